@@ -0,0 +1,101 @@
+/**
+ * \file Bench.hpp
+ * \brief The timing harness shared by the benchmark programs
+ *
+ * Copyright (c) Charles Karney (2021-2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_BENCH_HPP)
+#define GEOGRAPHICLIB_BENCH_HPP 1
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <GeographicLib/Math.hpp>
+
+#if !defined(_WIN32)
+#  include <sys/resource.h>
+#endif
+
+// Run each benchmark reps times; each run lasts at least tmin seconds.  Only
+// the benchmarks whose names contain filter are run.
+class Bench {
+private:
+  double _tmin;
+  int _reps;
+  std::string _filter;
+public:
+  // Prevent the computations from being optimized away.
+  GeographicLib::Math::real sink;
+  Bench(double tmin, int reps, const std::string& filter)
+    : _tmin(tmin), _reps(reps), _filter(filter), sink(0) {}
+  // f() performs ops operations.  Report the median time per operation.
+  template<class F> void Run(const std::string& name, size_t ops, F f) {
+    if (ops == 0 || name.find(_filter) == std::string::npos) return;
+    typedef std::chrono::steady_clock clock;
+    std::vector<double> times;
+    for (int rep = 0; rep < _reps; ++rep) {
+      size_t count = 0;
+      clock::time_point start = clock::now();
+      double t;
+      do {
+        f();
+        count += ops;
+        t = std::chrono::duration<double>(clock::now() - start).count();
+      } while (t < _tmin);
+      times.push_back(1e9 * t / count);
+    }
+    std::sort(times.begin(), times.end());
+    std::cout << std::left << std::setw(32) << name << std::right
+              << std::setw(9) << ops << " "
+              << std::fixed << std::setprecision(1)
+              << std::setw(10) << times[_reps / 2] << " "
+              << std::setw(10) << times[0] << " "
+              << std::setw(10) << times[_reps - 1] << "\n";
+  }
+  // f(i) performs operation i for i in [0, n).  Time each operation
+  // separately and report the 50th, 90th, and 99th percentiles and the
+  // maximum of the times in ns.  The first call is included and so this
+  // captures the cost of filling caches.
+  template<class F> void Latency(const std::string& name, size_t n, F f) {
+    if (n == 0 || name.find(_filter) == std::string::npos) return;
+    typedef std::chrono::steady_clock clock;
+    std::vector<double> times(n);
+    for (size_t i = 0; i < n; ++i) {
+      clock::time_point start = clock::now();
+      f(i);
+      times[i] =
+        1e9 * std::chrono::duration<double>(clock::now() - start).count();
+    }
+    std::sort(times.begin(), times.end());
+    std::cout << std::left << std::setw(32) << name << std::right
+              << std::setw(9) << n << " "
+              << std::fixed << std::setprecision(1)
+              << std::setw(10) << times[n / 2] << " "
+              << std::setw(10) << times[(9 * n) / 10] << " "
+              << std::setw(10) << times[(99 * n) / 100] << " "
+              << std::setw(10) << times[n - 1] << "\n";
+  }
+  // The peak resident set size of the process in MB (or -1 if this isn't
+  // available).
+  static double PeakMemory() {
+#if defined(_WIN32)
+    return -1;
+#else
+    struct rusage u;
+    if (getrusage(RUSAGE_SELF, &u) != 0) return -1;
+#  if defined(__APPLE__)
+    return u.ru_maxrss / double(1 << 20); // bytes
+#  else
+    return u.ru_maxrss / double(1 << 10); // kilobytes
+#  endif
+#endif
+  }
+};
+
+#endif  // GEOGRAPHICLIB_BENCH_HPP
@@ -0,0 +1,246 @@
+/**
+ * \file GeodBench.cpp
+ * \brief Timing benchmarks for the geodesic classes
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/GeodesicExact.hpp>
+#include <GeographicLib/PolygonArea.hpp>
+#include <GeographicLib/PolygonAreaBatch.hpp>
+#include <GeographicLib/Utility.hpp>
+#include "Bench.hpp"
+#include "../tests/GeodTestData.hpp"
+
+using namespace std;
+using namespace GeographicLib;
+typedef Math::real real;
+
+int usage(int retval) {
+  ( retval ? cerr : cout ) <<
+"GeodBench [ -f file ] [ -n count ] [ -t seconds ] [ -r reps ]\n\
+  [ -b name ] [ -h ]\n\
+\n\
+Time the geodesic calculations.  The input is read from file in the\n\
+format of GeodTest.dat (see the section \"Test data for geodesics\" in\n\
+the documentation) or the binary form written by GeodTest -C; if the\n\
+file name is \"-\" standard input is read.\n\
+If -f is omitted, count (default 100000) random geodesics are used.\n\
+Only the first count lines of the file are used.\n\
+\n\
+The geodesics are classified as short (s12 < 10 km), near-antipodal\n\
+(a12 > 179 deg), or long (the rest).  Each benchmark is run reps\n\
+(default 5) times; each run lasts at least seconds (default 0.2).  The\n\
+median time per operation is reported in ns.  -b name only runs the\n\
+benchmarks whose names contain name.\n";
+  return retval;
+}
+
+struct geodesic {
+  real lat1, lon1, azi1, lat2, lon2, s12, a12;
+};
+
+// Convert up to n lines of GeodTest.dat
+vector<geodesic> ReadData(const GeodTestData& t) {
+  vector<geodesic> data(t.size());
+  for (size_t i = 0; i < t.size(); ++i) {
+    geodesic& g = data[i];
+    g.lat1 = real(t[i].lat1); g.lon1 = real(t[i].lon1);
+    g.azi1 = real(t[i].azi1); g.lat2 = real(t[i].lat2);
+    g.lon2 = real(t[i].lon2); g.s12 = real(t[i].s12);
+    g.a12 = real(t[i].a12);
+  }
+  return data;
+}
+
+// Random geodesics computed with the direct method; every tenth geodesic is
+// nearly antipodal and every tenth is short.
+vector<geodesic> SyntheticData(const Geodesic& geod, size_t n) {
+  mt19937 r(20210101);
+  uniform_real_distribution<double> U(0, 1);
+  vector<geodesic> data(n);
+  for (size_t i = 0; i < n; ++i) {
+    geodesic& g = data[i];
+    g.lat1 = real(90 * U(r));
+    g.lon1 = 0;
+    g.azi1 = real(180 * U(r));
+    g.s12 = real(i % 10 == 1 ? 1e4 * U(r) :
+                 (i % 10 == 2 ? 19.95e6 + 0.05e6 * U(r) : 20e6 * U(r)));
+    real azi2;
+    g.a12 = geod.Direct(g.lat1, g.lon1, g.azi1, g.s12, g.lat2, g.lon2, azi2);
+  }
+  return data;
+}
+
+int main(int argc, const char* const argv[]) {
+  try {
+    Utility::set_digits();
+    string file, filter;
+    size_t n = 100000;
+    double tmin = 0.2;
+    int reps = 5;
+    for (int m = 1; m < argc; ++m) {
+      string arg(argv[m]);
+      if (arg == "-f" && m + 1 < argc)
+        file = argv[++m];
+      else if (arg == "-n" && m + 1 < argc)
+        n = Utility::val<size_t>(string(argv[++m]));
+      else if (arg == "-t" && m + 1 < argc)
+        tmin = Utility::val<double>(string(argv[++m]));
+      else if (arg == "-r" && m + 1 < argc)
+        reps = Utility::val<int>(string(argv[++m]));
+      else if (arg == "-b" && m + 1 < argc)
+        filter = argv[++m];
+      else if (arg == "-h")
+        return usage(0);
+      else
+        return usage(1);
+    }
+    if (!(reps > 0 && tmin >= 0))
+      throw GeographicErr("Bad value for -r or -t");
+
+    const Geodesic& geod = Geodesic::WGS84();
+    const GeodesicExact& geode = GeodesicExact::WGS84();
+    vector<geodesic> data;
+    if (file.empty())
+      data = SyntheticData(geod, n);
+    else if (file == "-")
+      data = ReadData(GeodTestData(cin, n));
+    else
+      data = ReadData(GeodTestData(file, n));
+
+    vector<geodesic> shortg, longg, antig;
+    for (const geodesic& g : data)
+      (g.s12 < 10000 ? shortg : (g.a12 > 179 ? antig : longg)).push_back(g);
+
+    Bench b(tmin, reps, filter);
+    cout << "# " << data.size() << " geodesics: " << shortg.size()
+         << " short, " << longg.size() << " long, " << antig.size()
+         << " near-antipodal\n"
+         << "# name                               count    ns/op  "
+         << "     min        max\n";
+
+    struct {
+      const char* name;
+      const vector<geodesic>* v;
+    } sets[] = {
+      {"short", &shortg}, {"long", &longg}, {"antipodal", &antig},
+      {"all", &data}
+    };
+
+    for (const auto& set : sets) {
+      const vector<geodesic>& v = *set.v;
+      b.Run(string("Geodesic::Direct/") + set.name, v.size(), [&]() {
+          real lat2, lon2, azi2;
+          for (const geodesic& g : v) {
+            geod.Direct(g.lat1, g.lon1, g.azi1, g.s12, lat2, lon2, azi2);
+            b.sink += lat2;
+          }
+        });
+      b.Run(string("Geodesic::Inverse/") + set.name, v.size(), [&]() {
+          real s12, azi1, azi2;
+          for (const geodesic& g : v) {
+            geod.Inverse(g.lat1, g.lon1, g.lat2, g.lon2, s12, azi1, azi2);
+            b.sink += s12;
+          }
+        });
+    }
+
+    // GeodesicExact is slower, so use a tenth of the data
+    vector<geodesic> datae;
+    for (size_t i = 0; i < data.size(); i += 10)
+      datae.push_back(data[i]);
+    b.Run("GeodesicExact::Direct/all", datae.size(), [&]() {
+        real lat2, lon2, azi2;
+        for (const geodesic& g : datae) {
+          geode.Direct(g.lat1, g.lon1, g.azi1, g.s12, lat2, lon2, azi2);
+          b.sink += lat2;
+        }
+      });
+    b.Run("GeodesicExact::Inverse/all", datae.size(), [&]() {
+        real s12, azi1, azi2;
+        for (const geodesic& g : datae) {
+          geode.Inverse(g.lat1, g.lon1, g.lat2, g.lon2, s12, azi1, azi2);
+          b.sink += s12;
+        }
+      });
+
+    // Construction of GeodesicLine and npos positions along it
+    const int npos = 10;
+    b.Run("GeodesicLine::Line", datae.size(), [&]() {
+        for (const geodesic& g : datae) {
+          GeodesicLine l(geod, g.lat1, g.lon1, g.azi1);
+          b.sink += l.Azimuth();
+        }
+      });
+    vector<GeodesicLine> lines;
+    for (const geodesic& g : datae)
+      lines.push_back(GeodesicLine(geod, g.lat1, g.lon1, g.azi1));
+    b.Run("GeodesicLine::Position", npos * lines.size(), [&]() {
+        real lat2, lon2;
+        for (size_t i = 0; i < lines.size(); ++i) {
+          for (int k = 1; k <= npos; ++k) {
+            lines[i].Position(k * datae[i].s12 / npos, lat2, lon2);
+            b.sink += lat2;
+          }
+        }
+      });
+
+    // Treat consecutive groups of 4 end points as the vertices of polygons
+    const unsigned nvert = 4;
+    size_t npoly = data.size() / nvert;
+    b.Run("PolygonArea::Compute", npoly, [&]() {
+        PolygonArea poly(geod);
+        real perimeter, area;
+        for (size_t i = 0; i < npoly; ++i) {
+          poly.Clear();
+          for (unsigned k = 0; k < nvert; ++k) {
+            const geodesic& g = data[nvert * i + k];
+            poly.AddPoint(g.lat2, g.lon2);
+          }
+          poly.Compute(false, true, perimeter, area);
+          b.sink += area;
+        }
+      });
+
+    // The same polygons computed with PolygonAreaBatch
+    PolygonAreaBatch polyb(geod);
+    vector<size_t> offsets(npoly + 1);
+    vector<real> lats(nvert * npoly), lons(nvert * npoly),
+      perimeters(npoly), areas(npoly);
+    for (size_t i = 0; i <= npoly; ++i)
+      offsets[i] = nvert * i;
+    for (size_t i = 0; i < nvert * npoly; ++i) {
+      lats[i] = data[i].lat2; lons[i] = data[i].lon2;
+    }
+    b.Run("PolygonAreaBatch::Compute", npoly, [&]() {
+        polyb.Compute(npoly, offsets.data(), lats.data(), lons.data(),
+                      false, true, perimeters.data(), areas.data());
+        b.sink += areas[0];
+      });
+
+    cout << "# checksum " << b.sink << "\n";
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  catch (...) {
+    cerr << "Caught unknown exception\n";
+    return 1;
+  }
+  return 0;
+}
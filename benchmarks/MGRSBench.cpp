@@ -0,0 +1,213 @@
+/**
+ * \file MGRSBench.cpp
+ * \brief Timing benchmarks for the MGRS and UTMUPS string conversions
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <memory>
+#include <GeographicLib/MGRS.hpp>
+#include <GeographicLib/UTMUPS.hpp>
+#include <GeographicLib/Utility.hpp>
+#include "Bench.hpp"
+
+using namespace std;
+using namespace GeographicLib;
+typedef Math::real real;
+
+int usage(int retval) {
+  ( retval ? cerr : cout ) <<
+"MGRSBench [ -f file ] [ -n count ] [ -t seconds ] [ -r reps ]\n\
+  [ -b name ] [ -h ]\n\
+\n\
+Time the conversions between MGRS and UTM/UPS coordinates.  The input\n\
+is read from file, one MGRS reference per line; if the file name is \"-\"\n\
+standard input is read.  If -f is omitted, count (default 100000) MGRS\n\
+references for random points with precisions in [-1, 11] are used.  Only\n\
+the first count lines of the file are used.\n\
+\n\
+Each benchmark is run reps (default 5) times; each run lasts at least\n\
+seconds (default 0.2).  The median time per operation is reported in ns.\n\
+-b name only runs the benchmarks whose names contain name.\n";
+  return retval;
+}
+
+// Read up to n MGRS references
+vector<string> ReadData(istream& str, size_t n) {
+  vector<string> data;
+  string s;
+  while (data.size() < n && getline(str, s))
+    data.push_back(Utility::trim(s));
+  return data;
+}
+
+// MGRS references for random points; the precision cycles through [-1, 11].
+vector<string> SyntheticData(size_t n) {
+  mt19937 r(20210101);
+  uniform_real_distribution<double> U(0, 1);
+  vector<string> data(n);
+  for (size_t i = 0; i < n; ++i) {
+    real
+      lat = real(asin(2 * U(r) - 1) / Math::degree()),
+      lon = real(360 * U(r) - 180),
+      x, y;
+    int zone;
+    bool northp;
+    UTMUPS::Forward(lat, lon, zone, northp, x, y);
+    MGRS::Forward(zone, northp, x, y, lat, int(i % 13) - 1, data[i]);
+  }
+  return data;
+}
+
+int main(int argc, const char* const argv[]) {
+  try {
+    Utility::set_digits();
+    string file, filter;
+    size_t n = 100000;
+    double tmin = 0.2;
+    int reps = 5;
+    for (int m = 1; m < argc; ++m) {
+      string arg(argv[m]);
+      if (arg == "-f" && m + 1 < argc)
+        file = argv[++m];
+      else if (arg == "-n" && m + 1 < argc)
+        n = Utility::val<size_t>(string(argv[++m]));
+      else if (arg == "-t" && m + 1 < argc)
+        tmin = Utility::val<double>(string(argv[++m]));
+      else if (arg == "-r" && m + 1 < argc)
+        reps = Utility::val<int>(string(argv[++m]));
+      else if (arg == "-b" && m + 1 < argc)
+        filter = argv[++m];
+      else if (arg == "-h")
+        return usage(0);
+      else
+        return usage(1);
+    }
+    if (!(reps > 0 && tmin >= 0))
+      throw GeographicErr("Bad value for -r or -t");
+
+    vector<string> data;
+    if (file.empty())
+      data = SyntheticData(n);
+    else if (file == "-")
+      data = ReadData(cin, n);
+    else {
+      ifstream str(file.c_str());
+      if (!str.good())
+        throw GeographicErr("Cannot open " + file);
+      data = ReadData(str, n);
+    }
+
+    // Decode the references once to check them and to supply the input for
+    // the forward conversions; the illegal ones are skipped.
+    vector<string> refs;
+    vector<int> zones, precs;
+    vector<bool> northps;
+    vector<real> xs, ys;
+    size_t nbad = 0;
+    for (const string& s : data) {
+      int zone, prec;
+      bool northp;
+      real x, y;
+      if (MGRS::Reverse(s.data(), s.size(), zone, northp, x, y, prec) !=
+          MGRS::OK) {
+        ++nbad;
+        continue;
+      }
+      refs.push_back(s); zones.push_back(zone); northps.push_back(northp);
+      xs.push_back(x); ys.push_back(y); precs.push_back(prec);
+    }
+
+    // The references in fixed-width slots for the batch conversion
+    const size_t stride = 28;
+    size_t nref = refs.size();
+    vector<char> buf(nref * stride, '\0');
+    for (size_t i = 0; i < nref; ++i)
+      refs[i].copy(&buf[i * stride], stride - 1);
+    vector<string> zonestrs(nref);
+    for (size_t i = 0; i < nref; ++i)
+      zonestrs[i] = UTMUPS::EncodeZone(zones[i], northps[i]);
+
+    Bench b(tmin, reps, filter);
+    cout << "# " << data.size() << " MGRS references: " << nbad
+         << " illegal\n"
+         << "# name                               count    ns/op  "
+         << "     min        max\n";
+
+    b.Run("MGRS::Reverse/string", nref, [&]() {
+        int zone, prec;
+        bool northp;
+        real x, y;
+        for (const string& s : refs) {
+          MGRS::Reverse(s, zone, northp, x, y, prec);
+          b.sink += x;
+        }
+      });
+    b.Run("MGRS::Reverse/buffer", nref, [&]() {
+        int zone, prec;
+        bool northp;
+        real x, y;
+        for (const string& s : refs) {
+          MGRS::Reverse(s.data(), s.size(), zone, northp, x, y, prec);
+          b.sink += x;
+        }
+      });
+    vector<int> zoneb(nref), precb(nref);
+    unique_ptr<bool[]> northpb(new bool[nref]);
+    vector<real> xb(nref), yb(nref);
+    b.Run("MGRS::ReverseBatch", nref, [&]() {
+        MGRS::ReverseBatch(nref, buf.data(), stride, zoneb.data(),
+                           northpb.get(), xb.data(), yb.data(), precb.data());
+        b.sink += xb[0];
+      });
+    b.Run("MGRS::Forward/string", nref, [&]() {
+        string s;
+        for (size_t i = 0; i < nref; ++i) {
+          MGRS::Forward(zones[i], northps[i], xs[i], ys[i], precs[i], s);
+          b.sink += s.size();
+        }
+      });
+    b.Run("MGRS::Forward/buffer", nref, [&]() {
+        char s[stride];
+        for (size_t i = 0; i < nref; ++i) {
+          MGRS::Forward(zones[i], northps[i], xs[i], ys[i], precs[i],
+                        s, stride);
+          b.sink += s[0];
+        }
+      });
+    b.Run("UTMUPS::DecodeZone/string", nref, [&]() {
+        int zone;
+        bool northp;
+        for (const string& s : zonestrs) {
+          UTMUPS::DecodeZone(s, zone, northp);
+          b.sink += zone;
+        }
+      });
+    b.Run("UTMUPS::DecodeZone/buffer", nref, [&]() {
+        int zone;
+        bool northp;
+        for (const string& s : zonestrs) {
+          UTMUPS::DecodeZone(s.data(), s.size(), zone, northp);
+          b.sink += zone;
+        }
+      });
+
+    cout << "# checksum " << b.sink << "\n";
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  catch (...) {
+    cerr << "Caught unknown exception\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,379 @@
+/**
+ * \file ModelBench.cpp
+ * \brief Timing benchmarks for the geoid, gravity, and magnetic models
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <memory>
+#include <functional>
+#include <GeographicLib/Geoid.hpp>
+#include <GeographicLib/GravityModel.hpp>
+#include <GeographicLib/GravityCircle.hpp>
+#include <GeographicLib/MagneticModel.hpp>
+#include <GeographicLib/MagneticCircle.hpp>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/Utility.hpp>
+#include "Bench.hpp"
+
+using namespace std;
+using namespace GeographicLib;
+typedef Math::real real;
+
+int usage(int retval) {
+  ( retval ? cerr : cout ) <<
+"ModelBench [ -g geoid ] [ -G gravity ] [ -M magnetic ] [ -n count ]\n\
+  [ -t seconds ] [ -r reps ] [ -b name ] [ -h ]\n\
+\n\
+Time the evaluation of geoid heights, gravity, and the magnetic field.\n\
+The models are given by -g (default egm96-5), -G (default egm96), and -M\n\
+(default wmm2020) and are found in the default directories (set, e.g.,\n\
+with the environment variable GEOGRAPHICLIB_DATA).  A model which can't\n\
+be loaded is skipped; an empty name skips it too.\n\
+\n\
+Two sets of count (default 100000) points are used: \"random\" points\n\
+distributed uniformly over the earth with heights in [0, 10] km, and\n\
+\"track\" points spaced 100 m apart along a meandering trajectory at a\n\
+height of 10 km.  The gravity benchmarks use a hundredth of the points.\n\
+\n\
+The geoid heights are computed with bilinear (linear) and cubic\n\
+interpolation and with the data read from the file as needed (stream),\n\
+cached in memory (cached), memory mapped (mmap), read with pread\n\
+(pread), or read from the compressed tiles (tiled); each is timed for\n\
+single points and for the batch routine.  The gravity is computed with\n\
+the full model and truncated to degrees 360, 120, and 36 for single\n\
+points and via GravityCircle.  The magnetic field is computed for single\n\
+points, via MagneticCircle, and with the batch routine.\n\
+\n\
+Each benchmark is run reps (default 5) times; each run lasts at least\n\
+seconds (default 0.2).  The median time per operation is reported in ns\n\
+(the throughput is the reciprocal of this).  The latencies of the\n\
+individual evaluations for one pass over the points (including filling\n\
+any caches) are then reported as percentiles.  The peak memory use of\n\
+the process is reported after each model is loaded.  -b name only runs\n\
+the benchmarks whose names contain name.\n";
+  return retval;
+}
+
+struct point {
+  real lat, lon, h;
+};
+
+// A set of points together with the coordinates as separate arrays for the
+// batch routines.
+struct pointset {
+  string name;
+  vector<point> p;
+  vector<real> lat, lon, h;
+  void Fill() {
+    lat.clear(); lon.clear(); h.clear();
+    for (const point& q : p) {
+      lat.push_back(q.lat); lon.push_back(q.lon); h.push_back(q.h);
+    }
+  }
+};
+
+// Points distributed uniformly over the earth.
+pointset RandomPoints(size_t n) {
+  mt19937 r(20210101);
+  uniform_real_distribution<double> U(0, 1);
+  pointset s;
+  s.name = "random";
+  s.p.resize(n);
+  for (point& q : s.p) {
+    q.lat = real(asin(2 * U(r) - 1) / Math::degree());
+    q.lon = real(360 * U(r) - 180);
+    q.h = real(10000 * U(r));
+  }
+  s.Fill();
+  return s;
+}
+
+// Points 100 m apart along a trajectory whose heading changes by up to 2
+// degrees at each step.
+pointset TrackPoints(size_t n) {
+  mt19937 r(20210102);
+  uniform_real_distribution<double> U(0, 1);
+  const Geodesic& geod = Geodesic::WGS84();
+  pointset s;
+  s.name = "track";
+  s.p.resize(n);
+  real lat = real(asin(2 * U(r) - 1) / Math::degree()),
+    lon = real(360 * U(r) - 180), azi = real(360 * U(r) - 180);
+  for (point& q : s.p) {
+    q.lat = lat; q.lon = lon; q.h = 10000;
+    geod.Direct(lat, lon, azi, real(100), lat, lon, azi);
+    azi += real(4 * U(r) - 2);
+  }
+  s.Fill();
+  return s;
+}
+
+// A subset with every stride'th point.
+pointset Subset(const pointset& s, size_t stride) {
+  pointset t;
+  t.name = s.name;
+  for (size_t i = 0; i < s.p.size(); i += stride)
+    t.p.push_back(s.p[i]);
+  t.Fill();
+  return t;
+}
+
+void Memory(const string& name) {
+  cout << "# peak memory after loading " << name << ": "
+       << fixed << setprecision(1) << Bench::PeakMemory() << " MB\n";
+}
+
+int main(int argc, const char* const argv[]) {
+  try {
+    Utility::set_digits();
+    string filter,
+      geoidname = Geoid::DefaultGeoidName(),
+      gravityname = GravityModel::DefaultGravityName(),
+      magneticname = MagneticModel::DefaultMagneticName();
+    size_t n = 100000;
+    double tmin = 0.2;
+    int reps = 5;
+    for (int m = 1; m < argc; ++m) {
+      string arg(argv[m]);
+      if (arg == "-g" && m + 1 < argc)
+        geoidname = argv[++m];
+      else if (arg == "-G" && m + 1 < argc)
+        gravityname = argv[++m];
+      else if (arg == "-M" && m + 1 < argc)
+        magneticname = argv[++m];
+      else if (arg == "-n" && m + 1 < argc)
+        n = Utility::val<size_t>(string(argv[++m]));
+      else if (arg == "-t" && m + 1 < argc)
+        tmin = Utility::val<double>(string(argv[++m]));
+      else if (arg == "-r" && m + 1 < argc)
+        reps = Utility::val<int>(string(argv[++m]));
+      else if (arg == "-b" && m + 1 < argc)
+        filter = argv[++m];
+      else if (arg == "-h")
+        return usage(0);
+      else
+        return usage(1);
+    }
+    if (!(reps > 0 && tmin >= 0 && n > 0))
+      throw GeographicErr("Bad value for -n, -r, or -t");
+
+    const pointset sets[] = { RandomPoints(n), TrackPoints(n) };
+    vector<real> out1(n), out2(n), out3(n);
+    Bench b(tmin, reps, filter);
+    Memory("the points");
+
+    // Load all the models first, so that the throughput and latency tables
+    // can be printed separately.  Each geoid case records how to construct
+    // a new instance.
+    struct geoidcase {
+      string name;
+      function<shared_ptr<const Geoid>()> make;
+      shared_ptr<const Geoid> g;
+    };
+    vector<geoidcase> geoids;
+    if (!geoidname.empty()) {
+      const struct {
+        const char* name;
+        Geoid::datamode mode;
+        bool cacheall;
+      } modes[] = {
+        {"stream", Geoid::STREAM, false},
+        {"cached", Geoid::STREAM, true},
+        {"mmap", Geoid::MEMORYMAP, false},
+        {"pread", Geoid::POSITIONAL, false},
+        {"tiled", Geoid::TILED, false},
+      };
+      for (bool cubic : {false, true})
+        for (const auto& mode : modes) {
+          geoidcase gc;
+          gc.name = string("Geoid/") + (cubic ? "cubic/" : "linear/")
+            + mode.name;
+          Geoid::datamode dm = mode.mode;
+          bool cacheall = mode.cacheall;
+          gc.make = [geoidname, cubic, dm, cacheall]()
+            -> shared_ptr<const Geoid> {
+            shared_ptr<Geoid> g =
+              make_shared<Geoid>(geoidname, "", cubic, false, dm);
+            if (cacheall) g->CacheAll();
+            return g;
+          };
+          try {
+            gc.g = gc.make();
+            Memory(gc.name);
+            geoids.push_back(gc);
+          }
+          catch (const exception& e) {
+            cout << "# skipping " << gc.name << ": " << e.what() << "\n";
+          }
+        }
+    }
+
+    shared_ptr<const GravityModel> grav;
+    vector<pair<int, shared_ptr<const GravityModel>>> gravs;
+    if (!gravityname.empty()) {
+      try {
+        grav = make_shared<GravityModel>(gravityname);
+        Memory("GravityModel/" + gravityname);
+        gravs.push_back({grav->Degree(), grav});
+        for (int N : {360, 120, 36})
+          if (N < grav->Degree())
+            gravs.push_back({N, make_shared<GravityModel>(*grav, N)});
+      }
+      catch (const exception& e) {
+        cout << "# skipping GravityModel: " << e.what() << "\n";
+      }
+    }
+
+    shared_ptr<const MagneticModel> mag;
+    if (!magneticname.empty()) {
+      try {
+        mag = make_shared<MagneticModel>(magneticname);
+        Memory("MagneticModel/" + magneticname);
+      }
+      catch (const exception& e) {
+        cout << "# skipping MagneticModel: " << e.what() << "\n";
+      }
+    }
+
+    // The gravity and the circles are expensive, so use fewer points; the
+    // circles are evaluated at ncirc longitudes.
+    const pointset gsets[] = { Subset(sets[0], 100), Subset(sets[1], 100) };
+    const size_t ncirc = 360;
+    vector<real> lons(ncirc);
+    for (size_t j = 0; j < ncirc; ++j)
+      lons[j] = real(j) - 180;
+
+    cout << "# name                               count    ns/op  "
+         << "     min        max\n";
+
+    for (const geoidcase& gc : geoids) {
+      const Geoid& g = *gc.g;
+      for (const pointset& s : sets) {
+        b.Run(gc.name + "/" + s.name, s.p.size(), [&]() {
+            for (const point& q : s.p)
+              b.sink += g(q.lat, q.lon);
+          });
+        b.Run(gc.name + "/batch/" + s.name, s.p.size(), [&]() {
+            g(s.p.size(), s.lat.data(), s.lon.data(), out1.data());
+            b.sink += out1[0];
+          });
+      }
+    }
+
+    for (const auto& gm : gravs) {
+      const GravityModel& g = *gm.second;
+      string deg = "/" + Utility::str(gm.first);
+      for (const pointset& s : gsets)
+        b.Run("GravityModel" + deg + "/" + s.name, s.p.size(),
+              [&]() {
+                real gx, gy, gz;
+                for (const point& q : s.p)
+                  b.sink += g.Gravity(q.lat, q.lon, q.h, gx, gy, gz);
+              });
+      const pointset& s = gsets[0];
+      b.Run("GravityModel::Circle" + deg, s.p.size(), [&]() {
+          for (const point& q : s.p) {
+            GravityCircle c = g.Circle(q.lat, q.h, GravityModel::GRAVITY);
+            b.sink += c.Height();
+          }
+        });
+      GravityCircle c = g.Circle(s.p[0].lat, s.p[0].h, GravityModel::GRAVITY);
+      b.Run("GravityCircle" + deg, ncirc, [&]() {
+          real gx, gy, gz;
+          for (real lon : lons)
+            b.sink += c.Gravity(lon, gx, gy, gz);
+        });
+    }
+
+    if (mag) {
+      const MagneticModel& m = *mag;
+      const real t = (m.MinTime() + m.MaxTime()) / 2;
+      vector<real> ts(n, t);
+      for (const pointset& s : sets) {
+        b.Run("MagneticModel/" + s.name, s.p.size(), [&]() {
+            real bx, by, bz;
+            for (const point& q : s.p) {
+              m(t, q.lat, q.lon, q.h, bx, by, bz);
+              b.sink += bx;
+            }
+          });
+        b.Run("MagneticModel/batch/" + s.name, s.p.size(), [&]() {
+            m.FieldBatch(s.p.size(), ts.data(),
+                         s.lat.data(), s.lon.data(), s.h.data(),
+                         out1.data(), out2.data(), out3.data());
+            b.sink += out1[0];
+          });
+      }
+      const pointset& s = gsets[0];
+      b.Run("MagneticModel::Circle", s.p.size(), [&]() {
+          for (const point& q : s.p) {
+            MagneticCircle c = m.Circle(t, q.lat, q.h);
+            b.sink += c.Height();
+          }
+        });
+      MagneticCircle c = m.Circle(t, s.p[0].lat, s.p[0].h);
+      b.Run("MagneticCircle", ncirc, [&]() {
+          real bx, by, bz;
+          for (real lon : lons) {
+            c(lon, bx, by, bz);
+            b.sink += bx;
+          }
+        });
+    }
+
+    cout << "# latency                            count      p50  "
+         << "     p90        p99        max\n";
+
+    // Use new objects so that the latencies include filling the caches.
+    for (const geoidcase& gc : geoids) {
+      for (const pointset& s : sets) {
+        shared_ptr<const Geoid> gp = gc.make();
+        const Geoid& g = *gp;
+        b.Latency(gc.name + "/" + s.name, s.p.size(), [&](size_t i) {
+            b.sink += g(s.p[i].lat, s.p[i].lon);
+          });
+      }
+    }
+
+    for (const auto& gm : gravs) {
+      const GravityModel& g = *gm.second;
+      for (const pointset& s : gsets)
+        b.Latency("GravityModel/" + Utility::str(gm.first) + "/" +
+                  s.name, s.p.size(), [&](size_t i) {
+                    real gx, gy, gz;
+                    b.sink += g.Gravity(s.p[i].lat, s.p[i].lon, s.p[i].h,
+                                        gx, gy, gz);
+                  });
+    }
+
+    if (mag) {
+      const MagneticModel& m = *mag;
+      const real t = (m.MinTime() + m.MaxTime()) / 2;
+      for (const pointset& s : sets)
+        b.Latency("MagneticModel/" + s.name, s.p.size(), [&](size_t i) {
+            real bx, by, bz;
+            m(t, s.p[i].lat, s.p[i].lon, s.p[i].h, bx, by, bz);
+            b.sink += bx;
+          });
+    }
+
+    Memory("all the models");
+    cout << "# checksum " << b.sink << "\n";
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  catch (...) {
+    cerr << "Caught unknown exception\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,512 @@
+/**
+ * \file ProjBench.cpp
+ * \brief Timing benchmarks for the projections and grid reference codecs
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <memory>
+#include <GeographicLib/TransverseMercator.hpp>
+#include <GeographicLib/TransverseMercatorExact.hpp>
+#include <GeographicLib/UTMUPS.hpp>
+#include <GeographicLib/MGRS.hpp>
+#include <GeographicLib/GeoCoords.hpp>
+#include <GeographicLib/LambertConformalConic.hpp>
+#include <GeographicLib/AlbersEqualArea.hpp>
+#include <GeographicLib/PolarStereographic.hpp>
+#include <GeographicLib/Geohash.hpp>
+#include <GeographicLib/GARS.hpp>
+#include <GeographicLib/Georef.hpp>
+#include <GeographicLib/OSGB.hpp>
+#include <GeographicLib/DMS.hpp>
+#include <GeographicLib/Utility.hpp>
+#include "Bench.hpp"
+
+using namespace std;
+using namespace GeographicLib;
+typedef Math::real real;
+
+int usage(int retval) {
+  ( retval ? cerr : cout ) <<
+"ProjBench [ -n count ] [ -t seconds ] [ -r reps ] [ -b name ] [ -h ]\n\
+\n\
+Time the projections (TransverseMercator, TransverseMercatorExact,\n\
+UTMUPS, LambertConformalConic, AlbersEqualArea, PolarStereographic,\n\
+and OSGB), the grid reference codecs (MGRS, GeoCoords, Geohash, GARS,\n\
+Georef, and OSGB), and the parsing of angles with DMS.  Where there is\n\
+a batch routine, both the scalar routine (name/Forward, etc.) and the\n\
+batch routine (name/ForwardBatch, etc.) are timed; \"(int)\" denotes the\n\
+batch routines using the packed integer codes.  count (default\n\
+100000) random points are used; these are confined to the region where\n\
+each projection is usually applied.  TransverseMercatorExact uses a\n\
+tenth of the points.\n\
+\n\
+Each benchmark is run reps (default 5) times; each run lasts at least\n\
+seconds (default 0.2).  The median time per operation is reported in ns.\n\
+-b name only runs the benchmarks whose names contain name.\n";
+  return retval;
+}
+
+// Random points in a region together with space for the results.
+struct points {
+  vector<real> lat, lon, x, y, lat2, lon2;
+  points(size_t n, real latmin, real latmax, real lonmin, real lonmax,
+         unsigned seed)
+    : lat(n), lon(n), x(n), y(n), lat2(n), lon2(n) {
+    mt19937 r(seed);
+    uniform_real_distribution<double> U(0, 1);
+    // Uniform in area
+    double
+      smin = sin(latmin * Math::degree()),
+      smax = sin(latmax * Math::degree());
+    for (size_t i = 0; i < n; ++i) {
+      lat[i] = real(asin(smin + (smax - smin) * U(r)) / Math::degree());
+      lon[i] = real(lonmin + (lonmax - lonmin) * U(r));
+    }
+  }
+  size_t size() const { return lat.size(); }
+};
+
+// Time a projection with Forward(lat, lon, x, y), Reverse(x, y, lat, lon),
+// ForwardBatch(n, lat, lon, x, y), and ReverseBatch(n, x, y, lat, lon) all
+// supplied as lambdas.  If batch is false, the batch routines are only used
+// to set up the data.
+template<class F, class R, class FB, class RB>
+void Projection(Bench& b, const string& name, points& p,
+                F fwd, R rev, FB fwdb, RB revb, bool batch = true) {
+  size_t n = p.size();
+  // Set x and y for the reverse scalar benchmark
+  fwdb(n, p.lat.data(), p.lon.data(), p.x.data(), p.y.data());
+  b.Run(name + "/Forward", n, [&]() {
+      real x, y;
+      for (size_t i = 0; i < n; ++i) {
+        fwd(p.lat[i], p.lon[i], x, y);
+        b.sink += x;
+      }
+    });
+  if (batch) b.Run(name + "/ForwardBatch", n, [&]() {
+      fwdb(n, p.lat.data(), p.lon.data(), p.x.data(), p.y.data());
+      b.sink += p.x[0];
+    });
+  b.Run(name + "/Reverse", n, [&]() {
+      real lat, lon;
+      for (size_t i = 0; i < n; ++i) {
+        rev(p.x[i], p.y[i], lat, lon);
+        b.sink += lat;
+      }
+    });
+  if (batch) b.Run(name + "/ReverseBatch", n, [&]() {
+      revb(n, p.x.data(), p.y.data(), p.lat2.data(), p.lon2.data());
+      b.sink += p.lat2[0];
+    });
+}
+
+int main(int argc, const char* const argv[]) {
+  try {
+    Utility::set_digits();
+    string filter;
+    size_t n = 100000;
+    double tmin = 0.2;
+    int reps = 5;
+    for (int m = 1; m < argc; ++m) {
+      string arg(argv[m]);
+      if (arg == "-n" && m + 1 < argc)
+        n = Utility::val<size_t>(string(argv[++m]));
+      else if (arg == "-t" && m + 1 < argc)
+        tmin = Utility::val<double>(string(argv[++m]));
+      else if (arg == "-r" && m + 1 < argc)
+        reps = Utility::val<int>(string(argv[++m]));
+      else if (arg == "-b" && m + 1 < argc)
+        filter = argv[++m];
+      else if (arg == "-h")
+        return usage(0);
+      else
+        return usage(1);
+    }
+    if (!(reps > 0 && tmin >= 0 && n > 0))
+      throw GeographicErr("Bad value for -n, -r, or -t");
+
+    Bench b(tmin, reps, filter);
+    cout << "# name                               count    ns/op  "
+         << "     min        max\n";
+
+    // Transverse Mercator within a UTM zone
+    {
+      const real lon0 = 3;
+      points p(n, -80, 84, 0, 6, 20210101);
+      const TransverseMercator& tm = TransverseMercator::UTM();
+      Projection
+        (b, "TransverseMercator", p,
+         [&](real lat, real lon, real& x, real& y) {
+          tm.Forward(lon0, lat, lon, x, y); },
+         [&](real x, real y, real& lat, real& lon) {
+           tm.Reverse(lon0, x, y, lat, lon); },
+         [&](size_t k, const real* lat, const real* lon, real* x, real* y) {
+           tm.ForwardBatch(k, lon0, lat, lon, x, y); },
+         [&](size_t k, const real* x, const real* y, real* lat, real* lon) {
+           tm.ReverseBatch(k, lon0, x, y, lat, lon); });
+      points pe(max(n / 10, size_t(1)), -80, 84, 0, 6, 20210101);
+      const TransverseMercatorExact& tme = TransverseMercatorExact::UTM();
+      Projection
+        (b, "TransverseMercatorExact", pe,
+         [&](real lat, real lon, real& x, real& y) {
+          tme.Forward(lon0, lat, lon, x, y); },
+         [&](real x, real y, real& lat, real& lon) {
+           tme.Reverse(lon0, x, y, lat, lon); },
+         // There are no batch routines; use loops to set up the data.
+         [&](size_t k, const real* lat, const real* lon, real* x, real* y) {
+           for (size_t i = 0; i < k; ++i)
+             tme.Forward(lon0, lat[i], lon[i], x[i], y[i]); },
+         [&](size_t k, const real* x, const real* y, real* lat, real* lon) {
+           for (size_t i = 0; i < k; ++i)
+             tme.Reverse(lon0, x[i], y[i], lat[i], lon[i]); },
+         false);
+    }
+
+    // UTMUPS, MGRS, and GeoCoords over the whole earth
+    {
+      points p(n, -90, 90, -180, 180, 20210102);
+      vector<int> zone(n);
+      unique_ptr<bool[]> northp(new bool[n]);
+      UTMUPS::ForwardBatch(n, p.lat.data(), p.lon.data(), zone.data(),
+                           northp.get(), p.x.data(), p.y.data());
+      b.Run("UTMUPS/Forward", n, [&]() {
+          int z;
+          bool h;
+          real x, y;
+          for (size_t i = 0; i < n; ++i) {
+            UTMUPS::Forward(p.lat[i], p.lon[i], z, h, x, y);
+            b.sink += x;
+          }
+        });
+      b.Run("UTMUPS/ForwardBatch", n, [&]() {
+          UTMUPS::ForwardBatch(n, p.lat.data(), p.lon.data(), zone.data(),
+                               northp.get(), p.x.data(), p.y.data());
+          b.sink += p.x[0];
+        });
+      b.Run("UTMUPS/Reverse", n, [&]() {
+          real lat, lon;
+          for (size_t i = 0; i < n; ++i) {
+            UTMUPS::Reverse(zone[i], northp[i], p.x[i], p.y[i], lat, lon);
+            b.sink += lat;
+          }
+        });
+      b.Run("UTMUPS/ReverseBatch", n, [&]() {
+          UTMUPS::ReverseBatch(n, zone.data(), northp.get(),
+                               p.x.data(), p.y.data(),
+                               p.lat2.data(), p.lon2.data());
+          b.sink += p.lat2[0];
+        });
+
+      const int prec = 5;
+      const size_t stride = 16;
+      vector<char> buf(n * stride);
+      vector<string> refs(n);
+      for (size_t i = 0; i < n; ++i)
+        MGRS::Forward(zone[i], northp[i], p.x[i], p.y[i], prec, refs[i]);
+      vector<int> zone2(n), prec2(n);
+      unique_ptr<bool[]> northp2(new bool[n]);
+      b.Run("MGRS/Forward", n, [&]() {
+          string s;
+          for (size_t i = 0; i < n; ++i) {
+            MGRS::Forward(zone[i], northp[i], p.x[i], p.y[i], prec, s);
+            b.sink += s.size();
+          }
+        });
+      b.Run("MGRS/ForwardBatch", n, [&]() {
+          MGRS::ForwardBatch(n, zone.data(), northp.get(),
+                             p.x.data(), p.y.data(), prec,
+                             buf.data(), stride);
+          b.sink += buf[0];
+        });
+      b.Run("MGRS/Reverse", n, [&]() {
+          int z, pr;
+          bool h;
+          real x, y;
+          for (const string& s : refs) {
+            MGRS::Reverse(s, z, h, x, y, pr);
+            b.sink += x;
+          }
+        });
+      b.Run("MGRS/ReverseBatch", n, [&]() {
+          MGRS::ReverseBatch(n, buf.data(), stride, zone2.data(),
+                             northp2.get(), p.lat2.data(), p.lon2.data(),
+                             prec2.data());
+          b.sink += p.lat2[0];
+        });
+
+      b.Run("GeoCoords/Reset", n, [&]() {
+          GeoCoords c;
+          for (size_t i = 0; i < n; ++i) {
+            c.Reset(p.lat[i], p.lon[i]);
+            b.sink += c.Easting();
+          }
+        });
+      b.Run("GeoCoords/ForwardBatch", n, [&]() {
+          GeoCoords::ForwardBatch(n, p.lat.data(), p.lon.data(),
+                                  zone2.data(), northp2.get(),
+                                  p.x.data(), p.y.data());
+          b.sink += p.x[0];
+        });
+      b.Run("GeoCoords/ForwardBatch+MGRS", n, [&]() {
+          GeoCoords::ForwardBatch(n, p.lat.data(), p.lon.data(),
+                                  zone2.data(), northp2.get(),
+                                  p.x.data(), p.y.data(), nullptr, nullptr,
+                                  buf.data(), stride, prec);
+          b.sink += buf[0];
+        });
+      b.Run("GeoCoords/Reset(MGRS)", n, [&]() {
+          GeoCoords c;
+          for (const string& s : refs) {
+            c.Reset(s);
+            b.sink += c.Latitude();
+          }
+        });
+    }
+
+    // Conic projections for the contiguous US
+    {
+      const real lon0 = -96;
+      points p(n, 20, 60, -130, -60, 20210103);
+      const LambertConformalConic
+        lcc(Constants::WGS84_a(), Constants::WGS84_f(), 33, 45, 1);
+      Projection
+        (b, "LambertConformalConic", p,
+         [&](real lat, real lon, real& x, real& y) {
+          lcc.Forward(lon0, lat, lon, x, y); },
+         [&](real x, real y, real& lat, real& lon) {
+           lcc.Reverse(lon0, x, y, lat, lon); },
+         [&](size_t k, const real* lat, const real* lon, real* x, real* y) {
+           lcc.ForwardBatch(k, lon0, lat, lon, x, y); },
+         [&](size_t k, const real* x, const real* y, real* lat, real* lon) {
+           lcc.ReverseBatch(k, lon0, x, y, lat, lon); });
+      const AlbersEqualArea
+        alb(Constants::WGS84_a(), Constants::WGS84_f(), 29.5, 45.5, 1);
+      Projection
+        (b, "AlbersEqualArea", p,
+         [&](real lat, real lon, real& x, real& y) {
+          alb.Forward(lon0, lat, lon, x, y); },
+         [&](real x, real y, real& lat, real& lon) {
+           alb.Reverse(lon0, x, y, lat, lon); },
+         [&](size_t k, const real* lat, const real* lon, real* x, real* y) {
+           alb.ForwardBatch(k, lon0, lat, lon, x, y); },
+         [&](size_t k, const real* x, const real* y, real* lat, real* lon) {
+           alb.ReverseBatch(k, lon0, x, y, lat, lon); });
+    }
+
+    // Polar stereographic for the north polar cap
+    {
+      points p(n, 60, 90, -180, 180, 20210104);
+      const PolarStereographic& ps = PolarStereographic::UPS();
+      Projection
+        (b, "PolarStereographic", p,
+         [&](real lat, real lon, real& x, real& y) {
+          ps.Forward(true, lat, lon, x, y); },
+         [&](real x, real y, real& lat, real& lon) {
+           ps.Reverse(true, x, y, lat, lon); },
+         [&](size_t k, const real* lat, const real* lon, real* x, real* y) {
+           ps.ForwardBatch(k, true, lat, lon, x, y); },
+         [&](size_t k, const real* x, const real* y, real* lat, real* lon) {
+           ps.ReverseBatch(k, true, x, y, lat, lon); });
+    }
+
+    // OSGB for Great Britain
+    {
+      points p(n, 50, 58, -7, 2, 20210105);
+      Projection
+        (b, "OSGB", p,
+         [&](real lat, real lon, real& x, real& y) {
+          OSGB::Forward(lat, lon, x, y); },
+         [&](real x, real y, real& lat, real& lon) {
+           OSGB::Reverse(x, y, lat, lon); },
+         [&](size_t k, const real* lat, const real* lon, real* x, real* y) {
+           OSGB::ForwardBatch(k, lat, lon, x, y); },
+         [&](size_t k, const real* x, const real* y, real* lat, real* lon) {
+           OSGB::ReverseBatch(k, x, y, lat, lon); });
+      const int prec = 4;
+      const size_t stride = 16;
+      vector<char> buf(n * stride);
+      vector<string> refs(n);
+      for (size_t i = 0; i < n; ++i)
+        OSGB::GridReference(p.x[i], p.y[i], prec, refs[i]);
+      vector<int> prec2(n);
+      b.Run("OSGB/GridReference", n, [&]() {
+          string s;
+          for (size_t i = 0; i < n; ++i) {
+            OSGB::GridReference(p.x[i], p.y[i], prec, s);
+            b.sink += s.size();
+          }
+        });
+      b.Run("OSGB/GridReferenceBatch", n, [&]() {
+          OSGB::GridReferenceBatch(n, p.x.data(), p.y.data(), prec,
+                                   buf.data(), stride);
+          b.sink += buf[0];
+        });
+      b.Run("OSGB/GridReference(parse)", n, [&]() {
+          real x, y;
+          int pr;
+          for (const string& s : refs) {
+            OSGB::GridReference(s, x, y, pr);
+            b.sink += x;
+          }
+        });
+      b.Run("OSGB/GridReferenceBatch(parse)", n, [&]() {
+          OSGB::GridReferenceBatch(n, buf.data(), stride,
+                                   p.lat2.data(), p.lon2.data(),
+                                   prec2.data());
+          b.sink += p.lat2[0];
+        });
+    }
+
+    // The geographic codes over the whole earth; each is timed with strings
+    // and, for the batch routines, with the packed integer forms (and the
+    // character buffers for Geohash).
+    {
+      points p(n, -90, 90, -180, 180, 20210106);
+      vector<unsigned long long> id(n);
+      const int len = 12;
+      const size_t stride = 16;
+      vector<char> buf(n * stride);
+      vector<string> strs(n);
+      vector<int> lens(n);
+
+      for (size_t i = 0; i < n; ++i)
+        Geohash::Forward(p.lat[i], p.lon[i], len, strs[i]);
+      b.Run("Geohash/Forward", n, [&]() {
+          string s;
+          for (size_t i = 0; i < n; ++i) {
+            Geohash::Forward(p.lat[i], p.lon[i], len, s);
+            b.sink += s[0];
+          }
+        });
+      b.Run("Geohash/ForwardBatch", n, [&]() {
+          Geohash::ForwardBatch(n, p.lat.data(), p.lon.data(), len,
+                                buf.data(), stride);
+          b.sink += buf[0];
+        });
+      b.Run("Geohash/ForwardBatch(int)", n, [&]() {
+          Geohash::ForwardBatch(n, p.lat.data(), p.lon.data(), len,
+                                id.data());
+          b.sink += real(id[0] & 1U);
+        });
+      b.Run("Geohash/Reverse", n, [&]() {
+          real lat, lon;
+          int l;
+          for (const string& s : strs) {
+            Geohash::Reverse(s, lat, lon, l);
+            b.sink += lat;
+          }
+        });
+      b.Run("Geohash/ReverseBatch", n, [&]() {
+          Geohash::ReverseBatch(n, buf.data(), stride,
+                                p.lat2.data(), p.lon2.data(), lens.data());
+          b.sink += p.lat2[0];
+        });
+      b.Run("Geohash/ReverseBatch(int)", n, [&]() {
+          Geohash::ReverseBatch(n, id.data(), len,
+                                p.lat2.data(), p.lon2.data());
+          b.sink += p.lat2[0];
+        });
+
+      const int gprec = 2;
+      for (size_t i = 0; i < n; ++i)
+        GARS::Forward(p.lat[i], p.lon[i], gprec, strs[i]);
+      b.Run("GARS/Forward", n, [&]() {
+          string s;
+          for (size_t i = 0; i < n; ++i) {
+            GARS::Forward(p.lat[i], p.lon[i], gprec, s);
+            b.sink += s[0];
+          }
+        });
+      b.Run("GARS/ForwardBatch(int)", n, [&]() {
+          GARS::ForwardBatch(n, p.lat.data(), p.lon.data(), gprec,
+                             id.data());
+          b.sink += real(id[0] & 1U);
+        });
+      b.Run("GARS/Reverse", n, [&]() {
+          real lat, lon;
+          int pr;
+          for (const string& s : strs) {
+            GARS::Reverse(s, lat, lon, pr);
+            b.sink += lat;
+          }
+        });
+      b.Run("GARS/ReverseBatch(int)", n, [&]() {
+          GARS::ReverseBatch(n, id.data(), gprec,
+                             p.lat2.data(), p.lon2.data());
+          b.sink += p.lat2[0];
+        });
+
+      const int rprec = 5;
+      for (size_t i = 0; i < n; ++i)
+        Georef::Forward(p.lat[i], p.lon[i], rprec, strs[i]);
+      b.Run("Georef/Forward", n, [&]() {
+          string s;
+          for (size_t i = 0; i < n; ++i) {
+            Georef::Forward(p.lat[i], p.lon[i], rprec, s);
+            b.sink += s[0];
+          }
+        });
+      b.Run("Georef/ForwardBatch(int)", n, [&]() {
+          Georef::ForwardBatch(n, p.lat.data(), p.lon.data(), rprec,
+                               id.data());
+          b.sink += real(id[0] & 1U);
+        });
+      b.Run("Georef/Reverse", n, [&]() {
+          real lat, lon;
+          int pr;
+          for (const string& s : strs) {
+            Georef::Reverse(s, lat, lon, pr);
+            b.sink += lat;
+          }
+        });
+      b.Run("Georef/ReverseBatch(int)", n, [&]() {
+          Georef::ReverseBatch(n, id.data(), rprec,
+                               p.lat2.data(), p.lon2.data());
+          b.sink += p.lat2[0];
+        });
+
+      // DMS has no batch routines; time the encoding and the parsing of
+      // single angles and of latitude-longitude pairs.
+      vector<string> lats(n), lons(n);
+      for (size_t i = 0; i < n; ++i) {
+        lats[i] = DMS::Encode(p.lat[i], DMS::SECOND, 2, DMS::LATITUDE);
+        lons[i] = DMS::Encode(p.lon[i], DMS::SECOND, 2, DMS::LONGITUDE);
+      }
+      b.Run("DMS/Encode", n, [&]() {
+          for (size_t i = 0; i < n; ++i)
+            b.sink += DMS::Encode(p.lat[i], DMS::SECOND, 2,
+                                  DMS::LATITUDE).size();
+        });
+      b.Run("DMS/Decode", n, [&]() {
+          DMS::flag ind;
+          for (const string& s : lats)
+            b.sink += DMS::Decode(s, ind);
+        });
+      b.Run("DMS/DecodeLatLon", n, [&]() {
+          real lat, lon;
+          for (size_t i = 0; i < n; ++i) {
+            DMS::DecodeLatLon(lats[i], lons[i], lat, lon);
+            b.sink += lat;
+          }
+        });
+    }
+
+    cout << "# checksum " << b.sink << "\n";
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  catch (...) {
+    cerr << "Caught unknown exception\n";
+    return 1;
+  }
+  return 0;
+}
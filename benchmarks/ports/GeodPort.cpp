@@ -0,0 +1,122 @@
+/**
+ * \file GeodPort.cpp
+ * \brief The C++ driver for the cross-port geodesic benchmark
+ *
+ * This reads a workload in the format described in ports/00README.txt from
+ * standard input, solves the inverse and direct problems with Geodesic,
+ * writes the results and the timings to standard output.  With -g count,
+ * it instead writes count random test geodesics computed with
+ * GeodesicExact in the format of GeodTest.dat.
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicExact.hpp>
+#include <GeographicLib/Utility.hpp>
+
+using namespace std;
+using namespace GeographicLib;
+
+// Random geodesics; every tenth geodesic is nearly antipodal and every tenth
+// is short (the same mix as GeodBench).  The endpoints are found with Direct
+// and the rest of the line is given by Inverse, so that each line describes a
+// shortest geodesic as in GeodTest.dat.
+void Generate(size_t n) {
+  const GeodesicExact& geod = GeodesicExact::WGS84();
+  mt19937 r(20210101);
+  uniform_real_distribution<double> U(0, 1);
+  cout << setprecision(17);
+  for (size_t i = 0; i < n; ++i) {
+    double lat1 = 90 * U(r), lon1 = 0, azi1 = 180 * U(r),
+      s12 = i % 10 == 1 ? 1e4 * U(r) :
+      (i % 10 == 2 ? 19.95e6 + 0.05e6 * U(r) : 20e6 * U(r)),
+      lat2, lon2, azi2, m12, M12, M21, S12;
+    geod.Direct(lat1, lon1, azi1, s12, lat2, lon2);
+    double a12 = geod.Inverse(lat1, lon1, lat2, lon2, s12, azi1, azi2,
+                              m12, M12, M21, S12);
+    cout << lat1 << " " << lon1 << " " << azi1 << " "
+         << lat2 << " " << lon2 << " " << azi2 << " "
+         << s12 << " " << a12 << " " << m12 << " " << S12 << "\n";
+  }
+}
+
+// Return the minimum over reps passes of the time per problem (ns).
+template<class F> double Time(size_t n, int reps, F f) {
+  typedef chrono::steady_clock clock;
+  double tmin = -1;
+  for (int rep = 0; rep < reps; ++rep) {
+    clock::time_point start = clock::now();
+    f();
+    double t = chrono::duration<double>(clock::now() - start).count();
+    if (tmin < 0 || t < tmin) tmin = t;
+  }
+  return 1e9 * tmin / double(n);
+}
+
+int main(int argc, const char* const argv[]) {
+  try {
+    if (argc == 3 && string(argv[1]) == "-g") {
+      Generate(Utility::val<size_t>(string(argv[2])));
+      return 0;
+    } else if (argc != 1) {
+      cerr << "Usage: GeodPort [ -g count ] < workload\n";
+      return 1;
+    }
+    size_t n;
+    int reps;
+    if (!(cin >> n >> reps))
+      throw GeographicErr("Bad workload header");
+    vector<double> lat1(n), lon1(n), azi1(n), lat2(n), lon2(n), s12(n),
+      s12i(n), azi1i(n), azi2i(n), lat2d(n), lon2d(n), azi2d(n);
+    for (size_t i = 0; i < n; ++i)
+      if (!(cin >> lat1[i] >> lon1[i] >> azi1[i]
+            >> lat2[i] >> lon2[i] >> s12[i]))
+        throw GeographicErr("Bad workload line " + Utility::str(i + 1));
+    const Geodesic& geod = Geodesic::WGS84();
+
+    double tinv = Time(n, reps, [&]() {
+        for (size_t i = 0; i < n; ++i)
+          geod.Inverse(lat1[i], lon1[i], lat2[i], lon2[i],
+                       s12i[i], azi1i[i], azi2i[i]);
+      });
+    double tdir = Time(n, reps, [&]() {
+        for (size_t i = 0; i < n; ++i)
+          geod.Direct(lat1[i], lon1[i], azi1[i], s12[i],
+                      lat2d[i], lon2d[i], azi2d[i]);
+      });
+    cout << setprecision(17);
+    for (size_t i = 0; i < n; ++i)
+      cout << s12i[i] << " " << azi1i[i] << " " << azi2i[i] << " "
+           << lat2d[i] << " " << lon2d[i] << " " << azi2d[i] << "\n";
+    double tinvb = Time(n, reps, [&]() {
+        geod.InverseBatch(n, lat1.data(), lon1.data(),
+                          lat2.data(), lon2.data(),
+                          s12i.data(), azi1i.data(), azi2i.data());
+      });
+    double tdirb = Time(n, reps, [&]() {
+        geod.DirectBatch(n, lat1.data(), lon1.data(),
+                         azi1.data(), s12.data(),
+                         lat2d.data(), lon2d.data(), azi2d.data());
+      });
+    cout << fixed << setprecision(1)
+         << "inverse " << tinv << "\n"
+         << "direct " << tdir << "\n"
+         << "inverse-batch " << tinvb << "\n"
+         << "direct-batch " << tdirb << "\n";
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * The .NET driver for the cross-port geodesic benchmark
+ *
+ * This reads a workload in the format described in 00README.txt from
+ * standard input, solves the inverse and direct problems with
+ * NETGeographicLib.Geodesic.Inverse and Direct (and the batch versions), and
+ * writes the results and the timings to standard output.  Compile with a
+ * reference to NETGeographicLib.dll, e.g.,
+ *
+ *   csc /r:NETGeographicLib.dll GeodPort.cs
+ **********************************************************************/
+
+using System;
+using System.Diagnostics;
+using System.Globalization;
+using System.IO;
+using System.Text;
+using NETGeographicLib;
+
+class GeodPort
+{
+    // The minimum over reps passes of the time per problem (ns).
+    static double Time(int n, int reps, Action f)
+    {
+        double tmin = -1;
+        for (int rep = 0; rep < reps; ++rep) {
+            Stopwatch sw = Stopwatch.StartNew();
+            f();
+            double t = sw.Elapsed.TotalSeconds;
+            if (tmin < 0 || t < tmin) tmin = t;
+        }
+        return 1e9 * tmin / n;
+    }
+
+    static void Main(string[] args)
+    {
+        CultureInfo c = CultureInfo.InvariantCulture;
+        string[] data = Console.In.ReadToEnd().Split(
+            (char[])null, StringSplitOptions.RemoveEmptyEntries);
+        int n = int.Parse(data[0], c), reps = int.Parse(data[1], c);
+        double[] lat1 = new double[n], lon1 = new double[n],
+            azi1 = new double[n], lat2 = new double[n], lon2 = new double[n],
+            s12 = new double[n],
+            s12i = new double[n], azi1i = new double[n], azi2i = new double[n],
+            lat2d = new double[n], lon2d = new double[n], azi2d = new double[n];
+        for (int i = 0; i < n; ++i) {
+            lat1[i] = double.Parse(data[2 + 6*i], c);
+            lon1[i] = double.Parse(data[3 + 6*i], c);
+            azi1[i] = double.Parse(data[4 + 6*i], c);
+            lat2[i] = double.Parse(data[5 + 6*i], c);
+            lon2[i] = double.Parse(data[6 + 6*i], c);
+            s12[i] = double.Parse(data[7 + 6*i], c);
+        }
+        Geodesic geod = new Geodesic();
+        double tinv = Time(n, reps, () => {
+                for (int i = 0; i < n; ++i)
+                    geod.Inverse(lat1[i], lon1[i], lat2[i], lon2[i],
+                                 out s12i[i], out azi1i[i], out azi2i[i]);
+            });
+        double tdir = Time(n, reps, () => {
+                for (int i = 0; i < n; ++i)
+                    geod.Direct(lat1[i], lon1[i], azi1[i], s12[i],
+                                out lat2d[i], out lon2d[i], out azi2d[i]);
+            });
+        StringBuilder o = new StringBuilder();
+        for (int i = 0; i < n; ++i)
+            o.AppendLine(String.Format(c, "{0:R} {1:R} {2:R} {3:R} {4:R} {5:R}",
+                                       s12i[i], azi1i[i], azi2i[i],
+                                       lat2d[i], lon2d[i], azi2d[i]));
+        double tinvb = Time(n, reps, () =>
+                            geod.InverseBatch(lat1, lon1, lat2, lon2,
+                                              s12i, azi1i, azi2i));
+        double tdirb = Time(n, reps, () =>
+                            geod.DirectBatch(lat1, lon1, azi1, s12,
+                                             lat2d, lon2d, azi2d));
+        o.AppendLine(String.Format(c, "inverse {0:F1}", tinv));
+        o.AppendLine(String.Format(c, "direct {0:F1}", tdir));
+        o.AppendLine(String.Format(c, "inverse-batch {0:F1}", tinvb));
+        o.AppendLine(String.Format(c, "direct-batch {0:F1}", tdirb));
+        Console.Out.Write(o.ToString().Replace("\r\n", "\n"));
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * The Java driver for the cross-port geodesic benchmark
+ *
+ * This reads a workload in the format described in 00README.txt from
+ * standard input, solves the inverse and direct problems with
+ * Geodesic.Inverse and Geodesic.Direct (and the batch versions), and writes
+ * the results and the timings to standard output.  Compile and run with the
+ * GeographicLib jar in the class path.  With the argument -native, the batch
+ * routines use the C++ library (see NativeGeodesic).
+ **********************************************************************/
+
+import java.io.*;
+import java.util.*;
+import net.sf.geographiclib.*;
+
+public class GeodPort {
+
+  private interface Task { void run(); }
+
+  // The minimum over reps passes of the time per problem (ns).
+  private static double time(int n, int reps, Task f) {
+    long tmin = -1;
+    for (int rep = 0; rep < reps; ++rep) {
+      long start = System.nanoTime();
+      f.run();
+      long t = System.nanoTime() - start;
+      if (tmin < 0 || t < tmin) tmin = t;
+    }
+    return (double)tmin / n;
+  }
+
+  public static void main(String[] args) throws IOException {
+    if (args.length > 0 && args[0].equals("-native"))
+      NativeGeodesic.Load();
+    StreamTokenizer in =
+      new StreamTokenizer(new BufferedReader(new InputStreamReader(System.in)));
+    in.resetSyntax();
+    in.wordChars(33, 126);
+    in.whitespaceChars(0, 32);
+    in.nextToken(); final int n = Integer.parseInt(in.sval);
+    in.nextToken(); final int reps = Integer.parseInt(in.sval);
+    final double[] lat1 = new double[n], lon1 = new double[n],
+      azi1 = new double[n], lat2 = new double[n], lon2 = new double[n],
+      s12 = new double[n],
+      s12i = new double[n], azi1i = new double[n], azi2i = new double[n],
+      lat2d = new double[n], lon2d = new double[n], azi2d = new double[n];
+    double[][] cols = {lat1, lon1, azi1, lat2, lon2, s12};
+    for (int i = 0; i < n; ++i)
+      for (double[] c : cols) {
+        in.nextToken(); c[i] = Double.parseDouble(in.sval);
+      }
+    final Geodesic geod = Geodesic.WGS84;
+    double tinv = time(n, reps, () -> {
+        for (int i = 0; i < n; ++i) {
+          GeodesicData r = geod.Inverse(lat1[i], lon1[i], lat2[i], lon2[i]);
+          s12i[i] = r.s12; azi1i[i] = r.azi1; azi2i[i] = r.azi2;
+        }
+      });
+    double tdir = time(n, reps, () -> {
+        for (int i = 0; i < n; ++i) {
+          GeodesicData r = geod.Direct(lat1[i], lon1[i], azi1[i], s12[i]);
+          lat2d[i] = r.lat2; lon2d[i] = r.lon2; azi2d[i] = r.azi2;
+        }
+      });
+    StringBuilder out = new StringBuilder();
+    for (int i = 0; i < n; ++i)
+      out.append(s12i[i]).append(' ').append(azi1i[i]).append(' ')
+        .append(azi2i[i]).append(' ').append(lat2d[i]).append(' ')
+        .append(lon2d[i]).append(' ').append(azi2d[i]).append('\n');
+    double tinvb = time(n, reps, () ->
+                        geod.InverseBatch(lat1, lon1, lat2, lon2,
+                                          GeodesicMask.STANDARD,
+                                          s12i, azi1i, azi2i,
+                                          null, null, null, null, null));
+    double tdirb = time(n, reps, () ->
+                        geod.DirectBatch(lat1, lon1, azi1, s12,
+                                         GeodesicMask.STANDARD,
+                                         lat2d, lon2d, azi2d,
+                                         null, null, null, null, null));
+    out.append(String.format(Locale.ROOT,
+                             "inverse %.1f%ndirect %.1f%n" +
+                             "inverse-batch %.1f%ndirect-batch %.1f%n",
+                             tinv, tdir, tinvb, tdirb));
+    System.out.print(out);
+  }
+}
@@ -0,0 +1,190 @@
+#! /usr/bin/env python3
+"""Compare the speed and accuracy of the geodesic routines in the ports
+
+Usage: crossport.py [ -B builddir ] [ -f file ] [ -n count ] [ -r reps ]
+  [ -p port,port,... ] [ --net dll ] [ -h ]
+
+The same workload is given to a small driver for each port (see
+00README.txt).  The workload is the first count (default 10000) lines of
+file in the format of GeodTest.dat (it may be gzipped); if -f is
+omitted, GeodPort -g generates count random geodesics with
+GeodesicExact.  Each timing is the minimum over reps (default 3) passes
+through the workload.
+
+builddir (default "BUILD") is a cmake build directory for the C++
+library; the GeodPort and javascript targets are built there.  The
+other ports are compiled from the sources into a temporary directory
+and are skipped if the compiler or interpreter they need is not found.
+The .NET port is only run if the path of NETGeographicLib.dll is given
+with --net.
+
+For each port, the table lists the time per problem (ns) for the scalar
+and batch inverse and direct routines and the maximum errors (nm)
+relative to the data in the file: for the inverse problem, the error in
+s12; for the direct problem, the error in the position of point 2.
+
+"""
+
+import argparse, gzip, math, os, shutil, subprocess, sys, tempfile
+
+SRC = os.path.dirname(os.path.abspath(__file__))
+TOP = os.path.normpath(os.path.join(SRC, '..', '..'))
+PORTS = ['cpp', 'c', 'fortran', 'python', 'js', 'java', 'net']
+TIMES = ['inverse', 'direct', 'inverse-batch', 'direct-batch']
+
+def run(cmd, **kw):
+  return subprocess.run(cmd, check = True, stdout = subprocess.PIPE,
+                        universal_newlines = True, **kw).stdout
+
+def which(*progs):
+  for prog in progs:
+    if shutil.which(prog): return prog
+  return None
+
+def cpp(args, tmp):
+  run(['cmake', '--build', args.builddir, '--target', 'GeodPort'])
+  for d in ['benchmarks', os.path.join('benchmarks', 'Release'),
+            os.path.join('benchmarks', 'Debug')]:
+    exe = os.path.join(args.builddir, d, 'GeodPort')
+    for e in [exe, exe + '.exe']:
+      if os.path.exists(e): return [e], None
+  raise RuntimeError('GeodPort not found in ' + args.builddir)
+
+def c(args, tmp):
+  cc = which('cc', 'gcc', 'clang')
+  if not cc: return None, None
+  exe = os.path.join(tmp, 'geodport-c')
+  run([cc, '-O2', '-I', os.path.join(TOP, 'legacy', 'C'),
+       os.path.join(SRC, 'geodport.c'),
+       os.path.join(TOP, 'legacy', 'C', 'geodesic.c'), '-o', exe, '-lm'])
+  return [exe], None
+
+def fortran(args, tmp):
+  fc = which('gfortran', 'flang')
+  if not fc: return None, None
+  exe = os.path.join(tmp, 'geodport-fortran')
+  run([fc, '-O2', '-I', os.path.join(TOP, 'legacy', 'Fortran'),
+       os.path.join(SRC, 'geodport.for'),
+       os.path.join(TOP, 'legacy', 'Fortran', 'geodesic.for'), '-o', exe])
+  return [exe], None
+
+def python(args, tmp):
+  env = dict(os.environ)
+  env['PYTHONPATH'] = os.path.join(TOP, 'python') + (
+    os.pathsep + env['PYTHONPATH'] if 'PYTHONPATH' in env else '')
+  return [sys.executable, os.path.join(SRC, 'geodport.py')], env
+
+def js(args, tmp):
+  node = which('node', 'nodejs')
+  if not node: return None, None
+  run(['cmake', '--build', args.builddir, '--target', 'javascript'])
+  return [node, os.path.join(SRC, 'geodport.js'),
+          os.path.join(args.builddir, 'js', 'geographiclib.js')], None
+
+def java(args, tmp):
+  if not (which('javac') and which('java')): return None, None
+  srcdir = os.path.join(TOP, 'java', 'src', 'main', 'java',
+                        'net', 'sf', 'geographiclib')
+  run(['javac', '-d', tmp, os.path.join(SRC, 'GeodPort.java')] +
+      [os.path.join(srcdir, f) for f in sorted(os.listdir(srcdir))
+       if f.endswith('.java')])
+  return ['java', '-cp', tmp, 'GeodPort'], None
+
+def net(args, tmp):
+  csc = which('csc', 'mcs')
+  if not (args.net and csc): return None, None
+  exe = os.path.join(tmp, 'GeodPort.exe')
+  shutil.copy(args.net, tmp)
+  run([csc, '/nologo', '/out:' + exe, '/r:' + args.net,
+       os.path.join(SRC, 'GeodPort.cs')])
+  return ([exe] if os.name == 'nt' else [which('mono') or 'mono', exe]), None
+
+def readdata(args):
+  """Return the workload as a list of
+  [lat1, lon1, azi1, lat2, lon2, azi2, s12]"""
+  if args.file:
+    with (gzip.open(args.file, 'rt') if args.file.endswith('.gz')
+          else open(args.file)) as f:
+      lines = [next(f, '') for i in range(args.count)]
+  else:
+    exe, _ = cpp(args, None)
+    lines = run(exe + ['-g', str(args.count)]).splitlines()
+  data = [[float(x) for x in l.split()[0:7]] for l in lines if l.strip()]
+  if not data: raise RuntimeError('No data')
+  return data
+
+def position(lat1, lon1, lat2, lon2):
+  """The approximate distance (m) between two nearby points"""
+  R = 6371008.8; d = math.pi / 180
+  dlon = math.remainder(lon2 - lon1, 360)
+  return math.hypot((lat2 - lat1) * d * R,
+                    dlon * d * R * math.cos((lat1 + lat2) / 2 * d))
+
+def compare(data, out):
+  """Return the maximum inverse and direct errors (nm) and the timings"""
+  lines = out.splitlines()
+  n = len(data)
+  if len(lines) < n: raise RuntimeError('Short output')
+  inv = dirn = 0.0
+  for g, l in zip(data, lines[0:n]):
+    s12, azi1, azi2, lat2, lon2, azi2d = [float(x) for x in l.split()]
+    e = abs(s12 - g[6])
+    inv = max(inv, e) if e == e else float('nan')
+    e = position(g[3], g[4], lat2, lon2)
+    dirn = max(dirn, e) if e == e else float('nan')
+  times = {}
+  for l in lines[n:]:
+    k, v = l.split()
+    times[k] = float(v)
+  return 1e9 * inv, 1e9 * dirn, times
+
+def main():
+  p = argparse.ArgumentParser(
+    description = 'Compare the geodesic routines in the ports.')
+  p.add_argument('-B', dest = 'builddir', default = 'BUILD',
+                 help = 'the cmake build directory (default BUILD)')
+  p.add_argument('-f', dest = 'file', help = 'GeodTest.dat or GeodTest.dat.gz')
+  p.add_argument('-n', dest = 'count', type = int, default = 10000,
+                 help = 'the number of geodesics (default 10000)')
+  p.add_argument('-r', dest = 'reps', type = int, default = 3,
+                 help = 'the number of passes timed (default 3)')
+  p.add_argument('-p', dest = 'ports', default = ','.join(PORTS),
+                 help = 'the ports to run (default ' + ','.join(PORTS) + ')')
+  p.add_argument('--net', help = 'the path of NETGeographicLib.dll')
+  args = p.parse_args()
+  ports = args.ports.split(',')
+  for port in ports:
+    if port not in PORTS: p.error('unknown port ' + port)
+
+  data = readdata(args)
+  work = '{} {}\n'.format(len(data), args.reps) + ''.join(
+    '{!r} {!r} {!r} {!r} {!r} {!r}\n'.format(*(g[0:5] + [g[6]]))
+    for g in data)
+  print('{} geodesics, {} passes; times in ns, errors in nm'.format(
+    len(data), args.reps))
+  print('{:8s}{:>10s}{:>10s}{:>10s}{:>10s}{:>12s}{:>12s}'.format(
+    'port', 'inverse', 'direct', 'inv-batch', 'dir-batch',
+    'inv-err', 'dir-err'))
+  tmp = tempfile.mkdtemp()
+  try:
+    for port in ports:
+      try:
+        cmd, env = globals()[port](args, tmp)
+        if not cmd:
+          print('{:8s}  skipped (not available)'.format(port))
+          continue
+        inv, dirn, times = compare(data, run(cmd, input = work, env = env))
+      except (subprocess.CalledProcessError, OSError, RuntimeError,
+              ValueError) as e:
+        print('{:8s}  failed: {}'.format(port, e))
+        continue
+      print('{:8s}{}{:12.1f}{:12.1f}'.format(
+        port, ''.join('{:10.1f}'.format(times[k]) if k in times
+                      else '{:>10s}'.format('-') for k in TIMES),
+        inv, dirn))
+      sys.stdout.flush()
+  finally:
+    shutil.rmtree(tmp)
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,97 @@
+/**
+ * @file geodport.c
+ * @brief The C driver for the cross-port geodesic benchmark
+ *
+ * This reads a workload in the format described in 00README.txt from
+ * standard input, solves the inverse and direct problems with geod_inverse()
+ * and geod_direct() (and the batch versions), and writes the results and the
+ * timings to standard output.  Compile with legacy/C/geodesic.c.
+ **********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "geodesic.h"
+
+#if defined(_MSC_VER)
+/* Squelch warnings about scanf */
+#  pragma warning (disable: 4996)
+#endif
+
+static double *lat1, *lon1, *azi1, *lat2, *lon2, *s12,
+  *s12i, *azi1i, *azi2i, *lat2d, *lon2d, *azi2d;
+static size_t n;
+static struct geod_geodesic g;
+
+static void inverse(void) {
+  size_t i;
+  for (i = 0; i < n; ++i)
+    geod_inverse(&g, lat1[i], lon1[i], lat2[i], lon2[i],
+                 s12i + i, azi1i + i, azi2i + i);
+}
+
+static void direct(void) {
+  size_t i;
+  for (i = 0; i < n; ++i)
+    geod_direct(&g, lat1[i], lon1[i], azi1[i], s12[i],
+                lat2d + i, lon2d + i, azi2d + i);
+}
+
+static void inversebatch(void) {
+  geod_inverse_batch(&g, n, lat1, lon1, lat2, lon2, s12i, azi1i, azi2i);
+}
+
+static void directbatch(void) {
+  geod_direct_batch(&g, n, lat1, lon1, azi1, s12, lat2d, lon2d, azi2d);
+}
+
+/* The minimum over reps passes of the time per problem (ns). */
+static double timeit(void (*f)(void), int reps) {
+  double tmin = -1;
+  int rep;
+  for (rep = 0; rep < reps; ++rep) {
+    clock_t start = clock();
+    double t;
+    f();
+    t = (double)(clock() - start) / CLOCKS_PER_SEC;
+    if (tmin < 0 || t < tmin) tmin = t;
+  }
+  return 1e9 * tmin / (double)n;
+}
+
+static double* alloc(void) {
+  double* p = (double*)malloc((n ? n : 1) * sizeof(double));
+  if (!p) { fprintf(stderr, "Out of memory\n"); exit(1); }
+  return p;
+}
+
+int main(void) {
+  double tinv, tdir, tinvb, tdirb;
+  size_t i;
+  int reps;
+  if (scanf("%lu %d", (unsigned long*)&n, &reps) != 2) {
+    fprintf(stderr, "Bad workload header\n");
+    return 1;
+  }
+  lat1 = alloc(); lon1 = alloc(); azi1 = alloc();
+  lat2 = alloc(); lon2 = alloc(); s12 = alloc();
+  s12i = alloc(); azi1i = alloc(); azi2i = alloc();
+  lat2d = alloc(); lon2d = alloc(); azi2d = alloc();
+  for (i = 0; i < n; ++i)
+    if (scanf("%lf %lf %lf %lf %lf %lf", lat1 + i, lon1 + i, azi1 + i,
+              lat2 + i, lon2 + i, s12 + i) != 6) {
+      fprintf(stderr, "Bad workload line %lu\n", (unsigned long)(i + 1));
+      return 1;
+    }
+  geod_init(&g, 6378137, 1/298.257223563); /* WGS84 */
+  tinv = timeit(inverse, reps);
+  tdir = timeit(direct, reps);
+  for (i = 0; i < n; ++i)
+    printf("%.17g %.17g %.17g %.17g %.17g %.17g\n",
+           s12i[i], azi1i[i], azi2i[i], lat2d[i], lon2d[i], azi2d[i]);
+  tinvb = timeit(inversebatch, reps);
+  tdirb = timeit(directbatch, reps);
+  printf("inverse %.1f\ndirect %.1f\ninverse-batch %.1f\ndirect-batch %.1f\n",
+         tinv, tdir, tinvb, tdirb);
+  return 0;
+}
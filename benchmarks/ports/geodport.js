@@ -0,0 +1,65 @@
+/*
+ * geodport.js
+ * The JavaScript driver for the cross-port geodesic benchmark
+ *
+ * This reads a workload in the format described in 00README.txt from
+ * standard input, solves the inverse and direct problems with
+ * Geodesic.Inverse and Geodesic.Direct (and the batch versions), and writes
+ * the results and the timings to standard output.  Usage:
+ *
+ *   node geodport.js path/to/geographiclib.js < workload
+ */
+
+"use strict";
+
+var fs = require("fs"),
+    path = require("path"),
+    G = require(path.resolve(process.argv[2] || "geographiclib")),
+    geod = G.Geodesic.WGS84,
+    data = fs.readFileSync(0, "utf8").trim().split(/\s+/).map(Number),
+    n = data[0], reps = data[1],
+    lat1 = new Float64Array(n), lon1 = new Float64Array(n),
+    azi1 = new Float64Array(n), lat2 = new Float64Array(n),
+    lon2 = new Float64Array(n), s12 = new Float64Array(n),
+    inv = new Array(n), dir = new Array(n),
+    out = [], i, tinv, tdir, tinvb, tdirb;
+
+// The minimum over reps passes of the time per problem (ns).
+function timeit(f) {
+  var tmin = -1, rep, start, t;
+  for (rep = 0; rep < reps; ++rep) {
+    start = process.hrtime.bigint();
+    f();
+    t = Number(process.hrtime.bigint() - start);
+    if (tmin < 0 || t < tmin) tmin = t;
+  }
+  return tmin / n;
+}
+
+for (i = 0; i < n; ++i) {
+  lat1[i] = data[2 + 6*i]; lon1[i] = data[3 + 6*i]; azi1[i] = data[4 + 6*i];
+  lat2[i] = data[5 + 6*i]; lon2[i] = data[6 + 6*i]; s12[i] = data[7 + 6*i];
+}
+tinv = timeit(function() {
+  for (var i = 0; i < n; ++i)
+    inv[i] = geod.Inverse(lat1[i], lon1[i], lat2[i], lon2[i]);
+});
+tdir = timeit(function() {
+  for (var i = 0; i < n; ++i)
+    dir[i] = geod.Direct(lat1[i], lon1[i], azi1[i], s12[i]);
+});
+for (i = 0; i < n; ++i)
+  out.push([inv[i].s12, inv[i].azi1, inv[i].azi2,
+            dir[i].lat2, dir[i].lon2, dir[i].azi2].join(" "));
+out.push("inverse " + tinv.toFixed(1), "direct " + tdir.toFixed(1));
+if (geod.InverseBatch) {
+  tinvb = timeit(function() {
+    geod.InverseBatch(lat1, lon1, lat2, lon2);
+  });
+  tdirb = timeit(function() {
+    geod.DirectBatch(lat1, lon1, azi1, s12);
+  });
+  out.push("inverse-batch " + tinvb.toFixed(1),
+           "direct-batch " + tdirb.toFixed(1));
+}
+process.stdout.write(out.join("\n") + "\n");
@@ -0,0 +1,54 @@
+"""The Python driver for the cross-port geodesic benchmark
+
+This reads a workload in the format described in 00README.txt from
+standard input, solves the inverse and direct problems with
+Geodesic.Inverse and Geodesic.Direct (and the batch versions), and
+writes the results and the timings to standard output.  Put the
+directory containing the geographiclib package in PYTHONPATH.
+
+"""
+
+import sys, time
+from geographiclib.geodesic import Geodesic
+
+def timeit(n, reps, f):
+  """The minimum over reps passes of the time per problem (ns)"""
+  tmin = None
+  for rep in range(reps):
+    start = time.perf_counter()
+    f()
+    t = time.perf_counter() - start
+    if tmin is None or t < tmin: tmin = t
+  return 1e9 * tmin / n
+
+def main():
+  data = sys.stdin.read().split()
+  n = int(data[0]); reps = int(data[1])
+  vals = [float(x) for x in data[2:2 + 6*n]]
+  lat1 = vals[0::6]; lon1 = vals[1::6]; azi1 = vals[2::6]
+  lat2 = vals[3::6]; lon2 = vals[4::6]; s12 = vals[5::6]
+  geod = Geodesic.WGS84
+  inv = [None] * n; dirn = [None] * n
+  def inverse():
+    for i in range(n):
+      inv[i] = geod.Inverse(lat1[i], lon1[i], lat2[i], lon2[i])
+  def direct():
+    for i in range(n):
+      dirn[i] = geod.Direct(lat1[i], lon1[i], azi1[i], s12[i])
+  tinv = timeit(n, reps, inverse)
+  tdir = timeit(n, reps, direct)
+  out = sys.stdout
+  for i in range(n):
+    out.write("{!r} {!r} {!r} {!r} {!r} {!r}\n".format(
+      inv[i]['s12'], inv[i]['azi1'], inv[i]['azi2'],
+      dirn[i]['lat2'], dirn[i]['lon2'], dirn[i]['azi2']))
+  tinvb = timeit(n, reps,
+                 lambda: geod.InverseBatch(lat1, lon1, lat2, lon2))
+  tdirb = timeit(n, reps,
+                 lambda: geod.DirectBatch(lat1, lon1, azi1, s12))
+  out.write("inverse {:.1f}\ndirect {:.1f}\n".format(tinv, tdir))
+  out.write("inverse-batch {:.1f}\ndirect-batch {:.1f}\n".format(
+    tinvb, tdirb))
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,62 @@
+# Generate a C++ source file with magnetic models compiled in.  This is
+# run in script mode at build time with the variables
+#   MODELS = comma-separated list of model names
+#   DIR = directory with the files NAME.wmm and NAME.wmm.cof
+#   OUTPUT = the file to generate
+
+# Write the contents of file FILE as the initializer of an unsigned char
+# array NAME to the variable OUT.
+function (embed_file FILE NAME OUT)
+  file (READ ${FILE} HEX HEX)
+  string (LENGTH "${HEX}" LEN)
+  if (LEN EQUAL 0)
+    message (FATAL_ERROR "${FILE} is empty")
+  endif ()
+  string (REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," HEX "${HEX}")
+  # 16 bytes per line
+  string (REPEAT "0x..," 16 LINE)
+  string (REGEX REPLACE "(${LINE})" "\\1\n      " HEX "${HEX}")
+  set (${OUT} "    const unsigned char ${NAME}[] = {\n      ${HEX}\n    };\n"
+    PARENT_SCOPE)
+endfunction ()
+
+string (REPLACE "," ";" MODELS "${MODELS}")
+set (DATA "")
+set (TABLE "")
+set (K 0)
+foreach (M ${MODELS})
+  foreach (F ${DIR}/${M}.wmm ${DIR}/${M}.wmm.cof)
+    if (NOT EXISTS ${F})
+      message (FATAL_ERROR "Magnetic model file ${F} not found")
+    endif ()
+  endforeach ()
+  embed_file (${DIR}/${M}.wmm meta${K} META)
+  embed_file (${DIR}/${M}.wmm.cof coeff${K} COEFF)
+  string (APPEND DATA "${META}${COEFF}")
+  string (APPEND TABLE
+    "    {\"${M}\", meta${K}, sizeof(meta${K}),"
+    " coeff${K}, sizeof(coeff${K})},\n")
+  math (EXPR K "${K} + 1")
+endforeach ()
+
+file (WRITE ${OUTPUT}.tmp "\
+// Magnetic models compiled into the library: ${MODELS}
+// This file was generated by embed-magnetic-models.cmake; do not edit.
+
+#include <GeographicLib/MagneticModel.hpp>
+
+namespace GeographicLib {
+
+  namespace {
+${DATA}  }
+
+  const MagneticModel::embedded MagneticModel::_embedded[] = {
+${TABLE}    {nullptr, nullptr, 0, nullptr, 0}
+  };
+
+} // namespace GeographicLib
+")
+# Only touch the output if it has changed
+execute_process (COMMAND ${CMAKE_COMMAND} -E copy_if_different
+  ${OUTPUT}.tmp ${OUTPUT})
+file (REMOVE ${OUTPUT}.tmp)
@@ -461,6 +461,103 @@ double Geodesic::GenInverse(double lat1, double lon1, double lat2, double lon2,
     return out;
 }
 
+//*****************************************************************************
+void Geodesic::DirectBatch(array<double>^ lat1, array<double>^ lon1,
+                           array<double>^ azi1, array<double>^ s12,
+                           Geodesic::mask outmask,
+                           array<double>^ lat2, array<double>^ lon2,
+                           array<double>^ azi2, array<double>^ m12,
+                           array<double>^ M12, array<double>^ M21,
+                           array<double>^ S12, array<double>^ a12)
+{
+    BatchArray::Check( lat1, 0, false, "lat1" );
+    int n = lat1->Length;
+    unsigned m = static_cast<unsigned>(outmask);
+    BatchArray::Check( lon1, n, false, "lon1" );
+    BatchArray::Check( azi1, n, false, "azi1" );
+    BatchArray::Check( s12, n, false, "s12" );
+    BatchArray::Check( lat2, n, (m & unsigned(mask::LATITUDE)) == 0, "lat2" );
+    BatchArray::Check( lon2, n, (m & unsigned(mask::LONGITUDE)) == 0, "lon2" );
+    BatchArray::Check( azi2, n, (m & unsigned(mask::AZIMUTH)) == 0, "azi2" );
+    BatchArray::Check( m12, n, (m & unsigned(mask::REDUCEDLENGTH)) == 0, "m12" );
+    BatchArray::Check( M12, n, (m & unsigned(mask::GEODESICSCALE)) == 0, "M12" );
+    BatchArray::Check( M21, n, (m & unsigned(mask::GEODESICSCALE)) == 0, "M21" );
+    BatchArray::Check( S12, n, (m & unsigned(mask::AREA)) == 0, "S12" );
+    BatchArray::Check( a12, n, true, "a12" );
+    if ( n == 0 ) return;
+    pin_ptr<double> plat1 = BatchArray::First( lat1 ),
+        plon1 = BatchArray::First( lon1 ), pazi1 = BatchArray::First( azi1 ),
+        ps12 = BatchArray::First( s12 ), plat2 = BatchArray::First( lat2 ),
+        plon2 = BatchArray::First( lon2 ), pazi2 = BatchArray::First( azi2 ),
+        pm12 = BatchArray::First( m12 ), pM12 = BatchArray::First( M12 ),
+        pM21 = BatchArray::First( M21 ), pS12 = BatchArray::First( S12 ),
+        pa12 = BatchArray::First( a12 );
+    m_pGeodesic->DirectBatch( n, plat1, plon1, pazi1, ps12, m,
+                              plat2, plon2, pazi2, pm12, pM12, pM21, pS12,
+                              pa12 );
+}
+
+//*****************************************************************************
+void Geodesic::DirectBatch(array<double>^ lat1, array<double>^ lon1,
+                           array<double>^ azi1, array<double>^ s12,
+                           array<double>^ lat2, array<double>^ lon2,
+                           array<double>^ azi2)
+{
+    DirectBatch( lat1, lon1, azi1, s12,
+                 Geodesic::mask::LATITUDE | Geodesic::mask::LONGITUDE |
+                 Geodesic::mask::AZIMUTH,
+                 lat2, lon2, azi2, nullptr, nullptr, nullptr, nullptr,
+                 nullptr );
+}
+
+//*****************************************************************************
+void Geodesic::InverseBatch(array<double>^ lat1, array<double>^ lon1,
+                            array<double>^ lat2, array<double>^ lon2,
+                            Geodesic::mask outmask,
+                            array<double>^ s12, array<double>^ azi1,
+                            array<double>^ azi2, array<double>^ m12,
+                            array<double>^ M12, array<double>^ M21,
+                            array<double>^ S12, array<double>^ a12)
+{
+    BatchArray::Check( lat1, 0, false, "lat1" );
+    int n = lat1->Length;
+    unsigned m = static_cast<unsigned>(outmask);
+    BatchArray::Check( lon1, n, false, "lon1" );
+    BatchArray::Check( lat2, n, false, "lat2" );
+    BatchArray::Check( lon2, n, false, "lon2" );
+    BatchArray::Check( s12, n, (m & unsigned(mask::DISTANCE)) == 0, "s12" );
+    BatchArray::Check( azi1, n, (m & unsigned(mask::AZIMUTH)) == 0, "azi1" );
+    BatchArray::Check( azi2, n, (m & unsigned(mask::AZIMUTH)) == 0, "azi2" );
+    BatchArray::Check( m12, n, (m & unsigned(mask::REDUCEDLENGTH)) == 0, "m12" );
+    BatchArray::Check( M12, n, (m & unsigned(mask::GEODESICSCALE)) == 0, "M12" );
+    BatchArray::Check( M21, n, (m & unsigned(mask::GEODESICSCALE)) == 0, "M21" );
+    BatchArray::Check( S12, n, (m & unsigned(mask::AREA)) == 0, "S12" );
+    BatchArray::Check( a12, n, true, "a12" );
+    if ( n == 0 ) return;
+    pin_ptr<double> plat1 = BatchArray::First( lat1 ),
+        plon1 = BatchArray::First( lon1 ), plat2 = BatchArray::First( lat2 ),
+        plon2 = BatchArray::First( lon2 ), ps12 = BatchArray::First( s12 ),
+        pazi1 = BatchArray::First( azi1 ), pazi2 = BatchArray::First( azi2 ),
+        pm12 = BatchArray::First( m12 ), pM12 = BatchArray::First( M12 ),
+        pM21 = BatchArray::First( M21 ), pS12 = BatchArray::First( S12 ),
+        pa12 = BatchArray::First( a12 );
+    m_pGeodesic->InverseBatch( n, plat1, plon1, plat2, plon2, m,
+                               ps12, pazi1, pazi2, pm12, pM12, pM21, pS12,
+                               pa12 );
+}
+
+//*****************************************************************************
+void Geodesic::InverseBatch(array<double>^ lat1, array<double>^ lon1,
+                            array<double>^ lat2, array<double>^ lon2,
+                            array<double>^ s12, array<double>^ azi1,
+                            array<double>^ azi2)
+{
+    InverseBatch( lat1, lon1, lat2, lon2,
+                  Geodesic::mask::DISTANCE | Geodesic::mask::AZIMUTH,
+                  s12, azi1, azi2, nullptr, nullptr, nullptr, nullptr,
+                  nullptr );
+}
+
 //*****************************************************************************
 System::IntPtr^ Geodesic::GetUnmanaged()
 {
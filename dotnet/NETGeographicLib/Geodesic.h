@@ -682,6 +682,104 @@ namespace NETGeographicLib
                         [System::Runtime::InteropServices::Out] double% S12);
         ///@}
 
+        /** \name Batch functions.
+         **********************************************************************/
+        ///@{
+        /**
+         * Solve many direct geodesic problems.
+         *
+         * @param[in] lat1 array of latitudes of point 1 (degrees).
+         * @param[in] lon1 array of longitudes of point 1 (degrees).
+         * @param[in] azi1 array of azimuths at point 1 (degrees).
+         * @param[in] s12 array of distances between point 1 and point 2
+         *   (meters).
+         * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+         *   specifying which of the following arrays should be set.
+         * @param[out] lat2 array of latitudes of point 2 (degrees).
+         * @param[out] lon2 array of longitudes of point 2 (degrees).
+         * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+         * @param[out] m12 array of reduced lengths (meters).
+         * @param[out] M12 array of geodesic scales of point 2 relative to
+         *   point 1 (dimensionless).
+         * @param[out] M21 array of geodesic scales of point 1 relative to
+         *   point 2 (dimensionless).
+         * @param[out] S12 array of areas under the geodesics
+         *   (meters<sup>2</sup>).
+         * @param[out] a12 array of arc lengths between point 1 and point 2
+         *   (degrees); this may be null.
+         * @exception GeographicErr if an array needed for \e outmask is null
+         *   or shorter than \e lat1.
+         *
+         * The number of problems is the length of \e lat1.  Only the output
+         * arrays selected by \e outmask are accessed; the others may be
+         * null.  The arrays are pinned and passed directly to
+         * GeographicLib::Geodesic::DirectBatch so that the whole batch is
+         * solved with a single transition to unmanaged code.
+         **********************************************************************/
+        void DirectBatch(array<double>^ lat1, array<double>^ lon1,
+                         array<double>^ azi1, array<double>^ s12,
+                         Geodesic::mask outmask,
+                         array<double>^ lat2, array<double>^ lon2,
+                         array<double>^ azi2, array<double>^ m12,
+                         array<double>^ M12, array<double>^ M21,
+                         array<double>^ S12, array<double>^ a12);
+
+        /**
+         * See the documentation for Geodesic::DirectBatch.
+         **********************************************************************/
+        void DirectBatch(array<double>^ lat1, array<double>^ lon1,
+                         array<double>^ azi1, array<double>^ s12,
+                         array<double>^ lat2, array<double>^ lon2,
+                         array<double>^ azi2);
+
+        /**
+         * Solve many inverse geodesic problems.
+         *
+         * @param[in] lat1 array of latitudes of point 1 (degrees).
+         * @param[in] lon1 array of longitudes of point 1 (degrees).
+         * @param[in] lat2 array of latitudes of point 2 (degrees).
+         * @param[in] lon2 array of longitudes of point 2 (degrees).
+         * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+         *   specifying which of the following arrays should be set.
+         * @param[out] s12 array of distances between point 1 and point 2
+         *   (meters).
+         * @param[out] azi1 array of azimuths at point 1 (degrees).
+         * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+         * @param[out] m12 array of reduced lengths (meters).
+         * @param[out] M12 array of geodesic scales of point 2 relative to
+         *   point 1 (dimensionless).
+         * @param[out] M21 array of geodesic scales of point 1 relative to
+         *   point 2 (dimensionless).
+         * @param[out] S12 array of areas under the geodesics
+         *   (meters<sup>2</sup>).
+         * @param[out] a12 array of arc lengths between point 1 and point 2
+         *   (degrees); this may be null.
+         * @exception GeographicErr if an array needed for \e outmask is null
+         *   or shorter than \e lat1.
+         *
+         * The number of problems is the length of \e lat1.  Only the output
+         * arrays selected by \e outmask are accessed; the others may be
+         * null.  The arrays are pinned and passed directly to
+         * GeographicLib::Geodesic::InverseBatch so that the whole batch is
+         * solved with a single transition to unmanaged code.
+         **********************************************************************/
+        void InverseBatch(array<double>^ lat1, array<double>^ lon1,
+                          array<double>^ lat2, array<double>^ lon2,
+                          Geodesic::mask outmask,
+                          array<double>^ s12, array<double>^ azi1,
+                          array<double>^ azi2, array<double>^ m12,
+                          array<double>^ M12, array<double>^ M21,
+                          array<double>^ S12, array<double>^ a12);
+
+        /**
+         * See the documentation for Geodesic::InverseBatch.
+         **********************************************************************/
+        void InverseBatch(array<double>^ lat1, array<double>^ lon1,
+                          array<double>^ lat2, array<double>^ lon2,
+                          array<double>^ s12, array<double>^ azi1,
+                          array<double>^ azi2);
+        ///@}
+
         /** \name Interface to GeodesicLine.
          **********************************************************************/
         ///@{
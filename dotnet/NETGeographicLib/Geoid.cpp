@@ -92,6 +92,26 @@ double Geoid::Height(double lat, double lon)
     }
 }
 
+//*****************************************************************************
+void Geoid::Height(array<double>^ lat, array<double>^ lon, array<double>^ h)
+{
+    BatchArray::Check( lat, 0, false, "lat" );
+    int n = lat->Length;
+    BatchArray::Check( lon, n, false, "lon" );
+    BatchArray::Check( h, n, false, "h" );
+    if ( n == 0 ) return;
+    pin_ptr<double> plat = BatchArray::First( lat ),
+        plon = BatchArray::First( lon ), ph = BatchArray::First( h );
+    try
+    {
+        m_pGeoid->operator()( n, plat, plon, ph );
+    }
+    catch ( const std::exception& err )
+    {
+        throw gcnew GeographicErr( err.what() );
+    }
+}
+
 //*****************************************************************************
 double Geoid::ConvertHeight(double lat, double lon, double h,
                             ConvertFlag d)
@@ -190,6 +190,24 @@ namespace NETGeographicLib
          **********************************************************************/
         double Height(double lat, double lon);
 
+        /**
+         * Compute the geoid heights at arrays of points.
+         *
+         * @param[in] lat array of latitudes (degrees).
+         * @param[in] lon array of longitudes (degrees).
+         * @param[out] h array of geoid heights (meters).
+         * @exception GeographicErr if there's a problem reading the data or if
+         *   an array is null or shorter than \e lat.
+         *
+         * The number of points is the length of \e lat.  The arrays are
+         * pinned and passed to the batch version of
+         * GeographicLib::Geoid::operator()() in a single transition to
+         * unmanaged code.  This gives the same results as calling Height for
+         * each point, but it doesn't change the single-cell cache and it
+         * reads the data for spatially coherent sets of points efficiently.
+         **********************************************************************/
+        void Height(array<double>^ lat, array<double>^ lon, array<double>^ h);
+
         /**
          * Convert a height above the geoid to a height above the ellipsoid and
          * vice versa.
@@ -83,6 +83,83 @@ double GravityModel::GeoidHeight(double lat, double lon)
     return m_pGravityModel->GeoidHeight( lat, lon );
 }
 
+//*****************************************************************************
+void GravityModel::GravityBatch(array<double>^ lat, array<double>^ lon,
+                                array<double>^ h, array<double>^ gx,
+                                array<double>^ gy, array<double>^ gz,
+                                array<double>^ W)
+{
+    BatchArray::Check( lat, 0, false, "lat" );
+    int n = lat->Length;
+    BatchArray::Check( lon, n, false, "lon" );
+    BatchArray::Check( h, n, false, "h" );
+    BatchArray::Check( gx, n, false, "gx" );
+    BatchArray::Check( gy, n, false, "gy" );
+    BatchArray::Check( gz, n, false, "gz" );
+    BatchArray::Check( W, n, true, "W" );
+    if ( n == 0 ) return;
+    pin_ptr<double> plat = BatchArray::First( lat ),
+        plon = BatchArray::First( lon ), ph = BatchArray::First( h ),
+        pgx = BatchArray::First( gx ), pgy = BatchArray::First( gy ),
+        pgz = BatchArray::First( gz ), pW = BatchArray::First( W );
+    m_pGravityModel->GravityBatch( n, plat, plon, ph, pgx, pgy, pgz, pW );
+}
+
+//*****************************************************************************
+void GravityModel::DisturbanceBatch(array<double>^ lat, array<double>^ lon,
+                                    array<double>^ h, array<double>^ deltax,
+                                    array<double>^ deltay,
+                                    array<double>^ deltaz,
+                                    array<double>^ T)
+{
+    BatchArray::Check( lat, 0, false, "lat" );
+    int n = lat->Length;
+    BatchArray::Check( lon, n, false, "lon" );
+    BatchArray::Check( h, n, false, "h" );
+    BatchArray::Check( deltax, n, false, "deltax" );
+    BatchArray::Check( deltay, n, false, "deltay" );
+    BatchArray::Check( deltaz, n, false, "deltaz" );
+    BatchArray::Check( T, n, true, "T" );
+    if ( n == 0 ) return;
+    pin_ptr<double> plat = BatchArray::First( lat ),
+        plon = BatchArray::First( lon ), ph = BatchArray::First( h ),
+        pdx = BatchArray::First( deltax ), pdy = BatchArray::First( deltay ),
+        pdz = BatchArray::First( deltaz ), pT = BatchArray::First( T );
+    m_pGravityModel->DisturbanceBatch( n, plat, plon, ph, pdx, pdy, pdz, pT );
+}
+
+//*****************************************************************************
+void GravityModel::GeoidHeightBatch(array<double>^ lat, array<double>^ lon,
+                                    array<double>^ N)
+{
+    BatchArray::Check( lat, 0, false, "lat" );
+    int n = lat->Length;
+    BatchArray::Check( lon, n, false, "lon" );
+    BatchArray::Check( N, n, false, "N" );
+    if ( n == 0 ) return;
+    pin_ptr<double> plat = BatchArray::First( lat ),
+        plon = BatchArray::First( lon ), pN = BatchArray::First( N );
+    m_pGravityModel->GeoidHeightBatch( n, plat, plon, pN );
+}
+
+//*****************************************************************************
+void GravityModel::DeflectionBatch(array<double>^ lat, array<double>^ lon,
+                                   array<double>^ h, array<double>^ xi,
+                                   array<double>^ eta)
+{
+    BatchArray::Check( lat, 0, false, "lat" );
+    int n = lat->Length;
+    BatchArray::Check( lon, n, false, "lon" );
+    BatchArray::Check( h, n, false, "h" );
+    BatchArray::Check( xi, n, false, "xi" );
+    BatchArray::Check( eta, n, false, "eta" );
+    if ( n == 0 ) return;
+    pin_ptr<double> plat = BatchArray::First( lat ),
+        plon = BatchArray::First( lon ), ph = BatchArray::First( h ),
+        pxi = BatchArray::First( xi ), peta = BatchArray::First( eta );
+    m_pGravityModel->DeflectionBatch( n, plat, plon, ph, pxi, peta );
+}
+
 //*****************************************************************************
 void GravityModel::SphericalAnomaly(double lat, double lon, double h,
         [System::Runtime::InteropServices::Out] double% Dg01,
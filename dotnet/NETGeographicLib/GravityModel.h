@@ -237,6 +237,92 @@ namespace NETGeographicLib
          **********************************************************************/
         double GeoidHeight(double lat, double lon);
 
+        /**
+         * Evaluate the gravity at arrays of points.
+         *
+         * @param[in] lat array of geographic latitudes (degrees).
+         * @param[in] lon array of geographic longitudes (degrees).
+         * @param[in] h array of heights above the ellipsoid (meters).
+         * @param[out] gx array of easterly components of the acceleration
+         *   (m s<sup>&minus;2</sup>).
+         * @param[out] gy array of northerly components of the acceleration
+         *   (m s<sup>&minus;2</sup>).
+         * @param[out] gz array of upward components of the acceleration
+         *   (m s<sup>&minus;2</sup>).
+         * @param[out] W array of the sums of the gravitational and centrifugal
+         *   potentials (m<sup>2</sup> s<sup>&minus;2</sup>); this may be null.
+         * @exception GeographicErr if an array is null (when not allowed) or
+         *   shorter than \e lat.
+         *
+         * The number of points is the length of \e lat.  The arrays are
+         * pinned and passed to GeographicLib::GravityModel::GravityBatch in a
+         * single transition to unmanaged code.  Points which lie on a common
+         * circle (the same \e lat and \e h) are evaluated with a
+         * GravityCircle, which is much faster for gridded data.
+         **********************************************************************/
+        void GravityBatch(array<double>^ lat, array<double>^ lon,
+                          array<double>^ h, array<double>^ gx,
+                          array<double>^ gy, array<double>^ gz,
+                          array<double>^ W);
+
+        /**
+         * Evaluate the gravity disturbance vector at arrays of points.
+         *
+         * @param[in] lat array of geographic latitudes (degrees).
+         * @param[in] lon array of geographic longitudes (degrees).
+         * @param[in] h array of heights above the ellipsoid (meters).
+         * @param[out] deltax array of easterly components of the disturbance
+         *   vector (m s<sup>&minus;2</sup>).
+         * @param[out] deltay array of northerly components of the disturbance
+         *   vector (m s<sup>&minus;2</sup>).
+         * @param[out] deltaz array of upward components of the disturbance
+         *   vector (m s<sup>&minus;2</sup>).
+         * @param[out] T array of the disturbing potentials (m<sup>2</sup>
+         *   s<sup>&minus;2</sup>); this may be null.
+         * @exception GeographicErr if an array is null (when not allowed) or
+         *   shorter than \e lat.
+         *
+         * See GravityBatch for the treatment of the arrays.
+         **********************************************************************/
+        void DisturbanceBatch(array<double>^ lat, array<double>^ lon,
+                              array<double>^ h, array<double>^ deltax,
+                              array<double>^ deltay, array<double>^ deltaz,
+                              array<double>^ T);
+
+        /**
+         * Evaluate the geoid height at arrays of points.
+         *
+         * @param[in] lat array of geographic latitudes (degrees).
+         * @param[in] lon array of geographic longitudes (degrees).
+         * @param[out] N array of the heights of the geoid above the
+         *   ReferenceEllipsoid() (meters).
+         * @exception GeographicErr if an array is null or shorter than \e
+         *   lat.
+         *
+         * See GravityBatch for the treatment of the arrays.
+         **********************************************************************/
+        void GeoidHeightBatch(array<double>^ lat, array<double>^ lon,
+                              array<double>^ N);
+
+        /**
+         * Evaluate the deflection of the vertical at arrays of points.
+         *
+         * @param[in] lat array of geographic latitudes (degrees).
+         * @param[in] lon array of geographic longitudes (degrees).
+         * @param[in] h array of heights above the ellipsoid (meters).
+         * @param[out] xi array of northerly components of the deflection of
+         *   the vertical (degrees).
+         * @param[out] eta array of easterly components of the deflection of
+         *   the vertical (degrees).
+         * @exception GeographicErr if an array is null or shorter than \e
+         *   lat.
+         *
+         * See GravityBatch for the treatment of the arrays.
+         **********************************************************************/
+        void DeflectionBatch(array<double>^ lat, array<double>^ lon,
+                             array<double>^ h, array<double>^ xi,
+                             array<double>^ eta);
+
         /**
          * Evaluate the components of the gravity anomaly vector using the
          * spherical approximation.
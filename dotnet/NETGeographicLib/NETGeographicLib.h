@@ -154,6 +154,37 @@ namespace NETGeographicLib
         {   return gcnew System::String( s.c_str() ); }
     };
 
+    // Support for the batch functions which pass managed arrays to the C++
+    // batch routines.  The arrays are pinned (not copied) for the duration of
+    // a single call into the unmanaged code.
+    ref class BatchArray
+    {
+        BatchArray() {}
+    public:
+        // Throw a GeographicErr unless the array has at least n elements; a
+        // null array is allowed if optional is true.
+        template <typename T>
+        static void Check( array<T>^ a, int n, bool optional,
+                           System::String^ name )
+        {
+            if ( a == nullptr ) {
+                if ( !optional )
+                    throw gcnew GeographicErr( name + " must not be null" );
+            } else if ( a->Length < n )
+                throw gcnew GeographicErr( name + " has fewer than " +
+                                           n.ToString() + " elements" );
+        }
+        // A pointer to the first element to be assigned to a pin_ptr; this
+        // is null if the array is null.  The array must not be empty.
+        template <typename T>
+        static interior_ptr<T> First( array<T>^ a )
+        {
+            interior_ptr<T> p = nullptr;
+            if ( a != nullptr ) p = &a[0];
+            return p;
+        }
+    };
+
     /**
      * @brief Physical constants
      *
@@ -60,6 +60,76 @@ void UTMUPS::Forward(double lat, double lon,
     }
 }
 
+//*****************************************************************************
+void UTMUPS::ForwardBatch(array<double>^ lat, array<double>^ lon,
+                          array<int>^ zone, array<bool>^ northp,
+                          array<double>^ x, array<double>^ y,
+                          array<double>^ gamma, array<double>^ k,
+                          int setzone, bool mgrslimits)
+{
+    BatchArray::Check( lat, 0, false, "lat" );
+    int n = lat->Length;
+    BatchArray::Check( lon, n, false, "lon" );
+    BatchArray::Check( zone, n, false, "zone" );
+    BatchArray::Check( northp, n, false, "northp" );
+    BatchArray::Check( x, n, false, "x" );
+    BatchArray::Check( y, n, false, "y" );
+    BatchArray::Check( gamma, n, true, "gamma" );
+    BatchArray::Check( k, n, true, "k" );
+    if ( n == 0 ) return;
+    pin_ptr<double> plat = BatchArray::First( lat ),
+        plon = BatchArray::First( lon ), px = BatchArray::First( x ),
+        py = BatchArray::First( y ), pgamma = BatchArray::First( gamma ),
+        pk = BatchArray::First( k );
+    pin_ptr<int> pzone = BatchArray::First( zone );
+    pin_ptr<bool> pnorthp = BatchArray::First( northp );
+    try
+    {
+        GeographicLib::UTMUPS::ForwardBatch( n, plat, plon, pzone, pnorthp,
+                                             px, py, pgamma, pk,
+                                             setzone, mgrslimits );
+    }
+    catch ( const std::exception& err )
+    {
+        throw gcnew GeographicErr( err.what() );
+    }
+}
+
+//*****************************************************************************
+void UTMUPS::ReverseBatch(array<int>^ zone, array<bool>^ northp,
+                          array<double>^ x, array<double>^ y,
+                          array<double>^ lat, array<double>^ lon,
+                          array<double>^ gamma, array<double>^ k,
+                          bool mgrslimits)
+{
+    BatchArray::Check( zone, 0, false, "zone" );
+    int n = zone->Length;
+    BatchArray::Check( northp, n, false, "northp" );
+    BatchArray::Check( x, n, false, "x" );
+    BatchArray::Check( y, n, false, "y" );
+    BatchArray::Check( lat, n, false, "lat" );
+    BatchArray::Check( lon, n, false, "lon" );
+    BatchArray::Check( gamma, n, true, "gamma" );
+    BatchArray::Check( k, n, true, "k" );
+    if ( n == 0 ) return;
+    pin_ptr<int> pzone = BatchArray::First( zone );
+    pin_ptr<bool> pnorthp = BatchArray::First( northp );
+    pin_ptr<double> px = BatchArray::First( x ),
+        py = BatchArray::First( y ), plat = BatchArray::First( lat ),
+        plon = BatchArray::First( lon ), pgamma = BatchArray::First( gamma ),
+        pk = BatchArray::First( k );
+    try
+    {
+        GeographicLib::UTMUPS::ReverseBatch( n, pzone, pnorthp, px, py,
+                                             plat, plon, pgamma, pk,
+                                             mgrslimits );
+    }
+    catch ( const std::exception& err )
+    {
+        throw gcnew GeographicErr( err.what() );
+    }
+}
+
 //*****************************************************************************
 void UTMUPS::Reverse(int zone, bool northp, double x, double y,
                     [System::Runtime::InteropServices::Out] double% lat,
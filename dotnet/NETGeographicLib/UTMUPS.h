@@ -260,6 +260,69 @@ namespace NETGeographicLib
                     [System::Runtime::InteropServices::Out] double% lon,
                     bool mgrslimits);
 
+        /**
+         * Forward projection of arrays of points, from geographic to UTM/UPS.
+         *
+         * @param[in] lat array of latitudes (degrees).
+         * @param[in] lon array of longitudes (degrees).
+         * @param[out] zone array of UTM zones (zero means UPS).
+         * @param[out] northp array of hemispheres (true means north, false
+         *   means south).
+         * @param[out] x array of eastings (meters).
+         * @param[out] y array of northings (meters).
+         * @param[out] gamma array of meridian convergences (degrees); this may
+         *   be null.
+         * @param[out] k array of scales of the projection; this may be null.
+         * @param[in] setzone zone override (use ZoneSpec.STANDARD as default).
+         * @param[in] mgrslimits if true enforce the stricter MGRS limits on the
+         *   coordinates.
+         * @exception GeographicErr if \e setzone is illegal or if an array is
+         *   null (when not allowed) or shorter than \e lat.
+         *
+         * The number of points is the length of \e lat.  This is equivalent
+         * to calling UTMUPS::Forward for each point, except that a point which
+         * would be rejected gives \e zone = ZoneSpec.INVALID and NaNs for \e
+         * x, \e y, \e gamma, and \e k instead of throwing an exception.  The
+         * arrays are pinned and passed to GeographicLib::UTMUPS::ForwardBatch
+         * in a single transition to unmanaged code.
+         **********************************************************************/
+        static void ForwardBatch(array<double>^ lat, array<double>^ lon,
+                                 array<int>^ zone, array<bool>^ northp,
+                                 array<double>^ x, array<double>^ y,
+                                 array<double>^ gamma, array<double>^ k,
+                                 int setzone, bool mgrslimits);
+
+        /**
+         * Reverse projection of arrays of points, from UTM/UPS to geographic.
+         *
+         * @param[in] zone array of UTM zones (zero means UPS).
+         * @param[in] northp array of hemispheres (true means north, false
+         *   means south).
+         * @param[in] x array of eastings (meters).
+         * @param[in] y array of northings (meters).
+         * @param[out] lat array of latitudes (degrees).
+         * @param[out] lon array of longitudes (degrees).
+         * @param[out] gamma array of meridian convergences (degrees); this may
+         *   be null.
+         * @param[out] k array of scales of the projection; this may be null.
+         * @param[in] mgrslimits if true enforce the stricter MGRS limits on the
+         *   coordinates.
+         * @exception GeographicErr if an array is null (when not allowed) or
+         *   shorter than \e zone.
+         *
+         * The number of points is the length of \e zone.  This is equivalent
+         * to calling UTMUPS::Reverse for each point, except that a point which
+         * would be rejected gives NaNs for the results instead of throwing an
+         * exception.  The arrays are pinned and passed to
+         * GeographicLib::UTMUPS::ReverseBatch in a single transition to
+         * unmanaged code.
+         **********************************************************************/
+        static void ReverseBatch(array<int>^ zone, array<bool>^ northp,
+                                 array<double>^ x, array<double>^ y,
+                                 array<double>^ lat, array<double>^ lon,
+                                 array<double>^ gamma, array<double>^ k,
+                                 bool mgrslimits);
+
         /**
          * Transfer UTM/UPS coordinated from one zone to another.
          *
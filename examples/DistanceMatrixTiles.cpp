@@ -0,0 +1,275 @@
+// Compute a large matrix of geodesic distances as a set of tiles which can
+// be spread over several machines and which survive interruptions.
+//
+// The n x m matrix for the points in points1 (rows) and points2 (columns)
+// is divided into tiles of tilesize x tilesize elements (smaller at the
+// right and bottom edges).  Tile t covers rows [r * tilesize, (r + 1) *
+// tilesize) and columns [c * tilesize, (c + 1) * tilesize) where r = t / nc,
+// c = t % nc, and nc is the number of tiles across the matrix; so the tile
+// ids depend only on n, m, and tilesize.  Each tile is computed with
+// DistanceMatrix and is written to its own file, tile-<t>.dat, in the
+// output directory.  A tile is written to a temporary file which is renamed
+// when it's complete; so a tile file is either complete or absent.  This
+// makes the tile files the checkpoints of the job: rerunning a command skips
+// the tiles which have already been computed.
+//
+// Commands:
+//
+// run: compute the tiles for shard k of K (default 0 of 1), i.e., the tiles
+//   with t % K == k.  Start one such process for each k on the nodes of a
+//   cluster (with the output directory on a shared file system or with the
+//   tile files collected afterwards).
+//
+// status: list the ids of the tiles which are missing (on standard output);
+//   the exit status is 1 if there are missing tiles.
+//
+// merge: combine the tiles into a single file holding the matrix as n x m
+//   big-endian doubles in row-major order.  This reads a band of tiles at a
+//   time and so needs little memory.
+//
+// The points files contain one point per line as "lat lon" in decimal
+// degrees.  Each tile file consists of a 48-byte header (the magic string
+// "GLDMTILE" followed by a checksum of the points, n, m, tilesize, and t as
+// big-endian 64-bit integers) followed by the distances in meters for the
+// tile as big-endian doubles in row-major order.  The header is checked
+// when a tile is reused; a tile computed for different points or a
+// different tiling is recomputed by run and rejected by merge.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <GeographicLib/DistanceMatrix.hpp>
+#include <GeographicLib/Utility.hpp>
+
+using namespace std;
+using namespace GeographicLib;
+
+typedef Math::real real;
+typedef unsigned long long u64;
+
+static const char magic[] = "GLDMTILE";
+static const size_t headersize = 48;
+
+// Read "lat lon" pairs, one per line.
+static void readpoints(const string& filename,
+                       vector<real>& lat, vector<real>& lon) {
+  ifstream file(filename.c_str());
+  if (!file.good())
+    throw GeographicErr("Cannot open " + filename);
+  string line;
+  for (size_t k = 1; getline(file, line); ++k) {
+    istringstream str(line);
+    string a, b, c;
+    if (!(str >> a)) continue;  // skip blank lines
+    if (!(str >> b) || (str >> c))
+      throw GeographicErr("Bad line " + Utility::str(k) + " of " + filename);
+    real x = Utility::val<real>(a), y = Utility::val<real>(b);
+    if (!(abs(x) <= 90))
+      throw GeographicErr("Bad latitude on line " + Utility::str(k) + " of "
+                          + filename);
+    lat.push_back(x);
+    lon.push_back(y);
+  }
+}
+
+// FNV-1a hash of the points
+static u64 checksum(u64 h, const vector<real>& lat, const vector<real>& lon) {
+  for (size_t i = 0; i < lat.size(); ++i) {
+    double v[2] = { double(lat[i]), double(lon[i]) };
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(v);
+    for (size_t k = 0; k < sizeof(v); ++k)
+      h = (h ^ p[k]) * 0x100000001b3ULL;
+  }
+  return h;
+}
+
+class Tiling {
+public:
+  vector<real> lat1, lon1, lat2, lon2;
+  u64 n, m, size, nr, nc, ntiles, sum;
+  string dir;
+  Tiling(const string& points1, const string& points2, u64 tilesize,
+         const string& directory)
+    : size(tilesize), dir(directory) {
+    if (size == 0)
+      throw GeographicErr("Tile size must be positive");
+    readpoints(points1, lat1, lon1);
+    readpoints(points2, lat2, lon2);
+    n = lat1.size(); m = lat2.size();
+    if (n == 0 || m == 0)
+      throw GeographicErr("No points");
+    nr = (n + size - 1) / size;
+    nc = (m + size - 1) / size;
+    ntiles = nr * nc;
+    sum = checksum(checksum(0xcbf29ce484222325ULL, lat1, lon1), lat2, lon2);
+  }
+  // The rows [i0, i1) and columns [j0, j1) of tile t
+  void extent(u64 t, u64& i0, u64& i1, u64& j0, u64& j1) const {
+    i0 = (t / nc) * size; i1 = min(n, i0 + size);
+    j0 = (t % nc) * size; j1 = min(m, j0 + size);
+  }
+  string filename(u64 t, bool temp = false) const {
+    ostringstream str;
+    str << dir << "/tile-" << setfill('0') << setw(8) << t
+        << (temp ? ".tmp" : ".dat");
+    return str.str();
+  }
+  void writeheader(ostream& str, u64 t) const {
+    u64 header[5] = { sum, n, m, size, t };
+    str.write(magic, 8);
+    Utility::writearray<u64, u64, true>(str, header, 5);
+  }
+  // Open tile t positioned at the start of the data; return false if the
+  // tile is absent or doesn't match.
+  bool open(u64 t, ifstream& str) const {
+    str.open(filename(t).c_str(), ios::binary);
+    if (!str.good()) return false;
+    u64 i0, i1, j0, j1;
+    extent(t, i0, i1, j0, j1);
+    str.seekg(0, ios::end);
+    if (u64(str.tellg()) != headersize + 8 * (i1 - i0) * (j1 - j0))
+      return false;
+    str.seekg(0);
+    char m0[8];
+    u64 header[5];
+    str.read(m0, 8);
+    Utility::readarray<u64, u64, true>(str, header, 5);
+    return memcmp(m0, magic, 8) == 0 && header[0] == sum &&
+      header[1] == n && header[2] == m && header[3] == size && header[4] == t;
+  }
+};
+
+int main(int argc, const char* const argv[]) {
+  // Hardwired arguments:
+  // 1 = the command, run, status, or merge
+  // 2 = the points for the rows
+  // 3 = the points for the columns
+  // 4 = the tile size
+  // 5 = the directory for the tiles
+  // for run:
+  //   6, 7 = (optional) the shard k and the number of shards K (default 0 1)
+  //   8 = (optional) number of threads (default = hardware concurrency)
+  // for merge:
+  //   6 = output file
+  string command(argc > 1 ? argv[1] : "");
+  if (!((command == "run" && (argc == 6 || argc == 8 || argc == 9)) ||
+        (command == "status" && argc == 6) ||
+        (command == "merge" && argc == 7))) {
+    cerr << "Usage:\n"
+         << argv[0] << " run points1 points2 tilesize dir [k K [threads]]\n"
+         << argv[0] << " status points1 points2 tilesize dir\n"
+         << argv[0] << " merge points1 points2 tilesize dir output\n";
+    return 1;
+  }
+  try {
+    Utility::set_digits();
+    Tiling tiles(argv[2], argv[3], Utility::val<u64>(string(argv[4])),
+                 argv[5]);
+    if (command == "run") {
+      u64
+        k = argc > 6 ? Utility::val<u64>(string(argv[6])) : 0,
+        K = argc > 7 ? Utility::val<u64>(string(argv[7])) : 1;
+      unsigned threads =
+        argc > 8 ? Utility::val<unsigned>(string(argv[8])) : 0;
+      if (!(K > 0 && k < K))
+        throw GeographicErr("Need 0 <= k < K");
+      const DistanceMatrix dm(Geodesic::WGS84(), threads);
+      vector<real> s12;
+      u64 computed = 0, skipped = 0;
+      for (u64 t = k; t < tiles.ntiles; t += K) {
+        {
+          ifstream str;
+          if (tiles.open(t, str)) {
+            ++skipped;
+            continue;
+          }
+        }
+        u64 i0, i1, j0, j1;
+        tiles.extent(t, i0, i1, j0, j1);
+        s12.resize(size_t((i1 - i0) * (j1 - j0)));
+        dm.Distances(size_t(i1 - i0),
+                     tiles.lat1.data() + i0, tiles.lon1.data() + i0,
+                     size_t(j1 - j0),
+                     tiles.lat2.data() + j0, tiles.lon2.data() + j0,
+                     s12.data());
+        string temp = tiles.filename(t, true), name = tiles.filename(t);
+        {
+          ofstream str(temp.c_str(), ios::binary);
+          if (!str.good())
+            throw GeographicErr("Cannot open " + temp);
+          tiles.writeheader(str, t);
+          Utility::writearray<double, real, true>(str, s12);
+          str.close();
+          if (!str)
+            throw GeographicErr("Failure writing " + temp);
+        }
+        if (rename(temp.c_str(), name.c_str()) != 0)
+          throw GeographicErr("Cannot rename " + temp + " to " + name);
+        ++computed;
+      }
+      cerr << "Shard " << k << " of " << K << ": computed " << computed
+           << ", reused " << skipped << " of " << tiles.ntiles
+           << " tiles\n";
+    } else if (command == "status") {
+      u64 missing = 0;
+      for (u64 t = 0; t < tiles.ntiles; ++t) {
+        ifstream str;
+        if (!tiles.open(t, str)) {
+          cout << t << "\n";
+          ++missing;
+        }
+      }
+      cerr << tiles.ntiles - missing << " of " << tiles.ntiles
+           << " tiles complete\n";
+      return missing ? 1 : 0;
+    } else {
+      string filename(argv[6]);
+      ofstream out(filename.c_str(), ios::binary);
+      if (!out.good())
+        throw GeographicErr("Cannot open " + filename);
+      vector<char> buf;
+      // Process a band of tiles at a time; the rows of the band are put
+      // together from the rows of the tiles.  The data is copied as is since
+      // the tiles and the output are both big-endian.
+      for (u64 r = 0; r < tiles.nr; ++r) {
+        vector<ifstream> band(size_t(tiles.nc));
+        for (u64 c = 0; c < tiles.nc; ++c) {
+          u64 t = r * tiles.nc + c;
+          if (!tiles.open(t, band[size_t(c)]))
+            throw GeographicErr("Tile " + Utility::str(t) +
+                                " is missing or invalid");
+        }
+        u64 rows = min(tiles.size, tiles.n - r * tiles.size);
+        for (u64 i = 0; i < rows; ++i) {
+          for (u64 c = 0; c < tiles.nc; ++c) {
+            buf.resize(size_t(8 * min(tiles.size, tiles.m - c * tiles.size)));
+            band[size_t(c)].read(buf.data(), buf.size());
+            out.write(buf.data(), buf.size());
+          }
+        }
+        for (u64 c = 0; c < tiles.nc; ++c)
+          if (!band[size_t(c)].good())
+            throw GeographicErr("Failure reading tile "
+                                + Utility::str(r * tiles.nc + c));
+      }
+      out.close();
+      if (!out)
+        throw GeographicErr("Failure writing " + filename);
+    }
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  catch (...) {
+    cerr << "Caught unknown exception\n";
+    return 1;
+  }
+}
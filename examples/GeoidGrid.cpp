@@ -0,0 +1,137 @@
+// Write out a global grid of geoid heights computed from a gravity model.
+// The heights are computed for a block of rows at a time using
+// GravityModel::GeoidHeightGrid (which spreads the rows over several threads
+// and uses an FFT over longitude for each row) and each block is written
+// out before the next is computed; so only a few rows are held in memory
+// and grids at any resolution can be produced.
+//
+// The output formats are
+//
+// pgm: the format used by the Geoid class, see
+//   https://geographiclib.sourceforge.io/C++/doc/geoid.html#geoidformat
+//   The rows run from north to south and the columns from 0E, the heights
+//   are stored as unsigned 16-bit big-endian integers with offset -108 m and
+//   scale 0.003 m.
+//
+// gtx: the format used by vdatum, see
+//   https://vdatum.noaa.gov/docs/gtx_info.html#dev_gtx_binary
+//   This is the format written by GeoidToGTX.  The rows run from south to
+//   north and the columns from 180W, the heights are stored as big-endian
+//   floats after a header giving the origin, spacing, and size of the grid.
+//
+// float: the layout of the pgm file with the heights stored as big-endian
+//   floats and with no header.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+#include <GeographicLib/GravityModel.hpp>
+#include <GeographicLib/Utility.hpp>
+
+using namespace std;
+using namespace GeographicLib;
+
+int main(int argc, const char* const argv[]) {
+  // Hardwired for 4 or 5 args:
+  // 1 = the gravity model (e.g., egm2008)
+  // 2 = intervals per degree
+  // 3 = the output format, pgm, gtx, or float
+  // 4 = output file
+  // 5 = (optional) number of threads (default = hardware concurrency)
+  if (!(argc == 5 || argc == 6)) {
+    cerr << "Usage: " << argv[0]
+         << " gravity-model intervals-per-degree pgm|gtx|float output "
+         << "[threads]\n";
+    return 1;
+  }
+  try {
+    typedef Math::real real;
+    Utility::set_digits();
+    string model(argv[1]), format(argv[3]), filename(argv[4]);
+    // Number of intervals per degree
+    int ndeg = Utility::val<int>(string(argv[2]));
+    unsigned threads =
+      argc == 6 ? Utility::val<unsigned>(string(argv[5])) : 0;
+    if (ndeg <= 0)
+      throw GeographicErr("Intervals per degree must be positive");
+    if (!(format == "pgm" || format == "gtx" || format == "float"))
+      throw GeographicErr("Unknown format " + format);
+    bool northfirst = format != "gtx";
+    GravityModel g(model);
+    int
+      nlat = 180 * ndeg + 1,
+      nlon = 360 * ndeg;
+    real
+      delta = 1 / real(ndeg), // Grid spacing
+      latorg = northfirst ? 90 : -90,
+      lonorg = northfirst ? 0 : -180,
+      // The pgm quantization
+      offset = -108, scale = real(0.003);
+    ofstream file(filename.c_str(), ios::binary);
+    if (!file.good())
+      throw GeographicErr("Cannot open " + filename);
+
+    // Write header
+    if (format == "pgm") {
+      char date[64];
+      time_t t = time(nullptr);
+      strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", gmtime(&t));
+      file << "P5\n"
+           << "# Geoid file in PGM format for the GeographicLib::Geoid class\n"
+           << "# Description " << g.GravityModelName() << ", "
+           << ndeg << " intervals per degree\n"
+           << "# DateTime " << date << "\n"
+           << "# Offset " << offset << "\n"
+           << "# Scale " << scale << "\n"
+           << "# Origin 90N 0E\n"
+           << "# AREA_OR_POINT Point\n"
+           << "# Vertical_Datum WGS84\n"
+           << nlon << " " << nlat << "\n"
+           << 65535 << "\n";
+    } else if (format == "gtx") {
+      real transform[] = {latorg, lonorg, delta, delta};
+      unsigned sizes[] = {unsigned(nlat), unsigned(nlon)};
+      Utility::writearray<double, real, true>(file, transform, 4);
+      Utility::writearray<unsigned, unsigned, true>(file, sizes, 2);
+    }
+
+    // Compute and write the results for nbatch latitudes at a time
+    const int nbatch = 64;
+    vector<real> N(size_t(nbatch) * nlon);
+    vector<unsigned short> P(format == "pgm" ? nlon : 0);
+    for (int ilat0 = 0; ilat0 < nlat; ilat0 += nbatch) { // Loop over batches
+      int nrows = min(nlat - ilat0, nbatch);
+      // The rows are at latitudes latorg -/+ ilat * delta; compute these in
+      // units of degrees and then intervals to avoid roundoff.
+      real lat0 = northfirst ?
+        latorg - (ilat0 / ndeg) - delta * (ilat0 % ndeg) :
+        latorg + (ilat0 / ndeg) + delta * (ilat0 % ndeg);
+      g.GeoidHeightGrid(lat0, northfirst ? -delta : delta, nrows,
+                        lonorg, delta, nlon, N.data(), threads);
+      for (int i = 0; i < nrows; ++i) { // write out data
+        const real* row = N.data() + size_t(i) * nlon;
+        if (format == "pgm") {
+          for (int j = 0; j < nlon; ++j) {
+            real p = round((row[j] - offset) / scale);
+            P[j] = (unsigned short)(max(real(0), min(real(65535), p)));
+          }
+          Utility::writearray<unsigned short, unsigned short, true>(file, P);
+        } else
+          Utility::writearray<float, real, true>(file, row, nlon);
+      }
+    } // batch loop
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  catch (...) {
+    cerr << "Caught unknown exception\n";
+    return 1;
+  }
+}
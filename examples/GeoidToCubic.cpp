@@ -0,0 +1,223 @@
+// Write out a file of the precomputed coefficients of the cubic fits used by
+// Geoid for each cell of a geoid data file.  This file can be read by Geoid
+// by setting the mode argument of the constructor to Geoid::PRECOMPUTED,
+// which saves the cost of computing the fit for each cell.  For the
+// interpolation to work, the output file must be called name.cub and be
+// placed in the same directory as name.pgm.
+//
+// The coefficients for a cell are found by evaluating the geoid height with
+// cubic interpolation at 10 points within the cell and solving for the
+// coefficients of the cubic polynomial that Geoid uses.
+//
+// The file consists of a text header and binary big-endian data:
+//   the line "GeographicLib-CubicGeoid"
+//   the comment lines of the PGM file (giving Offset, Scale, etc.)
+//   "# Coding float" or "# Coding int16"
+//   "# Quanta q0 q1 ... q9" (int16 coding only)
+//   the raster size of the PGM file, "width height"
+//   for each of the (height - 1) * width cells (in the same order as the
+//     pixels in the PGM file), 10 coefficients, either as floats or as
+//     int16 values c[i] which represent the coefficients c[i] * q[i]
+//
+// The coefficients are in the units of the pixels of the PGM file; so the
+// geoid height is Offset + Scale * (the value of the polynomial).
+
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <algorithm>
+
+#include <GeographicLib/Geoid.hpp>
+#include <GeographicLib/Utility.hpp>
+
+using namespace std;
+using namespace GeographicLib;
+typedef Math::real real;
+
+const int nterms = 10;
+
+// The terms of the cubic polynomial in the order used by Geoid
+void Monomials(real x, real y, real m[]) {
+  m[0] = 1;
+  m[1] = x; m[2] = y;
+  m[3] = x * x; m[4] = x * y; m[5] = y * y;
+  m[6] = x * x * x; m[7] = x * x * y; m[8] = x * y * y; m[9] = y * y * y;
+}
+
+real Poly(const real t[], real x, real y) {
+  real m[nterms], h = 0;
+  Monomials(x, y, m);
+  for (int i = 0; i < nterms; ++i) h += t[i] * m[i];
+  return h;
+}
+
+// Invert the n x n matrix a in place using Gauss-Jordan elimination with
+// partial pivoting.
+void Invert(vector<real>& a, int n) {
+  using std::abs;
+  vector<real> b(n * n, 0);
+  for (int i = 0; i < n; ++i) b[n * i + i] = 1;
+  for (int k = 0; k < n; ++k) {
+    int p = k;
+    for (int i = k + 1; i < n; ++i)
+      if (abs(a[n * i + k]) > abs(a[n * p + k])) p = i;
+    for (int j = 0; j < n; ++j) {
+      swap(a[n * k + j], a[n * p + j]);
+      swap(b[n * k + j], b[n * p + j]);
+    }
+    real d = a[n * k + k];
+    for (int j = 0; j < n; ++j) { a[n * k + j] /= d; b[n * k + j] /= d; }
+    for (int i = 0; i < n; ++i) {
+      if (i == k) continue;
+      real c = a[n * i + k];
+      for (int j = 0; j < n; ++j) {
+        a[n * i + j] -= c * a[n * k + j];
+        b[n * i + j] -= c * b[n * k + j];
+      }
+    }
+  }
+  a = b;
+}
+
+int main(int argc, const char* const argv[]) {
+  // Hardwired for 2 or 3 args:
+  // 1 = the geoid model (e.g., egm96-5)
+  // 2 = output file
+  // 3 = optional "int16" to store the coefficients as scaled 16-bit integers
+  if (!(argc == 3 || (argc == 4 && string(argv[3]) == "int16"))) {
+    cerr << "Usage: " << argv[0] << " geoid-name output.cub [int16]\n";
+    return 1;
+  }
+  try {
+    using std::abs;
+    using std::round;
+    Utility::set_digits();
+    string name(argv[1]), filename(argv[2]);
+    bool int16 = argc == 4;
+    // Read the data into memory
+    Geoid g(name, "", true, true);
+
+    // Copy the comments and raster size from the PGM header
+    vector<string> comments;
+    int width = 0, height = 0;
+    {
+      ifstream pgm(g.GeoidFile().c_str(), ios::binary);
+      string s;
+      getline(pgm, s);
+      while (getline(pgm, s)) {
+        if (s.empty()) continue;
+        if (s[0] == '#')
+          comments.push_back(s);
+        else {
+          istringstream is(s);
+          if (!(is >> width >> height))
+            throw GeographicErr("Error reading raster size " + g.GeoidFile());
+          break;
+        }
+      }
+    }
+    int ncells = width, nrows = height - 1;
+    real rlonres = width / real(360), rlatres = (height - 1) / real(180);
+
+    // The sample points within a cell: the points of a triangular lattice
+    // (which determines a cubic uniquely) away from the cell edges.
+    const int nsample = nterms;
+    real fx[nsample], fy[nsample];
+    vector<real> a(nterms * nterms);
+    for (int i = 0, k = 0; i <= 3; ++i)
+      for (int j = 0; i + j <= 3; ++j, ++k) {
+        fx[k] = (1 + 2 * i) / real(8);
+        fy[k] = (1 + 2 * j) / real(8);
+        Monomials(fx[k], fy[k], &a[nterms * k]);
+      }
+    Invert(a, nterms);
+
+    vector<real> lat(nsample * ncells), lon(nsample * ncells),
+      h(nsample * ncells), t(nterms * ncells);
+    // Compute the coefficients for row iy of cells
+    auto fitrow = [&](int iy) -> void {
+      for (int ix = 0; ix < ncells; ++ix)
+        for (int k = 0; k < nsample; ++k) {
+          lat[nsample * ix + k] = 90 - (iy + fy[k]) / rlatres;
+          lon[nsample * ix + k] = (ix + fx[k]) / rlonres;
+        }
+      g(nsample * ncells, &lat[0], &lon[0], &h[0]);
+      for (int ix = 0; ix < ncells; ++ix)
+        for (int i = 0; i < nterms; ++i) {
+          real c = 0;
+          for (int k = 0; k < nsample; ++k)
+            c += a[nterms * i + k] *
+              (h[nsample * ix + k] - g.Offset()) / g.Scale();
+          t[nterms * ix + i] = c;
+        }
+    };
+
+    // For int16 coding, find the range of each coefficient
+    real quanta[nterms];
+    if (int16) {
+      real tmax[nterms];
+      fill(tmax, tmax + nterms, real(0));
+      for (int iy = 0; iy < nrows; ++iy) {
+        fitrow(iy);
+        for (int ix = 0; ix < ncells; ++ix)
+          for (int i = 0; i < nterms; ++i)
+            tmax[i] = max(tmax[i], abs(t[nterms * ix + i]));
+      }
+      for (int i = 0; i < nterms; ++i)
+        quanta[i] = tmax[i] > 0 ? tmax[i] / 32767 : 1;
+    }
+
+    ofstream file(filename.c_str(), ios::binary);
+    file << "GeographicLib-CubicGeoid\n";
+    for (const string& s : comments)
+      file << s << "\n";
+    file << "# Coding " << (int16 ? "int16" : "float") << "\n";
+    if (int16) {
+      file << "# Quanta" << setprecision(17);
+      for (int i = 0; i < nterms; ++i)
+        file << " " << quanta[i];
+      file << "\n";
+    }
+    file << width << " " << height << "\n";
+
+    vector<float> tf(nterms * ncells);
+    vector<short> ts(nterms * ncells);
+    real maxerr = 0;
+    for (int iy = 0; iy < nrows; ++iy) {
+      fitrow(iy);
+      for (int ix = 0; ix < ncells; ++ix) {
+        real tq[nterms];
+        for (int i = 0; i < nterms; ++i) {
+          real c = t[nterms * ix + i];
+          if (int16) {
+            ts[nterms * ix + i] = short(round(c / quanta[i]));
+            tq[i] = ts[nterms * ix + i] * quanta[i];
+          } else {
+            tf[nterms * ix + i] = float(c);
+            tq[i] = tf[nterms * ix + i];
+          }
+        }
+        // The additional error due to the coding at the sample points
+        for (int k = 0; k < nsample; ++k)
+          maxerr = max(maxerr, abs(Poly(tq, fx[k], fy[k]) -
+                                   Poly(&t[nterms * ix], fx[k], fy[k])));
+      }
+      if (int16)
+        Utility::writearray<short, short, true>(file, ts);
+      else
+        Utility::writearray<float, float, true>(file, tf);
+    }
+    cout << "Maximum additional error " << maxerr * g.Scale() << " m\n";
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  catch (...) {
+    cerr << "Caught unknown exception\n";
+    return 1;
+  }
+}
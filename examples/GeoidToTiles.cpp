@@ -0,0 +1,211 @@
+// Write out a tiled and compressed copy of a geoid data file.  This file can
+// be read by Geoid by setting the mode argument of the constructor to
+// Geoid::TILED; the tiles are then read and decompressed as they are needed.
+// For this to work, the output file must be called name.gtl and be placed in
+// the same directory as name.pgm.
+//
+// The file consists of a text header, an index, and the compressed tiles:
+//   the line "GeographicLib-TiledGeoid"
+//   the comment lines of the PGM file (giving Offset, Scale, etc.)
+//   "# Coding rice"
+//   "# TileSize 64"
+//   the raster size of the PGM file, "width height"
+//   the maxval of the PGM file followed by a single newline
+//   ntiles + 1 big-endian 64-bit offsets, the first ntiles give the start of
+//     each tile relative to the end of the index (the tiles are in row-major
+//     order with ceil(width/64) tiles in each row) and the last gives the
+//     total size of the tiles
+//   the compressed tiles
+//
+// Each 64 x 64 tile (truncated at the east and south edges of the data) is
+// compressed as a bit stream.  Each row of the tile is coded as the Rice
+// parameter k (5 bits) followed by the residuals for the pixels in the row.
+// The residual is the value of the pixel minus the prediction w + n - nw
+// (where w, n, and nw are the neighboring pixels in the tile to the west,
+// north, and northwest; in the first row the prediction is w and in the first
+// column it is n) modulo 2^16 (for 16-bit pixels).  This is mapped to an
+// unsigned number u by interleaving positive and negative values (0, -1, 1,
+// -2, ...) and u is coded as q = u >> k in unary (q ones followed by a zero)
+// followed by the low k bits of u; if q >= 24, u is coded instead as 24 ones
+// followed by u in 16 bits.  k is chosen to minimize the size of the row.
+// The bits are packed most significant first and each tile is padded to a
+// whole number of bytes.  The compressed file is several times smaller than
+// the PGM file; the ratio depends on the roughness of the data.
+
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <algorithm>
+
+#include <GeographicLib/Utility.hpp>
+
+using namespace std;
+using namespace GeographicLib;
+
+const int tilesize = 64;
+const unsigned escape = 24;
+
+// Append bits to a byte buffer, most significant first
+class BitWriter {
+  vector<unsigned char>& _buf;
+  unsigned long long _acc;
+  unsigned _nbits;
+public:
+  BitWriter(vector<unsigned char>& buf) : _buf(buf), _acc(0), _nbits(0) {}
+  void put(unsigned long long v, unsigned k) {
+    for (unsigned i = k; i-- > 0;) {
+      _acc = (_acc << 1) | ((v >> i) & 1);
+      if (++_nbits == 8) {
+        _buf.push_back((unsigned char)(_acc));
+        _acc = 0; _nbits = 0;
+      }
+    }
+  }
+  void flush() { if (_nbits) put(0, 8 - _nbits); }
+};
+
+// Compress the nx x ny block of pixels (with row stride tilesize) at data
+void EncodeTile(const vector<unsigned>& data, int nx, int ny, unsigned wid,
+                vector<unsigned char>& buf) {
+  const unsigned long long mask = (1ULL << wid) - 1;
+  BitWriter w(buf);
+  vector<unsigned long long> u(nx);
+  for (int y = 0; y < ny; ++y) {
+    const unsigned* row = data.data() + y * tilesize;
+    const unsigned* prev = y ? row - tilesize : row;
+    for (int x = 0; x < nx; ++x) {
+      unsigned long long
+        p = y == 0 ? (x == 0 ? 0 : row[x-1]) :
+        (x == 0 ? prev[0] :
+         (unsigned long long)(row[x-1]) + prev[x] - prev[x-1]),
+        d = (row[x] - p) & mask;
+      u[x] = ((d << 1) & mask) ^ (d >> (wid - 1) ? mask : 0);
+    }
+    // Find the Rice parameter giving the fewest bits
+    unsigned kbest = 0;
+    unsigned long long best = 0;
+    for (unsigned k = 0; k < wid; ++k) {
+      unsigned long long bits = 0;
+      for (int x = 0; x < nx; ++x) {
+        unsigned long long q = u[x] >> k;
+        bits += q < escape ? q + 1 + k : escape + wid;
+      }
+      if (k == 0 || bits < best) { best = bits; kbest = k; }
+    }
+    w.put(kbest, 5);
+    for (int x = 0; x < nx; ++x) {
+      unsigned long long q = u[x] >> kbest;
+      if (q < escape) {
+        w.put((1ULL << (q + 1)) - 2, unsigned(q) + 1);
+        w.put(u[x], kbest);
+      } else {
+        w.put((1ULL << escape) - 1, escape);
+        w.put(u[x], wid);
+      }
+    }
+  }
+  w.flush();
+}
+
+int main(int argc, const char* const argv[]) {
+  // Hardwired for 2 args:
+  // 1 = the PGM geoid data file (e.g., egm2008-1.pgm)
+  // 2 = the output file (e.g., egm2008-1.gtl)
+  if (argc != 3) {
+    cerr << "Usage: " << argv[0] << " input.pgm output.gtl\n";
+    return 1;
+  }
+  try {
+    string infile(argv[1]), outfile(argv[2]);
+    ifstream in(infile.c_str(), ios::binary);
+    if (!in.good())
+      throw GeographicErr("Cannot open " + infile);
+    string s;
+    vector<string> comments;
+    if (!(getline(in, s) && s == "P5"))
+      throw GeographicErr("File not in PGM format " + infile);
+    int width = 0, height = 0;
+    while (getline(in, s)) {
+      if (s.empty())
+        continue;
+      if (s[0] == '#')
+        comments.push_back(s);
+      else {
+        istringstream is(s);
+        if (!(is >> width >> height))
+          throw GeographicErr("Error reading raster size " + infile);
+        break;
+      }
+    }
+    unsigned long long maxval;
+    if (!(in >> maxval && (maxval == 0xffffULL || maxval == 0xffffffffULL)))
+      throw GeographicErr("Unsupported maxval " + infile);
+    in.get();                   // the whitespace after maxval
+    if (width <= 0 || height <= 0)
+      throw GeographicErr("Bad raster size " + infile);
+    const unsigned wid = maxval == 0xffffULL ? 16 : 32;
+
+    ofstream out(outfile.c_str(), ios::binary);
+    if (!out.good())
+      throw GeographicErr("Cannot open " + outfile);
+    out << "GeographicLib-TiledGeoid\n";
+    for (const string& c : comments)
+      out << c << "\n";
+    out << "# Coding rice\n"
+        << "# TileSize " << tilesize << "\n"
+        << width << " " << height << "\n"
+        << maxval << "\n";
+    int
+      ntx = (width + tilesize - 1) / tilesize,
+      nty = (height + tilesize - 1) / tilesize;
+    // Write a placeholder index and fill it in at the end
+    vector<unsigned long long> index(size_t(ntx) * nty + 1, 0);
+    streamoff indexpos = out.tellp();
+    Utility::writearray<unsigned long long, unsigned long long, true>
+      (out, index);
+
+    // Read a band of tilesize rows at a time and write out its tiles
+    vector<unsigned> band(size_t(tilesize) * width), tile(tilesize * tilesize);
+    vector<unsigned char> buf;
+    unsigned long long pos = 0;
+    for (int ty = 0; ty < nty; ++ty) {
+      int ny = min(tilesize, height - ty * tilesize);
+      if (wid == 16)
+        Utility::readarray<unsigned short, unsigned, true>
+          (in, band.data(), size_t(ny) * width);
+      else
+        Utility::readarray<unsigned, unsigned, true>
+          (in, band.data(), size_t(ny) * width);
+      for (int tx = 0; tx < ntx; ++tx) {
+        int nx = min(tilesize, width - tx * tilesize);
+        for (int y = 0; y < ny; ++y)
+          copy(band.begin() + size_t(y) * width + tx * tilesize,
+               band.begin() + size_t(y) * width + tx * tilesize + nx,
+               tile.begin() + y * tilesize);
+        buf.clear();
+        EncodeTile(tile, nx, ny, wid, buf);
+        index[size_t(ty) * ntx + tx] = pos;
+        out.write(reinterpret_cast<const char*>(buf.data()), buf.size());
+        pos += buf.size();
+      }
+    }
+    index.back() = pos;
+    out.seekp(indexpos);
+    Utility::writearray<unsigned long long, unsigned long long, true>
+      (out, index);
+    if (!out.good())
+      throw GeographicErr("Error writing " + outfile);
+    cout << "Compressed " << infile << " to " << outfile << ", "
+         << pos << " bytes of tiles\n";
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  catch (...) {
+    cerr << "Caught unknown exception\n";
+    return 1;
+  }
+}
@@ -4,7 +4,7 @@
 #include <iomanip>
 #include <exception>
 #include <GeographicLib/Utility.hpp>
-#include "JacobiConformal.hpp"
+#include <GeographicLib/JacobiConformal.hpp>
 
 using namespace std;
 using namespace GeographicLib;
@@ -35,6 +35,14 @@ int main() {
       Math::real omg = i, bet = i;
       cout << i << " " << jc.x(omg) << " " << jc.y(bet) << "\n";
     }
+    // The batch functions project many points at once (e.g., the rows and
+    // columns of an image).
+    const int n = 19;
+    Math::real ang[n], x[n], y[n];
+    for (int i = 0; i < n; ++i) ang[i] = 5 * i;
+    jc.x(n, ang, x);
+    jc.y(n, ang, y);
+    cout << "Batch results at 45 degrees: " << x[9] << " " << y[9] << "\n";
   }
   catch (const exception& e) {
     cerr << "Caught exception: " << e.what() << "\n";
@@ -0,0 +1,55 @@
+// Load data files into named shared memory segments (or remove them) so
+// that the processes on a host using the memory mapped modes of Geoid,
+// GravityModel, and MagneticModel share a single copy of the data which
+// isn't subject to eviction from the page cache.  Run, e.g., (on a single line)
+//
+//   ShareData load /usr/local/share/GeographicLib/geoids/egm2008-1.pgm
+//     /usr/local/share/GeographicLib/gravity/egm2008.egm.cof
+//
+// once before starting the worker processes (which should construct Geoid
+// with mode Geoid::MEMORYMAP and GravityModel with mapped = true) and
+//
+//   ShareData remove ...
+//
+// to release the memory when they are done.  "ShareData status ..." reports
+// whether the files have been loaded.  For the gravity and magnetic models,
+// the coefficient file (with suffix ".cof") is the one to load.
+
+#include <iostream>
+#include <string>
+
+#include <GeographicLib/SharedData.hpp>
+
+using namespace std;
+using namespace GeographicLib;
+
+int main(int argc, const char* const argv[]) {
+  if (argc < 3) {
+    cerr << "Usage: " << argv[0] << " load|remove|status file...\n";
+    return 1;
+  }
+  try {
+    string cmd(argv[1]);
+    if (!(cmd == "load" || cmd == "remove" || cmd == "status"))
+      throw GeographicErr("Unknown command " + cmd);
+    for (int i = 2; i < argc; ++i) {
+      string file(argv[i]);
+      cout << file << " (" << SharedData::Name(file) << "): ";
+      if (cmd == "load")
+        cout << (SharedData::Load(file) ? "loaded" : "already loaded");
+      else if (cmd == "remove")
+        cout << (SharedData::Remove(file) ? "removed" : "not loaded");
+      else
+        cout << (SharedData::Loaded(file) ? "loaded" : "not loaded");
+      cout << "\n";
+    }
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+  catch (...) {
+    cerr << "Caught unknown exception\n";
+    return 1;
+  }
+}
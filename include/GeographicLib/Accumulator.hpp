@@ -135,6 +135,47 @@ namespace GeographicLib {
      * @param[in] y set \e sum -= \e y.
      **********************************************************************/
     Accumulator& operator-=(T y) { Add(-y); return *this; }
+    /**
+     * Add another accumulator to this one.  This allows partial sums computed
+     * separately, e.g., on several threads, to be combined.  The result is
+     * accurate to twice the normal precision (at the cost of a couple of ulps
+     * of the less significant word), as for the addition of a number.
+     *
+     * @param[in] a set \e sum += the sum held in \e a.
+     **********************************************************************/
+    Accumulator& operator+=(const Accumulator& a)
+    { Add(a._t); Add(a._s); return *this; }
+    /**
+     * Subtract another accumulator from this one.
+     *
+     * @param[in] a set \e sum -= the sum held in \e a.
+     **********************************************************************/
+    Accumulator& operator-=(const Accumulator& a)
+    { Add(-a._t); Add(-a._s); return *this; }
+    /**
+     * Add an array of numbers to the accumulator.
+     *
+     * @param[in] n the number of elements in \e y.
+     * @param[in] y the array of numbers to be added.
+     * @return a reference to the accumulator.
+     *
+     * The numbers are summed in several independent partial sums which are
+     * then merged with operator+=(const Accumulator&).  This avoids the
+     * dependency of each addition on the previous one and is about twice as
+     * fast as adding the numbers one at a time.  The accuracy is the same;
+     * however the result may differ in the last bit of the less significant
+     * word.
+     **********************************************************************/
+    Accumulator& Add(size_t n, const T y[]) {
+      const size_t lanes = 4;
+      Accumulator a[lanes];
+      size_t i = 0;
+      for (; i + lanes <= n; i += lanes)
+        for (size_t k = 0; k < lanes; ++k) a[k].Add(y[i + k]);
+      for (; i < n; ++i) Add(y[i]);
+      for (size_t k = 0; k < lanes; ++k) *this += a[k];
+      return *this;
+    }
     /**
      * Multiply accumulator by an integer.  To avoid loss of accuracy, use only
      * integers such that \e n &times; \e T is exactly representable as a \e T
@@ -73,6 +73,10 @@ namespace GeographicLib {
     GeodesicLine _meridian;
     real _sbet0, _cbet0;
     static const unsigned maxit_ = 10;
+    static const size_t projblock_ = 64;
+    // Returns the arc length along the central meridian for y
+    real IntForward(real lat, real dlon,
+                    real& x, real& azi, real& rk) const;
 
   public:
 
@@ -164,6 +168,54 @@ namespace GeographicLib {
       Reverse(x, y, lat, lon, azi, rk);
     }
 
+    /** \name Batch projections
+     **********************************************************************/
+    ///@{
+    /**
+     * Forward projection of arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes (degrees).
+     * @param[in] lon array of longitudes (degrees).
+     * @param[out] x array of eastings (meters).
+     * @param[out] y array of northings (meters).
+     * @param[out] azi if non-null, an array of the azimuths of the easting
+     *   directions (degrees).
+     * @param[out] rk if non-null, an array of the reciprocals of the
+     *   azimuthal northing scales.
+     *
+     * The longitude differences are computed with Math::AngDiffBatch and the
+     * northings with GeodesicLine::GenPositions on the central meridian.  The
+     * results are the same as calling Forward for each point.  The output
+     * arrays may coincide with the input arrays.
+     **********************************************************************/
+    void ForwardBatch(size_t n, const real lat[], const real lon[],
+                      real x[], real y[],
+                      real azi[] = nullptr, real rk[] = nullptr) const;
+
+    /**
+     * Reverse projection of arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] x array of eastings (meters).
+     * @param[in] y array of northings (meters).
+     * @param[out] lat array of latitudes (degrees).
+     * @param[out] lon array of longitudes (degrees).
+     * @param[out] azi if non-null, an array of the azimuths of the easting
+     *   directions (degrees).
+     * @param[out] rk if non-null, an array of the reciprocals of the
+     *   azimuthal northing scales.
+     *
+     * The feet of the perpendiculars on the central meridian are computed
+     * with GeodesicLine::GenPositions.  The results are the same as calling
+     * Reverse for each point.  The output arrays may coincide with the input
+     * arrays.
+     **********************************************************************/
+    void ReverseBatch(size_t n, const real x[], const real y[],
+                      real lat[], real lon[],
+                      real azi[] = nullptr, real rk[] = nullptr) const;
+    ///@}
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
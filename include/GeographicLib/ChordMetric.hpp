@@ -0,0 +1,183 @@
+/**
+ * \file ChordMetric.hpp
+ * \brief Header for GeographicLib::ChordMetric class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_CHORDMETRIC_HPP)
+#define GEOGRAPHICLIB_CHORDMETRIC_HPP 1
+
+#include <vector>
+#include <GeographicLib/Geocentric.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief The chord distance as a metric for NearestNeighbor
+   *
+   * This is a distance function object for use with NearestNeighbor, e.g.,
+   * \code
+   typedef ChordMetric::point pos;
+   ChordMetric dist(Geocentric::WGS84());
+   std::vector<pos> pts;
+   pts.push_back(dist.Point(lat, lon)); ...
+   dist.Attach(pts);
+   NearestNeighbor<Math::real, pos, ChordMetric> set(pts, dist);
+   \endcode
+   * The distance is the length of the straight line between the points in
+   * geocentric (ECEF) coordinates.  This is a lower bound on the geodesic
+   * distance and, for points closer than a few hundred kilometers, it
+   * differs from the geodesic distance by less than 1 part in 10<sup>4</sup>
+   * (and it orders the neighbors of a point in nearly the same way).
+   *
+   * Distances() computes the distances from a query point to a block of
+   * points, as required for NearestNeighbor to search its leaf buckets with
+   * a single call.  If Attach() has been called, the coordinates of the
+   * points are taken from copies held as separate arrays of \e X, \e Y, and
+   * \e Z; if the indices of the points are consecutive (as they are after
+   * NearestNeighbor::Renumber, provided Attach() is called with the
+   * renumbered points), these are loaded directly from the arrays.  The
+   * calculation is arranged in fixed-size blocks so that the compiler can
+   * use SIMD instructions.
+   *
+   * Once Attach() has been called, a ChordMetric object may be used by
+   * several threads; however Attach() must not be called while it's in use.
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT ChordMetric {
+  private:
+    typedef Math::real real;
+    Geocentric _earth;
+    std::vector<real> _x, _y, _z;
+    static const int block = 16;
+    static void distances(const real x[], const real y[], const real z[],
+                          int n, real qx, real qy, real qz, real d[]);
+  public:
+
+    /**
+     * A point given by its geocentric coordinates.
+     **********************************************************************/
+    class point {
+    private:
+      friend class ChordMetric;
+      real _x, _y, _z;
+    public:
+      /**
+       * The default constructor gives a point at the center of the earth.
+       **********************************************************************/
+      point() : _x(0), _y(0), _z(0) {}
+      /**
+       * @return \e X the geocentric coordinate (meters).
+       **********************************************************************/
+      Math::real X() const { return _x; }
+      /**
+       * @return \e Y the geocentric coordinate (meters).
+       **********************************************************************/
+      Math::real Y() const { return _y; }
+      /**
+       * @return \e Z the geocentric coordinate (meters).
+       **********************************************************************/
+      Math::real Z() const { return _z; }
+    };
+
+  private:
+    // The data of the vector of points given to Attach()
+    const point* _pts;
+  public:
+
+    /**
+     * Constructor for ChordMetric.
+     *
+     * @param[in] earth the Geocentric object used to convert geodetic
+     *   coordinates to geocentric.
+     **********************************************************************/
+    explicit ChordMetric(const Geocentric& earth)
+      : _earth(earth), _pts(nullptr) {}
+
+    /**
+     * Prepare a point.
+     *
+     * @param[in] lat the latitude of the point (degrees).
+     * @param[in] lon the longitude of the point (degrees).
+     * @param[in] h the height of the point above the ellipsoid (meters,
+     *   default 0).
+     * @return the point.
+     *
+     * \e lat should be in the range [&minus;90&deg;, 90&deg;].  None of the
+     * arguments should be a NaN or infinite; such points violate the metric
+     * conditions required by NearestNeighbor.
+     **********************************************************************/
+    point Point(real lat, real lon, real h = 0) const {
+      point p;
+      _earth.Forward(lat, lon, h, p._x, p._y, p._z);
+      return p;
+    }
+
+    /**
+     * The chord distance between two points.
+     *
+     * @param[in] p1 the first point.
+     * @param[in] p2 the second point.
+     * @return the distance between \e p1 and \e p2 (meters).
+     **********************************************************************/
+    real operator()(const point& p1, const point& p2) const {
+      real dx = p1._x - p2._x, dy = p1._y - p2._y, dz = p1._z - p2._z;
+      return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    /**
+     * Keep a copy of the coordinates of a set of points.
+     *
+     * @param[in] pts the vector of points.
+     * @exception std::bad_alloc if memory for the copy can't be allocated.
+     *
+     * This should be called with the vector of points given to
+     * NearestNeighbor (and called again whenever the points are changed).
+     * The copy is only used if the vector of points passed to Distances()
+     * has the same data (as given by std::vector::data()) and size as the
+     * one given here; otherwise the coordinates are taken from the points
+     * passed to Distances().  This check cannot detect points which are
+     * changed in place, so in that case Attach() must be called again.
+     **********************************************************************/
+    void Attach(const std::vector<point>& pts);
+
+    /**
+     * The distances from a point to several points.
+     *
+     * @param[in] pts the vector of points.
+     * @param[in] ind the indices of the points in \e pts.
+     * @param[in] n the number of points.
+     * @param[in] query the query point.
+     * @param[out] d the distances from
+     *   <i>pts</i>[<i>ind</i><sub><i>j</i></sub>] to \e query for \e j in
+     *   [0, \e n).
+     *
+     * The results are the same as those given by operator()() (apart,
+     * possibly, from roundoff).
+     **********************************************************************/
+    void Distances(const std::vector<point>& pts, const int ind[], int n,
+                   const point& query, real d[]) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geocentric object used in the
+     *   constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _earth.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geocentric object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _earth.Flattening(); }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_CHORDMETRIC_HPP
@@ -0,0 +1,223 @@
+/**
+ * \file CircleCache.hpp
+ * \brief Header for GeographicLib::CircleCache class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_CIRCLECACHE_HPP)
+#define GEOGRAPHICLIB_CIRCLECACHE_HPP 1
+
+#include <cmath>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Math.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief A cache of recently used circles of latitude
+   *
+   * This is used by GravityModel and MagneticModel (see
+   * GravityModel::SetCircleCache and MagneticModel::SetCircleCache) to hold
+   * the GravityCircle and MagneticCircle objects for the parallels most
+   * recently visited by the point queries.  Setting up a circle costs about
+   * as much as a single point evaluation, but thereafter each point on the
+   * circle costs only about \e N operations; so applications which return
+   * to the same latitude bands (e.g., aircraft in a holding pattern or ships
+   * on a fixed route) benefit from the reuse.
+   *
+   * The circles are keyed on the latitude and height, an integer \e k
+   * (e.g., the index of the epoch of a magnetic model), and the capabilities
+   * \e caps of the circle.  Optionally the latitude and height are rounded
+   * to multiples of a quantum before the circle is constructed, in which
+   * case the results are those for the rounded coordinates.  The number of
+   * circles held is bounded; when this bound is exceeded, the least recently
+   * used circle is dropped.  Queries with a NaN latitude or height are not
+   * cached.
+   *
+   * Get is thread safe; the circle is constructed without holding the lock,
+   * so concurrent misses don't block one another.  Reset is not thread safe.
+   *
+   * @tparam Circle the type of the circle, GravityCircle or MagneticCircle.
+   **********************************************************************/
+  template<class Circle>
+  class CircleCache {
+  private:
+    typedef Math::real real;
+    struct key {
+      real lat, h;
+      int k;
+      unsigned caps;
+      bool operator==(const key& x) const
+      { return lat == x.lat && h == x.h && k == x.k && caps == x.caps; }
+    };
+    struct hasher {
+      size_t operator()(const key& x) const {
+        std::hash<real> hr;
+        // The combination step from boost::hash_combine
+        size_t seed = 0;
+        for (size_t v : {hr(x.lat), hr(x.h), std::hash<int>()(x.k),
+                         std::hash<unsigned>()(x.caps)})
+          seed ^= v + size_t(0x9e3779b9) + (seed << 6) + (seed >> 2);
+        return seed;
+      }
+    };
+    typedef std::shared_ptr<const Circle> circleptr;
+    typedef std::pair<key, circleptr> item;
+    size_t _capacity;
+    real _latquantum, _hquantum;
+    mutable std::mutex _lock;
+    unsigned long long _hits, _misses;
+    std::list<item> _list;      // most recently used first
+    std::unordered_map<key, typename std::list<item>::iterator, hasher> _map;
+    static real Quantize(real x, real q) {
+      // Adding 0 converts -0 to +0
+      return (q > 0 ? q * std::round(x / q) : x) + real(0);
+    }
+    CircleCache(const CircleCache&) = delete;
+    CircleCache& operator=(const CircleCache&) = delete;
+  public:
+
+    /**
+     * The default constructor gives a disabled cache (with capacity 0).
+     **********************************************************************/
+    CircleCache()
+      : _capacity(0)
+      , _latquantum(0)
+      , _hquantum(0)
+      , _hits(0)
+      , _misses(0)
+    {}
+
+    /**
+     * Set the parameters of the cache.
+     *
+     * @param[in] capacity the maximum number of circles to hold; 0 disables
+     *   the cache.
+     * @param[in] latquantum if positive, the latitude is rounded to multiples
+     *   of this value (degrees).
+     * @param[in] hquantum if positive, the height is rounded to multiples
+     *   of this value (meters).
+     * @exception GeographicErr if \e latquantum or \e hquantum is negative or
+     *   not finite.
+     *
+     * This removes all the circles from the cache and resets the hit and
+     * miss counters.
+     **********************************************************************/
+    void Reset(size_t capacity, real latquantum = 0, real hquantum = 0) {
+      using std::isfinite;
+      if (!(isfinite(latquantum) && latquantum >= 0 &&
+            isfinite(hquantum) && hquantum >= 0))
+        throw GeographicErr("CircleCache quanta must be non-negative");
+      std::lock_guard<std::mutex> lock(_lock);
+      _capacity = capacity;
+      _latquantum = latquantum;
+      _hquantum = hquantum;
+      _hits = _misses = 0;
+      _list.clear(); _map.clear();
+    }
+
+    /**
+     * Look up a circle, constructing it on a miss.
+     *
+     * @param[in] lat the latitude (degrees).
+     * @param[in] h the height (meters).
+     * @param[in] k an additional integer key.
+     * @param[in] caps the capabilities of the circle.
+     * @param[in] make a function called as \e make(\e lat, \e h) with the
+     *   rounded latitude and height which returns the circle.
+     * @return a pointer to the circle.
+     **********************************************************************/
+    template<class F>
+    circleptr Get(real lat, real h, int k, unsigned caps, F make) {
+      using std::isnan;
+      const key x = {Quantize(lat, _latquantum), Quantize(h, _hquantum),
+                     k, caps};
+      {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto p = _map.find(x);
+        if (p != _map.end()) {
+          // Move the item to the front of the list; iterators remain valid.
+          _list.splice(_list.begin(), _list, p->second);
+          ++_hits;
+          return p->second->second;
+        }
+        ++_misses;
+      }
+      circleptr c = std::make_shared<const Circle>(make(x.lat, x.h));
+      if (!(isnan(x.lat) || isnan(x.h))) {
+        std::lock_guard<std::mutex> lock(_lock);
+        // Another thread may have inserted this key in the meantime.
+        if (_capacity > 0 && _map.find(x) == _map.end()) {
+          _list.push_front(item(x, c));
+          _map[x] = _list.begin();
+          while (_list.size() > _capacity) {
+            _map.erase(_list.back().first);
+            _list.pop_back();
+          }
+        }
+      }
+      return c;
+    }
+
+    /**
+     * @return the maximum number of circles held (0 means the cache is
+     *   disabled).
+     **********************************************************************/
+    size_t Capacity() const { return _capacity; }
+
+    /**
+     * @return the number of circles currently held.
+     **********************************************************************/
+    size_t Size() const {
+      std::lock_guard<std::mutex> lock(_lock);
+      return _list.size();
+    }
+
+    /**
+     * @return the number of lookups satisfied from the cache.
+     **********************************************************************/
+    unsigned long long Hits() const {
+      std::lock_guard<std::mutex> lock(_lock);
+      return _hits;
+    }
+
+    /**
+     * @return the number of lookups which required a circle to be
+     *   constructed.
+     **********************************************************************/
+    unsigned long long Misses() const {
+      std::lock_guard<std::mutex> lock(_lock);
+      return _misses;
+    }
+
+    /**
+     * @return an estimate of the number of bytes of heap memory used by the
+     *   circles currently held (including the bookkeeping for the cache).
+     *
+     * A circle which is also held by a caller is included in the count.
+     **********************************************************************/
+    size_t MemoryUsage() const {
+      std::lock_guard<std::mutex> lock(_lock);
+      // Each circle costs a list node, a hash table node, and the circle
+      // itself allocated together with its shared_ptr control block.
+      size_t bytes = _map.bucket_count() * sizeof(void*);
+      for (const item& x : _list)
+        bytes += sizeof(item) + 2 * sizeof(void*) +
+          sizeof(typename decltype(_map)::value_type) + 2 * sizeof(void*) +
+          sizeof(Circle) + 2 * sizeof(long) + x.second->MemoryUsage();
+      return bytes;
+    }
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_CIRCLECACHE_HPP
@@ -41,9 +41,15 @@ namespace GeographicLib {
    * SphericalHarmonic2::Circle to create instances of this class.
    *
    * CircularEngine stores the coefficients needed to allow the summation over
-   * order to be performed in 2 or 6 vectors of length \e M + 1 (depending on
-   * whether gradients are to be calculated).  For this reason the constructor
-   * may throw a std::bad_alloc exception.
+   * order to be performed in a single vector of length 2(\e M + 1) or
+   * 6(\e M + 1) (depending on whether gradients are to be calculated).  For
+   * this reason the constructor may throw a std::bad_alloc exception.  The
+   * coefficients for each order are stored together, so the outer sum reads
+   * the vector sequentially.  CircularEngine objects are cheap to move; and
+   * the overloads of SphericalHarmonic::Circle, etc., which take a
+   * CircularEngine argument reinitialize the object in place, reusing its
+   * storage (so no allocation is needed if the new circle is no larger than
+   * the old one).
    *
    * Example of use:
    * \include example-CircularEngine.cpp
@@ -56,47 +62,64 @@ namespace GeographicLib {
       FULL = SphericalEngine::FULL,
       SCHMIDT = SphericalEngine::SCHMIDT,
     };
+    // The offsets of the coefficients for order m in _w
+    enum { WC, WS, WRC, WRS, WTC, WTS };
     int _M;
     bool _gradp;
     unsigned _norm;
     real _a, _r, _u, _t;
-    std::vector<real> _wc, _ws, _wrc, _wrs, _wtc, _wts;
+    int _k;                     // The stride in _w, 2 or 6
+    // The coefficients for order m are _w[_k * m + WC], etc.
+    std::vector<real> _w;
     real _q, _uq, _uq2;
 
     Math::real Value(bool gradp, real sl, real cl,
                      real& gradx, real& grady, real& gradz) const;
+    // The number of longitudes evaluated together by Values.
+    static const int blk_ = 64;
+    // The vector version of Value for n <= blk_ longitudes.
+    void Values(bool gradp, int n, const real sl[], const real cl[],
+                real V[], real gradx[], real grady[], real gradz[]) const;
+    // The single precision version of Values.
+    void ValuesFloat(bool gradp, int n, const float sl[], const float cl[],
+                     float V[], float gradx[], float grady[], float gradz[])
+      const;
+    // Evaluate the sums at n longitudes lon0 + i * dlon by an FFT over
+    // longitude; this requires that dlon divide 360 degrees.  Return false
+    // (and do nothing) if this isn't possible or isn't faster than Values.
+    bool ValuesFFT(bool gradp, real lon0, real dlon, size_t n,
+                   real V[], real gradx[], real grady[], real gradz[]) const;
 
     friend class SphericalEngine;
-    CircularEngine(int M, bool gradp, unsigned norm,
-                   real a, real r, real u, real t)
-      : _M(M)
-      , _gradp(gradp)
-      , _norm(norm)
-      , _a(a)
-      , _r(r)
-      , _u(u)
-      , _t(t)
-      , _wc(std::vector<real>(_M + 1, 0))
-      , _ws(std::vector<real>(_M + 1, 0))
-      , _wrc(std::vector<real>(_gradp ? _M + 1 : 0, 0))
-      , _wrs(std::vector<real>(_gradp ? _M + 1 : 0, 0))
-      , _wtc(std::vector<real>(_gradp ? _M + 1 : 0, 0))
-      , _wts(std::vector<real>(_gradp ? _M + 1 : 0, 0))
-      {
-        _q = _a / _r;
-        _uq = _u * _q;
-        _uq2 = Math::sq(_uq);
-      }
+    // Reinitialize the object, reusing the storage in _w
+    void Reset(int M, bool gradp, unsigned norm,
+               real a, real r, real u, real t) {
+      _M = M;
+      _gradp = gradp;
+      _norm = norm;
+      _a = a;
+      _r = r;
+      _u = u;
+      _t = t;
+      _k = _gradp ? 6 : 2;
+      _w.assign(size_t(_k) * size_t(_M + 1), 0);
+      _q = _a / _r;
+      _uq = _u * _q;
+      _uq2 = Math::sq(_uq);
+    }
 
-    void SetCoeff(int m, real wc, real ws)
-    { _wc[m] = wc; _ws[m] = ws; }
+    void SetCoeff(int m, real wc, real ws) {
+      real* wm = _w.data() + _k * m;
+      wm[WC] = wc; wm[WS] = ws;
+    }
 
     void SetCoeff(int m, real wc, real ws,
                   real wrc, real wrs, real wtc, real wts) {
-      _wc[m] = wc; _ws[m] = ws;
+      real* wm = _w.data() + _k * m;
+      wm[WC] = wc; wm[WS] = ws;
       if (_gradp) {
-        _wrc[m] = wrc; _wrs[m] = wrs;
-        _wtc[m] = wtc; _wts[m] = wts;
+        wm[WRC] = wrc; wm[WRS] = wrs;
+        wm[WTC] = wtc; wm[WTS] = wts;
       }
     }
 
@@ -110,8 +133,15 @@ namespace GeographicLib {
     CircularEngine()
       : _M(-1)
       , _gradp(true)
+      , _norm(FULL)
+      , _a(1)
+      , _r(1)
       , _u(0)
       , _t(1)
+      , _k(6)
+      , _q(1)
+      , _uq(0)
+      , _uq2(0)
       {}
 
     /**
@@ -184,6 +214,133 @@ namespace GeographicLib {
       Math::sincosd(lon, sinlon, coslon);
       return (*this)(sinlon, coslon, gradx, grady, gradz);
     }
+
+    /**
+     * Evaluate the sum and, optionally, its gradient for many longitudes
+     * given in terms of their sines and cosines.
+     *
+     * @param[in] n the number of longitudes.
+     * @param[in] sinlon array of the sines of the longitudes.
+     * @param[in] coslon array of the cosines of the longitudes.
+     * @param[out] V array of the values of the sum.
+     * @param[out] gradx if non-null, array of the \e x components of the
+     *   gradient.
+     * @param[out] grady if non-null, array of the \e y components of the
+     *   gradient.
+     * @param[out] gradz if non-null, array of the \e z components of the
+     *   gradient.
+     *
+     * The results are identical to calling operator()() for each longitude.
+     * However the longitudes are processed in blocks so that the
+     * coefficients of the Clenshaw recurrence over order are computed once
+     * per order for the whole block and the inner loop over the longitudes
+     * can be vectorized by the compiler.  The gradients are computed only if
+     * \e gradx, \e grady, and \e gradz are all non-null and if the
+     * CircularEngine object was created with this capability; otherwise the
+     * gradient arrays are not touched.
+     **********************************************************************/
+    void Evaluate(size_t n, const real sinlon[], const real coslon[],
+                  real V[], real gradx[] = nullptr,
+                  real grady[] = nullptr, real gradz[] = nullptr) const;
+
+    /**
+     * Evaluate the sum and, optionally, its gradient for equally spaced
+     * longitudes.
+     *
+     * @param[in] lon0 the first longitude (degrees).
+     * @param[in] dlon the longitude spacing (degrees).
+     * @param[in] n the number of longitudes.
+     * @param[out] V array of the values of the sum at longitudes \e lon0 +
+     *   \e i \e dlon.
+     * @param[out] gradx if non-null, array of the \e x components of the
+     *   gradient.
+     * @param[out] grady if non-null, array of the \e y components of the
+     *   gradient.
+     * @param[out] gradz if non-null, array of the \e z components of the
+     *   gradient.
+     *
+     * This is equivalent to Evaluate() with the sines and cosines given by
+     * Math::sincosd(\e lon0 + \e i \e dlon).  (These are computed
+     * directly, instead of by a recurrence, so that the accuracy doesn't
+     * degrade along long rows.)
+     *
+     * If \e dlon divides 360&deg; into \e K parts, the sum over order is
+     * instead converted into a Fourier series in longitude which is
+     * evaluated at all \e K longitudes with a fast Fourier transform; this
+     * is done when it's cheaper than summing the series at each point, i.e.,
+     * roughly when \e K log \e K &lt; \e n \e M.  For a global grid with
+     * EGM2008 at 1' resolution, this reduces the cost of the sum over order
+     * by a factor of 10 to 20, so that the cost of a row is dominated by the
+     * construction of the CircularEngine.  The results then differ from
+     * those of Evaluate() by roundoff.
+     **********************************************************************/
+    void EvaluateGrid(real lon0, real dlon, size_t n,
+                      real V[], real gradx[] = nullptr,
+                      real grady[] = nullptr, real gradz[] = nullptr) const;
+
+    /**
+     * Evaluate the sum and, optionally, its gradient for many longitudes in
+     * single precision.
+     *
+     * @param[in] n the number of longitudes.
+     * @param[in] sinlon array of the sines of the longitudes.
+     * @param[in] coslon array of the cosines of the longitudes.
+     * @param[out] V array of the values of the sum.
+     * @param[out] gradx if non-null, array of the \e x components of the
+     *   gradient.
+     * @param[out] grady if non-null, array of the \e y components of the
+     *   gradient.
+     * @param[out] gradz if non-null, array of the \e z components of the
+     *   gradient.
+     *
+     * This is the same as Evaluate() except that the Clenshaw summation over
+     * order is carried out in single precision, so the inner loop handles
+     * twice as many longitudes per vector instruction.  The relative accuracy
+     * is about 10<sup>&minus;6</sup> which is ample for visualizing the
+     * results.  The sums over degree for each order span a much larger range
+     * than floats can represent (this is why SphericalEngine::scale() is
+     * needed); so before they are rounded to floats, the sum for order \e m
+     * is multiplied by (\e u \e q)<sup><i>m</i></sup>, which is the factor
+     * the summation over order would otherwise apply to it, and the Clenshaw
+     * recurrence is adjusted to compensate.
+     **********************************************************************/
+    void EvaluateFloat(size_t n, const float sinlon[], const float coslon[],
+                       float V[], float gradx[] = nullptr,
+                       float grady[] = nullptr, float gradz[] = nullptr)
+      const;
+
+    /**
+     * Evaluate the sum and, optionally, its gradient for equally spaced
+     * longitudes in single precision.
+     *
+     * @param[in] lon0 the first longitude (degrees).
+     * @param[in] dlon the longitude spacing (degrees).
+     * @param[in] n the number of longitudes.
+     * @param[out] V array of the values of the sum at longitudes \e lon0 +
+     *   \e i \e dlon.
+     * @param[out] gradx if non-null, array of the \e x components of the
+     *   gradient.
+     * @param[out] grady if non-null, array of the \e y components of the
+     *   gradient.
+     * @param[out] gradz if non-null, array of the \e z components of the
+     *   gradient.
+     *
+     * This is the single precision version of EvaluateGrid(); see
+     * EvaluateFloat().
+     **********************************************************************/
+    void EvaluateGridFloat(real lon0, real dlon, size_t n,
+                           float V[], float gradx[] = nullptr,
+                           float grady[] = nullptr, float gradz[] = nullptr)
+      const;
+
+    /**
+     * @return the number of bytes of heap memory used by the object (this
+     *   excludes sizeof(CircularEngine)).
+     *
+     * This is the storage for the sums over degree, 2(\e M + 1) or, if the
+     * gradient is computed, 6(\e M + 1) reals.
+     **********************************************************************/
+    size_t MemoryUsage() const { return _w.capacity() * sizeof(real); }
   };
 
 } // namespace GeographicLib
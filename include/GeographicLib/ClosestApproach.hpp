@@ -0,0 +1,267 @@
+/**
+ * \file ClosestApproach.hpp
+ * \brief Header for GeographicLib::ClosestApproach class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_CLOSESTAPPROACH_HPP)
+#define GEOGRAPHICLIB_CLOSESTAPPROACH_HPP 1
+
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Closest approach of objects moving along geodesics
+   *
+   * This finds the time and distance of the closest point of approach (CPA)
+   * of two objects moving at constant speeds along geodesics, e.g., a pair
+   * of aircraft.  Each trajectory is given by a GeodesicLine (whose point 1
+   * is the position at time 0) and a speed \e v, so that the position at
+   * time \e t is at a distance \e v \e t along the line.  The CPA is sought
+   * in the time window [0, \e tmax].  The units of time and speed are
+   * arbitrary, provided that the speed times the time gives meters.
+   *
+   * Newton's method is used to find a zero of the derivative of
+   * <i>s</i><sub>12</sub><sup>2</sup>/2 where <i>s</i><sub>12</sub> is the
+   * separation; the derivatives are given in terms of the azimuths, the
+   * reduced length, and the geodesic scales of the geodesic joining the
+   * objects.  In the planar limit, the first iteration gives the exact
+   * result; in practice 2 or 3 iterations suffice.  The iteration is
+   * confined to the time window; if the separation increases (resp.
+   * decreases) at the start (resp. end) of the window, the CPA is at the
+   * start (resp. end).
+   *
+   * ClosestApproach::Batch processes many pairs of trajectories (e.g., for
+   * conflict detection).  Pairs that can't come within a distance \e dmax in
+   * the time window are rejected cheaply: the chord distance between the
+   * initial positions is a lower bound on their geodesic separation, which
+   * can decrease at most at the sum of the speeds.  The work is distributed
+   * over a pool of threads.
+   *
+   * The same method gives the distance from a point to a geodesic segment
+   * (ClosestApproach::Segment and ClosestApproach::SegmentBatch), e.g., for
+   * matching GPS fixes to road segments: the point is fixed and the other
+   * object moves at unit speed along the segment.  Represent each segment
+   * by a GeodesicLine constructed with Geodesic::InverseLine, so that it is
+   * prepared once and reused for all the points.
+   *
+   * ClosestApproach::Simplify uses ClosestApproach::Segment to simplify a
+   * track (a polyline) with the Douglas-Peucker algorithm, with the tolerance
+   * given in meters; this avoids the errors incurred by first projecting the
+   * track.  Points which an upper bound based on the chord shows to lie within
+   * the current threshold of an end point of a segment are skipped without
+   * computing their distance to the segment.  ClosestApproach::SimplifyBatch
+   * processes many tracks in parallel.
+   *
+   * CAVEAT: if the objects are nearly antipodal, Newton's method may fail to
+   * converge to the global minimum of the separation in the window.
+   *
+   * A ClosestApproach object holds no state other than the ellipsoid and
+   * the number of threads; thus a single object may be used by several
+   * threads.
+   *
+   * Example of use:
+   * \code
+   * const Geodesic& geod = Geodesic::WGS84();
+   * ClosestApproach cpa(geod);
+   * // Planes leaving Istanbul and Reykjavik at the same time (speeds in
+   * // m/hr)
+   * GeodesicLine l1 = geod.Line(42, 29, -51), l2 = geod.Line(64, -22, 154);
+   * double t, s12 = cpa.Compute(l1, 900e3, l2, 800e3, 10, t);
+   * // t = 2.719 hr, s12 = 1082.7 km
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT ClosestApproach {
+  private:
+    typedef Math::real real;
+    static const int maxit_ = 10;
+    Geodesic _earth;
+    real _tol;
+    unsigned _threads;
+    // Geocentric coordinates of a point
+    void Cartesian(real lat, real lon, real& X, real& Y, real& Z) const;
+    // The Newton iteration; if line2 is null, object 2 is fixed at (lat2,
+    // lon2).
+    real Iterate(const GeodesicLine& line1, real v1,
+                 const GeodesicLine* line2, real v2, real lat2, real lon2,
+                 real tmax, real& t) const;
+  public:
+
+    /**
+     * Constructor for ClosestApproach.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     *   By default this uses the WGS84 ellipsoid.
+     * @param[in] threads the number of threads to use in
+     *   ClosestApproach::Batch, ClosestApproach::SegmentBatch, and
+     *   ClosestApproach::SimplifyBatch; if this is 0 (the default), the
+     *   number reported by std::thread::hardware_concurrency() is used.
+     **********************************************************************/
+    explicit ClosestApproach(const Geodesic& earth = Geodesic::WGS84(),
+                             unsigned threads = 0);
+
+    /**
+     * Find the closest approach of two objects.
+     *
+     * @param[in] line1 the geodesic along which object 1 moves.
+     * @param[in] v1 the speed of object 1.
+     * @param[in] line2 the geodesic along which object 2 moves.
+     * @param[in] v2 the speed of object 2.
+     * @param[in] tmax the end of the time window.
+     * @param[out] t the time of closest approach.
+     * @return \e s12 the distance between the objects at time \e t (meters).
+     *
+     * The GeodesicLine objects must have been constructed with \e caps
+     * including GeodesicLine::LATITUDE, GeodesicLine::LONGITUDE,
+     * GeodesicLine::AZIMUTH, and GeodesicLine::DISTANCE_IN (as is the case
+     * with the default value of \e caps); otherwise NaNs are returned.  \e
+     * tmax should be non-negative.
+     **********************************************************************/
+    Math::real Compute(const GeodesicLine& line1, real v1,
+                       const GeodesicLine& line2, real v2,
+                       real tmax, real& t) const;
+
+    /**
+     * Find the closest approaches for many pairs of objects.
+     *
+     * @param[in] n the number of pairs.
+     * @param[in] i1 array of the indices of object 1 of the pairs.
+     * @param[in] i2 array of the indices of object 2 of the pairs.
+     * @param[in] lines array of the geodesics along which the objects move.
+     * @param[in] v array of the speeds of the objects.
+     * @param[in] tmax the end of the time window.
+     * @param[in] dmax the threshold distance (meters).
+     * @param[out] t array of the times of closest approach.
+     * @param[out] s12 array of the distances at closest approach (meters).
+     * @return the number of pairs with \e s12 &le; \e dmax.
+     *
+     * Object \e k moves along \e lines[\e k] with speed \e v[\e k].  The
+     * results for the pair (\e i1[\e i], \e i2[\e i]) are stored in element
+     * \e i of \e t and \e s12.  If a pair can't come within \e dmax of one
+     * another in the time window, \e t is set to NaN and \e s12 is set to a
+     * lower bound for their separation (which exceeds \e dmax); otherwise
+     * the results are the same as those of ClosestApproach::Compute.  Set \e
+     * dmax = Math::infinity() to compute the closest approaches of all the
+     * pairs.
+     **********************************************************************/
+    size_t Batch(size_t n, const size_t i1[], const size_t i2[],
+                 const GeodesicLine lines[], const real v[],
+                 real tmax, real dmax, real t[], real s12[]) const;
+
+    /**
+     * Find the distance from a point to a geodesic segment.
+     *
+     * @param[in] seg the geodesic segment.
+     * @param[in] lat the latitude of the point (degrees).
+     * @param[in] lon the longitude of the point (degrees).
+     * @param[out] s the distance along the segment to the closest point
+     *   (meters).
+     * @return \e s12 the distance from the point to the segment (meters).
+     *
+     * The segment runs from point 1 to point 3 of \e seg, i.e., \e s lies
+     * between 0 and \e seg.Distance(); the closest point is given by \e
+     * seg.Position(\e s, ...).  \e seg must have the capabilities listed for
+     * ClosestApproach::Compute and point 3 must have been set (e.g., by
+     * constructing it with Geodesic::InverseLine); otherwise NaNs are
+     * returned.  If the closest point lies in the interior of the segment,
+     * the geodesic from it to the point is perpendicular to the segment.
+     **********************************************************************/
+    Math::real Segment(const GeodesicLine& seg, real lat, real lon,
+                       real& s) const;
+
+    /**
+     * Find the distances from many points to geodesic segments.
+     *
+     * @param[in] n the number of points.
+     * @param[in] iseg array of the indices of the segments.
+     * @param[in] segs array of the geodesic segments.
+     * @param[in] lat array of the latitudes of the points (degrees).
+     * @param[in] lon array of the longitudes of the points (degrees).
+     * @param[out] s12 array of the distances from the points to the segments
+     *   (meters).
+     * @param[out] s array of the distances along the segments to the closest
+     *   points (meters).
+     *
+     * Element \e i of the outputs gives the result of
+     * ClosestApproach::Segment for \e segs[\e iseg[\e i]] and point \e i.
+     * The output arrays may be the same as the input arrays \e lat and \e
+     * lon.  The work is distributed over the threads.
+     **********************************************************************/
+    void SegmentBatch(size_t n, const size_t iseg[],
+                      const GeodesicLine segs[],
+                      const real lat[], const real lon[],
+                      real s12[], real s[]) const;
+
+    /**
+     * Simplify a track with the Douglas-Peucker algorithm.
+     *
+     * @param[in] n the number of points in the track.
+     * @param[in] lat array of the latitudes of the points (degrees).
+     * @param[in] lon array of the longitudes of the points (degrees).
+     * @param[in] tol the tolerance (meters); this should be non-negative.
+     * @param[out] keep array of flags indicating which points are retained.
+     * @exception std::bad_alloc if the memory for the work stack can't be
+     *   allocated.
+     * @return the number of points retained.
+     *
+     * The first and last points are always retained.  Each point that is
+     * not retained lies within \e tol of the geodesic segment joining the
+     * retained points on either side of it.
+     **********************************************************************/
+    size_t Simplify(size_t n, const real lat[], const real lon[], real tol,
+                    bool keep[]) const;
+
+    /**
+     * Simplify many tracks with the Douglas-Peucker algorithm.
+     *
+     * @param[in] ntracks the number of tracks.
+     * @param[in] start array of the indices of the first points of the
+     *   tracks; this has \e ntracks + 1 elements and is non-decreasing.
+     * @param[in] lat array of the latitudes of the points (degrees).
+     * @param[in] lon array of the longitudes of the points (degrees).
+     * @param[in] tol the tolerance (meters); this should be non-negative.
+     * @param[out] keep array of flags indicating which points are retained.
+     * @exception std::bad_alloc if the memory for the work stacks can't be
+     *   allocated.
+     * @return the total number of points retained.
+     *
+     * Track \e k consists of the points with indices in [\e start[\e k],
+     * \e start[\e k + 1]).  The results are the same as calling
+     * ClosestApproach::Simplify for each track.  The tracks are distributed
+     * over the threads.
+     **********************************************************************/
+    size_t SimplifyBatch(size_t ntracks, const size_t start[],
+                         const real lat[], const real lon[], real tol,
+                         bool keep[]) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of threads used.
+     **********************************************************************/
+    unsigned Threads() const { return _threads; }
+
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _earth.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _earth.Flattening(); }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_CLOSESTAPPROACH_HPP
@@ -107,9 +107,33 @@ namespace GeographicLib {
     static const char* const dmsindicators_;
     static const char* const components_[3];
     static Math::real NumMatch(const std::string& s);
-    static Math::real InternalDecode(const std::string& dmsa, flag& ind);
     DMS();                      // Disable constructor
 
+  public:
+    /**
+     * The status returned by the version of Decode which does not throw an
+     * exception.
+     **********************************************************************/
+    enum status {
+      /**
+       * The decoding succeeded.
+       * @hideinitializer
+       **********************************************************************/
+      OK = 0,
+      /**
+       * The DMS string is illegal.
+       * @hideinitializer
+       **********************************************************************/
+      BADSTRING = 1,
+    };
+
+  private:
+    // If throwp = false, return a status instead of throwing an exception.
+    static status InternalDecode(const std::string& dmsa,
+                                 real& val, flag& ind, bool throwp);
+    static status GenDecode(const std::string& dms,
+                            real& val, flag& ind, bool throwp);
+
   public:
 
     /**
@@ -243,6 +267,23 @@ namespace GeographicLib {
      **********************************************************************/
     static Math::real Decode(const std::string& dms, flag& ind);
 
+    /**
+     * Convert a string in DMS to an angle without throwing an exception.
+     *
+     * @param[in] dms string input.
+     * @param[out] val angle (degrees).
+     * @param[out] ind a DMS::flag value signaling the presence of a
+     *   hemisphere indicator.
+     * @return BADSTRING if \e dms is malformed (in which case \e val and \e
+     *   ind are unchanged), otherwise OK.
+     *
+     * The rules for \e dms are the same as for Decode(const std::string&,
+     * flag&).  This is intended for processing input where malformed
+     * strings are common and the cost of handling an exception is
+     * significant.
+     **********************************************************************/
+    static status Decode(const std::string& dms, real& val, flag& ind);
+
     /**
      * Convert DMS to an angle.
      *
@@ -0,0 +1,163 @@
+/**
+ * \file Dispatch.hpp
+ * \brief Header for GeographicLib::Dispatch class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_DISPATCH_HPP)
+#define GEOGRAPHICLIB_DISPATCH_HPP 1
+
+#include <string>
+#include <GeographicLib/Constants.hpp>
+
+#if !defined(GEOGRAPHICLIB_DISPATCH)
+/**
+ * Are the batch kernels compiled for several x86-64 instruction set
+ * extensions with the variant selected at run time?  This is set by cmake
+ * (option GEOGRAPHICLIB_DISPATCH) when the compiler supports it.
+ **********************************************************************/
+#  define GEOGRAPHICLIB_DISPATCH 0
+#endif
+
+#if GEOGRAPHICLIB_DISPATCH
+// Attributes for the variants of a kernel.  The kernel body should be
+// declared with GEOGRAPHICLIB_KERNEL_INLINE so that it (and the inline
+// functions it calls) are compiled for the target of each variant.
+#  define GEOGRAPHICLIB_KERNEL_INLINE inline __attribute__((always_inline))
+#  define GEOGRAPHICLIB_TARGET_AVX2 __attribute__((target("avx2")))
+#  define GEOGRAPHICLIB_TARGET_AVX512 __attribute__((target("avx512f")))
+#  define GEOGRAPHICLIB_DISPATCH_SELECT(generic, avx2, avx512) \
+  GeographicLib::Dispatch::Select(generic, avx2, avx512)
+#else
+#  define GEOGRAPHICLIB_KERNEL_INLINE inline
+#  define GEOGRAPHICLIB_DISPATCH_SELECT(generic, avx2, avx512) (generic)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief Run time selection of the batch kernels
+   *
+   * The inner loops of some of the batch routines, e.g.,
+   * Math::sincosdBatch, are compiled several times for different instruction
+   * set extensions of the x86-64 architecture and the best variant supported
+   * by the CPU is chosen when the routine is first called.  This allows a
+   * single library binary to exploit the wider vector registers of recent
+   * processors while still running on older ones.  All the variants give
+   * bitwise identical results (the library is compiled with floating-point
+   * contraction turned off, so the AVX-512 variants do not use fused
+   * multiply-adds).
+   *
+   * This capability is enabled with the cmake option GEOGRAPHICLIB_DISPATCH
+   * (default ON); it is only available for x86-64 with compilers (g++ and
+   * clang++) which support the \c target attribute.  Otherwise the library
+   * uses kernels compiled for the baseline architecture; on 64-bit ARM
+   * processors this includes NEON, which needs no run time selection.
+   *
+   * The selected level can be lowered (but not raised) by setting the
+   * environment variable GEOGRAPHICLIB_ISA to "generic", "avx2", or
+   * "avx512".  This is useful for testing and for getting identical timings
+   * on a heterogeneous set of machines.
+   *
+   * Example of use:
+   * \code
+   * std::cout << "Kernels: " << Dispatch::Name(Dispatch::Selected()) << "\n"
+   *           << Dispatch::Kernels();
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT Dispatch {
+  private:
+    static int Detect();
+    static int Choose();
+  public:
+
+    /**
+     * The instruction set levels for the kernels.
+     **********************************************************************/
+    enum isa {
+      /**
+       * The baseline architecture for which the library was compiled.
+       * @hideinitializer
+       **********************************************************************/
+      GENERIC = 0,
+      /**
+       * The baseline architecture on ARM processors with NEON.
+       * @hideinitializer
+       **********************************************************************/
+      NEON    = 1,
+      /**
+       * x86-64 with AVX2 (256-bit vectors).
+       * @hideinitializer
+       **********************************************************************/
+      AVX2    = 2,
+      /**
+       * x86-64 with AVX-512F (512-bit vectors).
+       * @hideinitializer
+       **********************************************************************/
+      AVX512  = 3,
+    };
+
+    /**
+     * @return true if the library was compiled with run time selection of
+     *   the kernels.
+     **********************************************************************/
+    static bool Enabled() { return GEOGRAPHICLIB_DISPATCH != 0; }
+
+    /**
+     * @return the best instruction set level supported by both the library
+     *   and the CPU.
+     **********************************************************************/
+    static isa Supported();
+
+    /**
+     * @return the instruction set level of the kernels used by the library.
+     *
+     * This is Supported() limited by the environment variable
+     * GEOGRAPHICLIB_ISA.  The value is determined on the first call and is
+     * then fixed.
+     **********************************************************************/
+    static isa Selected();
+
+    /**
+     * @param[in] level an instruction set level.
+     * @return its name: "generic", "neon", "avx2", or "avx512".
+     **********************************************************************/
+    static std::string Name(isa level);
+
+    /**
+     * @return a description of the kernels used, with one line for each
+     *   routine, e.g., "Math::sincosdBatch avx2".
+     **********************************************************************/
+    static std::string Kernels();
+
+    /**
+     * Choose among the variants of a kernel.
+     *
+     * @tparam F the type of the kernel (a function pointer).
+     * @param[in] generic the kernel for the baseline architecture.
+     * @param[in] avx2 the kernel compiled for AVX2.
+     * @param[in] avx512 the kernel compiled for AVX-512F.
+     * @return the kernel for Selected().
+     *
+     * This is usually called (via the macro GEOGRAPHICLIB_DISPATCH_SELECT,
+     * which only requires the AVX variants to exist when
+     * GEOGRAPHICLIB_DISPATCH is set) when initializing a function-local
+     * static table of kernels.
+     **********************************************************************/
+    template<typename F> static F Select(F generic, F avx2, F avx512) {
+      switch (Selected()) {
+      case AVX512: return avx512;
+      case AVX2:   return avx2;
+      default:     return generic;
+      }
+    }
+
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_DISPATCH_HPP
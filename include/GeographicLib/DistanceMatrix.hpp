@@ -0,0 +1,156 @@
+/**
+ * \file DistanceMatrix.hpp
+ * \brief Header for GeographicLib::DistanceMatrixT class
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_DISTANCEMATRIX_HPP)
+#define GEOGRAPHICLIB_DISTANCEMATRIX_HPP 1
+
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicExact.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Matrices of geodesic distances and azimuths
+   *
+   * This solves the inverse geodesic problem between every point of one set,
+   * (\e lat1, \e lon1), and every point of a second set, (\e lat2, \e lon2).
+   * The results are written into caller-supplied row-major arrays; row \e i
+   * corresponds to point \e i of the first set.  The results are identical to
+   * those returned by GeodType::GenInverse.
+   *
+   * The latitude-dependent quantities (the reduced latitude and its sine and
+   * cosine, etc.) are computed once for each point instead of once per pair of
+   * points.  The matrix is split into tiles which are distributed over a pool
+   * of threads.  Each tile covers a few rows and enough columns that the
+   * precomputed quantities for the columns stay in the cache.
+   *
+   * This is a templated class to allow it to be used with Geodesic and
+   * GeodesicExact.  GeographicLib::DistanceMatrix and
+   * GeographicLib::DistanceMatrixExact are typedefs for these cases.
+   *
+   * A DistanceMatrixT object holds no state other than the ellipsoid and the
+   * number of threads; thus a single object may be used by several threads.
+   *
+   * A block of the matrix is computed by passing the corresponding ranges of
+   * the two sets of points.  The example program DistanceMatrixTiles.cpp
+   * uses this to compute a matrix which is too large for one machine as a
+   * set of tiles, stored in separate files, which can be shared among
+   * several processes and which allow an interrupted job to be resumed.
+   *
+   * @tparam GeodType the geodesic class to use.
+   **********************************************************************/
+
+  template<class GeodType = Geodesic>
+  class DistanceMatrixT {
+  private:
+    typedef Math::real real;
+    static const size_t rowtile_ = 8;
+    static const size_t coltile_ = 512;
+    GeodType _earth;
+    unsigned _threads;
+    struct point { real lat, sbet, cbet, dn; };
+    void Prepare(size_t n, const real lat[], point p[]) const;
+    void Tile(size_t i0, size_t i1, size_t j0, size_t j1, size_t m,
+              const point p1[], const real lon1[],
+              const point p2[], const real lon2[],
+              unsigned outmask,
+              real s12[], real azi1[], real azi2[]) const;
+  public:
+
+    /**
+     * Constructor for DistanceMatrixT.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     * @param[in] threads the number of threads to use; if this is 0 (the
+     *   default), the number reported by std::thread::hardware_concurrency()
+     *   is used.
+     **********************************************************************/
+    DistanceMatrixT(const GeodType& earth, unsigned threads = 0);
+
+    /**
+     * Compute the matrix of distances and azimuths.
+     *
+     * @param[in] n the number of points in the first set.
+     * @param[in] lat1 array of latitudes of the first set (degrees).
+     * @param[in] lon1 array of longitudes of the first set (degrees).
+     * @param[in] m the number of points in the second set.
+     * @param[in] lat2 array of latitudes of the second set (degrees).
+     * @param[in] lon2 array of longitudes of the second set (degrees).
+     * @param[in] outmask a bitor'ed combination of GeodType::DISTANCE and
+     *   GeodType::AZIMUTH specifying which of the following arrays should be
+     *   set.
+     * @param[out] s12 array of \e n &times; \e m distances (meters).
+     * @param[out] azi1 array of \e n &times; \e m azimuths at the points of
+     *   the first set (degrees).
+     * @param[out] azi2 array of \e n &times; \e m (forward) azimuths at the
+     *   points of the second set (degrees).
+     * @exception std::bad_alloc if the memory for the precomputed
+     *   quantities can't be allocated.
+     *
+     * The results for point \e i of the first set and point \e j of the
+     * second set are stored in element \e i &times; \e m + \e j of the output
+     * arrays.  Output arrays not selected by \e outmask are not referenced and
+     * may be null.
+     **********************************************************************/
+    void Compute(size_t n, const real lat1[], const real lon1[],
+                 size_t m, const real lat2[], const real lon2[],
+                 unsigned outmask,
+                 real s12[], real azi1[], real azi2[]) const;
+
+    /**
+     * Compute the matrix of distances.
+     *
+     * See the documentation for DistanceMatrixT::Compute.
+     **********************************************************************/
+    void Distances(size_t n, const real lat1[], const real lon1[],
+                   size_t m, const real lat2[], const real lon2[],
+                   real s12[]) const {
+      Compute(n, lat1, lon1, m, lat2, lon2, GeodType::DISTANCE,
+              s12, nullptr, nullptr);
+    }
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of threads used.
+     **********************************************************************/
+    unsigned Threads() const { return _threads; }
+
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _earth.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _earth.Flattening(); }
+    ///@}
+  };
+
+  /**
+   * @relates DistanceMatrixT
+   *
+   * Distance matrices with geodesics computed using Geodesic.
+   **********************************************************************/
+  typedef DistanceMatrixT<Geodesic> DistanceMatrix;
+
+  /**
+   * @relates DistanceMatrixT
+   *
+   * Distance matrices with geodesics computed using GeodesicExact.
+   **********************************************************************/
+  typedef DistanceMatrixT<GeodesicExact> DistanceMatrixExact;
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_DISTANCEMATRIX_HPP
@@ -52,6 +52,26 @@ namespace GeographicLib {
     const Math::real* ConformalToRectifyingCoeffs() const { return _tm._alp; }
     const Math::real* RectifyingToConformalCoeffs() const { return _tm._bet; }
     friend class Rhumb; friend class RhumbLine;
+
+    // The latitude conversions done by the batch routines
+    enum auxlat {
+      RECTIFYING, INVRECTIFYING, AUTHALIC, INVAUTHALIC,
+      CONFORMAL, INVCONFORMAL, ISOMETRIC, INVISOMETRIC,
+    };
+    // The batch routines process the points in blocks of this size
+    static const size_t auxblock_ = 64;
+    // Apply conversion type to the m <= auxblock_ latitudes in x in place
+    void AuxBlock(auxlat type, size_t m, real x[]) const;
+    template<typename T>
+    void AuxBatch(auxlat type, size_t n, const T in[], T out[]) const {
+      real x[auxblock_];
+      for (size_t i0 = 0; i0 < n; i0 += auxblock_) {
+        size_t m = n - i0 < auxblock_ ? n - i0 : auxblock_;
+        for (size_t i = 0; i < m; ++i) x[i] = real(in[i0 + i]);
+        AuxBlock(type, m, x);
+        for (size_t i = 0; i < m; ++i) out[i0 + i] = T(x[i]);
+      }
+    }
   public:
     /** \name Constructor
      **********************************************************************/
@@ -329,6 +349,116 @@ namespace GeographicLib {
     Math::real InverseIsometricLatitude(real psi) const;
     ///@}
 
+    /** \name Batch latitude conversions.
+     **********************************************************************/
+    ///@{
+    /**
+     * Convert an array of geographic latitudes to rectifying latitudes.
+     *
+     * @tparam T the type of the latitudes; this is typically Math::real or
+     *   float.
+     * @param[in] n the number of latitudes.
+     * @param[in] phi array of geographic latitudes (degrees).
+     * @param[out] mu array of rectifying latitudes (degrees).
+     *
+     * The conversions are carried out in Math::real precision in blocks of
+     * points; the trigonometric argument reductions are done with
+     * Math::sincosdBatch and Math::atan2dBatch.  The results are the same
+     * as calling RectifyingLatitude for each point, rounded to \e T.
+     * Single precision arrays halve the memory traffic for applications,
+     * such as equal-area binning, which don't need full accuracy.  The
+     * output array may coincide with the input array.  The other batch
+     * routines work the same way.
+     **********************************************************************/
+    template<typename T>
+    void RectifyingLatitudeBatch(size_t n, const T phi[], T mu[]) const
+    { AuxBatch(RECTIFYING, n, phi, mu); }
+
+    /**
+     * Convert an array of rectifying latitudes to geographic latitudes.
+     *
+     * @tparam T the type of the latitudes.
+     * @param[in] n the number of latitudes.
+     * @param[in] mu array of rectifying latitudes (degrees).
+     * @param[out] phi array of geographic latitudes (degrees).
+     **********************************************************************/
+    template<typename T>
+    void InverseRectifyingLatitudeBatch(size_t n, const T mu[], T phi[]) const
+    { AuxBatch(INVRECTIFYING, n, mu, phi); }
+
+    /**
+     * Convert an array of geographic latitudes to authalic latitudes.
+     *
+     * @tparam T the type of the latitudes.
+     * @param[in] n the number of latitudes.
+     * @param[in] phi array of geographic latitudes (degrees).
+     * @param[out] xi array of authalic latitudes (degrees).
+     **********************************************************************/
+    template<typename T>
+    void AuthalicLatitudeBatch(size_t n, const T phi[], T xi[]) const
+    { AuxBatch(AUTHALIC, n, phi, xi); }
+
+    /**
+     * Convert an array of authalic latitudes to geographic latitudes.
+     *
+     * @tparam T the type of the latitudes.
+     * @param[in] n the number of latitudes.
+     * @param[in] xi array of authalic latitudes (degrees).
+     * @param[out] phi array of geographic latitudes (degrees).
+     **********************************************************************/
+    template<typename T>
+    void InverseAuthalicLatitudeBatch(size_t n, const T xi[], T phi[]) const
+    { AuxBatch(INVAUTHALIC, n, xi, phi); }
+
+    /**
+     * Convert an array of geographic latitudes to conformal latitudes.
+     *
+     * @tparam T the type of the latitudes.
+     * @param[in] n the number of latitudes.
+     * @param[in] phi array of geographic latitudes (degrees).
+     * @param[out] chi array of conformal latitudes (degrees).
+     **********************************************************************/
+    template<typename T>
+    void ConformalLatitudeBatch(size_t n, const T phi[], T chi[]) const
+    { AuxBatch(CONFORMAL, n, phi, chi); }
+
+    /**
+     * Convert an array of conformal latitudes to geographic latitudes.
+     *
+     * @tparam T the type of the latitudes.
+     * @param[in] n the number of latitudes.
+     * @param[in] chi array of conformal latitudes (degrees).
+     * @param[out] phi array of geographic latitudes (degrees).
+     **********************************************************************/
+    template<typename T>
+    void InverseConformalLatitudeBatch(size_t n, const T chi[], T phi[]) const
+    { AuxBatch(INVCONFORMAL, n, chi, phi); }
+
+    /**
+     * Convert an array of geographic latitudes to isometric latitudes.
+     *
+     * @tparam T the type of the latitudes.
+     * @param[in] n the number of latitudes.
+     * @param[in] phi array of geographic latitudes (degrees).
+     * @param[out] psi array of isometric latitudes (degrees).
+     **********************************************************************/
+    template<typename T>
+    void IsometricLatitudeBatch(size_t n, const T phi[], T psi[]) const
+    { AuxBatch(ISOMETRIC, n, phi, psi); }
+
+    /**
+     * Convert an array of isometric latitudes to geographic latitudes.
+     *
+     * @tparam T the type of the latitudes.
+     * @param[in] n the number of latitudes.
+     * @param[in] psi array of isometric latitudes (degrees).
+     * @param[out] phi array of geographic latitudes (degrees).
+     **********************************************************************/
+    template<typename T>
+    void InverseIsometricLatitudeBatch(size_t n, const T psi[], T phi[]) const
+    { AuxBatch(INVISOMETRIC, n, psi, phi); }
+    ///@}
+
     /** \name Other quantities.
      **********************************************************************/
     ///@{
@@ -0,0 +1,177 @@
+/**
+ * \file EllipsoidCache.hpp
+ * \brief Header for GeographicLib::EllipsoidCache class
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_ELLIPSOIDCACHE_HPP)
+#define GEOGRAPHICLIB_ELLIPSOIDCACHE_HPP 1
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <GeographicLib/Constants.hpp>
+
+namespace GeographicLib {
+
+  class Geodesic;
+  class GeodesicExact;
+  class Rhumb;
+  class TransverseMercator;
+
+  /**
+   * \brief A cache of objects for several ellipsoids
+   *
+   * Applications which deal with many ellipsoids may use this class to avoid
+   * constructing a new Geodesic, GeodesicExact, Rhumb, or TransverseMercator
+   * object for each request.  The objects are constructed on demand using
+   * the normal constructors and are handed out as std::shared_ptr's to const
+   * objects which can be used concurrently by several threads.  The objects
+   * of each class are keyed on the parameters of the constructor (\e a, \e
+   * f, and \e exact or \e k0) and the number of objects of each class held
+   * is bounded; when this bound is exceeded, the least recently used object
+   * is dropped from the cache.  (The object remains valid for as long as a
+   * caller holds a shared_ptr to it.)
+   *
+   * All the member functions are thread safe.
+   *
+   * Example of use:
+   * \code
+   * EllipsoidCache cache(16);
+   * auto geod = cache.GeodesicInstance(Constants::WGS84_a(),
+   *                                    Constants::WGS84_f());
+   * double s12;
+   * geod->Inverse(40.6, -73.8, 51.6, -0.5, s12);
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT EllipsoidCache {
+  private:
+    typedef Math::real real;
+    typedef std::tuple<real, real, real> key;
+    template<class T> class LRU {
+    private:
+      typedef std::pair<key, std::shared_ptr<const T> > item;
+      std::list<item> _list;    // most recently used first
+      std::map<key, typename std::list<item>::iterator> _map;
+    public:
+      // Return the cached object for key k, or null if there isn't one.
+      std::shared_ptr<const T> Find(const key& k);
+      void Insert(const key& k, const std::shared_ptr<const T>& t,
+                  size_t capacity);
+      void Clear() { _list.clear(); _map.clear(); }
+      size_t Size() const { return _list.size(); }
+    };
+    size_t _capacity;
+    mutable std::mutex _lock;
+    unsigned long long _hits, _misses;
+    LRU<Geodesic> _geod;
+    LRU<GeodesicExact> _geodexact;
+    LRU<Rhumb> _rhumb;
+    LRU<TransverseMercator> _tm;
+    // Return the object for key k, calling make() to construct it if it's
+    // not in the cache.
+    template<class T, class F>
+    std::shared_ptr<const T> Lookup(LRU<T>& cache, const key& k, F make);
+    EllipsoidCache(const EllipsoidCache&) = delete;
+    EllipsoidCache& operator=(const EllipsoidCache&) = delete;
+  public:
+
+    /**
+     * Constructor for EllipsoidCache.
+     *
+     * @param[in] capacity the maximum number of objects of each class to
+     *   hold in the cache.
+     * @exception GeographicErr if \e capacity is zero.
+     **********************************************************************/
+    explicit EllipsoidCache(size_t capacity = 64);
+
+    /** \name Retrieving objects
+     **********************************************************************/
+    ///@{
+    /**
+     * @param[in] a equatorial radius (meters).
+     * @param[in] f flattening of ellipsoid.
+     * @exception GeographicErr if \e a or (1 &minus; \e f) \e a is not
+     *   positive.
+     * @return a shared pointer to the Geodesic object for this ellipsoid.
+     **********************************************************************/
+    std::shared_ptr<const Geodesic> GeodesicInstance(real a, real f);
+
+    /**
+     * @param[in] a equatorial radius (meters).
+     * @param[in] f flattening of ellipsoid.
+     * @exception GeographicErr if \e a or (1 &minus; \e f) \e a is not
+     *   positive.
+     * @return a shared pointer to the GeodesicExact object for this
+     *   ellipsoid.
+     **********************************************************************/
+    std::shared_ptr<const GeodesicExact> GeodesicExactInstance(real a, real f);
+
+    /**
+     * @param[in] a equatorial radius (meters).
+     * @param[in] f flattening of ellipsoid.
+     * @param[in] exact if true (the default) use an addition theorem for
+     *   elliptic integrals to compute divided differences; otherwise use
+     *   series expansion (accurate for |<i>f</i>| < 0.01).
+     * @exception GeographicErr if \e a or (1 &minus; \e f) \e a is not
+     *   positive.
+     * @return a shared pointer to the Rhumb object for this ellipsoid.
+     **********************************************************************/
+    std::shared_ptr<const Rhumb> RhumbInstance(real a, real f,
+                                               bool exact = true);
+
+    /**
+     * @param[in] a equatorial radius (meters).
+     * @param[in] f flattening of ellipsoid.
+     * @param[in] k0 central scale factor.
+     * @exception GeographicErr if \e a, (1 &minus; \e f) \e a, or \e k0 is
+     *   not positive.
+     * @return a shared pointer to the TransverseMercator object for this
+     *   ellipsoid and scale.
+     **********************************************************************/
+    std::shared_ptr<const TransverseMercator>
+    TransverseMercatorInstance(real a, real f, real k0);
+    ///@}
+
+    /** \name Managing the cache
+     **********************************************************************/
+    ///@{
+    /**
+     * Remove all the objects from the cache.  The hit and miss counters are
+     * not reset.
+     **********************************************************************/
+    void Clear();
+
+    /**
+     * @return the maximum number of objects of each class held.
+     **********************************************************************/
+    size_t Capacity() const { return _capacity; }
+
+    /**
+     * @return the total number of objects currently held.
+     **********************************************************************/
+    size_t Size() const;
+
+    /**
+     * @return the number of requests satisfied from the cache.
+     **********************************************************************/
+    unsigned long long Hits() const;
+
+    /**
+     * @return the number of requests which required a new object to be
+     *   constructed.
+     **********************************************************************/
+    unsigned long long Misses() const;
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_ELLIPSOIDCACHE_HPP
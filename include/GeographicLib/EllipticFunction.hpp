@@ -66,6 +66,15 @@ namespace GeographicLib {
     enum { num_ = 13 }; // Max depth required for sncndn; probably 5 is enough.
     real _k2, _kp2, _alpha2, _alphap2, _eps;
     real _Kc, _Ec, _Dc, _Pic, _Gc, _Hc;
+    // The Landen sequence for sncndn; returns the length
+    unsigned Landen(real m[], real n[], real& c, real& d) const;
+    // The incomplete integrals evaluated by the batch routines
+    enum inttype { INTF, INTE, INTD, INTPI, INTG, INTH };
+    // Set I to the unsymmetrized integral of type t for a block of m sets of
+    // sn, cn, dn
+    void IntBlock(inttype t, size_t m, const real sn[], const real cn[],
+                  const real dn[], real I[]) const;
+    void IntBatch(inttype t, size_t n, const real phi[], real I[]) const;
   public:
     /** \name Constructor
      **********************************************************************/
@@ -588,6 +597,109 @@ namespace GeographicLib {
     }
     ///@}
 
+    /** \name Batch evaluation.
+     **********************************************************************/
+    ///@{
+    /**
+     * The incomplete integral of the first kind for an array of arguments.
+     *
+     * @param[in] n the number of arguments.
+     * @param[in] phi array of arguments.
+     * @param[out] F array of \e F(&phi;, \e k).
+     *
+     * The arguments are processed in blocks; within a block the duplication
+     * steps of the symmetric integrals are carried out in lockstep so that
+     * the compiler can vectorize them (see Dispatch).  The results are the
+     * same as calling F(real) for each argument.  The output array may
+     * coincide with the input array.  The other batch routines work the
+     * same way.
+     **********************************************************************/
+    void FBatch(size_t n, const real phi[], real F[]) const
+    { IntBatch(INTF, n, phi, F); }
+
+    /**
+     * The incomplete integral of the second kind for an array of arguments.
+     *
+     * @param[in] n the number of arguments.
+     * @param[in] phi array of arguments.
+     * @param[out] E array of \e E(&phi;, \e k).
+     **********************************************************************/
+    void EBatch(size_t n, const real phi[], real E[]) const
+    { IntBatch(INTE, n, phi, E); }
+
+    /**
+     * The incomplete integral of the second kind for an array of arguments
+     * given in degrees.
+     *
+     * @param[in] n the number of arguments.
+     * @param[in] ang array of arguments (degrees).
+     * @param[out] E array of \e E(&pi; <i>ang</i>/180, \e k).
+     *
+     * The reduction of the arguments is done with Math::sincosdBatch.
+     **********************************************************************/
+    void EdBatch(size_t n, const real ang[], real E[]) const;
+
+    /**
+     * The incomplete integral of the third kind for an array of arguments.
+     *
+     * @param[in] n the number of arguments.
+     * @param[in] phi array of arguments.
+     * @param[out] Pi array of &Pi;(&phi;, &alpha;<sup>2</sup>, \e k).
+     *
+     * <i>R</i><sub><i>J</i></sub> is evaluated separately for each
+     * argument.
+     **********************************************************************/
+    void PiBatch(size_t n, const real phi[], real Pi[]) const
+    { IntBatch(INTPI, n, phi, Pi); }
+
+    /**
+     * Jahnke's incomplete elliptic integral for an array of arguments.
+     *
+     * @param[in] n the number of arguments.
+     * @param[in] phi array of arguments.
+     * @param[out] D array of \e D(&phi;, \e k).
+     **********************************************************************/
+    void DBatch(size_t n, const real phi[], real D[]) const
+    { IntBatch(INTD, n, phi, D); }
+
+    /**
+     * Legendre's geodesic longitude integral for an array of arguments.
+     *
+     * @param[in] n the number of arguments.
+     * @param[in] phi array of arguments.
+     * @param[out] G array of \e G(&phi;, &alpha;<sup>2</sup>, \e k).
+     **********************************************************************/
+    void GBatch(size_t n, const real phi[], real G[]) const
+    { IntBatch(INTG, n, phi, G); }
+
+    /**
+     * Cayley's geodesic longitude difference integral for an array of
+     * arguments.
+     *
+     * @param[in] n the number of arguments.
+     * @param[in] phi array of arguments.
+     * @param[out] H array of \e H(&phi;, &alpha;<sup>2</sup>, \e k).
+     **********************************************************************/
+    void HBatch(size_t n, const real phi[], real H[]) const
+    { IntBatch(INTH, n, phi, H); }
+
+    /**
+     * The Jacobi elliptic functions for an array of arguments.
+     *
+     * @param[in] n the number of arguments.
+     * @param[in] x array of arguments.
+     * @param[out] sn array of sn(\e x, \e k).
+     * @param[out] cn array of cn(\e x, \e k).
+     * @param[out] dn array of dn(\e x, \e k).
+     *
+     * The Landen sequence, which depends only on \e k, is computed once.
+     * The results are the same as calling sncndn for each argument.  Any of
+     * the output arrays may coincide with the input array.
+     **********************************************************************/
+    void sncndnBatch(size_t n, const real x[],
+                     real sn[], real cn[], real dn[]) const;
+    ///@}
+
     /** \name Symmetric elliptic integrals.
      **********************************************************************/
     ///@{
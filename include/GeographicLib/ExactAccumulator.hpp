@@ -0,0 +1,193 @@
+/**
+ * \file ExactAccumulator.hpp
+ * \brief Header for GeographicLib::ExactAccumulator class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_EXACTACCUMULATOR_HPP)
+#define GEOGRAPHICLIB_EXACTACCUMULATOR_HPP 1
+
+#include <cstring>
+#include <GeographicLib/Constants.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief An exact accumulator for sums of doubles
+   *
+   * This holds the exact sum of any number of doubles as a fixed-point
+   * number wide enough to cover the whole range of doubles (a
+   * "superaccumulator"), see U. W. Kulisch and W. L. Miranker,
+   * <a href="https://doi.org/10.1137/1028001">The arithmetic of the
+   * digital computer: a new approach</a>, SIAM Review 28(1), 1--40 (1986).
+   * Adding a number is carried out with integer arithmetic without
+   * rounding; so, unlike Accumulator, addition is associative and the sum
+   * doesn't depend on the order in which the numbers are added.  In
+   * particular, partial sums computed on several threads and combined with
+   * operator+=(const ExactAccumulator&) give the same result, to the last
+   * bit, regardless of how the numbers were divided among the threads.  The
+   * value returned by operator()() is the exact sum correctly rounded to a
+   * double.
+   *
+   * The sum is stored as 68 "digits" of 32 bits each (covering
+   * 2<sup>&minus;1074</sup> through 2<sup>1102</sup>), held in 64-bit
+   * integers so that the carries only need to be propagated occasionally.
+   * An object occupies about 560 bytes.  Adding a number costs a few
+   * integer operations and is about as fast as adding it to an
+   * Accumulator<double>.
+   *
+   * Infinities and NaNs are tracked separately; the result is a NaN if a
+   * NaN or infinities of both signs have been added and is infinite if
+   * infinities of one sign have been added (or if the sum overflows).
+   *
+   * The numbers are doubles regardless of the precision of Math::real.
+   * IEEE double precision arithmetic is assumed.
+   *
+   * Example of use:
+   * \code
+   * // Sum the blocks of y on several threads
+   * std::vector<ExactAccumulator> part(nblocks);
+   * // ... part[b] += y[i] for the elements i of block b ...
+   * ExactAccumulator sum;
+   * for (const auto& p : part) sum += p;
+   * double s = sum();  // the same for any division into blocks
+   * \endcode
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT ExactAccumulator {
+  private:
+    static const int ndigits_ = 68;
+    // The digit containing 2^p holds bits p - 32 * k, with k = (p + bias_) /
+    // 32, of the sum
+    static const int bias_ = 1074;
+    static const unsigned long long mask_ = 0xffffffffULL;
+    // The number of additions between normalizations; after a
+    // normalization the digits are less than 2^32 in magnitude and each
+    // addition adds less than 2^32 to each digit.
+    static const unsigned maxpending_ = 1U << 30;
+    // The sum is sum(_d[k] * 2^(32 * k - bias_))
+    long long _d[ndigits_];
+    unsigned _pending;
+    bool _nan, _pinf, _ninf;
+    void Add(double y) {
+      unsigned long long b;
+      std::memcpy(&b, &y, sizeof(b));
+      int e = int((b >> 52) & 0x7ff);
+      if (e == 0x7ff) {
+        AddNonFinite(y);
+        return;
+      }
+      // |y| = a * 2^(p - bias_)
+      unsigned long long a = b & ((1ULL << 52) - 1);
+      if (e) a |= 1ULL << 52;
+      if (a == 0) return;
+      int p = e ? e - 1 : 0, k = p / 32, s = p % 32;
+      long long
+        d0 = (long long)((a << s) & mask_),
+        d1 = (long long)((a >> (32 - s)) & mask_),
+        d2 = (long long)(s ? a >> (64 - s) : 0);
+      if (b >> 63) {
+        _d[k] -= d0; _d[k + 1] -= d1; _d[k + 2] -= d2;
+      } else {
+        _d[k] += d0; _d[k + 1] += d1; _d[k + 2] += d2;
+      }
+      if (++_pending == maxpending_) Normalize();
+    }
+    void AddNonFinite(double y);
+    // Propagate the carries so that all the digits, except the most
+    // significant one, are in [0, 2^32).
+    void Normalize();
+    void Negate();
+    void Merge(const ExactAccumulator& a, bool negate);
+  public:
+    /**
+     * Construct from a double.  This is not declared explicit, so that you
+     * can write <code>ExactAccumulator a = 5;</code>.
+     *
+     * @param[in] y set \e sum = \e y.
+     **********************************************************************/
+    ExactAccumulator(double y = 0) { *this = y; }
+    /**
+     * Set the accumulator to a number.
+     *
+     * @param[in] y set \e sum = \e y.
+     **********************************************************************/
+    ExactAccumulator& operator=(double y) {
+      std::memset(_d, 0, sizeof(_d));
+      _pending = 0;
+      _nan = _pinf = _ninf = false;
+      Add(y);
+      return *this;
+    }
+    /**
+     * Return the value held in the accumulator.
+     *
+     * @return \e sum correctly rounded to a double.
+     **********************************************************************/
+    double operator()() const;
+    /**
+     * Return the result of adding a number to \e sum (but don't change \e
+     * sum).
+     *
+     * @param[in] y the number to be added to the sum.
+     * @return \e sum + \e y correctly rounded to a double.
+     **********************************************************************/
+    double operator()(double y) const {
+      ExactAccumulator a(*this);
+      a.Add(y);
+      return a();
+    }
+    /**
+     * Add a number to the accumulator.
+     *
+     * @param[in] y set \e sum += \e y.
+     **********************************************************************/
+    ExactAccumulator& operator+=(double y) { Add(y); return *this; }
+    /**
+     * Subtract a number from the accumulator.
+     *
+     * @param[in] y set \e sum -= \e y.
+     **********************************************************************/
+    ExactAccumulator& operator-=(double y) { Add(-y); return *this; }
+    /**
+     * Add another accumulator to this one.  The result is exact.
+     *
+     * @param[in] a set \e sum += the sum held in \e a.
+     **********************************************************************/
+    ExactAccumulator& operator+=(const ExactAccumulator& a)
+    { Merge(a, false); return *this; }
+    /**
+     * Subtract another accumulator from this one.  The result is exact.
+     *
+     * @param[in] a set \e sum -= the sum held in \e a.
+     **********************************************************************/
+    ExactAccumulator& operator-=(const ExactAccumulator& a)
+    { Merge(a, true); return *this; }
+    /**
+     * Add an array of numbers to the accumulator.
+     *
+     * @param[in] n the number of elements in \e y.
+     * @param[in] y the array of numbers to be added.
+     * @param[in] threads the number of threads to use (default 1); if this
+     *   is 0, the number reported by std::thread::hardware_concurrency() is
+     *   used.
+     * @return a reference to the accumulator.
+     *
+     * The numbers are summed in blocks (on several threads if \e threads is
+     * greater than 1) and the partial sums are combined.  Because the
+     * addition is exact, the result doesn't depend on \e threads.
+     **********************************************************************/
+    ExactAccumulator& Add(size_t n, const double y[], unsigned threads = 1);
+    /**
+     * Multiply the accumulator by &minus;1.
+     *
+     * @return a reference to the accumulator.
+     **********************************************************************/
+    ExactAccumulator& negate() { Negate(); return *this; }
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_EXACTACCUMULATOR_HPP
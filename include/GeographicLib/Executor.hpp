@@ -0,0 +1,175 @@
+/**
+ * \file Executor.hpp
+ * \brief Header for GeographicLib::Executor class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_EXECUTOR_HPP)
+#define GEOGRAPHICLIB_EXECUTOR_HPP 1
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <GeographicLib/Constants.hpp>
+
+#if defined(_OPENMP)
+#  include <exception>
+#  include <mutex>
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief Run the tasks of the parallel functions
+   *
+   * All the functions in GeographicLib which take a \e threads argument
+   * (e.g., PolygonAreaBatch, DistanceMatrix, GeodesicIntersect::Segments,
+   * GravityModel::GeoidHeightGrid, and NearestNeighbor) split their work into
+   * independent tasks and hand these to an Executor.  By default, this is a
+   * ThreadExecutor which runs the tasks on a pool of std::thread objects
+   * started for each call.  An application with its own scheduler can route
+   * all this work to it by deriving a class from Executor and installing an
+   * instance of it with Executor::Set.  Because the \e threads argument is
+   * passed on to the executor, it then serves as a hint for the desired
+   * concurrency.
+   *
+   * If \e threads is 1 (or there's only one task), the tasks are run in the
+   * calling thread without involving the executor.
+   *
+   * This header also defines SerialExecutor, which runs the tasks in the
+   * calling thread, and, if compiled with OpenMP support, OpenMPExecutor.
+   * An adapter for Intel's TBB is
+   * \code
+   * class TBBExecutor : public GeographicLib::Executor {
+   * public:
+   *   void Run(size_t ntasks, unsigned,
+   *            const std::function<void(size_t)>& task) override {
+   *     tbb::parallel_for(size_t(0), ntasks, task);
+   *   }
+   * };
+   * ...
+   * GeographicLib::Executor::Set(std::make_shared<TBBExecutor>());
+   * \endcode
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT Executor {
+  public:
+    virtual ~Executor() {}
+
+    /**
+     * Run a set of tasks.
+     *
+     * @param[in] ntasks the number of tasks.
+     * @param[in] threads the requested number of threads (at least 2).
+     * @param[in] task the function to call for each task.
+     *
+     * This must call \e task(\e k) exactly once for each \e k in [0,
+     * \e ntasks) and return when all of the calls have completed.  The calls
+     * may be made concurrently and in any order.  If a call throws an
+     * exception, the remaining tasks may be skipped and the exception should
+     * be rethrown in the calling thread.
+     *
+     * A task may itself call Run (NearestNeighbor builds the two subtrees of
+     * a node concurrently in this way), so an implementation which waits
+     * for a fixed pool of threads should let the waiting thread run tasks.
+     **********************************************************************/
+    virtual void Run(size_t ntasks, unsigned threads,
+                     const std::function<void(size_t)>& task) = 0;
+
+    /**
+     * Install an executor for all the parallel functions.
+     *
+     * @param[in] exec the executor; if this is null, the default
+     *   ThreadExecutor is restored.
+     *
+     * Calls which are already in progress continue to use the previous
+     * executor.
+     **********************************************************************/
+    static void Set(std::shared_ptr<Executor> exec);
+
+    /**
+     * @return the executor currently installed.
+     **********************************************************************/
+    static std::shared_ptr<Executor> Get();
+
+    /**
+     * Run a set of tasks using the installed executor.
+     *
+     * @param[in] ntasks the number of tasks.
+     * @param[in] threads the requested number of threads; if 0, the number
+     *   reported by std::thread::hardware_concurrency() is used.
+     * @param[in] task the function to call for each task.
+     *
+     * If \e threads (or \e ntasks) is 1, the tasks are run in order in the
+     * calling thread.  Otherwise, the installed executor is called with the
+     * number of threads reduced to \e ntasks if necessary.
+     **********************************************************************/
+    static void Parallel(size_t ntasks, unsigned threads,
+                         const std::function<void(size_t)>& task);
+  };
+
+  /**
+   * \brief Run the tasks on a pool of std::thread objects
+   *
+   * This is the default Executor.  Each call to Run starts \e threads
+   * &minus; 1 threads and the calling thread joins in the work.  The tasks
+   * are handed out dynamically.  If not all the threads can be started, the
+   * tasks are run on the ones that were.  An exception thrown by a task is
+   * rethrown in the calling thread (after the other threads have finished).
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT ThreadExecutor : public Executor {
+  public:
+    void Run(size_t ntasks, unsigned threads,
+             const std::function<void(size_t)>& task) override;
+  };
+
+  /**
+   * \brief Run the tasks in the calling thread
+   *
+   * Installing this Executor turns off multithreading for all the parallel
+   * functions.
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT SerialExecutor : public Executor {
+  public:
+    void Run(size_t ntasks, unsigned,
+             const std::function<void(size_t)>& task) override {
+      for (size_t k = 0; k < ntasks; ++k) task(k);
+    }
+  };
+
+#if defined(_OPENMP)
+  /**
+   * \brief Run the tasks with OpenMP
+   *
+   * This is only defined when the including code is compiled with OpenMP
+   * support (it is defined entirely in the header, so the library itself
+   * doesn't need to be compiled with OpenMP).
+   **********************************************************************/
+  class OpenMPExecutor : public Executor {
+  public:
+    void Run(size_t ntasks, unsigned threads,
+             const std::function<void(size_t)>& task) override {
+      // Exceptions can't escape a parallel region, so save the first one.
+      std::exception_ptr err;
+      std::mutex lock;
+      const long long n = (long long)(ntasks);
+#pragma omp parallel for num_threads(threads) schedule(dynamic)
+      for (long long k = 0; k < n; ++k) {
+        try {
+          task(size_t(k));
+        }
+        catch (...) {
+          std::lock_guard<std::mutex> g(lock);
+          if (!err) err = std::current_exception();
+        }
+      }
+      if (err) std::rethrow_exception(err);
+    }
+  };
+#endif
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_EXECUTOR_HPP
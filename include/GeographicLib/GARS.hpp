@@ -57,6 +57,64 @@ namespace GeographicLib {
     };
     GARS();                     // Disable constructor
 
+  public:
+    /**
+     * The status returned by the conversion from a character buffer which
+     * does not throw an exception.
+     **********************************************************************/
+    enum status {
+      /**
+       * The conversion succeeded.
+       * @hideinitializer
+       **********************************************************************/
+      OK = 0,
+      /**
+       * The GARS string is illegal.
+       * @hideinitializer
+       **********************************************************************/
+      BADSTRING = 1,
+      /**
+       * The latitude is not in [&minus;90&deg;, 90&deg;] or the adjacent
+       * cell lies beyond a pole.
+       * @hideinitializer
+       **********************************************************************/
+      BADLATITUDE = 2,
+      /**
+       * The latitude or longitude is NaN (cell ids only).
+       * @hideinitializer
+       **********************************************************************/
+      BADCOORDS = 3,
+      /**
+       * The output buffer is too small.
+       * @hideinitializer
+       **********************************************************************/
+      BUFFERTOOSMALL = 4,
+      /**
+       * The cell id is out of range for the precision.
+       * @hideinitializer
+       **********************************************************************/
+      BADCELLID = 5,
+    };
+
+  private:
+    // If throwp = false, return a status instead of throwing an exception.
+    static status ReverseChars(const char* gars, int len,
+                               real& lat, real& lon, int& prec,
+                               bool centerp, bool throwp);
+    // Set x and y to the indices of the 5' cell containing (lat, lon), which
+    // must be valid.
+    static void Indices(real lat, real lon, int& x, int& y);
+    // Write the baselen_ + prec characters of the GARS for the 5' cell x, y.
+    static void Chars(int x, int y, int prec, char gars[]);
+    // Set x and y to the indices of the cell given by gars at the precision
+    // prec.  "INVALID" is treated as an illegal string.
+    static status ParseChars(const char* gars, int len, int& x, int& y,
+                             int& prec, bool throwp);
+    // The number of cells per degree for a precision
+    static int Mult(int prec) {
+      return prec <= 0 ? mult1_ : (prec == 1 ? mult1_ * mult2_ : m_);
+    }
+
   public:
 
     /**
@@ -102,6 +160,164 @@ namespace GeographicLib {
     static void Reverse(const std::string& gars, real& lat, real& lon,
                         int& prec, bool centerp = true);
 
+    /**
+     * Convert from GARS in a character buffer to geographic coordinates
+     * without throwing an exception.
+     *
+     * @param[in] gars the GARS (need not be null-terminated).
+     * @param[in] len the number of characters in \e gars.
+     * @param[out] lat latitude of point (degrees).
+     * @param[out] lon longitude of point (degrees).
+     * @param[out] prec the precision of \e gars.
+     * @param[in] centerp if true (the default) return the center of the
+     *   \e gars, otherwise return the south-west corner.
+     * @return BADSTRING if \e gars is illegal (in which case the output
+     *   arguments are unchanged), otherwise OK.
+     **********************************************************************/
+    static status Reverse(const char* gars, size_t len,
+                          real& lat, real& lon, int& prec,
+                          bool centerp = true);
+
+    /** \name Integer cell ids
+     *
+     * The cell id of a GARS of precision \e prec is \e j \e n + \e i, where \e
+     * i and \e j are the indices of the cell counting east from
+     * &minus;180&deg; and north from &minus;90&deg; and \e n = 360 /
+     * Resolution(\e prec) is the number of cells around a parallel.  The cell
+     * ids are dense, lying in [0, 64800 / Resolution(\e prec)<sup>2</sup>),
+     * and the precision is not encoded and must be supplied separately.
+     * Internally, \e prec is first put in the range [0, 2].  These routines
+     * neither allocate memory nor throw exceptions; instead an error is
+     * signaled by the returned status.  On failure the output arguments are
+     * unchanged.
+     **********************************************************************/
+    ///@{
+    /**
+     * Convert from geographic coordinates to a GARS cell id.
+     *
+     * @param[in] lat latitude of point (degrees).
+     * @param[in] lon longitude of point (degrees).
+     * @param[in] prec the precision of the GARS.
+     * @param[out] id the cell id.
+     * @return the status of the conversion; BADLATITUDE is returned if \e
+     *   lat is not in [&minus;90&deg;, 90&deg;] and BADCOORDS if \e lat or
+     *   \e lon is NaN.
+     **********************************************************************/
+    static status Forward(real lat, real lon, int prec,
+                          unsigned long long& id);
+
+    /**
+     * Convert from a GARS cell id to geographic coordinates.
+     *
+     * @param[in] id the cell id.
+     * @param[in] prec the precision of the GARS.
+     * @param[out] lat latitude of point (degrees).
+     * @param[out] lon longitude of point (degrees).
+     * @param[in] centerp if true (the default) return the center of the
+     *   cell, otherwise return the south-west corner.
+     * @return BADCELLID if \e id is out of range, otherwise OK.
+     **********************************************************************/
+    static status Reverse(unsigned long long id, int prec,
+                          real& lat, real& lon, bool centerp = true);
+
+    /**
+     * Convert arrays of geographic coordinates to GARS cell ids.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes (degrees).
+     * @param[in] lon array of longitudes (degrees).
+     * @param[in] prec the precision of the GARS.
+     * @param[out] id array of cell ids.
+     * @param[out] stat optional array of statuses for each point.
+     * @return the number of points for which the conversion failed.
+     *
+     * The cell id for a failed conversion is set to ~0, which is never a
+     * legal cell id.
+     **********************************************************************/
+    static size_t ForwardBatch(size_t n, const real lat[], const real lon[],
+                               int prec, unsigned long long id[],
+                               status stat[] = nullptr);
+
+    /**
+     * Convert an array of GARS cell ids to arrays of geographic coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] id array of cell ids.
+     * @param[in] prec the precision of the GARS.
+     * @param[out] lat array of latitudes (degrees).
+     * @param[out] lon array of longitudes (degrees).
+     * @param[in] centerp if true (the default) return the centers of the
+     *   cells, otherwise return the south-west corners.
+     * @param[out] stat optional array of statuses for each point.
+     * @return the number of points for which the conversion failed.
+     *
+     * For a failed conversion, \e lat and \e lon are set to NaN.
+     **********************************************************************/
+    static size_t ReverseBatch(size_t n, const unsigned long long id[],
+                               int prec, real lat[], real lon[],
+                               bool centerp = true, status stat[] = nullptr);
+
+    /**
+     * Convert a GARS in a character buffer to a cell id.
+     *
+     * @param[in] gars the GARS (need not be null-terminated).
+     * @param[in] len the number of characters in \e gars.
+     * @param[out] id the cell id.
+     * @param[out] prec the precision of \e gars.
+     * @return BADSTRING if \e gars is illegal or "INVALID", otherwise OK.
+     **********************************************************************/
+    static status CellId(const char* gars, size_t len,
+                         unsigned long long& id, int& prec);
+
+    /**
+     * Convert a cell id to a GARS in a character buffer.
+     *
+     * @param[in] id the cell id.
+     * @param[in] prec the precision of the GARS.
+     * @param[out] gars buffer for the null-terminated GARS.
+     * @param[in] size the size of \e gars.
+     * @return the status of the conversion; BADCELLID is returned if \e id
+     *   is out of range and BUFFERTOOSMALL if \e size is less than the
+     *   length of the result plus 1.
+     *
+     * A buffer with 8 characters is sufficient for all values of \e prec.
+     **********************************************************************/
+    static status CellString(unsigned long long id, int prec,
+                             char gars[], size_t size);
+
+    /**
+     * Find the id of a nearby cell of the same precision.
+     *
+     * @param[in] id the cell id.
+     * @param[in] prec the precision of the GARS.
+     * @param[in] dlat the number of cells to move north (negative for south).
+     * @param[in] dlon the number of cells to move east (negative for west).
+     * @param[out] adj the id of the resulting cell.
+     * @return the status; BADCELLID is returned if \e id is out of range and
+     *   BADLATITUDE if the resulting cell lies beyond a pole.
+     *
+     * Movement in longitude wraps around the antimeridian.
+     **********************************************************************/
+    static status Adjacent(unsigned long long id, int prec,
+                           int dlat, int dlon, unsigned long long& adj);
+
+    /**
+     * Find the ids of the neighbors of a cell.
+     *
+     * @param[in] id the cell id.
+     * @param[in] prec the precision of the GARS.
+     * @param[out] nbr the ids of the neighbors in the order N, NE, E, SE, S,
+     *   SW, W, NW.
+     * @return the number of neighbors.
+     *
+     * Neighbors lying beyond a pole are omitted (and the rest are moved up),
+     * so that 5 neighbors are returned for a cell touching a pole.  If \e id
+     * is out of range, 0 is returned.
+     **********************************************************************/
+    static int Neighbors(unsigned long long id, int prec,
+                         unsigned long long nbr[8]);
+    ///@}
+
     /**
      * The angular resolution of a GARS.
      *
@@ -111,8 +327,7 @@ namespace GeographicLib {
      * Internally, \e prec is first put in the range [0, 2].
      **********************************************************************/
     static Math::real Resolution(int prec) {
-      return 1/real(prec <= 0 ? mult1_ : (prec == 1 ? mult1_ * mult2_ :
-                                          mult1_ * mult2_ * mult3_));
+      return 1/real(Mult(prec));
     }
 
     /**
@@ -0,0 +1,323 @@
+/**
+ * \file GeoArrow.hpp
+ * \brief Header for GeographicLib::GeoArrow class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEOARROW_HPP)
+#define GEOGRAPHICLIB_GEOARROW_HPP 1
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <GeographicLib/Constants.hpp>
+
+// The structures of the Arrow C data interface; see
+// https://arrow.apache.org/docs/format/CDataInterface.html.  These are
+// ABI-stable and the guard allows them to be defined by several libraries.
+#if !defined(ARROW_C_DATA_INTERFACE)
+#define ARROW_C_DATA_INTERFACE
+
+extern "C" {
+
+  struct ArrowSchema {
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+    void (*release)(struct ArrowSchema*);
+    void* private_data;
+  };
+
+  struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+    void (*release)(struct ArrowArray*);
+    void* private_data;
+  };
+
+}
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs vector
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  class Geodesic;
+  class Geoid;
+  template<class GeodType> class PolygonAreaBatchT;
+  typedef PolygonAreaBatchT<Geodesic> PolygonAreaBatch;
+
+  /**
+   * \brief Apache Arrow columns for the batch routines
+   *
+   * This class exchanges data with Apache Arrow (and so with Parquet
+   * readers and dataframe libraries built on Arrow) through the
+   * <a href="https://arrow.apache.org/docs/format/CDataInterface.html">
+   * Arrow C data interface</a>.  This is a pair of C structures,
+   * ArrowSchema and ArrowArray, which are filled in by, e.g.,
+   * arrow::ExportArray in C++ or pyarrow's Array._export_to_c; since the
+   * interface is ABI-stable, GeographicLib doesn't need to be linked with
+   * Arrow.
+   *
+   * The following input columns are recognized:
+   * - float64 ("g") and float32 ("f") columns;
+   * - <a href="https://geoarrow.org">GeoArrow</a> points in the separated
+   *   encoding (a struct of \e x and \e y columns, possibly followed by \e
+   *   z and \e m) or the interleaved encoding (a fixed size list of 2, 3, or
+   *   4 coordinates); \e x is the longitude and \e y is the latitude;
+   * - GeoArrow polygons (a list of rings, each a list of points).
+   * When the library is compiled with double precision (the default), a
+   * float64 column without nulls is used in place (without copying).
+   * Otherwise the column is copied and null values are replaced by NaNs.
+   * Results are returned as new float64 columns (or int32 and boolean columns
+   * for the UTM zone and hemisphere) which own their memory; the consumer must
+   * call their release callbacks (Arrow does this when they are imported with,
+   * e.g., arrow::ImportArray).  A NaN result is not marked as a null.
+   *
+   * Example of use:
+   * \code
+   * // points1 and points2 are GeoArrow point arrays exported from Arrow
+   * ArrowSchema s12schema;
+   * ArrowArray s12array;
+   * GeoArrow::Inverse(Geodesic::WGS84(), schema1, points1, schema2, points2,
+   *                   &s12schema, &s12array);
+   * // import s12schema and s12array as an arrow::Array
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT GeoArrow {
+  private:
+    typedef Math::real real;
+  public:
+
+    /**
+     * \brief A read-only view of a numerical Arrow column
+     *
+     * This holds a pointer to the values of the column; if the column
+     * couldn't be used in place, the values are copied into storage owned
+     * by the Column.  The Arrow array must outlive the Column.
+     **********************************************************************/
+    class GEOGRAPHICLIB_EXPORT Column {
+    private:
+      friend class GeoArrow;
+      const real* _data;
+      size_t _n;
+      std::vector<real> _buf;
+      Column(const Column&) = delete;
+      Column& operator=(const Column&) = delete;
+    public:
+      /**
+       * Constructor for an empty Column.
+       **********************************************************************/
+      Column() : _data(nullptr), _n(0) {}
+      /**
+       * Move constructor.
+       **********************************************************************/
+      Column(Column&&) = default;
+      /**
+       * Move assignment.
+       **********************************************************************/
+      Column& operator=(Column&&) = default;
+      /**
+       * @return the number of values.
+       **********************************************************************/
+      size_t size() const { return _n; }
+      /**
+       * @return a pointer to the values.
+       **********************************************************************/
+      const real* data() const { return _data; }
+      /**
+       * @param[in] i the index of a value.
+       * @return value \e i.
+       **********************************************************************/
+      real operator[](size_t i) const { return _data[i]; }
+      /**
+       * @return true if the values had to be copied.
+       **********************************************************************/
+      bool Copied() const { return _n > 0 && _data == _buf.data(); }
+    };
+
+    /** \name Importing columns
+     **********************************************************************/
+    ///@{
+    /**
+     * Read a float64 or float32 column.
+     *
+     * @param[in] schema the schema of the column.
+     * @param[in] array the column.
+     * @param[out] col the values.
+     * @exception GeographicErr if the column isn't float64 or float32.
+     **********************************************************************/
+    static void Import(const ArrowSchema& schema, const ArrowArray& array,
+                       Column& col);
+
+    /**
+     * Read a column of GeoArrow points.
+     *
+     * @param[in] schema the schema of the column.
+     * @param[in] array the column.
+     * @param[out] lat the latitudes (the \e y coordinates).
+     * @param[out] lon the longitudes (the \e x coordinates).
+     * @exception GeographicErr if the column isn't a GeoArrow point array
+     *   with float64 or float32 coordinates.
+     **********************************************************************/
+    static void ImportPoints(const ArrowSchema& schema,
+                             const ArrowArray& array,
+                             Column& lat, Column& lon);
+    ///@}
+
+    /** \name Exporting columns
+     **********************************************************************/
+    ///@{
+    /**
+     * Export a float64 column.
+     *
+     * @param[in] values the values (which are moved into the column when
+     *   the library is compiled with double precision).
+     * @param[in] name the name of the column.
+     * @param[out] schema the schema of the column.
+     * @param[out] array the column.
+     * @exception std::bad_alloc if memory for the column can't be allocated.
+     **********************************************************************/
+    static void Export(std::vector<real>&& values, const std::string& name,
+                       ArrowSchema* schema, ArrowArray* array);
+
+    /**
+     * Export an int32 column.
+     *
+     * @param[in] values the values.
+     * @param[in] name the name of the column.
+     * @param[out] schema the schema of the column.
+     * @param[out] array the column.
+     * @exception std::bad_alloc if memory for the column can't be allocated.
+     **********************************************************************/
+    static void Export(std::vector<int32_t>&& values, const std::string& name,
+                       ArrowSchema* schema, ArrowArray* array);
+    ///@}
+
+    /** \name Batch computations
+     **********************************************************************/
+    ///@{
+    /**
+     * Solve inverse geodesic problems between two columns of points.
+     *
+     * @param[in] geod the Geodesic object.
+     * @param[in] schema1 the schema of the first points.
+     * @param[in] points1 the first points.
+     * @param[in] schema2 the schema of the second points.
+     * @param[in] points2 the second points.
+     * @param[out] s12schema the schema of the distance column.
+     * @param[out] s12 the distances "s12" (meters).
+     * @param[out] azi1schema (optional) the schema of the azimuth column.
+     * @param[out] azi1 (optional) the azimuths "azi1" at the first points
+     *   (degrees).
+     * @param[out] azi2schema (optional) the schema of the azimuth column.
+     * @param[out] azi2 (optional) the azimuths "azi2" at the second points
+     *   (degrees).
+     * @exception GeographicErr if the columns aren't GeoArrow points or have
+     *   different lengths.
+     **********************************************************************/
+    static void Inverse(const Geodesic& geod,
+                        const ArrowSchema& schema1, const ArrowArray& points1,
+                        const ArrowSchema& schema2, const ArrowArray& points2,
+                        ArrowSchema* s12schema, ArrowArray* s12,
+                        ArrowSchema* azi1schema = nullptr,
+                        ArrowArray* azi1 = nullptr,
+                        ArrowSchema* azi2schema = nullptr,
+                        ArrowArray* azi2 = nullptr);
+
+    /**
+     * Compute the perimeters and areas of a column of GeoArrow polygons.
+     *
+     * @param[in] poly the PolygonAreaBatch object.
+     * @param[in] schema the schema of the polygons.
+     * @param[in] polygons the polygons.
+     * @param[out] perimeterschema the schema of the perimeter column.
+     * @param[out] perimeter the perimeters "perimeter" (meters).
+     * @param[out] areaschema the schema of the area column.
+     * @param[out] area the areas "area" (meters<sup>2</sup>).
+     * @exception GeographicErr if the column isn't a GeoArrow polygon array.
+     *
+     * The first ring of each polygon is the shell and the rest are holes;
+     * the area is the area enclosed by the shell less the areas enclosed by
+     * the holes (regardless of the orientation of the rings) and the
+     * perimeter is the total length of the rings.  The rings should enclose
+     * less than half the earth.  A null polygon gives NaN.  If \e poly
+     * treats the points as polylines, the area is NaN.
+     **********************************************************************/
+    static void PolygonAreas(const PolygonAreaBatch& poly,
+                             const ArrowSchema& schema,
+                             const ArrowArray& polygons,
+                             ArrowSchema* perimeterschema,
+                             ArrowArray* perimeter,
+                             ArrowSchema* areaschema, ArrowArray* area);
+
+    /**
+     * Convert a column of points to UTM/UPS.
+     *
+     * @param[in] schema the schema of the points.
+     * @param[in] points the points.
+     * @param[out] zoneschema the schema of the zone column.
+     * @param[out] zone the zones "zone" (0 means UPS and UTMUPS::INVALID
+     *   indicates an error).
+     * @param[out] northpschema the schema of the hemisphere column.
+     * @param[out] northp the hemispheres "northp" (true means north).
+     * @param[out] xschema the schema of the easting column.
+     * @param[out] x the eastings "easting" (meters).
+     * @param[out] yschema the schema of the northing column.
+     * @param[out] y the northings "northing" (meters).
+     * @exception GeographicErr if the column isn't GeoArrow points.
+     *
+     * The standard zone is used; see UTMUPS::ForwardBatch.
+     **********************************************************************/
+    static void UTMUPSForward(const ArrowSchema& schema,
+                              const ArrowArray& points,
+                              ArrowSchema* zoneschema, ArrowArray* zone,
+                              ArrowSchema* northpschema, ArrowArray* northp,
+                              ArrowSchema* xschema, ArrowArray* x,
+                              ArrowSchema* yschema, ArrowArray* y);
+
+    /**
+     * Compute the geoid heights at a column of points.
+     *
+     * @param[in] geoid the Geoid object.
+     * @param[in] schema the schema of the points.
+     * @param[in] points the points.
+     * @param[out] hschema the schema of the height column.
+     * @param[out] h the heights "geoid_height" of the geoid above the
+     *   ellipsoid (meters).
+     * @exception GeographicErr if the column isn't GeoArrow points or if
+     *   the geoid data can't be read.
+     **********************************************************************/
+    static void GeoidHeights(const Geoid& geoid,
+                             const ArrowSchema& schema,
+                             const ArrowArray& points,
+                             ArrowSchema* hschema, ArrowArray* h);
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_GEOARROW_HPP
@@ -32,6 +32,16 @@ namespace GeographicLib {
    * The mutable state consists of the UTM or UPS coordinates for a alternate
    * zone.  A method SetAltZone is provided to set the alternate UPS/UTM zone.
    *
+   * The coordinates which weren't supplied, together with the meridian
+   * convergence and scale, are computed on first use and then cached.  So a
+   * program which only needs the latitude and longitude of a position given
+   * as latitude and longitude, or only the UTM/UPS coordinates of a position
+   * given as UTM/UPS coordinates, doesn't pay for the projection.  The
+   * arguments are still checked when the object is constructed or reset, so
+   * the exceptions are thrown as before.  Because the const member
+   * functions may complete the coordinates, a GeoCoords object shouldn't be
+   * queried by several threads at once without synchronization.
+   *
    * Methods are provided to return the geographic coordinates, the input UTM
    * or UPS coordinates (and associated meridian convergence and scale), or
    * alternate UTM or UPS coordinates (and their associated meridian
@@ -49,19 +59,31 @@ namespace GeographicLib {
   class GEOGRAPHICLIB_EXPORT GeoCoords {
   private:
     typedef Math::real real;
-    real _lat, _long, _easting, _northing, _gamma, _k;
-    bool _northp;
-    int _zone;                  // See UTMUPS::zonespec
+    // The coordinates which are still to be computed from those supplied;
+    // FORWARD means the UTM/UPS coordinates, REVERSE means the latitude and
+    // longitude (in both cases together with _gamma and _k).
+    enum lazy { COMPLETE, FORWARD, REVERSE };
+    mutable real _lat, _long, _easting, _northing, _gamma, _k;
+    mutable bool _northp;
+    mutable int _zone;          // See UTMUPS::zonespec
+    mutable lazy _lazy;
+    // If _alt is false, the alternate zone is the same as _zone
+    mutable bool _alt;
     mutable real _alt_easting, _alt_northing, _alt_gamma, _alt_k;
     mutable int _alt_zone;
 
-    void CopyToAlt() const {
-      _alt_easting = _easting;
-      _alt_northing = _northing;
-      _alt_gamma = _gamma;
-      _alt_k = _k;
-      _alt_zone = _zone;
-    }
+    // Compute the pending coordinates
+    void Complete() const;
+    void Update() const { if (_lazy != COMPLETE) Complete(); }
+    void UpdateGeographic() const { if (_lazy == REVERSE) Complete(); }
+    void UpdateUTMUPS() const { if (_lazy == FORWARD) Complete(); }
+    // Set the latitude and longitude (in [-180, 180]) with the UTM/UPS
+    // coordinates in the standard zone.
+    void ResetGeographic(real lat, real lon);
+    // Set the UTM/UPS coordinates, optionally fixing the hemisphere (see
+    // FixHemisphere).
+    void ResetUTMUPS(int zone, bool northp, real easting, real northing,
+                     bool fixhemisphere);
     static void UTMUPSString(int zone, bool northp,
                              real easting, real northing,
                              int prec, bool abbrev, std::string& utm);
@@ -83,7 +105,9 @@ namespace GeographicLib {
       , _k(Math::NaN())
       , _northp(false)
       , _zone(UTMUPS::INVALID)
-    { CopyToAlt(); }
+      , _lazy(COMPLETE)
+      , _alt(false)
+    {}
 
     /**
      * Construct from a string.
@@ -235,16 +259,7 @@ namespace GeographicLib {
      *   90&deg;].
      * @exception GeographicErr if \e zone cannot be used for this location.
      **********************************************************************/
-    void Reset(real latitude, real longitude, int zone = UTMUPS::STANDARD) {
-      UTMUPS::Forward(latitude, longitude,
-                      _zone, _northp, _easting, _northing, _gamma, _k,
-                      zone);
-      _lat = latitude;
-      _long = longitude;
-      if (_long >= 180) _long -= 360;
-      else if (_long < -180) _long += 360;
-      CopyToAlt();
-    }
+    void Reset(real latitude, real longitude, int zone = UTMUPS::STANDARD);
 
     /**
      * Reset the location in terms of UPS/UPS coordinates.  See
@@ -257,16 +272,8 @@ namespace GeographicLib {
      * @exception GeographicErr if \e zone, \e easting, or \e northing is
      *   outside its allowed range.
      **********************************************************************/
-    void Reset(int zone, bool northp, real easting, real northing) {
-      UTMUPS::Reverse(zone, northp, easting, northing,
-                      _lat, _long, _gamma, _k);
-      _zone = zone;
-      _northp = northp;
-      _easting = easting;
-      _northing = northing;
-      FixHemisphere();
-      CopyToAlt();
-    }
+    void Reset(int zone, bool northp, real easting, real northing)
+    { ResetUTMUPS(zone, northp, easting, northing, true); }
     ///@}
 
     /** \name Querying the GeoCoords object
@@ -275,47 +282,47 @@ namespace GeographicLib {
     /**
      * @return latitude (degrees)
      **********************************************************************/
-    Math::real Latitude() const { return _lat; }
+    Math::real Latitude() const { UpdateGeographic(); return _lat; }
 
     /**
      * @return longitude (degrees)
      **********************************************************************/
-    Math::real Longitude() const { return _long; }
+    Math::real Longitude() const { UpdateGeographic(); return _long; }
 
     /**
      * @return easting (meters)
      **********************************************************************/
-    Math::real Easting() const { return _easting; }
+    Math::real Easting() const { UpdateUTMUPS(); return _easting; }
 
     /**
      * @return northing (meters)
      **********************************************************************/
-    Math::real Northing() const { return _northing; }
+    Math::real Northing() const { UpdateUTMUPS(); return _northing; }
 
     /**
      * @return meridian convergence (degrees) for the UTM/UPS projection.
      **********************************************************************/
-    Math::real Convergence() const { return _gamma; }
+    Math::real Convergence() const { Update(); return _gamma; }
 
     /**
      * @return scale for the UTM/UPS projection.
      **********************************************************************/
-    Math::real Scale() const { return _k; }
+    Math::real Scale() const { Update(); return _k; }
 
     /**
      * @return hemisphere (false means south, true means north).
      **********************************************************************/
-    bool Northp() const { return _northp; }
+    bool Northp() const { UpdateUTMUPS(); return _northp; }
 
     /**
      * @return hemisphere letter n or s.
      **********************************************************************/
-    char Hemisphere() const { return _northp ? 'n' : 's'; }
+    char Hemisphere() const { return Northp() ? 'n' : 's'; }
 
     /**
      * @return the zone corresponding to the input (return 0 for UPS).
      **********************************************************************/
-    int Zone() const { return _zone; }
+    int Zone() const { UpdateUTMUPS(); return _zone; }
 
     ///@}
 
@@ -337,42 +344,48 @@ namespace GeographicLib {
     void SetAltZone(int zone = UTMUPS::STANDARD) const {
       if (zone == UTMUPS::MATCH)
         return;
+      Update();
       zone = UTMUPS::StandardZone(_lat, _long, zone);
       if (zone == _zone)
-        CopyToAlt();
+        _alt = false;
       else {
         bool northp;
         UTMUPS::Forward(_lat, _long,
                         _alt_zone, northp,
                         _alt_easting, _alt_northing, _alt_gamma, _alt_k,
                         zone);
+        _alt = true;
       }
     }
 
     /**
      * @return current alternate zone (return 0 for UPS).
      **********************************************************************/
-    int AltZone() const { return _alt_zone; }
+    int AltZone() const { return _alt ? _alt_zone : Zone(); }
 
     /**
      * @return easting (meters) for alternate zone.
      **********************************************************************/
-    Math::real AltEasting() const { return _alt_easting; }
+    Math::real AltEasting() const
+    { return _alt ? _alt_easting : Easting(); }
 
     /**
      * @return northing (meters) for alternate zone.
      **********************************************************************/
-    Math::real AltNorthing() const { return _alt_northing; }
+    Math::real AltNorthing() const
+    { return _alt ? _alt_northing : Northing(); }
 
     /**
      * @return meridian convergence (degrees) for alternate zone.
      **********************************************************************/
-    Math::real AltConvergence() const { return _alt_gamma; }
+    Math::real AltConvergence() const
+    { return _alt ? _alt_gamma : Convergence(); }
 
     /**
      * @return scale for alternate zone.
      **********************************************************************/
-    Math::real AltScale() const { return _alt_k; }
+    Math::real AltScale() const
+    { return _alt ? _alt_k : Scale(); }
     ///@}
 
     /** \name String representations of the GeoCoords object
@@ -520,6 +533,53 @@ namespace GeographicLib {
                                         bool abbrev = true) const;
     ///@}
 
+    /** \name Batch conversions
+     **********************************************************************/
+    ///@{
+    /**
+     * Convert arrays of geographic coordinates to UTM/UPS and MGRS without
+     * constructing a GeoCoords object for each point.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes (degrees).
+     * @param[in] lon array of longitudes (degrees).
+     * @param[out] zone array of UTM zones (zero means UPS).
+     * @param[out] northp array of hemispheres.
+     * @param[out] easting array of eastings (meters).
+     * @param[out] northing array of northings (meters).
+     * @param[out] gamma array of meridian convergences (degrees).
+     * @param[out] k array of scales.
+     * @param[out] mgrs buffer of \e n &times; \e stride characters for the
+     *   null-terminated MGRS strings; the string for point \e i starts at \e
+     *   mgrs[\e i &times; \e stride].
+     * @param[in] stride the space allotted to each MGRS string (28 suffices
+     *   for all values of \e prec).
+     * @param[in] prec the precision of the MGRS strings relative to 1m, as
+     *   for MGRSRepresentation.
+     * @param[in] setzone the zone to use for the UTM/UPS coordinates; see
+     *   UTMUPS::zonespec.
+     * @exception GeographicErr if \e setzone is illegal.
+     * @return the number of points which could not be converted.
+     *
+     * Any of the output arrays may be null, in which case the corresponding
+     * quantity is not returned; the MGRS strings are only computed if \e mgrs
+     * is non-null.  The results are the same as would be returned by
+     * GeoCoords(\e lat[\e i], \e lon[\e i], \e setzone).  If a point can't
+     * be converted (because \e lat[\e i] is out of range or the point is too
+     * far from \e setzone), its zone is set to UTMUPS::INVALID, the other
+     * outputs are set to NaN, and its MGRS string is "INVALID"; if only the
+     * MGRS conversion fails, the MGRS string is set to the empty string.
+     * The coordinates in an alternate zone, see SetAltZone, are obtained by
+     * calling this function with \e setzone set to the alternate zone.
+     **********************************************************************/
+    static size_t ForwardBatch(size_t n, const real lat[], const real lon[],
+                               int zone[], bool northp[],
+                               real easting[], real northing[],
+                               real gamma[] = nullptr, real k[] = nullptr,
+                               char mgrs[] = nullptr, size_t stride = 0,
+                               int prec = 0, int setzone = UTMUPS::STANDARD);
+    ///@}
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
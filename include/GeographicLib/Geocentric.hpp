@@ -70,8 +70,10 @@ namespace GeographicLib {
     friend class LocalCartesian;
     friend class MagneticCircle; // MagneticCircle uses Rotation
     friend class MagneticModel;  // MagneticModel uses IntForward
+    friend class MagneticSnapshot; // MagneticSnapshot uses IntForward
     friend class GravityCircle;  // GravityCircle uses Rotation
     friend class GravityModel;   // GravityModel uses IntForward
+    friend class GravityTrajectory; // GravityTrajectory uses IntForward
     friend class NormalGravity;  // NormalGravity uses IntForward
     static const size_t dim_ = 3;
     static const size_t dim2_ = dim_ * dim_;
@@ -234,6 +236,50 @@ namespace GeographicLib {
         IntReverse(X, Y, Z, lat, lon, h, NULL);
     }
 
+    /** \name Batch conversions
+     **********************************************************************/
+    ///@{
+    /**
+     * Convert arrays of points from geodetic to geocentric coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes (degrees).
+     * @param[in] lon array of longitudes (degrees).
+     * @param[in] h array of heights above the ellipsoid (meters).
+     * @param[out] X array of geocentric coordinates (meters).
+     * @param[out] Y array of geocentric coordinates (meters).
+     * @param[out] Z array of geocentric coordinates (meters).
+     * @param[out] M if non-null, an array of 9 \e n elements which is filled
+     *   with the rotation matrices, each in row-major order.
+     *
+     * The results are the same as calling Forward for each point.  The output
+     * arrays may coincide with the input arrays.
+     **********************************************************************/
+    void ForwardBatch(size_t n, const real lat[], const real lon[],
+                      const real h[], real X[], real Y[], real Z[],
+                      real M[] = nullptr) const;
+
+    /**
+     * Convert arrays of points from geocentric to geodetic coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] X array of geocentric coordinates (meters).
+     * @param[in] Y array of geocentric coordinates (meters).
+     * @param[in] Z array of geocentric coordinates (meters).
+     * @param[out] lat array of latitudes (degrees).
+     * @param[out] lon array of longitudes (degrees).
+     * @param[out] h array of heights above the ellipsoid (meters).
+     * @param[out] M if non-null, an array of 9 \e n elements which is filled
+     *   with the rotation matrices, each in row-major order.
+     *
+     * The results are the same as calling Reverse for each point.  The output
+     * arrays may coincide with the input arrays.
+     **********************************************************************/
+    void ReverseBatch(size_t n, const real X[], const real Y[],
+                      const real Z[], real lat[], real lon[], real h[],
+                      real M[] = nullptr) const;
+    ///@}
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
@@ -26,6 +26,8 @@
 namespace GeographicLib {
 
   class GeodesicLine;
+  template<class GeodType> class DistanceMatrixT;
+  template<class GeodType> class GeodesicOriginT;
 
   /**
    * \brief %Geodesic calculations
@@ -173,6 +175,10 @@ namespace GeographicLib {
   private:
     typedef Math::real real;
     friend class GeodesicLine;
+    template<unsigned caps> friend class GeodesicLineCompact;
+    template<class GeodType> friend class DistanceMatrixT;
+    template<class GeodType> friend class GeodesicOriginT;
+    template<class GeodType> friend class GeodesicMetricT;
     static const int nA1_ = GEOGRAPHICLIB_GEODESIC_ORDER;
     static const int nC1_ = GEOGRAPHICLIB_GEODESIC_ORDER;
     static const int nC1p_ = GEOGRAPHICLIB_GEODESIC_ORDER;
@@ -209,6 +215,13 @@ namespace GeographicLib {
     static real Astroid(real x, real y);
 
     real _a, _f, _f1, _e2, _ep2, _n, _b, _c2, _etol2;
+    // The tolerance for the inverse problem, the corresponding tolerance for
+    // the Newton iteration, and the number of terms retained in the C1 and C3
+    // series.
+    real _tol, _tolv;
+    int _nC1t, _nC3t;
+    // f = 0, in which case closed-form spherical solutions are used
+    bool _sphere;
     real _A3x[nA3x_], _C3x[nC3x_], _C4x[nC4x_];
 
     void Lengths(real eps, real sig12,
@@ -230,10 +243,20 @@ namespace GeographicLib {
                   real& ssig1, real& csig1, real& ssig2, real& csig2,
                   real& eps, real& domg12,
                   bool diffp, real& dlam12, real Ca[]) const;
+    void InverseLat(real& lat, real& sbet, real& cbet, real& dn) const;
+    // If hint, salp1, calp1, salp2, calp2 hold the azimuths of a nearby
+    // solution on input; these are used to start Newton's method.
     real GenInverse(real lat1, real lon1, real lat2, real lon2,
                     unsigned outmask, real& s12,
                     real& salp1, real& calp1, real& salp2, real& calp2,
-                    real& m12, real& M12, real& M21, real& S12) const;
+                    real& m12, real& M12, real& M21, real& S12,
+                    bool hint = false) const;
+    real GenInverse(real lat1, real sbet1, real cbet1, real dn1, real lon1,
+                    real lat2, real sbet2, real cbet2, real dn2, real lon2,
+                    unsigned outmask, real& s12,
+                    real& salp1, real& calp1, real& salp2, real& calp2,
+                    real& m12, real& M12, real& M21, real& S12,
+                    bool hint = false) const;
 
     // These are Maxima generated functions to provide series approximations to
     // the integrals for the ellipsoidal geodesic.
@@ -332,10 +355,46 @@ namespace GeographicLib {
      * @param[in] a equatorial radius (meters).
      * @param[in] f flattening of ellipsoid.  Setting \e f = 0 gives a sphere.
      *   Negative \e f gives a prolate ellipsoid.
+     * @param[in] tol (optional) the tolerance for the inverse problem
+     *   (meters); the default value 0 gives full accuracy.
      * @exception GeographicErr if \e a or (1 &minus; \e f) \e a is not
-     *   positive.
+     *   positive, or if \e tol is negative.
+     *
+     * A positive \e tol trades accuracy for speed in the solution of the
+     * inverse problem (Geodesic::Inverse and the other routines based on
+     * Geodesic::GenInverse): the error in \e s12 (and in \e m12) does not
+     * exceed \e tol, in addition to the roundoff error of the full-accuracy
+     * solution (about 15 nm for the WGS84 ellipsoid).  Half of the tolerance
+     * is allotted to the Newton iteration for the azimuth, which is terminated
+     * when the error in the longitude of point 2 is less than \e tol/(2\e a);
+     * and half is allotted to the truncation of the Fourier series for the
+     * distance and the longitude.  The number of terms retained is the
+     * smallest such that a bound on the truncation error (twice the sum of the
+     * magnitudes of the dropped coefficients, evaluated at the largest value
+     * of the expansion parameter, with a further safety factor of 2) is less
+     * than \e tol/2.  For the WGS84 ellipsoid, \e tol = 1 mm retains 3 terms
+     * and \e tol = 1 m retains 2 terms (instead of
+     * GEOGRAPHICLIB_GEODESIC_ORDER = 6); the inverse problem is then solved
+     * about 6% and 17% faster.  In addition, short lines are solved directly,
+     * without Newton's method, by the approximate solution on the auxiliary
+     * sphere; its error is bounded by 2\e a |\e f|
+     * &sigma;<sub>12</sub><sup>3</sup>, where &sigma;<sub>12</sub> is the
+     * spherical arc length, and this is used if it is less than \e tol/2.
+     * Thus \e tol = 15 nm, the accuracy of the full solution, gives a fast
+     * path for lines shorter than 360 m (for WGS84) with no loss of accuracy;
+     * this reduces the time for lines shorter than 1 km by about 20%.  The
+     * direct problem and GeodesicLine objects are always computed with full
+     * accuracy.
+     *
+     * With \e f = 0, the problems are solved directly by spherical
+     * trigonometry: the inverse problem without Newton's method and the
+     * direct problem (and GeodesicLine) without evaluating any of the
+     * series, which all vanish.  This makes Geodesic::Inverse about 1.7
+     * times faster and Geodesic::Direct about 1.45 times faster.  The
+     * direct problem gives the same results as before; the results of the
+     * inverse problem differ only by roundoff.
      **********************************************************************/
-    Geodesic(real a, real f);
+    Geodesic(real a, real f, real tol = 0);
     ///@}
 
     /** \name Direct geodesic problem specified in terms of distance.
@@ -633,6 +692,84 @@ namespace GeographicLib {
                          real& S12) const;
     ///@}
 
+    /** \name Batch direct geodesic solution.
+     **********************************************************************/
+    ///@{
+    /**
+     * Solve many direct geodesic problems given as parallel arrays.
+     *
+     * @param[in] n the number of problems to solve.
+     * @param[in] lat1 array of latitudes of point 1 (degrees).
+     * @param[in] lon1 array of longitudes of point 1 (degrees).
+     * @param[in] azi1 array of azimuths at point 1 (degrees).
+     * @param[in] s12 array of distances from point 1 to point 2 (meters).
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] lat2 array of latitudes of point 2 (degrees).
+     * @param[out] lon2 array of longitudes of point 2 (degrees).
+     * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+     * @param[out] m12 array of reduced lengths of geodesic (meters).
+     * @param[out] M12 array of geodesic scales of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 array of areas under the geodesic
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 (optional) array of arc lengths between point 1 and
+     *   point 2 (degrees).
+     *
+     * Element \e i of each output array is set to the result of
+     * Geodesic::GenDirect applied to element \e i of the input arrays with
+     * \e arcmode = false and the given \e outmask; the results are identical
+     * to those of the scalar routine.  All arrays have length \e n.  Output
+     * arrays corresponding to quantities not included in \e outmask are not
+     * referenced and may be null; \e a12 is set if it is not null.  An
+     * output array may not alias an input array.
+     *
+     * A single GeodesicLine is re-initialized in place for each problem
+     * (instead of constructing a temporary object for each call as
+     * GenDirect does) and only the series needed for \e outmask are
+     * computed.  As with InverseBatch, each problem is solved with the same
+     * code as the scalar routine; this keeps the results bit-identical and
+     * the code portable to all the precisions supported by
+     * GEOGRAPHICLIB_PRECISION.  (Evaluating the trigonometric functions for
+     * several problems at once with SIMD instructions would give slightly
+     * different results.)  To use several threads, divide the arrays into
+     * blocks and call DirectBatch for each block.
+     **********************************************************************/
+    void DirectBatch(size_t n,
+                     const real lat1[], const real lon1[],
+                     const real azi1[], const real s12[],
+                     unsigned outmask,
+                     real lat2[], real lon2[], real azi2[],
+                     real m12[], real M12[], real M21[], real S12[],
+                     real a12[] = nullptr) const;
+
+    /**
+     * See the documentation for Geodesic::DirectBatch.
+     **********************************************************************/
+    void DirectBatch(size_t n,
+                     const real lat1[], const real lon1[],
+                     const real azi1[], const real s12[],
+                     real lat2[], real lon2[]) const {
+      DirectBatch(n, lat1, lon1, azi1, s12,
+                  LATITUDE | LONGITUDE,
+                  lat2, lon2, nullptr, nullptr, nullptr, nullptr, nullptr);
+    }
+
+    /**
+     * See the documentation for Geodesic::DirectBatch.
+     **********************************************************************/
+    void DirectBatch(size_t n,
+                     const real lat1[], const real lon1[],
+                     const real azi1[], const real s12[],
+                     real lat2[], real lon2[], real azi2[]) const {
+      DirectBatch(n, lat1, lon1, azi1, s12,
+                  LATITUDE | LONGITUDE | AZIMUTH,
+                  lat2, lon2, azi2, nullptr, nullptr, nullptr, nullptr);
+    }
+    ///@}
+
     /** \name Inverse geodesic problem.
      **********************************************************************/
     ///@{
@@ -792,6 +929,273 @@ namespace GeographicLib {
                           unsigned outmask,
                           real& s12, real& azi1, real& azi2,
                           real& m12, real& M12, real& M21, real& S12) const;
+
+    /**
+     * The general inverse geodesic calculation starting from a nearby
+     * solution.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following parameters should be set.
+     * @param[out] s12 distance between point 1 and point 2 (meters).
+     * @param[in,out] azi1 azimuth at point 1 (degrees).
+     * @param[in,out] azi2 (forward) azimuth at point 2 (degrees).
+     * @param[out] m12 reduced length of geodesic (meters).
+     * @param[out] M12 geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 area under the geodesic (meters<sup>2</sup>).
+     * @return \e a12 arc length of between point 1 and point 2 (degrees).
+     *
+     * This is the same as Geodesic::GenInverse except that, on input, \e
+     * azi1 and \e azi2 should be the azimuths of the solution of a nearby
+     * inverse problem, e.g., for the previous point of a trajectory.  These
+     * are used to start Newton's method instead of the usual starting guess,
+     * which typically saves one iteration.  Either azimuth can be NaN, in
+     * which case the usual starting guess is used; this is appropriate for
+     * the first call.  If the hint is so poor that Newton's method needs to
+     * fall back to bisection, the iteration is restarted from the usual
+     * starting guess.  On output, \e azi1 and \e azi2 are always set
+     * (regardless of \e outmask), so that they can serve as the hint for the
+     * next call.  The results agree with those of Geodesic::GenInverse to
+     * within roundoff.
+     **********************************************************************/
+    Math::real GenInverseHint(real lat1, real lon1, real lat2, real lon2,
+                              unsigned outmask,
+                              real& s12, real& azi1, real& azi2,
+                              real& m12, real& M12, real& M21, real& S12)
+      const;
+
+    /**
+     * See the documentation for Geodesic::GenInverseHint.
+     **********************************************************************/
+    Math::real InverseHint(real lat1, real lon1, real lat2, real lon2,
+                           real& s12, real& azi1, real& azi2) const {
+      real t;
+      return GenInverseHint(lat1, lon1, lat2, lon2,
+                            DISTANCE | AZIMUTH,
+                            s12, azi1, azi2, t, t, t, t);
+    }
+    ///@}
+
+    /** \name Batch inverse geodesic solution.
+     **********************************************************************/
+    ///@{
+    /**
+     * Solve many inverse geodesic problems given as parallel arrays.
+     *
+     * @param[in] n the number of problems to solve.
+     * @param[in] lat1 array of latitudes of point 1 (degrees).
+     * @param[in] lon1 array of longitudes of point 1 (degrees).
+     * @param[in] lat2 array of latitudes of point 2 (degrees).
+     * @param[in] lon2 array of longitudes of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] s12 array of distances between point 1 and point 2
+     *   (meters).
+     * @param[out] azi1 array of azimuths at point 1 (degrees).
+     * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+     * @param[out] m12 array of reduced lengths of geodesic (meters).
+     * @param[out] M12 array of geodesic scales of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 array of areas under the geodesic
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 (optional) array of arc lengths between point 1 and
+     *   point 2 (degrees).
+     *
+     * Element \e i of each output array is set to the result of
+     * Geodesic::GenInverse applied to element \e i of the input arrays with
+     * the given \e outmask; the results are identical to those of the scalar
+     * routine.  All arrays have length \e n.  Output arrays corresponding to
+     * quantities not included in \e outmask are not referenced and may be
+     * null; \e a12 is set if it is not null.  An output array may not alias
+     * an input array.
+     *
+     * The canonicalization of \e outmask is done once for the whole batch and
+     * the per-call overhead of the scalar interface is avoided.  The Newton
+     * iteration is carried out independently for each problem using the
+     * same code as the scalar routine; this keeps the results bit-identical
+     * and the code portable to all the precisions supported by
+     * GEOGRAPHICLIB_PRECISION.  (For the WGS84 ellipsoid, the iteration
+     * converges in 2 or 3 steps for most problems, so little would be gained
+     * by evaluating several problems in lock-step.)
+     **********************************************************************/
+    void InverseBatch(size_t n,
+                      const real lat1[], const real lon1[],
+                      const real lat2[], const real lon2[],
+                      unsigned outmask,
+                      real s12[], real azi1[], real azi2[],
+                      real m12[], real M12[], real M21[], real S12[],
+                      real a12[] = nullptr) const;
+
+    /**
+     * See the documentation for Geodesic::InverseBatch.
+     **********************************************************************/
+    void InverseBatch(size_t n,
+                      const real lat1[], const real lon1[],
+                      const real lat2[], const real lon2[],
+                      real s12[]) const {
+      InverseBatch(n, lat1, lon1, lat2, lon2,
+                   DISTANCE,
+                   s12, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+    }
+
+    /**
+     * See the documentation for Geodesic::InverseBatch.
+     **********************************************************************/
+    void InverseBatch(size_t n,
+                      const real lat1[], const real lon1[],
+                      const real lat2[], const real lon2[],
+                      real s12[], real azi1[], real azi2[]) const {
+      InverseBatch(n, lat1, lon1, lat2, lon2,
+                   DISTANCE | AZIMUTH,
+                   s12, azi1, azi2, nullptr, nullptr, nullptr, nullptr);
+    }
+    ///@}
+
+    /** \name Bounding boxes of geodesic segments.
+     **********************************************************************/
+    ///@{
+    /**
+     * Compute the bounding boxes of the segments of a polyline.
+     *
+     * @param[in] n the number of vertices of the polyline.
+     * @param[in] lat array of latitudes of the vertices (degrees).
+     * @param[in] lon array of longitudes of the vertices (degrees).
+     * @param[out] latmin array of minimum latitudes (degrees).
+     * @param[out] latmax array of maximum latitudes (degrees).
+     * @param[out] lonw array of longitudes of the western edges (degrees).
+     * @param[out] dlon array of longitudinal extents (degrees).
+     *
+     * Element \e i of the output arrays (which have length \e n &minus; 1)
+     * gives the bounding box of the geodesic segment joining vertices \e i
+     * and \e i + 1; see GeodesicLine::BoundingBox.  This is suitable for
+     * loading the segments into a spatial index such as an R-tree.
+     **********************************************************************/
+    void BoundingBoxes(size_t n, const real lat[], const real lon[],
+                       real latmin[], real latmax[],
+                       real lonw[], real dlon[]) const;
+    ///@}
+
+    /** \name Inverse geodesic problem with partial derivatives.
+     **********************************************************************/
+    ///@{
+    /**
+     * Solve the inverse geodesic problem and return the partial derivatives
+     * of the results with respect to the coordinates of the end points.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[out] s12 distance between point 1 and point 2 (meters).
+     * @param[out] azi1 azimuth at point 1 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @param[out] J the 3 &times; 4 Jacobian matrix, an array of length 12
+     *   in row-major order.
+     * @return \e a12 arc length of between point 1 and point 2 (degrees).
+     *
+     * The rows of \e J are the derivatives of \e s12 (meters per degree),
+     * \e azi1, and \e azi2 (degrees per degree); the columns correspond to
+     * \e lat1, \e lon1, \e lat2, and \e lon2.  These are given in terms of
+     * the reduced length \e m12 and the geodesic scales \e M12 and \e M21,
+     * so only a single inverse problem is solved.  If point 2 is displaced
+     * by \e dN northwards and by \e dE eastwards (point 1 held fixed), then
+     * - \e ds12 = cos(\e azi2) \e dN + sin(\e azi2) \e dE,
+     * - \e dazi1 = \e dt / \e m12,
+     * - \e dazi2 = \e M21 \e dt / \e m12 + sin(\e lat2) \e dlon2,
+     * .
+     * where \e dt = &minus;sin(\e azi2) \e dN + cos(\e azi2) \e dE is
+     * the displacement at right angles to the geodesic and the last term
+     * accounts for the convergence of the meridians; the displacement of
+     * point 1 is treated likewise.  The derivatives of the azimuths are
+     * infinite if \e m12 = 0, e.g., if the points coincide.  These
+     * derivatives are suitable for the linearized observation equations in
+     * least-squares network adjustment.
+     **********************************************************************/
+    Math::real InverseJacobian(real lat1, real lon1, real lat2, real lon2,
+                               real& s12, real& azi1, real& azi2,
+                               real J[]) const;
+
+    /**
+     * Solve many inverse geodesic problems with partial derivatives.
+     *
+     * @param[in] n the number of problems to solve.
+     * @param[in] lat1 array of latitudes of point 1 (degrees).
+     * @param[in] lon1 array of longitudes of point 1 (degrees).
+     * @param[in] lat2 array of latitudes of point 2 (degrees).
+     * @param[in] lon2 array of longitudes of point 2 (degrees).
+     * @param[out] s12 array of distances between point 1 and point 2
+     *   (meters).
+     * @param[out] azi1 array of azimuths at point 1 (degrees).
+     * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+     * @param[out] J array of length 12\e n for the Jacobian matrices.
+     *
+     * Elements \e i of \e s12, \e azi1, and \e azi2 and elements 12\e i
+     * through 12\e i + 11 of \e J are set to the results of
+     * Geodesic::InverseJacobian applied to element \e i of the input
+     * arrays.  An output array may not alias an input array.
+     **********************************************************************/
+    void InverseJacobianBatch(size_t n,
+                              const real lat1[], const real lon1[],
+                              const real lat2[], const real lon2[],
+                              real s12[], real azi1[], real azi2[],
+                              real J[]) const;
+    ///@}
+
+    /** \name Proximity test.
+     **********************************************************************/
+    ///@{
+    /**
+     * Test whether two points are within a given distance of one another.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[in] r the threshold distance (meters).
+     * @return whether \e s12 &le; \e r.
+     *
+     * The result is the same as that of computing \e s12 with
+     * Geodesic::Inverse and comparing it with \e r, but most cases are
+     * decided without solving the inverse problem, using bounds on \e s12
+     * given by the chord \e c joining the points.  The chord is a lower bound
+     * for \e s12.  Because the curvature of the geodesic is at most
+     * 1/&rho;, where &rho; = min(<i>b</i><sup>2</sup>/<i>a</i>,
+     * <i>a</i><sup>2</sup>/<i>b</i>) is the smallest radius of curvature of
+     * the ellipsoid, 2&rho; asin(<i>c</i>/(2&rho;)) is an upper bound for
+     * \e s12 (Schur's comparison theorem).  The difference between the
+     * bounds is about <i>c</i><sup>3</sup>/(24&rho;<sup>2</sup>), e.g., 1 m
+     * for \e c = 100 km; only if \e r lies between the bounds is the inverse
+     * problem solved.  If any of the arguments is a NaN, false is returned.
+     **********************************************************************/
+    bool Within(real lat1, real lon1, real lat2, real lon2, real r) const;
+
+    /**
+     * Test whether many pairs of points are within a given distance.
+     *
+     * @param[in] n the number of pairs.
+     * @param[in] lat1 array of latitudes of point 1 (degrees).
+     * @param[in] lon1 array of longitudes of point 1 (degrees).
+     * @param[in] lat2 array of latitudes of point 2 (degrees).
+     * @param[in] lon2 array of longitudes of point 2 (degrees).
+     * @param[in] r the threshold distance (meters).
+     * @param[out] within array of the results.
+     * @return the number of pairs within \e r of one another.
+     *
+     * Element \e i of \e within is set to the result of Geodesic::Within
+     * applied to element \e i of the input arrays.
+     **********************************************************************/
+    size_t WithinBatch(size_t n,
+                       const real lat1[], const real lon1[],
+                       const real lat2[], const real lon2[],
+                       real r, bool within[]) const;
     ///@}
 
     /** \name Interface to GeodesicLine.
@@ -948,6 +1352,12 @@ namespace GeographicLib {
      **********************************************************************/
     Math::real Flattening() const { return _f; }
 
+    /**
+     * @return the tolerance for the inverse problem (meters).  This is the
+     *   value used in the constructor.
+     **********************************************************************/
+    Math::real Tolerance() const { return _tol; }
+
     /**
      * @return total area of ellipsoid in meters<sup>2</sup>.  The area of a
      *   polygon encircling a pole can be found by adding
@@ -967,6 +1377,11 @@ namespace GeographicLib {
     /**
      * A global instantiation of Geodesic with the parameters for the WGS84
      * ellipsoid.
+     *
+     * This object is constructed (in a thread-safe way) on the first call;
+     * subsequent calls merely return a reference to it.  In any case,
+     * constructing a Geodesic object is cheap (about a tenth of the time
+     * for the solution of an inverse problem).
      **********************************************************************/
     static const Geodesic& WGS84();
 
@@ -0,0 +1,219 @@
+/**
+ * \file GeodesicCache.hpp
+ * \brief Header for GeographicLib::GeodesicCache class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEODESICCACHE_HPP)
+#define GEOGRAPHICLIB_GEODESICCACHE_HPP 1
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <GeographicLib/Geodesic.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief A cache of solutions of the inverse geodesic problem
+   *
+   * Applications which repeatedly solve the inverse problem for the same
+   * pairs of points (e.g., the distances between popular airports) may use
+   * this class to turn the repeated calculations into hash table lookups.
+   * The solutions are keyed on the coordinates of the two points.  By
+   * default, the exact values of the coordinates are used (so that 0 and
+   * &minus;0 are distinct); optionally the coordinates can be rounded to
+   * multiples of a quantum before solving the problem, in which case the
+   * results are those for the rounded coordinates.  The number of solutions
+   * held is bounded; when this bound is exceeded, the least recently used
+   * solution is dropped from the cache.
+   *
+   * All the outputs of Geodesic::GenInverse are computed and cached on a
+   * miss, so that subsequent requests for any of the quantities are
+   * satisfied from the cache.  Queries with NaN coordinates are not cached.
+   *
+   * All the member functions are thread safe.  The inverse problem is
+   * solved without holding the lock, so concurrent misses don't block one
+   * another.
+   *
+   * Example of use:
+   * \code
+   * GeodesicCache cache(Geodesic::WGS84(), 1024);
+   * double s12;
+   * cache.Inverse(40.6, -73.8, 51.6, -0.5, s12);  // a miss
+   * cache.Inverse(40.6, -73.8, 51.6, -0.5, s12);  // a hit
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT GeodesicCache {
+  private:
+    typedef Math::real real;
+    struct key {
+      real lat1, lon1, lat2, lon2;
+      bool operator==(const key& k) const;
+    };
+    struct hasher {
+      size_t operator()(const key& k) const;
+    };
+    struct value {
+      real a12, s12, azi1, azi2, m12, M12, M21, S12;
+    };
+    typedef std::pair<key, value> item;
+    Geodesic _earth;
+    size_t _capacity;
+    real _quantum;
+    mutable std::mutex _lock;
+    unsigned long long _hits, _misses;
+    std::list<item> _list;      // most recently used first
+    std::unordered_map<key, std::list<item>::iterator, hasher> _map;
+    real Quantize(real x) const;
+    GeodesicCache(const GeodesicCache&) = delete;
+    GeodesicCache& operator=(const GeodesicCache&) = delete;
+  public:
+
+    /**
+     * Constructor for GeodesicCache.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     * @param[in] capacity the maximum number of solutions to hold in the
+     *   cache.
+     * @param[in] quantum if positive, the coordinates are rounded to
+     *   multiples of this value (degrees) before the lookup; the default
+     *   value 0 means that the exact coordinates are used.
+     * @exception GeographicErr if \e capacity is zero or if \e quantum is
+     *   negative or not finite.
+     **********************************************************************/
+    explicit GeodesicCache(const Geodesic& earth, size_t capacity = 65536,
+                           real quantum = 0);
+
+    /** \name Solving the inverse problem
+     **********************************************************************/
+    ///@{
+    /**
+     * The general inverse geodesic calculation using the cache.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Geodesic::mask values
+     *   specifying which of the following parameters should be set.
+     * @param[out] s12 distance from point 1 to point 2 (meters).
+     * @param[out] azi1 azimuth at point 1 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @param[out] m12 reduced length of geodesic (meters).
+     * @param[out] M12 geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 area under the geodesic (meters<sup>2</sup>).
+     * @return \e a12 arc length from point 1 to point 2 (degrees).
+     *
+     * The results are the same as those of Geodesic::GenInverse (for the
+     * quantized coordinates if \e quantum is positive).
+     **********************************************************************/
+    Math::real GenInverse(real lat1, real lon1, real lat2, real lon2,
+                          unsigned outmask, real& s12,
+                          real& azi1, real& azi2, real& m12,
+                          real& M12, real& M21, real& S12);
+
+    /**
+     * Solve the inverse problem for the distance using the cache.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[out] s12 distance from point 1 to point 2 (meters).
+     * @return \e a12 arc length from point 1 to point 2 (degrees).
+     **********************************************************************/
+    Math::real Inverse(real lat1, real lon1, real lat2, real lon2,
+                       real& s12) {
+      real t;
+      return GenInverse(lat1, lon1, lat2, lon2, Geodesic::DISTANCE,
+                        s12, t, t, t, t, t, t);
+    }
+
+    /**
+     * Solve the inverse problem for the distance and azimuths using the
+     * cache.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[out] s12 distance from point 1 to point 2 (meters).
+     * @param[out] azi1 azimuth at point 1 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @return \e a12 arc length from point 1 to point 2 (degrees).
+     **********************************************************************/
+    Math::real Inverse(real lat1, real lon1, real lat2, real lon2,
+                       real& s12, real& azi1, real& azi2) {
+      real t;
+      return GenInverse(lat1, lon1, lat2, lon2,
+                        Geodesic::DISTANCE | Geodesic::AZIMUTH,
+                        s12, azi1, azi2, t, t, t, t);
+    }
+    ///@}
+
+    /** \name Managing the cache
+     **********************************************************************/
+    ///@{
+    /**
+     * Remove all the solutions from the cache.  The hit and miss counters
+     * are not reset.
+     **********************************************************************/
+    void Clear();
+
+    /**
+     * @return the maximum number of solutions held.
+     **********************************************************************/
+    size_t Capacity() const { return _capacity; }
+
+    /**
+     * @return the quantum used to round the coordinates (degrees); 0 means
+     *   that the exact coordinates are used.
+     **********************************************************************/
+    Math::real Quantum() const { return _quantum; }
+
+    /**
+     * @return the number of solutions currently held.
+     **********************************************************************/
+    size_t Size() const;
+
+    /**
+     * @return the number of requests satisfied from the cache.
+     **********************************************************************/
+    unsigned long long Hits() const;
+
+    /**
+     * @return the number of requests which required the inverse problem to
+     *   be solved.
+     **********************************************************************/
+    unsigned long long Misses() const;
+    ///@}
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _earth.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _earth.Flattening(); }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_GEODESICCACHE_HPP
@@ -0,0 +1,191 @@
+/**
+ * \file GeodesicCluster.hpp
+ * \brief Header for GeographicLib::GeodesicCluster class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEODESICCLUSTER_HPP)
+#define GEOGRAPHICLIB_GEODESICCLUSTER_HPP 1
+
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/Gnomonic.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Geodesic centroids and k-means clustering
+   *
+   * This class finds the centroids of sets of points on the ellipsoid and
+   * partitions large sets of points into clusters with the k-means
+   * algorithm, with all distances measured along geodesics.
+   *
+   * The centroid of a set of points is defined with the Gnomonic
+   * projection: it is the point \e C such that the mean of the points
+   * projected with the gnomonic projection centered at \e C is the origin.
+   * It is found by repeatedly projecting the points about the current
+   * estimate, taking the mean in the projection, and mapping the mean back
+   * with Gnomonic::Reverse.  In the planar limit, the centroid is the usual
+   * mean and a single step suffices; for clusters whose extent is small
+   * compared to the radius of the earth, it is very close to the point
+   * which minimizes the sum of the squared distances and 2 or 3 steps
+   * suffice.  The gnomonic coordinates \e x = &rho; sin \e azi1, \e y = &rho;
+   * cos \e azi1 (where &rho; = <i>m12</i>/\e M12) of all the points relative
+   * to a center are computed with a single GeodesicOrigin, so that the
+   * quantities depending on the center are only computed once.  Points more
+   * than about 90&deg; from the current estimate of the centroid (for which
+   * the gnomonic projection is undefined) are ignored.
+   *
+   * KMeans uses Lloyd's algorithm, alternating between assigning each point
+   * to its nearest center and moving each center to the centroid of its
+   * points.  Rather than iterating each centroid to convergence, a single
+   * gnomonic step is taken in each iteration; the iteration stops when no
+   * point changes its assignment and no center moves by more than a
+   * tolerance.  Most of the distance computations in the assignment are
+   * skipped with the bounds of G. Hamerly, <a
+   * href="https://doi.org/10.1137/1.9781611972801.12">Making k-means even
+   * faster</a>, Proc. SIAM Data Mining, 130--140 (2010).  These rely on the
+   * triangle inequality which geodesic distances satisfy:
+   * - an upper bound on the distance of each point to its center and a lower
+   *   bound on its distance to every other center are carried between
+   *   iterations and are adjusted by the distances that the centers move;
+   * - a point is not reassigned if its upper bound is less than its lower
+   *   bound or than half the distance from its center to the nearest other
+   *   center.
+   * .
+   * Only when these tests fail (first with the upper bound replaced by the
+   * exact distance) are the distances to all the centers computed, using a
+   * GeodesicOrigin at the point.  Once the clusters settle down, the
+   * assignment step costs only a few geodesic calculations in total.  The
+   * points are distributed over a pool of threads in both the assignment
+   * and the centroid steps; the results do not depend on the number of
+   * threads.
+   *
+   * A GeodesicCluster object holds no state other than the ellipsoid and the
+   * number of threads; thus a single object may be used by several threads.
+   *
+   * Example of use:
+   * \code
+   * GeodesicCluster cluster(Geodesic::WGS84());
+   * // lat, lon hold n points; pick k initial centers, e.g., k of the points
+   * std::vector<double> latc(lat.begin(), lat.begin() + k),
+   *   lonc(lon.begin(), lon.begin() + k);
+   * std::vector<int> assign(n);
+   * cluster.KMeans(n, lat.data(), lon.data(),
+   *                k, latc.data(), lonc.data(), assign.data());
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT GeodesicCluster {
+  private:
+    typedef Math::real real;
+    // Points are handled in chunks of this size
+    static const size_t chunk_ = 1024;
+    Geodesic _earth;
+    Gnomonic _gnom;
+    unsigned _threads;
+    // One gnomonic step for the centroids of k sets of points; the points
+    // for set j are lat[off[j]..off[j+1]), etc.
+    void Step(size_t k, const size_t off[],
+              const real lat[], const real lon[], const real w[],
+              real latc[], real lonc[], real move[]) const;
+  public:
+
+    /**
+     * Constructor for GeodesicCluster.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     * @param[in] threads the number of threads to use; if this is 0 (the
+     *   default), the number reported by std::thread::hardware_concurrency()
+     *   is used.
+     **********************************************************************/
+    GeodesicCluster(const Geodesic& earth, unsigned threads = 0);
+
+    /**
+     * The centroid of a set of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes of the points (degrees).
+     * @param[in] lon array of longitudes of the points (degrees).
+     * @param[in] w array of weights of the points; if this is null, the
+     *   weights are all 1.
+     * @param[out] latc the latitude of the centroid (degrees).
+     * @param[out] lonc the longitude of the centroid (degrees).
+     * @param[in] tol the iteration stops when the centroid moves by less
+     *   than this distance (meters); the default is 1 mm.
+     * @param[in] maxit the maximum number of gnomonic steps.
+     * @return the number of gnomonic steps taken.
+     *
+     * The starting point for the iteration is the direction of the mean of
+     * the points as unit vectors in geocentric coordinates.  If \e n = 0 or
+     * if the points are so dispersed that this mean vanishes, \e latc and \e
+     * lonc are set to NaN and 0 is returned.
+     **********************************************************************/
+    int Centroid(size_t n, const real lat[], const real lon[], const real w[],
+                 real& latc, real& lonc,
+                 real tol = real(0.001), int maxit = 50) const;
+
+    /**
+     * Partition a set of points into clusters with the k-means algorithm.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes of the points (degrees).
+     * @param[in] lon array of longitudes of the points (degrees).
+     * @param[in] k the number of clusters.
+     * @param[in,out] latc array of latitudes of the centers of the clusters
+     *   (degrees); on input these are the initial centers.
+     * @param[in,out] lonc array of longitudes of the centers of the
+     *   clusters (degrees).
+     * @param[out] assign array of the indices in [0, \e k) of the clusters
+     *   to which the points are assigned.
+     * @param[out] dist if non-null, an array of the distances from the
+     *   points to the centers of their clusters (meters).
+     * @param[in] tol the iteration stops when no point changes its cluster
+     *   and no center moves by more than this distance (meters); the default
+     *   is 1 mm.
+     * @param[in] maxit the maximum number of iterations.
+     * @exception std::bad_alloc if the memory for the bounds and the work
+     *   arrays can't be allocated.
+     * @return the number of iterations.
+     *
+     * The result depends on the initial centers (for example, these might be
+     * chosen at random from the points or with the k-means++ method).  A
+     * center which has no points assigned to it is left in place.  The
+     * assignments in \e assign are those of the last assignment step, which
+     * preceded the last move of the centers; so a point may be slightly
+     * closer to another center if there are near ties.  Points with NaN
+     * coordinates are assigned to cluster 0 and have no influence on the
+     * centers.  If \e k = 0, nothing is done and 0 is returned.
+     **********************************************************************/
+    int KMeans(size_t n, const real lat[], const real lon[],
+               size_t k, real latc[], real lonc[],
+               int assign[], real dist[] = nullptr,
+               real tol = real(0.001), int maxit = 100) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of threads used.
+     **********************************************************************/
+    unsigned Threads() const { return _threads; }
+
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _earth.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _earth.Flattening(); }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_GEODESICCLUSTER_HPP
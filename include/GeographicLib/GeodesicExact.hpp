@@ -12,6 +12,8 @@
 
 #include <GeographicLib/Constants.hpp>
 #include <GeographicLib/EllipticFunction.hpp>
+#include <atomic>
+#include <mutex>
 
 #if !defined(GEOGRAPHICLIB_GEODESICEXACT_ORDER)
 /**
@@ -23,6 +25,8 @@
 namespace GeographicLib {
 
   class GeodesicLineExact;
+  template<class GeodType> class DistanceMatrixT;
+  template<class GeodType> class GeodesicOriginT;
 
   /**
    * \brief Exact geodesic calculations
@@ -81,6 +85,9 @@ namespace GeographicLib {
   private:
     typedef Math::real real;
     friend class GeodesicLineExact;
+    template<class GeodType> friend class DistanceMatrixT;
+    template<class GeodType> friend class GeodesicOriginT;
+    template<class GeodType> friend class GeodesicMetricT;
     static const int nC4_ = GEOGRAPHICLIB_GEODESICEXACT_ORDER;
     static const int nC4x_ = (nC4_ * (nC4_ + 1)) / 2;
     static const unsigned maxit1_ = 20;
@@ -104,7 +111,21 @@ namespace GeographicLib {
     static real Astroid(real x, real y);
 
     real _a, _f, _f1, _e2, _ep2, _n, _b, _c2, _etol2;
-    real _C4x[nC4x_];
+    // The complete elliptic integrals for meridional geodesics; these are
+    // the starting values of the elliptic integrals in GenInverse.
+    EllipticFunction _Emer;
+    // The coefficients _C4x are only needed for area calculations, so they
+    // are computed by C4f on first use.  C4lazy guards this computation; a
+    // copy of a GeodesicExact object recomputes the coefficients when needed.
+    struct C4lazy {
+      std::atomic<bool> init;
+      std::mutex lock;
+      C4lazy() : init(false) {}
+      C4lazy(const C4lazy&) : init(false) {}
+      C4lazy& operator=(const C4lazy&) { init = false; return *this; }
+    };
+    mutable C4lazy _C4lazy;
+    mutable real _C4x[nC4x_];
 
     void Lengths(const EllipticFunction& E,
                  real sig12,
@@ -126,14 +147,24 @@ namespace GeographicLib {
                   real& ssig1, real& csig1, real& ssig2, real& csig2,
                   EllipticFunction& E,
                   real& domg12, bool diffp, real& dlam12) const;
+    void InverseLat(real& lat, real& sbet, real& cbet, real& dn) const;
+    // If hint, salp1, calp1, salp2, calp2 hold the azimuths of a nearby
+    // solution on input; these are used to start Newton's method.
     real GenInverse(real lat1, real lon1, real lat2, real lon2,
                     unsigned outmask, real& s12,
                     real& salp1, real& calp1, real& salp2, real& calp2,
-                    real& m12, real& M12, real& M21, real& S12) const;
+                    real& m12, real& M12, real& M21, real& S12,
+                    bool hint = false) const;
+    real GenInverse(real lat1, real sbet1, real cbet1, real dn1, real lon1,
+                    real lat2, real sbet2, real cbet2, real dn2, real lon2,
+                    unsigned outmask, real& s12,
+                    real& salp1, real& calp1, real& salp2, real& calp2,
+                    real& m12, real& M12, real& M21, real& S12,
+                    bool hint = false) const;
 
     // These are Maxima generated functions to provide series approximations to
     // the integrals for the area.
-    void C4coeff();
+    void C4coeff() const;
     void C4f(real k2, real c[]) const;
     // Large coefficients are split so that lo contains the low 52 bits and hi
     // the rest.  This choice avoids double rounding with doubles and higher
@@ -683,6 +714,152 @@ namespace GeographicLib {
                           unsigned outmask,
                           real& s12, real& azi1, real& azi2,
                           real& m12, real& M12, real& M21, real& S12) const;
+
+    /**
+     * The general inverse geodesic calculation starting from an approximate
+     * solution.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of GeodesicExact::mask values
+     *   specifying which of the following parameters should be set.
+     * @param[out] s12 distance between point 1 and point 2 (meters).
+     * @param[in,out] azi1 azimuth at point 1 (degrees).
+     * @param[in,out] azi2 (forward) azimuth at point 2 (degrees).
+     * @param[out] m12 reduced length of geodesic (meters).
+     * @param[out] M12 geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 area under the geodesic (meters<sup>2</sup>).
+     * @return \e a12 arc length of between point 1 and point 2 (degrees).
+     *
+     * This is the same as GeodesicExact::GenInverse except that, on input,
+     * \e azi1 and \e azi2 should be approximations to the azimuths of the
+     * solution.  These are used to start Newton's method instead of the usual
+     * starting guess.  Since Newton's method converges quadratically, this
+     * is particularly useful with high precision arithmetic
+     * (GEOGRAPHICLIB_PRECISION = 4 or 5): if the azimuths are accurate to
+     * double precision (obtained, e.g., with a double precision build of the
+     * library), only one or two Newton iterations are needed to obtain the
+     * full precision result.  Either azimuth can be NaN, in which case the
+     * usual starting guess is used.  If the approximations are so poor that
+     * Newton's method needs to fall back to bisection, the iteration is
+     * restarted from the usual starting guess.  On output, \e azi1 and \e
+     * azi2 are always set (regardless of \e outmask).  The results agree
+     * with those of GeodesicExact::GenInverse to within roundoff.
+     **********************************************************************/
+    Math::real GenInverseHint(real lat1, real lon1, real lat2, real lon2,
+                              unsigned outmask,
+                              real& s12, real& azi1, real& azi2,
+                              real& m12, real& M12, real& M21, real& S12)
+      const;
+
+    /**
+     * See the documentation for GeodesicExact::GenInverseHint.
+     **********************************************************************/
+    Math::real InverseHint(real lat1, real lon1, real lat2, real lon2,
+                           real& s12, real& azi1, real& azi2) const {
+      real t;
+      return GenInverseHint(lat1, lon1, lat2, lon2,
+                            DISTANCE | AZIMUTH,
+                            s12, azi1, azi2, t, t, t, t);
+    }
+    ///@}
+
+    /** \name Batch geodesic solutions.
+     **********************************************************************/
+    ///@{
+    /**
+     * Solve many inverse geodesic problems given as parallel arrays.
+     *
+     * @param[in] n the number of problems to solve.
+     * @param[in] lat1 array of latitudes of point 1 (degrees).
+     * @param[in] lon1 array of longitudes of point 1 (degrees).
+     * @param[in] lat2 array of latitudes of point 2 (degrees).
+     * @param[in] lon2 array of longitudes of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of GeodesicExact::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] s12 array of distances between point 1 and point 2
+     *   (meters).
+     * @param[out] azi1 array of azimuths at point 1 (degrees).
+     * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+     * @param[out] m12 array of reduced lengths of geodesic (meters).
+     * @param[out] M12 array of geodesic scales of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 array of areas under the geodesic
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 (optional) array of arc lengths between point 1 and
+     *   point 2 (degrees).
+     * @param[in] threads the number of threads to use; if this is 0 (the
+     *   default), the number reported by std::thread::hardware_concurrency()
+     *   is used.
+     *
+     * Element \e i of each output array is set to the result of
+     * GeodesicExact::GenInverse applied to element \e i of the input arrays
+     * with the given \e outmask; the results are identical to those of the
+     * scalar routine.  All arrays have length \e n.  Output arrays
+     * corresponding to quantities not included in \e outmask are not
+     * referenced and may be null; \e a12 is set if it is not null.  An output
+     * array may not alias an input array.
+     *
+     * The problems are divided into chunks which are distributed over a pool
+     * of threads.  The GeodesicExact object is shared by the threads: the
+     * coefficients for the area are computed (once) before the threads are
+     * started and the elliptic integrals for meridional geodesics are
+     * computed by the constructor.
+     **********************************************************************/
+    void InverseBatch(size_t n,
+                      const real lat1[], const real lon1[],
+                      const real lat2[], const real lon2[],
+                      unsigned outmask,
+                      real s12[], real azi1[], real azi2[],
+                      real m12[], real M12[], real M21[], real S12[],
+                      real a12[] = nullptr, unsigned threads = 0) const;
+
+    /**
+     * Solve many direct geodesic problems given as parallel arrays.
+     *
+     * @param[in] n the number of problems to solve.
+     * @param[in] lat1 array of latitudes of point 1 (degrees).
+     * @param[in] lon1 array of longitudes of point 1 (degrees).
+     * @param[in] azi1 array of azimuths at point 1 (degrees).
+     * @param[in] s12 array of distances from point 1 to point 2 (meters).
+     * @param[in] outmask a bitor'ed combination of GeodesicExact::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] lat2 array of latitudes of point 2 (degrees).
+     * @param[out] lon2 array of longitudes of point 2 (degrees).
+     * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+     * @param[out] m12 array of reduced lengths of geodesic (meters).
+     * @param[out] M12 array of geodesic scales of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 array of areas under the geodesic
+     *   (meters<sup>2</sup>).
+     * @param[out] a12 (optional) array of arc lengths between point 1 and
+     *   point 2 (degrees).
+     * @param[in] threads the number of threads to use; if this is 0 (the
+     *   default), the number reported by std::thread::hardware_concurrency()
+     *   is used.
+     *
+     * Element \e i of each output array is set to the result of
+     * GeodesicExact::GenDirect (with \e arcmode = false) applied to element
+     * \e i of the input arrays with the given \e outmask; the results are
+     * identical to those of the scalar routine.  The conventions for the
+     * arrays and the threads are the same as for GeodesicExact::InverseBatch.
+     **********************************************************************/
+    void DirectBatch(size_t n,
+                     const real lat1[], const real lon1[],
+                     const real azi1[], const real s12[],
+                     unsigned outmask,
+                     real lat2[], real lon2[], real azi2[],
+                     real m12[], real M12[], real M21[], real S12[],
+                     real a12[] = nullptr, unsigned threads = 0) const;
     ///@}
 
     /** \name Interface to GeodesicLineExact.
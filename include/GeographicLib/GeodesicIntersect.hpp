@@ -0,0 +1,182 @@
+/**
+ * \file GeodesicIntersect.hpp
+ * \brief Header for GeographicLib::GeodesicIntersect class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEODESICINTERSECT_HPP)
+#define GEOGRAPHICLIB_GEODESICINTERSECT_HPP 1
+
+#include <vector>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/Gnomonic.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Intersections of geodesic segments
+   *
+   * This finds the intersections of geodesic segments, either of a single
+   * pair of segments or between every segment of one set and every segment
+   * of a second set (e.g., flight routes and the boundaries of airspaces).
+   *
+   * The intersection of a pair of segments is found by the iterative method
+   * given in Karney,
+   * <a href="https://doi.org/10.1007/s00190-012-0578-z">
+   * Algorithms for geodesics</a>, Sec. 8: the four end points are projected
+   * with the Gnomonic projection centered at an estimate of the intersection,
+   * the intersection of the resulting straight lines is found, and this is
+   * projected back to give a new estimate.  The fixed point of this process
+   * is the exact intersection, because geodesics through the center of the
+   * projection are straight lines; convergence is rapid.  The initial
+   * estimate is the mean of the end points, so that the intersection closest
+   * to the segments is found.  The method requires that the end points be
+   * within 90&deg; (in arc length) of the intersection; in practice this
+   * means that the segments should be shorter than about 10000 km.
+   *
+   * For sets of segments, a bounding box (in latitude and longitude)
+   * enclosing each geodesic segment is computed; the boxes for the second
+   * set are binned into a uniform grid which is used to find the candidate
+   * pairs of segments whose boxes overlap.  Only these are passed to the
+   * iterative solution.  The work is distributed over a pool of threads.
+   *
+   * A GeodesicIntersect object holds no state other than the ellipsoid and
+   * the number of threads; thus a single object may be used by several
+   * threads.
+   *
+   * Example of use:
+   * \code
+   * GeodesicIntersect inter(Geodesic::WGS84());
+   * double lat, lon;
+   * // Where does the JFK-LHR route cross the line from (60N, 30W) to
+   * // (40N, 20W)?  Prints 53.715 -25.801.
+   * if (inter.Segment(40.6, -73.8, 51.6, -0.5,
+   *                   60, -30, 40, -20, lat, lon))
+   *   std::cout << lat << " " << lon << "\n";
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT GeodesicIntersect {
+  private:
+    typedef Math::real real;
+    static const int maxit_ = 20;
+    Geodesic _earth;
+    Gnomonic _gn;
+    real _tol;
+    unsigned _threads;
+    // Bounding box of a segment; the longitudes are [lon, lon + dlon] with
+    // dlon in [0, 360].
+    struct box { real latmin, latmax, lon, dlon; };
+    box Box(real lat1, real lon1, real lat2, real lon2) const;
+    static bool Overlap(const box& a, const box& b);
+  public:
+
+    /**
+     * Constructor for GeodesicIntersect.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     *   By default this uses the WGS84 ellipsoid.
+     * @param[in] threads the number of threads to use in
+     *   GeodesicIntersect::Segments; if this is 0 (the default), the number
+     *   reported by std::thread::hardware_concurrency() is used.
+     **********************************************************************/
+    explicit GeodesicIntersect(const Geodesic& earth = Geodesic::WGS84(),
+                               unsigned threads = 0);
+
+    /**
+     * Find the intersection of two geodesic segments.
+     *
+     * @param[in] lata1 latitude of the start of segment \e a (degrees).
+     * @param[in] lona1 longitude of the start of segment \e a (degrees).
+     * @param[in] lata2 latitude of the end of segment \e a (degrees).
+     * @param[in] lona2 longitude of the end of segment \e a (degrees).
+     * @param[in] latb1 latitude of the start of segment \e b (degrees).
+     * @param[in] lonb1 longitude of the start of segment \e b (degrees).
+     * @param[in] latb2 latitude of the end of segment \e b (degrees).
+     * @param[in] lonb2 longitude of the end of segment \e b (degrees).
+     * @param[out] lat latitude of the intersection (degrees).
+     * @param[out] lon longitude of the intersection (degrees).
+     * @return true if the segments intersect.
+     *
+     * If false is returned, \e lat and \e lon are set to the intersection of
+     * the (extended) geodesics if this could be found, and to NaNs otherwise
+     * (e.g., if the geodesics are parallel or if one of the segments has zero
+     * length).  A segment touching the other at an end point counts as an
+     * intersection.
+     **********************************************************************/
+    bool Segment(real lata1, real lona1, real lata2, real lona2,
+                 real latb1, real lonb1, real latb2, real lonb2,
+                 real& lat, real& lon) const;
+
+    /**
+     * Find all the intersections between two sets of geodesic segments.
+     *
+     * @param[in] na the number of segments in set \e a.
+     * @param[in] lata1 array of latitudes of the starts of the segments in
+     *   set \e a (degrees).
+     * @param[in] lona1 array of longitudes of the starts of the segments in
+     *   set \e a (degrees).
+     * @param[in] lata2 array of latitudes of the ends of the segments in set
+     *   \e a (degrees).
+     * @param[in] lona2 array of longitudes of the ends of the segments in set
+     *   \e a (degrees).
+     * @param[in] nb the number of segments in set \e b.
+     * @param[in] latb1 array of latitudes of the starts of the segments in
+     *   set \e b (degrees).
+     * @param[in] lonb1 array of longitudes of the starts of the segments in
+     *   set \e b (degrees).
+     * @param[in] latb2 array of latitudes of the ends of the segments in set
+     *   \e b (degrees).
+     * @param[in] lonb2 array of longitudes of the ends of the segments in set
+     *   \e b (degrees).
+     * @param[out] ia the indices of the segments in set \e a.
+     * @param[out] ib the indices of the segments in set \e b.
+     * @param[out] lat the latitudes of the intersections (degrees).
+     * @param[out] lon the longitudes of the intersections (degrees).
+     * @exception std::bad_alloc if the memory for the bounding boxes and the
+     *   grid can't be allocated.
+     * @return the number of intersections found.
+     *
+     * Segment \e ia[\e k] of set \e a intersects segment \e ib[\e k] of set
+     * \e b at (\e lat[\e k], \e lon[\e k]); the results are sorted by \e ia
+     * and then by \e ib.  The output vectors are resized to the number of
+     * intersections.  The results are the same as calling
+     * GeodesicIntersect::Segment for every pair of segments.
+     **********************************************************************/
+    size_t Segments(size_t na,
+                    const real lata1[], const real lona1[],
+                    const real lata2[], const real lona2[],
+                    size_t nb,
+                    const real latb1[], const real lonb1[],
+                    const real latb2[], const real lonb2[],
+                    std::vector<size_t>& ia, std::vector<size_t>& ib,
+                    std::vector<real>& lat, std::vector<real>& lon) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of threads used.
+     **********************************************************************/
+    unsigned Threads() const { return _threads; }
+
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _earth.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _earth.Flattening(); }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_GEODESICINTERSECT_HPP
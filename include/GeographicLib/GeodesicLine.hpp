@@ -38,6 +38,11 @@ namespace GeographicLib {
    *
    * The default copy constructor and assignment operators work with this
    * class.  Similarly, a vector can be used to hold GeodesicLine objects.
+   * The object holds no heap-allocated state (it is trivially copyable and,
+   * with real = double and the default series order, \e sizeof(GeodesicLine)
+   * is 520 bytes), so large arrays of GeodesicLine objects can be stored
+   * contiguously in preallocated memory.  Use GeodesicLine::Reset or
+   * GeodesicLine::ResetInverse to re-initialize an existing object in place.
    *
    * The calculations are accurate to better than 15 nm (15 nanometers).  See
    * Sec. 9 of
@@ -72,6 +77,7 @@ namespace GeographicLib {
   private:
     typedef Math::real real;
     friend class Geodesic;
+    template<unsigned caps> friend class GeodesicLineCompact;
     static const int nC1_ = Geodesic::nC1_;
     static const int nC1p_ = Geodesic::nC1p_;
     static const int nC2_ = Geodesic::nC2_;
@@ -88,7 +94,14 @@ namespace GeographicLib {
     real _C1a[nC1_ + 1], _C1pa[nC1p_ + 1], _C2a[nC2_ + 1], _C3a[nC3_],
       _C4a[nC4_];    // all the elements of _C4a are used
     unsigned _caps;
-
+    bool _sphere;
+
+    // If s12_a12 is null, point i is at s0_a0 + i * ds_da.
+    void GenPositions(bool arcmode, size_t n, const real s12_a12[],
+                      real s0_a0, real ds_da, unsigned outmask,
+                      real lat2[], real lon2[], real azi2[],
+                      real s12[], real m12[], real M12[], real M21[],
+                      real S12[], real a12[]) const;
     void LineInit(const Geodesic& g,
                   real lat1, real lon1,
                   real azi1, real salp1, real calp1,
@@ -235,6 +248,49 @@ namespace GeographicLib {
     GeodesicLine() : _caps(0U) {}
     ///@}
 
+    /** \name Re-initialization
+     **********************************************************************/
+    ///@{
+    /**
+     * Re-initialize the object as a geodesic line starting at latitude \e
+     * lat1, longitude \e lon1, and azimuth \e azi1 (all in degrees).
+     *
+     * @param[in] g A Geodesic object used to compute the necessary
+     *   information about the GeodesicLine.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] azi1 azimuth at point 1 (degrees).
+     * @param[in] caps bitor'ed combination of GeodesicLine::mask values
+     *   specifying the capabilities the GeodesicLine object should possess.
+     *
+     * This is equivalent to assigning GeodesicLine(\e g, \e lat1, \e lon1,
+     * \e azi1, \e caps) to the object, but the object is set in place.
+     * Point 3 is reset to NaNs; use SetDistance or SetArc to set it.
+     **********************************************************************/
+    void Reset(const Geodesic& g, real lat1, real lon1, real azi1,
+               unsigned caps = ALL);
+
+    /**
+     * Re-initialize the object as the geodesic line between point 1 (\e
+     * lat1, \e lon1) and point 2 (\e lat2, \e lon2).
+     *
+     * @param[in] g A Geodesic object used to compute the necessary
+     *   information about the GeodesicLine.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[in] caps bitor'ed combination of GeodesicLine::mask values
+     *   specifying the capabilities the GeodesicLine object should possess.
+     *
+     * This is equivalent to assigning \e g.InverseLine(\e lat1, \e lon1,
+     * \e lat2, \e lon2, \e caps) to the object; point 3 is set to point 2.
+     **********************************************************************/
+    void ResetInverse(const Geodesic& g,
+                      real lat1, real lon1, real lat2, real lon2,
+                      unsigned caps = ALL);
+    ///@}
+
     /** \name Position in terms of distance
      **********************************************************************/
     ///@{
@@ -540,6 +596,115 @@ namespace GeographicLib {
                            real& S12) const;
     ///@}
 
+    /** \name Batch position functions.
+     **********************************************************************/
+    ///@{
+
+    /**
+     * Compute the positions of many points on the geodesic.
+     *
+     * @param[in] arcmode boolean flag determining the meaning of \e s12_a12;
+     *   if \e arcmode is false, then the GeodesicLine object must have been
+     *   constructed with \e caps |= GeodesicLine::DISTANCE_IN.
+     * @param[in] n the number of points.
+     * @param[in] s12_a12 array of distances (meters) or arc lengths (degrees)
+     *   from point 1 to the points.
+     * @param[in] outmask a bitor'ed combination of GeodesicLine::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] lat2 array of latitudes (degrees).
+     * @param[out] lon2 array of longitudes (degrees).
+     * @param[out] azi2 array of (forward) azimuths (degrees).
+     * @param[out] s12 array of distances from point 1 (meters).
+     * @param[out] m12 array of reduced lengths (meters).
+     * @param[out] M12 array of geodesic scales of the points relative to
+     *   point 1 (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to the
+     *   points (dimensionless).
+     * @param[out] S12 array of areas under the geodesic (meters<sup>2</sup>).
+     * @param[out] a12 array of arc lengths from point 1 (degrees).
+     *
+     * This is equivalent to calling GeodesicLine::GenPosition for each
+     * element of \e s12_a12 and storing the results in the corresponding
+     * element of the output arrays; the tests on \e outmask are made once
+     * for the whole array.  Output arrays not selected by \e outmask, or
+     * which the GeodesicLine object is not capable of computing, are not
+     * referenced and may be null; \e a12 is only set if it is not null.
+     **********************************************************************/
+    void GenPositions(bool arcmode, size_t n, const real s12_a12[],
+                      unsigned outmask,
+                      real lat2[], real lon2[], real azi2[],
+                      real s12[], real m12[], real M12[], real M21[],
+                      real S12[], real a12[] = nullptr) const {
+      GenPositions(arcmode, n, s12_a12, 0, 0, outmask,
+                   lat2, lon2, azi2, s12, m12, M12, M21, S12, a12);
+    }
+
+    /**
+     * Compute the positions of equally spaced points on the geodesic.
+     *
+     * @param[in] arcmode boolean flag determining the meaning of \e s0_a0
+     *   and \e ds_da; if \e arcmode is false, then the GeodesicLine object
+     *   must have been constructed with \e caps |= GeodesicLine::DISTANCE_IN.
+     * @param[in] n the number of points.
+     * @param[in] s0_a0 the distance (meters) or arc length (degrees) from
+     *   point 1 to the first point.
+     * @param[in] ds_da the spacing of the points (meters or degrees).
+     * @param[in] outmask a bitor'ed combination of GeodesicLine::mask values
+     *   specifying which of the output arrays should be set.
+     * @param[out] lat2 array of latitudes (degrees).
+     * @param[out] lon2 array of longitudes (degrees).
+     * @param[out] azi2 array of (forward) azimuths (degrees).
+     * @param[out] s12 array of distances from point 1 (meters).
+     * @param[out] m12 array of reduced lengths (meters).
+     * @param[out] M12 array of geodesic scales of the points relative to
+     *   point 1 (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to the
+     *   points (dimensionless).
+     * @param[out] S12 array of areas under the geodesic (meters<sup>2</sup>).
+     * @param[out] a12 array of arc lengths from point 1 (degrees).
+     *
+     * Point \e i is at \e s0_a0 + \e i \e ds_da.  The position is computed
+     * afresh for each point (rather than by stepping from the previous
+     * point), so the results are the same as those returned by
+     * GeodesicLine::GenPosition.  To densify the geodesic between point 1 and
+     * point 3, use \e s0_a0 = 0 and \e ds_da = GeodesicLine::Distance() /
+     * (\e n &minus; 1).  See the documentation for GeodesicLine::GenPositions
+     * for the treatment of the output arrays.
+     **********************************************************************/
+    void GenPositions(bool arcmode, size_t n, real s0_a0, real ds_da,
+                      unsigned outmask,
+                      real lat2[], real lon2[], real azi2[],
+                      real s12[], real m12[], real M12[], real M21[],
+                      real S12[], real a12[] = nullptr) const {
+      GenPositions(arcmode, n, nullptr, s0_a0, ds_da, outmask,
+                   lat2, lon2, azi2, s12, m12, M12, M21, S12, a12);
+    }
+
+    /**
+     * Compute the latitudes and longitudes of many points specified by their
+     * distances from point 1.
+     *
+     * See the documentation for GeodesicLine::GenPositions.
+     **********************************************************************/
+    void Positions(size_t n, const real s12[],
+                   real lat2[], real lon2[]) const {
+      GenPositions(false, n, s12, LATITUDE | LONGITUDE, lat2, lon2,
+                   nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+    }
+
+    /**
+     * Compute the latitudes and longitudes of many points specified by their
+     * arc lengths from point 1.
+     *
+     * See the documentation for GeodesicLine::GenPositions.
+     **********************************************************************/
+    void ArcPositions(size_t n, const real a12[],
+                      real lat2[], real lon2[]) const {
+      GenPositions(true, n, a12, LATITUDE | LONGITUDE, lat2, lon2,
+                   nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+    }
+    ///@}
+
     /** \name Setting point 3
      **********************************************************************/
     ///@{
@@ -577,6 +742,29 @@ namespace GeographicLib {
      *   point 1 to point 3 (degrees); it can be negative.
      **********************************************************************/
     void GenSetDistance(bool arcmode, real s13_a13);
+
+    /**
+     * The bounding box of the segment from point 1 to point 3.
+     *
+     * @param[out] latmin the minimum latitude (degrees).
+     * @param[out] latmax the maximum latitude (degrees).
+     * @param[out] lonw the longitude of the western edge (degrees).
+     * @param[out] dlon the longitudinal extent (degrees).
+     *
+     * The box spans longitudes [\e lonw, \e lonw + \e dlon] where \e lonw
+     * is in [&minus;180&deg;, 180&deg;) and \e dlon is in [0&deg;, 360&deg;];
+     * the box may straddle the antimeridian.  The latitude range includes
+     * that of the vertex of the geodesic (the point of maximum or minimum
+     * latitude) if this lies within the segment.  The longitude is monotonic
+     * along a geodesic, so the longitude range is that of the end points,
+     * except that a segment passing over a pole spans all longitudes.  This
+     * requires that the GeodesicLine object have been constructed with \e
+     * caps including GeodesicLine::LATITUDE and GeodesicLine::LONGITUDE and
+     * that point 3 have been set (e.g., by Geodesic::InverseLine); otherwise
+     * NaNs are returned.
+     **********************************************************************/
+    void BoundingBox(real& latmin, real& latmax, real& lonw, real& dlon)
+      const;
     ///@}
 
     /** \name Inspector functions
@@ -0,0 +1,487 @@
+/**
+ * \file GeodesicLineCompact.hpp
+ * \brief Header for GeographicLib::GeodesicLineCompact class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEODESICLINECOMPACT_HPP)
+#define GEOGRAPHICLIB_GEODESICLINECOMPACT_HPP 1
+
+#include <iostream>
+#include <limits>
+#include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/Utility.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief A geodesic line holding only what its capabilities need
+   *
+   * GeodesicLine holds all the series coefficients that any of its
+   * capabilities might need, so that \e sizeof(GeodesicLine) is 520 bytes
+   * (with real = double and the default series order) whatever
+   * capabilities are requested.  GeodesicLineCompact fixes the capabilities
+   * at compile time with the template parameter \e caps and stores only the
+   * coefficients and the other quantities that these capabilities require.
+   * For the default, \e caps = GeodesicLine::LONGITUDE |
+   * GeodesicLine::DISTANCE_IN (positions given in terms of distance),
+   * \e sizeof(GeodesicLineCompact<>) is 304 bytes; with \e caps =
+   * GeodesicLine::LONGITUDE (positions given in terms of arc length), it's
+   * 168 bytes.  The results are the same as those given by GeodesicLine.
+   *
+   * A GeodesicLineCompact is made from a GeodesicLine (which must have all
+   * the capabilities in \e caps), so the line can be specified in any of the
+   * ways allowed for GeodesicLine, e.g., with Geodesic::InverseLine.  The
+   * position of point 3, given by Distance() and Arc(), is copied from the
+   * GeodesicLine.
+   *
+   * Save() writes the line in a compact portable form, namely \e lat1, \e
+   * lon1, \e azi1, \e s13, and \e a13 as little-endian doubles (40 bytes),
+   * and Load() rebuilds the line from this.  The rebuilt line reproduces the
+   * original, except that lines not defined by an azimuth (e.g., those given
+   * by Geodesic::InverseLine) are rebuilt from \e azi1 in degrees, which may
+   * change the results by roundoff.
+   *
+   * As with GeodesicLine, the copy constructor and assignment operators
+   * work, the object holds no heap-allocated state, and GeodesicLineCompact
+   * objects may be used by several threads.
+   *
+   * Example of use:
+   * \code
+   typedef GeodesicLineCompact<> line;
+   const Geodesic& geod = Geodesic::WGS84();
+   std::vector<line> routes;
+   routes.push_back(line(geod.InverseLine(40.6, -73.8, 51.6, -0.5)));
+   real lat, lon;
+   routes[0].Position(0.5 * routes[0].Distance(), lat, lon);
+   \endcode
+   *
+   * @tparam caps bitor'ed combination of GeodesicLine::mask values specifying
+   *   the capabilities (GeodesicLine::LATITUDE and GeodesicLine::AZIMUTH are
+   *   included automatically).
+   **********************************************************************/
+  template<unsigned caps = GeodesicLine::LONGITUDE | GeodesicLine::DISTANCE_IN>
+  class GeodesicLineCompact {
+  private:
+    typedef Math::real real;
+    static const int nC1_ = Geodesic::nC1_;
+    static const int nC1p_ = Geodesic::nC1p_;
+    static const int nC2_ = Geodesic::nC2_;
+    static const int nC3_ = Geodesic::nC3_;
+    static const int nC4_ = Geodesic::nC4_;
+    static const unsigned caps_ =
+      caps | GeodesicLine::LATITUDE | GeodesicLine::AZIMUTH |
+      GeodesicLine::LONG_UNROLL;
+    // Which series are needed
+    static const bool useC1_ = (caps_ & Geodesic::CAP_C1) != 0;
+    static const bool useC1p_ = (caps_ & Geodesic::CAP_C1p) != 0;
+    static const bool useC2_ = (caps_ & Geodesic::CAP_C2) != 0;
+    static const bool useC3_ = (caps_ & Geodesic::CAP_C3) != 0;
+    static const bool useC4_ = (caps_ & Geodesic::CAP_C4) != 0;
+    // The offsets of the quantities in _p.  Those which aren't needed take
+    // no space.  The series coefficients omit the unused element c[0] of the
+    // sine series.
+    enum {
+      lat1_, lon1_, azi1_, s13_, a13_, f_, f1_, k2_,
+      salp0_, calp0_, ssig1_, csig1_,
+      b_,
+      A1m1_ = b_ + useC1_, B11_ = A1m1_ + useC1_, C1a_ = B11_ + useC1_,
+      stau1_ = C1a_ + useC1_ * nC1_, ctau1_ = stau1_ + useC1p_,
+      C1pa_ = ctau1_ + useC1p_,
+      somg1_ = C1pa_ + useC1p_ * nC1p_, comg1_ = somg1_ + useC3_,
+      A3c_ = comg1_ + useC3_, B31_ = A3c_ + useC3_, C3a_ = B31_ + useC3_,
+      dn1_ = C3a_ + useC3_ * (nC3_ - 1), A2m1_ = dn1_ + useC2_,
+      B21_ = A2m1_ + useC2_, C2a_ = B21_ + useC2_,
+      c2_ = C2a_ + useC2_ * nC2_, salp1_ = c2_ + useC4_,
+      calp1_ = salp1_ + useC4_,
+      A4_ = calp1_ + useC4_, B41_ = A4_ + useC4_, C4a_ = B41_ + useC4_,
+      size_ = C4a_ + useC4_ * nC4_,
+    };
+    real _p[size_];
+
+    // Pointers to the coefficients arranged so that the sine series have
+    // the indexing expected by Geodesic::SinCosSeries.
+    const real* C1a() const { return _p + C1a_ - 1; }
+    const real* C1pa() const { return _p + C1pa_ - 1; }
+    const real* C2a() const { return _p + C2a_ - 1; }
+    const real* C3a() const { return _p + C3a_ - 1; }
+    const real* C4a() const { return _p + C4a_; }
+
+    void init(const GeodesicLine& l) {
+      if (!( l.Init() && (l._caps & caps_) == caps_ ))
+        throw GeographicErr("GeodesicLine lacks the capabilities "
+                            "of GeodesicLineCompact");
+      real* p = _p;
+      p[lat1_] = l._lat1; p[lon1_] = l._lon1; p[azi1_] = l._azi1;
+      p[s13_] = l._s13; p[a13_] = l._a13;
+      p[f_] = l._f; p[f1_] = l._f1; p[k2_] = l._k2;
+      p[salp0_] = l._salp0; p[calp0_] = l._calp0;
+      p[ssig1_] = l._ssig1; p[csig1_] = l._csig1;
+      if (useC1_) {
+        p[b_] = l._b; p[A1m1_] = l._A1m1; p[B11_] = l._B11;
+        std::copy(l._C1a + 1, l._C1a + nC1_ + 1, p + C1a_);
+      }
+      if (useC1p_) {
+        p[stau1_] = l._stau1; p[ctau1_] = l._ctau1;
+        std::copy(l._C1pa + 1, l._C1pa + nC1p_ + 1, p + C1pa_);
+      }
+      if (useC3_) {
+        p[somg1_] = l._somg1; p[comg1_] = l._comg1;
+        p[A3c_] = l._A3c; p[B31_] = l._B31;
+        std::copy(l._C3a + 1, l._C3a + nC3_, p + C3a_);
+      }
+      if (useC2_) {
+        p[dn1_] = l._dn1; p[A2m1_] = l._A2m1; p[B21_] = l._B21;
+        std::copy(l._C2a + 1, l._C2a + nC2_ + 1, p + C2a_);
+      }
+      if (useC4_) {
+        p[c2_] = l._c2; p[salp1_] = l._salp1; p[calp1_] = l._calp1;
+        p[A4_] = l._A4; p[B41_] = l._B41;
+        std::copy(l._C4a, l._C4a + nC4_, p + C4a_);
+      }
+    }
+
+  public:
+
+    /** \name Constructors
+     **********************************************************************/
+    ///@{
+
+    /**
+     * Constructor from a GeodesicLine.
+     *
+     * @param[in] line the GeodesicLine.
+     * @exception GeographicErr if \e line isn't initialized or if it doesn't
+     *   have all the capabilities in \e caps.
+     **********************************************************************/
+    explicit GeodesicLineCompact(const GeodesicLine& line) { init(line); }
+
+    /**
+     * Constructor for a geodesic line staring at latitude \e lat1, longitude
+     * \e lon1, and azimuth \e azi1 (all in degrees).
+     *
+     * @param[in] g the Geodesic object specifying the ellipsoid.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] azi1 azimuth at point 1 (degrees).
+     *
+     * This is equivalent to constructing from GeodesicLine(\e g, \e lat1, \e
+     * lon1, \e azi1, \e caps).
+     **********************************************************************/
+    GeodesicLineCompact(const Geodesic& g, real lat1, real lon1, real azi1)
+    { init(GeodesicLine(g, lat1, lon1, azi1, caps_)); }
+
+    /**
+     * A default constructor.  All the positions on the resulting line are
+     * NaNs.
+     **********************************************************************/
+    GeodesicLineCompact()
+    { std::fill(_p, _p + size_, Math::NaN<real>()); }
+    ///@}
+
+    /** \name The general position function.
+     **********************************************************************/
+    ///@{
+
+    /**
+     * The general position function.  This is the same as
+     * GeodesicLine::GenPosition, except that the quantities which the
+     * capabilities don't provide are left unchanged.
+     *
+     * @param[in] arcmode boolean flag determining the meaning of the second
+     *   parameter; if \e arcmode is false, then the line must have the
+     *   GeodesicLine::DISTANCE_IN capability.
+     * @param[in] s12_a12 if \e arcmode is false, this is the distance between
+     *   point 1 and point 2 (meters); otherwise it is the arc length between
+     *   point 1 and point 2 (degrees); it can be negative.
+     * @param[in] outmask a bitor'ed combination of GeodesicLine::mask values
+     *   specifying which of the following parameters should be set.
+     * @param[out] lat2 latitude of point 2 (degrees).
+     * @param[out] lon2 longitude of point 2 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @param[out] s12 distance from point 1 to point 2 (meters).
+     * @param[out] m12 reduced length of geodesic (meters).
+     * @param[out] M12 geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 area under the geodesic (meters<sup>2</sup>).
+     * @return \e a12 arc length from point 1 to point 2 (degrees).
+     **********************************************************************/
+    Math::real GenPosition(bool arcmode, real s12_a12, unsigned outmask,
+                           real& lat2, real& lon2, real& azi2,
+                           real& s12, real& m12, real& M12, real& M21,
+                           real& S12) const;
+    ///@}
+
+    /** \name Position in terms of distance
+     **********************************************************************/
+    ///@{
+
+    /**
+     * Compute the position of point 2 which is a distance \e s12 (meters)
+     * from point 1.  This requires the GeodesicLine::DISTANCE_IN capability.
+     *
+     * @param[in] s12 distance from point 1 to point 2 (meters); it can be
+     *   negative.
+     * @param[out] lat2 latitude of point 2 (degrees).
+     * @param[out] lon2 longitude of point 2 (degrees); requires the
+     *   GeodesicLine::LONGITUDE capability.
+     * @return \e a12 arc length from point 1 to point 2 (degrees).
+     **********************************************************************/
+    Math::real Position(real s12, real& lat2, real& lon2) const {
+      real t;
+      return GenPosition(false, s12, GeodesicLine::LATITUDE |
+                         GeodesicLine::LONGITUDE,
+                         lat2, lon2, t, t, t, t, t, t);
+    }
+
+    /**
+     * See the documentation for GeodesicLineCompact::Position.
+     **********************************************************************/
+    Math::real Position(real s12, real& lat2, real& lon2, real& azi2) const {
+      real t;
+      return GenPosition(false, s12, GeodesicLine::LATITUDE |
+                         GeodesicLine::LONGITUDE | GeodesicLine::AZIMUTH,
+                         lat2, lon2, azi2, t, t, t, t, t);
+    }
+    ///@}
+
+    /** \name Position in terms of arc length
+     **********************************************************************/
+    ///@{
+
+    /**
+     * Compute the position of point 2 which is an arc length \e a12
+     * (degrees) from point 1.
+     *
+     * @param[in] a12 arc length from point 1 to point 2 (degrees); it can
+     *   be negative.
+     * @param[out] lat2 latitude of point 2 (degrees).
+     * @param[out] lon2 longitude of point 2 (degrees); requires the
+     *   GeodesicLine::LONGITUDE capability.
+     **********************************************************************/
+    void ArcPosition(real a12, real& lat2, real& lon2) const {
+      real t;
+      GenPosition(true, a12, GeodesicLine::LATITUDE | GeodesicLine::LONGITUDE,
+                  lat2, lon2, t, t, t, t, t, t);
+    }
+
+    /**
+     * See the documentation for GeodesicLineCompact::ArcPosition.
+     **********************************************************************/
+    void ArcPosition(real a12, real& lat2, real& lon2, real& azi2) const {
+      real t;
+      GenPosition(true, a12, GeodesicLine::LATITUDE |
+                  GeodesicLine::LONGITUDE | GeodesicLine::AZIMUTH,
+                  lat2, lon2, azi2, t, t, t, t, t);
+    }
+    ///@}
+
+    /** \name Compact serialization
+     **********************************************************************/
+    ///@{
+
+    /**
+     * Write the line to a stream.
+     *
+     * @param[in,out] os the stream to write to.
+     * @exception GeographicErr if the data can't be written.
+     *
+     * This writes \e lat1, \e lon1, \e azi1, \e s13, and \e a13 as
+     * little-endian doubles.
+     **********************************************************************/
+    void Save(std::ostream& os) const {
+      Utility::writearray<double, real, false>(os, _p, a13_ + 1);
+    }
+
+    /**
+     * Read a line from a stream.
+     *
+     * @param[in] g the Geodesic object specifying the ellipsoid (this should
+     *   be the same as that used to create the saved line).
+     * @param[in,out] is the stream to read from.
+     * @exception GeographicErr if the data can't be read.
+     **********************************************************************/
+    void Load(const Geodesic& g, std::istream& is) {
+      real v[a13_ + 1];
+      Utility::readarray<double, real, false>(is, v, a13_ + 1);
+      init(GeodesicLine(g, v[lat1_], v[lon1_], v[azi1_], caps_));
+      _p[s13_] = v[s13_]; _p[a13_] = v[a13_];
+    }
+    ///@}
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+
+    /**
+     * @return \e lat1 the latitude of point 1 (degrees).
+     **********************************************************************/
+    Math::real Latitude() const { return _p[lat1_]; }
+
+    /**
+     * @return \e lon1 the longitude of point 1 (degrees).
+     **********************************************************************/
+    Math::real Longitude() const { return _p[lon1_]; }
+
+    /**
+     * @return \e azi1 the azimuth (degrees) of the geodesic line at point 1.
+     **********************************************************************/
+    Math::real Azimuth() const { return _p[azi1_]; }
+
+    /**
+     * @return \e s13, the distance to point 3 (meters).
+     **********************************************************************/
+    Math::real Distance() const { return _p[s13_]; }
+
+    /**
+     * @return \e a13, the arc length to point 3 (degrees).
+     **********************************************************************/
+    Math::real Arc() const { return _p[a13_]; }
+
+    /**
+     * @return \e caps the capabilities of the line (including those added
+     *   automatically).
+     **********************************************************************/
+    static unsigned Capabilities() { return caps_; }
+    ///@}
+  };
+
+  template<unsigned caps>
+  Math::real GeodesicLineCompact<caps>::GenPosition(bool arcmode,
+                                                    real s12_a12,
+                                                    unsigned outmask,
+                                                    real& lat2, real& lon2,
+                                                    real& azi2,
+                                                    real& s12, real& m12,
+                                                    real& M12, real& M21,
+                                                    real& S12) const {
+    // This follows GeodesicLine::GenPosition.
+    using std::abs; using std::sqrt; using std::hypot; using std::atan2;
+    using std::sin; using std::cos; using std::copysign;
+    const real* p = _p;
+    outmask &= caps_ & Geodesic::OUT_MASK;
+    if (!( arcmode || useC1p_ ))
+      return Math::NaN();
+    const bool sphere = p[f_] == 0;
+    real sig12, ssig12, csig12, B12 = 0, AB1 = 0;
+    if (arcmode) {
+      sig12 = s12_a12 * Math::degree();
+      Math::sincosd(s12_a12, ssig12, csig12);
+    } else if (sphere) {
+      sig12 = s12_a12 / p[b_];
+      ssig12 = sin(sig12); csig12 = cos(sig12);
+    } else {
+      real
+        tau12 = s12_a12 / (p[b_] * (1 + p[A1m1_])),
+        s = sin(tau12),
+        c = cos(tau12);
+      B12 = - Geodesic::SinCosSeries(true,
+                                     p[stau1_] * c + p[ctau1_] * s,
+                                     p[ctau1_] * c - p[stau1_] * s,
+                                     C1pa(), nC1p_);
+      sig12 = tau12 - (B12 - p[B11_]);
+      ssig12 = sin(sig12); csig12 = cos(sig12);
+      if (abs(p[f_]) > real(0.01)) {
+        real
+          ssig2 = p[ssig1_] * csig12 + p[csig1_] * ssig12,
+          csig2 = p[csig1_] * csig12 - p[ssig1_] * ssig12;
+        B12 = Geodesic::SinCosSeries(true, ssig2, csig2, C1a(), nC1_);
+        real serr = (1 + p[A1m1_]) * (sig12 + (B12 - p[B11_]))
+          - s12_a12 / p[b_];
+        sig12 = sig12 - serr / sqrt(1 + p[k2_] * Math::sq(ssig2));
+        ssig12 = sin(sig12); csig12 = cos(sig12);
+      }
+    }
+
+    real ssig2, csig2, sbet2, cbet2, salp2, calp2;
+    ssig2 = p[ssig1_] * csig12 + p[csig1_] * ssig12;
+    csig2 = p[csig1_] * csig12 - p[ssig1_] * ssig12;
+    real dn2 = sqrt(1 + p[k2_] * Math::sq(ssig2));
+    if (useC1_ && !sphere &&
+        (outmask & (GeodesicLine::DISTANCE | GeodesicLine::REDUCEDLENGTH |
+                    GeodesicLine::GEODESICSCALE))) {
+      if (arcmode || abs(p[f_]) > real(0.01))
+        B12 = Geodesic::SinCosSeries(true, ssig2, csig2, C1a(), nC1_);
+      AB1 = (1 + p[A1m1_]) * (B12 - p[B11_]);
+    }
+    sbet2 = p[calp0_] * ssig2;
+    cbet2 = hypot(p[salp0_], p[calp0_] * csig2);
+    if (cbet2 == 0)
+      cbet2 = csig2 = sqrt(std::numeric_limits<real>::min());
+    salp2 = p[salp0_]; calp2 = p[calp0_] * csig2;
+
+    if (useC1_ && (outmask & GeodesicLine::DISTANCE))
+      s12 = arcmode ? p[b_] * ((1 + p[A1m1_]) * sig12 + AB1) : s12_a12;
+
+    if (useC3_ && (outmask & GeodesicLine::LONGITUDE)) {
+      real somg2 = p[salp0_] * ssig2, comg2 = csig2,
+        E = copysign(real(1), p[salp0_]);
+      real omg12 = outmask & GeodesicLine::LONG_UNROLL
+        ? E * (sig12
+               - (atan2(    ssig2, csig2) - atan2(    p[ssig1_], p[csig1_]))
+               + (atan2(E * somg2, comg2) - atan2(E * p[somg1_], p[comg1_])))
+        : atan2(somg2 * p[comg1_] - comg2 * p[somg1_],
+                comg2 * p[comg1_] + somg2 * p[somg1_]);
+      real lam12 = sphere ? omg12 : omg12 + p[A3c_] *
+        ( sig12 + (Geodesic::SinCosSeries(true, ssig2, csig2, C3a(), nC3_-1)
+                   - p[B31_]));
+      real lon12 = lam12 / Math::degree();
+      lon2 = outmask & GeodesicLine::LONG_UNROLL ? p[lon1_] + lon12 :
+        Math::AngNormalize(Math::AngNormalize(p[lon1_]) +
+                           Math::AngNormalize(lon12));
+    }
+
+    if (outmask & GeodesicLine::LATITUDE)
+      lat2 = Math::atan2d(sbet2, p[f1_] * cbet2);
+
+    if (outmask & GeodesicLine::AZIMUTH)
+      azi2 = Math::atan2d(salp2, calp2);
+
+    if (useC2_ && (outmask & (GeodesicLine::REDUCEDLENGTH |
+                           GeodesicLine::GEODESICSCALE))) {
+      real J12 = 0;
+      if (!sphere) {
+        real
+          B22 = Geodesic::SinCosSeries(true, ssig2, csig2, C2a(), nC2_),
+          AB2 = (1 + p[A2m1_]) * (B22 - p[B21_]);
+        J12 = (p[A1m1_] - p[A2m1_]) * sig12 + (AB1 - AB2);
+      }
+      if (outmask & GeodesicLine::REDUCEDLENGTH)
+        m12 = p[b_] * ((dn2 * (p[csig1_] * ssig2) -
+                        p[dn1_] * (p[ssig1_] * csig2))
+                       - p[csig1_] * csig2 * J12);
+      if (outmask & GeodesicLine::GEODESICSCALE) {
+        real t = p[k2_] * (ssig2 - p[ssig1_]) * (ssig2 + p[ssig1_]) /
+          (p[dn1_] + dn2);
+        M12 = csig12 + (t *  ssig2 -  csig2 * J12) * p[ssig1_] / p[dn1_];
+        M21 = csig12 - (t * p[ssig1_] - p[csig1_] * J12) *  ssig2 /  dn2;
+      }
+    }
+
+    if (useC4_ && (outmask & GeodesicLine::AREA)) {
+      real B42 = sphere ? 0 :
+        Geodesic::SinCosSeries(false, ssig2, csig2, C4a(), nC4_);
+      real salp12, calp12;
+      if (p[calp0_] == 0 || p[salp0_] == 0) {
+        salp12 = salp2 * p[calp1_] - calp2 * p[salp1_];
+        calp12 = calp2 * p[calp1_] + salp2 * p[salp1_];
+      } else {
+        salp12 = p[calp0_] * p[salp0_] *
+          (csig12 <= 0 ? p[csig1_] * (1 - csig12) + ssig12 * p[ssig1_] :
+           ssig12 * (p[csig1_] * ssig12 / (1 + csig12) + p[ssig1_]));
+        calp12 = Math::sq(p[salp0_]) + Math::sq(p[calp0_]) * p[csig1_] * csig2;
+      }
+      S12 = p[c2_] * atan2(salp12, calp12) + p[A4_] * (B42 - p[B41_]);
+    }
+
+    return arcmode ? s12_a12 : sig12 / Math::degree();
+  }
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_GEODESICLINECOMPACT_HPP
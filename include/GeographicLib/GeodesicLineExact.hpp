@@ -22,7 +22,8 @@ namespace GeographicLib {
    * GeodesicLineExact facilitates the determination of a series of points on a
    * single geodesic.  This is a companion to the GeodesicExact class.  For
    * additional information on this class see the documentation on the
-   * GeodesicLine class.
+   * GeodesicLine class.  With real = double and the default series order,
+   * \e sizeof(GeodesicLineExact) is 600 bytes.
    *
    * Example of use:
    * \include example-GeodesicLineExact.cpp
@@ -197,6 +198,51 @@ namespace GeographicLib {
     GeodesicLineExact() : _caps(0U) {}
     ///@}
 
+    /** \name Re-initialization
+     **********************************************************************/
+    ///@{
+    /**
+     * Re-initialize the object as a geodesic line starting at latitude \e
+     * lat1, longitude \e lon1, and azimuth \e azi1 (all in degrees).
+     *
+     * @param[in] g A GeodesicExact object used to compute the necessary
+     *   information about the GeodesicLineExact.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] azi1 azimuth at point 1 (degrees).
+     * @param[in] caps bitor'ed combination of GeodesicLineExact::mask values
+     *   specifying the capabilities the GeodesicLineExact object should
+     *   possess.
+     *
+     * This is equivalent to assigning GeodesicLineExact(\e g, \e lat1, \e lon1,
+     * \e azi1, \e caps) to the object, but the object is set in place.
+     * Point 3 is reset to NaNs; use SetDistance or SetArc to set it.
+     **********************************************************************/
+    void Reset(const GeodesicExact& g, real lat1, real lon1, real azi1,
+               unsigned caps = ALL);
+
+    /**
+     * Re-initialize the object as the geodesic line between point 1 (\e
+     * lat1, \e lon1) and point 2 (\e lat2, \e lon2).
+     *
+     * @param[in] g A GeodesicExact object used to compute the necessary
+     *   information about the GeodesicLineExact.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[in] caps bitor'ed combination of GeodesicLineExact::mask values
+     *   specifying the capabilities the GeodesicLineExact object should
+     *   possess.
+     *
+     * This is equivalent to assigning \e g.InverseLine(\e lat1, \e lon1,
+     * \e lat2, \e lon2, \e caps) to the object; point 3 is set to point 2.
+     **********************************************************************/
+    void ResetInverse(const GeodesicExact& g,
+                      real lat1, real lon1, real lat2, real lon2,
+                      unsigned caps = ALL);
+    ///@}
+
     /** \name Position in terms of distance
      **********************************************************************/
     ///@{
@@ -0,0 +1,171 @@
+/**
+ * \file GeodesicMetric.hpp
+ * \brief Header for GeographicLib::GeodesicMetricT class
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEODESICMETRIC_HPP)
+#define GEOGRAPHICLIB_GEODESICMETRIC_HPP 1
+
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicExact.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief The geodesic distance as a metric for NearestNeighbor
+   *
+   * This is a distance function object for use with NearestNeighbor, e.g.,
+   * \code
+   typedef GeodesicMetric::point pos;
+   GeodesicMetric dist(Geodesic::WGS84());
+   std::vector<pos> pts;
+   pts.push_back(dist.Point(lat, lon)); ...
+   NearestNeighbor<Math::real, pos, GeodesicMetric> set(pts, dist);
+   \endcode
+   * The distance is the geodesic distance computed by GeodType::Inverse.  The
+   * latitude-dependent quantities needed by the inverse calculation are
+   * computed once for each point by Point().
+   *
+   * In addition, Bounds() supplies cheap lower and upper bounds on the
+   * distance between two points; NearestNeighbor::Search uses these to skip
+   * the geodesic calculation if the bounds suffice to decide that a point is
+   * not one of the results and that the subtrees of the corresponding node
+   * need not be visited.  The bounds are found as follows: the ellipsoid is the
+   * image of the unit sphere under a mapping which stretches lengths by
+   * factors between \e b and \e a (for an oblate ellipsoid); a point on the
+   * ellipsoid with parametric latitude \e &beta; and longitude \e &lambda;
+   * maps to the point with latitude \e &beta; and longitude \e &lambda; on the
+   * sphere.  If \e &sigma; is the great circle distance between the
+   * corresponding points on the sphere, then the geodesic distance \e s
+   * satisfies \e b &sigma; &le; \e s &le; \e a &sigma;.  The lower bound is
+   * also at least the chord between the points.  The bounds are widened
+   * slightly to allow for roundoff and for the errors in the geodesic
+   * calculation.  Their relative width is about \e f.
+   *
+   * This is a templated class to allow it to be used with Geodesic and
+   * GeodesicExact.  GeographicLib::GeodesicMetric and
+   * GeographicLib::GeodesicMetricExact are typedefs for these cases.
+   *
+   * A GeodesicMetricT object holds no state other than the ellipsoid; thus a
+   * single object may be used by several threads.
+   *
+   * @tparam GeodType the geodesic class to use.
+   **********************************************************************/
+
+  template<class GeodType = Geodesic>
+  class GeodesicMetricT {
+  private:
+    typedef Math::real real;
+    GeodType _earth;
+    real _a, _b, _smin, _smax, _tol;
+  public:
+
+    /**
+     * A point prepared for distance calculations.
+     **********************************************************************/
+    class point {
+    private:
+      friend class GeodesicMetricT<GeodType>;
+      real _lat, _lon, _sbet, _cbet, _dn, _x, _y;
+    public:
+      /**
+       * The default constructor gives a point on the equator at longitude 0
+       * (with parameters appropriate for any ellipsoid).
+       **********************************************************************/
+      point()
+        : _lat(0), _lon(0), _sbet(0), _cbet(1), _dn(1), _x(1), _y(0) {}
+      /**
+       * @return the latitude of the point (degrees).  This is the value
+       *   used by the geodesic calculation; it may differ from the value
+       *   given to Point() by roundoff.
+       **********************************************************************/
+      Math::real Latitude() const { return _lat; }
+      /**
+       * @return the longitude of the point (degrees).
+       **********************************************************************/
+      Math::real Longitude() const { return _lon; }
+    };
+
+    /**
+     * Constructor for GeodesicMetricT.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     **********************************************************************/
+    explicit GeodesicMetricT(const GeodType& earth);
+
+    /**
+     * Prepare a point.
+     *
+     * @param[in] lat the latitude of the point (degrees).
+     * @param[in] lon the longitude of the point (degrees).
+     * @return the point.
+     *
+     * \e lat should be in the range [&minus;90&deg;, 90&deg;].  Neither \e
+     * lat nor \e lon should be a NaN or infinite; such points violate the
+     * metric conditions required by NearestNeighbor.
+     **********************************************************************/
+    point Point(real lat, real lon) const;
+
+    /**
+     * The geodesic distance between two points.
+     *
+     * @param[in] p1 the first point.
+     * @param[in] p2 the second point.
+     * @return the geodesic distance between \e p1 and \e p2 (meters).
+     *
+     * This gives the same result as GeodType::Inverse applied to the
+     * latitudes and longitudes of the points.
+     **********************************************************************/
+    real operator()(const point& p1, const point& p2) const;
+
+    /**
+     * Bounds on the geodesic distance between two points.
+     *
+     * @param[in] p1 the first point.
+     * @param[in] p2 the second point.
+     * @param[out] lo a lower bound on the distance (meters).
+     * @param[out] hi an upper bound on the distance (meters).
+     *
+     * The distance returned by operator()() lies in [\e lo, \e hi].  This
+     * costs about as much as a few trigonometric functions.
+     **********************************************************************/
+    void Bounds(const point& p1, const point& p2, real& lo, real& hi) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _earth.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _earth.Flattening(); }
+    ///@}
+  };
+
+  /**
+   * @relates GeodesicMetricT
+   *
+   * The geodesic distance computed using Geodesic.
+   **********************************************************************/
+  typedef GeodesicMetricT<Geodesic> GeodesicMetric;
+
+  /**
+   * @relates GeodesicMetricT
+   *
+   * The geodesic distance computed using GeodesicExact.
+   **********************************************************************/
+  typedef GeodesicMetricT<GeodesicExact> GeodesicMetricExact;
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_GEODESICMETRIC_HPP
@@ -0,0 +1,297 @@
+/**
+ * \file GeodesicOrigin.hpp
+ * \brief Header for GeographicLib::GeodesicOriginT class
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEODESICORIGIN_HPP)
+#define GEOGRAPHICLIB_GEODESICORIGIN_HPP 1
+
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicExact.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/GeodesicLineExact.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Inverse geodesic problems from a fixed point
+   *
+   * GeodesicOriginT facilitates the solution of many inverse geodesic
+   * problems which share the same first point (\e lat1, \e lon1).  This is
+   * analogous to GeodesicLine which facilitates the solution of many direct
+   * problems sharing the same starting point and azimuth.  The
+   * latitude-dependent quantities for point 1 (the reduced latitude, its sine
+   * and cosine, etc.) are computed once in the constructor.  The results are
+   * identical to those returned by GeodType::GenInverse.
+   *
+   * This is a templated class to allow it to be used with Geodesic and
+   * GeodesicExact.  GeographicLib::GeodesicOrigin and
+   * GeographicLib::GeodesicOriginExact are typedefs for these cases.
+   *
+   * A GeodesicOriginT object is immutable once constructed; thus a single
+   * object may be used by several threads.
+   *
+   * Example of use:
+   * \code
+   * Geodesic geod(Constants::WGS84_a(), Constants::WGS84_f());
+   * // Distances from JFK to several airports
+   * GeodesicOrigin jfk(geod, 40.6, -73.8);
+   * double s12;
+   * jfk.Inverse(51.6, -0.5, s12);  // LHR
+   * jfk.Inverse(49.0, 2.6, s12);   // CDG
+   * \endcode
+   *
+   * @tparam GeodType the geodesic class to use.
+   **********************************************************************/
+
+  template<class GeodType = Geodesic>
+  class GeodesicOriginT {
+  private:
+    typedef Math::real real;
+    GeodType _earth;
+    real _lat1, _lon1, _sbet1, _cbet1, _dn1;
+  public:
+
+    /**
+     * Constructor for GeodesicOriginT.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     *
+     * \e lat1 should be in the range [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    GeodesicOriginT(const GeodType& earth, real lat1, real lon1);
+
+    /** \name Inverse geodesic problem from point 1.
+     **********************************************************************/
+    ///@{
+    /**
+     * Solve the inverse geodesic problem from point 1 to point 2.
+     *
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[out] s12 distance between point 1 and point 2 (meters).
+     * @param[out] azi1 azimuth at point 1 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @param[out] m12 reduced length of geodesic (meters).
+     * @param[out] M12 geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 area under the geodesic (meters<sup>2</sup>).
+     * @return \e a12 arc length of between point 1 and point 2 (degrees).
+     *
+     * See the documentation for Geodesic::Inverse.  The following functions
+     * are overloaded versions of GeodesicOriginT::Inverse which omit some of
+     * the output parameters.
+     **********************************************************************/
+    Math::real Inverse(real lat2, real lon2,
+                       real& s12, real& azi1, real& azi2, real& m12,
+                       real& M12, real& M21, real& S12) const {
+      return GenInverse(lat2, lon2,
+                        GeodType::DISTANCE | GeodType::AZIMUTH |
+                        GeodType::REDUCEDLENGTH | GeodType::GEODESICSCALE |
+                        GeodType::AREA,
+                        s12, azi1, azi2, m12, M12, M21, S12);
+    }
+
+    /**
+     * See the documentation for GeodesicOriginT::Inverse.
+     **********************************************************************/
+    Math::real Inverse(real lat2, real lon2, real& s12) const {
+      real t;
+      return GenInverse(lat2, lon2, GeodType::DISTANCE,
+                        s12, t, t, t, t, t, t);
+    }
+
+    /**
+     * See the documentation for GeodesicOriginT::Inverse.
+     **********************************************************************/
+    Math::real Inverse(real lat2, real lon2, real& azi1, real& azi2) const {
+      real t;
+      return GenInverse(lat2, lon2, GeodType::AZIMUTH,
+                        t, azi1, azi2, t, t, t, t);
+    }
+
+    /**
+     * See the documentation for GeodesicOriginT::Inverse.
+     **********************************************************************/
+    Math::real Inverse(real lat2, real lon2,
+                       real& s12, real& azi1, real& azi2) const {
+      real t;
+      return GenInverse(lat2, lon2, GeodType::DISTANCE | GeodType::AZIMUTH,
+                        s12, azi1, azi2, t, t, t, t);
+    }
+
+    /**
+     * See the documentation for GeodesicOriginT::Inverse.
+     **********************************************************************/
+    Math::real Inverse(real lat2, real lon2,
+                       real& s12, real& azi1, real& azi2, real& m12) const {
+      real t;
+      return GenInverse(lat2, lon2,
+                        GeodType::DISTANCE | GeodType::AZIMUTH |
+                        GeodType::REDUCEDLENGTH,
+                        s12, azi1, azi2, m12, t, t, t);
+    }
+    ///@}
+
+    /** \name General version of inverse geodesic solution.
+     **********************************************************************/
+    ///@{
+    /**
+     * The general inverse geodesic calculation from point 1.
+     * GeodesicOriginT::Inverse is defined in terms of this function.
+     *
+     * @param[in] lat2 latitude of point 2 (degrees).
+     * @param[in] lon2 longitude of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of GeodType::mask values
+     *   specifying which of the following parameters should be set.
+     * @param[out] s12 distance between point 1 and point 2 (meters).
+     * @param[out] azi1 azimuth at point 1 (degrees).
+     * @param[out] azi2 (forward) azimuth at point 2 (degrees).
+     * @param[out] m12 reduced length of geodesic (meters).
+     * @param[out] M12 geodesic scale of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 geodesic scale of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 area under the geodesic (meters<sup>2</sup>).
+     * @return \e a12 arc length of between point 1 and point 2 (degrees).
+     *
+     * See the documentation for Geodesic::GenInverse for the allowed values
+     * of \e outmask.
+     **********************************************************************/
+    Math::real GenInverse(real lat2, real lon2, unsigned outmask,
+                          real& s12, real& azi1, real& azi2,
+                          real& m12, real& M12, real& M21, real& S12) const;
+    ///@}
+
+    /** \name Batch inverse geodesic solution.
+     **********************************************************************/
+    ///@{
+    /**
+     * Solve the inverse geodesic problems from point 1 to each of an array of
+     * points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat2 array of latitudes of point 2 (degrees).
+     * @param[in] lon2 array of longitudes of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of GeodType::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] s12 array of distances (meters).
+     * @param[out] azi1 array of azimuths at point 1 (degrees).
+     * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+     * @param[out] m12 array of reduced lengths (meters).
+     * @param[out] M12 array of geodesic scales of point 2 relative to point 1
+     *   (dimensionless).
+     * @param[out] M21 array of geodesic scales of point 1 relative to point 2
+     *   (dimensionless).
+     * @param[out] S12 array of areas under the geodesics (meters<sup>2</sup>).
+     * @param[out] a12 array of arc lengths (degrees).
+     *
+     * This is equivalent to calling GeodesicOriginT::GenInverse for each
+     * point and storing the results in element \e i of the output arrays.
+     * Output arrays not selected by \e outmask are not referenced and may be
+     * null; \e a12 is only set if it is not null.
+     **********************************************************************/
+    void InverseBatch(size_t n, const real lat2[], const real lon2[],
+                      unsigned outmask,
+                      real s12[], real azi1[], real azi2[],
+                      real m12[], real M12[], real M21[], real S12[],
+                      real a12[] = nullptr) const;
+
+    /**
+     * Solve the inverse problems from point 1 for the distances only.
+     *
+     * See the documentation for GeodesicOriginT::InverseBatch.
+     **********************************************************************/
+    void InverseBatch(size_t n, const real lat2[], const real lon2[],
+                      real s12[]) const {
+      InverseBatch(n, lat2, lon2, GeodType::DISTANCE, s12,
+                   nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
+    }
+    ///@}
+
+    /** \name Fan of geodesics from point 1.
+     **********************************************************************/
+    ///@{
+    /**
+     * Compute the positions for a grid of azimuths and distances from point
+     * 1.
+     *
+     * @param[in] nazi the number of azimuths.
+     * @param[in] azi1 array of azimuths at point 1 (degrees).
+     * @param[in] ns the number of distances.
+     * @param[in] s12 array of distances from point 1 (meters); these can be
+     *   negative.
+     * @param[out] lat2 array of latitudes of the points (degrees).
+     * @param[out] lon2 array of longitudes of the points (degrees).
+     * @param[out] azi2 (optional) array of (forward) azimuths at the points
+     *   (degrees).
+     *
+     * The output arrays have length \e nazi &times; \e ns; element \e i
+     * \e ns + \e j is the result for azimuth \e azi1[\e i] and distance \e
+     * s12[\e j] (so that the ranges for each azimuth are contiguous and the
+     * range rings are strided by \e ns).  \e azi2 is only set if it is not
+     * null.  The results are identical to those of GeodType::Direct.  This
+     * is suitable for generating radar coverage diagrams and buffers: a
+     * single GeodesicLine object is reset for each azimuth (so that no
+     * memory is allocated) and the positions along it are computed together
+     * by GeodesicLine::GenPositions.
+     **********************************************************************/
+    void Fan(size_t nazi, const real azi1[], size_t ns, const real s12[],
+             real lat2[], real lon2[], real azi2[] = nullptr) const;
+    ///@}
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return \e lat1 the latitude of point 1 (degrees).  This is rounded
+     *   in the same way as by GeodType::GenInverse.
+     **********************************************************************/
+    Math::real Latitude() const { return _lat1; }
+
+    /**
+     * @return \e lon1 the longitude of point 1 (degrees).  This is the value
+     *   given to the constructor; GeodType::GenInverse only rounds the
+     *   longitude difference, so \e lon1 is not rounded.
+     **********************************************************************/
+    Math::real Longitude() const { return _lon1; }
+
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _earth.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _earth.Flattening(); }
+    ///@}
+  };
+
+  /**
+   * @relates GeodesicOriginT
+   *
+   * Inverse problems from a fixed point computed using Geodesic.
+   **********************************************************************/
+  typedef GeodesicOriginT<Geodesic> GeodesicOrigin;
+
+  /**
+   * @relates GeodesicOriginT
+   *
+   * Inverse problems from a fixed point computed using GeodesicExact.
+   **********************************************************************/
+  typedef GeodesicOriginT<GeodesicExact> GeodesicOriginExact;
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_GEODESICORIGIN_HPP
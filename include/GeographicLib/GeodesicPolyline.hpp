@@ -0,0 +1,203 @@
+/**
+ * \file GeodesicPolyline.hpp
+ * \brief Header for GeographicLib::GeodesicPolyline class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEODESICPOLYLINE_HPP)
+#define GEOGRAPHICLIB_GEODESICPOLYLINE_HPP 1
+
+#include <vector>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief A polyline of geodesic segments indexed by distance
+   *
+   * A route given by a sequence of waypoints joined by geodesics.  The
+   * constructor solves the inverse problem for each leg once, storing a
+   * GeodesicLine for the leg and the cumulative distance to each waypoint
+   * (summed with an Accumulator).  Subsequent queries for the position at a
+   * given distance along the route find the leg with a binary search and
+   * then only require a direct calculation along the stored GeodesicLine.
+   *
+   * GeodesicPolyline::Positions handles many distances at once; if these
+   * are increasing (as in GeodesicPolyline::Resample), the search for the
+   * leg proceeds from the leg of the previous point.
+   * GeodesicPolyline::TimePositions finds the positions at given times,
+   * assuming constant speed on each leg between timestamped waypoints.
+   *
+   * A GeodesicPolyline object is not modified by any of the queries; thus a
+   * single object may be used by several threads.
+   *
+   * Example of use:
+   * \code
+   * const double lat[] = {40.6, 51.6, 55.8}, lon[] = {-73.8, -0.5, 37.4};
+   * GeodesicPolyline route(Geodesic::WGS84(), 3, lat, lon);
+   * double lat1, lon1;
+   * // Where is the half-way point of the route JFK-LHR-SVO?
+   * route.Position(route.Length() / 2, lat1, lon1);
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT GeodesicPolyline {
+  private:
+    typedef Math::real real;
+    Geodesic _earth;
+    std::vector<GeodesicLine> _legs;
+    // _dist[k] is the distance to waypoint k
+    std::vector<real> _dist;
+  public:
+
+    /**
+     * Constructor for GeodesicPolyline.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     * @param[in] n the number of waypoints.
+     * @param[in] lat array of latitudes of the waypoints (degrees).
+     * @param[in] lon array of longitudes of the waypoints (degrees).
+     * @exception GeographicErr if \e n < 2.
+     * @exception std::bad_alloc if the memory for the legs can't be
+     *   allocated.
+     *
+     * The route consists of the \e n &minus; 1 legs joining consecutive
+     * waypoints.  The latitudes should be in [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    GeodesicPolyline(const Geodesic& earth, size_t n,
+                     const real lat[], const real lon[]);
+
+    /**
+     * Compute the position at a given distance along the route.
+     *
+     * @param[in] s the distance from the first waypoint (meters).
+     * @param[out] lat the latitude of the point (degrees).
+     * @param[out] lon the longitude of the point (degrees).
+     * @param[out] azi the azimuth of the route at the point (degrees).
+     *
+     * If \e s is negative (resp. exceeds GeodesicPolyline::Length), the
+     * first (resp. last) leg is extended to give the position.  At a
+     * waypoint, the azimuth is that of the following leg.  The longitude is
+     * reduced to the range [&minus;180&deg;, 180&deg;].
+     **********************************************************************/
+    void Position(real s, real& lat, real& lon, real& azi) const;
+
+    /**
+     * Compute the position at a given distance along the route omitting the
+     * azimuth.
+     *
+     * @param[in] s the distance from the first waypoint (meters).
+     * @param[out] lat the latitude of the point (degrees).
+     * @param[out] lon the longitude of the point (degrees).
+     **********************************************************************/
+    void Position(real s, real& lat, real& lon) const {
+      real azi;
+      Position(s, lat, lon, azi);
+    }
+
+    /**
+     * Compute the positions at many distances along the route.
+     *
+     * @param[in] m the number of points.
+     * @param[in] s array of distances from the first waypoint (meters).
+     * @param[out] lat array of latitudes of the points (degrees).
+     * @param[out] lon array of longitudes of the points (degrees).
+     * @param[out] azi array of azimuths of the route at the points (degrees);
+     *   this may be omitted.
+     *
+     * The results are the same as calling GeodesicPolyline::Position for
+     * each distance.  The search for the leg is faster if the distances are
+     * sorted.
+     **********************************************************************/
+    void Positions(size_t m, const real s[], real lat[], real lon[],
+                   real azi[] = nullptr) const;
+
+    /**
+     * Resample the route at a fixed spacing.
+     *
+     * @param[in] ds the spacing (meters); this should be positive.
+     * @param[out] lat the latitudes of the points (degrees).
+     * @param[out] lon the longitudes of the points (degrees).
+     * @exception std::bad_alloc if the memory for the output can't be
+     *   allocated.
+     * @return the number of points.
+     *
+     * The points are at distances 0, \e ds, 2\e ds, ... along the route
+     * followed by the end of the route (unless the length of the route is a
+     * multiple of \e ds).  The output vectors are resized to the number of
+     * points.  If \e ds is not positive, the vectors are cleared and 0 is
+     * returned.
+     **********************************************************************/
+    size_t Resample(real ds,
+                    std::vector<real>& lat, std::vector<real>& lon) const;
+
+    /**
+     * Compute the positions at given times.
+     *
+     * @param[in] tw array of the times at the waypoints; this should be
+     *   increasing and have GeodesicPolyline::NumLegs() + 1 elements.
+     * @param[in] m the number of points.
+     * @param[in] t array of the times of the points.
+     * @param[out] lat array of latitudes of the points (degrees).
+     * @param[out] lon array of longitudes of the points (degrees).
+     * @param[out] azi array of azimuths of the route at the points (degrees);
+     *   this may be omitted.
+     *
+     * The speed is taken to be constant on each leg.  Times before \e tw[0]
+     * (resp. after the last waypoint time) are extrapolated along the first
+     * (resp. last) leg.
+     **********************************************************************/
+    void TimePositions(const real tw[], size_t m, const real t[],
+                       real lat[], real lon[], real azi[] = nullptr) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of legs (one less than the number of waypoints).
+     **********************************************************************/
+    size_t NumLegs() const { return _legs.size(); }
+
+    /**
+     * @return the total length of the route (meters).
+     **********************************************************************/
+    Math::real Length() const { return _dist.back(); }
+
+    /**
+     * @param[in] k the index of a waypoint.
+     * @return the distance along the route to waypoint \e k (meters).
+     *
+     * \e k should be in [0, GeodesicPolyline::NumLegs()].
+     **********************************************************************/
+    Math::real Distance(size_t k) const { return _dist[k]; }
+
+    /**
+     * @param[in] k the index of a leg.
+     * @return the GeodesicLine for leg \e k, joining waypoints \e k and \e k
+     *   + 1.
+     *
+     * \e k should be in [0, GeodesicPolyline::NumLegs()).
+     **********************************************************************/
+    const GeodesicLine& Leg(size_t k) const { return _legs[k]; }
+
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _earth.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _earth.Flattening(); }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_GEODESICPOLYLINE_HPP
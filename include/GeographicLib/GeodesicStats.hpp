@@ -0,0 +1,175 @@
+/**
+ * \file GeodesicStats.hpp
+ * \brief Header for GeographicLib::GeodesicStats class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEODESICSTATS_HPP)
+#define GEOGRAPHICLIB_GEODESICSTATS_HPP 1
+
+#include <GeographicLib/Constants.hpp>
+
+#if !defined(GEOGRAPHICLIB_GEODESIC_STATS)
+/**
+ * Do Geodesic and GeodesicExact collect statistics on the solution of the
+ * inverse problem?  This is set by cmake (option
+ * GEOGRAPHICLIB_GEODESIC_STATS).
+ **********************************************************************/
+#  define GEOGRAPHICLIB_GEODESIC_STATS 0
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief Statistics on the solution of the inverse geodesic problem
+   *
+   * If the library is built with GEOGRAPHICLIB_GEODESIC_STATS set, then
+   * Geodesic::GenInverse and GeodesicExact::GenInverse record how each
+   * inverse problem is solved: which case applies (meridional, equatorial,
+   * short, or general) and, in the general case, the number of iterations
+   * and how many of these fell back to bisection.  Each thread updates its
+   * own counters (without locking); the counters are summed over all the
+   * threads (including those that have exited) when GeodesicStats::Get is
+   * called.  If GEOGRAPHICLIB_GEODESIC_STATS is not set (the default), no
+   * statistics are collected, the calls to record them are compiled out,
+   * and all the counters are zero.
+   *
+   * Example of use:
+   * \code
+   * GeodesicStats::Reset(GeodesicStats::GEODESIC);
+   * // ... solve lots of inverse problems ...
+   * GeodesicStats st = GeodesicStats::Get(GeodesicStats::GEODESIC);
+   * std::cout << st.general << " " << st.MeanIterations() << " "
+   *           << st.bisections << "\n";
+   * \endcode
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT GeodesicStats {
+  public:
+    /**
+     * The solvers for which statistics are collected.
+     **********************************************************************/
+    enum solver {
+      /**
+       * Geodesic::GenInverse.
+       * @hideinitializer
+       **********************************************************************/
+      GEODESIC = 0,
+      /**
+       * GeodesicExact::GenInverse.
+       * @hideinitializer
+       **********************************************************************/
+      GEODESICEXACT = 1,
+    };
+
+    /**
+     * The cases for the solution of the inverse problem.
+     **********************************************************************/
+    enum solution {
+      /**
+       * The geodesic runs along a meridian.
+       * @hideinitializer
+       **********************************************************************/
+      MERIDIONAL = 0,
+      /**
+       * The geodesic runs along the equator.
+       * @hideinitializer
+       **********************************************************************/
+      EQUATORIAL = 1,
+      /**
+       * A short line solved directly without iteration.
+       * @hideinitializer
+       **********************************************************************/
+      SHORT = 2,
+      /**
+       * The general case solved by Newton's method.
+       * @hideinitializer
+       **********************************************************************/
+      GENERAL = 3,
+    };
+
+    /**
+     * The size of the histogram of the number of iterations.
+     **********************************************************************/
+    static const int nhist = 32;
+
+    /// The number of meridional geodesics.
+    unsigned long long meridional;
+    /// The number of equatorial geodesics.
+    unsigned long long equatorial;
+    /// The number of short geodesics solved without iteration.
+    unsigned long long shortline;
+    /// The number of geodesics solved by iteration.
+    unsigned long long general;
+    /// The total number of iterations for the general case.
+    unsigned long long iterations;
+    /// The number of iterations which fell back to bisection.
+    unsigned long long bisections;
+    /**
+     * histogram[\e k] is the number of general geodesics needing \e k
+     * iterations (the last element counts \e nhist &minus; 1 or more
+     * iterations).
+     **********************************************************************/
+    unsigned long long histogram[nhist];
+
+    /**
+     * Constructor setting all the counters to zero.
+     **********************************************************************/
+    GeodesicStats();
+
+    /**
+     * @return the total number of inverse problems solved.
+     **********************************************************************/
+    unsigned long long Inverse() const
+    { return meridional + equatorial + shortline + general; }
+
+    /**
+     * @return the mean number of iterations for the general case (NaN if
+     *   there are no such cases).
+     **********************************************************************/
+    double MeanIterations() const
+    { return double(iterations) / double(general); }
+
+    /**
+     * @return whether statistics are collected, i.e., whether the library
+     *   was built with GEOGRAPHICLIB_GEODESIC_STATS set.
+     **********************************************************************/
+    static bool Enabled();
+
+    /**
+     * Get the statistics for a solver.
+     *
+     * @param[in] s the solver.
+     * @return the statistics summed over all threads.
+     **********************************************************************/
+    static GeodesicStats Get(solver s);
+
+    /**
+     * Reset the statistics for a solver to zero.
+     *
+     * @param[in] s the solver.
+     *
+     * Counts recorded by other threads while this function is executing
+     * may be lost.
+     **********************************************************************/
+    static void Reset(solver s);
+
+    /**
+     * Record the solution of an inverse problem in the counters of the
+     * calling thread (for use by Geodesic and GeodesicExact).
+     *
+     * @param[in] s the solver.
+     * @param[in] k the case.
+     * @param[in] numit the number of iterations (for the general case).
+     * @param[in] numbis the number of bisection steps (for the general
+     *   case).
+     **********************************************************************/
+    static void Record(solver s, solution k,
+                       unsigned numit = 0, unsigned numbis = 0);
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_GEODESICSTATS_HPP
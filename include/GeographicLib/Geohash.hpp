@@ -41,11 +41,60 @@ namespace GeographicLib {
   private:
     typedef Math::real real;
     static const int maxlen_ = 18;
-    static const unsigned long long mask_ = 1ULL << 45;
+    // The longest geohash which fits in 64 bits
+    static const int maxintlen_ = 12;
     static const char* const lcdigits_;
     static const char* const ucdigits_;
     Geohash();                     // Disable constructor
 
+  public:
+    /**
+     * The status returned by the conversion from a character buffer which
+     * does not throw an exception.
+     **********************************************************************/
+    enum status {
+      /**
+       * The conversion succeeded.
+       * @hideinitializer
+       **********************************************************************/
+      OK = 0,
+      /**
+       * The Geohash string is illegal.
+       * @hideinitializer
+       **********************************************************************/
+      BADSTRING = 1,
+      /**
+       * The latitude is not in [&minus;90&deg;, 90&deg;] or the adjacent
+       * cell lies beyond a pole.
+       * @hideinitializer
+       **********************************************************************/
+      BADLATITUDE = 2,
+      /**
+       * The latitude or longitude is NaN (integer geohashes only).
+       * @hideinitializer
+       **********************************************************************/
+      BADCOORDS = 3,
+      /**
+       * The output buffer is too small.
+       * @hideinitializer
+       **********************************************************************/
+      BUFFERTOOSMALL = 4,
+    };
+
+  private:
+    // If throwp = false, return a status instead of throwing an exception.
+    static status ReverseChars(const char* geohash, size_t glen,
+                               real& lat, real& lon, int& len,
+                               bool centerp, bool throwp);
+    // Set ulon and ulat to the 45-bit indices of the finest cell containing
+    // (lat, lon), which must be valid.
+    static void Indices(real lat, real lon,
+                        unsigned long long& ulon, unsigned long long& ulat);
+    // Set lat and lon to the center or corner of the cell of length len
+    // whose indices are ulon and ulat.
+    static void Position(unsigned long long ulon, unsigned long long ulat,
+                         int len, bool centerp, real& lat, real& lon);
+
   public:
 
     /**
@@ -88,6 +137,233 @@ namespace GeographicLib {
     static void Reverse(const std::string& geohash, real& lat, real& lon,
                         int& len, bool centerp = true);
 
+    /**
+     * Convert from a geohash in a character buffer to geographic coordinates
+     * without throwing an exception.
+     *
+     * @param[in] geohash the geohash (need not be null-terminated).
+     * @param[in] glen the number of characters in \e geohash.
+     * @param[out] lat latitude of point (degrees).
+     * @param[out] lon longitude of point (degrees).
+     * @param[out] len the length of the geohash.
+     * @param[in] centerp if true (the default) return the center of the
+     *   geohash location, otherwise return the south-west corner.
+     * @return BADSTRING if \e geohash contains illegal characters (in which
+     *   case the output arguments are unchanged), otherwise OK.
+     **********************************************************************/
+    static status Reverse(const char* geohash, size_t glen,
+                          real& lat, real& lon, int& len,
+                          bool centerp = true);
+
+    /** \name Conversions on character buffers and integers
+     *
+     * These versions of Forward and Reverse neither allocate memory nor throw
+     * exceptions; instead an error is signaled by the returned status.  On
+     * failure the output arguments are unchanged.
+     *
+     * An integer geohash of length \e len holds the 5\e len bits of the
+     * geohash, right justified, with the bits of the first character most
+     * significant; thus it is the base-32 value of the geohash string.  The
+     * length is not encoded and must be supplied separately.  Internally, \e
+     * len is first put in the range [0, 12] for integer geohashes, since 12
+     * characters (about 19 cm precision) is the most that fits in 64 bits.
+     * Truncating an integer geohash of length \e len to length \e len
+     * &minus; \e k is a right shift by 5\e k bits.  The bits of the
+     * longitude and the latitude are interleaved using the BMI2 instructions
+     * PDEP and PEXT if these are enabled at compile time (e.g., with
+     * -mbmi2), and by shifting and masking otherwise.
+     **********************************************************************/
+    ///@{
+    /**
+     * Convert from geographic coordinates to a geohash in a character buffer.
+     *
+     * @param[in] lat latitude of point (degrees).
+     * @param[in] lon longitude of point (degrees).
+     * @param[in] len the length of the resulting geohash.
+     * @param[out] geohash buffer for the null-terminated geohash.
+     * @param[in] size the size of \e geohash.
+     * @return the status of the conversion; BADLATITUDE is returned if \e
+     *   lat is not in [&minus;90&deg;, 90&deg;] and BUFFERTOOSMALL if \e
+     *   size is less than the length of the result plus 1.
+     *
+     * Internally, \e len is first put in the range [0, 18].  If \e lat or \e
+     * lon is NaN, the geohash is "invalid".  A buffer with 19 characters is
+     * sufficient for all values of \e len.
+     **********************************************************************/
+    static status Forward(real lat, real lon, int len,
+                          char geohash[], size_t size);
+
+    /**
+     * Convert from geographic coordinates to an integer geohash.
+     *
+     * @param[in] lat latitude of point (degrees).
+     * @param[in] lon longitude of point (degrees).
+     * @param[in] len the length of the geohash.
+     * @param[out] geohash the integer geohash.
+     * @return the status of the conversion; BADLATITUDE is returned if \e
+     *   lat is not in [&minus;90&deg;, 90&deg;] and BADCOORDS if \e lat or
+     *   \e lon is NaN.
+     **********************************************************************/
+    static status Forward(real lat, real lon, int len,
+                          unsigned long long& geohash);
+
+    /**
+     * Convert from an integer geohash to geographic coordinates.
+     *
+     * @param[in] geohash the integer geohash.
+     * @param[in] len the length of the geohash.
+     * @param[out] lat latitude of point (degrees).
+     * @param[out] lon longitude of point (degrees).
+     * @param[in] centerp if true (the default) return the center of the
+     *   geohash location, otherwise return the south-west corner.
+     *
+     * Bits of \e geohash beyond the first 5\e len are ignored.
+     **********************************************************************/
+    static void Reverse(unsigned long long geohash, int len,
+                        real& lat, real& lon, bool centerp = true);
+
+    /**
+     * Convert arrays of geographic coordinates to geohashes in a character
+     * buffer.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes (degrees).
+     * @param[in] lon array of longitudes (degrees).
+     * @param[in] len the length of the geohashes.
+     * @param[out] geohash buffer of \e n &times; \e stride characters; the
+     *   null-terminated geohash for point \e i starts at \e geohash[\e i
+     *   &times; \e stride].
+     * @param[in] stride the space allotted to each geohash.
+     * @param[out] stat optional array of statuses for each point.
+     * @return the number of points for which the conversion failed.
+     *
+     * The geohash for a failed conversion is set to the empty string.
+     **********************************************************************/
+    static size_t ForwardBatch(size_t n, const real lat[], const real lon[],
+                               int len, char geohash[], size_t stride,
+                               status stat[] = nullptr);
+
+    /**
+     * Convert arrays of geographic coordinates to integer geohashes.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes (degrees).
+     * @param[in] lon array of longitudes (degrees).
+     * @param[in] len the length of the geohashes.
+     * @param[out] geohash array of integer geohashes.
+     * @param[out] stat optional array of statuses for each point.
+     * @return the number of points for which the conversion failed.
+     *
+     * The integer geohash for a failed conversion is set to 0.
+     **********************************************************************/
+    static size_t ForwardBatch(size_t n, const real lat[], const real lon[],
+                               int len, unsigned long long geohash[],
+                               status stat[] = nullptr);
+
+    /**
+     * Convert geohashes in a character buffer to arrays of geographic
+     * coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] geohash buffer of \e n &times; \e stride characters; the
+     *   geohash for point \e i starts at \e geohash[\e i &times; \e
+     *   stride] and is terminated by a null or by the end of its \e stride
+     *   characters.
+     * @param[in] stride the space allotted to each geohash.
+     * @param[out] lat array of latitudes (degrees).
+     * @param[out] lon array of longitudes (degrees).
+     * @param[out] len array of geohash lengths.
+     * @param[in] centerp if true (the default) return the centers of the
+     *   geohash locations, otherwise return the south-west corners.
+     * @param[out] stat optional array of statuses for each point.
+     * @return the number of points for which the conversion failed.
+     *
+     * For a failed conversion and for an "invalid" geohash, \e lat and \e
+     * lon are set to NaN and \e len is set to &minus;1.
+     **********************************************************************/
+    static size_t ReverseBatch(size_t n, const char geohash[], size_t stride,
+                               real lat[], real lon[], int len[],
+                               bool centerp = true, status stat[] = nullptr);
+
+    /**
+     * Convert an array of integer geohashes to arrays of geographic
+     * coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] geohash array of integer geohashes.
+     * @param[in] len the length of the geohashes.
+     * @param[out] lat array of latitudes (degrees).
+     * @param[out] lon array of longitudes (degrees).
+     * @param[in] centerp if true (the default) return the centers of the
+     *   geohash locations, otherwise return the south-west corners.
+     **********************************************************************/
+    static void ReverseBatch(size_t n, const unsigned long long geohash[],
+                             int len, real lat[], real lon[],
+                             bool centerp = true);
+    ///@}
+
+    /** \name Adjacent cells
+     **********************************************************************/
+    ///@{
+    /**
+     * Find the integer geohash of a nearby cell of the same length.
+     *
+     * @param[in] geohash the integer geohash.
+     * @param[in] len the length of the geohash.
+     * @param[in] dlat the number of cells to move north (negative for south).
+     * @param[in] dlon the number of cells to move east (negative for west).
+     * @param[out] adj the integer geohash of the resulting cell.
+     * @return the status; BADLATITUDE is returned if the resulting cell lies
+     *   beyond a pole.
+     *
+     * Movement in longitude wraps around the antimeridian.  Typically, \e
+     * dlat and \e dlon are &minus;1, 0, or 1; for example, \e dlat = 1, \e
+     * dlon = 0 gives the cell to the north.
+     **********************************************************************/
+    static status Adjacent(unsigned long long geohash, int len,
+                           int dlat, int dlon, unsigned long long& adj);
+
+    /**
+     * Find the geohash of a nearby cell of the same length in a character
+     * buffer.
+     *
+     * @param[in] geohash the geohash (need not be null-terminated).
+     * @param[in] glen the number of characters in \e geohash.
+     * @param[in] dlat the number of cells to move north (negative for south).
+     * @param[in] dlon the number of cells to move east (negative for west).
+     * @param[out] adj buffer for the null-terminated geohash of the resulting
+     *   cell.
+     * @param[in] size the size of \e adj.
+     * @return the status; BADSTRING is returned if \e geohash contains
+     *   illegal characters or is "invalid", BADLATITUDE if the resulting
+     *   cell lies beyond a pole, and BUFFERTOOSMALL if \e size is too small.
+     *
+     * Only the first 18 characters of \e geohash are considered.  The result
+     * is in lower case.
+     **********************************************************************/
+    static status Adjacent(const char* geohash, size_t glen,
+                           int dlat, int dlon, char adj[], size_t size);
+
+    /**
+     * Find the integer geohashes of the neighbors of a cell.
+     *
+     * @param[in] geohash the integer geohash.
+     * @param[in] len the length of the geohash.
+     * @param[out] nbr the integer geohashes of the neighbors in the order N,
+     *   NE, E, SE, S, SW, W, NW.
+     * @return the number of neighbors.
+     *
+     * Neighbors lying beyond a pole are omitted (and the rest are moved up),
+     * so that 5 neighbors are returned for a cell touching a pole.  For \e
+     * len = 0, the E and W "neighbors" are the cell itself.  A query cell
+     * together with its neighbors covers all points within a cell width of
+     * the query cell; this is the usual way of carrying out proximity joins
+     * with geohashes.
+     **********************************************************************/
+    static int Neighbors(unsigned long long geohash, int len,
+                         unsigned long long nbr[8]);
+    ///@}
+
     /**
      * The latitude resolution of a geohash.
      *
@@ -0,0 +1,147 @@
+/**
+ * \file GeohashCover.hpp
+ * \brief Header for GeographicLib::GeohashCover class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEOHASHCOVER_HPP)
+#define GEOGRAPHICLIB_GEOHASHCOVER_HPP 1
+
+#include <vector>
+#include <GeographicLib/Geodesic.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Geohash cells covering geodesic circles and polygons
+   *
+   * This class finds the set of geohash cells of a given length which
+   * intersect a region bounded by a geodesic circle or by a geodesic
+   * polygon; this is the set of keys to look up in a geohash-indexed store to
+   * find all the points in the region.  The cells are returned as integer
+   * geohashes (see Geohash) in increasing order.
+   *
+   * The region is refined hierarchically starting with the cell of length 0
+   * (the whole earth).  At each level, the 32 children of each cell which
+   * straddles the boundary are classified as lying inside the region, lying
+   * outside the region, or straddling its boundary.  Only the last category
+   * is refined further; the descendants of a cell which lies inside the
+   * region form a contiguous range of integer geohashes at the final length.
+   * The classification is exact (apart from roundoff), so the result is the
+   * smallest set of cells of the given length which covers the region.
+   *
+   * For a circle, the shortest distance from the center to a cell is found
+   * by solving inverse geodesic problems to the corners of the cell and, if
+   * necessary, finding the closest point on one of its bounding meridians.
+   * For a polygon, the longitude varies monotonically along each edge, so
+   * the portion of an edge within the longitude range of a cell is found by
+   * solving for the points on the edge where the longitude matches the sides
+   * of the cell; the edge intersects the cell if the latitude range of this
+   * portion overlaps the cell.  Only the edges which intersect a cell need
+   * be considered for its children.  Cells not intersecting any edge are
+   * classified by PreparedPolygon::Contains applied to their centers.
+   *
+   * The cells at each level are distributed over a pool of threads.
+   *
+   * A GeohashCover object holds no state other than the ellipsoid and the
+   * number of threads; thus a single object may be used by several threads.
+   *
+   * Example of use:
+   * \code
+   * GeohashCover cover(Geodesic::WGS84(), 1);
+   * std::vector<unsigned long long> cells;
+   * // Cells of length 6 within 5 km of Times Square
+   * cover.Circle(40.758, -73.9855, 5000, 6, cells);
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT GeohashCover {
+  private:
+    typedef Math::real real;
+    // The longest integer geohash
+    static const int maxlen_ = 12;
+    Geodesic _earth;
+    unsigned _threads;
+  public:
+
+    /**
+     * Constructor for GeohashCover.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     * @param[in] threads the number of threads to use; if this is 0 (the
+     *   default), the number reported by std::thread::hardware_concurrency()
+     *   is used.
+     **********************************************************************/
+    GeohashCover(const Geodesic& earth, unsigned threads = 0);
+
+    /**
+     * The cells covering a geodesic circle.
+     *
+     * @param[in] lat latitude of the center (degrees).
+     * @param[in] lon longitude of the center (degrees).
+     * @param[in] radius the radius of the circle (meters).
+     * @param[in] len the length of the geohashes.
+     * @param[out] cells the integer geohashes of the cells which contain a
+     *   point within a distance \e radius of the center.
+     * @exception GeographicErr if \e lat is not in [&minus;90&deg;,
+     *   90&deg;].
+     * @exception std::bad_alloc if the memory for \e cells can't be
+     *   allocated.
+     *
+     * Internally, \e len is first put in the range [0, 12].  \e radius
+     * should be less than a quarter of the meridian.  If \e radius is
+     * negative or NaN, \e cells is empty.
+     **********************************************************************/
+    void Circle(real lat, real lon, real radius, int len,
+                std::vector<unsigned long long>& cells) const;
+
+    /**
+     * The cells covering a geodesic polygon.
+     *
+     * @param[in] n the number of vertices.
+     * @param[in] lat array of latitudes of the vertices (degrees).
+     * @param[in] lon array of longitudes of the vertices (degrees).
+     * @param[in] len the length of the geohashes.
+     * @param[out] cells the integer geohashes of the cells which intersect
+     *   the interior or an edge of the polygon.
+     * @exception std::bad_alloc if the memory for \e cells can't be
+     *   allocated.
+     *
+     * Internally, \e len is first put in the range [0, 12].  The polygon is
+     * interpreted as in PreparedPolygon; in particular, its interior is the
+     * smaller of the two regions bounded by the edges.  \e lat should be in
+     * the range [&minus;90&deg;, 90&deg;] and the edges should be shorter
+     * than half the circumference of the earth.  A polygon with fewer than 3
+     * vertices is covered by no cells.
+     **********************************************************************/
+    void Polygon(size_t n, const real lat[], const real lon[], int len,
+                 std::vector<unsigned long long>& cells) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of threads used.
+     **********************************************************************/
+    unsigned Threads() const { return _threads; }
+
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _earth.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _earth.Flattening(); }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_GEOHASHCOVER_HPP
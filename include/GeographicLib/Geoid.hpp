@@ -11,7 +11,13 @@
 #define GEOGRAPHICLIB_GEOID_HPP 1
 
 #include <vector>
+#include <list>
+#include <unordered_map>
 #include <fstream>
+#include <atomic>
+#include <mutex>
+#include <future>
+#include <memory>
 #include <GeographicLib/Constants.hpp>
 
 #if defined(_MSC_VER)
@@ -70,7 +76,37 @@ namespace GeographicLib {
    * threadsafe parameter to true in the constructor.  This causes the
    * constructor to read all the data into memory and to turn off the
    * single-cell caching which results in a Geoid object which \e is thread
-   * safe.
+   * safe.  On POSIX systems, you can instead set the optional \e mode
+   * parameter to Geoid::MEMORYMAP or Geoid::POSITIONAL.  With MEMORYMAP, the
+   * data file is mapped into memory and the heights are obtained directly
+   * from the mapped data; the startup is fast and processes using the same
+   * data file share a single copy of the data in the operating system's page
+   * cache.  With POSITIONAL, the data is read with positional reads (pread)
+   * which several threads may perform concurrently; this may be combined
+   * with a tile cache (see CacheTiles()).  In both cases the single-cell
+   * caching is turned off and the resulting object is thread safe.
+   *
+   * With cubic interpolation, the coefficients of the cubic fit for each
+   * cell are usually computed from 12 pixel values as needed.  Setting \e
+   * mode to Geoid::PRECOMPUTED instead memory maps a file, with suffix
+   * ".cub", of precomputed coefficients created by
+   * <code>examples/GeoidToCubic.cpp</code>.  This file is 20 (float coding)
+   * or 10 (int16 coding) times larger than the original data file for 16-bit
+   * PGM files and float coding adds a negligible error (about
+   * 10<sup>&minus;5</sup> m) to the interpolated heights.  The int16
+   * coding adds an error of a few times the quantization error of the
+   * original data (about 2 cm for a 16-bit PGM file with a scale of 3 mm);
+   * GeoidToCubic reports an estimate of this error.
+   *
+   * Setting \e mode to Geoid::TILED reads a compressed copy of the data,
+   * with suffix ".gtl", created by <code>examples/GeoidToTiles.cpp</code>.
+   * The data is divided into tiles of 64 &times; 64 pixels which are
+   * compressed separately (losslessly) and an index gives the position of
+   * each tile in the file.  The tiles are read with positional reads and
+   * decompressed into the tile cache (see CacheTiles()) as they are needed.
+   * The file is several times smaller than the PGM file (by how much
+   * depends on the roughness of the data) and the heights are identical to
+   * those obtained from the PGM file.
    *
    * Example of use:
    * \include example-Geoid.cpp
@@ -93,6 +129,16 @@ namespace GeographicLib {
 #endif
     static const unsigned stencilsize_ = 12;
     static const unsigned nterms_ = ((3 + 1) * (3 + 2))/2; // for a cubic fit
+    static const unsigned cellblock_ = 8; // cell cache for batch evaluation
+    // For batch evaluation without a cache, the number of points whose data
+    // is read together, the largest gap (in pixels) between pixels read
+    // with a single request, and the number of requests in flight at once
+    static const size_t gatherblock_ = 16384;
+    static const unsigned gathergap_ = 32;
+    static const unsigned gatherqueue_ = 16;
+    static const char* const cubmagic_; // first line of a .cub file
+    static const char* const tilemagic_; // first line of a .gtl file
+    static const unsigned tileescape_ = 24; // escape for Rice coding
     static const int c0_;
     static const int c0n_;
     static const int c0s_;
@@ -110,15 +156,53 @@ namespace GeographicLib {
     int _width, _height;
     unsigned long long _datastart, _swidth;
     bool _threadsafe;
-    // Area cache
-    mutable std::vector< std::vector<pixel_t> > _data;
+    // The memory mapped data file (or null) and its size
+    const unsigned char* _map;
+    unsigned long long _mapsize;
+    // The time taken by the constructor (seconds)
+    double _loadtime;
+    // The file descriptor for positional reads (or -1)
+    int _fd;
+    // For precomputed coefficients, the bytes per cell (otherwise 0) and
+    // the quanta for int16 coding
+    unsigned _cellsize;
+    real _quanta[nterms_];
+    // Area cache; the pixels are stored in a single buffer with row iy -
+    // _yoffset starting at index (iy - _yoffset) * _xstride.  The stride is
+    // _xsize rounded up to a multiple of rowalign_ pixels so that the rows
+    // start on cache line boundaries (relative to the start of the buffer).
+    static const int rowalign_ = 64 / pixel_size_;
+    mutable std::vector<pixel_t> _data;
     mutable bool _cache;
     // NE corner and extent of cache
-    mutable int _xoffset, _yoffset, _xsize, _ysize;
+    mutable int _xoffset, _yoffset, _xsize, _ysize, _xstride;
+    // Tile cache; the tiles are tilesize_ x tilesize_ pixels and are keyed
+    // on ty * _ntx + tx where tx = ix / tilesize_, ty = iy / tilesize_.
+    static const int tilesize_ = 64;
+    struct tile {
+      int key;
+      std::vector<pixel_t> data;
+    };
+    mutable std::list<tile> _tiles; // most recently used first
+    mutable std::unordered_map<int, std::list<tile>::iterator> _tileindex;
+    mutable std::atomic<size_t> _maxtiles; // 0 means no tile cache
+    // Guards the tile cache for positional reads
+    mutable std::mutex _tilelock;
+    int _ntx;
+    // For a tiled file, the file offsets of the compressed tiles (indexed by
+    // key) followed by the file size (otherwise empty)
+    std::vector<unsigned long long> _tileoffset;
+    // Along-track prefetching; the key of the last tile visited (or -1)
+    mutable std::atomic<bool> _prefetch;
+    mutable std::atomic<int> _lasttile;
+    // Statistics (if _stats); _nmisses counts the data values which had to
+    // be read from the file and the read time is in nanoseconds
+    mutable std::atomic<bool> _stats;
+    mutable std::atomic<unsigned long long>
+      _nqueries, _nfits, _nmisses, _nreads, _nbytes, _nreadtime;
     // Cell cache
     mutable int _ix, _iy;
-    mutable real _v00, _v01, _v10, _v11;
-    mutable real _t[nterms_];
+    mutable real _t[nterms_];   // 4 values (bilinear) or 10 coefficients
     void filepos(int ix, int iy) const {
       _file.seekg(std::streamoff
                   (_datastart +
@@ -129,44 +213,88 @@ namespace GeographicLib {
         ix += _width;
       else if (ix >= _width)
         ix -= _width;
-      if (_cache && iy >= _yoffset && iy < _yoffset + _ysize &&
+      if (_map) {
+        if (iy < 0 || iy >= _height) {
+          iy = iy < 0 ? -iy : 2 * (_height - 1) - iy;
+          ix += (ix < _width/2 ? 1 : -1) * _width/2;
+        }
+        // The data is stored big-endian
+        const unsigned char* p = _map + _datastart +
+          pixel_size_ * (unsigned(iy)*_swidth + unsigned(ix));
+        unsigned r = (unsigned(p[0]) << 8) | unsigned(p[1]);
+        if (pixel_size_ == 4)
+          r = (r << 16) | (unsigned(p[2]) << 8) | unsigned(p[3]);
+        return real(r);
+      } else if (_cache && iy >= _yoffset && iy < _yoffset + _ysize &&
           ((ix >= _xoffset && ix < _xoffset + _xsize) ||
            (ix + _width >= _xoffset && ix + _width < _xoffset + _xsize))) {
-        return real(_data[iy - _yoffset]
-                    [ix >= _xoffset ? ix - _xoffset : ix + _width - _xoffset]);
+        return real(_data[size_t(iy - _yoffset) * _xstride +
+                          (ix >= _xoffset ? ix - _xoffset :
+                           ix + _width - _xoffset)]);
       } else {
         if (iy < 0 || iy >= _height) {
           iy = iy < 0 ? -iy : 2 * (_height - 1) - iy;
           ix += (ix < _width/2 ? 1 : -1) * _width/2;
         }
-        try {
-          filepos(ix, iy);
-          // initial values to suppress warnings in case get fails
-          char a = 0, b = 0;
-          _file.get(a);
-          _file.get(b);
-          unsigned r = ((unsigned char)(a) << 8) | (unsigned char)(b);
-          if (pixel_size_ == 4) {
-            _file.get(a);
-            _file.get(b);
-            r = (r << 16) | ((unsigned char)(a) << 8) | (unsigned char)(b);
-          }
-          return real(r);
-        }
-        catch (const std::exception& e) {
-          // throw GeographicErr("Error reading " + _filename + ": "
-          //                      + e.what());
-          // triggers complaints about the "binary '+'" under Visual Studio.
-          // So use '+=' instead.
-          std::string err("Error reading ");
-          err += _filename;
-          err += ": ";
-          err += e.what();
-          throw GeographicErr(err);
-        }
+        if (_maxtiles)
+          return tileval(ix, iy);
+        if (_fd >= 0)
+          return preadval(ix, iy);
+        return streamval(ix, iy);
       }
     }
+    real streamval(int ix, int iy) const;
+    real tileval(int ix, int iy) const;
+    void prefetch(int ix, int iy) const;
+    void advise(int tx, int ty) const;
+    real preadval(int ix, int iy) const;
+    void readpixels(int ix, int iy, pixel_t* data, int n) const;
+    void preadbytes(unsigned long long pos, unsigned char* buf, size_t len)
+      const;
+    void readtile(int tx, int ty, pixel_t* data) const;
+    // Decompress the len bytes at buf into an nx x ny block of pixels with
+    // row stride tilesize_
+    static void decodetile(const unsigned char* buf, size_t len,
+                           int nx, int ny, pixel_t* data);
+    // Nanoseconds from an arbitrary origin
+    static unsigned long long clockns();
+    // Record a read of bytes starting at time start
+    void countread(unsigned long long bytes, unsigned long long start) const;
+    // Find the cell containing (lat, lon) and the fractional position within
+    // the cell; return false if lat or lon is a NaN.
+    bool cellindex(real lat, real lon, int& ix, int& iy,
+                   real& fx, real& fy) const;
+    // Set t to the corner values (bilinear) or the coefficients of the
+    // cubic fit (cubic) for cell (ix, iy).
+    void cellfit(int ix, int iy, real t[]) const;
+    // Set t from the stencil values v for cell (ix, iy); v holds the pixels
+    // at the offsets given by stencil (4 for bilinear, stencilsize_ for
+    // cubic).
+    void stencilfit(const real v[], int iy, real t[]) const;
+    // The cubic fit to the stencil values v using the transfer matrix c3x
+    // with common denominator c0x.
+    static void cubicfit(const real v[], const int c3x[], int c0x, real t[]);
+    static const int* stencil(bool cubic);
+    // The index of pixel (ix, iy) in the data, wrapping ix and reflecting
+    // iy at the poles as in rawval.
+    unsigned long long pixelindex(int ix, int iy) const;
+    // Read the pixels with sorted distinct indices pix[0..n) into val; this
+    // coalesces nearby pixels into single requests and, for positional
+    // reads, issues gatherqueue_ requests concurrently.
+    void gatherpixels(size_t n, const unsigned long long pix[], real val[])
+      const;
+    // The batch evaluation when the data is only available from the file
+    // (no memory map or cache).
+    void gatherheights(size_t n, const real lat[], const real lon[],
+                       real h[]) const;
+    // Evaluate the fit t at the fractional position (fx, fy) in the cell.
+    static real evalfit(bool cubic, const real t[], real fx, real fy);
+    real interpolate(const real t[], real fx, real fy) const;
     real height(real lat, real lon) const;
+    void MapFile();
+    void OpenFile();
+    // GeoidRaster uses the stencil and fits
+    friend class GeoidRaster;
     Geoid(const Geoid&) = delete;            // copy constructor not allowed
     Geoid& operator=(const Geoid&) = delete; // copy assignment not allowed
   public:
@@ -192,6 +320,35 @@ namespace GeographicLib {
       GEOIDTOELLIPSOID = 1,
     };
 
+    /**
+     * How the data file is accessed.
+     **********************************************************************/
+    enum datamode {
+      /**
+       * Read the data file with a std::ifstream.
+       **********************************************************************/
+      STREAM = 0,
+      /**
+       * Memory map the data file (POSIX systems only).
+       **********************************************************************/
+      MEMORYMAP = 1,
+      /**
+       * Read the data file with positional reads (POSIX systems only).
+       **********************************************************************/
+      POSITIONAL = 2,
+      /**
+       * Memory map a file of precomputed cubic coefficients (POSIX systems
+       * only).
+       **********************************************************************/
+      PRECOMPUTED = 3,
+      /**
+       * Read a tiled and compressed data file with positional reads,
+       * decompressing the tiles into the tile cache as needed (POSIX systems
+       * only).
+       **********************************************************************/
+      TILED = 4,
+    };
+
     /** \name Setting up the geoid
      **********************************************************************/
     ///@{
@@ -204,20 +361,84 @@ namespace GeographicLib {
      *   true (the default) means cubic.
      * @param[in] threadsafe (optional), if true, construct a thread safe
      *   object.  The default is false
+     * @param[in] mode (optional) how the data file is accessed, one of
+     *   Geoid::STREAM (the default), Geoid::MEMORYMAP, Geoid::POSITIONAL,
+     *   Geoid::PRECOMPUTED, or Geoid::TILED; the last four result in a
+     *   thread safe object.
      * @exception GeographicErr if the data file cannot be found, is
      *   unreadable, or is corrupt.
      * @exception GeographicErr if \e threadsafe is true but the memory
      *   necessary for caching the data can't be allocated.
+     * @exception GeographicErr if \e mode is Geoid::MEMORYMAP,
+     *   Geoid::POSITIONAL, Geoid::PRECOMPUTED, or Geoid::TILED but the data
+     *   file can't be mapped or opened, or this mode isn't supported on this
+     *   system.
+     * @exception GeographicErr if \e mode is Geoid::PRECOMPUTED and \e
+     *   cubic is false.
      *
      * The data file is formed by appending ".pgm" to the name.  If \e path is
      * specified (and is non-empty), then the file is loaded from directory, \e
      * path.  Otherwise the path is given by DefaultGeoidPath().  If the \e
      * threadsafe parameter is true, the data set is read into memory, the data
      * file is closed, and single-cell caching is turned off; this results in a
-     * Geoid object which \e is thread safe.
+     * Geoid object which \e is thread safe.  If \e mode is Geoid::MEMORYMAP,
+     * the data file is instead mapped into memory with mmap (\e threadsafe
+     * is then ignored).  Only the parts of the data set which are accessed
+     * are read from the file and the memory is shared with other processes
+     * mapping the same file.  If \e mode is Geoid::POSITIONAL, the data is
+     * read as needed with pread (\e threadsafe is then ignored); several
+     * threads can read concurrently and a tile cache may be set up with
+     * CacheTiles().  If \e mode is Geoid::PRECOMPUTED, the data file is
+     * formed by appending ".cub" to the name and it is memory mapped.  If \e
+     * mode is Geoid::TILED, the data file is formed by appending ".gtl" to
+     * the name; its index is read and the tiles are read with pread and
+     * decompressed as needed into a tile cache of 16 MB (which may be
+     * changed with CacheTiles()).  These four modes result in a Geoid object
+     * which \e is thread safe.  With these modes, if the data file has been
+     * loaded into a shared memory segment with SharedData::Load, the
+     * segment is used instead of the file.
      **********************************************************************/
     explicit Geoid(const std::string& name, const std::string& path = "",
-                   bool cubic = true, bool threadsafe = false);
+                   bool cubic = true, bool threadsafe = false,
+                   datamode mode = STREAM);
+
+    /**
+     * Construct a geoid in the background.
+     *
+     * @param[in] name the name of the geoid.
+     * @param[in] path (optional) directory for data file.
+     * @param[in] cubic (optional) interpolation method; false means bilinear,
+     *   true (the default) means cubic.
+     * @param[in] threadsafe (optional), if true, construct a thread safe
+     *   object.  The default is false
+     * @param[in] mode (optional) how the data file is accessed.
+     * @return a future holding the Geoid.
+     *
+     * The arguments are the same as for the constructor, which is run on a
+     * new thread.  Calling \e get() on the returned future waits for the
+     * data to be loaded and rethrows any exception thrown by the
+     * constructor.  Several geoids and models (see GravityModel::Load and
+     * MagneticModel::Load) may be loaded concurrently in this way, e.g.,
+     * \code
+     * auto geoid = Geoid::Load("egm2008-1");
+     * auto grav = GravityModel::Load("egm2008");
+     * auto mag = MagneticModel::Load("wmm2020");
+     * // ... other initialization ...
+     * std::shared_ptr<Geoid> g = geoid.get();  // wait for the geoid
+     * \endcode
+     *
+     * If \e threadsafe is false and \e mode is Geoid::STREAM, the resulting
+     * object isn't thread safe; it may be handed to another thread, but only
+     * one thread may use it at a time.
+     **********************************************************************/
+    static std::future<std::shared_ptr<Geoid>>
+    Load(const std::string& name, const std::string& path = "",
+         bool cubic = true, bool threadsafe = false, datamode mode = STREAM);
+
+    /**
+     * The destructor unmaps or closes the data file if necessary.
+     **********************************************************************/
+    ~Geoid();
 
     /**
      * Set up a cache.
@@ -258,9 +479,109 @@ namespace GeographicLib {
     void CacheAll() const { CacheArea(real(-90), real(0),
                                       real(90), real(360)); }
 
+    /**
+     * Set up a cache of tiles of the data.
+     *
+     * @param[in] maxbytes the maximum memory (in bytes) to use for the tiles;
+     *   0 turns off the tile cache (except with \e mode = Geoid::TILED, in
+     *   which case a single tile is cached).
+     * @exception GeographicErr if this is called on a threadsafe Geoid
+     *   which was not constructed with \e mode = Geoid::POSITIONAL or
+     *   Geoid::TILED.
+     *
+     * With this cache, the data is read in tiles of 64 &times; 64 pixels as
+     * it's needed.  When the memory used by the tiles exceeds \e maxbytes,
+     * the least recently used tile is discarded.  This gives nearly the
+     * speed of CacheAll() when successive points are close to one another
+     * while bounding the memory used.  At least one tile is always cached.
+     * Points in an area set with CacheArea() are obtained from the area
+     * cache; the tile cache is used for other points.  With \e mode =
+     * Geoid::POSITIONAL or Geoid::TILED, the tile cache is shared by all the
+     * threads using the Geoid (and access to it is serialized with a mutex).
+     **********************************************************************/
+    void CacheTiles(unsigned long long maxbytes) const;
+
+    /**
+     * Turn along-track prefetching on or off.
+     *
+     * @param[in] enable if true, turn on prefetching.
+     * @exception GeographicErr if \e enable is true and the Geoid was not
+     *   constructed with \e mode = Geoid::MEMORYMAP, Geoid::POSITIONAL,
+     *   Geoid::PRECOMPUTED, or Geoid::TILED.
+     *
+     * This is intended for evaluating the geoid height along a track (e.g.,
+     * the trajectory of a vehicle).  The data is regarded as divided into
+     * tiles of 64 &times; 64 pixels and, when the track moves from one tile
+     * to the next, the operating system is advised (with madvise for a
+     * memory mapped file or posix_fadvise for positional reads) to start
+     * reading the next tile in the direction of travel.  This hides the
+     * latency of reading the data from disk at tile boundaries.  The values
+     * returned are not affected.  If several threads share the Geoid, the
+     * predictions will be less accurate but still harmless.
+     **********************************************************************/
+    void Prefetch(bool enable) const;
+    ///@}
+
+    /** \name Statistics
+     **********************************************************************/
+    ///@{
+    /**
+     * Turn the collection of statistics on or off.
+     *
+     * @param[in] enable if true, collect statistics.
+     *
+     * Statistics are not collected by default because, if a thread safe
+     * Geoid is shared by several threads, updating the counters for each
+     * point slows down the calculations.  Turning the collection on or off
+     * doesn't reset the counters.
+     **********************************************************************/
+    void CollectStatistics(bool enable) const { _stats = enable; }
+
+    /**
+     * The accumulated statistics since the Geoid was constructed or since the
+     * last call to ResetStatistics().
+     *
+     * @param[out] queries the number of points at which the geoid height has
+     *   been computed.
+     * @param[out] fits the number of times the data for a cell had to be
+     *   obtained (i.e., the query missed the single-cell cache and the cell
+     *   cache for the batch computation).
+     * @param[out] hits the number of data values obtained from memory (the
+     *   area cache, the tile cache, or the memory mapped file) for these
+     *   cells.
+     * @param[out] reads the number of read operations on the data file
+     *   (including those for filling the area and tile caches but not those
+     *   resulting from page faults on a memory mapped file).
+     * @param[out] bytes the number of bytes read from the data file.
+     * @param[out] readtime the time spent in read operations on the data
+     *   file (seconds).
+     *
+     * The number of data values needed for a fit is 12 for cubic
+     * interpolation, 4 for bilinear interpolation, and 1 for precomputed
+     * coefficients; \e hits is this number times \e fits minus the number of
+     * data values read from the file.
+     **********************************************************************/
+    void Statistics(unsigned long long& queries, unsigned long long& fits,
+                    unsigned long long& hits, unsigned long long& reads,
+                    unsigned long long& bytes, double& readtime) const {
+      queries = _nqueries; fits = _nfits;
+      hits = fits * (_cellsize ? 1 : (_cubic ? stencilsize_ : 4)) - _nmisses;
+      reads = _nreads; bytes = _nbytes; readtime = _nreadtime / 1.0e9;
+    }
+
+    /**
+     * Reset the counters for the accumulated statistics.
+     **********************************************************************/
+    void ResetStatistics() const {
+      _nqueries = _nfits = _nmisses = _nreads = _nbytes = _nreadtime = 0;
+    }
+
     /**
      * Clear the cache.  This never throws an error.  (This does nothing with a
-     * thread safe Geoid.)
+     * thread safe Geoid.)  Both the area cache and the tile cache are
+     * cleared.  (With \e mode = Geoid::POSITIONAL, the tile cache is cleared
+     * and turned off; with \e mode = Geoid::TILED, it is cleared but its
+     * size is unchanged.)
      **********************************************************************/
     void CacheClear() const;
 
@@ -285,6 +606,78 @@ namespace GeographicLib {
       return height(lat, lon);
     }
 
+    /**
+     * Compute the geoid height at several points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes of the points (degrees).
+     * @param[in] lon array of longitudes of the points (degrees).
+     * @param[out] h array of heights of the geoid above the ellipsoid
+     *   (meters).
+     * @exception GeographicErr if there's a problem reading the data; this
+     *   never happens if the points lie within the cached area.
+     *
+     * The results are the same as calling the single point version \e n
+     * times.  However the stencils and (with cubic interpolation) the fits
+     * for the 64 most recently visited cells are retained (the cells in any
+     * 8 &times; 8 block of cells are always retained together), so that the
+     * data for each cell is typically read and fitted only once.  This
+     * greatly reduces the cost for large spatially coherent sets of points,
+     * such as point clouds or trajectories, where many points fall into the
+     * same few cells even if consecutive points don't.  If the data isn't
+     * memory mapped or cached (in an area or tile cache), so that each value
+     * would be read from the file, the cells for up to 16384 points are
+     * found first and all the values needed for them are read at once in
+     * file order, combining nearby values into a single read.  With
+     * Geoid::POSITIONAL, several of these reads are issued concurrently,
+     * which hides much of the latency of the storage (e.g., a network file
+     * system).  Unlike the single
+     * point version, this function doesn't change the single-cell cache and
+     * so it is thread safe under the same conditions as the rest of the
+     * class.
+     * The arrays \e lat and \e lon may be the same as \e h; in this case,
+     * the input is overwritten.
+     **********************************************************************/
+    void operator()(size_t n, const real lat[], const real lon[],
+                    real h[]) const;
+
+    /**
+     * Compute the geoid height on a grid.
+     *
+     * @param[in] lat0 the latitude of the first row of the grid (degrees).
+     * @param[in] dlat the latitude spacing of the rows (degrees).
+     * @param[in] nlat the number of rows.
+     * @param[in] lon0 the longitude of the first column of the grid
+     *   (degrees).
+     * @param[in] dlon the longitude spacing of the columns (degrees).
+     * @param[in] nlon the number of columns.
+     * @param[out] h the raster of heights of the geoid above the ellipsoid
+     *   (meters); the height at latitude \e lat0 + \e i \e dlat and
+     *   longitude \e lon0 + \e j \e dlon is stored in h[\e i \e nlon + \e
+     *   j].  h must have room for \e nlat \e nlon elements.
+     * @param[in] threads the number of threads to use; if this is 0 (the
+     *   default), the number reported by std::thread::hardware_concurrency()
+     *   is used.  This is ignored (and the calculation is done in the calling
+     *   thread) unless the Geoid is thread safe.
+     * @exception GeographicErr if there's a problem reading the data; this
+     *   never happens if the grid lies within the cached area.
+     * @exception std::bad_alloc if the memory for the cell indices of the
+     *   rows and columns can't be allocated.
+     *
+     * This is intended for resampling the geoid onto the pixel grid of some
+     * other data set, e.g., a digital elevation model.  The results are the
+     * same as calling the single point version for each point of the grid.
+     * However, the rows of the grid are grouped into bands lying in the same
+     * row of cells of the geoid data and the columns are grouped into runs
+     * lying in the same column of cells; the fit for each cell is computed
+     * once and used for all the grid points in it.  The bands are handed out
+     * to the threads in turn.  This function doesn't change the single-cell
+     * cache.
+     **********************************************************************/
+    void HeightGrid(real lat0, real dlat, int nlat,
+                    real lon0, real dlon, int nlon, real h[],
+                    unsigned threads = 0) const;
+
     /**
      * Convert a height above the geoid to a height above the ellipsoid and
      * vice versa.
@@ -383,11 +776,61 @@ namespace GeographicLib {
      **********************************************************************/
     bool ThreadSafe() const { return _threadsafe; }
 
+    /**
+     * @return true if the data file is memory mapped.
+     **********************************************************************/
+    bool MemoryMapped() const { return _map != nullptr; }
+
     /**
      * @return true if a data cache is active.
      **********************************************************************/
     bool Cache() const { return _cache; }
 
+    /**
+     * @return true if a tile cache is active.
+     **********************************************************************/
+    bool TileCache() const { return _maxtiles != 0; }
+
+    /**
+     * @return true if along-track prefetching is turned on.
+     **********************************************************************/
+    bool Prefetching() const { return _prefetch; }
+
+    /**
+     * @return the number of tiles currently in the tile cache.
+     **********************************************************************/
+    size_t TileCacheCount() const {
+      std::lock_guard<std::mutex> lock(_tilelock);
+      return _tiles.size();
+    }
+
+    /**
+     * @return an estimate of the number of bytes of heap memory used by the
+     *   Geoid object (this excludes sizeof(Geoid)).
+     *
+     * This is the memory held by the area cache (see CacheArea() and
+     * CacheAll()), the tile cache (see CacheTiles()), and, for tiled files,
+     * the index of the tiles.  The memory mapped data file (see
+     * MemoryMapped()) isn't included because it is held in the operating
+     * system's page cache.
+     **********************************************************************/
+    size_t MemoryUsage() const;
+
+    /**
+     * @return the time taken by the constructor (seconds).
+     *
+     * This includes reading the header of the data file and, if the Geoid
+     * was constructed with \e threadsafe = true, reading the whole of the
+     * data into the cache.  The data read later by CacheArea(), etc., isn't
+     * included; see Statistics() for that.
+     **********************************************************************/
+    double LoadTime() const { return _loadtime; }
+
+    /**
+     * @return true if statistics are being collected.
+     **********************************************************************/
+    bool CollectingStatistics() const { return _stats; }
+
     /**
      * @return west edge of the cached area; the cache includes this edge.
      **********************************************************************/
@@ -0,0 +1,266 @@
+/**
+ * \file GeoidRaster.hpp
+ * \brief Header for GeographicLib::GeoidRaster class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GEOIDRASTER_HPP)
+#define GEOGRAPHICLIB_GEOIDRASTER_HPP 1
+
+#include <string>
+#include <vector>
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Geoid.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs vector
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief Geoid heights from a grid of float32 values
+   *
+   * Interpolate the geoid height from a grid of single precision floating
+   * point values.  Two formats are supported:
+   * - The GTX format used by NOAA's VDatum and by PROJ.  This consists of
+   *   a 40-byte header giving the latitude and longitude of the south-west
+   *   corner, the latitude and longitude spacing (all as doubles), and the
+   *   number of rows and columns (as 32-bit integers) followed by the
+   *   heights by rows from south to north.  The file is big-endian (but
+   *   little-endian files are also recognized).  A height of &minus;88.8888
+   *   marks a missing value.
+   * - A raw file of float32 values with no header.  The layout of the grid
+   *   is specified to the constructor.  The files written by the GeoidGrid
+   *   example program with the "float" format have the layout of the pgm
+   *   files used by Geoid.
+   *
+   * These grids may be regional (e.g., GEOID18) and, unlike the pgm files
+   * used by Geoid, the heights are stored directly, so they don't need to
+   * be converted or quantized.  The file is memory mapped (on systems other
+   * than Windows, where it is read into memory); the pages of the file are
+   * only read as they are needed.  Because the object is not modified by
+   * lookups, a single object can be used by several threads.
+   *
+   * The interpolation uses the same bilinear or cubic method as Geoid.  The
+   * cubic fit uses a 12-point stencil; where the stencil extends beyond the
+   * edge of the grid or includes a missing value, the bilinear interpolant
+   * is used instead.  The result is a NaN if the point lies outside the
+   * grid or if one of the corners of its cell is missing.  If the columns
+   * of the grid span 360&deg;, the grid wraps around in longitude.  A grid
+   * which includes a pole is treated like any other edge, so the cubic
+   * interpolation reverts to bilinear in the cells adjacent to the pole.
+   *
+   * Example of use:
+   * \code
+   * GeoidRaster g("us_noaa_g2018u0.gtx");
+   * real N = g(40, -100);
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT GeoidRaster {
+  private:
+    typedef Math::real real;
+    static const unsigned gtxheader_ = 40;
+    static const unsigned nterms_ = Geoid::nterms_;
+    static const unsigned stencilsize_ = Geoid::stencilsize_;
+    static const unsigned cellblock_ = Geoid::cellblock_;
+
+    std::string _filename;
+    bool _cubic;
+    real _lat0, _lon0, _dlat, _dlon;
+    int _nrows, _ncols;
+    // The number of columns in 360 degrees if the grid wraps around in
+    // longitude (otherwise 0)
+    int _period;
+    // Whether the bytes of the values need to be swapped
+    bool _swap;
+    // The memory mapped file (or null) and its size and the start of the
+    // data
+    const unsigned char* _map;
+    unsigned long long _mapsize;
+    const unsigned char* _pixels;
+    // The file contents if it can't be memory mapped
+    std::vector<unsigned char> _buffer;
+    void Init(unsigned long long datastart);
+    real pixel(int ix, int iy) const;
+    // Find the cell containing (lat, lon) and the fractional position within
+    // the cell; return false if the point lies outside the grid.
+    bool cellindex(real lat, real lon, int& ix, int& iy,
+                   real& fx, real& fy) const;
+    // Set t to the fit for cell (ix, iy) and return whether it's cubic;
+    // the fit is a NaN if a corner of the cell is missing.
+    bool cellfit(int ix, int iy, real t[]) const;
+    real height(real lat, real lon) const;
+    GeoidRaster(const GeoidRaster&) = delete; // copy constructor not allowed
+    GeoidRaster& operator=(const GeoidRaster&) = delete; // nor copy assignment
+  public:
+
+    /** \name Setting up the geoid
+     **********************************************************************/
+    ///@{
+    /**
+     * Construct a geoid from a GTX file.
+     *
+     * @param[in] filename the name of the file.
+     * @param[in] cubic (default true) interpolation method; false means
+     *   bilinear, true means cubic.
+     * @exception GeographicErr if the file cannot be found, cannot be
+     *   mapped, or is not a valid GTX file.
+     **********************************************************************/
+    explicit GeoidRaster(const std::string& filename, bool cubic = true);
+
+    /**
+     * Construct a geoid from a raw file of float32 values.
+     *
+     * @param[in] filename the name of the file.
+     * @param[in] lat0 the latitude of the first row (degrees).
+     * @param[in] lon0 the longitude of the first column (degrees).
+     * @param[in] dlat the latitude spacing of the rows (degrees); this is
+     *   negative if the rows run from north to south.
+     * @param[in] dlon the longitude spacing of the columns (degrees).
+     * @param[in] nrows the number of rows.
+     * @param[in] ncols the number of columns.
+     * @param[in] bigendian (default true) whether the values are stored
+     *   big-endian.
+     * @param[in] cubic (default true) interpolation method; false means
+     *   bilinear, true means cubic.
+     * @exception GeographicErr if the parameters are invalid or if the file
+     *   cannot be found, cannot be mapped, or has the wrong length.
+     *
+     * The file consists of \e nrows rows of \e ncols values.  The value
+     * for row \e i and column \e j is at latitude \e lat0 + \e i \e dlat and
+     * longitude \e lon0 + \e j \e dlon.  \e dlon must be positive.  For
+     * example, the file written by <code>GeoidGrid egm2008 file 4
+     * float</code> is read with
+     * \code
+     * GeoidRaster g("file", 90, 0, -0.25, 0.25, 721, 1440);
+     * \endcode
+     **********************************************************************/
+    GeoidRaster(const std::string& filename,
+                real lat0, real lon0, real dlat, real dlon,
+                int nrows, int ncols, bool bigendian = true,
+                bool cubic = true);
+
+    /**
+     * The destructor unmaps the file.
+     **********************************************************************/
+    ~GeoidRaster();
+    ///@}
+
+    /** \name Compute geoid heights
+     **********************************************************************/
+    ///@{
+    /**
+     * Compute the geoid height at a point
+     *
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] lon longitude of the point (degrees).
+     * @return the height of the geoid above the ellipsoid (meters).
+     *
+     * The result is a NaN if the point lies outside the grid or if the grid
+     * is missing data there.
+     **********************************************************************/
+    Math::real operator()(real lat, real lon) const {
+      return height(lat, lon);
+    }
+
+    /**
+     * Compute the geoid heights at several points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes of the points (degrees).
+     * @param[in] lon array of longitudes of the points (degrees).
+     * @param[out] h array of heights of the geoid above the ellipsoid
+     *   (meters).
+     *
+     * This gives the same results as calling operator()(\e lat, \e lon) for
+     * each point.  The fits for the recently visited cells are cached so
+     * that points which are close to one another are evaluated efficiently.
+     **********************************************************************/
+    void operator()(size_t n, const real lat[], const real lon[], real h[])
+      const;
+
+    /**
+     * Convert a height above the geoid to height above the ellipsoid and
+     * vice versa.
+     *
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] lon longitude of the point (degrees).
+     * @param[in] h height of the point (degrees).
+     * @param[in] d a Geoid::convertflag specifying the direction of the
+     *   conversion; Geoid::GEOIDTOELLIPSOID means convert a height above
+     *   the geoid to a height above the ellipsoid; Geoid::ELLIPSOIDTOGEOID
+     *   means convert a height above the ellipsoid to a height above the
+     *   geoid.
+     * @return converted height (meters).
+     **********************************************************************/
+    Math::real ConvertHeight(real lat, real lon, real h,
+                             Geoid::convertflag d) const {
+      return h + real(d) * height(lat, lon);
+    }
+    ///@}
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the full file name used to load the geoid data.
+     **********************************************************************/
+    const std::string& GeoidFile() const { return _filename; }
+
+    /**
+     * @return interpolation method ("cubic" or "bilinear").
+     **********************************************************************/
+    const std::string Interpolation() const
+    { return std::string(_cubic ? "cubic" : "bilinear"); }
+
+    /**
+     * @return the latitude of the first row (degrees).
+     **********************************************************************/
+    Math::real Latitude0() const { return _lat0; }
+
+    /**
+     * @return the longitude of the first column (degrees).
+     **********************************************************************/
+    Math::real Longitude0() const { return _lon0; }
+
+    /**
+     * @return the latitude spacing of the rows (degrees).
+     **********************************************************************/
+    Math::real LatitudeSpacing() const { return _dlat; }
+
+    /**
+     * @return the longitude spacing of the columns (degrees).
+     **********************************************************************/
+    Math::real LongitudeSpacing() const { return _dlon; }
+
+    /**
+     * @return the number of rows.
+     **********************************************************************/
+    int Rows() const { return _nrows; }
+
+    /**
+     * @return the number of columns.
+     **********************************************************************/
+    int Columns() const { return _ncols; }
+
+    /**
+     * @return whether the grid wraps around in longitude.
+     **********************************************************************/
+    bool Global() const { return _period > 0; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_GEOIDRASTER_HPP
@@ -114,6 +114,9 @@ namespace GeographicLib {
     // iterations, the convergence in the Reverse falls back to improvements in
     // each step by a constant (albeit small) factor.
     static const int numit_ = 20;
+    static const size_t projblock_ = 64;
+    void IntReverse(real lat0, real lon0, real azi0, real rho,
+                    real& lat, real& lon, real& azi, real& rk) const;
   public:
 
     /**
@@ -192,6 +195,60 @@ namespace GeographicLib {
       Reverse(lat0, lon0, x, y, lat, lon, azi, rk);
     }
 
+    /** \name Batch projections
+     **********************************************************************/
+    ///@{
+    /**
+     * Forward projection of arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat0 latitude of center point of projection (degrees).
+     * @param[in] lon0 longitude of center point of projection (degrees).
+     * @param[in] lat array of latitudes (degrees).
+     * @param[in] lon array of longitudes (degrees).
+     * @param[out] x array of eastings (meters).
+     * @param[out] y array of northings (meters).
+     * @param[out] azi if non-null, an array of the azimuths of the geodesics
+     *   through the points (degrees).
+     * @param[out] rk if non-null, an array of the reciprocals of the
+     *   azimuthal scales.
+     *
+     * The geodesics from the center are computed with a GeodesicOrigin, so
+     * that the quantities depending on the center are only computed once.
+     * The results are the same as calling Forward for each point.  The output
+     * arrays may coincide with the input arrays.
+     **********************************************************************/
+    void ForwardBatch(size_t n, real lat0, real lon0,
+                      const real lat[], const real lon[],
+                      real x[], real y[],
+                      real azi[] = nullptr, real rk[] = nullptr) const;
+
+    /**
+     * Reverse projection of arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat0 latitude of center point of projection (degrees).
+     * @param[in] lon0 longitude of center point of projection (degrees).
+     * @param[in] x array of eastings (meters).
+     * @param[in] y array of northings (meters).
+     * @param[out] lat array of latitudes (degrees).
+     * @param[out] lon array of longitudes (degrees).
+     * @param[out] azi if non-null, an array of the azimuths of the geodesics
+     *   through the points (degrees).
+     * @param[out] rk if non-null, an array of the reciprocals of the
+     *   azimuthal scales.
+     *
+     * The azimuths from the center are computed with Math::atan2dBatch; each
+     * point then requires its own geodesic line so that the saving is
+     * modest.  The results are the same as calling Reverse for each point.
+     * The output arrays may coincide with the input arrays.
+     **********************************************************************/
+    void ReverseBatch(size_t n, real lat0, real lon0,
+                      const real x[], const real y[],
+                      real lat[], real lon[],
+                      real azi[] = nullptr, real rk[] = nullptr) const;
+    ///@}
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
@@ -57,16 +57,15 @@ namespace GeographicLib {
       _corrmult, _gamma0, _gamma, _frot;
     CircularEngine _gravitational, _disturbing, _correction;
 
-    GravityCircle(mask caps, real a, real f, real lat, real h,
-                  real Z, real P, real cphi, real sphi,
-                  real amodel, real GMmodel,
-                  real dzonal0, real corrmult,
-                  real gamma0, real gamma, real frot,
-                  const CircularEngine& gravitational,
-                  const CircularEngine& disturbing,
-                  const CircularEngine& correction);
-
-    friend class GravityModel; // GravityModel calls the private constructor
+    // Set the parameters of the circle; the CircularEngine objects are
+    // filled in by GravityModel::Circle.
+    void Reset(mask caps, real a, real f, real lat, real h,
+               real Z, real P, real cphi, real sphi,
+               real amodel, real GMmodel,
+               real dzonal0, real corrmult,
+               real gamma0, real gamma, real frot);
+
+    friend class GravityModel; // GravityModel calls Reset
     Math::real W(real slam, real clam,
                  real& gX, real& gY, real& gZ) const;
     Math::real V(real slam, real clam,
@@ -74,6 +73,8 @@ namespace GeographicLib {
     Math::real InternalT(real slam, real clam,
                          real& deltaX, real& deltaY, real& deltaZ,
                          bool gradp, bool correct) const;
+    // The number of longitudes handled together by the vector routines.
+    static const int blk_ = 64;
   public:
     /**
      * A default constructor for the normal gravity.  This sets up an
@@ -149,6 +150,73 @@ namespace GeographicLib {
     void SphericalAnomaly(real lon, real& Dg01, real& xi, real& eta)
       const;
 
+    /**
+     * Evaluate the geoid height at many longitudes.
+     *
+     * @param[in] n the number of longitudes.
+     * @param[in] lon array of geographic longitudes (degrees).
+     * @param[out] N array of the heights of the geoid above the reference
+     *   ellipsoid (meters).
+     *
+     * This gives the same results as GeoidHeight(real) const, but the sums
+     * for a block of longitudes are computed together with
+     * CircularEngine::Evaluate which is several times faster.
+     **********************************************************************/
+    void GeoidHeight(size_t n, const real lon[], real N[]) const;
+
+    /**
+     * Evaluate the components of the spherical gravity anomaly vector at many
+     * longitudes.
+     *
+     * @param[in] n the number of longitudes.
+     * @param[in] lon array of geographic longitudes (degrees).
+     * @param[out] Dg01 array of gravity anomalies (m s<sup>&minus;2</sup>).
+     * @param[out] xi if non-null, array of the northerly components of the
+     *   deflection of the vertical (degrees).
+     * @param[out] eta if non-null, array of the easterly components of the
+     *   deflection of the vertical (degrees).
+     *
+     * This gives the same results as SphericalAnomaly(real, real&, real&,
+     * real&) const; see GeoidHeight(size_t, const real[], real[]) const.
+     **********************************************************************/
+    void SphericalAnomaly(size_t n, const real lon[], real Dg01[],
+                          real xi[] = nullptr, real eta[] = nullptr) const;
+
+    /**
+     * Evaluate the geoid height at equally spaced longitudes.
+     *
+     * @param[in] lon0 the first longitude (degrees).
+     * @param[in] dlon the longitude spacing (degrees).
+     * @param[in] n the number of longitudes.
+     * @param[out] N array of the heights of the geoid above the reference
+     *   ellipsoid (meters) at longitudes \e lon0 + \e i \e dlon.
+     *
+     * This gives the same results as GeoidHeight(size_t, const real[],
+     * real[]) const, except for roundoff.  The sums are computed with
+     * CircularEngine::EvaluateGrid; so if \e dlon divides 360&deg;, they
+     * may be evaluated with an FFT.
+     **********************************************************************/
+    void GeoidHeightGrid(real lon0, real dlon, size_t n, real N[]) const;
+
+    /**
+     * Evaluate the components of the spherical gravity anomaly vector at
+     * equally spaced longitudes.
+     *
+     * @param[in] lon0 the first longitude (degrees).
+     * @param[in] dlon the longitude spacing (degrees).
+     * @param[in] n the number of longitudes.
+     * @param[out] Dg01 array of gravity anomalies (m s<sup>&minus;2</sup>).
+     * @param[out] xi if non-null, array of the northerly components of the
+     *   deflection of the vertical (degrees).
+     * @param[out] eta if non-null, array of the easterly components of the
+     *   deflection of the vertical (degrees).
+     *
+     * See GeoidHeightGrid().
+     **********************************************************************/
+    void SphericalAnomalyGrid(real lon0, real dlon, size_t n, real Dg01[],
+                              real xi[] = nullptr, real eta[] = nullptr)
+      const;
+
     /**
      * Evaluate the components of the acceleration due to gravity and the
      * centrifugal acceleration in geocentric coordinates.
@@ -274,6 +342,15 @@ namespace GeographicLib {
       return (_caps & testcaps) == testcaps;
     }
 
+    /**
+     * @return the number of bytes of heap memory used by the object (this
+     *   excludes sizeof(GravityCircle)).
+     **********************************************************************/
+    size_t MemoryUsage() const {
+      return _gravitational.MemoryUsage() + _disturbing.MemoryUsage() +
+        _correction.MemoryUsage();
+    }
+
     /**
      * \deprecated An old name for EquatorialRadius().
      **********************************************************************/
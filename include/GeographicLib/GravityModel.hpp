@@ -14,6 +14,11 @@
 #include <GeographicLib/NormalGravity.hpp>
 #include <GeographicLib/SphericalHarmonic.hpp>
 #include <GeographicLib/SphericalHarmonic1.hpp>
+#include <GeographicLib/CircleCache.hpp>
+#include <atomic>
+#include <mutex>
+#include <future>
+#include <memory>
 
 #if defined(_MSC_VER)
 // Squelch warnings about dll vs vector
@@ -90,18 +95,57 @@ namespace GeographicLib {
     int _nmx, _mmx;
     SphericalHarmonic::normalization _norm;
     NormalGravity _earth;
-    std::vector<real> _Cx, _Sx, _CC, _CS, _zonal;
+    // The storage for the coefficients; this is filled in by the constructor
+    // and is then shared (without modification) by copies and truncated
+    // views of the model.
+    struct coeffstore {
+      std::vector<real> Cx, Sx, CC, CS;
+      SphericalEngine::mappedfile map; // Used instead of Cx, etc., if mapped
+      std::vector<float> Cxf, Sxf;     // Used instead of Cx, Sx, if single
+    };
+    std::shared_ptr<const coeffstore> _store;
+    std::vector<real> _zonal;
     real _dzonal0;              // A left over contribution to _zonal.
+    unsigned long long _loadbytes;
+    double _loadtime;
     SphericalHarmonic _gravitational;
     SphericalHarmonic1 _disturbing;
     SphericalHarmonic _correction;
+    // The degree variances of the disturbing potential are only needed for
+    // estimating truncation errors, so they are computed on first use.
+    // degvarlazy guards this computation; a copy of a GravityModel object
+    // recomputes the variances when needed.
+    struct degvarlazy {
+      std::atomic<bool> init;
+      std::mutex lock;
+      degvarlazy() : init(false) {}
+      degvarlazy(const degvarlazy&) : init(false) {}
+      degvarlazy& operator=(const degvarlazy&) { init = false; return *this; }
+    };
+    mutable degvarlazy _degvarlazy;
+    mutable std::vector<real> _degvar;
+    // The circles used by the point queries if SetCircleCache was called
+    mutable CircleCache<GravityCircle> _circles;
+    std::shared_ptr<const GravityCircle> CachedCircle(real lat, real h,
+                                                      unsigned caps) const;
     void ReadMetadata(const std::string& name);
+    // Set _nmx, _mmx, and the disturbing potential given _gravitational and
+    // _correction.
+    void SetDisturbing();
+    const std::vector<real>& DegreeVariances() const;
     Math::real InternalT(real X, real Y, real Z,
                          real& deltaX, real& deltaY, real& deltaZ,
                          bool gradp, bool correct) const;
-    GravityModel(const GravityModel&) = delete; // copy constructor not allowed
-    // nor copy assignment
-    GravityModel& operator=(const GravityModel&) = delete;
+    // Evaluate at n points using a GravityCircle with the given caps for the
+    // points which share a latitude and height (h = NULL means zero height);
+    // point(i) and circle(c, i) evaluate point i directly and with circle c.
+    template<class F, class C>
+    void GenBatch(size_t n, const real lat[], const real h[], unsigned caps,
+                  F point, C circle) const;
+    // Call row(i) for i in [0, nlat) using the given number of threads.
+    template<class F>
+    static void GenGrid(int nlat, F row, unsigned threads);
+    GravityModel& operator=(const GravityModel&) = delete; // no assignment
 
     enum captype {
       CAP_NONE   = 0U,
@@ -171,6 +215,10 @@ namespace GeographicLib {
      *   model this value.
      * @param[in] Mmax (optional) if non-negative, truncate the order of the
      *   model this value.
+     * @param[in] mapped (optional) if true, map the coefficient file into
+     *   memory instead of reading it (default false).
+     * @param[in] single (optional) if true, store the coefficients of the
+     *   model as floats (default false).
      * @exception GeographicErr if the data file cannot be found, is
      *   unreadable, or is corrupt, or if \e Mmax > \e Nmax.
      * @exception std::bad_alloc if the memory necessary for storing the model
@@ -189,10 +237,95 @@ namespace GeographicLib {
      * If \e Nmax &ge; 0 and \e Mmax < 0, then \e Mmax is set to \e Nmax.
      * After the model is loaded, the maximum degree and order of the model can
      * be found by the Degree() and Order() methods.
+     *
+     * If \e mapped is true and SphericalEngine::mappedfile::Supported(), the
+     * coefficient file is mapped into memory (copy on write) and the sums use
+     * the coefficients in place.  Construction is then nearly instantaneous,
+     * even for EGM2008, the coefficients are read from disk only as they are
+     * used, and several processes using the same model share the memory.
+     * Truncating the model doesn't reduce the memory mapped.  If mapping
+     * isn't supported, the file is read as usual; Mapped() reports which
+     * method was used.  If the coefficient file has been loaded into a
+     * shared memory segment with SharedData::Load, the segment is mapped
+     * instead of the file.
+     *
+     * If \e single is true (and the file isn't mapped), the coefficients of
+     * the gravitational potential are stored as floats after being read.
+     * This halves the memory needed (for EGM2008, from 37 MB to 18 MB) and
+     * reduces the memory traffic in evaluating the sums; the sums are still
+     * accumulated with type Math::real.  The relative error in each
+     * coefficient is then at most 6 &times; 10<sup>&minus;8</sup>.  The
+     * largest contribution to the resulting error comes from the degree 2
+     * zonal term, which leads to errors in the geoid height of about
+     * 0.2 mm; the errors from the higher degree terms, which are much
+     * smaller, are uncorrelated and contribute less than 0.01 mm.  These
+     * errors are well below the accuracy of the models themselves (and
+     * comparable to the errors in interpolating the geoid with the Geoid
+     * class).  The coefficients of the correction model (used for
+     * GeoidHeight) are always stored with type Math::real.
      **********************************************************************/
     explicit GravityModel(const std::string& name,
                           const std::string& path = "",
-                          int Nmax = -1, int Mmax = -1);
+                          int Nmax = -1, int Mmax = -1, bool mapped = false,
+                          bool single = false);
+
+    /**
+     * Construct a gravity model in the background.
+     *
+     * @param[in] name the name of the model.
+     * @param[in] path (optional) directory for data file.
+     * @param[in] Nmax (optional) if non-negative, truncate the degree of the
+     *   model this value.
+     * @param[in] Mmax (optional) if non-negative, truncate the order of the
+     *   model this value.
+     * @param[in] mapped (optional) if true, use the coefficients in place in
+     *   a memory-mapped file.
+     * @param[in] single (optional) if true, store the coefficients as
+     *   floats.
+     * @return a future holding the GravityModel.
+     *
+     * The arguments are the same as for the constructor, which is run on a
+     * new thread.  Calling \e get() on the returned future waits for the
+     * model to be loaded and rethrows any exception thrown by the
+     * constructor.  See Geoid::Load for an example.
+     **********************************************************************/
+    static std::future<std::shared_ptr<GravityModel>>
+    Load(const std::string& name, const std::string& path = "",
+         int Nmax = -1, int Mmax = -1, bool mapped = false,
+         bool single = false);
+
+    /**
+     * Construct a truncated view of a gravity model.
+     *
+     * @param[in] g the gravity model.
+     * @param[in] Nmax if non-negative, truncate the degree of the model this
+     *   value.
+     * @param[in] Mmax (optional) if non-negative, truncate the order of the
+     *   model this value.
+     * @exception GeographicErr if \e Nmax and \e Mmax are inconsistent.
+     *
+     * The new object shares the coefficients of \e g (which may be
+     * destroyed first), so no files are read and little memory is used.
+     * The result is the same as constructing the model from its files with
+     * \e Nmax and \e Mmax (except that truncating \e g can't increase the
+     * degree or order).  LoadBytes(), LoadTime(), Mapped(), and Single()
+     * report the values for the model whose coefficients are shared.  The
+     * circle cache (see SetCircleCache) isn't copied.
+     *
+     * This is a cheap way to obtain models of several degrees from a single
+     * load, or to give each thread its own model object.
+     **********************************************************************/
+    GravityModel(const GravityModel& g, int Nmax, int Mmax = -1);
+
+    /**
+     * The copy constructor.
+     *
+     * @param[in] g the gravity model.
+     *
+     * This is equivalent to GravityModel(\e g, -1, -1); the copy shares the
+     * coefficients of \e g.
+     **********************************************************************/
+    GravityModel(const GravityModel& g) : GravityModel(g, -1, -1) {}
     ///@}
 
     /** \name Compute gravity in geodetic coordinates
@@ -239,6 +372,50 @@ namespace GeographicLib {
                            real& deltax, real& deltay, real& deltaz)
       const;
 
+    /**
+     * Evaluate the gravity and the gravity gradient tensor at an arbitrary
+     * point above (or below) the ellipsoid.
+     *
+     * @param[in] lat the geographic latitude (degrees).
+     * @param[in] lon the geographic longitude (degrees).
+     * @param[in] h the height above the ellipsoid (meters).
+     * @param[out] gx the easterly component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gy the northerly component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gz the upward component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] Wxx the \e xx component of the gravity gradient
+     *   (s<sup>&minus;2</sup>).
+     * @param[out] Wxy the \e xy component of the gravity gradient
+     *   (s<sup>&minus;2</sup>).
+     * @param[out] Wxz the \e xz component of the gravity gradient
+     *   (s<sup>&minus;2</sup>).
+     * @param[out] Wyy the \e yy component of the gravity gradient
+     *   (s<sup>&minus;2</sup>).
+     * @param[out] Wyz the \e yz component of the gravity gradient
+     *   (s<sup>&minus;2</sup>).
+     * @param[out] Wzz the \e zz component of the gravity gradient
+     *   (s<sup>&minus;2</sup>).
+     * @return \e W the sum of the gravitational and centrifugal potentials
+     *   (m<sup>2</sup> s<sup>&minus;2</sup>).
+     *
+     * The gravity gradient is the Hessian of \e W, i.e., the tensor of
+     * second derivatives of \e W, in the local cartesian frame (\e x east,
+     * \e y north, \e z up); the tensor is symmetric, so only 6 components
+     * are returned.  The gravity is the same as that returned by Gravity().
+     * The effects of the earth's rotation are included; so the trace of the
+     * tensor is 2&omega;<sup>2</sup> instead of 0.  Multiply the results by
+     * 10<sup>9</sup> to convert to E&ouml;tv&ouml;s units.  All the
+     * quantities are obtained with a single pass through the coefficients,
+     * see SphericalEngine::Hessian.  This is much more efficient (and more
+     * accurate) than differencing the results of Gravity().
+     **********************************************************************/
+    Math::real GravityGradient(real lat, real lon, real h,
+                               real& gx, real& gy, real& gz,
+                               real& Wxx, real& Wxy, real& Wxz,
+                               real& Wyy, real& Wyz, real& Wzz) const;
+
     /**
      * Evaluate the geoid height.
      *
@@ -273,6 +450,182 @@ namespace GeographicLib {
      **********************************************************************/
     void SphericalAnomaly(real lat, real lon, real h,
                           real& Dg01, real& xi, real& eta) const;
+
+    /**
+     * Evaluate the deflection of the vertical.
+     *
+     * @param[in] lat the geographic latitude (degrees).
+     * @param[in] lon the geographic longitude (degrees).
+     * @param[in] h the height above the ellipsoid (meters).
+     * @param[out] xi the northerly component of the deflection of the vertical
+     *  (degrees).
+     * @param[out] eta the easterly component of the deflection of the vertical
+     *  (degrees).
+     *
+     * This returns the same \e xi and \e eta as SphericalAnomaly(), except
+     * for roundoff.  Only the horizontal components of the gradient of the
+     * disturbing potential are needed, so the radial derivative is omitted
+     * from the spherical harmonic sum (see SphericalEngine::Horizontal) and
+     * this is cheaper than SphericalAnomaly().  With \e h = 0, &minus;\e xi
+     * and &minus;\e eta (converted to radians) are the northerly and
+     * easterly slopes of the geoid in the spherical approximation.
+     **********************************************************************/
+    void Deflection(real lat, real lon, real h, real& xi, real& eta) const;
+    ///@}
+
+    /** \name Compute gravity at many points
+     **********************************************************************/
+    ///@{
+    /**
+     * Evaluate the gravity at arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of geographic latitudes (degrees).
+     * @param[in] lon array of geographic longitudes (degrees).
+     * @param[in] h array of heights above the ellipsoid (meters).
+     * @param[out] gx array of easterly components of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gy array of northerly components of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gz array of upward components of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] W if non-null, array of the sums of the gravitational and
+     *   centrifugal potentials (m<sup>2</sup> s<sup>&minus;2</sup>).
+     *
+     * This returns the same results as Gravity(), except for roundoff.  The
+     * points which lie on a common circle (the same \e lat and \e h) are
+     * evaluated with a GravityCircle.  This costs about as much as a single
+     * call to Gravity() to set up, and then each point on the circle is much
+     * cheaper.  So batches of points on a regular grid, or repeatedly
+     * sampling the same parallels, run much faster.  Scattered points are
+     * evaluated individually.
+     **********************************************************************/
+    void GravityBatch(size_t n, const real lat[], const real lon[],
+                      const real h[], real gx[], real gy[], real gz[],
+                      real W[] = nullptr) const;
+
+    /**
+     * Evaluate the gravity disturbance vector at arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of geographic latitudes (degrees).
+     * @param[in] lon array of geographic longitudes (degrees).
+     * @param[in] h array of heights above the ellipsoid (meters).
+     * @param[out] deltax array of easterly components of the disturbance
+     *   vector (m s<sup>&minus;2</sup>).
+     * @param[out] deltay array of northerly components of the disturbance
+     *   vector (m s<sup>&minus;2</sup>).
+     * @param[out] deltaz array of upward components of the disturbance vector
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] T if non-null, array of the disturbing potentials
+     *   (m<sup>2</sup> s<sup>&minus;2</sup>).
+     *
+     * See GravityBatch() for the treatment of points on a common circle.
+     **********************************************************************/
+    void DisturbanceBatch(size_t n, const real lat[], const real lon[],
+                          const real h[],
+                          real deltax[], real deltay[], real deltaz[],
+                          real T[] = nullptr) const;
+
+    /**
+     * Evaluate the geoid height at arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of geographic latitudes (degrees).
+     * @param[in] lon array of geographic longitudes (degrees).
+     * @param[out] N array of the heights of the geoid above the
+     *   ReferenceEllipsoid() (meters).
+     *
+     * See GravityBatch() for the treatment of points on a common circle (here
+     * the points with the same \e lat).
+     **********************************************************************/
+    void GeoidHeightBatch(size_t n, const real lat[], const real lon[],
+                          real N[]) const;
+
+    /**
+     * Evaluate the deflection of the vertical at arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of geographic latitudes (degrees).
+     * @param[in] lon array of geographic longitudes (degrees).
+     * @param[in] h array of heights above the ellipsoid (meters).
+     * @param[out] xi array of northerly components of the deflection of the
+     *   vertical (degrees).
+     * @param[out] eta array of easterly components of the deflection of the
+     *   vertical (degrees).
+     *
+     * Scattered points are evaluated with Deflection().  See GravityBatch()
+     * for the treatment of points on a common circle; these are evaluated
+     * with a GravityCircle constructed with GravityModel::SPHERICAL_ANOMALY.
+     * For a regular grid, SphericalAnomalyGrid() is faster still.
+     **********************************************************************/
+    void DeflectionBatch(size_t n, const real lat[], const real lon[],
+                         const real h[], real xi[], real eta[]) const;
+
+    /**
+     * Evaluate the geoid height on a grid.
+     *
+     * @param[in] lat0 the latitude of the first row of the grid (degrees).
+     * @param[in] dlat the latitude spacing of the rows (degrees).
+     * @param[in] nlat the number of rows.
+     * @param[in] lon0 the longitude of the first column of the grid
+     *   (degrees).
+     * @param[in] dlon the longitude spacing of the columns (degrees).
+     * @param[in] nlon the number of columns.
+     * @param[out] N the raster of geoid heights (meters); the height at
+     *   latitude \e lat0 + \e i \e dlat and longitude \e lon0 + \e j \e
+     *   dlon is stored in N[\e i \e nlon + \e j].  N must have room for \e
+     *   nlat \e nlon elements.
+     * @param[in] threads the number of threads to use; if this is 0 (the
+     *   default), the number reported by std::thread::hardware_concurrency()
+     *   is used.
+     * @exception std::bad_alloc if the memory for the GravityCircle objects
+     *   can't be allocated.
+     *
+     * A GravityCircle is constructed for each row and the rows are handed out
+     * to the threads in turn.  The results are the same as calling
+     * GeoidHeight() for each point, except for roundoff.  Typically several
+     * threads share the GravityModel and there's no need to partition the
+     * grid.  If \e dlon divides 360&deg; (as it does for global grids), the
+     * sums for each row are evaluated with an FFT over longitude (see
+     * CircularEngine::EvaluateGrid); for high degree models this greatly
+     * reduces the time spent on each row.
+     **********************************************************************/
+    void GeoidHeightGrid(real lat0, real dlat, int nlat,
+                         real lon0, real dlon, int nlon, real N[],
+                         unsigned threads = 0) const;
+
+    /**
+     * Evaluate the components of the spherical gravity anomaly on a grid.
+     *
+     * @param[in] h the height above the ellipsoid of the grid (meters).
+     * @param[in] lat0 the latitude of the first row of the grid (degrees).
+     * @param[in] dlat the latitude spacing of the rows (degrees).
+     * @param[in] nlat the number of rows.
+     * @param[in] lon0 the longitude of the first column of the grid
+     *   (degrees).
+     * @param[in] dlon the longitude spacing of the columns (degrees).
+     * @param[in] nlon the number of columns.
+     * @param[out] Dg01 the raster of gravity anomalies (m s<sup>&minus;2</sup>)
+     *   stored with the same layout as in GeoidHeightGrid().
+     * @param[out] xi if non-null, the raster of northerly components of the
+     *   deflection of the vertical (degrees).
+     * @param[out] eta if non-null, the raster of easterly components of the
+     *   deflection of the vertical (degrees).
+     * @param[in] threads the number of threads to use; if this is 0 (the
+     *   default), the number reported by std::thread::hardware_concurrency()
+     *   is used.
+     * @exception std::bad_alloc if the memory for the GravityCircle objects
+     *   can't be allocated.
+     *
+     * See SphericalAnomaly() for the definition of the anomaly and
+     * GeoidHeightGrid() for the treatment of the grid.
+     **********************************************************************/
+    void SphericalAnomalyGrid(real h, real lat0, real dlat, int nlat,
+                              real lon0, real dlon, int nlon,
+                              real Dg01[], real xi[] = nullptr,
+                              real eta[] = nullptr,
+                              unsigned threads = 0) const;
     ///@}
 
     /** \name Compute gravity in geocentric coordinates
@@ -299,6 +652,78 @@ namespace GeographicLib {
     Math::real W(real X, real Y, real Z,
                  real& gX, real& gY, real& gZ) const;
 
+    /**
+     * Evaluate \e W, the acceleration, and the gravity gradient in geocentric
+     * coordinates.
+     *
+     * @param[in] X geocentric coordinate of point (meters).
+     * @param[in] Y geocentric coordinate of point (meters).
+     * @param[in] Z geocentric coordinate of point (meters).
+     * @param[out] gX the \e X component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gY the \e Y component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gZ the \e Z component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] WXX the \e XX component of the gravity gradient
+     *   (s<sup>&minus;2</sup>).
+     * @param[out] WXY the \e XY component of the gravity gradient
+     *   (s<sup>&minus;2</sup>).
+     * @param[out] WXZ the \e XZ component of the gravity gradient
+     *   (s<sup>&minus;2</sup>).
+     * @param[out] WYY the \e YY component of the gravity gradient
+     *   (s<sup>&minus;2</sup>).
+     * @param[out] WYZ the \e YZ component of the gravity gradient
+     *   (s<sup>&minus;2</sup>).
+     * @param[out] WZZ the \e ZZ component of the gravity gradient
+     *   (s<sup>&minus;2</sup>).
+     * @return \e W = \e V + &Phi; the sum of the gravitational and
+     *   centrifugal potentials (m<sup>2</sup> s<sup>&minus;2</sup>).
+     *
+     * This is the geocentric counterpart of GravityGradient(); the gradient
+     * tensor is the Hessian of \e W with respect to \e X, \e Y, and \e Z.
+     **********************************************************************/
+    Math::real W(real X, real Y, real Z,
+                 real& gX, real& gY, real& gZ,
+                 real& WXX, real& WXY, real& WXZ,
+                 real& WYY, real& WYZ, real& WZZ) const;
+
+    /**
+     * Evaluate \e W and the acceleration at several points on a radial line.
+     *
+     * @param[in] X geocentric coordinate of a point on the line (meters).
+     * @param[in] Y geocentric coordinate of a point on the line (meters).
+     * @param[in] Z geocentric coordinate of a point on the line (meters).
+     * @param[in] n the number of points.
+     * @param[in] r array of the geocentric radii of the points (meters).
+     * @param[out] W array of \e W = \e V + &Phi; (m<sup>2</sup>
+     *   s<sup>&minus;2</sup>).
+     * @param[out] gX if non-null, array of the \e X components of the
+     *   acceleration (m s<sup>&minus;2</sup>).
+     * @param[out] gY if non-null, array of the \e Y components of the
+     *   acceleration (m s<sup>&minus;2</sup>).
+     * @param[out] gZ if non-null, array of the \e Z components of the
+     *   acceleration (m s<sup>&minus;2</sup>).
+     * @exception std::bad_alloc if the memory for the RadialEngine can't be
+     *   allocated.
+     *
+     * The points lie on the ray from the center of the earth through (\e X,
+     * \e Y, \e Z) at radii <i>r</i><sub><i>i</i></sub>; the results are the
+     * same as W(\e X, \e Y, \e Z, \e gX, \e gY, \e gZ) at each point.  The
+     * sums over order, which depend only on the direction of the ray, are
+     * done once (see SphericalHarmonic::Radial); each point then costs only
+     * about \e N operations.  This is the way to compute a vertical profile
+     * of the field.  Note that points with the same geodetic latitude and
+     * longitude, but different heights, lie on a radial line only at the
+     * equator and the poles; use Geocentric::Forward to find (\e X, \e Y, \e
+     * Z) and \e r for the point of interest at the middle of the profile.
+     * The acceleration is computed only if \e gX, \e gY, and \e gZ are all
+     * non-null.
+     **********************************************************************/
+    void WColumn(real X, real Y, real Z, size_t n, const real r[], real W[],
+                 real gX[] = nullptr, real gY[] = nullptr,
+                 real gZ[] = nullptr) const;
+
     /**
      * Evaluate the components of the acceleration due to gravity in geocentric
      * coordinates.
@@ -405,6 +830,8 @@ namespace GeographicLib {
      * @param[in] h the height of the point above the ellipsoid (meters).
      * @param[in] caps bitor'ed combination of GravityModel::mask values
      *   specifying the capabilities of the resulting GravityCircle object.
+     * @param[in] threads the number of threads to use in evaluating the sums
+     *   over degree (default 1).
      * @exception std::bad_alloc if the memory necessary for creating a
      *   GravityCircle can't be allocated.
      * @return a GravityCircle object whose member functions computes the
@@ -427,8 +854,185 @@ namespace GeographicLib {
      * functions will be substantially faster, especially for high-degree
      * models.  See \ref gravityparallel for an example of using GravityCircle
      * (together with OpenMP) to speed up the computation of geoid heights.
+     * Setting \e threads greater than 1 splits the sums for the different
+     * orders among several threads; this reduces the time to construct the
+     * circle for a high-degree model, such as EGM2008, when it's needed for
+     * only a few points.
+     *
+     * If \e Nmax &ge; 0, the sums are truncated to degree \e Nmax and order
+     * \e Mmax (which is set to \e Nmax if \e Mmax < 0).  This allows a
+     * lower-degree version of the model to be used without reloading it; the
+     * cost of constructing the circle is proportional to
+     * <i>Nmax</i><sup>2</sup>.  Use GravityDegree() or GeoidHeightDegree() to
+     * pick the smallest \e Nmax which meets an accuracy requirement.  The
+     * normal potential is not truncated; however the zonal terms of the model
+     * beyond \e Nmax which cancel the normal potential are dropped.  Thus if
+     * \e Nmax is less than about 20, Gravity() and V() include errors due to
+     * the truncation of the normal field.
+     **********************************************************************/
+    GravityCircle Circle(real lat, real h, unsigned caps = ALL,
+                         unsigned threads = 1,
+                         int Nmax = -1, int Mmax = -1) const;
+
+    /**
+     * Reinitialize a GravityCircle object in place.
+     *
+     * @param[out] circ the GravityCircle object.
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] h the height of the point above the ellipsoid (meters).
+     * @param[in] caps bitor'ed combination of GravityModel::mask values
+     *   specifying the capabilities of the resulting GravityCircle object.
+     * @param[in] threads (optional) the number of threads to use in
+     *   constructing the circle (default 1).
+     * @param[in] Nmax (optional) if non-negative, truncate the sums to this
+     *   degree (default -1).
+     * @param[in] Mmax (optional) if non-negative, truncate the sums to this
+     *   order (default -1, i.e., \e Mmax = \e Nmax).
+     * @exception std::bad_alloc if the memory necessary for creating a
+     *   GravityCircle can't be allocated.
+     *
+     * This gives the same result as \e circ = Circle(\e lat, \e h, \e caps,
+     * \e threads, \e Nmax, \e Mmax); however the storage already held by \e
+     * circ is reused.  Thus, if the gravity field is needed on many circles
+     * of latitude in turn, reusing a single GravityCircle in this way avoids
+     * allocating memory for each circle.
+     **********************************************************************/
+    void Circle(GravityCircle& circ, real lat, real h, unsigned caps = ALL,
+                unsigned threads = 1, int Nmax = -1, int Mmax = -1) const;
+
+    /**
+     * Let the point queries reuse the circles of latitude.
+     *
+     * @param[in] capacity the maximum number of GravityCircle objects to
+     *   hold; 0 (the initial state) turns off the cache.
+     * @param[in] latquantum (optional) if positive, the latitude is rounded
+     *   to multiples of this value (degrees); default 0.
+     * @param[in] hquantum (optional) if positive, the height is rounded to
+     *   multiples of this value (meters); default 0.
+     * @exception GeographicErr if \e latquantum or \e hquantum is negative
+     *   or not finite.
+     *
+     * With the cache turned on, Gravity(), Disturbance(), GeoidHeight(), and
+     * SphericalAnomaly() (with geodetic coordinates) evaluate the field with
+     * a GravityCircle for the latitude and height of the point (and the
+     * capabilities needed by the function).  The circle is constructed with
+     * Circle() on the first visit to a parallel and thereafter each point
+     * on it costs only about \e N operations, instead of about
+     * <i>N</i><sup>2</sup>.  This speeds up scattered queries which return
+     * to the same parallels, e.g., by vehicles following repeated tracks.
+     * If the quanta are positive, the results are those for the rounded
+     * latitude and height; this allows points which are close to one
+     * another to share a circle.  The least recently used circles are
+     * dropped when the capacity is exceeded.  For a model of degree \e N,
+     * each circle occupies about 8(<i>N</i> + 1) doubles per capability.
+     * See CircleCache for more details.
+     *
+     * The cache is thread safe; however this function is not and must not
+     * be called while other threads are using the GravityModel.
+     **********************************************************************/
+    void SetCircleCache(size_t capacity,
+                        real latquantum = 0, real hquantum = 0)
+    { _circles.Reset(capacity, latquantum, hquantum); }
+
+    /**
+     * @return the number of GravityCircle objects in the cache.
+     **********************************************************************/
+    size_t CircleCacheSize() const { return _circles.Size(); }
+
+    /**
+     * @return the number of point queries satisfied with a cached circle.
      **********************************************************************/
-    GravityCircle Circle(real lat, real h, unsigned caps = ALL) const;
+    unsigned long long CircleCacheHits() const { return _circles.Hits(); }
+
+    /**
+     * @return the number of point queries which required a circle to be
+     *   constructed.
+     **********************************************************************/
+    unsigned long long CircleCacheMisses() const { return _circles.Misses(); }
+    ///@}
+
+    /** \name Estimating the error from truncating the model
+     **********************************************************************/
+    ///@{
+    /**
+     * The degree variance of the disturbing potential.
+     *
+     * @param[in] n the degree.
+     * @return &sigma;<sub><i>n</i></sub><sup>2</sup> = &sum;<sub><i>m</i></sub>
+     *   (<i>C</i><sub><i>nm</i></sub><sup>2</sup> +
+     *   <i>S</i><sub><i>nm</i></sub><sup>2</sup>), where the coefficients are
+     *   those of the disturbing potential, fully normalized and made
+     *   dimensionless by the factor \e GM / \e a (returns 0 if \e n < 1 or
+     *   \e n > Degree()).
+     *
+     * The RMS value of the degree \e n component of \e T on the sphere
+     * <i>r</i> = \e a is (\e GM / \e a) &sigma;<sub><i>n</i></sub>.  The
+     * variances are computed on the first call to this function (or to the
+     * other functions in this section); this requires a pass through the
+     * coefficients of the model.
+     **********************************************************************/
+    Math::real DegreeVariance(int n) const;
+
+    /**
+     * The error in the geoid height from truncating the model.
+     *
+     * @param[in] Nmax the degree of the truncated model.
+     * @return the RMS difference (meters) between the geoid heights given by
+     *   the full model and the model truncated to degree \e Nmax.
+     *
+     * This estimate uses Bruns' formula with a spherical approximation,
+     * &delta;<i>N</i><sup>2</sup> = <i>a</i><sup>2</sup>
+     * &sum;<sub><i>n</i>&gt;<i>Nmax</i></sub>
+     * &sigma;<sub><i>n</i></sub><sup>2</sup>.  It includes only the
+     * contributions from the degrees present in the model, so it doesn't
+     * account for the omission error of the full model itself.
+     **********************************************************************/
+    Math::real GeoidHeightTruncationError(int Nmax) const;
+
+    /**
+     * The error in the gravity disturbance from truncating the model.
+     *
+     * @param[in] Nmax the degree of the truncated model.
+     * @param[in] h (optional) the height above the sphere <i>r</i> = \e a
+     *   (meters), default 0.
+     * @return the RMS difference (m s<sup>&minus;2</sup>) between the radial
+     *   components of the gravity disturbance given by the full model and the
+     *   model truncated to degree \e Nmax.
+     *
+     * This uses the spherical approximation &delta;<i>g</i><sup>2</sup> =
+     * (<i>GM</i>/<i>r</i><sup>2</sup>)<sup>2</sup>
+     * &sum;<sub><i>n</i>&gt;<i>Nmax</i></sub>
+     * (<i>n</i>+1)<sup>2</sup> (<i>a</i>/<i>r</i>)<sup>2<i>n</i></sup>
+     * &sigma;<sub><i>n</i></sub><sup>2</sup>, where \e r = \e a + \e h.  The
+     * errors in the gravity anomaly and the horizontal components are
+     * similar.
+     **********************************************************************/
+    Math::real GravityTruncationError(int Nmax, real h = 0) const;
+
+    /**
+     * The degree needed to compute the geoid height to a given accuracy.
+     *
+     * @param[in] tol the required accuracy (meters).
+     * @return the smallest \e Nmax for which GeoidHeightTruncationError(\e
+     *   Nmax) &le; \e tol.
+     **********************************************************************/
+    int GeoidHeightDegree(real tol) const;
+
+    /**
+     * The degree needed to compute the gravity disturbance to a given
+     * accuracy.
+     *
+     * @param[in] tol the required accuracy (m s<sup>&minus;2</sup>); note that
+     *   1 mGal = 10<sup>&minus;5</sup> m s<sup>&minus;2</sup>.
+     * @param[in] h (optional) the height above the sphere <i>r</i> = \e a
+     *   (meters), default 0.
+     * @return the smallest \e Nmax for which GravityTruncationError(\e Nmax,
+     *   \e h) &le; \e tol.
+     *
+     * The result can be passed to Circle() to compute the field with the
+     * required accuracy at the least cost.
+     **********************************************************************/
+    int GravityDegree(real tol, real h = 0) const;
     ///@}
 
     /** \name Inspector functions
@@ -456,6 +1060,43 @@ namespace GeographicLib {
      **********************************************************************/
     const std::string& GravityFile() const { return _filename; }
 
+    /**
+     * @return the number of bytes read from the coefficient file (the
+     *   file name with ".cof" appended).
+     **********************************************************************/
+    unsigned long long LoadBytes() const { return _loadbytes; }
+
+    /**
+     * @return true if the coefficient file is mapped into memory.  In this
+     *   case, LoadBytes() is the size of the mapped file.
+     **********************************************************************/
+    bool Mapped() const { return _store->map.data() != nullptr; }
+
+    /**
+     * @return true if the coefficients of the model are stored as floats.
+     **********************************************************************/
+    bool Single() const { return !_store->Cxf.empty(); }
+
+    /**
+     * @return the time taken to read the gravity model data files (seconds).
+     *
+     * The data files are only read by the constructor, so this and
+     * LoadBytes() give the complete I/O statistics for the gravity model.
+     **********************************************************************/
+    double LoadTime() const { return _loadtime; }
+
+    /**
+     * @return an estimate of the number of bytes of heap memory used by the
+     *   gravity model (this excludes sizeof(GravityModel)).
+     *
+     * This includes the coefficients (unless they are used in place in a
+     * mapped file; see Mapped()), the degree variances if they have been
+     * computed, and the circles in the circle cache.  The coefficients are
+     * shared by copies of the model (see the copy constructor); each copy
+     * includes them in its count.
+     **********************************************************************/
+    size_t MemoryUsage() const;
+
     /**
      * @return "name" used to load the gravity model (from the first argument
      *   of the constructor, but this may be overridden by the model file).
@@ -0,0 +1,166 @@
+/**
+ * \file GravityTrajectory.hpp
+ * \brief Header for GeographicLib::GravityTrajectory class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_GRAVITYTRAJECTORY_HPP)
+#define GEOGRAPHICLIB_GRAVITYTRAJECTORY_HPP 1
+
+#include <GeographicLib/Constants.hpp>
+
+namespace GeographicLib {
+
+  class GravityModel;
+
+  /**
+   * \brief Gravity along a trajectory
+   *
+   * Evaluate the gravity of a GravityModel at a sequence of nearby points,
+   * e.g., the positions of a vehicle at successive time steps of a
+   * simulation.  At an \e anchor point, \e W, its gradient (the
+   * acceleration), and its Hessian (the gravity gradient tensor) are
+   * computed with a single pass through the coefficients (see
+   * GravityModel::W).  At subsequent points within a distance \e r of the
+   * anchor, the acceleration is extrapolated linearly using the Hessian
+   * (and \e W quadratically); this costs a few dozen operations instead of
+   * a full spherical harmonic sum.  A point further than \e r from the
+   * anchor becomes the new anchor.
+   *
+   * The error in the extrapolated acceleration is about
+   * &frac12;<i>C</i><i>d</i><sup>2</sup>, where \e d is the distance from
+   * the anchor and \e C is the magnitude of the third derivatives of \e W.
+   * \e C is estimated at each new anchor by comparing the exact
+   * acceleration with that extrapolated from the previous anchor (and is at
+   * least the contribution 6<i>GM</i>/<i>R</i><sup>4</sup> of the central
+   * term); \e r is then chosen so that the error at distance \e r equals
+   * the tolerance.  Because \e C is estimated from the previous segment of
+   * the trajectory, the tolerance is not a strict bound; however, \e C
+   * varies slowly along a smooth trajectory and the estimate adapts at each
+   * anchor.  With the default tolerance of 10<sup>&minus;8</sup> m
+   * s<sup>&minus;2</sup> (1 &mu;Gal), \e r is about 100 m near the surface
+   * of the earth for a high degree model.
+   *
+   * A GravityTrajectory object holds a reference to the GravityModel which
+   * must outlive it.  The object is modified by each evaluation, so a
+   * separate object is needed for each trajectory (and each thread).
+   *
+   * Example of use:
+   * \code
+   * GravityModel grav("egm2008");
+   * GravityTrajectory traj(grav);
+   * for (int i = 0; i < n; ++i) {
+   *   real gx, gy, gz;
+   *   traj.Gravity(lat[i], lon[i], h[i], gx, gy, gz);
+   * }
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT GravityTrajectory {
+  private:
+    typedef Math::real real;
+    const GravityModel* _grav;
+    real _tol, _r, _c;
+    bool _anchored;
+    // The anchor: position, W, acceleration, and Hessian (XX, XY, XZ, YY,
+    // YZ, ZZ)
+    real _X0[3], _W0, _g0[3], _H0[6];
+    unsigned long long _anchors, _points;
+    real Extrapolate(const real d[3], real& gX, real& gY, real& gZ) const;
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param[in] grav the GravityModel.
+     * @param[in] tol the tolerance for the error in the acceleration (m
+     *   s<sup>&minus;2</sup>).
+     * @exception GeographicErr if \e tol isn't positive.
+     **********************************************************************/
+    explicit GravityTrajectory(const GravityModel& grav,
+                               real tol = real(1e-8));
+
+    /**
+     * Evaluate the gravity at the next point of the trajectory.
+     *
+     * @param[in] lat the geographic latitude (degrees).
+     * @param[in] lon the geographic longitude (degrees).
+     * @param[in] h the height above the ellipsoid (meters).
+     * @param[out] gx the easterly component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gy the northerly component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gz the upward component of the acceleration
+     *   (m s<sup>&minus;2</sup>); this is usually negative.
+     * @return \e W the sum of the gravitational and centrifugal potentials
+     *   (m<sup>2</sup> s<sup>&minus;2</sup>).
+     *
+     * This approximates GravityModel::Gravity.
+     **********************************************************************/
+    Math::real Gravity(real lat, real lon, real h,
+                       real& gx, real& gy, real& gz);
+
+    /**
+     * Evaluate the gravity at the next point of the trajectory in
+     * geocentric coordinates.
+     *
+     * @param[in] X geocentric coordinate of point (meters).
+     * @param[in] Y geocentric coordinate of point (meters).
+     * @param[in] Z geocentric coordinate of point (meters).
+     * @param[out] gX the \e X component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gY the \e Y component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gZ the \e Z component of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @return \e W = \e V + &Phi; the sum of the gravitational and
+     *   centrifugal potentials (m<sup>2</sup> s<sup>&minus;2</sup>).
+     *
+     * This approximates GravityModel::W(\e X, \e Y, \e Z, \e gX, \e gY, \e
+     * gZ).
+     **********************************************************************/
+    Math::real W(real X, real Y, real Z, real& gX, real& gY, real& gZ);
+
+    /**
+     * Forget the anchor, so that the next point is evaluated exactly.
+     *
+     * Call this when the trajectory jumps.  The estimate of \e C is
+     * retained.
+     **********************************************************************/
+    void Reset() { _anchored = false; }
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the tolerance for the error in the acceleration (m
+     *   s<sup>&minus;2</sup>).
+     **********************************************************************/
+    Math::real Tolerance() const { return _tol; }
+
+    /**
+     * @return \e r the distance from the current anchor within which the
+     *   acceleration is extrapolated (meters); this is 0 if there's no
+     *   anchor.
+     **********************************************************************/
+    Math::real Radius() const { return _anchored ? _r : 0; }
+
+    /**
+     * @return the number of points evaluated.
+     **********************************************************************/
+    unsigned long long Points() const { return _points; }
+
+    /**
+     * @return the number of anchors, i.e., the number of points at which
+     *   the spherical harmonic sums were evaluated.
+     **********************************************************************/
+    unsigned long long Anchors() const { return _anchors; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_GRAVITYTRAJECTORY_HPP
@@ -2,23 +2,28 @@
  * \file JacobiConformal.hpp
  * \brief Header for GeographicLib::JacobiConformal class
  *
- * <b>NOTE:</b> This is just sample code.  It is not part of GeographicLib
- * itself.
- *
- * Copyright (c) Charles Karney (2014-2020) <charles@karney.com> and licensed
+ * Copyright (c) Charles Karney (2014-2026) <charles@karney.com> and licensed
  * under the MIT/X11 License.  For more information, see
  * https://geographiclib.sourceforge.io/
  **********************************************************************/
 
+#if !defined(GEOGRAPHICLIB_JACOBICONFORMAL_HPP)
+#define GEOGRAPHICLIB_JACOBICONFORMAL_HPP 1
+
+#include <vector>
 #include <GeographicLib/EllipticFunction.hpp>
 
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs vector
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
 namespace GeographicLib {
+
   /**
    * \brief Jacobi's conformal projection of a triaxial ellipsoid
    *
-   * <b>NOTE:</b> This is just sample code.  It is not part of GeographicLib
-   * itself.
-   *
    * This is a conformal projection of the ellipsoid to a plane in which
    * the grid lines are straight; see Jacobi,
    * <a href="https://books.google.com/books?id=ryEOAAAAQAAJ&pg=PA212">
@@ -36,16 +41,47 @@ namespace GeographicLib {
    * points, \f$\left|\omega\right| = \left|\beta\right| = \frac12\pi\f$, lie
    * on middle principal ellipse in the plane \f$X=0\f$.
    *
+   * The single-point functions evaluate an incomplete elliptic integral of
+   * the third kind for each point.  Because the axes are fixed, \e x
+   * &minus; (2<i>X</i>/&pi;) &omega;, where \e X = x() is the quadrant
+   * length, is an odd periodic function of &omega; with period &pi;; so
+   * the constructor tabulates the coefficients of its Fourier sine series
+   * (and similarly for \e y).  The batch functions sum these series by
+   * Clenshaw summation; this is 3 to 6 times faster and agrees with the
+   * single-point functions to about 10<sup>&minus;14</sup> of the quadrant
+   * length.  The number of terms depends on the eccentricities of the
+   * ellipsoid; it is about 25 for a ratio of axes of 5.  If a series
+   * doesn't converge with 63 terms, the batch function falls back to the
+   * single-point evaluation.  This happens for \e y if the ellipsoid is
+   * nearly oblate (e.g., the triaxial earth) because then \e y is close
+   * to the isometric latitude and grows rapidly near the poles; it also
+   * happens for very elongated ellipsoids.
+   *
    * For more information on this projection, see \ref jacobi.
+   *
+   * Example of use:
+   * \include JacobiConformal.cpp
    **********************************************************************/
-  class JacobiConformal {
+  class GEOGRAPHICLIB_EXPORT JacobiConformal {
+  private:
     typedef Math::real real;
+    static const int nmax_ = 64;
     real _a, _b, _c, _ab2, _bc2, _ac2;
     EllipticFunction _ex, _ey;
+    // Fourier coefficients of x and y; element k - 1 is the coefficient of
+    // sin(2k omg) (resp. sin(2k bet)).  _xser (resp. _yser) is false if the
+    // series didn't converge.
+    std::vector<real> _cx, _cy;
+    bool _xser, _yser;
     static void norm(real& x, real& y) {
       using std::hypot;
       real z = hypot(x, y); x /= z; y /= z;
     }
+    void Init();
+    static bool Series(const EllipticFunction& ell, real scale,
+                       real p, real q, std::vector<real>& c);
+    static void Sum(const std::vector<real>& c, real quad,
+                    size_t n, const real ang[], real res[]);
   public:
     /**
      * Constructor for a trixial ellipsoid with semi-axes.
@@ -53,28 +89,14 @@ namespace GeographicLib {
      * @param[in] a the largest semi-axis.
      * @param[in] b the middle semi-axis.
      * @param[in] c the smallest semi-axis.
+     * @exception GeographicErr if the axes are not in order.
      *
      * The semi-axes must satisfy \e a &ge; \e b &ge; \e c > 0 and \e a >
      * \e c.  This form of the constructor cannot be used to specify a
      * sphere (use the next constructor).
      **********************************************************************/
-    JacobiConformal(real a, real b, real c)
-      : _a(a), _b(b), _c(c)
-      , _ab2((_a - _b) * (_a + _b))
-      , _bc2((_b - _c) * (_b + _c))
-      , _ac2((_a - _c) * (_a + _c))
-      , _ex(_ab2 / _ac2 * Math::sq(_c / _b), -_ab2 / Math::sq(_b),
-            _bc2 / _ac2 * Math::sq(_a / _b), Math::sq(_a / _b))
-      , _ey(_bc2 / _ac2 * Math::sq(_a / _b), +_bc2 / Math::sq(_b),
-            _ab2 / _ac2 * Math::sq(_c / _b), Math::sq(_c / _b))
-    {
-      using std::isfinite;
-      if (!(isfinite(_a) && _a >= _b && _b >= _c && _c > 0))
-        throw GeographicErr("JacobiConformal: axes are not in order");
-      if (!(_a > _c))
-        throw GeographicErr
-          ("JacobiConformal: use alternate constructor for sphere");
-    }
+    JacobiConformal(real a, real b, real c);
+
     /**
      * Alternate constructor for a triaxial ellipsoid.
      *
@@ -83,35 +105,21 @@ namespace GeographicLib {
      * @param[in] c the smallest semi-axis.
      * @param[in] ab the relative magnitude of \e a &minus; \e b.
      * @param[in] bc the relative magnitude of \e b &minus; \e c.
+     * @exception GeographicErr if the axes are not in order or if \e ab +
+     *   \e bc is not positive.
      *
      * This form can be used to specify a sphere.  The semi-axes must
      * satisfy \e a &ge; \e b &ge; c > 0.  The ratio \e ab : \e bc must equal
      * (<i>a</i>&minus;<i>b</i>) : (<i>b</i>&minus;<i>c</i>) with \e ab
      * &ge; 0, \e bc &ge; 0, and \e ab + \e bc > 0.
      **********************************************************************/
-    JacobiConformal(real a, real b, real c, real ab, real bc)
-      : _a(a), _b(b), _c(c)
-      , _ab2(ab * (_a + _b))
-      , _bc2(bc * (_b + _c))
-      , _ac2(_ab2 + _bc2)
-      , _ex(_ab2 / _ac2 * Math::sq(_c / _b),
-            -(_a - _b) * (_a + _b) / Math::sq(_b),
-            _bc2 / _ac2 * Math::sq(_a / _b), Math::sq(_a / _b))
-      , _ey(_bc2 / _ac2 * Math::sq(_a / _b),
-            +(_b - _c) * (_b + _c) / Math::sq(_b),
-            _ab2 / _ac2 * Math::sq(_c / _b), Math::sq(_c / _b))
-    {
-      using std::isfinite;
-      if (!(isfinite(_a) && _a >= _b && _b >= _c && _c > 0 &&
-            ab >= 0 && bc >= 0))
-        throw GeographicErr("JacobiConformal: axes are not in order");
-      if (!(ab + bc > 0 && isfinite(_ac2)))
-        throw GeographicErr("JacobiConformal: ab + bc must be positive");
-    }
+    JacobiConformal(real a, real b, real c, real ab, real bc);
+
     /**
      * @return the quadrant length in the \e x direction.
      **********************************************************************/
     Math::real x() const { return Math::sq(_a / _b) * _ex.Pi(); }
+
     /**
      * The \e x projection.
      *
@@ -124,6 +132,7 @@ namespace GeographicLib {
       return Math::sq(_a / _b)
         * _ex.Pi(somg1, comg1, _ex.Delta(somg1, comg1));
     }
+
     /**
      * The \e x projection.
      *
@@ -137,10 +146,24 @@ namespace GeographicLib {
       Math::sincosd(omg, somg, comg);
       return x(somg, comg) / Math::degree();
     }
+
+    /**
+     * The \e x projection of an array of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] omg array of &omega; (in degrees).
+     * @param[out] x array of \e x (in degrees).
+     *
+     * &omega; must be in (&minus;180&deg;, 180&deg;].  \e omg and \e x may
+     * be the same array.
+     **********************************************************************/
+    void x(size_t n, const real omg[], real x[]) const;
+
     /**
      * @return the quadrant length in the \e y direction.
      **********************************************************************/
     Math::real y() const { return Math::sq(_c / _b) * _ey.Pi(); }
+
     /**
      * The \e y projection.
      *
@@ -153,6 +176,7 @@ namespace GeographicLib {
       return Math::sq(_c / _b)
         * _ey.Pi(sbet1, cbet1, _ey.Delta(sbet1, cbet1));
     }
+
     /**
      * The \e y projection.
      *
@@ -166,6 +190,36 @@ namespace GeographicLib {
       Math::sincosd(bet, sbet, cbet);
       return y(sbet, cbet) / Math::degree();
     }
+
+    /**
+     * The \e y projection of an array of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] bet array of &beta; (in degrees).
+     * @param[out] y array of \e y (in degrees).
+     *
+     * &beta; must be in (&minus;180&deg;, 180&deg;].  \e bet and \e y may
+     * be the same array.
+     **********************************************************************/
+    void y(size_t n, const real bet[], real y[]) const;
+
+    /**
+     * @return the number of terms in the Fourier series for \e x (&minus;1
+     *   if the series didn't converge).
+     **********************************************************************/
+    int xTerms() const { return _xser ? int(_cx.size()) : -1; }
+
+    /**
+     * @return the number of terms in the Fourier series for \e y (&minus;1
+     *   if the series didn't converge).
+     **********************************************************************/
+    int yTerms() const { return _yser ? int(_cy.size()) : -1; }
   };
 
 } // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_JACOBICONFORMAL_HPP
@@ -68,6 +68,16 @@ namespace GeographicLib {
     real _sign, _n, _nc, _t0nm1, _scale, _lat0, _k0;
     real _scbet0, _tchi0, _scchi0, _psi0, _nrho0, _drhomax;
     static const int numit_ = 5;
+    // The batch routines process the arrays in blocks of this size
+    static const size_t projblock_ = 64;
+    // The parts of Forward and Reverse which don't involve the
+    // trigonometric functions of angles in degrees; lon = lon - lon0 reduced
+    // by AngDiff, sphi and cphi are the sine and cosine of lat * _sign, and
+    // lat = atand(tau).
+    void IntForward(real lon, real sphi, real cphi,
+                    real& x, real& y, real& gamma, real& k) const;
+    void IntReverse(real x, real y,
+                    real& tau, real& lam, real& gamma, real& k) const;
     static real hyp(real x) {
       using std::hypot;
       return hypot(real(1), x);
@@ -280,6 +290,53 @@ namespace GeographicLib {
       Reverse(lon0, x, y, lat, lon, gamma, k);
     }
 
+    /** \name Batch projections
+     **********************************************************************/
+    ///@{
+    /**
+     * Forward projection of arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lon0 central meridian longitude (degrees).
+     * @param[in] lat array of latitudes (degrees).
+     * @param[in] lon array of longitudes (degrees).
+     * @param[out] x array of eastings (meters).
+     * @param[out] y array of northings (meters).
+     * @param[out] gamma if non-null, an array of the meridian convergences
+     *   (degrees).
+     * @param[out] k if non-null, an array of the scales.
+     *
+     * The points are processed in blocks; the longitude differences and the
+     * sines and cosines of the latitudes are computed with Math::AngDiffBatch
+     * and Math::sincosdBatch.  The results are the same as calling Forward
+     * for each point.  The output arrays may coincide with the input arrays.
+     **********************************************************************/
+    void ForwardBatch(size_t n, real lon0, const real lat[], const real lon[],
+                      real x[], real y[],
+                      real gamma[] = nullptr, real k[] = nullptr) const;
+
+    /**
+     * Reverse projection of arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lon0 central meridian longitude (degrees).
+     * @param[in] x array of eastings (meters).
+     * @param[in] y array of northings (meters).
+     * @param[out] lat array of latitudes (degrees).
+     * @param[out] lon array of longitudes (degrees).
+     * @param[out] gamma if non-null, an array of the meridian convergences
+     *   (degrees).
+     * @param[out] k if non-null, an array of the scales.
+     *
+     * The latitudes are computed with Math::atan2dBatch.  The results are
+     * the same as calling Reverse for each point.  The output arrays may
+     * coincide with the input arrays.
+     **********************************************************************/
+    void ReverseBatch(size_t n, real lon0, const real x[], const real y[],
+                      real lat[], real lon[],
+                      real gamma[] = nullptr, real k[] = nullptr) const;
+    ///@}
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
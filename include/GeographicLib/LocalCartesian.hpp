@@ -199,6 +199,73 @@ namespace GeographicLib {
         IntReverse(x, y, z, lat, lon, h, NULL);
     }
 
+    /** \name Batch conversions
+     **********************************************************************/
+    ///@{
+    /**
+     * Convert arrays of points from geodetic to local cartesian coordinates.
+     *
+     * @tparam T the type of the local cartesian coordinates; this is
+     *   typically Math::real or float.
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes (degrees).
+     * @param[in] lon array of longitudes (degrees).
+     * @param[in] h array of heights above the ellipsoid (meters).
+     * @param[out] x array of local cartesian coordinates (meters).
+     * @param[out] y array of local cartesian coordinates (meters).
+     * @param[out] z array of local cartesian coordinates (meters).
+     * @param[out] M if non-null, an array of 9 \e n elements which is filled
+     *   with the rotation matrices, each in row-major order.
+     *
+     * The geocentric conversion and the rotation into the local system are
+     * carried out together for each point in Math::real precision, so the
+     * results are the same as calling Forward for each point, rounded to \e
+     * T.  Single precision for the outputs saves memory bandwidth; since its
+     * relative precision is about 6 &times; 10<sup>&minus;8</sup>, it is only
+     * suitable for points within a few tens of kilometers of the origin if cm
+     * accuracy is needed.  If \e T is Math::real, the output arrays may
+     * coincide with the input arrays.
+     **********************************************************************/
+    template<typename T>
+    void ForwardBatch(size_t n, const real lat[], const real lon[],
+                      const real h[], T x[], T y[], T z[],
+                      real M[] = nullptr) const {
+      for (size_t i = 0; i < n; ++i) {
+        real x1, y1, z1;
+        IntForward(lat[i], lon[i], h[i], x1, y1, z1,
+                   M ? M + dim2_ * i : NULL);
+        x[i] = T(x1); y[i] = T(y1); z[i] = T(z1);
+      }
+    }
+
+    /**
+     * Convert arrays of points from local cartesian to geodetic coordinates.
+     *
+     * @tparam T the type of the local cartesian coordinates; this is
+     *   typically Math::real or float.
+     * @param[in] n the number of points.
+     * @param[in] x array of local cartesian coordinates (meters).
+     * @param[in] y array of local cartesian coordinates (meters).
+     * @param[in] z array of local cartesian coordinates (meters).
+     * @param[out] lat array of latitudes (degrees).
+     * @param[out] lon array of longitudes (degrees).
+     * @param[out] h array of heights above the ellipsoid (meters).
+     * @param[out] M if non-null, an array of 9 \e n elements which is filled
+     *   with the rotation matrices, each in row-major order.
+     *
+     * The results are the same as calling Reverse for each point.  If \e T
+     * is Math::real, the output arrays may coincide with the input arrays.
+     **********************************************************************/
+    template<typename T>
+    void ReverseBatch(size_t n, const T x[], const T y[], const T z[],
+                      real lat[], real lon[], real h[],
+                      real M[] = nullptr) const {
+      for (size_t i = 0; i < n; ++i)
+        IntReverse(real(x[i]), real(y[i]), real(z[i]), lat[i], lon[i], h[i],
+                   M ? M + dim2_ * i : NULL);
+    }
+    ///@}
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
@@ -83,6 +83,11 @@ namespace GeographicLib {
     static const char* const upsband_;
     static const char* const digits_;
 
+    // Lookup tables for the character sets above, used by Reverse
+    class charindex;
+    struct tables;
+    static const tables& Tables();
+
     static const int mineasting_[4];
     static const int maxeasting_[4];
     static const int minnorthing_[4];
@@ -99,10 +104,73 @@ namespace GeographicLib {
       maxprec_ = 5 + 6,
       // For generating digits at maxprec
       mult_ = 1000000,
+      // Maximum length of an MGRS string: zone, 3 block letters, easting +
+      // northing
+      maxlen_ = 2 + 3 + 2 * maxprec_,
     };
-    static void CheckCoords(bool utmp, bool& northp, real& x, real& y);
+    // If throwp = false, return bool instead
+    static bool CheckCoords(bool utmp, bool& northp, real& x, real& y,
+                            bool throwp = true);
     static int UTMRow(int iband, int icol, int irow);
 
+  public:
+    /**
+     * The status returned by the conversions which write to or read from
+     * character buffers instead of throwing an exception.
+     **********************************************************************/
+    enum status {
+      /**
+       * The conversion succeeded.
+       * @hideinitializer
+       **********************************************************************/
+      OK = 0,
+      /**
+       * The UTM zone is out of range.
+       * @hideinitializer
+       **********************************************************************/
+      BADZONE = 1,
+      /**
+       * The precision is out of range.
+       * @hideinitializer
+       **********************************************************************/
+      BADPRECISION = 2,
+      /**
+       * The easting or northing is outside the allowed range.
+       * @hideinitializer
+       **********************************************************************/
+      BADCOORDS = 3,
+      /**
+       * The latitude is inconsistent with the UTM coordinates.
+       * @hideinitializer
+       **********************************************************************/
+      BADLATITUDE = 4,
+      /**
+       * The MGRS string is illegal.
+       * @hideinitializer
+       **********************************************************************/
+      BADSTRING = 5,
+      /**
+       * The output buffer is too small.
+       * @hideinitializer
+       **********************************************************************/
+      BUFFERTOOSMALL = 6,
+    };
+
+  private:
+    // Core conversions.  If throwp = false, return a status instead of
+    // throwing an exception.  mgrs1 must have room for maxlen_ characters; it
+    // is not null-terminated.
+    static status ForwardChars(int zone, bool northp, real x, real y,
+                               real lat, int prec, char mgrs1[], int& mlen,
+                               bool throwp);
+    static status ReverseChars(const char* mgrs, int len,
+                               int& zone, bool& northp, real& x, real& y,
+                               int& prec, bool centerp, bool throwp);
+    // Estimate the latitude needed to determine the band letter.  If throwp =
+    // false, return NaN if x or y is out of range.
+    static real ApproxLatitude(int zone, bool northp, real x, real y,
+                               bool throwp);
+
     friend class UTMUPS;        // UTMUPS::StandardZone calls LatitudeBand
     // Return latitude band number [-10, 10) for the given latitude (degrees).
     // The bands are reckoned in include their southern edges.
@@ -316,6 +384,119 @@ namespace GeographicLib {
                         int& zone, bool& northp, real& x, real& y,
                         int& prec, bool centerp = true);
 
+    /** \name Conversions on character buffers
+     *
+     * These versions of Forward and Reverse neither allocate memory nor throw
+     * exceptions; instead an error is signaled by the returned status.  On
+     * failure the output arguments are unchanged.
+     **********************************************************************/
+    ///@{
+    /**
+     * Convert UTM or UPS coordinate to an MGRS coordinate in a character
+     * buffer.
+     *
+     * @param[in] zone UTM zone (zero means UPS).
+     * @param[in] northp hemisphere (true means north, false means south).
+     * @param[in] x easting of point (meters).
+     * @param[in] y northing of point (meters).
+     * @param[in] prec precision relative to 100 km.
+     * @param[out] mgrs buffer for the null-terminated MGRS string.
+     * @param[in] size the size of \e mgrs.
+     * @return the status of the conversion; BUFFERTOOSMALL is returned if
+     *   \e size is less than the length of the result plus 1.
+     *
+     * A buffer with 28 characters is sufficient for all values of \e prec.
+     **********************************************************************/
+    static status Forward(int zone, bool northp, real x, real y,
+                          int prec, char mgrs[], size_t size);
+
+    /**
+     * Convert UTM or UPS coordinate to an MGRS coordinate in a character
+     * buffer when the latitude is known.
+     *
+     * @param[in] zone UTM zone (zero means UPS).
+     * @param[in] northp hemisphere (true means north, false means south).
+     * @param[in] x easting of point (meters).
+     * @param[in] y northing of point (meters).
+     * @param[in] lat latitude (degrees).
+     * @param[in] prec precision relative to 100 km.
+     * @param[out] mgrs buffer for the null-terminated MGRS string.
+     * @param[in] size the size of \e mgrs.
+     * @return the status of the conversion.
+     **********************************************************************/
+    static status Forward(int zone, bool northp, real x, real y, real lat,
+                          int prec, char mgrs[], size_t size);
+
+    /**
+     * Convert a MGRS coordinate in a character buffer to UTM or UPS
+     * coordinates.
+     *
+     * @param[in] mgrs the MGRS string (need not be null-terminated).
+     * @param[in] len the number of characters in \e mgrs.
+     * @param[out] zone UTM zone (zero means UPS).
+     * @param[out] northp hemisphere (true means north, false means south).
+     * @param[out] x easting of point (meters).
+     * @param[out] y northing of point (meters).
+     * @param[out] prec precision relative to 100 km.
+     * @param[in] centerp if true (default), return center of the MGRS square,
+     *   else return SW (lower left) corner.
+     * @return the status of the conversion; BADZONE or BADSTRING is returned
+     *   if \e mgrs is illegal.
+     **********************************************************************/
+    static status Reverse(const char* mgrs, size_t len,
+                          int& zone, bool& northp, real& x, real& y,
+                          int& prec, bool centerp = true);
+
+    /**
+     * Convert arrays of UTM or UPS coordinates to MGRS coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] zone array of UTM zones.
+     * @param[in] northp array of hemispheres.
+     * @param[in] x array of eastings (meters).
+     * @param[in] y array of northings (meters).
+     * @param[in] prec precision relative to 100 km.
+     * @param[out] mgrs buffer of \e n &times; \e stride characters; the
+     *   null-terminated MGRS string for point \e i starts at \e mgrs[\e i
+     *   &times; \e stride].
+     * @param[in] stride the space allotted to each MGRS string.
+     * @param[out] stat optional array of statuses for each point.
+     * @return the number of points for which the conversion failed.
+     *
+     * The MGRS string for a failed conversion is set to the empty string.
+     **********************************************************************/
+    static size_t ForwardBatch(size_t n, const int zone[], const bool northp[],
+                               const real x[], const real y[], int prec,
+                               char mgrs[], size_t stride,
+                               status stat[] = nullptr);
+
+    /**
+     * Convert arrays of MGRS coordinates to UTM or UPS coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] mgrs buffer of \e n &times; \e stride characters; the MGRS
+     *   string for point \e i starts at \e mgrs[\e i &times; \e stride] and
+     *   is terminated by a null or by the end of its \e stride characters.
+     * @param[in] stride the space allotted to each MGRS string.
+     * @param[out] zone array of UTM zones.
+     * @param[out] northp array of hemispheres.
+     * @param[out] x array of eastings (meters).
+     * @param[out] y array of northings (meters).
+     * @param[out] prec array of precisions.
+     * @param[in] centerp if true (default), return centers of the MGRS
+     *   squares, else return SW (lower left) corners.
+     * @param[out] stat optional array of statuses for each point.
+     * @return the number of points for which the conversion failed.
+     *
+     * For a failed conversion, \e zone is set to UTMUPS::INVALID, \e x and \e
+     * y are set to NaN, and \e prec is set to &minus;2.
+     **********************************************************************/
+    static size_t ReverseBatch(size_t n, const char mgrs[], size_t stride,
+                               int zone[], bool northp[],
+                               real x[], real y[], int prec[],
+                               bool centerp = true, status stat[] = nullptr);
+    ///@}
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
@@ -0,0 +1,187 @@
+/**
+ * \file MGRSGrid.hpp
+ * \brief Header for GeographicLib::MGRSGrid class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_MGRSGRID_HPP)
+#define GEOGRAPHICLIB_MGRSGRID_HPP 1
+
+#include <string>
+#include <vector>
+#include <GeographicLib/Constants.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief The MGRS grid lines and labels for map rendering
+   *
+   * This class generates, for a box bounded by parallels and meridians, the
+   * lines and labels of the MGRS grid at a given precision: the boundaries
+   * of the grid zones (the meridians separating UTM zones and the halves of
+   * the UPS regions and the parallels separating the latitude bands and
+   * the UTM and UPS regions), the grid lines of constant easting and
+   * northing spaced 10<sup>5&minus;\e prec</sup> m apart, and the position
+   * and MGRS reference of each grid square.  All of these are returned as
+   * geographic coordinates, ready to be passed to the map projection.
+   *
+   * The box is split into its intersections with the grid zones; the zones
+   * are obtained from UTMUPS::StandardZone, so that the Norway and Svalbard
+   * exceptions are honored.  In each zone, the range of the projected
+   * coordinates is found from the boundary of the intersection and the grid
+   * lines in this range are sampled at intervals of at most \e step
+   * meters.  The points on all the lines in a zone are converted to
+   * geographic coordinates with a single call to UTMUPS::ReverseBatch.  The
+   * lines are clipped to the zone and the box; the points where a line
+   * leaves the zone are found by the Illinois variant of regula falsi, with
+   * all the crossings in the zone being refined together.  The labels are
+   * placed at the centers of the grid squares and are converted to MGRS with
+   * a single call to MGRS::ForwardBatch.
+   *
+   * The longitudes returned are continuous across the antimeridian: they
+   * lie in [\e west, \e west + \e w], where \e w is the width of the box.
+   * The amount of output is proportional to the area of the box divided by
+   * the square of the grid spacing; so the box should be matched to the
+   * precision (e.g., a box of a few degrees for 1 km squares).
+   *
+   * An MGRSGrid object holds no state other than the precision and the
+   * sampling interval; thus a single object may be used by several threads.
+   *
+   * Example of use:
+   * \code
+   * MGRSGrid grid(1);              // 10 km squares
+   * std::vector<MGRSGrid::polyline> lines;
+   * std::vector<MGRSGrid::label> labels;
+   * grid.Generate(40, -76, 42, -72, lines, labels);
+   * for (const auto& l : labels)
+   *   std::cout << l.lat << " " << l.lon << " " << l.mgrs << "\n";
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT MGRSGrid {
+  private:
+    typedef Math::real real;
+    int _prec;
+    real _step;
+  public:
+
+    /**
+     * The kinds of line generated.
+     **********************************************************************/
+    enum linetype {
+      /**
+       * A meridian separating two grid zones.
+       * @hideinitializer
+       **********************************************************************/
+      ZONEBOUNDARY = 0,
+      /**
+       * A parallel separating two grid zones.
+       * @hideinitializer
+       **********************************************************************/
+      BANDBOUNDARY = 1,
+      /**
+       * A grid line of constant easting.
+       * @hideinitializer
+       **********************************************************************/
+      EASTING = 2,
+      /**
+       * A grid line of constant northing.
+       * @hideinitializer
+       **********************************************************************/
+      NORTHING = 3,
+    };
+
+    /**
+     * A line to be drawn.  For a zone or band boundary, \e zone and \e
+     * northp give the grid zone to the east or north of the line, and \e
+     * value is its longitude or latitude (degrees).  For a grid line, they
+     * give the grid zone containing the line, and \e value is its easting or
+     * northing (meters).
+     **********************************************************************/
+    struct polyline {
+      linetype type;            ///< The kind of line.
+      int zone;                 ///< The UTM zone (zero means UPS).
+      bool northp;              ///< The hemisphere.
+      real value;               ///< The longitude, latitude, easting, ...
+      std::vector<real> lat;    ///< The latitudes of the points (degrees).
+      std::vector<real> lon;    ///< The longitudes of the points (degrees).
+    };
+
+    /**
+     * A label to be drawn.  For \e prec &ge; 0, this is placed at the center
+     * of a grid square; otherwise it is placed at the center of the part of
+     * a grid zone which lies in the box.
+     **********************************************************************/
+    struct label {
+      real lat;                 ///< The latitude of the label (degrees).
+      real lon;                 ///< The longitude of the label (degrees).
+      std::string mgrs;         ///< The MGRS reference of the square.
+    };
+
+    /**
+     * Constructor for MGRSGrid.
+     *
+     * @param[in] prec the precision relative to 100 km; the grid lines are
+     *   spaced 10<sup>5&minus;\e prec</sup> m apart.
+     * @param[in] step the maximum interval at which the lines are sampled
+     *   (meters); the default is 1000 m.
+     * @exception GeographicErr if \e prec is not in [&minus;1, 5] or if \e
+     *   step is not positive.
+     *
+     * With \e prec = &minus;1, only the boundaries and the labels of the
+     * grid zones are generated.
+     **********************************************************************/
+    MGRSGrid(int prec, real step = 1000);
+
+    /**
+     * Generate the grid for a box.
+     *
+     * @param[in] south the southern edge of the box (degrees).
+     * @param[in] west the western edge of the box (degrees).
+     * @param[in] north the northern edge of the box (degrees).
+     * @param[in] east the eastern edge of the box (degrees).
+     * @param[out] lines the lines to be drawn.
+     * @param[out] labels the labels to be drawn.
+     * @exception GeographicErr if \e south or \e north is not in
+     *   [&minus;90&deg;, 90&deg;].
+     * @exception std::bad_alloc if the memory for \e lines or \e labels can't
+     *   be allocated.
+     *
+     * The box extends eastwards from \e west to \e east; if these are equal
+     * (modulo 360&deg;), the box encircles the earth.  If \e south &ge; \e
+     * north, or \e west or \e east is not finite, nothing is generated.  The
+     * boundaries of the grid zones on the western and southern edges of the
+     * box are included.  Only the grid squares whose centers lie in the box
+     * are labeled.
+     **********************************************************************/
+    void Generate(real south, real west, real north, real east,
+                  std::vector<polyline>& lines,
+                  std::vector<label>& labels) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the precision relative to 100 km.
+     **********************************************************************/
+    int Precision() const { return _prec; }
+
+    /**
+     * @return the spacing of the grid lines (meters); this is 0 for \e prec
+     *   = &minus;1.
+     **********************************************************************/
+    Math::real Spacing() const;
+
+    /**
+     * @return the maximum interval at which the lines are sampled (meters).
+     **********************************************************************/
+    Math::real Step() const { return _step; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_MGRSGRID_HPP
@@ -38,59 +38,50 @@ namespace GeographicLib {
   private:
     typedef Math::real real;
 
-    real _a, _f, _lat, _h, _t, _cphi, _sphi, _t1, _dt0;
-    bool _interpolate, _constterm;
-    CircularEngine _circ0, _circ1, _circ2;
-
-    MagneticCircle(real a, real f, real lat, real h, real t,
-                   real cphi, real sphi, real t1, real dt0,
-                   bool interpolate,
-                   const CircularEngine& circ0, const CircularEngine& circ1)
-      : _a(a)
-      , _f(f)
-      , _lat(Math::LatFix(lat))
-      , _h(h)
-      , _t(t)
-      , _cphi(cphi)
-      , _sphi(sphi)
-      , _t1(t1)
-      , _dt0(dt0)
-      , _interpolate(interpolate)
-      , _constterm(false)
-      , _circ0(circ0)
-      , _circ1(circ1)
-    {}
-
-    MagneticCircle(real a, real f, real lat, real h, real t,
-                   real cphi, real sphi, real t1, real dt0,
-                   bool interpolate,
-                   const CircularEngine& circ0, const CircularEngine& circ1,
-                   const CircularEngine& circ2)
-      : _a(a)
-      , _f(f)
-      , _lat(lat)
-      , _h(h)
-      , _t(t)
-      , _cphi(cphi)
-      , _sphi(sphi)
-      , _t1(t1)
-      , _dt0(dt0)
-      , _interpolate(interpolate)
-      , _constterm(true)
-      , _circ0(circ0)
-      , _circ1(circ1)
-      , _circ2(circ2)
-    {}
-
-    void Field(real lon, bool diffp,
+    real _a, _f, _lat, _h, _t, _cphi, _sphi, _t0, _dt0;
+    int _Nmodels, _n0;
+    bool _constterm;
+    // The circles for models _n0 through _n0 + _circ.size() - 1 and for the
+    // constant terms.
+    std::vector<CircularEngine> _circ;
+    CircularEngine _circc;
+
+    // Set the parameters of the circle; the CircularEngine objects are
+    // filled in by MagneticModel::Circle.
+    void Reset(real a, real f, real lat, real h, real t,
+               real cphi, real sphi, real t0, real dt0,
+               int Nmodels, int n0, bool constterm) {
+      _a = a;
+      _f = f;
+      _lat = Math::LatFix(lat);
+      _h = h;
+      _t = t;
+      _cphi = cphi;
+      _sphi = sphi;
+      _t0 = t0;
+      _dt0 = dt0;
+      _Nmodels = Nmodels;
+      _n0 = n0;
+      _constterm = constterm;
+    }
+
+    // The index of the model for time t which is reduced to the time since
+    // the epoch of the model (this matches MagneticModel::Epoch); return -1
+    // if the circles for this model are not available.
+    int Epoch(real& t) const;
+
+    void Field(real t, real lon, bool diffp,
                real& Bx, real& By, real& Bz,
                real& Bxt, real& Byt, real& Bzt) const;
 
-    void FieldGeocentric(real slam, real clam,
+    void FieldGeocentric(real t, real slam, real clam,
                          real& BX, real& BY, real& BZ,
                          real& BXt, real& BYt, real& BZt) const;
 
-    friend class MagneticModel; // MagneticModel calls the private constructor
+    // The number of longitudes handled together by the vector routine.
+    static const int blk_ = 64;
+
+    friend class MagneticModel; // MagneticModel calls Reset
 
   public:
 
@@ -117,7 +108,7 @@ namespace GeographicLib {
      **********************************************************************/
     void operator()(real lon, real& Bx, real& By, real& Bz) const {
       real dummy;
-      Field(lon, false, Bx, By, Bz, dummy, dummy, dummy);
+      Field(_t, lon, false, Bx, By, Bz, dummy, dummy, dummy);
     }
 
     /**
@@ -136,9 +127,94 @@ namespace GeographicLib {
      **********************************************************************/
     void operator()(real lon, real& Bx, real& By, real& Bz,
                     real& Bxt, real& Byt, real& Bzt) const {
-      Field(lon, true, Bx, By, Bz, Bxt, Byt, Bzt);
+      Field(_t, lon, true, Bx, By, Bz, Bxt, Byt, Bzt);
+    }
+
+    /**
+     * Evaluate the components of the geomagnetic field at many longitudes.
+     *
+     * @param[in] n the number of longitudes.
+     * @param[in] lon array of longitudes of the points (degrees).
+     * @param[out] Bx array of the easterly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] By array of the northerly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bz array of the vertical (up) components of the magnetic
+     *   field (nanotesla).
+     *
+     * This gives the same results as operator()(real, real&, real&, real&)
+     * const, but the sums for a block of longitudes are computed together
+     * with CircularEngine::Evaluate which is substantially faster.
+     **********************************************************************/
+    void operator()(size_t n, const real lon[],
+                    real Bx[], real By[], real Bz[]) const
+    { operator()(_t, n, lon, Bx, By, Bz); }
+
+    /**
+     * Evaluate the components of the geomagnetic field at a particular
+     * longitude and time.
+     *
+     * @param[in] t the time (years).
+     * @param[in] lon longitude of the point (degrees).
+     * @param[out] Bx the easterly component of the magnetic field (nanotesla).
+     * @param[out] By the northerly component of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bz the vertical (up) component of the magnetic field
+     *   (nanotesla).
+     *
+     * The circle only holds the sums for the models needed for the times
+     * specified when it was created with MagneticModel::Circle; NaNs are
+     * returned if \e t requires other models.  The results are the same as
+     * for a circle created for time \e t.
+     **********************************************************************/
+    void operator()(real t, real lon, real& Bx, real& By, real& Bz) const {
+      real dummy;
+      Field(t, lon, false, Bx, By, Bz, dummy, dummy, dummy);
     }
 
+    /**
+     * Evaluate the components of the geomagnetic field and their time
+     * derivatives at a particular longitude and time.
+     *
+     * @param[in] t the time (years).
+     * @param[in] lon longitude of the point (degrees).
+     * @param[out] Bx the easterly component of the magnetic field (nanotesla).
+     * @param[out] By the northerly component of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bz the vertical (up) component of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bxt the rate of change of \e Bx (nT/yr).
+     * @param[out] Byt the rate of change of \e By (nT/yr).
+     * @param[out] Bzt the rate of change of \e Bz (nT/yr).
+     *
+     * See operator()(real, real, real&, real&, real&) const for the allowed
+     * range of \e t.
+     **********************************************************************/
+    void operator()(real t, real lon, real& Bx, real& By, real& Bz,
+                    real& Bxt, real& Byt, real& Bzt) const {
+      Field(t, lon, true, Bx, By, Bz, Bxt, Byt, Bzt);
+    }
+
+    /**
+     * Evaluate the components of the geomagnetic field at many longitudes
+     * for a particular time.
+     *
+     * @param[in] t the time (years).
+     * @param[in] n the number of longitudes.
+     * @param[in] lon array of longitudes of the points (degrees).
+     * @param[out] Bx array of the easterly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] By array of the northerly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bz array of the vertical (up) components of the magnetic
+     *   field (nanotesla).
+     *
+     * See operator()(real, real, real&, real&, real&) const for the allowed
+     * range of \e t.
+     **********************************************************************/
+    void operator()(real t, size_t n, const real lon[],
+                    real Bx[], real By[], real Bz[]) const;
+
     /**
      * Evaluate the components of the geomagnetic field and their time
      * derivatives at a particular longitude.
@@ -152,6 +228,24 @@ namespace GeographicLib {
      * @param[out] BZt the rate of change of \e BZ (nT/yr).
      **********************************************************************/
     void FieldGeocentric(real lon, real& BX, real& BY, real& BZ,
+                         real& BXt, real& BYt, real& BZt) const {
+      FieldGeocentric(_t, lon, BX, BY, BZ, BXt, BYt, BZt);
+    }
+
+    /**
+     * Evaluate the components of the geomagnetic field and their time
+     * derivatives at a particular longitude and time.
+     *
+     * @param[in] t the time (years).
+     * @param[in] lon longitude of the point (degrees).
+     * @param[out] BX the \e X component of the magnetic field (nT).
+     * @param[out] BY the \e Y component of the magnetic field (nT).
+     * @param[out] BZ the \e Z component of the magnetic field (nT).
+     * @param[out] BXt the rate of change of \e BX (nT/yr).
+     * @param[out] BYt the rate of change of \e BY (nT/yr).
+     * @param[out] BZt the rate of change of \e BZ (nT/yr).
+     **********************************************************************/
+    void FieldGeocentric(real t, real lon, real& BX, real& BY, real& BZ,
                          real& BXt, real& BYt, real& BZt) const;
     ///@}
 
@@ -186,11 +280,24 @@ namespace GeographicLib {
     Math::real Height() const
     { return Init() ? _h : Math::NaN(); }
     /**
-     * @return the time (fractional years).
+     * @return the time (fractional years); this is the time used by the
+     *   member functions which don't take a time argument.
      **********************************************************************/
     Math::real Time() const
     { return Init() ? _t : Math::NaN(); }
 
+    /**
+     * @return the number of bytes of heap memory used by the object (this
+     *   excludes sizeof(MagneticCircle)).
+     **********************************************************************/
+    size_t MemoryUsage() const {
+      size_t bytes = _circ.capacity() * sizeof(CircularEngine) +
+        _circc.MemoryUsage();
+      for (const CircularEngine& c : _circ)
+        bytes += c.MemoryUsage();
+      return bytes;
+    }
+
     /**
      * \deprecated An old name for EquatorialRadius().
      **********************************************************************/
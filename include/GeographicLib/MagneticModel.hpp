@@ -13,6 +13,9 @@
 #include <GeographicLib/Constants.hpp>
 #include <GeographicLib/Geocentric.hpp>
 #include <GeographicLib/SphericalHarmonic.hpp>
+#include <GeographicLib/CircleCache.hpp>
+#include <future>
+#include <memory>
 
 #if defined(_MSC_VER)
 // Squelch warnings about dll vs vector
@@ -23,6 +26,7 @@
 namespace GeographicLib {
 
   class MagneticCircle;
+  class MagneticSnapshot;
 
   /**
    * \brief Model of the earth's magnetic field
@@ -81,16 +85,55 @@ namespace GeographicLib {
     int _Nmodels, _Nconstants, _nmx, _mmx;
     SphericalHarmonic::normalization _norm;
     Geocentric _earth;
-    std::vector< std::vector<real> > _G;
-    std::vector< std::vector<real> > _H;
+    // The storage for the coefficients; this is filled in by the constructor
+    // and is then shared (without modification) by copies and truncated
+    // views of the model.
+    struct coeffstore {
+      std::vector< std::vector<real> > G;
+      std::vector< std::vector<real> > H;
+      SphericalEngine::mappedfile map; // Used instead of G and H if mapped
+    };
+    std::shared_ptr<const coeffstore> _store;
     std::vector<SphericalHarmonic> _harm;
+    unsigned long long _loadbytes;
+    double _loadtime;
+    // The circles used by the point queries if SetCircleCache was called
+    mutable CircleCache<MagneticCircle> _circles;
     void Field(real t, real lat, real lon, real h, bool diffp,
                real& Bx, real& By, real& Bz,
                real& Bxt, real& Byt, real& Bzt) const;
-    void ReadMetadata(const std::string& name);
-    // copy constructor not allowed
-    MagneticModel(const MagneticModel&) = delete;
-    // nor copy assignment
+    void ReadMetadata(std::istream& metastr);
+    // A model compiled into the library
+    struct embedded {
+      const char* name;
+      const unsigned char* meta;
+      size_t metasize;
+      const unsigned char* coeff;
+      size_t coeffsize;
+    };
+    // The models compiled into the library, terminated by a null name
+    static const embedded _embedded[];
+    // Return the index of the model for time t and reduce t to the time since
+    // the epoch of the model.
+    int Epoch(real& t) const;
+    // Combine the sums B0[3], B1[3], and Bc[3] for models n and n + 1 and the
+    // constant terms into the field and its rate of change at time t (the
+    // result of Epoch) in the geocentric basis.
+    void Combine(real t, int n,
+                 const real B0[], const real B1[], const real Bc[],
+                 real& BX, real& BY, real& BZ,
+                 real& BXt, real& BYt, real& BZt) const;
+    // Evaluate the field at the geocentric point X, Y, Z with rotation matrix
+    // M at times t[ind[j]] for j in [0, n) (ind = NULL means ind[j] = j)
+    // saving the sums for each model.
+    void TimeSeries(real X, real Y, real Z, const real M[],
+                    size_t n, const size_t ind[], const real t[],
+                    real Bx[], real By[], real Bz[],
+                    real Bxt[], real Byt[], real Bzt[]) const;
+    // Call row(i) for i in [0, nlat) using the given number of threads.
+    template<class F>
+    static void GenGrid(int nlat, F row, unsigned threads);
+    // copy assignment not allowed
     MagneticModel& operator=(const MagneticModel&) = delete;
   public:
 
@@ -108,6 +151,8 @@ namespace GeographicLib {
      *   model this value.
      * @param[in] Mmax (optional) if non-negative, truncate the order of the
      *   model this value.
+     * @param[in] mapped (optional) if true, map the coefficient file into
+     *   memory instead of reading it (default false).
      * @exception GeographicErr if the data file cannot be found, is
      *   unreadable, or is corrupt, or if \e Mmax > \e Nmax.
      * @exception std::bad_alloc if the memory necessary for storing the model
@@ -131,11 +176,75 @@ namespace GeographicLib {
      * If \e Nmax &ge; 0 and \e Mmax < 0, then \e Mmax is set to \e Nmax.
      * After the model is loaded, the maximum degree and order of the model can
      * be found by the Degree() and Order() methods.
+     *
+     * If \e mapped is true and SphericalEngine::mappedfile::Supported(), the
+     * coefficients are used in place in the memory-mapped file; see
+     * GravityModel::GravityModel for details.
+     *
+     * If \e path is empty and the model is one of those compiled into the
+     * library (see EmbeddedModels()), the compiled-in data is used and no
+     * files are read; \e mapped is then ignored and
+     * MagneticModelDirectory() returns an empty string.
      **********************************************************************/
     explicit MagneticModel(const std::string& name,
                            const std::string& path = "",
                            const Geocentric& earth = Geocentric::WGS84(),
-                           int Nmax = -1, int Mmax = -1);
+                           int Nmax = -1, int Mmax = -1, bool mapped = false);
+
+    /**
+     * Construct a magnetic model in the background.
+     *
+     * @param[in] name the name of the model.
+     * @param[in] path (optional) directory for data file.
+     * @param[in] earth (optional) Geocentric object for converting
+     *   coordinates; default Geocentric::WGS84().
+     * @param[in] Nmax (optional) if non-negative, truncate the degree of the
+     *   model this value.
+     * @param[in] Mmax (optional) if non-negative, truncate the order of the
+     *   model this value.
+     * @param[in] mapped (optional) if true, use the coefficients in place in
+     *   a memory-mapped file.
+     * @return a future holding the MagneticModel.
+     *
+     * The arguments are the same as for the constructor, which is run on a
+     * new thread.  Calling \e get() on the returned future waits for the
+     * model to be loaded and rethrows any exception thrown by the
+     * constructor.  See Geoid::Load for an example.
+     **********************************************************************/
+    static std::future<std::shared_ptr<MagneticModel>>
+    Load(const std::string& name, const std::string& path = "",
+         const Geocentric& earth = Geocentric::WGS84(),
+         int Nmax = -1, int Mmax = -1, bool mapped = false);
+
+    /**
+     * Construct a truncated view of a magnetic model.
+     *
+     * @param[in] m the magnetic model.
+     * @param[in] Nmax if non-negative, truncate the degree of the model this
+     *   value.
+     * @param[in] Mmax (optional) if non-negative, truncate the order of the
+     *   model this value.
+     * @exception GeographicErr if \e Nmax and \e Mmax are inconsistent.
+     *
+     * The new object shares the coefficients of \e m (which may be
+     * destroyed first), so no files are read and little memory is used.
+     * The result is the same as constructing the model from its files with
+     * \e Nmax and \e Mmax (except that truncating \e m can't increase the
+     * degree or order).  LoadBytes(), LoadTime(), and Mapped() report the
+     * values for the model whose coefficients are shared.  The circle cache
+     * (see SetCircleCache) isn't copied.
+     **********************************************************************/
+    MagneticModel(const MagneticModel& m, int Nmax, int Mmax = -1);
+
+    /**
+     * The copy constructor.
+     *
+     * @param[in] m the magnetic model.
+     *
+     * This is equivalent to MagneticModel(\e m, -1, -1); the copy shares the
+     * coefficients of \e m.
+     **********************************************************************/
+    MagneticModel(const MagneticModel& m) : MagneticModel(m, -1, -1) {}
     ///@}
 
     /** \name Compute the magnetic field
@@ -203,6 +312,230 @@ namespace GeographicLib {
      **********************************************************************/
     MagneticCircle Circle(real t, real lat, real h) const;
 
+    /**
+     * Create a MagneticCircle object which allows the geomagnetic field to be
+     * computed efficiently for many longitudes and times with constant \e lat
+     * and \e h.
+     *
+     * @param[in] tmin the earliest time (years).
+     * @param[in] tmax the latest time (years).
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] h the height of the point above the ellipsoid (meters).
+     * @exception std::bad_alloc if the memory necessary for creating a
+     *   MagneticCircle can't be allocated.
+     * @return a MagneticCircle object whose member functions compute the
+     *   field at particular values of \e lon and \e t.
+     *
+     * The sums for each of the models needed for times in [\e tmin, \e tmax]
+     * are pre-evaluated, so the field can be found for any time in this
+     * range with the MagneticCircle member functions which take a time
+     * argument (at the cost of evaluating two or three CircularEngine
+     * objects).  The member functions without a time argument use \e tmin.
+     * Circle(\e t, \e lat, \e h) is equivalent to Circle(\e t, \e t, \e
+     * lat, \e h).
+     **********************************************************************/
+    MagneticCircle Circle(real tmin, real tmax, real lat, real h) const;
+
+    /**
+     * Reinitialize a MagneticCircle object in place.
+     *
+     * @param[out] circ the MagneticCircle object.
+     * @param[in] tmin the earliest time (years).
+     * @param[in] tmax the latest time (years).
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] h the height of the point above the ellipsoid (meters).
+     * @exception std::bad_alloc if the memory necessary for creating a
+     *   MagneticCircle can't be allocated.
+     *
+     * This gives the same result as \e circ = Circle(\e tmin, \e tmax, \e
+     * lat, \e h); however the storage already held by \e circ is reused.
+     **********************************************************************/
+    void Circle(MagneticCircle& circ, real tmin, real tmax,
+                real lat, real h) const;
+
+    /**
+     * Reinitialize a MagneticCircle object in place for a single time.
+     *
+     * @param[out] circ the MagneticCircle object.
+     * @param[in] t the time (years).
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] h the height of the point above the ellipsoid (meters).
+     * @exception std::bad_alloc if the memory necessary for creating a
+     *   MagneticCircle can't be allocated.
+     **********************************************************************/
+    void Circle(MagneticCircle& circ, real t, real lat, real h) const
+    { Circle(circ, t, t, lat, h); }
+
+    /**
+     * Create a MagneticSnapshot object which allows the geomagnetic field at
+     * many points at a fixed time to be computed efficiently.
+     *
+     * @param[in] t the time (years).
+     * @exception std::bad_alloc if the memory necessary for creating a
+     *   MagneticSnapshot can't be allocated.
+     * @return a MagneticSnapshot object whose
+     *   MagneticSnapshot::operator()(real lat, real lon, real h, real& Bx,
+     *   real& By, real& Bz) member function computes the field at particular
+     *   points.
+     *
+     * The coefficients of the two models bracketing \e t and of the constant
+     * terms are combined into a single set of coefficients for the field
+     * (and another for its rate of change).  The field at a point is then
+     * given by one spherical harmonic sum instead of two or three.  The
+     * combination costs about as much as evaluating the field at a single
+     * point.  The results agree with operator()() to within roundoff.
+     **********************************************************************/
+    MagneticSnapshot Snapshot(real t) const;
+
+    /**
+     * Let the point queries reuse the circles of latitude.
+     *
+     * @param[in] capacity the maximum number of MagneticCircle objects to
+     *   hold; 0 (the initial state) turns off the cache.
+     * @param[in] latquantum (optional) if positive, the latitude is rounded
+     *   to multiples of this value (degrees); default 0.
+     * @param[in] hquantum (optional) if positive, the height is rounded to
+     *   multiples of this value (meters); default 0.
+     * @exception GeographicErr if \e latquantum or \e hquantum is negative
+     *   or not finite.
+     *
+     * With the cache turned on, operator()() evaluates the field with a
+     * MagneticCircle for the latitude and height of the point which covers
+     * the epoch of the model containing \e t.  The circle is constructed
+     * with Circle() on the first visit to a parallel and thereafter each
+     * point on it costs only about \e N operations, instead of about
+     * <i>N</i><sup>2</sup>.  Because the circle holds the sums for the two
+     * models bracketing \e t, the results for all times within an epoch
+     * are exact and there's no need to quantize the time.  If the quanta
+     * are positive, the results are those for the rounded latitude and
+     * height.  The least recently used circles are dropped when the
+     * capacity is exceeded.  See CircleCache for more details.
+     *
+     * The cache is thread safe; however this function is not and must not
+     * be called while other threads are using the MagneticModel.
+     **********************************************************************/
+    void SetCircleCache(size_t capacity,
+                        real latquantum = 0, real hquantum = 0)
+    { _circles.Reset(capacity, latquantum, hquantum); }
+
+    /**
+     * @return the number of MagneticCircle objects in the cache.
+     **********************************************************************/
+    size_t CircleCacheSize() const { return _circles.Size(); }
+
+    /**
+     * @return the number of point queries satisfied with a cached circle.
+     **********************************************************************/
+    unsigned long long CircleCacheHits() const { return _circles.Hits(); }
+
+    /**
+     * @return the number of point queries which required a circle to be
+     *   constructed.
+     **********************************************************************/
+    unsigned long long CircleCacheMisses() const { return _circles.Misses(); }
+
+    /**
+     * Evaluate the components of the geomagnetic field on a grid.
+     *
+     * @param[in] t the time (years).
+     * @param[in] h the height above the ellipsoid of the grid (meters).
+     * @param[in] lat0 the latitude of the first row of the grid (degrees).
+     * @param[in] dlat the latitude spacing of the rows (degrees).
+     * @param[in] nlat the number of rows.
+     * @param[in] lon0 the longitude of the first column of the grid
+     *   (degrees).
+     * @param[in] dlon the longitude spacing of the columns (degrees).
+     * @param[in] nlon the number of columns.
+     * @param[out] Bx the raster of easterly components of the magnetic field
+     *   (nanotesla); the value at latitude \e lat0 + \e i \e dlat and
+     *   longitude \e lon0 + \e j \e dlon is stored in Bx[\e i \e nlon + \e
+     *   j].
+     * @param[out] By the raster of northerly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bz the raster of vertical (up) components of the magnetic
+     *   field (nanotesla).
+     * @param[in] threads the number of threads to use; if this is 0 (the
+     *   default), the number reported by std::thread::hardware_concurrency()
+     *   is used.
+     * @exception std::bad_alloc if the memory for the MagneticCircle objects
+     *   can't be allocated.
+     *
+     * A MagneticCircle is constructed for each row and the rows are handed
+     * out to the threads in turn.  The results are the same as calling
+     * operator()() for each point, except for roundoff.
+     **********************************************************************/
+    void FieldGrid(real t, real h, real lat0, real dlat, int nlat,
+                   real lon0, real dlon, int nlon,
+                   real Bx[], real By[], real Bz[],
+                   unsigned threads = 0) const;
+
+    /**
+     * Evaluate the components of the geomagnetic field at a point for many
+     * times.
+     *
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] lon longitude of the point (degrees).
+     * @param[in] h the height of the point above the ellipsoid (meters).
+     * @param[in] n the number of times.
+     * @param[in] t array of times (years).
+     * @param[out] Bx array of easterly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] By array of northerly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bz array of vertical (up) components of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bxt if non-null, array of the rates of change of \e Bx
+     *   (nT/yr).
+     * @param[out] Byt if non-null, array of the rates of change of \e By
+     *   (nT/yr).
+     * @param[out] Bzt if non-null, array of the rates of change of \e Bz
+     *   (nT/yr).
+     *
+     * \e Bxt, \e Byt, and \e Bzt should either all be null or all be
+     * non-null.  The spherical harmonic sums for each model (and its secular
+     * variation) are evaluated at most once, so the cost for each additional
+     * time is just a few multiplications.  The results are identical to
+     * calling operator()() for each time.
+     **********************************************************************/
+    void FieldTimeSeries(real lat, real lon, real h,
+                         size_t n, const real t[],
+                         real Bx[], real By[], real Bz[],
+                         real Bxt[] = nullptr, real Byt[] = nullptr,
+                         real Bzt[] = nullptr) const;
+
+    /**
+     * Evaluate the components of the geomagnetic field for arrays of times
+     * and positions.
+     *
+     * @param[in] n the number of points.
+     * @param[in] t array of times (years).
+     * @param[in] lat array of latitudes (degrees).
+     * @param[in] lon array of longitudes (degrees).
+     * @param[in] h array of heights above the ellipsoid (meters).
+     * @param[out] Bx array of easterly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] By array of northerly components of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bz array of vertical (up) components of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bxt if non-null, array of the rates of change of \e Bx
+     *   (nT/yr).
+     * @param[out] Byt if non-null, array of the rates of change of \e By
+     *   (nT/yr).
+     * @param[out] Bzt if non-null, array of the rates of change of \e Bz
+     *   (nT/yr).
+     *
+     * The entries which share a position (the same \e lat, \e lon, and \e
+     * h) are evaluated together with FieldTimeSeries(); the rest are
+     * evaluated individually.  The results are identical to calling
+     * operator()() for each entry.
+     **********************************************************************/
+    void FieldBatch(size_t n, const real t[], const real lat[],
+                    const real lon[], const real h[],
+                    real Bx[], real By[], real Bz[],
+                    real Bxt[] = nullptr, real Byt[] = nullptr,
+                    real Bzt[] = nullptr) const;
+
     /**
      * Compute the magnetic field in geocentric coordinate.
      *
@@ -221,6 +554,44 @@ namespace GeographicLib {
                          real& BX, real& BY, real& BZ,
                          real& BXt, real& BYt, real& BZt) const;
 
+    /**
+     * Compute the magnetic field in geocentric coordinates at several points
+     * on a radial line.
+     *
+     * @param[in] t the time (years).
+     * @param[in] X geocentric coordinate of a point on the line (meters).
+     * @param[in] Y geocentric coordinate of a point on the line (meters).
+     * @param[in] Z geocentric coordinate of a point on the line (meters).
+     * @param[in] n the number of points.
+     * @param[in] r array of the geocentric radii of the points (meters).
+     * @param[out] BX array of the \e X components of the magnetic field (nT).
+     * @param[out] BY array of the \e Y components of the magnetic field (nT).
+     * @param[out] BZ array of the \e Z components of the magnetic field (nT).
+     * @param[out] BXt if non-null, array of the rates of change of \e BX
+     *   (nT/yr).
+     * @param[out] BYt if non-null, array of the rates of change of \e BY
+     *   (nT/yr).
+     * @param[out] BZt if non-null, array of the rates of change of \e BZ
+     *   (nT/yr).
+     * @exception std::bad_alloc if the memory for the RadialEngine objects
+     *   can't be allocated.
+     *
+     * The points lie on the ray from the center of the earth through (\e X,
+     * \e Y, \e Z) at radii <i>r</i><sub><i>i</i></sub>; the results are the
+     * same as FieldGeocentric() at each point.  The sums over order, which
+     * depend only on the direction of the ray, are done once (see
+     * SphericalHarmonic::Radial); each point then costs only about \e N
+     * operations.  Note that points with the same geodetic latitude and
+     * longitude, but different heights, lie on a radial line only at the
+     * equator and the poles.  The rates of change are only computed if \e
+     * BXt, \e BYt, and \e BZt are all non-null.
+     **********************************************************************/
+    void FieldGeocentricColumn(real t, real X, real Y, real Z,
+                               size_t n, const real r[],
+                               real BX[], real BY[], real BZ[],
+                               real BXt[] = nullptr, real BYt[] = nullptr,
+                               real BZt[] = nullptr) const;
+
     /**
      * Compute various quantities dependent on the magnetic field.
      *
@@ -288,6 +659,37 @@ namespace GeographicLib {
      **********************************************************************/
     const std::string& MagneticFile() const { return _filename; }
 
+    /**
+     * @return the number of bytes read from the coefficient file (the
+     *   file name with ".cof" appended).
+     **********************************************************************/
+    unsigned long long LoadBytes() const { return _loadbytes; }
+
+    /**
+     * @return true if the coefficient file is mapped into memory.  In this
+     *   case, LoadBytes() is the size of the mapped file.
+     **********************************************************************/
+    bool Mapped() const { return _store->map.data() != nullptr; }
+
+    /**
+     * @return the time taken to read the magnetic model data files (seconds).
+     *
+     * The data files are only read by the constructor, so this and
+     * LoadBytes() give the complete I/O statistics for the magnetic model.
+     **********************************************************************/
+    double LoadTime() const { return _loadtime; }
+
+    /**
+     * @return an estimate of the number of bytes of heap memory used by the
+     *   magnetic model (this excludes sizeof(MagneticModel)).
+     *
+     * This includes the coefficients (unless they are used in place in a
+     * mapped file; see Mapped()) and the circles in the circle cache.  The
+     * coefficients are shared by copies of the model; each copy includes
+     * them in its count.
+     **********************************************************************/
+    size_t MemoryUsage() const;
+
     /**
      * @return "name" used to load the magnetic model (from the first argument
      *   of the constructor, but this may be overridden by the model file).
@@ -395,6 +797,17 @@ namespace GeographicLib {
      * object.
      **********************************************************************/
     static std::string DefaultMagneticName();
+
+    /**
+     * @return the names of the magnetic models compiled into the library.
+     *
+     * The models to include are specified when the library is built with
+     * cmake by setting GEOGRAPHICLIB_MAGNETIC_MODELS to a list of names,
+     * e.g., "wmm2020;igrf13"; the data files for these models are read from
+     * GEOGRAPHICLIB_MAGNETIC_MODELS_DIR when the library is compiled.  By
+     * default, no models are compiled in.
+     **********************************************************************/
+    static std::vector<std::string> EmbeddedModels();
   };
 
 } // namespace GeographicLib
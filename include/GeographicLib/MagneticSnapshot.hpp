@@ -0,0 +1,204 @@
+/**
+ * \file MagneticSnapshot.hpp
+ * \brief Header for GeographicLib::MagneticSnapshot class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_MAGNETICSNAPSHOT_HPP)
+#define GEOGRAPHICLIB_MAGNETICSNAPSHOT_HPP 1
+
+#include <memory>
+#include <vector>
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Geocentric.hpp>
+#include <GeographicLib/SphericalHarmonic.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs shared_ptr
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief Geomagnetic field at a fixed time
+   *
+   * Evaluate the earth's magnetic field at a fixed time.  MagneticModel
+   * evaluates the spherical harmonic sums for the two models bracketing the
+   * time (and for the constant terms, if any) and combines the results.
+   * Because the sums are linear in the coefficients, the coefficients for a
+   * particular time can instead be combined once; a MagneticSnapshot holds
+   * these combined coefficients so that the field at each point requires a
+   * single spherical harmonic sum (and a second one for the rate of change
+   * of the field).  This is useful when many points are evaluated at the
+   * same time, e.g., the points of a survey or a real-time stream.
+   *
+   * Use MagneticModel::Snapshot to create a MagneticSnapshot object.  (The
+   * constructor for this class is private.)  The object holds its own copy
+   * of the combined coefficients and so may outlive the MagneticModel.
+   * Copies of the object share the coefficients.
+   *
+   * Example of use:
+   * \code
+   * MagneticModel mag("wmm2020");
+   * const MagneticSnapshot snap(mag.Snapshot(2022.5));
+   * real Bx, By, Bz;
+   * snap(lat, lon, h, Bx, By, Bz);
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT MagneticSnapshot {
+  private:
+    typedef Math::real real;
+
+    real _t;
+    int _nmx, _mmx;
+    Geocentric _earth;
+    // The combined coefficients for the field and its rate of change; these
+    // include the factor -a which converts the gradient of the sum to the
+    // field.
+    struct coeffstore {
+      std::vector<real> G, H, Gt, Ht;
+    };
+    std::shared_ptr<const coeffstore> _store;
+    SphericalHarmonic _harm, _harmt;
+
+    MagneticSnapshot(real t, real a, SphericalHarmonic::normalization norm,
+                     const Geocentric& earth, int nmx, int mmx,
+                     const std::shared_ptr<const coeffstore>& store);
+
+    void Field(real lat, real lon, real h, bool diffp,
+               real& Bx, real& By, real& Bz,
+               real& Bxt, real& Byt, real& Bzt) const;
+
+    friend class MagneticModel; // MagneticModel calls the constructor
+
+  public:
+
+    /**
+     * A default constructor for the snapshot.  This sets up an
+     * uninitialized object which can be later replaced by the
+     * MagneticModel::Snapshot.
+     **********************************************************************/
+    MagneticSnapshot() : _t(Math::NaN()), _nmx(-1), _mmx(-1) {}
+
+    /** \name Compute the magnetic field
+     **********************************************************************/
+    ///@{
+    /**
+     * Evaluate the components of the geomagnetic field.
+     *
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] lon longitude of the point (degrees).
+     * @param[in] h the height of the point above the ellipsoid (meters).
+     * @param[out] Bx the easterly component of the magnetic field (nanotesla).
+     * @param[out] By the northerly component of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bz the vertical (up) component of the magnetic field
+     *   (nanotesla).
+     *
+     * This gives the same results as MagneticModel::operator()(\e t, \e lat,
+     * \e lon, \e h, \e Bx, \e By, \e Bz) with \e t = Time().
+     **********************************************************************/
+    void operator()(real lat, real lon, real h,
+                    real& Bx, real& By, real& Bz) const {
+      real dummy;
+      Field(lat, lon, h, false, Bx, By, Bz, dummy, dummy, dummy);
+    }
+
+    /**
+     * Evaluate the components of the geomagnetic field and their time
+     * derivatives.
+     *
+     * @param[in] lat latitude of the point (degrees).
+     * @param[in] lon longitude of the point (degrees).
+     * @param[in] h the height of the point above the ellipsoid (meters).
+     * @param[out] Bx the easterly component of the magnetic field (nanotesla).
+     * @param[out] By the northerly component of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bz the vertical (up) component of the magnetic field
+     *   (nanotesla).
+     * @param[out] Bxt the rate of change of \e Bx (nT/yr).
+     * @param[out] Byt the rate of change of \e By (nT/yr).
+     * @param[out] Bzt the rate of change of \e Bz (nT/yr).
+     *
+     * The time derivatives require a second spherical harmonic sum.
+     **********************************************************************/
+    void operator()(real lat, real lon, real h,
+                    real& Bx, real& By, real& Bz,
+                    real& Bxt, real& Byt, real& Bzt) const {
+      Field(lat, lon, h, true, Bx, By, Bz, Bxt, Byt, Bzt);
+    }
+
+    /**
+     * Compute the magnetic field in geocentric coordinates.
+     *
+     * @param[in] X geocentric coordinate (meters).
+     * @param[in] Y geocentric coordinate (meters).
+     * @param[in] Z geocentric coordinate (meters).
+     * @param[out] BX the \e X component of the magnetic field (nT).
+     * @param[out] BY the \e Y component of the magnetic field (nT).
+     * @param[out] BZ the \e Z component of the magnetic field (nT).
+     **********************************************************************/
+    void FieldGeocentric(real X, real Y, real Z,
+                         real& BX, real& BY, real& BZ) const
+    { _harm(X, Y, Z, BX, BY, BZ); }
+
+    /**
+     * Compute the magnetic field and its rate of change in geocentric
+     * coordinates.
+     *
+     * @param[in] X geocentric coordinate (meters).
+     * @param[in] Y geocentric coordinate (meters).
+     * @param[in] Z geocentric coordinate (meters).
+     * @param[out] BX the \e X component of the magnetic field (nT).
+     * @param[out] BY the \e Y component of the magnetic field (nT).
+     * @param[out] BZ the \e Z component of the magnetic field (nT).
+     * @param[out] BXt the rate of change of \e BX (nT/yr).
+     * @param[out] BYt the rate of change of \e BY (nT/yr).
+     * @param[out] BZt the rate of change of \e BZ (nT/yr).
+     **********************************************************************/
+    void FieldGeocentric(real X, real Y, real Z,
+                         real& BX, real& BY, real& BZ,
+                         real& BXt, real& BYt, real& BZt) const {
+      _harm(X, Y, Z, BX, BY, BZ);
+      _harmt(X, Y, Z, BXt, BYt, BZt);
+    }
+    ///@}
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return true if the object has been initialized.
+     **********************************************************************/
+    bool Init() const { return bool(_store); }
+
+    /**
+     * @return the time of the snapshot (years).
+     **********************************************************************/
+    Math::real Time() const { return _t; }
+
+    /**
+     * @return \e Nmax the maximum degree of the combined coefficients.
+     **********************************************************************/
+    int Degree() const { return _nmx; }
+
+    /**
+     * @return \e Mmax the maximum order of the combined coefficients.
+     **********************************************************************/
+    int Order() const { return _mmx; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_MAGNETICSNAPSHOT_HPP
@@ -0,0 +1,143 @@
+/**
+ * \file MappedInput.hpp
+ * \brief Header for GeographicLib::MappedInput class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_MAPPEDINPUT_HPP)
+#define GEOGRAPHICLIB_MAPPEDINPUT_HPP 1
+
+#include <istream>
+#include <fstream>
+#include <string>
+#include <GeographicLib/Constants.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs string
+#  pragma warning (push)
+#  pragma warning (disable: 4251 4275)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief An input file stream backed by a memory mapping
+   *
+   * This is a replacement for std::ifstream for reading files.  A regular
+   * file is mapped into memory (with mmap on POSIX systems) and the
+   * mapping serves as the buffer of the stream, so that reading from the
+   * stream involves no system calls and no copying into an intermediate
+   * buffer.  If the file can't be mapped (e.g., it's a pipe or the system
+   * doesn't support mmap), it is read through a std::filebuf.  In both
+   * cases, the stream behaves the same as std::ifstream.
+   *
+   * In addition, NextLine returns the lines of the file without copying
+   * them when the file is mapped.
+   *
+   * Example of use:
+   * \code
+   * MappedInput in;
+   * in.open("points.txt");
+   * const char* line; size_t len;
+   * while (in.NextLine(line, len)) {
+   *   // process the len characters at line
+   * }
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT MappedInput : public std::istream {
+  private:
+    // A streambuf whose get area is the mapped file
+    class mapbuf : public std::streambuf {
+    public:
+      void set(char* b, char* e) { setg(b, b, e); }
+      bool line(const char*& p, size_t& n);
+    };
+    mapbuf _map;
+    std::filebuf _file;
+    void* _addr;
+    size_t _size;
+    bool _mapped;
+    std::string _line;
+    MappedInput(const MappedInput&) = delete;
+    MappedInput& operator=(const MappedInput&) = delete;
+  public:
+
+    /**
+     * Constructor for a MappedInput which isn't associated with a file.
+     **********************************************************************/
+    MappedInput();
+
+    /**
+     * Constructor which opens a file.
+     *
+     * @param[in] file the name of the file.
+     * @param[in] mode the mode used if the file is read through a
+     *   std::filebuf (std::ios::in is always added).
+     *
+     * If the file can't be opened, the failbit is set.
+     **********************************************************************/
+    explicit MappedInput(const std::string& file,
+                         std::ios::openmode mode = std::ios::in);
+
+    /**
+     * The destructor unmaps or closes the file.
+     **********************************************************************/
+    ~MappedInput() override;
+
+    /**
+     * Open a file.
+     *
+     * @param[in] file the name of the file.
+     * @param[in] mode the mode used if the file is read through a
+     *   std::filebuf (std::ios::in is always added).
+     *
+     * Any file that was open is first closed.  The state of the stream is
+     * cleared on success; otherwise the failbit is set.
+     **********************************************************************/
+    void open(const std::string& file,
+              std::ios::openmode mode = std::ios::in);
+
+    /**
+     * @return true if a file is open.
+     **********************************************************************/
+    bool is_open() const { return _mapped || _file.is_open(); }
+
+    /**
+     * Close the file.
+     **********************************************************************/
+    void close();
+
+    /**
+     * Read the next line.
+     *
+     * @param[out] line a pointer to the first character of the line.
+     * @param[out] len the number of characters in the line (excluding the
+     *   terminating newline).
+     * @return true if a line was read; otherwise the eofbit and failbit are
+     *   set.
+     *
+     * This is equivalent to std::getline followed by taking the data and
+     * size of the string.  If the file is mapped, \e line points into the
+     * mapping and is valid until the file is closed; otherwise \e line is
+     * valid until the next call to NextLine.  The line isn't
+     * null-terminated.
+     **********************************************************************/
+    bool NextLine(const char*& line, size_t& len);
+
+    /**
+     * @return true if the file is read through a memory mapping.
+     **********************************************************************/
+    bool Mapped() const { return _mapped; }
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_MAPPEDINPUT_HPP
@@ -35,6 +35,19 @@
 #  define GEOGRAPHICLIB_PRECISION 2
 #endif
 
+#if !defined(GEOGRAPHICLIB_INLINE_MATH)
+/**
+ * Make the definitions of the scalar functions in Math, e.g., Math::sincosd
+ * and Math::atan2d, visible to the calling code so that the compiler can
+ * inline them?  By default (0), these are compiled into the library and
+ * calls to them from outside the library can't be inlined (except by link
+ * time optimization of a static library; see GEOGRAPHICLIB_LTO).  Define
+ * this to be 1 before including any %GeographicLib header to include
+ * MathInline.hpp.  The library doesn't need to be rebuilt.
+ **********************************************************************/
+#  define GEOGRAPHICLIB_INLINE_MATH 0
+#endif
+
 #include <cmath>
 #include <algorithm>
 #include <limits>
@@ -402,7 +415,13 @@ namespace GeographicLib {
     template<typename T> static T polyval(int N, const T p[], T x) {
     // This used to employ Math::fma; but that's too slow and it seemed not to
     // improve the accuracy noticeably.  This might change when there's direct
-    // hardware support for fma.
+    // hardware support for fma.  Even with hardware fma (x86-64, -march=native)
+    // std::fma here made C3f + C4f 35% slower, while Estrin's scheme with the
+    // order fixed at compile time was 8% slower (and no better with fma).  The
+    // series code evaluates several independent polynomials together (e.g.,
+    // in C3f and C4f, where the compiler unrolls the loop because the orders
+    // are constants); so the latency of each Horner chain is hidden and the
+    // extra multiplications in Estrin's scheme only add to the cost.
       T y = N < 0 ? 0 : *p++;
       while (--N >= 0) y = y * x + *p++;
       return y;
@@ -565,6 +584,67 @@ namespace GeographicLib {
      **********************************************************************/
    template<typename T> static T atand(T x);
 
+    /**
+     * Evaluate sincosd for an array of arguments.
+     *
+     * @tparam T the type of the arguments.
+     * @param[in] n the number of arguments.
+     * @param[in] x array of angles in degrees.
+     * @param[out] sinx array of sin(<i>x</i>).
+     * @param[out] cosx array of cos(<i>x</i>).
+     *
+     * The results are identical to calling sincosd for each element.  The
+     * reduction of the arguments, which is done with remquo in sincosd, is
+     * carried out exactly with arithmetic which the compiler can vectorize;
+     * arguments larger than about 2<sup>\e p &minus; 8</sup> in magnitude
+     * (where \e p is the number of bits in the fraction of \e T), and
+     * infinities and NaNs, are passed to sincosd.  The sines and cosines of
+     * the reduced arguments are evaluated by the same (scalar) library
+     * functions as in sincosd; this guarantees that the results are the same
+     * and that they don't depend on the instruction set.  The output arrays
+     * may coincide with \e x.
+     **********************************************************************/
+    template<typename T> static void sincosdBatch(size_t n, const T x[],
+                                                  T sinx[], T cosx[]);
+
+    /**
+     * Evaluate atan2d for arrays of arguments.
+     *
+     * @tparam T the type of the arguments and the returned values.
+     * @param[in] n the number of arguments.
+     * @param[in] y array of \e y values.
+     * @param[in] x array of \e x values.
+     * @param[out] ang array of atan2(<i>y</i>, <i>x</i>) in degrees.
+     *
+     * The results are identical to calling atan2d for each element; the
+     * rearrangement of the arguments and the mapping of the results to the
+     * correct quadrant are done in separate passes which the compiler can
+     * vectorize.  \e ang may coincide with \e x or \e y.
+     **********************************************************************/
+    template<typename T> static void atan2dBatch(size_t n,
+                                                 const T y[], const T x[],
+                                                 T ang[]);
+
+    /**
+     * Evaluate AngDiff for arrays of arguments.
+     *
+     * @tparam T the type of the arguments and the returned values.
+     * @param[in] n the number of arguments.
+     * @param[in] x array of first angles in degrees.
+     * @param[in] y array of second angles in degrees.
+     * @param[out] d array of the truncated values of \e y &minus; \e x.
+     * @param[out] e array of the error terms in degrees; this may be null.
+     *
+     * The results are identical to calling AngDiff for each element.  The
+     * calls to remainder in AngDiff are replaced by an exact reduction as
+     * in sincosdBatch, so that no library functions are called for
+     * arguments less than about 2<sup>\e p &minus; 8</sup> in magnitude.
+     * The output arrays may coincide with \e x or \e y.
+     **********************************************************************/
+    template<typename T> static void AngDiffBatch(size_t n,
+                                                  const T x[], const T y[],
+                                                  T d[], T e[] = nullptr);
+
     /**
      * Evaluate <i>e</i> atanh(<i>e x</i>)
      *
@@ -681,4 +761,8 @@ namespace GeographicLib {
 
 } // namespace GeographicLib
 
+#if GEOGRAPHICLIB_INLINE_MATH
+#  include <GeographicLib/MathInline.hpp>
+#endif
+
 #endif  // GEOGRAPHICLIB_MATH_HPP
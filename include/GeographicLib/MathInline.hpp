@@ -0,0 +1,191 @@
+/**
+ * \file MathInline.hpp
+ * \brief Definitions of the scalar GeographicLib::Math functions
+ *
+ * These definitions are compiled into the library (by Math.cpp).  They are
+ * also made visible to the calling code, so that they can be inlined into
+ * it, if GEOGRAPHICLIB_INLINE_MATH is set to 1 before Math.hpp is included.
+ *
+ * Copyright (c) Charles Karney (2008-2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_MATHINLINE_HPP)
+#define GEOGRAPHICLIB_MATHINLINE_HPP 1
+
+#include <GeographicLib/Math.hpp>
+#include <utility>
+
+#if defined(_MSC_VER)
+// Squelch warnings about constant conditional expressions
+#  pragma warning (push)
+#  pragma warning (disable: 4127)
+#endif
+
+namespace GeographicLib {
+
+  /// \cond SKIP
+
+  template<typename T> inline T Math::hypot(T x, T y) {
+    using std::hypot; return hypot(x, y);
+  }
+
+  template<typename T> inline T Math::expm1(T x) {
+    using std::expm1; return expm1(x);
+  }
+
+  template<typename T> inline T Math::log1p(T x) {
+    using std::log1p; return log1p(x);
+  }
+
+  template<typename T> inline T Math::asinh(T x) {
+    using std::asinh; return asinh(x);
+  }
+
+  template<typename T> inline T Math::atanh(T x) {
+    using std::atanh; return atanh(x);
+  }
+
+  template<typename T> inline T Math::copysign(T x, T y) {
+    using std::copysign; return copysign(x, y);
+  }
+
+  template<typename T> inline T Math::cbrt(T x) {
+    using std::cbrt; return cbrt(x);
+  }
+
+  template<typename T> inline T Math::remainder(T x, T y) {
+    using std::remainder; return remainder(x, y);
+  }
+
+  template<typename T> inline T Math::remquo(T x, T y, int* n) {
+    using std::remquo; return remquo(x, y, n);
+  }
+
+  template<typename T> inline T Math::round(T x) {
+    using std::round; return round(x);
+  }
+
+  template<typename T> inline long Math::lround(T x) {
+    using std::lround; return lround(x);
+  }
+
+  template<typename T> inline T Math::fma(T x, T y, T z) {
+    using std::fma; return fma(x, y, z);
+  }
+
+  template<typename T> inline T Math::sum(T u, T v, T& t) {
+    GEOGRAPHICLIB_VOLATILE T s = u + v;
+    GEOGRAPHICLIB_VOLATILE T up = s - v;
+    GEOGRAPHICLIB_VOLATILE T vpp = s - up;
+    up -= u;
+    vpp -= v;
+    t = -(up + vpp);
+    // u + v =       s      + t
+    //       = round(u + v) + t
+    return s;
+  }
+
+  template<typename T> inline T Math::AngRound(T x) {
+    using std::abs;
+    static const T z = 1/T(16);
+    if (x == 0) return 0;
+    GEOGRAPHICLIB_VOLATILE T y = abs(x);
+    // The compiler mustn't "simplify" z - (z - y) to y
+    y = y < z ? z - (z - y) : y;
+    return x < 0 ? -y : y;
+  }
+
+  template<typename T> inline void Math::sincosd(T x, T& sinx, T& cosx) {
+    // In order to minimize round-off errors, this function exactly reduces
+    // the argument to the range [-45, 45] before converting it to radians.
+    using std::remquo; using std::sin; using std::cos;
+    T r; int q = 0;
+    // N.B. the implementation of remquo in glibc pre 2.22 were buggy.  See
+    // https://sourceware.org/bugzilla/show_bug.cgi?id=17569
+    // This was fixed in version 2.22 on 2015-08-05
+    r = remquo(x, T(90), &q);   // now abs(r) <= 45
+    r *= degree<T>();
+    // g++ -O turns these two function calls into a call to sincos
+    T s = sin(r), c = cos(r);
+    switch (unsigned(q) & 3U) {
+    case 0U: sinx =  s; cosx =  c; break;
+    case 1U: sinx =  c; cosx = -s; break;
+    case 2U: sinx = -s; cosx = -c; break;
+    default: sinx = -c; cosx =  s; break; // case 3U
+    }
+    // Set sign of 0 results.  -0 only produced for sin(-0)
+    if (x != 0) { sinx += T(0); cosx += T(0); }
+  }
+
+  template<typename T> inline T Math::sind(T x) {
+    // See sincosd
+    using std::remquo; using std::sin; using std::cos;
+    T r; int q = 0;
+    r = remquo(x, T(90), &q); // now abs(r) <= 45
+    r *= degree<T>();
+    unsigned p = unsigned(q);
+    r = p & 1U ? cos(r) : sin(r);
+    if (p & 2U) r = -r;
+    if (x != 0) r += T(0);
+    return r;
+  }
+
+  template<typename T> inline T Math::cosd(T x) {
+    // See sincosd
+    using std::remquo; using std::sin; using std::cos;
+    T r; int q = 0;
+    r = remquo(x, T(90), &q); // now abs(r) <= 45
+    r *= degree<T>();
+    unsigned p = unsigned(q + 1);
+    r = p & 1U ? cos(r) : sin(r);
+    if (p & 2U) r = -r;
+    return T(0) + r;
+  }
+
+  template<typename T> inline T Math::tand(T x) {
+    static const T overflow = 1 / sq(std::numeric_limits<T>::epsilon());
+    T s, c;
+    sincosd(x, s, c);
+    return c != 0 ? s / c : (s < 0 ? -overflow : overflow);
+  }
+
+  template<typename T> inline T Math::atan2d(T y, T x) {
+    // In order to minimize round-off errors, this function rearranges the
+    // arguments so that result of atan2 is in the range [-pi/4, pi/4] before
+    // converting it to degrees and mapping the result to the correct
+    // quadrant.
+    using std::abs; using std::atan2; using std::swap;
+    int q = 0;
+    if (abs(y) > abs(x)) { swap(x, y); q = 2; }
+    if (x < 0) { x = -x; ++q; }
+    // here x >= 0 and x >= abs(y), so angle is in [-pi/4, pi/4]
+    T ang = atan2(y, x) / degree<T>();
+    switch (q) {
+      // Note that atan2d(-0.0, 1.0) will return -0.  However, we expect that
+      // atan2d will not be called with y = -0.  If need be, include
+      //
+      //   case 0: ang = 0 + ang; break;
+      //
+      // and handle mpfr as in AngRound.
+    case 1: ang = (y >= 0 ? 180 : -180) - ang; break;
+    case 2: ang =  90 - ang; break;
+    case 3: ang = -90 + ang; break;
+    default: break;
+    }
+    return ang;
+  }
+
+  template<typename T> inline T Math::atand(T x)
+  { return atan2d(x, T(1)); }
+
+  /// \endcond
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_MATHINLINE_HPP
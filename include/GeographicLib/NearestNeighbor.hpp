@@ -15,12 +15,18 @@
 #include <queue>                // for priority_queue
 #include <utility>              // for swap + pair
 #include <cstring>
+#include <cstdint>             // for uintptr_t
 #include <limits>
 #include <cmath>
 #include <iostream>
 #include <sstream>
-// Only for GeographicLib::GeographicErr
+#include <thread>
+#include <memory>                // for shared_ptr
+#include <string>
+// Only for GeographicLib::GeographicErr and GeographicLib::Executor
 #include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <GeographicLib/Trace.hpp>
 
 #if defined(GEOGRAPHICLIB_HAVE_BOOST_SERIALIZATION) && \
   GEOGRAPHICLIB_HAVE_BOOST_SERIALIZATION
@@ -30,6 +36,14 @@
 #include <boost/serialization/vector.hpp>
 #endif
 
+#if !defined(_WIN32)
+// For mmap
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions
 #  pragma warning (push)
@@ -59,7 +73,29 @@ namespace GeographicLib {
    *   constructed with a Geodesic object and which implements a member
    *   function with a signature <code>dist_t operator() (const pos_t&, const
    *   pos_t&) const</code>, which returns the geodesic distance between two
-   *   points.
+   *   points.  GeographicLib::GeodesicMetric is such a class.
+   *
+   * If \e distfun_t also has a member function <code>void Bounds(const
+   * pos_t& a, const pos_t& b, dist_t& lo, dist_t& hi) const</code>, which
+   * returns cheap lower and upper bounds on the distance between \e a and \e
+   * b, Search() uses these to avoid the distance calculation whenever the
+   * bounds suffice to determine how the search should proceed.  The results
+   * of the search are unchanged; however the search cost reported by
+   * Statistics() counts only the distance calculations which were actually
+   * carried out.
+   *
+   * If \e distfun_t has a member function <code>void Distances(const
+   * std::vector<pos_t>& pts, const int ind[], int n, const pos_t& query,
+   * dist_t d[]) const</code>, which sets <i>d</i><sub><i>j</i></sub> to the
+   * distance between <i>pts</i>[<i>ind</i><sub><i>j</i></sub>] and \e query
+   * for \e j in [0, \e n), Search() calls it once for each leaf bucket it
+   * visits instead of computing the distances one at a time (and Bounds()
+   * is then only used for the vantage points).  This lets the distance
+   * function use SIMD instructions for the calculation.  After Renumber(),
+   * the points in each bucket are consecutive, so a distance function
+   * which keeps its own copy of the coordinates of the points as separate
+   * arrays can compute the distances with contiguous vector loads.
+   * GeographicLib::ChordMetric is such a class.
    *
    * \note The distance measure must satisfy the triangle inequality, \f$
    * d(a,c) \le d(a,b) + d(b,c) \f$ for all points \e a, \e b, \e c.  The
@@ -70,11 +106,17 @@ namespace GeographicLib {
    * square root in the interests of "efficiency"; the squared distance does
    * not satisfy the triangle inequality!
    *
-   * \note This is a "header-only" implementation and, as such, depends in a
-   * minimal way on the rest of GeographicLib (the only dependency is through
-   * the use of GeographicLib::GeographicErr for handling compile-time and
-   * run-time exceptions).  Therefore, it is easy to extract this class from
-   * the rest of GeographicLib and use it as a stand-alone facility.
+   * \note This class is implemented in the header; however, it is no
+   * longer "header-only".  The parallel parts of the calculations (used by
+   * the constructor, Initialize(), Rebuild(), SearchBatch(), and
+   * ReadMapped()) are run by GeographicLib::Executor::Parallel, which is
+   * compiled into the library; so a program using this class must be linked
+   * with GeographicLib, even if it only uses one thread.  Otherwise, it
+   * depends on the rest of GeographicLib only through the use of
+   * GeographicLib::GeographicErr for handling compile-time and run-time
+   * exceptions.  To extract this class from GeographicLib and use it as a
+   * stand-alone facility, replace the calls to Executor::Parallel with a
+   * loop over the tasks (or with your own thread pool).
    *
    * The \e dist_t type must support numeric_limits queries (specifically:
    * is_signed, is_integer, max(), digits).
@@ -85,9 +127,13 @@ namespace GeographicLib {
    * it's necessary to supply the same vector of points and the same distance
    * function.
    *
-   * There's no capability in this implementation to add or remove points from
-   * the set.  Instead Initialize() should be called to re-initialize the
-   * object with the modified vector of points.
+   * Points can be added to the set with Insert() and removed with Remove();
+   * see Insert() for the contract between these functions and the vector of
+   * points.  A removed point stays in the tree (as a vantage point) until
+   * the part of the tree containing it is rebuilt and the tree rebuilds
+   * parts of itself that become unbalanced or contain too many removed
+   * points.  So searches after many updates cost about the same as for a
+   * freshly built tree.
    *
    * Because of the overhead in constructing a NearestNeighbor object for a
    * large set of points, functions Save() and Load() are provided to save the
@@ -115,7 +161,8 @@ namespace GeographicLib {
      *
      * This is equivalent to specifying an empty set of points.
      **********************************************************************/
-    NearestNeighbor() : _numpoints(0), _bucket(0), _cost(0) {}
+    NearestNeighbor() : _numpoints(0), _bucket(0), _cost(0), _nmapped(0),
+                        _root(-1), _nremoved(0), _dyn(false) {}
 
     /**
      * Constructor for NearestNeighbor.
@@ -145,10 +192,12 @@ namespace GeographicLib {
      *
      * \warning The same arguments \e pts and \e dist must be provided
      * to the Search() function.
+     *
+     * See Initialize() for a description of \e threads.
      **********************************************************************/
     NearestNeighbor(const std::vector<pos_t>& pts, const distfun_t& dist,
-                    int bucket = 4) {
-      Initialize(pts, dist, bucket);
+                    int bucket = 4, unsigned threads = 1) {
+      Initialize(pts, dist, bucket, threads);
     }
 
     /**
@@ -158,17 +207,28 @@ namespace GeographicLib {
      * @param[in] dist the distance function object.
      * @param[in] bucket the size of the buckets at the leaf nodes; this must
      *   lie in [0, 2 + 4*sizeof(dist_t)/sizeof(int)] (default 4).
+     * @param[in] threads the number of threads to use to build the tree
+     *   (default 1); if this is 0, the number reported by
+     *   std::thread::hardware_concurrency() is used.
      * @exception GeographicErr if the value of \e bucket is out of bounds or
      *   the size of \e pts is too big for an int.
      * @exception std::bad_alloc if memory for the tree can't be allocated.
      *
      * See also the documentation on the constructor.
      *
+     * If \e threads > 1, the distances from the vantage point of a large
+     * node are computed in parallel and the two subtrees of a node are built
+     * concurrently.  The resulting tree is identical to the one built with
+     * \e threads = 1.  In this case, \e dist will be called from several
+     * threads at once and must be safe to use in this way (this is the case
+     * if it just calls Geodesic::Inverse, for example).
+     *
      * If an exception is thrown, the state of the NearestNeighbor is
      * unchanged.
      **********************************************************************/
     void Initialize(const std::vector<pos_t>& pts, const distfun_t& dist,
-                    int bucket = 4) {
+                    int bucket = 4, unsigned threads = 1) {
+      GEOGRAPHICLIB_TRACE_SCOPE1(nn__initialize, pts.size());
       static_assert(std::numeric_limits<dist_t>::is_signed,
                     "dist_t must be a signed type");
       if (!( 0 <= bucket && bucket <= maxbucket ))
@@ -182,9 +242,16 @@ namespace GeographicLib {
         ids[k] = std::make_pair(dist_t(0), k);
       int cost = 0;
       std::vector<Node> tree;
-      init(pts, dist, bucket, tree, ids, cost,
-           0, int(ids.size()), int(ids.size()/2));
+      if (threads == 0) threads = std::thread::hardware_concurrency();
+      if (threads > 1)
+        initpar(pts, dist, bucket, tree, ids, cost,
+                0, int(ids.size()), int(ids.size()/2), threads);
+      else
+        init(pts, dist, bucket, tree, ids, cost,
+             0, int(ids.size()), int(ids.size()/2));
       _tree.swap(tree);
+      _mapped.reset(); _nmapped = 0;
+      resetdynamic();
       _numpoints = int(pts.size());
       _bucket = bucket;
       _mc = _sc = 0;
@@ -263,79 +330,83 @@ namespace GeographicLib {
                   dist_t mindist = -1,
                   bool exhaustive = true,
                   dist_t tol = 0) const {
+      GEOGRAPHICLIB_TRACE_SCOPE1(nn__search, size_t(1));
       if (_numpoints != int(pts.size()))
           throw GeographicLib::GeographicErr("pts array has wrong size");
       std::priority_queue<item> results;
-      if (_numpoints > 0 && k > 0 && maxdist > mindist) {
-        // distance to the kth closest point so far
-        dist_t tau = maxdist;
-        // first is negative of how far query is outside boundary of node
-        // +1 if on boundary or inside
-        // second is node index
-        std::priority_queue<item> todo;
-        todo.push(std::make_pair(dist_t(1), int(_tree.size()) - 1));
-        int c = 0;
-        while (!todo.empty()) {
-          int n = todo.top().second;
-          dist_t d = -todo.top().first;
-          todo.pop();
-          dist_t tau1 = tau - tol;
-          // compare tau and d again since tau may have become smaller.
-          if (!( n >= 0 && tau1 >= d )) continue;
-          const Node& current = _tree[n];
-          dist_t dst = 0;   // to suppress warning about uninitialized variable
-          bool exitflag = false, leaf = current.index < 0;
-          for (int i = 0; i < (leaf ? _bucket : 1); ++i) {
-            int index = leaf ? current.leaves[i] : current.index;
-            if (index < 0) break;
-            dst = dist(pts[index], query);
-            ++c;
+      int c = search(pts, dist, query, results,
+                     k, maxdist, mindist, exhaustive, tol);
+      if (c >= 0) accum(c);
 
-            if (dst > mindist && dst <= tau) {
-              if (int(results.size()) == k) results.pop();
-              results.push(std::make_pair(dst, index));
-              if (int(results.size()) == k) {
-                if (exhaustive)
-                  tau = results.top().first;
-                else {
-                  exitflag = true;
-                  break;
-                }
-                if (tau <= tol) {
-                  exitflag = true;
-                  break;
-                }
-              }
-            }
-          }
-          if (exitflag) break;
-
-          if (current.index < 0) continue;
-          tau1 = tau - tol;
-          for (int l = 0; l < 2; ++l) {
-            if (current.data.child[l] >= 0 &&
-                dst + current.data.upper[l] >= mindist) {
-              if (dst < current.data.lower[l]) {
-                d = current.data.lower[l] - dst;
-                if (tau1 >= d)
-                  todo.push(std::make_pair(-d, current.data.child[l]));
-              } else if (dst > current.data.upper[l]) {
-                d = dst - current.data.upper[l];
-                if (tau1 >= d)
-                  todo.push(std::make_pair(-d, current.data.child[l]));
-              } else
-                todo.push(std::make_pair(dist_t(1), current.data.child[l]));
-            }
-          }
-        }
-        ++_k;
-        _c1 += c;
-        double omc = _mc;
-        _mc += (c - omc) / _k;
-        _sc += (c - omc) * (c - _mc);
-        if (c > _cmax) _cmax = c;
-        if (c < _cmin) _cmin = c;
+      dist_t d = -1;
+      ind.resize(results.size());
+
+      for (int i = int(ind.size()); i--;) {
+        ind[i] = int(results.top().second);
+        if (i == 0) d = results.top().first;
+        results.pop();
       }
+      return d;
+
+    }
+
+    /**
+     * Search the NearestNeighbor approximately.
+     *
+     * @param[in] pts the vector of points used for initialization.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] query the query point.
+     * @param[out] ind a vector of indices to the closest points found.
+     * @param[in] k the number of points to search for.
+     * @param[in] eps the relative error allowed in the distances (default
+     *   0).
+     * @param[in] maxcost the maximum number of distance calculations
+     *   (default 0, meaning no limit).
+     * @param[in] maxdist only return points with distances of \e maxdist or
+     *   less from \e query (default is the maximum \e dist_t).
+     * @param[in] mindist only return points with distances of more than
+     *   \e mindist from \e query (default = &minus;1).
+     * @return the distance to the closest point found (&minus;1 if no points
+     *   are found).
+     * @exception GeographicErr if \e pts has a different size from that used
+     *   to construct the object.
+     *
+     * This is an exhaustive search, as Search(), with two ways to trade
+     * accuracy for speed:
+     * - If \e eps is positive, the parts of the tree which can only contain
+     *   points further than \e d/(1 + \e eps) from the query are skipped,
+     *   where \e d is the distance to the <i>k</i>'th point found so far.  In
+     *   this case, the distance to the <i>j</i>'th point returned is at most
+     *   (1 + \e eps) times the distance to the true <i>j</i>'th closest
+     *   point (for a floating point \e dist_t).  Values of \e eps between
+     *   0.1 and 1 give a substantial reduction in the cost of searching
+     *   clustered or high dimensional data.
+     * - If \e maxcost is positive, the search stops after \e maxcost
+     *   distance calculations and the best points found so far are returned.
+     *   This bounds the worst case time for a search (at the expense of the
+     *   accuracy guarantee).  Because the tree is searched closest node
+     *   first, the points found early in the search are good candidates;
+     *   a suitable budget is a few times the mean cost reported by
+     *   Statistics() for exact searches.
+     *
+     * With \e eps = 0 and \e maxcost = 0, this is the same as Search() with
+     * \e exhaustive = true and \e tol = 0.  The cost of the search is added
+     * to the statistics reported by Statistics().
+     **********************************************************************/
+    dist_t SearchApprox(const std::vector<pos_t>& pts, const distfun_t& dist,
+                        const pos_t& query,
+                        std::vector<int>& ind,
+                        int k,
+                        double eps = 0,
+                        int maxcost = 0,
+                        dist_t maxdist = std::numeric_limits<dist_t>::max(),
+                        dist_t mindist = -1) const {
+      if (_numpoints != int(pts.size()))
+          throw GeographicLib::GeographicErr("pts array has wrong size");
+      std::priority_queue<item> results;
+      int c = search(pts, dist, query, results,
+                     k, maxdist, mindist, true, 0, eps, maxcost);
+      if (c >= 0) accum(c);
 
       dist_t d = -1;
       ind.resize(results.size());
@@ -346,19 +417,338 @@ namespace GeographicLib {
         results.pop();
       }
       return d;
+    }
 
+    /**
+     * Search the NearestNeighbor for a batch of query points.
+     *
+     * @param[in] pts the vector of points used for initialization.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] queries the vector of query points.
+     * @param[out] offsets a vector of size queries.size() + 1; the results
+     *   for query \e i are in positions [<i>offsets</i><sub><i>i</i></sub>,
+     *   <i>offsets</i><sub><i>i</i>+1</sub>) of \e ind and \e dists.
+     * @param[out] ind the indices of the points found for all the queries.
+     * @param[out] dists the distances of the points found from their query
+     *   points.
+     * @param[in] k the number of points to search for (default = 1).
+     * @param[in] maxdist only return points with distances of \e maxdist or
+     *   less from \e query (default is the maximum \e dist_t).
+     * @param[in] mindist only return points with distances of more than
+     *   \e mindist from \e query (default = &minus;1).
+     * @param[in] exhaustive whether to do an exhaustive search (default true).
+     * @param[in] tol the tolerance on the results (default 0).
+     * @param[in] threads the number of threads to use (default 1); if this is
+     *   0, the number reported by std::thread::hardware_concurrency() is
+     *   used.
+     * @exception GeographicErr if \e pts has a different size from that used
+     *   to construct the object.
+     * @exception std::bad_alloc if memory for the results can't be allocated.
+     *
+     * This gives the same results as calling Search() for each query in
+     * turn; the results for each query are sorted by distance (closest
+     * first).  The results are returned in "compressed sparse row" form
+     * which avoids allocating a vector for each query.  A radius query, all
+     * the points within \e maxdist of each query point, is obtained by
+     * setting \e k = NumPoints().
+     *
+     * The statistics reported by Statistics() are updated as though Search()
+     * had been called for each query in turn.  If \e threads > 1, the queries
+     * are distributed over the threads and \e dist will be called from
+     * several threads at once and must be safe to use in this way.
+     **********************************************************************/
+    void SearchBatch(const std::vector<pos_t>& pts, const distfun_t& dist,
+                     const std::vector<pos_t>& queries,
+                     std::vector<size_t>& offsets,
+                     std::vector<int>& ind,
+                     std::vector<dist_t>& dists,
+                     int k = 1,
+                     dist_t maxdist = std::numeric_limits<dist_t>::max(),
+                     dist_t mindist = -1,
+                     bool exhaustive = true,
+                     dist_t tol = 0,
+                     unsigned threads = 1) const {
+      GEOGRAPHICLIB_TRACE_SCOPE1(nn__search, queries.size());
+      if (_numpoints != int(pts.size()))
+          throw GeographicLib::GeographicErr("pts array has wrong size");
+      size_t n = queries.size();
+      // The queries are handed out in blocks; the results for each block are
+      // accumulated in block-sized buffers and copied to the output at the
+      // end.
+      const size_t blocksize = 256;
+      size_t nblocks = (n + blocksize - 1) / blocksize;
+      std::vector<std::vector<item> > res(nblocks);
+      std::vector<size_t> num(n);
+      std::vector<int> cost(n);
+      GeographicLib::Executor::Parallel
+        (nblocks, threads, [&](size_t b) -> void {
+          std::priority_queue<item> results;
+          std::vector<item>& r = res[b];
+          for (size_t i = b * blocksize;
+               i < std::min(n, (b + 1) * blocksize); ++i) {
+            cost[i] = search(pts, dist, queries[i], results,
+                             k, maxdist, mindist, exhaustive, tol);
+            num[i] = results.size();
+            size_t i0 = r.size();
+            r.resize(i0 + results.size());
+            // results pops the furthest point first
+            for (size_t j = r.size(); j-- > i0;) {
+              r[j] = results.top();
+              results.pop();
+            }
+          }
+        });
+      offsets.resize(n + 1);
+      offsets[0] = 0;
+      for (size_t i = 0; i < n; ++i)
+        offsets[i + 1] = offsets[i] + num[i];
+      ind.resize(offsets[n]); dists.resize(offsets[n]);
+      for (size_t b = 0, j = 0; b < nblocks; ++b)
+        for (const item& t : res[b]) {
+          dists[j] = t.first; ind[j] = t.second; ++j;
+        }
+      for (size_t i = 0; i < n; ++i)
+        if (cost[i] >= 0) accum(cost[i]);
     }
 
     /**
      * @return the total number of points in the set.
+     *
+     * This is the size of the vector of points, which, after calls to
+     * Insert() and Remove(), includes the points which are not in the tree.
      **********************************************************************/
     int NumPoints() const { return _numpoints; }
 
+    /**
+     * Add a point to the tree.
+     *
+     * @param[in] pts the vector of points.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] i the index of the point to add.
+     * @exception GeographicErr if \e i is not a valid index into \e pts, if
+     *   point \e i is already in the tree, if \e pts is smaller than the
+     *   vector used for initialization or is too big for an int, or if the
+     *   tree is being used in place via AttachMapped() or LoadMapped().
+     * @exception std::bad_alloc if memory for the tree can't be allocated.
+     *
+     * The object still doesn't store the points, so the vector of points is
+     * managed by the caller subject to these rules:
+     * - the vector may grow, e.g., by appending the points to be inserted;
+     *   its new size is taken to be NumPoints() and must be passed to all
+     *   subsequent calls to Search(), etc.;
+     * - the positions of the points in the tree (see InTree()) must not be
+     *   changed;
+     * - the position of a point which isn't in the tree may be changed and
+     *   the point then inserted; thus the slot of a removed point may be
+     *   reused once InTree() reports that it has left the tree.
+     *
+     * The point is added by descending the tree from the root, extending
+     * the bounds of the nodes on the way as necessary, and adding it to a
+     * leaf; a full leaf is split.  This costs about log2(NumPoints())
+     * distance calculations.  If the insertions make a subtree unbalanced
+     * (one of its children holds more than 3/4 of its points), the subtree
+     * is rebuilt.  The distance calculations for updating the tree are
+     * added to the setup cost reported by Statistics().
+     *
+     * The first call to Insert(), Remove(), or InTree() after the tree is
+     * built or loaded sets up the bookkeeping needed for updates; this takes
+     * a pass over the tree.  These functions must not be called while
+     * another thread is searching the tree.
+     **********************************************************************/
+    void Insert(const std::vector<pos_t>& pts, const distfun_t& dist, int i) {
+      if (_mapped)
+        throw GeographicLib::GeographicErr("Cannot modify a mapped tree");
+      if (pts.size() > size_t(std::numeric_limits<int>::max()))
+        throw GeographicLib::GeographicErr("pts array too big");
+      if (int(pts.size()) < _numpoints)
+        throw GeographicLib::GeographicErr("pts array has shrunk");
+      if (!( 0 <= i && i < int(pts.size()) ))
+        throw GeographicLib::GeographicErr("Bad point index");
+      dynamic();
+      if (i < _numpoints && _state[i] != absent)
+        throw GeographicLib::GeographicErr("Point is already in the tree");
+      _state.resize(pts.size(), absent);
+      _where.resize(pts.size(), -1);
+      _numpoints = int(pts.size());
+      int n = _root;
+      if (n < 0) {
+        _root = newleaf(i, -1);
+        _state[i] = inuse;
+        return;
+      }
+      for (;;) {
+        ++_count[n];
+        if (_tree[n].index < 0) {
+          // A bucket; add the point if there's room, otherwise split it
+          int l = 0;
+          while (l < _bucket && _tree[n].leaves[l] >= 0) ++l;
+          if (l < _bucket) {
+            _tree[n].leaves[l] = i;
+            _where[i] = n;
+          } else
+            rebuild(pts, dist, n, i);
+          break;
+        }
+        Node& node = _tree[n];
+        dist_t d = dist(pts[node.index], pts[i]);
+        ++_cost;
+        // Pick a child whose bounds include d (the smaller if both do); else
+        // an empty child; else the child whose bounds need extending least.
+        int l = -1;
+        for (int k = 0; k < 2; ++k)
+          if (node.data.child[k] >= 0 &&
+              node.data.lower[k] <= d && d <= node.data.upper[k] &&
+              (l < 0 || _count[node.data.child[k]] <
+               _count[node.data.child[l]]))
+            l = k;
+        if (l < 0)
+          for (int k = 0; k < 2 && l < 0; ++k)
+            if (node.data.child[k] < 0) l = k;
+        if (l < 0) {
+          dist_t e[2];
+          for (int k = 0; k < 2; ++k)
+            e[k] = d < node.data.lower[k] ? node.data.lower[k] - d :
+              d - node.data.upper[k];
+          l = e[0] <= e[1] ? 0 : 1;
+        }
+        if (node.data.child[l] < 0) {
+          node.data.lower[l] = node.data.upper[l] = d;
+          // newleaf may reallocate _tree, invalidating node
+          int c = newleaf(i, n);
+          _tree[n].data.child[l] = c;
+          break;
+        }
+        node.data.lower[l] = (std::min)(node.data.lower[l], d);
+        node.data.upper[l] = (std::max)(node.data.upper[l], d);
+        n = node.data.child[l];
+      }
+      _state[i] = inuse;
+      // Rebuild the highest unbalanced subtree on the path to the point
+      int s = -1;
+      for (int m = _parent[_where[i]]; m >= 0; m = _parent[m]) {
+        if (_count[m] < minrebuild) continue;
+        for (int k = 0; k < 2; ++k) {
+          int c = _tree[m].data.child[k];
+          if (c >= 0 && 4 * _count[c] > 3 * _count[m]) s = m;
+        }
+      }
+      if (s >= 0)
+        rebuild(pts, dist, s, -1);
+    }
+
+    /**
+     * Remove a point from the tree.
+     *
+     * @param[in] pts the vector of points.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] i the index of the point to remove.
+     * @exception GeographicErr if \e pts has a different size from
+     *   NumPoints(), if point \e i isn't in the tree (or has already been
+     *   removed), or if the tree is being used in place via AttachMapped()
+     *   or LoadMapped().
+     * @exception std::bad_alloc if memory for the tree can't be allocated.
+     *
+     * The point is no longer returned by searches.  However it remains in
+     * the tree (and its position must not be changed) until the subtree
+     * containing it is rebuilt; this happens when more than half the points
+     * in the subtree have been removed.  So the cost of searches remains
+     * close to that for a tree of the remaining points.  See Insert() for
+     * the other rules governing updates.
+     **********************************************************************/
+    void Remove(const std::vector<pos_t>& pts, const distfun_t& dist, int i) {
+      if (_mapped)
+        throw GeographicLib::GeographicErr("Cannot modify a mapped tree");
+      if (_numpoints != int(pts.size()))
+        throw GeographicLib::GeographicErr("pts array has wrong size");
+      if (!( 0 <= i && i < _numpoints ))
+        throw GeographicLib::GeographicErr("Bad point index");
+      dynamic();
+      if (_state[i] != inuse)
+        throw GeographicLib::GeographicErr("Point is not in the tree");
+      _state[i] = removed;
+      ++_nremoved;
+      // Rebuild the highest subtree on the path to the point in which more
+      // than half the points have been removed
+      int s = -1;
+      for (int m = _where[i]; m >= 0; m = _parent[m]) {
+        ++_nrem[m];
+        if (2 * _nrem[m] > _count[m]) s = m;
+      }
+      if (s >= 0)
+        rebuild(pts, dist, s, -1);
+    }
+
+    /**
+     * Rebuild the tree.
+     *
+     * @param[in] pts the vector of points.
+     * @param[in] dist the distance function object used for initialization.
+     * @param[in] threads the number of threads to use to build the tree
+     *   (default 1); if this is 0, the number reported by
+     *   std::thread::hardware_concurrency() is used.
+     * @exception GeographicErr if \e pts has a different size from
+     *   NumPoints() or if the tree is being used in place via AttachMapped()
+     *   or LoadMapped().
+     * @exception std::bad_alloc if memory for the tree can't be allocated.
+     *
+     * This builds a new tree from the points which are in the tree and
+     * haven't been removed, as Initialize() does (with the same \e bucket);
+     * afterwards no removed points are left in the tree.  This isn't needed
+     * to maintain the efficiency of searches; however, it is required
+     * before the tree can be saved if points have been removed.
+     **********************************************************************/
+    void Rebuild(const std::vector<pos_t>& pts, const distfun_t& dist,
+                 unsigned threads = 1) {
+      if (_mapped)
+        throw GeographicLib::GeographicErr("Cannot modify a mapped tree");
+      if (_numpoints != int(pts.size()))
+        throw GeographicLib::GeographicErr("pts array has wrong size");
+      dynamic();
+      std::vector<item> ids;
+      for (int k = 0; k < _numpoints; ++k)
+        if (_state[k] == inuse) ids.push_back(std::make_pair(dist_t(0), k));
+      int cost = 0;
+      std::vector<Node> tree;
+      if (threads == 0) threads = std::thread::hardware_concurrency();
+      if (threads > 1)
+        initpar(pts, dist, _bucket, tree, ids, cost,
+                0, int(ids.size()), int(ids.size()/2), threads);
+      else
+        init(pts, dist, _bucket, tree, ids, cost,
+             0, int(ids.size()), int(ids.size()/2));
+      _tree.swap(tree);
+      _cost += cost;
+      resetdynamic();
+    }
+
+    /**
+     * @param[in] i the index of a point.
+     * @return true if point \e i is in the tree (including a point which
+     *   has been removed but is still used as part of the tree).
+     *
+     * The position of a point in the tree must not be changed.  See
+     * Insert() for the conditions under which this may be called.
+     **********************************************************************/
+    bool InTree(int i) const {
+      if (!( 0 <= i && i < _numpoints ))
+        return false;
+      dynamic();
+      return _state[i] != absent;
+    }
+
+    /**
+     * @return the number of points which have been removed but are still
+     *   in the tree.
+     **********************************************************************/
+    int NumRemoved() const { return _nremoved; }
+
     /**
      * Write the object to an I/O stream.
      *
      * @param[in,out] os the stream to write to.
      * @param[in] bin if true (the default) save in binary mode.
+     * @exception GeographicErr if points have been removed from the tree
+     *   since it was last built; call Rebuild() first.
      * @exception std::bad_alloc if memory for the string representation of the
      *   object can't be allocated.
      *
@@ -374,6 +764,10 @@ namespace GeographicLib {
     void Save(std::ostream& os, bool bin = true) const {
       int realspec = std::numeric_limits<dist_t>::digits *
         (std::numeric_limits<dist_t>::is_integer ? -1 : 1);
+      std::vector<Node> buf1;
+      const Node* tree;
+      int ntree;
+      savednodes(buf1, tree, ntree);
       if (bin) {
         char id[] = "NearestNeighbor_";
         os.write(id, 16);
@@ -382,11 +776,11 @@ namespace GeographicLib {
         buf[1] = realspec;
         buf[2] = _bucket;
         buf[3] = _numpoints;
-        buf[4] = int(_tree.size());
+        buf[4] = ntree;
         buf[5] = _cost;
         os.write(reinterpret_cast<const char *>(buf), 6 * sizeof(int));
-        for (int i = 0; i < int(_tree.size()); ++i) {
-          const Node& node = _tree[i];
+        for (int i = 0; i < ntree; ++i) {
+          const Node& node = tree[i];
           os.write(reinterpret_cast<const char *>(&node.index), sizeof(int));
           if (node.index >= 0) {
             os.write(reinterpret_cast<const char *>(node.data.lower),
@@ -411,9 +805,9 @@ namespace GeographicLib {
           ostring.precision(prec);
         }
         ostring << version << " " << realspec << " " << _bucket << " "
-                << _numpoints << " " << _tree.size() << " " << _cost;
-        for (int i = 0; i < int(_tree.size()); ++i) {
-          const Node& node = _tree[i];
+                << _numpoints << " " << ntree << " " << _cost;
+        for (int i = 0; i < ntree; ++i) {
+          const Node& node = tree[i];
           ostring << "\n" << node.index;
           if (node.index >= 0) {
             for (int l = 0; l < 2; ++l)
@@ -523,6 +917,8 @@ namespace GeographicLib {
         tree.push_back(node);
       }
       _tree.swap(tree);
+      _mapped.reset(); _nmapped = 0;
+      resetdynamic();
       _numpoints = numpoints;
       _bucket = bucket;
       _mc = _sc = 0;
@@ -552,6 +948,293 @@ namespace GeographicLib {
     friend std::istream& operator>>(std::istream& is, NearestNeighbor& t)
     { t.Load(is, false); return is; }
 
+    /**
+     * Write the object in the mapped format.
+     *
+     * @param[in,out] os the stream to write to.
+     * @exception GeographicErr if points have been removed from the tree
+     *   since it was last built; call Rebuild() first.
+     *
+     * The mapped format is a flat binary image of the tree: a 64-byte header
+     * followed by the nodes of the tree exactly as they are stored in memory.
+     * The child pointers are indices into the array of nodes, so the format is
+     * position independent and data in this format can be used in place by
+     * AttachMapped() or LoadMapped() without reading or copying it.  It can
+     * also be read from a stream with ReadMapped().  The nodes are written
+     * in large blocks, so this is also the fastest way to save a large tree.
+     * The format is \e not portable; it depends on the byte order and the
+     * layout of the nodes and it can only be used on a machine with the same
+     * architecture and with the same type \e dist_t.
+     **********************************************************************/
+    void SaveMapped(std::ostream& os) const {
+      std::vector<Node> buf1;
+      const Node* tree;
+      int ntree;
+      savednodes(buf1, tree, ntree);
+      char hdr[mappedhdr];
+      std::memset(hdr, 0, mappedhdr);
+      std::memcpy(hdr, "NearestNeighborM", 16);
+      int buf[8];
+      buf[0] = version;
+      buf[1] = std::numeric_limits<dist_t>::digits *
+        (std::numeric_limits<dist_t>::is_integer ? -1 : 1);
+      buf[2] = _bucket;
+      buf[3] = _numpoints;
+      buf[4] = ntree;
+      buf[5] = _cost;
+      buf[6] = int(sizeof(Node));
+      buf[7] = byteorder;
+      std::memcpy(hdr + 16, buf, sizeof(buf));
+      os.write(hdr, mappedhdr);
+      // Copy the nodes into a zeroed buffer so that the padding bytes are
+      // written as zeros; the buffer is written out in large blocks.
+      const size_t unionsize = sizeof(Node().data) > sizeof(Node().leaves) ?
+        sizeof(Node().data) : sizeof(Node().leaves);
+      // Need to use bn, otherwise std::min gives a link error: undefined
+      // reference to GeographicLib::NearestNeighbor<...>::blocknodes.
+      int bn = blocknodes;
+      std::vector<char> nodebuf(size_t((std::min)(ntree, bn)) *
+                                sizeof(Node));
+      for (int i0 = 0; i0 < ntree; i0 += bn) {
+        int m = (std::min)(bn, ntree - i0);
+        std::memset(nodebuf.data(), 0, size_t(m) * sizeof(Node));
+        for (int i = 0; i < m; ++i) {
+          const Node& node = tree[i0 + i];
+          const char* p = reinterpret_cast<const char*>(&node);
+          char* q = nodebuf.data() + size_t(i) * sizeof(Node);
+          std::memcpy(q, p, unionsize);
+          std::memcpy(q + (reinterpret_cast<const char*>(&node.index) - p),
+                      &node.index, sizeof(int));
+        }
+        os.write(nodebuf.data(), std::streamsize(size_t(m) * sizeof(Node)));
+      }
+    }
+
+    /**
+     * Read data in the mapped format from a stream.
+     *
+     * @param[in,out] is the stream to read from.
+     * @param[in] check if true (the default), check all the nodes of the
+     *   tree.
+     * @param[in] threads the number of threads to use for checking the tree
+     *   (default 1); if this is 0, the number reported by
+     *   std::thread::hardware_concurrency() is used.
+     * @exception GeographicErr if the header is illegal, if the data is
+     *   truncated, or if \e check is true and a node is illegal.
+     * @exception std::bad_alloc if memory for the tree can't be allocated.
+     *
+     * This reads the output of SaveMapped() into memory.  The nodes are
+     * read in large blocks directly into the tree, so this is much faster
+     * than Load() for large trees; the resulting object is the same as one
+     * restored by Load() (in particular, it may be modified by Insert() and
+     * Remove()).  Use this, instead of LoadMapped(), to transfer an index
+     * over a network stream or when the data is not in a file which can be
+     * mapped.  The format can be compressed with an external tool for
+     * transfer or backup.  The counters tracking the statistics of searches
+     * are reset by this operation.  If an exception is thrown, the state of
+     * the NearestNeighbor is unchanged.
+     **********************************************************************/
+    void ReadMapped(std::istream& is, bool check = true, unsigned threads = 1)
+    {
+      char hdr[mappedhdr];
+      if (!is.read(hdr, mappedhdr))
+        throw GeographicLib::GeographicErr("Mapped data too short");
+      int bucket, numpoints, treesize, cost;
+      mappedheader(hdr, bucket, numpoints, treesize, cost);
+      std::vector<Node> tree(treesize);
+      // Use bn instead of blocknodes with std::min (see SaveMapped).
+      int bn = blocknodes;
+      for (int i0 = 0; i0 < treesize; i0 += bn) {
+        int m = (std::min)(bn, treesize - i0);
+        if (!is.read(reinterpret_cast<char*>(tree.data() + i0),
+                     std::streamsize(size_t(m) * sizeof(Node))))
+          throw GeographicLib::GeographicErr("Mapped data truncated");
+      }
+      if (check) {
+        // Check the nodes in blocks distributed over the threads; the
+        // first error is reported.
+        size_t nblocks = (size_t(treesize) + bn - 1) / bn;
+        std::vector<std::string> errs(nblocks);
+        GeographicLib::Executor::Parallel
+          (nblocks, threads, [&](size_t b) -> void {
+            int i1 = (std::min)(treesize, int(b + 1) * bn);
+            try {
+              for (int i = int(b) * bn; i < i1; ++i)
+                tree[i].Check(numpoints, treesize, bucket);
+            }
+            catch (const std::exception& e) {
+              errs[b] = e.what();
+            }
+          });
+        for (const std::string& e : errs)
+          if (!e.empty()) throw GeographicLib::GeographicErr(e);
+      }
+      _tree.swap(tree);
+      _mapped.reset(); _nmapped = 0;
+      resetdynamic();
+      _numpoints = numpoints;
+      _bucket = bucket;
+      _mc = _sc = 0;
+      _cost = cost; _c1 = _k = _cmax = 0;
+      _cmin = std::numeric_limits<int>::max();
+    }
+
+    /**
+     * Use data in the mapped format in place.
+     *
+     * @param[in] data the start of the data written by SaveMapped().
+     * @param[in] size the number of bytes available at \e data.
+     * @param[in] check if true, check all the nodes of the tree (default
+     *   false).
+     * @exception GeographicErr if the header is illegal, if the data is
+     *   truncated, or if \e data is not suitably aligned.
+     * @exception GeographicErr if \e check is true and a node is illegal.
+     *
+     * No data is copied; the tree is searched in place, so \e data must
+     * remain valid (and unchanged) for as long as this object (or a copy of
+     * it) uses it.  Typically \e data is a memory mapped file.  Only the
+     * header is checked, unless \e check is true; this makes loading
+     * instantaneous but, if the data has been corrupted, subsequent searches
+     * may misbehave.  The counters tracking the statistics of searches are
+     * reset by this operation.  If an exception is thrown, the state of the
+     * NearestNeighbor is unchanged.
+     **********************************************************************/
+    void AttachMapped(const char* data, size_t size, bool check = false) {
+      // Use a shared_ptr with a no-op deleter so that the storage is not
+      // released.
+      attachmapped(std::shared_ptr<const char>(data, [](const char*){}),
+                   size, check);
+    }
+
+    /**
+     * Memory map a file in the mapped format and use it in place.
+     *
+     * @param[in] filename the name of a file written by SaveMapped().
+     * @param[in] check if true, check all the nodes of the tree (default
+     *   false).
+     * @exception GeographicErr if the file cannot be mapped, if mapping is
+     *   not supported on this system, or if AttachMapped() throws.
+     *
+     * The file is mapped read only; the pages are shared by all the processes
+     * which map the same file and are only read from disk as they are needed
+     * by searches.  The mapping is released when the last NearestNeighbor
+     * object using it is destroyed or re-initialized.  This is only supported
+     * on POSIX systems.
+     **********************************************************************/
+    void LoadMapped(const std::string& filename, bool check = false) {
+#if !defined(_WIN32)
+      int fd = open(filename.c_str(), O_RDONLY);
+      if (fd < 0)
+        throw GeographicLib::GeographicErr("Cannot open " + filename);
+      struct stat st;
+      if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        throw GeographicLib::GeographicErr("Cannot get size of " + filename);
+      }
+      size_t size = size_t(st.st_size);
+      void* p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+      close(fd);
+      if (p == MAP_FAILED)
+        throw GeographicLib::GeographicErr("Cannot map " + filename);
+      attachmapped(std::shared_ptr<const char>
+                   (static_cast<const char*>(p),
+                    [size](const char* q)
+                    { munmap(const_cast<char*>(q), size); }),
+                   size, check);
+#else
+      (void)check;
+      throw GeographicLib::GeographicErr("Cannot map " + filename +
+                                         ": not supported on this system");
+#endif
+    }
+
+    /**
+     * @return true if the tree is being used in place via AttachMapped() or
+     *   LoadMapped().
+     **********************************************************************/
+    bool Mapped() const { return bool(_mapped); }
+
+    /**
+     * @return the number of bytes of heap memory used by the tree (this
+     *   excludes sizeof(NearestNeighbor) and the vector of points, which is
+     *   managed by the caller).
+     *
+     * This is the storage for the nodes of the tree and, once Insert(),
+     * Remove(), or InTree() has been called, the bookkeeping for updating
+     * the tree.  If the tree is used in place via AttachMapped() or
+     * LoadMapped(), the nodes aren't included; for LoadMapped(), they occupy
+     * the mapped file.
+     **********************************************************************/
+    size_t MemoryUsage() const {
+      return _tree.capacity() * sizeof(Node) +
+        _state.capacity() * sizeof(signed char) +
+        (_where.capacity() + _parent.capacity() + _count.capacity() +
+         _nrem.capacity() + _freenodes.capacity()) * sizeof(int);
+    }
+
+    /**
+     * Renumber the points so that the points in each part of the tree are
+     * stored together.
+     *
+     * @param[out] perm the permutation of the points; the point with index \e
+     *   i in the renumbered tree is <i>pts</i>[<i>perm</i><sub><i>i</i></sub>]
+     *   in the original vector.
+     * @exception GeographicErr if the tree is being used in place via
+     *   AttachMapped() or LoadMapped() or if points have been removed from
+     *   the tree since it was last built.
+     * @exception std::bad_alloc if memory for the permutation can't be
+     *   allocated.
+     *
+     * The points are numbered in the order in which they are referenced by
+     * the nodes of the tree.  Because each subtree occupies a contiguous
+     * range of nodes, the points held by a leaf bucket are consecutive and
+     * the points in neighboring parts of the tree are close together in
+     * memory; this reduces the cache misses incurred in fetching the points
+     * during a search of a large set.  To use the renumbered tree, the caller
+     * must arrange the points in the same order, i.e., construct a new vector
+     * \e pts2 with <i>pts2</i><sub><i>i</i></sub> =
+     * <i>pts</i>[<i>perm</i><sub><i>i</i></sub>] and pass this to Search();
+     * the indices returned by the search then refer to \e pts2.  The shape
+     * of the tree is unchanged so searches visit the same nodes as before;
+     * however, if several points are equidistant from a query point, the
+     * choice between them may change.  Call this before Save() or
+     * SaveMapped() to save the renumbered tree.
+     **********************************************************************/
+    void Renumber(std::vector<int>& perm) {
+      if (_mapped)
+        throw GeographicLib::GeographicErr("Cannot renumber a mapped tree");
+      if (_dyn) {
+        std::vector<Node> tree;
+        const Node* p;
+        int n;
+        savednodes(tree, p, n);
+        _tree.swap(tree);
+        resetdynamic();
+      }
+      std::vector<int> newid(_numpoints, -1);
+      perm.clear();
+      perm.reserve(_numpoints);
+      // Start with the root node (the last one)
+      for (int i = int(_tree.size()); i--;) {
+        Node& node = _tree[i];
+        if (node.index >= 0) {
+          newid[node.index] = int(perm.size());
+          perm.push_back(node.index);
+          node.index = newid[node.index];
+        } else {
+          for (int l = 0; l < _bucket; ++l) {
+            int j = node.leaves[l];
+            if (j < 0) break;
+            newid[j] = int(perm.size());
+            perm.push_back(j);
+            node.leaves[l] = newid[j];
+          }
+        }
+      }
+      // Points which aren't in the tree (see Insert) are dropped
+      _numpoints = int(perm.size());
+    }
+
     /**
      * Swap with another NearestNeighbor object.
      *
@@ -562,6 +1245,17 @@ namespace GeographicLib {
       std::swap(_bucket, t._bucket);
       std::swap(_cost, t._cost);
       _tree.swap(t._tree);
+      _mapped.swap(t._mapped);
+      std::swap(_nmapped, t._nmapped);
+      std::swap(_root, t._root);
+      std::swap(_nremoved, t._nremoved);
+      std::swap(_dyn, t._dyn);
+      _state.swap(t._state);
+      _where.swap(t._where);
+      _parent.swap(t._parent);
+      _count.swap(t._count);
+      _nrem.swap(t._nrem);
+      _freenodes.swap(t._freenodes);
       std::swap(_mc, t._mc);
       std::swap(_sc, t._sc);
       std::swap(_c1, t._c1);
@@ -636,9 +1330,10 @@ namespace GeographicLib {
           if (!( -1 <= data.child[0] && data.child[0] < treesize &&
                  -1 <= data.child[1] && data.child[1] < treesize ))
             throw GeographicLib::GeographicErr("Bad child pointers");
+          // Insert() may extend the bounds so that they overlap, so only
+          // check each pair separately.
           if (!( 0 <= data.lower[0] && data.lower[0] <= data.upper[0] &&
-                 data.upper[0] <= data.lower[1] &&
-                 data.lower[1] <= data.upper[1] ))
+                 0 <= data.lower[1] && data.lower[1] <= data.upper[1] ))
             throw GeographicLib::GeographicErr("Bad bounds");
         } else {
           // Must be at least one valid leaf followed by a sequence end markers
@@ -700,8 +1395,16 @@ namespace GeographicLib {
         & boost::serialization::make_nvp("realspec", realspec)
         & boost::serialization::make_nvp("bucket", _bucket)
         & boost::serialization::make_nvp("numpoints", _numpoints)
-        & boost::serialization::make_nvp("cost", _cost)
-        & boost::serialization::make_nvp("tree", _tree);
+        & boost::serialization::make_nvp("cost", _cost);
+      std::vector<Node> buf1;
+      const Node* tree;
+      int ntree;
+      savednodes(buf1, tree, ntree);
+      if (_mapped || _dyn) {
+        std::vector<Node> tree1(tree, tree + ntree);
+        ar & boost::serialization::make_nvp("tree", tree1);
+      } else
+        ar & boost::serialization::make_nvp("tree", _tree);
     }
     template<class Archive> void load(Archive& ar, const unsigned) {
       int version1, realspec, bucket, numpoints, cost;
@@ -725,6 +1428,8 @@ namespace GeographicLib {
       for (int i = 0; i < int(tree.size()); ++i)
         tree[i].Check(numpoints, int(tree.size()), bucket);
       _tree.swap(tree);
+      _mapped.reset(); _nmapped = 0;
+      resetdynamic();
       _numpoints = numpoints;
       _bucket = bucket;
       _mc = _sc = 0;
@@ -738,10 +1443,474 @@ namespace GeographicLib {
 
     int _numpoints, _bucket, _cost;
     std::vector<Node> _tree;
+    // If _mapped is set, the tree consists of the _nmapped nodes which
+    // follow the header of the mapped format in _mapped; otherwise it's
+    // _tree.
+    std::shared_ptr<const char> _mapped;
+    int _nmapped;
+    static const int mappedhdr = 64;
+    // The number of nodes transferred at a time by SaveMapped and ReadMapped
+    static const int blocknodes = 1 << 12;
+    const Node* nodes() const {
+      return _mapped ?
+        reinterpret_cast<const Node*>(_mapped.get() + mappedhdr) :
+        _tree.data();
+    }
+    int treesize() const { return _mapped ? _nmapped : int(_tree.size()); }
+    // The state of the tree as modified by Insert and Remove.  _root is the
+    // index of the root node (-1 if the tree is empty).  The remaining data
+    // is set up by dynamic() when the tree is first modified (_dyn is set)
+    // and thereafter the nodes in _freenodes are unused.  _state gives the
+    // state of each point (absent, inuse, or removed), _where gives the node
+    // holding each point in the tree.  For each node, _parent is its parent
+    // (-1 for the root), _count is the number of points in its subtree, and
+    // _nrem is the number of these which have been removed.
+    int _root, _nremoved;
+    mutable bool _dyn;
+    mutable std::vector<signed char> _state;
+    mutable std::vector<int> _where, _parent, _count, _nrem, _freenodes;
+    enum { absent = 0, inuse = 1, removed = 2 };
+    // Don't bother rebalancing subtrees with fewer points than this
+    static const int minrebuild = 16;
+    int root() const { return _root; }
+    bool live(int i) const { return _state.empty() || _state[i] == inuse; }
     // Counters to track stastistics on the cost of searches
     mutable double _mc, _sc;
     mutable int _c1, _k, _cmin, _cmax;
 
+    // Marker for the byte order of data in the mapped format
+    static const int byteorder = 0x01020304;
+
+    void attachmapped(const std::shared_ptr<const char>& data, size_t size,
+                      bool check) {
+      if (size < size_t(mappedhdr))
+        throw GeographicLib::GeographicErr("Mapped data too short");
+      const char* d = data.get();
+      if (reinterpret_cast<std::uintptr_t>(d) % alignof(Node) != 0)
+        throw GeographicLib::GeographicErr("Mapped data is misaligned");
+      int bucket, numpoints, treesize, cost;
+      mappedheader(d, bucket, numpoints, treesize, cost);
+      if ((size - mappedhdr) / sizeof(Node) < size_t(treesize))
+        throw GeographicLib::GeographicErr("Mapped data truncated");
+      if (check) {
+        const Node* tree = reinterpret_cast<const Node*>(d + mappedhdr);
+        for (int i = 0; i < treesize; ++i)
+          tree[i].Check(numpoints, treesize, bucket);
+      }
+      std::vector<Node>().swap(_tree);
+      _mapped = data; _nmapped = treesize;
+      resetdynamic();
+      _numpoints = numpoints;
+      _bucket = bucket;
+      _mc = _sc = 0;
+      _cost = cost; _c1 = _k = _cmax = 0;
+      _cmin = std::numeric_limits<int>::max();
+    }
+
+    // Check the header of the mapped format and return its contents.
+    static void mappedheader(const char* d, int& bucket, int& numpoints,
+                             int& treesize, int& cost) {
+      if (std::memcmp(d, "NearestNeighborM", 16) != 0)
+        throw GeographicLib::GeographicErr("Bad ID");
+      int buf[8];
+      std::memcpy(buf, d + 16, sizeof(buf));
+      int version1 = buf[0], realspec = buf[1];
+      bucket = buf[2]; numpoints = buf[3]; treesize = buf[4]; cost = buf[5];
+      if (!( buf[7] == byteorder ))
+        throw GeographicLib::GeographicErr("Incompatible byte order");
+      if (!( version1 == version ))
+        throw GeographicLib::GeographicErr("Incompatible version");
+      if (!( realspec == std::numeric_limits<dist_t>::digits *
+             (std::numeric_limits<dist_t>::is_integer ? -1 : 1) ))
+        throw GeographicLib::GeographicErr("Different dist_t types");
+      if (!( buf[6] == int(sizeof(Node)) ))
+        throw GeographicLib::GeographicErr("Incompatible node layout");
+      if (!( 0 <= bucket && bucket <= maxbucket ))
+        throw GeographicLib::GeographicErr("Bad bucket size");
+      if (!( 0 <= treesize && treesize <= numpoints ))
+        throw
+          GeographicLib::GeographicErr("Bad number of points or tree size");
+      if (!( 0 <= cost ))
+        throw GeographicLib::GeographicErr("Bad value for cost");
+    }
+
+    // Discard the state of modifications to the tree, called whenever a new
+    // tree is installed.
+    void resetdynamic() {
+      _root = treesize() - 1;
+      _nremoved = 0;
+      _dyn = false;
+      std::vector<signed char>().swap(_state);
+      std::vector<int>().swap(_where);
+      std::vector<int>().swap(_parent);
+      std::vector<int>().swap(_count);
+      std::vector<int>().swap(_nrem);
+      std::vector<int>().swap(_freenodes);
+    }
+
+    // Set up the data needed to modify the tree.
+    void dynamic() const {
+      if (_dyn) return;
+      const Node* tree = nodes();
+      int n = treesize();
+      _state.assign(_numpoints, absent);
+      _where.assign(_numpoints, -1);
+      _parent.assign(n, -1);
+      _count.assign(n, 0);
+      _nrem.assign(n, 0);
+      _freenodes.clear();
+      // List the nodes breadth first and process them in reverse order so
+      // that children are counted before their parents.
+      std::vector<int> order;
+      if (_root >= 0) order.push_back(_root);
+      for (size_t j = 0; j < order.size(); ++j) {
+        const Node& node = tree[order[j]];
+        if (node.index >= 0)
+          for (int l = 0; l < 2; ++l)
+            if (node.data.child[l] >= 0) {
+              _parent[node.data.child[l]] = order[j];
+              order.push_back(node.data.child[l]);
+            }
+      }
+      for (size_t j = order.size(); j--;)
+        countnode(tree, order[j]);
+      _dyn = true;
+    }
+
+    // Set _count, _where, and _state for node n assuming its children have
+    // been counted.
+    void countnode(const Node* tree, int n) const {
+      const Node& node = tree[n];
+      int c = 0;
+      if (node.index >= 0) {
+        _where[node.index] = n; _state[node.index] = inuse; ++c;
+        for (int l = 0; l < 2; ++l)
+          if (node.data.child[l] >= 0) c += _count[node.data.child[l]];
+      } else {
+        for (int l = 0; l < _bucket && node.leaves[l] >= 0; ++l) {
+          _where[node.leaves[l]] = n; _state[node.leaves[l]] = inuse; ++c;
+        }
+      }
+      _count[n] = c;
+      _nrem[n] = 0;
+    }
+
+    // Add a node with parent p to the tree reusing a free slot if possible.
+    int newnode(const Node& node, int p) {
+      int n;
+      if (_freenodes.empty()) {
+        n = int(_tree.size());
+        _tree.push_back(node);
+        _parent.push_back(p); _count.push_back(0); _nrem.push_back(0);
+      } else {
+        n = _freenodes.back();
+        _freenodes.pop_back();
+        _tree[n] = node;
+        _parent[n] = p; _count[n] = 0; _nrem[n] = 0;
+      }
+      return n;
+    }
+
+    // Add a node with parent p holding just point i.
+    int newleaf(int i, int p) {
+      Node node;
+      if (_bucket == 0)
+        node.index = i;
+      else {
+        node.index = -1;
+        node.leaves[0] = i;
+        for (int l = 1; l < _bucket; ++l)
+          node.leaves[l] = -1;
+        for (int l = _bucket; l < maxbucket; ++l)
+          node.leaves[l] = 0;
+      }
+      int n = newnode(node, p);
+      _count[n] = 1;
+      _where[i] = n;
+      return n;
+    }
+
+    // Rebuild the subtree with root s from its live points and extra (if
+    // non-negative).  The removed points in the subtree become absent and
+    // the new subtree occupies node s and free nodes.
+    void rebuild(const std::vector<pos_t>& pts, const distfun_t& dist,
+                 int s, int extra) {
+      std::vector<item> ids;
+      if (extra >= 0) ids.push_back(std::make_pair(dist_t(0), extra));
+      std::vector<int> todo(1, s);
+      while (!todo.empty()) {
+        int n = todo.back();
+        todo.pop_back();
+        const Node& node = _tree[n];
+        for (int l = 0; l < (node.index >= 0 ? 1 : _bucket); ++l) {
+          int j = node.index >= 0 ? node.index : node.leaves[l];
+          if (j < 0) break;
+          if (_state[j] == inuse)
+            ids.push_back(std::make_pair(dist_t(0), j));
+          else {
+            _state[j] = absent;
+            --_nremoved;
+          }
+          _where[j] = -1;
+        }
+        if (node.index >= 0)
+          for (int l = 0; l < 2; ++l)
+            if (node.data.child[l] >= 0) todo.push_back(node.data.child[l]);
+        if (n != s) _freenodes.push_back(n);
+      }
+      int p = _parent[s], num = int(ids.size());
+      for (int m = p; m >= 0; m = _parent[m]) {
+        _count[m] += num - _count[s];
+        _nrem[m] -= _nrem[s];
+      }
+      if (num == 0) {
+        _freenodes.push_back(s);
+        if (p < 0)
+          _root = -1;
+        else
+          for (int l = 0; l < 2; ++l)
+            if (_tree[p].data.child[l] == s) _tree[p].data.child[l] = -1;
+        return;
+      }
+      std::vector<Node> sub;
+      int cost = 0;
+      init(pts, dist, _bucket, sub, ids, cost, 0, num, num/2);
+      _cost += cost;
+      // sub lists the nodes in post order; its root (the last node) goes
+      // into node s.
+      int m = int(sub.size());
+      std::vector<int> slot(m);
+      slot[m - 1] = s;
+      for (int k = 0; k < m - 1; ++k)
+        slot[k] = newnode(Node(), -1);
+      for (int k = 0; k < m; ++k) {
+        Node& node = sub[k];
+        if (node.index >= 0)
+          for (int l = 0; l < 2; ++l)
+            if (node.data.child[l] >= 0) {
+              node.data.child[l] = slot[node.data.child[l]];
+              _parent[node.data.child[l]] = slot[k];
+            }
+        _tree[slot[k]] = node;
+        countnode(_tree.data(), slot[k]);
+      }
+    }
+
+    // Copy the nodes reachable from the root to tree in post order (the
+    // layout produced by Initialize).
+    int pack(std::vector<Node>& tree, int n) const {
+      Node node = nodes()[n];
+      if (node.index >= 0)
+        for (int l = 0; l < 2; ++l)
+          if (node.data.child[l] >= 0)
+            node.data.child[l] = pack(tree, node.data.child[l]);
+      tree.push_back(node);
+      return int(tree.size()) - 1;
+    }
+
+    // Set tree and ntree to the nodes to be saved; if the tree has been
+    // modified, these are packed into buf.  (A mapped tree can't be modified;
+    // however _dyn may be set for it by InTree.)
+    void savednodes(std::vector<Node>& buf,
+                    const Node*& tree, int& ntree) const {
+      if (_nremoved > 0)
+        throw GeographicLib::GeographicErr
+          ("Call Rebuild before saving a tree with removed points");
+      if (_dyn && !_mapped) {
+        buf.clear();
+        if (_root >= 0) pack(buf, _root);
+        tree = buf.data(); ntree = int(buf.size());
+      } else {
+        tree = nodes(); ntree = treesize();
+      }
+    }
+
+    // The guts of Search.  The results are returned in results and the
+    // return value is the number of distance calculations (-1 if no search
+    // was carried out).  This doesn't touch the statistics and so it's safe
+    // to call from several threads.  If eps > 0, the nodes which can't
+    // contain points closer than tau/(1+eps) are skipped.  If maxcost > 0,
+    // the search stops after maxcost distance calculations.
+    int search(const std::vector<pos_t>& pts, const distfun_t& dist,
+               const pos_t& query, std::priority_queue<item>& results,
+               int k, dist_t maxdist, dist_t mindist,
+               bool exhaustive, dist_t tol,
+               double eps = 0, int maxcost = 0) const {
+      if (!(_numpoints > 0 && k > 0 && maxdist > mindist))
+        return -1;
+      // the pruning threshold given the current value of tau
+      auto shrink = [eps, tol](dist_t tau) -> dist_t
+        { return (eps > 0 ? dist_t(tau / (1 + eps)) : tau) - tol; };
+      // distance to the kth closest point so far
+      dist_t tau = maxdist;
+      // first is negative of how far query is outside boundary of node
+      // +1 if on boundary or inside
+      // second is node index
+      std::priority_queue<item> todo;
+      const Node* tree = nodes();
+      todo.push(std::make_pair(dist_t(1), root()));
+      int c = 0;
+      while (!todo.empty()) {
+        int n = todo.top().second;
+        dist_t d = -todo.top().first;
+        todo.pop();
+        if (maxcost > 0 && c >= maxcost) break;
+        dist_t tau1 = shrink(tau);
+        // compare tau and d again since tau may have become smaller.
+        if (!( n >= 0 && tau1 >= d )) continue;
+        const Node& current = tree[n];
+        dist_t dst = 0;   // to suppress warning about uninitialized variable
+        bool exitflag = false, leaf = current.index < 0, pruned = false;
+        // If dist supplies Distances, compute the distances to the first nb
+        // points of a bucket with a single call.
+        dist_t dists[maxbucket];
+        int nb = 0;
+        bool batch = false;
+        if (leaf) {
+          while (nb < _bucket && current.leaves[nb] >= 0) ++nb;
+          if (maxcost > 0) nb = (std::min)(nb, maxcost - c);
+          batch = distances(dist, pts, current.leaves, nb, query, dists, 0);
+          if (batch) c += nb;
+        }
+        for (int i = 0; i < (leaf ? _bucket : 1); ++i) {
+          int index = leaf ? current.leaves[i] : current.index;
+          if (index < 0) break;
+          if (batch && i >= nb) {
+            // The budget is exhausted
+            exitflag = true;
+            break;
+          }
+          // A removed point in a leaf can be skipped
+          if (leaf && !live(index)) continue;
+          if (batch) {
+            dst = dists[i];
+            if (dst > mindist && dst <= tau) {
+              if (int(results.size()) == k) results.pop();
+              results.push(std::make_pair(dst, index));
+              if (int(results.size()) == k) {
+                tau = results.top().first;
+                if (!exhaustive || tau <= tol) {
+                  exitflag = true;
+                  break;
+                }
+              }
+            }
+            continue;
+          }
+          dist_t lo = 0, hi = 0;
+          // If dist supplies bounds, skip the distance calculation if the
+          // bounds show that the point is not a result and (for an interior
+          // node) that neither subtree will be visited.  The traversal of
+          // the tree is the same as if the distance had been computed.
+          if (bounds(dist, pts[index], query, lo, hi, 0) &&
+              (lo > tau || hi <= mindist)) {
+            if (leaf) continue;
+            if (prunable(current, lo, hi, shrink(tau), mindist)) {
+              pruned = true;
+              break;
+            }
+          }
+          if (maxcost > 0 && c >= maxcost) {
+            exitflag = true;
+            break;
+          }
+          dst = dist(pts[index], query);
+          ++c;
+
+          if (dst > mindist && dst <= tau && live(index)) {
+            if (int(results.size()) == k) results.pop();
+            results.push(std::make_pair(dst, index));
+            if (int(results.size()) == k) {
+              if (exhaustive)
+                tau = results.top().first;
+              else {
+                exitflag = true;
+                break;
+              }
+              if (tau <= tol) {
+                exitflag = true;
+                break;
+              }
+            }
+          }
+        }
+        if (exitflag) break;
+
+        if (leaf || pruned) continue;
+        tau1 = shrink(tau);
+        for (int l = 0; l < 2; ++l) {
+          if (current.data.child[l] >= 0 &&
+              dst + current.data.upper[l] >= mindist) {
+            if (dst < current.data.lower[l]) {
+              d = current.data.lower[l] - dst;
+              if (tau1 >= d)
+                todo.push(std::make_pair(-d, current.data.child[l]));
+            } else if (dst > current.data.upper[l]) {
+              d = dst - current.data.upper[l];
+              if (tau1 >= d)
+                todo.push(std::make_pair(-d, current.data.child[l]));
+            } else
+              todo.push(std::make_pair(dist_t(1), current.data.child[l]));
+          }
+        }
+      }
+      return c;
+    }
+
+    // Call dist.Bounds(a, b, lo, hi), returning true, if this member
+    // function exists; otherwise return false.
+    template<class F>
+    static auto bounds(const F& f, const pos_t& a, const pos_t& b,
+                       dist_t& lo, dist_t& hi, int)
+      -> decltype(f.Bounds(a, b, lo, hi), bool()) {
+      f.Bounds(a, b, lo, hi);
+      return true;
+    }
+    template<class F>
+    static bool bounds(const F&, const pos_t&, const pos_t&,
+                       dist_t&, dist_t&, long)
+    { return false; }
+
+    // Call dist.Distances(pts, ind, n, query, d), returning true, if this
+    // member function exists; otherwise return false.
+    template<class F>
+    static auto distances(const F& f, const std::vector<pos_t>& pts,
+                          const int* ind, int n, const pos_t& query,
+                          dist_t* d, int)
+      -> decltype(f.Distances(pts, ind, n, query, d), bool()) {
+      f.Distances(pts, ind, n, query, d);
+      return true;
+    }
+    template<class F>
+    static bool distances(const F&, const std::vector<pos_t>&,
+                          const int*, int, const pos_t&, dist_t*, long)
+    { return false; }
+
+    // Given that the distance from the query to the vantage point of node
+    // lies in [lo, hi], will both children of node be skipped by search?
+    static bool prunable(const Node& node, dist_t lo, dist_t hi,
+                         dist_t tau1, dist_t mindist) {
+      for (int l = 0; l < 2; ++l) {
+        if (!( node.data.child[l] < 0 ||
+               hi + node.data.upper[l] < mindist ||
+               (hi < node.data.lower[l] && node.data.lower[l] - hi > tau1) ||
+               (lo > node.data.upper[l] && lo - node.data.upper[l] > tau1) ))
+          return false;
+      }
+      return true;
+    }
+
+    // Add the cost c of a search to the statistics
+    void accum(int c) const {
+      ++_k;
+      _c1 += c;
+      double omc = _mc;
+      _mc += (c - omc) / _k;
+      _sc += (c - omc) * (c - _mc);
+      if (c > _cmax) _cmax = c;
+      if (c < _cmin) _cmin = c;
+    }
+
     int init(const std::vector<pos_t>& pts, const distfun_t& dist, int bucket,
              std::vector<Node>& tree, std::vector<item>& ids, int& cost,
              int l, int u, int vp) {
@@ -806,6 +1975,94 @@ namespace GeographicLib {
       return int(tree.size()) - 1;
     }
 
+    // Run f(k) for k in [0, threads) using the installed Executor; an
+    // exception thrown by f is rethrown by the calling thread.
+    template<class F>
+    static void parallel(unsigned threads, F f) {
+      GeographicLib::Executor::Parallel
+        (threads, threads, [&](size_t k) -> void { f(unsigned(k)); });
+    }
+
+    // The parallel version of init.  This does the same computation as init,
+    // except that the distances are computed by several threads and the
+    // subtree child[0] is built on a separate thread with its own tree
+    // vector; the two subtree vectors are then appended to tree with their
+    // child pointers offset so that the result is the same as for init.  The
+    // threads are divided between the two subtrees.
+    int initpar(const std::vector<pos_t>& pts, const distfun_t& dist,
+                int bucket, std::vector<Node>& tree, std::vector<item>& ids,
+                int& cost, int l, int u, int vp, unsigned threads) {
+      // Don't bother with threads for small nodes
+      const int minchunk = 1 << 10;
+      if (threads <= 1 || u - l < 2 * minchunk)
+        return init(pts, dist, bucket, tree, ids, cost, l, u, vp);
+      Node node;
+      std::swap(ids[l], ids[vp]);
+      int m = (u + l + 1) / 2;
+      {
+        unsigned nthreads =
+          unsigned(std::min(int(threads), (u - l - 1) / minchunk));
+        int n = u - l - 1;
+        parallel(nthreads, [&](unsigned k) -> void {
+            int q = n / int(nthreads), r = n % int(nthreads),
+              k0 = l + 1 + q * int(k) + std::min(int(k), r),
+              k1 = k0 + q + (int(k) < r ? 1 : 0);
+            for (int j = k0; j < k1; ++j)
+              ids[j].first = dist(pts[ids[l].second], pts[ids[j].second]);
+          });
+        cost += n;
+      }
+      std::nth_element(ids.begin() + l + 1,
+                       ids.begin() + m,
+                       ids.begin() + u);
+      node.index = ids[l].second;
+      int vp0 = -1;
+      if (m > l + 1) {
+        typename std::vector<item>::iterator
+          t = std::min_element(ids.begin() + l + 1, ids.begin() + m);
+        node.data.lower[0] = t->first;
+        t = std::max_element(ids.begin() + l + 1, ids.begin() + m);
+        node.data.upper[0] = t->first;
+        vp0 = int(t - ids.begin());
+      }
+      typename std::vector<item>::iterator
+        t = std::max_element(ids.begin() + m, ids.begin() + u);
+      node.data.lower[1] = ids[m].first;
+      node.data.upper[1] = t->first;
+      int vp1 = int(t - ids.begin());
+      // The subtrees occupy disjoint ranges of ids, so they can be built
+      // concurrently.
+      std::vector<Node> tree0, tree1;
+      int cost0 = 0, cost1 = 0, child0 = -1, child1 = -1;
+      unsigned threads0 = threads / 2;
+      parallel(vp0 >= 0 ? 2 : 1, [&](unsigned k) -> void {
+          if (k == 0)
+            child1 = initpar(pts, dist, bucket, tree1, ids, cost1,
+                             m, u, vp1, threads - threads0);
+          else
+            child0 = initpar(pts, dist, bucket, tree0, ids, cost0,
+                             l + 1, m, vp0, threads0);
+        });
+      cost += cost0 + cost1;
+      int off0 = int(tree.size()), off1 = off0 + int(tree0.size());
+      tree.reserve(off1 + tree1.size() + 1);
+      for (int k = 0; k < 2; ++k) {
+        const std::vector<Node>& sub = k == 0 ? tree0 : tree1;
+        int off = k == 0 ? off0 : off1;
+        for (Node n : sub) {
+          if (n.index >= 0) {
+            for (int i = 0; i < 2; ++i)
+              if (n.data.child[i] >= 0) n.data.child[i] += off;
+          }
+          tree.push_back(n);
+        }
+      }
+      node.data.child[0] = child0 >= 0 ? child0 + off0 : -1;
+      node.data.child[1] = child1 >= 0 ? child1 + off1 : -1;
+      tree.push_back(node);
+      return int(tree.size()) - 1;
+    }
+
   };
 
 } // namespace GeographicLib
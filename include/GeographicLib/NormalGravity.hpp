@@ -255,6 +255,70 @@ namespace GeographicLib {
     Math::real Phi(real X, real Y, real& fX, real& fY) const;
     ///@}
 
+    /** \name Compute the gravity at many points
+     **********************************************************************/
+    ///@{
+    /**
+     * Evaluate the gravity on the surface of the ellipsoid at an array of
+     * latitudes.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of geographic latitudes (degrees).
+     * @param[out] gamma array of accelerations due to gravity, positive
+     *   downwards (m s<sup>&minus;2</sup>).
+     *
+     * The results are identical to calling SurfaceGravity(real) const for
+     * each point.
+     **********************************************************************/
+    void SurfaceGravity(size_t n, const real lat[], real gamma[]) const;
+
+    /**
+     * Evaluate the gravity at arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of geographic latitudes (degrees).
+     * @param[in] h array of heights above the ellipsoid (meters).
+     * @param[out] gammay array of northerly components of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gammaz array of upward components of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] Ures if non-null, array of the normal potentials
+     *   (m<sup>2</sup> s<sup>&minus;2</sup>).
+     *
+     * This returns the same results as Gravity(real, real, real&, real&)
+     * const, except for roundoff.  For points on the ellipsoid (\e h = 0),
+     * the closed form results \e gammay = 0, \e gammaz = &minus;
+     * SurfaceGravity(\e lat), and \e U = SurfacePotential() are used; these
+     * are several times cheaper than the general expressions.
+     **********************************************************************/
+    void Gravity(size_t n, const real lat[], const real h[],
+                 real gammay[], real gammaz[], real Ures[] = nullptr) const;
+
+    /**
+     * Evaluate the components of the acceleration due to gravity and the
+     * centrifugal acceleration in geocentric coordinates at arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] X array of geocentric coordinates of the points (meters).
+     * @param[in] Y array of geocentric coordinates of the points (meters).
+     * @param[in] Z array of geocentric coordinates of the points (meters).
+     * @param[out] gammaX array of \e X components of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gammaY array of \e Y components of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] gammaZ array of \e Z components of the acceleration
+     *   (m s<sup>&minus;2</sup>).
+     * @param[out] Ures if non-null, array of the sums of the gravitational
+     *   and centrifugal potentials (m<sup>2</sup> s<sup>&minus;2</sup>).
+     *
+     * The results are identical to calling U(real, real, real, real&, real&,
+     * real&) const for each point.
+     **********************************************************************/
+    void U(size_t n, const real X[], const real Y[], const real Z[],
+           real gammaX[], real gammaY[], real gammaZ[],
+           real Ures[] = nullptr) const;
+    ///@}
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
@@ -62,8 +62,50 @@ namespace GeographicLib {
       maxprec_ = 5 + 6,
     };
     static real computenorthoffset();
-    static void CheckCoords(real x, real y);
+    // If throwp = false, return bool instead
+    static bool CheckCoords(real x, real y, bool throwp = true);
     OSGB();                     // Disable constructor
+  public:
+    /**
+     * The status returned by the conversions on character buffers which do
+     * not throw an exception.
+     **********************************************************************/
+    enum status {
+      /**
+       * The conversion succeeded.
+       * @hideinitializer
+       **********************************************************************/
+      OK = 0,
+      /**
+       * The precision is not in [0, 11].
+       * @hideinitializer
+       **********************************************************************/
+      BADPRECISION = 1,
+      /**
+       * The easting or northing is outside the OSGB range.
+       * @hideinitializer
+       **********************************************************************/
+      BADCOORDS = 2,
+      /**
+       * The grid reference string is illegal.
+       * @hideinitializer
+       **********************************************************************/
+      BADSTRING = 3,
+      /**
+       * The output buffer is too small.
+       * @hideinitializer
+       **********************************************************************/
+      BUFFERTOOSMALL = 4,
+    };
+
+  private:
+    // If throwp = false, return a status instead of throwing an exception.
+    static status GridChars(real x, real y, int prec,
+                            char grid[], int& len, bool throwp);
+    static status ReverseChars(const char* gridref, int len,
+                               real& x, real& y, int& prec,
+                               bool centerp, bool throwp);
+
   public:
 
     /**
@@ -174,6 +216,131 @@ namespace GeographicLib {
                               real& x, real& y, int& prec,
                               bool centerp = true);
 
+    /** \name Batch conversions and conversions on character buffers
+     *
+     * The grid reference versions neither allocate memory nor throw
+     * exceptions; instead an error is signaled by the returned status.  On
+     * failure the output arguments are unchanged.
+     **********************************************************************/
+    ///@{
+    /**
+     * Forward projection of arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes (degrees).
+     * @param[in] lon array of longitudes (degrees).
+     * @param[out] x array of eastings (meters).
+     * @param[out] y array of northings (meters).
+     * @param[out] gamma array of meridian convergences (degrees); this may be
+     *   null.
+     * @param[out] k array of scales of the projection; this may be null.
+     *
+     * This is equivalent to calling OSGB::Forward for each point and the
+     * results are identical.
+     **********************************************************************/
+    static void ForwardBatch(size_t n, const real lat[], const real lon[],
+                             real x[], real y[],
+                             real gamma[] = nullptr, real k[] = nullptr);
+
+    /**
+     * Reverse projection of arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] x array of eastings (meters).
+     * @param[in] y array of northings (meters).
+     * @param[out] lat array of latitudes (degrees).
+     * @param[out] lon array of longitudes (degrees).
+     * @param[out] gamma array of meridian convergences (degrees); this may be
+     *   null.
+     * @param[out] k array of scales of the projection; this may be null.
+     *
+     * This is equivalent to calling OSGB::Reverse for each point and the
+     * results are identical.
+     **********************************************************************/
+    static void ReverseBatch(size_t n, const real x[], const real y[],
+                             real lat[], real lon[],
+                             real gamma[] = nullptr, real k[] = nullptr);
+
+    /**
+     * Convert OSGB coordinates to a grid reference in a character buffer.
+     *
+     * @param[in] x easting of point (meters).
+     * @param[in] y northing of point (meters).
+     * @param[in] prec precision relative to 100 km.
+     * @param[out] gridref buffer for the null-terminated grid reference.
+     * @param[in] size the size of \e gridref.
+     * @return the status of the conversion; BUFFERTOOSMALL is returned if
+     *   \e size is less than the length of the result plus 1.
+     *
+     * A buffer with 25 characters is sufficient for all values of \e prec.
+     **********************************************************************/
+    static status GridReference(real x, real y, int prec,
+                                char gridref[], size_t size);
+
+    /**
+     * Convert a grid reference in a character buffer to OSGB coordinates.
+     *
+     * @param[in] gridref the grid reference (need not be null-terminated).
+     * @param[in] len the number of characters in \e gridref.
+     * @param[out] x easting of point (meters).
+     * @param[out] y northing of point (meters).
+     * @param[out] prec precision relative to 100 km.
+     * @param[in] centerp if true (default), return center of the grid square,
+     *   else return SW (lower left) corner.
+     * @return BADSTRING if \e gridref is illegal, otherwise OK.
+     **********************************************************************/
+    static status GridReference(const char* gridref, size_t len,
+                                real& x, real& y, int& prec,
+                                bool centerp = true);
+
+    /**
+     * Convert arrays of OSGB coordinates to grid references.
+     *
+     * @param[in] n the number of points.
+     * @param[in] x array of eastings (meters).
+     * @param[in] y array of northings (meters).
+     * @param[in] prec precision relative to 100 km.
+     * @param[out] gridref buffer of \e n &times; \e stride characters; the
+     *   null-terminated grid reference for point \e i starts at \e
+     *   gridref[\e i &times; \e stride].
+     * @param[in] stride the space allotted to each grid reference.
+     * @param[out] stat optional array of statuses for each point.
+     * @return the number of points for which the conversion failed.
+     *
+     * The grid reference for a failed conversion is set to the empty string.
+     **********************************************************************/
+    static size_t GridReferenceBatch(size_t n, const real x[], const real y[],
+                                     int prec, char gridref[], size_t stride,
+                                     status stat[] = nullptr);
+
+    /**
+     * Convert grid references in a character buffer to arrays of OSGB
+     * coordinates.
+     *
+     * @param[in] n the number of points.
+     * @param[in] gridref buffer of \e n &times; \e stride characters; the
+     *   grid reference for point \e i starts at \e gridref[\e i &times; \e
+     *   stride] and is terminated by a null or by the end of its \e stride
+     *   characters.
+     * @param[in] stride the space allotted to each grid reference.
+     * @param[out] x array of eastings (meters).
+     * @param[out] y array of northings (meters).
+     * @param[out] prec array of precisions.
+     * @param[in] centerp if true (default), return centers of the grid
+     *   squares, else return SW (lower left) corners.
+     * @param[out] stat optional array of statuses for each point.
+     * @return the number of points for which the conversion failed.
+     *
+     * For a failed conversion, \e x and \e y are set to NaN, and \e prec is
+     * set to &minus;2.
+     **********************************************************************/
+    static size_t GridReferenceBatch(size_t n, const char gridref[],
+                                     size_t stride,
+                                     real x[], real y[], int prec[],
+                                     bool centerp = true,
+                                     status stat[] = nullptr);
+    ///@}
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
@@ -0,0 +1,405 @@
+/**
+ * \file Pipeline.hpp
+ * \brief Header for GeographicLib::Pipeline class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_PIPELINE_HPP)
+#define GEOGRAPHICLIB_PIPELINE_HPP 1
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/Geocentric.hpp>
+#include <GeographicLib/Geoid.hpp>
+#include <GeographicLib/LocalCartesian.hpp>
+#include <GeographicLib/UTMUPS.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs vector
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief A streaming pipeline of coordinate conversions
+   *
+   * This class chains together conversion stages (parsing, conversions
+   * between geodetic, UTM/UPS, geocentric, and local cartesian
+   * coordinates, geoid height corrections, and formatting) and applies
+   * them to blocks of points stored by columns.  Each stage processes a
+   * whole block with the batch routines of the underlying classes, so that
+   * a multi-step conversion, e.g., reading geographic coordinates with
+   * orthometric heights and printing geocentric coordinates, runs in a
+   * single process without formatting and parsing the intermediate
+   * results.
+   *
+   * Each stage declares the columns of a Block it needs and the columns it
+   * provides; Add checks that the needs of a stage are met by the earlier
+   * stages (the text column is always available).  A point for which a
+   * stage fails is marked with an error message and is skipped by the
+   * subsequent stages; Process prints such points as "ERROR: " followed by
+   * the message, as the command line utilities do.
+   *
+   * A Pipeline and its stages are not modified by Run or Process; thus a
+   * single Pipeline may be used by several threads provided each thread
+   * supplies its own Block (and provided any Geoid object used by a stage
+   * is thread safe).  The stages created with a Geocentric or
+   * LocalCartesian object hold a copy of it; those created with a Geoid
+   * object hold a reference to it.
+   *
+   * Example of use:
+   * \code
+   * Geoid egm96("egm96-5");
+   * Pipeline p;
+   * p.Add(Pipeline::ParseGeodetic(false))
+   *   .Add(Pipeline::GeoidHeight(egm96, Geoid::GEOIDTOELLIPSOID))
+   *   .Add(Pipeline::ToGeocentric(Geocentric::WGS84()))
+   *   .Add(Pipeline::FormatCartesian(3));
+   * p.Process(std::cin, std::cout);
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT Pipeline {
+  private:
+    typedef Math::real real;
+  public:
+
+    /**
+     * Bit masks for the columns of a Block.
+     **********************************************************************/
+    enum column {
+      /**
+       * The text of each point (the input line or the formatted output).
+       * @hideinitializer
+       **********************************************************************/
+      TEXT      = 1U<<0,
+      /**
+       * Latitude and longitude (Block::lat and Block::lon).
+       * @hideinitializer
+       **********************************************************************/
+      GEODETIC  = 1U<<1,
+      /**
+       * Height (Block::h).
+       * @hideinitializer
+       **********************************************************************/
+      HEIGHT    = 1U<<2,
+      /**
+       * UTM/UPS coordinates (Block::zone, Block::northp, Block::x, and
+       * Block::y).
+       * @hideinitializer
+       **********************************************************************/
+      GRID      = 1U<<3,
+      /**
+       * Geocentric or local cartesian coordinates (Block::x, Block::y, and
+       * Block::z).
+       * @hideinitializer
+       **********************************************************************/
+      CARTESIAN = 1U<<4,
+    };
+
+    /**
+     * \brief A block of points stored by columns
+     *
+     * The columns x and y are shared by the UTM/UPS and cartesian
+     * coordinates.  A point with a non-empty \e error is skipped by the
+     * stages.
+     **********************************************************************/
+    class GEOGRAPHICLIB_EXPORT Block {
+    public:
+      /**
+       * The input line (with any comment removed) or the formatted output.
+       **********************************************************************/
+      std::vector<std::string> text;
+      /**
+       * The comment for each point (including the preceding space) which is
+       * appended to the output by Process.
+       **********************************************************************/
+      std::vector<std::string> comment;
+      /**
+       * The error message for each point (empty if there's no error).
+       **********************************************************************/
+      std::vector<std::string> error;
+      /**
+       * The coordinates of the points.
+       **********************************************************************/
+      std::vector<real> lat, lon, h, x, y, z;
+      /**
+       * The UTM zones of the points.
+       **********************************************************************/
+      std::vector<int> zone;
+      /**
+       * The hemispheres of the points (non-zero means north).
+       **********************************************************************/
+      std::vector<char> northp;
+      /**
+       * @return the number of points.
+       **********************************************************************/
+      size_t size() const { return text.size(); }
+      /**
+       * Set the number of points.
+       *
+       * @param[in] n the number of points.
+       *
+       * The error messages of all the points are cleared.
+       **********************************************************************/
+      void resize(size_t n);
+    };
+
+    /**
+     * \brief A stage of a Pipeline
+     *
+     * Derived classes implement Needs, Provides, and Run.  Run is called
+     * with a Block whose columns given by Needs are set; it should set the
+     * columns given by Provides for the points with an empty error message
+     * and set the error message for any point it can't convert.
+     **********************************************************************/
+    class GEOGRAPHICLIB_EXPORT Stage {
+    public:
+      virtual ~Stage() {}
+      /**
+       * @return the columns needed by the stage (a combination of
+       *   Pipeline::column).
+       **********************************************************************/
+      virtual unsigned Needs() const = 0;
+      /**
+       * @return the columns provided by the stage.
+       **********************************************************************/
+      virtual unsigned Provides() const = 0;
+      /**
+       * Process a block of points.
+       *
+       * @param[in,out] b the block.
+       **********************************************************************/
+      virtual void Run(Block& b) const = 0;
+    };
+
+  private:
+    std::vector<std::shared_ptr<const Stage> > _stages;
+    unsigned _columns;
+  public:
+
+    /**
+     * Constructor for an empty Pipeline.
+     **********************************************************************/
+    Pipeline() : _columns(TEXT) {}
+
+    /**
+     * Append a stage to the pipeline.
+     *
+     * @param[in] stage the stage.
+     * @exception GeographicErr if \e stage is null or if it needs a column
+     *   which isn't provided by the earlier stages.
+     * @return a reference to the Pipeline.
+     **********************************************************************/
+    Pipeline& Add(const std::shared_ptr<const Stage>& stage);
+
+    /**
+     * Run the stages on a block of points.
+     *
+     * @param[in,out] b the block.
+     **********************************************************************/
+    void Run(Block& b) const;
+
+    /**
+     * Process lines of text.
+     *
+     * @param[in] in the input stream; there is one point per line.
+     * @param[out] out the output stream; this receives the text column of
+     *   each point followed by its comment or, if the point had an error,
+     *   "ERROR: " followed by the error message.
+     * @param[in] cdelim if non-empty, the part of a line starting with \e
+     *   cdelim is a comment.
+     * @param[in] blocksize the number of lines processed at a time (default
+     *   1024).
+     * @return the number of points with errors.
+     *
+     * The output is written after each block has been processed; so this
+     * function is not suitable for interactive use.
+     **********************************************************************/
+    size_t Process(std::istream& in, std::ostream& out,
+                   const std::string& cdelim = "",
+                   size_t blocksize = 1024) const;
+
+    /** \name Parsing stages
+     **********************************************************************/
+    ///@{
+    /**
+     * Parse geographic coordinates.
+     *
+     * @param[in] longfirst if true, the longitude is given first.
+     * @param[in] heightp if true (the default), the coordinates are followed
+     *   by the height.
+     * @return a stage needing TEXT and providing GEODETIC (and HEIGHT if \e
+     *   heightp).
+     *
+     * The latitude and longitude are decoded with DMS::DecodeLatLon and the
+     * height with Utility::val.
+     **********************************************************************/
+    static std::shared_ptr<const Stage> ParseGeodetic(bool longfirst,
+                                                      bool heightp = true);
+
+    /**
+     * Parse cartesian coordinates.
+     *
+     * @return a stage needing TEXT and providing CARTESIAN.
+     **********************************************************************/
+    static std::shared_ptr<const Stage> ParseCartesian();
+
+    /**
+     * Parse coordinates in any of the formats accepted by GeoCoords.
+     *
+     * @param[in] longfirst if true, geographic coordinates are given with the
+     *   longitude first.
+     * @param[in] centerp if true (the default), an MGRS reference is taken to
+     *   be the center of its square.
+     * @return a stage needing TEXT and providing GEODETIC and GRID.
+     **********************************************************************/
+    static std::shared_ptr<const Stage> ParseCoords(bool longfirst,
+                                                    bool centerp = true);
+    ///@}
+
+    /** \name Conversion stages
+     **********************************************************************/
+    ///@{
+    /**
+     * Convert geographic to UTM/UPS coordinates.
+     *
+     * @param[in] setzone the zone override (default UTMUPS::STANDARD).
+     * @return a stage needing GEODETIC and providing GRID.
+     **********************************************************************/
+    static std::shared_ptr<const Stage>
+    ToGrid(int setzone = UTMUPS::STANDARD);
+
+    /**
+     * Convert UTM/UPS to geographic coordinates.
+     *
+     * @return a stage needing GRID and providing GEODETIC.
+     **********************************************************************/
+    static std::shared_ptr<const Stage> FromGrid();
+
+    /**
+     * Convert between heights above the geoid and above the ellipsoid.
+     *
+     * @param[in] geoid the Geoid object; this must outlive the stage.
+     * @param[in] d Geoid::GEOIDTOELLIPSOID or Geoid::ELLIPSOIDTOGEOID.
+     * @return a stage needing GEODETIC and HEIGHT and providing HEIGHT.
+     *
+     * If the geoid data can't be read, all the points of the block are
+     * marked with the error.
+     **********************************************************************/
+    static std::shared_ptr<const Stage>
+    GeoidHeight(const Geoid& geoid, Geoid::convertflag d);
+
+    /**
+     * Convert geodetic to geocentric coordinates.
+     *
+     * @param[in] earth the Geocentric object.
+     * @return a stage needing GEODETIC and HEIGHT and providing CARTESIAN.
+     **********************************************************************/
+    static std::shared_ptr<const Stage>
+    ToGeocentric(const Geocentric& earth);
+
+    /**
+     * Convert geocentric to geodetic coordinates.
+     *
+     * @param[in] earth the Geocentric object.
+     * @return a stage needing CARTESIAN and providing GEODETIC and HEIGHT.
+     **********************************************************************/
+    static std::shared_ptr<const Stage>
+    FromGeocentric(const Geocentric& earth);
+
+    /**
+     * Convert geodetic to local cartesian coordinates.
+     *
+     * @param[in] local the LocalCartesian object.
+     * @return a stage needing GEODETIC and HEIGHT and providing CARTESIAN.
+     **********************************************************************/
+    static std::shared_ptr<const Stage>
+    ToLocal(const LocalCartesian& local);
+
+    /**
+     * Convert local cartesian to geodetic coordinates.
+     *
+     * @param[in] local the LocalCartesian object.
+     * @return a stage needing CARTESIAN and providing GEODETIC and HEIGHT.
+     **********************************************************************/
+    static std::shared_ptr<const Stage>
+    FromLocal(const LocalCartesian& local);
+    ///@}
+
+    /** \name Formatting stages
+     **********************************************************************/
+    ///@{
+    /**
+     * Format geographic coordinates.
+     *
+     * @param[in] prec the precision; the latitude and longitude are given
+     *   with \e prec + 5 decimal places and the height with \e prec.
+     * @param[in] longfirst if true, give the longitude first.
+     * @param[in] heightp if true (the default), append the height.
+     * @return a stage needing GEODETIC (and HEIGHT if \e heightp) and
+     *   providing TEXT.
+     **********************************************************************/
+    static std::shared_ptr<const Stage>
+    FormatGeodetic(int prec, bool longfirst, bool heightp = true);
+
+    /**
+     * Format cartesian coordinates.
+     *
+     * @param[in] prec the number of decimal places.
+     * @return a stage needing CARTESIAN and providing TEXT.
+     **********************************************************************/
+    static std::shared_ptr<const Stage> FormatCartesian(int prec);
+
+    /**
+     * Format UTM/UPS coordinates.
+     *
+     * @param[in] prec the number of decimal places for the easting and
+     *   northing; this is put in the range [0, 9].
+     * @param[in] abbrev if true (the default), the hemisphere is abbreviated
+     *   to n or s.
+     * @return a stage needing GRID and providing TEXT.
+     **********************************************************************/
+    static std::shared_ptr<const Stage>
+    FormatGrid(int prec, bool abbrev = true);
+
+    /**
+     * Format MGRS coordinates.
+     *
+     * @param[in] prec the precision relative to 100 km; this is put in the
+     *   range [&minus;1, 11].
+     * @return a stage needing GRID and providing TEXT.
+     **********************************************************************/
+    static std::shared_ptr<const Stage> FormatMGRS(int prec);
+    ///@}
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of stages.
+     **********************************************************************/
+    size_t Size() const { return _stages.size(); }
+
+    /**
+     * @return the columns provided by the stages (together with TEXT).
+     **********************************************************************/
+    unsigned Columns() const { return _columns; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_PIPELINE_HPP
@@ -38,6 +38,16 @@ namespace GeographicLib {
     typedef Math::real real;
     real _a, _f, _e2, _es, _e2m, _c;
     real _k0;
+    // The batch routines process the arrays in blocks of this size
+    static const size_t projblock_ = 64;
+    // The parts of Forward and Reverse which don't involve the
+    // trigonometric functions of angles in degrees; lat has been multiplied
+    // by the hemisphere sign, tau = tand(lat), slon and clon are the sine and
+    // cosine of lon, and the latitude given by Reverse is atand(tau).
+    void IntForward(bool northp, real lat, real tau,
+                    real lon, real slon, real clon,
+                    real& x, real& y, real& gamma, real& k) const;
+    void IntReverse(real x, real y, real& tau, real& k) const;
   public:
 
     /**
@@ -118,6 +128,57 @@ namespace GeographicLib {
       Reverse(northp, x, y, lat, lon, gamma, k);
     }
 
+    /** \name Batch projections
+     **********************************************************************/
+    ///@{
+    /**
+     * Forward projection of arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] northp the pole which is the center of projection (true
+     *   means north, false means south).
+     * @param[in] lat array of latitudes (degrees).
+     * @param[in] lon array of longitudes (degrees).
+     * @param[out] x array of eastings (meters).
+     * @param[out] y array of northings (meters).
+     * @param[out] gamma if non-null, an array of the meridian convergences
+     *   (degrees).
+     * @param[out] k if non-null, an array of the scales.
+     *
+     * The points are processed in blocks; the trigonometric functions of the
+     * latitudes and longitudes are computed with Math::sincosdBatch.  The
+     * results are the same as calling Forward for each point.  The output
+     * arrays may coincide with the input arrays.
+     **********************************************************************/
+    void ForwardBatch(size_t n, bool northp,
+                      const real lat[], const real lon[],
+                      real x[], real y[],
+                      real gamma[] = nullptr, real k[] = nullptr) const;
+
+    /**
+     * Reverse projection of arrays of points.
+     *
+     * @param[in] n the number of points.
+     * @param[in] northp the pole which is the center of projection (true
+     *   means north, false means south).
+     * @param[in] x array of eastings (meters).
+     * @param[in] y array of northings (meters).
+     * @param[out] lat array of latitudes (degrees).
+     * @param[out] lon array of longitudes (degrees).
+     * @param[out] gamma if non-null, an array of the meridian convergences
+     *   (degrees).
+     * @param[out] k if non-null, an array of the scales.
+     *
+     * The latitudes and longitudes are computed with Math::atan2dBatch.  The
+     * results are the same as calling Reverse for each point.  The output
+     * arrays may coincide with the input arrays.
+     **********************************************************************/
+    void ReverseBatch(size_t n, bool northp,
+                      const real x[], const real y[],
+                      real lat[], real lon[],
+                      real gamma[] = nullptr, real k[] = nullptr) const;
+    ///@}
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
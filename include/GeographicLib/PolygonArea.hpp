@@ -10,6 +10,7 @@
 #if !defined(GEOGRAPHICLIB_POLYGONAREA_HPP)
 #define GEOGRAPHICLIB_POLYGONAREA_HPP 1
 
+#include <deque>
 #include <GeographicLib/Geodesic.hpp>
 #include <GeographicLib/GeodesicExact.hpp>
 #include <GeographicLib/Rhumb.hpp>
@@ -51,6 +52,12 @@ namespace GeographicLib {
    * There's an option to treat the points as defining a polyline instead of a
    * polygon; in that case, only the perimeter is computed.
    *
+   * There's also an option to maintain a sliding window of vertices, e.g.,
+   * the last \e N positions of a moving vehicle.  In this case, the
+   * contributions of each edge to the perimeter and area are stored so that
+   * the oldest vertex can be removed with PolygonAreaT::RemovePoint at
+   * constant cost, regardless of the size of the window.
+   *
    * This is a templated class to allow it to be used with Geodesic,
    * GeodesicExact, and Rhumb.  GeographicLib::PolygonArea,
    * GeographicLib::PolygonAreaExact, and GeographicLib::PolygonAreaRhumb are
@@ -105,6 +112,26 @@ namespace GeographicLib {
     int _crossings;
     Accumulator<> _areasum, _perimetersum;
     real _lat0, _lon0, _lat1, _lon1;
+    // The edges in the window: the end point and the contributions to the
+    // sums.
+    struct edge {
+      real lat, lon, s12, S12;
+      int crossings;
+    };
+    unsigned _window;
+    std::deque<edge> _edges;
+    void addedge(real lat, real lon, real s12, real S12, int crossings) {
+      _perimetersum += s12;
+      if (!_polyline) {
+        _areasum += S12;
+        _crossings += crossings;
+      }
+      if (_window) {
+        edge e = {lat, lon, s12, S12, crossings};
+        _edges.push_back(e);
+        if (_num >= _window) RemovePoint();
+      }
+    }
     static int transit(real lon1, real lon2) {
       // Return 1 or -1 if crossing prime meridian in east or west direction.
       // Otherwise return zero.
@@ -137,6 +164,14 @@ namespace GeographicLib {
     }
     template <typename T>
     void AreaReduce(T& area, int crossings, bool reverse, bool sign) const;
+    // The number of edges computed at a time by AddPoints and the number
+    // claimed by a thread at a time
+    static const size_t chunk_ = 1 << 16;
+    static const size_t block_ = 256;
+    // Compute the m edges from (lats[j], lons[j]) to (lats[j+1], lons[j+1])
+    // for AddPoints; this is specialized for Rhumb.
+    void inverseedges(size_t m, const real lats[], const real lons[],
+                      real s12[], real S12[], unsigned threads) const;
   public:
 
     /**
@@ -145,14 +180,23 @@ namespace GeographicLib {
      * @param[in] earth the Geodesic object to use for geodesic calculations.
      * @param[in] polyline if true that treat the points as defining a polyline
      *   instead of a polygon (default = false).
+     * @param[in] window if positive, keep only the last \e window points of
+     *   the polygon or polyline (default = 0, keep all the points).
+     *
+     * If \e window is positive, the contributions of each edge are stored
+     * (so the memory used is proportional to \e window), adding a point
+     * when there are already \e window points removes the oldest one, and
+     * PolygonAreaT::RemovePoint may be called.
      **********************************************************************/
-    PolygonAreaT(const GeodType& earth, bool polyline = false)
+    PolygonAreaT(const GeodType& earth, bool polyline = false,
+                 unsigned window = 0)
       : _earth(earth)
       , _area0(_earth.EllipsoidArea())
       , _polyline(polyline)
       , _mask(GeodType::LATITUDE | GeodType::LONGITUDE | GeodType::DISTANCE |
               (_polyline ? GeodType::NONE :
                GeodType::AREA | GeodType::LONG_UNROLL))
+      , _window(window)
     { Clear(); }
 
     /**
@@ -164,8 +208,22 @@ namespace GeographicLib {
       _areasum = 0;
       _perimetersum = 0;
       _lat0 = _lon0 = _lat1 = _lon1 = Math::NaN();
+      _edges.clear();
     }
 
+    /**
+     * Remove the oldest point from the polygon or polyline.
+     *
+     * @exception GeographicErr if \e window was 0 in the constructor.
+     *
+     * The first vertex and the edge from it to the second vertex are
+     * removed, so the polygon now starts at the second vertex.  The
+     * contributions of the edge are subtracted from the sums; thus the cost
+     * is independent of the number of points.  This does nothing if no
+     * points have been added.
+     **********************************************************************/
+    void RemovePoint();
+
     /**
      * Add a point to the polygon or polyline.
      *
@@ -176,6 +234,27 @@ namespace GeographicLib {
      **********************************************************************/
     void AddPoint(real lat, real lon);
 
+    /**
+     * Add several points to the polygon or polyline.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes of the points (degrees).
+     * @param[in] lon array of longitudes of the points (degrees).
+     * @param[in] threads the number of threads to use to compute the edges
+     *   (default 1); if this is 0, the number reported by
+     *   std::thread::hardware_concurrency() is used.
+     *
+     * This gives the same results as calling PolygonAreaT::AddPoint for each
+     * point in turn.  However, the geodesic calculations for the edges, which
+     * are independent of one another, are carried out in blocks and, if \e
+     * threads is greater than 1, these are distributed over several threads.
+     * The results for the edges are then added to the sums in their original
+     * order; so the results don't depend on \e threads.  This is useful for
+     * polygons with many vertices (e.g., the boundary of a country).
+     **********************************************************************/
+    void AddPoints(size_t n, const real lat[], const real lon[],
+                   unsigned threads = 1);
+
     /**
      * Add an edge to the polygon or polyline.
      *
@@ -288,6 +367,24 @@ namespace GeographicLib {
     void CurrentPoint(real& lat, real& lon) const
     { lat = _lat1; lon = _lon1; }
 
+    /**
+     * Report the first vertex of the polygon or polyline.
+     *
+     * @param[out] lat the latitude of the point (degrees).
+     * @param[out] lon the longitude of the point (degrees).
+     *
+     * If no points have been added, then NaNs are returned.  With a sliding
+     * window, this is the oldest point in the window.
+     **********************************************************************/
+    void FirstPoint(real& lat, real& lon) const
+    { lat = _lat0; lon = _lon0; }
+
+    /**
+     * @return the size of the sliding window (0 if all the points are
+     *   kept).
+     **********************************************************************/
+    unsigned Window() const { return _window; }
+
     /**
      * \deprecated An old name for EquatorialRadius().
      **********************************************************************/
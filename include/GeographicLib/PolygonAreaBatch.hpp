@@ -0,0 +1,193 @@
+/**
+ * \file PolygonAreaBatch.hpp
+ * \brief Header for GeographicLib::PolygonAreaBatchT class
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_POLYGONAREABATCH_HPP)
+#define GEOGRAPHICLIB_POLYGONAREABATCH_HPP 1
+
+#include <GeographicLib/PolygonArea.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Areas and perimeters of many polygons
+   *
+   * This computes the perimeters and areas of a set of polygons (or the
+   * lengths of a set of polylines) given in a flat layout: the vertices of
+   * all the polygons are stored consecutively in arrays of latitudes and
+   * longitudes and an array of offsets gives the start of each polygon.
+   * This is the layout used for the rings of GeoArrow and similar formats.
+   * The polygons are distributed over a pool of threads; each thread uses a
+   * single PolygonAreaT object which is cleared for each polygon, so no
+   * memory is allocated per polygon.  The results are identical to those
+   * obtained by adding the vertices to a PolygonAreaT with
+   * PolygonAreaT::AddPoint and calling PolygonAreaT::Compute.
+   *
+   * As with PolygonAreaT, the polygons are closed implicitly.  If the last
+   * vertex of a polygon repeats the first (as in WKB or GeoJSON), the extra
+   * edge has zero length and doesn't change the perimeter or area; however
+   * it \e is included in the number of vertices.
+   *
+   * This is a templated class to allow it to be used with Geodesic,
+   * GeodesicExact, and Rhumb.  GeographicLib::PolygonAreaBatch,
+   * GeographicLib::PolygonAreaBatchExact, and
+   * GeographicLib::PolygonAreaBatchRhumb are typedefs for these cases.
+   *
+   * A PolygonAreaBatchT object holds no state other than the ellipsoid, the
+   * \e polyline flag, and the number of threads; thus a single object may be
+   * used by several threads.
+   *
+   * @tparam GeodType the geodesic class to use.
+   **********************************************************************/
+
+  template<class GeodType = Geodesic>
+  class PolygonAreaBatchT {
+  private:
+    typedef Math::real real;
+    // The number of polygons claimed by a thread at a time
+    static const size_t block_ = 64;
+    GeodType _earth;
+    bool _polyline;
+    unsigned _threads;
+  public:
+
+    /**
+     * Constructor for PolygonAreaBatchT.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     * @param[in] polyline if true that treat the points as defining polylines
+     *   instead of polygons (default = false).
+     * @param[in] threads the number of threads to use; if this is 0 (the
+     *   default), the number reported by std::thread::hardware_concurrency()
+     *   is used.
+     **********************************************************************/
+    PolygonAreaBatchT(const GeodType& earth, bool polyline = false,
+                      unsigned threads = 0);
+
+    /**
+     * Compute the perimeters and areas of a set of polygons.
+     *
+     * @param[in] n the number of polygons.
+     * @param[in] offsets array of \e n + 1 indices; the vertices of polygon
+     *   \e k are elements \e offsets[\e k] through \e offsets[\e k + 1]
+     *   &minus; 1 of \e lat and \e lon.
+     * @param[in] lat array of latitudes of the vertices (degrees).
+     * @param[in] lon array of longitudes of the vertices (degrees).
+     * @param[in] reverse if true then clockwise (instead of counter-clockwise)
+     *   traversal counts as a positive area.
+     * @param[in] sign if true then return a signed result for the area if
+     *   the polygon is traversed in the "wrong" direction instead of returning
+     *   the area for the rest of the earth.
+     * @param[out] perimeter array of \e n perimeters of the polygons or
+     *   lengths of the polylines (meters).
+     * @param[out] area array of \e n areas of the polygons
+     *   (meters<sup>2</sup>); this is not referenced (and may be null) if \e
+     *   polyline is true in the constructor.
+     * @param[out] num (optional) array of \e n numbers of vertices.
+     *
+     * \e offsets should be nondecreasing and \e offsets[0] is usually 0.  An
+     * empty polygon gives a perimeter and area of 0.  Output arrays which
+     * are null are not set.
+     **********************************************************************/
+    void Compute(size_t n, const size_t offsets[],
+                 const real lat[], const real lon[],
+                 bool reverse, bool sign,
+                 real perimeter[], real area[],
+                 unsigned num[] = nullptr) const;
+
+    /**
+     * Compute the total perimeter and area of a multipolygon.
+     *
+     * @param[in] n the number of rings.
+     * @param[in] offsets array of \e n + 1 indices; the vertices of ring \e
+     *   k are elements \e offsets[\e k] through \e offsets[\e k + 1]
+     *   &minus; 1 of \e lat and \e lon.
+     * @param[in] lat array of latitudes of the vertices (degrees).
+     * @param[in] lon array of longitudes of the vertices (degrees).
+     * @param[in] hole array of \e n flags; if \e hole[\e k] is true, ring \e
+     *   k is a hole.  If this is null, the holes are determined by the
+     *   orientation of the rings (see below).
+     * @param[in] reverse if true then clockwise (instead of counter-clockwise)
+     *   traversal counts as a positive area.
+     * @param[out] perimeter the sum of the perimeters of the rings (meters).
+     * @param[out] area the area of the multipolygon (meters<sup>2</sup>);
+     *   this is not set if \e polyline is true in the constructor.
+     *
+     * The rings are distributed over the threads in the same way as for
+     * Compute.  The perimeters and the areas of the rings are summed with
+     * ExactAccumulator in each block of rings and the blocks are merged
+     * exactly; so the results are correctly rounded sums of the ring results
+     * and don't depend on the number of threads or the order of the rings.
+     *
+     * The area of each ring is computed with \e sign = true, i.e., it is the
+     * area of the smaller of the two regions bounded by the ring (this
+     * assumes that no ring encloses more than half the earth).  If \e hole
+     * is given, the orientation of the rings is ignored: the areas of the
+     * outer rings are added and the areas of the holes are subtracted.
+     * Otherwise, the signed areas of the rings are added; this gives the
+     * area of the multipolygon if the outer rings are counter-clockwise and
+     * the holes are clockwise (as in GeoJSON) with \e reverse = false, or if
+     * the outer rings are clockwise and the holes counter-clockwise (as in
+     * shapefiles) with \e reverse = true.
+     **********************************************************************/
+    void ComputeMulti(size_t n, const size_t offsets[],
+                      const real lat[], const real lon[],
+                      const bool hole[], bool reverse,
+                      real& perimeter, real& area) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of threads used.
+     **********************************************************************/
+    unsigned Threads() const { return _threads; }
+
+    /**
+     * @return true if the points are treated as defining polylines.
+     **********************************************************************/
+    bool Polyline() const { return _polyline; }
+
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _earth.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _earth.Flattening(); }
+    ///@}
+  };
+
+  /**
+   * @relates PolygonAreaBatchT
+   *
+   * Batch polygon areas using Geodesic.
+   **********************************************************************/
+  typedef PolygonAreaBatchT<Geodesic> PolygonAreaBatch;
+
+  /**
+   * @relates PolygonAreaBatchT
+   *
+   * Batch polygon areas using GeodesicExact.
+   **********************************************************************/
+  typedef PolygonAreaBatchT<GeodesicExact> PolygonAreaBatchExact;
+
+  /**
+   * @relates PolygonAreaBatchT
+   *
+   * Batch polygon areas using Rhumb.
+   **********************************************************************/
+  typedef PolygonAreaBatchT<Rhumb> PolygonAreaBatchRhumb;
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_POLYGONAREABATCH_HPP
@@ -0,0 +1,161 @@
+/**
+ * \file PreparedPolygon.hpp
+ * \brief Header for GeographicLib::PreparedPolygonT class
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_PREPAREDPOLYGON_HPP)
+#define GEOGRAPHICLIB_PREPAREDPOLYGON_HPP 1
+
+#include <vector>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicExact.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Point in polygon tests for geodesic polygons
+   *
+   * This class lets you test whether points lie inside a polygon whose edges
+   * are geodesics.  The polygon is "prepared" by the constructor which
+   * computes the geodesic for each edge and sets up an index of the edges by
+   * longitude.  A test counts the edges which cross the meridian through the
+   * point between the point and the north pole; only the edges in a single
+   * longitude bin need be considered and, for most of these, comparing the
+   * latitude of the point with the range of latitudes of the edge suffices.
+   * Otherwise, the side of the edge on which the point lies is found by
+   * comparing the azimuth of the edge with the azimuth from its first vertex
+   * to the point (this requires the solution of an inverse geodesic
+   * problem).  Thus the typical cost of a test is independent of the number
+   * of vertices.
+   *
+   * As with PolygonAreaT, the polygon is closed implicitly and may encircle
+   * a pole.  The polygon divides the ellipsoid into two regions and the
+   * \e interior is taken to be the smaller of these; this is the region
+   * whose area is returned by PolygonAreaT::Compute with \e sign = true.
+   * Self-intersecting polygons are treated with the even-odd rule.  The
+   * result for points lying exactly on an edge is unspecified.  The side test
+   * assumes that an edge and the distances from its first vertex to the
+   * points being tested are less than about half the circumference of the
+   * earth.
+   *
+   * This is a templated class to allow it to be used with Geodesic and
+   * GeodesicExact.  GeographicLib::PreparedPolygon and
+   * GeographicLib::PreparedPolygonExact are typedefs for these cases.
+   *
+   * All the member functions are const, so a single object may be used by
+   * several threads.
+   *
+   * Example of use:
+   * \code
+   * const double lat[] = {40.6, 51.6, 35.8}, lon[] = {-73.8, -0.5, 140.4};
+   * PreparedPolygon poly(Geodesic::WGS84(), 3, lat, lon);
+   * bool inside = poly.Contains(70, 0);
+   * \endcode
+   *
+   * @tparam GeodType the geodesic class to use.
+   **********************************************************************/
+
+  template<class GeodType = Geodesic>
+  class PreparedPolygonT {
+  private:
+    typedef Math::real real;
+    GeodType _earth;
+    struct edge {
+      real lat1, lon1, azi1, lon12, latmin, latmax;
+    };
+    std::vector<edge> _edges;
+    // Edge indices for each longitude bin in compressed form; the edges in
+    // bin k are _binedges[_binstart[k]] thru _binedges[_binstart[k+1]-1].
+    std::vector<unsigned> _binstart, _binedges;
+    real _binscale;             // bins per degree
+    // Does the region to the left of the edges contain the north pole?  Is
+    // the interior the region to the left of the edges?
+    bool _northleft, _interiorleft;
+    unsigned _num;
+    real _perimeter, _area;
+    int bin(real lon) const;
+    bool South(const edge& e, real lat, real lon) const;
+  public:
+
+    /**
+     * Constructor for PreparedPolygonT.
+     *
+     * @param[in] earth the Geodesic object to use for geodesic calculations.
+     * @param[in] n the number of vertices.
+     * @param[in] lat array of latitudes of the vertices (degrees).
+     * @param[in] lon array of longitudes of the vertices (degrees).
+     * @exception std::bad_alloc if the memory for the edges and the index
+     *   can't be allocated.
+     *
+     * \e lat should be in the range [&minus;90&deg;, 90&deg;].  Repeated
+     * vertices (e.g., a final vertex which duplicates the first) are
+     * allowed.  A polygon with fewer than 3 vertices contains no points.
+     **********************************************************************/
+    PreparedPolygonT(const GeodType& earth,
+                     size_t n, const real lat[], const real lon[]);
+
+    /**
+     * Test whether a point lies in the interior of the polygon.
+     *
+     * @param[in] lat the latitude of the point (degrees).
+     * @param[in] lon the longitude of the point (degrees).
+     * @return true if the point is inside the polygon.
+     *
+     * \e lat should be in the range [&minus;90&deg;, 90&deg;].
+     **********************************************************************/
+    bool Contains(real lat, real lon) const;
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the number of vertices.
+     **********************************************************************/
+    unsigned NumVertices() const { return _num; }
+
+    /**
+     * @return the perimeter of the polygon (meters).
+     **********************************************************************/
+    Math::real Perimeter() const { return _perimeter; }
+
+    /**
+     * @return the area of the interior of the polygon
+     *   (meters<sup>2</sup>).
+     **********************************************************************/
+    Math::real Area() const { return _area; }
+
+    /**
+     * @return \e a the equatorial radius of the ellipsoid (meters).  This is
+     *   the value inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real EquatorialRadius() const { return _earth.EquatorialRadius(); }
+
+    /**
+     * @return \e f the flattening of the ellipsoid.  This is the value
+     *   inherited from the Geodesic object used in the constructor.
+     **********************************************************************/
+    Math::real Flattening() const { return _earth.Flattening(); }
+    ///@}
+  };
+
+  /**
+   * @relates PreparedPolygonT
+   *
+   * Point in polygon tests using Geodesic.
+   **********************************************************************/
+  typedef PreparedPolygonT<Geodesic> PreparedPolygon;
+
+  /**
+   * @relates PreparedPolygonT
+   *
+   * Point in polygon tests using GeodesicExact.
+   **********************************************************************/
+  typedef PreparedPolygonT<GeodesicExact> PreparedPolygonExact;
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_PREPAREDPOLYGON_HPP
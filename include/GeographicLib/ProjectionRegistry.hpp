@@ -0,0 +1,210 @@
+/**
+ * \file ProjectionRegistry.hpp
+ * \brief Header for GeographicLib::ProjectionRegistry class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_PROJECTIONREGISTRY_HPP)
+#define GEOGRAPHICLIB_PROJECTIONREGISTRY_HPP 1
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <GeographicLib/Constants.hpp>
+
+namespace GeographicLib {
+
+  class AlbersEqualArea;
+  class LambertConformalConic;
+  class TransverseMercator;
+
+  /**
+   * \brief A registry of named map projections
+   *
+   * Applications which convert between many grid systems (e.g., the zones
+   * of the State Plane Coordinate System) may use this class to hold the
+   * TransverseMercator, LambertConformalConic, and AlbersEqualArea objects
+   * for the grids.  The parameters of each projection are registered under
+   * a name with one of the Add functions; the object is constructed the
+   * first time it's requested (or when Prepare() is called) and thereafter
+   * the same object is handed out as a std::shared_ptr to a const object
+   * which can be used concurrently by several threads.  Names registered
+   * with identical parameters share a single object.
+   *
+   * The false easting and northing, the central meridian, and the latitude
+   * of the origin of a grid are not part of the projection objects (they
+   * enter as the \e lon0 argument of Forward and Reverse and as offsets
+   * to the results); these should be held by the caller.
+   *
+   * All the member functions are thread safe.
+   *
+   * Example of use:
+   * \code
+   * ProjectionRegistry reg;
+   * reg.AddLambertConformalConic("CO-N", Constants::WGS84_a(),
+   *                              Constants::WGS84_f(), 39.7167, 40.7833, 1);
+   * auto lcc = reg.LambertConformalConicInstance("CO-N");
+   * double x, y;
+   * lcc->Forward(-105.5, 40, -105, x, y);
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT ProjectionRegistry {
+  private:
+    typedef Math::real real;
+    enum kind { TM = 0, LCC = 1, AEA = 2 };
+    // kind, a, f, stdlat1, stdlat2, k (stdlat1 = stdlat2 = 0 for TM)
+    typedef std::tuple<int, real, real, real, real, real> key;
+    mutable std::mutex _lock;
+    std::map<std::string, key> _names;
+    std::map<key, std::shared_ptr<const TransverseMercator> > _tm;
+    std::map<key, std::shared_ptr<const LambertConformalConic> > _lcc;
+    std::map<key, std::shared_ptr<const AlbersEqualArea> > _aea;
+    void Add(const std::string& name, const key& k);
+    // Return the key for name checking that it's of kind t; _lock must be
+    // held.
+    const key& Find(const std::string& name, int t) const;
+    // The object for key k, constructing it if necessary; _lock must be
+    // held.
+    std::shared_ptr<const TransverseMercator> tm(const key& k);
+    std::shared_ptr<const LambertConformalConic> lcc(const key& k);
+    std::shared_ptr<const AlbersEqualArea> aea(const key& k);
+    ProjectionRegistry(const ProjectionRegistry&) = delete;
+    ProjectionRegistry& operator=(const ProjectionRegistry&) = delete;
+  public:
+
+    /**
+     * Constructor for an empty ProjectionRegistry.
+     **********************************************************************/
+    ProjectionRegistry() {}
+
+    /** \name Registering projections
+     **********************************************************************/
+    ///@{
+    /**
+     * Register a transverse Mercator projection.
+     *
+     * @param[in] name the name of the projection.
+     * @param[in] a equatorial radius (meters).
+     * @param[in] f flattening of ellipsoid.
+     * @param[in] k0 central scale factor.
+     * @exception GeographicErr if \e name is already registered with
+     *   different parameters or if any of the parameters is a NaN.
+     *
+     * The parameters are checked when the object is constructed.
+     **********************************************************************/
+    void AddTransverseMercator(const std::string& name,
+                               real a, real f, real k0);
+
+    /**
+     * Register a Lambert conformal conic projection.
+     *
+     * @param[in] name the name of the projection.
+     * @param[in] a equatorial radius (meters).
+     * @param[in] f flattening of ellipsoid.
+     * @param[in] stdlat1 first standard parallel (degrees).
+     * @param[in] stdlat2 second standard parallel (degrees).
+     * @param[in] k1 scale on the standard parallels.
+     * @exception GeographicErr if \e name is already registered with
+     *   different parameters or if any of the parameters is a NaN.
+     *
+     * For a projection with a single standard parallel \e stdlat and
+     * central scale factor \e k0, set \e stdlat1 = \e stdlat2 = \e stdlat and
+     * \e k1 = \e k0.  The parameters are checked when the object is
+     * constructed.
+     **********************************************************************/
+    void AddLambertConformalConic(const std::string& name, real a, real f,
+                                  real stdlat1, real stdlat2, real k1);
+
+    /**
+     * Register an Albers equal area conic projection.
+     *
+     * @param[in] name the name of the projection.
+     * @param[in] a equatorial radius (meters).
+     * @param[in] f flattening of ellipsoid.
+     * @param[in] stdlat1 first standard parallel (degrees).
+     * @param[in] stdlat2 second standard parallel (degrees).
+     * @param[in] k1 azimuthal scale on the standard parallels.
+     * @exception GeographicErr if \e name is already registered with
+     *   different parameters or if any of the parameters is a NaN.
+     *
+     * For a projection with a single standard parallel, set \e stdlat1 = \e
+     * stdlat2.  The parameters are checked when the object is constructed.
+     **********************************************************************/
+    void AddAlbersEqualArea(const std::string& name, real a, real f,
+                            real stdlat1, real stdlat2, real k1);
+    ///@}
+
+    /** \name Retrieving projections
+     **********************************************************************/
+    ///@{
+    /**
+     * @param[in] name the name of the projection.
+     * @exception GeographicErr if \e name isn't registered as a transverse
+     *   Mercator projection or if its parameters are invalid.
+     * @return a shared pointer to the TransverseMercator object.
+     **********************************************************************/
+    std::shared_ptr<const TransverseMercator>
+    TransverseMercatorInstance(const std::string& name);
+
+    /**
+     * @param[in] name the name of the projection.
+     * @exception GeographicErr if \e name isn't registered as a Lambert
+     *   conformal conic projection or if its parameters are invalid.
+     * @return a shared pointer to the LambertConformalConic object.
+     **********************************************************************/
+    std::shared_ptr<const LambertConformalConic>
+    LambertConformalConicInstance(const std::string& name);
+
+    /**
+     * @param[in] name the name of the projection.
+     * @exception GeographicErr if \e name isn't registered as an Albers
+     *   equal area projection or if its parameters are invalid.
+     * @return a shared pointer to the AlbersEqualArea object.
+     **********************************************************************/
+    std::shared_ptr<const AlbersEqualArea>
+    AlbersEqualAreaInstance(const std::string& name);
+
+    /**
+     * Construct the objects for all the registered projections.
+     *
+     * @exception GeographicErr if the parameters of any projection are
+     *   invalid (the objects for the other projections are still
+     *   constructed).
+     *
+     * Calling this after registering the projections moves the cost of
+     * setting them up to a convenient time (e.g., the start of the
+     * program).
+     **********************************************************************/
+    void Prepare();
+    ///@}
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @param[in] name the name of a projection.
+     * @return true if \e name is registered.
+     **********************************************************************/
+    bool Defined(const std::string& name) const;
+
+    /**
+     * @return the number of registered names.
+     **********************************************************************/
+    size_t Size() const;
+
+    /**
+     * @return the number of projection objects which have been constructed.
+     **********************************************************************/
+    size_t Constructed() const;
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_PROJECTIONREGISTRY_HPP
@@ -0,0 +1,162 @@
+/**
+ * \file RadialEngine.hpp
+ * \brief Header for GeographicLib::RadialEngine class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_RADIALENGINE_HPP)
+#define GEOGRAPHICLIB_RADIALENGINE_HPP 1
+
+#include <vector>
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/SphericalEngine.hpp>
+
+#if defined(_MSC_VER)
+// Squelch warnings about dll vs vector
+#  pragma warning (push)
+#  pragma warning (disable: 4251)
+#endif
+
+namespace GeographicLib {
+
+  /**
+   * \brief Spherical harmonic sums along a radial line
+   *
+   * The class is a companion to SphericalEngine and the radial counterpart
+   * of CircularEngine.  If the results of a spherical harmonic sum are
+   * needed for several points on a ray from the center (i.e., with the same
+   * geocentric latitude and longitude but different radii \e r), then
+   * SphericalEngine::Radial can compute, for each degree \e n, the sum over
+   * order \e m, which is independent of \e r, and produce a RadialEngine
+   * object.  RadialEngine::operator()() then only needs to sum the
+   * contributions of the degrees multiplied by
+   * (<i>a</i>/<i>r</i>)<sup><i>n</i>+1</sup>, which takes about \e N
+   * operations, instead of about <i>N</i><sup>2</sup> for a full evaluation
+   * of the sum.
+   *
+   * The sum over order uses the associated Legendre functions computed
+   * explicitly by the standard recursion over degree.  Their range for high
+   * degrees exceeds that of doubles; so the recursion keeps a separate
+   * binary exponent (the method of Fukushima, J. Geodesy 86, 271&ndash;285
+   * (2012)).  The results agree with SphericalEngine::Value to roundoff.
+   *
+   * Note that points with the same geodetic latitude and longitude but
+   * different heights do \e not lie on a radial line (the geocentric
+   * latitude changes with height by up to 0.19&deg;).
+   *
+   * RadialEngine is tightly linked to the internals of SphericalEngine.  For
+   * that reason, the constructor for this class is private.  Use
+   * SphericalHarmonic::Radial, SphericalHarmonic1::Radial, and
+   * SphericalHarmonic2::Radial to create instances of this class.
+   *
+   * RadialEngine stores the sums in 1 or 3 vectors of length \e N + 1
+   * (depending on whether gradients are to be calculated).  For this reason
+   * the constructor may throw a std::bad_alloc exception.
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT RadialEngine {
+  private:
+    typedef Math::real real;
+    int _N;
+    bool _gradp;
+    real _a, _u, _t, _cl, _sl;
+    // The sums over order of the terms of degree n for the value and the
+    // derivatives wrt theta and lambda (the latter divided by u).
+    std::vector<real> _v, _vt, _vl;
+
+    Math::real Value(bool gradp, real r,
+                     real& gradx, real& grady, real& gradz) const;
+
+    friend class SphericalEngine;
+    RadialEngine(int N, bool gradp, real a, real u, real t, real cl, real sl)
+      : _N(N)
+      , _gradp(gradp)
+      , _a(a)
+      , _u(u)
+      , _t(t)
+      , _cl(cl)
+      , _sl(sl)
+      , _v(std::vector<real>(_N + 1, 0))
+      , _vt(std::vector<real>(_gradp ? _N + 1 : 0, 0))
+      , _vl(std::vector<real>(_gradp ? _N + 1 : 0, 0))
+      {}
+
+  public:
+
+    /**
+     * A default constructor.  RadialEngine::operator()() on the resulting
+     * object returns zero.  The resulting object can be assigned to the result
+     * of SphericalHarmonic::Radial.
+     **********************************************************************/
+    RadialEngine()
+      : _N(-1)
+      , _gradp(true)
+      , _a(1)
+      , _u(1)
+      , _t(0)
+      , _cl(1)
+      , _sl(0)
+      {}
+
+    /**
+     * Evaluate the sum at a particular radius.
+     *
+     * @param[in] r the radius.
+     * @return \e V the value of the sum.
+     **********************************************************************/
+    Math::real operator()(real r) const {
+      real dummy;
+      return Value(false, r, dummy, dummy, dummy);
+    }
+
+    /**
+     * Evaluate the sum and its gradient at a particular radius.
+     *
+     * @param[in] r the radius.
+     * @param[out] gradx \e x component of the gradient.
+     * @param[out] grady \e y component of the gradient.
+     * @param[out] gradz \e z component of the gradient.
+     * @return \e V the value of the sum.
+     *
+     * The gradients will only be computed if the RadialEngine object was
+     * created with this capability (e.g., via \e gradp = true in
+     * SphericalHarmonic::Radial).  If not, \e gradx, etc., will not be
+     * touched.
+     **********************************************************************/
+    Math::real operator()(real r, real& gradx, real& grady, real& gradz)
+      const {
+      return Value(true, r, gradx, grady, gradz);
+    }
+
+    /**
+     * Evaluate the sum and, optionally, its gradient at many radii.
+     *
+     * @param[in] n the number of radii.
+     * @param[in] r array of the radii.
+     * @param[out] V array of the values of the sum.
+     * @param[out] gradx if non-null, array of the \e x components of the
+     *   gradient.
+     * @param[out] grady if non-null, array of the \e y components of the
+     *   gradient.
+     * @param[out] gradz if non-null, array of the \e z components of the
+     *   gradient.
+     *
+     * This is equivalent to calling operator()() for each radius.  The
+     * gradients are computed only if \e gradx, \e grady, and \e gradz are
+     * all non-null and if the RadialEngine object was created with this
+     * capability; otherwise the gradient arrays are not touched.
+     **********************************************************************/
+    void Evaluate(size_t n, const real r[], real V[], real gradx[] = nullptr,
+                  real grady[] = nullptr, real gradz[] = nullptr) const;
+  };
+
+} // namespace GeographicLib
+
+#if defined(_MSC_VER)
+#  pragma warning (pop)
+#endif
+
+#endif  // GEOGRAPHICLIB_RADIALENGINE_HPP
@@ -0,0 +1,364 @@
+/**
+ * \file RasterWarp.hpp
+ * \brief Header for GeographicLib::RasterWarp class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_RASTERWARP_HPP)
+#define GEOGRAPHICLIB_RASTERWARP_HPP 1
+
+#include <algorithm>
+#include <vector>
+#include <GeographicLib/Constants.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief A map projection with its central meridian or pole fixed
+   *
+   * This adapts the projection classes whose Forward and Reverse functions
+   * take an extra first argument, the central meridian \e lon0
+   * (TransverseMercator, TransverseMercatorExact, LambertConformalConic,
+   * AlbersEqualArea, etc.) or the hemisphere \e northp
+   * (PolarStereographic), for use with RasterWarp.  The projection object is
+   * copied.  Use MakeRasterProjection to avoid spelling out the template
+   * parameters.
+   *
+   * @tparam Proj the projection class.
+   * @tparam Arg the type of the first argument of Proj::Forward.
+   **********************************************************************/
+  template<class Proj, typename Arg = Math::real>
+  class RasterProjection {
+  private:
+    typedef Math::real real;
+    Proj _proj;
+    Arg _arg;
+  public:
+    /**
+     * Constructor for RasterProjection.
+     *
+     * @param[in] proj the projection.
+     * @param[in] arg the first argument to pass to \e proj.Forward and \e
+     *   proj.Reverse.
+     **********************************************************************/
+    RasterProjection(const Proj& proj, Arg arg)
+      : _proj(proj)
+      , _arg(arg)
+    {}
+
+    /**
+     * Forward projection.
+     *
+     * @param[in] lat latitude of point (degrees).
+     * @param[in] lon longitude of point (degrees).
+     * @param[out] x easting of point (meters).
+     * @param[out] y northing of point (meters).
+     **********************************************************************/
+    void Forward(real lat, real lon, real& x, real& y) const
+    { _proj.Forward(_arg, lat, lon, x, y); }
+
+    /**
+     * Reverse projection.
+     *
+     * @param[in] x easting of point (meters).
+     * @param[in] y northing of point (meters).
+     * @param[out] lat latitude of point (degrees).
+     * @param[out] lon longitude of point (degrees).
+     **********************************************************************/
+    void Reverse(real x, real y, real& lat, real& lon) const
+    { _proj.Reverse(_arg, x, y, lat, lon); }
+  };
+
+  /**
+   * @relates RasterProjection
+   *
+   * @param[in] proj the projection.
+   * @param[in] arg the first argument to pass to \e proj.Forward and \e
+   *   proj.Reverse.
+   * @return a RasterProjection for \e proj.
+   **********************************************************************/
+  template<class Proj, typename Arg>
+  RasterProjection<Proj, Arg> MakeRasterProjection(const Proj& proj,
+                                                   Arg arg)
+  { return RasterProjection<Proj, Arg>(proj, arg); }
+
+  /**
+   * \brief A geographic grid for RasterWarp
+   *
+   * The "projected" coordinates are \e x = longitude and \e y = latitude in
+   * degrees.  The longitudes returned by Forward are in [\e lon0 &minus;
+   * 180&deg;, \e lon0 + 180&deg;], so that a grid which straddles the
+   * antimeridian can be handled by choosing \e lon0 near its center.
+   **********************************************************************/
+  class RasterGeographic {
+  private:
+    typedef Math::real real;
+    real _lon0;
+  public:
+    /**
+     * Constructor for RasterGeographic.
+     *
+     * @param[in] lon0 the longitude at the center of the range of the
+     *   longitudes (degrees).
+     **********************************************************************/
+    explicit RasterGeographic(real lon0 = 0) : _lon0(lon0) {}
+
+    /**
+     * "Forward projection".
+     *
+     * @param[in] lat latitude of point (degrees).
+     * @param[in] lon longitude of point (degrees).
+     * @param[out] x the longitude reduced to the range centered on \e lon0
+     *   (degrees).
+     * @param[out] y the latitude (degrees).
+     **********************************************************************/
+    void Forward(real lat, real lon, real& x, real& y) const
+    { x = _lon0 + Math::AngDiff(_lon0, lon); y = lat; }
+
+    /**
+     * "Reverse projection".
+     *
+     * @param[in] x longitude of point (degrees).
+     * @param[in] y latitude of point (degrees).
+     * @param[out] lat latitude of point (degrees).
+     * @param[out] lon longitude of point (degrees).
+     **********************************************************************/
+    void Reverse(real x, real y, real& lat, real& lon) const
+    { lat = y; lon = x; }
+  };
+
+  /**
+   * \brief Approximate transformations for raster reprojection
+   *
+   * Warping an image from a source grid to a destination grid requires, for
+   * each pixel of the destination, the coordinates of the corresponding
+   * point in the source, i.e., the composition of the reverse projection
+   * for the destination and the forward projection for the source.  Doing
+   * this exactly for every pixel is expensive.  Since the transformation is
+   * smooth on the scale of a pixel, RasterWarp::Transform computes it
+   * exactly on a sparse set of points and interpolates in between, in the
+   * manner of GDAL's approximate transformer.
+   *
+   * The raster is divided into blocks (at most \e maxblock pixels on a side).
+   * For each block, the transformation is computed exactly at the four
+   * corners, the midpoints of the four edges, and the center and the
+   * interpolation is accepted if the bilinear interpolant from the corners
+   * agrees with the exact values at the other points to within the
+   * tolerance \e tol.  Otherwise the block is split into four and the
+   * process is repeated; blocks with only 2 &times; 2 pixels are computed
+   * exactly.  Since the error in bilinear interpolation of a smooth
+   * function varies quadratically over the block, the error is then less
+   * than about \e tol over the whole block.  Blocks containing points which
+   * can't be transformed (giving NaNs) or which straddle a discontinuity
+   * (e.g., the antimeridian for a geographic source grid) are split until
+   * they're transformed exactly.
+   *
+   * The source and destination grids are described by objects with member
+   * functions
+   * \code
+   *   void Forward(real lat, real lon, real& x, real& y) const;
+   *   void Reverse(real x, real y, real& lat, real& lon) const;
+   * \endcode
+   * RasterProjection adapts the projection classes to this interface and
+   * RasterGeographic handles geographic grids.  Because interpolation
+   * commutes with affine transformations, the source coordinates returned by
+   * Transform may be converted to pixel indices afterwards.
+   *
+   * A RasterWarp object holds no mutable state; thus a single object may be
+   * used by several threads (provided that the source and destination
+   * objects allow this).
+   *
+   * @tparam Src the class for the source grid.
+   * @tparam Dst the class for the destination grid.
+   *
+   * Example of use:
+   * \code
+   * // Reproject from UTM zone 33N to a Lambert conformal conic grid
+   * TransverseMercator utm(TransverseMercator::UTM());
+   * LambertConformalConic lcc(Constants::WGS84_a(), Constants::WGS84_f(),
+   *                           real(40), real(50), real(1));
+   * auto src = MakeRasterProjection(utm, real(15));
+   * auto dst = MakeRasterProjection(lcc, real(10));
+   * RasterWarp<decltype(src), decltype(dst)> warp(src, dst, real(0.01));
+   * std::vector<real> xs(1000 * 1000), ys(1000 * 1000);
+   * // UTM coordinates for a 1000 x 1000 LCC grid with 30 m pixels
+   * warp.Transform(real(-15000), real(15000), real(30), real(-30),
+   *                1000, 1000, xs.data(), ys.data());
+   * \endcode
+   **********************************************************************/
+  template<class Src, class Dst>
+  class RasterWarp {
+  private:
+    typedef Math::real real;
+    Src _src;
+    Dst _dst;
+    real _tol;
+    size_t _maxblock;
+    // Raster geometry for Transform; exact flags the points which have been
+    // transformed exactly (so that points on the edges shared by blocks are
+    // only computed once and aren't overwritten by interpolated values).
+    struct grid {
+      real x0, y0, dx, dy; size_t nx; real *u, *v;
+      std::vector<char> exact;
+    };
+    void Exact(grid& g, size_t i, size_t j, size_t& count) const {
+      size_t k = j * g.nx + i;
+      if (g.exact[k]) return;
+      real lat, lon;
+      _dst.Reverse(g.x0 + real(i) * g.dx, g.y0 + real(j) * g.dy, lat, lon);
+      _src.Forward(lat, lon, g.u[k], g.v[k]);
+      g.exact[k] = 1;
+      ++count;
+    }
+    // Fill the block [i0, i1] x [j0, j1] given exact values at the corners
+    void Block(grid& g, size_t i0, size_t i1, size_t j0, size_t j1,
+               size_t& count) const {
+      using std::isfinite; using std::hypot;
+      if (i1 - i0 <= 1 && j1 - j0 <= 1) return;
+      // Split a dimension only if it spans more than 2 pixels; then im = i0
+      // or jm = j0 signals an unsplit dimension.
+      size_t im = i1 - i0 > 1 ? (i0 + i1) / 2 : i0,
+        jm = j1 - j0 > 1 ? (j0 + j1) / 2 : j0;
+      // The check points: the edge midpoints and the center
+      size_t ci[5] = {im, im, i0, i1, im}, cj[5] = {j0, j1, jm, jm, jm};
+      real u00 = g.u[j0 * g.nx + i0], v00 = g.v[j0 * g.nx + i0],
+        u10 = g.u[j0 * g.nx + i1], v10 = g.v[j0 * g.nx + i1],
+        u01 = g.u[j1 * g.nx + i0], v01 = g.v[j1 * g.nx + i0],
+        u11 = g.u[j1 * g.nx + i1], v11 = g.v[j1 * g.nx + i1],
+        di = real(i1 - i0), dj = real(j1 - j0);
+      // Bilinear interpolation from the corners
+      auto interp = [=](size_t i, size_t j, real& u, real& v) -> void {
+        real s = di > 0 ? real(i - i0) / di : 0,
+          t = dj > 0 ? real(j - j0) / dj : 0;
+        u = (1 - t) * ((1 - s) * u00 + s * u10) + t * ((1 - s) * u01 + s * u11);
+        v = (1 - t) * ((1 - s) * v00 + s * v10) + t * ((1 - s) * v01 + s * v11);
+      };
+      bool ok = isfinite(u00) && isfinite(v00) && isfinite(u10) &&
+        isfinite(v10) && isfinite(u01) && isfinite(v01) &&
+        isfinite(u11) && isfinite(v11);
+      for (int k = 0; k < 5; ++k) {
+        size_t i = ci[k], j = cj[k];
+        // Skip the check points which coincide with corners or with earlier
+        // check points (when a dimension isn't split)
+        if ((i == i0 || i == i1) && (j == j0 || j == j1)) continue;
+        if ((k == 4 && (im == i0 || jm == j0)) ||
+            (k == 3 && i1 == i0) || (k == 1 && j1 == j0))
+          continue;
+        Exact(g, i, j, count);
+        real u, v;
+        interp(i, j, u, v);
+        // This also catches nans
+        if (ok && !(hypot(u - g.u[j * g.nx + i], v - g.v[j * g.nx + i])
+                    <= _tol))
+          ok = false;
+      }
+      if (ok) {
+        for (size_t j = j0; j <= j1; ++j)
+          for (size_t i = i0; i <= i1; ++i) {
+            if (!g.exact[j * g.nx + i])
+              interp(i, j, g.u[j * g.nx + i], g.v[j * g.nx + i]);
+          }
+      } else {
+        // Split into 4 (or 2) blocks whose corners are among the points
+        // computed exactly above
+        size_t is[3] = {i0, im, i1}, js[3] = {j0, jm, j1},
+          ni = im == i0 ? 1 : 2, nj = jm == j0 ? 1 : 2;
+        if (ni == 1) is[1] = i1;
+        if (nj == 1) js[1] = j1;
+        for (size_t b = 0; b < nj; ++b)
+          for (size_t a = 0; a < ni; ++a)
+            Block(g, is[a], is[a + 1], js[b], js[b + 1], count);
+      }
+    }
+  public:
+
+    /**
+     * Constructor for RasterWarp.
+     *
+     * @param[in] src the source grid.
+     * @param[in] dst the destination grid.
+     * @param[in] tol the tolerance for the interpolation errors (in the
+     *   units of the source coordinates).
+     * @param[in] maxblock the maximum size of the blocks (default 64).
+     * @exception GeographicErr if \e tol is negative or \e maxblock is less
+     *   than 2.
+     *
+     * \e tol = 0 results in all the points being transformed exactly.
+     **********************************************************************/
+    RasterWarp(const Src& src, const Dst& dst, real tol,
+               size_t maxblock = 64)
+      : _src(src)
+      , _dst(dst)
+      , _tol(tol)
+      , _maxblock(maxblock)
+    {
+      if (!(_tol >= 0))
+        throw GeographicErr("Tolerance for RasterWarp is negative");
+      if (!(_maxblock >= 2))
+        throw GeographicErr("Block size for RasterWarp is less than 2");
+    }
+
+    /**
+     * Transform a raster.
+     *
+     * @param[in] x0 the destination \e x coordinate of the first column.
+     * @param[in] y0 the destination \e y coordinate of the first row.
+     * @param[in] dx the increment in \e x between columns.
+     * @param[in] dy the increment in \e y between rows.
+     * @param[in] nx the number of columns.
+     * @param[in] ny the number of rows.
+     * @param[out] u array of \e nx &times; \e ny source \e x coordinates.
+     * @param[out] v array of \e nx &times; \e ny source \e y coordinates.
+     * @return the number of points transformed exactly.
+     *
+     * The results for column \e i and row \e j, the destination point (\e x0
+     * + \e i \e dx, \e y0 + \e j \e dy), are stored in element \e j \e nx +
+     * \e i of \e u and \e v.
+     **********************************************************************/
+    size_t Transform(real x0, real y0, real dx, real dy,
+                     size_t nx, size_t ny, real u[], real v[]) const {
+      grid g = {x0, y0, dx, dy, nx, u, v, std::vector<char>(nx * ny, 0)};
+      size_t count = 0;
+      if (nx == 0 || ny == 0) return count;
+      if (_tol == 0) {
+        for (size_t j = 0; j < ny; ++j)
+          for (size_t i = 0; i < nx; ++i)
+            Exact(g, i, j, count);
+        return count;
+      }
+      // The top level blocks share their edges with their neighbors
+      for (size_t j = 0, j1; ; j = j1) {
+        j1 = std::min(j + _maxblock, ny - 1);
+        for (size_t i = 0, i1; ; i = i1) {
+          i1 = std::min(i + _maxblock, nx - 1);
+          Exact(g, i, j, count); Exact(g, i1, j, count);
+          Exact(g, i, j1, count); Exact(g, i1, j1, count);
+          Block(g, i, i1, j, j1, count);
+          if (i1 == nx - 1) break;
+        }
+        if (j1 == ny - 1) break;
+      }
+      return count;
+    }
+
+    /** \name Inspector functions
+     **********************************************************************/
+    ///@{
+    /**
+     * @return the tolerance for the interpolation errors.
+     **********************************************************************/
+    Math::real Tolerance() const { return _tol; }
+
+    /**
+     * @return the maximum size of the blocks.
+     **********************************************************************/
+    size_t MaxBlock() const { return _maxblock; }
+    ///@}
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_RASTERWARP_HPP
@@ -12,6 +12,8 @@
 
 #include <GeographicLib/Constants.hpp>
 #include <GeographicLib/Ellipsoid.hpp>
+#include <atomic>
+#include <mutex>
 
 #if !defined(GEOGRAPHICLIB_RHUMBAREA_ORDER)
 /**
@@ -73,8 +75,24 @@ namespace GeographicLib {
     real _c2;
     static const int tm_maxord = GEOGRAPHICLIB_TRANSVERSEMERCATOR_ORDER;
     static const int maxpow_ = GEOGRAPHICLIB_RHUMBAREA_ORDER;
-    // _R[0] unused
-    real _R[maxpow_ + 1];
+    // _R[0] unused.  The coefficients _R are only needed for area
+    // calculations, so they are computed by MeanSinXi on first use.  Rlazy
+    // guards this computation.  A copy of a Rhumb object shares the
+    // coefficients if they have already been computed (_Rlazy is copied
+    // before _R, so the coefficients are complete if init is set);
+    // otherwise it computes them when needed.
+    struct Rlazy {
+      std::atomic<bool> init;
+      std::mutex lock;
+      Rlazy() : init(false) {}
+      Rlazy(const Rlazy& r) : init(r.init.load(std::memory_order_acquire)) {}
+      Rlazy& operator=(const Rlazy& r) {
+        init = r.init.load(std::memory_order_acquire); return *this;
+      }
+    };
+    mutable Rlazy _Rlazy;
+    mutable real _R[maxpow_ + 1];
+    void Rcoeff() const;
     static real gd(real x)
     { using std::atan; using std::sinh; return atan(sinh(x)); }
 
@@ -194,6 +212,11 @@ namespace GeographicLib {
                     real&, real& , real& , real& , real& S12) const {
       GenInverse(lat1, lon1, lat2, lon2, outmask, s12, azi12, S12);
     }
+    // The inverse problem given the isometric latitudes psi1 and psi2
+    // (degrees) of the end points.
+    void InverseIsometric(real psi1, real lon1, real psi2, real lon2,
+                          unsigned outmask,
+                          real& s12, real& azi12, real& S12) const;
   public:
 
     /**
@@ -257,6 +280,12 @@ namespace GeographicLib {
      *   positive.
      *
      * See \ref rhumb, for a detailed description of the \e exact parameter.
+     *
+     * The coefficients of the series for the area are computed when the area
+     * is first requested.  Most of the remaining cost of construction (about
+     * 0.5 &mu;s) is in setting up the Ellipsoid; if many Rhumb objects are
+     * needed for a few ellipsoids, use EllipsoidCache::RhumbInstance to
+     * reuse them.
      **********************************************************************/
     Rhumb(real a, real f, bool exact = true);
 
@@ -388,6 +417,88 @@ namespace GeographicLib {
                     unsigned outmask,
                     real& s12, real& azi12, real& S12) const;
 
+    /**
+     * Solve a batch of direct rhumb problems.
+     *
+     * @param[in] n the number of problems.
+     * @param[in] lat1 array of latitudes of point 1 (degrees).
+     * @param[in] lon1 array of longitudes of point 1 (degrees).
+     * @param[in] azi12 array of azimuths of the rhumb lines (degrees).
+     * @param[in] s12 array of distances between point 1 and point 2
+     *   (meters).
+     * @param[in] outmask a bitor'ed combination of Rhumb::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] lat2 array of latitudes of point 2 (degrees).
+     * @param[out] lon2 array of longitudes of point 2 (degrees).
+     * @param[out] S12 array of areas under the rhumb lines
+     *   (meters<sup>2</sup>).
+     *
+     * Element \e i of each output array is set to the result of
+     * Rhumb::GenDirect applied to element \e i of the input arrays with the
+     * given \e outmask; the results are identical to those of the scalar
+     * routine.  Output arrays corresponding to quantities not included in \e
+     * outmask are not referenced and may be null.
+     **********************************************************************/
+    void DirectBatch(size_t n,
+                     const real lat1[], const real lon1[],
+                     const real azi12[], const real s12[],
+                     unsigned outmask,
+                     real lat2[], real lon2[], real S12[]) const;
+
+    /**
+     * Solve a batch of inverse rhumb problems.
+     *
+     * @param[in] n the number of problems.
+     * @param[in] lat1 array of latitudes of point 1 (degrees).
+     * @param[in] lon1 array of longitudes of point 1 (degrees).
+     * @param[in] lat2 array of latitudes of point 2 (degrees).
+     * @param[in] lon2 array of longitudes of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Rhumb::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] s12 array of rhumb distances between point 1 and point 2
+     *   (meters).
+     * @param[out] azi12 array of azimuths of the rhumb lines (degrees).
+     * @param[out] S12 array of areas under the rhumb lines
+     *   (meters<sup>2</sup>).
+     *
+     * Element \e i of each output array is set to the result of
+     * Rhumb::GenInverse applied to element \e i of the input arrays with the
+     * given \e outmask; the results are identical to those of the scalar
+     * routine.  Output arrays corresponding to quantities not included in \e
+     * outmask are not referenced and may be null.
+     **********************************************************************/
+    void InverseBatch(size_t n,
+                      const real lat1[], const real lon1[],
+                      const real lat2[], const real lon2[],
+                      unsigned outmask,
+                      real s12[], real azi12[], real S12[]) const;
+
+    /**
+     * Solve the inverse rhumb problems from a single point 1 to many points
+     * 2.
+     *
+     * @param[in] lat1 latitude of point 1 (degrees).
+     * @param[in] lon1 longitude of point 1 (degrees).
+     * @param[in] n the number of points 2.
+     * @param[in] lat2 array of latitudes of point 2 (degrees).
+     * @param[in] lon2 array of longitudes of point 2 (degrees).
+     * @param[in] outmask a bitor'ed combination of Rhumb::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] s12 array of rhumb distances between point 1 and point 2
+     *   (meters).
+     * @param[out] azi12 array of azimuths of the rhumb lines (degrees).
+     * @param[out] S12 array of areas under the rhumb lines
+     *   (meters<sup>2</sup>).
+     *
+     * This is equivalent to the other form of InverseBatch with all the
+     * elements of \e lat1 and \e lon1 equal; however the isometric latitude
+     * of point 1 is only computed once.
+     **********************************************************************/
+    void InverseBatch(real lat1, real lon1, size_t n,
+                      const real lat2[], const real lon2[],
+                      unsigned outmask,
+                      real s12[], real azi12[], real S12[]) const;
+
     /**
      * Set up to compute several points on a single rhumb line.
      *
@@ -468,6 +579,11 @@ namespace GeographicLib {
     const Rhumb& _rh;
     bool _exact;                // TODO: RhumbLine::_exact is unused; retire
     real _lat1, _lon1, _azi12, _salp, _calp, _mu1, _psi1, _r1;
+    // The common code for the batch position functions; if s12 is null, the
+    // distances are s0 + i * ds.
+    void GenPositions(size_t n, const real s12[], real s0, real ds,
+                      unsigned outmask,
+                      real lat2[], real lon2[], real S12[]) const;
     // copy assignment not allowed
     RhumbLine& operator=(const RhumbLine&) = delete;
     RhumbLine(const Rhumb& rh, real lat1, real lon1, real azi12,
@@ -584,6 +700,62 @@ namespace GeographicLib {
     void GenPosition(real s12, unsigned outmask,
                      real& lat2, real& lon2, real& S12) const;
 
+    /**
+     * Compute the positions of many points on the rhumb line.
+     *
+     * @param[in] n the number of points.
+     * @param[in] s12 array of distances from point 1 to the points (meters).
+     * @param[in] outmask a bitor'ed combination of RhumbLine::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] lat2 array of latitudes (degrees).
+     * @param[out] lon2 array of longitudes (degrees).
+     * @param[out] S12 array of areas under the rhumb line
+     *   (meters<sup>2</sup>).
+     *
+     * This is equivalent to calling RhumbLine::GenPosition for each element
+     * of \e s12 and storing the results in the corresponding element of the
+     * output arrays.  Output arrays not selected by \e outmask are not
+     * referenced and may be null.
+     **********************************************************************/
+    void GenPositions(size_t n, const real s12[], unsigned outmask,
+                      real lat2[], real lon2[], real S12[]) const {
+      GenPositions(n, s12, 0, 0, outmask, lat2, lon2, S12);
+    }
+
+    /**
+     * Compute the positions of equally spaced points on the rhumb line.
+     *
+     * @param[in] n the number of points.
+     * @param[in] s0 the distance from point 1 to the first point (meters).
+     * @param[in] ds the spacing of the points (meters).
+     * @param[in] outmask a bitor'ed combination of RhumbLine::mask values
+     *   specifying which of the following arrays should be set.
+     * @param[out] lat2 array of latitudes (degrees).
+     * @param[out] lon2 array of longitudes (degrees).
+     * @param[out] S12 array of areas under the rhumb line
+     *   (meters<sup>2</sup>).
+     *
+     * Point \e i is at \e s0 + \e i \e ds.  As with
+     * GeodesicLine::GenPositions, the position is computed afresh for each
+     * point, so the results are the same as those returned by
+     * RhumbLine::GenPosition.
+     **********************************************************************/
+    void GenPositions(size_t n, real s0, real ds, unsigned outmask,
+                      real lat2[], real lon2[], real S12[]) const {
+      GenPositions(n, nullptr, s0, ds, outmask, lat2, lon2, S12);
+    }
+
+    /**
+     * Compute the latitudes and longitudes of many points specified by their
+     * distances from point 1.
+     *
+     * See the documentation for RhumbLine::GenPositions.
+     **********************************************************************/
+    void Positions(size_t n, const real s12[],
+                   real lat2[], real lon2[]) const {
+      GenPositions(n, s12, LATITUDE | LONGITUDE, lat2, lon2, nullptr);
+    }
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
@@ -0,0 +1,125 @@
+/**
+ * \file SharedData.hpp
+ * \brief Header for GeographicLib::SharedData class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_SHAREDDATA_HPP)
+#define GEOGRAPHICLIB_SHAREDDATA_HPP 1
+
+#include <string>
+#include <GeographicLib/Constants.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Data files held in named shared memory segments
+   *
+   * When many processes on a host use the same geoid or gravity model, the
+   * memory mapped modes (Geoid::MEMORYMAP, Geoid::POSITIONAL,
+   * Geoid::PRECOMPUTED, Geoid::TILED, and the \e mapped argument of the
+   * GravityModel and MagneticModel constructors) already let them share
+   * the data through the operating system's page cache.  However, the pages
+   * of the cache may be evicted under memory pressure (so that the data has
+   * to be read again from disk) and the data file may be on a slow or
+   * network file system.
+   *
+   * This class lets a loader process copy a data file once into a named
+   * POSIX shared memory segment (created with shm_open).  The segment
+   * persists until it is removed (or the system is restarted).  Thereafter,
+   * whenever one of the memory mapped modes opens the data file, it
+   * attaches to the segment instead (read-only, or copy on write in the
+   * case of the coefficients which GravityModel adjusts).  So the memory
+   * used by the data doesn't grow with the number of processes and none of
+   * the processes need read the file.  No changes are needed to the code
+   * which constructs the Geoid, GravityModel, or MagneticModel objects.
+   *
+   * The name of the segment is derived from the canonical path of the data
+   * file and a segment is only used if its size matches that of the file.
+   * If a data file is replaced by a new version of the same size, the
+   * segment should be removed (and, possibly, loaded again).  Removing a
+   * segment doesn't affect the processes which are already attached to it.
+   *
+   * This is only available on POSIX systems.
+   *
+   * Example of use:
+   * \code
+   * // In the loader
+   * SharedData::Load("/usr/local/share/GeographicLib/geoids/egm2008-1.pgm");
+   * // In the workers (this attaches to the segment)
+   * Geoid g("egm2008-1", "", true, false, Geoid::MEMORYMAP);
+   * \endcode
+   * <code>examples/ShareData.cpp</code> is a command-line loader.
+   **********************************************************************/
+  class GEOGRAPHICLIB_EXPORT SharedData {
+  private:
+    SharedData() = delete;      // Disable constructor
+  public:
+    /**
+     * @return true if shared memory segments are supported on this system.
+     **********************************************************************/
+    static bool Supported();
+
+    /**
+     * The name of the shared memory segment for a data file.
+     *
+     * @param[in] filename the name of the data file.
+     * @return the name of the segment.
+     *
+     * This is "/GeographicLib-" followed by a hash of the canonical path of
+     * the file and its base name (truncated to 200 characters).
+     **********************************************************************/
+    static std::string Name(const std::string& filename);
+
+    /**
+     * Load a data file into a shared memory segment.
+     *
+     * @param[in] filename the name of the data file.
+     * @exception GeographicErr if the file can't be read, the segment can't
+     *   be created, or shared memory segments aren't supported.
+     * @return true if the file was loaded, false if an up to date segment
+     *   already exists.
+     *
+     * A segment of the wrong size is removed and replaced.  The segment
+     * grows as it is written, so processes attaching to it in the meantime
+     * read the file instead.
+     **********************************************************************/
+    static bool Load(const std::string& filename);
+
+    /**
+     * Remove the shared memory segment for a data file.
+     *
+     * @param[in] filename the name of the data file.
+     * @return true if a segment was removed.
+     *
+     * Processes attached to the segment may continue to use it; the memory
+     * is released when the last one detaches.
+     **********************************************************************/
+    static bool Remove(const std::string& filename);
+
+    /**
+     * @param[in] filename the name of the data file.
+     * @return true if an up to date shared memory segment for the file
+     *   exists.
+     **********************************************************************/
+    static bool Loaded(const std::string& filename);
+
+    /**
+     * Open the shared memory segment for a data file.
+     *
+     * @param[in] filename the name of the data file.
+     * @return a read-only file descriptor for the segment or &minus;1 if
+     *   there's no up to date segment.
+     *
+     * This is used by the classes which map or read their data files; the
+     * caller should close the file descriptor.
+     **********************************************************************/
+    static int Open(const std::string& filename);
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_SHAREDDATA_HPP
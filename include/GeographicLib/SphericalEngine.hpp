@@ -12,6 +12,7 @@
 
 #include <vector>
 #include <istream>
+#include <string>
 #include <GeographicLib/Constants.hpp>
 
 #if defined(_MSC_VER)
@@ -23,6 +24,7 @@
 namespace GeographicLib {
 
   class CircularEngine;
+  class RadialEngine;
 
   /**
    * \brief The evaluation engine for SphericalHarmonic
@@ -42,8 +44,12 @@ namespace GeographicLib {
     typedef Math::real real;
     // CircularEngine needs access to sqrttable, scale
     friend class CircularEngine;
-    // Return the table of the square roots of integers
-    static std::vector<real>& sqrttable();
+    // The table of the square roots of integers.  A table, once published,
+    // is never modified; RootTable replaces it with a longer one if needed.
+    struct roottable;
+    static roottable& roots();
+    // Return the current table of the square roots of integers
+    static const real* sqrttable();
     // An internal scaling of the coefficients to avoid overflow in
     // intermediate calculations.
     static real scale() {
@@ -62,6 +68,8 @@ namespace GeographicLib {
       return std::numeric_limits<real>::epsilon() *
         sqrt(std::numeric_limits<real>::epsilon());
     }
+    // The number of orders handled as a unit by a thread in Circle.
+    static const int morders_ = 32;
     SphericalEngine();          // Disable constructor
   public:
     /**
@@ -99,13 +107,17 @@ namespace GeographicLib {
     class GEOGRAPHICLIB_EXPORT coeff {
     private:
       int _Nx, _nmx, _mmx;
-      std::vector<real>::const_iterator _Cnm;
-      std::vector<real>::const_iterator _Snm;
+      const real* _Cnm;
+      const real* _Snm;
+      // Used instead of _Cnm and _Snm if the coefficients are stored as floats
+      const float* _Cf;
+      const float* _Sf;
     public:
       /**
        * A default constructor
        **********************************************************************/
-      coeff() : _Nx(-1) , _nmx(-1) , _mmx(-1) {}
+      coeff() : _Nx(-1) , _nmx(-1) , _mmx(-1), _Cnm(nullptr), _Snm(nullptr)
+              , _Cf(nullptr), _Sf(nullptr) {}
       /**
        * The general constructor.
        *
@@ -127,8 +139,10 @@ namespace GeographicLib {
         : _Nx(N)
         , _nmx(nmx)
         , _mmx(mmx)
-        , _Cnm(C.begin())
-        , _Snm(S.begin())
+        , _Cnm(C.data())
+        , _Snm(S.data())
+        , _Cf(nullptr)
+        , _Sf(nullptr)
       {
         if (!((_Nx >= _nmx && _nmx >= _mmx && _mmx >= 0) ||
               // If mmx = -1 then the sums are empty so require nmx = -1 also.
@@ -157,8 +171,10 @@ namespace GeographicLib {
         : _Nx(N)
         , _nmx(N)
         , _mmx(N)
-        , _Cnm(C.begin())
-        , _Snm(S.begin())
+        , _Cnm(C.data())
+        , _Snm(S.data())
+        , _Cf(nullptr)
+        , _Sf(nullptr)
       {
         if (!(_Nx >= -1))
           throw GeographicErr("Bad indices for coeff");
@@ -167,6 +183,92 @@ namespace GeographicLib {
           throw GeographicErr("Arrays too small in coeff");
         SphericalEngine::RootTable(_nmx);
       }
+      /**
+       * A constructor for coefficients held in arrays.
+       *
+       * @param[in] C an array of coefficients for the cosine terms.
+       * @param[in] S an array of coefficients for the sine terms.
+       * @param[in] N the degree giving storage layout for \e C and \e S.
+       * @param[in] nmx the maximum degree to be used.
+       * @param[in] mmx the maximum order to be used.
+       * @exception GeographicErr if \e N, \e nmx, and \e mmx do not satisfy
+       *   \e N &ge; \e nmx &ge; \e mmx &ge; &minus;1.
+       * @exception std::bad_alloc if the memory for the square root table
+       *   can't be allocated.
+       *
+       * This allows the coefficients to be held in memory not owned by a
+       * std::vector, e.g., a mappedfile.  \e C and \e S must hold at least
+       * Csize(\e N, \e mmx) and Ssize(\e N, \e mmx) elements; this is not
+       * checked.
+       **********************************************************************/
+      coeff(const real C[], const real S[], int N, int nmx, int mmx)
+        : _Nx(N)
+        , _nmx(nmx)
+        , _mmx(mmx)
+        , _Cnm(C)
+        , _Snm(S)
+        , _Cf(nullptr)
+        , _Sf(nullptr)
+      {
+        if (!((_Nx >= _nmx && _nmx >= _mmx && _mmx >= 0) ||
+              // If mmx = -1 then the sums are empty so require nmx = -1 also.
+              (_nmx == -1 && _mmx == -1)))
+          throw GeographicErr("Bad indices for coeff");
+        SphericalEngine::RootTable(_nmx);
+      }
+      /**
+       * A constructor for coefficients stored as floats.
+       *
+       * @param[in] C an array of coefficients for the cosine terms.
+       * @param[in] S an array of coefficients for the sine terms.
+       * @param[in] N the degree giving storage layout for \e C and \e S.
+       * @param[in] nmx the maximum degree to be used.
+       * @param[in] mmx the maximum order to be used.
+       * @exception GeographicErr if \e N, \e nmx, and \e mmx do not satisfy
+       *   \e N &ge; \e nmx &ge; \e mmx &ge; &minus;1.
+       * @exception std::bad_alloc if the memory for the square root table
+       *   can't be allocated.
+       *
+       * This halves the memory needed for the coefficients (and the memory
+       * traffic in evaluating the sums) compared with storing them as
+       * doubles.  The sums are still accumulated with type Math::real;
+       * however, the coefficients themselves are only accurate to a relative
+       * error of 6 &times; 10<sup>&minus;8</sup>.  The sizes of \e C and \e
+       * S are the same as for the previous constructor; this is not checked.
+       **********************************************************************/
+      coeff(const float C[], const float S[], int N, int nmx, int mmx)
+        : _Nx(N)
+        , _nmx(nmx)
+        , _mmx(mmx)
+        , _Cnm(nullptr)
+        , _Snm(nullptr)
+        , _Cf(C)
+        , _Sf(S)
+      {
+        if (!((_Nx >= _nmx && _nmx >= _mmx && _mmx >= 0) ||
+              // If mmx = -1 then the sums are empty so require nmx = -1 also.
+              (_nmx == -1 && _mmx == -1)))
+          throw GeographicErr("Bad indices for coeff");
+        SphericalEngine::RootTable(_nmx);
+      }
+      /**
+       * A truncated copy of the coefficients.
+       *
+       * @param[in] nmx the maximum degree to be used.
+       * @param[in] mmx the maximum order to be used.
+       * @return a coeff object sharing the coefficients of this one whose
+       *   maximum degree and order are reduced to \e nmx and \e mmx (if
+       *   these are smaller than the current values).
+       *
+       * The sums are empty if \e nmx or \e mmx is negative.
+       **********************************************************************/
+      coeff Truncate(int nmx, int mmx) const {
+        coeff c(*this);
+        c._nmx = (std::min)(_nmx, nmx);
+        c._mmx = (std::min)((std::min)(_mmx, mmx), c._nmx);
+        if (c._mmx < 0) c._nmx = c._mmx = -1;
+        return c;
+      }
       /**
        * @return \e N the degree giving storage layout for \e C and \e S.
        **********************************************************************/
@@ -194,14 +296,18 @@ namespace GeographicLib {
        * @param[in] k the one-dimensional index.
        * @return the value of the \e C coefficient.
        **********************************************************************/
-      Math::real Cv(int k) const { return *(_Cnm + k); }
+      Math::real Cv(int k) const
+      { return _Cf ? real(*(_Cf + k)) : *(_Cnm + k); }
       /**
        * An element of \e S.
        *
        * @param[in] k the one-dimensional index.
        * @return the value of the \e S coefficient.
        **********************************************************************/
-      Math::real Sv(int k) const { return *(_Snm + (k - (_Nx + 1))); }
+      Math::real Sv(int k) const {
+        return _Cf ? real(*(_Sf + (k - (_Nx + 1)))) :
+          *(_Snm + (k - (_Nx + 1)));
+      }
       /**
        * An element of \e C with checking.
        *
@@ -213,7 +319,7 @@ namespace GeographicLib {
        *   and \e m are in range else 0.
        **********************************************************************/
       Math::real Cv(int k, int n, int m, real f) const
-      { return m > _mmx || n > _nmx ? 0 : *(_Cnm + k) * f; }
+      { return m > _mmx || n > _nmx ? 0 : Cv(k) * f; }
       /**
        * An element of \e S with checking.
        *
@@ -225,7 +331,7 @@ namespace GeographicLib {
        *   and \e m are in range else 0.
        **********************************************************************/
       Math::real Sv(int k, int n, int m, real f) const
-      { return m > _mmx || n > _nmx ? 0 : *(_Snm + (k - (_Nx + 1))) * f; }
+      { return m > _mmx || n > _nmx ? 0 : Sv(k) * f; }
 
       /**
        * The size of the coefficient vector for the cosine terms.
@@ -277,6 +383,78 @@ namespace GeographicLib {
       static void readcoeffs(std::istream& stream, int& N, int& M,
                              std::vector<real>& C, std::vector<real>& S,
                              bool truncate = false);
+
+      /**
+       * Locate coefficients in a memory mapped file.
+       *
+       * @param[in] data the start of the mapped data.
+       * @param[in] size the size of the mapped data.
+       * @param[in,out] pos the offset of the coefficients in \e data; on
+       *   return, the offset of the data following the coefficients.
+       * @param[out] N The maximum degree of the coefficients.
+       * @param[out] M The maximum order of the coefficients.
+       * @param[out] C a pointer to the cosine coefficients.
+       * @param[out] S a pointer to the sine coefficients.
+       * @exception GeographicErr if \e N and \e M do not satisfy \e N &ge;
+       *   \e M &ge; &minus;1.
+       * @exception GeographicErr if the data is truncated or misaligned.
+       *
+       * This is the counterpart of readcoeffs for data which has been
+       * mapped with mappedfile; the format is the same.  No data is copied,
+       * \e C and \e S point into \e data, which must therefore outlive all
+       * the coeff objects using them.  This can only be used if
+       * mappedfile::Supported() is true.  Use a coeff object with \e N as the
+       * storage degree to access a truncated set of coefficients.
+       **********************************************************************/
+      static void mapcoeffs(char* data, size_t size, size_t& pos,
+                            int& N, int& M, real*& C, real*& S);
+    };
+
+    /**
+     * \brief A file mapped into memory
+     *
+     * The file is mapped privately (copy on write) so that the few
+     * coefficients which GravityModel adjusts after loading can be modified
+     * in place; the rest of the pages are shared by all the processes which
+     * map the same file and are only read from disk on demand.  This is only
+     * available on POSIX systems.
+     **********************************************************************/
+    class GEOGRAPHICLIB_EXPORT mappedfile {
+    private:
+      char* _data;
+      size_t _size;
+      mappedfile(const mappedfile&) = delete; // copy constructor not allowed
+      mappedfile& operator=(const mappedfile&) = delete; // nor copy assignment
+    public:
+      /**
+       * A default constructor; no file is mapped.
+       **********************************************************************/
+      mappedfile() : _data(nullptr), _size(0) {}
+      /**
+       * The destructor unmaps the file.
+       **********************************************************************/
+      ~mappedfile();
+      /**
+       * Map a file into memory.
+       *
+       * @param[in] filename the name of the file.
+       * @exception GeographicErr if the file can't be opened or mapped.
+       **********************************************************************/
+      void Map(const std::string& filename);
+      /**
+       * @return the start of the mapped data (nullptr if no file is mapped).
+       **********************************************************************/
+      char* data() const { return _data; }
+      /**
+       * @return the size of the mapped data.
+       **********************************************************************/
+      size_t size() const { return _size; }
+      /**
+       * @return true if the coefficients in a file can be used in place, i.e.,
+       *   memory mapping is available on this system, the machine is
+       *   little-endian, and Math::real is an IEEE double.
+       **********************************************************************/
+      static bool Supported();
     };
 
     /**
@@ -305,13 +483,99 @@ namespace GeographicLib {
      * parameters, to allow more optimization to be done at compile time.
      *
      * Clenshaw summation is used which permits the evaluation of the sum
-     * without the need to allocate temporary arrays.  Thus this function never
-     * throws an exception.
+     * without the need to allocate temporary arrays.  Thus, if \e threads is
+     * 1, this function never throws an exception.  If \e threads is greater
+     * than 1 and the maximum order is large enough, the inner sums over degree
+     * are computed by Circle using that many threads and the outer sum over
+     * order is done with the resulting CircularEngine; this requires
+     * temporary arrays of length \e M + 1 and so may throw std::bad_alloc.
+     * The result agrees with the single-threaded result to roundoff.
+     *
+     * The inner sum for order \e m runs over decreasing degree \e n, and the
+     * coefficients \e C[\e n,\e m] and \e S[\e n,\e m] for fixed \e m are
+     * contiguous in the column-major storage layout.  So the coefficients of
+     * each component are read as two sequential streams (in the reverse
+     * direction), which hardware prefetching handles well.  For EGM2008 the
+     * cost is dominated by the arithmetic of the recurrence, not by memory
+     * access; storing \e C and \e S interleaved makes no measurable
+     * difference.
      **********************************************************************/
     template<bool gradp, normalization norm, int L>
       static Math::real Value(const coeff c[], const real f[],
                               real x, real y, real z, real a,
-                              real& gradx, real& grady, real& gradz);
+                              real& gradx, real& grady, real& gradz,
+                              unsigned threads = 1);
+
+    /**
+     * Evaluate a spherical harmonic sum, its gradient, and its Hessian.
+     *
+     * @tparam norm the normalization for the associated Legendre polynomials.
+     * @tparam L the number of terms in the coefficients.
+     * @param[in] c an array of coeff objects.
+     * @param[in] f array of coefficient multipliers.  f[0] should be 1.
+     * @param[in] x the \e x component of the cartesian position.
+     * @param[in] y the \e y component of the cartesian position.
+     * @param[in] z the \e z component of the cartesian position.
+     * @param[in] a the normalizing radius.
+     * @param[out] gradx the \e x component of the gradient.
+     * @param[out] grady the \e y component of the gradient.
+     * @param[out] gradz the \e z component of the gradient.
+     * @param[out] hxx the \e xx component of the Hessian.
+     * @param[out] hxy the \e xy component of the Hessian.
+     * @param[out] hxz the \e xz component of the Hessian.
+     * @param[out] hyy the \e yy component of the Hessian.
+     * @param[out] hyz the \e yz component of the Hessian.
+     * @param[out] hzz the \e zz component of the Hessian.
+     * @result the spherical harmonic sum.
+     *
+     * This is the same as Value (with \e gradp = true and \e threads = 1)
+     * except that the second derivatives are also computed.  All the
+     * quantities are found in a single Clenshaw pass over the coefficients:
+     * the inner sums carry the first and second derivatives with respect to
+     * \e r and &theta; and the derivatives with respect to &lambda; are
+     * included in the outer sums.  This costs less than twice as much as the
+     * evaluation of the gradient (compared with a factor of 6 for finding
+     * the Hessian by central differences of the gradient).  The Hessian is
+     * symmetric, so only 6 of its components are returned.  The
+     * combinations of the second derivatives in spherical coordinates which
+     * are singular at the poles are formed before the outer sum so that the
+     * results remain accurate close to the poles.
+     **********************************************************************/
+    template<normalization norm, int L>
+      static Math::real Hessian(const coeff c[], const real f[],
+                                real x, real y, real z, real a,
+                                real& gradx, real& grady, real& gradz,
+                                real& hxx, real& hxy, real& hxz,
+                                real& hyy, real& hyz, real& hzz);
+
+    /**
+     * Evaluate a spherical harmonic sum and its horizontal gradient.
+     *
+     * @tparam norm the normalization for the associated Legendre polynomials.
+     * @tparam L the number of terms in the coefficients.
+     * @param[in] c an array of coeff objects.
+     * @param[in] f array of coefficient multipliers.  f[0] should be 1.
+     * @param[in] x the \e x component of the cartesian position.
+     * @param[in] y the \e y component of the cartesian position.
+     * @param[in] z the \e z component of the cartesian position.
+     * @param[in] a the normalizing radius.
+     * @param[out] grade the easterly component of the gradient,
+     *   1/(\e r sin&theta;) &part;\e V/&part;&lambda;.
+     * @param[out] gradn the northerly component of the gradient, &minus;1/\e
+     *   r &part;\e V/&part;&theta;.
+     * @result the spherical harmonic sum.
+     *
+     * This is the same as Value (with \e gradp = true and \e threads = 1)
+     * except that the radial derivative is not computed and the gradient is
+     * given in the local spherical frame (the directions of increasing
+     * longitude and geocentric latitude).  Omitting the recurrences for the
+     * radial derivative saves about a quarter of the work of Value.  This is
+     * what's needed for the deflection of the vertical.
+     **********************************************************************/
+    template<normalization norm, int L>
+      static Math::real Horizontal(const coeff c[], const real f[],
+                                   real x, real y, real z, real a,
+                                   real& grade, real& gradn);
 
     /**
      * Create a CircularEngine object
@@ -325,6 +589,7 @@ namespace GeographicLib {
      *   <i>y</i><sup>2</sup>).
      * @param[in] z the height of the circle.
      * @param[in] a the normalizing radius.
+     * @param[in] threads the number of threads to use (default 1).
      * @exception std::bad_alloc if the memory for the CircularEngine can't be
      *   allocated.
      * @result the CircularEngine object.
@@ -335,10 +600,76 @@ namespace GeographicLib {
      * call SphericalEngine::Circle to give a CircularEngine object and then
      * call CircularEngine::operator()() with arguments <i>x</i>/\e p and
      * <i>y</i>/\e p.
+     *
+     * The inner sums for the different orders \e m are independent.  If \e
+     * threads is greater than 1, the orders are split into blocks which are
+     * summed concurrently by up to \e threads threads (if the threads can't
+     * be started, the work is done on fewer threads).  This reduces the
+     * latency of setting up a circle for a high-degree model; the results are
+     * identical to the single-threaded ones.  A single thread is used for
+     * models of low order, where the cost of starting the threads dominates.
+     * The coefficients and the square root table are only read, so
+     * concurrent calls are safe.
      **********************************************************************/
     template<bool gradp, normalization norm, int L>
       static CircularEngine Circle(const coeff c[], const real f[],
-                                   real p, real z, real a);
+                                   real p, real z, real a,
+                                   unsigned threads = 1);
+
+    /**
+     * Reinitialize a CircularEngine object in place.
+     *
+     * @tparam gradp should the gradient be calculated.
+     * @tparam norm the normalization for the associated Legendre polynomials.
+     * @tparam L the number of terms in the coefficients.
+     * @param[in] c an array of coeff objects.
+     * @param[in] f array of coefficient multipliers.  f[0] should be 1.
+     * @param[in] p the radius of the circle = sqrt(<i>x</i><sup>2</sup> +
+     *   <i>y</i><sup>2</sup>).
+     * @param[in] z the height of the circle.
+     * @param[in] a the normalizing radius.
+     * @param[in] threads the number of threads to use.
+     * @param[out] circ the CircularEngine object.
+     * @exception std::bad_alloc if the memory for the CircularEngine can't be
+     *   allocated.
+     *
+     * This is the same as Circle(c, f, p, z, a, threads) except that the
+     * result is placed in \e circ reusing its storage.  This avoids the
+     * allocation of memory when the circles for many latitudes are computed
+     * one after the other.
+     **********************************************************************/
+    template<bool gradp, normalization norm, int L>
+      static void Circle(const coeff c[], const real f[],
+                         real p, real z, real a, unsigned threads,
+                         CircularEngine& circ);
+
+    /**
+     * Create a RadialEngine object
+     *
+     * @tparam gradp should the gradient be calculated.
+     * @tparam norm the normalization for the associated Legendre polynomials.
+     * @tparam L the number of terms in the coefficients.
+     * @param[in] c an array of coeff objects.
+     * @param[in] f array of coefficient multipliers.  f[0] should be 1.
+     * @param[in] x the \e x component of a point on the ray.
+     * @param[in] y the \e y component of a point on the ray.
+     * @param[in] z the \e z component of a point on the ray.
+     * @param[in] a the normalizing radius.
+     * @exception std::bad_alloc if the memory for the RadialEngine can't be
+     *   allocated.
+     * @result the RadialEngine object.
+     *
+     * If you need to evaluate the spherical harmonic sum for several points
+     * on the ray from the origin through (\e x, \e y, \e z), it is more
+     * efficient to call SphericalEngine::Radial to give a RadialEngine object
+     * and then call RadialEngine::operator()() with the radii of the points.
+     * This function performs the sums over order \e m for each degree \e n
+     * (about <i>N</i><sup>2</sup> operations); RadialEngine::operator()()
+     * performs the sum over degree (about \e N operations).
+     **********************************************************************/
+    template<bool gradp, normalization norm, int L>
+      static RadialEngine Radial(const coeff c[], const real f[],
+                                 real x, real y, real z, real a);
     /**
      * Check that the static table of square roots is big enough and enlarge it
      * if necessary.
@@ -348,15 +679,15 @@ namespace GeographicLib {
      *   be allocated.
      *
      * Typically, there's no need for an end-user to call this routine, because
-     * the constructors for SphericalEngine::coeff do so.  However, since this
-     * updates a static table, there's a possible race condition in a
-     * multi-threaded environment.  Because this routine does nothing if the
-     * table is already large enough, one way to avoid race conditions is to
-     * call this routine at program start up (when it's still single threaded),
-     * supplying the largest degree that your program will use.  E.g., \code
-     GeographicLib::SphericalEngine::RootTable(2190);
-     \endcode
-     * suffices to accommodate extant magnetic and gravity models.
+     * the constructors for SphericalEngine::coeff do so.  This routine may be
+     * called concurrently with other calls to it and with evaluations of
+     * spherical harmonic sums by other threads; no external synchronization
+     * is needed.  A table is never modified once it is in use; if a longer
+     * table is needed, a new one is made (under a lock) and published
+     * atomically.  The superseded tables are retained, because another
+     * thread may still be reading them; the lengths grow geometrically so
+     * that the total memory is at most a few times that of the largest table
+     * (about 35 kB for \e N = 2190).
      **********************************************************************/
     static void RootTable(int N);
 
@@ -369,10 +700,7 @@ namespace GeographicLib {
      * \warning It's safest not to call this routine at all.  (The space used
      * by the table is modest.)
      **********************************************************************/
-    static void ClearRootTable() {
-      std::vector<real> temp(0);
-      sqrttable().swap(temp);
-    }
+    static void ClearRootTable();
   };
 
 } // namespace GeographicLib
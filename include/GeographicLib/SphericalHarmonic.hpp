@@ -14,6 +14,7 @@
 #include <GeographicLib/Constants.hpp>
 #include <GeographicLib/SphericalEngine.hpp>
 #include <GeographicLib/CircularEngine.hpp>
+#include <GeographicLib/RadialEngine.hpp>
 
 namespace GeographicLib {
 
@@ -203,6 +204,26 @@ namespace GeographicLib {
       , _norm(norm)
     { _c[0] = SphericalEngine::coeff(C, S, N, nmx, mmx); }
 
+    /**
+     * Constructor from a SphericalEngine::coeff object.
+     *
+     * @param[in] c the coefficients.
+     * @param[in] a the reference radius appearing in the definition of the
+     *   sum.
+     * @param[in] norm the normalization for the associated Legendre
+     *   polynomials, either SphericalHarmonic::FULL (the default) or
+     *   SphericalHarmonic::SCHMIDT.
+     *
+     * This allows the coefficients to be supplied in arrays not owned by a
+     * std::vector, e.g., in a SphericalEngine::mappedfile.  The same caveat
+     * about the lifetime of the coefficients applies.
+     **********************************************************************/
+    SphericalHarmonic(const SphericalEngine::coeff& c,
+                      real a, unsigned norm = FULL)
+      : _a(a)
+      , _norm(norm)
+    { _c[0] = c; }
+
     /**
      * A default constructor so that the object can be created when the
      * constructor for another object is initialized.  This default object can
@@ -273,6 +294,48 @@ namespace GeographicLib {
       return v;
     }
 
+    /**
+     * Compute a spherical harmonic sum, its gradient, and its Hessian.
+     *
+     * @param[in] x cartesian coordinate.
+     * @param[in] y cartesian coordinate.
+     * @param[in] z cartesian coordinate.
+     * @param[out] gradx \e x component of the gradient
+     * @param[out] grady \e y component of the gradient
+     * @param[out] gradz \e z component of the gradient
+     * @param[out] hxx \e xx component of the Hessian
+     * @param[out] hxy \e xy component of the Hessian
+     * @param[out] hxz \e xz component of the Hessian
+     * @param[out] hyy \e yy component of the Hessian
+     * @param[out] hyz \e yz component of the Hessian
+     * @param[out] hzz \e zz component of the Hessian
+     * @return \e V the spherical harmonic sum.
+     *
+     * The second derivatives are found in the same pass over the
+     * coefficients as \e V and its gradient; see SphericalEngine::Hessian.
+     **********************************************************************/
+    Math::real Hessian(real x, real y, real z,
+                       real& gradx, real& grady, real& gradz,
+                       real& hxx, real& hxy, real& hxz,
+                       real& hyy, real& hyz, real& hzz) const {
+      real f[] = {1};
+      real v = 0;
+      switch (_norm) {
+      case FULL:
+        v = SphericalEngine::Hessian<SphericalEngine::FULL, 1>
+          (_c, f, x, y, z, _a, gradx, grady, gradz,
+           hxx, hxy, hxz, hyy, hyz, hzz);
+        break;
+      case SCHMIDT:
+      default:                  // To avoid compiler warnings
+        v = SphericalEngine::Hessian<SphericalEngine::SCHMIDT, 1>
+          (_c, f, x, y, z, _a, gradx, grady, gradz,
+           hxx, hxy, hxz, hyy, hyz, hzz);
+        break;
+      }
+      return v;
+    }
+
     /**
      * Create a CircularEngine to allow the efficient evaluation of several
      * points on a circle of latitude.
@@ -281,6 +344,8 @@ namespace GeographicLib {
      * @param[in] z the height of the circle above the equatorial plane.
      * @param[in] gradp if true the returned object will be able to compute the
      *   gradient of the sum.
+     * @param[in] threads the number of threads to use in computing the inner
+     *   sums (default 1); see SphericalEngine::Circle.
      * @exception std::bad_alloc if the memory for the CircularEngine can't be
      *   allocated.
      * @return the CircularEngine object.
@@ -323,23 +388,108 @@ namespace GeographicLib {
      }
      \endcode
      **********************************************************************/
-    CircularEngine Circle(real p, real z, bool gradp) const {
+    CircularEngine Circle(real p, real z, bool gradp, unsigned threads = 1)
+      const {
       real f[] = {1};
       switch (_norm) {
       case FULL:
         return gradp ?
           SphericalEngine::Circle<true, SphericalEngine::FULL, 1>
-          (_c, f, p, z, _a) :
+          (_c, f, p, z, _a, threads) :
           SphericalEngine::Circle<false, SphericalEngine::FULL, 1>
-          (_c, f, p, z, _a);
+          (_c, f, p, z, _a, threads);
         break;
       case SCHMIDT:
       default:                  // To avoid compiler warnings
         return gradp ?
           SphericalEngine::Circle<true, SphericalEngine::SCHMIDT, 1>
-          (_c, f, p, z, _a) :
+          (_c, f, p, z, _a, threads) :
           SphericalEngine::Circle<false, SphericalEngine::SCHMIDT, 1>
-          (_c, f, p, z, _a);
+          (_c, f, p, z, _a, threads);
+        break;
+      }
+    }
+
+    /**
+     * Reinitialize a CircularEngine in place.
+     *
+     * @param[in] p the radius of the circle.
+     * @param[in] z the height of the circle above the equatorial plane.
+     * @param[in] gradp if true the resulting object will be able to compute
+     *   the gradient of the sum.
+     * @param[in] threads the number of threads to use in computing the inner
+     *   sums; see SphericalEngine::Circle.
+     * @param[out] circ the CircularEngine object.
+     * @exception std::bad_alloc if the memory for the CircularEngine can't be
+     *   allocated.
+     *
+     * This gives the same result as \e circ = Circle(\e p, \e z, \e gradp,
+     * \e threads); however the storage of \e circ is reused.  So, when the
+     * sums are needed on many circles in turn, no memory is allocated after
+     * the first circle (provided that \e gradp is not changed from false to
+     * true).
+     **********************************************************************/
+    void Circle(real p, real z, bool gradp, unsigned threads,
+                CircularEngine& circ) const {
+      real f[] = {1};
+      switch (_norm) {
+      case FULL:
+        if (gradp)
+          SphericalEngine::Circle<true, SphericalEngine::FULL, 1>
+            (_c, f, p, z, _a, threads, circ);
+        else
+          SphericalEngine::Circle<false, SphericalEngine::FULL, 1>
+            (_c, f, p, z, _a, threads, circ);
+        break;
+      case SCHMIDT:
+      default:                  // To avoid compiler warnings
+        if (gradp)
+          SphericalEngine::Circle<true, SphericalEngine::SCHMIDT, 1>
+            (_c, f, p, z, _a, threads, circ);
+        else
+          SphericalEngine::Circle<false, SphericalEngine::SCHMIDT, 1>
+            (_c, f, p, z, _a, threads, circ);
+        break;
+      }
+    }
+
+    /**
+     * Create a RadialEngine to allow the efficient evaluation of several
+     * points on a radial line.
+     *
+     * @param[in] x cartesian coordinate of a point on the line.
+     * @param[in] y cartesian coordinate of a point on the line.
+     * @param[in] z cartesian coordinate of a point on the line.
+     * @param[in] gradp if true the returned object will be able to compute the
+     *   gradient of the sum.
+     * @exception std::bad_alloc if the memory for the RadialEngine can't be
+     *   allocated.
+     * @return the RadialEngine object.
+     *
+     * This performs the sums over order \e m, which are independent of the
+     * radius (about <i>N</i><sup>2</sup> operations).  Calling
+     * RadialEngine::operator()() on the returned object with a radius \e r
+     * performs the sum over degree \e n (about \e N operations) and gives
+     * the same result as SphericalHarmonic::operator()() at the point on the
+     * ray from the origin through (\e x, \e y, \e z) at radius \e r.
+     **********************************************************************/
+    RadialEngine Radial(real x, real y, real z, bool gradp) const {
+      real f[] = {1};
+      switch (_norm) {
+      case FULL:
+        return gradp ?
+          SphericalEngine::Radial<true, SphericalEngine::FULL, 1>
+          (_c, f, x, y, z, _a) :
+          SphericalEngine::Radial<false, SphericalEngine::FULL, 1>
+          (_c, f, x, y, z, _a);
+        break;
+      case SCHMIDT:
+      default:                  // To avoid compiler warnings
+        return gradp ?
+          SphericalEngine::Radial<true, SphericalEngine::SCHMIDT, 1>
+          (_c, f, x, y, z, _a) :
+          SphericalEngine::Radial<false, SphericalEngine::SCHMIDT, 1>
+          (_c, f, x, y, z, _a);
         break;
       }
     }
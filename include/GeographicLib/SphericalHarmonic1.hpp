@@ -14,6 +14,7 @@
 #include <GeographicLib/Constants.hpp>
 #include <GeographicLib/SphericalEngine.hpp>
 #include <GeographicLib/CircularEngine.hpp>
+#include <GeographicLib/RadialEngine.hpp>
 
 namespace GeographicLib {
 
@@ -148,6 +149,38 @@ namespace GeographicLib {
       _c[1] = SphericalEngine::coeff(C1, S1, N1, nmx1, mmx1);
     }
 
+    /**
+     * Constructor from SphericalEngine::coeff objects.
+     *
+     * @param[in] c the coefficients <i>C</i><sub><i>nm</i></sub> and
+     *   <i>S</i><sub><i>nm</i></sub>.
+     * @param[in] c1 the coefficients <i>C'</i><sub><i>nm</i></sub> and
+     *   <i>S'</i><sub><i>nm</i></sub>.
+     * @param[in] a the reference radius appearing in the definition of the
+     *   sum.
+     * @param[in] norm the normalization for the associated Legendre
+     *   polynomials, either SphericalHarmonic1::FULL (the default) or
+     *   SphericalHarmonic1::SCHMIDT.
+     * @exception GeographicErr if the maximum degree or order of \e c1 exceeds
+     *   that of \e c.
+     *
+     * This allows the coefficients to be supplied in arrays not owned by a
+     * std::vector, e.g., in a SphericalEngine::mappedfile.  The same caveat
+     * about the lifetime of the coefficients applies.
+     **********************************************************************/
+    SphericalHarmonic1(const SphericalEngine::coeff& c,
+                       const SphericalEngine::coeff& c1,
+                       real a, unsigned norm = FULL)
+      : _a(a)
+      , _norm(norm) {
+      if (!(c1.nmx() <= c.nmx()))
+        throw GeographicErr("nmx1 cannot be larger that nmx");
+      if (!(c1.mmx() <= c.mmx()))
+        throw GeographicErr("mmx1 cannot be larger that mmx");
+      _c[0] = c;
+      _c[1] = c1;
+    }
+
     /**
      * A default constructor so that the object can be created when the
      * constructor for another object is initialized.  This default object can
@@ -221,6 +254,41 @@ namespace GeographicLib {
       return v;
     }
 
+    /**
+     * Compute a spherical harmonic sum with a correction term and its
+     * horizontal gradient.
+     *
+     * @param[in] tau multiplier for correction coefficients \e C' and \e S'.
+     * @param[in] x cartesian coordinate.
+     * @param[in] y cartesian coordinate.
+     * @param[in] z cartesian coordinate.
+     * @param[out] grade the easterly component of the gradient.
+     * @param[out] gradn the northerly component of the gradient (in the
+     *   direction of increasing geocentric latitude).
+     * @return \e V the spherical harmonic sum.
+     *
+     * This omits the radial derivative and so is cheaper than
+     * operator()(real, real, real, real, real&, real&, real&) const; see
+     * SphericalEngine::Horizontal.
+     **********************************************************************/
+    Math::real Horizontal(real tau, real x, real y, real z,
+                          real& grade, real& gradn) const {
+      real f[] = {1, tau};
+      real v = 0;
+      switch (_norm) {
+      case FULL:
+        v = SphericalEngine::Horizontal<SphericalEngine::FULL, 2>
+          (_c, f, x, y, z, _a, grade, gradn);
+        break;
+      case SCHMIDT:
+      default:                  // To avoid compiler warnings
+        v = SphericalEngine::Horizontal<SphericalEngine::SCHMIDT, 2>
+          (_c, f, x, y, z, _a, grade, gradn);
+        break;
+      }
+      return v;
+    }
+
     /**
      * Create a CircularEngine to allow the efficient evaluation of several
      * points on a circle of latitude at a fixed value of \e tau.
@@ -230,6 +298,8 @@ namespace GeographicLib {
      * @param[in] z the height of the circle above the equatorial plane.
      * @param[in] gradp if true the returned object will be able to compute the
      *   gradient of the sum.
+     * @param[in] threads the number of threads to use in computing the inner
+     *   sums (default 1); see SphericalEngine::Circle.
      * @exception std::bad_alloc if the memory for the CircularEngine can't be
      *   allocated.
      * @return the CircularEngine object.
@@ -245,23 +315,109 @@ namespace GeographicLib {
      *
      * See SphericalHarmonic::Circle for an example of its use.
      **********************************************************************/
-    CircularEngine Circle(real tau, real p, real z, bool gradp) const {
+    CircularEngine Circle(real tau, real p, real z, bool gradp,
+                          unsigned threads = 1) const {
       real f[] = {1, tau};
       switch (_norm) {
       case FULL:
         return gradp ?
           SphericalEngine::Circle<true, SphericalEngine::FULL, 2>
-          (_c, f, p, z, _a) :
+          (_c, f, p, z, _a, threads) :
           SphericalEngine::Circle<false, SphericalEngine::FULL, 2>
-          (_c, f, p, z, _a);
+          (_c, f, p, z, _a, threads);
         break;
       case SCHMIDT:
       default:                  // To avoid compiler warnings
         return gradp ?
           SphericalEngine::Circle<true, SphericalEngine::SCHMIDT, 2>
-          (_c, f, p, z, _a) :
+          (_c, f, p, z, _a, threads) :
+          SphericalEngine::Circle<false, SphericalEngine::SCHMIDT, 2>
+          (_c, f, p, z, _a, threads);
+        break;
+      }
+    }
+
+    /**
+     * Reinitialize a CircularEngine in place.
+     *
+     * @param[in] tau the multiplier for the correction coefficients.
+     * @param[in] p the radius of the circle.
+     * @param[in] z the height of the circle above the equatorial plane.
+     * @param[in] gradp if true the resulting object will be able to compute
+     *   the gradient of the sum.
+     * @param[in] threads the number of threads to use in computing the inner
+     *   sums; see SphericalEngine::Circle.
+     * @param[out] circ the CircularEngine object.
+     * @exception std::bad_alloc if the memory for the CircularEngine can't be
+     *   allocated.
+     *
+     * This gives the same result as \e circ = Circle(\e tau, \e p, \e z,
+     * \e gradp, \e threads), but reuses the storage of \e circ; see
+     * SphericalHarmonic::Circle(real, real, bool, unsigned, CircularEngine&)
+     * const.
+     **********************************************************************/
+    void Circle(real tau, real p, real z, bool gradp, unsigned threads,
+                CircularEngine& circ) const {
+      real f[] = {1, tau};
+      switch (_norm) {
+      case FULL:
+        if (gradp)
+          SphericalEngine::Circle<true, SphericalEngine::FULL, 2>
+            (_c, f, p, z, _a, threads, circ);
+        else
+          SphericalEngine::Circle<false, SphericalEngine::FULL, 2>
+            (_c, f, p, z, _a, threads, circ);
+        break;
+      case SCHMIDT:
+      default:                  // To avoid compiler warnings
+        if (gradp)
+          SphericalEngine::Circle<true, SphericalEngine::SCHMIDT, 2>
+            (_c, f, p, z, _a, threads, circ);
+        else
           SphericalEngine::Circle<false, SphericalEngine::SCHMIDT, 2>
-          (_c, f, p, z, _a);
+            (_c, f, p, z, _a, threads, circ);
+        break;
+      }
+    }
+
+    /**
+     * Create a RadialEngine to allow the efficient evaluation of several
+     * points on a radial line.
+     *
+     * @param[in] tau multiplier for correction coefficients \e C' and \e S'.
+     * @param[in] x cartesian coordinate of a point on the line.
+     * @param[in] y cartesian coordinate of a point on the line.
+     * @param[in] z cartesian coordinate of a point on the line.
+     * @param[in] gradp if true the returned object will be able to compute the
+     *   gradient of the sum.
+     * @exception std::bad_alloc if the memory for the RadialEngine can't be
+     *   allocated.
+     * @return the RadialEngine object.
+     *
+     * This performs the sums over order \e m, which are independent of the
+     * radius (about <i>N</i><sup>2</sup> operations).  Calling
+     * RadialEngine::operator()() on the returned object with a radius \e r
+     * performs the sum over degree \e n (about \e N operations) and gives
+     * the same result as SphericalHarmonic1::operator()() at the point on
+     * the ray from the origin through (\e x, \e y, \e z) at radius \e r.
+     **********************************************************************/
+    RadialEngine Radial(real tau, real x, real y, real z, bool gradp) const {
+      real f[] = {1, tau};
+      switch (_norm) {
+      case FULL:
+        return gradp ?
+          SphericalEngine::Radial<true, SphericalEngine::FULL, 2>
+          (_c, f, x, y, z, _a) :
+          SphericalEngine::Radial<false, SphericalEngine::FULL, 2>
+          (_c, f, x, y, z, _a);
+        break;
+      case SCHMIDT:
+      default:                  // To avoid compiler warnings
+        return gradp ?
+          SphericalEngine::Radial<true, SphericalEngine::SCHMIDT, 2>
+          (_c, f, x, y, z, _a) :
+          SphericalEngine::Radial<false, SphericalEngine::SCHMIDT, 2>
+          (_c, f, x, y, z, _a);
         break;
       }
     }
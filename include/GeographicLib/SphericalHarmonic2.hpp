@@ -14,6 +14,7 @@
 #include <GeographicLib/Constants.hpp>
 #include <GeographicLib/SphericalEngine.hpp>
 #include <GeographicLib/CircularEngine.hpp>
+#include <GeographicLib/RadialEngine.hpp>
 
 namespace GeographicLib {
 
@@ -261,6 +262,8 @@ namespace GeographicLib {
      * @param[in] z the height of the circle above the equatorial plane.
      * @param[in] gradp if true the returned object will be able to compute the
      *   gradient of the sum.
+     * @param[in] threads the number of threads to use in computing the inner
+     *   sums (default 1); see SphericalEngine::Circle.
      * @exception std::bad_alloc if the memory for the CircularEngine can't be
      *   allocated.
      * @return the CircularEngine object.
@@ -276,24 +279,114 @@ namespace GeographicLib {
      *
      * See SphericalHarmonic::Circle for an example of its use.
      **********************************************************************/
-    CircularEngine Circle(real tau1, real tau2, real p, real z, bool gradp)
-      const {
+    CircularEngine Circle(real tau1, real tau2, real p, real z, bool gradp,
+                          unsigned threads = 1) const {
       real f[] = {1, tau1, tau2};
       switch (_norm) {
       case FULL:
         return gradp ?
           SphericalEngine::Circle<true, SphericalEngine::FULL, 3>
-          (_c, f, p, z, _a) :
+          (_c, f, p, z, _a, threads) :
           SphericalEngine::Circle<false, SphericalEngine::FULL, 3>
-          (_c, f, p, z, _a);
+          (_c, f, p, z, _a, threads);
         break;
       case SCHMIDT:
       default:                  // To avoid compiler warnings
         return gradp ?
           SphericalEngine::Circle<true, SphericalEngine::SCHMIDT, 3>
-          (_c, f, p, z, _a) :
+          (_c, f, p, z, _a, threads) :
+          SphericalEngine::Circle<false, SphericalEngine::SCHMIDT, 3>
+          (_c, f, p, z, _a, threads);
+        break;
+      }
+    }
+
+    /**
+     * Reinitialize a CircularEngine in place.
+     *
+     * @param[in] tau1 multiplier for correction coefficients \e C' and \e S'.
+     * @param[in] tau2 multiplier for correction coefficients \e C'' and
+     *   \e S''.
+     * @param[in] p the radius of the circle.
+     * @param[in] z the height of the circle above the equatorial plane.
+     * @param[in] gradp if true the resulting object will be able to compute
+     *   the gradient of the sum.
+     * @param[in] threads the number of threads to use in computing the inner
+     *   sums; see SphericalEngine::Circle.
+     * @param[out] circ the CircularEngine object.
+     * @exception std::bad_alloc if the memory for the CircularEngine can't be
+     *   allocated.
+     *
+     * This gives the same result as \e circ = Circle(\e tau1, \e tau2,
+     * \e p, \e z, \e gradp, \e threads), but reuses the storage of
+     * \e circ; see SphericalHarmonic::Circle(real, real, bool, unsigned,
+     * CircularEngine&) const.
+     **********************************************************************/
+    void Circle(real tau1, real tau2, real p, real z, bool gradp,
+                unsigned threads, CircularEngine& circ) const {
+      real f[] = {1, tau1, tau2};
+      switch (_norm) {
+      case FULL:
+        if (gradp)
+          SphericalEngine::Circle<true, SphericalEngine::FULL, 3>
+            (_c, f, p, z, _a, threads, circ);
+        else
+          SphericalEngine::Circle<false, SphericalEngine::FULL, 3>
+            (_c, f, p, z, _a, threads, circ);
+        break;
+      case SCHMIDT:
+      default:                  // To avoid compiler warnings
+        if (gradp)
+          SphericalEngine::Circle<true, SphericalEngine::SCHMIDT, 3>
+            (_c, f, p, z, _a, threads, circ);
+        else
           SphericalEngine::Circle<false, SphericalEngine::SCHMIDT, 3>
-          (_c, f, p, z, _a);
+            (_c, f, p, z, _a, threads, circ);
+        break;
+      }
+    }
+
+    /**
+     * Create a RadialEngine to allow the efficient evaluation of several
+     * points on a radial line.
+     *
+     * @param[in] tau1 multiplier for correction coefficients \e C' and \e S'.
+     * @param[in] tau2 multiplier for correction coefficients \e C'' and \e
+     *   S''.
+     * @param[in] x cartesian coordinate of a point on the line.
+     * @param[in] y cartesian coordinate of a point on the line.
+     * @param[in] z cartesian coordinate of a point on the line.
+     * @param[in] gradp if true the returned object will be able to compute the
+     *   gradient of the sum.
+     * @exception std::bad_alloc if the memory for the RadialEngine can't be
+     *   allocated.
+     * @return the RadialEngine object.
+     *
+     * This performs the sums over order \e m, which are independent of the
+     * radius (about <i>N</i><sup>2</sup> operations).  Calling
+     * RadialEngine::operator()() on the returned object with a radius \e r
+     * performs the sum over degree \e n (about \e N operations) and gives
+     * the same result as SphericalHarmonic2::operator()() at the point on
+     * the ray from the origin through (\e x, \e y, \e z) at radius \e r.
+     **********************************************************************/
+    RadialEngine Radial(real tau1, real tau2, real x, real y, real z,
+                        bool gradp) const {
+      real f[] = {1, tau1, tau2};
+      switch (_norm) {
+      case FULL:
+        return gradp ?
+          SphericalEngine::Radial<true, SphericalEngine::FULL, 3>
+          (_c, f, x, y, z, _a) :
+          SphericalEngine::Radial<false, SphericalEngine::FULL, 3>
+          (_c, f, x, y, z, _a);
+        break;
+      case SCHMIDT:
+      default:                  // To avoid compiler warnings
+        return gradp ?
+          SphericalEngine::Radial<true, SphericalEngine::SCHMIDT, 3>
+          (_c, f, x, y, z, _a) :
+          SphericalEngine::Radial<false, SphericalEngine::SCHMIDT, 3>
+          (_c, f, x, y, z, _a);
         break;
       }
     }
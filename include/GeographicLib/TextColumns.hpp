@@ -0,0 +1,117 @@
+/**
+ * \file TextColumns.hpp
+ * \brief Header for GeographicLib::TextColumns class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_TEXTCOLUMNS_HPP)
+#define GEOGRAPHICLIB_TEXTCOLUMNS_HPP 1
+
+#include <string>
+#include <GeographicLib/Constants.hpp>
+
+namespace GeographicLib {
+
+  /**
+   * \brief Split lines of text into fields and decode columns of numbers
+   *
+   * This is used to read delimited text files of coordinates (e.g., the
+   * input to the utility programs or CSV files) a block of lines at a
+   * time.  Split divides a line into fields, without copying, scanning 16
+   * characters at a time for delimiters with SSE2 instructions where these
+   * are available.  DecodeNumbers and DecodeLatLon then convert a column of
+   * fields.  Fields which are plain decimal numbers (the vast majority in
+   * practice) are converted with Utility::fastval; the rest, e.g., those
+   * with hemisphere designators or in degrees, minutes, and seconds, are
+   * passed to Utility::val or DMS::DecodeLatLon.  The results, including
+   * the error messages, are the same as calling these routines on each
+   * field.
+   *
+   * Example of use:
+   * \code
+   * const char* field[3]; size_t len[3];
+   * size_t n = TextColumns::Split(line, linelen, 3, field, len);
+   * \endcode
+   **********************************************************************/
+
+  class GEOGRAPHICLIB_EXPORT TextColumns {
+  private:
+    typedef Math::real real;
+    TextColumns() = delete;     // Disable constructor
+  public:
+
+    /**
+     * Split a line into fields.
+     *
+     * @param[in] line the characters of the line.
+     * @param[in] len the number of characters in the line.
+     * @param[in] maxfields the maximum number of fields to return.
+     * @param[out] field the starts of the fields.
+     * @param[out] flen the lengths of the fields.
+     * @param[in] commas if true (the default), commas are delimiters too.
+     * @return the number of fields found (at most \e maxfields).
+     *
+     * Fields are separated by runs of white space (as given by isspace in
+     * the C locale) and, if \e commas is true, commas; leading and trailing
+     * delimiters are ignored.  Thus with \e commas = false, the fields are
+     * the same as those extracted with operator>> from a std::istream.  The
+     * arrays \e field and \e flen must have room for \e maxfields elements.
+     * The line needn't be null-terminated.  To check whether a line has
+     * more than \e n fields, set \e maxfields = \e n + 1.
+     **********************************************************************/
+    static size_t Split(const char* line, size_t len, size_t maxfields,
+                        const char* field[], size_t flen[],
+                        bool commas = true);
+
+    /**
+     * Decode a column of numbers.
+     *
+     * @param[in] n the number of fields.
+     * @param[in] field the starts of the fields.
+     * @param[in] flen the lengths of the fields.
+     * @param[out] val the values.
+     * @param[out] err error messages.
+     * @return the number of fields which couldn't be decoded.
+     *
+     * Field \e i is decoded as by Utility::val<real>.  If this fails, \e
+     * err[i] is set to the message of the exception and \e val[i] is left
+     * unchanged.  Fields with \e field[i] = nullptr are skipped.
+     **********************************************************************/
+    static size_t DecodeNumbers(size_t n,
+                                const char* const field[],
+                                const size_t flen[],
+                                real val[], std::string err[]);
+
+    /**
+     * Decode a column of latitudes and longitudes.
+     *
+     * @param[in] n the number of points.
+     * @param[in] a the starts of the first fields.
+     * @param[in] alen the lengths of the first fields.
+     * @param[in] b the starts of the second fields.
+     * @param[in] blen the lengths of the second fields.
+     * @param[in] longfirst if true, assume longitude is given before
+     *   latitude in the absence of hemisphere designators.
+     * @param[out] lat the latitudes (degrees).
+     * @param[out] lon the longitudes (degrees).
+     * @param[out] err error messages.
+     * @return the number of points which couldn't be decoded.
+     *
+     * Point \e i is decoded as by DMS::DecodeLatLon.  If this fails, \e
+     * err[i] is set to the message of the exception and \e lat[i] and \e
+     * lon[i] are left unchanged.  Points for which either \e a[i] or \e b[i]
+     * is nullptr are skipped.
+     **********************************************************************/
+    static size_t DecodeLatLon(size_t n,
+                               const char* const a[], const size_t alen[],
+                               const char* const b[], const size_t blen[],
+                               bool longfirst,
+                               real lat[], real lon[], std::string err[]);
+  };
+
+} // namespace GeographicLib
+
+#endif  // GEOGRAPHICLIB_TEXTCOLUMNS_HPP
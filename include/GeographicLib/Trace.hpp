@@ -0,0 +1,162 @@
+/**
+ * \file Trace.hpp
+ * \brief Static tracepoints for profiling the library
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEOGRAPHICLIB_TRACE_HPP)
+#define GEOGRAPHICLIB_TRACE_HPP 1
+
+#include <GeographicLib/Constants.hpp>
+
+#if !defined(GEOGRAPHICLIB_TRACEPOINTS)
+/**
+ * Does the library contain static tracepoints?  This is set by cmake
+ * (option GEOGRAPHICLIB_TRACEPOINTS).
+ **********************************************************************/
+#  define GEOGRAPHICLIB_TRACEPOINTS 0
+#endif
+
+/**
+ * \page tracepoints Static tracepoints
+ *
+ * If the library is built with GEOGRAPHICLIB_TRACEPOINTS set, it contains
+ * static tracepoints in the provider "geographiclib" which can be attached
+ * to without rebuilding the library or the program.  On Linux, these are
+ * USDT probes (from &lt;sys/sdt.h&gt;) which can be used by bpftrace, bcc,
+ * perf, and SystemTap, e.g.,
+ * \verbatim
+   bpftrace -e 'usdt:/usr/lib/libGeographicLib.so:geographiclib:batch__entry
+     { @start[tid] = nsecs; }
+     usdt:/usr/lib/libGeographicLib.so:geographiclib:batch__return
+     { @ns[str(arg0)] = hist(nsecs - @start[tid]); }'
+   \endverbatim
+ * On Windows, they are TraceLogging events of the provider "GeographicLib"
+ * (GUID {6f0c2a64-3d0e-5a4b-9a0e-8b0c3f5c1e27}) which can be recorded with
+ * wpr or xperf.  If GEOGRAPHICLIB_TRACEPOINTS isn't set (the default), the
+ * tracepoints are compiled out and their arguments aren't evaluated.
+ *
+ * The probes come in pairs, <i>name</i>__entry and <i>name</i>__return,
+ * both with the same arguments:
+ * - geoid__load (const char* name): the Geoid constructor;
+ * - geoid__cache (double south, double west, double north, double east):
+ *   Geoid::CacheArea;
+ * - gravity__load (const char* name): the GravityModel constructor;
+ * - gravity__circle (double lat, double h): GravityModel::Circle;
+ * - magnetic__load (const char* name): the MagneticModel constructor;
+ * - nn__initialize (size_t npoints): NearestNeighbor::Initialize;
+ * - nn__search (size_t nquery): NearestNeighbor::Search (\e nquery = 1)
+ *   and NearestNeighbor::SearchBatch;
+ * - batch (const char* function, size_t n): the batch routines, e.g.,
+ *   Geodesic::InverseBatch; \e function is the name of the routine.
+ * .
+ * (The names of the USDT probes appear with "__" replaced by "-" in some
+ * tools.)  The NearestNeighbor probes are in the header, so they are only
+ * available via USDT in programs compiled with &lt;sys/sdt.h&gt;.
+ **********************************************************************/
+
+#if GEOGRAPHICLIB_TRACEPOINTS && !defined(_WIN32)
+
+#  include <sys/sdt.h>
+#  define GEOGRAPHICLIB_TRACE1(probe, a) \
+  DTRACE_PROBE1(geographiclib, probe, a)
+#  define GEOGRAPHICLIB_TRACE2(probe, a, b) \
+  DTRACE_PROBE2(geographiclib, probe, a, b)
+#  define GEOGRAPHICLIB_TRACE4(probe, a, b, c, d) \
+  DTRACE_PROBE4(geographiclib, probe, a, b, c, d)
+
+#elif GEOGRAPHICLIB_TRACEPOINTS && defined(GEOGRAPHICLIB_TRACE_ETW)
+
+// TraceLogging is only used within the library (src/Trace.cpp defines
+// GEOGRAPHICLIB_TRACE_ETW and the provider).
+#  include <windows.h>
+#  include <TraceLoggingProvider.h>
+TRACELOGGING_DECLARE_PROVIDER(GeographicLibTraceProvider);
+#  define GEOGRAPHICLIB_TRACE1(probe, a)                        \
+  TraceLoggingWrite(GeographicLibTraceProvider, #probe,         \
+                    TraceLoggingValue(a, "arg0"))
+#  define GEOGRAPHICLIB_TRACE2(probe, a, b)                     \
+  TraceLoggingWrite(GeographicLibTraceProvider, #probe,         \
+                    TraceLoggingValue(a, "arg0"),               \
+                    TraceLoggingValue(b, "arg1"))
+#  define GEOGRAPHICLIB_TRACE4(probe, a, b, c, d)               \
+  TraceLoggingWrite(GeographicLibTraceProvider, #probe,         \
+                    TraceLoggingValue(a, "arg0"),               \
+                    TraceLoggingValue(b, "arg1"),               \
+                    TraceLoggingValue(c, "arg2"),               \
+                    TraceLoggingValue(d, "arg3"))
+
+#endif
+
+#if defined(GEOGRAPHICLIB_TRACE1)
+
+namespace GeographicLib {
+
+  /**
+   * \brief Fire the return probe of a tracepoint when leaving a scope
+   *
+   * This is an implementation detail of the GEOGRAPHICLIB_TRACE_SCOPE
+   * macros; the return probe fires even if the scope is left via an
+   * exception.
+   **********************************************************************/
+  template<class F> class TraceScope {
+  private:
+    F _exit;
+    bool _active;
+    TraceScope& operator=(const TraceScope&) = delete;
+  public:
+    explicit TraceScope(F exit) : _exit(exit), _active(true) {}
+    TraceScope(TraceScope&& t) : _exit(t._exit), _active(t._active)
+    { t._active = false; }
+    ~TraceScope() { if (_active) _exit(); }
+  };
+
+  template<class F> inline TraceScope<F> MakeTraceScope(F exit)
+  { return TraceScope<F>(exit); }
+
+} // namespace GeographicLib
+
+// The arguments are evaluated once (on entry) and the return probe is
+// given the same values.
+#  define GEOGRAPHICLIB_TRACE_SCOPE1(probe, a)                          \
+  const auto geographiclib_trace_a_ = (a);                              \
+  GEOGRAPHICLIB_TRACE1(probe##__entry, geographiclib_trace_a_);         \
+  auto&& geographiclib_trace_scope_ = GeographicLib::MakeTraceScope     \
+    ([=]() { GEOGRAPHICLIB_TRACE1(probe##__return,                      \
+                                  geographiclib_trace_a_); })
+#  define GEOGRAPHICLIB_TRACE_SCOPE2(probe, a, b)                       \
+  const auto geographiclib_trace_a_ = (a);                              \
+  const auto geographiclib_trace_b_ = (b);                              \
+  GEOGRAPHICLIB_TRACE2(probe##__entry,                                  \
+                       geographiclib_trace_a_, geographiclib_trace_b_); \
+  auto&& geographiclib_trace_scope_ = GeographicLib::MakeTraceScope     \
+    ([=]() { GEOGRAPHICLIB_TRACE2(probe##__return,                      \
+                                  geographiclib_trace_a_,               \
+                                  geographiclib_trace_b_); })
+#  define GEOGRAPHICLIB_TRACE_SCOPE4(probe, a, b, c, d)                 \
+  const auto geographiclib_trace_a_ = (a);                              \
+  const auto geographiclib_trace_b_ = (b);                              \
+  const auto geographiclib_trace_c_ = (c);                              \
+  const auto geographiclib_trace_d_ = (d);                              \
+  GEOGRAPHICLIB_TRACE4(probe##__entry,                                  \
+                       geographiclib_trace_a_, geographiclib_trace_b_,  \
+                       geographiclib_trace_c_, geographiclib_trace_d_); \
+  auto&& geographiclib_trace_scope_ = GeographicLib::MakeTraceScope     \
+    ([=]() { GEOGRAPHICLIB_TRACE4(probe##__return,                      \
+                                  geographiclib_trace_a_,               \
+                                  geographiclib_trace_b_,               \
+                                  geographiclib_trace_c_,               \
+                                  geographiclib_trace_d_); })
+
+#else
+
+#  define GEOGRAPHICLIB_TRACE_SCOPE1(probe, a) ((void)0)
+#  define GEOGRAPHICLIB_TRACE_SCOPE2(probe, a, b) ((void)0)
+#  define GEOGRAPHICLIB_TRACE_SCOPE4(probe, a, b, c, d) ((void)0)
+
+#endif
+
+#endif  // GEOGRAPHICLIB_TRACE_HPP
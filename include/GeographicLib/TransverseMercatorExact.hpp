@@ -10,6 +10,7 @@
 #if !defined(GEOGRAPHICLIB_TRANSVERSEMERCATOREXACT_HPP)
 #define GEOGRAPHICLIB_TRANSVERSEMERCATOREXACT_HPP 1
 
+#include <vector>
 #include <GeographicLib/Constants.hpp>
 #include <GeographicLib/EllipticFunction.hpp>
 
@@ -89,6 +90,23 @@ namespace GeographicLib {
     bool _extendp;
     EllipticFunction _Eu, _Ev;
 
+    // A table of starting guesses (u, v) for zetainv or sigmainv on the grid
+    // x = x0 + h * (i-1), y = y0 + h * (j-1) for 0 <= i <= nx + 2 and 0 <= j
+    // <= ny + 2; see CacheArea.
+    class guesstab {
+    public:
+      real x0, y0, h;
+      int nx, ny;               // The number of cells
+      std::vector<real> u, v;   // The values at the nodes
+      std::vector<char> ok;     // Can the guess be used in a cell?
+      guesstab() : x0(0), y0(0), h(0), nx(0), ny(0) {}
+      // Interpolate (u, v) at (x, y); returns false if this isn't possible
+      bool Guess(real x, real y, real& ux, real& vx) const;
+    };
+    guesstab _ztab, _stab;
+    // Fill in the table for zetainv (zetap = true) or sigmainv
+    void Tabulate(bool zetap, guesstab& t) const;
+
     void zeta(real u, real snu, real cnu, real dnu,
               real v, real snv, real cnv, real dnv,
               real& taup, real& lam) const;
@@ -223,6 +241,76 @@ namespace GeographicLib {
       Reverse(lon0, x, y, lat, lon, gamma, k);
     }
 
+    /** \name Caching the starting guesses
+     **********************************************************************/
+    ///@{
+    /**
+     * Tabulate the starting guesses for a region.
+     *
+     * @param[in] south latitude (degrees) of the south edge of the region.
+     * @param[in] west longitude (degrees) relative to the central meridian of
+     *   the west edge of the region.
+     * @param[in] north latitude (degrees) of the north edge of the region.
+     * @param[in] east longitude (degrees) relative to the central meridian of
+     *   the east edge of the region.
+     * @param[in] step the grid spacing (degrees); default 0.5&deg;.
+     * @exception GeographicErr if the region is empty, if \e south or \e
+     *   north is not in [&minus;90&deg;, 90&deg;], or if \e step is not
+     *   positive.
+     * @exception std::bad_alloc if the memory necessary for the tables can't
+     *   be allocated.
+     *
+     * Most of the time for Forward and Reverse is spent in the Newton
+     * iterations which invert the mappings to the Thompson transverse
+     * Mercator coordinates; the starting guesses used for these are only
+     * good near the central meridian.  This routine computes the exact
+     * inverse mappings on a grid covering the region and its image in the
+     * projected coordinates.  Starting guesses are then found by cubic
+     * interpolation into these tables.  This typically reduces the number of
+     * Newton iterations to 2 and the time for Forward and Reverse by 25% to
+     * 50%.
+     *
+     * The Newton iterations are still carried out to convergence, so the
+     * errors are bounded as for the uncached projection (5 nm); however the
+     * results may differ from the uncached results because of roundoff.  The
+     * interpolation error is checked at the center of each grid cell; any
+     * cell where this exceeds 10<sup>&minus;3</sup> (in units of the
+     * equatorial radius), e.g., near the branch point, is excluded from the
+     * table.  Points outside the tables use the normal starting guesses.
+     *
+     * The region is subject to the symmetries of the projection, so for the
+     * standard projection (\e extendp = false) the region with \e lat and \e
+     * lon &minus; \e lon0 replaced by their absolute values is tabulated.
+     * Longitudes are limited to [&minus;90&deg;, 90&deg;] and latitudes to
+     * [&minus;89.5&deg;, 89.5&deg;] (beyond which the table would need to be
+     * very large).
+     *
+     * With the default grid spacing, the tables require a few hundred bytes
+     * per square degree of the region and the time to build them is about
+     * the time for four Forward or Reverse calls per grid cell.
+     *
+     * This changes the TransverseMercatorExact object and so should not be
+     * called while other threads are using it.  TransverseMercatorExact::UTM()
+     * is a constant object; to cache the starting guesses for UTM, construct
+     * a copy with
+     * \code
+     *   TransverseMercatorExact tm(TransverseMercatorExact::UTM());
+     * \endcode
+     **********************************************************************/
+    void CacheArea(real south, real west, real north, real east,
+                   real step = real(0.5));
+
+    /**
+     * Clear the tables of starting guesses.
+     **********************************************************************/
+    void CacheClear();
+
+    /**
+     * @return true if there are tables of starting guesses.
+     **********************************************************************/
+    bool Cache() const { return _ztab.nx > 0; }
+    ///@}
+
     /** \name Inspector functions
      **********************************************************************/
     ///@{
@@ -93,6 +93,42 @@ namespace GeographicLib {
     // throwp = false, return bool instead.
     static bool CheckCoords(bool utmp, bool northp, real x, real y,
                             bool msgrlimits = false, bool throwp = true);
+    // The status codes returned by ForwardZone (0 = OK for success)
+    enum fwdstatus { FAR_FROM_ZONE = 1, FAR_FROM_POLE, OUT_OF_RANGE };
+    friend class GeoCoords;     // GeoCoords calls CheckCoords
+    // Project (lat, lon) into the given physical zone and hemisphere and add
+    // the false origins; return a fwdstatus instead of throwing an error.
+    static int ForwardZone(real lat, real lon, int zone, bool northp,
+                           real& x, real& y, real& gamma, real& k,
+                           bool mgrslimits);
+
+  public:
+    /**
+     * The status returned by the decoding of a zone string from a character
+     * buffer which does not throw an exception.
+     **********************************************************************/
+    enum status {
+      /**
+       * The decoding succeeded.
+       * @hideinitializer
+       **********************************************************************/
+      OK = 0,
+      /**
+       * The zone number is illegal.
+       * @hideinitializer
+       **********************************************************************/
+      BADZONE = 1,
+      /**
+       * The zone string is otherwise malformed.
+       * @hideinitializer
+       **********************************************************************/
+      BADSTRING = 2,
+    };
+
+  private:
+    // If throwp = false, return a status instead of throwing an exception.
+    static status DecodeZoneChars(const char* zonestr, size_t zlen,
+                                  int& zone, bool& northp, bool throwp);
     UTMUPS();                   // Disable constructor
 
   public:
@@ -263,6 +299,65 @@ namespace GeographicLib {
                         real& lat, real& lon, real& gamma, real& k,
                         bool mgrslimits = false);
 
+    /**
+     * Forward projection of arrays of points, from geographic to UTM/UPS.
+     *
+     * @param[in] n the number of points.
+     * @param[in] lat array of latitudes (degrees).
+     * @param[in] lon array of longitudes (degrees).
+     * @param[out] zone array of UTM zones (zero means UPS).
+     * @param[out] northp array of hemispheres (true means north, false means
+     *   south).
+     * @param[out] x array of eastings (meters).
+     * @param[out] y array of northings (meters).
+     * @param[out] gamma array of meridian convergences (degrees); this may be
+     *   null.
+     * @param[out] k array of scales of the projection; this may be null.
+     * @param[in] setzone zone override (optional).
+     * @param[in] mgrslimits if true enforce the stricter MGRS limits on the
+     *   coordinates (default = false).
+     * @exception GeographicErr if \e setzone is illegal.
+     *
+     * This is equivalent to calling UTMUPS::Forward for each point, except
+     * that errors do not throw an exception.  Instead, for a point which
+     * UTMUPS::Forward would reject, \e zone is set to UTMUPS::INVALID and \e
+     * x, \e y, \e gamma, and \e k are set to NaN, as for a point with a NaN
+     * coordinate.  Thus a few bad points don't abort the conversion of a
+     * large data set.
+     **********************************************************************/
+    static void ForwardBatch(size_t n, const real lat[], const real lon[],
+                             int zone[], bool northp[], real x[], real y[],
+                             real gamma[] = nullptr, real k[] = nullptr,
+                             int setzone = STANDARD, bool mgrslimits = false);
+
+    /**
+     * Reverse projection of arrays of points, from UTM/UPS to geographic.
+     *
+     * @param[in] n the number of points.
+     * @param[in] zone array of UTM zones (zero means UPS).
+     * @param[in] northp array of hemispheres (true means north, false means
+     *   south).
+     * @param[in] x array of eastings (meters).
+     * @param[in] y array of northings (meters).
+     * @param[out] lat array of latitudes (degrees).
+     * @param[out] lon array of longitudes (degrees).
+     * @param[out] gamma array of meridian convergences (degrees); this may be
+     *   null.
+     * @param[out] k array of scales of the projection; this may be null.
+     * @param[in] mgrslimits if true enforce the stricter MGRS limits on the
+     *   coordinates (default = false).
+     *
+     * This is equivalent to calling UTMUPS::Reverse for each point, except
+     * that a point which UTMUPS::Reverse would reject (because \e zone, \e
+     * x, or \e y is out of range) gives NaNs for \e lat, \e lon, \e gamma,
+     * and \e k instead of throwing an exception.
+     **********************************************************************/
+    static void ReverseBatch(size_t n, const int zone[], const bool northp[],
+                             const real x[], const real y[],
+                             real lat[], real lon[],
+                             real gamma[] = nullptr, real k[] = nullptr,
+                             bool mgrslimits = false);
+
     /**
      * UTMUPS::Forward without returning convergence and scale.
      **********************************************************************/
@@ -319,6 +414,43 @@ namespace GeographicLib {
                          int zoneout, bool northpout, real& xout, real& yout,
                          int& zone);
 
+    /**
+     * Transfer arrays of UTM/UPS coordinates from one zone to another.
+     *
+     * @param[in] n the number of points.
+     * @param[in] zonein array of UTM zones for \e xin and \e yin (zero
+     *   means UPS).
+     * @param[in] northpin array of hemispheres for \e xin and \e yin.
+     * @param[in] xin array of eastings (meters) in \e zonein.
+     * @param[in] yin array of northings (meters) in \e zonein.
+     * @param[in] zoneout the requested UTM zone for \e xout and \e yout (or
+     *   zero for UPS).
+     * @param[in] northpout hemisphere for \e xout and \e yout.
+     * @param[out] xout array of eastings (meters) in \e zone.
+     * @param[out] yout array of northings (meters) in \e zone.
+     * @param[out] zone array of the actual UTM zones for \e xout and \e yout
+     *   (or zero for UPS).
+     * @exception GeographicErr if \e zoneout is out of range.
+     *
+     * This is equivalent to calling UTMUPS::Transfer for each point, except
+     * that a point which UTMUPS::Transfer would reject gives NaNs for \e xout
+     * and \e yout and UTMUPS::INVALID for \e zone instead of throwing an
+     * exception.  Points which stay in the same zone are copied (with the
+     * northing shifted if the hemisphere changes); this includes all the
+     * valid points if \e zoneout = UTMUPS::MATCH.  The rest go through the
+     * TransverseMercator and PolarStereographic batch projections.  The
+     * longitudes relative to the central meridians of the UTM zones are
+     * passed directly from the reverse to the forward projection; this avoids
+     * reducing the longitudes to [&minus;180&deg;, 180&deg;] and back.
+     *
+     * The output arrays may coincide with the input arrays.
+     **********************************************************************/
+    static void TransferBatch(size_t n, const int zonein[],
+                              const bool northpin[],
+                              const real xin[], const real yin[],
+                              int zoneout, bool northpout,
+                              real xout[], real yout[], int zone[]);
+
     /**
      * Decode a UTM/UPS zone string.
      *
@@ -340,6 +472,24 @@ namespace GeographicLib {
     static void DecodeZone(const std::string& zonestr,
                            int& zone, bool& northp);
 
+    /**
+     * Decode a UTM/UPS zone string in a character buffer without throwing an
+     * exception.
+     *
+     * @param[in] zonestr representation of zone and hemisphere (need not be
+     *   null-terminated).
+     * @param[in] len the number of characters in \e zonestr.
+     * @param[out] zone the UTM zone (zero means UPS).
+     * @param[out] northp hemisphere (true means north, false means south).
+     * @return the status of the decoding; if this is not OK, \e zone and \e
+     *   northp are unchanged.
+     *
+     * The rules for \e zonestr are the same as for the std::string version of
+     * DecodeZone.
+     **********************************************************************/
+    static status DecodeZone(const char* zonestr, size_t len,
+                             int& zone, bool& northp);
+
     /**
      * Encode a UTM/UPS zone string.
      *
@@ -17,6 +17,8 @@
 #include <cctype>
 #include <ctime>
 #include <cstring>
+#include <cstdint>
+#include <type_traits>
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions and unsafe gmtime
@@ -46,6 +48,44 @@ namespace GeographicLib {
     static bool gregorian(int s) {
       return s >= 639799;       // 1752-09-14
     }
+    // Convert x to fixed format with precision p >= 0 using snprintf;
+    // return the length of the result or -1 if this can't be done.
+    static int fixedstr(char buf[], size_t n, Math::real x, int p);
+    // Reverse the bytes of an unsigned integer.  Compilers recognize these
+    // as byte swaps and, in the loops in swaparray, vectorize them.
+    static std::uint16_t bswap(std::uint16_t u)
+    { return std::uint16_t(u >> 8 | u << 8); }
+    static std::uint32_t bswap(std::uint32_t u) {
+      return (u >> 24) | ((u >> 8) & 0xff00u) |
+        ((u << 8) & 0xff0000u) | (u << 24);
+    }
+    static std::uint64_t bswap(std::uint64_t u) {
+      return (std::uint64_t(bswap(std::uint32_t(u))) << 32) |
+        bswap(std::uint32_t(u >> 32));
+    }
+    template<typename U> static void bswaparray(char* p, size_t num) {
+      for (size_t i = 0; i < num; ++i, p += sizeof(U)) {
+        U u;
+        std::memcpy(&u, p, sizeof(U));
+        u = bswap(u);
+        std::memcpy(p, &u, sizeof(U));
+      }
+    }
+    // Swap the bytes of each element of x[0, num); this is the bulk version
+    // of Math::swab.
+    template<typename T> static void swaparray(T x[], size_t num) {
+      char* p = reinterpret_cast<char*>(x);
+      switch (sizeof(T)) {
+      case 1: break;
+      case 2: bswaparray<std::uint16_t>(p, num); break;
+      case 4: bswaparray<std::uint32_t>(p, num); break;
+      case 8: bswaparray<std::uint64_t>(p, num); break;
+      default:
+        for (size_t i = 0; i < num; ++i) x[i] = Math::swab<T>(x[i]);
+      }
+    }
+    // The size in bytes of the buffers used by readarray and writearray.
+    static const size_t bufbytes_ = 16384;
   public:
 
     /**
@@ -296,6 +336,12 @@ namespace GeographicLib {
       if (!isfinite(x))
         return x < 0 ? std::string("-inf") :
           (x > 0 ? std::string("inf") : std::string("nan"));
+      if (p >= 0) {
+        char buf[64];           // Big enough for most numbers
+        int len = fixedstr(buf, sizeof(buf), x, p);
+        if (len >= 0 && size_t(len) < sizeof(buf))
+          return std::string(buf, len);
+      }
       std::ostringstream s;
 #if GEOGRAPHICLIB_PRECISION == 4
       // boost-quadmath treats precision == 0 as "use as many digits as
@@ -316,6 +362,25 @@ namespace GeographicLib {
       s << x; return s.str();
     }
 
+    /**
+     * Convert a Math::real object to a string in a caller-supplied buffer.
+     *
+     * @param[out] buf the buffer for the result.
+     * @param[in] n the size of \e buf.
+     * @param[in] x the value to be converted.
+     * @param[in] p the precision used (default &minus;1).
+     * @return the length of the string representation of \e x (not counting
+     *   the terminating null).
+     *
+     * This gives the same result as str(Math::real, int).  The result is
+     * null terminated and, if the returned length is \e n or more, it has
+     * been truncated to fit into \e buf.  With \e p &ge; 0, the conversion
+     * is done with snprintf, which avoids memory allocation, unless the
+     * current locale isn't the classic "C" locale (or Math::real is a
+     * high-precision type) in which case an ostringstream is used.
+     **********************************************************************/
+    static size_t str(char buf[], size_t n, Math::real x, int p = -1);
+
     /**
      * Trim the white space from the beginning and end of a string.
      *
@@ -361,6 +426,8 @@ namespace GeographicLib {
       // If T is bool, then the specialization val<bool>() defined below is
       // used.
       T x;
+      // Plain decimal numbers are converted without using a string stream.
+      if (fastval(s, x)) return x;
       std::string errmsg, t(trim(s));
       do {                     // Executed once (provides the ability to break)
         std::istringstream is(t);
@@ -380,6 +447,106 @@ namespace GeographicLib {
         throw GeographicErr(errmsg);
       return x;
     }
+    /**
+     * Convert a plain decimal number in a string to a floating point type
+     * quickly.
+     *
+     * @tparam T the type of the result.
+     * @param[in] s the string to be converted.
+     * @param[out] x the value of \e s, if successful.
+     * @return true if \e s was converted.
+     *
+     * \e s must consist of an optional sign, a mantissa with at least one
+     * digit and an optional decimal point, and an optional exponent, "e" or
+     * "E" followed by an optionally signed integer.  White space at the
+     * beginning and end of \e s is ignored.  The conversion, with strtod (or
+     * its variants), is the same as that performed by a string stream but
+     * avoids any memory allocation.  If \e s is not of this form (or the
+     * result overflows or underflows, or the C locale doesn't use "." as the
+     * decimal point), false is returned and \e x is unchanged; the caller
+     * should then fall back to the general methods.  This version, which is
+     * used for types other than float, double, and long double, always
+     * returns false.
+     **********************************************************************/
+    template<typename T> static bool fastval(const std::string& s, T& x) {
+      (void)s; (void)x;
+      return false;
+    }
+    /**
+     * Convert a plain decimal number in a string to a float quickly.
+     *
+     * @param[in] s the string to be converted.
+     * @param[out] x the value of \e s, if successful.
+     * @return true if \e s was converted.
+     **********************************************************************/
+    static bool fastval(const std::string& s, float& x);
+    /**
+     * Convert a plain decimal number in a string to a double quickly.
+     *
+     * @param[in] s the string to be converted.
+     * @param[out] x the value of \e s, if successful.
+     * @return true if \e s was converted.
+     **********************************************************************/
+    static bool fastval(const std::string& s, double& x);
+    /**
+     * Convert a plain decimal number in a string to a long double quickly.
+     *
+     * @param[in] s the string to be converted.
+     * @param[out] x the value of \e s, if successful.
+     * @return true if \e s was converted.
+     **********************************************************************/
+    static bool fastval(const std::string& s, long double& x);
+    /**
+     * Convert a plain decimal number in a character array to a floating
+     * point type quickly.
+     *
+     * @tparam T the type of the result.
+     * @param[in] s the characters to be converted.
+     * @param[in] n the number of characters.
+     * @param[out] x the value of \e s, if successful.
+     * @return true if \e s was converted.
+     *
+     * This is the same as fastval(const std::string&, T&) except that the
+     * characters needn't be null-terminated.  This version, which is used
+     * for types other than float, double, and long double, always returns
+     * false.
+     **********************************************************************/
+    template<typename T>
+    static bool fastval(const char* s, size_t n, T& x) {
+      (void)s; (void)n; (void)x;
+      return false;
+    }
+    /**
+     * Convert a plain decimal number in a character array to a float
+     * quickly.
+     *
+     * @param[in] s the characters to be converted.
+     * @param[in] n the number of characters.
+     * @param[out] x the value of \e s, if successful.
+     * @return true if \e s was converted.
+     **********************************************************************/
+    static bool fastval(const char* s, size_t n, float& x);
+    /**
+     * Convert a plain decimal number in a character array to a double
+     * quickly.
+     *
+     * @param[in] s the characters to be converted.
+     * @param[in] n the number of characters.
+     * @param[out] x the value of \e s, if successful.
+     * @return true if \e s was converted.
+     **********************************************************************/
+    static bool fastval(const char* s, size_t n, double& x);
+    /**
+     * Convert a plain decimal number in a character array to a long double
+     * quickly.
+     *
+     * @param[in] s the characters to be converted.
+     * @param[in] n the number of characters.
+     * @param[out] x the value of \e s, if successful.
+     * @return true if \e s was converted.
+     **********************************************************************/
+    static bool fastval(const char* s, size_t n, long double& x);
+
     /**
      * \deprecated An old name for val<T>(s).
      **********************************************************************/
@@ -503,28 +670,42 @@ namespace GeographicLib {
           str.read(reinterpret_cast<char*>(array), num * sizeof(ExtT));
           if (!str.good())
             throw GeographicErr("Failure reading data");
-          if (bigendp != Math::bigendian) { // endian mismatch -> swap bytes
-            for (size_t i = num; i--;)
-              array[i] = Math::swab<IntT>(array[i]);
+          if (bigendp != Math::bigendian) // endian mismatch -> swap bytes
+            swaparray<IntT>(array, num);
+        }
+      else if (sizeof(IntT) > sizeof(ExtT) &&
+               std::is_trivially_copyable<IntT>::value)
+        {
+          // The data is wider in memory (e.g., float to double).  Read the
+          // data into the end of array and convert it in place working
+          // forwards; result i doesn't overlap the external values j > i.
+          char* p = reinterpret_cast<char*>(array);
+          size_t off = num * (sizeof(IntT) - sizeof(ExtT));
+          str.read(p + off, num * sizeof(ExtT));
+          if (!str.good())
+            throw GeographicErr("Failure reading data");
+          for (size_t i = 0; i < num; ++i) {
+            ExtT x;
+            std::memcpy(&x, p + off + i * sizeof(ExtT), sizeof(ExtT));
+            // fix endian-ness and cast to IntT
+            array[i] = IntT(bigendp == Math::bigendian ? x :
+                            Math::swab<ExtT>(x));
           }
         }
       else
 #endif
         {
-          const int bufsize = 1024; // read this many values at a time
-          ExtT buffer[bufsize];     // temporary buffer
-          int k = int(num);         // data values left to read
-          int i = 0;                // index into output array
-          while (k) {
-            int n = (std::min)(k, bufsize);
+          const size_t bufsize = bufbytes_ / sizeof(ExtT);
+          ExtT buffer[bufsize];     // read this many values at a time
+          for (size_t i = 0; i < num;) {
+            size_t n = (std::min)(num - i, bufsize);
             str.read(reinterpret_cast<char*>(buffer), n * sizeof(ExtT));
             if (!str.good())
               throw GeographicErr("Failure reading data");
-            for (int j = 0; j < n; ++j)
-              // fix endian-ness and cast to IntT
-              array[i++] = IntT(bigendp == Math::bigendian ? buffer[j] :
-                                Math::swab<ExtT>(buffer[j]));
-            k -= n;
+            if (bigendp != Math::bigendian) // fix endian-ness
+              swaparray<ExtT>(buffer, n);
+            for (size_t j = 0; j < n; ++j)
+              array[i++] = IntT(buffer[j]); // cast to IntT
           }
         }
       return;
@@ -578,20 +759,17 @@ namespace GeographicLib {
       else
 #endif
         {
-          const int bufsize = 1024; // write this many values at a time
-          ExtT buffer[bufsize];     // temporary buffer
-          int k = int(num);         // data values left to write
-          int i = 0;                // index into output array
-          while (k) {
-            int n = (std::min)(k, bufsize);
-            for (int j = 0; j < n; ++j)
-              // cast to ExtT and fix endian-ness
-              buffer[j] = bigendp == Math::bigendian ? ExtT(array[i++]) :
-                Math::swab<ExtT>(ExtT(array[i++]));
+          const size_t bufsize = bufbytes_ / sizeof(ExtT);
+          ExtT buffer[bufsize];     // write this many values at a time
+          for (size_t i = 0; i < num;) {
+            size_t n = (std::min)(num - i, bufsize);
+            for (size_t j = 0; j < n; ++j)
+              buffer[j] = ExtT(array[i++]); // cast to ExtT
+            if (bigendp != Math::bigendian) // fix endian-ness
+              swaparray<ExtT>(buffer, n);
             str.write(reinterpret_cast<const char*>(buffer), n * sizeof(ExtT));
             if (!str.good())
               throw GeographicErr("Failure writing data");
-            k -= n;
           }
         }
       return;
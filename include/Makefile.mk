@@ -2,41 +2,75 @@ MODULES = Accumulator \
 	AlbersEqualArea \
 	AzimuthalEquidistant \
 	CassiniSoldner \
+	ChordMetric \
 	CircularEngine \
+	ClosestApproach \
 	DMS \
+	Dispatch \
+	DistanceMatrix \
 	Ellipsoid \
+	EllipsoidCache \
 	EllipticFunction \
+	ExactAccumulator \
+	Executor \
 	GARS \
+	GeoArrow \
 	GeoCoords \
 	Geocentric \
 	Geodesic \
+	GeodesicCache \
+	GeodesicCluster \
 	GeodesicExact \
+	GeodesicIntersect \
 	GeodesicLine \
+	GeodesicLineCompact \
 	GeodesicLineExact \
+	GeodesicMetric \
+	GeodesicOrigin \
+	GeodesicPolyline \
+	GeodesicStats \
 	Geohash \
+	GeohashCover \
 	Geoid \
+	GeoidRaster \
 	Georef \
 	Gnomonic \
 	GravityCircle \
 	GravityModel \
+	GravityTrajectory \
+	JacobiConformal \
 	LambertConformalConic \
 	LocalCartesian \
 	MGRS \
+	MGRSGrid \
 	MagneticCircle \
 	MagneticModel \
+	MagneticSnapshot \
+	MappedInput \
 	Math \
+	MathInline \
 	NormalGravity \
 	OSGB \
+	Pipeline \
 	PolarStereographic \
 	PolygonArea \
+	PolygonAreaBatch \
+	PreparedPolygon \
+	ProjectionRegistry \
+	RadialEngine \
 	Rhumb \
+	SharedData \
 	SphericalEngine \
+	TextColumns \
+	Trace \
 	TransverseMercator \
 	TransverseMercatorExact \
 	UTMUPS \
 	Utility
-EXTRAHEADERS = Constants \
+EXTRAHEADERS = CircleCache \
+	Constants \
 	NearestNeighbor \
+	RasterWarp \
 	SphericalHarmonic \
 	SphericalHarmonic1 \
 	SphericalHarmonic2
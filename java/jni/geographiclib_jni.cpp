@@ -0,0 +1,169 @@
+/**
+ * \file geographiclib_jni.cpp
+ * \brief The optional native backend for the Java batch routines
+ *
+ * This implements the native methods of net.sf.geographiclib.NativeGeodesic
+ * with GeographicLib::Geodesic::InverseBatch,
+ * GeographicLib::Geodesic::DirectBatch, and
+ * GeographicLib::GeodesicLine::GenPositions.  The Java library uses these
+ * once NativeGeodesic.Load() has succeeded.
+ *
+ * Build the shared library with GEOGRAPHICLIB_PRECISION = 2 (the default) and
+ * link it with the C++ library, e.g., on Linux
+ * \verbatim
+   g++ -O3 -shared -fPIC -I$JAVA_HOME/include -I$JAVA_HOME/include/linux \
+     -I$PREFIX/include geographiclib_jni.cpp -L$PREFIX/lib -lGeographic \
+     -o libGeographicLib_jni.so
+   \endverbatim
+ * and put it in a directory in java.library.path.
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <jni.h>
+#include <exception>
+#include <initializer_list>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+
+#if GEOGRAPHICLIB_PRECISION != 2
+#error "The JNI library requires GEOGRAPHICLIB_PRECISION = 2"
+#endif
+
+namespace {
+
+  using namespace GeographicLib;
+
+  // The elements of a Java double[]; they are copied back (for an output) or
+  // discarded (for an input) by the destructor.  A null array gives a null
+  // pointer.
+  class Array {
+  private:
+    JNIEnv* _env;
+    jdoubleArray _arr;
+    jdouble* _data;
+    jint _mode;
+    Array(const Array&) = delete;
+    Array& operator=(const Array&) = delete;
+  public:
+    Array(JNIEnv* env, jdoubleArray arr, bool output)
+      : _env(env), _arr(arr), _data(nullptr), _mode(output ? 0 : JNI_ABORT)
+    { if (_arr) _data = _env->GetDoubleArrayElements(_arr, nullptr); }
+    ~Array()
+    { if (_data) _env->ReleaseDoubleArrayElements(_arr, _data, _mode); }
+    double* data() const { return _data; }
+  };
+
+  // Check that the (non-null) arrays have at least n elements; if not,
+  // throw an ArrayIndexOutOfBoundsException and return false.
+  bool Check(JNIEnv* env, jint n, std::initializer_list<jdoubleArray> arrs) {
+    for (jdoubleArray a : arrs)
+      if (a && env->GetArrayLength(a) < n) {
+        jclass c = env->FindClass("java/lang/ArrayIndexOutOfBoundsException");
+        if (c) env->ThrowNew(c, "array is shorter than the number of points");
+        return false;
+      }
+    return true;
+  }
+
+  void Throw(JNIEnv* env, const std::exception& e) {
+    jclass c = env->FindClass("net/sf/geographiclib/GeographicErr");
+    if (c) env->ThrowNew(c, e.what());
+  }
+
+} // namespace
+
+extern "C" {
+
+  JNIEXPORT void JNICALL
+  Java_net_sf_geographiclib_NativeGeodesic_inverse
+  (JNIEnv* env, jclass, jdouble a, jdouble f, jint n,
+   jdoubleArray jlat1, jdoubleArray jlon1,
+   jdoubleArray jlat2, jdoubleArray jlon2, jint outmask,
+   jdoubleArray js12, jdoubleArray jazi1, jdoubleArray jazi2,
+   jdoubleArray jm12, jdoubleArray jM12, jdoubleArray jM21,
+   jdoubleArray jS12, jdoubleArray ja12) {
+    if (!Check(env, n, {jlat1, jlon1, jlat2, jlon2, js12, jazi1, jazi2,
+                        jm12, jM12, jM21, jS12, ja12}))
+      return;
+    try {
+      const Geodesic g(a, f);
+      Array lat1(env, jlat1, false), lon1(env, jlon1, false),
+        lat2(env, jlat2, false), lon2(env, jlon2, false),
+        s12(env, js12, true), azi1(env, jazi1, true), azi2(env, jazi2, true),
+        m12(env, jm12, true), M12(env, jM12, true), M21(env, jM21, true),
+        S12(env, jS12, true), a12(env, ja12, true);
+      g.InverseBatch(size_t(n), lat1.data(), lon1.data(),
+                     lat2.data(), lon2.data(), unsigned(outmask),
+                     s12.data(), azi1.data(), azi2.data(),
+                     m12.data(), M12.data(), M21.data(), S12.data(),
+                     a12.data());
+    }
+    catch (const std::exception& e) {
+      Throw(env, e);
+    }
+  }
+
+  JNIEXPORT void JNICALL
+  Java_net_sf_geographiclib_NativeGeodesic_direct
+  (JNIEnv* env, jclass, jdouble a, jdouble f, jint n,
+   jdoubleArray jlat1, jdoubleArray jlon1,
+   jdoubleArray jazi1, jdoubleArray js12, jint outmask,
+   jdoubleArray jlat2, jdoubleArray jlon2, jdoubleArray jazi2,
+   jdoubleArray jm12, jdoubleArray jM12, jdoubleArray jM21,
+   jdoubleArray jS12, jdoubleArray ja12) {
+    if (!Check(env, n, {jlat1, jlon1, jazi1, js12, jlat2, jlon2, jazi2,
+                        jm12, jM12, jM21, jS12, ja12}))
+      return;
+    try {
+      const Geodesic g(a, f);
+      Array lat1(env, jlat1, false), lon1(env, jlon1, false),
+        azi1(env, jazi1, false), s12(env, js12, false),
+        lat2(env, jlat2, true), lon2(env, jlon2, true),
+        azi2(env, jazi2, true),
+        m12(env, jm12, true), M12(env, jM12, true), M21(env, jM21, true),
+        S12(env, jS12, true), a12(env, ja12, true);
+      g.DirectBatch(size_t(n), lat1.data(), lon1.data(),
+                    azi1.data(), s12.data(), unsigned(outmask),
+                    lat2.data(), lon2.data(), azi2.data(),
+                    m12.data(), M12.data(), M21.data(), S12.data(),
+                    a12.data());
+    }
+    catch (const std::exception& e) {
+      Throw(env, e);
+    }
+  }
+
+  JNIEXPORT void JNICALL
+  Java_net_sf_geographiclib_NativeGeodesic_positions
+  (JNIEnv* env, jclass, jdouble a, jdouble f,
+   jdouble lat1, jdouble lon1, jdouble azi1, jint caps, jboolean arcmode,
+   jint n, jdoubleArray js12_a12, jint outmask,
+   jdoubleArray jlat2, jdoubleArray jlon2, jdoubleArray jazi2,
+   jdoubleArray js12, jdoubleArray jm12, jdoubleArray jM12,
+   jdoubleArray jM21, jdoubleArray jS12, jdoubleArray ja12) {
+    if (!Check(env, n, {js12_a12, jlat2, jlon2, jazi2, js12,
+                        jm12, jM12, jM21, jS12, ja12}))
+      return;
+    try {
+      const Geodesic g(a, f);
+      const GeodesicLine l(g, lat1, lon1, azi1, unsigned(caps));
+      Array s12_a12(env, js12_a12, false),
+        lat2(env, jlat2, true), lon2(env, jlon2, true),
+        azi2(env, jazi2, true), s12(env, js12, true),
+        m12(env, jm12, true), M12(env, jM12, true), M21(env, jM21, true),
+        S12(env, jS12, true), a12(env, ja12, true);
+      l.GenPositions(arcmode != JNI_FALSE, size_t(n), s12_a12.data(),
+                     unsigned(outmask),
+                     lat2.data(), lon2.data(), azi2.data(), s12.data(),
+                     m12.data(), M12.data(), M21.data(), S12.data(),
+                     a12.data());
+    }
+    catch (const std::exception& e) {
+      Throw(env, e);
+    }
+  }
+
+}
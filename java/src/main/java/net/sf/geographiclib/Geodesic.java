@@ -459,6 +459,106 @@ public class Geodesic {
       Position(arcmode, s12_a12, outmask);
   }
 
+  /**
+   * Solve many direct geodesic problems.
+   * <p>
+   * @param lat1 array of latitudes of point 1 (degrees).
+   * @param lon1 array of longitudes of point 1 (degrees).
+   * @param azi1 array of azimuths at point 1 (degrees).
+   * @param s12 array of distances between point 1 and point 2 (meters).
+   * @param outmask a bitor'ed combination of {@link GeodesicMask} values
+   *   specifying which of the following arrays should be set.
+   * @param lat2 array of latitudes of point 2 (degrees).
+   * @param lon2 array of longitudes of point 2 (degrees).
+   * @param azi2 array of (forward) azimuths at point 2 (degrees).
+   * @param m12 array of reduced lengths (meters).
+   * @param M12 array of geodesic scales of point 2 relative to point 1
+   *   (dimensionless).
+   * @param M21 array of geodesic scales of point 1 relative to point 2
+   *   (dimensionless).
+   * @param S12 array of areas under the geodesics (meters<sup>2</sup>).
+   * @param a12 array of arc lengths between point 1 and point 2 (degrees);
+   *   this may be null.
+   * <p>
+   * This is the batch version of {@link #Direct(double, double, double,
+   * double, int) Direct}; the results for problem <i>i</i> are the same as
+   * those given by Direct(lat1[i], lon1[i], azi1[i], s12[i], outmask).  Only
+   * the arrays corresponding to the bits set in <i>outmask</i> are accessed;
+   * the others may be null.  The output arrays must be at least as long as
+   * <i>lat1</i>.  A single {@link GeodesicLine} is reinitialized for each
+   * problem, so no objects are allocated for the individual problems.
+   * <p>
+   * If the native library has been loaded with {@link NativeGeodesic#Load()},
+   * the problems are solved by the C++ library.
+   **********************************************************************/
+  public void DirectBatch(double[] lat1, double[] lon1,
+                          double[] azi1, double[] s12, int outmask,
+                          double[] lat2, double[] lon2, double[] azi2,
+                          double[] m12, double[] M12, double[] M21,
+                          double[] S12, double[] a12) {
+    // Automatically supply DISTANCE_IN
+    int caps = outmask | GeodesicMask.DISTANCE_IN;
+    outmask &= GeodesicMask.OUT_MASK;
+    int n = lat1.length;
+    // Hoist the tests on outmask out of the loop.
+    boolean
+      lat = (outmask & GeodesicMask.LATITUDE) != 0,
+      lon = (outmask & GeodesicMask.LONGITUDE) != 0,
+      azi = (outmask & GeodesicMask.AZIMUTH) != 0,
+      redl = (outmask & GeodesicMask.REDUCEDLENGTH) != 0,
+      scale = (outmask & GeodesicMask.GEODESICSCALE) != 0,
+      area = (outmask & GeodesicMask.AREA) != 0;
+    if (NativeGeodesic.Loaded()) {
+      NativeGeodesic.direct(_a, _f, n, lat1, lon1, azi1, s12, outmask,
+                            lat ? lat2 : null, lon ? lon2 : null,
+                            azi ? azi2 : null, redl ? m12 : null,
+                            scale ? M12 : null, scale ? M21 : null,
+                            area ? S12 : null, a12);
+      return;
+    }
+    GeodesicLine line = null;
+    GeodesicData r = new GeodesicData();
+    Pair p = new Pair();
+    for (int i = 0; i < n; ++i) {
+      if (line == null)
+        line = new GeodesicLine(this, lat1[i], lon1[i], azi1[i], caps);
+      else
+        line.LineReset(this, lat1[i], lon1[i], azi1[i], caps, p);
+      line.PositionInt(false, s12[i], outmask, r, p);
+      if (lat) lat2[i] = r.lat2;
+      if (lon) lon2[i] = r.lon2;
+      if (azi) azi2[i] = r.azi2;
+      if (redl) m12[i] = r.m12;
+      if (scale) { M12[i] = r.M12; M21[i] = r.M21; }
+      if (area) S12[i] = r.S12;
+      if (a12 != null) a12[i] = r.a12;
+    }
+  }
+
+  /**
+   * Solve many direct geodesic problems for the positions and azimuths.
+   * <p>
+   * @param lat1 array of latitudes of point 1 (degrees).
+   * @param lon1 array of longitudes of point 1 (degrees).
+   * @param azi1 array of azimuths at point 1 (degrees).
+   * @param s12 array of distances between point 1 and point 2 (meters).
+   * @param lat2 array of latitudes of point 2 (degrees).
+   * @param lon2 array of longitudes of point 2 (degrees).
+   * @param azi2 array of (forward) azimuths at point 2 (degrees).
+   * <p>
+   * See the documentation for {@link #DirectBatch(double[], double[],
+   * double[], double[], int, double[], double[], double[], double[],
+   * double[], double[], double[], double[]) DirectBatch}.
+   **********************************************************************/
+  public void DirectBatch(double[] lat1, double[] lon1,
+                          double[] azi1, double[] s12,
+                          double[] lat2, double[] lon2, double[] azi2) {
+    DirectBatch(lat1, lon1, azi1, s12,
+                GeodesicMask.LATITUDE | GeodesicMask.LONGITUDE |
+                GeodesicMask.AZIMUTH,
+                lat2, lon2, azi2, null, null, null, null, null);
+  }
+
   /**
    * Define a {@link GeodesicLine} in terms of the direct geodesic problem
    * specified in terms of distance with all capabilities included.
@@ -1051,6 +1151,103 @@ public class Geodesic {
     return r;
   }
 
+  /**
+   * Solve many inverse geodesic problems.
+   * <p>
+   * @param lat1 array of latitudes of point 1 (degrees).
+   * @param lon1 array of longitudes of point 1 (degrees).
+   * @param lat2 array of latitudes of point 2 (degrees).
+   * @param lon2 array of longitudes of point 2 (degrees).
+   * @param outmask a bitor'ed combination of {@link GeodesicMask} values
+   *   specifying which of the following arrays should be set.
+   * @param s12 array of distances between point 1 and point 2 (meters).
+   * @param azi1 array of azimuths at point 1 (degrees).
+   * @param azi2 array of (forward) azimuths at point 2 (degrees).
+   * @param m12 array of reduced lengths (meters).
+   * @param M12 array of geodesic scales of point 2 relative to point 1
+   *   (dimensionless).
+   * @param M21 array of geodesic scales of point 1 relative to point 2
+   *   (dimensionless).
+   * @param S12 array of areas under the geodesics (meters<sup>2</sup>).
+   * @param a12 array of arc lengths between point 1 and point 2 (degrees);
+   *   this may be null.
+   * <p>
+   * This is the batch version of {@link #Inverse(double, double, double,
+   * double, int) Inverse}; the results for problem <i>i</i> are the same as
+   * those given by Inverse(lat1[i], lon1[i], lat2[i], lon2[i], outmask).
+   * Only the arrays corresponding to the bits set in <i>outmask</i> are
+   * accessed; the others may be null.  The output arrays must be at least as
+   * long as <i>lat1</i>.  The results are written directly into the arrays
+   * instead of being returned as a {@link GeodesicData} object for each
+   * problem.  The arrays can be slices of larger problems handed to
+   * different threads; a Geodesic object may be used by several threads at
+   * once.
+   * <p>
+   * If the native library has been loaded with {@link NativeGeodesic#Load()},
+   * the problems are solved by the C++ library.
+   **********************************************************************/
+  public void InverseBatch(double[] lat1, double[] lon1,
+                           double[] lat2, double[] lon2, int outmask,
+                           double[] s12, double[] azi1, double[] azi2,
+                           double[] m12, double[] M12, double[] M21,
+                           double[] S12, double[] a12) {
+    outmask &= GeodesicMask.OUT_MASK;
+    int n = lat1.length;
+    // Hoist the tests on outmask out of the loop.
+    boolean
+      dist = (outmask & GeodesicMask.DISTANCE) != 0,
+      azi = (outmask & GeodesicMask.AZIMUTH) != 0,
+      redl = (outmask & GeodesicMask.REDUCEDLENGTH) != 0,
+      scale = (outmask & GeodesicMask.GEODESICSCALE) != 0,
+      area = (outmask & GeodesicMask.AREA) != 0;
+    if (NativeGeodesic.Loaded()) {
+      NativeGeodesic.inverse(_a, _f, n, lat1, lon1, lat2, lon2, outmask,
+                             dist ? s12 : null,
+                             azi ? azi1 : null, azi ? azi2 : null,
+                             redl ? m12 : null,
+                             scale ? M12 : null, scale ? M21 : null,
+                             area ? S12 : null, a12);
+      return;
+    }
+    for (int i = 0; i < n; ++i) {
+      InverseData result = InverseInt(lat1[i], lon1[i], lat2[i], lon2[i],
+                                      outmask);
+      GeodesicData r = result.g;
+      if (dist) s12[i] = r.s12;
+      if (azi) {
+        azi1[i] = GeoMath.atan2d(result.salp1, result.calp1);
+        azi2[i] = GeoMath.atan2d(result.salp2, result.calp2);
+      }
+      if (redl) m12[i] = r.m12;
+      if (scale) { M12[i] = r.M12; M21[i] = r.M21; }
+      if (area) S12[i] = r.S12;
+      if (a12 != null) a12[i] = r.a12;
+    }
+  }
+
+  /**
+   * Solve many inverse geodesic problems for the distances and azimuths.
+   * <p>
+   * @param lat1 array of latitudes of point 1 (degrees).
+   * @param lon1 array of longitudes of point 1 (degrees).
+   * @param lat2 array of latitudes of point 2 (degrees).
+   * @param lon2 array of longitudes of point 2 (degrees).
+   * @param s12 array of distances between point 1 and point 2 (meters).
+   * @param azi1 array of azimuths at point 1 (degrees).
+   * @param azi2 array of (forward) azimuths at point 2 (degrees).
+   * <p>
+   * See the documentation for {@link #InverseBatch(double[], double[],
+   * double[], double[], int, double[], double[], double[], double[],
+   * double[], double[], double[], double[]) InverseBatch}.
+   **********************************************************************/
+  public void InverseBatch(double[] lat1, double[] lon1,
+                           double[] lat2, double[] lon2,
+                           double[] s12, double[] azi1, double[] azi2) {
+    InverseBatch(lat1, lon1, lat2, lon2,
+                 GeodesicMask.DISTANCE | GeodesicMask.AZIMUTH,
+                 s12, azi1, azi2, null, null, null, null, null);
+  }
+
   /**
    * Define a {@link GeodesicLine} in terms of the inverse geodesic problem
    * with all capabilities included.
@@ -177,9 +177,16 @@ public class GeodesicLine {
   public GeodesicLine(Geodesic g,
                       double lat1, double lon1, double azi1,
                       int caps) {
+    LineReset(g, lat1, lon1, azi1, caps, new Pair());
+  }
+
+  // Reinitialize the line in place; the coefficient arrays are reused if they
+  // have already been allocated.  This is used by Geodesic.DirectBatch to
+  // avoid creating a new GeodesicLine for each problem.
+  void LineReset(Geodesic g, double lat1, double lon1, double azi1, int caps,
+                 Pair p) {
     azi1 = GeoMath.AngNormalize(azi1);
     double salp1, calp1;
-    Pair p = new Pair();
     // Guard against underflow in salp0
     GeoMath.sincosd(p, GeoMath.AngRound(azi1));
     salp1 = p.first; calp1 = p.second;
@@ -235,7 +242,7 @@ public class GeodesicLine {
 
     if ((_caps & GeodesicMask.CAP_C1) != 0) {
       _A1m1 = Geodesic.A1m1f(eps);
-      _C1a = new double[nC1_ + 1];
+      if (_C1a == null) _C1a = new double[nC1_ + 1];
       Geodesic.C1f(eps, _C1a);
       _B11 = Geodesic.SinCosSeries(true, _ssig1, _csig1, _C1a);
       double s = Math.sin(_B11), c = Math.cos(_B11);
@@ -247,26 +254,26 @@ public class GeodesicLine {
     }
 
     if ((_caps & GeodesicMask.CAP_C1p) != 0) {
-      _C1pa = new double[nC1p_ + 1];
+      if (_C1pa == null) _C1pa = new double[nC1p_ + 1];
       Geodesic.C1pf(eps, _C1pa);
     }
 
     if ((_caps & GeodesicMask.CAP_C2) != 0) {
-      _C2a = new double[nC2_ + 1];
+      if (_C2a == null) _C2a = new double[nC2_ + 1];
       _A2m1 = Geodesic.A2m1f(eps);
       Geodesic.C2f(eps, _C2a);
       _B21 = Geodesic.SinCosSeries(true, _ssig1, _csig1, _C2a);
     }
 
     if ((_caps & GeodesicMask.CAP_C3) != 0) {
-      _C3a = new double[nC3_];
+      if (_C3a == null) _C3a = new double[nC3_];
       g.C3f(eps, _C3a);
       _A3c = -_f * _salp0 * g.A3f(eps);
       _B31 = Geodesic.SinCosSeries(true, _ssig1, _csig1, _C3a);
     }
 
     if ((_caps & GeodesicMask.CAP_C4) != 0) {
-      _C4a = new double[nC4_];
+      if (_C4a == null) _C4a = new double[nC4_];
       g.C4f(eps, _C4a);
       // Multiplier = a^2 * e^2 * cos(alpha0) * sin(alpha0)
       _A4 = GeoMath.sq(_a) * _calp0 * _salp0 * g._e2;
@@ -426,12 +433,23 @@ public class GeodesicLine {
                                int outmask) {
     outmask &= _caps & GeodesicMask.OUT_MASK;
     GeodesicData r = new GeodesicData();
-    if (!( Init() &&
-           (arcmode ||
-            (_caps & (GeodesicMask.OUT_MASK & GeodesicMask.DISTANCE_IN)) != 0)
-           ))
+    if (!Possible(arcmode))
       // Uninitialized or impossible distance calculation requested
       return r;
+    PositionInt(arcmode, s12_a12, outmask, r, new Pair());
+    return r;
+  }
+
+  boolean Possible(boolean arcmode) {
+    return Init() &&
+      (arcmode ||
+       (_caps & (GeodesicMask.OUT_MASK & GeodesicMask.DISTANCE_IN)) != 0);
+  }
+
+  // The body of Position.  outmask has already been restricted to _caps and
+  // Possible(arcmode) is true.  The results are written to r; p is scratch.
+  void PositionInt(boolean arcmode, double s12_a12, int outmask,
+                   GeodesicData r, Pair p) {
     r.lat1 = _lat1; r.azi1 = _azi1;
     r.lon1 = ((outmask & GeodesicMask.LONG_UNROLL) != 0) ? _lon1 :
       GeoMath.AngNormalize(_lon1);
@@ -442,7 +460,6 @@ public class GeodesicLine {
       // Interpret s12_a12 as spherical arc length
       r.a12 = s12_a12;
       sig12 = Math.toRadians(s12_a12);
-      Pair p = new Pair();
       GeoMath.sincosd(p, s12_a12); ssig12 = p.first; csig12 = p.second;
     } else {
       // Interpret s12_a12 as distance
@@ -584,8 +601,115 @@ public class GeodesicLine {
       }
       r.S12 = _c2 * Math.atan2(salp12, calp12) + _A4 * (B42 - _B41);
     }
+  }
 
-    return r;
+  /**
+   * Compute the positions of many points on the geodesic.
+   * <p>
+   * @param arcmode boolean flag determining the meaning of <i>s12_a12</i>;
+   *   if arcmode is false, then the GeodesicLine object must have been
+   *   constructed with <i>caps</i> |= {@link GeodesicMask#DISTANCE_IN}.
+   * @param s12_a12 array of distances (meters) or arc lengths (degrees) from
+   *   point 1 to the points.
+   * @param outmask a bitor'ed combination of {@link GeodesicMask} values
+   *   specifying which of the following arrays should be set.
+   * @param lat2 array of latitudes (degrees).
+   * @param lon2 array of longitudes (degrees).
+   * @param azi2 array of (forward) azimuths (degrees).
+   * @param s12 array of distances from point 1 (meters).
+   * @param m12 array of reduced lengths (meters).
+   * @param M12 array of geodesic scales of the points relative to point 1
+   *   (dimensionless).
+   * @param M21 array of geodesic scales of point 1 relative to the points
+   *   (dimensionless).
+   * @param S12 array of areas under the geodesic (meters<sup>2</sup>).
+   * @param a12 array of arc lengths from point 1 (degrees); this may be null.
+   * <p>
+   * This is the batch version of {@link #Position(boolean, double, int)
+   * Position}; the results for point <i>i</i> are the same as those given by
+   * Position(arcmode, s12_a12[i], outmask).  Only the arrays corresponding to
+   * the bits set in <i>outmask</i> (restricted to the capabilities of the
+   * object) are accessed; the others may be null.  The output arrays must be
+   * at least as long as <i>s12_a12</i>.  No objects are allocated for the
+   * individual points, so this is a good choice when computing many points
+   * on a geodesic.
+   * <p>
+   * If the native library has been loaded with {@link NativeGeodesic#Load()},
+   * the points are computed by the C++ library starting from
+   * <i>lat1</i>, <i>lon1</i>, and <i>azi1</i>.  (For a GeodesicLine
+   * constructed with {@link Geodesic#InverseLine InverseLine}, this may give
+   * results which differ in the last bit.)
+   **********************************************************************/
+  public void GenPositions(boolean arcmode, double[] s12_a12, int outmask,
+                           double[] lat2, double[] lon2, double[] azi2,
+                           double[] s12, double[] m12,
+                           double[] M12, double[] M21, double[] S12,
+                           double[] a12) {
+    outmask &= _caps & GeodesicMask.OUT_MASK;
+    int n = s12_a12.length;
+    // Hoist the tests on outmask out of the loop.
+    boolean
+      lat = (outmask & GeodesicMask.LATITUDE) != 0,
+      lon = (outmask & GeodesicMask.LONGITUDE) != 0,
+      azi = (outmask & GeodesicMask.AZIMUTH) != 0,
+      dist = (outmask & GeodesicMask.DISTANCE) != 0,
+      redl = (outmask & GeodesicMask.REDUCEDLENGTH) != 0,
+      scale = (outmask & GeodesicMask.GEODESICSCALE) != 0,
+      area = (outmask & GeodesicMask.AREA) != 0;
+    if (Possible(arcmode) && NativeGeodesic.Loaded()) {
+      NativeGeodesic.positions(_a, _f, _lat1, _lon1, _azi1, _caps, arcmode,
+                               n, s12_a12, outmask,
+                               lat ? lat2 : null, lon ? lon2 : null,
+                               azi ? azi2 : null, dist ? s12 : null,
+                               redl ? m12 : null,
+                               scale ? M12 : null, scale ? M21 : null,
+                               area ? S12 : null, a12);
+      return;
+    }
+    GeodesicData r = new GeodesicData();
+    Pair p = new Pair();
+    boolean ok = Possible(arcmode);
+    for (int i = 0; i < n; ++i) {
+      if (ok) PositionInt(arcmode, s12_a12[i], outmask, r, p);
+      if (lat) lat2[i] = r.lat2;
+      if (lon) lon2[i] = r.lon2;
+      if (azi) azi2[i] = r.azi2;
+      if (dist) s12[i] = r.s12;
+      if (redl) m12[i] = r.m12;
+      if (scale) { M12[i] = r.M12; M21[i] = r.M21; }
+      if (area) S12[i] = r.S12;
+      if (a12 != null) a12[i] = r.a12;
+    }
+  }
+
+  /**
+   * Compute the latitudes and longitudes of many points specified by their
+   * distances from point 1.
+   * <p>
+   * @param s12 array of distances from point 1 (meters).
+   * @param lat2 array of latitudes (degrees).
+   * @param lon2 array of longitudes (degrees).
+   * <p>
+   * See the documentation for {@link #GenPositions GenPositions}.
+   **********************************************************************/
+  public void Positions(double[] s12, double[] lat2, double[] lon2) {
+    GenPositions(false, s12, GeodesicMask.LATITUDE | GeodesicMask.LONGITUDE,
+                 lat2, lon2, null, null, null, null, null, null, null);
+  }
+
+  /**
+   * Compute the latitudes and longitudes of many points specified by their
+   * arc lengths from point 1.
+   * <p>
+   * @param a12 array of arc lengths from point 1 (degrees).
+   * @param lat2 array of latitudes (degrees).
+   * @param lon2 array of longitudes (degrees).
+   * <p>
+   * See the documentation for {@link #GenPositions GenPositions}.
+   **********************************************************************/
+  public void ArcPositions(double[] a12, double[] lat2, double[] lon2) {
+    GenPositions(true, a12, GeodesicMask.LATITUDE | GeodesicMask.LONGITUDE,
+                 lat2, lon2, null, null, null, null, null, null, null);
   }
 
   /**
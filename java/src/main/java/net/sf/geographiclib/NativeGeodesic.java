@@ -0,0 +1,83 @@
+/**
+ * Implementation of the net.sf.geographiclib.NativeGeodesic class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+package net.sf.geographiclib;
+
+/**
+ * Optional access to the batch routines of the C++ library via JNI.
+ * <p>
+ * The batch routines, {@link Geodesic#InverseBatch(double[], double[],
+ * double[], double[], int, double[], double[], double[], double[], double[],
+ * double[], double[], double[]) Geodesic.InverseBatch}, {@link
+ * Geodesic#DirectBatch(double[], double[], double[], double[], int, double[],
+ * double[], double[], double[], double[], double[], double[], double[])
+ * Geodesic.DirectBatch}, and {@link GeodesicLine#GenPositions
+ * GeodesicLine.GenPositions}, are implemented in Java.  If {@link #Load()} is
+ * called and it succeeds in loading the native library
+ * <code>GeographicLib_jni</code>, these routines call the C++ library
+ * instead.  The results agree with the Java routines to within roundoff.
+ * <p>
+ * The native library is built from <code>jni/geographiclib_jni.cpp</code>
+ * (see the instructions in that file) and must be in a directory listed in
+ * <code>java.library.path</code>.  The rest of the Java library is
+ * unaffected if it isn't available.
+ **********************************************************************/
+public class NativeGeodesic {
+
+  private static volatile boolean loaded = false;
+
+  private NativeGeodesic() {}
+
+  /**
+   * Load the native library.
+   * <p>
+   * @return true if the native library is (now) loaded.
+   * <p>
+   * This may be called several times; failure to load the library is not an
+   * error, it just means that the Java routines will continue to be used.
+   **********************************************************************/
+  public static synchronized boolean Load() {
+    if (!loaded) {
+      try {
+        System.loadLibrary("GeographicLib_jni");
+        loaded = true;
+      }
+      catch (UnsatisfiedLinkError e) {}
+      catch (SecurityException e) {}
+    }
+    return loaded;
+  }
+
+  /**
+   * @return true if the native library has been loaded.
+   **********************************************************************/
+  public static boolean Loaded() { return loaded; }
+
+  // The native routines.  The outputs which are not needed are null.
+  static native void inverse(double a, double f, int n,
+                             double[] lat1, double[] lon1,
+                             double[] lat2, double[] lon2, int outmask,
+                             double[] s12, double[] azi1, double[] azi2,
+                             double[] m12, double[] M12, double[] M21,
+                             double[] S12, double[] a12);
+
+  static native void direct(double a, double f, int n,
+                            double[] lat1, double[] lon1,
+                            double[] azi1, double[] s12, int outmask,
+                            double[] lat2, double[] lon2, double[] azi2,
+                            double[] m12, double[] M12, double[] M21,
+                            double[] S12, double[] a12);
+
+  static native void positions(double a, double f,
+                               double lat1, double lon1, double azi1,
+                               int caps, boolean arcmode,
+                               int n, double[] s12_a12, int outmask,
+                               double[] lat2, double[] lon2, double[] azi2,
+                               double[] s12, double[] m12,
+                               double[] M12, double[] M21,
+                               double[] S12, double[] a12);
+}
@@ -178,6 +178,76 @@ public class GeodesicTest {
     }
   }
 
+  @Test
+  public void InverseBatchCheck() {
+    int n = testcases.length;
+    double lat1[] = new double[n], lon1[] = new double[n],
+      lat2[] = new double[n], lon2[] = new double[n],
+      s12[] = new double[n], azi1[] = new double[n], azi2[] = new double[n],
+      m12[] = new double[n], M12[] = new double[n], M21[] = new double[n],
+      S12[] = new double[n], a12[] = new double[n];
+    for (int i = 0; i < n; ++i) {
+      lat1[i] = testcases[i][0]; lon1[i] = testcases[i][1];
+      lat2[i] = testcases[i][3]; lon2[i] = testcases[i][4];
+    }
+    Geodesic.WGS84.InverseBatch(lat1, lon1, lat2, lon2,
+                                GeodesicMask.ALL | GeodesicMask.LONG_UNROLL,
+                                s12, azi1, azi2, m12, M12, M21, S12, a12);
+    for (int i = 0; i < n; ++i) {
+      assertEquals(testcases[i][2], azi1[i], 1e-13);
+      assertEquals(testcases[i][5], azi2[i], 1e-13);
+      assertEquals(testcases[i][6], s12[i], 1e-8);
+      assertEquals(testcases[i][7], a12[i], 1e-13);
+      assertEquals(testcases[i][8], m12[i], 1e-8);
+      assertEquals(testcases[i][9], M12[i], 1e-15);
+      assertEquals(testcases[i][10], M21[i], 1e-15);
+      assertEquals(testcases[i][11], S12[i], 0.1);
+    }
+  }
+
+  @Test
+  public void DirectBatchCheck() {
+    int n = testcases.length;
+    double lat1[] = new double[n], lon1[] = new double[n],
+      azi1[] = new double[n], s12[] = new double[n],
+      lat2[] = new double[n], lon2[] = new double[n], azi2[] = new double[n],
+      S12[] = new double[n];
+    for (int i = 0; i < n; ++i) {
+      lat1[i] = testcases[i][0]; lon1[i] = testcases[i][1];
+      azi1[i] = testcases[i][2]; s12[i] = testcases[i][6];
+    }
+    Geodesic.WGS84.DirectBatch(lat1, lon1, azi1, s12,
+                               GeodesicMask.STANDARD | GeodesicMask.AREA |
+                               GeodesicMask.LONG_UNROLL,
+                               lat2, lon2, azi2, null, null, null, S12, null);
+    for (int i = 0; i < n; ++i) {
+      assertEquals(testcases[i][3], lat2[i], 1e-13);
+      assertEquals(testcases[i][4], lon2[i], 1e-13);
+      assertEquals(testcases[i][5], azi2[i], 1e-13);
+      assertEquals(testcases[i][11], S12[i], 0.1);
+    }
+  }
+
+  @Test
+  public void PositionsCheck() {
+    GeodesicLine line = Geodesic.WGS84.InverseLine(40.6, -73.8, 1.4, 104);
+    double s12[] = {0, line.Distance() / 3, line.Distance()},
+      lat2[] = new double[3], lon2[] = new double[3], azi2[] = new double[3],
+      a12[] = new double[3];
+    line.GenPositions(false, s12, GeodesicMask.STANDARD,
+                      lat2, lon2, azi2, null, null, null, null, null, a12);
+    for (int i = 0; i < s12.length; ++i) {
+      GeodesicData pos = line.Position(s12[i]);
+      assertEquals(pos.lat2, lat2[i], 1e-13);
+      assertEquals(pos.lon2, lon2[i], 1e-13);
+      assertEquals(pos.azi2, azi2[i], 1e-13);
+      assertEquals(pos.a12, a12[i], 1e-13);
+    }
+    line.ArcPositions(new double[] {line.Arc()}, lat2, lon2);
+    assertEquals(1.4, lat2[0], 1e-13);
+    assertEquals(104, lon2[0], 1e-13);
+  }
+
   @Test
   public void GeodSolve0() {
     GeodesicData inv = Geodesic.WGS84.Inverse(40.6, -73.8,
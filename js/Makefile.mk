@@ -1,5 +1,5 @@
 # The order here is significant
-JS_MODULES=Math Geodesic GeodesicLine PolygonArea DMS
+JS_MODULES=Math Geodesic GeodesicLine PolygonArea DMS Wasm
 JSSCRIPTS = $(patsubst %,src/%.js,$(JS_MODULES))
 TYPESSCRIPTS = $(wildcard types/*.d.ts)
 TESTSCRIPTS = $(wildcard test/*.js)
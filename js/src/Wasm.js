@@ -0,0 +1,422 @@
+/*
+ * Wasm.js
+ * Batch versions of the geodesic routines using WebAssembly.
+ *
+ * The WebAssembly module, geographiclib.wasm, is compiled from the C++
+ * library by wasm/build-wasm.sh.  If it hasn't been loaded, the batch
+ * routines loop over the JavaScript routines.
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ */
+
+// Load AFTER GeographicLib/Math.js, GeographicLib/Geodesic.js,
+// GeographicLib/GeodesicLine.js, and GeographicLib/PolygonArea.js
+
+GeographicLib.Wasm = {};
+
+(function(
+  /**
+   * @exports GeographicLib/Wasm
+   * @description Solve many geodesic problems at once with the C++ library
+   *   compiled to WebAssembly.  Call
+   *   {@link module:GeographicLib/Wasm.load load} to load geographiclib.wasm;
+   *   thereafter the batch routines,
+   *   {@link module:GeographicLib/Geodesic.Geodesic#InverseBatch
+   *   Geodesic.InverseBatch},
+   *   {@link module:GeographicLib/Geodesic.Geodesic#DirectBatch
+   *   Geodesic.DirectBatch},
+   *   {@link module:GeographicLib/Geodesic.Geodesic#PolygonAreaBatch
+   *   Geodesic.PolygonAreaBatch}, and
+   *   {@link module:GeographicLib/GeodesicLine.GeodesicLine#GenPositionBatch
+   *   GeodesicLine.GenPositionBatch}, use the compiled code.  Until then (or
+   *   if WebAssembly isn't supported) they give the same results by calling
+   *   the JavaScript routines for each problem.
+   */
+  w, g, l, m) {
+  "use strict";
+
+  var kernels = null, wasmImports, call, batchmask;
+
+  // Supply the functions imported by the module.  None of these should be
+  // called, except to abort the program (e.g., if the library throws an
+  // exception) or to be told about the growth of the memory.
+  wasmImports = function(module) {
+    var imports = {}, list = WebAssembly.Module.imports(module), i;
+    for (i = 0; i < list.length; ++i) {
+      if (list[i].kind !== "function") continue;
+      if (!imports[list[i].module]) imports[list[i].module] = {};
+      imports[list[i].module][list[i].name] =
+        (function(name) {
+          return /abort|exit|throw/.test(name) ?
+            function() {
+              throw new Error("GeographicLib.Wasm: " + name + " called");
+            } :
+            function() { return 0; };
+        })(list[i].name);
+    }
+    return imports;
+  };
+
+  // Copy the arrays ins (each of length n) into the WebAssembly memory, call
+  // fn with the addresses of the inputs followed by those of the outputs
+  // (0 for the outputs which are not wanted, flagged by false in outs), and
+  // return an array of the outputs as Float64Arrays.
+  call = function(n, ins, outs, fn) {
+    var k = kernels, nin = ins.length, nout = outs.length,
+        p = k.alloc(Math.max(1, n * (nin + nout))), heap, addr = [], res = [],
+        i;
+    if (!p) throw new Error("GeographicLib.Wasm: out of memory");
+    try {
+      heap = new Float64Array(k.memory.buffer);
+      for (i = 0; i < nin; ++i) {
+        if (ins[i].length !== n)
+          throw new Error("GeographicLib.Wasm: arrays must have length " + n);
+        heap.set(ins[i], p/8 + n * i);
+        addr.push(p + 8 * n * i);
+      }
+      for (i = 0; i < nout; ++i)
+        addr.push(outs[i] ? p + 8 * n * (nin + i) : 0);
+      fn(addr);
+      // The memory may have grown; so get a new view
+      heap = new Float64Array(k.memory.buffer);
+      for (i = 0; i < nout; ++i)
+        res.push(outs[i] ?
+                 heap.slice(p/8 + n * (nin + i), p/8 + n * (nin + i + 1)) :
+                 null);
+    } finally {
+      k.free(p);
+    }
+    return res;
+  };
+
+  // Canonicalize outmask as in Geodesic.Inverse, etc.
+  batchmask = function(outmask) {
+    if (!outmask) outmask = g.STANDARD;
+    else if (outmask === g.LONG_UNROLL) outmask |= g.STANDARD;
+    return outmask;
+  };
+
+  /**
+   * @summary Load the WebAssembly module.
+   * @param {object} source the contents of geographiclib.wasm as an
+   *   ArrayBuffer or typed array, a WebAssembly.Module, a Response (e.g.,
+   *   the result of fetch("geographiclib.wasm")), or a Promise for one of
+   *   these.
+   * @returns {Promise} a Promise which resolves to
+   *   {@link module:GeographicLib/Wasm GeographicLib.Wasm} once the module is
+   *   ready to use.
+   * @description In a browser, use
+   *   <code>GeographicLib.Wasm.load(fetch("geographiclib.wasm"))</code>; in
+   *   node, use
+   *   <code>GeographicLib.Wasm.load(fs.readFileSync("geographiclib.wasm"))</code>.
+   */
+  w.load = function(source) {
+    if (typeof WebAssembly !== "object")
+      return Promise.reject(new Error("WebAssembly is not supported"));
+    return Promise.resolve(source).then(function(src) {
+      return typeof Response !== "undefined" && src instanceof Response ?
+        src.arrayBuffer() : src;
+    }).then(function(src) {
+      return src instanceof WebAssembly.Module ? src :
+        WebAssembly.compile(src);
+    }).then(function(module) {
+      return WebAssembly.instantiate(module, wasmImports(module));
+    }).then(function(instance) {
+      var e = instance.exports;
+      // Run the static constructors of a module built with --no-entry
+      if (e._initialize) e._initialize();
+      kernels = {
+        memory: e.memory,
+        alloc: e.geod_alloc,
+        free: e.geod_free,
+        inverse: e.geod_inverse_batch,
+        direct: e.geod_direct_batch,
+        positions: e.geod_line_positions,
+        polygon: e.geod_polygon_area
+      };
+      return w;
+    });
+  };
+
+  /**
+   * @summary Check whether the WebAssembly module has been loaded.
+   * @returns {bool} true if the batch routines use the compiled code.
+   */
+  w.loaded = function() {
+    return kernels !== null;
+  };
+
+  /**
+   * @summary Revert to using the JavaScript routines.
+   */
+  w.unload = function() {
+    kernels = null;
+  };
+
+  /**
+   * @summary Solve many inverse geodesic problems.
+   * @param {array} lat1 the latitudes of the first points in degrees.
+   * @param {array} lon1 the longitudes of the first points in degrees.
+   * @param {array} lat2 the latitudes of the second points in degrees.
+   * @param {array} lon2 the longitudes of the second points in degrees.
+   * @param {bitmask} [outmask = STANDARD] which results to include.
+   * @returns {object} the requested results as Float64Arrays.
+   * @description The arrays (ordinary arrays or typed arrays) must all have
+   *   the same length.  The a12, s12, azi1, azi2, m12, M12, M21, and S12
+   *   fields of the result are set as for
+   *   {@link module:GeographicLib/Geodesic.Geodesic#Inverse Inverse}; the
+   *   input coordinates are not echoed.
+   */
+  g.Geodesic.prototype.InverseBatch = function(lat1, lon1, lat2, lon2,
+                                               outmask) {
+    var n = lat1.length, vals = {}, out, r, i, t;
+    outmask = batchmask(outmask);
+    out = outmask & g.OUT_MASK;
+    if (kernels) {
+      r = call(n, [lat1, lon1, lat2, lon2],
+               [out & g.DISTANCE, out & g.AZIMUTH, out & g.AZIMUTH,
+                out & g.REDUCEDLENGTH,
+                out & g.GEODESICSCALE, out & g.GEODESICSCALE,
+                out & g.AREA, true],
+               function(p) {
+                 kernels.inverse(this.a, this.f, n, p[0], p[1], p[2], p[3],
+                                 outmask, p[4], p[5], p[6], p[7], p[8], p[9],
+                                 p[10], p[11]);
+               }.bind(this));
+      vals.a12 = r[7];
+      if (out & g.DISTANCE) vals.s12 = r[0];
+      if (out & g.AZIMUTH) { vals.azi1 = r[1]; vals.azi2 = r[2]; }
+      if (out & g.REDUCEDLENGTH) vals.m12 = r[3];
+      if (out & g.GEODESICSCALE) { vals.M12 = r[4]; vals.M21 = r[5]; }
+      if (out & g.AREA) vals.S12 = r[6];
+      return vals;
+    }
+    vals.a12 = new Float64Array(n);
+    if (out & g.DISTANCE) vals.s12 = new Float64Array(n);
+    if (out & g.AZIMUTH) {
+      vals.azi1 = new Float64Array(n); vals.azi2 = new Float64Array(n);
+    }
+    if (out & g.REDUCEDLENGTH) vals.m12 = new Float64Array(n);
+    if (out & g.GEODESICSCALE) {
+      vals.M12 = new Float64Array(n); vals.M21 = new Float64Array(n);
+    }
+    if (out & g.AREA) vals.S12 = new Float64Array(n);
+    for (i = 0; i < n; ++i) {
+      t = this.Inverse(lat1[i], lon1[i], lat2[i], lon2[i], outmask);
+      vals.a12[i] = t.a12;
+      if (out & g.DISTANCE) vals.s12[i] = t.s12;
+      if (out & g.AZIMUTH) { vals.azi1[i] = t.azi1; vals.azi2[i] = t.azi2; }
+      if (out & g.REDUCEDLENGTH) vals.m12[i] = t.m12;
+      if (out & g.GEODESICSCALE) { vals.M12[i] = t.M12; vals.M21[i] = t.M21; }
+      if (out & g.AREA) vals.S12[i] = t.S12;
+    }
+    return vals;
+  };
+
+  /**
+   * @summary Solve many direct geodesic problems.
+   * @param {array} lat1 the latitudes of the first points in degrees.
+   * @param {array} lon1 the longitudes of the first points in degrees.
+   * @param {array} azi1 the azimuths at the first points in degrees.
+   * @param {array} s12 the distances from the first points to the second in
+   *   meters.
+   * @param {bitmask} [outmask = STANDARD] which results to include.
+   * @returns {object} the requested results as Float64Arrays.
+   * @description The arrays (ordinary arrays or typed arrays) must all have
+   *   the same length.  The a12, lat2, lon2, azi2, m12, M12, M21, and S12
+   *   fields of the result are set as for
+   *   {@link module:GeographicLib/Geodesic.Geodesic#Direct Direct}; the
+   *   input values are not echoed.
+   */
+  g.Geodesic.prototype.DirectBatch = function(lat1, lon1, azi1, s12,
+                                              outmask) {
+    var n = lat1.length, vals = {}, out, r, i, t;
+    outmask = batchmask(outmask);
+    out = outmask & g.OUT_MASK;
+    if (kernels) {
+      r = call(n, [lat1, lon1, azi1, s12],
+               [out & g.LATITUDE, out & g.LONGITUDE, out & g.AZIMUTH,
+                out & g.REDUCEDLENGTH,
+                out & g.GEODESICSCALE, out & g.GEODESICSCALE,
+                out & g.AREA, true],
+               function(p) {
+                 kernels.direct(this.a, this.f, n, p[0], p[1], p[2], p[3],
+                                outmask, p[4], p[5], p[6], p[7], p[8], p[9],
+                                p[10], p[11]);
+               }.bind(this));
+      vals.a12 = r[7];
+      if (out & g.LATITUDE) vals.lat2 = r[0];
+      if (out & g.LONGITUDE) vals.lon2 = r[1];
+      if (out & g.AZIMUTH) vals.azi2 = r[2];
+      if (out & g.REDUCEDLENGTH) vals.m12 = r[3];
+      if (out & g.GEODESICSCALE) { vals.M12 = r[4]; vals.M21 = r[5]; }
+      if (out & g.AREA) vals.S12 = r[6];
+      return vals;
+    }
+    vals.a12 = new Float64Array(n);
+    if (out & g.LATITUDE) vals.lat2 = new Float64Array(n);
+    if (out & g.LONGITUDE) vals.lon2 = new Float64Array(n);
+    if (out & g.AZIMUTH) vals.azi2 = new Float64Array(n);
+    if (out & g.REDUCEDLENGTH) vals.m12 = new Float64Array(n);
+    if (out & g.GEODESICSCALE) {
+      vals.M12 = new Float64Array(n); vals.M21 = new Float64Array(n);
+    }
+    if (out & g.AREA) vals.S12 = new Float64Array(n);
+    for (i = 0; i < n; ++i) {
+      t = this.Direct(lat1[i], lon1[i], azi1[i], s12[i], outmask);
+      vals.a12[i] = t.a12;
+      if (out & g.LATITUDE) vals.lat2[i] = t.lat2;
+      if (out & g.LONGITUDE) vals.lon2[i] = t.lon2;
+      if (out & g.AZIMUTH) vals.azi2[i] = t.azi2;
+      if (out & g.REDUCEDLENGTH) vals.m12[i] = t.m12;
+      if (out & g.GEODESICSCALE) { vals.M12[i] = t.M12; vals.M21[i] = t.M21; }
+      if (out & g.AREA) vals.S12[i] = t.S12;
+    }
+    return vals;
+  };
+
+  /**
+   * @summary Compute the perimeter and area of a polygon.
+   * @param {array} lats the latitudes of the vertices in degrees.
+   * @param {array} lons the longitudes of the vertices in degrees.
+   * @param {bool} [polyline = false] if true the vertices describe a
+   *   polyline instead of a polygon.
+   * @param {bool} [reverse = false] if true then clockwise (instead of
+   *   counter-clockwise) traversal counts as a positive area.
+   * @param {bool} [sign = true] if true then return a signed result for the
+   *   area if the polygon is traversed in the "wrong" direction instead of
+   *   returning the area for the rest of the earth.
+   * @returns {object} r where r.number is the number of vertices, r.perimeter
+   *   is the perimeter (meters), and r.area (only returned if polyline is
+   *   false) is the area (meters<sup>2</sup>).
+   * @description This gives the same result as adding the vertices in turn
+   *   to a {@link module:GeographicLib/PolygonArea.PolygonArea PolygonArea}
+   *   object and calling its Compute method.
+   */
+  g.Geodesic.prototype.PolygonAreaBatch = function(lats, lons, polyline,
+                                                   reverse, sign) {
+    var n = lats.length, poly, r, i;
+    polyline = !!polyline; reverse = !!reverse;
+    sign = typeof sign === "undefined" ? true : !!sign;
+    if (kernels) {
+      call(n, [lats, lons], [], function(p) {
+        var res = kernels.alloc(3), heap;
+        try {
+          kernels.polygon(this.a, this.f, polyline ? 1 : 0, reverse ? 1 : 0,
+                          sign ? 1 : 0, n, p[0], p[1], res);
+          heap = new Float64Array(kernels.memory.buffer);
+          r = heap.slice(res/8, res/8 + 3);
+        } finally {
+          kernels.free(res);
+        }
+      }.bind(this));
+      return polyline ? {number: r[0], perimeter: r[1]} :
+        {number: r[0], perimeter: r[1], area: r[2]};
+    }
+    poly = this.Polygon(polyline);
+    for (i = 0; i < n; ++i)
+      poly.AddPoint(lats[i], lons[i]);
+    return poly.Compute(reverse, sign);
+  };
+
+  /**
+   * @summary Find many positions on the line.
+   * @param {bool} arcmode boolean flag determining the meaning of s12_a12.
+   * @param {array} s12_a12 if arcmode is false, the distances from the first
+   *   point in meters; otherwise the arc lengths in degrees.
+   * @param {bitmask} [outmask = STANDARD] which results to include; this is
+   *   subject to the capabilities of the object.
+   * @returns {object} the requested results as Float64Arrays.
+   * @description The a12, lat2, lon2, azi2, s12 (if arcmode is true), m12,
+   *   M12, M21, and S12 fields of the result are set as for
+   *   {@link module:GeographicLib/GeodesicLine.GeodesicLine#GenPosition
+   *   GenPosition}.  The compiled code starts the line from lat1, lon1, and
+   *   azi1; so, for a line created by
+   *   {@link module:GeographicLib/Geodesic.Geodesic#InverseLine InverseLine},
+   *   the results may differ from those of GenPosition by roundoff.
+   */
+  l.GeodesicLine.prototype.GenPositionBatch = function(arcmode, s12_a12,
+                                                       outmask) {
+    var n = s12_a12.length, vals = {}, out, r, i, t;
+    outmask = batchmask(outmask);
+    out = outmask & this.caps & g.OUT_MASK;
+    arcmode = !!arcmode;
+    if (kernels) {
+      r = call(n, [s12_a12],
+               [out & g.LATITUDE, out & g.LONGITUDE, out & g.AZIMUTH,
+                arcmode && (out & g.DISTANCE), out & g.REDUCEDLENGTH,
+                out & g.GEODESICSCALE, out & g.GEODESICSCALE,
+                out & g.AREA, true],
+               function(p) {
+                 kernels.positions(this.a, this.f,
+                                   this.lat1, this.lon1, this.azi1, this.caps,
+                                   arcmode ? 1 : 0, n, p[0], out,
+                                   p[1], p[2], p[3], p[4], p[5], p[6], p[7],
+                                   p[8], p[9]);
+               }.bind(this));
+      vals.a12 = r[8];
+      if (out & g.LATITUDE) vals.lat2 = r[0];
+      if (out & g.LONGITUDE) vals.lon2 = r[1];
+      if (out & g.AZIMUTH) vals.azi2 = r[2];
+      if (arcmode && (out & g.DISTANCE)) vals.s12 = r[3];
+      if (out & g.REDUCEDLENGTH) vals.m12 = r[4];
+      if (out & g.GEODESICSCALE) { vals.M12 = r[5]; vals.M21 = r[6]; }
+      if (out & g.AREA) vals.S12 = r[7];
+      return vals;
+    }
+    vals.a12 = new Float64Array(n);
+    if (out & g.LATITUDE) vals.lat2 = new Float64Array(n);
+    if (out & g.LONGITUDE) vals.lon2 = new Float64Array(n);
+    if (out & g.AZIMUTH) vals.azi2 = new Float64Array(n);
+    if (arcmode && (out & g.DISTANCE)) vals.s12 = new Float64Array(n);
+    if (out & g.REDUCEDLENGTH) vals.m12 = new Float64Array(n);
+    if (out & g.GEODESICSCALE) {
+      vals.M12 = new Float64Array(n); vals.M21 = new Float64Array(n);
+    }
+    if (out & g.AREA) vals.S12 = new Float64Array(n);
+    for (i = 0; i < n; ++i) {
+      t = this.GenPosition(arcmode, s12_a12[i], outmask);
+      vals.a12[i] = t.a12;
+      if (out & g.LATITUDE) vals.lat2[i] = t.lat2;
+      if (out & g.LONGITUDE) vals.lon2[i] = t.lon2;
+      if (out & g.AZIMUTH) vals.azi2[i] = t.azi2;
+      if (arcmode && (out & g.DISTANCE)) vals.s12[i] = t.s12;
+      if (out & g.REDUCEDLENGTH) vals.m12[i] = t.m12;
+      if (out & g.GEODESICSCALE) { vals.M12[i] = t.M12; vals.M21[i] = t.M21; }
+      if (out & g.AREA) vals.S12[i] = t.S12;
+    }
+    return vals;
+  };
+
+  /**
+   * @summary Find many positions on the line given the distances.
+   * @param {array} s12 the distances from the first point in meters.
+   * @param {bitmask} [outmask = STANDARD] which results to include; this is
+   *   subject to the capabilities of the object.
+   * @returns {object} the requested results as Float64Arrays.
+   * @description See
+   *   {@link module:GeographicLib/GeodesicLine.GeodesicLine#GenPositionBatch
+   *   GenPositionBatch}.
+   */
+  l.GeodesicLine.prototype.PositionBatch = function(s12, outmask) {
+    return this.GenPositionBatch(false, s12, outmask);
+  };
+
+  /**
+   * @summary Find many positions on the line given the arc lengths.
+   * @param {array} a12 the arc lengths from the first point in degrees.
+   * @param {bitmask} [outmask = STANDARD] which results to include; this is
+   *   subject to the capabilities of the object.
+   * @returns {object} the requested results as Float64Arrays.
+   * @description See
+   *   {@link module:GeographicLib/GeodesicLine.GeodesicLine#GenPositionBatch
+   *   GenPositionBatch}.
+   */
+  l.GeodesicLine.prototype.ArcPositionBatch = function(a12, outmask) {
+    return this.GenPositionBatch(true, a12, outmask);
+  };
+
+})(GeographicLib.Wasm, GeographicLib.Geodesic, GeographicLib.GeodesicLine,
+   GeographicLib.Math);
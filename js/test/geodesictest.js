@@ -638,6 +638,72 @@ describe("GeographicLib", function() {
 
   });
 
+  describe("BatchTest", function () {
+    var geod = g.WGS84;
+
+    it("InverseBatch", function() {
+      var i, n = testcases.length, lat1 = [], lon1 = [], lat2 = [], lon2 = [],
+          r;
+      for (i = 0; i < n; ++i) {
+        lat1.push(testcases[i][0]); lon1.push(testcases[i][1]);
+        lat2.push(testcases[i][3]); lon2.push(testcases[i][4]);
+      }
+      r = geod.InverseBatch(lat1, lon1, lat2, lon2, g.ALL | g.LONG_UNROLL);
+      assert(r.s12 instanceof Float64Array);
+      for (i = 0; i < n; ++i) {
+        assert.approx(r.azi1[i], testcases[i][2], 1e-13);
+        assert.approx(r.azi2[i], testcases[i][5], 1e-13);
+        assert.approx(r.s12[i], testcases[i][6], 1e-8);
+        assert.approx(r.a12[i], testcases[i][7], 1e-13);
+        assert.approx(r.m12[i], testcases[i][8], 1e-8);
+        assert.approx(r.S12[i], testcases[i][11], 0.1);
+      }
+    });
+
+    it("DirectBatch", function() {
+      var i, n = testcases.length, lat1 = [], lon1 = [], azi1 = [], s12 = [],
+          r;
+      for (i = 0; i < n; ++i) {
+        lat1.push(testcases[i][0]); lon1.push(testcases[i][1]);
+        azi1.push(testcases[i][2]); s12.push(testcases[i][6]);
+      }
+      r = geod.DirectBatch(new Float64Array(lat1), new Float64Array(lon1),
+                           new Float64Array(azi1), new Float64Array(s12),
+                           g.STANDARD | g.LONG_UNROLL);
+      assert.strictEqual(r.m12, undefined);
+      for (i = 0; i < n; ++i) {
+        assert.approx(r.lat2[i], testcases[i][3], 1e-13);
+        assert.approx(r.lon2[i], testcases[i][4], 1e-13);
+        assert.approx(r.azi2[i], testcases[i][5], 1e-13);
+        assert.approx(r.a12[i], testcases[i][7], 1e-13);
+      }
+    });
+
+    it("PositionBatch", function() {
+      var line = geod.InverseLine(40.6, -73.8, 1.4, 104, g.ALL),
+          s12 = [0, line.s13/3, line.s13], r, i, t;
+      r = line.PositionBatch(s12);
+      for (i = 0; i < s12.length; ++i) {
+        t = line.Position(s12[i]);
+        assert.approx(r.lat2[i], t.lat2, 1e-13);
+        assert.approx(r.lon2[i], t.lon2, 1e-13);
+        assert.approx(r.azi2[i], t.azi2, 1e-13);
+      }
+      r = line.ArcPositionBatch([line.a13], g.DISTANCE);
+      assert.approx(r.s12[0], line.s13, 1e-8);
+    });
+
+    it("PolygonAreaBatch", function() {
+      var r = geod.PolygonAreaBatch([89, 89, 89, 89], [0, 90, 180, 270]);
+      assert.strictEqual(r.number, 4);
+      assert.approx(r.perimeter, 631819.8745, 1e-4);
+      assert.approx(r.area, 24952305678.0, 1);
+      r = geod.PolygonAreaBatch([89, 89, 89, 89], [0, 90, 180, 270], true);
+      assert.strictEqual(r.area, undefined);
+    });
+
+  });
+
   describe("Planimeter", function () {
 
     var geod = g.WGS84,
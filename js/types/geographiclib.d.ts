@@ -139,6 +139,52 @@ declare class GeodesicClass {
     lon2: number,
     caps?: number
   ): any; // TODO: define GeodesicLine object
+
+  InverseBatch(
+    lat1: ArrayLike<number>,
+    lon1: ArrayLike<number>,
+    lat2: ArrayLike<number>,
+    lon2: ArrayLike<number>,
+    outmask?: number
+  ): {
+    a12: Float64Array;
+    s12?: Float64Array;
+    azi1?: Float64Array;
+    azi2?: Float64Array;
+    m12?: Float64Array;
+    M12?: Float64Array;
+    M21?: Float64Array;
+    S12?: Float64Array;
+  };
+
+  DirectBatch(
+    lat1: ArrayLike<number>,
+    lon1: ArrayLike<number>,
+    azi1: ArrayLike<number>,
+    s12: ArrayLike<number>,
+    outmask?: number
+  ): {
+    a12: Float64Array;
+    lat2?: Float64Array;
+    lon2?: Float64Array;
+    azi2?: Float64Array;
+    m12?: Float64Array;
+    M12?: Float64Array;
+    M21?: Float64Array;
+    S12?: Float64Array;
+  };
+
+  PolygonAreaBatch(
+    lats: ArrayLike<number>,
+    lons: ArrayLike<number>,
+    polyline?: boolean,
+    reverse?: boolean,
+    sign?: boolean
+  ): {
+    number: number;
+    perimeter: number;
+    area?: number;
+  };
 }
 
 export declare const Geodesic: {
@@ -150,3 +196,8 @@ export declare const Geodesic: {
 export declare const GeodesicLine: any;
 export declare const Math: any;
 export declare const PolygonArea: any;
+export declare const Wasm: {
+  load(source: any): Promise<any>;
+  loaded(): boolean;
+  unload(): void;
+};
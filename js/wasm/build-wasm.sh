@@ -0,0 +1,31 @@
+#! /bin/sh -e
+# Compile the C++ geodesic routines into geographiclib.wasm for use with
+# GeographicLib.Wasm (src/Wasm.js).  This needs emscripten's em++ on the
+# path.  Run in this directory; the output is written to the current
+# directory unless OUT is set.
+#
+# -msimd128 lets the compiler auto-vectorize using WebAssembly's 128-bit
+# SIMD instructions; the kernels themselves are the scalar C++ routines so
+# that the results agree with those of the C++ library.
+
+SRC=../../src
+OUT=${OUT-geographiclib.wasm}
+EMXX=${EMXX-em++}
+
+SOURCES="Accumulator AlbersEqualArea Ellipsoid EllipticFunction Executor
+Geodesic GeodesicExact GeodesicExactC4 GeodesicLine GeodesicLineExact Math
+PolygonArea Rhumb TransverseMercator"
+
+FILES=
+for f in $SOURCES; do
+    FILES="$FILES $SRC/$f.cpp"
+done
+
+EXPORTS=_geod_alloc,_geod_free,_geod_inverse_batch,_geod_direct_batch
+EXPORTS=$EXPORTS,_geod_line_positions,_geod_polygon_area,_malloc,_free
+
+$EMXX -std=c++11 -O3 -msimd128 -I../../include \
+      -DGEOGRAPHICLIB_SHARED_LIB=0 -DGEOGRAPHICLIB_PRECISION=2 \
+      geographiclib-wasm.cpp $FILES \
+      --no-entry -sSTANDALONE_WASM -sALLOW_MEMORY_GROWTH=1 \
+      -sEXPORTED_FUNCTIONS=$EXPORTS -o $OUT
@@ -0,0 +1,90 @@
+/**
+ * \file geographiclib-wasm.cpp
+ * \brief The WebAssembly kernels for the JavaScript package
+ *
+ * This exposes the batch routines of GeographicLib::Geodesic,
+ * GeographicLib::GeodesicLine, and GeographicLib::PolygonArea with a plain C
+ * interface taking pointers into the WebAssembly memory.  It is compiled
+ * with the library sources into geographiclib.wasm by build-wasm.sh; the
+ * JavaScript interface is in src/Wasm.js.  The ellipsoid is specified by \e a
+ * and \e f in each call (constructing a Geodesic object is cheap compared to
+ * solving a batch of problems) so that no C++ objects outlive a call.  Null
+ * output pointers are allowed for quantities which are not needed.
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <cstdlib>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/PolygonArea.hpp>
+
+#if defined(__EMSCRIPTEN__)
+#  include <emscripten/emscripten.h>
+#  define GEOD_WASM_EXPORT extern "C" EMSCRIPTEN_KEEPALIVE
+#else
+#  define GEOD_WASM_EXPORT extern "C"
+#endif
+
+using namespace GeographicLib;
+
+// Memory management for the JavaScript side
+GEOD_WASM_EXPORT double* geod_alloc(size_t n) {
+  return static_cast<double*>(std::malloc(n * sizeof(double)));
+}
+
+GEOD_WASM_EXPORT void geod_free(double* p) { std::free(p); }
+
+GEOD_WASM_EXPORT
+void geod_inverse_batch(double a, double f, size_t n,
+                        const double* lat1, const double* lon1,
+                        const double* lat2, const double* lon2,
+                        unsigned outmask,
+                        double* s12, double* azi1, double* azi2,
+                        double* m12, double* M12, double* M21, double* S12,
+                        double* a12) {
+  const Geodesic g(a, f);
+  g.InverseBatch(n, lat1, lon1, lat2, lon2, outmask,
+                 s12, azi1, azi2, m12, M12, M21, S12, a12);
+}
+
+GEOD_WASM_EXPORT
+void geod_direct_batch(double a, double f, size_t n,
+                       const double* lat1, const double* lon1,
+                       const double* azi1, const double* s12,
+                       unsigned outmask,
+                       double* lat2, double* lon2, double* azi2,
+                       double* m12, double* M12, double* M21, double* S12,
+                       double* a12) {
+  const Geodesic g(a, f);
+  g.DirectBatch(n, lat1, lon1, azi1, s12, outmask,
+                lat2, lon2, azi2, m12, M12, M21, S12, a12);
+}
+
+GEOD_WASM_EXPORT
+void geod_line_positions(double a, double f,
+                         double lat1, double lon1, double azi1, unsigned caps,
+                         int arcmode, size_t n, const double* s12_a12,
+                         unsigned outmask,
+                         double* lat2, double* lon2, double* azi2,
+                         double* s12, double* m12, double* M12, double* M21,
+                         double* S12, double* a12) {
+  const Geodesic g(a, f);
+  const GeodesicLine l(g, lat1, lon1, azi1, caps);
+  l.GenPositions(arcmode != 0, n, s12_a12, outmask,
+                 lat2, lon2, azi2, s12, m12, M12, M21, S12, a12);
+}
+
+// Set res[0] = number of points, res[1] = perimeter, res[2] = area (not set
+// for a polyline).
+GEOD_WASM_EXPORT
+void geod_polygon_area(double a, double f, int polyline,
+                       int reverse, int sign, size_t n,
+                       const double* lat, const double* lon, double* res) {
+  const Geodesic g(a, f);
+  PolygonArea p(g, polyline != 0);
+  p.AddPoints(n, lat, lon);
+  res[0] = p.Compute(reverse != 0, sign != 0, res[1], res[2]);
+}
@@ -49,39 +49,74 @@
 typedef double real;
 typedef int boolx;
 
-static unsigned init = 0;
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 static const int FALSE = 0;
 static const int TRUE = 1;
 static unsigned digits, maxit1, maxit2;
 static real epsilon, realmin, pi, degree, NaN,
   tiny, tol0, tol1, tol2, tolb, xthresh;
 
+/* The state of the static constants: 0 = not set, 1 = being set by Init, 2 =
+ * set.  This is accessed atomically (if the compiler provides the means) so
+ * that geod_init can be called concurrently from several threads. */
+static long init = 0;
+
+#if defined(__ATOMIC_ACQUIRE)
+static long InitState(void)
+{ return __atomic_load_n(&init, __ATOMIC_ACQUIRE); }
+static boolx InitClaim(void) {
+  long expected = 0;
+  return __atomic_compare_exchange_n(&init, &expected, 1L, 0,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+static void InitDone(void) { __atomic_store_n(&init, 2L, __ATOMIC_RELEASE); }
+#elif defined(_MSC_VER)
+static long InitState(void)
+{ return _InterlockedCompareExchange((volatile long*)&init, 0, 0); }
+static boolx InitClaim(void)
+{ return _InterlockedCompareExchange((volatile long*)&init, 1, 0) == 0; }
+static void InitDone(void) { _InterlockedExchange((volatile long*)&init, 2); }
+#else
+/* No atomic operations are available; call geod_init once before starting
+ * any threads. */
+static long InitState(void) { return init; }
+static boolx InitClaim(void) { init = 1; return TRUE; }
+static void InitDone(void) { init = 2; }
+#endif
+
 static void Init(void) {
-  if (!init) {
-    digits = DBL_MANT_DIG;
-    epsilon = DBL_EPSILON;
-    realmin = DBL_MIN;
+  if (InitState() == 2) return;
+  if (!InitClaim()) {
+    /* Another thread is setting the constants; wait for it to finish. */
+    while (InitState() != 2) {}
+    return;
+  }
+  digits = DBL_MANT_DIG;
+  epsilon = DBL_EPSILON;
+  realmin = DBL_MIN;
 #if defined(M_PI)
-    pi = M_PI;
+  pi = M_PI;
 #else
-    pi = atan2(0.0, -1.0);
+  pi = atan2(0.0, -1.0);
 #endif
-    maxit1 = 20;
-    maxit2 = maxit1 + digits + 10;
-    tiny = sqrt(realmin);
-    tol0 = epsilon;
-    /* Increase multiplier in defn of tol1 from 100 to 200 to fix inverse case
-     * 52.784459512564 0 -52.784459512563990912 179.634407464943777557
-     * which otherwise failed for Visual Studio 10 (Release and Debug) */
-    tol1 = 200 * tol0;
-    tol2 = sqrt(tol0);
-    /* Check on bisection interval */
-    tolb = tol0 * tol2;
-    xthresh = 1000 * tol2;
-    degree = pi/180;
-    NaN = nan("0");
-    init = 1;
-  }
+  maxit1 = 20;
+  maxit2 = maxit1 + digits + 10;
+  tiny = sqrt(realmin);
+  tol0 = epsilon;
+  /* Increase multiplier in defn of tol1 from 100 to 200 to fix inverse case
+   * 52.784459512564 0 -52.784459512563990912 179.634407464943777557
+   * which otherwise failed for Visual Studio 10 (Release and Debug) */
+  tol1 = 200 * tol0;
+  tol2 = sqrt(tol0);
+  /* Check on bisection interval */
+  tolb = tol0 * tol2;
+  xthresh = 1000 * tol2;
+  degree = pi/180;
+  NaN = nan("0");
+  InitDone();
 }
 
 enum captype {
@@ -278,7 +313,7 @@ static real areareduceB(real area, real area0,
                         int crossings, boolx reverse, boolx sign);
 
 void geod_init(struct geod_geodesic* g, real a, real f) {
-  if (!init) Init();
+  Init();
   g->a = a;
   g->f = f;
   g->f1 = 1 - g->f;
@@ -1062,6 +1097,44 @@ void geod_inverse(const struct geod_geodesic* g,
                   nullptr, nullptr, nullptr, nullptr);
 }
 
+void geod_direct_batch(const struct geod_geodesic* g, size_t n,
+                       const real lat1[], const real lon1[],
+                       const real azi1[], const real s12[],
+                       real lat2[], real lon2[], real azi2[]) {
+  struct geod_geodesicline l;
+  unsigned caps =
+    (lat2 ? GEOD_LATITUDE : GEOD_NONE) |
+    (lon2 ? GEOD_LONGITUDE : GEOD_NONE) |
+    (azi2 ? GEOD_AZIMUTH : GEOD_NONE) | GEOD_DISTANCE_IN;
+  size_t i;
+  /* Reuse a single geod_geodesicline; this is what geod_direct does for each
+   * problem apart from the computation of the mask. */
+  for (i = 0; i < n; ++i) {
+    geod_lineinit(&l, g, lat1[i], lon1[i], azi1[i], caps);
+    geod_genposition(&l, GEOD_NOFLAGS, s12[i],
+                     lat2 ? lat2 + i : nullptr,
+                     lon2 ? lon2 + i : nullptr,
+                     azi2 ? azi2 + i : nullptr,
+                     nullptr, nullptr, nullptr, nullptr, nullptr);
+  }
+}
+
+void geod_inverse_batch(const struct geod_geodesic* g, size_t n,
+                        const real lat1[], const real lon1[],
+                        const real lat2[], const real lon2[],
+                        real s12[], real azi1[], real azi2[]) {
+  real salp1, calp1, salp2, calp2;
+  size_t i;
+  for (i = 0; i < n; ++i) {
+    geod_geninverse_int(g, lat1[i], lon1[i], lat2[i], lon2[i],
+                        s12 ? s12 + i : nullptr,
+                        &salp1, &calp1, &salp2, &calp2,
+                        nullptr, nullptr, nullptr, nullptr);
+    if (azi1) azi1[i] = atan2dx(salp1, calp1);
+    if (azi2) azi2[i] = atan2dx(salp2, calp2);
+  }
+}
+
 real SinCosSeries(boolx sinp, real sinx, real cosx, const real c[], int n) {
   /* Evaluate
    * y = sinp ? sum(c[i] * sin( 2*i    * x), i, 1, n) :
@@ -1793,6 +1866,7 @@ void geod_polygon_init(struct geod_polygon* p, boolx polylinep) {
 }
 
 void geod_polygon_clear(struct geod_polygon* p) {
+  Init();                     /* in case geod_init hasn't been called */
   p->lat0 = p->lon0 = p->lat = p->lon = NaN;
   accini(p->P);
   accini(p->A);
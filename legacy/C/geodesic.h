@@ -171,6 +171,8 @@
 #include "proj_symbol_rename.h"
 #endif
 
+#include <stddef.h>
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -237,6 +239,14 @@ extern "C" {
    * @param[out] g a pointer to the object to be initialized.
    * @param[in] a the equatorial radius (meters).
    * @param[in] f the flattening.
+   *
+   * The first call of geod_init() (or geod_polygon_init()) sets some static
+   * constants used by the library.  This is done exactly once even if
+   * several threads call these functions concurrently; thereafter all the
+   * functions may be called from several threads provided that the objects
+   * being modified are not shared between threads.  (With a compiler which
+   * provides neither the GCC atomic builtins nor the Visual Studio interlocked
+   * intrinsics, call geod_init() once before starting any threads.)
    **********************************************************************/
   void GEOD_DLL geod_init(struct geod_geodesic* g, double a, double f);
 
@@ -403,6 +413,62 @@ extern "C" {
                                   double* pm12, double* pM12, double* pM21,
                                   double* pS12);
 
+  /**
+   * Solve many direct geodesic problems given as parallel arrays.
+   *
+   * @param[in] g a pointer to the geod_geodesic object specifying the
+   *   ellipsoid.
+   * @param[in] n the number of problems to solve.
+   * @param[in] lat1 array of latitudes of point 1 (degrees).
+   * @param[in] lon1 array of longitudes of point 1 (degrees).
+   * @param[in] azi1 array of azimuths at point 1 (degrees).
+   * @param[in] s12 array of distances from point 1 to point 2 (meters).
+   * @param[out] lat2 array of latitudes of point 2 (degrees).
+   * @param[out] lon2 array of longitudes of point 2 (degrees).
+   * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+   *
+   * Element \e i of the output arrays is set as though by geod_direct()
+   * applied to element \e i of the input arrays, and the results are
+   * identical.  All the arrays have length \e n.  Any of the output arrays
+   * may be replaced by 0, if you do not need some quantities computed.  An
+   * output array may not alias an input array.  This is the C counterpart of
+   * GeographicLib::Geodesic::DirectBatch; to use several threads, divide the
+   * arrays into blocks and call geod_direct_batch() for each block.
+   **********************************************************************/
+  void GEOD_DLL geod_direct_batch(const struct geod_geodesic* g, size_t n,
+                                  const double lat1[], const double lon1[],
+                                  const double azi1[], const double s12[],
+                                  double lat2[], double lon2[],
+                                  double azi2[]);
+
+  /**
+   * Solve many inverse geodesic problems given as parallel arrays.
+   *
+   * @param[in] g a pointer to the geod_geodesic object specifying the
+   *   ellipsoid.
+   * @param[in] n the number of problems to solve.
+   * @param[in] lat1 array of latitudes of point 1 (degrees).
+   * @param[in] lon1 array of longitudes of point 1 (degrees).
+   * @param[in] lat2 array of latitudes of point 2 (degrees).
+   * @param[in] lon2 array of longitudes of point 2 (degrees).
+   * @param[out] s12 array of distances from point 1 to point 2 (meters).
+   * @param[out] azi1 array of azimuths at point 1 (degrees).
+   * @param[out] azi2 array of (forward) azimuths at point 2 (degrees).
+   *
+   * Element \e i of the output arrays is set as though by geod_inverse()
+   * applied to element \e i of the input arrays, and the results are
+   * identical.  All the arrays have length \e n.  Any of the output arrays
+   * may be replaced by 0, if you do not need some quantities computed.  An
+   * output array may not alias an input array.  This is the C counterpart of
+   * GeographicLib::Geodesic::InverseBatch; to use several threads, divide
+   * the arrays into blocks and call geod_inverse_batch() for each block.
+   **********************************************************************/
+  void GEOD_DLL geod_inverse_batch(const struct geod_geodesic* g, size_t n,
+                                   const double lat1[], const double lon1[],
+                                   const double lat2[], const double lon2[],
+                                   double s12[], double azi1[],
+                                   double azi2[]);
+
   /**
    * Initialize a geod_geodesicline object.
    *
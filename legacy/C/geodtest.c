@@ -175,6 +175,40 @@ static int testdirect() {
   return result;
 }
 
+static int testbatch() {
+  double lat1[20], lon1[20], azi1[20], lat2[20], lon2[20], azi2[20], s12[20];
+  double lat2a[20], lon2a[20], azi2a[20], azi1a[20], s12a[20];
+  double x, y, z;
+  struct geod_geodesic g;
+  int i, result = 0;
+  geod_init(&g, wgs84_a, wgs84_f);
+  for (i = 0; i < ncases; ++i) {
+    lat1[i] = testcases[i][0]; lon1[i] = testcases[i][1];
+    azi1[i] = testcases[i][2];
+    lat2[i] = testcases[i][3]; lon2[i] = testcases[i][4];
+    s12[i] = testcases[i][6];
+  }
+  /* The batch routines give the same results as the scalar ones */
+  geod_direct_batch(&g, ncases, lat1, lon1, azi1, s12, lat2a, lon2a, azi2a);
+  geod_inverse_batch(&g, ncases, lat1, lon1, lat2, lon2, s12a, azi1a, azi2);
+  for (i = 0; i < ncases; ++i) {
+    geod_direct(&g, lat1[i], lon1[i], azi1[i], s12[i], &x, &y, &z);
+    result += checkEquals(lat2a[i], x, 0);
+    result += checkEquals(lon2a[i], y, 0);
+    result += checkEquals(azi2a[i], z, 0);
+    geod_inverse(&g, lat1[i], lon1[i], lat2[i], lon2[i], &x, &y, &z);
+    result += checkEquals(s12a[i], x, 0);
+    result += checkEquals(azi1a[i], y, 0);
+    result += checkEquals(azi2[i], z, 0);
+  }
+  /* Output arrays may be omitted */
+  geod_inverse_batch(&g, ncases, lat1, lon1, lat2, lon2,
+                     nullptr, nullptr, s12a);
+  for (i = 0; i < ncases; ++i)
+    result += checkEquals(s12a[i], azi2[i], 0);
+  return result;
+}
+
 static int testarcdirect() {
   double lat1, lon1, azi1, lat2, lon2, azi2, s12, a12, m12, M12, M21, S12;
   double lat2a, lon2a, azi2a, s12a, m12a, M12a, M21a, S12a;
@@ -1085,6 +1119,7 @@ int main() {
   if ((i = testinverse())) {++n; printf("testinverse fail: %d\n", i);}
   if ((i = testdirect())) {++n; printf("testdirect fail: %d\n", i);}
   if ((i = testarcdirect())) {++n; printf("testarcdirect fail: %d\n", i);}
+  if ((i = testbatch())) {++n; printf("testbatch fail: %d\n", i);}
   if ((i = GeodSolve0())) {++n; printf("GeodSolve0 fail: %d\n", i);}
   if ((i = GeodSolve1())) {++n; printf("GeodSolve1 fail: %d\n", i);}
   if ((i = GeodSolve2())) {++n; printf("GeodSolve2 fail: %d\n", i);}
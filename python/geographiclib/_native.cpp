@@ -0,0 +1,278 @@
+/**
+ * \file _native.cpp
+ * \brief The optional compiled backend for the geographiclib python package
+ *
+ * This defines the extension module geographiclib._native which exposes
+ * GeographicLib::Geodesic::InverseBatch, GeographicLib::Geodesic::DirectBatch,
+ * and GeographicLib::PolygonArea::AddPoints to python.  It is used by
+ * Geodesic.InverseBatch, Geodesic.DirectBatch, and Geodesic.PolygonAreaBatch
+ * in geodesic.py; these fall back to the pure python code if this module
+ * isn't available.  The arrays are passed with the buffer protocol (e.g.,
+ * numpy arrays or array.array('d') objects) and are accessed in place.  The
+ * global interpreter lock is released while the geodesics are computed.
+ *
+ * This module needs to be compiled with GEOGRAPHICLIB_PRECISION = 2 (the
+ * default) and linked with the C++ library; see setup.py.
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <string>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/PolygonArea.hpp>
+#include <GeographicLib/Executor.hpp>
+
+#if GEOGRAPHICLIB_PRECISION != 2
+#error "The python extension requires GEOGRAPHICLIB_PRECISION = 2"
+#endif
+
+namespace {
+
+  using namespace GeographicLib;
+
+  // The number of problems handed to a thread at a time
+  const size_t block_ = 4096;
+
+  // A one-dimensional contiguous array of doubles obtained with the buffer
+  // protocol; the buffer is released by the destructor.  An array
+  // corresponding to None has data() == nullptr.
+  class Array {
+  private:
+    Py_buffer _view;
+    bool _held;
+    Array(const Array&) = delete;
+    Array& operator=(const Array&) = delete;
+  public:
+    Array() : _held(false) {}
+    ~Array() { if (_held) PyBuffer_Release(&_view); }
+    // Return false (with a python exception set) on failure.
+    bool Get(PyObject* obj, const char* name, bool writable, size_t n,
+             bool optional) {
+      if (obj == Py_None && optional) return true;
+      if (PyObject_GetBuffer(obj, &_view,
+                             PyBUF_C_CONTIGUOUS | PyBUF_FORMAT |
+                             (writable ? PyBUF_WRITABLE : 0)) < 0)
+        return false;
+      _held = true;
+      if (_view.ndim != 1 || _view.itemsize != sizeof(double) ||
+          !_view.format || std::strcmp(_view.format, "d") != 0) {
+        PyErr_Format(PyExc_TypeError,
+                     "%s must be a 1-dimensional array of doubles", name);
+        return false;
+      }
+      if (size_t(_view.shape[0]) != n) {
+        PyErr_Format(PyExc_ValueError, "%s must have length %zu", name, n);
+        return false;
+      }
+      return true;
+    }
+    double* data() const
+    { return _held ? static_cast<double*>(_view.buf) : nullptr; }
+    // The address of element i, or nullptr if the array is None.
+    double* at(size_t i) const { return _held ? data() + i : nullptr; }
+  };
+
+  // Get the length of the first input array.
+  bool Length(PyObject* obj, const char* name, size_t& n) {
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj, &view, PyBUF_ND) < 0) return false;
+    bool ok = view.ndim == 1;
+    if (ok)
+      n = size_t(view.shape[0]);
+    else
+      PyErr_Format(PyExc_TypeError, "%s must be a 1-dimensional array", name);
+    PyBuffer_Release(&view);
+    return ok;
+  }
+
+  // Run f(i0, k) over the blocks of [0, n) on threads threads with the GIL
+  // released; return false (with a python exception set) if an exception is
+  // thrown.
+  template<typename F>
+  bool RunBlocks(size_t n, unsigned threads, const F& f) {
+    const char* msg = nullptr;
+    std::string what;
+    Py_BEGIN_ALLOW_THREADS
+    try {
+      Executor::Parallel((n + block_ - 1) / block_, threads,
+                         [&](size_t b) -> void {
+                           size_t i0 = b * block_;
+                           f(i0, std::min(block_, n - i0));
+                         });
+    }
+    catch (const std::exception& e) {
+      what = e.what(); msg = what.c_str();
+    }
+    Py_END_ALLOW_THREADS
+    if (msg) {
+      PyErr_SetString(PyExc_RuntimeError, msg);
+      return false;
+    }
+    return true;
+  }
+
+  PyObject* inverse(PyObject*, PyObject* args) {
+    double a, f;
+    unsigned outmask, threads;
+    PyObject *olat1, *olon1, *olat2, *olon2,
+      *os12, *oazi1, *oazi2, *om12, *oM12, *oM21, *oS12, *oa12;
+    if (!PyArg_ParseTuple(args, "ddIIOOOOOOOOOOOO:inverse",
+                          &a, &f, &outmask, &threads,
+                          &olat1, &olon1, &olat2, &olon2,
+                          &os12, &oazi1, &oazi2,
+                          &om12, &oM12, &oM21, &oS12, &oa12))
+      return nullptr;
+    size_t n;
+    if (!Length(olat1, "lat1", n)) return nullptr;
+    Array lat1, lon1, lat2, lon2, s12, azi1, azi2, m12, M12, M21, S12, a12;
+    if (!(lat1.Get(olat1, "lat1", false, n, false) &&
+          lon1.Get(olon1, "lon1", false, n, false) &&
+          lat2.Get(olat2, "lat2", false, n, false) &&
+          lon2.Get(olon2, "lon2", false, n, false) &&
+          s12.Get(os12, "s12", true, n, true) &&
+          azi1.Get(oazi1, "azi1", true, n, true) &&
+          azi2.Get(oazi2, "azi2", true, n, true) &&
+          m12.Get(om12, "m12", true, n, true) &&
+          M12.Get(oM12, "M12", true, n, true) &&
+          M21.Get(oM21, "M21", true, n, true) &&
+          S12.Get(oS12, "S12", true, n, true) &&
+          a12.Get(oa12, "a12", true, n, true)))
+      return nullptr;
+    try {
+      const Geodesic g(a, f);
+      if (!RunBlocks(n, threads, [&](size_t i, size_t k) -> void {
+            g.InverseBatch(k, lat1.at(i), lon1.at(i), lat2.at(i), lon2.at(i),
+                           outmask,
+                           s12.at(i), azi1.at(i), azi2.at(i),
+                           m12.at(i), M12.at(i), M21.at(i), S12.at(i),
+                           a12.at(i));
+          }))
+        return nullptr;
+    }
+    catch (const std::exception& e) {
+      PyErr_SetString(PyExc_ValueError, e.what());
+      return nullptr;
+    }
+    Py_RETURN_NONE;
+  }
+
+  PyObject* direct(PyObject*, PyObject* args) {
+    double a, f;
+    unsigned outmask, threads;
+    PyObject *olat1, *olon1, *oazi1, *os12,
+      *olat2, *olon2, *oazi2, *om12, *oM12, *oM21, *oS12, *oa12;
+    if (!PyArg_ParseTuple(args, "ddIIOOOOOOOOOOOO:direct",
+                          &a, &f, &outmask, &threads,
+                          &olat1, &olon1, &oazi1, &os12,
+                          &olat2, &olon2, &oazi2,
+                          &om12, &oM12, &oM21, &oS12, &oa12))
+      return nullptr;
+    size_t n;
+    if (!Length(olat1, "lat1", n)) return nullptr;
+    Array lat1, lon1, azi1, s12, lat2, lon2, azi2, m12, M12, M21, S12, a12;
+    if (!(lat1.Get(olat1, "lat1", false, n, false) &&
+          lon1.Get(olon1, "lon1", false, n, false) &&
+          azi1.Get(oazi1, "azi1", false, n, false) &&
+          s12.Get(os12, "s12", false, n, false) &&
+          lat2.Get(olat2, "lat2", true, n, true) &&
+          lon2.Get(olon2, "lon2", true, n, true) &&
+          azi2.Get(oazi2, "azi2", true, n, true) &&
+          m12.Get(om12, "m12", true, n, true) &&
+          M12.Get(oM12, "M12", true, n, true) &&
+          M21.Get(oM21, "M21", true, n, true) &&
+          S12.Get(oS12, "S12", true, n, true) &&
+          a12.Get(oa12, "a12", true, n, true)))
+      return nullptr;
+    try {
+      const Geodesic g(a, f);
+      if (!RunBlocks(n, threads, [&](size_t i, size_t k) -> void {
+            g.DirectBatch(k, lat1.at(i), lon1.at(i), azi1.at(i), s12.at(i),
+                          outmask,
+                          lat2.at(i), lon2.at(i), azi2.at(i),
+                          m12.at(i), M12.at(i), M21.at(i), S12.at(i),
+                          a12.at(i));
+          }))
+        return nullptr;
+    }
+    catch (const std::exception& e) {
+      PyErr_SetString(PyExc_ValueError, e.what());
+      return nullptr;
+    }
+    Py_RETURN_NONE;
+  }
+
+  PyObject* polygonarea(PyObject*, PyObject* args) {
+    double a, f;
+    int polyline, reverse, sign;
+    unsigned threads;
+    PyObject *olat, *olon;
+    if (!PyArg_ParseTuple(args, "ddpppIOO:polygonarea",
+                          &a, &f, &polyline, &reverse, &sign, &threads,
+                          &olat, &olon))
+      return nullptr;
+    size_t n;
+    if (!Length(olat, "lats", n)) return nullptr;
+    Array lat, lon;
+    if (!(lat.Get(olat, "lats", false, n, false) &&
+          lon.Get(olon, "lons", false, n, false)))
+      return nullptr;
+    unsigned num = 0;
+    double perimeter = 0, area = 0;
+    const char* msg = nullptr;
+    std::string what;
+    Py_BEGIN_ALLOW_THREADS
+    try {
+      const Geodesic g(a, f);
+      PolygonArea p(g, polyline != 0);
+      p.AddPoints(n, lat.data(), lon.data(), threads);
+      num = p.Compute(reverse != 0, sign != 0, perimeter, area);
+    }
+    catch (const std::exception& e) {
+      what = e.what(); msg = what.c_str();
+    }
+    Py_END_ALLOW_THREADS
+    if (msg) {
+      PyErr_SetString(PyExc_ValueError, msg);
+      return nullptr;
+    }
+    // As in polygonarea.py, the area of a polyline is nan
+    if (polyline) area = std::numeric_limits<double>::quiet_NaN();
+    return Py_BuildValue("(Idd)", num, perimeter, area);
+  }
+
+  PyMethodDef methods_[] = {
+    {"inverse", inverse, METH_VARARGS,
+     "inverse(a, f, outmask, threads, lat1, lon1, lat2, lon2, "
+     "s12, azi1, azi2, m12, M12, M21, S12, a12)\n\n"
+     "Solve inverse problems with Geodesic::InverseBatch, writing the "
+     "results into the output arrays (which may be None)."},
+    {"direct", direct, METH_VARARGS,
+     "direct(a, f, outmask, threads, lat1, lon1, azi1, s12, "
+     "lat2, lon2, azi2, m12, M12, M21, S12, a12)\n\n"
+     "Solve direct problems with Geodesic::DirectBatch, writing the "
+     "results into the output arrays (which may be None)."},
+    {"polygonarea", polygonarea, METH_VARARGS,
+     "polygonarea(a, f, polyline, reverse, sign, threads, lats, lons)\n\n"
+     "Return (num, perimeter, area) for a polygon with PolygonArea."},
+    {nullptr, nullptr, 0, nullptr}
+  };
+
+  PyModuleDef module_ = {
+    PyModuleDef_HEAD_INIT, "geographiclib._native",
+    "Compiled backend for geographiclib using the C++ library", -1,
+    methods_, nullptr, nullptr, nullptr, nullptr
+  };
+
+} // namespace
+
+PyMODINIT_FUNC PyInit__native(void) {
+  return PyModule_Create(&module_);
+}
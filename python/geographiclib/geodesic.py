@@ -23,6 +23,16 @@ with
 
   * :meth:`~geographiclib.geodesic.Geodesic.Polygon`
 
+Many problems given as arrays are solved by
+
+  * :meth:`~geographiclib.geodesic.Geodesic.InverseBatch`
+  * :meth:`~geographiclib.geodesic.Geodesic.DirectBatch`
+  * :meth:`~geographiclib.geodesic.Geodesic.PolygonAreaBatch`
+
+These use the compiled extension module geographiclib._native (backed by
+the C++ library) if it was built (see setup.py); otherwise they fall back
+to the pure python code.
+
 The public attributes for this class are
 
   * :attr:`~geographiclib.geodesic.Geodesic.a`
@@ -78,9 +88,32 @@ The public attributes for this class are
 ######################################################################
 
 import math
+import array
 from geographiclib.geomath import Math
 from geographiclib.constants import Constants
 from geographiclib.geodesiccapability import GeodesicCapability
+try:
+  from geographiclib import _native
+except ImportError:
+  _native = None
+
+def _double_array(x):
+  """Private: return x as a buffer of doubles, without copying if possible"""
+  try:
+    view = memoryview(x)
+    if view.format == 'd' and view.ndim == 1 and view.c_contiguous:
+      return x
+  except TypeError:
+    pass
+  return array.array('d', x)
+
+def _new_array(n):
+  """Private: return a new array of n doubles (numpy if available)"""
+  try:
+    import numpy
+    return numpy.empty(n)
+  except ImportError:
+    return array.array('d', [0.0]) * n
 
 class Geodesic(object):
   """Solve geodesic problems"""
@@ -1262,6 +1295,152 @@ class Geodesic(object):
     from geographiclib.polygonarea import PolygonArea
     return PolygonArea(self, polyline)
 
+  def InverseBatch(self, lat1, lon1, lat2, lon2,
+                   outmask = GeodesicCapability.STANDARD, threads = 1):
+    """Solve many inverse geodesic problems
+
+    :param lat1: array of latitudes of the first points in degrees
+    :param lon1: array of longitudes of the first points in degrees
+    :param lat2: array of latitudes of the second points in degrees
+    :param lon2: array of longitudes of the second points in degrees
+    :param outmask: the :ref:`output mask <outmask>`
+    :param threads: the number of threads used by the compiled backend
+      (0 means use all the hardware threads)
+    :return: a :ref:`dict` of arrays
+
+    The inputs are sequences of equal length; numpy arrays or
+    array.array('d') objects of doubles are used without copying.  The
+    dict contains the *a12*, *s12*, *azi1*, *azi2*, *m12*, *M12*,
+    *M21*, *S12* entries selected by *outmask* as returned by
+    :meth:`~geographiclib.geodesic.Geodesic.Inverse`, with each entry
+    an array (a numpy array if numpy is available, otherwise an
+    array.array).  The input coordinates are not echoed.
+
+    """
+
+    lat1 = _double_array(lat1); lon1 = _double_array(lon1)
+    lat2 = _double_array(lat2); lon2 = _double_array(lon2)
+    n = len(lat1)
+    out = outmask & Geodesic.OUT_MASK
+    result = {'a12': _new_array(n)}
+    if out & Geodesic.DISTANCE: result['s12'] = _new_array(n)
+    if out & Geodesic.AZIMUTH:
+      result['azi1'] = _new_array(n); result['azi2'] = _new_array(n)
+    if out & Geodesic.REDUCEDLENGTH: result['m12'] = _new_array(n)
+    if out & Geodesic.GEODESICSCALE:
+      result['M12'] = _new_array(n); result['M21'] = _new_array(n)
+    if out & Geodesic.AREA: result['S12'] = _new_array(n)
+    if _native is not None:
+      _native.inverse(self.a, self.f, outmask, threads,
+                      lat1, lon1, lat2, lon2,
+                      result.get('s12'), result.get('azi1'),
+                      result.get('azi2'), result.get('m12'),
+                      result.get('M12'), result.get('M21'),
+                      result.get('S12'), result['a12'])
+      return result
+    for i in range(n):
+      a12, s12, salp1,calp1, salp2,calp2, m12, M12, M21, S12 = (
+        self._GenInverse(lat1[i], lon1[i], lat2[i], lon2[i], outmask))
+      result['a12'][i] = a12
+      if out & Geodesic.DISTANCE: result['s12'][i] = s12
+      if out & Geodesic.AZIMUTH:
+        result['azi1'][i] = Math.atan2d(salp1, calp1)
+        result['azi2'][i] = Math.atan2d(salp2, calp2)
+      if out & Geodesic.REDUCEDLENGTH: result['m12'][i] = m12
+      if out & Geodesic.GEODESICSCALE:
+        result['M12'][i] = M12; result['M21'][i] = M21
+      if out & Geodesic.AREA: result['S12'][i] = S12
+    return result
+
+  def DirectBatch(self, lat1, lon1, azi1, s12,
+                  outmask = GeodesicCapability.STANDARD, threads = 1):
+    """Solve many direct geodesic problems
+
+    :param lat1: array of latitudes of the first points in degrees
+    :param lon1: array of longitudes of the first points in degrees
+    :param azi1: array of azimuths at the first points in degrees
+    :param s12: array of distances from the first points to the
+      second in meters
+    :param outmask: the :ref:`output mask <outmask>`
+    :param threads: the number of threads used by the compiled backend
+      (0 means use all the hardware threads)
+    :return: a :ref:`dict` of arrays
+
+    This is the analog of
+    :meth:`~geographiclib.geodesic.Geodesic.InverseBatch` for the direct
+    problem.  The dict contains the *a12*, *lat2*, *lon2*, *azi2*,
+    *m12*, *M12*, *M21*, *S12* entries selected by *outmask* as
+    returned by :meth:`~geographiclib.geodesic.Geodesic.Direct`.
+
+    """
+
+    lat1 = _double_array(lat1); lon1 = _double_array(lon1)
+    azi1 = _double_array(azi1); s12 = _double_array(s12)
+    n = len(lat1)
+    out = outmask & Geodesic.OUT_MASK
+    result = {'a12': _new_array(n)}
+    if out & Geodesic.LATITUDE: result['lat2'] = _new_array(n)
+    if out & Geodesic.LONGITUDE: result['lon2'] = _new_array(n)
+    if out & Geodesic.AZIMUTH: result['azi2'] = _new_array(n)
+    if out & Geodesic.REDUCEDLENGTH: result['m12'] = _new_array(n)
+    if out & Geodesic.GEODESICSCALE:
+      result['M12'] = _new_array(n); result['M21'] = _new_array(n)
+    if out & Geodesic.AREA: result['S12'] = _new_array(n)
+    if _native is not None:
+      _native.direct(self.a, self.f, outmask, threads,
+                     lat1, lon1, azi1, s12,
+                     result.get('lat2'), result.get('lon2'),
+                     result.get('azi2'), result.get('m12'),
+                     result.get('M12'), result.get('M21'),
+                     result.get('S12'), result['a12'])
+      return result
+    for i in range(n):
+      a12, lat2, lon2, azi2, _, m12, M12, M21, S12 = self._GenDirect(
+        lat1[i], lon1[i], azi1[i], False, s12[i], outmask)
+      result['a12'][i] = a12
+      if out & Geodesic.LATITUDE: result['lat2'][i] = lat2
+      if out & Geodesic.LONGITUDE: result['lon2'][i] = lon2
+      if out & Geodesic.AZIMUTH: result['azi2'][i] = azi2
+      if out & Geodesic.REDUCEDLENGTH: result['m12'][i] = m12
+      if out & Geodesic.GEODESICSCALE:
+        result['M12'][i] = M12; result['M21'][i] = M21
+      if out & Geodesic.AREA: result['S12'][i] = S12
+    return result
+
+  def PolygonAreaBatch(self, lats, lons, polyline = False,
+                       reverse = False, sign = True, threads = 1):
+    """Compute the perimeter and area of a polygon
+
+    :param lats: array of latitudes of the vertices in degrees
+    :param lons: array of longitudes of the vertices in degrees
+    :param polyline: if True then the vertices describe a polyline
+      instead of a polygon
+    :param reverse: if true then clockwise (instead of
+      counter-clockwise) traversal counts as a positive area
+    :param sign: if true then return a signed result for the area if the
+      polygon is traversed in the "wrong" direction instead of returning
+      the area for the rest of the earth
+    :param threads: the number of threads used by the compiled backend
+      (0 means use all the hardware threads)
+    :return: a tuple of number, perimeter (meters), area (meters^2)
+
+    This gives the same result as adding the vertices in turn to
+    :meth:`~geographiclib.geodesic.Geodesic.Polygon` and calling
+    :meth:`~geographiclib.polygonarea.PolygonArea.Compute`.
+
+    """
+
+    lats = _double_array(lats); lons = _double_array(lons)
+    if len(lons) != len(lats):
+      raise ValueError("lats and lons must have the same length")
+    if _native is not None:
+      return _native.polygonarea(self.a, self.f, polyline, reverse, sign,
+                                 threads, lats, lons)
+    poly = self.Polygon(polyline)
+    for lat, lon in zip(lats, lons):
+      poly.AddPoint(lat, lon)
+    return poly.Compute(reverse, sign)
+
   EMPTY         = GeodesicCapability.EMPTY
   """No capabilities, no output."""
   LATITUDE      = GeodesicCapability.LATITUDE
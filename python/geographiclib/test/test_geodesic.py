@@ -1,5 +1,6 @@
 import unittest
 
+from geographiclib import geodesic
 from geographiclib.geodesic import Geodesic
 from geographiclib.geomath import Math
 
@@ -549,6 +550,55 @@ class GeodSolveTest(unittest.TestCase):
     self.assertAlmostEqual(inv["azi2"], 90.00000106, delta = 1e-7  )
     self.assertAlmostEqual(inv["s12"],   0.264,      delta = 0.5e-3)
 
+class BatchTest(unittest.TestCase):
+
+  def check(self):
+    cases = GeodesicTest.testcases
+    lat1 = [l[0] for l in cases]; lon1 = [l[1] for l in cases]
+    azi1 = [l[2] for l in cases]; lat2 = [l[3] for l in cases]
+    lon2 = [l[4] for l in cases]; s12 = [l[6] for l in cases]
+    inv = Geodesic.WGS84.InverseBatch(lat1, lon1, lat2, lon2,
+                                      Geodesic.ALL | Geodesic.LONG_UNROLL)
+    dir = Geodesic.WGS84.DirectBatch(lat1, lon1, azi1, s12,
+                                     Geodesic.ALL | Geodesic.LONG_UNROLL)
+    for i, l in enumerate(cases):
+      self.assertAlmostEqual(l[2], inv["azi1"][i], delta = 1e-13)
+      self.assertAlmostEqual(l[5], inv["azi2"][i], delta = 1e-13)
+      self.assertAlmostEqual(l[6], inv["s12"][i], delta = 1e-8)
+      self.assertAlmostEqual(l[7], inv["a12"][i], delta = 1e-13)
+      self.assertAlmostEqual(l[8], inv["m12"][i], delta = 1e-8)
+      self.assertAlmostEqual(l[9], inv["M12"][i], delta = 1e-15)
+      self.assertAlmostEqual(l[10], inv["M21"][i], delta = 1e-15)
+      self.assertAlmostEqual(l[11], inv["S12"][i], delta = 0.1)
+      self.assertAlmostEqual(l[3], dir["lat2"][i], delta = 1e-13)
+      self.assertAlmostEqual(l[4], dir["lon2"][i], delta = 1e-13)
+      self.assertAlmostEqual(l[5], dir["azi2"][i], delta = 1e-13)
+      self.assertAlmostEqual(l[7], dir["a12"][i], delta = 1e-13)
+      self.assertAlmostEqual(l[11], dir["S12"][i], delta = 0.1)
+    inv = Geodesic.WGS84.InverseBatch(lat1, lon1, lat2, lon2,
+                                      Geodesic.DISTANCE)
+    self.assertEqual(sorted(inv.keys()), ['a12', 's12'])
+    num, perimeter, area = Geodesic.WGS84.PolygonAreaBatch(
+      [89, 89, 89, 89], [0, 90, 180, 270])
+    self.assertEqual(num, 4)
+    self.assertAlmostEqual(perimeter, 631819.8745, delta = 1e-4)
+    self.assertAlmostEqual(area, 24952305678.0, delta = 1)
+    num, perimeter, area = Geodesic.WGS84.PolygonAreaBatch(
+      [89, 89, 89, 89], [0, 90, 180, 270], polyline = True)
+    self.assertTrue(Math.isnan(area))
+
+  def test_batch(self):
+    self.check()
+
+  def test_batch_python(self):
+    # The pure python fallback gives the same results
+    native = geodesic._native
+    geodesic._native = None
+    try:
+      self.check()
+    finally:
+      geodesic._native = native
+
 class PlanimeterTest(unittest.TestCase):
 
   polygon = Geodesic.WGS84.Polygon(False)
@@ -18,7 +18,17 @@
 #
 # The initial version of this file was provided by
 # Andrew MacIntyre <Andrew.MacIntyre@acma.gov.au>.
+#
+# The optional compiled backend, geographiclib._native, is built if the
+# environment variable GEOGRAPHICLIB_PREFIX is set to the installation
+# prefix of the C++ library (with the headers in $GEOGRAPHICLIB_PREFIX/include
+# and the library in $GEOGRAPHICLIB_PREFIX/lib), e.g.,
+#
+#   GEOGRAPHICLIB_PREFIX=/usr/local python setup.py install
+#
+# If the extension can't be built, the pure python package is installed.
 
+import os
 import setuptools
 
 name = "geographiclib"
@@ -27,6 +37,22 @@ version = "1.52"
 with open("README.md", "r") as fh:
     long_description = fh.read()
 
+ext_modules = []
+prefix = os.environ.get("GEOGRAPHICLIB_PREFIX")
+if prefix:
+  ext_modules.append(setuptools.Extension(
+    "geographiclib._native",
+    sources = ["geographiclib/_native.cpp"],
+    include_dirs = [os.path.join(prefix, "include")],
+    library_dirs = [os.path.join(prefix, "lib")],
+    runtime_library_dirs = ([] if os.name == "nt" else
+                            [os.path.join(prefix, "lib")]),
+    libraries = ["Geographic"],
+    extra_compile_args = ([] if os.name == "nt" else ["-std=c++11"]),
+    language = "c++",
+    optional = True,
+  ))
+
 setuptools.setup(
   name = name,
   version = version,
@@ -38,6 +64,7 @@ setuptools.setup(
   url = "https://geographiclib.sourceforge.io/" + version + "/python",
   include_package_data = True,
   packages = setuptools.find_packages(),
+  ext_modules = ext_modules,
   license = "MIT",
   keywords = "gis geographical earth distance geodesic",
   classifiers = [
@@ -485,10 +485,15 @@ namespace GeographicLib {
 
   void AlbersEqualArea::Forward(real lon0, real lat, real lon,
                                 real& x, real& y, real& gamma, real& k) const {
-    lon = Math::AngDiff(lon0, lon);
     lat *= _sign;
     real sphi, cphi;
     Math::sincosd(Math::LatFix(lat) * _sign, sphi, cphi);
+    IntForward(Math::AngDiff(lon0, lon), sphi, cphi, x, y, gamma, k);
+  }
+
+  void AlbersEqualArea::IntForward(real lon, real sphi, real cphi,
+                                   real& x, real& y,
+                                   real& gamma, real& k) const {
     cphi = max(epsx_, cphi);
     real
       lam = lon * Math::degree(),
@@ -511,6 +516,16 @@ namespace GeographicLib {
   void AlbersEqualArea::Reverse(real lon0, real x, real y,
                                 real& lat, real& lon,
                                 real& gamma, real& k) const {
+    real tau, lam;
+    IntReverse(x, y, tau, lam, gamma, k);
+    lat = Math::atand(tau);
+    lon = lam / Math::degree();
+    lon = Math::AngNormalize(lon + Math::AngNormalize(lon0));
+  }
+
+  void AlbersEqualArea::IntReverse(real x, real y,
+                                   real& tau, real& lam,
+                                   real& gamma, real& k) const {
     y *= _sign;
     real
       nx = _k0 * _n0 * x, ny = _k0 * _n0 * y, y1 =  _nrho0 - ny,
@@ -521,15 +536,56 @@ namespace GeographicLib {
               (Math::sq(_a) * _qZ),
       txi = (_txi0 + dsxia) / sqrt(max(1 - dsxia * (2*_txi0 + dsxia), epsx2_)),
       tphi = tphif(txi),
-      theta = atan2(nx, y1),
-      lam = _n0 != 0 ? theta / (_k2 * _n0) : x / (y1 * _k0);
+      theta = atan2(nx, y1);
+    lam = _n0 != 0 ? theta / (_k2 * _n0) : x / (y1 * _k0);
     gamma = _sign * theta / Math::degree();
-    lat = Math::atand(_sign * tphi);
-    lon = lam / Math::degree();
-    lon = Math::AngNormalize(lon + Math::AngNormalize(lon0));
+    tau = _sign * tphi;
     k = _k0 * (den != 0 ? (_nrho0 + _n0 * drho) * hyp(_fm * tphi) / _a : 1);
   }
 
+  void AlbersEqualArea::ForwardBatch(size_t n, real lon0,
+                                     const real lat[], const real lon[],
+                                     real x[], real y[],
+                                     real gamma[], real k[]) const {
+    real a[projblock_], s[projblock_], c[projblock_];
+    for (size_t i0 = 0; i0 < n; i0 += projblock_) {
+      size_t m = n - i0 < projblock_ ? n - i0 : projblock_;
+      for (size_t i = 0; i < m; ++i) {
+        a[i] = Math::LatFix(lat[i0 + i] * _sign) * _sign;
+        c[i] = lon0;
+      }
+      Math::AngDiffBatch(m, c, lon + i0, c);
+      Math::sincosdBatch(m, a, s, a);
+      for (size_t i = 0; i < m; ++i) {
+        real gammai, ki;
+        IntForward(c[i], s[i], a[i], x[i0 + i], y[i0 + i], gammai, ki);
+        if (gamma) gamma[i0 + i] = gammai;
+        if (k) k[i0 + i] = ki;
+      }
+    }
+  }
+
+  void AlbersEqualArea::ReverseBatch(size_t n, real lon0,
+                                     const real x[], const real y[],
+                                     real lat[], real lon[],
+                                     real gamma[], real k[]) const {
+    real t[projblock_], l[projblock_], c[projblock_];
+    lon0 = Math::AngNormalize(lon0);
+    for (size_t i0 = 0; i0 < n; i0 += projblock_) {
+      size_t m = n - i0 < projblock_ ? n - i0 : projblock_;
+      for (size_t i = 0; i < m; ++i) {
+        real gammai, ki;
+        IntReverse(x[i0 + i], y[i0 + i], t[i], l[i], gammai, ki);
+        if (gamma) gamma[i0 + i] = gammai;
+        if (k) k[i0 + i] = ki;
+        c[i] = 1;
+      }
+      Math::atan2dBatch(m, t, c, lat + i0);
+      for (size_t i = 0; i < m; ++i)
+        lon[i0 + i] = Math::AngNormalize(l[i] / Math::degree() + lon0);
+    }
+  }
+
   void AlbersEqualArea::SetScale(real lat, real k) {
     if (!(isfinite(k) && k > 0))
       throw GeographicErr("Scale is not positive");
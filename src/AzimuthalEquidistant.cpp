@@ -8,6 +8,7 @@
  **********************************************************************/
 
 #include <GeographicLib/AzimuthalEquidistant.hpp>
+#include <GeographicLib/GeodesicOrigin.hpp>
 
 namespace GeographicLib {
 
@@ -38,4 +39,46 @@ namespace GeographicLib {
     rk = !(sig <= eps_) ? m / s : 1;
   }
 
+  void AzimuthalEquidistant::ForwardBatch(size_t n, real lat0, real lon0,
+                                          const real lat[], const real lon[],
+                                          real x[], real y[],
+                                          real azi[], real rk[]) const {
+    GeodesicOrigin origin(_earth, lat0, lon0);
+    real sig[projblock_], s[projblock_], azi0[projblock_], azi2[projblock_],
+      m[projblock_], sx[projblock_], cx[projblock_];
+    for (size_t i0 = 0; i0 < n; i0 += projblock_) {
+      size_t k = n - i0 < projblock_ ? n - i0 : projblock_;
+      origin.InverseBatch(k, lat + i0, lon + i0,
+                          Geodesic::DISTANCE | Geodesic::AZIMUTH |
+                          Geodesic::REDUCEDLENGTH,
+                          s, azi0, azi2, m, nullptr, nullptr, nullptr, sig);
+      Math::sincosdBatch(k, azi0, sx, cx);
+      for (size_t i = 0; i < k; ++i) {
+        x[i0 + i] = sx[i] * s[i]; y[i0 + i] = cx[i] * s[i];
+        if (azi) azi[i0 + i] = azi2[i];
+        if (rk) rk[i0 + i] = !(sig[i] <= eps_) ? m[i] / s[i] : 1;
+      }
+    }
+  }
+
+  void AzimuthalEquidistant::ReverseBatch(size_t n, real lat0, real lon0,
+                                          const real x[], const real y[],
+                                          real lat[], real lon[],
+                                          real azi[], real rk[]) const {
+    real azi0[projblock_], s[projblock_];
+    for (size_t i0 = 0; i0 < n; i0 += projblock_) {
+      size_t k = n - i0 < projblock_ ? n - i0 : projblock_;
+      for (size_t i = 0; i < k; ++i)
+        s[i] = hypot(x[i0 + i], y[i0 + i]);
+      Math::atan2dBatch(k, x + i0, y + i0, azi0);
+      for (size_t i = 0; i < k; ++i) {
+        real sig, azii, m;
+        sig = _earth.Direct(lat0, lon0, azi0[i], s[i],
+                            lat[i0 + i], lon[i0 + i], azii, m);
+        if (azi) azi[i0 + i] = azii;
+        if (rk) rk[i0 + i] = !(sig <= eps_) ? m / s[i] : 1;
+      }
+    }
+  }
+
 } // namespace GeographicLib
@@ -35,7 +35,15 @@ namespace GeographicLib {
                                real& azi, real& rk) const {
     if (!Init())
       return;
-    real dlon = Math::AngDiff(LongitudeOrigin(), lon);
+    real dlon = Math::AngDiff(LongitudeOrigin(), lon), t;
+    real sig01 = IntForward(lat, dlon, x, azi, rk);
+    _meridian.GenPosition(true, sig01,
+                          Geodesic::DISTANCE,
+                          t, t, t, y, t, t, t, t);
+  }
+
+  Math::real CassiniSoldner::IntForward(real lat, real dlon,
+                                        real& x, real& azi, real& rk) const {
     real sig12, s12, azi1, azi2;
     sig12 = _earth.Inverse(lat, -abs(dlon), lat, abs(dlon), s12, azi1, azi2);
     sig12 *= real(0.5);
@@ -71,9 +79,7 @@ namespace GeographicLib {
       sbet01 = sbet1 * _cbet0 - cbet1 * _sbet0,
       cbet01 = cbet1 * _cbet0 + sbet1 * _sbet0,
       sig01 = atan2(sbet01, cbet01) / Math::degree();
-    _meridian.GenPosition(true, sig01,
-                          Geodesic::DISTANCE,
-                          t, t, t, y, t, t, t, t);
+    return sig01;
   }
 
   void CassiniSoldner::Reverse(real x, real y, real& lat, real& lon,
@@ -86,4 +92,52 @@ namespace GeographicLib {
     _earth.Direct(lat1, lon1, azi0 + 90, x, lat, lon, azi, rk, t);
   }
 
+  void CassiniSoldner::ForwardBatch(size_t n,
+                                    const real lat[], const real lon[],
+                                    real x[], real y[],
+                                    real azi[], real rk[]) const {
+    if (!Init())
+      return;
+    real lon0[projblock_], dlon[projblock_], sig01[projblock_];
+    for (size_t i = 0; i < projblock_; ++i)
+      lon0[i] = LongitudeOrigin();
+    for (size_t i0 = 0; i0 < n; i0 += projblock_) {
+      size_t k = n - i0 < projblock_ ? n - i0 : projblock_;
+      Math::AngDiffBatch(k, lon0, lon + i0, dlon);
+      for (size_t i = 0; i < k; ++i) {
+        real azii, rki;
+        sig01[i] = IntForward(lat[i0 + i], dlon[i], x[i0 + i], azii, rki);
+        if (azi) azi[i0 + i] = azii;
+        if (rk) rk[i0 + i] = rki;
+      }
+      _meridian.GenPositions(true, k, sig01, Geodesic::DISTANCE,
+                             nullptr, nullptr, nullptr, y + i0,
+                             nullptr, nullptr, nullptr, nullptr);
+    }
+  }
+
+  void CassiniSoldner::ReverseBatch(size_t n,
+                                    const real x[], const real y[],
+                                    real lat[], real lon[],
+                                    real azi[], real rk[]) const {
+    if (!Init())
+      return;
+    real lat1[projblock_], lon1[projblock_], azi0[projblock_];
+    for (size_t i0 = 0; i0 < n; i0 += projblock_) {
+      size_t k = n - i0 < projblock_ ? n - i0 : projblock_;
+      _meridian.GenPositions(false, k, y + i0,
+                             Geodesic::LATITUDE | Geodesic::LONGITUDE |
+                             Geodesic::AZIMUTH,
+                             lat1, lon1, azi0, nullptr,
+                             nullptr, nullptr, nullptr, nullptr);
+      for (size_t i = 0; i < k; ++i) {
+        real azii, rki, t;
+        _earth.Direct(lat1[i], lon1[i], azi0[i] + 90, x[i0 + i],
+                      lat[i0 + i], lon[i0 + i], azii, rki, t);
+        if (azi) azi[i0 + i] = azii;
+        if (rk) rk[i0 + i] = rki;
+      }
+    }
+  }
+
 } // namespace GeographicLib
@@ -0,0 +1,73 @@
+/**
+ * \file ChordMetric.cpp
+ * \brief Implementation for GeographicLib::ChordMetric class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/ChordMetric.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  void ChordMetric::Attach(const vector<point>& pts) {
+    vector<real> x(pts.size()), y(pts.size()), z(pts.size());
+    for (size_t i = 0; i < pts.size(); ++i) {
+      x[i] = pts[i]._x; y[i] = pts[i]._y; z[i] = pts[i]._z;
+    }
+    _x.swap(x); _y.swap(y); _z.swap(z);
+    _pts = pts.data();
+  }
+
+  void ChordMetric::distances(const real x[], const real y[], const real z[],
+                              int n, real qx, real qy, real qz, real d[]) {
+    // The loops over l have a fixed trip count so that the compiler can
+    // vectorize them.
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+      real s[4];
+      for (int l = 0; l < 4; ++l) {
+        real dx = x[j + l] - qx, dy = y[j + l] - qy, dz = z[j + l] - qz;
+        s[l] = dx * dx + dy * dy + dz * dz;
+      }
+      for (int l = 0; l < 4; ++l)
+        d[j + l] = sqrt(s[l]);
+    }
+    for (; j < n; ++j) {
+      real dx = x[j] - qx, dy = y[j] - qy, dz = z[j] - qz;
+      d[j] = sqrt(dx * dx + dy * dy + dz * dz);
+    }
+  }
+
+  void ChordMetric::Distances(const vector<point>& pts, const int ind[], int n,
+                              const point& query, real d[]) const {
+    bool attached = _pts == pts.data() && _x.size() == pts.size();
+    real x[block], y[block], z[block];
+    for (int j0 = 0; j0 < n; j0 += block) {
+      int m = min(block, n - j0);
+      const int* ix = ind + j0;
+      bool consecutive = attached;
+      for (int l = 1; consecutive && l < m; ++l)
+        consecutive = ix[l] == ix[0] + l;
+      if (consecutive)
+        distances(_x.data() + ix[0], _y.data() + ix[0], _z.data() + ix[0],
+                  m, query._x, query._y, query._z, d + j0);
+      else {
+        // Gather the coordinates
+        for (int l = 0; l < m; ++l) {
+          if (attached) {
+            x[l] = _x[ix[l]]; y[l] = _y[ix[l]]; z[l] = _z[ix[l]];
+          } else {
+            const point& p = pts[ix[l]];
+            x[l] = p._x; y[l] = p._y; z[l] = p._z;
+          }
+        }
+        distances(x, y, z, m, query._x, query._y, query._z, d + j0);
+      }
+    }
+  }
+
+} // namespace GeographicLib
@@ -8,16 +8,59 @@
  **********************************************************************/
 
 #include <GeographicLib/CircularEngine.hpp>
+#include <complex>
+#include <limits>
+#include <vector>
 
 namespace GeographicLib {
 
   using namespace std;
 
+  namespace {
+    typedef Math::real real;
+    typedef complex<real> cplx;
+
+    // The prime factors of n (in increasing order).
+    vector<int> factors(int n) {
+      vector<int> fac;
+      for (int p = 2; p * p <= n; ++p)
+        for (; n % p == 0; n /= p) fac.push_back(p);
+      if (n > 1) fac.push_back(n);
+      return fac;
+    }
+
+    // A mixed radix decimation in time FFT.  Set out[j] = sum(in[k*s] *
+    // w[(j*k*ws) % N], k, 0, n-1) for j in [0, n), where w[k] = exp(2*pi*i*
+    // k/N) and n*ws = N.  fac are the prime factors of n; the cost is
+    // proportional to n times the sum of the factors.
+    void fft(const cplx in[], size_t s, cplx out[], int n,
+             const int fac[], const cplx w[], size_t ws, cplx t[]) {
+      int p = fac[0], m = n / p;
+      if (m == 1)
+        for (int q = 0; q < p; ++q) out[q] = in[q * s];
+      else
+        for (int q = 0; q < p; ++q)
+          fft(in + q * s, s * p, out + q * m, m, fac + 1, w, ws * p, t);
+      // Combine the p transforms of length m; t is scratch space of size p.
+      size_t N = size_t(n) * ws, wp = N / p;
+      for (int k = 0; k < m; ++k) {
+        for (int u = 0; u < p; ++u)
+          t[u] = out[u * m + k] * w[size_t(u) * k * ws];
+        for (int q = 0; q < p; ++q) {
+          cplx x = t[0];
+          for (int u = 1; u < p; ++u)
+            x += t[u] * w[(size_t(u) * q % p) * wp];
+          out[q * m + k] = x;
+        }
+      }
+    }
+  }
+
   Math::real CircularEngine::Value(bool gradp, real sl, real cl,
                                    real& gradx, real& grady, real& gradz) const
   {
     gradp = _gradp && gradp;
-    const vector<real>& root( SphericalEngine::sqrttable() );
+    const real* root = SphericalEngine::sqrttable();
 
     // Initialize outer sum
     real vc  = 0, vc2  = 0, vs  = 0, vs2  = 0;   // v [N + 1], v [N + 2]
@@ -27,6 +70,7 @@ namespace GeographicLib {
     real vtc = 0, vtc2 = 0, vts = 0, vts2 = 0;   // vt[N + 1], vt[N + 2]
     real vlc = 0, vlc2 = 0, vls = 0, vls2 = 0;   // vl[N + 1], vl[N + 2]
     for (int m = _M; m >= 0; --m) {   // m = M .. 0
+      const real* wm = _w.data() + _k * m;
       // Now Sc[m] = wc, Ss[m] = ws
       // Sc'[m] = wtc, Ss'[m] = wtc
       if (m) {
@@ -45,15 +89,15 @@ namespace GeographicLib {
         default:
           A = B = 0;
         }
-        v = A * vc  + B * vc2  +  _wc[m] ; vc2  = vc ; vc  = v;
-        v = A * vs  + B * vs2  +  _ws[m] ; vs2  = vs ; vs  = v;
+        v = A * vc  + B * vc2  +  wm[WC] ; vc2  = vc ; vc  = v;
+        v = A * vs  + B * vs2  +  wm[WS] ; vs2  = vs ; vs  = v;
         if (gradp) {
-          v = A * vrc + B * vrc2 +  _wrc[m]; vrc2 = vrc; vrc = v;
-          v = A * vrs + B * vrs2 +  _wrs[m]; vrs2 = vrs; vrs = v;
-          v = A * vtc + B * vtc2 +  _wtc[m]; vtc2 = vtc; vtc = v;
-          v = A * vts + B * vts2 +  _wts[m]; vts2 = vts; vts = v;
-          v = A * vlc + B * vlc2 + m*_ws[m]; vlc2 = vlc; vlc = v;
-          v = A * vls + B * vls2 - m*_wc[m]; vls2 = vls; vls = v;
+          v = A * vrc + B * vrc2 +  wm[WRC]; vrc2 = vrc; vrc = v;
+          v = A * vrs + B * vrs2 +  wm[WRS]; vrs2 = vrs; vrs = v;
+          v = A * vtc + B * vtc2 +  wm[WTC]; vtc2 = vtc; vtc = v;
+          v = A * vts + B * vts2 +  wm[WTS]; vts2 = vts; vts = v;
+          v = A * vlc + B * vlc2 + m*wm[WS]; vlc2 = vlc; vlc = v;
+          v = A * vls + B * vls2 - m*wm[WC]; vls2 = vls; vls = v;
         }
       } else {
         real A, B, qs;
@@ -70,15 +114,15 @@ namespace GeographicLib {
           A = B = 0;
         }
         qs = _q / SphericalEngine::scale();
-        vc = qs * (_wc[m] + A * (cl * vc + sl * vs ) + B * vc2);
+        vc = qs * (wm[WC] + A * (cl * vc + sl * vs ) + B * vc2);
         if (gradp) {
           qs /= _r;
           // The components of the gradient in circular coordinates are
           // r: dV/dr
           // theta: 1/r * dV/dtheta
           // lambda: 1/(r*u) * dV/dlambda
-          vrc =    - qs * (_wrc[m] + A * (cl * vrc + sl * vrs) + B * vrc2);
-          vtc =      qs * (_wtc[m] + A * (cl * vtc + sl * vts) + B * vtc2);
+          vrc =    - qs * (wm[WRC] + A * (cl * vrc + sl * vrs) + B * vrc2);
+          vtc =      qs * (wm[WTC] + A * (cl * vtc + sl * vts) + B * vtc2);
           vlc = qs / _u * (          A * (cl * vlc + sl * vls) + B * vlc2);
         }
       }
@@ -93,4 +137,425 @@ namespace GeographicLib {
     return vc;
   }
 
+  void CircularEngine::Values(bool gradp, int n,
+                              const real sl[], const real cl[], real V[],
+                              real gradx[], real grady[], real gradz[]) const
+  {
+    // This follows Value with each of the accumulators replaced by an array
+    // indexed by the longitude.  The operations are in the same order, so the
+    // results are identical.
+    gradp = _gradp && gradp;
+    const real* root = SphericalEngine::sqrttable();
+
+    real vc [blk_], vc2 [blk_], vs [blk_], vs2 [blk_],
+      vrc[blk_], vrc2[blk_], vrs[blk_], vrs2[blk_],
+      vtc[blk_], vtc2[blk_], vts[blk_], vts2[blk_],
+      vlc[blk_], vlc2[blk_], vls[blk_], vls2[blk_];
+    for (int i = 0; i < n; ++i) {
+      vc [i] = vc2 [i] = vs [i] = vs2 [i] = 0;
+      vrc[i] = vrc2[i] = vrs[i] = vrs2[i] = 0;
+      vtc[i] = vtc2[i] = vts[i] = vts2[i] = 0;
+      vlc[i] = vlc2[i] = vls[i] = vls2[i] = 0;
+    }
+    for (int m = _M; m >= 0; --m) {   // m = M .. 0
+      const real* wm = _w.data() + _k * m;
+      if (m) {
+        real v, B;              // alpha[m] / cl, beta[m + 1]
+        switch (_norm) {
+        case FULL:
+          v = root[2] * root[2 * m + 3] / root[m + 1];
+          B = - v * root[2 * m + 5] / (root[8] * root[m + 2]) * _uq2;
+          break;
+        case SCHMIDT:
+          v = root[2] * root[2 * m + 1] / root[m + 1];
+          B = - v * root[2 * m + 3] / (root[8] * root[m + 2]) * _uq2;
+          break;
+        default:
+          v = B = 0;
+        }
+        real wc = wm[WC], ws = wm[WS];
+        for (int i = 0; i < n; ++i) {
+          real A = cl[i] * v * _uq, w;
+          w = A * vc[i] + B * vc2[i] + wc; vc2[i] = vc[i]; vc[i] = w;
+          w = A * vs[i] + B * vs2[i] + ws; vs2[i] = vs[i]; vs[i] = w;
+        }
+        if (gradp) {
+          real wrc = wm[WRC], wrs = wm[WRS], wtc = wm[WTC], wts = wm[WTS],
+            wlc = m*wm[WS], wls = - m*wm[WC];
+          for (int i = 0; i < n; ++i) {
+            real A = cl[i] * v * _uq, w;
+            w = A * vrc[i] + B * vrc2[i] + wrc; vrc2[i] = vrc[i]; vrc[i] = w;
+            w = A * vrs[i] + B * vrs2[i] + wrs; vrs2[i] = vrs[i]; vrs[i] = w;
+            w = A * vtc[i] + B * vtc2[i] + wtc; vtc2[i] = vtc[i]; vtc[i] = w;
+            w = A * vts[i] + B * vts2[i] + wts; vts2[i] = vts[i]; vts[i] = w;
+            w = A * vlc[i] + B * vlc2[i] + wlc; vlc2[i] = vlc[i]; vlc[i] = w;
+            w = A * vls[i] + B * vls2[i] + wls; vls2[i] = vls[i]; vls[i] = w;
+          }
+        }
+      } else {
+        real A, B, qs;
+        switch (_norm) {
+        case FULL:
+          A = root[3] * _uq;       // F[1]/(q*cl) or F[1]/(q*sl)
+          B = - root[15]/2 * _uq2; // beta[1]/q
+          break;
+        case SCHMIDT:
+          A = _uq;
+          B = - root[3]/2 * _uq2;
+          break;
+        default:
+          A = B = 0;
+        }
+        qs = _q / SphericalEngine::scale();
+        for (int i = 0; i < n; ++i)
+          vc[i] = qs * (wm[WC] + A * (cl[i] * vc[i] + sl[i] * vs[i]) +
+                        B * vc2[i]);
+        if (gradp) {
+          qs /= _r;
+          for (int i = 0; i < n; ++i) {
+            vrc[i] = - qs * (wm[WRC] + A * (cl[i] * vrc[i] + sl[i] * vrs[i])
+                             + B * vrc2[i]);
+            vtc[i] =   qs * (wm[WTC] + A * (cl[i] * vtc[i] + sl[i] * vts[i])
+                             + B * vtc2[i]);
+            vlc[i] = qs / _u * (A * (cl[i] * vlc[i] + sl[i] * vls[i])
+                                + B * vlc2[i]);
+          }
+        }
+      }
+    }
+
+    for (int i = 0; i < n; ++i) {
+      V[i] = vc[i];
+      if (gradp) {
+        // Rotate into cartesian (geocentric) coordinates
+        gradx[i] = cl[i] * (_u * vrc[i] + _t * vtc[i]) - sl[i] * vlc[i];
+        grady[i] = sl[i] * (_u * vrc[i] + _t * vtc[i]) + cl[i] * vlc[i];
+        gradz[i] =           _t * vrc[i] - _u * vtc[i]                  ;
+      }
+    }
+  }
+
+  void CircularEngine::ValuesFloat(bool gradp, int n,
+                                   const float sl[], const float cl[],
+                                   float V[], float gradx[], float grady[],
+                                   float gradz[]) const
+  {
+    // This is Values with the accumulators v[m] replaced by y[m] =
+    // (u*q)^m * v[m].  The factors of u*q then drop out of the coefficients
+    // of the recurrence and instead multiply the sums over degree w[m]; these
+    // are computed in double precision (using the scaling given by logarithms
+    // so as to avoid overflow and underflow) before being rounded to float.
+    // The result is scaled by 2^lf in place of SphericalEngine::scale().
+    using std::log2; using std::frexp; using std::ldexp;
+    using std::floor; using std::exp2;
+    gradp = _gradp && gradp;
+    const real* root = SphericalEngine::sqrttable();
+    const int lf = -3 * numeric_limits<float>::max_exponent / 5;
+    const real
+      l0 = lf - log2(SphericalEngine::scale()), luq = log2(_uq);
+    // w * 2^(l0 + m * luq) rounded to float
+    auto wf = [](real w, real l) -> float {
+      int e;
+      real fr = frexp(w, &e), fl = floor(l);
+      return float(ldexp(fr * exp2(l - fl), e + int(fl)));
+    };
+
+    float vc [blk_], vc2 [blk_], vs [blk_], vs2 [blk_],
+      vrc[blk_], vrc2[blk_], vrs[blk_], vrs2[blk_],
+      vtc[blk_], vtc2[blk_], vts[blk_], vts2[blk_],
+      vlc[blk_], vlc2[blk_], vls[blk_], vls2[blk_];
+    for (int i = 0; i < n; ++i) {
+      vc [i] = vc2 [i] = vs [i] = vs2 [i] = 0;
+      vrc[i] = vrc2[i] = vrs[i] = vrs2[i] = 0;
+      vtc[i] = vtc2[i] = vts[i] = vts2[i] = 0;
+      vlc[i] = vlc2[i] = vls[i] = vls2[i] = 0;
+    }
+    for (int m = _M; m >= 0; --m) {   // m = M .. 0
+      const real* wm = _w.data() + _k * m;
+      real l = l0 + m * luq;
+      if (m) {
+        real v, b;              // alpha[m] / (cl*u*q), beta[m + 1] / (u*q)^2
+        switch (_norm) {
+        case FULL:
+          v = root[2] * root[2 * m + 3] / root[m + 1];
+          b = - v * root[2 * m + 5] / (root[8] * root[m + 2]);
+          break;
+        case SCHMIDT:
+          v = root[2] * root[2 * m + 1] / root[m + 1];
+          b = - v * root[2 * m + 3] / (root[8] * root[m + 2]);
+          break;
+        default:
+          v = b = 0;
+        }
+        float a = float(v), B = float(b),
+          wc = wf(wm[WC], l), ws = wf(wm[WS], l);
+        for (int i = 0; i < n; ++i) {
+          float A = cl[i] * a, w;
+          w = A * vc[i] + B * vc2[i] + wc; vc2[i] = vc[i]; vc[i] = w;
+          w = A * vs[i] + B * vs2[i] + ws; vs2[i] = vs[i]; vs[i] = w;
+        }
+        if (gradp) {
+          float wrc = wf(wm[WRC], l), wrs = wf(wm[WRS], l),
+            wtc = wf(wm[WTC], l), wts = wf(wm[WTS], l),
+            wlc = wf(m*wm[WS], l), wls = wf(- m*wm[WC], l);
+          for (int i = 0; i < n; ++i) {
+            float A = cl[i] * a, w;
+            w = A * vrc[i] + B * vrc2[i] + wrc; vrc2[i] = vrc[i]; vrc[i] = w;
+            w = A * vrs[i] + B * vrs2[i] + wrs; vrs2[i] = vrs[i]; vrs[i] = w;
+            w = A * vtc[i] + B * vtc2[i] + wtc; vtc2[i] = vtc[i]; vtc[i] = w;
+            w = A * vts[i] + B * vts2[i] + wts; vts2[i] = vts[i]; vts[i] = w;
+            w = A * vlc[i] + B * vlc2[i] + wlc; vlc2[i] = vlc[i]; vlc[i] = w;
+            w = A * vls[i] + B * vls2[i] + wls; vls2[i] = vls[i]; vls[i] = w;
+          }
+        }
+      } else {
+        real a, b, qs;
+        switch (_norm) {
+        case FULL:
+          a = root[3];
+          b = - root[15]/2;
+          break;
+        case SCHMIDT:
+          a = 1;
+          b = - root[3]/2;
+          break;
+        default:
+          a = b = 0;
+        }
+        qs = ldexp(_q, -lf);
+        float A = float(a), B = float(b), Q = float(qs), wc = wf(wm[WC], l);
+        for (int i = 0; i < n; ++i)
+          vc[i] = Q * (wc + A * (cl[i] * vc[i] + sl[i] * vs[i]) +
+                       B * vc2[i]);
+        if (gradp) {
+          qs /= _r;
+          float Qr = float(qs), Qu = float(qs / _u),
+            wrc = wf(wm[WRC], l), wtc = wf(wm[WTC], l);
+          for (int i = 0; i < n; ++i) {
+            vrc[i] = - Qr * (wrc + A * (cl[i] * vrc[i] + sl[i] * vrs[i])
+                             + B * vrc2[i]);
+            vtc[i] =   Qr * (wtc + A * (cl[i] * vtc[i] + sl[i] * vts[i])
+                             + B * vtc2[i]);
+            vlc[i] = Qu * (A * (cl[i] * vlc[i] + sl[i] * vls[i])
+                           + B * vlc2[i]);
+          }
+        }
+      }
+    }
+
+    float u = float(_u), t = float(_t);
+    for (int i = 0; i < n; ++i) {
+      V[i] = vc[i];
+      if (gradp) {
+        // Rotate into cartesian (geocentric) coordinates
+        gradx[i] = cl[i] * (u * vrc[i] + t * vtc[i]) - sl[i] * vlc[i];
+        grady[i] = sl[i] * (u * vrc[i] + t * vtc[i]) + cl[i] * vlc[i];
+        gradz[i] =           t * vrc[i] - u * vtc[i]                  ;
+      }
+    }
+  }
+
+  void CircularEngine::Evaluate(size_t n,
+                                const real sinlon[], const real coslon[],
+                                real V[],
+                                real gradx[], real grady[], real gradz[])
+    const {
+    bool gradp = gradx && grady && gradz;
+    for (size_t i = 0; i < n; i += blk_) {
+      int k = int(min(n - i, size_t(blk_)));
+      Values(gradp, k, sinlon + i, coslon + i, V + i,
+             gradp ? gradx + i : nullptr,
+             gradp ? grady + i : nullptr,
+             gradp ? gradz + i : nullptr);
+    }
+  }
+
+  void CircularEngine::EvaluateGrid(real lon0, real dlon, size_t n,
+                                    real V[],
+                                    real gradx[], real grady[], real gradz[])
+    const {
+    bool gradp = gradx && grady && gradz;
+    if (ValuesFFT(gradp, lon0, dlon, n, V, gradx, grady, gradz))
+      return;
+    real sl[blk_], cl[blk_];
+    for (size_t i = 0; i < n; i += blk_) {
+      int k = int(min(n - i, size_t(blk_)));
+      for (int j = 0; j < k; ++j)
+        Math::sincosd(lon0 + real(i + j) * dlon, sl[j], cl[j]);
+      Values(gradp, k, sl, cl, V + i,
+             gradp ? gradx + i : nullptr,
+             gradp ? grady + i : nullptr,
+             gradp ? gradz + i : nullptr);
+    }
+  }
+
+  bool CircularEngine::ValuesFFT(bool gradp, real lon0, real dlon, size_t n,
+                                 real V[],
+                                 real gradx[], real grady[], real gradz[])
+    const {
+    // Value evaluates a Clenshaw sum over m whose basis functions are
+    // s[m] * cos(m*lambda) and s[m] * sin(m*lambda) where s[0] = 1, s[1] =
+    // A (for m = 0), and s[m+1] = s[m] * alpha[m] / (2*cl) for m > 0; this
+    // follows from the recurrence cos((m+1)*lambda) = 2*cl*cos(m*lambda) -
+    // cos((m-1)*lambda).  Multiplying the coefficients by these factors
+    // gives a Fourier series in lambda which, if dlon = 360/K, is evaluated
+    // at the K longitudes lon0 + j * dlon by a single FFT of length K.  The
+    // products are formed using the logarithms of s[m] to avoid overflow
+    // and underflow (as in ValuesFloat).
+    using std::log2; using std::frexp; using std::ldexp; using std::floor;
+    using std::exp2; using std::round; using std::abs;
+    gradp = _gradp && gradp;
+    if (!(_M >= 0 && _uq > 0 && n > 0 && abs(dlon) > 0)) return false;
+    real Kr = round(360 / abs(dlon)),
+      tol = 360 * 64 * numeric_limits<real>::epsilon();
+    if (!(Kr >= 2 && Kr <= real(numeric_limits<int>::max() / 2) &&
+          abs(Kr * abs(dlon) - 360) <= tol))
+      return false;
+    int K = int(Kr);
+    vector<int> fac(factors(K));
+    real facsum = 0;
+    for (int p : fac) facsum += p;
+    // The cost of the FFTs (2 are needed for the gradient) compared with the
+    // cost of the sums in Values (with 8 accumulators for the gradient).
+    if (!(Kr * facsum * (gradp ? 2 : 1) <
+          real(n) * real(_M + 1) * (gradp ? 4 : 1)))
+      return false;
+    const real* root = SphericalEngine::sqrttable();
+    real A0;
+    switch (_norm) {
+    case FULL: A0 = root[3]; break;
+    case SCHMIDT: A0 = 1; break;
+    default: A0 = 0;
+    }
+    // The spectra: V + i*vr and vt + i*vl.  The Hermitian part of the
+    // spectrum of each real series is formed so that both transforms are
+    // real.
+    vector<cplx> h1(K, cplx(0)), h2(gradp ? K : 0, cplx(0)),
+      w(K), f(K), t(fac.back());
+    // ls = log2(qs * s[m]); the factor 1/u for vl is included in its
+    // coefficients (with lu = log2(u)) since s[m] contains a factor u for
+    // m > 0 (for which vl is nonzero).
+    real ls = log2(_q) - log2(SphericalEngine::scale()), luq = log2(_uq),
+      lu = log2(_u);
+    // w * 2^l
+    auto wl = [](real x, real l) -> real {
+      int e;
+      real fr = frexp(x, &e), fl = floor(l);
+      return ldexp(fr * exp2(l - fl), e + int(fl));
+    };
+    // Add (c - i*d) * exp(i*m*lon0)/2 to the coefficient k and its conjugate
+    // to the coefficient K - k.
+    auto add = [K](vector<cplx>& h, int k, cplx e, real c, real d,
+                   real c2, real d2) -> void {
+      cplx z1 = cplx(c, -d) * e, z2 = cplx(c2, -d2) * e;
+      z1 /= real(2); z2 /= real(2);
+      // z1 + i*z2 and its "conjugate" conj(z1) + i*conj(z2)
+      h[k] += z1 + cplx(-z2.imag(), z2.real());
+      h[(K - k) % K] += conj(z1) + cplx(z2.imag(), z2.real());
+    };
+    for (int m = 0; m <= _M; ++m) {
+      if (m == 1)
+        ls += log2(A0) + luq;
+      else if (m > 1) {
+        real v;                 // alpha[m-1] / (cl*u*q)
+        switch (_norm) {
+        case FULL:
+          v = root[2] * root[2 * m + 1] / root[m];
+          break;
+        case SCHMIDT:
+          v = root[2] * root[2 * m - 1] / root[m];
+          break;
+        default:
+          v = 0;
+        }
+        ls += log2(v / 2) + luq;
+      }
+      const real* wm = _w.data() + _k * m;
+      real s, c;
+      Math::sincosd(real(m) * lon0, s, c);
+      cplx e(c, s);
+      int k = m % K;
+      if (gradp) {
+        // V + i*vr
+        add(h1, k, e, wl(wm[WC], ls), wl(wm[WS], ls),
+            wl(wm[WRC], ls), wl(wm[WRS], ls));
+        // vt + i*vl
+        add(h2, k, e, wl(wm[WTC], ls), wl(wm[WTS], ls),
+            wl(m * wm[WS], ls - lu), wl(-m * wm[WC], ls - lu));
+      } else
+        add(h1, k, e, wl(wm[WC], ls), wl(wm[WS], ls), 0, 0);
+    }
+    for (int j = 0; j < K; ++j) {
+      real s, c;
+      Math::sincosd(real(j) * 360 / K, s, c);
+      w[j] = cplx(c, s);
+    }
+    fft(h1.data(), 1, f.data(), K, fac.data(), w.data(), 1, t.data());
+    // Output i is at index j = i (mod K) in the transform, or j = -i if
+    // dlon < 0.
+    auto index = [K, dlon](size_t i) -> int {
+      int j = int(i % size_t(K));
+      return dlon > 0 ? j : (K - j) % K;
+    };
+    if (!gradp) {
+      for (size_t i = 0; i < n; ++i)
+        V[i] = f[index(i)].real();
+      return true;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      const cplx& x = f[index(i)];
+      V[i] = x.real();
+      gradx[i] = - x.imag() / _r; // Save vrc in gradx
+    }
+    fft(h2.data(), 1, f.data(), K, fac.data(), w.data(), 1, t.data());
+    for (size_t i = 0; i < n; ++i) {
+      const cplx& x = f[index(i)];
+      real sl, cl;
+      Math::sincosd(lon0 + real(i) * dlon, sl, cl);
+      real
+        vrc = gradx[i],
+        vtc = x.real() / _r,
+        vlc = x.imag() / _r;
+      // Rotate into cartesian (geocentric) coordinates
+      gradx[i] = cl * (_u * vrc + _t * vtc) - sl * vlc;
+      grady[i] = sl * (_u * vrc + _t * vtc) + cl * vlc;
+      gradz[i] =           _t * vrc - _u * vtc        ;
+    }
+    return true;
+  }
+
+  void CircularEngine::EvaluateFloat(size_t n,
+                                     const float sinlon[],
+                                     const float coslon[],
+                                     float V[], float gradx[],
+                                     float grady[], float gradz[]) const {
+    bool gradp = gradx && grady && gradz;
+    for (size_t i = 0; i < n; i += blk_) {
+      int k = int(min(n - i, size_t(blk_)));
+      ValuesFloat(gradp, k, sinlon + i, coslon + i, V + i,
+                  gradp ? gradx + i : nullptr,
+                  gradp ? grady + i : nullptr,
+                  gradp ? gradz + i : nullptr);
+    }
+  }
+
+  void CircularEngine::EvaluateGridFloat(real lon0, real dlon, size_t n,
+                                         float V[], float gradx[],
+                                         float grady[], float gradz[]) const {
+    bool gradp = gradx && grady && gradz;
+    float sl[blk_], cl[blk_];
+    for (size_t i = 0; i < n; i += blk_) {
+      int k = int(min(n - i, size_t(blk_)));
+      for (int j = 0; j < k; ++j) {
+        real s, c;
+        Math::sincosd(lon0 + real(i + j) * dlon, s, c);
+        sl[j] = float(s); cl[j] = float(c);
+      }
+      ValuesFloat(gradp, k, sl, cl, V + i,
+                  gradp ? gradx + i : nullptr,
+                  gradp ? grady + i : nullptr,
+                  gradp ? gradz + i : nullptr);
+    }
+  }
+
 } // namespace GeographicLib
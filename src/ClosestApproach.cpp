@@ -0,0 +1,230 @@
+/**
+ * \file ClosestApproach.cpp
+ * \brief Implementation for GeographicLib::ClosestApproach class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <GeographicLib/ClosestApproach.hpp>
+#include <GeographicLib/Executor.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  ClosestApproach::ClosestApproach(const Geodesic& earth, unsigned threads)
+    : _earth(earth)
+      // The convergence is quadratic, so the error after a step of this size
+      // is negligible.
+    , _tol(real(0.01) * sqrt(numeric_limits<real>::epsilon()) *
+           _earth.EquatorialRadius())
+    , _threads(threads ? threads : thread::hardware_concurrency())
+  {
+    // hardware_concurrency returns 0 if the number of cores can't be
+    // determined.
+    if (_threads == 0) _threads = 1;
+  }
+
+  void ClosestApproach::Cartesian(real lat, real lon,
+                                  real& X, real& Y, real& Z) const {
+    real f = _earth.Flattening(), e2 = f * (2 - f),
+      sphi, cphi, slam, clam;
+    Math::sincosd(lat, sphi, cphi);
+    Math::sincosd(lon, slam, clam);
+    real n = _earth.EquatorialRadius() / sqrt(1 - e2 * Math::sq(sphi));
+    X = n * cphi * clam;
+    Y = n * cphi * slam;
+    Z = n * (1 - e2) * sphi;
+  }
+
+  Math::real ClosestApproach::Iterate(const GeodesicLine& line1, real v1,
+                                      const GeodesicLine* line2, real v2,
+                                      real lat2, real lon2,
+                                      real tmax, real& t) const {
+    const real vsum = abs(v1) + abs(v2);
+    real s12 = Math::NaN(), tx = 0, azi2 = 0;
+    t = Math::NaN();
+    for (int i = 0; i < maxit_; ++i) {
+      real lat1, lon1, azi1;
+      line1.Position(v1 * tx, lat1, lon1, azi1);
+      if (line2) line2->Position(v2 * tx, lat2, lon2, azi2);
+      real azi1x, azi2x, m12, M12, M21;
+      _earth.Inverse(lat1, lon1, lat2, lon2,
+                     s12, azi1x, azi2x, m12, M12, M21);
+      t = tx;
+      // The objects coincide
+      if (s12 == 0) break;
+      // (x1, y1) and (x2, y2) are the velocities of the objects resolved
+      // along and perpendicular to the geodesic joining them.
+      real x1, y1, x2, y2;
+      Math::sincosd(Math::AngDiff(azi1x, azi1), y1, x1);
+      Math::sincosd(Math::AngDiff(azi2x, azi2), y2, x2);
+      x1 *= v1; y1 *= v1; x2 *= v2; y2 *= v2;
+      real r12 = s12 / m12,
+        // g = d(s12^2/2)/dt and dg = dg/dt
+        g = s12 * (x2 - x1),
+        dg = (Math::sq(x1) + M12 * r12 * Math::sq(y1)) +
+        (Math::sq(x2) + M21 * r12 * Math::sq(y2)) -
+        2 * (x1 * x2 + r12 * y1 * y2);
+      // The separation increases at the start (or decreases at the end) of
+      // the window
+      if ((tx <= 0 && g >= 0) || (tx >= tmax && g <= 0)) break;
+      // If the separation isn't convex here, head for the end of the window
+      // towards which it decreases
+      real tn = dg > 0 ? tx - g / dg : (g > 0 ? 0 : tmax);
+      tn = min(tmax, max(real(0), tn));
+      if (!(abs(tn - tx) * vsum > _tol)) break;
+      tx = tn;
+    }
+    return s12;
+  }
+
+  Math::real ClosestApproach::Compute(const GeodesicLine& line1, real v1,
+                                      const GeodesicLine& line2, real v2,
+                                      real tmax, real& t) const {
+    const unsigned caps = GeodesicLine::LATITUDE | GeodesicLine::LONGITUDE |
+      GeodesicLine::AZIMUTH | GeodesicLine::DISTANCE_IN;
+    if (!(line1.Capabilities(caps) && line2.Capabilities(caps))) {
+      t = Math::NaN();
+      return Math::NaN();
+    }
+    return Iterate(line1, v1, &line2, v2, 0, 0, tmax, t);
+  }
+
+  Math::real ClosestApproach::Segment(const GeodesicLine& seg,
+                                      real lat, real lon, real& s) const {
+    const unsigned caps = GeodesicLine::LATITUDE | GeodesicLine::LONGITUDE |
+      GeodesicLine::AZIMUTH | GeodesicLine::DISTANCE_IN;
+    real s13 = seg.Distance();
+    if (!(seg.Capabilities(caps) && isfinite(s13))) {
+      s = Math::NaN();
+      return Math::NaN();
+    }
+    // A point moving with unit speed along the segment (backwards if the
+    // segment has negative length) and a fixed point
+    real v1 = s13 < 0 ? -1 : 1,
+      s12 = Iterate(seg, v1, nullptr, 0, lat, lon, abs(s13), s);
+    s *= v1;
+    return s12;
+  }
+
+  size_t ClosestApproach::Batch(size_t n, const size_t i1[],
+                                const size_t i2[],
+                                const GeodesicLine lines[], const real v[],
+                                real tmax, real dmax,
+                                real t[], real s12[]) const {
+    // Pairs are handled in chunks of this size
+    const size_t chunk = 64;
+    const size_t nchunks = (n + chunk - 1) / chunk;
+    vector<size_t> count(nchunks, 0);
+    Executor::Parallel(nchunks, _threads, [&](size_t k) -> void {
+      for (size_t i = k * chunk; i < min(n, (k + 1) * chunk); ++i) {
+        const GeodesicLine& l1 = lines[i1[i]], & l2 = lines[i2[i]];
+        const real v1 = v[i1[i]], v2 = v[i2[i]];
+        real X1, Y1, Z1, X2, Y2, Z2;
+        Cartesian(l1.Latitude(), l1.Longitude(), X1, Y1, Z1);
+        Cartesian(l2.Latitude(), l2.Longitude(), X2, Y2, Z2);
+        // The chord is no longer than the geodesic and the separation can
+        // decrease no faster than the sum of the speeds.
+        real lb = hypot(hypot(X2 - X1, Y2 - Y1), Z2 - Z1) -
+          (abs(v1) + abs(v2)) * tmax;
+        if (lb > dmax) {
+          t[i] = Math::NaN(); s12[i] = lb;
+          continue;
+        }
+        s12[i] = Compute(l1, v1, l2, v2, tmax, t[i]);
+        if (s12[i] <= dmax) ++count[k];
+      }
+    });
+    size_t num = 0;
+    for (size_t c : count) num += c;
+    return num;
+  }
+
+  void ClosestApproach::SegmentBatch(size_t n, const size_t iseg[],
+                                     const GeodesicLine segs[],
+                                     const real lat[], const real lon[],
+                                     real s12[], real s[]) const {
+    // Points are handled in chunks of this size
+    const size_t chunk = 64;
+    Executor::Parallel((n + chunk - 1) / chunk, _threads,
+                       [&](size_t k) -> void {
+      for (size_t i = k * chunk; i < min(n, (k + 1) * chunk); ++i) {
+        // Allow s12 and s to alias lat and lon
+        real lati = lat[i], loni = lon[i], si;
+        s12[i] = Segment(segs[iseg[i]], lati, loni, si);
+        s[i] = si;
+      }
+    });
+  }
+
+  size_t ClosestApproach::Simplify(size_t n,
+                                   const real lat[], const real lon[],
+                                   real tol, bool keep[]) const {
+    const unsigned caps = GeodesicLine::LATITUDE | GeodesicLine::LONGITUDE |
+      GeodesicLine::AZIMUTH | GeodesicLine::DISTANCE_IN;
+    for (size_t k = 0; k < n; ++k)
+      keep[k] = k == 0 || k + 1 == n;
+    size_t num = min(n, size_t(2));
+    if (n <= 2) return num;
+    // The geocentric coordinates of the points, for the bounds on the
+    // distances between them
+    vector<real> xyz(3 * n);
+    for (size_t k = 0; k < n; ++k)
+      Cartesian(lat[k], lon[k], xyz[3*k], xyz[3*k+1], xyz[3*k+2]);
+    // The smallest radius of curvature and an allowance for roundoff; see
+    // Geodesic::Within.
+    const real a = _earth.EquatorialRadius(), f1 = 1 - _earth.Flattening(),
+      rho = a * min(Math::sq(f1), 1 / f1),
+      eps = 64 * numeric_limits<real>::epsilon() * a;
+    // An upper bound on the distance between points k and l
+    auto bound = [&](size_t k, size_t l) -> real {
+      real c = hypot(hypot(xyz[3*k] - xyz[3*l], xyz[3*k+1] - xyz[3*l+1]),
+                     xyz[3*k+2] - xyz[3*l+2]);
+      return c <= rho ? 2 * rho * asin(c / (2 * rho)) + eps :
+        Math::infinity();
+    };
+    // The segments [i, j] still to be examined
+    vector<pair<size_t, size_t>> todo;
+    todo.push_back(make_pair(size_t(0), n - 1));
+    while (!todo.empty()) {
+      const size_t i = todo.back().first, j = todo.back().second;
+      todo.pop_back();
+      GeodesicLine seg = _earth.InverseLine(lat[i], lon[i], lat[j], lon[j],
+                                            caps);
+      real dmax = tol;
+      size_t kmax = i;
+      for (size_t k = i + 1; k < j; ++k) {
+        // A point within dmax of an end point is no further than this from
+        // the segment
+        if (min(bound(k, i), bound(k, j)) <= dmax) continue;
+        real s, d = Segment(seg, lat[k], lon[k], s);
+        if (d > dmax) { dmax = d; kmax = k; }
+      }
+      if (kmax == i) continue;
+      keep[kmax] = true; ++num;
+      if (kmax - i > 1) todo.push_back(make_pair(i, kmax));
+      if (j - kmax > 1) todo.push_back(make_pair(kmax, j));
+    }
+    return num;
+  }
+
+  size_t ClosestApproach::SimplifyBatch(size_t ntracks, const size_t start[],
+                                        const real lat[], const real lon[],
+                                        real tol, bool keep[]) const {
+    vector<size_t> count(ntracks, 0);
+    Executor::Parallel(ntracks, _threads, [&](size_t k) -> void {
+      const size_t i = start[k];
+      count[k] = Simplify(start[k + 1] - i, lat + i, lon + i, tol, keep + i);
+    });
+    size_t num = 0;
+    for (size_t c : count) num += c;
+    return num;
+  }
+
+} // namespace GeographicLib
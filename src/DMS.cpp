@@ -25,7 +25,37 @@ namespace GeographicLib {
   const char* const DMS::dmsindicators_ = "D'\":";
   const char* const DMS::components_[] = {"degrees", "minutes", "seconds"};
 
-  Math::real DMS::Decode(const std::string& dms, flag& ind) {
+  namespace {
+    typedef unsigned char uchar;
+    // Is s (ignoring surrounding white space) an optionally signed decimal
+    // number without an exponent?  Integers with more than 15 digits are
+    // excluded since InternalDecode accumulates their digits in floating
+    // point.
+    bool plaindecimal(const string& s) {
+      const char* p = s.c_str(), * e = p + s.size();
+      while (p < e && isspace(uchar(*p))) ++p;
+      while (p < e && isspace(uchar(e[-1]))) --e;
+      if (p < e && (*p == '+' || *p == '-')) ++p;
+      int nint = 0, nfrac = 0;
+      for (; p < e && isdigit(uchar(*p)); ++p) ++nint;
+      bool pointseen = p < e && *p == '.';
+      if (pointseen)
+        for (++p; p < e && isdigit(uchar(*p)); ++p) ++nfrac;
+      return p == e && nint + nfrac > 0 && (pointseen || nint <= 15);
+    }
+  }
+
+  DMS::status DMS::GenDecode(const std::string& dms, real& val, flag& ind,
+                             bool throwp) {
+    // Plain decimal numbers are the most common input; convert these
+    // directly, avoiding the character replacements below.
+    real v;
+    if (plaindecimal(dms) && Utility::fastval(dms, v)) {
+      val = v + 0;              // As below, -0 is converted to +0
+      ind = NONE;
+      return OK;
+    }
+
     // Here's a table of the allowed characters
 
     // S unicode   dec  UTF-8      descripton
@@ -153,7 +183,7 @@ namespace GeographicLib {
     while (beg < end && isspace(dmsa[end - 1]))
       --end;
     // The trimmed string in [beg, end)
-    real v = 0;
+    v = 0;
     int i = 0;
     flag ind1 = NONE;
     // p is pointer to the next piece that needs decoding
@@ -168,21 +198,40 @@ namespace GeographicLib {
       // Find next sign
       pb = min(dmsa.find_first_of(signs_, pa), end);
       flag ind2 = NONE;
-      v += InternalDecode(dmsa.substr(p, pb - p), ind2);
+      real v2;
+      status stat = InternalDecode(dmsa.substr(p, pb - p), v2, ind2, throwp);
+      if (stat != OK) return stat;
+      v += v2;
       if (ind1 == NONE)
         ind1 = ind2;
-      else if (!(ind2 == NONE || ind1 == ind2))
+      else if (!(ind2 == NONE || ind1 == ind2)) {
+        if (!throwp) return BADSTRING;
         throw GeographicErr("Incompatible hemisphere specifier in " +
                             dmsa.substr(beg, pb - beg));
+      }
     }
-    if (i == 0)
+    if (i == 0) {
+      if (!throwp) return BADSTRING;
       throw GeographicErr("Empty or incomplete DMS string " +
                           dmsa.substr(beg, end - beg));
+    }
+    val = v;
     ind = ind1;
-    return v;
+    return OK;
   }
 
-  Math::real DMS::InternalDecode(const string& dmsa, flag& ind) {
+  Math::real DMS::Decode(const std::string& dms, flag& ind) {
+    real val;
+    GenDecode(dms, val, ind, true);
+    return val;
+  }
+
+  DMS::status DMS::Decode(const std::string& dms, real& val, flag& ind) {
+    return GenDecode(dms, val, ind, false);
+  }
+
+  DMS::status DMS::InternalDecode(const string& dmsa, real& val, flag& ind,
+                                  bool throwp) {
     string errormsg;
     do {                       // Executed once (provides the ability to break)
       int sign = 1;
@@ -339,18 +388,21 @@ namespace GeographicLib {
       ind = ind1;
       // Assume check on range of result is made by calling routine (which
       // might be able to offer a better diagnostic).
-      return real(sign) *
+      val = real(sign) *
         ( fpieces[2] != 0 ?
           (60*(60*fpieces[0] + fpieces[1]) + fpieces[2]) / 3600 :
           ( fpieces[1] != 0 ?
             (60*fpieces[0] + fpieces[1]) / 60 : fpieces[0] ) );
+      return OK;
     } while (false);
-    real val = Utility::nummatch<real>(dmsa);
-    if (val == 0)
+    real val1 = Utility::nummatch<real>(dmsa);
+    if (val1 == 0) {
+      if (!throwp) return BADSTRING;
       throw GeographicErr(errormsg);
-    else
+    } else
       ind = NONE;
-    return val;
+    val = val1;
+    return OK;
   }
 
   void DMS::DecodeLatLon(const string& stra, const string& strb,
@@ -445,6 +497,14 @@ namespace GeographicLib {
       pieces[i - 1] = ip;
     }
     pieces[0] += idegree;
+    if (trailing == DEGREE && ind == NONE) {
+      // The common case of a plain number doesn't need a string stream
+      char buf[64];
+      buf[0] = '-';
+      size_t len = Utility::str(buf + 1, sizeof(buf) - 1, pieces[0], prec);
+      if (len < sizeof(buf) - 1)
+        return sign < 0 ? string(buf, len + 1) : string(buf + 1, len);
+    }
     ostringstream s;
     s << fixed << setfill('0');
     if (ind == NONE && sign < 0)
@@ -0,0 +1,102 @@
+/**
+ * \file Dispatch.cpp
+ * \brief Implementation for GeographicLib::Dispatch class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/Dispatch.hpp>
+// For getenv
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER)
+// Squelch warnings about unsafe use of getenv
+#  pragma warning (disable: 4996)
+#endif
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    // The routines with kernels selected by Dispatch::Select.  Add to this
+    // list when adding a kernel table.
+    const char* const kernels[] = {
+      "Math::sincosdBatch",
+      "Math::atan2dBatch",
+      "Math::AngDiffBatch",
+      "EllipticFunction::FBatch",
+      "EllipticFunction::EBatch",
+      "EllipticFunction::EdBatch",
+      "EllipticFunction::PiBatch",
+      "EllipticFunction::DBatch",
+      "EllipticFunction::GBatch",
+      "EllipticFunction::HBatch",
+    };
+  }
+
+  int Dispatch::Detect() {
+#if GEOGRAPHICLIB_DISPATCH
+    // __builtin_cpu_supports also checks that the OS saves the wide
+    // registers.
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return AVX512;
+    if (__builtin_cpu_supports("avx2")) return AVX2;
+    return GENERIC;
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    return NEON;
+#else
+    return GENERIC;
+#endif
+  }
+
+  int Dispatch::Choose() {
+    int level = Detect();
+    const char* isaname = getenv("GEOGRAPHICLIB_ISA");
+    if (isaname) {
+      int cap = level;
+      if (strcmp(isaname, "generic") == 0)
+        cap = GENERIC;
+      else if (strcmp(isaname, "neon") == 0)
+        cap = NEON;
+      else if (strcmp(isaname, "avx2") == 0)
+        cap = AVX2;
+      else if (strcmp(isaname, "avx512") == 0)
+        cap = AVX512;
+      // NEON is not a step on the way to AVX2 and vice versa
+      if (cap < level) level = cap == NEON ? GENERIC : cap;
+    }
+    return level;
+  }
+
+  Dispatch::isa Dispatch::Supported() {
+    static const int level = Detect();
+    return isa(level);
+  }
+
+  Dispatch::isa Dispatch::Selected() {
+    // Initialization of a function-local static is thread safe
+    static const int level = Choose();
+    return isa(level);
+  }
+
+  string Dispatch::Name(isa level) {
+    switch (level) {
+    case NEON:   return "neon";
+    case AVX2:   return "avx2";
+    case AVX512: return "avx512";
+    default:     return "generic";
+    }
+  }
+
+  string Dispatch::Kernels() {
+    string name = Name(Selected()), s;
+    for (const char* k : kernels)
+      s += string(k) + " " + name + "\n";
+    return s;
+  }
+
+} // namespace GeographicLib
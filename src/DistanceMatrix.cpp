@@ -0,0 +1,101 @@
+/**
+ * \file DistanceMatrix.cpp
+ * \brief Implementation for GeographicLib::DistanceMatrixT class
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <vector>
+#include <thread>
+#include <GeographicLib/DistanceMatrix.hpp>
+#include <GeographicLib/Executor.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  template<class GeodType>
+  DistanceMatrixT<GeodType>::DistanceMatrixT(const GeodType& earth,
+                                             unsigned threads)
+    : _earth(earth)
+    , _threads(threads ? threads : thread::hardware_concurrency())
+  {
+    // hardware_concurrency returns 0 if the number of cores can't be
+    // determined.
+    if (_threads == 0) _threads = 1;
+  }
+
+  template<class GeodType>
+  void DistanceMatrixT<GeodType>::Prepare(size_t n, const real lat[],
+                                          point p[]) const {
+    for (size_t i = 0; i < n; ++i) {
+      p[i].lat = lat[i];
+      _earth.InverseLat(p[i].lat, p[i].sbet, p[i].cbet, p[i].dn);
+    }
+  }
+
+  template<class GeodType>
+  void DistanceMatrixT<GeodType>::Tile(size_t i0, size_t i1,
+                                       size_t j0, size_t j1, size_t m,
+                                       const point p1[], const real lon1[],
+                                       const point p2[], const real lon2[],
+                                       unsigned outmask,
+                                       real s12[], real azi1[], real azi2[])
+    const {
+    const bool
+      dist = (outmask & GeodType::DISTANCE) != 0,
+      azi = (outmask & GeodType::AZIMUTH) != 0;
+    for (size_t i = i0; i < i1; ++i) {
+      const point& q1 = p1[i];
+      for (size_t j = j0; j < j1; ++j) {
+        const point& q2 = p2[j];
+        real s = 0, salp1, calp1, salp2, calp2, t;
+        _earth.GenInverse(q1.lat, q1.sbet, q1.cbet, q1.dn, lon1[i],
+                          q2.lat, q2.sbet, q2.cbet, q2.dn, lon2[j],
+                          outmask, s, salp1, calp1, salp2, calp2,
+                          t, t, t, t);
+        size_t k = i * m + j;
+        if (dist) s12[k] = s;
+        if (azi) {
+          azi1[k] = Math::atan2d(salp1, calp1);
+          azi2[k] = Math::atan2d(salp2, calp2);
+        }
+      }
+    }
+  }
+
+  template<class GeodType>
+  void DistanceMatrixT<GeodType>::Compute(size_t n,
+                                          const real lat1[], const real lon1[],
+                                          size_t m,
+                                          const real lat2[], const real lon2[],
+                                          unsigned outmask,
+                                          real s12[], real azi1[], real azi2[])
+    const {
+    outmask &= (GeodType::DISTANCE | GeodType::AZIMUTH) & GeodType::OUT_MASK;
+    if (n == 0 || m == 0 || outmask == 0) return;
+    vector<point> p1(n), p2(m);
+    Prepare(n, lat1, p1.data());
+    Prepare(m, lat2, p2.data());
+    const size_t
+      nr = (n + rowtile_ - 1) / rowtile_,
+      nc = (m + coltile_ - 1) / coltile_,
+      ntiles = nr * nc;
+    // Tiles in the same band of columns are consecutive so that a thread
+    // claiming tiles in order reuses the column data from the cache.
+    Executor::Parallel(ntiles, _threads, [&](size_t t) -> void {
+      size_t
+        c = t / nr, r = t % nr,
+        i0 = r * rowtile_, i1 = min(n, i0 + rowtile_),
+        j0 = c * coltile_, j1 = min(m, j0 + coltile_);
+      Tile(i0, i1, j0, j1, m, p1.data(), lon1, p2.data(), lon2,
+           outmask, s12, azi1, azi2);
+    });
+  }
+
+  template class GEOGRAPHICLIB_EXPORT DistanceMatrixT<Geodesic>;
+  template class GEOGRAPHICLIB_EXPORT DistanceMatrixT<GeodesicExact>;
+
+} // namespace GeographicLib
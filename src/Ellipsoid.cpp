@@ -88,6 +88,81 @@ namespace GeographicLib {
   Math::real Ellipsoid::InverseIsometricLatitude(real psi) const
   { return Math::atand(Math::tauf(sinh(psi * Math::degree()), _es)); }
 
+  void Ellipsoid::AuxBlock(auxlat type, size_t m, real x[]) const {
+    // This follows the scalar routines step by step, so that the results are
+    // the same; the tand and atand steps use the batch versions of sincosd
+    // and atan2d.
+    static const real overflow = 1 / Math::sq(numeric_limits<real>::epsilon());
+    real t[auxblock_], s[auxblock_], c[auxblock_];
+    // Set t = tand(LatFix(y))
+    auto tand = [&t, &s, &c, m](const real y[]) -> void {
+      for (size_t i = 0; i < m; ++i) t[i] = Math::LatFix(y[i]);
+      Math::sincosdBatch(m, t, s, c);
+      for (size_t i = 0; i < m; ++i)
+        t[i] = c[i] != 0 ? s[i] / c[i] : (s[i] < 0 ? -overflow : overflow);
+    };
+    // Set y = atand(t)
+    auto atand = [&t, &c, m](real y[]) -> void {
+      for (size_t i = 0; i < m; ++i) c[i] = 1;
+      Math::atan2dBatch(m, t, c, y);
+    };
+    real *a = s;                // s is free after tand
+    switch (type) {
+    case RECTIFYING:
+      tand(x);
+      for (size_t i = 0; i < m; ++i) t[i] *= _f1;
+      atand(a);
+      {
+        real qm = QuarterMeridian();
+        for (size_t i = 0; i < m; ++i)
+          if (abs(x[i]) != 90) x[i] = 90 * (_b * _ell.Ed(a[i])) / qm;
+      }
+      break;
+    case INVRECTIFYING:
+      {
+        real e = _ell.E();
+        for (size_t i = 0; i < m; ++i)
+          a[i] = _ell.Einv(x[i] * e / 90) / Math::degree();
+      }
+      tand(a);                  // OK because a is copied to t first
+      for (size_t i = 0; i < m; ++i) t[i] /= _f1;
+      atand(a);
+      for (size_t i = 0; i < m; ++i)
+        if (abs(x[i]) != 90) x[i] = a[i];
+      break;
+    case AUTHALIC:
+      tand(x);
+      for (size_t i = 0; i < m; ++i) t[i] = _au.txif(t[i]);
+      atand(x);
+      break;
+    case INVAUTHALIC:
+      tand(x);
+      for (size_t i = 0; i < m; ++i) t[i] = _au.tphif(t[i]);
+      atand(x);
+      break;
+    case CONFORMAL:
+      tand(x);
+      for (size_t i = 0; i < m; ++i) t[i] = Math::taupf(t[i], _es);
+      atand(x);
+      break;
+    case INVCONFORMAL:
+      tand(x);
+      for (size_t i = 0; i < m; ++i) t[i] = Math::tauf(t[i], _es);
+      atand(x);
+      break;
+    case ISOMETRIC:
+      tand(x);
+      for (size_t i = 0; i < m; ++i)
+        x[i] = asinh(Math::taupf(t[i], _es)) / Math::degree();
+      break;
+    case INVISOMETRIC:
+      for (size_t i = 0; i < m; ++i)
+        t[i] = Math::tauf(sinh(x[i] * Math::degree()), _es);
+      atand(x);
+      break;
+    }
+  }
+
   Math::real Ellipsoid::CircleRadius(real phi) const {
     return abs(phi) == 90 ? 0 :
       // a * cos(beta)
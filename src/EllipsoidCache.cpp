@@ -0,0 +1,112 @@
+/**
+ * \file EllipsoidCache.cpp
+ * \brief Implementation for GeographicLib::EllipsoidCache class
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/EllipsoidCache.hpp>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicExact.hpp>
+#include <GeographicLib/Rhumb.hpp>
+#include <GeographicLib/TransverseMercator.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  template<class T>
+  shared_ptr<const T> EllipsoidCache::LRU<T>::Find(const key& k) {
+    auto p = _map.find(k);
+    if (p == _map.end()) return shared_ptr<const T>();
+    // Move the item to the front of the list; iterators remain valid.
+    _list.splice(_list.begin(), _list, p->second);
+    return p->second->second;
+  }
+
+  template<class T>
+  void EllipsoidCache::LRU<T>::Insert(const key& k,
+                                      const shared_ptr<const T>& t,
+                                      size_t capacity) {
+    _list.push_front(item(k, t));
+    _map[k] = _list.begin();
+    while (_list.size() > capacity) {
+      _map.erase(_list.back().first);
+      _list.pop_back();
+    }
+  }
+
+  EllipsoidCache::EllipsoidCache(size_t capacity)
+    : _capacity(capacity)
+    , _hits(0)
+    , _misses(0)
+  {
+    if (_capacity == 0)
+      throw GeographicErr("EllipsoidCache capacity must be positive");
+  }
+
+  template<class T, class F>
+  shared_ptr<const T> EllipsoidCache::Lookup(LRU<T>& cache, const key& k,
+                                             F make) {
+    lock_guard<mutex> lock(_lock);
+    shared_ptr<const T> t = cache.Find(k);
+    if (t)
+      ++_hits;
+    else {
+      ++_misses;
+      // If the constructor throws, nothing is cached.
+      t = make();
+      cache.Insert(k, t, _capacity);
+    }
+    return t;
+  }
+
+  shared_ptr<const Geodesic>
+  EllipsoidCache::GeodesicInstance(real a, real f) {
+    return Lookup(_geod, key(a, f, 0),
+                  [a, f]() { return make_shared<const Geodesic>(a, f); });
+  }
+
+  shared_ptr<const GeodesicExact>
+  EllipsoidCache::GeodesicExactInstance(real a, real f) {
+    return Lookup(_geodexact, key(a, f, 0),
+                  [a, f]() { return make_shared<const GeodesicExact>(a, f); });
+  }
+
+  shared_ptr<const Rhumb>
+  EllipsoidCache::RhumbInstance(real a, real f, bool exact) {
+    return Lookup(_rhumb, key(a, f, exact ? 1 : 0),
+                  [a, f, exact]()
+                  { return make_shared<const Rhumb>(a, f, exact); });
+  }
+
+  shared_ptr<const TransverseMercator>
+  EllipsoidCache::TransverseMercatorInstance(real a, real f, real k0) {
+    return Lookup(_tm, key(a, f, k0),
+                  [a, f, k0]()
+                  { return make_shared<const TransverseMercator>(a, f, k0); });
+  }
+
+  void EllipsoidCache::Clear() {
+    lock_guard<mutex> lock(_lock);
+    _geod.Clear(); _geodexact.Clear(); _rhumb.Clear(); _tm.Clear();
+  }
+
+  size_t EllipsoidCache::Size() const {
+    lock_guard<mutex> lock(_lock);
+    return _geod.Size() + _geodexact.Size() + _rhumb.Size() + _tm.Size();
+  }
+
+  unsigned long long EllipsoidCache::Hits() const {
+    lock_guard<mutex> lock(_lock);
+    return _hits;
+  }
+
+  unsigned long long EllipsoidCache::Misses() const {
+    lock_guard<mutex> lock(_lock);
+    return _misses;
+  }
+
+} // namespace GeographicLib
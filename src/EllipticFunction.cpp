@@ -8,6 +8,7 @@
  **********************************************************************/
 
 #include <GeographicLib/EllipticFunction.hpp>
+#include <GeographicLib/Dispatch.hpp>
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions
@@ -221,6 +222,158 @@ namespace GeographicLib {
       (4084080 * mul * An * sqrt(An)) + 3 * s;
   }
 
+  namespace {
+    typedef Math::real real;
+
+    // The batch routines process the arrays in blocks of this size
+    const size_t ellblock = 64;
+
+    // RF(x, y, z) and RD(x, y, z) for m <= ellblock sets of arguments.  The
+    // duplication steps are carried out in lockstep, with the updates for
+    // the arguments which have already converged suppressed by selects;
+    // thus the results are the same as for the scalar routines.  The
+    // tolerances tol are those of the scalar routines.  The loops only
+    // involve arithmetic and sqrt and are vectorized by compilers (given
+    // -fno-math-errno).
+    template<typename T> GEOGRAPHICLIB_KERNEL_INLINE
+    void rfkernel(size_t m, const T x[], const T y[], const T z[], T rf[],
+                  T tol) {
+      T A0[ellblock], An[ellblock], Q[ellblock],
+        x0[ellblock], y0[ellblock], z0[ellblock], mul[ellblock];
+      for (size_t i = 0; i < m; ++i) {
+        A0[i] = An[i] = (x[i] + y[i] + z[i])/3;
+        Q[i] = max(max(abs(A0[i]-x[i]), abs(A0[i]-y[i])), abs(A0[i]-z[i]))
+          / tol;
+        x0[i] = x[i]; y0[i] = y[i]; z0[i] = z[i]; mul[i] = 1;
+      }
+      for (;;) {
+        int nact = 0;
+        for (size_t i = 0; i < m; ++i) {
+          bool act = Q[i] >= mul[i] * abs(An[i]);
+          T sx = sqrt(x0[i]), sy = sqrt(y0[i]), sz = sqrt(z0[i]),
+            lam = sx*sy + sy*sz + sz*sx;
+          An[i] = act ? (An[i] + lam)/4 : An[i];
+          x0[i] = act ? (x0[i] + lam)/4 : x0[i];
+          y0[i] = act ? (y0[i] + lam)/4 : y0[i];
+          z0[i] = act ? (z0[i] + lam)/4 : z0[i];
+          mul[i] = act ? mul[i] * 4 : mul[i];
+          nact += act ? 1 : 0;
+        }
+        if (nact == 0) break;
+      }
+      for (size_t i = 0; i < m; ++i) {
+        T
+          X = (A0[i] - x[i]) / (mul[i] * An[i]),
+          Y = (A0[i] - y[i]) / (mul[i] * An[i]),
+          Z = - (X + Y),
+          E2 = X*Y - Z*Z,
+          E3 = X*Y*Z;
+        rf[i] = (E3 * (6930 * E3 + E2 * (15015 * E2 - 16380) + 17160) +
+                 E2 * ((10010 - 5775 * E2) * E2 - 24024) + 240240) /
+          (240240 * sqrt(An[i]));
+      }
+    }
+
+    template<typename T> GEOGRAPHICLIB_KERNEL_INLINE
+    void rdkernel(size_t m, const T x[], const T y[], const T z[], T rd[],
+                  T tol) {
+      T A0[ellblock], An[ellblock], Q[ellblock],
+        x0[ellblock], y0[ellblock], z0[ellblock], mul[ellblock], s[ellblock];
+      for (size_t i = 0; i < m; ++i) {
+        A0[i] = An[i] = (x[i] + y[i] + 3*z[i])/5;
+        Q[i] = max(max(abs(A0[i]-x[i]), abs(A0[i]-y[i])), abs(A0[i]-z[i]))
+          / tol;
+        x0[i] = x[i]; y0[i] = y[i]; z0[i] = z[i]; mul[i] = 1; s[i] = 0;
+      }
+      for (;;) {
+        int nact = 0;
+        for (size_t i = 0; i < m; ++i) {
+          bool act = Q[i] >= mul[i] * abs(An[i]);
+          T sx = sqrt(x0[i]), sy = sqrt(y0[i]), sz = sqrt(z0[i]),
+            lam = sx*sy + sy*sz + sz*sx;
+          s[i] = act ? s[i] + 1/(mul[i] * sz * (z0[i] + lam)) : s[i];
+          An[i] = act ? (An[i] + lam)/4 : An[i];
+          x0[i] = act ? (x0[i] + lam)/4 : x0[i];
+          y0[i] = act ? (y0[i] + lam)/4 : y0[i];
+          z0[i] = act ? (z0[i] + lam)/4 : z0[i];
+          mul[i] = act ? mul[i] * 4 : mul[i];
+          nact += act ? 1 : 0;
+        }
+        if (nact == 0) break;
+      }
+      for (size_t i = 0; i < m; ++i) {
+        T
+          X = (A0[i] - x[i]) / (mul[i] * An[i]),
+          Y = (A0[i] - y[i]) / (mul[i] * An[i]),
+          Z = -(X + Y) / 3,
+          E2 = X*Y - 6*Z*Z,
+          E3 = (3*X*Y - 8*Z*Z)*Z,
+          E4 = 3 * (X*Y - Z*Z) * Z*Z,
+          E5 = X*Y*Z*Z*Z;
+        rd[i] = ((471240 - 540540 * E2) * E5 +
+                 (612612 * E2 - 540540 * E3 - 556920) * E4 +
+                 E3 * (306306 * E3 + E2 * (675675 * E2 - 706860) + 680680) +
+                 E2 * ((417690 - 255255 * E2) * E2 - 875160) + 4084080) /
+          (4084080 * mul[i] * An[i] * sqrt(An[i])) + 3 * s[i];
+      }
+    }
+
+    // The variants of the kernels
+    void rfgeneric(size_t m, const real x[], const real y[], const real z[],
+                   real rf[], real tol)
+    { rfkernel(m, x, y, z, rf, tol); }
+    void rdgeneric(size_t m, const real x[], const real y[], const real z[],
+                   real rd[], real tol)
+    { rdkernel(m, x, y, z, rd, tol); }
+#if GEOGRAPHICLIB_DISPATCH && GEOGRAPHICLIB_PRECISION <= 3
+    GEOGRAPHICLIB_TARGET_AVX2
+    void rfavx2(size_t m, const real x[], const real y[], const real z[],
+                real rf[], real tol)
+    { rfkernel(m, x, y, z, rf, tol); }
+    GEOGRAPHICLIB_TARGET_AVX2
+    void rdavx2(size_t m, const real x[], const real y[], const real z[],
+                real rd[], real tol)
+    { rdkernel(m, x, y, z, rd, tol); }
+    GEOGRAPHICLIB_TARGET_AVX512
+    void rfavx512(size_t m, const real x[], const real y[], const real z[],
+                  real rf[], real tol)
+    { rfkernel(m, x, y, z, rf, tol); }
+    GEOGRAPHICLIB_TARGET_AVX512
+    void rdavx512(size_t m, const real x[], const real y[], const real z[],
+                  real rd[], real tol)
+    { rdkernel(m, x, y, z, rd, tol); }
+#endif
+
+    // The table of kernels, set on first use.  There are no vector variants
+    // for the multi-precision types.
+    struct ellkernels {
+      void (*rf)(size_t, const real*, const real*, const real*, real*, real);
+      void (*rd)(size_t, const real*, const real*, const real*, real*, real);
+      ellkernels()
+#if GEOGRAPHICLIB_PRECISION <= 3
+        : rf(GEOGRAPHICLIB_DISPATCH_SELECT(&rfgeneric, &rfavx2, &rfavx512))
+        , rd(GEOGRAPHICLIB_DISPATCH_SELECT(&rdgeneric, &rdavx2, &rdavx512))
+#else
+        : rf(&rfgeneric)
+        , rd(&rdgeneric)
+#endif
+      {}
+    };
+
+    const ellkernels& kernels() {
+      static const ellkernels k;
+      return k;
+    }
+
+    // Apply the trig-like symmetries to the unsymmetrized integral I with
+    // complete integral C, as in F(sn, cn, dn), etc.
+    real symmetrize(real I, real sn, real cn, real C) {
+      if (cn < 0)
+        I = 2 * C - I;
+      return copysign(I, sn);
+    }
+  }
+
   void EllipticFunction::Reset(real k2, real alpha2,
                                real kp2, real alphap2) {
     // Accept nans here (needed for GeodesicExact)
@@ -312,33 +465,41 @@ namespace GeographicLib {
    *   Numericshe Mathematik 7, 78-90 (1965)
    */
 
-  void EllipticFunction::sncndn(real x, real& sn, real& cn, real& dn) const {
-    // Bulirsch's sncndn routine, p 89.
+  unsigned EllipticFunction::Landen(real m[], real n[],
+                                    real& c, real& d) const {
+    // The first part of Bulirsch's sncndn routine, which depends only on k.
     static const real tolJAC =
       sqrt(numeric_limits<real>::epsilon() * real(0.01));
-    if (_kp2 != 0) {
-      real mc = _kp2, d = 0;
-      if (_kp2 < 0) {
-        d = 1 - mc;
-        mc /= -d;
-        d = sqrt(d);
-        x *= d;
-      }
-      real c = 0;           // To suppress warning about uninitialized variable
-      real m[num_], n[num_];
-      unsigned l = 0;
-      for (real a = 1; l < num_ || GEOGRAPHICLIB_PANIC; ++l) {
-        // This converges quadratically.  Max 5 trips
-        m[l] = a;
-        n[l] = mc = sqrt(mc);
-        c = (a + mc) / 2;
-        if (!(abs(a - mc) > tolJAC * a)) {
-          ++l;
-          break;
-        }
-        mc *= a;
-        a = c;
+    real mc = _kp2;
+    d = 0;
+    if (_kp2 < 0) {
+      d = 1 - mc;
+      mc /= -d;
+      d = sqrt(d);
+    }
+    c = 0;                  // To suppress warning about uninitialized variable
+    unsigned l = 0;
+    for (real a = 1; l < num_ || GEOGRAPHICLIB_PANIC; ++l) {
+      // This converges quadratically.  Max 5 trips
+      m[l] = a;
+      n[l] = mc = sqrt(mc);
+      c = (a + mc) / 2;
+      if (!(abs(a - mc) > tolJAC * a)) {
+        ++l;
+        break;
       }
+      mc *= a;
+      a = c;
+    }
+    return l;
+  }
+
+  void EllipticFunction::sncndn(real x, real& sn, real& cn, real& dn) const {
+    // Bulirsch's sncndn routine, p 89.
+    if (_kp2 != 0) {
+      real c, d, m[num_], n[num_];
+      unsigned l = Landen(m, n, c, d);
+      if (_kp2 < 0) x *= d;
       x *= c;
       sn = sin(x);
       cn = cos(x);
@@ -567,4 +728,191 @@ namespace GeographicLib {
     return Einv( tau * E() / (Math::pi()/2) ) - tau;
   }
 
+  void EllipticFunction::IntBlock(inttype t, size_t m, const real sn[],
+                                  const real cn[], const real dn[],
+                                  real I[]) const {
+    static const real
+      tolRF = pow(3 * numeric_limits<real>::epsilon() * real(0.01),
+                  1/real(8)),
+      tolRD = pow(real(0.2) * (numeric_limits<real>::epsilon() * real(0.01)),
+                  1/real(8));
+    real cn2[ellblock], dn2[ellblock], one[ellblock],
+      rf[ellblock], rd[ellblock];
+    for (size_t i = 0; i < m; ++i) {
+      // The scalar routines don't evaluate the symmetric integrals if cn2 =
+      // 0; substitute harmless arguments, since RF(0, 0, 1) doesn't converge.
+      bool z = cn[i]*cn[i] == 0;
+      cn2[i] = z ? 1 : cn[i]*cn[i];
+      dn2[i] = z ? 1 : dn[i]*dn[i];
+      one[i] = 1;
+    }
+    const ellkernels& k = kernels();
+    if (t == INTD)
+      k.rd(m, cn2, dn2, one, rd, tolRD);
+    else if (t == INTE && _k2 > 0 && _kp2 < 0)
+      k.rd(m, dn2, one, cn2, rd, tolRD);
+    else {
+      k.rf(m, cn2, dn2, one, rf, tolRF);
+      if (t == INTE)
+        k.rd(m, cn2, _k2 <= 0 ? dn2 : one, _k2 <= 0 ? one : dn2,
+             rd, tolRD);
+    }
+    // The rest follows F(sn, cn, dn), etc., exactly.
+    for (size_t i = 0; i < m; ++i) {
+      real s = sn[i], c = cn[i], d = dn[i],
+        c2 = c*c, d2 = d*d, s2 = s*s;
+      if (c2 == 0) {
+        switch (t) {
+        case INTF:  I[i] = K();  break;
+        case INTE:  I[i] = E();  break;
+        case INTD:  I[i] = D();  break;
+        case INTPI: I[i] = Pi(); break;
+        case INTG:  I[i] = G();  break;
+        default:    I[i] = H();  break;
+        }
+        continue;
+      }
+      switch (t) {
+      case INTF:
+        I[i] = abs(s) * rf[i];
+        break;
+      case INTE:
+        I[i] = abs(s) * ( _k2 <= 0 ?
+                          rf[i] - _k2 * s2 * rd[i] / 3 :
+                          ( _kp2 >= 0 ?
+                            _kp2 * rf[i] +
+                            _k2 * _kp2 * s2 * rd[i] / 3 +
+                            _k2 * abs(c) / d :
+                            - _kp2 * s2 * rd[i] / 3 +
+                            d / abs(c) ) );
+        break;
+      case INTD:
+        I[i] = abs(s) * s2 * rd[i] / 3;
+        break;
+      case INTPI:
+        I[i] = abs(s) * (rf[i] +
+                         _alpha2 * s2 * RJ(c2, d2, 1, c2 + _alphap2 * s2) / 3);
+        break;
+      case INTG:
+        I[i] = abs(s) * (rf[i] +
+                         (_alpha2 - _k2) * s2 *
+                         RJ(c2, d2, 1, c2 + _alphap2 * s2) / 3);
+        break;
+      default:
+        I[i] = abs(s) * (rf[i] -
+                         _alphap2 * s2 *
+                         RJ(c2, d2, 1, c2 + _alphap2 * s2) / 3);
+        break;
+      }
+    }
+  }
+
+  void EllipticFunction::IntBatch(inttype t, size_t n, const real phi[],
+                                  real I[]) const {
+    real C;
+    switch (t) {
+    case INTF:  C = K();  break;
+    case INTE:  C = E();  break;
+    case INTD:  C = D();  break;
+    case INTPI: C = Pi(); break;
+    case INTG:  C = G();  break;
+    default:    C = H();  break;
+    }
+    real sn[ellblock], cn[ellblock], dn[ellblock], I0[ellblock];
+    for (size_t i0 = 0; i0 < n; i0 += ellblock) {
+      size_t m = n - i0 < ellblock ? n - i0 : ellblock;
+      const real* p = phi + i0;
+      for (size_t i = 0; i < m; ++i) {
+        sn[i] = sin(p[i]); cn[i] = cos(p[i]); dn[i] = Delta(sn[i], cn[i]);
+      }
+      IntBlock(t, m, sn, cn, dn, I0);
+      for (size_t i = 0; i < m; ++i) {
+        real s = sn[i], c = cn[i], x = p[i];
+        if (abs(x) < Math::pi())
+          I[i0 + i] = symmetrize(I0[i], s, c, C);
+        else {
+          // As in deltaF, etc.; the unsymmetrized integral is unchanged by
+          // the reflection.
+          if (c < 0) { c = -c; s = -s; }
+          real delta = symmetrize(I0[i], s, c, C) * (Math::pi()/2) / C
+            - atan2(s, c);
+          I[i0 + i] = (delta + x) * C / (Math::pi()/2);
+        }
+      }
+    }
+  }
+
+  void EllipticFunction::EdBatch(size_t n, const real ang[], real E[]) const {
+    real a[ellblock], q[ellblock],
+      sn[ellblock], cn[ellblock], dn[ellblock], I0[ellblock];
+    for (size_t i0 = 0; i0 < n; i0 += ellblock) {
+      size_t m = n - i0 < ellblock ? n - i0 : ellblock;
+      for (size_t i = 0; i < m; ++i) {
+        q[i] = ceil(ang[i0 + i]/360 - real(0.5));
+        a[i] = ang[i0 + i] - 360 * q[i];
+      }
+      Math::sincosdBatch(m, a, sn, cn);
+      for (size_t i = 0; i < m; ++i)
+        dn[i] = Delta(sn[i], cn[i]);
+      IntBlock(INTE, m, sn, cn, dn, I0);
+      for (size_t i = 0; i < m; ++i)
+        E[i0 + i] = symmetrize(I0[i], sn[i], cn[i], this->E())
+          + 4 * this->E() * q[i];
+    }
+  }
+
+  void EllipticFunction::sncndnBatch(size_t n, const real x[],
+                                     real sn[], real cn[], real dn[]) const {
+    if (_kp2 == 0) {
+      for (size_t i = 0; i < n; ++i) {
+        real t = x[i];
+        sn[i] = tanh(t);
+        dn[i] = cn[i] = 1 / cosh(t);
+      }
+      return;
+    }
+    real c, d, m[num_], nn[num_];
+    unsigned l = Landen(m, nn, c, d);
+    real s[ellblock], co[ellblock], a[ellblock], cc[ellblock], dd[ellblock];
+    for (size_t i0 = 0; i0 < n; i0 += ellblock) {
+      size_t mb = n - i0 < ellblock ? n - i0 : ellblock;
+      for (size_t i = 0; i < mb; ++i) {
+        real t = x[i0 + i];
+        if (_kp2 < 0) t *= d;
+        t *= c;
+        s[i] = sin(t); co[i] = cos(t);
+      }
+      // The back recurrence of sncndn in lockstep; the results for sn = 0
+      // are discarded.
+      for (size_t i = 0; i < mb; ++i) {
+        a[i] = co[i] / s[i];
+        cc[i] = c * a[i];
+        dd[i] = 1;
+      }
+      for (unsigned j = l; j--;) {
+        real b = m[j], nj = nn[j];
+        for (size_t i = 0; i < mb; ++i) {
+          a[i] *= cc[i];
+          cc[i] *= dd[i];
+          dd[i] = (nj + a[i]) / (b + a[i]);
+          a[i] = cc[i] / b;
+        }
+      }
+      for (size_t i = 0; i < mb; ++i) {
+        real si = s[i], ci = co[i], di = 1;
+        if (si != 0) {
+          real t = 1 / sqrt(cc[i]*cc[i] + 1);
+          si = si < 0 ? -t : t;
+          ci = cc[i] * si;
+          di = dd[i];
+          if (_kp2 < 0) {
+            swap(ci, di);
+            si /= d;
+          }
+        }
+        sn[i0 + i] = si; cn[i0 + i] = ci; dn[i0 + i] = di;
+      }
+    }
+  }
+
 } // namespace GeographicLib
@@ -0,0 +1,122 @@
+/**
+ * \file ExactAccumulator.cpp
+ * \brief Implementation for GeographicLib::ExactAccumulator class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/ExactAccumulator.hpp>
+#include <limits>
+#include <vector>
+#include <GeographicLib/Executor.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  void ExactAccumulator::AddNonFinite(double y) {
+    using std::isnan;
+    if (isnan(y))
+      _nan = true;
+    else if (y > 0)
+      _pinf = true;
+    else
+      _ninf = true;
+  }
+
+  void ExactAccumulator::Normalize() {
+    for (int k = 0; k < ndigits_ - 1; ++k) {
+      // lo = _d[k] mod 2^32; the division is exact
+      long long
+        lo = (long long)((unsigned long long)(_d[k]) & mask_),
+        c = (_d[k] - lo) / (1LL << 32);
+      _d[k] = lo;
+      _d[k + 1] += c;
+    }
+    _pending = 0;
+  }
+
+  void ExactAccumulator::Negate() {
+    for (int k = 0; k < ndigits_; ++k)
+      _d[k] = -_d[k];
+    swap(_pinf, _ninf);
+  }
+
+  void ExactAccumulator::Merge(const ExactAccumulator& a, bool negate) {
+    // After normalizing, the digits are less than 2^32 and those of a are
+    // less than (a._pending + 1) * 2^32.  (a may be *this.)
+    Normalize();
+    unsigned pending = a._pending + 1;
+    bool nan = a._nan,
+      pinf = negate ? a._ninf : a._pinf,
+      ninf = negate ? a._pinf : a._ninf;
+    if (negate)
+      for (int k = 0; k < ndigits_; ++k) _d[k] -= a._d[k];
+    else
+      for (int k = 0; k < ndigits_; ++k) _d[k] += a._d[k];
+    _nan = _nan || nan;
+    _pinf = _pinf || pinf;
+    _ninf = _ninf || ninf;
+    _pending = pending;
+    if (_pending >= maxpending_) Normalize();
+  }
+
+  double ExactAccumulator::operator()() const {
+    const double inf = numeric_limits<double>::infinity();
+    if (_nan || (_pinf && _ninf))
+      return numeric_limits<double>::quiet_NaN();
+    if (_pinf || _ninf)
+      return _pinf ? inf : -inf;
+    ExactAccumulator a(*this);
+    a.Normalize();
+    // Work with the magnitude of the sum
+    bool neg = a._d[ndigits_ - 1] < 0;
+    if (neg) {
+      a.Negate();
+      a.Normalize();
+    }
+    int k = ndigits_ - 1;
+    while (k >= 0 && a._d[k] == 0) --k;
+    if (k < 0)
+      return 0;
+    if (k == ndigits_ - 1)      // the sum is at least 2^1070
+      return neg ? -inf : inf;
+    // Assemble the leading 64 bits of the sum in u, with the leading bit in
+    // bit 63; bit 0 is set if any of the following bits are set.  The
+    // conversion to double then gives the correctly rounded result.  If the
+    // result is subnormal, all the bits fit in u and the result is exact.
+    unsigned long long
+      d2 = (unsigned long long)(a._d[k]),
+      d1 = k >= 1 ? (unsigned long long)(a._d[k - 1]) : 0,
+      d0 = k >= 2 ? (unsigned long long)(a._d[k - 2]) : 0;
+    int z = 0;
+    while (!((d2 << z) & 0x80000000ULL)) ++z;
+    unsigned long long u = (((d2 << 32) | d1) << z) | (z ? d0 >> (32 - z) : 0);
+    bool sticky = ((d0 << z) & mask_) != 0;
+    for (int j = k - 3; j >= 0 && !sticky; --j)
+      sticky = a._d[j] != 0;
+    if (sticky) u |= 1;
+    double r = ldexp(double(u), 32 * (k - 1) - bias_ - z);
+    return neg ? -r : r;
+  }
+
+  ExactAccumulator& ExactAccumulator::Add(size_t n, const double y[],
+                                          unsigned threads) {
+    const size_t block = 1 << 16, nblocks = (n + block - 1) / block;
+    if (threads == 1 || nblocks <= 1) {
+      for (size_t i = 0; i < n; ++i) Add(y[i]);
+      return *this;
+    }
+    vector<ExactAccumulator> part(nblocks);
+    Executor::Parallel(nblocks, threads, [&](size_t b) -> void {
+      for (size_t i = b * block; i < min(n, (b + 1) * block); ++i)
+        part[b].Add(y[i]);
+    });
+    for (size_t b = 0; b < nblocks; ++b)
+      *this += part[b];
+    return *this;
+  }
+
+} // namespace GeographicLib
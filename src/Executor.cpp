@@ -0,0 +1,99 @@
+/**
+ * \file Executor.cpp
+ * \brief Implementation for GeographicLib::Executor class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <GeographicLib/Executor.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    // The installed executor (null means the default) and its lock
+    struct Installed {
+      mutex lock;
+      shared_ptr<Executor> exec;
+    };
+
+    Installed& installed() {
+      static Installed i;
+      return i;
+    }
+
+    shared_ptr<Executor> DefaultExecutor() {
+      static const shared_ptr<Executor> exec = make_shared<ThreadExecutor>();
+      return exec;
+    }
+  }
+
+  void Executor::Set(shared_ptr<Executor> exec) {
+    Installed& i = installed();
+    lock_guard<mutex> g(i.lock);
+    i.exec = exec;
+  }
+
+  shared_ptr<Executor> Executor::Get() {
+    {
+      Installed& i = installed();
+      lock_guard<mutex> g(i.lock);
+      if (i.exec) return i.exec;
+    }
+    return DefaultExecutor();
+  }
+
+  void Executor::Parallel(size_t ntasks, unsigned threads,
+                          const function<void(size_t)>& task) {
+    if (threads == 0) threads = thread::hardware_concurrency();
+    if (threads <= 1 || ntasks <= 1) {
+      for (size_t k = 0; k < ntasks; ++k) task(k);
+      return;
+    }
+    Get()->Run(ntasks, unsigned(min(size_t(threads), ntasks)), task);
+  }
+
+  void ThreadExecutor::Run(size_t ntasks, unsigned threads,
+                           const function<void(size_t)>& task) {
+    atomic<size_t> next(0);
+    // An exception in a worker thread (e.g., std::bad_alloc) is caught and
+    // rethrown by the calling thread.
+    exception_ptr err;
+    mutex lock;
+    auto worker = [&]() -> void {
+      try {
+        for (size_t k; (k = next++) < ntasks;)
+          task(k);
+      }
+      catch (...) {
+        lock_guard<mutex> g(lock);
+        if (!err) err = current_exception();
+        next = ntasks;          // Stop the other workers
+      }
+    };
+    size_t nthreads = min(size_t(threads), ntasks);
+    vector<thread> pool;
+    if (nthreads > 1) pool.reserve(nthreads - 1);
+    try {
+      for (size_t k = 1; k < nthreads; ++k)
+        pool.push_back(thread(worker));
+    }
+    catch (const system_error&) {
+      // Couldn't start all the threads; carry on with the ones we've got.
+    }
+    worker();
+    for (auto& th : pool) th.join();
+    if (err) rethrow_exception(err);
+  }
+
+} // namespace GeographicLib
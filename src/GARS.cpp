@@ -17,108 +17,276 @@ namespace GeographicLib {
   const char* const GARS::digits_ = "0123456789";
   const char* const GARS::letters_ = "ABCDEFGHJKLMNPQRSTUVWXYZ";
 
-  void GARS::Forward(real lat, real lon, int prec, string& gars) {
-    using std::isnan;           // Needed for Centos 7, ubuntu 14
-    if (abs(lat) > 90)
-      throw GeographicErr("Latitude " + Utility::str(lat)
-                          + "d not in [-90d, 90d]");
-    if (isnan(lat) || isnan(lon)) {
-      gars = "INVALID";
-      return;
-    }
+  void GARS::Indices(real lat, real lon, int& x, int& y) {
     lon = Math::AngNormalize(lon);
     if (lon == 180) lon = -180; // lon now in [-180,180)
     if (lat == 90) lat *= (1 - numeric_limits<real>::epsilon() / 2);
-    prec = max(0, min(int(maxprec_), prec));
+    x = int(floor(lon * m_)) - lonorig_ * m_;
+    y = int(floor(lat * m_)) - latorig_ * m_;
+  }
+
+  void GARS::Chars(int x, int y, int prec, char gars[]) {
     int
-      x = int(floor(lon * m_)) - lonorig_ * m_,
-      y = int(floor(lat * m_)) - latorig_ * m_,
       ilon = x * mult1_ / m_,
       ilat = y * mult1_ / m_;
     x -= ilon * m_ / mult1_; y -= ilat * m_ / mult1_;
-    char gars1[maxlen_];
     ++ilon;
     for (int c = lonlen_; c--;) {
-      gars1[c] = digits_[ ilon % baselon_]; ilon /= baselon_;
+      gars[c] = digits_[ ilon % baselon_]; ilon /= baselon_;
     }
     for (int c = latlen_; c--;) {
-      gars1[lonlen_ + c] = letters_[ilat % baselat_]; ilat /= baselat_;
+      gars[lonlen_ + c] = letters_[ilat % baselat_]; ilat /= baselat_;
     }
     if (prec > 0) {
       ilon = x / mult3_; ilat = y / mult3_;
-      gars1[baselen_] = digits_[mult2_ * (mult2_ - 1 - ilat) + ilon + 1];
+      gars[baselen_] = digits_[mult2_ * (mult2_ - 1 - ilat) + ilon + 1];
       if (prec > 1) {
         ilon = x % mult3_; ilat = y % mult3_;
-        gars1[baselen_ + 1] = digits_[mult3_ * (mult3_ - 1 - ilat) + ilon + 1];
+        gars[baselen_ + 1] = digits_[mult3_ * (mult3_ - 1 - ilat) + ilon + 1];
       }
     }
+  }
+
+  void GARS::Forward(real lat, real lon, int prec, string& gars) {
+    using std::isnan;           // Needed for Centos 7, ubuntu 14
+    if (abs(lat) > 90)
+      throw GeographicErr("Latitude " + Utility::str(lat)
+                          + "d not in [-90d, 90d]");
+    if (isnan(lat) || isnan(lon)) {
+      gars = "INVALID";
+      return;
+    }
+    prec = max(0, min(int(maxprec_), prec));
+    int x, y;
+    Indices(lat, lon, x, y);
+    char gars1[maxlen_];
+    Chars(x, y, prec, gars1);
     gars.resize(baselen_ + prec);
     copy(gars1, gars1 + baselen_ + prec, gars.begin());
   }
 
-  void GARS::Reverse(const string& gars, real& lat, real& lon,
-                     int& prec, bool centerp) {
-    int len = int(gars.length());
-    if (len >= 3 &&
-        toupper(gars[0]) == 'I' &&
-        toupper(gars[1]) == 'N' &&
-        toupper(gars[2]) == 'V') {
-      lat = lon = Math::NaN();
-      return;
+  GARS::status GARS::ParseChars(const char* gars, int len, int& x, int& y,
+                                int& prec, bool throwp) {
+    if (len < baselen_) {
+      if (!throwp) return BADSTRING;
+      throw GeographicErr("GARS must have at least 5 characters "
+                          + string(gars, len));
+    }
+    if (len > maxlen_) {
+      if (!throwp) return BADSTRING;
+      throw GeographicErr("GARS can have at most 7 characters "
+                          + string(gars, len));
     }
-    if (len < baselen_)
-      throw GeographicErr("GARS must have at least 5 characters " + gars);
-    if (len > maxlen_)
-      throw GeographicErr("GARS can have at most 7 characters " + gars);
     int prec1 = len - baselen_;
     int ilon = 0;
     for (int c = 0; c < lonlen_; ++c) {
       int k = Utility::lookup(digits_, gars[c]);
-      if (k < 0)
-        throw GeographicErr("GARS must start with 3 digits " + gars);
+      if (k < 0) {
+        if (!throwp) return BADSTRING;
+        throw GeographicErr("GARS must start with 3 digits "
+                            + string(gars, len));
+      }
       ilon = ilon * baselon_ + k;
     }
-    if (!(ilon >= 1 && ilon <= 720))
-        throw GeographicErr("Initial digits in GARS must lie in [1, 720] " +
-                            gars);
+    if (!(ilon >= 1 && ilon <= 720)) {
+      if (!throwp) return BADSTRING;
+      throw GeographicErr("Initial digits in GARS must lie in [1, 720] " +
+                          string(gars, len));
+    }
     --ilon;
     int ilat = 0;
     for (int c = 0; c < latlen_; ++c) {
       int k = Utility::lookup(letters_, gars[lonlen_ + c]);
-      if (k < 0)
-        throw GeographicErr("Illegal letters in GARS " + gars.substr(3,2));
+      if (k < 0) {
+        if (!throwp) return BADSTRING;
+        throw GeographicErr("Illegal letters in GARS " + string(gars + 3, 2));
+      }
       ilat = ilat * baselat_ + k;
     }
-    if (!(ilat < 360))
-      throw  GeographicErr("GARS letters must lie in [AA, QZ] " + gars);
-    real
-      unit = mult1_,
-      lat1 = ilat + latorig_ * unit,
-      lon1 = ilon + lonorig_ * unit;
+    if (!(ilat < 360)) {
+      if (!throwp) return BADSTRING;
+      throw GeographicErr("GARS letters must lie in [AA, QZ] "
+                          + string(gars, len));
+    }
     if (prec1 > 0) {
       int k = Utility::lookup(digits_, gars[baselen_]);
-      if (!(k >= 1 && k <= mult2_ * mult2_))
-        throw GeographicErr("6th character in GARS must [1, 4] " + gars);
+      if (!(k >= 1 && k <= mult2_ * mult2_)) {
+        if (!throwp) return BADSTRING;
+        throw GeographicErr("6th character in GARS must [1, 4] "
+                            + string(gars, len));
+      }
       --k;
-      unit *= mult2_;
-      lat1 = mult2_ * lat1 + (mult2_ - 1 - k / mult2_);
-      lon1 = mult2_ * lon1 + (k % mult2_);
+      ilat = mult2_ * ilat + (mult2_ - 1 - k / mult2_);
+      ilon = mult2_ * ilon + (k % mult2_);
       if (prec1 > 1) {
         k = Utility::lookup(digits_, gars[baselen_ + 1]);
-        if (!(k >= 1 /* && k <= mult3_ * mult3_ */))
-          throw GeographicErr("7th character in GARS must [1, 9] " + gars);
+        if (!(k >= 1 /* && k <= mult3_ * mult3_ */)) {
+          if (!throwp) return BADSTRING;
+          throw GeographicErr("7th character in GARS must [1, 9] "
+                              + string(gars, len));
+        }
         --k;
-        unit *= mult3_;
-        lat1 = mult3_ * lat1 + (mult3_ - 1 - k / mult3_);
-        lon1 = mult3_ * lon1 + (k % mult3_);
+        ilat = mult3_ * ilat + (mult3_ - 1 - k / mult3_);
+        ilon = mult3_ * ilon + (k % mult3_);
       }
     }
+    x = ilon; y = ilat;
+    prec = prec1;
+    return OK;
+  }
+
+  GARS::status GARS::ReverseChars(const char* gars, int len,
+                                  real& lat, real& lon, int& prec,
+                                  bool centerp, bool throwp) {
+    if (len >= 3 &&
+        toupper(gars[0]) == 'I' &&
+        toupper(gars[1]) == 'N' &&
+        toupper(gars[2]) == 'V') {
+      lat = lon = Math::NaN();
+      return OK;
+    }
+    int x, y, prec1;
+    status st = ParseChars(gars, len, x, y, prec1, throwp);
+    if (st != OK) return st;
+    real
+      unit = Mult(prec1),
+      lat1 = y + latorig_ * unit,
+      lon1 = x + lonorig_ * unit;
+    if (centerp) {
+      unit *= 2; lat1 = 2 * lat1 + 1; lon1 = 2 * lon1 + 1;
+    }
+    lat = lat1 / unit;
+    lon = lon1 / unit;
+    prec = prec1;
+    return OK;
+  }
+
+  void GARS::Reverse(const string& gars, real& lat, real& lon,
+                     int& prec, bool centerp) {
+    ReverseChars(gars.data(), int(gars.length()), lat, lon, prec, centerp,
+                 true);
+  }
+
+  GARS::status GARS::Reverse(const char* gars, size_t len,
+                             real& lat, real& lon, int& prec, bool centerp) {
+    if (len > size_t(numeric_limits<int>::max())) return BADSTRING;
+    return ReverseChars(gars, int(len), lat, lon, prec, centerp, false);
+  }
+
+  GARS::status GARS::Forward(real lat, real lon, int prec,
+                             unsigned long long& id) {
+    using std::isnan;
+    if (abs(lat) > 90)
+      return BADLATITUDE;
+    if (isnan(lat) || isnan(lon))
+      return BADCOORDS;
+    prec = max(0, min(int(maxprec_), prec));
+    int x, y, d = m_ / Mult(prec);
+    Indices(lat, lon, x, y);
+    id = (unsigned long long)(y / d) * (-2 * lonorig_ * Mult(prec)) + x / d;
+    return OK;
+  }
+
+  GARS::status GARS::Reverse(unsigned long long id, int prec,
+                             real& lat, real& lon, bool centerp) {
+    prec = max(0, min(int(maxprec_), prec));
+    int mult = Mult(prec);
+    unsigned long long nlon = -2 * lonorig_ * mult;
+    if (id >= nlon * (-2 * latorig_ * mult))
+      return BADCELLID;
+    real
+      unit = mult,
+      lat1 = real(id / nlon) + latorig_ * unit,
+      lon1 = real(id % nlon) + lonorig_ * unit;
     if (centerp) {
       unit *= 2; lat1 = 2 * lat1 + 1; lon1 = 2 * lon1 + 1;
     }
     lat = lat1 / unit;
     lon = lon1 / unit;
+    return OK;
+  }
+
+  size_t GARS::ForwardBatch(size_t n, const real lat[], const real lon[],
+                            int prec, unsigned long long id[],
+                            status stat[]) {
+    size_t nbad = 0;
+    for (size_t i = 0; i < n; ++i) {
+      status st = Forward(lat[i], lon[i], prec, id[i]);
+      if (st != OK) {
+        ++nbad;
+        id[i] = ~0ULL;
+      }
+      if (stat) stat[i] = st;
+    }
+    return nbad;
+  }
+
+  size_t GARS::ReverseBatch(size_t n, const unsigned long long id[],
+                            int prec, real lat[], real lon[], bool centerp,
+                            status stat[]) {
+    size_t nbad = 0;
+    for (size_t i = 0; i < n; ++i) {
+      status st = Reverse(id[i], prec, lat[i], lon[i], centerp);
+      if (st != OK) {
+        ++nbad;
+        lat[i] = lon[i] = Math::NaN();
+      }
+      if (stat) stat[i] = st;
+    }
+    return nbad;
+  }
+
+  GARS::status GARS::CellId(const char* gars, size_t len,
+                            unsigned long long& id, int& prec) {
+    if (len > size_t(maxlen_)) return BADSTRING;
+    int x, y, prec1;
+    status st = ParseChars(gars, int(len), x, y, prec1, false);
+    if (st != OK) return st;
+    id = (unsigned long long)y * (-2 * lonorig_ * Mult(prec1)) + x;
     prec = prec1;
+    return OK;
+  }
+
+  GARS::status GARS::CellString(unsigned long long id, int prec,
+                                char gars[], size_t size) {
+    prec = max(0, min(int(maxprec_), prec));
+    int mult = Mult(prec), d = m_ / mult;
+    unsigned long long nlon = -2 * lonorig_ * mult;
+    if (id >= nlon * (-2 * latorig_ * mult))
+      return BADCELLID;
+    if (size < size_t(baselen_ + prec) + 1)
+      return BUFFERTOOSMALL;
+    Chars(int(id % nlon) * d, int(id / nlon) * d, prec, gars);
+    gars[baselen_ + prec] = '\0';
+    return OK;
+  }
+
+  GARS::status GARS::Adjacent(unsigned long long id, int prec,
+                              int dlat, int dlon, unsigned long long& adj) {
+    prec = max(0, min(int(maxprec_), prec));
+    int mult = Mult(prec);
+    long long nlon = -2 * lonorig_ * mult, nlat = -2 * latorig_ * mult;
+    if (id >= (unsigned long long)(nlon * nlat))
+      return BADCELLID;
+    long long
+      y = (long long)id / nlon + dlat,
+      x = ((long long)id % nlon + dlon) % nlon;
+    if (y < 0 || y >= nlat)
+      return BADLATITUDE;
+    if (x < 0) x += nlon;
+    adj = (unsigned long long)(y * nlon + x);
+    return OK;
+  }
+
+  int GARS::Neighbors(unsigned long long id, int prec,
+                      unsigned long long nbr[8]) {
+    static const int dlat[] = { 1, 1, 0, -1, -1, -1,  0,  1 };
+    static const int dlon[] = { 0, 1, 1,  1,  0, -1, -1, -1 };
+    int k = 0;
+    for (int i = 0; i < 8; ++i)
+      if (Adjacent(id, prec, dlat[i], dlon[i], nbr[k]) == OK)
+        ++k;
+    return k;
   }
 
 } // namespace GeographicLib
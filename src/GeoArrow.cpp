@@ -0,0 +1,339 @@
+/**
+ * \file GeoArrow.cpp
+ * \brief Implementation for GeographicLib::GeoArrow class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <memory>
+#include <type_traits>
+#include <GeographicLib/GeoArrow.hpp>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/Geoid.hpp>
+#include <GeographicLib/PolygonAreaBatch.hpp>
+#include <GeographicLib/UTMUPS.hpp>
+#include <GeographicLib/Utility.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+
+    typedef Math::real real;
+
+    // ARROW_FLAG_NULLABLE in the C data interface
+    const int64_t nullable_ = 2;
+
+    // The storage for an exported schema and array
+    struct SchemaData {
+      string format, name;
+    };
+
+    template<typename T>
+    struct ArrayData {
+      vector<T> values;
+      const void* buffers[2];
+    };
+
+    void ReleaseSchema(ArrowSchema* schema) {
+      delete static_cast<SchemaData*>(schema->private_data);
+      schema->release = nullptr;
+    }
+
+    template<typename T>
+    void ReleaseArray(ArrowArray* array) {
+      delete static_cast<ArrayData<T>*>(array->private_data);
+      array->release = nullptr;
+    }
+
+    // Export a column whose data buffer is values; length is the number of
+    // elements (which differs from values.size() for bit-packed booleans).
+    template<typename T>
+    void ExportBuffer(vector<T>&& values, size_t length, const char* format,
+                      const string& name,
+                      ArrowSchema* schema, ArrowArray* array) {
+      if (!(schema && array))
+        throw GeographicErr("GeoArrow: null output schema or array");
+      unique_ptr<SchemaData> s(new SchemaData());
+      unique_ptr<ArrayData<T> > a(new ArrayData<T>());
+      s->format = format; s->name = name;
+      a->values = move(values);
+      a->buffers[0] = nullptr;  // no validity bitmap: there are no nulls
+      a->buffers[1] = a->values.data();
+      schema->format = s->format.c_str();
+      schema->name = s->name.c_str();
+      schema->metadata = nullptr;
+      schema->flags = nullable_;
+      schema->n_children = 0;
+      schema->children = nullptr;
+      schema->dictionary = nullptr;
+      schema->release = ReleaseSchema;
+      schema->private_data = s.release();
+      array->length = int64_t(length);
+      array->null_count = 0;
+      array->offset = 0;
+      array->n_buffers = 2;
+      array->n_children = 0;
+      array->buffers = a->buffers;
+      array->children = nullptr;
+      array->dictionary = nullptr;
+      array->release = ReleaseArray<T>;
+      array->private_data = a.release();
+    }
+
+    vector<double> ToDouble(vector<double>&& v) { return move(v); }
+
+    template<typename T>
+    vector<double> ToDouble(vector<T>&& v) {
+      vector<double> d(v.size());
+      for (size_t i = 0; i < v.size(); ++i) d[i] = double(v[i]);
+      return d;
+    }
+
+    void ExportBool(const bool v[], size_t n, const string& name,
+                    ArrowSchema* schema, ArrowArray* array) {
+      vector<uint8_t> bits((n + 7) / 8, 0);
+      for (size_t i = 0; i < n; ++i)
+        if (v[i]) bits[i / 8] = uint8_t(bits[i / 8] | (1U << (i % 8)));
+      ExportBuffer(move(bits), n, "b", name, schema, array);
+    }
+
+    string Format(const ArrowSchema& schema) {
+      return schema.format ? string(schema.format) : string();
+    }
+
+    // Is element i (including the offset of the array) valid?
+    bool Valid(const ArrowArray& array, int64_t i) {
+      const uint8_t* v = array.n_buffers > 0 ?
+        static_cast<const uint8_t*>(array.buffers[0]) : nullptr;
+      return !v || (v[i / 8] >> (i % 8)) & 1;
+    }
+
+    bool MayHaveNulls(const ArrowArray& array) {
+      return array.null_count != 0 && array.n_buffers > 0 && array.buffers[0];
+    }
+
+    // Set data to point to elements first + i * stride of array (excluding
+    // its offset) for i in [0, n), copying them to buf if necessary.  If
+    // parent is not null, it's a struct or fixed size list array; the value
+    // is null if element i of parent is null.
+    void ReadValues(const ArrowSchema& schema, const ArrowArray& array,
+                    int64_t first, int64_t stride, size_t n,
+                    const ArrowArray* parent,
+                    vector<real>& buf, const real*& data) {
+      string f = Format(schema);
+      bool dbl = f == "g";
+      if (!(dbl || f == "f"))
+        throw GeographicErr("GeoArrow: expected a float64 or float32 column, "
+                            "not \"" + f + "\"");
+      if (array.n_buffers != 2)
+        throw GeographicErr("GeoArrow: bad floating point column");
+      if (n == 0) { buf.clear(); data = nullptr; return; }
+      int64_t i0 = array.offset + first;
+      if (!(i0 >= 0 && i0 + int64_t(n - 1) * stride < array.offset +
+            array.length))
+        throw GeographicErr("GeoArrow: floating point column is too short");
+      bool nulls = MayHaveNulls(array) || (parent && MayHaveNulls(*parent));
+      if (dbl && !nulls && stride == 1 && is_same<real, double>::value) {
+        buf.clear();
+        data = reinterpret_cast<const real*>
+          (static_cast<const double*>(array.buffers[1]) + i0);
+        return;
+      }
+      const double* d = static_cast<const double*>(array.buffers[1]);
+      const float* s = static_cast<const float*>(array.buffers[1]);
+      buf.resize(n);
+      for (size_t i = 0; i < n; ++i) {
+        int64_t j = i0 + int64_t(i) * stride;
+        buf[i] = !(Valid(array, j) &&
+                   (!parent || Valid(*parent, parent->offset + int64_t(i)))) ?
+          Math::NaN() : (dbl ? real(d[j]) : real(s[j]));
+      }
+      data = buf.data();
+    }
+
+    // Offset i (excluding the offset of the array) of a list array.
+    int64_t ListOffset(bool large, const ArrowArray& array, int64_t i) {
+      const void* b = array.buffers[1];
+      int64_t j = array.offset + i;
+      return large ? static_cast<const int64_t*>(b)[j] :
+        int64_t(static_cast<const int32_t*>(b)[j]);
+    }
+
+    bool ListFormat(const ArrowSchema& schema, const ArrowArray& array,
+                    bool& large) {
+      string f = Format(schema);
+      large = f == "+L";
+      return (large || f == "+l") && schema.n_children == 1 &&
+        array.n_children == 1 && array.n_buffers == 2;
+    }
+
+  } // anonymous namespace
+
+  void GeoArrow::Import(const ArrowSchema& schema, const ArrowArray& array,
+                        Column& col) {
+    col._n = size_t(array.length);
+    ReadValues(schema, array, 0, 1, col._n, nullptr, col._buf,
+               col._data);
+  }
+
+  void GeoArrow::ImportPoints(const ArrowSchema& schema,
+                              const ArrowArray& array,
+                              Column& lat, Column& lon) {
+    string f = Format(schema);
+    size_t n = size_t(array.length);
+    lat._n = lon._n = n;
+    if (f == "+s") {
+      // Separated encoding: a struct of x, y, ...
+      if (!(schema.n_children >= 2 && array.n_children == schema.n_children))
+        throw GeographicErr("GeoArrow: point struct needs x and y columns");
+      ReadValues(*schema.children[0], *array.children[0], array.offset, 1, n,
+                 &array, lon._buf, lon._data);
+      ReadValues(*schema.children[1], *array.children[1], array.offset, 1, n,
+                 &array, lat._buf, lat._data);
+    } else if (f.compare(0, 3, "+w:") == 0) {
+      // Interleaved encoding: a fixed size list of coordinates
+      int k = Utility::val<int>(f.substr(3));
+      if (!(k >= 2 && k <= 4 && schema.n_children == 1 &&
+            array.n_children == 1))
+        throw GeographicErr("GeoArrow: bad interleaved point format \""
+                            + f + "\"");
+      ReadValues(*schema.children[0], *array.children[0],
+                 array.offset * k, k, n, &array, lon._buf, lon._data);
+      ReadValues(*schema.children[0], *array.children[0],
+                 array.offset * k + 1, k, n, &array, lat._buf,
+                 lat._data);
+    } else
+      throw GeographicErr("GeoArrow: expected a point column, not \""
+                          + f + "\"");
+  }
+
+  void GeoArrow::Export(vector<real>&& values, const string& name,
+                        ArrowSchema* schema, ArrowArray* array) {
+    size_t n = values.size();
+    ExportBuffer(ToDouble(move(values)), n, "g", name, schema, array);
+  }
+
+  void GeoArrow::Export(vector<int32_t>&& values, const string& name,
+                        ArrowSchema* schema, ArrowArray* array) {
+    size_t n = values.size();
+    ExportBuffer(move(values), n, "i", name, schema, array);
+  }
+
+  void GeoArrow::Inverse(const Geodesic& geod,
+                         const ArrowSchema& schema1, const ArrowArray& points1,
+                         const ArrowSchema& schema2, const ArrowArray& points2,
+                         ArrowSchema* s12schema, ArrowArray* s12,
+                         ArrowSchema* azi1schema, ArrowArray* azi1,
+                         ArrowSchema* azi2schema, ArrowArray* azi2) {
+    Column lat1, lon1, lat2, lon2;
+    ImportPoints(schema1, points1, lat1, lon1);
+    ImportPoints(schema2, points2, lat2, lon2);
+    size_t n = lat1.size();
+    if (lat2.size() != n)
+      throw GeographicErr("GeoArrow: point columns have different lengths");
+    bool azi = (azi1schema && azi1) || (azi2schema && azi2);
+    vector<real> s(n), a1(azi ? n : 0), a2(azi ? n : 0);
+    geod.InverseBatch(n, lat1.data(), lon1.data(), lat2.data(), lon2.data(),
+                      Geodesic::DISTANCE |
+                      (azi ? unsigned(Geodesic::AZIMUTH) : 0U),
+                      s.data(), azi ? a1.data() : nullptr,
+                      azi ? a2.data() : nullptr,
+                      nullptr, nullptr, nullptr, nullptr);
+    Export(move(s), "s12", s12schema, s12);
+    if (azi1schema && azi1) Export(move(a1), "azi1", azi1schema, azi1);
+    if (azi2schema && azi2) Export(move(a2), "azi2", azi2schema, azi2);
+  }
+
+  void GeoArrow::PolygonAreas(const PolygonAreaBatch& poly,
+                              const ArrowSchema& schema,
+                              const ArrowArray& polygons,
+                              ArrowSchema* perimeterschema,
+                              ArrowArray* perimeter,
+                              ArrowSchema* areaschema, ArrowArray* area) {
+    bool plarge, rlarge;
+    if (!(ListFormat(schema, polygons, plarge) &&
+          ListFormat(*schema.children[0], *polygons.children[0], rlarge)))
+      throw GeographicErr("GeoArrow: expected a polygon column, not \""
+                          + Format(schema) + "\"");
+    const ArrowArray& rings = *polygons.children[0];
+    Column lat, lon;
+    ImportPoints(*schema.children[0]->children[0], *rings.children[0],
+                 lat, lon);
+    size_t n = size_t(polygons.length);
+    int64_t r0 = n ? ListOffset(plarge, polygons, 0) : 0,
+      r1 = n ? ListOffset(plarge, polygons, int64_t(n)) : 0;
+    if (!(r0 >= 0 && r0 <= r1 && r1 <= rings.length))
+      throw GeographicErr("GeoArrow: bad polygon offsets");
+    // The vertices of all the rings are passed to PolygonAreaBatch in one
+    // call.
+    size_t nr = size_t(r1 - r0);
+    vector<size_t> offsets(nr + 1);
+    for (size_t k = 0; k <= nr; ++k) {
+      int64_t o = ListOffset(rlarge, rings, r0 + int64_t(k));
+      if (!(o >= 0 && size_t(o) <= lat.size() &&
+            (k == 0 || size_t(o) >= offsets[k - 1])))
+        throw GeographicErr("GeoArrow: bad ring offsets");
+      offsets[k] = size_t(o);
+    }
+    vector<real> rperim(nr), rarea(nr);
+    poly.Compute(nr, offsets.data(), lat.data(), lon.data(), false, true,
+                 rperim.data(), rarea.data());
+    vector<real> perim(n), areas(n);
+    for (size_t i = 0; i < n; ++i) {
+      if (!Valid(polygons, polygons.offset + int64_t(i))) {
+        perim[i] = areas[i] = Math::NaN();
+        continue;
+      }
+      int64_t k0 = ListOffset(plarge, polygons, int64_t(i)) - r0,
+        k1 = ListOffset(plarge, polygons, int64_t(i) + 1) - r0;
+      if (!(k0 >= 0 && k0 <= k1 && k1 <= int64_t(nr)))
+        throw GeographicErr("GeoArrow: bad polygon offsets");
+      real p = 0, a = 0;
+      for (int64_t k = k0; k < k1; ++k) {
+        p += rperim[k];
+        a += k == k0 ? abs(rarea[k]) : -abs(rarea[k]);
+      }
+      perim[i] = p;
+      areas[i] = poly.Polyline() ? Math::NaN() : a;
+    }
+    Export(move(perim), "perimeter", perimeterschema, perimeter);
+    Export(move(areas), "area", areaschema, area);
+  }
+
+  void GeoArrow::UTMUPSForward(const ArrowSchema& schema,
+                               const ArrowArray& points,
+                               ArrowSchema* zoneschema, ArrowArray* zone,
+                               ArrowSchema* northpschema, ArrowArray* northp,
+                               ArrowSchema* xschema, ArrowArray* x,
+                               ArrowSchema* yschema, ArrowArray* y) {
+    Column lat, lon;
+    ImportPoints(schema, points, lat, lon);
+    size_t n = lat.size();
+    vector<int> z(n);
+    unique_ptr<bool[]> np(new bool[n]);
+    vector<real> xv(n), yv(n);
+    UTMUPS::ForwardBatch(n, lat.data(), lon.data(), z.data(), np.get(),
+                         xv.data(), yv.data());
+    Export(vector<int32_t>(z.begin(), z.end()), "zone", zoneschema, zone);
+    ExportBool(np.get(), n, "northp", northpschema, northp);
+    Export(move(xv), "easting", xschema, x);
+    Export(move(yv), "northing", yschema, y);
+  }
+
+  void GeoArrow::GeoidHeights(const Geoid& geoid,
+                              const ArrowSchema& schema,
+                              const ArrowArray& points,
+                              ArrowSchema* hschema, ArrowArray* h) {
+    Column lat, lon;
+    ImportPoints(schema, points, lat, lon);
+    size_t n = lat.size();
+    vector<real> hv(n);
+    geoid(n, lat.data(), lon.data(), hv.data());
+    Export(move(hv), "geoid_height", hschema, h);
+  }
+
+} // namespace GeographicLib
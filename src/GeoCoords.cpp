@@ -27,15 +27,16 @@ namespace GeographicLib {
       sa.push_back(s.substr(pos1, pos0 == string::npos ? pos0 : pos0 - pos1));
     }
     if (sa.size() == 1) {
-      int prec;
-      MGRS::Reverse(sa[0], _zone, _northp, _easting, _northing, prec, centerp);
-      UTMUPS::Reverse(_zone, _northp, _easting, _northing,
-                      _lat, _long, _gamma, _k);
+      int zone, prec;
+      bool northp;
+      real easting, northing;
+      MGRS::Reverse(sa[0], zone, northp, easting, northing, prec, centerp);
+      ResetUTMUPS(zone, northp, easting, northing, false);
     } else if (sa.size() == 2) {
-      DMS::DecodeLatLon(sa[0], sa[1], _lat, _long, longfirst);
-      _long = Math::AngNormalize(_long);
-      UTMUPS::Forward( _lat, _long,
-                       _zone, _northp, _easting, _northing, _gamma, _k);
+      real lat, lon;
+      DMS::DecodeLatLon(sa[0], sa[1], lat, lon, longfirst);
+      lon = Math::AngNormalize(lon);
+      ResetGeographic(lat, lon);
     } else if (sa.size() == 3) {
       unsigned zoneind, coordind;
       if (sa[0].size() > 0 && isalpha(sa[0][sa[0].size() - 1])) {
@@ -48,19 +49,92 @@ namespace GeographicLib {
         throw GeographicErr("Neither " + sa[0] + " nor " + sa[2]
                             + " of the form UTM/UPS Zone + Hemisphere"
                             + " (ex: 38n, 09s, n)");
-      UTMUPS::DecodeZone(sa[zoneind], _zone, _northp);
-      for (unsigned i = 0; i < 2; ++i)
-        (i ? _northing : _easting) = Utility::val<real>(sa[coordind + i]);
-      UTMUPS::Reverse(_zone, _northp, _easting, _northing,
-                      _lat, _long, _gamma, _k);
-      FixHemisphere();
+      int zone;
+      bool northp;
+      UTMUPS::DecodeZone(sa[zoneind], zone, northp);
+      real easting = Utility::val<real>(sa[coordind]),
+        northing = Utility::val<real>(sa[coordind + 1]);
+      ResetUTMUPS(zone, northp, easting, northing, true);
     } else
       throw GeographicErr("Coordinate requires 1, 2, or 3 elements");
-    CopyToAlt();
+  }
+
+  void GeoCoords::Reset(real latitude, real longitude, int zone) {
+    if (zone == UTMUPS::STANDARD && longitude >= -180 && longitude < 180)
+      ResetGeographic(latitude, longitude);
+    else {
+      UTMUPS::Forward(latitude, longitude,
+                      _zone, _northp, _easting, _northing, _gamma, _k,
+                      zone);
+      _lazy = COMPLETE;
+      _lat = latitude;
+      _long = longitude;
+      if (_long >= 180) _long -= 360;
+      else if (_long < -180) _long += 360;
+      _alt = false;
+    }
+  }
+
+  void GeoCoords::ResetGeographic(real lat, real lon) {
+    // With the standard zone, UTMUPS::Forward only fails for a bad latitude;
+    // so check this here (to throw the error now) and defer the projection.
+    if (abs(lat) > 90)
+      UTMUPS::Forward(lat, lon,
+                      _zone, _northp, _easting, _northing, _gamma, _k);
+    _lat = lat;
+    _long = lon;
+    _lazy = FORWARD;
+    _alt = false;
+  }
+
+  void GeoCoords::ResetUTMUPS(int zone, bool northp,
+                              real easting, real northing,
+                              bool fixhemisphere) {
+    using std::isnan;           // Needed for Centos 7, ubuntu 14
+    bool defer = false;
+    if (!(zone == UTMUPS::INVALID || isnan(easting) || isnan(northing))) {
+      // Make the checks that UTMUPS::Reverse makes
+      if (!(zone >= UTMUPS::MINZONE && zone <= UTMUPS::MAXZONE))
+        throw GeographicErr("Zone " + Utility::str(zone)
+                            + " not in range [0, 60]");
+      UTMUPS::CheckCoords(zone != UTMUPS::UPS, northp, easting, northing);
+      // The latitude has the same sign as the UTM northing relative to the
+      // equator, so FixHemisphere does nothing unless the northing is on the
+      // wrong side of the equator.  In that case (and for UPS), compute the
+      // latitude now.
+      defer = !fixhemisphere ||
+        (zone != UTMUPS::UPS &&
+         (northp ? northing >= 0 : northing <= UTMUPS::UTMShift()));
+    }
+    _zone = zone;
+    _northp = northp;
+    _easting = easting;
+    _northing = northing;
+    _alt = false;
+    if (defer)
+      _lazy = REVERSE;
+    else {
+      UTMUPS::Reverse(_zone, _northp, _easting, _northing,
+                      _lat, _long, _gamma, _k);
+      _lazy = COMPLETE;
+      if (fixhemisphere)
+        FixHemisphere();
+    }
+  }
+
+  void GeoCoords::Complete() const {
+    if (_lazy == FORWARD)
+      UTMUPS::Forward(_lat, _long,
+                      _zone, _northp, _easting, _northing, _gamma, _k);
+    else if (_lazy == REVERSE)
+      UTMUPS::Reverse(_zone, _northp, _easting, _northing,
+                      _lat, _long, _gamma, _k);
+    _lazy = COMPLETE;
   }
 
   string GeoCoords::GeoRepresentation(int prec, bool longfirst) const {
     using std::isnan;           // Needed for Centos 7, ubuntu 14
+    UpdateGeographic();
     prec = max(0, min(9 + Math::extra_digits(), prec) + 5);
     ostringstream os;
     os << fixed << setprecision(prec);
@@ -80,6 +154,7 @@ namespace GeographicLib {
 
   string GeoCoords::DMSRepresentation(int prec, bool longfirst,
                                       char dmssep) const {
+    UpdateGeographic();
     prec = max(0, min(10 + Math::extra_digits(), prec) + 5);
     return DMS::Encode(longfirst ? _long : _lat, unsigned(prec),
                        longfirst ? DMS::LONGITUDE : DMS::LATITUDE, dmssep) +
@@ -88,6 +163,7 @@ namespace GeographicLib {
   }
 
   string GeoCoords::MGRSRepresentation(int prec) const {
+    Update();
     // Max precision is um
     prec = max(-1, min(6, prec) + 5);
     string mgrs;
@@ -96,10 +172,11 @@ namespace GeographicLib {
   }
 
   string GeoCoords::AltMGRSRepresentation(int prec) const {
+    Update();
     // Max precision is um
     prec = max(-1, min(6, prec) + 5);
     string mgrs;
-    MGRS::Forward(_alt_zone, _northp, _alt_easting, _alt_northing, _lat, prec,
+    MGRS::Forward(AltZone(), _northp, AltEasting(), AltNorthing(), _lat, prec,
                   mgrs);
     return mgrs;
   }
@@ -128,6 +205,7 @@ namespace GeographicLib {
   }
 
   string GeoCoords::UTMUPSRepresentation(int prec, bool abbrev) const {
+    UpdateUTMUPS();
     string utm;
     UTMUPSString(_zone, _northp, _easting, _northing, prec, abbrev, utm);
     return utm;
@@ -135,6 +213,7 @@ namespace GeographicLib {
 
   string GeoCoords::UTMUPSRepresentation(bool northp, int prec,
                                          bool abbrev) const {
+    UpdateUTMUPS();
     real e, n;
     int z;
     UTMUPS::Transfer(_zone, _northp, _easting, _northing,
@@ -146,22 +225,66 @@ namespace GeographicLib {
 
   string GeoCoords::AltUTMUPSRepresentation(int prec, bool abbrev) const {
     string utm;
-    UTMUPSString(_alt_zone, _northp, _alt_easting, _alt_northing, prec,
+    UTMUPSString(AltZone(), _northp, AltEasting(), AltNorthing(), prec,
                  abbrev, utm);
     return utm;
   }
 
   string GeoCoords::AltUTMUPSRepresentation(bool northp, int prec,
                                             bool abbrev) const {
+    int zone = AltZone();
     real e, n;
     int z;
-    UTMUPS::Transfer(_alt_zone, _northp, _alt_easting, _alt_northing,
-                     _alt_zone,  northp,      e,            n,       z);
+    UTMUPS::Transfer(zone, _northp, AltEasting(), AltNorthing(),
+                     zone,  northp, e,            n,             z);
     string utm;
-    UTMUPSString(_alt_zone, northp, e, n, prec, abbrev, utm);
+    UTMUPSString(zone, northp, e, n, prec, abbrev, utm);
     return utm;
   }
 
+  size_t GeoCoords::ForwardBatch(size_t n, const real lat[], const real lon[],
+                                 int zone[], bool northp[],
+                                 real easting[], real northing[],
+                                 real gamma[], real k[],
+                                 char mgrs[], size_t stride,
+                                 int prec, int setzone) {
+    using std::isnan;           // Needed for Centos 7, ubuntu 14
+    // Process the points in blocks, using local arrays for the UTM/UPS
+    // coordinates which aren't requested but are needed for MGRS.
+    const size_t nblk = 256;
+    int zone1[nblk];
+    bool northp1[nblk];
+    real x1[nblk], y1[nblk];
+    // Max precision is um
+    prec = max(-1, min(6, prec) + 5);
+    size_t nbad = 0;
+    for (size_t i0 = 0; i0 < n; i0 += nblk) {
+      size_t m = min(nblk, n - i0);
+      int* zonei = zone ? zone + i0 : zone1;
+      bool* northpi = northp ? northp + i0 : northp1;
+      real
+        *xi = easting ? easting + i0 : x1,
+        *yi = northing ? northing + i0 : y1;
+      UTMUPS::ForwardBatch(m, lat + i0, lon + i0, zonei, northpi, xi, yi,
+                           gamma ? gamma + i0 : nullptr, k ? k + i0 : nullptr,
+                           setzone);
+      for (size_t i = 0; i < m; ++i) {
+        bool bad = zonei[i] == UTMUPS::INVALID &&
+          !(isnan(lat[i0 + i]) || isnan(lon[i0 + i]));
+        if (mgrs) {
+          char* mgrsi = mgrs + (i0 + i) * stride;
+          if (MGRS::Forward(zonei[i], northpi[i], xi[i], yi[i], lat[i0 + i],
+                            prec, mgrsi, stride) != MGRS::OK) {
+            bad = true;
+            if (stride > 0) mgrsi[0] = '\0';
+          }
+        }
+        if (bad) ++nbad;
+      }
+    }
+    return nbad;
+  }
+
   void GeoCoords::FixHemisphere() {
     using std::isnan;           // Needed for Centos 7, ubuntu 14
     if (_lat == 0 || (_northp && _lat >= 0) || (!_northp && _lat < 0) ||
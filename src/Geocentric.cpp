@@ -169,4 +169,22 @@ namespace GeographicLib {
     M[2] =  clam * cphi; M[5] =  slam * cphi; M[8] = sphi;
   }
 
+  void Geocentric::ForwardBatch(size_t n, const real lat[], const real lon[],
+                                const real h[], real X[], real Y[], real Z[],
+                                real M[]) const {
+    if (!Init()) return;
+    for (size_t i = 0; i < n; ++i)
+      IntForward(lat[i], lon[i], h[i], X[i], Y[i], Z[i],
+                 M ? M + dim2_ * i : NULL);
+  }
+
+  void Geocentric::ReverseBatch(size_t n, const real X[], const real Y[],
+                                const real Z[], real lat[], real lon[],
+                                real h[], real M[]) const {
+    if (!Init()) return;
+    for (size_t i = 0; i < n; ++i)
+      IntReverse(X[i], Y[i], Z[i], lat[i], lon[i], h[i],
+                 M ? M + dim2_ * i : NULL);
+  }
+
 } // namespace GeographicLib
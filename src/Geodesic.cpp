@@ -28,6 +28,8 @@
 
 #include <GeographicLib/Geodesic.hpp>
 #include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/GeodesicStats.hpp>
+#include <GeographicLib/Trace.hpp>
 
 #if defined(_MSC_VER)
 // Squelch warnings about potentially uninitialized local variables and
@@ -39,7 +41,7 @@ namespace GeographicLib {
 
   using namespace std;
 
-  Geodesic::Geodesic(real a, real f)
+  Geodesic::Geodesic(real a, real f, real tol)
     : maxit2_(maxit1_ + Math::digits() + 10)
       // Underflow guard.  We require
       //   tiny_ * epsilon() > 0
@@ -76,14 +78,51 @@ namespace GeographicLib {
       // spherical case.
     , _etol2(real(0.1) * tol2_ /
              sqrt( max(real(0.001), abs(_f)) * min(real(1), 1 - _f/2) / 2 ))
+    , _tol(tol)
+    , _tolv(tol0_)
+    , _nC1t(nC1_)
+    , _nC3t(nC3_ - 1)
+    , _sphere(_f == 0)
   {
     if (!(isfinite(_a) && _a > 0))
       throw GeographicErr("Equatorial radius is not positive");
     if (!(isfinite(_b) && _b > 0))
       throw GeographicErr("Polar semi-axis is not positive");
+    if (!(isfinite(_tol) && _tol >= 0))
+      throw GeographicErr("Tolerance is not non-negative");
     A3coeff();
     C3coeff();
     C4coeff();
+    if (_tol > 0) {
+      // An error of dlam in the longitude of point 2 gives an error of at
+      // most a * dlam in s12.
+      _tolv = max(tol0_, _tol / (2 * _a));
+      // The short-line solution in InverseStart displaces point 2 by about
+      // 0.8 * a * |f| * sig12^3 (because of the error in the azimuth; the
+      // error in s12 is 10 times smaller).  Use it for lines for which twice
+      // this is less than tol/2.  Cap the threshold at 0.05 (about 300 km)
+      // where the error has been checked.
+      _etol2 = max(_etol2, min(real(0.05), cbrt(_tol / (4 * _a * abs(_f)))));
+      // The largest value of the expansion parameter is n, attained for
+      // meridional geodesics
+      real epsx = _n, C1a[nC1_ + 1], C3a[nC3_];
+      C1f(epsx, C1a);
+      C3f(epsx, C3a);
+      real A1 = 1 + A1m1f(epsx), A3 = A3f(epsx);
+      // Find the fewest terms for which the truncation error in s12, b * A1
+      // * (sum of dropped C1 terms) + a * f * A3 * (sum of dropped C3
+      // terms), each sum doubled because the series are differenced, is
+      // less than tol/2, including a safety factor of 2.
+      for (int k = nC1_ - 1; k >= 1; --k) {
+        real err = 0;
+        for (int l = k + 1; l <= nC1_; ++l)
+          err += 2 * _b * A1 * abs(C1a[l]);
+        for (int l = k + 1; l < nC3_; ++l)
+          err += 2 * _a * abs(_f) * A3 * abs(C3a[l]);
+        if (!(2 * err < _tol / 2)) break;
+        _nC1t = k; _nC3t = min(k, nC3_ - 1);
+      }
+    }
   }
 
   const Geodesic& Geodesic::WGS84() {
@@ -156,12 +195,47 @@ namespace GeographicLib {
     return GenDirectLine(lat1, lon1, azi1, true, a12, caps);
   }
 
+  void Geodesic::InverseLat(real& lat,
+                            real& sbet, real& cbet, real& dn) const {
+    // The latitude dependent quantities needed by GenInverse for one of the
+    // end points.  lat is rounded on output.
+    // If really close to the equator, treat as on equator.
+    lat = Math::AngRound(Math::LatFix(lat));
+    Math::sincosd(lat, sbet, cbet); sbet *= _f1;
+    // Ensure cbet = +epsilon at poles; doing the fix on beta means that sig12
+    // will be <= 2*tiny for two points at the same pole.
+    Math::norm(sbet, cbet); cbet = max(tiny_, cbet);
+    dn = sqrt(1 + _ep2 * Math::sq(sbet));
+  }
+
   Math::real Geodesic::GenInverse(real lat1, real lon1, real lat2, real lon2,
                                   unsigned outmask, real& s12,
                                   real& salp1, real& calp1,
                                   real& salp2, real& calp2,
                                   real& m12, real& M12, real& M21,
-                                  real& S12) const {
+                                  real& S12, bool hint) const {
+    real sbet1, cbet1, dn1, sbet2, cbet2, dn2;
+    InverseLat(lat1, sbet1, cbet1, dn1);
+    InverseLat(lat2, sbet2, cbet2, dn2);
+    return GenInverse(lat1, sbet1, cbet1, dn1, lon1,
+                      lat2, sbet2, cbet2, dn2, lon2,
+                      outmask, s12, salp1, calp1, salp2, calp2,
+                      m12, M12, M21, S12, hint);
+  }
+
+  Math::real Geodesic::GenInverse(real lat1, real sbet1, real cbet1, real dn1,
+                                  real lon1,
+                                  real lat2, real sbet2, real cbet2, real dn2,
+                                  real lon2,
+                                  unsigned outmask, real& s12,
+                                  real& salp1, real& calp1,
+                                  real& salp2, real& calp2,
+                                  real& m12, real& M12, real& M21,
+                                  real& S12, bool hint) const {
+    // The azimuths of the nearby solution
+    const real
+      salp1h = hint ? salp1 : 0, calp1h = hint ? calp1 : 0,
+      salp2h = hint ? salp2 : 0, calp2h = hint ? calp2 : 0;
     // Compute longitude difference (AngDiff does this carefully).  Result is
     // in [-180, 180] but -180 is only for west-going geodesics.  180 is for
     // east-going and meridional geodesics.
@@ -180,20 +254,26 @@ namespace GeographicLib {
     } else
       Math::sincosd(lon12, slam12, clam12);
 
-    // If really close to the equator, treat as on equator.
-    lat1 = Math::AngRound(Math::LatFix(lat1));
-    lat2 = Math::AngRound(Math::LatFix(lat2));
+    // lat1 and lat2 have already been rounded by InverseLat, which also sets
+    // sbet, cbet, and dn for each point.
     // Swap points so that point with higher (abs) latitude is point 1.
     // If one latitude is a nan, then it becomes lat1.
     int swapp = abs(lat1) < abs(lat2) ? -1 : 1;
     if (swapp < 0) {
       lonsign *= -1;
       swap(lat1, lat2);
+      swap(sbet1, sbet2);
+      swap(cbet1, cbet2);
+      swap(dn1, dn2);
     }
     // Make lat1 <= 0
     int latsign = lat1 < 0 ? 1 : -1;
     lat1 *= latsign;
     lat2 *= latsign;
+    // sincosd is odd in its argument, so this is equivalent to recomputing the
+    // reduced latitudes from lat1 and lat2.
+    sbet1 *= latsign;
+    sbet2 *= latsign;
     // Now we have
     //
     //     0 <= lon12 <= 180
@@ -206,16 +286,7 @@ namespace GeographicLib {
     // check, e.g., on verifying quadrants in atan2.  In addition, this
     // enforces some symmetries in the results returned.
 
-    real sbet1, cbet1, sbet2, cbet2, s12x, m12x;
-
-    Math::sincosd(lat1, sbet1, cbet1); sbet1 *= _f1;
-    // Ensure cbet1 = +epsilon at poles; doing the fix on beta means that sig12
-    // will be <= 2*tiny for two points at the same pole.
-    Math::norm(sbet1, cbet1); cbet1 = max(tiny_, cbet1);
-
-    Math::sincosd(lat2, sbet2, cbet2); sbet2 *= _f1;
-    // Ensure cbet2 = +epsilon at poles
-    Math::norm(sbet2, cbet2); cbet2 = max(tiny_, cbet2);
+    real s12x, m12x;
 
     // If cbet1 < -sbet1, then cbet2 - cbet1 is a sensitive measure of the
     // |bet1| - |bet2|.  Alternatively (cbet1 >= -sbet1), abs(sbet2) + sbet1 is
@@ -225,18 +296,19 @@ namespace GeographicLib {
     // 48.522876735459 0 -48.52287673545898293 179.599720456223079643
     // which failed with Visual Studio 10 (Release and Debug)
 
+    // In these cases, dn1 and dn2 are equal.
     if (cbet1 < -sbet1) {
-      if (cbet2 == cbet1)
+      if (cbet2 == cbet1) {
         sbet2 = sbet2 < 0 ? sbet1 : -sbet1;
+        dn2 = dn1;
+      }
     } else {
-      if (abs(sbet2) == -sbet1)
+      if (abs(sbet2) == -sbet1) {
         cbet2 = cbet1;
+        dn2 = dn1;
+      }
     }
 
-    real
-      dn1 = sqrt(1 + _ep2 * Math::sq(sbet1)),
-      dn2 = sqrt(1 + _ep2 * Math::sq(sbet2));
-
     real a12, sig12;
     // index zero element of this array is unused
     real Ca[nC_];
@@ -286,6 +358,9 @@ namespace GeographicLib {
         m12x *= _b;
         s12x *= _b;
         a12 = sig12 / Math::degree();
+        if (GEOGRAPHICLIB_GEODESIC_STATS)
+          GeodesicStats::Record(GeodesicStats::GEODESIC,
+                                GeodesicStats::MERIDIONAL);
       } else
         // m12 < 0, i.e., prolate and too close to anti-podal
         meridian = false;
@@ -305,18 +380,43 @@ namespace GeographicLib {
       if (outmask & GEODESICSCALE)
         M12 = M21 = cos(sig12);
       a12 = lon12 / _f1;
+      if (GEOGRAPHICLIB_GEODESIC_STATS)
+        GeodesicStats::Record(GeodesicStats::GEODESIC,
+                              GeodesicStats::EQUATORIAL);
 
     } else if (!meridian) {
 
       // Now point1 and point2 belong within a hemisphere bounded by a
       // meridian and geodesic is neither meridional or equatorial.
 
-      // Figure a starting point for Newton's method
-      real dnm;
-      sig12 = InverseStart(sbet1, cbet1, dn1, sbet2, cbet2, dn2,
-                           lam12, slam12, clam12,
-                           salp1, calp1, salp2, calp2, dnm,
-                           Ca);
+      real dnm = 1;
+      if (_sphere) {
+        // The spherical triangle gives the solution directly.  This is the
+        // solution that InverseStart uses for short lines (with omg12 =
+        // lam12) and it retains the accurate evaluation of the longitude
+        // difference and the latitudes in degrees.
+        real
+          sbet12 = sbet2 * cbet1 - cbet2 * sbet1,
+          sbet12a = sbet2 * cbet1 + cbet2 * sbet1,
+          s2 = Math::sq(slam12);
+        salp1 = cbet2 * slam12;
+        calp1 = clam12 >= 0 ?
+          sbet12 + cbet2 * sbet1 * s2 / (1 + clam12) :
+          sbet12a - cbet2 * sbet1 * s2 / (1 - clam12);
+        salp2 = cbet1 * slam12;
+        calp2 = sbet12 - cbet1 * sbet2 *
+          (clam12 >= 0 ? s2 / (1 + clam12) : 1 - clam12);
+        sig12 = atan2(hypot(salp1, calp1),
+                      sbet1 * sbet2 + cbet1 * cbet2 * clam12);
+        Math::norm(salp1, calp1);
+        Math::norm(salp2, calp2);
+        somg12 = slam12; comg12 = clam12;
+      } else
+        // Figure a starting point for Newton's method
+        sig12 = InverseStart(sbet1, cbet1, dn1, sbet2, cbet2, dn2,
+                             lam12, slam12, clam12,
+                             salp1, calp1, salp2, calp2, dnm,
+                             Ca);
 
       if (sig12 >= 0) {
         // Short lines (InverseStart sets salp2, calp2, dnm)
@@ -326,8 +426,27 @@ namespace GeographicLib {
           M12 = M21 = cos(sig12 / dnm);
         a12 = sig12 / Math::degree();
         omg12 = lam12 / (_f1 * dnm);
+        if (GEOGRAPHICLIB_GEODESIC_STATS)
+          GeodesicStats::Record(GeodesicStats::GEODESIC, GeodesicStats::SHORT);
       } else {
 
+        // Set if the iteration starts from the nearby solution; salp1x and
+        // calp1x then hold the starting point given by InverseStart.
+        bool hinted = false;
+        real salp1x = 0, calp1x = 0;
+        if (hint) {
+          // Transform the azimuth of the nearby solution at (the canonical)
+          // point 1 to the canonical form; see the end of this function.
+          salp1x = (swapp < 0 ? salp2h : salp1h) * swapp * lonsign;
+          calp1x = (swapp < 0 ? calp2h : calp1h) * swapp * latsign;
+          Math::norm(salp1x, calp1x);
+          // Use it only if it's a legal starting point
+          if (salp1x > 0 && isfinite(calp1x)) {
+            swap(salp1, salp1x); swap(calp1, calp1x);
+            hinted = true;
+          }
+        }
+
         // Newton's method.  This is a straightforward solution of f(alp1) =
         // lambda12(alp1) - lam12 = 0 with one wrinkle.  f(alp) has exactly one
         // root in the interval (0, pi) and its derivative is positive at the
@@ -342,7 +461,7 @@ namespace GeographicLib {
         //
         // initial values to suppress warnings (if loop is executed 0 times)
         real ssig1 = 0, csig1 = 0, ssig2 = 0, csig2 = 0, eps = 0, domg12 = 0;
-        unsigned numit = 0;
+        unsigned numit = 0, numbis = 0;
         // Bracketing range
         real salp1a = tiny_, calp1a = 1, salp1b = tiny_, calp1b = -1;
         for (bool tripn = false, tripb = false;
@@ -356,7 +475,7 @@ namespace GeographicLib {
                             salp2, calp2, sig12, ssig1, csig1, ssig2, csig2,
                             eps, domg12, numit < maxit1_, dv, Ca);
           // Reversed test to allow escape with NaNs
-          if (tripb || !(abs(v) >= (tripn ? 8 : 1) * tol0_)) break;
+          if (tripb || !(abs(v) >= (tripn ? 8 : 1) * _tolv)) break;
           // Update bracketing values
           if (v > 0 && (numit > maxit1_ || calp1/salp1 > calp1b/salp1b))
             { salp1b = salp1; calp1b = calp1; }
@@ -375,10 +494,22 @@ namespace GeographicLib {
               // In some regimes we don't get quadratic convergence because
               // slope -> 0.  So use convergence conditions based on epsilon
               // instead of sqrt(epsilon).
-              tripn = abs(v) <= 16 * tol0_;
+              tripn = abs(v) <= 16 * _tolv;
               continue;
             }
           }
+          if (hinted) {
+            // The nearby solution was a poor starting point.  The bracket
+            // may then be too wide for bisection to converge, so start again
+            // from InverseStart's estimate; the result is then the same as
+            // without the hint.  numit wraps around to 0 with the increment.
+            hinted = false;
+            salp1 = salp1x; calp1 = calp1x;
+            salp1a = tiny_; calp1a = 1; salp1b = tiny_; calp1b = -1;
+            tripn = false;
+            numit = unsigned(-1);
+            continue;
+          }
           // Either dv was not positive or updated value was outside legal
           // range.  Use the midpoint of the bracket as the next estimate.
           // This mechanism is not needed for the WGS84 ellipsoid, but it does
@@ -390,10 +521,14 @@ namespace GeographicLib {
           salp1 = (salp1a + salp1b)/2;
           calp1 = (calp1a + calp1b)/2;
           Math::norm(salp1, calp1);
+          ++numbis;
           tripn = false;
           tripb = (abs(salp1a - salp1) + (calp1a - calp1) < tolb_ ||
                    abs(salp1 - salp1b) + (calp1 - calp1b) < tolb_);
         }
+        if (GEOGRAPHICLIB_GEODESIC_STATS)
+          GeodesicStats::Record(GeodesicStats::GEODESIC, GeodesicStats::GENERAL,
+                                numit, numbis);
         {
           real dummy;
           // Ensure that the reduced length and geodesic scale are computed in
@@ -427,7 +562,8 @@ namespace GeographicLib {
         salp0 = salp1 * cbet1,
         calp0 = hypot(calp1, salp1 * sbet1); // calp0 > 0
       real alp12;
-      if (calp0 != 0 && salp0 != 0) {
+      // A4 vanishes for a sphere
+      if (!_sphere && calp0 != 0 && salp0 != 0) {
         real
           // From Lambda12: tan(bet) = tan(sig) * cos(alp)
           ssig1 = sbet1, csig1 = calp1 * cbet1,
@@ -514,19 +650,198 @@ namespace GeographicLib {
     return a12;
   }
 
+  Math::real Geodesic::GenInverseHint(real lat1, real lon1,
+                                      real lat2, real lon2,
+                                      unsigned outmask,
+                                      real& s12, real& azi1, real& azi2,
+                                      real& m12, real& M12, real& M21,
+                                      real& S12) const {
+    outmask &= OUT_MASK;
+    real salp1, calp1, salp2, calp2;
+    Math::sincosd(azi1, salp1, calp1);
+    Math::sincosd(azi2, salp2, calp2);
+    real a12 = GenInverse(lat1, lon1, lat2, lon2,
+                          outmask, s12, salp1, calp1, salp2, calp2,
+                          m12, M12, M21, S12, true);
+    azi1 = Math::atan2d(salp1, calp1);
+    azi2 = Math::atan2d(salp2, calp2);
+    return a12;
+  }
+
+  void Geodesic::DirectBatch(size_t n,
+                             const real lat1[], const real lon1[],
+                             const real azi1[], const real s12[],
+                             unsigned outmask,
+                             real lat2[], real lon2[], real azi2[],
+                             real m12[], real M12[], real M21[], real S12[],
+                             real a12[]) const {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "Geodesic::DirectBatch", n);
+    // Hoist the tests on outmask out of the loop.
+    const bool
+      lat = (outmask & LATITUDE) != 0,
+      lon = (outmask & LONGITUDE) != 0,
+      azi = (outmask & AZIMUTH) != 0,
+      redl = (outmask & REDUCEDLENGTH) != 0,
+      scale = (outmask & GEODESICSCALE) != 0,
+      area = (outmask & AREA) != 0;
+    // As in GenDirect
+    const unsigned caps = outmask | DISTANCE_IN;
+    GeodesicLine line;
+    for (size_t i = 0; i < n; ++i) {
+      real lat2x = 0, lon2x = 0, azi2x = 0, t,
+        m12x = 0, M12x = 0, M21x = 0, S12x = 0;
+      line.Reset(*this, lat1[i], lon1[i], azi1[i], caps);
+      real a12x = line.GenPosition(false, s12[i], caps,
+                                   lat2x, lon2x, azi2x, t,
+                                   m12x, M12x, M21x, S12x);
+      if (lat) lat2[i] = lat2x;
+      if (lon) lon2[i] = lon2x;
+      if (azi) azi2[i] = azi2x;
+      if (redl) m12[i] = m12x;
+      if (scale) { M12[i] = M12x; M21[i] = M21x; }
+      if (area) S12[i] = S12x;
+      if (a12) a12[i] = a12x;
+    }
+  }
+
+  void Geodesic::InverseBatch(size_t n,
+                              const real lat1[], const real lon1[],
+                              const real lat2[], const real lon2[],
+                              unsigned outmask,
+                              real s12[], real azi1[], real azi2[],
+                              real m12[], real M12[], real M21[], real S12[],
+                              real a12[]) const {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "Geodesic::InverseBatch", n);
+    outmask &= OUT_MASK;
+    // Hoist the tests on outmask out of the loop.
+    const bool
+      dist = (outmask & DISTANCE) != 0,
+      azi = (outmask & AZIMUTH) != 0,
+      redl = (outmask & REDUCEDLENGTH) != 0,
+      scale = (outmask & GEODESICSCALE) != 0,
+      area = (outmask & AREA) != 0;
+    for (size_t i = 0; i < n; ++i) {
+      real s12x = 0, salp1, calp1, salp2, calp2,
+        m12x = 0, M12x = 0, M21x = 0, S12x = 0,
+        a12x = GenInverse(lat1[i], lon1[i], lat2[i], lon2[i],
+                          outmask, s12x, salp1, calp1, salp2, calp2,
+                          m12x, M12x, M21x, S12x);
+      if (dist) s12[i] = s12x;
+      if (azi) {
+        azi1[i] = Math::atan2d(salp1, calp1);
+        azi2[i] = Math::atan2d(salp2, calp2);
+      }
+      if (redl) m12[i] = m12x;
+      if (scale) { M12[i] = M12x; M21[i] = M21x; }
+      if (area) S12[i] = S12x;
+      if (a12) a12[i] = a12x;
+    }
+  }
+
+  void Geodesic::BoundingBoxes(size_t n, const real lat[], const real lon[],
+                              real latmin[], real latmax[],
+                              real lonw[], real dlon[]) const {
+    GeodesicLine line;
+    for (size_t i = 0; i + 1 < n; ++i) {
+      line.ResetInverse(*this, lat[i], lon[i], lat[i + 1], lon[i + 1],
+                        LATITUDE | LONGITUDE);
+      line.BoundingBox(latmin[i], latmax[i], lonw[i], dlon[i]);
+    }
+  }
+
+  Math::real Geodesic::InverseJacobian(real lat1, real lon1,
+                                       real lat2, real lon2,
+                                       real& s12, real& azi1, real& azi2,
+                                       real J[]) const {
+    real salp1, calp1, salp2, calp2, m12, M12, M21, t,
+      a12 = GenInverse(lat1, lon1, lat2, lon2,
+                       DISTANCE | REDUCEDLENGTH | GEODESICSCALE,
+                       s12, salp1, calp1, salp2, calp2, m12, M12, M21, t);
+    azi1 = Math::atan2d(salp1, calp1);
+    azi2 = Math::atan2d(salp2, calp2);
+    real sphi1, cphi1, sphi2, cphi2;
+    Math::sincosd(lat1, sphi1, cphi1);
+    Math::sincosd(lat2, sphi2, cphi2);
+    // The meridional radius of curvature, rho, and the radius of the
+    // parallel, r, at the end points; the displacements for changes in lat
+    // and lon of 1 radian are rho and r.
+    real
+      w1 = 1 / sqrt(1 - _e2 * Math::sq(sphi1)),
+      w2 = 1 / sqrt(1 - _e2 * Math::sq(sphi2)),
+      r1 = _a * w1 * cphi1, rho1 = _a * (1 - _e2) * Math::sq(w1) * w1,
+      r2 = _a * w2 * cphi2, rho2 = _a * (1 - _e2) * Math::sq(w2) * w2,
+      // The displacements at right angles to the geodesic (to the left at
+      // point 1 and to the right at point 2) divided by m12
+      t1lat = salp1 * rho1 / m12, t1lon = -calp1 * r1 / m12,
+      t2lat = -salp2 * rho2 / m12, t2lon = calp2 * r2 / m12;
+    J[0] = -calp1 * rho1 * Math::degree();
+    J[1] = -salp1 * r1 * Math::degree();
+    J[2] = calp2 * rho2 * Math::degree();
+    J[3] = salp2 * r2 * Math::degree();
+    J[4] = M12 * t1lat;
+    J[5] = M12 * t1lon + sphi1;
+    J[6] = t2lat;
+    J[7] = t2lon;
+    J[8] = t1lat;
+    J[9] = t1lon;
+    J[10] = M21 * t2lat;
+    J[11] = M21 * t2lon + sphi2;
+    return a12;
+  }
+
+  void Geodesic::InverseJacobianBatch(size_t n,
+                                      const real lat1[], const real lon1[],
+                                      const real lat2[], const real lon2[],
+                                      real s12[], real azi1[], real azi2[],
+                                      real J[]) const {
+    for (size_t i = 0; i < n; ++i)
+      InverseJacobian(lat1[i], lon1[i], lat2[i], lon2[i],
+                      s12[i], azi1[i], azi2[i], J + 12 * i);
+  }
+
+  bool Geodesic::Within(real lat1, real lon1, real lat2, real lon2,
+                        real r) const {
+    // Allow for roundoff in the chord
+    static const real tol = 64 * numeric_limits<real>::epsilon();
+    real sphi1, cphi1, sphi2, cphi2, slam12, clam12;
+    Math::sincosd(lat1, sphi1, cphi1);
+    Math::sincosd(lat2, sphi2, cphi2);
+    Math::sincosd(Math::AngDiff(lon1, lon2), slam12, clam12);
+    // The chord with point 1 rotated to longitude 0
+    real
+      n1 = _a / sqrt(1 - _e2 * Math::sq(sphi1)),
+      n2 = _a / sqrt(1 - _e2 * Math::sq(sphi2)),
+      c = hypot(hypot(n2 * cphi2 * clam12 - n1 * cphi1, n2 * cphi2 * slam12),
+                (1 - _e2) * (n2 * sphi2 - n1 * sphi1));
+    if (c - tol * _a > r) return false;
+    // The smallest radius of curvature.  Restricting the upper bound to c <=
+    // rho ensures that the geodesic is short enough for the comparison
+    // theorem to apply.
+    real rho = _a * min(Math::sq(_f1), 1 / _f1);
+    if (c <= rho && 2 * rho * asin(c / (2 * rho)) + tol * _a <= r)
+      return true;
+    real s12;
+    Inverse(lat1, lon1, lat2, lon2, s12);
+    return s12 <= r;
+  }
+
+  size_t Geodesic::WithinBatch(size_t n,
+                               const real lat1[], const real lon1[],
+                               const real lat2[], const real lon2[],
+                               real r, bool within[]) const {
+    size_t num = 0;
+    for (size_t i = 0; i < n; ++i)
+      if ((within[i] = Within(lat1[i], lon1[i], lat2[i], lon2[i], r)))
+        ++num;
+    return num;
+  }
+
   GeodesicLine Geodesic::InverseLine(real lat1, real lon1,
                                      real lat2, real lon2,
                                      unsigned caps) const {
-    real t, salp1, calp1, salp2, calp2,
-      a12 = GenInverse(lat1, lon1, lat2, lon2,
-                       // No need to specify AZIMUTH here
-                       0u, t, salp1, calp1, salp2, calp2,
-                       t, t, t, t),
-      azi1 = Math::atan2d(salp1, calp1);
-    // Ensure that a12 can be converted to a distance
-    if (caps & (OUT_MASK & DISTANCE_IN)) caps |= DISTANCE;
-    return
-      GeodesicLine(*this, lat1, lon1, azi1, salp1, calp1, caps, true, a12);
+    GeodesicLine line;
+    line.ResetInverse(*this, lat1, lon1, lat2, lon2, caps);
+    return line;
   }
 
   void Geodesic::Lengths(real eps, real sig12,
@@ -559,8 +874,8 @@ namespace GeographicLib {
       A1 = 1 + A1;
     }
     if (outmask & DISTANCE) {
-      real B1 = SinCosSeries(true, ssig2, csig2, Ca, nC1_) -
-        SinCosSeries(true, ssig1, csig1, Ca, nC1_);
+      real B1 = SinCosSeries(true, ssig2, csig2, Ca, _nC1t) -
+        SinCosSeries(true, ssig1, csig1, Ca, _nC1t);
       // Missing a factor of _b
       s12b = A1 * (sig12 + B1);
       if (outmask & (REDUCEDLENGTH | GEODESICSCALE)) {
@@ -867,8 +1182,8 @@ namespace GeographicLib {
     real k2 = Math::sq(calp0) * _ep2;
     eps = k2 / (2 * (1 + sqrt(1 + k2)) + k2);
     C3f(eps, Ca);
-    B312 = (SinCosSeries(true, ssig2, csig2, Ca, nC3_-1) -
-            SinCosSeries(true, ssig1, csig1, Ca, nC3_-1));
+    B312 = (SinCosSeries(true, ssig2, csig2, Ca, _nC3t) -
+            SinCosSeries(true, ssig1, csig1, Ca, _nC3t));
     domg12 = -_f * A3f(eps) * salp0 * (sig12 + B312);
     lam12 = eta + domg12;
 
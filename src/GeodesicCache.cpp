@@ -0,0 +1,122 @@
+/**
+ * \file GeodesicCache.cpp
+ * \brief Implementation for GeographicLib::GeodesicCache class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <functional>
+#include <initializer_list>
+#include <GeographicLib/GeodesicCache.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  bool GeodesicCache::key::operator==(const key& k) const {
+    // Compare the values and the signs, so that 0 and -0 are distinct
+    auto same = [](real x, real y) -> bool
+      { return x == y && signbit(x) == signbit(y); };
+    return same(lat1, k.lat1) && same(lon1, k.lon1) &&
+      same(lat2, k.lat2) && same(lon2, k.lon2);
+  }
+
+  size_t GeodesicCache::hasher::operator()(const key& k) const {
+    hash<real> h;
+    // The combination step from boost::hash_combine
+    size_t seed = 0;
+    for (real x : {k.lat1, k.lon1, k.lat2, k.lon2})
+      seed ^= h(x) + size_t(0x9e3779b9) + (seed << 6) + (seed >> 2);
+    return seed;
+  }
+
+  GeodesicCache::GeodesicCache(const Geodesic& earth, size_t capacity,
+                               real quantum)
+    : _earth(earth)
+    , _capacity(capacity)
+    , _quantum(quantum)
+    , _hits(0)
+    , _misses(0)
+  {
+    if (_capacity == 0)
+      throw GeographicErr("GeodesicCache capacity must be positive");
+    if (!(isfinite(_quantum) && _quantum >= 0))
+      throw GeographicErr("GeodesicCache quantum must be non-negative");
+  }
+
+  Math::real GeodesicCache::Quantize(real x) const {
+    return _quantum > 0 ? _quantum * round(x / _quantum) : x;
+  }
+
+  Math::real GeodesicCache::GenInverse(real lat1, real lon1,
+                                       real lat2, real lon2,
+                                       unsigned outmask, real& s12,
+                                       real& azi1, real& azi2, real& m12,
+                                       real& M12, real& M21, real& S12) {
+    const key k = {Quantize(lat1), Quantize(lon1),
+                   Quantize(lat2), Quantize(lon2)};
+    value v;
+    bool found = false;
+    {
+      lock_guard<mutex> lock(_lock);
+      auto p = _map.find(k);
+      if (p != _map.end()) {
+        // Move the item to the front of the list; iterators remain valid.
+        _list.splice(_list.begin(), _list, p->second);
+        v = p->second->second;
+        found = true;
+        ++_hits;
+      } else
+        ++_misses;
+    }
+    if (!found) {
+      v.a12 = _earth.GenInverse(k.lat1, k.lon1, k.lat2, k.lon2, Geodesic::ALL,
+                                v.s12, v.azi1, v.azi2, v.m12, v.M12, v.M21,
+                                v.S12);
+      if (!(isnan(k.lat1) || isnan(k.lon1) ||
+            isnan(k.lat2) || isnan(k.lon2))) {
+        lock_guard<mutex> lock(_lock);
+        // Another thread may have inserted this key in the meantime.
+        if (_map.find(k) == _map.end()) {
+          _list.push_front(item(k, v));
+          _map[k] = _list.begin();
+          while (_list.size() > _capacity) {
+            _map.erase(_list.back().first);
+            _list.pop_back();
+          }
+        }
+      }
+    }
+    // The mask values share the capability bits, so check for all the bits
+    auto has = [outmask](unsigned m) -> bool { return (outmask & m) == m; };
+    if (has(Geodesic::DISTANCE)) s12 = v.s12;
+    if (has(Geodesic::AZIMUTH)) { azi1 = v.azi1; azi2 = v.azi2; }
+    if (has(Geodesic::REDUCEDLENGTH)) m12 = v.m12;
+    if (has(Geodesic::GEODESICSCALE)) { M12 = v.M12; M21 = v.M21; }
+    if (has(Geodesic::AREA)) S12 = v.S12;
+    return v.a12;
+  }
+
+  void GeodesicCache::Clear() {
+    lock_guard<mutex> lock(_lock);
+    _list.clear(); _map.clear();
+  }
+
+  size_t GeodesicCache::Size() const {
+    lock_guard<mutex> lock(_lock);
+    return _list.size();
+  }
+
+  unsigned long long GeodesicCache::Hits() const {
+    lock_guard<mutex> lock(_lock);
+    return _hits;
+  }
+
+  unsigned long long GeodesicCache::Misses() const {
+    lock_guard<mutex> lock(_lock);
+    return _misses;
+  }
+
+} // namespace GeographicLib
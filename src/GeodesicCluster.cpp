@@ -0,0 +1,222 @@
+/**
+ * \file GeodesicCluster.cpp
+ * \brief Implementation for GeographicLib::GeodesicCluster class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <GeographicLib/GeodesicCluster.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <GeographicLib/GeodesicOrigin.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  GeodesicCluster::GeodesicCluster(const Geodesic& earth, unsigned threads)
+    : _earth(earth)
+    , _gnom(earth)
+    , _threads(threads ? threads : thread::hardware_concurrency())
+  {
+    // hardware_concurrency returns 0 if the number of cores can't be
+    // determined.
+    if (_threads == 0) _threads = 1;
+  }
+
+  void GeodesicCluster::Step(size_t k, const size_t off[],
+                             const real lat[], const real lon[],
+                             const real w[],
+                             real latc[], real lonc[], real move[]) const {
+    // The weighted sums of the gnomonic coordinates of the points of set j
+    // in a chunk
+    struct sum { size_t j; real w, x, y; };
+    const size_t n = off[k], nchunks = (n + chunk_ - 1) / chunk_;
+    vector<vector<sum>> sums(nchunks);
+    Executor::Parallel(nchunks, _threads, [&](size_t c) -> void {
+      const size_t i0 = c * chunk_, i1 = min(n, i0 + chunk_);
+      vector<real> azi1(chunk_), azi2(chunk_), m12(chunk_),
+        M12(chunk_), M21(chunk_), sx(chunk_), cx(chunk_);
+      // The last set starting at or before i0
+      size_t j = size_t(upper_bound(off, off + k + 1, i0) - off) - 1;
+      for (size_t ia = i0; ia < i1;) {
+        while (off[j + 1] <= ia) ++j; // Skip empty sets
+        const size_t ib = min(i1, off[j + 1]), m = ib - ia;
+        GeodesicOrigin origin(_earth, latc[j], lonc[j]);
+        origin.InverseBatch(m, lat + ia, lon + ia,
+                            Geodesic::AZIMUTH | Geodesic::REDUCEDLENGTH |
+                            Geodesic::GEODESICSCALE,
+                            nullptr, azi1.data(), azi2.data(), m12.data(),
+                            M12.data(), M21.data(), nullptr);
+        Math::sincosdBatch(m, azi1.data(), sx.data(), cx.data());
+        sum t = {j, 0, 0, 0};
+        for (size_t i = 0; i < m; ++i) {
+          // Skip NaNs and points beyond the range of the gnomonic projection
+          if (!(M12[i] > 0)) continue;
+          real rho = m12[i] / M12[i], wi = w ? w[ia + i] : 1;
+          t.w += wi; t.x += wi * rho * sx[i]; t.y += wi * rho * cx[i];
+        }
+        sums[c].push_back(t);
+        ia = ib;
+      }
+    });
+    // Combine the sums in a fixed order so that the result doesn't depend on
+    // the number of threads.
+    vector<real> sw(k, 0), sx(k, 0), sy(k, 0);
+    for (const vector<sum>& s : sums)
+      for (const sum& t : s) {
+        sw[t.j] += t.w; sx[t.j] += t.x; sy[t.j] += t.y;
+      }
+    Executor::Parallel(k, _threads, [&](size_t j) -> void {
+      using std::isnan;
+      move[j] = 0;
+      if (!(sw[j] > 0)) return;
+      real lat1, lon1;
+      _gnom.Reverse(latc[j], lonc[j], sx[j] / sw[j], sy[j] / sw[j],
+                    lat1, lon1);
+      if (isnan(lat1)) return;
+      _earth.Inverse(latc[j], lonc[j], lat1, lon1, move[j]);
+      latc[j] = lat1; lonc[j] = lon1;
+    });
+  }
+
+  int GeodesicCluster::Centroid(size_t n, const real lat[], const real lon[],
+                                const real w[], real& latc, real& lonc,
+                                real tol, int maxit) const {
+    using std::isfinite;
+    // Start at the mean of the unit vectors
+    real X = 0, Y = 0, Z = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (!(isfinite(lat[i]) && isfinite(lon[i]))) continue;
+      real sphi, cphi, slam, clam, wi = w ? w[i] : 1;
+      Math::sincosd(lat[i], sphi, cphi);
+      Math::sincosd(lon[i], slam, clam);
+      X += wi * cphi * clam; Y += wi * cphi * slam; Z += wi * sphi;
+    }
+    latc = lonc = Math::NaN();
+    real r = hypot(X, Y);
+    if (!(hypot(r, Z) > 0)) return 0;
+    latc = Math::atan2d(Z, r); lonc = Math::atan2d(Y, X);
+    const size_t off[2] = {0, n};
+    int it = 0;
+    while (it < maxit) {
+      ++it;
+      real move;
+      Step(1, off, lat, lon, w, &latc, &lonc, &move);
+      if (!(move > tol)) break;
+    }
+    return it;
+  }
+
+  int GeodesicCluster::KMeans(size_t n, const real lat[], const real lon[],
+                              size_t k, real latc[], real lonc[],
+                              int assign[], real dist[],
+                              real tol, int maxit) const {
+    using std::isnan;
+    if (k == 0) return 0;
+    const real inf = Math::infinity();
+    const size_t nchunks = (n + chunk_ - 1) / chunk_;
+    // u = upper bound on the distance to the assigned center, l = lower bound
+    // on the distance to any other center.
+    vector<real> u(n, inf), l(n, 0), s(k), move(k, 0), slat(n), slon(n);
+    vector<size_t> off(k + 1), changes(nchunks);
+    vector<GeodesicOrigin> centers;
+    centers.reserve(k);
+    // The largest and second largest moves of the centers and the index of
+    // the center with the largest move
+    real p1 = 0, p2 = 0;
+    size_t j1 = 0;
+    int it = 0;
+    for (bool first = true; it < maxit; first = false) {
+      ++it;
+      centers.clear();
+      for (size_t j = 0; j < k; ++j)
+        centers.emplace_back(_earth, latc[j], lonc[j]);
+      // Half the distance from each center to the nearest other center
+      Executor::Parallel(k, _threads, [&](size_t j) -> void {
+        real d = inf;
+        for (size_t j2 = 0; j2 < k; ++j2) {
+          if (j2 == j) continue;
+          real d2;
+          centers[j].Inverse(latc[j2], lonc[j2], d2);
+          d = min(d, d2);
+        }
+        s[j] = d / 2;
+      });
+      // Assign the points to the nearest centers
+      Executor::Parallel(nchunks, _threads, [&](size_t c) -> void {
+        const size_t i0 = c * chunk_, i1 = min(n, i0 + chunk_);
+        vector<real> d(k);
+        size_t nchg = 0;
+        for (size_t i = i0; i < i1; ++i) {
+          if (isnan(lat[i]) || isnan(lon[i])) {
+            assign[i] = 0; continue;
+          }
+          size_t a = first ? 0 : size_t(assign[i]);
+          if (!first) {
+            // Account for the moves of the centers in the last iteration
+            u[i] += move[a];
+            l[i] -= a == j1 ? p2 : p1;
+            real m = max(s[a], l[i]);
+            if (u[i] <= m) continue;
+            centers[a].Inverse(lat[i], lon[i], u[i]);
+            if (u[i] <= m) continue;
+          }
+          GeodesicOrigin origin(_earth, lat[i], lon[i]);
+          origin.InverseBatch(k, latc, lonc, d.data());
+          size_t b = 0;
+          real d1 = inf, d2 = inf;
+          for (size_t j = 0; j < k; ++j) {
+            if (d[j] < d1) {
+              d2 = d1; d1 = d[j]; b = j;
+            } else if (d[j] < d2)
+              d2 = d[j];
+          }
+          if (first || b != a) ++nchg;
+          assign[i] = int(b); u[i] = d1; l[i] = d2;
+        }
+        changes[c] = nchg;
+      });
+      size_t nchg = 0;
+      for (size_t c : changes) nchg += c;
+      // Sort the points by cluster and move the centers to the centroids
+      fill(off.begin(), off.end(), 0);
+      for (size_t i = 0; i < n; ++i)
+        if (!(isnan(lat[i]) || isnan(lon[i]))) ++off[assign[i] + 1];
+      for (size_t j = 0; j < k; ++j) off[j + 1] += off[j];
+      {
+        vector<size_t> pos(off.begin(), off.end() - 1);
+        for (size_t i = 0; i < n; ++i) {
+          if (isnan(lat[i]) || isnan(lon[i])) continue;
+          size_t p = pos[assign[i]]++;
+          slat[p] = lat[i]; slon[p] = lon[i];
+        }
+      }
+      Step(k, off.data(), slat.data(), slon.data(), nullptr,
+           latc, lonc, move.data());
+      p1 = p2 = 0; j1 = 0;
+      for (size_t j = 0; j < k; ++j) {
+        if (move[j] > p1) {
+          p2 = p1; p1 = move[j]; j1 = j;
+        } else if (move[j] > p2)
+          p2 = move[j];
+      }
+      if (!first && nchg == 0 && p1 <= tol) break;
+    }
+    if (dist) {
+      centers.clear();
+      for (size_t j = 0; j < k; ++j)
+        centers.emplace_back(_earth, latc[j], lonc[j]);
+      Executor::Parallel(nchunks, _threads, [&](size_t c) -> void {
+        for (size_t i = c * chunk_; i < min(n, (c + 1) * chunk_); ++i)
+          centers[assign[i]].Inverse(lat[i], lon[i], dist[i]);
+      });
+    }
+    return it;
+  }
+
+} // namespace GeographicLib
@@ -26,8 +26,12 @@
  * - s and c prefixes mean sin and cos
  **********************************************************************/
 
+#include <algorithm>
 #include <GeographicLib/GeodesicExact.hpp>
 #include <GeographicLib/GeodesicLineExact.hpp>
+#include <GeographicLib/GeodesicStats.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <GeographicLib/Trace.hpp>
 
 #if defined(_MSC_VER)
 // Squelch warnings about potentially uninitialized local variables and
@@ -82,12 +86,13 @@ namespace GeographicLib {
       // spherical case.
     , _etol2(real(0.1) * tol2_ /
              sqrt( max(real(0.001), abs(_f)) * min(real(1), 1 - _f/2) / 2 ))
+    , _Emer(-_ep2)
   {
     if (!(isfinite(_a) && _a > 0))
       throw GeographicErr("Equatorial radius is not positive");
     if (!(isfinite(_b) && _b > 0))
       throw GeographicErr("Polar semi-axis is not positive");
-    C4coeff();
+    // The coefficients for the area, _C4x, are computed on demand in C4f.
   }
 
   const GeodesicExact& GeodesicExact::WGS84() {
@@ -162,13 +167,49 @@ namespace GeographicLib {
     return GenDirectLine(lat1, lon1, azi1, true, a12, caps);
   }
 
+  void GeodesicExact::InverseLat(real& lat,
+                                 real& sbet, real& cbet, real& dn) const {
+    // The latitude dependent quantities needed by GenInverse for one of the
+    // end points.  lat is rounded on output.
+    // If really close to the equator, treat as on equator.
+    lat = Math::AngRound(Math::LatFix(lat));
+    Math::sincosd(lat, sbet, cbet); sbet *= _f1;
+    // Ensure cbet = +epsilon at poles; doing the fix on beta means that sig12
+    // will be <= 2*tiny for two points at the same pole.
+    Math::norm(sbet, cbet); cbet = max(tiny_, cbet);
+    dn = (_f >= 0 ? sqrt(1 + _ep2 * Math::sq(sbet)) :
+          sqrt(1 - _e2 * Math::sq(cbet)) / _f1);
+  }
+
   Math::real GeodesicExact::GenInverse(real lat1, real lon1,
                                        real lat2, real lon2,
                                        unsigned outmask, real& s12,
                                        real& salp1, real& calp1,
                                        real& salp2, real& calp2,
                                        real& m12, real& M12, real& M21,
-                                       real& S12) const {
+                                       real& S12, bool hint) const {
+    real sbet1, cbet1, dn1, sbet2, cbet2, dn2;
+    InverseLat(lat1, sbet1, cbet1, dn1);
+    InverseLat(lat2, sbet2, cbet2, dn2);
+    return GenInverse(lat1, sbet1, cbet1, dn1, lon1,
+                      lat2, sbet2, cbet2, dn2, lon2,
+                      outmask, s12, salp1, calp1, salp2, calp2,
+                      m12, M12, M21, S12, hint);
+  }
+
+  Math::real GeodesicExact::GenInverse(real lat1, real sbet1, real cbet1,
+                                       real dn1, real lon1,
+                                       real lat2, real sbet2, real cbet2,
+                                       real dn2, real lon2,
+                                       unsigned outmask, real& s12,
+                                       real& salp1, real& calp1,
+                                       real& salp2, real& calp2,
+                                       real& m12, real& M12, real& M21,
+                                       real& S12, bool hint) const {
+    // The approximate azimuths of the solution
+    const real
+      salp1h = hint ? salp1 : 0, calp1h = hint ? calp1 : 0,
+      salp2h = hint ? salp2 : 0, calp2h = hint ? calp2 : 0;
     // Compute longitude difference (AngDiff does this carefully).  Result is
     // in [-180, 180] but -180 is only for west-going geodesics.  180 is for
     // east-going and meridional geodesics.
@@ -187,20 +228,26 @@ namespace GeographicLib {
     } else
       Math::sincosd(lon12, slam12, clam12);
 
-    // If really close to the equator, treat as on equator.
-    lat1 = Math::AngRound(Math::LatFix(lat1));
-    lat2 = Math::AngRound(Math::LatFix(lat2));
+    // lat1 and lat2 have already been rounded by InverseLat, which also sets
+    // sbet, cbet, and dn for each point.
     // Swap points so that point with higher (abs) latitude is point 1
     // If one latitude is a nan, then it becomes lat1.
     int swapp = abs(lat1) < abs(lat2) ? -1 : 1;
     if (swapp < 0) {
       lonsign *= -1;
       swap(lat1, lat2);
+      swap(sbet1, sbet2);
+      swap(cbet1, cbet2);
+      swap(dn1, dn2);
     }
     // Make lat1 <= 0
     int latsign = lat1 < 0 ? 1 : -1;
     lat1 *= latsign;
     lat2 *= latsign;
+    // sincosd is odd in its argument, so this is equivalent to recomputing the
+    // reduced latitudes from lat1 and lat2.
+    sbet1 *= latsign;
+    sbet2 *= latsign;
     // Now we have
     //
     //     0 <= lon12 <= 180
@@ -213,19 +260,10 @@ namespace GeographicLib {
     // check, e.g., on verifying quadrants in atan2.  In addition, this
     // enforces some symmetries in the results returned.
 
-    real sbet1, cbet1, sbet2, cbet2, s12x, m12x;
+    real s12x, m12x;
     // Initialize for the meridian.  No longitude calculation is done in this
     // case to let the parameter default to 0.
-    EllipticFunction E(-_ep2);
-
-    Math::sincosd(lat1, sbet1, cbet1); sbet1 *= _f1;
-    // Ensure cbet1 = +epsilon at poles; doing the fix on beta means that sig12
-    // will be <= 2*tiny for two points at the same pole.
-    Math::norm(sbet1, cbet1); cbet1 = max(tiny_, cbet1);
-
-    Math::sincosd(lat2, sbet2, cbet2); sbet2 *= _f1;
-    // Ensure cbet2 = +epsilon at poles
-    Math::norm(sbet2, cbet2); cbet2 = max(tiny_, cbet2);
+    EllipticFunction E(_Emer);
 
     // If cbet1 < -sbet1, then cbet2 - cbet1 is a sensitive measure of the
     // |bet1| - |bet2|.  Alternatively (cbet1 >= -sbet1), abs(sbet2) + sbet1 is
@@ -235,20 +273,19 @@ namespace GeographicLib {
     // 48.522876735459 0 -48.52287673545898293 179.599720456223079643
     // which failed with Visual Studio 10 (Release and Debug)
 
+    // In these cases, dn1 and dn2 are equal.
     if (cbet1 < -sbet1) {
-      if (cbet2 == cbet1)
+      if (cbet2 == cbet1) {
         sbet2 = sbet2 < 0 ? sbet1 : -sbet1;
+        dn2 = dn1;
+      }
     } else {
-      if (abs(sbet2) == -sbet1)
+      if (abs(sbet2) == -sbet1) {
         cbet2 = cbet1;
+        dn2 = dn1;
+      }
     }
 
-    real
-      dn1 = (_f >= 0 ? sqrt(1 + _ep2 * Math::sq(sbet1)) :
-             sqrt(1 - _e2 * Math::sq(cbet1)) / _f1),
-      dn2 = (_f >= 0 ? sqrt(1 + _ep2 * Math::sq(sbet2)) :
-             sqrt(1 - _e2 * Math::sq(cbet2)) / _f1);
-
     real a12, sig12;
 
     bool meridian = lat1 == -90 || slam12 == 0;
@@ -291,6 +328,9 @@ namespace GeographicLib {
         m12x *= _b;
         s12x *= _b;
         a12 = sig12 / Math::degree();
+        if (GEOGRAPHICLIB_GEODESIC_STATS)
+          GeodesicStats::Record(GeodesicStats::GEODESICEXACT,
+                                GeodesicStats::MERIDIONAL);
       } else
         // m12 < 0, i.e., prolate and too close to anti-podal
         meridian = false;
@@ -310,6 +350,9 @@ namespace GeographicLib {
       if (outmask & GEODESICSCALE)
         M12 = M21 = cos(sig12);
       a12 = lon12 / _f1;
+      if (GEOGRAPHICLIB_GEODESIC_STATS)
+        GeodesicStats::Record(GeodesicStats::GEODESICEXACT,
+                              GeodesicStats::EQUATORIAL);
 
     } else if (!meridian) {
 
@@ -330,8 +373,28 @@ namespace GeographicLib {
           M12 = M21 = cos(sig12 / dnm);
         a12 = sig12 / Math::degree();
         omg12 = lam12 / (_f1 * dnm);
+        if (GEOGRAPHICLIB_GEODESIC_STATS)
+          GeodesicStats::Record(GeodesicStats::GEODESICEXACT,
+                                GeodesicStats::SHORT);
       } else {
 
+        // Set if the iteration starts from the approximate solution; salp1x
+        // and calp1x then hold the starting point given by InverseStart.
+        bool hinted = false;
+        real salp1x = 0, calp1x = 0;
+        if (hint) {
+          // Transform the approximate azimuth at (the canonical) point 1 to
+          // the canonical form; see the end of this function.
+          salp1x = (swapp < 0 ? salp2h : salp1h) * swapp * lonsign;
+          calp1x = (swapp < 0 ? calp2h : calp1h) * swapp * latsign;
+          Math::norm(salp1x, calp1x);
+          // Use it only if it's a legal starting point
+          if (salp1x > 0 && isfinite(calp1x)) {
+            swap(salp1, salp1x); swap(calp1, calp1x);
+            hinted = true;
+          }
+        }
+
         // Newton's method.  This is a straightforward solution of f(alp1) =
         // lambda12(alp1) - lam12 = 0 with one wrinkle.  f(alp) has exactly one
         // root in the interval (0, pi) and its derivative is positive at the
@@ -346,7 +409,7 @@ namespace GeographicLib {
         //
         // initial values to suppress warnings (if loop is executed 0 times)
         real ssig1 = 0, csig1 = 0, ssig2 = 0, csig2 = 0, domg12 = 0;
-        unsigned numit = 0;
+        unsigned numit = 0, numbis = 0;
         // Bracketing range
         real salp1a = tiny_, calp1a = 1, salp1b = tiny_, calp1b = -1;
         for (bool tripn = false, tripb = false;
@@ -402,6 +465,16 @@ namespace GeographicLib {
               continue;
             }
           }
+          if (hinted) {
+            // The approximate solution was a poor starting point; start again
+            // from InverseStart's estimate (see Geodesic::GenInverse).
+            hinted = false;
+            salp1 = salp1x; calp1 = calp1x;
+            salp1a = tiny_; calp1a = 1; salp1b = tiny_; calp1b = -1;
+            tripn = false;
+            numit = unsigned(-1);
+            continue;
+          }
           // Either dv was not positive or updated value was outside legal
           // range.  Use the midpoint of the bracket as the next estimate.
           // This mechanism is not needed for the WGS84 ellipsoid, but it does
@@ -413,10 +486,14 @@ namespace GeographicLib {
           salp1 = (salp1a + salp1b)/2;
           calp1 = (calp1a + calp1b)/2;
           Math::norm(salp1, calp1);
+          ++numbis;
           tripn = false;
           tripb = (abs(salp1a - salp1) + (calp1a - calp1) < tolb_ ||
                    abs(salp1 - salp1b) + (calp1 - calp1b) < tolb_);
         }
+        if (GEOGRAPHICLIB_GEODESIC_STATS)
+          GeodesicStats::Record(GeodesicStats::GEODESICEXACT,
+                                GeodesicStats::GENERAL, numit, numbis);
         {
           real dummy;
           Lengths(E, sig12, ssig1, csig1, dn1, ssig2, csig2, dn2,
@@ -537,19 +614,113 @@ namespace GeographicLib {
     return a12;
   }
 
+  Math::real GeodesicExact::GenInverseHint(real lat1, real lon1,
+                                           real lat2, real lon2,
+                                           unsigned outmask,
+                                           real& s12, real& azi1, real& azi2,
+                                           real& m12, real& M12, real& M21,
+                                           real& S12) const {
+    outmask &= OUT_MASK;
+    real salp1, calp1, salp2, calp2;
+    Math::sincosd(azi1, salp1, calp1);
+    Math::sincosd(azi2, salp2, calp2);
+    real a12 = GenInverse(lat1, lon1, lat2, lon2,
+                          outmask, s12, salp1, calp1, salp2, calp2,
+                          m12, M12, M21, S12, true);
+    azi1 = Math::atan2d(salp1, calp1);
+    azi2 = Math::atan2d(salp2, calp2);
+    return a12;
+  }
+
+  void GeodesicExact::InverseBatch(size_t n,
+                                   const real lat1[], const real lon1[],
+                                   const real lat2[], const real lon2[],
+                                   unsigned outmask,
+                                   real s12[], real azi1[], real azi2[],
+                                   real m12[], real M12[], real M21[],
+                                   real S12[], real a12[],
+                                   unsigned threads) const {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "GeodesicExact::InverseBatch", n);
+    outmask &= OUT_MASK;
+    // Hoist the tests on outmask out of the loop.
+    const bool
+      dist = (outmask & DISTANCE) != 0,
+      azi = (outmask & AZIMUTH) != 0,
+      redl = (outmask & REDUCEDLENGTH) != 0,
+      scale = (outmask & GEODESICSCALE) != 0,
+      area = (outmask & AREA) != 0;
+    // Compute the area coefficients before starting the threads.
+    if (area) { real c[nC4_]; C4f(0, c); }
+    // Problems are handled in chunks of this size
+    const size_t chunk = 64;
+    Executor::Parallel((n + chunk - 1) / chunk, threads,
+                       [&](size_t t) -> void {
+      for (size_t i = t * chunk; i < min(n, (t + 1) * chunk); ++i) {
+        real s12x = 0, salp1, calp1, salp2, calp2,
+          m12x = 0, M12x = 0, M21x = 0, S12x = 0,
+          a12x = GenInverse(lat1[i], lon1[i], lat2[i], lon2[i],
+                            outmask, s12x, salp1, calp1, salp2, calp2,
+                            m12x, M12x, M21x, S12x);
+        if (dist) s12[i] = s12x;
+        if (azi) {
+          azi1[i] = Math::atan2d(salp1, calp1);
+          azi2[i] = Math::atan2d(salp2, calp2);
+        }
+        if (redl) m12[i] = m12x;
+        if (scale) { M12[i] = M12x; M21[i] = M21x; }
+        if (area) S12[i] = S12x;
+        if (a12) a12[i] = a12x;
+      }
+    });
+  }
+
+  void GeodesicExact::DirectBatch(size_t n,
+                                  const real lat1[], const real lon1[],
+                                  const real azi1[], const real s12[],
+                                  unsigned outmask,
+                                  real lat2[], real lon2[], real azi2[],
+                                  real m12[], real M12[], real M21[],
+                                  real S12[], real a12[],
+                                  unsigned threads) const {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "GeodesicExact::DirectBatch", n);
+    // Hoist the tests on outmask out of the loop.  outmask is passed
+    // unchanged to GenDirect which uses it to set the capabilities of the
+    // GeodesicLineExact.
+    const unsigned out = outmask & OUT_MASK;
+    const bool
+      lat = (out & LATITUDE) != 0,
+      lon = (out & LONGITUDE) != 0,
+      azi = (out & AZIMUTH) != 0,
+      redl = (out & REDUCEDLENGTH) != 0,
+      scale = (out & GEODESICSCALE) != 0,
+      area = (out & AREA) != 0;
+    if (area) { real c[nC4_]; C4f(0, c); }
+    const size_t chunk = 64;
+    Executor::Parallel((n + chunk - 1) / chunk, threads,
+                       [&](size_t t) -> void {
+      for (size_t i = t * chunk; i < min(n, (t + 1) * chunk); ++i) {
+        real lat2x = 0, lon2x = 0, azi2x = 0, s12x,
+          m12x = 0, M12x = 0, M21x = 0, S12x = 0,
+          a12x = GenDirect(lat1[i], lon1[i], azi1[i], false, s12[i], outmask,
+                           lat2x, lon2x, azi2x, s12x,
+                           m12x, M12x, M21x, S12x);
+        if (lat) lat2[i] = lat2x;
+        if (lon) lon2[i] = lon2x;
+        if (azi) azi2[i] = azi2x;
+        if (redl) m12[i] = m12x;
+        if (scale) { M12[i] = M12x; M21[i] = M21x; }
+        if (area) S12[i] = S12x;
+        if (a12) a12[i] = a12x;
+      }
+    });
+  }
+
   GeodesicLineExact GeodesicExact::InverseLine(real lat1, real lon1,
                                                real lat2, real lon2,
                                                unsigned caps) const {
-    real t, salp1, calp1, salp2, calp2,
-      a12 = GenInverse(lat1, lon1, lat2, lon2,
-                       // No need to specify AZIMUTH here
-                       0u, t, salp1, calp1, salp2, calp2,
-                       t, t, t, t),
-      azi1 = Math::atan2d(salp1, calp1);
-    // Ensure that a12 can be converted to a distance
-    if (caps & (OUT_MASK & DISTANCE_IN)) caps |= DISTANCE;
-    return GeodesicLineExact(*this, lat1, lon1, azi1, salp1, calp1, caps,
-                             true, a12);
+    GeodesicLineExact line;
+    line.ResetInverse(*this, lat1, lon1, lat2, lon2, caps);
+    return line;
   }
 
   void GeodesicExact::Lengths(const EllipticFunction& E,
@@ -901,6 +1072,14 @@ namespace GeographicLib {
   void GeodesicExact::C4f(real eps, real c[]) const {
     // Evaluate C4 coeffs
     // Elements c[0] thru c[nC4_ - 1] are set
+    if (!_C4lazy.init.load(memory_order_acquire)) {
+      // Compute _C4x on first use (double-checked locking)
+      lock_guard<mutex> lock(_C4lazy.lock);
+      if (!_C4lazy.init.load(memory_order_relaxed)) {
+        C4coeff();
+        _C4lazy.init.store(true, memory_order_release);
+      }
+    }
     real mult = 1;
     int o = 0;
     for (int l = 0; l < nC4_; ++l) { // l is index of C4[l]
@@ -33,7 +33,7 @@ namespace GeographicLib {
   // so the cast is not needed; 21708121824 = 678378807*2^5 and 678378807 >=
   // 2^24 so the cast is needed.
 
-  void GeodesicExact::C4coeff() {
+  void GeodesicExact::C4coeff() const {
     // Generated by Maxima on 2017-05-27 10:17:57-04:00
 #if GEOGRAPHICLIB_GEODESICEXACT_ORDER == 24
     static const real coeff[] = {
@@ -0,0 +1,217 @@
+/**
+ * \file GeodesicIntersect.cpp
+ * \brief Implementation for GeographicLib::GeodesicIntersect class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <algorithm>
+#include <thread>
+#include <GeographicLib/GeodesicIntersect.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/Executor.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  GeodesicIntersect::GeodesicIntersect(const Geodesic& earth,
+                                       unsigned threads)
+    : _earth(earth)
+    , _gn(_earth)
+      // The convergence is quadratic, so the error after a step of this size
+      // is negligible.
+    , _tol(real(0.01) * sqrt(numeric_limits<real>::epsilon()) *
+           _earth.EquatorialRadius())
+    , _threads(threads ? threads : thread::hardware_concurrency())
+  {
+    // hardware_concurrency returns 0 if the number of cores can't be
+    // determined.
+    if (_threads == 0) _threads = 1;
+  }
+
+  bool GeodesicIntersect::Segment(real lata1, real lona1,
+                                  real lata2, real lona2,
+                                  real latb1, real lonb1,
+                                  real latb2, real lonb2,
+                                  real& lat, real& lon) const {
+    lat = lon = Math::NaN();
+    // Start at the mean of the end points
+    real
+      lat0 = (lata1 + lata2 + latb1 + latb2) / 4,
+      lon0 = lona1 + (Math::AngDiff(lona1, lona2) +
+                      Math::AngDiff(lona1, lonb1) +
+                      Math::AngDiff(lona1, lonb2)) / 4;
+    for (int i = 0; i < maxit_; ++i) {
+      real xa1, ya1, xa2, ya2, xb1, yb1, xb2, yb2;
+      _gn.Forward(lat0, lon0, lata1, lona1, xa1, ya1);
+      _gn.Forward(lat0, lon0, lata2, lona2, xa2, ya2);
+      _gn.Forward(lat0, lon0, latb1, lonb1, xb1, yb1);
+      _gn.Forward(lat0, lon0, latb2, lonb2, xb2, yb2);
+      // The lines A1A2 and B1B2 and their intersection P in homogeneous
+      // coordinates; see Hartley and Zisserman, Multiple View Geometry, Sec.
+      // 2.2.1.
+      real
+        la0 = ya1 - ya2, la1 = xa2 - xa1, la2 = xa1 * ya2 - ya1 * xa2,
+        lb0 = yb1 - yb2, lb1 = xb2 - xb1, lb2 = xb1 * yb2 - yb1 * xb2,
+        pz = la0 * lb1 - la1 * lb0,
+        px = (la1 * lb2 - la2 * lb1) / pz,
+        py = (la2 * lb0 - la0 * lb2) / pz;
+      // Parallel lines or end points more than 90 degrees from the center
+      if (!(isfinite(px) && isfinite(py)))
+        return false;
+      real lat1, lon1;
+      _gn.Reverse(lat0, lon0, px, py, lat1, lon1);
+      if (isnan(lat1))
+        return false;
+      lat0 = lat1; lon0 = lon1;
+      if (hypot(px, py) <= _tol) {
+        lat = lat0; lon = Math::AngNormalize(lon0);
+        // P lies between the end points of each segment
+        return
+          (xa1 - px) * (xa2 - px) + (ya1 - py) * (ya2 - py) <= 0 &&
+          (xb1 - px) * (xb2 - px) + (yb1 - py) * (yb2 - py) <= 0;
+      }
+    }
+    return false;
+  }
+
+  GeodesicIntersect::box GeodesicIntersect::Box(real lat1, real lon1,
+                                                real lat2, real lon2) const {
+    // Pad the box to allow for roundoff errors
+    static const real pad = real(1e-6);
+    box b;
+    _earth.InverseLine(lat1, lon1, lat2, lon2,
+                       Geodesic::LATITUDE | Geodesic::LONGITUDE).
+      BoundingBox(b.latmin, b.latmax, b.lon, b.dlon);
+    b.latmin -= pad; b.latmax += pad;
+    if (abs(lat1) == real(90) || abs(lat2) == real(90) ||
+        b.dlon == real(360)) {
+      // The segment passes through a pole
+      b.lon = -real(180); b.dlon = real(360);
+    } else {
+      b.lon = Math::AngNormalize(b.lon - pad);
+      b.dlon = min(real(360), b.dlon + 2 * pad);
+    }
+    return b;
+  }
+
+  bool GeodesicIntersect::Overlap(const box& a, const box& b) {
+    if (!(a.latmin <= b.latmax && b.latmin <= a.latmax))
+      return false;
+    real d = Math::AngNormalize(b.lon - a.lon);
+    if (d < 0) d += real(360);
+    return d <= a.dlon || d + b.dlon >= real(360);
+  }
+
+  size_t GeodesicIntersect::Segments(size_t na,
+                                     const real lata1[], const real lona1[],
+                                     const real lata2[], const real lona2[],
+                                     size_t nb,
+                                     const real latb1[], const real lonb1[],
+                                     const real latb2[], const real lonb2[],
+                                     vector<size_t>& ia, vector<size_t>& ib,
+                                     vector<real>& lat, vector<real>& lon)
+    const {
+    ia.clear(); ib.clear(); lat.clear(); lon.clear();
+    if (na == 0 || nb == 0) return 0;
+    // Segments are handled in chunks of this size
+    const size_t chunk = 64;
+    vector<box> boxa(na), boxb(nb);
+    Executor::Parallel((na + chunk - 1) / chunk, _threads,
+                       [&](size_t t) -> void {
+      for (size_t i = t * chunk; i < min(na, (t + 1) * chunk); ++i)
+        boxa[i] = Box(lata1[i], lona1[i], lata2[i], lona2[i]);
+    });
+    Executor::Parallel((nb + chunk - 1) / chunk, _threads,
+                       [&](size_t t) -> void {
+      for (size_t j = t * chunk; j < min(nb, (t + 1) * chunk); ++j)
+        boxb[j] = Box(latb1[j], lonb1[j], latb2[j], lonb2[j]);
+    });
+    // The grid cell size (degrees) is the mean size of the boxes for set b,
+    // so that each of these covers a few cells.
+    real sb = 0;
+    for (const box& b : boxb) sb += max(b.latmax - b.latmin, b.dlon);
+    real cell = sb / real(nb);
+    cell = isfinite(cell) ? min(real(30), max(real(0.01), cell)) : real(30);
+    const size_t ncol = size_t(ceil(real(360) / cell));
+    // Make the columns fit exactly so that they wrap around correctly
+    cell = real(360) / real(ncol);
+    const size_t
+      nrow = size_t(ceil(real(180) / cell)),
+      // Boxes for set b covering more cells than this aren't binned
+      maxcells = 64;
+    // The range of cells covered by a box; the columns wrap around.
+    auto cells = [&](const box& b, size_t& r0, size_t& r1,
+                     size_t& c0, size_t& nc) -> void {
+      r0 = min(nrow - 1, size_t(max(real(0), (b.latmin + real(90)) / cell)));
+      r1 = min(nrow - 1, size_t(max(real(0), (b.latmax + real(90)) / cell)));
+      real w = b.lon + real(180);
+      if (w >= real(360)) w -= real(360);
+      c0 = min(ncol - 1, size_t(max(real(0), w / cell)));
+      nc = min(ncol, size_t(max(real(0), (w + b.dlon) / cell)) - c0 + 1);
+    };
+    // Bin the boxes for set b by cell (key = row * ncol + column); the big
+    // ones are checked for every segment of set a.
+    vector<pair<size_t, size_t>> bins;
+    vector<size_t> big;
+    for (size_t j = 0; j < nb; ++j) {
+      size_t r0, r1, c0, nc;
+      cells(boxb[j], r0, r1, c0, nc);
+      if ((r1 - r0 + 1) * nc > maxcells) {
+        big.push_back(j);
+        continue;
+      }
+      for (size_t r = r0; r <= r1; ++r)
+        for (size_t k = 0; k < nc; ++k)
+          bins.push_back(make_pair(r * ncol + (c0 + k) % ncol, j));
+    }
+    sort(bins.begin(), bins.end());
+    // Append the entries of bins with keys in [k0, k1) to cand
+    auto scan = [&](size_t k0, size_t k1, vector<size_t>& cand) -> void {
+      for (auto p = lower_bound(bins.begin(), bins.end(),
+                                make_pair(k0, size_t(0)));
+           p != bins.end() && p->first < k1; ++p)
+        cand.push_back(p->second);
+    };
+    struct hit { size_t a, b; real lat, lon; };
+    const size_t nchunks = (na + chunk - 1) / chunk;
+    vector<vector<hit>> hits(nchunks);
+    Executor::Parallel(nchunks, _threads, [&](size_t t) -> void {
+      vector<size_t> cand;
+      for (size_t i = t * chunk; i < min(na, (t + 1) * chunk); ++i) {
+        const box& a = boxa[i];
+        size_t r0, r1, c0, nc;
+        cells(a, r0, r1, c0, nc);
+        cand.assign(big.begin(), big.end());
+        // The cells in a row have consecutive keys (in two ranges if the box
+        // wraps around in longitude)
+        for (size_t r = r0; r <= r1; ++r) {
+          size_t c1 = c0 + nc;
+          scan(r * ncol + c0, r * ncol + min(c1, ncol), cand);
+          if (c1 > ncol) scan(r * ncol, r * ncol + (c1 - ncol), cand);
+        }
+        sort(cand.begin(), cand.end());
+        cand.erase(unique(cand.begin(), cand.end()), cand.end());
+        for (size_t j : cand) {
+          real latx, lonx;
+          if (Overlap(a, boxb[j]) &&
+              Segment(lata1[i], lona1[i], lata2[i], lona2[i],
+                      latb1[j], lonb1[j], latb2[j], lonb2[j], latx, lonx)) {
+            hit h = {i, j, latx, lonx};
+            hits[t].push_back(h);
+          }
+        }
+      }
+    });
+    for (const auto& hs : hits)
+      for (const hit& h : hs) {
+        ia.push_back(h.a); ib.push_back(h.b);
+        lat.push_back(h.lat); lon.push_back(h.lon);
+      }
+    return ia.size();
+  }
+
+} // namespace GeographicLib
@@ -47,6 +47,7 @@ namespace GeographicLib {
     _b = g._b;
     _c2 = g._c2;
     _f1 = g._f1;
+    _sphere = g._sphere;
     // Always allow latitude and azimuth and unrolling of longitude
     _caps = caps | LATITUDE | AZIMUTH | LONG_UNROLL;
 
@@ -78,6 +79,15 @@ namespace GeographicLib {
     _k2 = Math::sq(_calp0) * g._ep2;
     real eps = _k2 / (2 * (1 + sqrt(1 + _k2)) + _k2);
 
+    if (_sphere) {
+      // All the series vanish for a sphere and GenPosition skips them.
+      _A1m1 = _A2m1 = _B11 = _B21 = _B31 = _A4 = _B41 = 0;
+      _A3c = -_f * _salp0;
+      _stau1 = _ssig1; _ctau1 = _csig1;
+      _a13 = _s13 = Math::NaN();
+      return;
+    }
+
     if (_caps & CAP_C1) {
       _A1m1 = Geodesic::A1m1f(eps);
       Geodesic::C1f(eps, _C1a);
@@ -118,6 +128,12 @@ namespace GeographicLib {
   GeodesicLine::GeodesicLine(const Geodesic& g,
                              real lat1, real lon1, real azi1,
                              unsigned caps) {
+    Reset(g, lat1, lon1, azi1, caps);
+  }
+
+  void GeodesicLine::Reset(const Geodesic& g,
+                           real lat1, real lon1, real azi1,
+                           unsigned caps) {
     azi1 = Math::AngNormalize(azi1);
     real salp1, calp1;
     // Guard against underflow in salp0.  Also -0 is converted to +0.
@@ -125,6 +141,22 @@ namespace GeographicLib {
     LineInit(g, lat1, lon1, azi1, salp1, calp1, caps);
   }
 
+  void GeodesicLine::ResetInverse(const Geodesic& g,
+                                  real lat1, real lon1,
+                                  real lat2, real lon2,
+                                  unsigned caps) {
+    real t, salp1, calp1, salp2, calp2,
+      a12 = g.GenInverse(lat1, lon1, lat2, lon2,
+                         // No need to specify AZIMUTH here
+                         0u, t, salp1, calp1, salp2, calp2,
+                         t, t, t, t),
+      azi1 = Math::atan2d(salp1, calp1);
+    // Ensure that a12 can be converted to a distance
+    if (caps & (OUT_MASK & DISTANCE_IN)) caps |= DISTANCE;
+    LineInit(g, lat1, lon1, azi1, salp1, calp1, caps);
+    SetArc(a12);
+  }
+
   GeodesicLine::GeodesicLine(const Geodesic& g,
                              real lat1, real lon1,
                              real azi1, real salp1, real calp1,
@@ -150,6 +182,9 @@ namespace GeographicLib {
       // Interpret s12_a12 as spherical arc length
       sig12 = s12_a12 * Math::degree();
       Math::sincosd(s12_a12, ssig12, csig12);
+    } else if (_sphere) {
+      sig12 = s12_a12 / _b;
+      ssig12 = sin(sig12); csig12 = cos(sig12);
     } else {
       // Interpret s12_a12 as distance
       real
@@ -202,7 +237,7 @@ namespace GeographicLib {
     ssig2 = _ssig1 * csig12 + _csig1 * ssig12;
     csig2 = _csig1 * csig12 - _ssig1 * ssig12;
     real dn2 = sqrt(1 + _k2 * Math::sq(ssig2));
-    if (outmask & (DISTANCE | REDUCEDLENGTH | GEODESICSCALE)) {
+    if (!_sphere && (outmask & (DISTANCE | REDUCEDLENGTH | GEODESICSCALE))) {
       if (arcmode || abs(_f) > 0.01)
         B12 = Geodesic::SinCosSeries(true, ssig2, csig2, _C1a, nC1_);
       AB1 = (1 + _A1m1) * (B12 - _B11);
@@ -231,7 +266,7 @@ namespace GeographicLib {
                + (atan2(E * somg2, comg2) - atan2(E * _somg1, _comg1)))
         : atan2(somg2 * _comg1 - comg2 * _somg1,
                 comg2 * _comg1 + somg2 * _somg1);
-      real lam12 = omg12 + _A3c *
+      real lam12 = _sphere ? omg12 : omg12 + _A3c *
         ( sig12 + (Geodesic::SinCosSeries(true, ssig2, csig2, _C3a, nC3_-1)
                    - _B31));
       real lon12 = lam12 / Math::degree();
@@ -247,10 +282,13 @@ namespace GeographicLib {
       azi2 = Math::atan2d(salp2, calp2);
 
     if (outmask & (REDUCEDLENGTH | GEODESICSCALE)) {
-      real
-        B22 = Geodesic::SinCosSeries(true, ssig2, csig2, _C2a, nC2_),
-        AB2 = (1 + _A2m1) * (B22 - _B21),
+      real J12 = 0;
+      if (!_sphere) {
+        real
+          B22 = Geodesic::SinCosSeries(true, ssig2, csig2, _C2a, nC2_),
+          AB2 = (1 + _A2m1) * (B22 - _B21);
         J12 = (_A1m1 - _A2m1) * sig12 + (AB1 - AB2);
+      }
       if (outmask & REDUCEDLENGTH)
         // Add parens around (_csig1 * ssig2) and (_ssig1 * csig2) to ensure
         // accurate cancellation in the case of coincident points.
@@ -264,8 +302,8 @@ namespace GeographicLib {
     }
 
     if (outmask & AREA) {
-      real
-        B42 = Geodesic::SinCosSeries(false, ssig2, csig2, _C4a, nC4_);
+      real B42 = _sphere ? 0 :
+        Geodesic::SinCosSeries(false, ssig2, csig2, _C4a, nC4_);
       real salp12, calp12;
       if (_calp0 == 0 || _salp0 == 0) {
         // alp12 = alp2 - alp1, used in atan2 so no need to normalize
@@ -298,6 +336,43 @@ namespace GeographicLib {
     return arcmode ? s12_a12 : sig12 / Math::degree();
   }
 
+  void GeodesicLine::GenPositions(bool arcmode, size_t n,
+                                  const real s12_a12[],
+                                  real s0_a0, real ds_da, unsigned outmask,
+                                  real lat2[], real lon2[], real azi2[],
+                                  real s12[], real m12[],
+                                  real M12[], real M21[],
+                                  real S12[], real a12[]) const {
+    outmask &= _caps & OUT_MASK;
+    // Hoist the tests on outmask out of the loop.
+    const bool
+      lat = (outmask & LATITUDE) != 0,
+      lon = (outmask & LONGITUDE) != 0,
+      azi = (outmask & AZIMUTH) != 0,
+      dist = (outmask & DISTANCE) != 0,
+      redl = (outmask & REDUCEDLENGTH) != 0,
+      scale = (outmask & GEODESICSCALE) != 0,
+      area = (outmask & AREA) != 0;
+    for (size_t i = 0; i < n; ++i) {
+      // Compute each point from s0_a0 directly to avoid accumulating errors.
+      real
+        s12_a12x = s12_a12 ? s12_a12[i] : s0_a0 + real(i) * ds_da,
+        lat2x = 0, lon2x = 0, azi2x = 0, s12x = 0,
+        m12x = 0, M12x = 0, M21x = 0, S12x = 0,
+        a12x = GenPosition(arcmode, s12_a12x, outmask,
+                           lat2x, lon2x, azi2x, s12x,
+                           m12x, M12x, M21x, S12x);
+      if (lat) lat2[i] = lat2x;
+      if (lon) lon2[i] = lon2x;
+      if (azi) azi2[i] = azi2x;
+      if (dist) s12[i] = s12x;
+      if (redl) m12[i] = m12x;
+      if (scale) { M12[i] = M12x; M21[i] = M21x; }
+      if (area) S12[i] = S12x;
+      if (a12) a12[i] = a12x;
+    }
+  }
+
   void GeodesicLine::SetDistance(real s13) {
     _s13 = s13;
     real t;
@@ -318,4 +393,39 @@ namespace GeographicLib {
     arcmode ? SetArc(s13_a13) : SetDistance(s13_a13);
   }
 
+  void GeodesicLine::BoundingBox(real& latmin, real& latmax,
+                                 real& lonw, real& dlon) const {
+    latmin = latmax = lonw = dlon = Math::NaN();
+    real lat3, lon3, t;
+    // lat3 and lon3 are NaNs if point 3 isn't set or the capabilities are
+    // missing.
+    GenPosition(true, _a13, LATITUDE | LONGITUDE | LONG_UNROLL,
+                lat3, lon3, t, t, t, t, t, t);
+    if (!(isfinite(lat3) && isfinite(lon3))) return;
+    latmin = min(_lat1, lat3); latmax = max(_lat1, lat3);
+    // The range of sig, measured from the northward equator crossing, for
+    // the segment.  sin(bet) = calp0 * sin(sig), so the vertices are at sig
+    // = +/- pi/2 mod 2*pi.
+    real sig1 = atan2(_ssig1, _csig1), sig3 = sig1 + _a13 * Math::degree(),
+      siga = min(sig1, sig3), sigb = max(sig1, sig3),
+      pi2 = Math::pi() / 2,
+      // The latitude of the vertex; 90 for meridional geodesics
+      lat0 = Math::atan2d(_calp0, _f1 * abs(_salp0));
+    bool pole = false;
+    if (ceil((siga - pi2) / (4 * pi2)) * 4 * pi2 + pi2 <= sigb) {
+      latmax = max(latmax, lat0); pole = pole || lat0 == real(90);
+    }
+    if (ceil((siga + pi2) / (4 * pi2)) * 4 * pi2 - pi2 <= sigb) {
+      latmin = min(latmin, -lat0); pole = pole || lat0 == real(90);
+    }
+    real lon13 = lon3 - _lon1;
+    if (pole || abs(lon13) >= real(360)) {
+      lonw = -real(180); dlon = real(360);
+    } else {
+      lonw = Math::AngNormalize(lon13 >= 0 ? _lon1 : lon3);
+      if (lonw == real(180)) lonw = -real(180);
+      dlon = abs(lon13);
+    }
+  }
+
 } // namespace GeographicLib
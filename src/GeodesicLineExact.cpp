@@ -118,6 +118,12 @@ namespace GeographicLib {
   GeodesicLineExact::GeodesicLineExact(const GeodesicExact& g,
                                        real lat1, real lon1, real azi1,
                                        unsigned caps) {
+    Reset(g, lat1, lon1, azi1, caps);
+  }
+
+  void GeodesicLineExact::Reset(const GeodesicExact& g,
+                                real lat1, real lon1, real azi1,
+                                unsigned caps) {
     azi1 = Math::AngNormalize(azi1);
     real salp1, calp1;
     // Guard against underflow in salp0.  Also -0 is converted to +0.
@@ -125,6 +131,22 @@ namespace GeographicLib {
     LineInit(g, lat1, lon1, azi1, salp1, calp1, caps);
   }
 
+  void GeodesicLineExact::ResetInverse(const GeodesicExact& g,
+                                       real lat1, real lon1,
+                                       real lat2, real lon2,
+                                       unsigned caps) {
+    real t, salp1, calp1, salp2, calp2,
+      a12 = g.GenInverse(lat1, lon1, lat2, lon2,
+                         // No need to specify AZIMUTH here
+                         0u, t, salp1, calp1, salp2, calp2,
+                         t, t, t, t),
+      azi1 = Math::atan2d(salp1, calp1);
+    // Ensure that a12 can be converted to a distance
+    if (caps & (OUT_MASK & DISTANCE_IN)) caps |= DISTANCE;
+    LineInit(g, lat1, lon1, azi1, salp1, calp1, caps);
+    SetArc(a12);
+  }
+
   GeodesicLineExact::GeodesicLineExact(const GeodesicExact& g,
                                        real lat1, real lon1,
                                        real azi1, real salp1, real calp1,
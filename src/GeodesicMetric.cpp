@@ -0,0 +1,78 @@
+/**
+ * \file GeodesicMetric.cpp
+ * \brief Implementation for GeographicLib::GeodesicMetricT class
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/GeodesicMetric.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  template<class GeodType>
+  GeodesicMetricT<GeodType>::GeodesicMetricT(const GeodType& earth)
+    : _earth(earth)
+    , _a(earth.EquatorialRadius())
+    , _b(_a * (1 - earth.Flattening()))
+    , _smin(fmin(_a, _b))
+    , _smax(fmax(_a, _b))
+      // The bounds are widened by this relative amount and by this amount
+      // times a.  A margin of 2^-32 (= 1.5 mm for the earth) easily covers
+      // the roundoff in Bounds and the error in the geodesic calculation.
+    , _tol(ldexp(real(1), -32))
+  {}
+
+  template<class GeodType>
+  typename GeodesicMetricT<GeodType>::point
+  GeodesicMetricT<GeodType>::Point(real lat, real lon) const {
+    point p;
+    p._lat = lat;
+    p._lon = lon;
+    _earth.InverseLat(p._lat, p._sbet, p._cbet, p._dn);
+    real slam, clam;
+    Math::sincosd(lon, slam, clam);
+    // (x, y, sbet) is the point on the unit sphere; sbet and cbet are
+    // normalized by InverseLat.
+    p._x = p._cbet * clam; p._y = p._cbet * slam;
+    return p;
+  }
+
+  template<class GeodType>
+  Math::real GeodesicMetricT<GeodType>::operator()(const point& p1,
+                                                   const point& p2) const {
+    // GenInverse uses the azimuth arguments as workspace, so they must be
+    // distinct.
+    real s12, salp1, calp1, salp2, calp2, t;
+    _earth.GenInverse(p1._lat, p1._sbet, p1._cbet, p1._dn, p1._lon,
+                      p2._lat, p2._sbet, p2._cbet, p2._dn, p2._lon,
+                      GeodType::DISTANCE & GeodType::OUT_MASK,
+                      s12, salp1, calp1, salp2, calp2, t, t, t, t);
+    return s12;
+  }
+
+  template<class GeodType>
+  void GeodesicMetricT<GeodType>::Bounds(const point& p1, const point& p2,
+                                         real& lo, real& hi) const {
+    real
+      dx = p1._x - p2._x, dy = p1._y - p2._y, dz = p1._sbet - p2._sbet,
+      // The cross and dot products of the points on the unit sphere
+      cx = p1._y * p2._sbet - p1._sbet * p2._y,
+      cy = p1._sbet * p2._x - p1._x * p2._sbet,
+      cz = p1._x * p2._y - p1._y * p2._x,
+      sig = atan2(sqrt(cx * cx + cy * cy + cz * cz),
+                  p1._x * p2._x + p1._y * p2._y + p1._sbet * p2._sbet),
+      // The chord between the points on the ellipsoid
+      chord = sqrt(_a * _a * (dx * dx + dy * dy) + _b * _b * dz * dz);
+    lo = fmax(real(0),
+              fmax(_smin * sig, chord) * (1 - _tol) - _a * _tol);
+    hi = _smax * sig * (1 + _tol) + _a * _tol;
+  }
+
+  template class GEOGRAPHICLIB_EXPORT GeodesicMetricT<Geodesic>;
+  template class GEOGRAPHICLIB_EXPORT GeodesicMetricT<GeodesicExact>;
+
+} // namespace GeographicLib
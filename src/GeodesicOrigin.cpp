@@ -0,0 +1,139 @@
+/**
+ * \file GeodesicOrigin.cpp
+ * \brief Implementation for GeographicLib::GeodesicOriginT class
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/GeodesicOrigin.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    // The line class for each geodesic class and a routine to compute the
+    // positions of many points on a line
+    template<class GeodType> struct LineOf;
+    template<> struct LineOf<Geodesic> { typedef GeodesicLine type; };
+    template<> struct LineOf<GeodesicExact> {
+      typedef GeodesicLineExact type;
+    };
+
+    void Positions(const GeodesicLine& line, size_t n, const Math::real s12[],
+                   Math::real lat2[], Math::real lon2[], Math::real azi2[]) {
+      line.GenPositions(false, n, s12,
+                        GeodesicLine::LATITUDE | GeodesicLine::LONGITUDE |
+                        (azi2 ? GeodesicLine::AZIMUTH : GeodesicLine::NONE),
+                        lat2, lon2, azi2,
+                        nullptr, nullptr, nullptr, nullptr, nullptr);
+    }
+
+    void Positions(const GeodesicLineExact& line, size_t n,
+                   const Math::real s12[],
+                   Math::real lat2[], Math::real lon2[], Math::real azi2[]) {
+      const unsigned outmask =
+        GeodesicLineExact::LATITUDE | GeodesicLineExact::LONGITUDE |
+        (azi2 ? GeodesicLineExact::AZIMUTH : GeodesicLineExact::NONE);
+      for (size_t j = 0; j < n; ++j) {
+        Math::real azi2x, t;
+        line.GenPosition(false, s12[j], outmask,
+                         lat2[j], lon2[j], azi2x, t, t, t, t, t);
+        if (azi2) azi2[j] = azi2x;
+      }
+    }
+  }
+
+  template<class GeodType>
+  GeodesicOriginT<GeodType>::GeodesicOriginT(const GeodType& earth,
+                                             real lat1, real lon1)
+    : _earth(earth)
+    , _lat1(lat1)
+    , _lon1(lon1)
+  {
+    _earth.InverseLat(_lat1, _sbet1, _cbet1, _dn1);
+  }
+
+  template<class GeodType>
+  Math::real GeodesicOriginT<GeodType>::GenInverse(real lat2, real lon2,
+                                                   unsigned outmask,
+                                                   real& s12,
+                                                   real& azi1, real& azi2,
+                                                   real& m12,
+                                                   real& M12, real& M21,
+                                                   real& S12) const {
+    outmask &= GeodType::OUT_MASK;
+    real sbet2, cbet2, dn2, salp1, calp1, salp2, calp2;
+    _earth.InverseLat(lat2, sbet2, cbet2, dn2);
+    real a12 = _earth.GenInverse(_lat1, _sbet1, _cbet1, _dn1, _lon1,
+                                 lat2, sbet2, cbet2, dn2, lon2,
+                                 outmask, s12, salp1, calp1, salp2, calp2,
+                                 m12, M12, M21, S12);
+    if (outmask & GeodType::AZIMUTH) {
+      azi1 = Math::atan2d(salp1, calp1);
+      azi2 = Math::atan2d(salp2, calp2);
+    }
+    return a12;
+  }
+
+  template<class GeodType>
+  void GeodesicOriginT<GeodType>::InverseBatch(size_t n,
+                                               const real lat2[],
+                                               const real lon2[],
+                                               unsigned outmask,
+                                               real s12[],
+                                               real azi1[], real azi2[],
+                                               real m12[],
+                                               real M12[], real M21[],
+                                               real S12[],
+                                               real a12[]) const {
+    outmask &= GeodType::OUT_MASK;
+    // Hoist the tests on outmask out of the loop.
+    const bool
+      dist = (outmask & GeodType::DISTANCE) != 0,
+      azi = (outmask & GeodType::AZIMUTH) != 0,
+      redl = (outmask & GeodType::REDUCEDLENGTH) != 0,
+      scale = (outmask & GeodType::GEODESICSCALE) != 0,
+      area = (outmask & GeodType::AREA) != 0;
+    for (size_t i = 0; i < n; ++i) {
+      real lat2x = lat2[i], sbet2, cbet2, dn2;
+      _earth.InverseLat(lat2x, sbet2, cbet2, dn2);
+      real s12x = 0, salp1, calp1, salp2, calp2,
+        m12x = 0, M12x = 0, M21x = 0, S12x = 0,
+        a12x = _earth.GenInverse(_lat1, _sbet1, _cbet1, _dn1, _lon1,
+                                 lat2x, sbet2, cbet2, dn2, lon2[i],
+                                 outmask, s12x, salp1, calp1, salp2, calp2,
+                                 m12x, M12x, M21x, S12x);
+      if (dist) s12[i] = s12x;
+      if (azi) {
+        azi1[i] = Math::atan2d(salp1, calp1);
+        azi2[i] = Math::atan2d(salp2, calp2);
+      }
+      if (redl) m12[i] = m12x;
+      if (scale) { M12[i] = M12x; M21[i] = M21x; }
+      if (area) S12[i] = S12x;
+      if (a12) a12[i] = a12x;
+    }
+  }
+
+  template<class GeodType>
+  void GeodesicOriginT<GeodType>::Fan(size_t nazi, const real azi1[],
+                                      size_t ns, const real s12[],
+                                      real lat2[], real lon2[],
+                                      real azi2[]) const {
+    typename LineOf<GeodType>::type line;
+    for (size_t i = 0; i < nazi; ++i) {
+      line.Reset(_earth, _lat1, _lon1, azi1[i],
+                 GeodType::LATITUDE | GeodType::LONGITUDE |
+                 GeodType::AZIMUTH | GeodType::DISTANCE_IN);
+      Positions(line, ns, s12, lat2 + i * ns, lon2 + i * ns,
+                azi2 ? azi2 + i * ns : nullptr);
+    }
+  }
+
+  template class GEOGRAPHICLIB_EXPORT GeodesicOriginT<Geodesic>;
+  template class GEOGRAPHICLIB_EXPORT GeodesicOriginT<GeodesicExact>;
+
+} // namespace GeographicLib
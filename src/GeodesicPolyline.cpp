@@ -0,0 +1,98 @@
+/**
+ * \file GeodesicPolyline.cpp
+ * \brief Implementation for GeographicLib::GeodesicPolyline class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <algorithm>
+#include <GeographicLib/GeodesicPolyline.hpp>
+#include <GeographicLib/Accumulator.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    // The largest k in [0, n) with x[k] <= s (or 0 if there's none), where x
+    // is sorted; k is used as a guess for the result.
+    size_t Locate(const Math::real x[], size_t n, Math::real s, size_t k) {
+      if (k < n && x[k] <= s && (k + 1 == n || s < x[k + 1]))
+        return k;
+      // Try the next interval before resorting to a binary search
+      if (k + 1 < n && x[k + 1] <= s && (k + 2 == n || s < x[k + 2]))
+        return k + 1;
+      return n > 1 ? size_t(upper_bound(x + 1, x + n, s) - (x + 1)) : 0;
+    }
+  }
+
+  GeodesicPolyline::GeodesicPolyline(const Geodesic& earth, size_t n,
+                                     const real lat[], const real lon[])
+    : _earth(earth)
+  {
+    if (n < 2)
+      throw GeographicErr("GeodesicPolyline needs at least 2 waypoints");
+    const unsigned caps = Geodesic::LATITUDE | Geodesic::LONGITUDE |
+      Geodesic::AZIMUTH | Geodesic::DISTANCE_IN;
+    _legs.reserve(n - 1);
+    _dist.reserve(n);
+    _dist.push_back(0);
+    Accumulator<> s;
+    for (size_t k = 0; k + 1 < n; ++k) {
+      _legs.push_back(_earth.InverseLine(lat[k], lon[k],
+                                         lat[k + 1], lon[k + 1], caps));
+      s += _legs.back().Distance();
+      _dist.push_back(s());
+    }
+  }
+
+  void GeodesicPolyline::Position(real s,
+                                  real& lat, real& lon, real& azi) const {
+    size_t k = Locate(_dist.data(), _legs.size(), s, 0);
+    _legs[k].Position(s - _dist[k], lat, lon, azi);
+  }
+
+  void GeodesicPolyline::Positions(size_t m, const real s[],
+                                   real lat[], real lon[], real azi[]) const {
+    size_t k = 0;
+    for (size_t i = 0; i < m; ++i) {
+      real si = s[i], azii;
+      k = Locate(_dist.data(), _legs.size(), si, k);
+      _legs[k].Position(si - _dist[k], lat[i], lon[i], azii);
+      if (azi) azi[i] = azii;
+    }
+  }
+
+  size_t GeodesicPolyline::Resample(real ds,
+                                    vector<real>& lat,
+                                    vector<real>& lon) const {
+    lat.clear(); lon.clear();
+    if (!(ds > 0)) return 0;
+    const real len = Length();
+    size_t m = size_t(floor(len / ds)) + 1;
+    vector<real> s(m);
+    for (size_t i = 0; i < m; ++i) s[i] = real(i) * ds;
+    if (s.back() < len) s.push_back(len);
+    m = s.size();
+    lat.resize(m); lon.resize(m);
+    Positions(m, s.data(), lat.data(), lon.data());
+    return m;
+  }
+
+  void GeodesicPolyline::TimePositions(const real tw[], size_t m,
+                                       const real t[], real lat[], real lon[],
+                                       real azi[]) const {
+    size_t k = 0;
+    for (size_t i = 0; i < m; ++i) {
+      real ti = t[i], azii;
+      k = Locate(tw, _legs.size(), ti, k);
+      real dt = tw[k + 1] - tw[k],
+        s = dt > 0 ? (ti - tw[k]) / dt * (_dist[k + 1] - _dist[k]) : 0;
+      _legs[k].Position(s, lat[i], lon[i], azii);
+      if (azi) azi[i] = azii;
+    }
+  }
+
+} // namespace GeographicLib
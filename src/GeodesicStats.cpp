@@ -0,0 +1,129 @@
+/**
+ * \file GeodesicStats.cpp
+ * \brief Implementation for GeographicLib::GeodesicStats class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <GeographicLib/GeodesicStats.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    // The counters are the cases, the iterations, the bisections, and the
+    // histogram.
+    const int nsolvers = 2,
+      ncounters = 4 + 2 + GeodesicStats::nhist;
+
+    struct Local;
+
+    // The counters of the live threads and the totals for the threads which
+    // have exited.
+    struct Registry {
+      mutex lock;
+      set<Local*> live;
+      unsigned long long retired[nsolvers][ncounters];
+      Registry() { fill(retired[0], retired[0] + nsolvers * ncounters, 0); }
+    };
+
+    Registry& registry() {
+      static Registry r;
+      return r;
+    }
+
+    // The counters of a thread.  These are only updated by the owning thread
+    // but may be read by other threads, hence the (relaxed) atomics.
+    struct Local {
+      atomic<unsigned long long> c[nsolvers][ncounters];
+      Local() {
+        for (int s = 0; s < nsolvers; ++s)
+          for (int k = 0; k < ncounters; ++k)
+            c[s][k].store(0, memory_order_relaxed);
+        Registry& r = registry();
+        lock_guard<mutex> lock(r.lock);
+        r.live.insert(this);
+      }
+      ~Local() {
+        Registry& r = registry();
+        lock_guard<mutex> lock(r.lock);
+        for (int s = 0; s < nsolvers; ++s)
+          for (int k = 0; k < ncounters; ++k)
+            r.retired[s][k] += c[s][k].load(memory_order_relaxed);
+        r.live.erase(this);
+      }
+      // Increment a counter without a locked instruction.
+      void Add(int s, int k, unsigned long long n) {
+        c[s][k].store(c[s][k].load(memory_order_relaxed) + n,
+                      memory_order_relaxed);
+      }
+    };
+
+    Local& local() {
+      static thread_local Local l;
+      return l;
+    }
+  }
+
+  GeodesicStats::GeodesicStats()
+    : meridional(0)
+    , equatorial(0)
+    , shortline(0)
+    , general(0)
+    , iterations(0)
+    , bisections(0)
+  {
+    fill(histogram, histogram + nhist, 0);
+  }
+
+  bool GeodesicStats::Enabled() { return GEOGRAPHICLIB_GEODESIC_STATS != 0; }
+
+  void GeodesicStats::Record(solver s, solution k,
+                             unsigned numit, unsigned numbis) {
+    Local& l = local();
+    l.Add(s, k, 1);
+    if (k == GENERAL) {
+      l.Add(s, 4, numit);
+      l.Add(s, 5, numbis);
+      l.Add(s, 6 + min(numit, unsigned(nhist - 1)), 1);
+    }
+  }
+
+  GeodesicStats GeodesicStats::Get(solver s) {
+    unsigned long long c[ncounters];
+    {
+      Registry& r = registry();
+      lock_guard<mutex> lock(r.lock);
+      copy(r.retired[s], r.retired[s] + ncounters, c);
+      for (const Local* l : r.live)
+        for (int k = 0; k < ncounters; ++k)
+          c[k] += l->c[s][k].load(memory_order_relaxed);
+    }
+    GeodesicStats st;
+    st.meridional = c[MERIDIONAL];
+    st.equatorial = c[EQUATORIAL];
+    st.shortline = c[SHORT];
+    st.general = c[GENERAL];
+    st.iterations = c[4];
+    st.bisections = c[5];
+    copy(c + 6, c + ncounters, st.histogram);
+    return st;
+  }
+
+  void GeodesicStats::Reset(solver s) {
+    Registry& r = registry();
+    lock_guard<mutex> lock(r.lock);
+    fill(r.retired[s], r.retired[s] + ncounters, 0);
+    for (Local* l : r.live)
+      for (int k = 0; k < ncounters; ++k)
+        l->c[s][k].store(0, memory_order_relaxed);
+  }
+
+} // namespace GeographicLib
@@ -9,6 +9,9 @@
 
 #include <GeographicLib/Geohash.hpp>
 #include <GeographicLib/Utility.hpp>
+#if defined(__BMI2__)
+#  include <immintrin.h>
+#endif
 
 namespace GeographicLib {
 
@@ -17,53 +20,227 @@ namespace GeographicLib {
   const char* const Geohash::lcdigits_ = "0123456789bcdefghjkmnpqrstuvwxyz";
   const char* const Geohash::ucdigits_ = "0123456789BCDEFGHJKMNPQRSTUVWXYZ";
 
-  void Geohash::Forward(real lat, real lon, int len, string& geohash) {
-    using std::isnan;           // Needed for Centos 7, ubuntu 14
+  namespace {
+    typedef unsigned long long ull;
+    // The bits of the longitude and latitude indices are interleaved
+    // (longitude first) and split into hi, containing the first 60 bits (12
+    // characters), and lo, containing the remaining 30 bits (6 characters).
+    // Each index has 45 bits; 30 go to hi and 15 to lo.
+    const int lobits = 15;
+    const ull lomask = (1ULL << lobits) - 1;
+    const ull lonmask = (1ULL << 45) - 1;
+
+    // Spread the low 32 bits of x to the even bits of the result.
+    inline ull spread(ull x) {
+#if defined(__BMI2__)
+      return _pdep_u64(x, 0x5555555555555555ULL);
+#else
+      x &= 0xffffffffULL;
+      x = (x | (x << 16)) & 0x0000ffff0000ffffULL;
+      x = (x | (x <<  8)) & 0x00ff00ff00ff00ffULL;
+      x = (x | (x <<  4)) & 0x0f0f0f0f0f0f0f0fULL;
+      x = (x | (x <<  2)) & 0x3333333333333333ULL;
+      x = (x | (x <<  1)) & 0x5555555555555555ULL;
+      return x;
+#endif
+    }
+
+    // Gather the even bits of x; the inverse of spread.
+    inline ull compact(ull x) {
+#if defined(__BMI2__)
+      return _pext_u64(x, 0x5555555555555555ULL);
+#else
+      x &= 0x5555555555555555ULL;
+      x = (x | (x >>  1)) & 0x3333333333333333ULL;
+      x = (x | (x >>  2)) & 0x0f0f0f0f0f0f0f0fULL;
+      x = (x | (x >>  4)) & 0x00ff00ff00ff00ffULL;
+      x = (x | (x >>  8)) & 0x0000ffff0000ffffULL;
+      x = (x | (x >> 16)) & 0x00000000ffffffffULL;
+      return x;
+#endif
+    }
+
+    inline void interleave(ull ulon, ull ulat, ull& hi, ull& lo) {
+      hi = (spread(ulon >> lobits) << 1) | spread(ulat >> lobits);
+      lo = (spread(ulon & lomask) << 1) | spread(ulat & lomask);
+    }
+
+    inline void deinterleave(ull hi, ull lo, ull& ulon, ull& ulat) {
+      ulon = (compact(hi >> 1) << lobits) | compact(lo >> 1);
+      ulat = (compact(hi) << lobits) | compact(lo);
+    }
+
+    // The 5-bit value of character k of a geohash
+    inline unsigned digit(ull hi, ull lo, int k) {
+      return unsigned(k < 12 ? hi >> (55 - 5 * k) : lo >> (85 - 5 * k)) & 31U;
+    }
+
+    // Table of the values of geohash characters (-1 for illegal characters)
+    struct table {
+      signed char val[256];
+      table() {
+        const char* const digits = "0123456789bcdefghjkmnpqrstuvwxyz";
+        for (int c = 0; c < 256; ++c) val[c] = -1;
+        for (int i = 0; i < 32; ++i) {
+          val[(unsigned char)digits[i]] = (signed char)i;
+          val[(unsigned char)toupper(digits[i])] = (signed char)i;
+        }
+      }
+    };
+
+    const table& Table() {
+      static const table t;
+      return t;
+    }
+
+    // Decode the first len characters of geohash to the indices of the SW
+    // corner of its cell.  Return the index of the first illegal character or
+    // -1 if all the characters are legal.
+    int decode(const char* geohash, int len, ull& ulon, ull& ulat) {
+      const table& t = Table();
+      ull hi = 0, lo = 0;
+      for (int k = 0; k < len; ++k) {
+        int byte = t.val[(unsigned char)geohash[k]];
+        if (byte < 0) return k;
+        if (k < 12)
+          hi |= ull(byte) << (55 - 5 * k);
+        else
+          lo |= ull(byte) << (85 - 5 * k);
+      }
+      deinterleave(hi, lo, ulon, ulat);
+      return -1;
+    }
+
+    // Move the indices of a cell of length len by dlat and dlon cells.
+    // Return false if the result lies beyond a pole.
+    bool move(ull& ulon, ull& ulat, int len, int dlat, int dlon) {
+      int nlon = (5 * len + 1) / 2, nlat = 5 * len / 2;
+      long long ilat = (long long)(ulat >> (45 - nlat)) + dlat;
+      if (ilat < 0 || ilat >= (1LL << nlat))
+        return false;
+      ulat = ull(ilat) << (45 - nlat);
+      // Unsigned arithmetic handles the wrap around in longitude
+      ulon = (ulon + (ull((long long)dlon) << (45 - nlon))) & lonmask;
+      return true;
+    }
+  }
+
+  void Geohash::Indices(real lat, real lon, ull& ulon, ull& ulat) {
     static const real shift = ldexp(real(1), 45);
     static const real loneps = 180 / shift;
     static const real lateps =  90 / shift;
-    if (abs(lat) > 90)
-      throw GeographicErr("Latitude " + Utility::str(lat)
-                          + "d not in [-90d, 90d]");
-    if (isnan(lat) || isnan(lon)) {
-      geohash = "invalid";
-      return;
-    }
     if (lat == 90) lat -= lateps / 2;
     lon = Math::AngNormalize(lon);
     if (lon == 180) lon = -180; // lon now in [-180,180)
     // lon/loneps in [-2^45,2^45); lon/loneps + shift in [0,2^46)
-    // similarly for lat
+    // similarly for lat.  The last bit is dropped.
+    ulon = ull(floor(lon/loneps) + shift) >> 1;
+    ulat = ull(floor(lat/lateps) + shift) >> 1;
+  }
+
+  void Geohash::Position(ull ulon, ull ulat, int len, bool centerp,
+                         real& lat, real& lon) {
+    static const real shift = ldexp(real(1), 45);
+    static const real loneps = 180 / shift;
+    static const real lateps =  90 / shift;
+    int s = 5 * (maxlen_ - len);
+    ulon <<= 1; ulat <<= 1;
+    if (centerp) {
+      ulon += 1ULL << (s / 2);
+      ulat += 1ULL << (s - s / 2);
+    }
+    lon = ulon * loneps - 180;
+    lat = ulat * lateps - 90;
+  }
+
+  void Geohash::Forward(real lat, real lon, int len, string& geohash) {
+    char geohash1[maxlen_ + 1];
+    if (Forward(lat, lon, len, geohash1, sizeof(geohash1)) == BADLATITUDE)
+      throw GeographicErr("Latitude " + Utility::str(lat)
+                          + "d not in [-90d, 90d]");
+    geohash = geohash1;
+  }
+
+  Geohash::status Geohash::Forward(real lat, real lon, int len,
+                                   char geohash[], size_t size) {
+    using std::isnan;           // Needed for Centos 7, ubuntu 14
+    if (abs(lat) > 90)
+      return BADLATITUDE;
+    if (isnan(lat) || isnan(lon)) {
+      static const char* const invalid = "invalid";
+      if (size < 8) return BUFFERTOOSMALL;
+      copy(invalid, invalid + 8, geohash);
+      return OK;
+    }
     len = max(0, min(int(maxlen_), len));
-    unsigned long long
-      ulon = (unsigned long long)(floor(lon/loneps) + shift),
-      ulat = (unsigned long long)(floor(lat/lateps) + shift);
-    char geohash1[maxlen_];
-    unsigned byte = 0;
-    for (unsigned i = 0; i < 5 * unsigned(len);) {
-      if ((i & 1) == 0) {
-        byte = (byte << 1) + unsigned((ulon & mask_) != 0);
-        ulon <<= 1;
-      } else {
-        byte = (byte << 1) + unsigned((ulat & mask_) != 0);
-        ulat <<= 1;
+    if (size < size_t(len) + 1) return BUFFERTOOSMALL;
+    ull ulon, ulat, hi, lo;
+    Indices(lat, lon, ulon, ulat);
+    interleave(ulon, ulat, hi, lo);
+    for (int k = 0; k < len; ++k)
+      geohash[k] = lcdigits_[digit(hi, lo, k)];
+    geohash[len] = '\0';
+    return OK;
+  }
+
+  Geohash::status Geohash::Forward(real lat, real lon, int len,
+                                   ull& geohash) {
+    using std::isnan;
+    if (abs(lat) > 90)
+      return BADLATITUDE;
+    if (isnan(lat) || isnan(lon))
+      return BADCOORDS;
+    len = max(0, min(int(maxintlen_), len));
+    ull ulon, ulat, hi, lo;
+    Indices(lat, lon, ulon, ulat);
+    interleave(ulon, ulat, hi, lo);
+    geohash = hi >> (5 * (maxintlen_ - len));
+    return OK;
+  }
+
+  void Geohash::Reverse(ull geohash, int len, real& lat, real& lon,
+                        bool centerp) {
+    len = max(0, min(int(maxintlen_), len));
+    ull ulon, ulat;
+    // Shifting left discards any bits beyond the first 5 * len
+    deinterleave(len ? geohash << (64 - 5 * len) >> 4 : 0, 0, ulon, ulat);
+    Position(ulon, ulat, len, centerp, lat, lon);
+  }
+
+  size_t Geohash::ForwardBatch(size_t n, const real lat[], const real lon[],
+                               int len, char geohash[], size_t stride,
+                               status stat[]) {
+    size_t nbad = 0;
+    for (size_t i = 0; i < n; ++i) {
+      char* geohashi = geohash + i * stride;
+      status st = Forward(lat[i], lon[i], len, geohashi, stride);
+      if (st != OK) {
+        ++nbad;
+        if (stride > 0) geohashi[0] = '\0';
       }
-      ++i;
-      if (i % 5 == 0) {
-        geohash1[(i/5)-1] = lcdigits_[byte];
-        byte = 0;
+      if (stat) stat[i] = st;
+    }
+    return nbad;
+  }
+
+  size_t Geohash::ForwardBatch(size_t n, const real lat[], const real lon[],
+                               int len, ull geohash[], status stat[]) {
+    size_t nbad = 0;
+    for (size_t i = 0; i < n; ++i) {
+      status st = Forward(lat[i], lon[i], len, geohash[i]);
+      if (st != OK) {
+        ++nbad;
+        geohash[i] = 0;
       }
+      if (stat) stat[i] = st;
     }
-    geohash.resize(len);
-    copy(geohash1, geohash1 + len, geohash.begin());
+    return nbad;
   }
 
-  void Geohash::Reverse(const string& geohash, real& lat, real& lon,
-                        int& len, bool centerp) {
-    static const real shift = ldexp(real(1), 45);
-    static const real loneps = 180 / shift;
-    static const real lateps =  90 / shift;
-    int len1 = min(int(maxlen_), int(geohash.length()));
+  Geohash::status Geohash::ReverseChars(const char* geohash, size_t glen,
+                                        real& lat, real& lon, int& len,
+                                        bool centerp, bool throwp) {
+    int len1 = int(min(size_t(maxlen_), glen));
     if (len1 >= 3 &&
         ((toupper(geohash[0]) == 'I' &&
           toupper(geohash[1]) == 'N' &&
@@ -73,32 +250,96 @@ namespace GeographicLib {
           toupper(geohash[0]) == 'N' &&
           toupper(geohash[2]) == 'N'))) {
       lat = lon = Math::NaN();
-      return;
+      return OK;
     }
-    unsigned long long ulon = 0, ulat = 0;
-    for (unsigned k = 0, j = 0; k < unsigned(len1); ++k) {
-      int byte = Utility::lookup(ucdigits_, geohash[k]);
-      if (byte < 0)
-        throw GeographicErr("Illegal character in geohash " + geohash);
-      for (unsigned m = 16; m; m >>= 1) {
-        if (j == 0)
-          ulon = (ulon << 1) + unsigned((byte & m) != 0);
-        else
-          ulat = (ulat << 1) + unsigned((byte & m) != 0);
-        j ^= 1;
-      }
+    ull ulon, ulat;
+    if (decode(geohash, len1, ulon, ulat) >= 0) {
+      if (!throwp) return BADSTRING;
+      throw GeographicErr("Illegal character in geohash "
+                          + string(geohash, glen));
     }
-    ulon <<= 1; ulat <<= 1;
-    if (centerp) {
-      ulon += 1;
-      ulat += 1;
-    }
-    int s = 5 * (maxlen_ - len1);
-    ulon <<=     (s / 2);
-    ulat <<= s - (s / 2);
-    lon = ulon * loneps - 180;
-    lat = ulat * lateps - 90;
+    Position(ulon, ulat, len1, centerp, lat, lon);
     len = len1;
+    return OK;
+  }
+
+  void Geohash::Reverse(const string& geohash, real& lat, real& lon,
+                        int& len, bool centerp) {
+    ReverseChars(geohash.data(), geohash.length(), lat, lon, len, centerp,
+                 true);
+  }
+
+  Geohash::status Geohash::Reverse(const char* geohash, size_t glen,
+                                   real& lat, real& lon, int& len,
+                                   bool centerp) {
+    return ReverseChars(geohash, glen, lat, lon, len, centerp, false);
+  }
+
+  size_t Geohash::ReverseBatch(size_t n, const char geohash[], size_t stride,
+                               real lat[], real lon[], int len[],
+                               bool centerp, status stat[]) {
+    size_t nbad = 0;
+    for (size_t i = 0; i < n; ++i) {
+      const char* geohashi = geohash + i * stride;
+      size_t glen = 0;
+      while (glen < stride && geohashi[glen]) ++glen;
+      // len is unchanged for an "invalid" geohash
+      len[i] = -1;
+      status st = Reverse(geohashi, glen, lat[i], lon[i], len[i], centerp);
+      if (st != OK) {
+        ++nbad;
+        lat[i] = lon[i] = Math::NaN();
+      }
+      if (stat) stat[i] = st;
+    }
+    return nbad;
+  }
+
+  void Geohash::ReverseBatch(size_t n, const ull geohash[], int len,
+                             real lat[], real lon[], bool centerp) {
+    for (size_t i = 0; i < n; ++i)
+      Reverse(geohash[i], len, lat[i], lon[i], centerp);
+  }
+
+  Geohash::status Geohash::Adjacent(ull geohash, int len, int dlat, int dlon,
+                                    ull& adj) {
+    len = max(0, min(int(maxintlen_), len));
+    int sh = 5 * (maxintlen_ - len);
+    ull ulon, ulat, hi, lo;
+    deinterleave(len ? geohash << (64 - 5 * len) >> 4 : 0, 0, ulon, ulat);
+    if (!move(ulon, ulat, len, dlat, dlon))
+      return BADLATITUDE;
+    interleave(ulon, ulat, hi, lo);
+    adj = hi >> sh;
+    return OK;
+  }
+
+  Geohash::status Geohash::Adjacent(const char* geohash, size_t glen,
+                                    int dlat, int dlon,
+                                    char adj[], size_t size) {
+    int len = int(min(size_t(maxlen_), glen));
+    ull ulon, ulat, hi, lo;
+    // decode rejects "invalid" and "nan" since i, l, and a are illegal
+    if (decode(geohash, len, ulon, ulat) >= 0)
+      return BADSTRING;
+    if (size < size_t(len) + 1) return BUFFERTOOSMALL;
+    if (!move(ulon, ulat, len, dlat, dlon))
+      return BADLATITUDE;
+    interleave(ulon, ulat, hi, lo);
+    for (int k = 0; k < len; ++k)
+      adj[k] = lcdigits_[digit(hi, lo, k)];
+    adj[len] = '\0';
+    return OK;
+  }
+
+  int Geohash::Neighbors(ull geohash, int len, ull nbr[8]) {
+    static const int dlat[] = { 1, 1, 0, -1, -1, -1,  0,  1 };
+    static const int dlon[] = { 0, 1, 1,  1,  0, -1, -1, -1 };
+    int k = 0;
+    for (int i = 0; i < 8; ++i)
+      if (Adjacent(geohash, len, dlat[i], dlon[i], nbr[k]) == OK)
+        ++k;
+    return k;
   }
 
 } // namespace GeographicLib
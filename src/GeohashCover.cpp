@@ -0,0 +1,312 @@
+/**
+ * \file GeohashCover.cpp
+ * \brief Implementation for GeographicLib::GeohashCover class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <utility>
+#include <GeographicLib/GeohashCover.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <GeographicLib/GeodesicLine.hpp>
+#include <GeographicLib/Geohash.hpp>
+#include <GeographicLib/PreparedPolygon.hpp>
+#include <GeographicLib/Utility.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    typedef Math::real real;
+    typedef unsigned long long ull;
+
+    // Classification of a cell
+    enum { OUTSIDE = 0, PARTIAL = 1, INSIDE = 2 };
+
+    const int maxit = 100;
+    // Tolerance for the longitude of points on an edge (degrees)
+    const real tolt = 16 * numeric_limits<real>::epsilon() * 180;
+    // Number of cells whose children are classified by a single task
+    const size_t chunk = 8;
+
+    // The longitude of lon east of w in [0, 360)
+    inline real east(real w, real lon) {
+      real t = Math::AngDiff(w, lon);
+      return t < 0 ? t + 360 : t;
+    }
+
+    // The extent of a geohash cell
+    struct box {
+      real s, n, w, dlon;
+      box(ull h, int len) {
+        Geohash::Reverse(h, len, s, w, false);
+        n = s + Geohash::LatitudeResolution(len);
+        dlon = Geohash::LongitudeResolution(len);
+      }
+      bool lonin(real lon) const { return east(w, lon) <= dlon; }
+      bool in(real lat, real lon) const
+      { return s <= lat && lat <= n && lonin(lon); }
+    };
+
+    // Classify a cell given the indices of the edges which intersect its
+    // parent; set out to the indices of the edges which intersect the cell.
+    typedef function<int(const box&, const vector<unsigned>&,
+                         vector<unsigned>&)> classifier;
+
+    struct node {
+      ull h;
+      vector<unsigned> edges;
+    };
+
+    void Refine(int len, unsigned threads, vector<unsigned> edges,
+                const classifier& classify, vector<ull>& cells) {
+      cells.clear();
+      if (len == 0) {
+        vector<unsigned> out;
+        if (classify(box(0, 0), edges, out) != OUTSIDE) cells.push_back(0);
+        return;
+      }
+      // The ranges [first, last) of geohashes of length len in the region
+      vector<pair<ull, ull>> ranges;
+      vector<node> cur(1);
+      cur[0].h = 0; cur[0].edges.swap(edges);
+      for (int l = 0; l < len && !cur.empty(); ++l) {
+        const size_t ntasks = (cur.size() + chunk - 1) / chunk;
+        const int shift = 5 * (len - l - 1);
+        vector<vector<node>> next(ntasks);
+        vector<vector<pair<ull, ull>>> found(ntasks);
+        Executor::Parallel(ntasks, threads, [&](size_t t) -> void {
+          const size_t i1 = min(cur.size(), (t + 1) * chunk);
+          for (size_t i = t * chunk; i < i1; ++i) {
+            for (ull k = 0; k < 32; ++k) {
+              node c;
+              c.h = cur[i].h << 5 | k;
+              int r = classify(box(c.h, l + 1), cur[i].edges, c.edges);
+              if (r == INSIDE || (r == PARTIAL && shift == 0))
+                found[t].push_back(make_pair(c.h << shift,
+                                             (c.h + 1) << shift));
+              else if (r == PARTIAL)
+                next[t].push_back(std::move(c));
+            }
+          }
+        });
+        cur.clear();
+        for (size_t t = 0; t < ntasks; ++t) {
+          ranges.insert(ranges.end(), found[t].begin(), found[t].end());
+          for (auto& c : next[t])
+            cur.push_back(std::move(c));
+        }
+      }
+      sort(ranges.begin(), ranges.end());
+      ull num = 0;
+      for (const auto& r : ranges) num += r.second - r.first;
+      cells.reserve(size_t(num));
+      for (const auto& r : ranges)
+        for (ull h = r.first; h < r.second; ++h)
+          cells.push_back(h);
+    }
+
+    // Classify a cell relative to the circle of radius r centered at (lat0,
+    // lon0).  rhomax is the largest meridional radius of curvature.
+    int CircleCell(const Geodesic& earth, real lat0, real lon0, real r,
+                   real rhomax, const box& b) {
+      const real e = b.w + b.dlon;
+      int nin = 0;
+      for (int k = 0; k < 4; ++k) {
+        real s12;
+        earth.Inverse(lat0, lon0, k & 1 ? b.n : b.s, k & 2 ? e : b.w, s12);
+        if (s12 <= r) ++nin;
+      }
+      // The distance along each side of the cell has no interior maximum so,
+      // if all the corners are inside the circle, so is the boundary of the
+      // cell; then the cell lies inside unless it contains the antipode.
+      if (nin == 4)
+        return b.in(-lat0, lon0 + 180) ? PARTIAL : INSIDE;
+      if (nin > 0 || b.in(lat0, lon0))
+        return PARTIAL;
+      real s12, azi1, azi2;
+      if (b.lonin(lon0)) {
+        // The closest point is on the meridian through the center
+        earth.Inverse(lat0, lon0, lat0 < b.s ? b.s : b.n, lon0, s12);
+        return s12 <= r ? PARTIAL : OUTSIDE;
+      }
+      // Otherwise the closest point is on the nearer bounding meridian.  The
+      // distance to it is unimodal; bisect on the direction of the geodesic
+      // at the meridian.  Because the distance changes by no more than the
+      // meridian arc, stop when the bound on the closest approach settles
+      // the question.
+      const real lone =
+        abs(Math::AngDiff(lon0, b.w)) <= abs(Math::AngDiff(lon0, e)) ?
+        b.w : e;
+      real lo = b.s, hi = b.n;
+      earth.Inverse(lat0, lon0, lo, lone, s12, azi1, azi2);
+      if (Math::cosd(azi2) >= 0) return OUTSIDE;
+      earth.Inverse(lat0, lon0, hi, lone, s12, azi1, azi2);
+      if (Math::cosd(azi2) <= 0) return OUTSIDE;
+      for (int i = 0; i < maxit; ++i) {
+        real m = (lo + hi) / 2;
+        earth.Inverse(lat0, lon0, m, lone, s12, azi1, azi2);
+        if (s12 <= r) return PARTIAL;
+        if (s12 - rhomax * (hi - lo) / 2 * Math::degree() > r)
+          return OUTSIDE;
+        (Math::cosd(azi2) < 0 ? lo : hi) = m;
+      }
+      return PARTIAL;
+    }
+
+    // An edge of a polygon.  The longitude, unrolled and multiplied by sg,
+    // increases monotonically from lon1 to lon1 + lon12 along the edge.
+    struct edge {
+      GeodesicLine l;
+      real s12, lon1, lon12, sg, lat1, lat2, latmin, latmax, svert, latvert;
+    };
+
+    // Find the point on edge e where the relative longitude is t (degrees);
+    // set s and lat to its distance from the first vertex and its latitude.
+    // If the longitude is constant (a meridional edge), return the first
+    // vertex or, if last, the second vertex.
+    void EdgePoint(const edge& e, real t, bool last, real a, real e2,
+                   real& s, real& lat) {
+      if (last && !(t < e.lon12)) { s = e.s12; lat = e.lat2; return; }
+      if (!(t > 0)) { s = 0; lat = e.lat1; return; }
+      if (!(t < e.lon12)) { s = e.s12; lat = e.lat2; return; }
+      // Safeguarded Newton's method; the longitude may jump by 180 degrees
+      // where a meridional edge passes over a pole, in which case this
+      // reduces to bisection.
+      real lo = 0, hi = e.s12;
+      s = e.s12 * t / e.lon12;
+      for (int i = 0; i < maxit; ++i) {
+        real lon, azi, dummy;
+        e.l.GenPosition(false, s,
+                        GeodesicLine::LATITUDE | GeodesicLine::LONGITUDE |
+                        GeodesicLine::AZIMUTH | GeodesicLine::LONG_UNROLL,
+                        lat, lon, azi, dummy, dummy, dummy, dummy, dummy);
+        real g = e.sg * (lon - e.lon1) - t;
+        if (!(abs(g) > tolt)) break;
+        (g < 0 ? lo : hi) = s;
+        if (!(hi - lo > tolt * Math::degree() * a)) break;
+        real sphi, cphi;
+        Math::sincosd(lat, sphi, cphi);
+        // d(lon)/ds in degrees per meter
+        real dt = e.sg * Math::sind(azi) * sqrt(1 - e2 * Math::sq(sphi)) /
+          (a * cphi * Math::degree()),
+          snew = s - g / dt;
+        s = dt > 0 && snew > lo && snew < hi ? snew : (lo + hi) / 2;
+      }
+    }
+
+    // Does edge e intersect the cell?
+    bool EdgeCell(const edge& e, const box& b, real a, real e2) {
+      if (e.latmax < b.s || e.latmin > b.n) return false;
+      // The western end of the cell in terms of the relative longitude
+      real t0 = b.dlon >= 360 ? 0 :
+        e.sg > 0 ? east(e.lon1, b.w) : east(b.w + b.dlon, e.lon1);
+      for (int k = 0; k < 2; ++k) {
+        real u = max(real(0), t0 - k * 360),
+          v = min(e.lon12, t0 - k * 360 + b.dlon);
+        if (u > v) continue;
+        if (b.s <= e.latmin && e.latmax <= b.n) return true;
+        real su, latu, sv, latv;
+        EdgePoint(e, u, false, a, e2, su, latu);
+        EdgePoint(e, v, true, a, e2, sv, latv);
+        real latmin = min(latu, latv), latmax = max(latu, latv);
+        if (su <= e.svert && e.svert <= sv) {
+          latmin = min(latmin, e.latvert); latmax = max(latmax, e.latvert);
+        }
+        if (!(latmax < b.s || latmin > b.n)) return true;
+      }
+      return false;
+    }
+  }
+
+  GeohashCover::GeohashCover(const Geodesic& earth, unsigned threads)
+    : _earth(earth)
+    , _threads(threads ? threads : thread::hardware_concurrency())
+  {
+    // hardware_concurrency returns 0 if the number of cores can't be
+    // determined.
+    if (_threads == 0) _threads = 1;
+  }
+
+  void GeohashCover::Circle(real lat, real lon, real radius, int len,
+                            vector<ull>& cells) const {
+    if (!(abs(lat) <= 90))
+      throw GeographicErr("Latitude " + Utility::str(lat)
+                          + "d not in [-90d, 90d]");
+    cells.clear();
+    if (!(radius >= 0)) return;
+    len = max(0, min(int(maxlen_), len));
+    const real f1 = 1 - _earth.Flattening(),
+      rhomax = _earth.EquatorialRadius() * max(Math::sq(f1), 1/f1);
+    const Geodesic& earth = _earth;
+    Refine(len, _threads, vector<unsigned>(),
+           [&](const box& b, const vector<unsigned>&,
+               vector<unsigned>&) -> int {
+             return CircleCell(earth, lat, lon, radius, rhomax, b);
+           }, cells);
+  }
+
+  void GeohashCover::Polygon(size_t n, const real lat[], const real lon[],
+                             int len, vector<ull>& cells) const {
+    cells.clear();
+    if (n < 3) return;
+    len = max(0, min(int(maxlen_), len));
+    const real a = _earth.EquatorialRadius(),
+      e2 = _earth.Flattening() * (2 - _earth.Flattening());
+    const unsigned caps = GeodesicLine::LATITUDE | GeodesicLine::LONGITUDE |
+      GeodesicLine::AZIMUTH | GeodesicLine::DISTANCE |
+      GeodesicLine::DISTANCE_IN;
+    vector<edge> edges;
+    edges.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      size_t j = i + 1 < n ? i + 1 : 0;
+      edge e;
+      e.l = _earth.InverseLine(lat[i], lon[i], lat[j], lon[j], caps);
+      e.s12 = e.l.Distance();
+      if (!(e.s12 > 0)) continue; // Skip repeated vertices
+      real lon2, t;
+      e.lat1 = e.l.Latitude(); e.lon1 = e.l.Longitude();
+      e.l.GenPosition(false, e.s12,
+                      GeodesicLine::LATITUDE | GeodesicLine::LONGITUDE |
+                      GeodesicLine::LONG_UNROLL,
+                      e.lat2, lon2, t, t, t, t, t, t);
+      e.sg = lon2 < e.lon1 ? -1 : 1;
+      e.lon12 = e.sg * (lon2 - e.lon1);
+      e.latmin = min(e.lat1, e.lat2); e.latmax = max(e.lat1, e.lat2);
+      // The arc from the first vertex to the next vertex of the geodesic;
+      // vertices lie 90 degrees from the equatorial crossings.
+      real avert = remainder(90 - e.l.EquatorialArc(), real(180));
+      if (avert < 0) avert += 180;
+      e.svert = Math::NaN(); e.latvert = Math::NaN();
+      if (avert < e.l.Arc()) {
+        e.l.GenPosition(true, avert,
+                        GeodesicLine::LATITUDE | GeodesicLine::DISTANCE,
+                        e.latvert, t, t, e.svert, t, t, t, t);
+        e.latmin = min(e.latmin, e.latvert);
+        e.latmax = max(e.latmax, e.latvert);
+      }
+      edges.push_back(e);
+    }
+    if (edges.empty()) return;
+    const PreparedPolygon poly(_earth, n, lat, lon);
+    vector<unsigned> all(edges.size());
+    for (unsigned k = 0; k < unsigned(edges.size()); ++k) all[k] = k;
+    Refine(len, _threads, all,
+           [&](const box& b, const vector<unsigned>& in,
+               vector<unsigned>& out) -> int {
+             for (unsigned k : in)
+               if (EdgeCell(edges[k], b, a, e2)) out.push_back(k);
+             if (!out.empty()) return PARTIAL;
+             return poly.Contains(b.s + (b.n - b.s) / 2, b.w + b.dlon / 2) ?
+               INSIDE : OUTSIDE;
+           }, cells);
+  }
+
+} // namespace GeographicLib
@@ -2,15 +2,30 @@
  * \file Geoid.cpp
  * \brief Implementation for GeographicLib::Geoid class
  *
- * Copyright (c) Charles Karney (2009-2020) <charles@karney.com> and licensed
+ * Copyright (c) Charles Karney (2009-2021) <charles@karney.com> and licensed
  * under the MIT/X11 License.  For more information, see
  * https://geographiclib.sourceforge.io/
  **********************************************************************/
 
 #include <GeographicLib/Geoid.hpp>
+#include <algorithm>
 // For getenv
 #include <cstdlib>
+#include <cerrno>
+#include <cstring>
+#include <chrono>
 #include <GeographicLib/Utility.hpp>
+#include <GeographicLib/SharedData.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <GeographicLib/Trace.hpp>
+
+#if !defined(_WIN32)
+// For mmap
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
 
 #if !defined(GEOGRAPHICLIB_DATA)
 #  if defined(_WIN32)
@@ -98,6 +113,9 @@ namespace GeographicLib {
   // genmatrix(yc,1,length(warr)).abs(c3).genmatrix(yd,length(pows),1)),2)$
   // c3:c0*c3$
 
+  const char* const Geoid::cubmagic_ = "GeographicLib-CubicGeoid";
+  const char* const Geoid::tilemagic_ = "GeographicLib-TiledGeoid";
+
   const int Geoid::c0_ = 240; // Common denominator
   const int Geoid::c3_[stencilsize_ * nterms_] = {
       9, -18, -88,    0,  96,   90,   0,   0, -60, -20,
@@ -199,7 +217,7 @@ namespace GeographicLib {
   };
 
   Geoid::Geoid(const std::string& name, const std::string& path, bool cubic,
-               bool threadsafe)
+               bool threadsafe, datamode mode)
     : _name(name)
     , _dir(path)
     , _cubic(cubic)
@@ -208,17 +226,42 @@ namespace GeographicLib {
     , _degree( Math::degree() )
     , _eps( sqrt(numeric_limits<real>::epsilon()) )
     , _threadsafe(false)        // Set after cache is read
+    , _map(nullptr)
+    , _mapsize(0)
+    , _loadtime(0)
+    , _fd(-1)
+    , _cellsize(0)
+    , _maxtiles(0)
+    , _prefetch(false)
+    , _lasttile(-1)
+    , _stats(false)
   {
+    GEOGRAPHICLIB_TRACE_SCOPE1(geoid__load, name.c_str());
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    ResetStatistics();
     static_assert(sizeof(pixel_t) == pixel_size_, "pixel_t has the wrong size");
+    static_assert(sizeof(float) == sizeof(unsigned),
+                  "float and unsigned have different sizes");
     if (_dir.empty())
       _dir = DefaultGeoidPath();
-    _filename = _dir + "/" + _name + (pixel_size_ != 4 ? ".pgm" : ".pgm4");
+    const bool precomputed = mode == PRECOMPUTED, tiled = mode == TILED;
+    if (precomputed && !_cubic)
+      throw GeographicErr("Precomputed coefficients need cubic interpolation");
+    _filename = _dir + "/" + _name +
+      (precomputed ? ".cub" :
+       (tiled ? ".gtl" : (pixel_size_ != 4 ? ".pgm" : ".pgm4")));
     _file.open(_filename.c_str(), ios::binary);
     if (!(_file.good()))
       throw GeographicErr("File not readable " + _filename);
-    string s;
-    if (!(getline(_file, s) && s == "P5"))
-      throw GeographicErr("File not in PGM format " + _filename);
+    string s, coding;
+    bool quanta = false;
+    int tilesize = 0;
+    if (!(getline(_file, s) &&
+          s == (precomputed ? cubmagic_ : (tiled ? tilemagic_ : "P5"))))
+      throw GeographicErr(string("File not in ") +
+                          (precomputed ? "cubic coefficient" :
+                           (tiled ? "tiled geoid" : "PGM")) +
+                          " format " + _filename);
     _offset = numeric_limits<real>::max();
     _scale = 0;
     _maxerror = _rmserror = -1;
@@ -249,6 +292,15 @@ namespace GeographicLib {
         } else if (key == (_cubic ? "RMSCubicError" : "RMSBilinearError")) {
           // It's not an error if the error can't be read
           is >> _rmserror;
+        } else if ((precomputed || tiled) && key == "Coding") {
+          is >> coding;
+        } else if (tiled && key == "TileSize") {
+          is >> tilesize;
+        } else if (precomputed && key == "Quanta") {
+          for (unsigned i = 0; i < nterms_; ++i)
+            if (!(is >> _quanta[i]))
+              throw GeographicErr("Error reading quanta " + _filename);
+          quanta = true;
         }
       } else {
         istringstream is(s);
@@ -257,7 +309,22 @@ namespace GeographicLib {
         break;
       }
     }
-    {
+    if (precomputed) {
+      if (coding == "float")
+        _cellsize = 4 * nterms_;
+      else if (coding == "int16" && quanta)
+        _cellsize = 2 * nterms_;
+      else
+        throw GeographicErr("Unknown coding " + coding + " " + _filename);
+      _datastart = (unsigned long long)(_file.tellg());
+      _swidth = (unsigned long long)(_width);
+    } else {
+      if (tiled) {
+        if (coding != "rice")
+          throw GeographicErr("Unknown coding " + coding + " " + _filename);
+        if (tilesize != tilesize_)
+          throw GeographicErr("Incorrect tile size " + _filename);
+      }
       unsigned maxval;
       if (!(_file >> maxval))
         throw GeographicErr("Error reading maxval " + _filename);
@@ -282,10 +349,33 @@ namespace GeographicLib {
     if (!(_height & 1))
       // This is so that latitude grid includes the equator.
       throw GeographicErr("Raster height is even " + _filename);
+    _ntx = (_width + tilesize_ - 1) / tilesize_;
+    if (tiled) {
+      // The index gives the offsets of the tiles relative to the end of the
+      // index followed by the total size of the tiles; convert these to file
+      // offsets.
+      size_t ntiles = size_t(_ntx) * size_t((_height + tilesize_ - 1) /
+                                            tilesize_);
+      _tileoffset.resize(ntiles + 1);
+      _file.seekg(streamoff(_datastart));
+      Utility::readarray<unsigned long long, unsigned long long, true>
+        (_file, _tileoffset);
+      if (!_file.good() || _tileoffset[0] != 0)
+        throw GeographicErr("Error reading tile index " + _filename);
+      unsigned long long base = _datastart + 8 * (ntiles + 1);
+      for (size_t k = ntiles + 1; k-- > 0;) {
+        if (k > 0 && _tileoffset[k] < _tileoffset[k-1])
+          throw GeographicErr("Corrupt tile index " + _filename);
+        _tileoffset[k] += base;
+      }
+    }
     _file.seekg(0, ios::end);
-    if (!_file.good() ||
-        _datastart + pixel_size_ * _swidth * (unsigned long long)(_height) !=
-        (unsigned long long)(_file.tellg()))
+    // For precomputed coefficients, there are _height - 1 rows of cells
+    _mapsize = tiled ? _tileoffset.back() :
+      _datastart + (precomputed ?
+                    _cellsize * _swidth * (unsigned long long)(_height - 1) :
+                    pixel_size_ * _swidth * (unsigned long long)(_height));
+    if (!_file.good() || _mapsize != (unsigned long long)(_file.tellg()))
       // Possibly this test should be "<" because the file contains, e.g., a
       // second image.  However, for now we are more strict.
       throw GeographicErr("File has the wrong length " + _filename);
@@ -296,116 +386,719 @@ namespace GeographicLib {
     _iy = _height;
     // Ensure that file errors throw exceptions
     _file.exceptions(ifstream::eofbit | ifstream::failbit | ifstream::badbit);
-    if (threadsafe) {
+    if (mode == MEMORYMAP || precomputed) {
+      _file.close();
+      MapFile();
+      _threadsafe = true;
+    } else if (mode == POSITIONAL || tiled) {
+      _file.close();
+      OpenFile();
+      _threadsafe = true;
+      if (tiled)
+        // Tiles are always read into the tile cache
+        CacheTiles(1ULL << 24);
+    } else if (threadsafe) {
       CacheAll();
       _file.close();
       _threadsafe = true;
     }
+    _loadtime = chrono::duration<double>
+      (chrono::steady_clock::now() - start).count();
   }
 
-  Math::real Geoid::height(real lat, real lon) const {
-    using std::isnan;           // Needed for Centos 7, ubuntu 14
-    lat = Math::LatFix(lat);
-    if (isnan(lat) || isnan(lon)) {
-      return Math::NaN();
+  future<shared_ptr<Geoid>> Geoid::Load(const string& name,
+                                         const string& path, bool cubic,
+                                         bool threadsafe, datamode mode) {
+    return async(launch::async, [=]() -> shared_ptr<Geoid> {
+      return make_shared<Geoid>(name, path, cubic, threadsafe, mode);
+    });
+  }
+
+  Geoid::~Geoid() {
+#if !defined(_WIN32)
+    if (_map)
+      munmap(const_cast<unsigned char*>(_map), size_t(_mapsize));
+    if (_fd >= 0)
+      close(_fd);
+#endif
+  }
+
+  void Geoid::OpenFile() {
+#if !defined(_WIN32)
+    _fd = SharedData::Open(_filename);
+    if (_fd < 0)
+      _fd = open(_filename.c_str(), O_RDONLY);
+    if (_fd < 0)
+      throw GeographicErr("File not readable " + _filename);
+#else
+    throw GeographicErr("Positional reads are not supported on this system");
+#endif
+  }
+
+  unsigned long long Geoid::clockns() {
+    return (unsigned long long)
+      (chrono::duration_cast<chrono::nanoseconds>
+       (chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  void Geoid::countread(unsigned long long bytes, unsigned long long start)
+    const {
+    if (start == 0) return;     // statistics were off when the read started
+    ++_nreads;
+    _nbytes += bytes;
+    _nreadtime += clockns() - start;
+  }
+
+  Math::real Geoid::streamval(int ix, int iy) const {
+    if (_stats) ++_nmisses;
+    unsigned long long start = _stats ? clockns() : 0;
+    try {
+      filepos(ix, iy);
+      // initial values to suppress warnings in case get fails
+      char a = 0, b = 0;
+      _file.get(a);
+      _file.get(b);
+      unsigned r = ((unsigned char)(a) << 8) | (unsigned char)(b);
+      if (pixel_size_ == 4) {
+        _file.get(a);
+        _file.get(b);
+        r = (r << 16) | ((unsigned char)(a) << 8) | (unsigned char)(b);
+      }
+      countread(pixel_size_, start);
+      return real(r);
+    }
+    catch (const exception& e) {
+      // throw GeographicErr("Error reading " + _filename + ": "
+      //                      + e.what());
+      // triggers complaints about the "binary '+'" under Visual Studio.
+      // So use '+=' instead.
+      string err("Error reading ");
+      err += _filename;
+      err += ": ";
+      err += e.what();
+      throw GeographicErr(err);
+    }
+  }
+
+  void Geoid::readpixels(int ix, int iy, pixel_t* data, int n) const {
+    if (_fd < 0) {
+      unsigned long long start = _stats ? clockns() : 0;
+      filepos(ix, iy);
+      Utility::readarray<pixel_t, pixel_t, true>(_file, data, n);
+      countread(pixel_size_ * (unsigned long long)(n), start);
+      return;
     }
-    lon = Math::AngNormalize(lon);
-    real
-      fx =  lon * _rlonres,
-      fy = -lat * _rlatres;
+#if !defined(_WIN32)
+    unsigned long long pos =
+      _datastart + pixel_size_ * (unsigned(iy)*_swidth + unsigned(ix));
+    unsigned char buf[pixel_size_ * tilesize_];
+    while (n > 0) {
+      int k = min(n, tilesize_);
+      size_t len = pixel_size_ * size_t(k);
+      preadbytes(pos, buf, len);
+      // The data is stored big-endian
+      for (int i = 0; i < k; ++i) {
+        unsigned v = 0;
+        for (unsigned j = 0; j < pixel_size_; ++j)
+          v = (v << 8) | unsigned(buf[pixel_size_ * i + j]);
+        data[i] = pixel_t(v);
+      }
+      data += k; n -= k; pos += len;
+    }
+#endif
+  }
+
+  void Geoid::preadbytes(unsigned long long pos, unsigned char* buf,
+                         size_t len) const {
+#if !defined(_WIN32)
+    size_t got = 0;
+    while (got < len) {
+      unsigned long long start = _stats ? clockns() : 0;
+      ssize_t r = pread(_fd, buf + got, len - got, off_t(pos + got));
+      if (r < 0 && errno == EINTR)
+        continue;
+      if (r <= 0)
+        throw GeographicErr("Error reading " + _filename);
+      countread((unsigned long long)(r), start);
+      got += size_t(r);
+    }
+#else
+    (void)pos; (void)buf; (void)len;
+#endif
+  }
+
+  void Geoid::readtile(int tx, int ty, pixel_t* data) const {
     int
-      ix = int(floor(fx)),
-      iy = min((_height - 1)/2 - 1, int(floor(fy)));
+      key = ty * _ntx + tx,
+      nx = min(tilesize_, _width - tx * tilesize_),
+      ny = min(tilesize_, _height - ty * tilesize_);
+    unsigned long long pos = _tileoffset[key];
+    vector<unsigned char> buf(size_t(_tileoffset[key + 1] - pos));
+    preadbytes(pos, buf.data(), buf.size());
+    decodetile(buf.data(), buf.size(), nx, ny, data);
+  }
+
+  void Geoid::decodetile(const unsigned char* buf, size_t len,
+                         int nx, int ny, pixel_t* data) {
+    // Each row of the tile is coded as the Rice parameter k (5 bits)
+    // followed by the nx residuals.  The residual for each pixel is its
+    // value minus a prediction from its neighbors to the west (w), north
+    // (n), and northwest (nw), namely w + n - nw (or w in the first row and
+    // n in the first column), modulo 2^wid.  This is mapped to an unsigned
+    // number u by interleaving positive and negative values (0, -1, 1, -2,
+    // ...); u is coded as q = u >> k in unary (q ones and a zero) followed
+    // by the low k bits of u, or, if q >= tileescape_, tileescape_ ones
+    // followed by u in wid bits.  The bits are packed most significant
+    // first.
+    const unsigned wid = 8 * pixel_size_;
+    const unsigned long long mask = pixel_max_;
+    const unsigned char* end = buf + len;
+    unsigned long long acc = 0;
+    unsigned nbits = 0;
+    auto get = [&](unsigned k) -> unsigned long long {
+      while (nbits < k) {
+        if (buf == end)
+          throw GeographicErr("Tile data truncated");
+        acc = (acc << 8) | *buf++;
+        nbits += 8;
+      }
+      nbits -= k;
+      return (acc >> nbits) & ((1ULL << k) - 1);
+    };
+    for (int y = 0; y < ny; ++y) {
+      pixel_t* row = data + y * tilesize_;
+      const pixel_t* prev = y ? row - tilesize_ : row;
+      unsigned k = unsigned(get(5));
+      if (k >= wid)
+        throw GeographicErr("Tile data corrupt");
+      for (int x = 0; x < nx; ++x) {
+        unsigned q = 0;
+        while (q < tileescape_ && get(1)) ++q;
+        unsigned long long
+          u = q < tileescape_ ? ((unsigned long long)(q) << k) | get(k) :
+          get(wid),
+          d = (u >> 1) ^ (u & 1 ? mask : 0),
+          p = y == 0 ? (x == 0 ? 0 : row[x-1]) :
+          (x == 0 ? prev[0] :
+           (unsigned long long)(row[x-1]) + prev[x] - prev[x-1]);
+        row[x] = pixel_t((p + d) & mask);
+      }
+    }
+  }
+
+  Math::real Geoid::preadval(int ix, int iy) const {
+    if (_stats) ++_nmisses;
+    pixel_t r;
+    readpixels(ix, iy, &r, 1);
+    return real(r);
+  }
+
+  void Geoid::MapFile() {
+#if !defined(_WIN32)
+    // Use a shared memory segment holding the file if there is one
+    int fd = SharedData::Open(_filename);
+    if (fd < 0)
+      fd = open(_filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw GeographicErr("File not readable " + _filename);
+    struct stat sb;
+    if (fstat(fd, &sb) < 0 ||
+        (unsigned long long)(sb.st_size) != _mapsize) {
+      close(fd);
+      throw GeographicErr("File has the wrong length " + _filename);
+    }
+    void* p = mmap(nullptr, size_t(_mapsize), PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping remains valid after the file is closed
+    close(fd);
+    if (p == MAP_FAILED)
+      throw GeographicErr("Cannot memory map " + _filename);
+    _map = static_cast<const unsigned char*>(p);
+#else
+    throw GeographicErr("Memory mapping is not supported on this system");
+#endif
+  }
+
+  bool Geoid::cellindex(real lat, real lon, int& ix, int& iy,
+                        real& fx, real& fy) const {
+    using std::isnan;           // Needed for Centos 7, ubuntu 14
+    lat = Math::LatFix(lat);
+    if (isnan(lat) || isnan(lon))
+      return false;
+    // AngNormalize (which calls remainder) is relatively slow; skip it if
+    // lon is already in (-180, 180].
+    if (!(lon > -180 && lon <= 180)) lon = Math::AngNormalize(lon);
+    fx =  lon * _rlonres;
+    fy = -lat * _rlatres;
+    ix = int(floor(fx));
+    iy = min((_height - 1)/2 - 1, int(floor(fy)));
     fx -= ix;
     fy -= iy;
     iy += (_height - 1)/2;
     ix += ix < 0 ? _width : (ix >= _width ? -_width : 0);
-    real v00 = 0, v01 = 0, v10 = 0, v11 = 0;
-    real t[nterms_];
-
-    if (_threadsafe || !(ix == _ix && iy == _iy)) {
-      if (!_cubic) {
-        v00 = rawval(ix    , iy    );
-        v01 = rawval(ix + 1, iy    );
-        v10 = rawval(ix    , iy + 1);
-        v11 = rawval(ix + 1, iy + 1);
-      } else {
-        real v[stencilsize_];
-        int k = 0;
-        v[k++] = rawval(ix    , iy - 1);
-        v[k++] = rawval(ix + 1, iy - 1);
-        v[k++] = rawval(ix - 1, iy    );
-        v[k++] = rawval(ix    , iy    );
-        v[k++] = rawval(ix + 1, iy    );
-        v[k++] = rawval(ix + 2, iy    );
-        v[k++] = rawval(ix - 1, iy + 1);
-        v[k++] = rawval(ix    , iy + 1);
-        v[k++] = rawval(ix + 1, iy + 1);
-        v[k++] = rawval(ix + 2, iy + 1);
-        v[k++] = rawval(ix    , iy + 2);
-        v[k++] = rawval(ix + 1, iy + 2);
-
-        const int* c3x = iy == 0 ? c3n_ : (iy == _height - 2 ? c3s_ : c3_);
-        int c0x = iy == 0 ? c0n_ : (iy == _height - 2 ? c0s_ : c0_);
-        for (unsigned i = 0; i < nterms_; ++i) {
-          t[i] = 0;
-          for (unsigned j = 0; j < stencilsize_; ++j)
-            t[i] += v[j] * c3x[nterms_ * j + i];
-          t[i] /= c0x;
+    return true;
+  }
+
+  void Geoid::cellfit(int ix, int iy, real t[]) const {
+    if (_stats) ++_nfits;
+    if (_prefetch)
+      prefetch(ix, iy);
+    if (_cellsize) {
+      // Precomputed coefficients stored big-endian
+      const unsigned char* p = _map + _datastart +
+        _cellsize * (unsigned(iy)*_swidth + unsigned(ix));
+      for (unsigned i = 0; i < nterms_; ++i) {
+        if (_cellsize == 4 * nterms_) {
+          unsigned r = (unsigned(p[0]) << 24) | (unsigned(p[1]) << 16) |
+            (unsigned(p[2]) << 8) | unsigned(p[3]);
+          float x;
+          memcpy(&x, &r, sizeof(x));
+          t[i] = real(x);
+          p += 4;
+        } else {
+          int r = (int(p[0]) << 8) | int(p[1]);
+          t[i] = (r < 0x8000 ? r : r - 0x10000) * _quanta[i];
+          p += 2;
         }
       }
-    } else { // same cell; used cached coefficients
-      if (!_cubic) {
-        v00 = _v00;
-        v01 = _v01;
-        v10 = _v10;
-        v11 = _v11;
-      } else
-        copy(_t, _t + nterms_, t);
+    } else {
+      const int* d = stencil(_cubic);
+      real v[stencilsize_];
+      for (unsigned k = 0; k < (_cubic ? stencilsize_ : 4); ++k)
+        v[k] = rawval(ix + d[2 * k], iy + d[2 * k + 1]);
+      stencilfit(v, iy, t);
     }
+  }
+
+  const int* Geoid::stencil(bool cubic) {
+    // The offsets (dx, dy) of the pixels of the stencil from (ix, iy)
+    static const int
+      bilinear[2 * 4] = { 0, 0,  1, 0,  0, 1,  1, 1 },
+      cubic12[2 * stencilsize_] = {
+        0, -1,  1, -1,
+        -1, 0,  0, 0,  1, 0,  2, 0,
+        -1, 1,  0, 1,  1, 1,  2, 1,
+        0, 2,  1, 2,
+      };
+    return cubic ? cubic12 : bilinear;
+  }
+
+  void Geoid::stencilfit(const real v[], int iy, real t[]) const {
     if (!_cubic) {
-      real
-        a = (1 - fx) * v00 + fx * v01,
-        b = (1 - fx) * v10 + fx * v11,
-        c = (1 - fy) * a + fy * b,
-        h = _offset + _scale * c;
-      if (!_threadsafe) {
-        _ix = ix;
-        _iy = iy;
-        _v00 = v00;
-        _v01 = v01;
-        _v10 = v10;
-        _v11 = v11;
+      for (unsigned i = 0; i < 4; ++i)
+        t[i] = v[i];
+      return;
+    }
+    if (iy == 0)
+      cubicfit(v, c3n_, c0n_, t);
+    else if (iy == _height - 2)
+      cubicfit(v, c3s_, c0s_, t);
+    else
+      cubicfit(v, c3_, c0_, t);
+  }
+
+  void Geoid::cubicfit(const real v[], const int c3x[], int c0x, real t[]) {
+    for (unsigned i = 0; i < nterms_; ++i) {
+      t[i] = 0;
+      for (unsigned j = 0; j < stencilsize_; ++j)
+        t[i] += v[j] * c3x[nterms_ * j + i];
+      t[i] /= c0x;
+    }
+  }
+
+  unsigned long long Geoid::pixelindex(int ix, int iy) const {
+    if (ix < 0)
+      ix += _width;
+    else if (ix >= _width)
+      ix -= _width;
+    if (iy < 0 || iy >= _height) {
+      iy = iy < 0 ? -iy : 2 * (_height - 1) - iy;
+      ix += (ix < _width/2 ? 1 : -1) * _width/2;
+    }
+    return (unsigned long long)(iy) * _swidth + unsigned(ix);
+  }
+
+  void Geoid::gatherpixels(size_t n, const unsigned long long pix[],
+                           real val[]) const {
+    if (n == 0) return;
+    if (_stats) _nmisses += n;
+    // Divide the pixels into runs [runs[k], runs[k+1]) which are read with a
+    // single request; the pixels in the gaps are read and discarded.
+    const unsigned long long maxrun = 1ULL << 16;
+    vector<size_t> runs(1, 0);
+    for (size_t i = 1; i < n; ++i)
+      if (pix[i] - pix[i - 1] > gathergap_ ||
+          pix[i] - pix[runs.back()] >= maxrun)
+        runs.push_back(i);
+    runs.push_back(n);
+    auto readrun = [&](size_t k) -> void {
+      size_t i0 = runs[k], i1 = runs[k + 1];
+      unsigned long long p0 = pix[i0];
+      size_t len = size_t(pix[i1 - 1] - p0 + 1);
+      vector<pixel_t> data(len);
+      if (_fd >= 0) {
+        vector<unsigned char> buf(pixel_size_ * len);
+        preadbytes(_datastart + pixel_size_ * p0, buf.data(), buf.size());
+        // The data is stored big-endian
+        for (size_t i = 0; i < len; ++i) {
+          unsigned v = 0;
+          for (unsigned j = 0; j < pixel_size_; ++j)
+            v = (v << 8) | unsigned(buf[pixel_size_ * i + j]);
+          data[i] = pixel_t(v);
+        }
+      } else
+        readpixels(int(p0 % _swidth), int(p0 / _swidth), data.data(),
+                   int(len));
+      for (size_t i = i0; i < i1; ++i)
+        val[i] = real(data[size_t(pix[i] - p0)]);
+    };
+    if (_fd >= 0)
+      // Positional reads may be issued concurrently; this overlaps the
+      // latency of the requests (e.g., for a network file system).
+      Executor::Parallel(runs.size() - 1, gatherqueue_, readrun);
+    else
+      for (size_t k = 0; k + 1 < runs.size(); ++k)
+        readrun(k);
+  }
+
+  void Geoid::gatherheights(size_t n, const real lat[], const real lon[],
+                            real h[]) const {
+    const unsigned long long nocell = ~0ULL;
+    const int* d = stencil(_cubic);
+    const unsigned ns = _cubic ? stencilsize_ : 4;
+    vector<unsigned long long> keys, cells, pix;
+    vector<real> fxs, fys, val, fits;
+    for (size_t b0 = 0; b0 < n; b0 += gatherblock_) {
+      size_t m = min(n - b0, gatherblock_);
+      // Find the cells for the points, keyed by iy * _width + ix
+      keys.resize(m); fxs.resize(m); fys.resize(m);
+      cells.clear();
+      for (size_t i = 0; i < m; ++i) {
+        int ix, iy;
+        if (cellindex(lat[b0 + i], lon[b0 + i], ix, iy, fxs[i], fys[i]))
+          cells.push_back(keys[i] =
+                          (unsigned long long)(iy) * _width + unsigned(ix));
+        else
+          keys[i] = nocell;
       }
-      return h;
-    } else {
-      real h = t[0] + fx * (t[1] + fx * (t[3] + fx * t[6])) +
+      sort(cells.begin(), cells.end());
+      cells.erase(unique(cells.begin(), cells.end()), cells.end());
+      // The pixels needed for the stencils of all the cells
+      pix.clear();
+      for (unsigned long long c : cells) {
+        int ix = int(c % unsigned(_width)), iy = int(c / unsigned(_width));
+        for (unsigned k = 0; k < ns; ++k)
+          pix.push_back(pixelindex(ix + d[2 * k], iy + d[2 * k + 1]));
+      }
+      sort(pix.begin(), pix.end());
+      pix.erase(unique(pix.begin(), pix.end()), pix.end());
+      val.resize(pix.size());
+      gatherpixels(pix.size(), pix.data(), val.data());
+      // Fit each cell
+      fits.resize(cells.size() * nterms_);
+      for (size_t j = 0; j < cells.size(); ++j) {
+        int
+          ix = int(cells[j] % unsigned(_width)),
+          iy = int(cells[j] / unsigned(_width));
+        real v[stencilsize_];
+        for (unsigned k = 0; k < ns; ++k)
+          v[k] = val[lower_bound(pix.begin(), pix.end(),
+                                 pixelindex(ix + d[2 * k], iy + d[2 * k + 1]))
+                     - pix.begin()];
+        stencilfit(v, iy, fits.data() + nterms_ * j);
+      }
+      if (_stats) _nfits += cells.size();
+      for (size_t i = 0; i < m; ++i)
+        h[b0 + i] = keys[i] == nocell ? Math::NaN() :
+          interpolate(fits.data() + nterms_ *
+                      (lower_bound(cells.begin(), cells.end(), keys[i]) -
+                       cells.begin()), fxs[i], fys[i]);
+    }
+  }
+
+  Math::real Geoid::evalfit(bool cubic, const real t[], real fx, real fy) {
+    if (!cubic) {
+      real
+        a = (1 - fx) * t[0] + fx * t[1],
+        b = (1 - fx) * t[2] + fx * t[3];
+      return (1 - fy) * a + fy * b;
+    } else
+      return t[0] + fx * (t[1] + fx * (t[3] + fx * t[6])) +
         fy * (t[2] + fx * (t[4] + fx * t[7]) +
              fy * (t[5] + fx * t[8] + fy * t[9]));
-      h = _offset + _scale * h;
-      if (!_threadsafe) {
-        _ix = ix;
-        _iy = iy;
-        copy(t, t + nterms_, _t);
+  }
+
+  Math::real Geoid::interpolate(const real t[], real fx, real fy) const {
+    return _offset + _scale * evalfit(_cubic, t, fx, fy);
+  }
+
+  Math::real Geoid::height(real lat, real lon) const {
+    int ix, iy;
+    real fx, fy;
+    if (_stats) ++_nqueries;
+    if (!cellindex(lat, lon, ix, iy, fx, fy))
+      return Math::NaN();
+    if (_threadsafe) {
+      real t[nterms_];
+      cellfit(ix, iy, t);
+      return interpolate(t, fx, fy);
+    }
+    if (!(ix == _ix && iy == _iy)) {
+      cellfit(ix, iy, _t);
+      _ix = ix;
+      _iy = iy;
+    } // else same cell; use cached coefficients
+    return interpolate(_t, fx, fy);
+  }
+
+  void Geoid::operator()(size_t n, const real lat[], const real lon[],
+                         real h[]) const {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "Geoid::operator()", n);
+    // A direct-mapped cache of the fits for recently visited cells; the cells
+    // in any cellblock_ x cellblock_ block map to distinct slots.
+    struct slot { int ix, iy; real t[nterms_]; };
+    if (_stats) _nqueries += n;
+    if (!_map && !_cache && !_maxtiles) {
+      // Each value would be read from the file; read all the values needed
+      // by a block of points at once instead.
+      gatherheights(n, lat, lon, h);
+      return;
+    }
+    slot s[cellblock_ * cellblock_];
+    for (unsigned k = 0; k < cellblock_ * cellblock_; ++k)
+      s[k].ix = s[k].iy = -1;
+    for (size_t i = 0; i < n; ++i) {
+      int ix, iy;
+      real fx, fy;
+      if (!cellindex(lat[i], lon[i], ix, iy, fx, fy)) {
+        h[i] = Math::NaN();
+        continue;
       }
-      return h;
+      slot& c = s[(unsigned(iy) % cellblock_) * cellblock_ +
+                  unsigned(ix) % cellblock_];
+      if (!(c.ix == ix && c.iy == iy)) {
+        cellfit(ix, iy, c.t);
+        c.ix = ix;
+        c.iy = iy;
+      }
+      h[i] = interpolate(c.t, fx, fy);
     }
   }
 
+  void Geoid::HeightGrid(real lat0, real dlat, int nlat,
+                         real lon0, real dlon, int nlon, real h[],
+                         unsigned threads) const {
+    if (nlat <= 0 || nlon <= 0) return;
+    // The cell indices and fractional positions depend on only latitude
+    // (for the rows) or longitude (for the columns); ix or iy = -1 flags a
+    // NaN.
+    vector<int> ixs(nlon), iys(nlat);
+    vector<real> fxs(nlon), fys(nlat);
+    int ix, iy;
+    real fx, fy;
+    for (int j = 0; j < nlon; ++j)
+      ixs[j] = cellindex(0, lon0 + j * dlon, ix, iy, fxs[j], fy) ? ix : -1;
+    // The rows in each band [bands[k], bands[k+1]) lie in the same row of
+    // cells.
+    vector<int> bands;
+    for (int i = 0; i < nlat; ++i) {
+      iys[i] = cellindex(lat0 + i * dlat, 0, ix, iy, fx, fys[i]) ? iy : -1;
+      if (i == 0 || iys[i] != iys[i-1])
+        bands.push_back(i);
+    }
+    bands.push_back(nlat);
+    if (_stats) _nqueries += (unsigned long long)(nlat) * nlon;
+    Executor::Parallel(bands.size() - 1, _threadsafe ? threads : 1,
+                       [&](size_t k) -> void {
+      int i0 = bands[k], i1 = bands[k+1], by = iys[i0];
+      real t[nterms_];
+      for (int j0 = 0; j0 < nlon;) {
+        // The run of columns [j0, j1) lies in the same column of cells
+        int bx = ixs[j0], j1 = j0 + 1;
+        while (j1 < nlon && ixs[j1] == bx) ++j1;
+        bool valid = bx >= 0 && by >= 0;
+        if (valid)
+          cellfit(bx, by, t);
+        for (int i = i0; i < i1; ++i) {
+          real* row = h + size_t(i) * nlon;
+          for (int j = j0; j < j1; ++j)
+            row[j] = valid ? interpolate(t, fxs[j], fys[i]) : Math::NaN();
+        }
+        j0 = j1;
+      }
+    });
+  }
+
+  Math::real Geoid::tileval(int ix, int iy) const {
+    // 0 <= ix < _width, 0 <= iy < _height here
+    unique_lock<mutex> lock(_tilelock, defer_lock);
+    if (_fd >= 0) {
+      // The tile cache is shared by all threads
+      lock.lock();
+      if (_maxtiles == 0) {
+        // Turned off by another thread in the meantime
+        lock.unlock();
+        return preadval(ix, iy);
+      }
+    }
+    int
+      tx = ix / tilesize_, ty = iy / tilesize_,
+      key = ty * _ntx + tx;
+    auto p = _tileindex.find(key);
+    if (p != _tileindex.end()) {
+      // Move tile to front of list
+      if (p->second != _tiles.begin())
+        _tiles.splice(_tiles.begin(), _tiles, p->second);
+    } else {
+      if (_stats) ++_nmisses;
+      // Read the tile, reusing the least recently used tile if the cache is
+      // full.
+      if (_tiles.size() >= _maxtiles) {
+        _tileindex.erase(_tiles.back().key);
+        _tiles.splice(_tiles.begin(), _tiles, prev(_tiles.end()));
+      } else
+        _tiles.push_front(tile());
+      tile& t = _tiles.front();
+      int
+        x0 = tx * tilesize_, y0 = ty * tilesize_,
+        nx = min(tilesize_, _width - x0), ny = min(tilesize_, _height - y0);
+      try {
+        t.data.resize(tilesize_ * tilesize_);
+        if (!_tileoffset.empty())
+          readtile(tx, ty, t.data.data());
+        else
+          for (int y = 0; y < ny; ++y)
+            readpixels(x0, y0 + y, &(t.data[y * tilesize_]), nx);
+      }
+      catch (const exception& e) {
+        _tiles.pop_front();
+        throw GeographicErr(string("Error reading tile ") + e.what());
+      }
+      t.key = key;
+      _tileindex[key] = _tiles.begin();
+    }
+    return real(_tiles.front().data[(iy - ty * tilesize_) * tilesize_ +
+                                    (ix - tx * tilesize_)]);
+  }
+
+  void Geoid::CacheTiles(unsigned long long maxbytes) const {
+    if (_threadsafe && _fd < 0)
+      throw GeographicErr("Attempt to change cache of threadsafe Geoid");
+    lock_guard<mutex> lock(_tilelock);
+    const unsigned long long tilebytes =
+      (unsigned long long)(tilesize_) * tilesize_ * sizeof(pixel_t);
+    // A tiled file is always read via the tile cache
+    _maxtiles = maxbytes == 0 && _tileoffset.empty() ? 0 :
+      size_t(max(1ULL, maxbytes / tilebytes));
+    // Discard excess tiles
+    while (_tiles.size() > _maxtiles) {
+      _tileindex.erase(_tiles.back().key);
+      _tiles.pop_back();
+    }
+  }
+
+  void Geoid::Prefetch(bool enable) const {
+    if (enable && !_map && _fd < 0)
+      throw GeographicErr("Prefetching needs a memory mapped file "
+                          "or positional reads");
+    _lasttile = -1;
+    _prefetch = enable;
+  }
+
+  void Geoid::prefetch(int ix, int iy) const {
+    // 0 <= ix < _width, 0 <= iy < _height - 1 here
+    int
+      tx = ix / tilesize_, ty = iy / tilesize_,
+      key = ty * _ntx + tx,
+      last = _lasttile.exchange(key, memory_order_relaxed);
+    if (last == key || last < 0)
+      return;
+    // Predict the next tile from the direction of the move from the last
+    // tile, allowing for wrap-around in longitude
+    int dx = tx - last % _ntx, dy = ty - last / _ntx;
+    dx += dx > _ntx/2 ? -_ntx : (dx < -_ntx/2 ? _ntx : 0);
+    dx = dx > 0 ? 1 : (dx < 0 ? -1 : 0);
+    dy = dy > 0 ? 1 : (dy < 0 ? -1 : 0);
+    tx += dx; tx += tx < 0 ? _ntx : (tx >= _ntx ? -_ntx : 0);
+    ty += dy;
+    if (ty >= 0 && ty * tilesize_ < _height)
+      advise(tx, ty);
+  }
+
+  void Geoid::advise(int tx, int ty) const {
+#if !defined(_WIN32)
+    // Precomputed coefficients have _cellsize bytes per cell and _height - 1
+    // rows of cells
+    if (!_tileoffset.empty()) {
+      // Advise reading the compressed tile
+      int key = ty * _ntx + tx;
+      posix_fadvise(_fd, off_t(_tileoffset[key]),
+                    off_t(_tileoffset[key + 1] - _tileoffset[key]),
+                    POSIX_FADV_WILLNEED);
+      return;
+    }
+    unsigned long long
+      recsize = _cellsize ? _cellsize : pixel_size_,
+      pagesize = (unsigned long long)(sysconf(_SC_PAGESIZE));
+    int
+      x0 = tx * tilesize_, y0 = ty * tilesize_,
+      nx = min(tilesize_, _width - x0),
+      ny = min(tilesize_, _height - (_cellsize ? 1 : 0) - y0);
+    for (int y = 0; y < ny; ++y) {
+      unsigned long long
+        pos = _datastart + recsize * (unsigned(y0 + y)*_swidth + unsigned(x0)),
+        len = recsize * unsigned(nx);
+      // This is only advice, so ignore any errors
+      if (_map) {
+        unsigned long long pos0 = pos - pos % pagesize;
+        madvise(const_cast<unsigned char*>(_map) + pos0,
+                size_t(pos + len - pos0), MADV_WILLNEED);
+      } else
+        posix_fadvise(_fd, off_t(pos), off_t(len), POSIX_FADV_WILLNEED);
+    }
+#else
+    (void)tx; (void)ty;
+#endif
+  }
+
   void Geoid::CacheClear() const {
-    if (!_threadsafe) {
+    if (_fd >= 0) {
+      lock_guard<mutex> lock(_tilelock);
+      if (_tileoffset.empty())
+        _maxtiles = 0;
+      _tiles.clear();
+      _tileindex.clear();
+    } else if (!_threadsafe) {
       _cache = false;
+      _maxtiles = 0;
       try {
         _data.clear();
         // Use swap to release memory back to system
-        vector< vector<pixel_t> >().swap(_data);
+        vector<pixel_t>().swap(_data);
+        _tiles.clear();
+        _tileindex.clear();
       }
       catch (const exception&) {
       }
     }
   }
 
+  size_t Geoid::MemoryUsage() const {
+    size_t bytes = _data.capacity() * sizeof(pixel_t) +
+      _tileoffset.capacity() * sizeof(unsigned long long);
+    lock_guard<mutex> lock(_tilelock);
+    // Each tile costs a list node and a hash table node in addition to its
+    // pixels.
+    bytes += _tileindex.bucket_count() * sizeof(void*);
+    for (const tile& t : _tiles)
+      bytes += sizeof(tile) + 2 * sizeof(void*) +
+        sizeof(decltype(_tileindex)::value_type) + 2 * sizeof(void*) +
+        t.data.capacity() * sizeof(pixel_t);
+    return bytes;
+  }
+
   void Geoid::CacheArea(real south, real west, real north, real east) const {
+    GEOGRAPHICLIB_TRACE_SCOPE4(geoid__cache, double(south), double(west),
+                               double(north), double(east));
     if (_threadsafe)
       throw GeographicErr("Attempt to change cache of threadsafe Geoid");
     if (south > north) {
@@ -441,16 +1134,16 @@ namespace GeographicLib {
       ie += iw < 0 ? _width : (iw >= _width ? -_width : 0);
       iw += iw < 0 ? _width : (iw >= _width ? -_width : 0);
     }
-    int oysize = int(_data.size());
     _xsize = ie - iw + 1;
     _ysize = is - in + 1;
+    _xstride = (_xsize + rowalign_ - 1) / rowalign_ * rowalign_;
     _xoffset = iw;
     _yoffset = in;
 
     try {
-      _data.resize(_ysize, vector<pixel_t>(_xsize));
-      for (int iy = min(oysize, _ysize); iy--;)
-        _data[iy].resize(_xsize);
+      // A single allocation for the whole area (the existing storage is
+      // reused if it's big enough).
+      _data.resize(size_t(_ysize) * _xstride);
     }
     catch (const bad_alloc&) {
       CacheClear();
@@ -468,15 +1161,11 @@ namespace GeographicLib {
             iw1 -= _width;
         }
         int xs1 = min(_width - iw1, _xsize);
-        filepos(iw1, iy1);
-        Utility::readarray<pixel_t, pixel_t, true>
-          (_file, &(_data[iy - in][0]), xs1);
-        if (xs1 < _xsize) {
+        pixel_t* row = _data.data() + size_t(iy - in) * _xstride;
+        readpixels(iw1, iy1, row, xs1);
+        if (xs1 < _xsize)
           // Wrap around longitude = 0
-          filepos(0, iy1);
-          Utility::readarray<pixel_t, pixel_t, true>
-            (_file, &(_data[iy - in][xs1]), _xsize - xs1);
-        }
+          readpixels(0, iy1, row + xs1, _xsize - xs1);
       }
       _cache = true;
     }
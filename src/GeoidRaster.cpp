@@ -0,0 +1,246 @@
+/**
+ * \file GeoidRaster.cpp
+ * \brief Implementation for GeographicLib::GeoidRaster class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/GeoidRaster.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <GeographicLib/Utility.hpp>
+#include <GeographicLib/SharedData.hpp>
+
+#if !defined(_WIN32)
+// For mmap
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    // The value which marks missing data in GTX files
+    const float nodata = -88.8888f;
+  }
+
+  GeoidRaster::GeoidRaster(const string& filename, bool cubic)
+    : _filename(filename)
+    , _cubic(cubic)
+    , _map(nullptr)
+    , _mapsize(0)
+    , _pixels(nullptr)
+  {
+    ifstream file(_filename.c_str(), ios::binary);
+    if (!file.good())
+      throw GeographicErr("File not readable " + _filename);
+    file.seekg(0, ios::end);
+    unsigned long long size = (unsigned long long)(file.tellg());
+    if (!file.good() || size < gtxheader_)
+      throw GeographicErr("File too short " + _filename);
+    // The header is big-endian according to the specification; however,
+    // some little-endian files exist.  Pick the byte order for which the
+    // grid size matches the file size.
+    real transform[4];
+    int sizes[2];
+    for (int k = 0; k < 2; ++k) {
+      file.seekg(0);
+      if (k == 0) {
+        Utility::readarray<double, real, true>(file, transform, 4);
+        Utility::readarray<int, int, true>(file, sizes, 2);
+      } else {
+        Utility::readarray<double, real, false>(file, transform, 4);
+        Utility::readarray<int, int, false>(file, sizes, 2);
+      }
+      if (sizes[0] > 0 && sizes[1] > 0 &&
+          size == gtxheader_ + 4ULL * unsigned(sizes[0]) * unsigned(sizes[1])) {
+        _swap = (k == 0) != Math::bigendian;
+        break;
+      }
+      if (k == 1)
+        throw GeographicErr("Header does not match the file size for "
+                            + _filename);
+    }
+    _lat0 = transform[0];
+    _lon0 = transform[1];
+    _dlat = transform[2];
+    _dlon = transform[3];
+    _nrows = sizes[0];
+    _ncols = sizes[1];
+    Init(gtxheader_);
+  }
+
+  GeoidRaster::GeoidRaster(const string& filename,
+                           real lat0, real lon0, real dlat, real dlon,
+                           int nrows, int ncols, bool bigendian, bool cubic)
+    : _filename(filename)
+    , _cubic(cubic)
+    , _lat0(lat0)
+    , _lon0(lon0)
+    , _dlat(dlat)
+    , _dlon(dlon)
+    , _nrows(nrows)
+    , _ncols(ncols)
+    , _swap(bigendian != Math::bigendian)
+    , _map(nullptr)
+    , _mapsize(0)
+    , _pixels(nullptr)
+  {
+    Init(0);
+  }
+
+  GeoidRaster::~GeoidRaster() {
+#if !defined(_WIN32)
+    if (_map)
+      munmap(const_cast<unsigned char*>(_map), size_t(_mapsize));
+#endif
+  }
+
+  void GeoidRaster::Init(unsigned long long datastart) {
+    using std::isfinite;
+    if (!(isfinite(_lat0) && isfinite(_lon0) && isfinite(_dlat) &&
+          _dlat != 0 && isfinite(_dlon) && _dlon > 0))
+      throw GeographicErr("Bad origin or spacing for the grid in "
+                          + _filename);
+    if (!(_nrows >= 2 && _ncols >= 2))
+      throw GeographicErr("Grid needs at least 2 rows and columns in "
+                          + _filename);
+    // The grid wraps around if a whole number of columns spans 360d
+    real p = 360 / _dlon;
+    int np = int(round(p));
+    _period = abs(p - np) < 1/real(1000) && np <= _ncols ? np : 0;
+    _mapsize = datastart + 4ULL * unsigned(_nrows) * unsigned(_ncols);
+#if !defined(_WIN32)
+    // Use a shared memory segment holding the file if there is one
+    int fd = SharedData::Open(_filename);
+    if (fd < 0)
+      fd = open(_filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw GeographicErr("File not readable " + _filename);
+    struct stat sb;
+    if (fstat(fd, &sb) < 0 ||
+        (unsigned long long)(sb.st_size) != _mapsize) {
+      close(fd);
+      throw GeographicErr("File has the wrong length " + _filename);
+    }
+    void* q = mmap(nullptr, size_t(_mapsize), PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping remains valid after the file is closed
+    close(fd);
+    if (q == MAP_FAILED)
+      throw GeographicErr("Cannot memory map " + _filename);
+    _map = static_cast<const unsigned char*>(q);
+    _pixels = _map + datastart;
+#else
+    ifstream file(_filename.c_str(), ios::binary);
+    if (!file.good())
+      throw GeographicErr("File not readable " + _filename);
+    _buffer.resize(size_t(_mapsize));
+    file.read(reinterpret_cast<char*>(_buffer.data()), _buffer.size());
+    if (!file.good() || file.peek() != char_traits<char>::eof())
+      throw GeographicErr("File has the wrong length " + _filename);
+    _pixels = _buffer.data() + datastart;
+#endif
+  }
+
+  Math::real GeoidRaster::pixel(int ix, int iy) const {
+    if (_period)
+      ix += ix < 0 ? _period : (ix >= _period ? -_period : 0);
+    if (ix < 0 || ix >= _ncols || iy < 0 || iy >= _nrows)
+      return Math::NaN();
+    unsigned r;
+    memcpy(&r, _pixels + 4 * (size_t(iy) * size_t(_ncols) + size_t(ix)), 4);
+    if (_swap)
+      r = (r >> 24) | ((r >> 8) & 0xff00u) | ((r << 8) & 0xff0000u) |
+        (r << 24);
+    float x;
+    memcpy(&x, &r, sizeof(x));
+    return x == nodata ? Math::NaN() : real(x);
+  }
+
+  bool GeoidRaster::cellindex(real lat, real lon, int& ix, int& iy,
+                              real& fx, real& fy) const {
+    using std::isnan;
+    lat = Math::LatFix(lat);
+    if (isnan(lat) || isnan(lon))
+      return false;
+    fy = (lat - _lat0) / _dlat;
+    // The longitude east of lon0 in [0, 360)
+    real dlon = Math::AngDiff(_lon0, lon);
+    if (dlon < 0) dlon += 360;
+    fx = dlon / _dlon;
+    if (!(fy >= 0 && fy <= _nrows - 1) ||
+        !(_period || fx <= _ncols - 1))
+      return false;
+    ix = min(int(floor(fx)), _period ? _period - 1 : _ncols - 2);
+    iy = min(int(floor(fy)), _nrows - 2);
+    fx -= ix;
+    fy -= iy;
+    return true;
+  }
+
+  bool GeoidRaster::cellfit(int ix, int iy, real t[]) const {
+    using std::isnan;
+    const int* d = Geoid::stencil(_cubic);
+    unsigned ns = _cubic ? stencilsize_ : 4;
+    real v[stencilsize_];
+    bool full = true;
+    for (unsigned k = 0; k < ns; ++k) {
+      v[k] = pixel(ix + d[2 * k], iy + d[2 * k + 1]);
+      full = full && !isnan(v[k]);
+    }
+    if (!_cubic) {
+      copy(v, v + 4, t);
+      return false;
+    } else if (full) {
+      Geoid::cubicfit(v, Geoid::c3_, Geoid::c0_, t);
+      return true;
+    }
+    // Fall back to bilinear; the corners of the cell are elements 3, 4, 7,
+    // and 8 of the cubic stencil.  A missing corner gives a NaN.
+    t[0] = v[3]; t[1] = v[4]; t[2] = v[7]; t[3] = v[8];
+    return false;
+  }
+
+  Math::real GeoidRaster::height(real lat, real lon) const {
+    int ix, iy;
+    real fx, fy, t[nterms_];
+    if (!cellindex(lat, lon, ix, iy, fx, fy))
+      return Math::NaN();
+    bool cubic = cellfit(ix, iy, t);
+    return Geoid::evalfit(cubic, t, fx, fy);
+  }
+
+  void GeoidRaster::operator()(size_t n, const real lat[], const real lon[],
+                               real h[]) const {
+    // A direct-mapped cache of the fits for recently visited cells, as in
+    // Geoid::operator()
+    struct slot { int ix, iy; bool cubic; real t[nterms_]; };
+    slot s[cellblock_ * cellblock_];
+    for (unsigned k = 0; k < cellblock_ * cellblock_; ++k)
+      s[k].ix = s[k].iy = -1;
+    for (size_t i = 0; i < n; ++i) {
+      int ix, iy;
+      real fx, fy;
+      if (!cellindex(lat[i], lon[i], ix, iy, fx, fy)) {
+        h[i] = Math::NaN();
+        continue;
+      }
+      slot& c = s[(unsigned(iy) % cellblock_) * cellblock_ +
+                  unsigned(ix) % cellblock_];
+      if (!(c.ix == ix && c.iy == iy)) {
+        c.cubic = cellfit(ix, iy, c.t);
+        c.ix = ix;
+        c.iy = iy;
+      }
+      h[i] = Geoid::evalfit(c.cubic, c.t, fx, fy);
+    }
+  }
+
+} // namespace GeographicLib
@@ -19,119 +19,310 @@ namespace GeographicLib {
   const char* const Georef::lattile_ = "ABCDEFGHJKLM";
   const char* const Georef::degrees_ = "ABCDEFGHJKLMNPQ";
 
-  void Georef::Forward(real lat, real lon, int prec, string& georef) {
-    using std::isnan;           // Needed for Centos 7, ubuntu 14
-    if (abs(lat) > 90)
-      throw GeographicErr("Latitude " + Utility::str(lat)
-                          + "d not in [-90d, 90d]");
-    if (isnan(lat) || isnan(lon)) {
-      georef = "INVALID";
-      return;
-    }
-    lon = Math::AngNormalize(lon); // lon in [-180,180)
-    if (lat == 90) lat *= (1 - numeric_limits<real>::epsilon() / 2);
-    prec = max(-1, min(int(maxprec_), prec));
-    if (prec == 1) ++prec;      // Disallow prec = 1
-    // The C++ standard mandates 64 bits for long long.  But
-    // check, to make sure.
+  namespace {
+    // The number of 10^-9' units in a degree.  The C++ standard mandates 64
+    // bits for long long.  But check, to make sure.
     static_assert(numeric_limits<long long>::digits >= 45,
                   "long long not wide enough to store 21600e9");
     const long long m = 60000000000LL;
-    long long
-      x = (long long)(floor(lon * real(m))) - lonorig_ * m,
-      y = (long long)(floor(lat * real(m))) - latorig_ * m;
+  }
+
+  long long Georef::Divisor(int prec) {
+    if (prec < 1)
+      return prec < 0 ? tile_ * m : m;
+    long long d = 1;
+    for (int i = prec; i < maxprec_; ++i) d *= base_;
+    return d;
+  }
+
+  void Georef::Indices(real lat, real lon, long long& x, long long& y) {
+    lon = Math::AngNormalize(lon);
+    if (lon == 180) lon = -180; // lon now in [-180,180)
+    if (lat == 90) lat *= (1 - numeric_limits<real>::epsilon() / 2);
+    x = (long long)(floor(lon * real(m))) - lonorig_ * m;
+    y = (long long)(floor(lat * real(m))) - latorig_ * m;
+  }
+
+  void Georef::Chars(long long x, long long y, int prec, char georef[]) {
     int ilon = int(x / m); int ilat = int(y / m);
-    char georef1[maxlen_];
-    georef1[0] = lontile_[ilon / tile_];
-    georef1[1] = lattile_[ilat / tile_];
+    georef[0] = lontile_[ilon / tile_];
+    georef[1] = lattile_[ilat / tile_];
     if (prec >= 0) {
-      georef1[2] = degrees_[ilon % tile_];
-      georef1[3] = degrees_[ilat % tile_];
+      georef[2] = degrees_[ilon % tile_];
+      georef[3] = degrees_[ilat % tile_];
       if (prec > 0) {
         x -= m * ilon; y -= m * ilat;
-        long long d = (long long)pow(real(base_), maxprec_ - prec);
+        long long d = Divisor(prec);
         x /= d; y /= d;
         for (int c = prec; c--;) {
-          georef1[baselen_ + c       ] = digits_[x % base_]; x /= base_;
-          georef1[baselen_ + c + prec] = digits_[y % base_]; y /= base_;
+          georef[baselen_ + c       ] = digits_[x % base_]; x /= base_;
+          georef[baselen_ + c + prec] = digits_[y % base_]; y /= base_;
         }
       }
     }
-    georef.resize(baselen_ + 2 * prec);
-    copy(georef1, georef1 + baselen_ + 2 * prec, georef.begin());
   }
 
-  void Georef::Reverse(const string& georef, real& lat, real& lon,
-                       int& prec, bool centerp) {
-    int len = int(georef.length());
-    if (len >= 3 &&
-        toupper(georef[0]) == 'I' &&
-        toupper(georef[1]) == 'N' &&
-        toupper(georef[2]) == 'V') {
-      lat = lon = Math::NaN();
+  void Georef::Forward(real lat, real lon, int prec, string& georef) {
+    using std::isnan;           // Needed for Centos 7, ubuntu 14
+    if (abs(lat) > 90)
+      throw GeographicErr("Latitude " + Utility::str(lat)
+                          + "d not in [-90d, 90d]");
+    if (isnan(lat) || isnan(lon)) {
+      georef = "INVALID";
       return;
     }
-    if (len < baselen_ - 2)
+    prec = max(-1, min(int(maxprec_), prec));
+    if (prec == 1) ++prec;      // Disallow prec = 1
+    long long x, y;
+    Indices(lat, lon, x, y);
+    char georef1[maxlen_];
+    Chars(x, y, prec, georef1);
+    georef.resize(baselen_ + 2 * prec);
+    copy(georef1, georef1 + baselen_ + 2 * prec, georef.begin());
+  }
+
+  Georef::status Georef::ParseChars(const char* georef, int len,
+                                    long long& x, long long& y, int& prec,
+                                    bool throwp) {
+    // Only used to construct error messages
+    auto str = [georef, len](int p) -> string
+      { return string(georef + p, max(0, len - p)); };
+    if (len < baselen_ - 2) {
+      if (!throwp) return BADSTRING;
       throw GeographicErr("Georef must start with at least 2 letters "
-                          + georef);
+                          + str(0));
+    }
     int prec1 = (2 + len - baselen_) / 2 - 1;
     int k;
     k = Utility::lookup(lontile_, georef[0]);
-    if (k < 0)
-      throw GeographicErr("Bad longitude tile letter in georef " + georef);
-    real lon1 = k + lonorig_ / tile_;
+    if (k < 0) {
+      if (!throwp) return BADSTRING;
+      throw GeographicErr("Bad longitude tile letter in georef " + str(0));
+    }
+    long long x1 = k;
     k = Utility::lookup(lattile_, georef[1]);
-    if (k < 0)
-      throw GeographicErr("Bad latitude tile letter in georef " + georef);
-    real lat1 = k + latorig_ / tile_;
-    real unit = 1;
+    if (k < 0) {
+      if (!throwp) return BADSTRING;
+      throw GeographicErr("Bad latitude tile letter in georef " + str(0));
+    }
+    long long y1 = k;
     if (len > 2) {
-      unit *= tile_;
       k = Utility::lookup(degrees_, georef[2]);
-      if (k < 0)
-        throw GeographicErr("Bad longitude degree letter in georef " + georef);
-      lon1 = lon1 * tile_ + k;
-      if (len < 4)
+      if (k < 0) {
+        if (!throwp) return BADSTRING;
+        throw GeographicErr("Bad longitude degree letter in georef "
+                            + str(0));
+      }
+      x1 = x1 * tile_ + k;
+      if (len < 4) {
+        if (!throwp) return BADSTRING;
         throw GeographicErr("Missing latitude degree letter in georef "
-                            + georef);
+                            + str(0));
+      }
       k = Utility::lookup(degrees_, georef[3]);
-      if (k < 0)
-        throw GeographicErr("Bad latitude degree letter in georef " + georef);
-      lat1 = lat1 * tile_ + k;
+      if (k < 0) {
+        if (!throwp) return BADSTRING;
+        throw GeographicErr("Bad latitude degree letter in georef " + str(0));
+      }
+      y1 = y1 * tile_ + k;
       if (prec1 > 0) {
-        if (georef.find_first_not_of(digits_, baselen_) != string::npos)
-          throw GeographicErr("Non digits in trailing portion of georef "
-                              + georef.substr(baselen_));
-        if (len % 2)
+        for (int i = baselen_; i < len; ++i)
+          if (Utility::lookup(digits_, georef[i]) < 0) {
+            if (!throwp) return BADSTRING;
+            throw GeographicErr("Non digits in trailing portion of georef "
+                                + str(baselen_));
+          }
+        if (len % 2) {
+          if (!throwp) return BADSTRING;
           throw GeographicErr("Georef must end with an even number of digits "
-                              + georef.substr(baselen_));
-        if (prec1 == 1)
+                              + str(baselen_));
+        }
+        if (prec1 == 1) {
+          if (!throwp) return BADSTRING;
           throw GeographicErr("Georef needs at least 4 digits for minutes "
-                              + georef.substr(baselen_));
-        if (prec1 > maxprec_)
+                              + str(baselen_));
+        }
+        if (prec1 > maxprec_) {
+          if (!throwp) return BADSTRING;
           throw GeographicErr("More than " + Utility::str(2*maxprec_)
                               + " digits in georef "
-                              + georef.substr(baselen_));
+                              + str(baselen_));
+        }
         for (int i = 0; i < prec1; ++i) {
-          int m = i ? base_ : 6;
-          unit *= m;
-          int
-            x = Utility::lookup(digits_, georef[baselen_ + i]),
-            y = Utility::lookup(digits_, georef[baselen_ + i + prec1]);
-          if (!(i || (x < m && y < m)))
+          int m1 = i ? base_ : 6,
+            xi = Utility::lookup(digits_, georef[baselen_ + i]),
+            yi = Utility::lookup(digits_, georef[baselen_ + i + prec1]);
+          if (!(i || (xi < m1 && yi < m1))) {
+            if (!throwp) return BADSTRING;
             throw GeographicErr("Minutes terms in georef must be less than 60 "
-                                + georef.substr(baselen_));
-          lon1 = m * lon1 + x;
-          lat1 = m * lat1 + y;
+                                + str(baselen_));
+          }
+          x1 = m1 * x1 + xi;
+          y1 = m1 * y1 + yi;
         }
       }
     }
+    x = x1; y = y1;
+    prec = prec1;
+    return OK;
+  }
+
+  Georef::status Georef::ReverseChars(const char* georef, int len,
+                                      real& lat, real& lon, int& prec,
+                                      bool centerp, bool throwp) {
+    if (len >= 3 &&
+        toupper(georef[0]) == 'I' &&
+        toupper(georef[1]) == 'N' &&
+        toupper(georef[2]) == 'V') {
+      lat = lon = Math::NaN();
+      return OK;
+    }
+    long long x, y;
+    int prec1;
+    status st = ParseChars(georef, len, x, y, prec1, throwp);
+    if (st != OK) return st;
+    // The number of cells in a tile
+    real
+      unit = real(tile_ * m / Divisor(prec1)),
+      lat1 = y + latorig_ / tile_ * unit,
+      lon1 = x + lonorig_ / tile_ * unit;
+    if (centerp) {
+      unit *= 2; lat1 = 2 * lat1 + 1; lon1 = 2 * lon1 + 1;
+    }
+    lat = (tile_ * lat1) / unit;
+    lon = (tile_ * lon1) / unit;
+    prec = prec1;
+    return OK;
+  }
+
+  void Georef::Reverse(const string& georef, real& lat, real& lon,
+                       int& prec, bool centerp) {
+    ReverseChars(georef.data(), int(georef.length()), lat, lon, prec,
+                 centerp, true);
+  }
+
+  Georef::status Georef::Reverse(const char* georef, size_t len,
+                                 real& lat, real& lon, int& prec,
+                                 bool centerp) {
+    if (len > size_t(numeric_limits<int>::max())) return BADSTRING;
+    return ReverseChars(georef, int(len), lat, lon, prec, centerp, false);
+  }
+
+  Georef::status Georef::Forward(real lat, real lon, int prec,
+                                 unsigned long long& id) {
+    using std::isnan;
+    if (abs(lat) > 90)
+      return BADLATITUDE;
+    if (isnan(lat) || isnan(lon))
+      return BADCOORDS;
+    long long x, y, d = Divisor(IntPrecision(prec));
+    Indices(lat, lon, x, y);
+    id = (unsigned long long)(y / d) * (-2 * lonorig_ * m / d) + x / d;
+    return OK;
+  }
+
+  Georef::status Georef::Reverse(unsigned long long id, int prec,
+                                 real& lat, real& lon, bool centerp) {
+    long long d = Divisor(IntPrecision(prec));
+    unsigned long long nlon = -2 * lonorig_ * m / d;
+    if (id >= nlon * (-2 * latorig_ * m / d))
+      return BADCELLID;
+    real
+      unit = real(tile_ * m / d),
+      lat1 = real(id / nlon) + latorig_ / tile_ * unit,
+      lon1 = real(id % nlon) + lonorig_ / tile_ * unit;
     if (centerp) {
       unit *= 2; lat1 = 2 * lat1 + 1; lon1 = 2 * lon1 + 1;
     }
     lat = (tile_ * lat1) / unit;
     lon = (tile_ * lon1) / unit;
+    return OK;
+  }
+
+  size_t Georef::ForwardBatch(size_t n, const real lat[], const real lon[],
+                              int prec, unsigned long long id[],
+                              status stat[]) {
+    size_t nbad = 0;
+    for (size_t i = 0; i < n; ++i) {
+      status st = Forward(lat[i], lon[i], prec, id[i]);
+      if (st != OK) {
+        ++nbad;
+        id[i] = ~0ULL;
+      }
+      if (stat) stat[i] = st;
+    }
+    return nbad;
+  }
+
+  size_t Georef::ReverseBatch(size_t n, const unsigned long long id[],
+                              int prec, real lat[], real lon[], bool centerp,
+                              status stat[]) {
+    size_t nbad = 0;
+    for (size_t i = 0; i < n; ++i) {
+      status st = Reverse(id[i], prec, lat[i], lon[i], centerp);
+      if (st != OK) {
+        ++nbad;
+        lat[i] = lon[i] = Math::NaN();
+      }
+      if (stat) stat[i] = st;
+    }
+    return nbad;
+  }
+
+  Georef::status Georef::CellId(const char* georef, size_t len,
+                                unsigned long long& id, int& prec) {
+    if (len > size_t(maxlen_)) return BADSTRING;
+    long long x, y;
+    int prec1;
+    status st = ParseChars(georef, int(len), x, y, prec1, false);
+    if (st != OK) return st;
+    if (prec1 > maxintprec_) return BADPRECISION;
+    id = (unsigned long long)y * (-2 * lonorig_ * m / Divisor(prec1)) + x;
     prec = prec1;
+    return OK;
+  }
+
+  Georef::status Georef::CellString(unsigned long long id, int prec,
+                                    char georef[], size_t size) {
+    prec = IntPrecision(prec);
+    long long d = Divisor(prec);
+    unsigned long long nlon = -2 * lonorig_ * m / d;
+    if (id >= nlon * (-2 * latorig_ * m / d))
+      return BADCELLID;
+    if (size < size_t(baselen_ + 2 * prec) + 1)
+      return BUFFERTOOSMALL;
+    Chars((long long)(id % nlon) * d, (long long)(id / nlon) * d, prec,
+          georef);
+    georef[baselen_ + 2 * prec] = '\0';
+    return OK;
+  }
+
+  Georef::status Georef::Adjacent(unsigned long long id, int prec,
+                                  int dlat, int dlon,
+                                  unsigned long long& adj) {
+    long long d = Divisor(IntPrecision(prec)),
+      nlon = -2 * lonorig_ * m / d, nlat = -2 * latorig_ * m / d;
+    if (id >= (unsigned long long)nlon * (unsigned long long)nlat)
+      return BADCELLID;
+    long long
+      y = (long long)(id / nlon) + dlat,
+      x = ((long long)(id % nlon) + dlon) % nlon;
+    if (y < 0 || y >= nlat)
+      return BADLATITUDE;
+    if (x < 0) x += nlon;
+    adj = (unsigned long long)y * nlon + x;
+    return OK;
+  }
+
+  int Georef::Neighbors(unsigned long long id, int prec,
+                        unsigned long long nbr[8]) {
+    static const int dlat[] = { 1, 1, 0, -1, -1, -1,  0,  1 };
+    static const int dlon[] = { 0, 1, 1,  1,  0, -1, -1, -1 };
+    int k = 0;
+    for (int i = 0; i < 8; ++i)
+      if (Adjacent(id, prec, dlat[i], dlon[i], nbr[k]) == OK)
+        ++k;
+    return k;
   }
 
 } // namespace GeographicLib
@@ -8,6 +8,7 @@
  **********************************************************************/
 
 #include <GeographicLib/Gnomonic.hpp>
+#include <GeographicLib/GeodesicOrigin.hpp>
 
 #if defined(_MSC_VER)
 // Squelch warnings about potentially uninitialized local variables and
@@ -46,10 +47,13 @@ namespace GeographicLib {
 
   void Gnomonic::Reverse(real lat0, real lon0, real x, real y,
                          real& lat, real& lon, real& azi, real& rk) const {
-    real
-      azi0 = Math::atan2d(x, y),
-      rho = hypot(x, y),
-      s = _a * atan(rho/_a);
+    IntReverse(lat0, lon0, Math::atan2d(x, y), hypot(x, y),
+               lat, lon, azi, rk);
+  }
+
+  void Gnomonic::IntReverse(real lat0, real lon0, real azi0, real rho,
+                            real& lat, real& lon, real& azi, real& rk) const {
+    real s = _a * atan(rho/_a);
     bool little = rho <= _a;
     if (!little)
       rho = 1/rho;
@@ -80,4 +84,51 @@ namespace GeographicLib {
     return;
   }
 
+  void Gnomonic::ForwardBatch(size_t n, real lat0, real lon0,
+                              const real lat[], const real lon[],
+                              real x[], real y[],
+                              real azi[], real rk[]) const {
+    GeodesicOrigin origin(_earth, lat0, lon0);
+    real azi0[projblock_], azi2[projblock_], m[projblock_], M[projblock_],
+      t[projblock_], sx[projblock_], cx[projblock_];
+    for (size_t i0 = 0; i0 < n; i0 += projblock_) {
+      size_t k = n - i0 < projblock_ ? n - i0 : projblock_;
+      origin.InverseBatch(k, lat + i0, lon + i0,
+                          Geodesic::AZIMUTH | Geodesic::REDUCEDLENGTH |
+                          Geodesic::GEODESICSCALE,
+                          t, azi0, azi2, m, M, t, t);
+      Math::sincosdBatch(k, azi0, sx, cx);
+      for (size_t i = 0; i < k; ++i) {
+        if (M[i] <= 0)
+          x[i0 + i] = y[i0 + i] = Math::NaN();
+        else {
+          real rho = m[i]/M[i];
+          x[i0 + i] = sx[i] * rho; y[i0 + i] = cx[i] * rho;
+        }
+        if (azi) azi[i0 + i] = azi2[i];
+        if (rk) rk[i0 + i] = M[i];
+      }
+    }
+  }
+
+  void Gnomonic::ReverseBatch(size_t n, real lat0, real lon0,
+                              const real x[], const real y[],
+                              real lat[], real lon[],
+                              real azi[], real rk[]) const {
+    real azi0[projblock_], rho[projblock_];
+    for (size_t i0 = 0; i0 < n; i0 += projblock_) {
+      size_t k = n - i0 < projblock_ ? n - i0 : projblock_;
+      for (size_t i = 0; i < k; ++i)
+        rho[i] = hypot(x[i0 + i], y[i0 + i]);
+      Math::atan2dBatch(k, x + i0, y + i0, azi0);
+      for (size_t i = 0; i < k; ++i) {
+        real azii, rki;
+        IntReverse(lat0, lon0, azi0[i], rho[i],
+                   lat[i0 + i], lon[i0 + i], azii, rki);
+        if (azi) azi[i0 + i] = azii;
+        if (rk) rk[i0 + i] = rki;
+      }
+    }
+  }
+
 } // namespace GeographicLib
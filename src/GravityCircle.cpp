@@ -10,43 +10,38 @@
 #include <GeographicLib/GravityCircle.hpp>
 #include <fstream>
 #include <sstream>
+#include <vector>
 #include <GeographicLib/Geocentric.hpp>
 
 namespace GeographicLib {
 
   using namespace std;
 
-  GravityCircle::GravityCircle(mask caps, real a, real f, real lat, real h,
-                               real Z, real P, real cphi, real sphi,
-                               real amodel, real GMmodel,
-                               real dzonal0, real corrmult,
-                               real gamma0, real gamma, real frot,
-                               const CircularEngine& gravitational,
-                               const CircularEngine& disturbing,
-                               const CircularEngine& correction)
-    : _caps(caps)
-    , _a(a)
-    , _f(f)
-    , _lat(Math::LatFix(lat))
-    , _h(h)
-    , _Z(Z)
-    , _Px(P)
-    , _invR(1 / hypot(_Px, _Z))
-    , _cpsi(_Px * _invR)
-    , _spsi(_Z * _invR)
-    , _cphi(cphi)
-    , _sphi(sphi)
-    , _amodel(amodel)
-    , _GMmodel(GMmodel)
-    , _dzonal0(dzonal0)
-    , _corrmult(corrmult)
-    , _gamma0(gamma0)
-    , _gamma(gamma)
-    , _frot(frot)
-    , _gravitational(gravitational)
-    , _disturbing(disturbing)
-    , _correction(correction)
-    {}
+  void GravityCircle::Reset(mask caps, real a, real f, real lat, real h,
+                            real Z, real P, real cphi, real sphi,
+                            real amodel, real GMmodel,
+                            real dzonal0, real corrmult,
+                            real gamma0, real gamma, real frot) {
+    _caps = caps;
+    _a = a;
+    _f = f;
+    _lat = Math::LatFix(lat);
+    _h = h;
+    _Z = Z;
+    _Px = P;
+    _invR = 1 / hypot(_Px, _Z);
+    _cpsi = _Px * _invR;
+    _spsi = _Z * _invR;
+    _cphi = cphi;
+    _sphi = sphi;
+    _amodel = amodel;
+    _GMmodel = GMmodel;
+    _dzonal0 = dzonal0;
+    _corrmult = corrmult;
+    _gamma0 = gamma0;
+    _gamma = gamma;
+    _frot = frot;
+  }
 
   Math::real GravityCircle::Gravity(real lon,
                                     real& gx, real& gy, real& gz) const {
@@ -99,6 +94,111 @@ namespace GeographicLib {
     eta = -(deltax/_gamma) / Math::degree();
   }
 
+  void GravityCircle::GeoidHeight(size_t n, const real lon[], real N[])
+    const {
+    if ((_caps & GEOID_HEIGHT) != GEOID_HEIGHT) {
+      for (size_t i = 0; i < n; ++i) N[i] = Math::NaN();
+      return;
+    }
+    real slam[blk_], clam[blk_], T[blk_], correction[blk_];
+    for (size_t i0 = 0; i0 < n; i0 += blk_) {
+      int k = int(min(n - i0, size_t(blk_)));
+      for (int j = 0; j < k; ++j)
+        Math::sincosd(lon[i0 + j], slam[j], clam[j]);
+      _disturbing.Evaluate(k, slam, clam, T);
+      _correction.Evaluate(k, slam, clam, correction);
+      // This mirrors InternalT with gradp = correct = false
+      for (int j = 0; j < k; ++j)
+        N[i0 + j] = (T[j] / _amodel * _GMmodel) / _gamma0 +
+          _corrmult * correction[j];
+    }
+  }
+
+  void GravityCircle::SphericalAnomaly(size_t n, const real lon[],
+                                       real Dg01[], real xi[], real eta[])
+    const {
+    if ((_caps & SPHERICAL_ANOMALY) != SPHERICAL_ANOMALY) {
+      for (size_t i = 0; i < n; ++i) {
+        Dg01[i] = Math::NaN();
+        if (xi) xi[i] = Math::NaN();
+        if (eta) eta[i] = Math::NaN();
+      }
+      return;
+    }
+    real slam[blk_], clam[blk_], T[blk_],
+      deltaX[blk_], deltaY[blk_], deltaZ[blk_],
+      f = _GMmodel / _amodel;
+    for (size_t i0 = 0; i0 < n; i0 += blk_) {
+      int k = int(min(n - i0, size_t(blk_)));
+      for (int j = 0; j < k; ++j)
+        Math::sincosd(lon[i0 + j], slam[j], clam[j]);
+      _disturbing.Evaluate(k, slam, clam, T, deltaX, deltaY, deltaZ);
+      for (int j = 0; j < k; ++j) {
+        // This mirrors InternalT with gradp = true, correct = false, and the
+        // rest of SphericalAnomaly(real, real&, real&, real&).
+        real
+          Tj = T[j] / _amodel * _GMmodel,
+          deltax = deltaX[j] * f, deltay = deltaY[j] * f,
+          deltaz = deltaZ[j] * f,
+          MC[Geocentric::dim2_];
+        Geocentric::Rotation(_spsi, _cpsi, slam[j], clam[j], MC);
+        Geocentric::Unrotate(MC, deltax, deltay, deltaz,
+                             deltax, deltay, deltaz);
+        Dg01[i0 + j] = - deltaz - 2 * Tj * _invR;
+        if (xi) xi[i0 + j] = -(deltay/_gamma) / Math::degree();
+        if (eta) eta[i0 + j] = -(deltax/_gamma) / Math::degree();
+      }
+    }
+  }
+
+  void GravityCircle::GeoidHeightGrid(real lon0, real dlon, size_t n,
+                                      real N[]) const {
+    if ((_caps & GEOID_HEIGHT) != GEOID_HEIGHT) {
+      for (size_t i = 0; i < n; ++i) N[i] = Math::NaN();
+      return;
+    }
+    vector<real> correction(n);
+    _disturbing.EvaluateGrid(lon0, dlon, n, N);
+    _correction.EvaluateGrid(lon0, dlon, n, correction.data());
+    // This mirrors InternalT with gradp = correct = false
+    for (size_t i = 0; i < n; ++i)
+      N[i] = (N[i] / _amodel * _GMmodel) / _gamma0 +
+        _corrmult * correction[i];
+  }
+
+  void GravityCircle::SphericalAnomalyGrid(real lon0, real dlon, size_t n,
+                                           real Dg01[], real xi[], real eta[])
+    const {
+    if ((_caps & SPHERICAL_ANOMALY) != SPHERICAL_ANOMALY) {
+      for (size_t i = 0; i < n; ++i) {
+        Dg01[i] = Math::NaN();
+        if (xi) xi[i] = Math::NaN();
+        if (eta) eta[i] = Math::NaN();
+      }
+      return;
+    }
+    vector<real> deltaX(n), deltaY(n), deltaZ(n);
+    real f = _GMmodel / _amodel;
+    // Dg01 holds T until it's overwritten.
+    _disturbing.EvaluateGrid(lon0, dlon, n, Dg01,
+                             deltaX.data(), deltaY.data(), deltaZ.data());
+    for (size_t i = 0; i < n; ++i) {
+      // This mirrors SphericalAnomaly(size_t, const real[], ...)
+      real
+        T = Dg01[i] / _amodel * _GMmodel,
+        deltax = deltaX[i] * f, deltay = deltaY[i] * f,
+        deltaz = deltaZ[i] * f,
+        slam, clam, MC[Geocentric::dim2_];
+      Math::sincosd(lon0 + real(i) * dlon, slam, clam);
+      Geocentric::Rotation(_spsi, _cpsi, slam, clam, MC);
+      Geocentric::Unrotate(MC, deltax, deltay, deltaz,
+                           deltax, deltay, deltaz);
+      Dg01[i] = - deltaz - 2 * T * _invR;
+      if (xi) xi[i] = -(deltay/_gamma) / Math::degree();
+      if (eta) eta[i] = -(deltax/_gamma) / Math::degree();
+    }
+  }
+
   Math::real GravityCircle::W(real slam, real clam,
                               real& gX, real& gY, real& gZ) const {
     real Wres = V(slam, clam, gX, gY, gZ) + _frot * _Px / 2;
@@ -9,10 +9,15 @@
 
 #include <GeographicLib/GravityModel.hpp>
 #include <fstream>
+#include <chrono>
 #include <limits>
+#include <algorithm>
+#include <mutex>
 #include <GeographicLib/SphericalEngine.hpp>
 #include <GeographicLib/GravityCircle.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <GeographicLib/Trace.hpp>
 
 #if !defined(GEOGRAPHICLIB_DATA)
 #  if defined(_WIN32)
@@ -36,7 +41,7 @@ namespace GeographicLib {
   using namespace std;
 
   GravityModel::GravityModel(const std::string& name, const std::string& path,
-                             int Nmax, int Mmax)
+                             int Nmax, int Mmax, bool mapped, bool single)
     : _name(name)
     , _dir(path)
     , _description("NONE")
@@ -49,6 +54,7 @@ namespace GeographicLib {
     , _mmx(-1)
     , _norm(SphericalHarmonic::FULL)
   {
+    GEOGRAPHICLIB_TRACE_SCOPE1(gravity__load, name.c_str());
     if (_dir.empty())
       _dir = DefaultGravityPath();
     bool truncate = Nmax >= 0 || Mmax >= 0;
@@ -57,41 +63,155 @@ namespace GeographicLib {
       if (Nmax < 0) Nmax = numeric_limits<int>::max();
       if (Mmax < 0) Mmax = numeric_limits<int>::max();
     }
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
     ReadMetadata(_name);
+    shared_ptr<coeffstore> store = make_shared<coeffstore>();
+    coeffstore& st = *store;
     {
       string coeff = _filename + ".cof";
-      ifstream coeffstr(coeff.c_str(), ios::binary);
-      if (!coeffstr.good())
-        throw GeographicErr("Error opening " + coeff);
-      char id[idlength_ + 1];
-      coeffstr.read(id, idlength_);
-      if (!coeffstr.good())
-        throw GeographicErr("No header in " + coeff);
-      id[idlength_] = '\0';
-      if (_id != string(id))
-        throw GeographicErr("ID mismatch: " + _id + " vs " + id);
-      int N, M;
-      if (truncate) { N = Nmax; M = Mmax; }
-      SphericalEngine::coeff::readcoeffs(coeffstr, N, M, _Cx, _Sx, truncate);
-      if (!(N >= 0 && M >= 0))
-        throw GeographicErr("Degree and order must be at least 0");
-      if (_Cx[0] != 0)
-        throw GeographicErr("The degree 0 term should be zero");
-      _Cx[0] = 1;               // Include the 1/r term in the sum
-      _gravitational = SphericalHarmonic(_Cx, _Sx, N, N, M, _amodel, _norm);
-      if (truncate) { N = Nmax; M = Mmax; }
-      SphericalEngine::coeff::readcoeffs(coeffstr, N, M, _CC, _CS, truncate);
-      if (N < 0) {
-        N = M = 0;
-        _CC.resize(1, real(0));
+      if (mapped && SphericalEngine::mappedfile::Supported()) {
+        st.map.Map(coeff);
+        char* data = st.map.data();
+        size_t pos = idlength_;
+        if (st.map.size() < pos)
+          throw GeographicErr("No header in " + coeff);
+        if (_id != string(data, idlength_))
+          throw GeographicErr("ID mismatch: " + _id + " vs " +
+                              string(data, idlength_));
+        if (truncate && !(Nmax >= Mmax && Mmax >= 0))
+          throw GeographicErr("Bad requested degree and order " +
+                              Utility::str(Nmax) + " " + Utility::str(Mmax));
+        int N0, M0;
+        real *C, *S;
+        SphericalEngine::coeff::mapcoeffs(data, st.map.size(), pos, N0, M0,
+                                          C, S);
+        int
+          N = truncate ? min(Nmax, N0) : N0,
+          M = truncate ? min(Mmax, M0) : M0;
+        if (!(N >= 0 && M >= 0))
+          throw GeographicErr("Degree and order must be at least 0");
+        if (C[0] != 0)
+          throw GeographicErr("The degree 0 term should be zero");
+        C[0] = 1;               // Include the 1/r term in the sum
+        _gravitational = SphericalHarmonic(SphericalEngine::coeff(C, S,
+                                                                  N0, N, M),
+                                           _amodel, _norm);
+        SphericalEngine::coeff::mapcoeffs(data, st.map.size(), pos, N0, M0,
+                                          C, S);
+        N = truncate ? min(Nmax, N0) : N0; M = truncate ? min(Mmax, M0) : M0;
+        if (N < 0) {
+          N0 = N = M = 0;
+          st.CC.resize(1, real(0));
+          C = st.CC.data(); S = nullptr;
+        }
+        C[0] += _zeta0 / _corrmult;
+        _correction = SphericalHarmonic(SphericalEngine::coeff(C, S,
+                                                               N0, N, M),
+                                        real(1), _norm);
+        if (pos != st.map.size())
+          throw GeographicErr("Extra data in " + coeff);
+        _loadbytes = (unsigned long long)(pos);
+      } else {
+        ifstream coeffstr(coeff.c_str(), ios::binary);
+        if (!coeffstr.good())
+          throw GeographicErr("Error opening " + coeff);
+        char id[idlength_ + 1];
+        coeffstr.read(id, idlength_);
+        if (!coeffstr.good())
+          throw GeographicErr("No header in " + coeff);
+        id[idlength_] = '\0';
+        if (_id != string(id))
+          throw GeographicErr("ID mismatch: " + _id + " vs " + id);
+        int N, M;
+        if (truncate) { N = Nmax; M = Mmax; }
+        SphericalEngine::coeff::readcoeffs(coeffstr, N, M, st.Cx, st.Sx,
+                                           truncate);
+        if (!(N >= 0 && M >= 0))
+          throw GeographicErr("Degree and order must be at least 0");
+        if (st.Cx[0] != 0)
+          throw GeographicErr("The degree 0 term should be zero");
+        st.Cx[0] = 1;            // Include the 1/r term in the sum
+        if (single) {
+          st.Cxf.assign(st.Cx.begin(), st.Cx.end());
+          st.Sxf.assign(st.Sx.begin(), st.Sx.end());
+          // Release the memory for the real coefficients
+          vector<real>().swap(st.Cx); vector<real>().swap(st.Sx);
+          _gravitational = SphericalHarmonic(SphericalEngine::coeff
+                                             (st.Cxf.data(), st.Sxf.data(),
+                                              N, N, M),
+                                             _amodel, _norm);
+        } else
+          _gravitational = SphericalHarmonic(st.Cx, st.Sx, N, N, M,
+                                             _amodel, _norm);
+        if (truncate) { N = Nmax; M = Mmax; }
+        SphericalEngine::coeff::readcoeffs(coeffstr, N, M, st.CC, st.CS,
+                                           truncate);
+        if (N < 0) {
+          N = M = 0;
+          st.CC.resize(1, real(0));
+        }
+        st.CC[0] += _zeta0 / _corrmult;
+        _correction = SphericalHarmonic(st.CC, st.CS, N, N, M, real(1), _norm);
+        int pos = int(coeffstr.tellg());
+        coeffstr.seekg(0, ios::end);
+        if (pos != coeffstr.tellg())
+          throw GeographicErr("Extra data in " + coeff);
+        _loadbytes = (unsigned long long)(pos);
       }
-      _CC[0] += _zeta0 / _corrmult;
-      _correction = SphericalHarmonic(_CC, _CS, N, N, M, real(1), _norm);
-      int pos = int(coeffstr.tellg());
-      coeffstr.seekg(0, ios::end);
-      if (pos != coeffstr.tellg())
-        throw GeographicErr("Extra data in " + coeff);
     }
+    _loadtime = chrono::duration<double>
+      (chrono::steady_clock::now() - start).count();
+    _store = store;
+    SetDisturbing();
+  }
+
+  GravityModel::GravityModel(const GravityModel& g, int Nmax, int Mmax)
+    : _name(g._name)
+    , _dir(g._dir)
+    , _description(g._description)
+    , _date(g._date)
+    , _filename(g._filename)
+    , _id(g._id)
+    , _amodel(g._amodel)
+    , _GMmodel(g._GMmodel)
+    , _zeta0(g._zeta0)
+    , _corrmult(g._corrmult)
+    , _nmx(-1)
+    , _mmx(-1)
+    , _norm(g._norm)
+    , _earth(g._earth)
+    , _store(g._store)
+    , _loadbytes(g._loadbytes)
+    , _loadtime(g._loadtime)
+  {
+    if (Nmax >= 0 && Mmax < 0) Mmax = Nmax;
+    if (Nmax < 0) Nmax = numeric_limits<int>::max();
+    if (Mmax < 0) Mmax = numeric_limits<int>::max();
+    if (!(Nmax >= Mmax))
+      throw GeographicErr("Bad requested degree and order " +
+                          Utility::str(Nmax) + " " + Utility::str(Mmax));
+    _gravitational =
+      SphericalHarmonic(g._gravitational.Coefficients().Truncate(Nmax, Mmax),
+                        _amodel, _norm);
+    _correction =
+      SphericalHarmonic(g._correction.Coefficients().Truncate(Nmax, Mmax),
+                        real(1), _norm);
+    SetDisturbing();
+  }
+
+  size_t GravityModel::MemoryUsage() const {
+    const coeffstore& st = *_store;
+    size_t bytes = sizeof(coeffstore) +
+      (st.Cx.capacity() + st.Sx.capacity() + st.CC.capacity() +
+       st.CS.capacity() + _zonal.capacity()) * sizeof(real) +
+      (st.Cxf.capacity() + st.Sxf.capacity()) * sizeof(float) +
+      _circles.MemoryUsage();
+    if (_degvarlazy.init.load(memory_order_acquire))
+      bytes += _degvar.capacity() * sizeof(real);
+    return bytes;
+  }
+
+  void GravityModel::SetDisturbing() {
     int nmx = _gravitational.Coefficients().nmx();
     _nmx = max(nmx, _correction.Coefficients().nmx());
     _mmx = max(_gravitational.Coefficients().mmx(),
@@ -112,7 +232,7 @@ namespace GeographicLib {
       // goes out to n = 18.
       mult *= amult;
       real
-        r = _Cx[n],                                        // the model term
+        r = _gravitational.Coefficients().Cv(n),           // the model term
         s = - mult * _earth.Jn(n) / sqrt(real(2 * n + 1)), // the normal term
         t = r - s;                                         // the difference
       if (t == r)               // the normal term is negligible
@@ -121,16 +241,23 @@ namespace GeographicLib {
       _zonal.push_back(s);
     }
     int nmx1 = int(_zonal.size()) - 1;
-    _disturbing = SphericalHarmonic1(_Cx, _Sx,
-                                     _gravitational.Coefficients().N(),
-                                     nmx, _gravitational.Coefficients().mmx(),
-                                     _zonal,
-                                     _zonal, // This is not accessed!
-                                     nmx1, nmx1, 0,
+    _disturbing = SphericalHarmonic1(_gravitational.Coefficients(),
+                                     SphericalEngine::coeff(_zonal,
+                                                            _zonal, // unused
+                                                            nmx1, nmx1, 0),
                                      _amodel,
                                      SphericalHarmonic1::normalization(_norm));
   }
 
+  future<shared_ptr<GravityModel>>
+  GravityModel::Load(const string& name, const string& path,
+                     int Nmax, int Mmax, bool mapped, bool single) {
+    return async(launch::async, [=]() -> shared_ptr<GravityModel> {
+      return make_shared<GravityModel>(name, path, Nmax, Mmax, mapped,
+                                       single);
+    });
+  }
+
   void GravityModel::ReadMetadata(const string& name) {
     const char* spaces = " \t\n\v\f\r";
     _filename = _dir + "/" + name + ".egm";
@@ -229,10 +356,10 @@ namespace GeographicLib {
       deltaY *= f;
       deltaZ *= f;
       if (correct) {
-        invR = _GMmodel * _dzonal0 * invR * invR * invR;
-        deltaX += X * invR;
-        deltaY += Y * invR;
-        deltaZ += Z * invR;
+        real r3 = _GMmodel * _dzonal0 * invR * invR * invR;
+        deltaX += X * r3;
+        deltaY += Y * r3;
+        deltaZ += Z * r3;
       }
     } else
       T = _disturbing(-1, X, Y, Z);
@@ -261,8 +388,53 @@ namespace GeographicLib {
     return Wres;
   }
 
+  Math::real GravityModel::W(real X, real Y, real Z,
+                             real& gX, real& gY, real& gZ,
+                             real& WXX, real& WXY, real& WXZ,
+                             real& WYY, real& WYZ, real& WZZ) const {
+    real
+      Wres = _gravitational.Hessian(X, Y, Z, gX, gY, gZ,
+                                    WXX, WXY, WXZ, WYY, WYZ, WZZ),
+      f = _GMmodel / _amodel, fX, fY;
+    Wres = f * Wres + _earth.Phi(X, Y, fX, fY);
+    gX = f * gX + fX; gY = f * gY + fY; gZ *= f;
+    WXX *= f; WXY *= f; WXZ *= f; WYY *= f; WYZ *= f; WZZ *= f;
+    // The Hessian of the centrifugal potential
+    real omega2 = Math::sq(_earth.AngularVelocity());
+    WXX += omega2; WYY += omega2;
+    return Wres;
+  }
+
+  void GravityModel::WColumn(real X, real Y, real Z,
+                             size_t n, const real r[], real W[],
+                             real gX[], real gY[], real gZ[]) const {
+    bool gradp = gX && gY && gZ;
+    RadialEngine rad = _gravitational.Radial(X, Y, Z, gradp);
+    real
+      f = _GMmodel / _amodel,
+      R = hypot(hypot(X, Y), Z);
+    for (size_t i = 0; i < n; ++i) {
+      // The point on the ray at radius r[i]
+      real s = R != 0 ? r[i] / R : 0, fX, fY;
+      W[i] = _earth.Phi(s * X, s * Y, fX, fY);
+      if (gradp) {
+        real GX, GY, GZ;
+        W[i] += f * rad(r[i], GX, GY, GZ);
+        gX[i] = f * GX + fX;
+        gY[i] = f * GY + fY;
+        gZ[i] = f * GZ;
+      } else
+        W[i] += f * rad(r[i]);
+    }
+  }
+
   void GravityModel::SphericalAnomaly(real lat, real lon, real h,
                                       real& Dg01, real& xi, real& eta) const {
+    if (_circles.Capacity()) {
+      CachedCircle(lat, h, SPHERICAL_ANOMALY)->
+        SphericalAnomaly(lon, Dg01, xi, eta);
+      return;
+    }
     real X, Y, Z, M[Geocentric::dim2_];
     _earth.Earth().IntForward(lat, lon, h, X, Y, Z, M);
     real
@@ -287,8 +459,39 @@ namespace GeographicLib {
     eta = -(deltax/gamma) / Math::degree();
   }
 
+  void GravityModel::Deflection(real lat, real lon, real h,
+                                real& xi, real& eta) const {
+    if (_circles.Capacity()) {
+      real Dg01;
+      CachedCircle(lat, h, SPHERICAL_ANOMALY)->
+        SphericalAnomaly(lon, Dg01, xi, eta);
+      return;
+    }
+    real X, Y, Z;
+    _earth.Earth().IntForward(lat, lon, h, X, Y, Z, NULL);
+    if (X == 0 && Y == 0) {
+      // At a pole, the spherical frame of SphericalEngine::Horizontal is for
+      // lon = 0; use SphericalAnomaly which gets the frame from lon.
+      real Dg01;
+      SphericalAnomaly(lat, lon, h, Dg01, xi, eta);
+      return;
+    }
+    // This mirrors SphericalAnomaly with the radial components dropped.  The
+    // horizontal gradient is given directly in spherical coordinates.
+    real deltax, deltay, f = _GMmodel / _amodel;
+    _disturbing.Horizontal(-1, X, Y, Z, deltax, deltay);
+    deltax *= f; deltay *= f;
+    real gammaX, gammaY, gammaZ;
+    _earth.U(X, Y, Z, gammaX, gammaY, gammaZ);
+    real gamma = hypot( hypot(gammaX, gammaY), gammaZ);
+    xi  = -(deltay/gamma) / Math::degree();
+    eta = -(deltax/gamma) / Math::degree();
+  }
+
   Math::real GravityModel::GeoidHeight(real lat, real lon) const
   {
+    if (_circles.Capacity())
+      return CachedCircle(lat, 0, GEOID_HEIGHT)->GeoidHeight(lon);
     real X, Y, Z;
     _earth.Earth().IntForward(lat, lon, 0, X, Y, Z, NULL);
     real
@@ -303,15 +506,48 @@ namespace GeographicLib {
 
   Math::real GravityModel::Gravity(real lat, real lon, real h,
                                    real& gx, real& gy, real& gz) const {
+    if (_circles.Capacity())
+      return CachedCircle(lat, h, GRAVITY)->Gravity(lon, gx, gy, gz);
     real X, Y, Z, M[Geocentric::dim2_];
     _earth.Earth().IntForward(lat, lon, h, X, Y, Z, M);
     real Wres = W(X, Y, Z, gx, gy, gz);
     Geocentric::Unrotate(M, gx, gy, gz, gx, gy, gz);
     return Wres;
   }
+  Math::real GravityModel::GravityGradient(real lat, real lon, real h,
+                                           real& gx, real& gy, real& gz,
+                                           real& Wxx, real& Wxy, real& Wxz,
+                                           real& Wyy, real& Wyz, real& Wzz)
+    const {
+    real X, Y, Z, M[Geocentric::dim2_], H[3][3];
+    _earth.Earth().IntForward(lat, lon, h, X, Y, Z, M);
+    real Wres = W(X, Y, Z, gx, gy, gz,
+                  H[0][0], H[0][1], H[0][2], H[1][1], H[1][2], H[2][2]);
+    for (int i = 0; i < 3; ++i)
+      for (int j = i + 1; j < 3; ++j)
+        H[j][i] = H[i][j];
+    Geocentric::Unrotate(M, gx, gy, gz, gx, gy, gz);
+    // Transform to the local frame, M^T * H * M
+    real L[3][3];
+    for (int i = 0; i < 3; ++i)
+      for (int j = i; j < 3; ++j) {
+        real s = 0;
+        for (int k = 0; k < 3; ++k)
+          for (int l = 0; l < 3; ++l)
+            s += M[3 * k + i] * H[k][l] * M[3 * l + j];
+        L[i][j] = s;
+      }
+    Wxx = L[0][0]; Wxy = L[0][1]; Wxz = L[0][2];
+    Wyy = L[1][1]; Wyz = L[1][2]; Wzz = L[2][2];
+    return Wres;
+  }
+
   Math::real GravityModel::Disturbance(real lat, real lon, real h,
                                        real& deltax, real& deltay,
                                        real& deltaz) const {
+    if (_circles.Capacity())
+      return CachedCircle(lat, h, DISTURBANCE)->
+        Disturbance(lon, deltax, deltay, deltaz);
     real X, Y, Z, M[Geocentric::dim2_];
     _earth.Earth().IntForward(lat, lon, h, X, Y, Z, M);
     real Tres = InternalT(X, Y, Z, deltax, deltay, deltaz, true, true);
@@ -319,7 +555,174 @@ namespace GeographicLib {
     return Tres;
   }
 
-  GravityCircle GravityModel::Circle(real lat, real h, unsigned caps) const {
+  shared_ptr<const GravityCircle>
+  GravityModel::CachedCircle(real lat, real h, unsigned caps) const {
+    return _circles.Get(lat, h, 0, caps,
+                        [this, caps](real lat1, real h1) -> GravityCircle
+                        { return Circle(lat1, h1, caps); });
+  }
+
+  template<class F, class C>
+  void GravityModel::GenBatch(size_t n, const real lat[], const real h[],
+                              unsigned caps, F point, C circle) const {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "GravityModel::GenBatch", n);
+    // Sort the points by (lat, h) so that points on the same circle are
+    // adjacent.  Points with lat or h = NaN are evaluated directly (they would
+    // break the ordering).
+    vector<size_t> ind;
+    ind.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      if (isnan(lat[i]) || (h && isnan(h[i])))
+        point(i);
+      else
+        ind.push_back(i);
+    }
+    sort(ind.begin(), ind.end(),
+         [lat, h](size_t i, size_t j) -> bool
+         { return lat[i] < lat[j] ||
+             (h && lat[i] == lat[j] && h[i] < h[j]); });
+    // The storage of the circle is reused for each group of points
+    GravityCircle c;
+    for (size_t k0 = 0, k1; k0 < ind.size(); k0 = k1) {
+      size_t i0 = ind[k0];
+      for (k1 = k0 + 1;
+           k1 < ind.size() && lat[ind[k1]] == lat[i0] &&
+             !(h && h[ind[k1]] != h[i0]);
+           ++k1) {}
+      if (k1 - k0 < 2)
+        // A circle costs about as much to set up as a direct evaluation
+        point(i0);
+      else {
+        Circle(c, lat[i0], h ? h[i0] : 0, caps);
+        for (size_t k = k0; k < k1; ++k)
+          circle(c, ind[k]);
+      }
+    }
+  }
+
+  void GravityModel::GravityBatch(size_t n, const real lat[], const real lon[],
+                                  const real h[],
+                                  real gx[], real gy[], real gz[],
+                                  real W[]) const {
+    GenBatch(n, lat, h, GRAVITY,
+             [&](size_t i) -> void {
+               real w = Gravity(lat[i], lon[i], h[i], gx[i], gy[i], gz[i]);
+               if (W) W[i] = w;
+             },
+             [&](const GravityCircle& c, size_t i) -> void {
+               real w = c.Gravity(lon[i], gx[i], gy[i], gz[i]);
+               if (W) W[i] = w;
+             });
+  }
+
+  void GravityModel::DisturbanceBatch(size_t n,
+                                      const real lat[], const real lon[],
+                                      const real h[],
+                                      real deltax[], real deltay[],
+                                      real deltaz[], real T[]) const {
+    GenBatch(n, lat, h, DISTURBANCE,
+             [&](size_t i) -> void {
+               real t = Disturbance(lat[i], lon[i], h[i],
+                                    deltax[i], deltay[i], deltaz[i]);
+               if (T) T[i] = t;
+             },
+             [&](const GravityCircle& c, size_t i) -> void {
+               real t = c.Disturbance(lon[i], deltax[i], deltay[i], deltaz[i]);
+               if (T) T[i] = t;
+             });
+  }
+
+  void GravityModel::GeoidHeightBatch(size_t n,
+                                      const real lat[], const real lon[],
+                                      real N[]) const {
+    GenBatch(n, lat, NULL, GEOID_HEIGHT,
+             [&](size_t i) -> void { N[i] = GeoidHeight(lat[i], lon[i]); },
+             [&](const GravityCircle& c, size_t i) -> void
+             { N[i] = c.GeoidHeight(lon[i]); });
+  }
+
+  void GravityModel::DeflectionBatch(size_t n,
+                                     const real lat[], const real lon[],
+                                     const real h[],
+                                     real xi[], real eta[]) const {
+    GenBatch(n, lat, h, SPHERICAL_ANOMALY,
+             [&](size_t i) -> void
+             { Deflection(lat[i], lon[i], h[i], xi[i], eta[i]); },
+             [&](const GravityCircle& c, size_t i) -> void {
+               real Dg01;
+               c.SphericalAnomaly(lon[i], Dg01, xi[i], eta[i]);
+             });
+  }
+
+  template<class F>
+  void GravityModel::GenGrid(int nlat, F row, unsigned threads) {
+    if (nlat <= 0) return;
+    Executor::Parallel(size_t(nlat), threads,
+                       [&](size_t i) -> void { row(int(i)); });
+  }
+
+  void GravityModel::GeoidHeightGrid(real lat0, real dlat, int nlat,
+                                     real lon0, real dlon, int nlon, real N[],
+                                     unsigned threads) const {
+    if (nlon <= 0) return;
+    GenGrid(nlat,
+            [&](int i) -> void {
+              const GravityCircle c(Circle(lat0 + i * dlat, 0, GEOID_HEIGHT));
+              c.GeoidHeightGrid(lon0, dlon, nlon, N + size_t(i) * nlon);
+            }, threads);
+  }
+
+  void GravityModel::SphericalAnomalyGrid(real h, real lat0, real dlat,
+                                          int nlat, real lon0, real dlon,
+                                          int nlon, real Dg01[],
+                                          real xi[], real eta[],
+                                          unsigned threads) const {
+    if (nlon <= 0) return;
+    GenGrid(nlat,
+            [&](int i) -> void {
+              const GravityCircle
+                c(Circle(lat0 + i * dlat, h, SPHERICAL_ANOMALY));
+              size_t k = size_t(i) * nlon;
+              c.SphericalAnomalyGrid(lon0, dlon, nlon, Dg01 + k,
+                                     xi ? xi + k : nullptr,
+                                     eta ? eta + k : nullptr);
+            }, threads);
+  }
+
+  GravityCircle GravityModel::Circle(real lat, real h, unsigned caps,
+                                     unsigned threads,
+                                     int Nmax, int Mmax) const {
+    GravityCircle circ;
+    Circle(circ, lat, h, caps, threads, Nmax, Mmax);
+    return circ;
+  }
+
+  void GravityModel::Circle(GravityCircle& circ, real lat, real h,
+                            unsigned caps, unsigned threads,
+                            int Nmax, int Mmax) const {
+    GEOGRAPHICLIB_TRACE_SCOPE2(gravity__circle, double(lat), double(h));
+    const SphericalHarmonic* gravitational = &_gravitational;
+    const SphericalHarmonic1* disturbing = &_disturbing;
+    const SphericalHarmonic* correction = &_correction;
+    SphericalHarmonic gravitationalt, correctiont;
+    SphericalHarmonic1 disturbingt;
+    if (Nmax >= 0) {
+      // Truncated sums sharing the coefficients of the model
+      if (Mmax < 0) Mmax = Nmax;
+      gravitationalt =
+        SphericalHarmonic(_gravitational.Coefficients().Truncate(Nmax, Mmax),
+                          _amodel, _norm);
+      disturbingt =
+        SphericalHarmonic1(gravitationalt.Coefficients(),
+                           _disturbing.Coefficients1().Truncate(Nmax, 0),
+                           _amodel, SphericalHarmonic1::normalization(_norm));
+      correctiont =
+        SphericalHarmonic(_correction.Coefficients().Truncate(Nmax, Mmax),
+                          real(1), _norm);
+      gravitational = &gravitationalt;
+      disturbing = &disturbingt;
+      correction = &correctiont;
+    }
     if (h != 0)
       // Disallow invoking GeoidHeight unless h is zero.
       caps &= ~(CAP_GAMMA0 | CAP_C);
@@ -337,20 +740,101 @@ namespace GeographicLib {
     } else
       gamma = Math::NaN();
     _earth.Phi(X, Y, fx, fy);
-    return GravityCircle(GravityCircle::mask(caps),
-                         _earth._a, _earth._f, lat, h, Z, X, M[7], M[8],
-                         _amodel, _GMmodel, _dzonal0, _corrmult,
-                         gamma0, gamma, fx,
-                         caps & CAP_G ?
-                         _gravitational.Circle(X, Z, true) :
-                         CircularEngine(),
-                         // N.B. If CAP_DELTA is set then CAP_T should be too.
-                         caps & CAP_T ?
-                         _disturbing.Circle(-1, X, Z, (caps&CAP_DELTA) != 0) :
-                         CircularEngine(),
-                         caps & CAP_C ?
-                         _correction.Circle(invR * X, invR * Z, false) :
-                         CircularEngine());
+    circ.Reset(GravityCircle::mask(caps),
+               _earth._a, _earth._f, lat, h, Z, X, M[7], M[8],
+               _amodel, _GMmodel, _dzonal0, _corrmult,
+               gamma0, gamma, fx);
+    // The CircularEngine objects which aren't needed are cleared; the others
+    // are reinitialized reusing their storage.
+    if (caps & CAP_G)
+      gravitational->Circle(X, Z, true, threads, circ._gravitational);
+    else
+      circ._gravitational = CircularEngine();
+    // N.B. If CAP_DELTA is set then CAP_T should be too.
+    if (caps & CAP_T)
+      disturbing->Circle(-1, X, Z, (caps&CAP_DELTA) != 0, threads,
+                         circ._disturbing);
+    else
+      circ._disturbing = CircularEngine();
+    if (caps & CAP_C)
+      correction->Circle(invR * X, invR * Z, false, threads,
+                         circ._correction);
+    else
+      circ._correction = CircularEngine();
+  }
+
+  const vector<Math::real>& GravityModel::DegreeVariances() const {
+    if (!_degvarlazy.init.load(memory_order_acquire)) {
+      lock_guard<mutex> lock(_degvarlazy.lock);
+      if (!_degvarlazy.init.load(memory_order_relaxed)) {
+        const SphericalEngine::coeff
+          &c = _disturbing.Coefficients(), &c1 = _disturbing.Coefficients1();
+        _degvar.assign(c.nmx() + 1, real(0));
+        // Skip n = 0; this term is handled by _dzonal0.
+        for (int n = 1; n <= c.nmx(); ++n) {
+          real s = 0;
+          for (int m = 0; m <= min(n, c.mmx()); ++m) {
+            int k = c.index(n, m);
+            real C = c.Cv(k);
+            if (m == 0) {
+              if (n <= c1.nmx()) C -= c1.Cv(c1.index(n, m));
+              s += Math::sq(C);
+            } else
+              s += Math::sq(C) + Math::sq(c.Sv(k));
+          }
+          // Convert Schmidt semi-normalized coefficients to full normalization
+          _degvar[n] = _norm == SphericalHarmonic::FULL ? s : s / (2 * n + 1);
+        }
+        _degvarlazy.init.store(true, memory_order_release);
+      }
+    }
+    return _degvar;
+  }
+
+  Math::real GravityModel::DegreeVariance(int n) const {
+    const vector<real>& degvar = DegreeVariances();
+    return n >= 0 && n < int(degvar.size()) ? degvar[n] : 0;
+  }
+
+  Math::real GravityModel::GeoidHeightTruncationError(int Nmax) const {
+    const vector<real>& degvar = DegreeVariances();
+    real s = 0;
+    // Sum the smallest terms first
+    for (int n = int(degvar.size()) - 1; n > max(Nmax, 0); --n)
+      s += degvar[n];
+    return _amodel * sqrt(s);
+  }
+
+  Math::real GravityModel::GravityTruncationError(int Nmax, real h) const {
+    const vector<real>& degvar = DegreeVariances();
+    real r = _amodel + h, q2 = Math::sq(_amodel / r), s = 0;
+    for (int n = int(degvar.size()) - 1; n > max(Nmax, 0); --n)
+      s += Math::sq(real(n + 1)) * pow(q2, n) * degvar[n];
+    return _GMmodel / Math::sq(r) * sqrt(s);
+  }
+
+  int GravityModel::GeoidHeightDegree(real tol) const {
+    const vector<real>& degvar = DegreeVariances();
+    real s = 0, t = Math::sq(tol / _amodel);
+    int n = int(degvar.size()) - 1;
+    // Add terms while the truncation error remains within tolerance
+    for (; n > 0; --n) {
+      s += degvar[n];
+      if (!(s <= t)) break;
+    }
+    return max(n, 0);
+  }
+
+  int GravityModel::GravityDegree(real tol, real h) const {
+    const vector<real>& degvar = DegreeVariances();
+    real r = _amodel + h, q2 = Math::sq(_amodel / r), s = 0,
+      t = Math::sq(tol * Math::sq(r) / _GMmodel);
+    int n = int(degvar.size()) - 1;
+    for (; n > 0; --n) {
+      s += Math::sq(real(n + 1)) * pow(q2, n) * degvar[n];
+      if (!(s <= t)) break;
+    }
+    return max(n, 0);
   }
 
   string GravityModel::DefaultGravityPath() {
@@ -0,0 +1,94 @@
+/**
+ * \file GravityTrajectory.cpp
+ * \brief Implementation for GeographicLib::GravityTrajectory class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/GravityTrajectory.hpp>
+#include <algorithm>
+#include <GeographicLib/GravityModel.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  GravityTrajectory::GravityTrajectory(const GravityModel& grav, real tol)
+    : _grav(&grav)
+    , _tol(tol)
+    , _r(0)
+    , _c(0)
+    , _anchored(false)
+    , _X0()
+    , _W0(0)
+    , _g0()
+    , _H0()
+    , _anchors(0)
+    , _points(0)
+  {
+    if (!(isfinite(_tol) && _tol > 0))
+      throw GeographicErr("Tolerance must be positive");
+  }
+
+  Math::real GravityTrajectory::Extrapolate(const real d[3],
+                                            real& gX, real& gY, real& gZ)
+    const {
+    gX = _g0[0] + _H0[0] * d[0] + _H0[1] * d[1] + _H0[2] * d[2];
+    gY = _g0[1] + _H0[1] * d[0] + _H0[3] * d[1] + _H0[4] * d[2];
+    gZ = _g0[2] + _H0[2] * d[0] + _H0[4] * d[1] + _H0[5] * d[2];
+    // W0 + d . (g0 + g)/2 = W0 + d . g0 + d . H0 . d / 2
+    return _W0 + (d[0] * (_g0[0] + gX) + d[1] * (_g0[1] + gY) +
+                  d[2] * (_g0[2] + gZ)) / 2;
+  }
+
+  Math::real GravityTrajectory::W(real X, real Y, real Z,
+                                  real& gX, real& gY, real& gZ) {
+    ++_points;
+    real d[3] = { X - _X0[0], Y - _X0[1], Z - _X0[2] },
+      dist = _anchored ? hypot(hypot(d[0], d[1]), d[2]) : Math::infinity();
+    if (dist <= _r)
+      return Extrapolate(d, gX, gY, gZ);
+    real H[6],
+      Wres = _grav->W(X, Y, Z, gX, gY, gZ,
+                      H[0], H[1], H[2], H[3], H[4], H[5]);
+    if (!(isfinite(Wres) && isfinite(gX) && isfinite(gY) && isfinite(gZ))) {
+      // Don't anchor at a bad point (e.g., one with a NaN coordinate)
+      _anchored = false;
+      return Wres;
+    }
+    // The third derivative of the central term GM/R
+    real R = hypot(hypot(X, Y), Z),
+      c = 6 * _grav->MassConstant() / Math::sq(Math::sq(R));
+    if (dist <= 2 * _r) {
+      // The error in extrapolating from the previous anchor gives C.  Allow
+      // C to decrease by at most a factor of 4 (and r to increase by at most
+      // a factor of 2) per anchor.
+      real ex, ey, ez;
+      Extrapolate(d, ex, ey, ez);
+      real err = hypot(hypot(ex - gX, ey - gY), ez - gZ);
+      c = fmax(c, fmax(2 * err / Math::sq(dist), _c / 4));
+    } else
+      // The trajectory has jumped; be conservative
+      c = fmax(c, _c);
+    _c = c;
+    _r = sqrt(2 * _tol / _c);
+    _X0[0] = X; _X0[1] = Y; _X0[2] = Z;
+    _W0 = Wres; _g0[0] = gX; _g0[1] = gY; _g0[2] = gZ;
+    copy(H, H + 6, _H0);
+    _anchored = true;
+    ++_anchors;
+    return Wres;
+  }
+
+  Math::real GravityTrajectory::Gravity(real lat, real lon, real h,
+                                        real& gx, real& gy, real& gz) {
+    real X, Y, Z, M[Geocentric::dim2_];
+    _grav->ReferenceEllipsoid().Earth().IntForward(lat, lon, h, X, Y, Z, M);
+    real Wres = W(X, Y, Z, gx, gy, gz);
+    Geocentric::Unrotate(M, gx, gy, gz, gx, gy, gz);
+    return Wres;
+  }
+
+} // namespace GeographicLib
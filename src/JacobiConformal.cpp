@@ -0,0 +1,128 @@
+/**
+ * \file JacobiConformal.cpp
+ * \brief Implementation for GeographicLib::JacobiConformal class
+ *
+ * Copyright (c) Charles Karney (2014-2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/JacobiConformal.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  JacobiConformal::JacobiConformal(real a, real b, real c)
+    : _a(a), _b(b), _c(c)
+    , _ab2((_a - _b) * (_a + _b))
+    , _bc2((_b - _c) * (_b + _c))
+    , _ac2((_a - _c) * (_a + _c))
+    , _ex(_ab2 / _ac2 * Math::sq(_c / _b), -_ab2 / Math::sq(_b),
+          _bc2 / _ac2 * Math::sq(_a / _b), Math::sq(_a / _b))
+    , _ey(_bc2 / _ac2 * Math::sq(_a / _b), +_bc2 / Math::sq(_b),
+          _ab2 / _ac2 * Math::sq(_c / _b), Math::sq(_c / _b))
+  {
+    if (!(isfinite(_a) && _a >= _b && _b >= _c && _c > 0))
+      throw GeographicErr("JacobiConformal: axes are not in order");
+    if (!(_a > _c))
+      throw GeographicErr
+        ("JacobiConformal: use alternate constructor for sphere");
+    Init();
+  }
+
+  JacobiConformal::JacobiConformal(real a, real b, real c, real ab, real bc)
+    : _a(a), _b(b), _c(c)
+    , _ab2(ab * (_a + _b))
+    , _bc2(bc * (_b + _c))
+    , _ac2(_ab2 + _bc2)
+    , _ex(_ab2 / _ac2 * Math::sq(_c / _b),
+          -(_a - _b) * (_a + _b) / Math::sq(_b),
+          _bc2 / _ac2 * Math::sq(_a / _b), Math::sq(_a / _b))
+    , _ey(_bc2 / _ac2 * Math::sq(_a / _b),
+          +(_b - _c) * (_b + _c) / Math::sq(_b),
+          _ab2 / _ac2 * Math::sq(_c / _b), Math::sq(_c / _b))
+  {
+    if (!(isfinite(_a) && _a >= _b && _b >= _c && _c > 0 &&
+          ab >= 0 && bc >= 0))
+      throw GeographicErr("JacobiConformal: axes are not in order");
+    if (!(ab + bc > 0 && isfinite(_ac2)))
+      throw GeographicErr("JacobiConformal: ab + bc must be positive");
+    Init();
+  }
+
+  void JacobiConformal::Init() {
+    _xser = Series(_ex, Math::sq(_a / _b), _b, _a, _cx);
+    _yser = Series(_ey, Math::sq(_c / _b), _b, _c, _cy);
+  }
+
+  bool JacobiConformal::Series(const EllipticFunction& ell, real scale,
+                               real p, real q, vector<real>& c) {
+    // The function is f(ang) = scale * Pi(phi), where tan(phi) = p/q *
+    // tan(ang), and g(ang) = f(ang) - quad * ang/(pi/2) is an odd function
+    // with period pi.  Sample g at ang_j = (pi/2) * j/n for 0 < j < n and
+    // find the coefficients of sin(2k ang) for 0 < k < n with a discrete sine
+    // transform.  Double n until the upper half of the coefficients is
+    // negligible.
+    const real quad = scale * ell.Pi(),
+      tol = 16 * numeric_limits<real>::epsilon() * quad;
+    for (int n = 16; n <= nmax_; n *= 2) {
+      // sint[m] = sin(pi * m/n) for 0 <= m < 2n
+      vector<real> sint(2 * n), g(n, 0);
+      for (int m = 0; m < 2 * n; ++m)
+        sint[m] = sin(Math::pi() * m / n);
+      for (int j = 1; j < n; ++j) {
+        real s, t;
+        Math::sincosd(real(90) * j / n, s, t);
+        s *= p; t *= q; norm(s, t);
+        g[j] = scale * ell.Pi(s, t, ell.Delta(s, t)) - quad * j / n;
+      }
+      c.assign(n - 1, 0);
+      real tail = 0;
+      for (int k = 1; k < n; ++k) {
+        real sum = 0;
+        for (int j = 1; j < n; ++j)
+          sum += g[j] * sint[(k * j) % (2 * n)];
+        c[k - 1] = 2 * sum / n;
+        if (2 * k >= n) tail = max(tail, abs(c[k - 1]));
+      }
+      if (tail <= tol) {
+        while (!c.empty() && abs(c.back()) <= tol) c.pop_back();
+        return true;
+      }
+    }
+    c.clear();
+    return false;
+  }
+
+  void JacobiConformal::Sum(const vector<real>& c, real quad,
+                            size_t n, const real ang[], real res[]) {
+    const int nc = int(c.size());
+    for (size_t i = 0; i < n; ++i) {
+      real a = ang[i], s, t;
+      Math::sincosd(a, s, t);
+      // sin and cos of 2*ang; Clenshaw summation of sum(c[k-1] * sin(2k ang))
+      real s2 = 2 * s * t, ar = 2 * (t - s) * (t + s), b1 = 0, b2 = 0;
+      for (int k = nc; k > 0; --k) {
+        real b0 = ar * b1 - b2 + c[k - 1];
+        b2 = b1; b1 = b0;
+      }
+      res[i] = (quad * a / 90 + s2 * b1) / Math::degree();
+    }
+  }
+
+  void JacobiConformal::x(size_t n, const real omg[], real x[]) const {
+    if (_xser)
+      Sum(_cx, this->x(), n, omg, x);
+    else
+      for (size_t i = 0; i < n; ++i) x[i] = this->x(omg[i]);
+  }
+
+  void JacobiConformal::y(size_t n, const real bet[], real y[]) const {
+    if (_yser)
+      Sum(_cy, this->y(), n, bet, y);
+    else
+      for (size_t i = 0; i < n; ++i) y[i] = this->y(bet[i]);
+  }
+
+} // namespace GeographicLib
@@ -331,7 +331,14 @@ namespace GeographicLib {
   void LambertConformalConic::Forward(real lon0, real lat, real lon,
                                       real& x, real& y,
                                       real& gamma, real& k) const {
-    lon = Math::AngDiff(lon0, lon);
+    real sphi, cphi;
+    Math::sincosd(Math::LatFix(lat) * _sign, sphi, cphi);
+    IntForward(Math::AngDiff(lon0, lon), sphi, cphi, x, y, gamma, k);
+  }
+
+  void LambertConformalConic::IntForward(real lon, real sphi, real cphi,
+                                         real& x, real& y,
+                                         real& gamma, real& k) const {
     // From Snyder, we have
     //
     // theta = n * lambda
@@ -342,8 +349,6 @@ namespace GeographicLib {
     //
     // where nrho0 = n * rho0, drho = rho - rho0
     // and drho is evaluated with divided differences
-    real sphi, cphi;
-    Math::sincosd(Math::LatFix(lat) * _sign, sphi, cphi);
     cphi = max(epsx_, cphi);
     real
       lam = lon * Math::degree(),
@@ -373,6 +378,16 @@ namespace GeographicLib {
   void LambertConformalConic::Reverse(real lon0, real x, real y,
                                       real& lat, real& lon,
                                       real& gamma, real& k) const {
+    real tau, lam;
+    IntReverse(x, y, tau, lam, gamma, k);
+    lat = Math::atand(tau);
+    lon = lam / Math::degree();
+    lon = Math::AngNormalize(lon + Math::AngNormalize(lon0));
+  }
+
+  void LambertConformalConic::IntReverse(real x, real y,
+                                         real& tau, real& lam,
+                                         real& gamma, real& k) const {
     // From Snyder, we have
     //
     //        x = rho * sin(theta)
@@ -427,17 +442,58 @@ namespace GeographicLib {
     gamma = atan2(nx, y1);
     real
       tphi = Math::tauf(tchi, _es),
-      scbet = hyp(_fm * tphi), scchi = hyp(tchi),
-      lam = _n != 0 ? gamma / _n : x / y1;
-    lat = Math::atand(_sign * tphi);
-    lon = lam / Math::degree();
-    lon = Math::AngNormalize(lon + Math::AngNormalize(lon0));
+      scbet = hyp(_fm * tphi), scchi = hyp(tchi);
+    lam = _n != 0 ? gamma / _n : x / y1;
+    tau = _sign * tphi;
     k = _k0 * (scbet/_scbet0) /
       (exp(_nc != 0 ? - (Math::sq(_nc)/(1 + _n)) * dpsi : 0)
        * (tchi >= 0 ? scchi + tchi : 1 / (scchi - tchi)) / (_scchi0 + _tchi0));
     gamma /= _sign * Math::degree();
   }
 
+  void LambertConformalConic::ForwardBatch(size_t n, real lon0,
+                                           const real lat[], const real lon[],
+                                           real x[], real y[],
+                                           real gamma[], real k[]) const {
+    real a[projblock_], s[projblock_], c[projblock_];
+    for (size_t i0 = 0; i0 < n; i0 += projblock_) {
+      size_t m = n - i0 < projblock_ ? n - i0 : projblock_;
+      for (size_t i = 0; i < m; ++i) {
+        a[i] = Math::LatFix(lat[i0 + i]) * _sign;
+        c[i] = lon0;
+      }
+      Math::AngDiffBatch(m, c, lon + i0, c);
+      Math::sincosdBatch(m, a, s, a);
+      for (size_t i = 0; i < m; ++i) {
+        real gammai, ki;
+        IntForward(c[i], s[i], a[i], x[i0 + i], y[i0 + i], gammai, ki);
+        if (gamma) gamma[i0 + i] = gammai;
+        if (k) k[i0 + i] = ki;
+      }
+    }
+  }
+
+  void LambertConformalConic::ReverseBatch(size_t n, real lon0,
+                                           const real x[], const real y[],
+                                           real lat[], real lon[],
+                                           real gamma[], real k[]) const {
+    real t[projblock_], l[projblock_], c[projblock_];
+    lon0 = Math::AngNormalize(lon0);
+    for (size_t i0 = 0; i0 < n; i0 += projblock_) {
+      size_t m = n - i0 < projblock_ ? n - i0 : projblock_;
+      for (size_t i = 0; i < m; ++i) {
+        real gammai, ki;
+        IntReverse(x[i0 + i], y[i0 + i], t[i], l[i], gammai, ki);
+        if (gamma) gamma[i0 + i] = gammai;
+        if (k) k[i0 + i] = ki;
+        c[i] = 1;
+      }
+      Math::atan2dBatch(m, t, c, lat + i0);
+      for (size_t i = 0; i < m; ++i)
+        lon[i0 + i] = Math::AngNormalize(l[i] / Math::degree() + lon0);
+    }
+  }
+
   void LambertConformalConic::SetScale(real lat, real k) {
     if (!(isfinite(k) && k > 0))
       throw GeographicErr("Scale is not positive");
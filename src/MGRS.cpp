@@ -9,6 +9,8 @@
 
 #include <GeographicLib/MGRS.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <GeographicLib/Trace.hpp>
+#include <cstring>
 
 namespace GeographicLib {
 
@@ -25,6 +27,43 @@ namespace GeographicLib {
   const char* const MGRS::upsband_ = "ABYZ";
   const char* const MGRS::digits_ = "0123456789";
 
+  // The position of each character in a set of upper case characters, or -1
+  // if the character is not in the set.  This is a table-driven version of
+  // Utility::lookup (the case of the character is ignored).
+  class MGRS::charindex {
+  private:
+    signed char _ind[256];
+  public:
+    explicit charindex(const char* set) {
+      fill(_ind, _ind + 256, -1);
+      for (int i = 0; set[i]; ++i)
+        _ind[(unsigned char)(set[i])] =
+          _ind[(unsigned char)(tolower(set[i]))] = (signed char)(i);
+    }
+    int operator()(char c) const { return _ind[(unsigned char)(c)]; }
+  };
+
+  struct MGRS::tables {
+    charindex digits, latband, upsband, utmcols[3], utmrow, upscols[4],
+      upsrows[2];
+    tables()
+      : digits(digits_)
+      , latband(latband_)
+      , upsband(upsband_)
+      , utmcols{charindex(utmcols_[0]), charindex(utmcols_[1]),
+                charindex(utmcols_[2])}
+      , utmrow(utmrow_)
+      , upscols{charindex(upscols_[0]), charindex(upscols_[1]),
+                charindex(upscols_[2]), charindex(upscols_[3])}
+      , upsrows{charindex(upsrows_[0]), charindex(upsrows_[1])}
+    {}
+  };
+
+  const MGRS::tables& MGRS::Tables() {
+    static const tables t;
+    return t;
+  }
+
   const int MGRS::mineasting_[] =
     { minupsSind_, minupsNind_, minutmcol_, minutmcol_ };
   const int MGRS::maxeasting_[] =
@@ -36,32 +75,37 @@ namespace GeographicLib {
     { maxupsSind_, maxupsNind_,
       maxutmNrow_ + (maxutmSrow_ - minutmNrow_), maxutmNrow_ };
 
-  void MGRS::Forward(int zone, bool northp, real x, real y, real lat,
-                     int prec, std::string& mgrs) {
+  MGRS::status MGRS::ForwardChars(int zone, bool northp, real x, real y,
+                                  real lat, int prec, char mgrs1[], int& mlen,
+                                  bool throwp) {
     using std::isnan;           // Needed for Centos 7, ubuntu 14
     // The smallest angle s.t., 90 - angeps() < 90 (approx 50e-12 arcsec)
     // 7 = ceil(log_2(90))
     static const real angeps = ldexp(real(1), -(Math::digits() - 7));
     if (zone == UTMUPS::INVALID ||
         isnan(x) || isnan(y) || isnan(lat)) {
-      mgrs = "INVALID";
-      return;
+      static const char* const invalid = "INVALID";
+      mlen = int(strlen(invalid));
+      copy(invalid, invalid + mlen, mgrs1);
+      return OK;
     }
     bool utmp = zone != 0;
-    CheckCoords(utmp, northp, x, y);
-    if (!(zone >= UTMUPS::MINZONE && zone <= UTMUPS::MAXZONE))
+    if (!CheckCoords(utmp, northp, x, y, throwp))
+      return BADCOORDS;
+    if (!(zone >= UTMUPS::MINZONE && zone <= UTMUPS::MAXZONE)) {
+      if (!throwp) return BADZONE;
       throw GeographicErr("Zone " + Utility::str(zone) + " not in [0,60]");
-    if (!(prec >= -1 && prec <= maxprec_))
+    }
+    if (!(prec >= -1 && prec <= maxprec_)) {
+      if (!throwp) return BADPRECISION;
       throw GeographicErr("MGRS precision " + Utility::str(prec)
                           + " not in [-1, "
                           + Utility::str(int(maxprec_)) + "]");
-    // Fixed char array for accumulating string.  Allow space for zone, 3 block
-    // letters, easting + northing.  Don't need to allow for terminating null.
-    char mgrs1[2 + 3 + 2 * maxprec_];
+    }
     int
       zone1 = zone - 1,
-      z = utmp ? 2 : 0,
-      mlen = z + 3 + 2 * prec;
+      z = utmp ? 2 : 0;
+    mlen = z + 3 + 2 * prec;
     if (utmp) {
       mgrs1[0] = digits_[ zone / base_ ];
       mgrs1[1] = digits_[ zone % base_ ];
@@ -90,9 +134,11 @@ namespace GeographicLib {
         iband = abs(lat) > angeps ? LatitudeBand(lat) : (northp ? 0 : -1),
         icol = xh - minutmcol_,
         irow = UTMRow(iband, icol, yh % utmrowperiod_);
-      if (irow != yh - (northp ? minutmNrow_ : maxutmSrow_))
+      if (irow != yh - (northp ? minutmNrow_ : maxutmSrow_)) {
+        if (!throwp) return BADLATITUDE;
         throw GeographicErr("Latitude " + Utility::str(lat)
                             + " is inconsistent with UTM coordinates");
+      }
       mgrs1[z++] = latband_[10 + iband];
       mgrs1[z++] = utmcols_[zone1 % 3][icol];
       mgrs1[z++] = utmrow_[(yh + (zone1 & 1 ? utmevenrowshift_ : 0))
@@ -115,12 +161,33 @@ namespace GeographicLib {
         mgrs1[z + c + prec] = digits_[iy % base_]; iy /= base_;
       }
     }
+    return OK;
+  }
+
+  void MGRS::Forward(int zone, bool northp, real x, real y, real lat,
+                     int prec, std::string& mgrs) {
+    char mgrs1[maxlen_];
+    int mlen;
+    ForwardChars(zone, northp, x, y, lat, prec, mgrs1, mlen, true);
     mgrs.resize(mlen);
     copy(mgrs1, mgrs1 + mlen, mgrs.begin());
   }
 
-  void MGRS::Forward(int zone, bool northp, real x, real y,
-                     int prec, std::string& mgrs) {
+  MGRS::status MGRS::Forward(int zone, bool northp, real x, real y,
+                             real lat, int prec, char mgrs[], size_t size) {
+    char mgrs1[maxlen_];
+    int mlen;
+    status stat = ForwardChars(zone, northp, x, y, lat, prec, mgrs1, mlen,
+                               false);
+    if (stat != OK) return stat;
+    if (!(size_t(mlen) < size)) return BUFFERTOOSMALL;
+    copy(mgrs1, mgrs1 + mlen, mgrs);
+    mgrs[mlen] = '\0';
+    return OK;
+  }
+
+  Math::real MGRS::ApproxLatitude(int zone, bool northp, real x, real y,
+                                  bool throwp) {
     real lat, lon;
     if (zone > 0) {
       // Does a rough estimate for latitude determine the latitude band?
@@ -145,21 +212,61 @@ namespace GeographicLib {
         if (LatitudeBand(latp) == LatitudeBand(late))
           lat = latp;
         else
-          // bounds straddle a band boundary so need to compute lat accurately
-          UTMUPS::Reverse(zone, northp, x, y, lat, lon);
+          // bounds straddle a band boundary so need to compute lat accurately;
+          // without throwp, lat = NaN if x or y is out of range.
+          if (throwp)
+            UTMUPS::Reverse(zone, northp, x, y, lat, lon);
+          else
+            UTMUPS::ReverseBatch(1, &zone, &northp, &x, &y, &lat, &lon);
       }
     } else
       // Latitude isn't needed for UPS specs or for INVALID
       lat = 0;
-    Forward(zone, northp, x, y, lat, prec, mgrs);
+    return lat;
   }
 
-  void MGRS::Reverse(const string& mgrs,
-                     int& zone, bool& northp, real& x, real& y,
-                     int& prec, bool centerp) {
-    int
-      p = 0,
-      len = int(mgrs.length());
+  void MGRS::Forward(int zone, bool northp, real x, real y,
+                     int prec, std::string& mgrs) {
+    Forward(zone, northp, x, y, ApproxLatitude(zone, northp, x, y, true),
+            prec, mgrs);
+  }
+
+  MGRS::status MGRS::Forward(int zone, bool northp, real x, real y,
+                             int prec, char mgrs[], size_t size) {
+    using std::isnan;
+    real lat = ApproxLatitude(zone, northp, x, y, false);
+    if (isnan(lat) && !(isnan(x) || isnan(y)))
+      return zone >= UTMUPS::MINZONE && zone <= UTMUPS::MAXZONE ?
+        BADCOORDS : BADZONE;
+    return Forward(zone, northp, x, y, lat, prec, mgrs, size);
+  }
+
+  size_t MGRS::ForwardBatch(size_t n, const int zone[], const bool northp[],
+                            const real x[], const real y[], int prec,
+                            char mgrs[], size_t stride, status stat[]) {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "MGRS::ForwardBatch", n);
+    size_t nbad = 0;
+    for (size_t i = 0; i < n; ++i) {
+      char* mgrsi = mgrs + i * stride;
+      status st = Forward(zone[i], northp[i], x[i], y[i], prec,
+                          mgrsi, stride);
+      if (st != OK) {
+        ++nbad;
+        if (stride > 0) mgrsi[0] = '\0';
+      }
+      if (stat) stat[i] = st;
+    }
+    return nbad;
+  }
+
+  MGRS::status MGRS::ReverseChars(const char* mgrs, int len,
+                                  int& zone, bool& northp, real& x, real& y,
+                                  int& prec, bool centerp, bool throwp) {
+    // Only used to construct error messages
+    auto str = [mgrs, len](int p, int n) -> string
+      { return string(mgrs + p, min(n, len - p)); };
+    const tables& t = Tables();
+    int p = 0;
     if (len >= 3 &&
         toupper(mgrs[0]) == 'I' &&
         toupper(mgrs[1]) == 'N' &&
@@ -168,30 +275,39 @@ namespace GeographicLib {
       northp = false;
       x = y = Math::NaN();
       prec = -2;
-      return;
+      return OK;
     }
     int zone1 = 0;
     while (p < len) {
-      int i = Utility::lookup(digits_, mgrs[p]);
+      int i = t.digits(mgrs[p]);
       if (i < 0)
         break;
       zone1 = 10 * zone1 + i;
       ++p;
     }
-    if (p > 0 && !(zone1 >= UTMUPS::MINUTMZONE && zone1 <= UTMUPS::MAXUTMZONE))
+    if (p > 0 &&
+        !(zone1 >= UTMUPS::MINUTMZONE && zone1 <= UTMUPS::MAXUTMZONE)) {
+      if (!throwp) return BADZONE;
       throw GeographicErr("Zone " + Utility::str(zone1) + " not in [1,60]");
-    if (p > 2)
+    }
+    if (p > 2) {
+      if (!throwp) return BADSTRING;
       throw GeographicErr("More than 2 digits at start of MGRS "
-                          + mgrs.substr(0, p));
-    if (len - p < 1)
-      throw GeographicErr("MGRS string too short " + mgrs);
+                          + str(0, p));
+    }
+    if (len - p < 1) {
+      if (!throwp) return BADSTRING;
+      throw GeographicErr("MGRS string too short " + str(0, len));
+    }
     bool utmp = zone1 != UTMUPS::UPS;
     int zonem1 = zone1 - 1;
     const char* band = utmp ? latband_ : upsband_;
-    int iband = Utility::lookup(band, mgrs[p++]);
-    if (iband < 0)
+    int iband = (utmp ? t.latband : t.upsband)(mgrs[p++]);
+    if (iband < 0) {
+      if (!throwp) return BADSTRING;
       throw GeographicErr("Band letter " + Utility::str(mgrs[p-1]) + " not in "
                           + (utmp ? "UTM" : "UPS") + " set " + band);
+    }
     bool northp1 = iband >= (utmp ? 10 : 2);
     if (p == len) {             // Grid zone only (ignore centerp)
       // Approx length of a degree of meridian arc in units of tile.
@@ -212,32 +328,40 @@ namespace GeographicLib {
         y = upseasting_ * tile_;
       }
       prec = -1;
-      return;
-    } else if (len - p < 2)
-      throw GeographicErr("Missing row letter in " + mgrs);
+      return OK;
+    } else if (len - p < 2) {
+      if (!throwp) return BADSTRING;
+      throw GeographicErr("Missing row letter in " + str(0, len));
+    }
     const char* col = utmp ? utmcols_[zonem1 % 3] : upscols_[iband];
     const char* row = utmp ? utmrow_ : upsrows_[northp1];
-    int icol = Utility::lookup(col, mgrs[p++]);
-    if (icol < 0)
+    int icol = (utmp ? t.utmcols[zonem1 % 3] : t.upscols[iband])(mgrs[p++]);
+    if (icol < 0) {
+      if (!throwp) return BADSTRING;
       throw GeographicErr("Column letter " + Utility::str(mgrs[p-1])
                           + " not in "
-                          + (utmp ? "zone " + mgrs.substr(0, p-2) :
+                          + (utmp ? "zone " + str(0, p-2) :
                              "UPS band " + Utility::str(mgrs[p-2]))
                           + " set " + col );
-    int irow = Utility::lookup(row, mgrs[p++]);
-    if (irow < 0)
+    }
+    int irow = (utmp ? t.utmrow : t.upsrows[northp1])(mgrs[p++]);
+    if (irow < 0) {
+      if (!throwp) return BADSTRING;
       throw GeographicErr("Row letter " + Utility::str(mgrs[p-1]) + " not in "
                           + (utmp ? "UTM" :
                              "UPS " + Utility::str(hemispheres_[northp1]))
                           + " set " + row);
+    }
     if (utmp) {
       if (zonem1 & 1)
         irow = (irow + utmrowperiod_ - utmevenrowshift_) % utmrowperiod_;
       iband -= 10;
       irow = UTMRow(iband, icol, irow);
-      if (irow == maxutmSrow_)
-        throw GeographicErr("Block " + mgrs.substr(p-2, 2)
-                            + " not in zone/band " + mgrs.substr(0, p-2));
+      if (irow == maxutmSrow_) {
+        if (!throwp) return BADSTRING;
+        throw GeographicErr("Block " + str(p-2, 2)
+                            + " not in zone/band " + str(0, p-2));
+      }
 
       irow = northp1 ? irow : irow + 100;
       icol = icol + minutmcol_;
@@ -254,23 +378,28 @@ namespace GeographicLib {
     for (int i = 0; i < prec1; ++i) {
       unit *= base_;
       int
-        ix = Utility::lookup(digits_, mgrs[p + i]),
-        iy = Utility::lookup(digits_, mgrs[p + i + prec1]);
-      if (ix < 0 || iy < 0)
-        throw GeographicErr("Encountered a non-digit in " + mgrs.substr(p));
+        ix = t.digits(mgrs[p + i]),
+        iy = t.digits(mgrs[p + i + prec1]);
+      if (ix < 0 || iy < 0) {
+        if (!throwp) return BADSTRING;
+        throw GeographicErr("Encountered a non-digit in " + str(p, len));
+      }
       x1 = base_ * x1 + ix;
       y1 = base_ * y1 + iy;
     }
     if ((len - p) % 2) {
-      if (Utility::lookup(digits_, mgrs[len - 1]) < 0)
-        throw GeographicErr("Encountered a non-digit in " + mgrs.substr(p));
+      if (!throwp) return BADSTRING;
+      if (t.digits(mgrs[len - 1]) < 0)
+        throw GeographicErr("Encountered a non-digit in " + str(p, len));
       else
         throw GeographicErr("Not an even number of digits in "
-                            + mgrs.substr(p));
+                            + str(p, len));
     }
-    if (prec1 > maxprec_)
+    if (prec1 > maxprec_) {
+      if (!throwp) return BADSTRING;
       throw GeographicErr("More than " + Utility::str(2*maxprec_)
-                          + " digits in " + mgrs.substr(p));
+                          + " digits in " + str(p, len));
+    }
     if (centerp) {
       unit *= 2; x1 = 2 * x1 + 1; y1 = 2 * y1 + 1;
     }
@@ -279,9 +408,49 @@ namespace GeographicLib {
     x = (tile_ * x1) / unit;
     y = (tile_ * y1) / unit;
     prec = prec1;
+    return OK;
+  }
+
+  void MGRS::Reverse(const string& mgrs,
+                     int& zone, bool& northp, real& x, real& y,
+                     int& prec, bool centerp) {
+    ReverseChars(mgrs.data(), int(mgrs.length()),
+                 zone, northp, x, y, prec, centerp, true);
+  }
+
+  MGRS::status MGRS::Reverse(const char* mgrs, size_t len,
+                             int& zone, bool& northp, real& x, real& y,
+                             int& prec, bool centerp) {
+    if (len > size_t(numeric_limits<int>::max())) return BADSTRING;
+    return ReverseChars(mgrs, int(len), zone, northp, x, y, prec, centerp,
+                        false);
+  }
+
+  size_t MGRS::ReverseBatch(size_t n, const char mgrs[], size_t stride,
+                            int zone[], bool northp[], real x[], real y[],
+                            int prec[], bool centerp, status stat[]) {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "MGRS::ReverseBatch", n);
+    size_t nbad = 0;
+    for (size_t i = 0; i < n; ++i) {
+      const char* mgrsi = mgrs + i * stride;
+      size_t len = 0;
+      while (len < stride && mgrsi[len]) ++len;
+      status st = Reverse(mgrsi, len, zone[i], northp[i], x[i], y[i],
+                          prec[i], centerp);
+      if (st != OK) {
+        ++nbad;
+        zone[i] = UTMUPS::INVALID;
+        northp[i] = false;
+        x[i] = y[i] = Math::NaN();
+        prec[i] = -2;
+      }
+      if (stat) stat[i] = st;
+    }
+    return nbad;
   }
 
-  void MGRS::CheckCoords(bool utmp, bool& northp, real& x, real& y) {
+  bool MGRS::CheckCoords(bool utmp, bool& northp, real& x, real& y,
+                         bool throwp) {
     // Limits are all multiples of 100km and are all closed on the lower end
     // and open on the upper end -- and this is reflected in the error
     // messages.  However if a coordinate lies on the excluded upper end (e.g.,
@@ -299,6 +468,8 @@ namespace GeographicLib {
     if (! (ix >= mineasting_[ind] && ix < maxeasting_[ind]) ) {
       if (ix == maxeasting_[ind] && x == maxeasting_[ind] * tile_)
         x -= eps;
+      else if (!throwp)
+        return false;
       else
         throw GeographicErr("Easting " + Utility::str(int(floor(x/1000)))
                             + "km not in MGRS/"
@@ -312,6 +483,8 @@ namespace GeographicLib {
     if (! (iy >= minnorthing_[ind] && iy < maxnorthing_[ind]) ) {
       if (iy == maxnorthing_[ind] && y == maxnorthing_[ind] * tile_)
         y -= eps;
+      else if (!throwp)
+        return false;
       else
         throw GeographicErr("Northing " + Utility::str(int(floor(y/1000)))
                             + "km not in MGRS/"
@@ -338,6 +511,7 @@ namespace GeographicLib {
         }
       }
     }
+    return true;
   }
 
   int MGRS::UTMRow(int iband, int icol, int irow) {
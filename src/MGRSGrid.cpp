@@ -0,0 +1,409 @@
+/**
+ * \file MGRSGrid.cpp
+ * \brief Implementation for GeographicLib::MGRSGrid class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <GeographicLib/MGRSGrid.hpp>
+#include <GeographicLib/MGRS.hpp>
+#include <GeographicLib/UTMUPS.hpp>
+#include <GeographicLib/Utility.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    typedef Math::real real;
+
+    const int maxit = 50;
+    // Tolerance for the crossings of the lines with the zone boundaries
+    // (meters)
+    const real tol = real(1e-6);
+    // Number of points per side used to find the range of the projected
+    // coordinates
+    const int nedge = 32;
+    // Space for an MGRS string with prec <= 5 (with the terminating null)
+    const size_t stride = 2 + 3 + 2 * 5 + 1;
+
+    // The longitude of lon east of w in [0, 360)
+    inline real eastof(real w, real lon) {
+      real t = Math::AngDiff(w, lon);
+      return t < 0 ? t + 360 : t;
+    }
+
+    // A grid zone: a UTM zone in a latitude band, or the eastern or western
+    // half of a UPS region
+    struct cell {
+      int zone;
+      bool northp;
+      real s, n, w, dlon;
+    };
+
+    // The grid zones, ordered by latitude band and then by longitude.  These
+    // are found by applying UTMUPS::StandardZone at 1 degree intervals; this
+    // picks up the Norway and Svalbard exceptions.
+    const vector<cell>& Cells() {
+      static const vector<cell> cells = [] () -> vector<cell> {
+        vector<cell> c;
+        for (int iband = -10; iband < 10; ++iband) {
+          real s = real(8 * iband), n = real(iband == 9 ? 84 : 8 * iband + 8),
+            lat = (s + n) / 2;
+          int zone0 = 0, ilon0 = -180;
+          for (int ilon = -180; ilon <= 180; ++ilon) {
+            int zone = ilon < 180 ?
+              UTMUPS::StandardZone(lat, ilon + real(0.5)) : 0;
+            if (zone != zone0) {
+              if (zone0 > 0)
+                c.push_back({zone0, iband >= 0, s, n,
+                             real(ilon0), real(ilon - ilon0)});
+              zone0 = zone; ilon0 = ilon;
+            }
+          }
+        }
+        for (int h = 0; h < 2; ++h)
+          for (int i = 0; i < 2; ++i)
+            c.push_back({UTMUPS::UPS, h == 1,
+                         real(h ? 84 : -90), real(h ? 90 : -80),
+                         real(i ? 0 : -180), real(180)});
+        return c;
+      }();
+      return cells;
+    }
+
+    // The intersection of a grid zone with the box; w is in the continuous
+    // longitude frame of the box.
+    struct piece {
+      int zone;
+      bool northp;
+      real s, n, w, dlon;
+      // How far (lat, lon) lies outside the piece (degrees); this is <= 0 for
+      // a point inside the piece and NaN for a NaN point.
+      real outside(real lat, real lon) const {
+        using std::isnan;
+        if (isnan(lat) || isnan(lon)) return Math::NaN();
+        real rel = Math::AngDiff(w, lon);
+        return max(max(s - lat, lat - n), max(-rel, rel - dlon));
+      }
+      // Put a point inside the piece in the longitude frame of the box; if
+      // snap, move it onto the nearest edge.
+      void place(real& lat, real& lon, bool snap) const {
+        real rel = Math::AngDiff(w, lon);
+        if (snap) {
+          real d[] = {s - lat, lat - n, -rel, rel - dlon};
+          switch (max_element(d, d + 4) - d) {
+          case 0: lat = s; break;
+          case 1: lat = n; break;
+          case 2: rel = 0; break;
+          default: rel = dlon; break;
+          }
+        }
+        lon = w + rel;
+      }
+      // The batch conversions with the zone and hemisphere of the piece
+      void Reverse(size_t m, const real x[], const real y[],
+                   real lat[], real lon[]) const {
+        vector<int> zonev(m, zone);
+        unique_ptr<bool[]> northv(new bool[m]);
+        fill_n(northv.get(), m, northp);
+        UTMUPS::ReverseBatch(m, zonev.data(), northv.get(), x, y, lat, lon);
+      }
+      void Forward(size_t m, const real lat[], const real lon[],
+                   real x[], real y[]) const {
+        vector<int> zonev(m);
+        unique_ptr<bool[]> northv(new bool[m]);
+        UTMUPS::ForwardBatch(m, lat, lon, zonev.data(), northv.get(), x, y,
+                             nullptr, nullptr, zone);
+        // A point on the equator is assigned to the northern hemisphere
+        if (zone != UTMUPS::UPS)
+          for (size_t i = 0; i < m; ++i)
+            if (northv[i] != northp)
+              y[i] += northp ? -UTMUPS::UTMShift() : UTMUPS::UTMShift();
+      }
+    };
+
+    // A point where a grid line crosses the edge of a piece, bracketed
+    // between a point inside (at tin) and a point outside (at tout).
+    struct crossing {
+      size_t line;
+      real tin, tout, gin, gout, lat, lon;
+      int side;
+    };
+
+    // The grid lines and labels in a piece
+    void Grid(const piece& p, real sp, real step,
+              vector<MGRSGrid::polyline>& lines,
+              vector<int>& lzone, vector<char>& lnorth,
+              vector<real>& lx, vector<real>& ly,
+              vector<real>& llat, vector<real>& llon) {
+      using std::isfinite; using std::ceil; using std::floor; using std::abs;
+      // The range of the projected coordinates from points on the edges
+      vector<real> lat(4 * nedge), lon(4 * nedge), x(4 * nedge), y(4 * nedge);
+      for (int i = 0; i < nedge; ++i) {
+        real f = real(i) / nedge;
+        lat[i] = p.s + f * (p.n - p.s); lon[i] = p.w + p.dlon;
+        lat[nedge + i] = p.n - f * (p.n - p.s); lon[nedge + i] = p.w;
+        lat[2*nedge + i] = p.s; lon[2*nedge + i] = p.w + f * p.dlon;
+        lat[3*nedge + i] = p.n; lon[3*nedge + i] = p.w + p.dlon - f * p.dlon;
+      }
+      p.Forward(4 * nedge, lat.data(), lon.data(), x.data(), y.data());
+      real xmin = Math::infinity(), xmax = -xmin, ymin = xmin, ymax = xmax;
+      for (int i = 0; i < 4 * nedge; ++i) {
+        if (!(isfinite(x[i]) && isfinite(y[i]))) continue;
+        xmin = min(xmin, x[i]); xmax = max(xmax, x[i]);
+        ymin = min(ymin, y[i]); ymax = max(ymax, y[i]);
+      }
+      if (!(xmin <= xmax && ymin <= ymax)) return;
+      // Allow for the extremes falling between the points on the edges
+      {
+        real dx = (xmax - xmin) / nedge, dy = (ymax - ymin) / nedge;
+        xmin -= dx; xmax += dx; ymin -= dy; ymax += dy;
+      }
+      long
+        ix0 = long(ceil(xmin / sp)), ix1 = long(floor(xmax / sp)),
+        iy0 = long(ceil(ymin / sp)), iy1 = long(floor(ymax / sp));
+      // The lines are sampled finely enough to resolve a small piece
+      int
+        nx = max(2 * nedge, int(ceil((xmax - xmin) / step))) + 1,
+        ny = max(2 * nedge, int(ceil((ymax - ymin) / step))) + 1;
+
+      // The labels at the centers of the grid squares
+      size_t
+        nlx = size_t(max(0L, ix1 - ix0 + 2)),
+        nly = size_t(max(0L, iy1 - iy0 + 2)),
+        nlab = nlx * nly;
+      x.resize(nlab); y.resize(nlab); lat.resize(nlab); lon.resize(nlab);
+      for (size_t i = 0; i < nlx; ++i)
+        for (size_t j = 0; j < nly; ++j) {
+          x[i * nly + j] = (real(ix0 - 1 + long(i)) + real(0.5)) * sp;
+          y[i * nly + j] = (real(iy0 - 1 + long(j)) + real(0.5)) * sp;
+        }
+      p.Reverse(nlab, x.data(), y.data(), lat.data(), lon.data());
+      for (size_t k = 0; k < nlab; ++k) {
+        if (!(p.outside(lat[k], lon[k]) <= 0)) continue;
+        p.place(lat[k], lon[k], false);
+        lzone.push_back(p.zone); lnorth.push_back(p.northp);
+        lx.push_back(x[k]); ly.push_back(y[k]);
+        llat.push_back(lat[k]); llon.push_back(lon[k]);
+      }
+
+      // Sample all the lines, EASTING lines first, and convert them together
+      size_t neast = size_t(max(0L, ix1 - ix0 + 1)),
+        nnorth = size_t(max(0L, iy1 - iy0 + 1)),
+        nline = neast + nnorth,
+        npts = neast * ny + nnorth * nx;
+      if (nline == 0) return;
+      auto eastingp = [neast](size_t l) -> bool { return l < neast; };
+      auto value = [=](size_t l) -> real
+        { return real(eastingp(l) ? ix0 + long(l) : iy0 + long(l - neast)); };
+      // The index of the first point on line l
+      auto start = [=](size_t l) -> size_t
+        { return eastingp(l) ? l * ny : neast * ny + (l - neast) * nx; };
+      auto count = [=](size_t l) -> int { return eastingp(l) ? ny : nx; };
+      // The coordinate along line l of its j'th point
+      auto param = [=](size_t l, int j) -> real {
+        return eastingp(l) ?
+          ymin + (ymax - ymin) * j / (ny - 1) :
+          xmin + (xmax - xmin) * j / (nx - 1);
+      };
+      x.resize(npts); y.resize(npts); lat.resize(npts); lon.resize(npts);
+      for (size_t l = 0; l < nline; ++l) {
+        size_t k = start(l);
+        real v = value(l) * sp;
+        for (int j = 0; j < count(l); ++j, ++k) {
+          if (eastingp(l)) { x[k] = v; y[k] = param(l, j); }
+          else { x[k] = param(l, j); y[k] = v; }
+        }
+      }
+      p.Reverse(npts, x.data(), y.data(), lat.data(), lon.data());
+      vector<real> g(npts);
+      for (size_t k = 0; k < npts; ++k)
+        g[k] = p.outside(lat[k], lon[k]);
+
+      // Find the brackets for the crossings of the edges
+      vector<crossing> cross;
+      for (size_t l = 0; l < nline; ++l) {
+        size_t k = start(l);
+        for (int j = 1; j < count(l); ++j) {
+          bool in0 = g[k + j - 1] <= 0, in1 = g[k + j] <= 0;
+          if (in0 == in1) continue;
+          size_t kin = k + (in0 ? j - 1 : j), kout = k + (in0 ? j : j - 1);
+          cross.push_back({l, param(l, in0 ? j - 1 : j),
+                           param(l, in0 ? j : j - 1),
+                           g[kin], g[kout], lat[kin], lon[kin], 0});
+        }
+      }
+      // Refine the crossings together with the Illinois algorithm, falling
+      // back to bisection if the point outside is out of the projection's
+      // range.
+      {
+        vector<size_t> active(cross.size());
+        for (size_t i = 0; i < active.size(); ++i) active[i] = i;
+        vector<real> tm, xm, ym, latm, lonm;
+        for (int it = 0; it < maxit && !active.empty(); ++it) {
+          size_t m = active.size();
+          tm.resize(m); xm.resize(m); ym.resize(m);
+          latm.resize(m); lonm.resize(m);
+          for (size_t i = 0; i < m; ++i) {
+            const crossing& c = cross[active[i]];
+            tm[i] = isfinite(c.gout) ?
+              (c.tin * c.gout - c.tout * c.gin) / (c.gout - c.gin) :
+              (c.tin + c.tout) / 2;
+            real v = value(c.line) * sp;
+            if (eastingp(c.line)) { xm[i] = v; ym[i] = tm[i]; }
+            else { xm[i] = tm[i]; ym[i] = v; }
+          }
+          p.Reverse(m, xm.data(), ym.data(), latm.data(), lonm.data());
+          size_t m1 = 0;
+          for (size_t i = 0; i < m; ++i) {
+            crossing& c = cross[active[i]];
+            real gm = p.outside(latm[i], lonm[i]);
+            if (gm <= 0) {
+              c.tin = tm[i]; c.gin = gm; c.lat = latm[i]; c.lon = lonm[i];
+              if (c.side == -1) c.gout /= 2;
+              c.side = -1;
+            } else {
+              c.tout = tm[i]; c.gout = isfinite(gm) ? gm : Math::NaN();
+              if (c.side == 1) c.gin /= 2;
+              c.side = 1;
+            }
+            if (!(gm == 0 || abs(c.tout - c.tin) <= tol))
+              active[m1++] = active[i];
+          }
+          active.resize(m1);
+        }
+      }
+
+      // Assemble the polylines
+      size_t ic = 0;
+      for (size_t l = 0; l < nline; ++l) {
+        size_t k = start(l);
+        MGRSGrid::polyline line;
+        line.type = eastingp(l) ? MGRSGrid::EASTING : MGRSGrid::NORTHING;
+        line.zone = p.zone; line.northp = p.northp; line.value = value(l) * sp;
+        bool in = false;
+        for (int j = 0; j < count(l); ++j, ++k) {
+          bool inj = g[k] <= 0;
+          if (inj != in && j > 0) {
+            real lat1 = cross[ic].lat, lon1 = cross[ic].lon;
+            ++ic;
+            p.place(lat1, lon1, true);
+            line.lat.push_back(lat1); line.lon.push_back(lon1);
+            if (!inj) {
+              lines.push_back(line);
+              line.lat.clear(); line.lon.clear();
+            }
+          }
+          if (inj) {
+            real lat1 = lat[k], lon1 = lon[k];
+            p.place(lat1, lon1, false);
+            line.lat.push_back(lat1); line.lon.push_back(lon1);
+          }
+          in = inj;
+        }
+        if (in) lines.push_back(line);
+      }
+    }
+
+    // A meridian or parallel with points spaced no further apart than step
+    void Graticule(const piece& p, bool meridianp, real step,
+                   vector<MGRSGrid::polyline>& lines) {
+      using std::ceil;
+      // Convert step to degrees
+      step /= Constants::WGS84_a() * Math::degree();
+      MGRSGrid::polyline line;
+      line.zone = p.zone; line.northp = p.northp;
+      if (meridianp) {
+        line.type = MGRSGrid::ZONEBOUNDARY; line.value = p.w;
+        int m = max(2, int(ceil((p.n - p.s) / step)) + 1);
+        for (int j = 0; j < m; ++j) {
+          line.lat.push_back(p.s + (p.n - p.s) * j / (m - 1));
+          line.lon.push_back(p.w);
+        }
+      } else {
+        line.type = MGRSGrid::BANDBOUNDARY; line.value = p.s;
+        int m = max(2, int(ceil(p.dlon * Math::cosd(p.s) / step)) + 1);
+        for (int j = 0; j < m; ++j) {
+          line.lat.push_back(p.s);
+          line.lon.push_back(p.w + p.dlon * j / (m - 1));
+        }
+      }
+      lines.push_back(line);
+    }
+
+  } // namespace
+
+  MGRSGrid::MGRSGrid(int prec, real step)
+    : _prec(prec)
+    , _step(step)
+  {
+    using std::isfinite;
+    if (!(prec >= -1 && prec <= 5))
+      throw GeographicErr("MGRSGrid precision " + Utility::str(prec)
+                          + " not in [-1, 5]");
+    if (!(isfinite(step) && step > 0))
+      throw GeographicErr("MGRSGrid step must be positive");
+  }
+
+  Math::real MGRSGrid::Spacing() const {
+    if (_prec < 0) return 0;
+    real sp = 100000;           // The size of the 100 km squares
+    for (int i = 0; i < _prec; ++i) sp /= 10;
+    return sp;
+  }
+
+  void MGRSGrid::Generate(real south, real west, real north, real east,
+                          vector<polyline>& lines,
+                          vector<label>& labels) const {
+    using std::isfinite; using std::abs;
+    lines.clear(); labels.clear();
+    if (!(abs(south) <= 90 && abs(north) <= 90))
+      throw GeographicErr("MGRSGrid latitudes must be in [-90, 90]");
+    if (!(south < north && isfinite(west) && isfinite(east))) return;
+    real dlon = eastof(west, east);
+    if (dlon == 0) dlon = 360;
+    real sp = Spacing();
+    // The labels are accumulated over all the pieces and converted together
+    vector<int> lzone; vector<char> lnorth;
+    vector<real> lx, ly, llat, llon;
+    for (const cell& c : Cells()) {
+      real s = max(c.s, south), n = min(c.n, north);
+      if (!(s < n)) continue;
+      real t = eastof(west, c.w);
+      for (int k = 0; k < 2; ++k) {
+        real t0 = t - 360 * k,
+          lo = max(t0, real(0)), hi = min(t0 + c.dlon, dlon);
+        if (!(lo < hi)) continue;
+        piece p = {c.zone, c.northp, s, n, west + lo, hi - lo};
+        if (s == c.s && c.s > -90) Graticule(p, false, _step, lines);
+        if (lo == t0) Graticule(p, true, _step, lines);
+        if (_prec >= 0)
+          Grid(p, sp, _step, lines, lzone, lnorth, lx, ly, llat, llon);
+        else {
+          // Label the grid zone at the center of the piece
+          real lat1 = (p.s + p.n) / 2, lon1 = p.w + p.dlon / 2, x1, y1;
+          p.Forward(1, &lat1, &lon1, &x1, &y1);
+          lzone.push_back(p.zone); lnorth.push_back(p.northp);
+          lx.push_back(x1); ly.push_back(y1);
+          llat.push_back(lat1); llon.push_back(lon1);
+        }
+      }
+    }
+    size_t nlab = lzone.size();
+    if (nlab == 0) return;
+    unique_ptr<bool[]> northv(new bool[nlab]);
+    copy(lnorth.begin(), lnorth.end(), northv.get());
+    vector<char> mgrs(nlab * stride);
+    MGRS::ForwardBatch(nlab, lzone.data(), northv.get(), lx.data(), ly.data(),
+                       _prec, mgrs.data(), stride);
+    labels.reserve(nlab);
+    for (size_t i = 0; i < nlab; ++i)
+      labels.push_back({llat[i], llon[i], string(mgrs.data() + i * stride)});
+  }
+
+} // namespace GeographicLib
@@ -16,22 +16,35 @@ namespace GeographicLib {
 
   using namespace std;
 
-  void MagneticCircle::FieldGeocentric(real slam, real clam,
+  int MagneticCircle::Epoch(real& t) const {
+    t -= _t0;
+    int n = max(min(int(floor(t / _dt0)), _Nmodels - 1), 0);
+    t -= n * _dt0;
+    return n >= _n0 && n + 1 < _n0 + int(_circ.size()) ? n : -1;
+  }
+
+  void MagneticCircle::FieldGeocentric(real t, real slam, real clam,
                                        real& BX, real& BY, real& BZ,
                                        real& BXt, real& BYt, real& BZt) const {
+    int n = Epoch(t);
+    if (n < 0) {
+      BX = BY = BZ = BXt = BYt = BZt = Math::NaN();
+      return;
+    }
     real BXc = 0, BYc = 0, BZc = 0;
-    _circ0(slam, clam, BX, BY, BZ);
-    _circ1(slam, clam, BXt, BYt, BZt);
+    _circ[n - _n0](slam, clam, BX, BY, BZ);
+    _circ[n + 1 - _n0](slam, clam, BXt, BYt, BZt);
     if (_constterm)
-      _circ2(slam, clam, BXc, BYc, BZc);
-    if (_interpolate) {
+      _circc(slam, clam, BXc, BYc, BZc);
+    if (n + 1 < _Nmodels) {
+      // Interpolate; convert to a time derivative
       BXt = (BXt - BX) / _dt0;
       BYt = (BYt - BY) / _dt0;
       BZt = (BZt - BZ) / _dt0;
     }
-    BX += _t1 * BXt + BXc;
-    BY += _t1 * BYt + BYc;
-    BZ += _t1 * BZt + BZc;
+    BX += t * BXt + BXc;
+    BY += t * BYt + BYc;
+    BZ += t * BZt + BZc;
 
     BXt *= - _a;
     BYt *= - _a;
@@ -42,15 +55,15 @@ namespace GeographicLib {
     BZ *= - _a;
   }
 
-  void MagneticCircle::FieldGeocentric(real lon,
+  void MagneticCircle::FieldGeocentric(real t, real lon,
                                        real& BX, real& BY, real& BZ,
                                        real& BXt, real& BYt, real& BZt) const {
     real slam, clam;
     Math::sincosd(lon, slam, clam);
-    FieldGeocentric(slam, clam, BX, BY, BZ, BXt, BYt, BZt);
+    FieldGeocentric(t, slam, clam, BX, BY, BZ, BXt, BYt, BZt);
   }
 
-  void MagneticCircle::Field(real lon, bool diffp,
+  void MagneticCircle::Field(real t, real lon, bool diffp,
                              real& Bx, real& By, real& Bz,
                              real& Bxt, real& Byt, real& Bzt) const {
     real slam, clam;
@@ -58,10 +71,54 @@ namespace GeographicLib {
     real M[Geocentric::dim2_];
     Geocentric::Rotation(_sphi, _cphi, slam, clam, M);
     real BX, BY, BZ, BXt, BYt, BZt; // Components in geocentric basis
-    FieldGeocentric(slam, clam, BX, BY, BZ, BXt, BYt, BZt);
+    FieldGeocentric(t, slam, clam, BX, BY, BZ, BXt, BYt, BZt);
     if (diffp)
       Geocentric::Unrotate(M, BXt, BYt, BZt, Bxt, Byt, Bzt);
     Geocentric::Unrotate(M, BX, BY, BZ, Bx, By, Bz);
   }
 
+  void MagneticCircle::operator()(real t, size_t n, const real lon[],
+                                  real Bx[], real By[], real Bz[]) const {
+    int m = Epoch(t);
+    if (m < 0) {
+      fill(Bx, Bx + n, Math::NaN());
+      fill(By, By + n, Math::NaN());
+      fill(Bz, Bz + n, Math::NaN());
+      return;
+    }
+    const CircularEngine &circ0 = _circ[m - _n0], &circ1 = _circ[m + 1 - _n0];
+    bool interpolate = m + 1 < _Nmodels;
+    real slam[blk_], clam[blk_], V[blk_],
+      BX[blk_], BY[blk_], BZ[blk_], BXt[blk_], BYt[blk_], BZt[blk_],
+      BXc[blk_], BYc[blk_], BZc[blk_];
+    for (size_t i0 = 0; i0 < n; i0 += blk_) {
+      int k = int(min(n - i0, size_t(blk_)));
+      for (int j = 0; j < k; ++j)
+        Math::sincosd(lon[i0 + j], slam[j], clam[j]);
+      circ0.Evaluate(k, slam, clam, V, BX, BY, BZ);
+      circ1.Evaluate(k, slam, clam, V, BXt, BYt, BZt);
+      if (_constterm)
+        _circc.Evaluate(k, slam, clam, V, BXc, BYc, BZc);
+      else
+        for (int j = 0; j < k; ++j) BXc[j] = BYc[j] = BZc[j] = 0;
+      for (int j = 0; j < k; ++j) {
+        // This mirrors FieldGeocentric and Field
+        real bXt = BXt[j], bYt = BYt[j], bZt = BZt[j];
+        if (interpolate) {
+          bXt = (bXt - BX[j]) / _dt0;
+          bYt = (bYt - BY[j]) / _dt0;
+          bZt = (bZt - BZ[j]) / _dt0;
+        }
+        real
+          bX = (BX[j] + (t * bXt + BXc[j])) * (- _a),
+          bY = (BY[j] + (t * bYt + BYc[j])) * (- _a),
+          bZ = (BZ[j] + (t * bZt + BZc[j])) * (- _a),
+          M[Geocentric::dim2_];
+        Geocentric::Rotation(_sphi, _cphi, slam[j], clam[j], M);
+        Geocentric::Unrotate(M, bX, bY, bZ,
+                             Bx[i0 + j], By[i0 + j], Bz[i0 + j]);
+      }
+    }
+  }
+
 } // namespace GeographicLib
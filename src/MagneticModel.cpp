@@ -9,9 +9,14 @@
 
 #include <GeographicLib/MagneticModel.hpp>
 #include <fstream>
+#include <sstream>
+#include <chrono>
 #include <GeographicLib/SphericalEngine.hpp>
 #include <GeographicLib/MagneticCircle.hpp>
+#include <GeographicLib/MagneticSnapshot.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <GeographicLib/Trace.hpp>
 
 #if !defined(GEOGRAPHICLIB_DATA)
 #  if defined(_WIN32)
@@ -35,7 +40,8 @@ namespace GeographicLib {
   using namespace std;
 
   MagneticModel::MagneticModel(const std::string& name, const std::string& path,
-                               const Geocentric& earth, int Nmax, int Mmax)
+                               const Geocentric& earth, int Nmax, int Mmax,
+                               bool mapped)
     : _name(name)
     , _dir(path)
     , _description("NONE")
@@ -54,7 +60,15 @@ namespace GeographicLib {
     , _norm(SphericalHarmonic::SCHMIDT)
     , _earth(earth)
   {
-    if (_dir.empty())
+    GEOGRAPHICLIB_TRACE_SCOPE1(magnetic__load, name.c_str());
+    // Use a compiled-in model if there's one with this name (and no path
+    // is given)
+    const embedded* e = nullptr;
+    if (_dir.empty()) {
+      for (e = _embedded; e->name && _name != e->name; ++e) {}
+      if (!e->name) e = nullptr;
+    }
+    if (_dir.empty() && !e)
       _dir = DefaultMagneticPath();
     bool truncate = Nmax >= 0 || Mmax >= 0;
     if (truncate) {
@@ -62,45 +76,158 @@ namespace GeographicLib {
       if (Nmax < 0) Nmax = numeric_limits<int>::max();
       if (Mmax < 0) Mmax = numeric_limits<int>::max();
     }
-    ReadMetadata(_name);
-    _G.resize(_Nmodels + 1 + _Nconstants);
-    _H.resize(_Nmodels + 1 + _Nconstants);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    if (e) {
+      _filename = "<embedded>/" + _name + ".wmm";
+      istringstream metastr(string(reinterpret_cast<const char*>(e->meta),
+                                   e->metasize));
+      ReadMetadata(metastr);
+    } else {
+      _filename = _dir + "/" + _name + ".wmm";
+      ifstream metastr(_filename.c_str());
+      if (!metastr.good())
+        throw GeographicErr("Cannot open " + _filename);
+      ReadMetadata(metastr);
+    }
+    shared_ptr<coeffstore> store = make_shared<coeffstore>();
+    coeffstore& st = *store;
+    st.G.resize(_Nmodels + 1 + _Nconstants);
+    st.H.resize(_Nmodels + 1 + _Nconstants);
     {
       string coeff = _filename + ".cof";
-      ifstream coeffstr(coeff.c_str(), ios::binary);
-      if (!coeffstr.good())
-        throw GeographicErr("Error opening " + coeff);
-      char id[idlength_ + 1];
-      coeffstr.read(id, idlength_);
-      if (!coeffstr.good())
-        throw GeographicErr("No header in " + coeff);
-      id[idlength_] = '\0';
-      if (_id != string(id))
-        throw GeographicErr("ID mismatch: " + _id + " vs " + id);
-      for (int i = 0; i < _Nmodels + 1 + _Nconstants; ++i) {
-        int N, M;
-        if (truncate) { N = Nmax; M = Mmax; }
-        SphericalEngine::coeff::readcoeffs(coeffstr, N, M, _G[i], _H[i],
-                                           truncate);
-        if (!(M < 0 || _G[i][0] == 0))
-          throw GeographicErr("A degree 0 term is not permitted");
-        _harm.push_back(SphericalHarmonic(_G[i], _H[i], N, N, M, _a, _norm));
-        _nmx = max(_nmx, _harm.back().Coefficients().nmx());
-        _mmx = max(_mmx, _harm.back().Coefficients().mmx());
+      if (mapped && !e && SphericalEngine::mappedfile::Supported()) {
+        st.map.Map(coeff);
+        char* data = st.map.data();
+        size_t pos = idlength_;
+        if (st.map.size() < pos)
+          throw GeographicErr("No header in " + coeff);
+        if (_id != string(data, idlength_))
+          throw GeographicErr("ID mismatch: " + _id + " vs " +
+                              string(data, idlength_));
+        if (truncate && !(Nmax >= Mmax && Mmax >= 0))
+          throw GeographicErr("Bad requested degree and order " +
+                              Utility::str(Nmax) + " " + Utility::str(Mmax));
+        for (int i = 0; i < _Nmodels + 1 + _Nconstants; ++i) {
+          int N0, M0;
+          real *C, *S;
+          SphericalEngine::coeff::mapcoeffs(data, st.map.size(), pos,
+                                            N0, M0, C, S);
+          int
+            N = truncate ? min(Nmax, N0) : N0,
+            M = truncate ? min(Mmax, M0) : M0;
+          if (!(M < 0 || C[0] == 0))
+            throw GeographicErr("A degree 0 term is not permitted");
+          _harm.push_back(SphericalHarmonic(SphericalEngine::coeff(C, S,
+                                                                   N0, N, M),
+                                            _a, _norm));
+          _nmx = max(_nmx, _harm.back().Coefficients().nmx());
+          _mmx = max(_mmx, _harm.back().Coefficients().mmx());
+        }
+        if (pos != st.map.size())
+          throw GeographicErr("Extra data in " + coeff);
+        _loadbytes = (unsigned long long)(pos);
+      } else {
+        ifstream coefffile;
+        istringstream coeffdata;
+        if (e)
+          coeffdata.str(string(reinterpret_cast<const char*>(e->coeff),
+                               e->coeffsize));
+        else
+          coefffile.open(coeff.c_str(), ios::binary);
+        istream& coeffstr = e ? static_cast<istream&>(coeffdata) : coefffile;
+        if (!coeffstr.good())
+          throw GeographicErr("Error opening " + coeff);
+        char id[idlength_ + 1];
+        coeffstr.read(id, idlength_);
+        if (!coeffstr.good())
+          throw GeographicErr("No header in " + coeff);
+        id[idlength_] = '\0';
+        if (_id != string(id))
+          throw GeographicErr("ID mismatch: " + _id + " vs " + id);
+        for (int i = 0; i < _Nmodels + 1 + _Nconstants; ++i) {
+          int N, M;
+          if (truncate) { N = Nmax; M = Mmax; }
+          SphericalEngine::coeff::readcoeffs(coeffstr, N, M, st.G[i], st.H[i],
+                                             truncate);
+          if (!(M < 0 || st.G[i][0] == 0))
+            throw GeographicErr("A degree 0 term is not permitted");
+          _harm.push_back(SphericalHarmonic(st.G[i], st.H[i], N, N, M,
+                                            _a, _norm));
+          _nmx = max(_nmx, _harm.back().Coefficients().nmx());
+          _mmx = max(_mmx, _harm.back().Coefficients().mmx());
+        }
+        int pos = int(coeffstr.tellg());
+        coeffstr.seekg(0, ios::end);
+        if (pos != coeffstr.tellg())
+          throw GeographicErr("Extra data in " + coeff);
+        _loadbytes = (unsigned long long)(pos);
       }
-      int pos = int(coeffstr.tellg());
-      coeffstr.seekg(0, ios::end);
-      if (pos != coeffstr.tellg())
-        throw GeographicErr("Extra data in " + coeff);
+    }
+    _store = store;
+    _loadtime = chrono::duration<double>
+      (chrono::steady_clock::now() - start).count();
+  }
+
+  MagneticModel::MagneticModel(const MagneticModel& m, int Nmax, int Mmax)
+    : _name(m._name)
+    , _dir(m._dir)
+    , _description(m._description)
+    , _date(m._date)
+    , _filename(m._filename)
+    , _id(m._id)
+    , _t0(m._t0)
+    , _dt0(m._dt0)
+    , _tmin(m._tmin)
+    , _tmax(m._tmax)
+    , _a(m._a)
+    , _hmin(m._hmin)
+    , _hmax(m._hmax)
+    , _Nmodels(m._Nmodels)
+    , _Nconstants(m._Nconstants)
+    , _nmx(-1)
+    , _mmx(-1)
+    , _norm(m._norm)
+    , _earth(m._earth)
+    , _store(m._store)
+    , _loadbytes(m._loadbytes)
+    , _loadtime(m._loadtime)
+  {
+    if (Nmax >= 0 && Mmax < 0) Mmax = Nmax;
+    if (Nmax < 0) Nmax = numeric_limits<int>::max();
+    if (Mmax < 0) Mmax = numeric_limits<int>::max();
+    if (!(Nmax >= Mmax))
+      throw GeographicErr("Bad requested degree and order " +
+                          Utility::str(Nmax) + " " + Utility::str(Mmax));
+    _harm.reserve(m._harm.size());
+    for (const SphericalHarmonic& h : m._harm) {
+      _harm.push_back(SphericalHarmonic(h.Coefficients().Truncate(Nmax, Mmax),
+                                        _a, _norm));
+      _nmx = max(_nmx, _harm.back().Coefficients().nmx());
+      _mmx = max(_mmx, _harm.back().Coefficients().mmx());
     }
   }
 
-  void MagneticModel::ReadMetadata(const string& name) {
+  size_t MagneticModel::MemoryUsage() const {
+    const coeffstore& st = *_store;
+    size_t bytes = sizeof(coeffstore) +
+      (st.G.capacity() + st.H.capacity()) * sizeof(vector<real>) +
+      _harm.capacity() * sizeof(SphericalHarmonic) + _circles.MemoryUsage();
+    for (const vector<real>& v : st.G) bytes += v.capacity() * sizeof(real);
+    for (const vector<real>& v : st.H) bytes += v.capacity() * sizeof(real);
+    return bytes;
+  }
+
+  future<shared_ptr<MagneticModel>>
+  MagneticModel::Load(const string& name, const string& path,
+                      const Geocentric& earth, int Nmax, int Mmax,
+                      bool mapped) {
+    return async(launch::async, [=]() -> shared_ptr<MagneticModel> {
+      return make_shared<MagneticModel>(name, path, earth, Nmax, Mmax, mapped);
+    });
+  }
+
+  void MagneticModel::ReadMetadata(istream& metastr) {
     const char* spaces = " \t\n\v\f\r";
-    _filename = _dir + "/" + name + ".wmm";
-    ifstream metastr(_filename.c_str());
-    if (!metastr.good())
-      throw GeographicErr("Cannot open " + _filename);
     string line;
     getline(metastr, line);
     if (!(line.size() >= 6 && line.substr(0,5) == "WMMF-"))
@@ -182,29 +309,29 @@ namespace GeographicLib {
     }
   }
 
-  void MagneticModel::FieldGeocentric(real t, real X, real Y, real Z,
-                                      real& BX, real& BY, real& BZ,
-                                      real& BXt, real& BYt, real& BZt) const {
+  int MagneticModel::Epoch(real& t) const {
     t -= _t0;
     int n = max(min(int(floor(t / _dt0)), _Nmodels - 1), 0);
-    bool interpolate = n + 1 < _Nmodels;
     t -= n * _dt0;
-    // Components in geocentric basis
-    // initial values to suppress warning
-    real BXc = 0, BYc = 0, BZc = 0;
-    _harm[n](X, Y, Z, BX, BY, BZ);
-    _harm[n + 1](X, Y, Z, BXt, BYt, BZt);
-    if (_Nconstants)
-      _harm[_Nmodels + 1](X, Y, Z, BXc, BYc, BZc);
-    if (interpolate) {
-      // Convert to a time derivative
+    return n;
+  }
+
+  void MagneticModel::Combine(real t, int n,
+                              const real B0[], const real B1[],
+                              const real Bc[],
+                              real& BX, real& BY, real& BZ,
+                              real& BXt, real& BYt, real& BZt) const {
+    BX = B0[0]; BY = B0[1]; BZ = B0[2];
+    BXt = B1[0]; BYt = B1[1]; BZt = B1[2];
+    if (n + 1 < _Nmodels) {
+      // Interpolate; convert to a time derivative
       BXt = (BXt - BX) / _dt0;
       BYt = (BYt - BY) / _dt0;
       BZt = (BZt - BZ) / _dt0;
     }
-    BX += t * BXt + BXc;
-    BY += t * BYt + BYc;
-    BZ += t * BZt + BZc;
+    BX += t * BXt + Bc[0];
+    BY += t * BYt + Bc[1];
+    BZ += t * BZt + Bc[2];
 
     BXt = BXt * - _a;
     BYt = BYt * - _a;
@@ -215,9 +342,60 @@ namespace GeographicLib {
     BZ *= - _a;
   }
 
+  void MagneticModel::FieldGeocentric(real t, real X, real Y, real Z,
+                                      real& BX, real& BY, real& BZ,
+                                      real& BXt, real& BYt, real& BZt) const {
+    int n = Epoch(t);
+    // Components in geocentric basis
+    real B0[3], B1[3], Bc[3] = {0, 0, 0};
+    _harm[n](X, Y, Z, B0[0], B0[1], B0[2]);
+    _harm[n + 1](X, Y, Z, B1[0], B1[1], B1[2]);
+    if (_Nconstants)
+      _harm[_Nmodels + 1](X, Y, Z, Bc[0], Bc[1], Bc[2]);
+    Combine(t, n, B0, B1, Bc, BX, BY, BZ, BXt, BYt, BZt);
+  }
+
+  void MagneticModel::FieldGeocentricColumn(real t, real X, real Y, real Z,
+                                            size_t n, const real r[],
+                                            real BX[], real BY[], real BZ[],
+                                            real BXt[], real BYt[],
+                                            real BZt[]) const {
+    bool diffp = BXt && BYt && BZt;
+    int k = Epoch(t);
+    RadialEngine
+      rad0 = _harm[k].Radial(X, Y, Z, true),
+      rad1 = _harm[k + 1].Radial(X, Y, Z, true),
+      radc = _Nconstants ? _harm[_Nmodels + 1].Radial(X, Y, Z, true) :
+      RadialEngine();
+    for (size_t i = 0; i < n; ++i) {
+      real B0[3], B1[3], Bc[3] = {0, 0, 0}, dX, dY, dZ;
+      rad0(r[i], B0[0], B0[1], B0[2]);
+      rad1(r[i], B1[0], B1[1], B1[2]);
+      if (_Nconstants)
+        radc(r[i], Bc[0], Bc[1], Bc[2]);
+      if (diffp)
+        Combine(t, k, B0, B1, Bc, BX[i], BY[i], BZ[i], BXt[i], BYt[i], BZt[i]);
+      else
+        Combine(t, k, B0, B1, Bc, BX[i], BY[i], BZ[i], dX, dY, dZ);
+    }
+  }
+
   void MagneticModel::Field(real t, real lat, real lon, real h, bool diffp,
                             real& Bx, real& By, real& Bz,
                             real& Bxt, real& Byt, real& Bzt) const {
+    if (_circles.Capacity() && !isnan(t)) {
+      real t1 = t;
+      // The circle holds the models for the epoch containing t
+      shared_ptr<const MagneticCircle> c =
+        _circles.Get(lat, h, Epoch(t1), 0,
+                     [this, t](real lat1, real h1) -> MagneticCircle
+                     { return Circle(t, lat1, h1); });
+      if (diffp)
+        (*c)(t, lon, Bx, By, Bz, Bxt, Byt, Bzt);
+      else
+        (*c)(t, lon, Bx, By, Bz);
+      return;
+    }
     real X, Y, Z;
     real M[Geocentric::dim2_];
     _earth.IntForward(lat, lon, h, X, Y, Z, M);
@@ -230,25 +408,196 @@ namespace GeographicLib {
     Geocentric::Unrotate(M, BX, BY, BZ, Bx, By, Bz);
   }
 
+  void MagneticModel::TimeSeries(real X, real Y, real Z, const real M[],
+                                 size_t n, const size_t ind[], const real t[],
+                                 real Bx[], real By[], real Bz[],
+                                 real Bxt[], real Byt[], real Bzt[]) const {
+    // The sums for the models, evaluated as needed
+    int nharm = int(_harm.size());
+    vector<real> B(3 * nharm);
+    vector<bool> done(nharm, false);
+    auto sum = [&](int k) -> const real* {
+      real* b = &B[3 * k];
+      if (!done[k]) {
+        _harm[k](X, Y, Z, b[0], b[1], b[2]);
+        done[k] = true;
+      }
+      return b;
+    };
+    const real zero[3] = {0, 0, 0};
+    for (size_t j = 0; j < n; ++j) {
+      size_t i = ind ? ind[j] : j;
+      real t1 = t[i];
+      int k = Epoch(t1);
+      real BX, BY, BZ, BXt, BYt, BZt;
+      Combine(t1, k, sum(k), sum(k + 1),
+              _Nconstants ? sum(_Nmodels + 1) : zero,
+              BX, BY, BZ, BXt, BYt, BZt);
+      if (Bxt)
+        Geocentric::Unrotate(M, BXt, BYt, BZt, Bxt[i], Byt[i], Bzt[i]);
+      Geocentric::Unrotate(M, BX, BY, BZ, Bx[i], By[i], Bz[i]);
+    }
+  }
+
+  void MagneticModel::FieldTimeSeries(real lat, real lon, real h,
+                                      size_t n, const real t[],
+                                      real Bx[], real By[], real Bz[],
+                                      real Bxt[], real Byt[], real Bzt[])
+    const {
+    real X, Y, Z, M[Geocentric::dim2_];
+    _earth.IntForward(lat, lon, h, X, Y, Z, M);
+    TimeSeries(X, Y, Z, M, n, nullptr, t, Bx, By, Bz, Bxt, Byt, Bzt);
+  }
+
+  void MagneticModel::FieldBatch(size_t n, const real t[], const real lat[],
+                                 const real lon[], const real h[],
+                                 real Bx[], real By[], real Bz[],
+                                 real Bxt[], real Byt[], real Bzt[]) const {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "MagneticModel::FieldBatch", n);
+    auto point = [&](size_t i) -> void {
+      real dummy;
+      if (Bxt)
+        Field(t[i], lat[i], lon[i], h[i], true, Bx[i], By[i], Bz[i],
+              Bxt[i], Byt[i], Bzt[i]);
+      else
+        Field(t[i], lat[i], lon[i], h[i], false, Bx[i], By[i], Bz[i],
+              dummy, dummy, dummy);
+    };
+    // Sort the entries by (lat, lon, h) so that entries at the same position
+    // are adjacent.  Entries with a NaN position are evaluated directly (they
+    // would break the ordering).
+    vector<size_t> ind;
+    ind.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      if (isnan(lat[i]) || isnan(lon[i]) || isnan(h[i]))
+        point(i);
+      else
+        ind.push_back(i);
+    }
+    sort(ind.begin(), ind.end(),
+         [lat, lon, h](size_t i, size_t j) -> bool
+         { return lat[i] < lat[j] ||
+             (lat[i] == lat[j] &&
+              (lon[i] < lon[j] || (lon[i] == lon[j] && h[i] < h[j]))); });
+    for (size_t k0 = 0, k1; k0 < ind.size(); k0 = k1) {
+      size_t i0 = ind[k0];
+      for (k1 = k0 + 1;
+           k1 < ind.size() && lat[ind[k1]] == lat[i0] &&
+             lon[ind[k1]] == lon[i0] && h[ind[k1]] == h[i0];
+           ++k1) {}
+      if (k1 - k0 < 2)
+        point(i0);
+      else {
+        real X, Y, Z, M[Geocentric::dim2_];
+        _earth.IntForward(lat[i0], lon[i0], h[i0], X, Y, Z, M);
+        TimeSeries(X, Y, Z, M, k1 - k0, ind.data() + k0, t,
+                   Bx, By, Bz, Bxt, Byt, Bzt);
+      }
+    }
+  }
+
   MagneticCircle MagneticModel::Circle(real t, real lat, real h) const {
-    real t1 = t - _t0;
-    int n = max(min(int(floor(t1 / _dt0)), _Nmodels - 1), 0);
-    bool interpolate = n + 1 < _Nmodels;
-    t1 -= n * _dt0;
+    return Circle(t, t, lat, h);
+  }
+
+  MagneticCircle MagneticModel::Circle(real tmin, real tmax,
+                                       real lat, real h) const {
+    MagneticCircle circ;
+    Circle(circ, tmin, tmax, lat, h);
+    return circ;
+  }
+
+  void MagneticModel::Circle(MagneticCircle& circ, real tmin, real tmax,
+                             real lat, real h) const {
+    if (tmax < tmin) swap(tmin, tmax);
+    real t1 = tmin, t2 = tmax;
+    int n0 = Epoch(t1), n1 = Epoch(t2) + 1;
     real X, Y, Z, M[Geocentric::dim2_];
     _earth.IntForward(lat, 0, h, X, Y, Z, M);
     // Y = 0, cphi = M[7], sphi = M[8];
+    circ.Reset(_a, _earth._f, lat, h, tmin, M[7], M[8], _t0, _dt0, _Nmodels,
+               n0, _Nconstants != 0);
+    // The CircularEngine objects are reinitialized reusing their storage.
+    circ._circ.resize(n1 - n0 + 1);
+    for (int n = n0; n <= n1; ++n)
+      _harm[n].Circle(X, Z, true, 1, circ._circ[n - n0]);
+    if (_Nconstants)
+      _harm[_Nmodels + 1].Circle(X, Z, true, 1, circ._circc);
+    else
+      circ._circc = CircularEngine();
+  }
+
+  MagneticSnapshot MagneticModel::Snapshot(real t) const {
+    real t1 = t;
+    int n = Epoch(t1);
+    // The weights of models n and n + 1 and of the constant terms in the
+    // field and its rate of change; see Combine.
+    real w0, w1, w0t, w1t;
+    if (n + 1 < _Nmodels) {
+      w0t = -1 / _dt0; w1t = 1 / _dt0;
+    } else {
+      w0t = 0; w1t = 1;
+    }
+    w0 = 1 + t1 * w0t; w1 = t1 * w1t;
+    const int
+      nk = _Nconstants ? 3 : 2,
+      k[3] = { n, n + 1, _Nmodels + 1 };
+    const real
+      w[3] = { w0, w1, 1 },
+      wt[3] = { w0t, w1t, 0 };
+    // The combined coefficients use the layout for degree _nmx and order
+    // _mmx; the models may have been truncated differently.
+    shared_ptr<MagneticSnapshot::coeffstore> store =
+      make_shared<MagneticSnapshot::coeffstore>();
+    MagneticSnapshot::coeffstore& st = *store;
+    auto index = [this](int l, int m) -> int
+      { return m * _nmx - m * (m - 1) / 2 + l; };
+    if (_mmx >= 0) {
+      int nc = index(_nmx, _mmx) + 1;
+      st.G.assign(nc, 0); st.Gt.assign(nc, 0);
+      st.H.assign(nc - (_nmx + 1), 0); st.Ht.assign(nc - (_nmx + 1), 0);
+      for (int j = 0; j < nk; ++j) {
+        const SphericalEngine::coeff& c = _harm[k[j]].Coefficients();
+        // Include the factor -a from Combine
+        const real f = -_a * w[j], ft = -_a * wt[j];
+        for (int m = 0; m <= c.mmx(); ++m)
+          for (int l = m; l <= c.nmx(); ++l) {
+            int i = index(l, m), ic = c.index(l, m);
+            real cv = c.Cv(ic);
+            st.G[i] += f * cv; st.Gt[i] += ft * cv;
+            if (m > 0) {
+              real sv = c.Sv(ic);
+              i -= _nmx + 1;
+              st.H[i] += f * sv; st.Ht[i] += ft * sv;
+            }
+          }
+      }
+    }
+    return MagneticSnapshot(t, _a, _norm, _earth, _nmx, _mmx, store);
+  }
+
+
+  template<class F>
+  void MagneticModel::GenGrid(int nlat, F row, unsigned threads) {
+    if (nlat <= 0) return;
+    Executor::Parallel(size_t(nlat), threads,
+                       [&](size_t i) -> void { row(int(i)); });
+  }
 
-    return (_Nconstants == 0 ?
-            MagneticCircle(_a, _earth._f, lat, h, t,
-                           M[7], M[8], t1, _dt0, interpolate,
-                           _harm[n].Circle(X, Z, true),
-                           _harm[n + 1].Circle(X, Z, true)) :
-            MagneticCircle(_a, _earth._f, lat, h, t,
-                           M[7], M[8], t1, _dt0, interpolate,
-                           _harm[n].Circle(X, Z, true),
-                           _harm[n + 1].Circle(X, Z, true),
-                           _harm[_Nmodels + 1].Circle(X, Z, true)));
+  void MagneticModel::FieldGrid(real t, real h,
+                                real lat0, real dlat, int nlat,
+                                real lon0, real dlon, int nlon,
+                                real Bx[], real By[], real Bz[],
+                                unsigned threads) const {
+    if (nlon <= 0) return;
+    vector<real> lon(nlon);
+    for (int j = 0; j < nlon; ++j) lon[j] = lon0 + j * dlon;
+    GenGrid(nlat,
+            [&](int i) -> void {
+              const MagneticCircle c(Circle(t, lat0 + i * dlat, h));
+              size_t k = size_t(i) * nlon;
+              c(nlon, lon.data(), Bx + k, By + k, Bz + k);
+            }, threads);
   }
 
   void MagneticModel::FieldComponents(real Bx, real By, real Bz,
@@ -287,4 +636,18 @@ namespace GeographicLib {
     return !name.empty() ? name : string(GEOGRAPHICLIB_MAGNETIC_DEFAULT_NAME);
   }
 
+  vector<string> MagneticModel::EmbeddedModels() {
+    vector<string> names;
+    for (const embedded* e = _embedded; e->name; ++e)
+      names.push_back(e->name);
+    return names;
+  }
+
+#if !GEOGRAPHICLIB_MAGNETIC_EMBED
+  // No models are compiled into the library; otherwise this table is defined
+  // in the MagneticModelData.cpp generated by cmake.
+  const MagneticModel::embedded MagneticModel::_embedded[] =
+    { {nullptr, nullptr, 0, nullptr, 0} };
+#endif
+
 } // namespace GeographicLib
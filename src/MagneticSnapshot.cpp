@@ -0,0 +1,47 @@
+/**
+ * \file MagneticSnapshot.cpp
+ * \brief Implementation for GeographicLib::MagneticSnapshot class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/MagneticSnapshot.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  MagneticSnapshot::MagneticSnapshot(real t, real a,
+                                     SphericalHarmonic::normalization norm,
+                                     const Geocentric& earth,
+                                     int nmx, int mmx,
+                                     const shared_ptr<const coeffstore>& store)
+    : _t(t)
+    , _nmx(nmx)
+    , _mmx(mmx)
+    , _earth(earth)
+    , _store(store)
+    , _harm(_store->G, _store->H, _nmx, _nmx, _mmx, a, norm)
+    , _harmt(_store->Gt, _store->Ht, _nmx, _nmx, _mmx, a, norm)
+  {}
+
+  void MagneticSnapshot::Field(real lat, real lon, real h, bool diffp,
+                               real& Bx, real& By, real& Bz,
+                               real& Bxt, real& Byt, real& Bzt) const {
+    real X, Y, Z;
+    real M[Geocentric::dim2_];
+    _earth.IntForward(lat, lon, h, X, Y, Z, M);
+    // Components in geocentric basis
+    real BX, BY, BZ;
+    _harm(X, Y, Z, BX, BY, BZ);
+    if (diffp) {
+      real BXt, BYt, BZt;
+      _harmt(X, Y, Z, BXt, BYt, BZt);
+      Geocentric::Unrotate(M, BXt, BYt, BZt, Bxt, Byt, Bzt);
+    }
+    Geocentric::Unrotate(M, BX, BY, BZ, Bx, By, Bz);
+  }
+
+} // namespace GeographicLib
@@ -11,41 +11,73 @@ MODULES = Accumulator \
 	AlbersEqualArea \
 	AzimuthalEquidistant \
 	CassiniSoldner \
+	ChordMetric \
 	CircularEngine \
+	ClosestApproach \
 	DMS \
+	Dispatch \
+	DistanceMatrix \
 	Ellipsoid \
+	EllipsoidCache \
 	EllipticFunction \
+	ExactAccumulator \
+	Executor \
 	GARS \
+	GeoArrow \
 	GeoCoords \
 	Geocentric \
 	Geodesic \
+	GeodesicCache \
+	GeodesicCluster \
 	GeodesicExact \
+	GeodesicIntersect \
 	GeodesicLine \
 	GeodesicLineExact \
+	GeodesicMetric \
+	GeodesicOrigin \
+	GeodesicPolyline \
+	GeodesicStats \
 	Geohash \
+	GeohashCover \
 	Geoid \
+	GeoidRaster \
 	Georef \
 	Gnomonic \
 	GravityCircle \
 	GravityModel \
+	GravityTrajectory \
+	JacobiConformal \
 	LambertConformalConic \
 	LocalCartesian \
 	MGRS \
+	MGRSGrid \
 	MagneticCircle \
 	MagneticModel \
+	MagneticSnapshot \
+	MappedInput \
 	Math \
 	NormalGravity \
 	OSGB \
+	Pipeline \
 	PolarStereographic \
 	PolygonArea \
+	PolygonAreaBatch \
+	PreparedPolygon \
+	ProjectionRegistry \
+	RadialEngine \
 	Rhumb \
+	SharedData \
 	SphericalEngine \
+	TextColumns \
+	Trace \
 	TransverseMercator \
 	TransverseMercatorExact \
 	UTMUPS \
 	Utility
-EXTRAHEADERS = Constants \
+EXTRAHEADERS = CircleCache \
+	Constants \
 	NearestNeighbor \
+	RasterWarp \
 	SphericalHarmonic \
 	SphericalHarmonic1 \
 	SphericalHarmonic2
@@ -55,7 +87,7 @@ SOURCES = $(addsuffix .cpp,$(MODULES) $(EXTRASOURCES))
 OBJECTS = $(addsuffix .o,$(MODULES) $(EXTRASOURCES))
 
 CC = g++ -g
-CXXFLAGS = -g -Wall -Wextra -O3 -std=c++0x
+CXXFLAGS = -g -Wall -Wextra -O3 -std=c++0x -pthread
 
 CPPFLAGS = -I$(INCLUDEPATH) $(DEFINES) \
 	-DGEOGRAPHICLIB_DATA=\"$(GEOGRAPHICLIB_DATA)\"
@@ -81,65 +113,134 @@ TAGS: $(HEADERS) $(SOURCES)
 Accumulator.o: Accumulator.hpp Config.h Constants.hpp Math.hpp
 AlbersEqualArea.o: AlbersEqualArea.hpp Config.h Constants.hpp Math.hpp
 AzimuthalEquidistant.o: AzimuthalEquidistant.hpp Config.h Constants.hpp \
-	Geodesic.hpp Math.hpp
+	Geodesic.hpp GeodesicExact.hpp GeodesicLine.hpp GeodesicLineExact.hpp \
+	GeodesicOrigin.hpp Math.hpp
 CassiniSoldner.o: CassiniSoldner.hpp Config.h Constants.hpp Geodesic.hpp \
 	GeodesicLine.hpp Math.hpp
+ChordMetric.o: ChordMetric.hpp Config.h Constants.hpp Geocentric.hpp Math.hpp
 CircularEngine.o: CircularEngine.hpp Config.h Constants.hpp Math.hpp \
 	SphericalEngine.hpp
+ClosestApproach.o: ClosestApproach.hpp Config.h Constants.hpp Executor.hpp \
+	Geodesic.hpp GeodesicLine.hpp Math.hpp
 DMS.o: Config.h Constants.hpp DMS.hpp Math.hpp Utility.hpp
+Dispatch.o: Config.h Constants.hpp Dispatch.hpp Math.hpp
+DistanceMatrix.o: Config.h Constants.hpp DistanceMatrix.hpp Executor.hpp \
+	Geodesic.hpp GeodesicExact.hpp Math.hpp
 Ellipsoid.o: Config.h Constants.hpp Ellipsoid.hpp AlbersEqualArea.hpp \
 	EllipticFunction.hpp Math.hpp TransverseMercator.hpp
+EllipsoidCache.o: Config.h Constants.hpp Ellipsoid.hpp EllipsoidCache.hpp \
+	Geodesic.hpp GeodesicExact.hpp Math.hpp Rhumb.hpp TransverseMercator.hpp
 EllipticFunction.o: Config.h Constants.hpp EllipticFunction.hpp Math.hpp
+ExactAccumulator.o: Config.h Constants.hpp ExactAccumulator.hpp Executor.hpp
+Executor.o: Config.h Constants.hpp Executor.hpp
 GARS.o: Config.h Constants.hpp GARS.hpp Utility.hpp
+GeoArrow.o: Accumulator.hpp Config.h Constants.hpp Executor.hpp \
+	GeoArrow.hpp Geodesic.hpp GeodesicExact.hpp Geoid.hpp Math.hpp \
+	PolygonArea.hpp PolygonAreaBatch.hpp Rhumb.hpp UTMUPS.hpp Utility.hpp
 GeoCoords.o: Config.h Constants.hpp DMS.hpp GeoCoords.hpp MGRS.hpp Math.hpp \
 	UTMUPS.hpp Utility.hpp
 Geocentric.o: Config.h Constants.hpp Geocentric.hpp Math.hpp
-Geodesic.o: Config.h Constants.hpp Geodesic.hpp GeodesicLine.hpp Math.hpp
-GeodesicExact.o: Config.h Constants.hpp GeodesicExact.hpp \
-	GeodesicLineExact.hpp Math.hpp
+Geodesic.o: Config.h Constants.hpp Geodesic.hpp GeodesicLine.hpp \
+	GeodesicStats.hpp Math.hpp Trace.hpp
+GeodesicCache.o: Config.h Constants.hpp Geodesic.hpp GeodesicCache.hpp \
+	Math.hpp
+GeodesicCluster.o: Config.h Constants.hpp Executor.hpp Geodesic.hpp \
+	GeodesicCluster.hpp GeodesicExact.hpp GeodesicLine.hpp \
+	GeodesicLineExact.hpp GeodesicOrigin.hpp Gnomonic.hpp Math.hpp
+GeodesicExact.o: Config.h Constants.hpp Executor.hpp GeodesicExact.hpp \
+	GeodesicLineExact.hpp GeodesicStats.hpp Math.hpp Trace.hpp
 GeodesicExactC4.o: Config.h Constants.hpp GeodesicExact.hpp Math.hpp
+GeodesicIntersect.o: Config.h Constants.hpp Executor.hpp Geodesic.hpp \
+	GeodesicExact.hpp GeodesicIntersect.hpp GeodesicLine.hpp \
+	GeodesicLineExact.hpp GeodesicOrigin.hpp Gnomonic.hpp Math.hpp
 GeodesicLine.o: Config.h Constants.hpp Geodesic.hpp GeodesicLine.hpp Math.hpp
 GeodesicLineExact.o: Config.h Constants.hpp GeodesicExact.hpp \
 	GeodesicLineExact.hpp Math.hpp
+GeodesicMetric.o: Config.h Constants.hpp Geodesic.hpp GeodesicExact.hpp \
+	GeodesicMetric.hpp Math.hpp
+GeodesicOrigin.o: Config.h Constants.hpp Geodesic.hpp GeodesicExact.hpp \
+	GeodesicLine.hpp GeodesicLineExact.hpp GeodesicOrigin.hpp Math.hpp
+GeodesicPolyline.o: Accumulator.hpp Config.h Constants.hpp Geodesic.hpp \
+	GeodesicLine.hpp GeodesicPolyline.hpp Math.hpp
+GeodesicStats.o: Config.h Constants.hpp GeodesicStats.hpp
 Geohash.o: Config.h Constants.hpp Geohash.hpp Utility.hpp
-Geoid.o: Config.h Constants.hpp Geoid.hpp Math.hpp
+GeohashCover.o: Config.h Constants.hpp Executor.hpp Geodesic.hpp \
+	GeodesicExact.hpp GeodesicLine.hpp Geohash.hpp GeohashCover.hpp Math.hpp \
+	PreparedPolygon.hpp Utility.hpp
+Geoid.o: Config.h Constants.hpp Executor.hpp Geoid.hpp Math.hpp \
+	SharedData.hpp Trace.hpp Utility.hpp
+GeoidRaster.o: Config.h Constants.hpp Geoid.hpp GeoidRaster.hpp Math.hpp \
+	SharedData.hpp Utility.hpp
 Georef.o: Config.h Constants.hpp Georef.hpp Utility.hpp
-Gnomonic.o: Config.h Constants.hpp Geodesic.hpp GeodesicLine.hpp Gnomonic.hpp \
+Gnomonic.o: Config.h Constants.hpp Geodesic.hpp GeodesicExact.hpp \
+	GeodesicLine.hpp GeodesicLineExact.hpp GeodesicOrigin.hpp Gnomonic.hpp \
 	Math.hpp
-GravityCircle.o: CircularEngine.hpp Config.h Constants.hpp Geocentric.hpp \
-	GravityCircle.hpp GravityModel.hpp Math.hpp NormalGravity.hpp \
-	SphericalEngine.hpp SphericalHarmonic.hpp SphericalHarmonic1.hpp
-GravityModel.o: CircularEngine.hpp Config.h Constants.hpp Geocentric.hpp \
-	GravityCircle.hpp GravityModel.hpp Math.hpp NormalGravity.hpp \
-	SphericalEngine.hpp SphericalHarmonic.hpp SphericalHarmonic1.hpp \
-	Utility.hpp
+GravityCircle.o: CircleCache.hpp CircularEngine.hpp Config.h Constants.hpp \
+	Geocentric.hpp GravityCircle.hpp GravityModel.hpp Math.hpp \
+	NormalGravity.hpp RadialEngine.hpp SphericalEngine.hpp \
+	SphericalHarmonic.hpp SphericalHarmonic1.hpp
+GravityModel.o: CircleCache.hpp CircularEngine.hpp Config.h Constants.hpp \
+	Executor.hpp Geocentric.hpp GravityCircle.hpp GravityModel.hpp Math.hpp \
+	NormalGravity.hpp RadialEngine.hpp SphericalEngine.hpp \
+	SphericalHarmonic.hpp SphericalHarmonic1.hpp Trace.hpp Utility.hpp
+GravityTrajectory.o: CircleCache.hpp CircularEngine.hpp Config.h \
+	Constants.hpp Geocentric.hpp GravityModel.hpp GravityTrajectory.hpp \
+	Math.hpp NormalGravity.hpp RadialEngine.hpp SphericalEngine.hpp \
+	SphericalHarmonic.hpp SphericalHarmonic1.hpp
+JacobiConformal.o: Config.h Constants.hpp EllipticFunction.hpp \
+	JacobiConformal.hpp Math.hpp
 LambertConformalConic.o: Config.h Constants.hpp LambertConformalConic.hpp \
 	Math.hpp
 LocalCartesian.o: Config.h Constants.hpp Geocentric.hpp LocalCartesian.hpp \
 	Math.hpp
-MGRS.o: Config.h Constants.hpp MGRS.hpp Math.hpp UTMUPS.hpp Utility.hpp
+MGRS.o: Config.h Constants.hpp MGRS.hpp Math.hpp Trace.hpp UTMUPS.hpp \
+	Utility.hpp
+MGRSGrid.o: Config.h Constants.hpp MGRS.hpp MGRSGrid.hpp Math.hpp UTMUPS.hpp \
+	Utility.hpp
 MagneticCircle.o: CircularEngine.hpp Config.h Constants.hpp Geocentric.hpp \
 	MagneticCircle.hpp Math.hpp SphericalEngine.hpp
-MagneticModel.o: CircularEngine.hpp Config.h Constants.hpp Geocentric.hpp \
-	MagneticCircle.hpp MagneticModel.hpp Math.hpp SphericalEngine.hpp \
-	SphericalHarmonic.hpp Utility.hpp
-Math.o: Config.h Constants.hpp Math.hpp
+MagneticModel.o: CircleCache.hpp CircularEngine.hpp Config.h Constants.hpp \
+	Executor.hpp Geocentric.hpp MagneticCircle.hpp MagneticModel.hpp \
+	MagneticSnapshot.hpp Math.hpp RadialEngine.hpp SphericalEngine.hpp \
+	SphericalHarmonic.hpp Trace.hpp Utility.hpp
+MagneticSnapshot.o: CircularEngine.hpp Config.h Constants.hpp Geocentric.hpp \
+	MagneticSnapshot.hpp Math.hpp RadialEngine.hpp SphericalEngine.hpp \
+	SphericalHarmonic.hpp
+MappedInput.o: Config.h Constants.hpp MappedInput.hpp Math.hpp
+Math.o: Config.h Constants.hpp Dispatch.hpp Math.hpp MathInline.hpp
 NormalGravity.o: Config.h Constants.hpp Geocentric.hpp Math.hpp \
 	NormalGravity.hpp
 OSGB.o: Config.h Constants.hpp Math.hpp OSGB.hpp TransverseMercator.hpp \
 	Utility.hpp
+Pipeline.o: Config.h Constants.hpp DMS.hpp GeoCoords.hpp Geocentric.hpp \
+	Geoid.hpp LocalCartesian.hpp MGRS.hpp Math.hpp Pipeline.hpp \
+	TextColumns.hpp UTMUPS.hpp Utility.hpp
 PolarStereographic.o: Config.h Constants.hpp Math.hpp PolarStereographic.hpp
-PolygonArea.o: Accumulator.hpp Config.h Constants.hpp Geodesic.hpp Math.hpp \
-	PolygonArea.hpp
-Rhumb.o: Config.h Constants.hpp Ellipsoid.hpp Math.hpp Rhumb.hpp \
-	AlbersEqualArea.hpp EllipticFunction.hpp TransverseMercator.hpp
-SphericalEngine.o: CircularEngine.hpp Config.h Constants.hpp Math.hpp \
-	SphericalEngine.hpp Utility.hpp
-TransverseMercator.o: Config.h Constants.hpp Math.hpp TransverseMercator.hpp
+PolygonArea.o: Accumulator.hpp Config.h Constants.hpp Executor.hpp \
+	Geodesic.hpp Math.hpp PolygonArea.hpp
+PolygonAreaBatch.o: Config.h Constants.hpp ExactAccumulator.hpp Executor.hpp \
+	Math.hpp PolygonArea.hpp PolygonAreaBatch.hpp
+PreparedPolygon.o: Config.h Constants.hpp Geodesic.hpp GeodesicExact.hpp \
+	Math.hpp PreparedPolygon.hpp
+ProjectionRegistry.o: AlbersEqualArea.hpp Config.h Constants.hpp \
+	LambertConformalConic.hpp Math.hpp ProjectionRegistry.hpp \
+	TransverseMercator.hpp
+RadialEngine.o: Config.h Constants.hpp Math.hpp RadialEngine.hpp \
+	SphericalEngine.hpp
+Rhumb.o: AlbersEqualArea.hpp Config.h Constants.hpp Ellipsoid.hpp \
+	EllipticFunction.hpp Math.hpp Rhumb.hpp Trace.hpp TransverseMercator.hpp
+SharedData.o: Config.h Constants.hpp SharedData.hpp
+SphericalEngine.o: CircularEngine.hpp Config.h Constants.hpp Executor.hpp \
+	Math.hpp RadialEngine.hpp SharedData.hpp SphericalEngine.hpp Utility.hpp
+TextColumns.o: Config.h Constants.hpp DMS.hpp Math.hpp TextColumns.hpp \
+	Utility.hpp
+Trace.o: Config.h Constants.hpp Trace.hpp
+TransverseMercator.o: Config.h Constants.hpp Math.hpp Trace.hpp \
+	TransverseMercator.hpp
 TransverseMercatorExact.o: Config.h Constants.hpp EllipticFunction.hpp \
 	Math.hpp TransverseMercatorExact.hpp
 UTMUPS.o: Config.h Constants.hpp MGRS.hpp Math.hpp PolarStereographic.hpp \
-	TransverseMercator.hpp UTMUPS.hpp Utility.hpp
+	Trace.hpp TransverseMercator.hpp UTMUPS.hpp Utility.hpp
 Utility.o: Config.h Constants.hpp Math.hpp Utility.hpp
 
 .PHONY: all install clean
@@ -0,0 +1,110 @@
+/**
+ * \file MappedInput.cpp
+ * \brief Implementation for GeographicLib::MappedInput class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <cstring>
+#include <GeographicLib/MappedInput.hpp>
+
+#if !defined(_WIN32)
+// For mmap
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  bool MappedInput::mapbuf::line(const char*& p, size_t& n) {
+    char* b = gptr();
+    char* e = egptr();
+    if (b == e) return false;
+    char* nl = static_cast<char*>(memchr(b, '\n', size_t(e - b)));
+    p = b;
+    n = size_t((nl ? nl : e) - b);
+    setg(eback(), nl ? nl + 1 : e, e);
+    return true;
+  }
+
+  MappedInput::MappedInput()
+    : istream(nullptr)
+    , _addr(nullptr)
+    , _size(0)
+    , _mapped(false)
+  {}
+
+  MappedInput::MappedInput(const string& file, ios::openmode mode)
+    : MappedInput()
+  { open(file, mode); }
+
+  MappedInput::~MappedInput() { close(); }
+
+  void MappedInput::open(const string& file, ios::openmode mode) {
+    close();
+#if !defined(_WIN32)
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd >= 0) {
+      struct stat st;
+      // Only regular files are mapped; pipes, etc., are read with _file so
+      // that input is processed as it arrives.
+      if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        _size = size_t(st.st_size);
+        if (_size == 0)
+          _mapped = true;
+        else {
+          void* addr = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+          if (addr != MAP_FAILED) {
+            _addr = addr;
+            _mapped = true;
+#if defined(MADV_SEQUENTIAL)
+            madvise(_addr, _size, MADV_SEQUENTIAL);
+#endif
+          } else
+            _size = 0;
+        }
+      }
+      ::close(fd);              // the mapping remains valid
+    }
+#endif
+    if (_mapped) {
+      // The buffer is only read; setg requires a non-const pointer.
+      char* b = static_cast<char*>(_addr);
+      _map.set(b, b + _size);
+      rdbuf(&_map);
+    } else if (_file.open(file.c_str(), mode | ios::in))
+      rdbuf(&_file);
+    else
+      setstate(ios::failbit);
+  }
+
+  void MappedInput::close() {
+#if !defined(_WIN32)
+    if (_addr) munmap(_addr, _size);
+#endif
+    _addr = nullptr; _size = 0; _mapped = false;
+    _map.set(nullptr, nullptr);
+    if (_file.is_open()) _file.close();
+    rdbuf(nullptr);
+  }
+
+  bool MappedInput::NextLine(const char*& line, size_t& len) {
+    if (_mapped) {
+      if (!good() || !_map.line(line, len)) {
+        setstate(ios::eofbit | ios::failbit);
+        return false;
+      }
+      return true;
+    }
+    if (!std::getline(*this, _line)) return false;
+    line = _line.data(); len = _line.size();
+    return true;
+  }
+
+} // namespace GeographicLib
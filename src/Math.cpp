@@ -8,6 +8,9 @@
  **********************************************************************/
 
 #include <GeographicLib/Math.hpp>
+#include <GeographicLib/MathInline.hpp>
+#include <GeographicLib/Dispatch.hpp>
+#include <cfloat>
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions
@@ -54,157 +57,276 @@ namespace GeographicLib {
       digits10() - numeric_limits<double>::digits10 : 0;
   }
 
-  template<typename T> T Math::hypot(T x, T y) {
-    using std::hypot; return hypot(x, y);
-  }
-
-  template<typename T> T Math::expm1(T x) {
-    using std::expm1; return expm1(x);
-  }
+  // The scalar functions, hypot through atand, are defined in
+  // MathInline.hpp.
 
-  template<typename T> T Math::log1p(T x) {
-    using std::log1p; return log1p(x);
-  }
+  namespace {
+    // The batch routines process the arrays in blocks of this size
+    const size_t mathblock = 64;
 
-  template<typename T> T Math::asinh(T x) {
-    using std::asinh; return asinh(x);
-  }
+    // The fast versions of the batch routines are used for the IEEE binary
+    // types; other types call the scalar routines.
+    template<typename T> struct batchfast : false_type {};
+    template<> struct batchfast<float> : true_type {};
+    template<> struct batchfast<double> : true_type {};
+    template<> struct batchfast<long double> : true_type {};
 
-  template<typename T> T Math::atanh(T x) {
-    using std::atanh; return atanh(x);
-  }
+    // 2^n as a compile-time constant
+    template<typename T> constexpr T pow2(int n)
+    { return n == 0 ? T(1) : 2 * pow2<T>(n - 1); }
 
-  template<typename T> T Math::copysign(T x, T y) {
-    using std::copysign; return copysign(x, y);
-  }
+    // Can x be reduced by remfast?  This is false for NaNs and infinities.
+    template<typename T> GEOGRAPHICLIB_KERNEL_INLINE bool remok(T x) {
+      constexpr T bound = pow2<T>(numeric_limits<T>::digits - 8);
+      return abs(x) <= bound;
+    }
 
-  template<typename T> T Math::cbrt(T x) {
-    using std::cbrt; return cbrt(x);
-  }
+    // Round x to the nearest integer (with ties going to the even integer)
+    // for |x| < 2^(digits-2) by adding and subtracting 1.5 * 2^(digits-1).
+    // Unlike nearbyint, this is vectorized by compilers for the baseline
+    // x86-64 architecture.
+    template<typename T> GEOGRAPHICLIB_KERNEL_INLINE T roundfast(T x) {
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+      constexpr T magic = 3 * pow2<T>(numeric_limits<T>::digits - 2);
+      return (x + magic) - magic;
+#else
+      // Extra precision for intermediate results defeats the magic number
+      return nearbyint(x);
+#endif
+    }
 
-  template<typename T> T Math::remainder(T x, T y) {
-    using std::remainder; return remainder(x, y);
-  }
+    // Set r = x - q * y exactly, where q is the integer nearest to x/y (with
+    // ties going to the even integer), for remok(x) and y = 90 or 360.  (For
+    // other x, the results are meaningless but no exception is raised.)  This
+    // gives the same results as remquo and remainder, which are not
+    // vectorized by compilers.  Here q * y is exact because |q| <
+    // 2^(digits-14) and x - q * y is exact because the result is
+    // representable.  If the division rounds x / y to a half-integer when
+    // the exact quotient isn't one, q might be off by one; this is corrected
+    // by the final adjustment.
+    template<typename T> GEOGRAPHICLIB_KERNEL_INLINE
+    T remfast(T x, T y, T& q) {
+      T q1 = roundfast(x / y);
+      T r = x - q1 * y,
+        // Conditional arithmetic is written as selects so that the compiler
+        // doesn't need to speculate floating point operations (which it
+        // won't do with -ftrapping-math, the default)
+        adj = (r > y/2 ? T(1) : T(0)) - (r < -y/2 ? T(1) : T(0));
+      r -= adj * y; q1 += adj;
+      // The sign of a zero result is the sign of x
+      r = r == 0 ? copysign(T(0), x) : r;
+      q = q1;
+      return r;
+    }
 
-  template<typename T> T Math::remquo(T x, T y, int* n) {
-    using std::remquo; return remquo(x, y, n);
-  }
+    // The kernels for the fast versions of the batch routines.  These are
+    // compiled for each of the instruction set levels in Dispatch.
+    template<typename T> GEOGRAPHICLIB_KERNEL_INLINE
+    void sincosdkernel(size_t n, const T x[], T sinx[], T cosx[]) {
+      const T degree = Math::degree<T>();
+      T rb[mathblock], sb[mathblock], cb[mathblock];
+      unsigned qb[mathblock];
+      for (size_t i0 = 0; i0 < n; i0 += mathblock) {
+        size_t m = min(mathblock, n - i0);
+        // Reduce the arguments to [-45, 45] (vectorizable).  This loop has no
+        // tests on the arguments; the results are discarded if !remok(x).
+        for (size_t i = 0; i < m; ++i) {
+          T q, r = remfast(x[i0 + i], T(90), q),
+            // Only q mod 4 is needed; q - 4 * roundfast(q/4) is exact and lies
+            // in [-2, 2] (or is a NaN), so it can be converted to an int.
+            q4 = q - 4 * roundfast(q / 4);
+          rb[i] = r * degree;
+          qb[i] = unsigned(int(isnan(q4) ? T(0) : q4)) & 3U;
+        }
+        // Library calls; the rare out of range arguments go to sincosd
+        for (size_t i = 0; i < m; ++i) {
+          if (remok(x[i0 + i])) {
+            sb[i] = sin(rb[i]); cb[i] = cos(rb[i]);
+          } else {
+            Math::sincosd(x[i0 + i], sb[i], cb[i]);
+            qb[i] = 0U;
+          }
+        }
+        // Map to the correct quadrant (vectorizable)
+        for (size_t i = 0; i < m; ++i) {
+          // This is the switch in sincosd written with selects
+          unsigned q = qb[i];
+          T s = q & 1U ? cb[i] : sb[i], c = q & 1U ? sb[i] : cb[i],
+            sx = q & 2U ? -s : s, cx = (q + 1U) & 2U ? -c : c,
+            // Set sign of 0 results.  -0 only produced for sin(-0).  Adding
+            // -0 leaves all values unchanged.
+            z = x[i0 + i] != 0 ? T(0) : -T(0);
+          sinx[i0 + i] = sx + z; cosx[i0 + i] = cx + z;
+        }
+      }
+    }
 
-  template<typename T> T Math::round(T x) {
-    using std::round; return round(x);
-  }
+    template<typename T> GEOGRAPHICLIB_KERNEL_INLINE
+    void atan2dkernel(size_t n, const T y[], const T x[], T ang[]) {
+      const T degree = Math::degree<T>();
+      T xb[mathblock], yb[mathblock], ab[mathblock];
+      bool ypos[mathblock];
+      int qb[mathblock];
+      for (size_t i0 = 0; i0 < n; i0 += mathblock) {
+        size_t m = min(mathblock, n - i0);
+        // Rearrange the arguments as in atan2d (vectorizable)
+        for (size_t i = 0; i < m; ++i) {
+          T xi = x[i0 + i], yi = y[i0 + i];
+          int q = 0;
+          if (abs(yi) > abs(xi)) { swap(xi, yi); q = 2; }
+          if (xi < 0) { xi = -xi; ++q; }
+          xb[i] = xi; yb[i] = yi; qb[i] = q; ypos[i] = yi >= 0;
+        }
+        for (size_t i = 0; i < m; ++i)
+          ab[i] = atan2(yb[i], xb[i]) / degree;
+        // Map to the correct quadrant (vectorizable)
+        for (size_t i = 0; i < m; ++i) {
+          // This is the switch in atan2d written with selects
+          T a = ab[i], a1 = (ypos[i] ? 180 : -180) - a, a2 = 90 - a,
+            a3 = -90 + a;
+          int q = qb[i];
+          ang[i0 + i] = q == 1 ? a1 : (q == 2 ? a2 : (q == 3 ? a3 : a));
+        }
+      }
+    }
 
-  template<typename T> long Math::lround(T x) {
-    using std::lround; return lround(x);
-  }
+    template<typename T> GEOGRAPHICLIB_KERNEL_INLINE
+    void angdiffkernel(size_t n, const T x[], const T y[], T d[], T e[]) {
+      T xb[mathblock], yb[mathblock];
+      for (size_t i0 = 0; i0 < n; i0 += mathblock) {
+        size_t m = min(mathblock, n - i0);
+        // Reduce the arguments to [-180, 180] (vectorizable)
+        for (size_t i = 0; i < m; ++i) {
+          T q;
+          xb[i] = remfast(-x[i0 + i], T(360), q);
+          yb[i] = remfast( y[i0 + i], T(360), q);
+        }
+        // The rare out of range arguments go to remainder
+        for (size_t i = 0; i < m; ++i)
+          if (!(remok(x[i0 + i]) && remok(y[i0 + i]))) {
+            xb[i] = remainder(-x[i0 + i], T(360));
+            yb[i] = remainder( y[i0 + i], T(360));
+          }
+        // The rest of AngDiff; the argument to remfast is in [-360, 360]
+        for (size_t i = 0; i < m; ++i) {
+          T t, q, ei,
+            di = remfast(Math::sum(xb[i], yb[i], t), T(360), q);
+          if (di == -180) di = 180;
+          di = Math::sum(di == 180 && t > 0 ? -180 : di, t, ei);
+          d[i0 + i] = di;
+          if (e) e[i0 + i] = ei;
+        }
+      }
+    }
 
-  template<typename T> T Math::fma(T x, T y, T z) {
-    using std::fma; return fma(x, y, z);
-  }
+    // The variants of the kernels
+    template<typename T>
+    void sincosdgeneric(size_t n, const T x[], T sinx[], T cosx[])
+    { sincosdkernel(n, x, sinx, cosx); }
+    template<typename T>
+    void atan2dgeneric(size_t n, const T y[], const T x[], T ang[])
+    { atan2dkernel(n, y, x, ang); }
+    template<typename T>
+    void angdiffgeneric(size_t n, const T x[], const T y[], T d[], T e[])
+    { angdiffkernel(n, x, y, d, e); }
+#if GEOGRAPHICLIB_DISPATCH
+    template<typename T> GEOGRAPHICLIB_TARGET_AVX2
+    void sincosdavx2(size_t n, const T x[], T sinx[], T cosx[])
+    { sincosdkernel(n, x, sinx, cosx); }
+    template<typename T> GEOGRAPHICLIB_TARGET_AVX2
+    void atan2davx2(size_t n, const T y[], const T x[], T ang[])
+    { atan2dkernel(n, y, x, ang); }
+    template<typename T> GEOGRAPHICLIB_TARGET_AVX2
+    void angdiffavx2(size_t n, const T x[], const T y[], T d[], T e[])
+    { angdiffkernel(n, x, y, d, e); }
+    template<typename T> GEOGRAPHICLIB_TARGET_AVX512
+    void sincosdavx512(size_t n, const T x[], T sinx[], T cosx[])
+    { sincosdkernel(n, x, sinx, cosx); }
+    template<typename T> GEOGRAPHICLIB_TARGET_AVX512
+    void atan2davx512(size_t n, const T y[], const T x[], T ang[])
+    { atan2dkernel(n, y, x, ang); }
+    template<typename T> GEOGRAPHICLIB_TARGET_AVX512
+    void angdiffavx512(size_t n, const T x[], const T y[], T d[], T e[])
+    { angdiffkernel(n, x, y, d, e); }
+#endif
 
-  template<typename T> T Math::sum(T u, T v, T& t) {
-    GEOGRAPHICLIB_VOLATILE T s = u + v;
-    GEOGRAPHICLIB_VOLATILE T up = s - v;
-    GEOGRAPHICLIB_VOLATILE T vpp = s - up;
-    up -= u;
-    vpp -= v;
-    t = -(up + vpp);
-    // u + v =       s      + t
-    //       = round(u + v) + t
-    return s;
-  }
+    // The table of kernels, set on first use
+    template<typename T> struct mathkernels {
+      void (*sincosd)(size_t, const T*, T*, T*);
+      void (*atan2d)(size_t, const T*, const T*, T*);
+      void (*angdiff)(size_t, const T*, const T*, T*, T*);
+      mathkernels()
+        : sincosd(GEOGRAPHICLIB_DISPATCH_SELECT(&sincosdgeneric<T>,
+                                                &sincosdavx2<T>,
+                                                &sincosdavx512<T>))
+        , atan2d(GEOGRAPHICLIB_DISPATCH_SELECT(&atan2dgeneric<T>,
+                                               &atan2davx2<T>,
+                                               &atan2davx512<T>))
+        , angdiff(GEOGRAPHICLIB_DISPATCH_SELECT(&angdiffgeneric<T>,
+                                                &angdiffavx2<T>,
+                                                &angdiffavx512<T>))
+      {}
+    };
+
+    template<typename T> const mathkernels<T>& kernels() {
+      static const mathkernels<T> k;
+      return k;
+    }
 
-  template<typename T> T Math::AngRound(T x) {
-    static const T z = 1/T(16);
-    if (x == 0) return 0;
-    GEOGRAPHICLIB_VOLATILE T y = abs(x);
-    // The compiler mustn't "simplify" z - (z - y) to y
-    y = y < z ? z - (z - y) : y;
-    return x < 0 ? -y : y;
-  }
+    template<typename T>
+    void sincosdbatch(size_t n, const T x[], T sinx[], T cosx[], false_type) {
+      for (size_t i = 0; i < n; ++i) {
+        T s, c;
+        Math::sincosd(x[i], s, c);
+        sinx[i] = s; cosx[i] = c;
+      }
+    }
 
-  template<typename T> void Math::sincosd(T x, T& sinx, T& cosx) {
-    // In order to minimize round-off errors, this function exactly reduces
-    // the argument to the range [-45, 45] before converting it to radians.
-    using std::remquo;
-    T r; int q = 0;
-    // N.B. the implementation of remquo in glibc pre 2.22 were buggy.  See
-    // https://sourceware.org/bugzilla/show_bug.cgi?id=17569
-    // This was fixed in version 2.22 on 2015-08-05
-    r = remquo(x, T(90), &q);   // now abs(r) <= 45
-    r *= degree<T>();
-    // g++ -O turns these two function calls into a call to sincos
-    T s = sin(r), c = cos(r);
-    switch (unsigned(q) & 3U) {
-    case 0U: sinx =  s; cosx =  c; break;
-    case 1U: sinx =  c; cosx = -s; break;
-    case 2U: sinx = -s; cosx = -c; break;
-    default: sinx = -c; cosx =  s; break; // case 3U
+    template<typename T>
+    void sincosdbatch(size_t n, const T x[], T sinx[], T cosx[], true_type)
+    { kernels<T>().sincosd(n, x, sinx, cosx); }
+
+    template<typename T>
+    void atan2dbatch(size_t n, const T y[], const T x[], T ang[], false_type)
+    { atan2dkernel(n, y, x, ang); }
+
+    template<typename T>
+    void atan2dbatch(size_t n, const T y[], const T x[], T ang[], true_type)
+    { kernels<T>().atan2d(n, y, x, ang); }
+
+    template<typename T>
+    void angdiffbatch(size_t n, const T x[], const T y[], T d[], T e[],
+                      false_type) {
+      for (size_t i = 0; i < n; ++i) {
+        T ei;
+        d[i] = Math::AngDiff(x[i], y[i], ei);
+        if (e) e[i] = ei;
+      }
     }
-    // Set sign of 0 results.  -0 only produced for sin(-0)
-    if (x != 0) { sinx += T(0); cosx += T(0); }
-  }
 
-  template<typename T> T Math::sind(T x) {
-    // See sincosd
-    using std::remquo;
-    T r; int q = 0;
-    r = remquo(x, T(90), &q); // now abs(r) <= 45
-    r *= degree<T>();
-    unsigned p = unsigned(q);
-    r = p & 1U ? cos(r) : sin(r);
-    if (p & 2U) r = -r;
-    if (x != 0) r += T(0);
-    return r;
+    template<typename T>
+    void angdiffbatch(size_t n, const T x[], const T y[], T d[], T e[],
+                      true_type)
+    { kernels<T>().angdiff(n, x, y, d, e); }
   }
 
-  template<typename T> T Math::cosd(T x) {
-    // See sincosd
-    using std::remquo;
-    T r; int q = 0;
-    r = remquo(x, T(90), &q); // now abs(r) <= 45
-    r *= degree<T>();
-    unsigned p = unsigned(q + 1);
-    r = p & 1U ? cos(r) : sin(r);
-    if (p & 2U) r = -r;
-    return T(0) + r;
+  template<typename T> void Math::sincosdBatch(size_t n, const T x[],
+                                               T sinx[], T cosx[]) {
+    sincosdbatch(n, x, sinx, cosx, batchfast<T>());
   }
 
-  template<typename T> T Math::tand(T x) {
-    static const T overflow = 1 / sq(numeric_limits<T>::epsilon());
-    T s, c;
-    sincosd(x, s, c);
-    return c != 0 ? s / c : (s < 0 ? -overflow : overflow);
+  template<typename T> void Math::atan2dBatch(size_t n,
+                                              const T y[], const T x[],
+                                              T ang[]) {
+    atan2dbatch(n, y, x, ang, batchfast<T>());
   }
 
-  template<typename T> T Math::atan2d(T y, T x) {
-    // In order to minimize round-off errors, this function rearranges the
-    // arguments so that result of atan2 is in the range [-pi/4, pi/4] before
-    // converting it to degrees and mapping the result to the correct
-    // quadrant.
-    int q = 0;
-    if (abs(y) > abs(x)) { swap(x, y); q = 2; }
-    if (x < 0) { x = -x; ++q; }
-    // here x >= 0 and x >= abs(y), so angle is in [-pi/4, pi/4]
-    T ang = atan2(y, x) / degree<T>();
-    switch (q) {
-      // Note that atan2d(-0.0, 1.0) will return -0.  However, we expect that
-      // atan2d will not be called with y = -0.  If need be, include
-      //
-      //   case 0: ang = 0 + ang; break;
-      //
-      // and handle mpfr as in AngRound.
-    case 1: ang = (y >= 0 ? 180 : -180) - ang; break;
-    case 2: ang =  90 - ang; break;
-    case 3: ang = -90 + ang; break;
-    default: break;
-    }
-    return ang;
+  template<typename T> void Math::AngDiffBatch(size_t n,
+                                               const T x[], const T y[],
+                                               T d[], T e[]) {
+    angdiffbatch(n, x, y, d, e, batchfast<T>());
   }
 
-  template<typename T> T Math::atand(T x)
-  { return atan2d(x, T(1)); }
-
   template<typename T> T Math::eatanhe(T x, T es)  {
     using std::atanh;
     return es > T(0) ? es * atanh(es * x) : -es * atan(es * x);
@@ -308,6 +430,12 @@ namespace GeographicLib {
   template T    GEOGRAPHICLIB_EXPORT Math::tand     <T>(T);             \
   template T    GEOGRAPHICLIB_EXPORT Math::atan2d   <T>(T, T);          \
   template T    GEOGRAPHICLIB_EXPORT Math::atand    <T>(T);             \
+  template void GEOGRAPHICLIB_EXPORT Math::sincosdBatch                 \
+  <T>(size_t, const T[], T[], T[]);                                     \
+  template void GEOGRAPHICLIB_EXPORT Math::atan2dBatch                  \
+  <T>(size_t, const T[], const T[], T[]);                               \
+  template void GEOGRAPHICLIB_EXPORT Math::AngDiffBatch                 \
+  <T>(size_t, const T[], const T[], T[], T[]);                          \
   template T    GEOGRAPHICLIB_EXPORT Math::eatanhe  <T>(T, T);          \
   template T    GEOGRAPHICLIB_EXPORT Math::taupf    <T>(T, T);          \
   template T    GEOGRAPHICLIB_EXPORT Math::tauf     <T>(T, T);          \
@@ -247,6 +247,38 @@ namespace GeographicLib {
     return Ures;
   }
 
+  void NormalGravity::SurfaceGravity(size_t n, const real lat[],
+                                     real gamma[]) const {
+    for (size_t i = 0; i < n; ++i)
+      gamma[i] = SurfaceGravity(lat[i]);
+  }
+
+  void NormalGravity::Gravity(size_t n, const real lat[], const real h[],
+                              real gammay[], real gammaz[],
+                              real Ures[]) const {
+    for (size_t i = 0; i < n; ++i) {
+      real u;
+      if (h[i] == 0) {
+        // On the ellipsoid, gravity is normal to the surface and U = U0.
+        gammay[i] = 0;
+        gammaz[i] = - SurfaceGravity(lat[i]);
+        u = _U0;
+      } else
+        u = Gravity(lat[i], h[i], gammay[i], gammaz[i]);
+      if (Ures) Ures[i] = u;
+    }
+  }
+
+  void NormalGravity::U(size_t n,
+                        const real X[], const real Y[], const real Z[],
+                        real gammaX[], real gammaY[], real gammaZ[],
+                        real Ures[]) const {
+    for (size_t i = 0; i < n; ++i) {
+      real u = U(X[i], Y[i], Z[i], gammaX[i], gammaY[i], gammaZ[i]);
+      if (Ures) Ures[i] = u;
+    }
+  }
+
   Math::real NormalGravity::J2ToFlattening(real a, real GM,
                                            real omega, real J2) {
     // Solve
@@ -9,6 +9,7 @@
 
 #include <GeographicLib/OSGB.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <cstring>
 
 namespace GeographicLib {
 
@@ -31,18 +32,46 @@ namespace GeographicLib {
     return northoffset;
   }
 
-  void OSGB::GridReference(real x, real y, int prec, std::string& gridref) {
+  void OSGB::ForwardBatch(size_t n, const real lat[], const real lon[],
+                          real x[], real y[], real gamma[], real k[]) {
+    real x0 = FalseEasting(), y0 = computenorthoffset();
+    OSGBTM().ForwardBatch(n, OriginLongitude(), lat, lon, x, y, gamma, k);
+    for (size_t i = 0; i < n; ++i) {
+      x[i] += x0;
+      y[i] += y0;
+    }
+  }
+
+  void OSGB::ReverseBatch(size_t n, const real x[], const real y[],
+                          real lat[], real lon[], real gamma[], real k[]) {
+    const TransverseMercator& tm = OSGBTM();
+    real x0 = FalseEasting(), y0 = computenorthoffset(),
+      lon0 = OriginLongitude();
+    for (size_t i = 0; i < n; ++i) {
+      real gammax, kx;
+      tm.Reverse(lon0, x[i] - x0, y[i] - y0, lat[i], lon[i], gammax, kx);
+      if (gamma) gamma[i] = gammax;
+      if (k) k[i] = kx;
+    }
+  }
+
+  OSGB::status OSGB::GridChars(real x, real y, int prec,
+                               char grid[], int& len, bool throwp) {
     using std::isnan;           // Needed for Centos 7, ubuntu 14
-    CheckCoords(x, y);
-    if (!(prec >= 0 && prec <= maxprec_))
+    if (!CheckCoords(x, y, throwp))
+      return BADCOORDS;
+    if (!(prec >= 0 && prec <= maxprec_)) {
+      if (!throwp) return BADPRECISION;
       throw GeographicErr("OSGB precision " + Utility::str(prec)
                           + " not in [0, "
                           + Utility::str(int(maxprec_)) + "]");
+    }
     if (isnan(x) || isnan(y)) {
-      gridref = "INVALID";
-      return;
+      static const char* const invalid = "INVALID";
+      len = int(strlen(invalid));
+      copy(invalid, invalid + len, grid);
+      return OK;
     }
-    char grid[2 + 2 * maxprec_];
     int
       xh = int(floor(x / tile_)),
       yh = int(floor(y / tile_));
@@ -80,46 +109,74 @@ namespace GeographicLib {
         iy /= base_;
       }
     }
-    int mlen = z + 2 * prec;
+    len = z + 2 * prec;
+    return OK;
+  }
+
+  void OSGB::GridReference(real x, real y, int prec, std::string& gridref) {
+    char grid[2 + 2 * maxprec_];
+    int mlen;
+    GridChars(x, y, prec, grid, mlen, true);
     gridref.resize(mlen);
     copy(grid, grid + mlen, gridref.begin());
   }
 
-  void OSGB::GridReference(const std::string& gridref,
-                           real& x, real& y, int& prec,
-                           bool centerp) {
-    int
-      len = int(gridref.size()),
-      p = 0;
+  OSGB::status OSGB::GridReference(real x, real y, int prec,
+                                   char gridref[], size_t size) {
+    char grid[2 + 2 * maxprec_];
+    int mlen;
+    status st = GridChars(x, y, prec, grid, mlen, false);
+    if (st != OK) return st;
+    // The test mlen >= 0 always succeeds; it stops g++ warning about the copy
+    if (!(mlen >= 0 && size_t(mlen) < size)) return BUFFERTOOSMALL;
+    copy(grid, grid + mlen, gridref);
+    gridref[mlen] = '\0';
+    return OK;
+  }
+
+  OSGB::status OSGB::ReverseChars(const char* gridref, int len,
+                                  real& x, real& y, int& prec,
+                                  bool centerp, bool throwp) {
+    // Only used to construct error messages
+    auto str = [gridref, len]() -> string { return string(gridref, len); };
+    int p = 0;
     if (len >= 2 &&
         toupper(gridref[0]) == 'I' &&
         toupper(gridref[1]) == 'N') {
       x = y = Math::NaN();
       prec = -2;                // For compatibility with MGRS::Reverse.
-      return;
+      return OK;
     }
     char grid[2 + 2 * maxprec_];
     for (int i = 0; i < len; ++i) {
       if (!isspace(gridref[i])) {
-        if (p >= 2 + 2 * maxprec_)
-          throw GeographicErr("OSGB string " + gridref + " too long");
+        if (p >= 2 + 2 * maxprec_) {
+          if (!throwp) return BADSTRING;
+          throw GeographicErr("OSGB string " + str() + " too long");
+        }
         grid[p++] = gridref[i];
       }
     }
     len = p;
     p = 0;
-    if (len < 2)
-      throw GeographicErr("OSGB string " + gridref + " too short");
-    if (len % 2)
-      throw GeographicErr("OSGB string " + gridref +
+    if (len < 2) {
+      if (!throwp) return BADSTRING;
+      throw GeographicErr("OSGB string " + str() + " too short");
+    }
+    if (len % 2) {
+      if (!throwp) return BADSTRING;
+      throw GeographicErr("OSGB string " + str() +
                           " has odd number of characters");
+    }
     int
       xh = 0,
       yh = 0;
     while (p < 2) {
       int i = Utility::lookup(letters_, grid[p++]);
-      if (i < 0)
-        throw GeographicErr("Illegal prefix character " + gridref);
+      if (i < 0) {
+        if (!throwp) return BADSTRING;
+        throw GeographicErr("Illegal prefix character " + str());
+      }
       yh = yh * tilegrid_ + tilegrid_ - (i / tilegrid_) - 1;
       xh = xh * tilegrid_ + (i % tilegrid_);
     }
@@ -136,8 +193,10 @@ namespace GeographicLib {
       int
         ix = Utility::lookup(digits_, grid[p + i]),
         iy = Utility::lookup(digits_, grid[p + i + prec1]);
-      if (ix < 0 || iy < 0)
-        throw GeographicErr("Encountered a non-digit in " + gridref);
+      if (ix < 0 || iy < 0) {
+        if (!throwp) return BADSTRING;
+        throw GeographicErr("Encountered a non-digit in " + str());
+      }
       x1 += unit * ix;
       y1 += unit * iy;
     }
@@ -148,22 +207,78 @@ namespace GeographicLib {
     x = x1;
     y = y1;
     prec = prec1;
+    return OK;
+  }
+
+  void OSGB::GridReference(const std::string& gridref,
+                           real& x, real& y, int& prec,
+                           bool centerp) {
+    ReverseChars(gridref.data(), int(gridref.size()), x, y, prec, centerp,
+                 true);
+  }
+
+  OSGB::status OSGB::GridReference(const char* gridref, size_t len,
+                                   real& x, real& y, int& prec,
+                                   bool centerp) {
+    if (len > size_t(numeric_limits<int>::max())) return BADSTRING;
+    return ReverseChars(gridref, int(len), x, y, prec, centerp, false);
   }
 
-  void OSGB::CheckCoords(real x, real y) {
+  size_t OSGB::GridReferenceBatch(size_t n, const real x[], const real y[],
+                                  int prec, char gridref[], size_t stride,
+                                  status stat[]) {
+    size_t nbad = 0;
+    for (size_t i = 0; i < n; ++i) {
+      char* gridrefi = gridref + i * stride;
+      status st = GridReference(x[i], y[i], prec, gridrefi, stride);
+      if (st != OK) {
+        ++nbad;
+        if (stride > 0) gridrefi[0] = '\0';
+      }
+      if (stat) stat[i] = st;
+    }
+    return nbad;
+  }
+
+  size_t OSGB::GridReferenceBatch(size_t n, const char gridref[],
+                                  size_t stride,
+                                  real x[], real y[], int prec[],
+                                  bool centerp, status stat[]) {
+    size_t nbad = 0;
+    for (size_t i = 0; i < n; ++i) {
+      const char* gridrefi = gridref + i * stride;
+      size_t len = 0;
+      while (len < stride && gridrefi[len]) ++len;
+      status st = GridReference(gridrefi, len, x[i], y[i], prec[i], centerp);
+      if (st != OK) {
+        ++nbad;
+        x[i] = y[i] = Math::NaN();
+        prec[i] = -2;
+      }
+      if (stat) stat[i] = st;
+    }
+    return nbad;
+  }
+
+  bool OSGB::CheckCoords(real x, real y, bool throwp) {
     // Limits are all multiples of 100km and are all closed on the lower end
     // and open on the upper end -- and this is reflected in the error
     // messages.  NaNs are let through.
-    if (x < minx_ || x >= maxx_)
+    if (x < minx_ || x >= maxx_) {
+      if (!throwp) return false;
       throw GeographicErr("Easting " + Utility::str(int(floor(x/1000)))
                           + "km not in OSGB range ["
                           + Utility::str(minx_/1000) + "km, "
                           + Utility::str(maxx_/1000) + "km)");
-    if (y < miny_ || y >= maxy_)
+    }
+    if (y < miny_ || y >= maxy_) {
+      if (!throwp) return false;
       throw GeographicErr("Northing " + Utility::str(int(floor(y/1000)))
                           + "km not in OSGB range ["
                           + Utility::str(miny_/1000) + "km, "
                           + Utility::str(maxy_/1000) + "km)");
+    }
+    return true;
   }
 
 } // namespace GeographicLib
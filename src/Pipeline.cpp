@@ -0,0 +1,413 @@
+/**
+ * \file Pipeline.cpp
+ * \brief Implementation for GeographicLib::Pipeline class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <iostream>
+#include <algorithm>
+#include <GeographicLib/Pipeline.hpp>
+#include <GeographicLib/DMS.hpp>
+#include <GeographicLib/GeoCoords.hpp>
+#include <GeographicLib/MGRS.hpp>
+#include <GeographicLib/TextColumns.hpp>
+#include <GeographicLib/Utility.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+
+    typedef Math::real real;
+    typedef Pipeline::Block Block;
+
+    // A generic stage; run(b) does the work.
+    template<class F>
+    class FunctionStage : public Pipeline::Stage {
+    private:
+      unsigned _needs, _provides;
+      F _run;
+    public:
+      FunctionStage(unsigned needs, unsigned provides, F run)
+        : _needs(needs), _provides(provides), _run(run) {}
+      unsigned Needs() const override { return _needs; }
+      unsigned Provides() const override { return _provides; }
+      void Run(Block& b) const override { _run(b); }
+    };
+
+    template<class F>
+    shared_ptr<const Pipeline::Stage> MakeStage(unsigned needs,
+                                                unsigned provides, F run) {
+      return make_shared<FunctionStage<F> >(needs, provides, run);
+    }
+
+    // The first ntok (at most 3) fields of the lines of b.  Lines with fewer
+    // fields are flagged as errors here; lines with more are flagged by
+    // Extraneous, after the fields have been decoded, so that errors in
+    // decoding take precedence (as in the utility programs).
+    class Fields {
+    private:
+      int _ntok;
+      vector<const char*> _extra;
+      vector<size_t> _extralen;
+    public:
+      vector<const char*> field[3];
+      vector<size_t> flen[3];
+      Fields(Block& b, int ntok)
+        : _ntok(ntok)
+        , _extra(b.size(), nullptr)
+        , _extralen(b.size(), 0)
+      {
+        size_t n = b.size();
+        for (int k = 0; k < _ntok; ++k) {
+          field[k].assign(n, nullptr); flen[k].assign(n, 0);
+        }
+        const char* f[4]; size_t l[4];
+        for (size_t i = 0; i < n; ++i) {
+          if (!b.error[i].empty()) continue;
+          size_t nf = TextColumns::Split(b.text[i].data(), b.text[i].size(),
+                                         size_t(_ntok) + 1, f, l, false);
+          if (nf < size_t(_ntok)) {
+            b.error[i] = "Incomplete input: " + b.text[i];
+            continue;
+          }
+          for (int k = 0; k < _ntok; ++k) {
+            field[k][i] = f[k]; flen[k][i] = l[k];
+          }
+          if (nf > size_t(_ntok)) {
+            _extra[i] = f[_ntok]; _extralen[i] = l[_ntok];
+          }
+        }
+      }
+      // Skip the lines with errors in subsequent decoding.
+      void Drop(const Block& b) {
+        for (size_t i = 0; i < b.size(); ++i)
+          if (!b.error[i].empty())
+            for (int k = 0; k < _ntok; ++k) field[k][i] = nullptr;
+      }
+      void Extraneous(Block& b) const {
+        for (size_t i = 0; i < b.size(); ++i)
+          if (_extra[i] && b.error[i].empty())
+            b.error[i] = "Extraneous input: "
+              + string(_extra[i], _extralen[i]);
+      }
+    };
+
+    // The batch routines of Geocentric and LocalCartesian don't check the
+    // latitude; flag points with latitudes out of range as errors.
+    void CheckLatitude(Block& b) {
+      for (size_t i = 0; i < b.size(); ++i)
+        if (b.error[i].empty() && abs(b.lat[i]) > 90)
+          b.error[i] = "Latitude " + Utility::str(b.lat[i])
+            + "d not in [-90d, 90d]";
+    }
+
+  } // anonymous namespace
+
+  void Pipeline::Block::resize(size_t n) {
+    text.resize(n); comment.resize(n); error.assign(n, string());
+    lat.resize(n); lon.resize(n); h.resize(n);
+    x.resize(n); y.resize(n); z.resize(n);
+    zone.resize(n); northp.resize(n);
+  }
+
+  Pipeline& Pipeline::Add(const shared_ptr<const Stage>& stage) {
+    if (!stage)
+      throw GeographicErr("Pipeline: null stage");
+    unsigned missing = stage->Needs() & ~_columns;
+    if (missing)
+      throw GeographicErr("Pipeline: stage needs columns "
+                          + Utility::str(missing)
+                          + " which aren't provided");
+    _stages.push_back(stage);
+    _columns |= stage->Provides();
+    return *this;
+  }
+
+  void Pipeline::Run(Block& b) const {
+    for (const auto& stage : _stages)
+      stage->Run(b);
+  }
+
+  size_t Pipeline::Process(istream& in, ostream& out, const string& cdelim,
+                           size_t blocksize) const {
+    blocksize = max(size_t(1), blocksize);
+    Block b;
+    string s, buf;
+    size_t nerr = 0;
+    while (in) {
+      b.resize(blocksize);
+      size_t n = 0;
+      for (; n < blocksize && getline(in, s); ++n) {
+        b.comment[n].clear();
+        if (!cdelim.empty()) {
+          string::size_type m = s.find(cdelim);
+          if (m != string::npos) {
+            b.comment[n] = " " + s.substr(m);
+            s = s.substr(0, m);
+          }
+        }
+        b.text[n] = s;
+      }
+      if (n == 0) break;
+      b.resize(n);
+      Run(b);
+      buf.clear();
+      for (size_t i = 0; i < n; ++i) {
+        if (b.error[i].empty())
+          buf += b.text[i] + b.comment[i] + "\n";
+        else {
+          buf += "ERROR: " + b.error[i] + "\n";
+          ++nerr;
+        }
+      }
+      out << buf;
+    }
+    return nerr;
+  }
+
+  shared_ptr<const Pipeline::Stage> Pipeline::ParseGeodetic(bool longfirst,
+                                                            bool heightp) {
+    return MakeStage
+      (TEXT, GEODETIC | (heightp ? unsigned(HEIGHT) : 0u),
+       [longfirst, heightp](Block& b) -> void {
+         size_t n = b.size();
+         Fields f(b, heightp ? 3 : 2);
+         TextColumns::DecodeLatLon(n, f.field[0].data(), f.flen[0].data(),
+                                   f.field[1].data(), f.flen[1].data(),
+                                   longfirst,
+                                   b.lat.data(), b.lon.data(), b.error.data());
+         if (heightp) {
+           f.Drop(b);
+           TextColumns::DecodeNumbers(n, f.field[2].data(), f.flen[2].data(),
+                                      b.h.data(), b.error.data());
+         } else
+           fill(b.h.begin(), b.h.end(), real(0));
+         f.Extraneous(b);
+       });
+  }
+
+  shared_ptr<const Pipeline::Stage> Pipeline::ParseCartesian() {
+    return MakeStage
+      (TEXT, CARTESIAN,
+       [](Block& b) -> void {
+         size_t n = b.size();
+         Fields f(b, 3);
+         real* val[3] = { b.x.data(), b.y.data(), b.z.data() };
+         for (int k = 0; k < 3; ++k) {
+           f.Drop(b);
+           TextColumns::DecodeNumbers(n, f.field[k].data(), f.flen[k].data(),
+                                      val[k], b.error.data());
+         }
+         f.Extraneous(b);
+       });
+  }
+
+  shared_ptr<const Pipeline::Stage> Pipeline::ParseCoords(bool longfirst,
+                                                          bool centerp) {
+    return MakeStage
+      (TEXT, GEODETIC | GRID,
+       [longfirst, centerp](Block& b) -> void {
+         GeoCoords p;
+         for (size_t i = 0; i < b.size(); ++i) {
+           if (!b.error[i].empty()) continue;
+           try {
+             p.Reset(b.text[i], centerp, longfirst);
+             b.lat[i] = p.Latitude(); b.lon[i] = p.Longitude();
+             b.zone[i] = p.Zone(); b.northp[i] = p.Northp();
+             b.x[i] = p.Easting(); b.y[i] = p.Northing();
+           }
+           catch (const exception& e) {
+             b.error[i] = e.what();
+           }
+         }
+       });
+  }
+
+  shared_ptr<const Pipeline::Stage> Pipeline::ToGrid(int setzone) {
+    if (!(setzone >= UTMUPS::MINPSEUDOZONE && setzone <= UTMUPS::MAXZONE))
+      throw GeographicErr("Illegal zone requested " + Utility::str(setzone));
+    return MakeStage
+      (GEODETIC, GRID,
+       [setzone](Block& b) -> void {
+         size_t n = b.size();
+         unique_ptr<bool[]> northp(new bool[n]);
+         UTMUPS::ForwardBatch(n, b.lat.data(), b.lon.data(), b.zone.data(),
+                              northp.get(), b.x.data(), b.y.data(),
+                              nullptr, nullptr, setzone);
+         for (size_t i = 0; i < n; ++i) {
+           b.northp[i] = northp[i];
+           if (b.error[i].empty() && b.zone[i] == UTMUPS::INVALID) {
+             // Repeat the conversion to obtain the error message; this
+             // doesn't throw for NaN coordinates.
+             try {
+               int zone; bool np; real x, y;
+               UTMUPS::Forward(b.lat[i], b.lon[i], zone, np, x, y, setzone);
+             }
+             catch (const exception& e) {
+               b.error[i] = e.what();
+             }
+           }
+         }
+       });
+  }
+
+  shared_ptr<const Pipeline::Stage> Pipeline::FromGrid() {
+    return MakeStage
+      (GRID, GEODETIC,
+       [](Block& b) -> void {
+         size_t n = b.size();
+         unique_ptr<bool[]> northp(new bool[n]);
+         for (size_t i = 0; i < n; ++i) northp[i] = b.northp[i] != 0;
+         UTMUPS::ReverseBatch(n, b.zone.data(), northp.get(),
+                              b.x.data(), b.y.data(),
+                              b.lat.data(), b.lon.data());
+         for (size_t i = 0; i < n; ++i) {
+           if (b.error[i].empty() && isnan(b.lat[i])) {
+             try {
+               real lat, lon;
+               UTMUPS::Reverse(b.zone[i], northp[i], b.x[i], b.y[i],
+                               lat, lon);
+             }
+             catch (const exception& e) {
+               b.error[i] = e.what();
+             }
+           }
+         }
+       });
+  }
+
+  shared_ptr<const Pipeline::Stage>
+  Pipeline::GeoidHeight(const Geoid& geoid, Geoid::convertflag d) {
+    const Geoid* g = &geoid;
+    return MakeStage
+      (GEODETIC | HEIGHT, HEIGHT,
+       [g, d](Block& b) -> void {
+         size_t n = b.size();
+         vector<real> N(n);
+         try {
+           (*g)(n, b.lat.data(), b.lon.data(), N.data());
+         }
+         catch (const exception& e) {
+           for (size_t i = 0; i < n; ++i)
+             if (b.error[i].empty()) b.error[i] = e.what();
+           return;
+         }
+         for (size_t i = 0; i < n; ++i)
+           b.h[i] += real(d) * N[i];
+       });
+  }
+
+  shared_ptr<const Pipeline::Stage>
+  Pipeline::ToGeocentric(const Geocentric& earth) {
+    return MakeStage
+      (GEODETIC | HEIGHT, CARTESIAN,
+       [earth](Block& b) -> void {
+         CheckLatitude(b);
+         earth.ForwardBatch(b.size(), b.lat.data(), b.lon.data(), b.h.data(),
+                            b.x.data(), b.y.data(), b.z.data());
+       });
+  }
+
+  shared_ptr<const Pipeline::Stage>
+  Pipeline::FromGeocentric(const Geocentric& earth) {
+    return MakeStage
+      (CARTESIAN, GEODETIC | HEIGHT,
+       [earth](Block& b) -> void {
+         earth.ReverseBatch(b.size(), b.x.data(), b.y.data(), b.z.data(),
+                            b.lat.data(), b.lon.data(), b.h.data());
+       });
+  }
+
+  shared_ptr<const Pipeline::Stage>
+  Pipeline::ToLocal(const LocalCartesian& local) {
+    return MakeStage
+      (GEODETIC | HEIGHT, CARTESIAN,
+       [local](Block& b) -> void {
+         CheckLatitude(b);
+         local.ForwardBatch(b.size(), b.lat.data(), b.lon.data(), b.h.data(),
+                            b.x.data(), b.y.data(), b.z.data());
+       });
+  }
+
+  shared_ptr<const Pipeline::Stage>
+  Pipeline::FromLocal(const LocalCartesian& local) {
+    return MakeStage
+      (CARTESIAN, GEODETIC | HEIGHT,
+       [local](Block& b) -> void {
+         local.ReverseBatch(b.size(), b.x.data(), b.y.data(), b.z.data(),
+                            b.lat.data(), b.lon.data(), b.h.data());
+       });
+  }
+
+  shared_ptr<const Pipeline::Stage>
+  Pipeline::FormatGeodetic(int prec, bool longfirst, bool heightp) {
+    return MakeStage
+      (GEODETIC | (heightp ? unsigned(HEIGHT) : 0u), TEXT,
+       [prec, longfirst, heightp](Block& b) -> void {
+         for (size_t i = 0; i < b.size(); ++i) {
+           if (!b.error[i].empty()) continue;
+           b.text[i] =
+             Utility::str(longfirst ? b.lon[i] : b.lat[i], prec + 5) + " " +
+             Utility::str(longfirst ? b.lat[i] : b.lon[i], prec + 5);
+           if (heightp)
+             b.text[i] += " " + Utility::str(b.h[i], prec);
+         }
+       });
+  }
+
+  shared_ptr<const Pipeline::Stage> Pipeline::FormatCartesian(int prec) {
+    return MakeStage
+      (CARTESIAN, TEXT,
+       [prec](Block& b) -> void {
+         for (size_t i = 0; i < b.size(); ++i) {
+           if (!b.error[i].empty()) continue;
+           b.text[i] = Utility::str(b.x[i], prec) + " " +
+             Utility::str(b.y[i], prec) + " " + Utility::str(b.z[i], prec);
+         }
+       });
+  }
+
+  shared_ptr<const Pipeline::Stage> Pipeline::FormatGrid(int prec,
+                                                         bool abbrev) {
+    prec = max(0, min(9, prec));
+    return MakeStage
+      (GRID, TEXT,
+       [prec, abbrev](Block& b) -> void {
+         for (size_t i = 0; i < b.size(); ++i) {
+           if (!b.error[i].empty()) continue;
+           try {
+             b.text[i] = UTMUPS::EncodeZone(b.zone[i], b.northp[i] != 0,
+                                            abbrev) + " " +
+               Utility::str(b.x[i], prec) + " " + Utility::str(b.y[i], prec);
+           }
+           catch (const exception& e) {
+             b.error[i] = e.what();
+           }
+         }
+       });
+  }
+
+  shared_ptr<const Pipeline::Stage> Pipeline::FormatMGRS(int prec) {
+    prec = max(-1, min(11, prec));
+    return MakeStage
+      (GRID, TEXT,
+       [prec](Block& b) -> void {
+         for (size_t i = 0; i < b.size(); ++i) {
+           if (!b.error[i].empty()) continue;
+           try {
+             MGRS::Forward(b.zone[i], b.northp[i] != 0, b.x[i], b.y[i],
+                           prec, b.text[i]);
+           }
+           catch (const exception& e) {
+             b.error[i] = e.what();
+           }
+         }
+       });
+  }
+
+} // namespace GeographicLib
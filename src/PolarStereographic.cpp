@@ -63,8 +63,16 @@ namespace GeographicLib {
                                    real& gamma, real& k) const {
     lat = Math::LatFix(lat);
     lat *= northp ? 1 : -1;
+    real slon, clon;
+    Math::sincosd(lon, slon, clon);
+    IntForward(northp, lat, Math::tand(lat), lon, slon, clon, x, y, gamma, k);
+  }
+
+  void PolarStereographic::IntForward(bool northp, real lat, real tau,
+                                      real lon, real slon, real clon,
+                                      real& x, real& y,
+                                      real& gamma, real& k) const {
     real
-      tau = Math::tand(lat),
       secphi = hypot(real(1), tau),
       taup = Math::taupf(tau, _es),
       rho = hypot(real(1), taup) + abs(taup);
@@ -72,27 +80,87 @@ namespace GeographicLib {
     rho *= 2 * _k0 * _a / _c;
     k = lat != 90 ? (rho / _a) * secphi * sqrt(_e2m + _e2 / Math::sq(secphi)) :
       _k0;
-    Math::sincosd(lon, x, y);
-    x *= rho;
-    y *= (northp ? -rho : rho);
+    x = slon * rho;
+    y = clon * (northp ? -rho : rho);
     gamma = Math::AngNormalize(northp ? lon : -lon);
   }
 
   void PolarStereographic::Reverse(bool northp, real x, real y,
                                    real& lat, real& lon,
                                    real& gamma, real& k) const {
+    real tau;
+    IntReverse(x, y, tau, k);
+    lat = (northp ? 1 : -1) * Math::atand(tau);
+    lon = Math::atan2d(x, northp ? -y : y );
+    gamma = Math::AngNormalize(northp ? lon : -lon);
+  }
+
+  void PolarStereographic::IntReverse(real x, real y,
+                                      real& tau, real& k) const {
     real
       rho = hypot(x, y),
       t = rho != 0 ? rho / (2 * _k0 * _a / _c) :
       Math::sq(numeric_limits<real>::epsilon()),
       taup = (1 / t - t) / 2,
-      tau = Math::tauf(taup, _es),
-      secphi = hypot(real(1), tau);
+      secphi;
+    tau = Math::tauf(taup, _es);
+    secphi = hypot(real(1), tau);
     k = rho != 0 ? (rho / _a) * secphi * sqrt(_e2m + _e2 / Math::sq(secphi)) :
       _k0;
-    lat = (northp ? 1 : -1) * Math::atand(tau);
-    lon = Math::atan2d(x, northp ? -y : y );
-    gamma = Math::AngNormalize(northp ? lon : -lon);
+  }
+
+  void PolarStereographic::ForwardBatch(size_t n, bool northp,
+                                        const real lat[], const real lon[],
+                                        real x[], real y[],
+                                        real gamma[], real k[]) const {
+    // As in Math::tand
+    static const real
+      overflow = 1 / Math::sq(numeric_limits<real>::epsilon());
+    real a[projblock_], t[projblock_], c[projblock_],
+      l[projblock_], sl[projblock_], cl[projblock_];
+    for (size_t i0 = 0; i0 < n; i0 += projblock_) {
+      size_t m = n - i0 < projblock_ ? n - i0 : projblock_;
+      for (size_t i = 0; i < m; ++i) {
+        a[i] = Math::LatFix(lat[i0 + i]);
+        a[i] *= northp ? 1 : -1;
+        l[i] = lon[i0 + i];
+      }
+      Math::sincosdBatch(m, a, t, c);
+      for (size_t i = 0; i < m; ++i)
+        t[i] = c[i] != 0 ? t[i] / c[i] : (t[i] < 0 ? -overflow : overflow);
+      Math::sincosdBatch(m, l, sl, cl);
+      for (size_t i = 0; i < m; ++i) {
+        real gammai, ki;
+        IntForward(northp, a[i], t[i], l[i], sl[i], cl[i],
+                   x[i0 + i], y[i0 + i], gammai, ki);
+        if (gamma) gamma[i0 + i] = gammai;
+        if (k) k[i0 + i] = ki;
+      }
+    }
+  }
+
+  void PolarStereographic::ReverseBatch(size_t n, bool northp,
+                                        const real x[], const real y[],
+                                        real lat[], real lon[],
+                                        real gamma[], real k[]) const {
+    real t[projblock_], c[projblock_], xs[projblock_], ys[projblock_];
+    for (size_t i0 = 0; i0 < n; i0 += projblock_) {
+      size_t m = n - i0 < projblock_ ? n - i0 : projblock_;
+      for (size_t i = 0; i < m; ++i) {
+        real ki;
+        xs[i] = x[i0 + i]; ys[i] = northp ? -y[i0 + i] : y[i0 + i];
+        IntReverse(xs[i], y[i0 + i], t[i], ki);
+        if (k) k[i0 + i] = ki;
+        c[i] = 1;
+      }
+      Math::atan2dBatch(m, t, c, t);
+      Math::atan2dBatch(m, xs, ys, c);
+      for (size_t i = 0; i < m; ++i) {
+        lat[i0 + i] = (northp ? 1 : -1) * t[i];
+        lon[i0 + i] = c[i];
+        if (gamma) gamma[i0 + i] = Math::AngNormalize(northp ? c[i] : -c[i]);
+      }
+    }
   }
 
   void PolarStereographic::SetScale(real lat, real k) {
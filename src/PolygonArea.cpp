@@ -7,7 +7,9 @@
  * https://geographiclib.sourceforge.io/
  **********************************************************************/
 
+#include <vector>
 #include <GeographicLib/PolygonArea.hpp>
+#include <GeographicLib/Executor.hpp>
 
 namespace GeographicLib {
 
@@ -24,28 +26,118 @@ namespace GeographicLib {
       real s12, S12, t;
       _earth.GenInverse(_lat1, _lon1, lat, lon, _mask,
                         s12, t, t, t, t, t, S12);
-      _perimetersum += s12;
-      if (!_polyline) {
-        _areasum += S12;
-        _crossings += transit(_lon1, lon);
-      }
+      addedge(lat, lon, s12, S12, _polyline ? 0 : transit(_lon1, lon));
       _lat1 = lat; _lon1 = lon;
     }
     ++_num;
   }
 
+  template <class GeodType>
+  void PolygonAreaT<GeodType>::RemovePoint() {
+    if (!_window)
+      throw GeographicErr("RemovePoint needs a sliding window");
+    if (_num == 0) return;
+    if (_edges.empty()) {
+      Clear();
+      return;
+    }
+    const edge& e = _edges.front();
+    _perimetersum -= e.s12;
+    if (!_polyline) {
+      _areasum -= e.S12;
+      _crossings -= e.crossings;
+    }
+    _lat0 = e.lat; _lon0 = e.lon;
+    _edges.pop_front();
+    --_num;
+    if (_edges.empty()) {
+      // Remove any roundoff left in the sums
+      _perimetersum = 0;
+      _areasum = 0;
+      _crossings = 0;
+    }
+  }
+
+  template <class GeodType>
+  void PolygonAreaT<GeodType>::inverseedges(size_t m,
+                                            const real lats[],
+                                            const real lons[],
+                                            real s12[], real S12[],
+                                            unsigned threads) const {
+    const size_t nblocks = (m + block_ - 1) / block_;
+    Executor::Parallel(nblocks, threads, [&](size_t b) -> void {
+      real t;
+      for (size_t j = b * block_; j < min(m, (b + 1) * block_); ++j)
+        _earth.GenInverse(lats[j], lons[j], lats[j + 1], lons[j + 1],
+                          _mask, s12[j], t, t, t, t, t, S12[j]);
+    });
+  }
+
+  template <>
+  void PolygonAreaT<Rhumb>::inverseedges(size_t m,
+                                         const real lats[], const real lons[],
+                                         real s12[], real S12[],
+                                         unsigned threads) const {
+    // Each vertex is shared by two edges, so compute its isometric latitude
+    // once (this is the bulk of the cost of Rhumb::GenInverse).  The
+    // results are the same as from GenInverse.
+    vector<real> psi(m + 1);
+    const size_t nblocks = (m + block_) / block_;
+    Executor::Parallel(nblocks, threads, [&](size_t b) -> void {
+      for (size_t j = b * block_; j < min(m + 1, (b + 1) * block_); ++j)
+        psi[j] = _earth._ell.IsometricLatitude(lats[j]);
+    });
+    Executor::Parallel(nblocks, threads, [&](size_t b) -> void {
+      real t;
+      for (size_t j = b * block_; j < min(m, (b + 1) * block_); ++j)
+        _earth.InverseIsometric(psi[j], lons[j], psi[j + 1], lons[j + 1],
+                                _mask, s12[j], t, S12[j]);
+    });
+  }
+
+  template <class GeodType>
+  void PolygonAreaT<GeodType>::AddPoints(size_t n, const real lat[],
+                                         const real lon[], unsigned threads) {
+    if (n == 0) return;
+    if (_num == 0) {
+      AddPoint(lat[0], lon[0]);
+      ++lat; ++lon; --n;
+    }
+    vector<real>
+      lats(min(n, size_t(chunk_)) + 1), lons(lats.size()),
+      s12(lats.size() - 1), S12(s12.size());
+    for (size_t i0 = 0; i0 < n; i0 += chunk_) {
+      // Edge j of this chunk goes from point j to point j + 1 of lats, lons
+      const size_t m = min(n - i0, size_t(chunk_));
+      lats[0] = _lat1; lons[0] = _lon1;
+      for (size_t j = 0; j < m; ++j) {
+        lats[j + 1] = Math::LatFix(lat[i0 + j]);
+        lons[j + 1] = Math::AngNormalize(lon[i0 + j]);
+      }
+      inverseedges(m, lats.data(), lons.data(), s12.data(), S12.data(),
+                   threads);
+      // Accumulate the results in the same order as AddPoint
+      for (size_t j = 0; j < m; ++j) {
+        addedge(lats[j + 1], lons[j + 1], s12[j], S12[j],
+                _polyline ? 0 : transit(lons[j], lons[j + 1]));
+        ++_num;
+      }
+      _lat1 = lats[m]; _lon1 = lons[m];
+    }
+  }
+
   template <class GeodType>
   void PolygonAreaT<GeodType>::AddEdge(real azi, real s) {
     if (_num) {                 // Do nothing if _num is zero
       real lat, lon, S12, t;
       _earth.GenDirect(_lat1, _lon1, azi, false, s, _mask,
                        lat, lon, t, t, t, t, t, S12);
-      _perimetersum += s;
+      int crossings = 0;
       if (!_polyline) {
-        _areasum += S12;
-        _crossings += transitdirect(_lon1, lon);
+        crossings = transitdirect(_lon1, lon);
         lon = Math::AngNormalize(lon);
       }
+      addedge(lat, lon, s, S12, crossings);
       _lat1 = lat; _lon1 = lon;
       ++_num;
     }
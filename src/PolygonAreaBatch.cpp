@@ -0,0 +1,98 @@
+/**
+ * \file PolygonAreaBatch.cpp
+ * \brief Implementation for GeographicLib::PolygonAreaBatchT class
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <thread>
+#include <vector>
+#include <GeographicLib/PolygonAreaBatch.hpp>
+#include <GeographicLib/ExactAccumulator.hpp>
+#include <GeographicLib/Executor.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  template<class GeodType>
+  PolygonAreaBatchT<GeodType>::PolygonAreaBatchT(const GeodType& earth,
+                                                 bool polyline,
+                                                 unsigned threads)
+    : _earth(earth)
+    , _polyline(polyline)
+    , _threads(threads ? threads : thread::hardware_concurrency())
+  {
+    // hardware_concurrency returns 0 if the number of cores can't be
+    // determined.
+    if (_threads == 0) _threads = 1;
+  }
+
+  template<class GeodType>
+  void PolygonAreaBatchT<GeodType>::Compute(size_t n, const size_t offsets[],
+                                            const real lat[],
+                                            const real lon[],
+                                            bool reverse, bool sign,
+                                            real perimeter[], real area[],
+                                            unsigned num[]) const {
+    if (n == 0) return;
+    const size_t nblocks = (n + block_ - 1) / block_;
+    Executor::Parallel(nblocks, _threads, [&](size_t b) -> void {
+      PolygonAreaT<GeodType> poly(_earth, _polyline);
+      for (size_t k = b * block_; k < min(n, (b + 1) * block_); ++k) {
+        poly.Clear();
+        poly.AddPoints(offsets[k + 1] - offsets[k],
+                       lat + offsets[k], lon + offsets[k]);
+        real p, a;
+        unsigned m = poly.Compute(reverse, sign, p, a);
+        if (perimeter) perimeter[k] = p;
+        if (area && !_polyline) area[k] = a;
+        if (num) num[k] = m;
+      }
+    });
+  }
+
+  template<class GeodType>
+  void PolygonAreaBatchT<GeodType>::ComputeMulti(size_t n,
+                                                 const size_t offsets[],
+                                                 const real lat[],
+                                                 const real lon[],
+                                                 const bool hole[],
+                                                 bool reverse,
+                                                 real& perimeter,
+                                                 real& area) const {
+    using std::abs;
+    const size_t nblocks = (n + block_ - 1) / block_;
+    // The sums for each block; these are merged exactly below.
+    vector<ExactAccumulator> psum(nblocks), asum(nblocks);
+    Executor::Parallel(nblocks, _threads, [&](size_t b) -> void {
+      PolygonAreaT<GeodType> poly(_earth, _polyline);
+      for (size_t k = b * block_; k < min(n, (b + 1) * block_); ++k) {
+        poly.Clear();
+        poly.AddPoints(offsets[k + 1] - offsets[k],
+                       lat + offsets[k], lon + offsets[k]);
+        real p, a;
+        poly.Compute(reverse, true, p, a);
+        psum[b] += double(p);
+        if (_polyline) continue;
+        if (hole)
+          asum[b] += double(hole[k] ? -abs(a) : abs(a));
+        else
+          asum[b] += double(a);
+      }
+    });
+    ExactAccumulator P, A;
+    for (size_t b = 0; b < nblocks; ++b) {
+      P += psum[b]; A += asum[b];
+    }
+    perimeter = real(P());
+    if (!_polyline) area = real(A());
+  }
+
+  template class GEOGRAPHICLIB_EXPORT PolygonAreaBatchT<Geodesic>;
+  template class GEOGRAPHICLIB_EXPORT PolygonAreaBatchT<GeodesicExact>;
+  template class GEOGRAPHICLIB_EXPORT PolygonAreaBatchT<Rhumb>;
+
+} // namespace GeographicLib
@@ -0,0 +1,167 @@
+/**
+ * \file PreparedPolygon.cpp
+ * \brief Implementation for GeographicLib::PreparedPolygonT class
+ *
+ * Copyright (c) Charles Karney (2021) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/PreparedPolygon.hpp>
+#include <GeographicLib/PolygonArea.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  template<class GeodType>
+  PreparedPolygonT<GeodType>::PreparedPolygonT(const GeodType& earth,
+                                               size_t n, const real lat[],
+                                               const real lon[])
+    : _earth(earth)
+    , _binscale(0)
+    , _northleft(false)
+    , _interiorleft(false)
+    , _num(unsigned(n))
+    , _perimeter(0)
+    , _area(0)
+  {
+    using std::round;
+    if (n < 3) {
+      _binstart.assign(1, 0);
+      return;
+    }
+    {
+      PolygonAreaT<GeodType> poly(_earth);
+      poly.AddPoints(n, lat, lon);
+      real left, area0 = _earth.EllipsoidArea();
+      poly.Compute(false, false, _perimeter, left);
+      _interiorleft = left <= area0 / 2;
+      _area = _interiorleft ? left : area0 - left;
+    }
+    // Slop in the latitude bounds of the edges (degrees)
+    const real pad = 1/real(1000000),
+      f1 = 1 - _earth.Flattening();
+    real lonsum = 0, areasum = 0;
+    _edges.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      size_t j = i + 1 < n ? i + 1 : 0;
+      edge e;
+      e.lat1 = Math::LatFix(lat[i]); e.lon1 = Math::AngNormalize(lon[i]);
+      real
+        lat2 = Math::LatFix(lat[j]), lon2 = Math::AngNormalize(lon[j]),
+        s12, azi2, S12, t;
+      _earth.GenInverse(e.lat1, e.lon1, lat2, lon2,
+                        GeodType::DISTANCE | GeodType::AZIMUTH |
+                        GeodType::AREA,
+                        s12, e.azi1, azi2, t, t, t, S12);
+      if (!(s12 > 0)) continue; // Skip repeated vertices
+      e.lon12 = Math::AngDiff(e.lon1, lon2);
+      lonsum += e.lon12;
+      areasum += S12;
+      e.latmin = min(e.lat1, lat2); e.latmax = max(e.lat1, lat2);
+      bool north1 = abs(e.azi1) < 90, north2 = abs(azi2) < 90;
+      if (north1 != north2) {
+        // The edge includes a vertex of the geodesic; find its latitude by
+        // Clairaut's relation.
+        real sphi, cphi, salp, calp;
+        Math::sincosd(e.lat1, sphi, cphi);
+        Math::sincosd(e.azi1, salp, calp);
+        real sbet = f1 * sphi, cbet = cphi;
+        Math::norm(sbet, cbet);
+        real salp0 = abs(salp * cbet),
+          lat0 = Math::atan2d(sqrt(max(real(0), 1 - Math::sq(salp0))),
+                              f1 * salp0);
+        if (north1)
+          e.latmax = max(e.latmax, lat0);
+        else
+          e.latmin = min(e.latmin, -lat0);
+      }
+      e.latmin -= pad; e.latmax += pad;
+      _edges.push_back(e);
+    }
+    // The polygon encircles the north pole eastwards (positively) or
+    // westwards (negatively) or not at all.  In the last case, the north
+    // pole is on the left if the polygon is traversed clockwise
+    // (positive area sum).
+    int k = int(round(lonsum / 360));
+    _northleft = k == 0 ? areasum > 0 : k > 0;
+
+    // Set up the longitude bins; there are about as many bins as edges
+    size_t nb = max(size_t(1), min(_edges.size(), size_t(1) << 16));
+    _binscale = nb / real(360);
+    _binstart.assign(nb + 1, 0);
+    for (int pass = 0; pass < 2; ++pass) {
+      if (pass) {
+        for (size_t b = 0; b < nb; ++b)
+          _binstart[b + 1] += _binstart[b];
+        _binedges.resize(_binstart[nb]);
+      }
+      vector<unsigned> fill(_binstart.begin(), _binstart.end() - 1);
+      for (size_t i = 0; i < _edges.size(); ++i) {
+        const edge& e = _edges[i];
+        // The longitude range of the edge (unrolled) with some slop
+        real
+          lo = e.lon1 + min(real(0), e.lon12) - pad,
+          hi = e.lon1 + max(real(0), e.lon12) + pad;
+        int
+          b0 = int(floor((lo + 180) * _binscale)),
+          b1 = int(floor((hi + 180) * _binscale));
+        b1 = min(b1, b0 + int(nb) - 1);
+        for (int b = b0; b <= b1; ++b) {
+          int bb = b % int(nb); if (bb < 0) bb += int(nb);
+          if (pass)
+            _binedges[fill[bb]++] = unsigned(i);
+          else
+            ++_binstart[bb + 1];
+        }
+      }
+    }
+  }
+
+  template<class GeodType>
+  int PreparedPolygonT<GeodType>::bin(real lon) const {
+    // lon in (-180, 180]
+    int nb = int(_binstart.size()) - 1,
+      b = int(floor((lon + 180) * _binscale));
+    return b < 0 ? 0 : (b >= nb ? b - nb : b);
+  }
+
+  template<class GeodType>
+  bool PreparedPolygonT<GeodType>::South(const edge& e,
+                                         real lat, real lon) const {
+    if (lat < e.latmin) return true;
+    if (lat > e.latmax) return false;
+    // Compare the azimuth of the edge with the azimuth to the point
+    real azi1, azi2;
+    _earth.Inverse(e.lat1, e.lon1, lat, lon, azi1, azi2);
+    real d = Math::AngDiff(e.azi1, azi1);
+    // For an eastward edge, the point is south if it's on the right.
+    return e.lon12 > 0 ? d > 0 : d < 0;
+  }
+
+  template<class GeodType>
+  bool PreparedPolygonT<GeodType>::Contains(real lat, real lon) const {
+    using std::isnan;           // Needed for Centos 7, ubuntu 14
+    lat = Math::LatFix(lat);
+    if (_edges.empty() || isnan(lat) || isnan(lon)) return false;
+    lon = Math::AngNormalize(lon);
+    int b = bin(lon), w = 0;
+    // Count (with sign) the edges crossing the meridian north of the point;
+    // w is the number of times the region to the left is entered going
+    // north from the point to the pole.
+    for (unsigned k = _binstart[b]; k < _binstart[b + 1]; ++k) {
+      const edge& e = _edges[_binedges[k]];
+      real a = Math::AngDiff(lon, e.lon1), c = a + e.lon12;
+      if ((a <= 0) == (c <= 0)) continue;
+      if (South(e, lat, lon))
+        w += e.lon12 > 0 ? 1 : -1;
+    }
+    bool left = ((_northleft ? 1 : 0) - w) % 2 != 0;
+    return left == _interiorleft;
+  }
+
+  template class GEOGRAPHICLIB_EXPORT PreparedPolygonT<Geodesic>;
+  template class GEOGRAPHICLIB_EXPORT PreparedPolygonT<GeodesicExact>;
+
+} // namespace GeographicLib
@@ -0,0 +1,154 @@
+/**
+ * \file ProjectionRegistry.cpp
+ * \brief Implementation for GeographicLib::ProjectionRegistry class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/ProjectionRegistry.hpp>
+#include <GeographicLib/AlbersEqualArea.hpp>
+#include <GeographicLib/LambertConformalConic.hpp>
+#include <GeographicLib/TransverseMercator.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  void ProjectionRegistry::Add(const string& name, const key& k) {
+    // NaNs would break the ordering of the keys
+    if (isnan(get<1>(k)) || isnan(get<2>(k)) || isnan(get<3>(k)) ||
+        isnan(get<4>(k)) || isnan(get<5>(k)))
+      throw GeographicErr("Projection " + name + " has NaN parameters");
+    lock_guard<mutex> lock(_lock);
+    auto p = _names.find(name);
+    if (p == _names.end())
+      _names[name] = k;
+    else if (p->second != k)
+      throw GeographicErr("Projection " + name +
+                          " is already registered with other parameters");
+  }
+
+  void ProjectionRegistry::AddTransverseMercator(const string& name,
+                                                 real a, real f, real k0) {
+    Add(name, key(TM, a, f, 0, 0, k0));
+  }
+
+  void ProjectionRegistry::AddLambertConformalConic(const string& name,
+                                                    real a, real f,
+                                                    real stdlat1,
+                                                    real stdlat2, real k1) {
+    Add(name, key(LCC, a, f, stdlat1, stdlat2, k1));
+  }
+
+  void ProjectionRegistry::AddAlbersEqualArea(const string& name,
+                                              real a, real f,
+                                              real stdlat1, real stdlat2,
+                                              real k1) {
+    Add(name, key(AEA, a, f, stdlat1, stdlat2, k1));
+  }
+
+  const ProjectionRegistry::key&
+  ProjectionRegistry::Find(const string& name, int t) const {
+    auto p = _names.find(name);
+    if (p == _names.end())
+      throw GeographicErr("Projection " + name + " is not registered");
+    if (get<0>(p->second) != t)
+      throw GeographicErr("Projection " + name + " is of a different type");
+    return p->second;
+  }
+
+  shared_ptr<const TransverseMercator>
+  ProjectionRegistry::tm(const key& k) {
+    // If the constructor throws, t stays null and the construction is tried
+    // again on the next request.
+    auto& t = _tm[k];
+    if (!t)
+      t = make_shared<const TransverseMercator>(get<1>(k), get<2>(k),
+                                                get<5>(k));
+    return t;
+  }
+
+  shared_ptr<const LambertConformalConic>
+  ProjectionRegistry::lcc(const key& k) {
+    auto& t = _lcc[k];
+    if (!t)
+      t = get<3>(k) == get<4>(k) ?
+        make_shared<const LambertConformalConic>(get<1>(k), get<2>(k),
+                                                 get<3>(k), get<5>(k)) :
+        make_shared<const LambertConformalConic>(get<1>(k), get<2>(k),
+                                                 get<3>(k), get<4>(k),
+                                                 get<5>(k));
+    return t;
+  }
+
+  shared_ptr<const AlbersEqualArea>
+  ProjectionRegistry::aea(const key& k) {
+    auto& t = _aea[k];
+    if (!t)
+      t = get<3>(k) == get<4>(k) ?
+        make_shared<const AlbersEqualArea>(get<1>(k), get<2>(k),
+                                           get<3>(k), get<5>(k)) :
+        make_shared<const AlbersEqualArea>(get<1>(k), get<2>(k),
+                                           get<3>(k), get<4>(k), get<5>(k));
+    return t;
+  }
+
+  shared_ptr<const TransverseMercator>
+  ProjectionRegistry::TransverseMercatorInstance(const string& name) {
+    lock_guard<mutex> lock(_lock);
+    return tm(Find(name, TM));
+  }
+
+  shared_ptr<const LambertConformalConic>
+  ProjectionRegistry::LambertConformalConicInstance(const string& name) {
+    lock_guard<mutex> lock(_lock);
+    return lcc(Find(name, LCC));
+  }
+
+  shared_ptr<const AlbersEqualArea>
+  ProjectionRegistry::AlbersEqualAreaInstance(const string& name) {
+    lock_guard<mutex> lock(_lock);
+    return aea(Find(name, AEA));
+  }
+
+  void ProjectionRegistry::Prepare() {
+    lock_guard<mutex> lock(_lock);
+    string bad;
+    for (const auto& p : _names) {
+      try {
+        switch (get<0>(p.second)) {
+        case TM:  tm(p.second);  break;
+        case LCC: lcc(p.second); break;
+        default:  aea(p.second); break;
+        }
+      }
+      catch (const GeographicErr&) {
+        if (bad.empty()) bad = p.first;
+      }
+    }
+    if (!bad.empty())
+      throw GeographicErr("Projection " + bad + " has invalid parameters");
+  }
+
+  bool ProjectionRegistry::Defined(const string& name) const {
+    lock_guard<mutex> lock(_lock);
+    return _names.find(name) != _names.end();
+  }
+
+  size_t ProjectionRegistry::Size() const {
+    lock_guard<mutex> lock(_lock);
+    return _names.size();
+  }
+
+  size_t ProjectionRegistry::Constructed() const {
+    lock_guard<mutex> lock(_lock);
+    size_t n = 0;
+    for (const auto& p : _tm)  n += p.second ? 1 : 0;
+    for (const auto& p : _lcc) n += p.second ? 1 : 0;
+    for (const auto& p : _aea) n += p.second ? 1 : 0;
+    return n;
+  }
+
+} // namespace GeographicLib
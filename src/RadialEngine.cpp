@@ -0,0 +1,56 @@
+/**
+ * \file RadialEngine.cpp
+ * \brief Implementation for GeographicLib::RadialEngine class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/RadialEngine.hpp>
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  Math::real RadialEngine::Value(bool gradp, real r,
+                                 real& gradx, real& grady, real& gradz) const
+  {
+    gradp = _gradp && gradp;
+    real q = _a / r;
+    // Horner's method for the sums over degree of q^(n+1) * v[n], etc.
+    real v = 0, vr = 0, vt = 0, vl = 0;
+    for (int n = _N; n >= 0; --n) {
+      v = q * v + _v[n];
+      if (gradp) {
+        vr = q * vr + (n + 1) * _v[n];
+        vt = q * vt + _vt[n];
+        vl = q * vl + _vl[n];
+      }
+    }
+    if (gradp) {
+      // The components of the gradient in spherical coordinates
+      real
+        qr = q / r,
+        gr = - qr * vr,
+        gt =   qr * vt,
+        gl =   qr * vl;
+      // Rotate into cartesian (geocentric) coordinates
+      gradx = _cl * (_u * gr + _t * gt) - _sl * gl;
+      grady = _sl * (_u * gr + _t * gt) + _cl * gl;
+      gradz =        _t * gr - _u * gt             ;
+    }
+    return q * v;
+  }
+
+  void RadialEngine::Evaluate(size_t n, const real r[], real V[],
+                              real gradx[], real grady[], real gradz[])
+    const {
+    bool gradp = gradx && grady && gradz;
+    real dummy;
+    for (size_t i = 0; i < n; ++i)
+      V[i] = gradp ? Value(true, r[i], gradx[i], grady[i], gradz[i]) :
+        Value(false, r[i], dummy, dummy, dummy);
+  }
+
+} // namespace GeographicLib
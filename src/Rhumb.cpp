@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <GeographicLib/Rhumb.hpp>
+#include <GeographicLib/Trace.hpp>
 
 namespace GeographicLib {
 
@@ -20,6 +21,10 @@ namespace GeographicLib {
     , _exact(exact)
     , _c2(_ell.Area() / 720)
   {
+    // The coefficients for the area, _R, are computed on demand in MeanSinXi.
+  }
+
+  void Rhumb::Rcoeff() const {
     // Generated by Maxima on 2015-05-15 08:24:04-04:00
 #if GEOGRAPHICLIB_RHUMBAREA_ORDER == 4
     static const real coeff[] = {
@@ -148,10 +153,16 @@ namespace GeographicLib {
   void Rhumb::GenInverse(real lat1, real lon1, real lat2, real lon2,
                          unsigned outmask,
                          real& s12, real& azi12, real& S12) const {
+    InverseIsometric(_ell.IsometricLatitude(lat1), lon1,
+                     _ell.IsometricLatitude(lat2), lon2,
+                     outmask, s12, azi12, S12);
+  }
+
+  void Rhumb::InverseIsometric(real psi1, real lon1, real psi2, real lon2,
+                               unsigned outmask,
+                               real& s12, real& azi12, real& S12) const {
     real
       lon12 = Math::AngDiff(lon1, lon2),
-      psi1 = _ell.IsometricLatitude(lat1),
-      psi2 = _ell.IsometricLatitude(lat2),
       psi12 = psi2 - psi1,
       h = hypot(lon12, psi12);
     if (outmask & AZIMUTH)
@@ -165,6 +176,65 @@ namespace GeographicLib {
         MeanSinXi(psi2 * Math::degree(), psi1 * Math::degree());
   }
 
+  void Rhumb::DirectBatch(size_t n,
+                          const real lat1[], const real lon1[],
+                          const real azi12[], const real s12[],
+                          unsigned outmask,
+                          real lat2[], real lon2[], real S12[]) const {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "Rhumb::DirectBatch", n);
+    const bool
+      lat = (outmask & LATITUDE) != 0,
+      lon = (outmask & LONGITUDE) != 0,
+      area = (outmask & AREA) != 0;
+    for (size_t i = 0; i < n; ++i) {
+      real lat2x = 0, lon2x = 0, S12x = 0;
+      GenDirect(lat1[i], lon1[i], azi12[i], s12[i], outmask,
+                lat2x, lon2x, S12x);
+      if (lat) lat2[i] = lat2x;
+      if (lon) lon2[i] = lon2x;
+      if (area) S12[i] = S12x;
+    }
+  }
+
+  void Rhumb::InverseBatch(size_t n,
+                           const real lat1[], const real lon1[],
+                           const real lat2[], const real lon2[],
+                           unsigned outmask,
+                           real s12[], real azi12[], real S12[]) const {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "Rhumb::InverseBatch", n);
+    const bool
+      dist = (outmask & DISTANCE) != 0,
+      azi = (outmask & AZIMUTH) != 0,
+      area = (outmask & AREA) != 0;
+    for (size_t i = 0; i < n; ++i) {
+      real s12x = 0, azi12x = 0, S12x = 0;
+      GenInverse(lat1[i], lon1[i], lat2[i], lon2[i], outmask,
+                 s12x, azi12x, S12x);
+      if (dist) s12[i] = s12x;
+      if (azi) azi12[i] = azi12x;
+      if (area) S12[i] = S12x;
+    }
+  }
+
+  void Rhumb::InverseBatch(real lat1, real lon1, size_t n,
+                           const real lat2[], const real lon2[],
+                           unsigned outmask,
+                           real s12[], real azi12[], real S12[]) const {
+    const bool
+      dist = (outmask & DISTANCE) != 0,
+      azi = (outmask & AZIMUTH) != 0,
+      area = (outmask & AREA) != 0;
+    real psi1 = _ell.IsometricLatitude(lat1);
+    for (size_t i = 0; i < n; ++i) {
+      real s12x = 0, azi12x = 0, S12x = 0;
+      InverseIsometric(psi1, lon1, _ell.IsometricLatitude(lat2[i]), lon2[i],
+                       outmask, s12x, azi12x, S12x);
+      if (dist) s12[i] = s12x;
+      if (azi) azi12[i] = azi12x;
+      if (area) S12[i] = S12x;
+    }
+  }
+
   RhumbLine Rhumb::Line(real lat1, real lon1, real azi12) const
   { return RhumbLine(*this, lat1, lon1, azi12, _exact); }
 
@@ -324,6 +394,14 @@ namespace GeographicLib {
   }
 
   Math::real Rhumb::MeanSinXi(real psix, real psiy) const {
+    if (!_Rlazy.init.load(memory_order_acquire)) {
+      // Compute _R on first use (double-checked locking)
+      lock_guard<mutex> lock(_Rlazy.lock);
+      if (!_Rlazy.init.load(memory_order_relaxed)) {
+        Rcoeff();
+        _Rlazy.init.store(true, memory_order_release);
+      }
+    }
     return Dlog(cosh(psix), cosh(psiy)) * Dcosh(psix, psiy)
       + SinCosSeries(false, gd(psix), gd(psiy), _R, maxpow_) * Dgd(psix, psiy);
   }
@@ -381,4 +459,21 @@ namespace GeographicLib {
     if (outmask & LONGITUDE) lon2 = lon2x;
   }
 
+  void RhumbLine::GenPositions(size_t n, const real s12[], real s0, real ds,
+                               unsigned outmask,
+                               real lat2[], real lon2[], real S12[]) const {
+    const bool
+      lat = (outmask & LATITUDE) != 0,
+      lon = (outmask & LONGITUDE) != 0,
+      area = (outmask & AREA) != 0;
+    for (size_t i = 0; i < n; ++i) {
+      real lat2x = 0, lon2x = 0, S12x = 0;
+      GenPosition(s12 ? s12[i] : s0 + real(i) * ds, outmask,
+                  lat2x, lon2x, S12x);
+      if (lat) lat2[i] = lat2x;
+      if (lon) lon2[i] = lon2x;
+      if (area) S12[i] = S12x;
+    }
+  }
+
 } // namespace GeographicLib
@@ -0,0 +1,153 @@
+/**
+ * \file SharedData.cpp
+ * \brief Implementation for GeographicLib::SharedData class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstdio>
+#include <vector>
+#include <GeographicLib/SharedData.hpp>
+
+#if !defined(_WIN32)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  bool SharedData::Supported() {
+#if !defined(_WIN32)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  string SharedData::Name(const string& filename) {
+    string path(filename);
+#if !defined(_WIN32)
+    char* p = realpath(filename.c_str(), nullptr);
+    if (p) {
+      path = p;
+      free(p);
+    }
+#endif
+    // 64-bit FNV-1a hash of the path
+    unsigned long long h = 14695981039346656037ULL;
+    for (char c : path) {
+      h ^= (unsigned char)(c);
+      h *= 1099511628211ULL;
+    }
+    char hash[17];
+    snprintf(hash, sizeof(hash), "%016llx", h);
+    string base = path.substr(path.find_last_of('/') + 1);
+    return string("/GeographicLib-") + hash + "-" + base.substr(0, 200);
+  }
+
+  int SharedData::Open(const string& filename) {
+#if !defined(_WIN32)
+    struct stat fs, ss;
+    if (stat(filename.c_str(), &fs) < 0)
+      return -1;
+    int fd = shm_open(Name(filename).c_str(), O_RDONLY, 0);
+    if (fd < 0)
+      return -1;
+    if (fstat(fd, &ss) < 0 || ss.st_size != fs.st_size) {
+      // Missing or stale segment
+      close(fd);
+      return -1;
+    }
+    return fd;
+#else
+    (void)filename;
+    return -1;
+#endif
+  }
+
+  bool SharedData::Loaded(const string& filename) {
+#if !defined(_WIN32)
+    int fd = Open(filename);
+    if (fd < 0)
+      return false;
+    close(fd);
+    return true;
+#else
+    (void)filename;
+    return false;
+#endif
+  }
+
+  bool SharedData::Load(const string& filename) {
+#if !defined(_WIN32)
+    if (Loaded(filename))
+      return false;
+    int in = open(filename.c_str(), O_RDONLY);
+    if (in < 0)
+      throw GeographicErr("File not readable " + filename);
+    string name = Name(filename);
+    // Remove a stale segment; existing attachments remain valid
+    shm_unlink(name.c_str());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+    if (fd < 0) {
+      int err = errno;
+      close(in);
+      if (err == EEXIST)
+        // Another process is loading the file
+        return false;
+      throw GeographicErr("Cannot create shared memory segment " + name);
+    }
+    // Copy the file with write so that the segment only reaches its full
+    // size once all the data is present.
+    vector<char> buf(1 << 20);
+    bool ok = true;
+    for (;;) {
+      ssize_t n = read(in, buf.data(), buf.size());
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n <= 0) {
+        ok = n == 0;
+        break;
+      }
+      for (ssize_t got = 0; ok && got < n;) {
+        ssize_t r = write(fd, buf.data() + got, size_t(n - got));
+        if (r < 0 && errno == EINTR)
+          continue;
+        ok = r > 0;
+        if (ok) got += r;
+      }
+      if (!ok)
+        break;
+    }
+    close(in);
+    close(fd);
+    if (!ok) {
+      shm_unlink(name.c_str());
+      throw GeographicErr("Error loading " + filename +
+                          " into shared memory segment " + name);
+    }
+    return true;
+#else
+    throw GeographicErr("Shared memory segments are not supported "
+                        "on this system");
+#endif
+  }
+
+  bool SharedData::Remove(const string& filename) {
+#if !defined(_WIN32)
+    return shm_unlink(Name(filename).c_str()) == 0;
+#else
+    (void)filename;
+    return false;
+#endif
+  }
+
+} // namespace GeographicLib
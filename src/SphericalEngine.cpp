@@ -132,7 +132,23 @@
 
 #include <GeographicLib/SphericalEngine.hpp>
 #include <GeographicLib/CircularEngine.hpp>
+#include <GeographicLib/RadialEngine.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <GeographicLib/SharedData.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <cstring>
+#include <cstdint>
+
+#if !defined(_WIN32)
+// For mmap
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
 
 #if defined(_MSC_VER)
 // Squelch warnings about constant conditional expressions and potentially
@@ -144,15 +160,29 @@ namespace GeographicLib {
 
   using namespace std;
 
-  vector<Math::real>& SphericalEngine::sqrttable() {
-    static vector<real> sqrttable(0);
-    return sqrttable;
+  struct SphericalEngine::roottable {
+    mutex lock;                 // Held while a new table is made
+    atomic<const real*> current; // The published table
+    atomic<int> size;           // Its length
+    vector< unique_ptr<real[]> > tables; // All the tables made
+    roottable() : current(nullptr), size(0) {}
+  };
+
+  SphericalEngine::roottable& SphericalEngine::roots() {
+    // Initialization of the static is thread safe
+    static roottable roots;
+    return roots;
+  }
+
+  const Math::real* SphericalEngine::sqrttable() {
+    return roots().current.load(memory_order_acquire);
   }
 
   template<bool gradp, SphericalEngine::normalization norm, int L>
   Math::real SphericalEngine::Value(const coeff c[], const real f[],
                                     real x, real y, real z, real a,
-                                    real& gradx, real& grady, real& gradz)
+                                    real& gradx, real& grady, real& gradz,
+                                    unsigned threads)
     {
     static_assert(L > 0, "L must be positive");
     static_assert(norm == FULL || norm == SCHMIDT, "Unknown normalization");
@@ -171,6 +201,12 @@ namespace GeographicLib {
       uq = u * q,
       uq2 = Math::sq(uq),
       tu = t / u;
+    if (threads > 1 && M >= morders_) {
+      // Do the inner sums in parallel with Circle and the outer sum with
+      // CircularEngine.
+      CircularEngine circ(Circle<gradp, norm, L>(c, f, p, z, a, threads));
+      return gradp ? circ(sl, cl, gradx, grady, gradz) : circ(sl, cl);
+    }
     // Initialize outer sum
     real vc  = 0, vc2  = 0, vs  = 0, vs2  = 0;   // v [N + 1], v [N + 2]
     // vr, vt, vl and similar w variable accumulate the sums for the
@@ -179,7 +215,7 @@ namespace GeographicLib {
     real vtc = 0, vtc2 = 0, vts = 0, vts2 = 0;   // vt[N + 1], vt[N + 2]
     real vlc = 0, vlc2 = 0, vls = 0, vls2 = 0;   // vl[N + 1], vl[N + 2]
     int k[L];
-    const vector<real>& root( sqrttable() );
+    const real* root = sqrttable();
     for (int m = M; m >= 0; --m) {   // m = M .. 0
       // Initialize inner sum
       real
@@ -293,30 +329,38 @@ namespace GeographicLib {
     return vc;
   }
 
-  template<bool gradp, SphericalEngine::normalization norm, int L>
-  CircularEngine SphericalEngine::Circle(const coeff c[], const real f[],
-                                         real p, real z, real a) {
-
+  template<SphericalEngine::normalization norm, int L>
+  Math::real SphericalEngine::Horizontal(const coeff c[], const real f[],
+                                         real x, real y, real z, real a,
+                                         real& grade, real& gradn) {
     static_assert(L > 0, "L must be positive");
     static_assert(norm == FULL || norm == SCHMIDT, "Unknown normalization");
     int N = c[0].nmx(), M = c[0].mmx();
 
     real
+      p = hypot(x, y),
+      cl = p != 0 ? x / p : 1,  // cos(lambda); at pole, pick lambda = 0
+      sl = p != 0 ? y / p : 0,  // sin(lambda)
       r = hypot(z, p),
       t = r != 0 ? z / r : 0,   // cos(theta); at origin, pick theta = pi/2
       u = r != 0 ? max(p / r, eps()) : 1, // sin(theta); but avoid the pole
       q = a / r;
     real
       q2 = Math::sq(q),
+      uq = u * q,
+      uq2 = Math::sq(uq),
       tu = t / u;
-    CircularEngine circ(M, gradp, norm, a, r, u, t);
+    // This is Value with gradp = true with the recurrences for the
+    // derivatives wrt r (vr and wr) removed.
+    real vc  = 0, vc2  = 0, vs  = 0, vs2  = 0;   // v [N + 1], v [N + 2]
+    real vtc = 0, vtc2 = 0, vts = 0, vts2 = 0;   // vt[N + 1], vt[N + 2]
+    real vlc = 0, vlc2 = 0, vls = 0, vls2 = 0;   // vl[N + 1], vl[N + 2]
     int k[L];
-    const vector<real>& root( sqrttable() );
+    const real* root = sqrttable();
     for (int m = M; m >= 0; --m) {   // m = M .. 0
       // Initialize inner sum
       real
         wc  = 0, wc2  = 0, ws  = 0, ws2  = 0, // w [N - m + 1], w [N - m + 2]
-        wrc = 0, wrc2 = 0, wrs = 0, wrs2 = 0, // wr[N - m + 1], wr[N - m + 2]
         wtc = 0, wtc2 = 0, wts = 0, wts2 = 0; // wt[N - m + 1], wt[N - m + 2]
       for (int l = 0; l < L; ++l)
         k[l] = c[l].index(N, m) + 1;
@@ -343,43 +387,485 @@ namespace GeographicLib {
           R += c[l].Cv(--k[l], n, m, f[l]);
         R *= scale();
         w = A * wc + B * wc2 + R; wc2 = wc; wc = w;
-        if (gradp) {
-          w = A * wrc + B * wrc2 + (n + 1) * R; wrc2 = wrc; wrc = w;
-          w = A * wtc + B * wtc2 -  u*Ax * wc2; wtc2 = wtc; wtc = w;
-        }
+        w = A * wtc + B * wtc2 -  u*Ax * wc2; wtc2 = wtc; wtc = w;
         if (m) {
           R = c[0].Sv(k[0]);
           for (int l = 1; l < L; ++l)
             R += c[l].Sv(k[l], n, m, f[l]);
           R *= scale();
           w = A * ws + B * ws2 + R; ws2 = ws; ws = w;
-          if (gradp) {
-            w = A * wrs + B * wrs2 + (n + 1) * R; wrs2 = wrs; wrs = w;
-            w = A * wts + B * wts2 -  u*Ax * ws2; wts2 = wts; wts = w;
-          }
+          w = A * wts + B * wts2 -  u*Ax * ws2; wts2 = wts; wts = w;
         }
       }
-      if (!gradp)
-        circ.SetCoeff(m, wc, ws);
-      else {
-        // Include the terms Sc[m] * P'[m,m](t) and  Ss[m] * P'[m,m](t)
+      if (m) {
+        real v, A, B;           // alpha[m], beta[m + 1]
+        switch (norm) {
+        case FULL:
+          v = root[2] * root[2 * m + 3] / root[m + 1];
+          A = cl * v * uq;
+          B = - v * root[2 * m + 5] / (root[8] * root[m + 2]) * uq2;
+          break;
+        case SCHMIDT:
+          v = root[2] * root[2 * m + 1] / root[m + 1];
+          A = cl * v * uq;
+          B = - v * root[2 * m + 3] / (root[8] * root[m + 2]) * uq2;
+          break;
+        default: break;       // To suppress warning message from Visual Studio
+        }
+        v = A * vc  + B * vc2  +  wc ; vc2  = vc ; vc  = v;
+        v = A * vs  + B * vs2  +  ws ; vs2  = vs ; vs  = v;
+        // Include the terms Sc[m] * P'[m,m](t) and Ss[m] * P'[m,m](t)
         wtc += m * tu * wc; wts += m * tu * ws;
-        circ.SetCoeff(m, wc, ws, wrc, wrs, wtc, wts);
+        v = A * vtc + B * vtc2 +  wtc; vtc2 = vtc; vtc = v;
+        v = A * vts + B * vts2 +  wts; vts2 = vts; vts = v;
+        v = A * vlc + B * vlc2 + m*ws; vlc2 = vlc; vlc = v;
+        v = A * vls + B * vls2 - m*wc; vls2 = vls; vls = v;
+      } else {
+        real A, B, qs;
+        switch (norm) {
+        case FULL:
+          A = root[3] * uq;       // F[1]/(q*cl) or F[1]/(q*sl)
+          B = - root[15]/2 * uq2; // beta[1]/q
+          break;
+        case SCHMIDT:
+          A = uq;
+          B = - root[3]/2 * uq2;
+          break;
+        default: break;       // To suppress warning message from Visual Studio
+        }
+        qs = q / scale();
+        vc = qs * (wc + A * (cl * vc + sl * vs ) + B * vc2);
+        qs /= r;
+        vtc =     qs * (wtc + A * (cl * vtc + sl * vts) + B * vtc2);
+        vlc = qs / u * (      A * (cl * vlc + sl * vls) + B * vlc2);
+      }
+    }
+    // The theta direction points south
+    grade = vlc;
+    gradn = -vtc;
+    return vc;
+  }
+
+  template<SphericalEngine::normalization norm, int L>
+  Math::real SphericalEngine::Hessian(const coeff c[], const real f[],
+                                      real x, real y, real z, real a,
+                                      real& gradx, real& grady, real& gradz,
+                                      real& hxx, real& hxy, real& hxz,
+                                      real& hyy, real& hyz, real& hzz) {
+    static_assert(L > 0, "L must be positive");
+    static_assert(norm == FULL || norm == SCHMIDT, "Unknown normalization");
+    int N = c[0].nmx(), M = c[0].mmx();
+
+    real
+      p = hypot(x, y),
+      cl = p != 0 ? x / p : 1,  // cos(lambda); at pole, pick lambda = 0
+      sl = p != 0 ? y / p : 0,  // sin(lambda)
+      r = hypot(z, p),
+      t = r != 0 ? z / r : 0,   // cos(theta); at origin, pick theta = pi/2
+      u = r != 0 ? max(p / r, eps()) : 1, // sin(theta); but avoid the pole
+      q = a / r;
+    real
+      q2 = Math::sq(q),
+      uq = u * q,
+      uq2 = Math::sq(uq),
+      tu = t / u;
+    // The outer sums are indexed by
+    enum { VV, VR, VT, VL,      // V, -r * dV/dr, dV/dtheta, dV/dlambda
+           HRR, HRT, HTT, HLL,  // the components of r^2 * Hessian (with
+           HRL, HTL, NSUM };    // an extra factor of u for HRL and HTL)
+    // Initialize outer sums; vc[k], vc2[k] = v[m + 1], v[m + 2]
+    real vc[NSUM], vc2[NSUM], vs[NSUM], vs2[NSUM];
+    for (int j = 0; j < NSUM; ++j)
+      vc[j] = vc2[j] = vs[j] = vs2[j] = 0;
+    int k[L];
+    const real* root = sqrttable();
+    for (int m = M; m >= 0; --m) {   // m = M .. 0
+      // Initialize inner sum.  The sums for the derivatives wrt r are
+      // weighted by n + 1 and (n + 1) * (n + 2); those for the derivatives
+      // wrt theta are obtained by differentiating the Clenshaw recurrence.
+      real
+        wc   = 0, wc2   = 0, ws   = 0, ws2   = 0, // w
+        wrc  = 0, wrc2  = 0, wrs  = 0, wrs2  = 0, // d/dr
+        wtc  = 0, wtc2  = 0, wts  = 0, wts2  = 0, // d/dtheta
+        wrrc = 0, wrrc2 = 0, wrrs = 0, wrrs2 = 0, // d2/dr2
+        wrtc = 0, wrtc2 = 0, wrts = 0, wrts2 = 0, // d2/(dr dtheta)
+        wttc = 0, wttc2 = 0, wtts = 0, wtts2 = 0; // d2/dtheta2
+      for (int l = 0; l < L; ++l)
+        k[l] = c[l].index(N, m) + 1;
+      for (int n = N; n >= m; --n) {             // n = N .. m; l = N - m .. 0
+        real w, A, Ax, B, R;    // alpha[l], beta[l + 1]
+        switch (norm) {
+        case FULL:
+          w = root[2 * n + 1] / (root[n - m + 1] * root[n + m + 1]);
+          Ax = q * w * root[2 * n + 3];
+          A = t * Ax;
+          B = - q2 * root[2 * n + 5] /
+            (w * root[n - m + 2] * root[n + m + 2]);
+          break;
+        case SCHMIDT:
+          w = root[n - m + 1] * root[n + m + 1];
+          Ax = q * (2 * n + 1) / w;
+          A = t * Ax;
+          B = - q2 * w / (root[n - m + 2] * root[n + m + 2]);
+          break;
+        default: break;       // To suppress warning message from Visual Studio
+        }
+        // dA/dtheta = -u*Ax, d2A/dtheta2 = -t*Ax
+        real Au = u * Ax, At = t * Ax, n1 = real(n + 1), n2 = n1 * (n + 2);
+        R = c[0].Cv(--k[0]);
+        for (int l = 1; l < L; ++l)
+          R += c[l].Cv(--k[l], n, m, f[l]);
+        R *= scale();
+        w = A * wc   + B * wc2   + R     ; wc2   = wc  ; wc   = w;
+        w = A * wrc  + B * wrc2  + n1 * R; wrc2  = wrc ; wrc  = w;
+        w = A * wrrc + B * wrrc2 + n2 * R; wrrc2 = wrrc; wrrc = w;
+        w = A * wtc  + B * wtc2  - Au * wc2 ; wtc2  = wtc ; wtc  = w;
+        w = A * wrtc + B * wrtc2 - Au * wrc2; wrtc2 = wrtc; wrtc = w;
+        w = A * wttc + B * wttc2 - 2 * Au * wtc2 - At * wc2;
+        wttc2 = wttc; wttc = w;
+        if (m) {
+          R = c[0].Sv(k[0]);
+          for (int l = 1; l < L; ++l)
+            R += c[l].Sv(k[l], n, m, f[l]);
+          R *= scale();
+          w = A * ws   + B * ws2   + R     ; ws2   = ws  ; ws   = w;
+          w = A * wrs  + B * wrs2  + n1 * R; wrs2  = wrs ; wrs  = w;
+          w = A * wrrs + B * wrrs2 + n2 * R; wrrs2 = wrrs; wrrs = w;
+          w = A * wts  + B * wts2  - Au * ws2 ; wts2  = wts ; wts  = w;
+          w = A * wrts + B * wrts2 - Au * wrs2; wrts2 = wrts; wrts = w;
+          w = A * wtts + B * wtts2 - 2 * Au * wts2 - At * ws2;
+          wtts2 = wtts; wtts = w;
+        }
+      }
+      // The coefficients of cos(m*lambda) and sin(m*lambda) * P[m,m](t) for
+      // each outer sum.  The derivatives of P[m,m](t) = const * u^m wrt
+      // theta are included with
+      //   d/dtheta u^m = m*t/u * u^m
+      //   d2/dtheta2 u^m = m*((m-1)*t^2/u^2 - 1) * u^m
+      // The terms in 1/u^2 for m = 1 cancel in the combinations for TT and
+      // LL, which are computed so that they remain accurate near the poles.
+      real sc[NSUM], ss[NSUM];
+      {
+        real
+          tc = wtc + m * tu * wc, ts = wts + m * tu * ws, // d/dtheta
+          h = m * ((m - 1) * Math::sq(tu) - 1),
+          g = m * (m - 1) / Math::sq(u) + m;
+        sc[VV] = wc; ss[VV] = ws;
+        sc[VR] = wrc; ss[VR] = wrs;
+        sc[VT] = tc; ss[VT] = ts;
+        sc[VL] = m * ws; ss[VL] = - m * wc;
+        sc[HRR] = wrrc; ss[HRR] = wrrs;
+        sc[HRT] = - (wrtc + m * tu * wrc + tc);
+        ss[HRT] = - (wrts + m * tu * wrs + ts);
+        sc[HTT] = wttc + 2 * m * tu * wtc + h * wc - wrc;
+        ss[HTT] = wtts + 2 * m * tu * wts + h * ws - wrs;
+        sc[HLL] = tu * wtc - g * wc - wrc;
+        ss[HLL] = tu * wts - g * ws - wrs;
+        sc[HRL] = - m * (wrs + ws); ss[HRL] = m * (wrc + wc);
+        sc[HTL] = m * (wts + (m - 1) * tu * ws);
+        ss[HTL] = - m * (wtc + (m - 1) * tu * wc);
+      }
+      if (m) {
+        real v, A, B;           // alpha[m], beta[m + 1]
+        switch (norm) {
+        case FULL:
+          v = root[2] * root[2 * m + 3] / root[m + 1];
+          A = cl * v * uq;
+          B = - v * root[2 * m + 5] / (root[8] * root[m + 2]) * uq2;
+          break;
+        case SCHMIDT:
+          v = root[2] * root[2 * m + 1] / root[m + 1];
+          A = cl * v * uq;
+          B = - v * root[2 * m + 3] / (root[8] * root[m + 2]) * uq2;
+          break;
+        default: break;       // To suppress warning message from Visual Studio
+        }
+        for (int j = 0; j < NSUM; ++j) {
+          v = A * vc[j] + B * vc2[j] + sc[j]; vc2[j] = vc[j]; vc[j] = v;
+          v = A * vs[j] + B * vs2[j] + ss[j]; vs2[j] = vs[j]; vs[j] = v;
+        }
+      } else {
+        real A, B, qs;
+        switch (norm) {
+        case FULL:
+          A = root[3] * uq;       // F[1]/(q*cl) or F[1]/(q*sl)
+          B = - root[15]/2 * uq2; // beta[1]/q
+          break;
+        case SCHMIDT:
+          A = uq;
+          B = - root[3]/2 * uq2;
+          break;
+        default: break;       // To suppress warning message from Visual Studio
+        }
+        qs = q / scale();
+        for (int j = 0; j < NSUM; ++j)
+          vc[j] = qs * (sc[j] + A * (cl * vc[j] + sl * vs[j]) + B * vc2[j]);
       }
     }
 
+    // The gradient and Hessian in the local frame (r, theta, lambda)
+    real
+      r2 = Math::sq(r),
+      gr = - vc[VR] / r, gt = vc[VT] / r, gl = vc[VL] / (r * u),
+      hrr = vc[HRR] / r2, hrt = vc[HRT] / r2, htt = vc[HTT] / r2,
+      hll = vc[HLL] / r2, hrl = vc[HRL] / (r2 * u), htl = vc[HTL] / (r2 * u);
+    // Rotate into cartesian (geocentric) coordinates; the columns of the
+    // rotation matrix are the unit vectors in the r, theta, and lambda
+    // directions.
+    real
+      Rm[3][3] = {{u * cl, t * cl, -sl},
+                  {u * sl, t * sl,  cl},
+                  {t     ,     -u,   0}},
+      Hl[3][3] = {{hrr, hrt, hrl},
+                  {hrt, htt, htl},
+                  {hrl, htl, hll}},
+      Hx[3][3];
+    for (int i = 0; i < 3; ++i)
+      for (int j = i; j < 3; ++j) {
+        real sum = 0;
+        for (int l = 0; l < 3; ++l)
+          for (int l1 = 0; l1 < 3; ++l1)
+            sum += Rm[i][l] * Hl[l][l1] * Rm[j][l1];
+        Hx[i][j] = sum;
+      }
+    gradx = cl * (u * gr + t * gt) - sl * gl;
+    grady = sl * (u * gr + t * gt) + cl * gl;
+    gradz =       t * gr - u * gt            ;
+    hxx = Hx[0][0]; hxy = Hx[0][1]; hxz = Hx[0][2];
+    hyy = Hx[1][1]; hyz = Hx[1][2]; hzz = Hx[2][2];
+    return vc[VV];
+  }
+
+  template<bool gradp, SphericalEngine::normalization norm, int L>
+  CircularEngine SphericalEngine::Circle(const coeff c[], const real f[],
+                                         real p, real z, real a,
+                                         unsigned threads) {
+    CircularEngine circ;
+    Circle<gradp, norm, L>(c, f, p, z, a, threads, circ);
     return circ;
   }
 
+  template<bool gradp, SphericalEngine::normalization norm, int L>
+  void SphericalEngine::Circle(const coeff c[], const real f[],
+                               real p, real z, real a, unsigned threads,
+                               CircularEngine& circ) {
+
+    static_assert(L > 0, "L must be positive");
+    static_assert(norm == FULL || norm == SCHMIDT, "Unknown normalization");
+    int N = c[0].nmx(), M = c[0].mmx();
+
+    real
+      r = hypot(z, p),
+      t = r != 0 ? z / r : 0,   // cos(theta); at origin, pick theta = pi/2
+      u = r != 0 ? max(p / r, eps()) : 1, // sin(theta); but avoid the pole
+      q = a / r;
+    real
+      q2 = Math::sq(q),
+      tu = t / u;
+    circ.Reset(M, gradp, norm, a, r, u, t);
+    const real* root = sqrttable();
+    // Compute the inner sums for orders m1 - 1 .. m0; each order is
+    // independent of the others.
+    auto orders = [&](int m0, int m1) -> void {
+      int k[L];
+      for (int m = m1 - 1; m >= m0; --m) {   // m = m1 - 1 .. m0
+        // Initialize inner sum
+        real
+          wc  = 0, wc2  = 0, ws  = 0, ws2  = 0, // w [N - m + 1], w [N - m + 2]
+          wrc = 0, wrc2 = 0, wrs = 0, wrs2 = 0, // wr[N - m + 1], wr[N - m + 2]
+          wtc = 0, wtc2 = 0, wts = 0, wts2 = 0; // wt[N - m + 1], wt[N - m + 2]
+        for (int l = 0; l < L; ++l)
+          k[l] = c[l].index(N, m) + 1;
+        for (int n = N; n >= m; --n) {             // n = N .. m; l = N - m .. 0
+          real w, A, Ax, B, R;    // alpha[l], beta[l + 1]
+          switch (norm) {
+          case FULL:
+            w = root[2 * n + 1] / (root[n - m + 1] * root[n + m + 1]);
+            Ax = q * w * root[2 * n + 3];
+            A = t * Ax;
+            B = - q2 * root[2 * n + 5] /
+              (w * root[n - m + 2] * root[n + m + 2]);
+            break;
+          case SCHMIDT:
+            w = root[n - m + 1] * root[n + m + 1];
+            Ax = q * (2 * n + 1) / w;
+            A = t * Ax;
+            B = - q2 * w / (root[n - m + 2] * root[n + m + 2]);
+            break;
+          default: break;     // To suppress warning message from Visual Studio
+          }
+          R = c[0].Cv(--k[0]);
+          for (int l = 1; l < L; ++l)
+            R += c[l].Cv(--k[l], n, m, f[l]);
+          R *= scale();
+          w = A * wc + B * wc2 + R; wc2 = wc; wc = w;
+          if (gradp) {
+            w = A * wrc + B * wrc2 + (n + 1) * R; wrc2 = wrc; wrc = w;
+            w = A * wtc + B * wtc2 -  u*Ax * wc2; wtc2 = wtc; wtc = w;
+          }
+          if (m) {
+            R = c[0].Sv(k[0]);
+            for (int l = 1; l < L; ++l)
+              R += c[l].Sv(k[l], n, m, f[l]);
+            R *= scale();
+            w = A * ws + B * ws2 + R; ws2 = ws; ws = w;
+            if (gradp) {
+              w = A * wrs + B * wrs2 + (n + 1) * R; wrs2 = wrs; wrs = w;
+              w = A * wts + B * wts2 -  u*Ax * ws2; wts2 = wts; wts = w;
+            }
+          }
+        }
+        if (!gradp)
+          circ.SetCoeff(m, wc, ws);
+        else {
+          // Include the terms Sc[m] * P'[m,m](t) and  Ss[m] * P'[m,m](t)
+          wtc += m * tu * wc; wts += m * tu * ws;
+          circ.SetCoeff(m, wc, ws, wrc, wrs, wtc, wts);
+        }
+      }
+    };
+
+    int nchunks = (M + morders_) / morders_;
+    if (threads <= 1 || nchunks <= 1)
+      orders(0, M + 1);
+    else {
+      // The chunks of morders_ orders are claimed starting with the low
+      // orders (where the inner sums are longest) to balance the load.
+      Executor::Parallel(size_t(nchunks), threads, [&](size_t i) -> void {
+        orders(int(i) * morders_, min(M + 1, (int(i) + 1) * morders_));
+      });
+    }
+  }
+
+  template<bool gradp, SphericalEngine::normalization norm, int L>
+  RadialEngine SphericalEngine::Radial(const coeff c[], const real f[],
+                                       real x, real y, real z, real a) {
+    static_assert(L > 0, "L must be positive");
+    static_assert(norm == FULL || norm == SCHMIDT, "Unknown normalization");
+    int N = c[0].nmx(), M = c[0].mmx();
+
+    real
+      p = hypot(x, y),
+      cl = p != 0 ? x / p : 1,  // cos(lambda); at pole, pick lambda = 0
+      sl = p != 0 ? y / p : 0,  // sin(lambda)
+      r = hypot(z, p),
+      t = r != 0 ? z / r : 0,   // cos(theta); at origin, pick theta = pi/2
+      u = r != 0 ? max(p / r, eps()) : 1; // sin(theta); but avoid the pole
+    RadialEngine rad(N, gradp, a, u, t, cl, sl);
+    if (N < 0) return rad;
+    const real* root = sqrttable();
+    // The fully normalized associated Legendre functions P[n,m](t) are found
+    // by recursion over n starting with P[m,m](t) = const * u^m.  These span
+    // a range far larger than doubles can represent, so the recursion is
+    // carried out on x with P = x * 2^e and x is renormalized if it
+    // grows too large (or, for P[m,m], too small).  The contributions which
+    // underflow when converted back to doubles are negligible.
+    const int ebig = numeric_limits<real>::max_exponent / 2;
+    const real big = ldexp(real(1), ebig), small = 1 / big;
+    // P[m,m] = pmm[m] * 2^emm[m]
+    vector<real> pmm(max(M, 1) + 1);
+    vector<int> emm(pmm.size());
+    {
+      real xmm = 1; int e = 0;
+      for (int m = 0; m < int(pmm.size()); ++m) {
+        if (m > 0) {
+          xmm *= u * (m == 1 ? root[3] : root[2 * m + 1] / root[2 * m]);
+          if (abs(xmm) < small) { xmm *= big; e -= ebig; }
+        }
+        pmm[m] = xmm; emm[m] = e;
+      }
+    }
+    // Set P[n] = P[n,m](t) for n = m .. N
+    auto column = [&](int m, real P[]) -> void {
+      int e = emm[m];
+      real x2 = pmm[m], x1 = root[2 * m + 3] * t * x2, fac = ldexp(real(1), e);
+      P[m] = x2 * fac;
+      if (m < N) P[m + 1] = x1 * fac;
+      for (int n = m + 2; n <= N; ++n) {
+        real
+          w = root[n - m] * root[n + m],
+          A = root[2 * n - 1] * root[2 * n + 1] / w,
+          B = root[2 * n + 1] * root[n + m - 1] * root[n - m - 1] /
+          (w * root[2 * n - 3]),
+          x0 = A * t * x1 - B * x2;
+        x2 = x1; x1 = x0;
+        if (abs(x1) > big) {
+          x1 *= small; x2 *= small; e += ebig; fac = ldexp(real(1), e);
+        }
+        P[n] = x1 * fac;
+      }
+    };
+    vector<real> P(N + 1), P1(gradp && N >= 1 ? N + 1 : 0);
+    // The derivatives for m = 0 need P[n,1]
+    if (gradp && N >= 1) column(1, P1.data());
+    int k[L];
+    real cm = 1, sm = 0;        // cos(m*lambda), sin(m*lambda)
+    for (int m = 0; m <= M; ++m) {
+      if (m > 0) {
+        real c1 = cm * cl - sm * sl;
+        sm = sm * cl + cm * sl; cm = c1;
+      }
+      if (m == 1 && gradp)
+        P.swap(P1);
+      else
+        column(m, P.data());
+      for (int l = 0; l < L; ++l)
+        k[l] = c[l].index(m, m);
+      for (int n = m; n <= N; ++n) {
+        real C = c[0].Cv(k[0]), S = m ? c[0].Sv(k[0]) : 0;
+        for (int l = 1; l < L; ++l) {
+          C += c[l].Cv(k[l], n, m, f[l]);
+          if (m) S += c[l].Sv(k[l], n, m, f[l]);
+        }
+        for (int l = 0; l < L; ++l) ++k[l];
+        // Convert to Schmidt semi-normalized functions if necessary
+        real s = norm == FULL ? 1 : 1 / root[2 * n + 1],
+          Pn = s * P[n], cs = C * cm + S * sm;
+        rad._v[n] += Pn * cs;
+        if (gradp) {
+          // dP[n,m]/dtheta
+          real dP = m == 0 ?
+            (n > 0 ? - root[n] * root[n + 1] / root[2] * P1[n] : 0) :
+            (n * t * P[n] - (n > m ? root[n - m] * root[n + m] *
+                             root[2 * n + 1] / root[2 * n - 1] * P[n - 1] :
+                             0)) / u;
+          rad._vt[n] += s * dP * cs;
+          if (m) rad._vl[n] += m * Pn / u * (S * cm - C * sm);
+        }
+      }
+    }
+    return rad;
+  }
+
   void SphericalEngine::RootTable(int N) {
     // Need square roots up to max(2 * N + 5, 15).
-    vector<real>& root( sqrttable() );
-    int L = max(2 * N + 5, 15) + 1, oldL = int(root.size());
-    if (oldL >= L)
+    roottable& r = roots();
+    int L = max(2 * N + 5, 15) + 1;
+    if (r.size.load(memory_order_acquire) >= L)
+      return;
+    lock_guard<mutex> g(r.lock);
+    int oldL = r.size.load(memory_order_relaxed);
+    if (oldL >= L)              // Another thread got here first
       return;
-    root.resize(L);
+    L = max(L, oldL + oldL / 2);
+    unique_ptr<real[]> root(new real[L]);
+    const real* oldroot = r.current.load(memory_order_relaxed);
+    for (int l = 0; l < oldL; ++l)
+      root[l] = oldroot[l];
     for (int l = oldL; l < L; ++l)
       root[l] = sqrt(real(l));
+    r.tables.reserve(r.tables.size() + 1); // so push_back can't throw
+    r.current.store(root.get(), memory_order_release);
+    r.size.store(L, memory_order_release);
+    r.tables.push_back(move(root));
+  }
+
+  void SphericalEngine::ClearRootTable() {
+    roottable& r = roots();
+    lock_guard<mutex> g(r.lock);
+    r.current.store(nullptr, memory_order_release);
+    r.size.store(0, memory_order_release);
+    vector< unique_ptr<real[]> >().swap(r.tables);
   }
 
   void SphericalEngine::coeff::readcoeffs(istream& stream, int& N, int& M,
@@ -427,84 +913,302 @@ namespace GeographicLib {
     return;
   }
 
+  void SphericalEngine::coeff::mapcoeffs(char* data, size_t size,
+                                         size_t& pos, int& N, int& M,
+                                         real*& C, real*& S) {
+    int nm[2];
+    if (!(pos <= size && size - pos >= sizeof(nm)))
+      throw GeographicErr("Missing degree and order in mapped coefficients");
+    memcpy(nm, data + pos, sizeof(nm));
+    pos += sizeof(nm);
+    N = nm[0]; M = nm[1];
+    if (!((N >= M && M >= 0) || (N == -1 && M == -1)))
+      // The last condition is that M = -1 implies N = -1.
+      throw GeographicErr("Bad degree and order " +
+                          Utility::str(N) + " " + Utility::str(M));
+    size_t
+      nc = size_t(Csize(N, M)), ns = size_t(Ssize(N, M)),
+      len = (nc + ns) * sizeof(real);
+    if (size - pos < len)
+      throw GeographicErr("Mapped coefficients are truncated");
+    if ((reinterpret_cast<uintptr_t>(data) + pos) % alignof(real) != 0)
+      throw GeographicErr("Mapped coefficients are misaligned");
+    C = reinterpret_cast<real*>(data + pos);
+    S = C + nc;
+    pos += len;
+  }
+
+  SphericalEngine::mappedfile::~mappedfile() {
+#if !defined(_WIN32)
+    if (_data)
+      munmap(_data, _size);
+#endif
+  }
+
+  void SphericalEngine::mappedfile::Map(const std::string& filename) {
+#if !defined(_WIN32)
+    if (_data) {
+      munmap(_data, _size);
+      _data = nullptr; _size = 0;
+    }
+    // Use a shared memory segment holding the file if there is one
+    int fd = SharedData::Open(filename);
+    if (fd < 0)
+      fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw GeographicErr("Error opening " + filename);
+    struct stat sb;
+    if (fstat(fd, &sb) < 0 || sb.st_size <= 0) {
+      close(fd);
+      throw GeographicErr("Cannot determine the size of " + filename);
+    }
+    size_t size = size_t(sb.st_size);
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // The mapping remains valid after the file is closed
+    close(fd);
+    if (p == MAP_FAILED)
+      throw GeographicErr("Cannot memory map " + filename);
+    _data = static_cast<char*>(p);
+    _size = size;
+#else
+    throw GeographicErr("Memory mapping is not supported on this system");
+#endif
+  }
+
+  bool SphericalEngine::mappedfile::Supported() {
+#if !defined(_WIN32)
+    return !Math::bigendian && numeric_limits<real>::is_iec559 &&
+      sizeof(real) == sizeof(double);
+#else
+    return false;
+#endif
+  }
+
   /// \cond SKIP
   template Math::real GEOGRAPHICLIB_EXPORT
   SphericalEngine::Value<true, SphericalEngine::FULL, 1>
-  (const coeff[], const real[], real, real, real, real, real&, real&, real&);
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   unsigned);
   template Math::real GEOGRAPHICLIB_EXPORT
   SphericalEngine::Value<false, SphericalEngine::FULL, 1>
-  (const coeff[], const real[], real, real, real, real, real&, real&, real&);
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   unsigned);
   template Math::real GEOGRAPHICLIB_EXPORT
   SphericalEngine::Value<true, SphericalEngine::SCHMIDT, 1>
-  (const coeff[], const real[], real, real, real, real, real&, real&, real&);
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   unsigned);
   template Math::real GEOGRAPHICLIB_EXPORT
   SphericalEngine::Value<false, SphericalEngine::SCHMIDT, 1>
-  (const coeff[], const real[], real, real, real, real, real&, real&, real&);
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   unsigned);
 
   template Math::real GEOGRAPHICLIB_EXPORT
   SphericalEngine::Value<true, SphericalEngine::FULL, 2>
-  (const coeff[], const real[], real, real, real, real, real&, real&, real&);
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   unsigned);
   template Math::real GEOGRAPHICLIB_EXPORT
   SphericalEngine::Value<false, SphericalEngine::FULL, 2>
-  (const coeff[], const real[], real, real, real, real, real&, real&, real&);
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   unsigned);
   template Math::real GEOGRAPHICLIB_EXPORT
   SphericalEngine::Value<true, SphericalEngine::SCHMIDT, 2>
-  (const coeff[], const real[], real, real, real, real, real&, real&, real&);
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   unsigned);
   template Math::real GEOGRAPHICLIB_EXPORT
   SphericalEngine::Value<false, SphericalEngine::SCHMIDT, 2>
-  (const coeff[], const real[], real, real, real, real, real&, real&, real&);
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   unsigned);
 
   template Math::real GEOGRAPHICLIB_EXPORT
   SphericalEngine::Value<true, SphericalEngine::FULL, 3>
-  (const coeff[], const real[], real, real, real, real, real&, real&, real&);
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   unsigned);
   template Math::real GEOGRAPHICLIB_EXPORT
   SphericalEngine::Value<false, SphericalEngine::FULL, 3>
-  (const coeff[], const real[], real, real, real, real, real&, real&, real&);
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   unsigned);
   template Math::real GEOGRAPHICLIB_EXPORT
   SphericalEngine::Value<true, SphericalEngine::SCHMIDT, 3>
-  (const coeff[], const real[], real, real, real, real, real&, real&, real&);
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   unsigned);
   template Math::real GEOGRAPHICLIB_EXPORT
   SphericalEngine::Value<false, SphericalEngine::SCHMIDT, 3>
-  (const coeff[], const real[], real, real, real, real, real&, real&, real&);
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   unsigned);
+
+  template Math::real GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Hessian<SphericalEngine::FULL, 1>
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   real&, real&, real&, real&, real&, real&);
+  template Math::real GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Hessian<SphericalEngine::SCHMIDT, 1>
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   real&, real&, real&, real&, real&, real&);
+
+  template Math::real GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Hessian<SphericalEngine::FULL, 2>
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   real&, real&, real&, real&, real&, real&);
+  template Math::real GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Hessian<SphericalEngine::SCHMIDT, 2>
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   real&, real&, real&, real&, real&, real&);
+
+  template Math::real GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Hessian<SphericalEngine::FULL, 3>
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   real&, real&, real&, real&, real&, real&);
+  template Math::real GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Hessian<SphericalEngine::SCHMIDT, 3>
+  (const coeff[], const real[], real, real, real, real, real&, real&, real&,
+   real&, real&, real&, real&, real&, real&);
+
+  template Math::real GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Horizontal<SphericalEngine::FULL, 1>
+  (const coeff[], const real[], real, real, real, real, real&, real&);
+  template Math::real GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Horizontal<SphericalEngine::SCHMIDT, 1>
+  (const coeff[], const real[], real, real, real, real, real&, real&);
+
+  template Math::real GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Horizontal<SphericalEngine::FULL, 2>
+  (const coeff[], const real[], real, real, real, real, real&, real&);
+  template Math::real GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Horizontal<SphericalEngine::SCHMIDT, 2>
+  (const coeff[], const real[], real, real, real, real, real&, real&);
+
+  template Math::real GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Horizontal<SphericalEngine::FULL, 3>
+  (const coeff[], const real[], real, real, real, real, real&, real&);
+  template Math::real GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Horizontal<SphericalEngine::SCHMIDT, 3>
+  (const coeff[], const real[], real, real, real, real, real&, real&);
 
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<true, SphericalEngine::FULL, 1>
-  (const coeff[], const real[], real, real, real);
+  (const coeff[], const real[], real, real, real, unsigned);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circle<true, SphericalEngine::FULL, 1>
+  (const coeff[], const real[], real, real, real, unsigned,
+   CircularEngine&);
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<false, SphericalEngine::FULL, 1>
-  (const coeff[], const real[], real, real, real);
+  (const coeff[], const real[], real, real, real, unsigned);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circle<false, SphericalEngine::FULL, 1>
+  (const coeff[], const real[], real, real, real, unsigned,
+   CircularEngine&);
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<true, SphericalEngine::SCHMIDT, 1>
-  (const coeff[], const real[], real, real, real);
+  (const coeff[], const real[], real, real, real, unsigned);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circle<true, SphericalEngine::SCHMIDT, 1>
+  (const coeff[], const real[], real, real, real, unsigned,
+   CircularEngine&);
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<false, SphericalEngine::SCHMIDT, 1>
-  (const coeff[], const real[], real, real, real);
+  (const coeff[], const real[], real, real, real, unsigned);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circle<false, SphericalEngine::SCHMIDT, 1>
+  (const coeff[], const real[], real, real, real, unsigned,
+   CircularEngine&);
 
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<true, SphericalEngine::FULL, 2>
-  (const coeff[], const real[], real, real, real);
+  (const coeff[], const real[], real, real, real, unsigned);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circle<true, SphericalEngine::FULL, 2>
+  (const coeff[], const real[], real, real, real, unsigned,
+   CircularEngine&);
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<false, SphericalEngine::FULL, 2>
-  (const coeff[], const real[], real, real, real);
+  (const coeff[], const real[], real, real, real, unsigned);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circle<false, SphericalEngine::FULL, 2>
+  (const coeff[], const real[], real, real, real, unsigned,
+   CircularEngine&);
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<true, SphericalEngine::SCHMIDT, 2>
-  (const coeff[], const real[], real, real, real);
+  (const coeff[], const real[], real, real, real, unsigned);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circle<true, SphericalEngine::SCHMIDT, 2>
+  (const coeff[], const real[], real, real, real, unsigned,
+   CircularEngine&);
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<false, SphericalEngine::SCHMIDT, 2>
-  (const coeff[], const real[], real, real, real);
+  (const coeff[], const real[], real, real, real, unsigned);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circle<false, SphericalEngine::SCHMIDT, 2>
+  (const coeff[], const real[], real, real, real, unsigned,
+   CircularEngine&);
 
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<true, SphericalEngine::FULL, 3>
-  (const coeff[], const real[], real, real, real);
+  (const coeff[], const real[], real, real, real, unsigned);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circle<true, SphericalEngine::FULL, 3>
+  (const coeff[], const real[], real, real, real, unsigned,
+   CircularEngine&);
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<false, SphericalEngine::FULL, 3>
-  (const coeff[], const real[], real, real, real);
+  (const coeff[], const real[], real, real, real, unsigned);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circle<false, SphericalEngine::FULL, 3>
+  (const coeff[], const real[], real, real, real, unsigned,
+   CircularEngine&);
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<true, SphericalEngine::SCHMIDT, 3>
-  (const coeff[], const real[], real, real, real);
+  (const coeff[], const real[], real, real, real, unsigned);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circle<true, SphericalEngine::SCHMIDT, 3>
+  (const coeff[], const real[], real, real, real, unsigned,
+   CircularEngine&);
   template CircularEngine GEOGRAPHICLIB_EXPORT
   SphericalEngine::Circle<false, SphericalEngine::SCHMIDT, 3>
-  (const coeff[], const real[], real, real, real);
+  (const coeff[], const real[], real, real, real, unsigned);
+  template void GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Circle<false, SphericalEngine::SCHMIDT, 3>
+  (const coeff[], const real[], real, real, real, unsigned,
+   CircularEngine&);
+
+  template RadialEngine GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Radial<true, SphericalEngine::FULL, 1>
+  (const coeff[], const real[], real, real, real, real);
+  template RadialEngine GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Radial<true, SphericalEngine::SCHMIDT, 1>
+  (const coeff[], const real[], real, real, real, real);
+  template RadialEngine GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Radial<false, SphericalEngine::FULL, 1>
+  (const coeff[], const real[], real, real, real, real);
+  template RadialEngine GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Radial<false, SphericalEngine::SCHMIDT, 1>
+  (const coeff[], const real[], real, real, real, real);
+
+  template RadialEngine GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Radial<true, SphericalEngine::FULL, 2>
+  (const coeff[], const real[], real, real, real, real);
+  template RadialEngine GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Radial<true, SphericalEngine::SCHMIDT, 2>
+  (const coeff[], const real[], real, real, real, real);
+  template RadialEngine GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Radial<false, SphericalEngine::FULL, 2>
+  (const coeff[], const real[], real, real, real, real);
+  template RadialEngine GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Radial<false, SphericalEngine::SCHMIDT, 2>
+  (const coeff[], const real[], real, real, real, real);
+
+  template RadialEngine GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Radial<true, SphericalEngine::FULL, 3>
+  (const coeff[], const real[], real, real, real, real);
+  template RadialEngine GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Radial<true, SphericalEngine::SCHMIDT, 3>
+  (const coeff[], const real[], real, real, real, real);
+  template RadialEngine GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Radial<false, SphericalEngine::FULL, 3>
+  (const coeff[], const real[], real, real, real, real);
+  template RadialEngine GEOGRAPHICLIB_EXPORT
+  SphericalEngine::Radial<false, SphericalEngine::SCHMIDT, 3>
+  (const coeff[], const real[], real, real, real, real);
   /// \endcond
 
 } // namespace GeographicLib
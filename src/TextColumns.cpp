@@ -0,0 +1,168 @@
+/**
+ * \file TextColumns.cpp
+ * \brief Implementation for GeographicLib::TextColumns class
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <cctype>
+#include <GeographicLib/TextColumns.hpp>
+#include <GeographicLib/DMS.hpp>
+#include <GeographicLib/Utility.hpp>
+
+#if defined(__SSE2__)
+// SSE2 is part of the x86-64 baseline, so no run-time dispatch is needed.
+#  include <emmintrin.h>
+#endif
+
+namespace GeographicLib {
+
+  using namespace std;
+
+  namespace {
+    typedef unsigned char uchar;
+
+    inline bool isdelim(char c, bool commas) {
+      return isspace(uchar(c)) || (commas && c == ',');
+    }
+
+    // The same test as in DMS.cpp: a plain decimal number which
+    // DMS::Decode converts without further processing.
+    bool plaindecimal(const char* p, size_t n) {
+      const char* e = p + n;
+      while (p < e && isspace(uchar(*p))) ++p;
+      while (p < e && isspace(uchar(e[-1]))) --e;
+      if (p < e && (*p == '+' || *p == '-')) ++p;
+      int nint = 0, nfrac = 0;
+      for (; p < e && isdigit(uchar(*p)); ++p) ++nint;
+      bool pointseen = p < e && *p == '.';
+      if (pointseen)
+        for (++p; p < e && isdigit(uchar(*p)); ++p) ++nfrac;
+      return p == e && nint + nfrac > 0 && (pointseen || nint <= 15);
+    }
+  }
+
+  size_t TextColumns::Split(const char* line, size_t len, size_t maxfields,
+                            const char* field[], size_t flen[],
+                            bool commas) {
+    size_t nf = 0, i = 0, start = 0;
+    bool infield = false;
+    if (maxfields == 0) return 0;
+#if defined(__SSE2__)
+    // Find the delimiters 16 characters at a time.  In the C locale, the
+    // white space characters are ' ' and '\t' through '\r'.  Bits set in
+    // starts and ends mark the first character of a field and the delimiter
+    // following a field.
+    const __m128i
+      space = _mm_set1_epi8(' '),
+      comma = _mm_set1_epi8(commas ? ',' : ' '),
+      lo = _mm_set1_epi8('\t' - 1),
+      hi = _mm_set1_epi8('\r' + 1);
+    for (; i + 16 <= len; i += 16) {
+      __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(line + i));
+      __m128i d = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space),
+                                            _mm_cmpeq_epi8(v, comma)),
+                               _mm_and_si128(_mm_cmpgt_epi8(v, lo),
+                                             _mm_cmplt_epi8(v, hi)));
+      unsigned
+        delim = unsigned(_mm_movemask_epi8(d)),
+        text = ~delim & 0xffffu,
+        prev = (text << 1) | (infield ? 1u : 0u),
+        starts = text & ~prev,
+        ends = delim & prev;
+      infield = (text >> 15) != 0;
+      while (starts | ends) {
+        // starts and ends alternate; take the lower of the two
+        unsigned s = starts & (0u - starts), e = ends & (0u - ends);
+        if (s && (!e || s < e)) {
+          start = i + unsigned(__builtin_ctz(s));
+          starts ^= s;
+        } else {
+          size_t j = i + unsigned(__builtin_ctz(e));
+          field[nf] = line + start; flen[nf] = j - start;
+          if (++nf == maxfields) return nf;
+          ends ^= e;
+        }
+      }
+    }
+#endif
+    for (; i < len; ++i) {
+      bool delim = isdelim(line[i], commas);
+      if (!infield && !delim) {
+        start = i; infield = true;
+      } else if (infield && delim) {
+        field[nf] = line + start; flen[nf] = i - start;
+        if (++nf == maxfields) return nf;
+        infield = false;
+      }
+    }
+    if (infield) {
+      field[nf] = line + start; flen[nf] = len - start;
+      ++nf;
+    }
+    return nf;
+  }
+
+  size_t TextColumns::DecodeNumbers(size_t n,
+                                    const char* const field[],
+                                    const size_t flen[],
+                                    real val[], string err[]) {
+    size_t nerr = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (!field[i]) continue;
+      real x;
+      if (Utility::fastval(field[i], flen[i], x)) {
+        val[i] = x;
+        continue;
+      }
+      try {
+        val[i] = Utility::val<real>(string(field[i], flen[i]));
+      }
+      catch (const exception& e) {
+        err[i] = e.what();
+        ++nerr;
+      }
+    }
+    return nerr;
+  }
+
+  size_t TextColumns::DecodeLatLon(size_t n,
+                                   const char* const a[], const size_t alen[],
+                                   const char* const b[], const size_t blen[],
+                                   bool longfirst,
+                                   real lat[], real lon[], string err[]) {
+    size_t nerr = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (!a[i] || !b[i]) continue;
+      real x, y;
+      if (plaindecimal(a[i], alen[i]) && plaindecimal(b[i], blen[i]) &&
+          Utility::fastval(a[i], alen[i], x) &&
+          Utility::fastval(b[i], blen[i], y)) {
+        // As in DMS::Decode, -0 is converted to +0
+        x += 0; y += 0;
+        real
+          lat1 = longfirst ? y : x,
+          lon1 = longfirst ? x : y;
+        if (abs(lat1) > 90) {
+          err[i] = "Latitude " + Utility::str(lat1) + "d not in [-90d, 90d]";
+          ++nerr;
+        } else {
+          lat[i] = lat1; lon[i] = lon1;
+        }
+        continue;
+      }
+      try {
+        DMS::DecodeLatLon(string(a[i], alen[i]), string(b[i], blen[i]),
+                          lat[i], lon[i], longfirst);
+      }
+      catch (const exception& e) {
+        err[i] = e.what();
+        ++nerr;
+      }
+    }
+    return nerr;
+  }
+
+} // namespace GeographicLib
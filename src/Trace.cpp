@@ -0,0 +1,34 @@
+/**
+ * \file Trace.cpp
+ * \brief The TraceLogging provider for the static tracepoints
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <GeographicLib/Trace.hpp>
+
+#if GEOGRAPHICLIB_TRACEPOINTS && defined(GEOGRAPHICLIB_TRACE_ETW)
+
+// The USDT probes need no support code; on Windows, the provider is defined
+// here and registered while the library is loaded.
+
+// {6f0c2a64-3d0e-5a4b-9a0e-8b0c3f5c1e27}
+TRACELOGGING_DEFINE_PROVIDER(GeographicLibTraceProvider, "GeographicLib",
+                             (0x6f0c2a64, 0x3d0e, 0x5a4b, 0x9a, 0x0e,
+                              0x8b, 0x0c, 0x3f, 0x5c, 0x1e, 0x27));
+
+namespace GeographicLib {
+
+  namespace {
+    struct TraceRegistration {
+      TraceRegistration() { TraceLoggingRegister(GeographicLibTraceProvider); }
+      ~TraceRegistration()
+      { TraceLoggingUnregister(GeographicLibTraceProvider); }
+    } traceregistration_;
+  }
+
+} // namespace GeographicLib
+
+#endif
@@ -31,18 +31,22 @@
  * If the preprocessor variable GEOGRAPHICLIB_TRANSVERSEMERCATOR_ORDER is set
  * to an integer between 4 and 8, then this specifies the order of the series
  * used for the forward and reverse transformations.  The default value is 6.
+ * A lower order can be selected at run time with the \e order argument of the
+ * constructor.
  * (The series accurate to 12th order is given in \ref tmseries.)
  **********************************************************************/
 
 #include <complex>
 #include <GeographicLib/TransverseMercator.hpp>
+#include <GeographicLib/Trace.hpp>
 
 namespace GeographicLib {
 
   using namespace std;
 
-  TransverseMercator::TransverseMercator(real a, real f, real k0)
-    : _a(a)
+  TransverseMercator::TransverseMercator(real a, real f, real k0, int order)
+    : _order(order)
+    , _a(a)
     , _f(f)
     , _k0(k0)
     , _e2(_f * (2 - _f))
@@ -59,6 +63,8 @@ namespace GeographicLib {
       throw GeographicErr("Polar semi-axis is not positive");
     if (!(isfinite(_k0) && _k0 > 0))
       throw GeographicErr("Scale is not positive");
+    if (!(_order >= 1 && _order <= maxpow_))
+      throw GeographicErr("Series order out of range");
 
     // Generated by Maxima on 2015-05-14 22:55:13-04:00
 #if GEOGRAPHICLIB_TRANSVERSEMERCATOR_ORDER/2 == 2
@@ -254,17 +260,26 @@ namespace GeographicLib {
     static_assert(sizeof(betcoeff) / sizeof(real) ==
                   (maxpow_ * (maxpow_ + 3))/2,
                   "Coefficient array size mismatch for bet");
-    int m = maxpow_/2;
-    _b1 = Math::polyval(m, b1coeff, Math::sq(_n)) / (b1coeff[m + 1] * (1+_n));
+    // The series for a lower order are the truncations of the polynomials
+    // (whose coefficients are given highest power first), so skip the
+    // leading coefficients.
+    int m = maxpow_/2, p = _order/2;
+    _b1 = Math::polyval(p, b1coeff + (m - p), Math::sq(_n)) /
+      (b1coeff[m + 1] * (1+_n));
     // _a1 is the equivalent radius for computing the circumference of
     // ellipse.
     _a1 = _b1 * _a;
     int o = 0;
     real d = _n;
     for (int l = 1; l <= maxpow_; ++l) {
-      m = maxpow_ - l;
-      _alp[l] = d * Math::polyval(m, alpcoeff + o, _n) / alpcoeff[o + m + 1];
-      _bet[l] = d * Math::polyval(m, betcoeff + o, _n) / betcoeff[o + m + 1];
+      m = maxpow_ - l; p = _order - l;
+      if (p >= 0) {
+        _alp[l] = d * Math::polyval(p, alpcoeff + o + (m - p), _n) /
+          alpcoeff[o + m + 1];
+        _bet[l] = d * Math::polyval(p, betcoeff + o + (m - p), _n) /
+          betcoeff[o + m + 1];
+      } else
+        _alp[l] = _bet[l] = 0;
       o += m + 2;
       d *= _n;
     }
@@ -422,11 +437,11 @@ namespace GeographicLib {
     // The conversion from conformal to rectifying latitude can be expressed as
     // a series in _n:
     //
-    //   zeta = zeta' + sum(h[j-1]' * sin(2 * j * zeta'), j = 1..maxpow_)
+    //   zeta = zeta' + sum(h[j-1]' * sin(2 * j * zeta'), j = 1..order)
     //
     // where h[j]' = O(_n^j).  The reversion of this series gives
     //
-    //   zeta' = zeta - sum(h[j-1] * sin(2 * j * zeta), j = 1..maxpow_)
+    //   zeta' = zeta - sum(h[j-1] * sin(2 * j * zeta), j = 1..order)
     //
     // which is used in Reverse.
     //
@@ -451,7 +466,7 @@ namespace GeographicLib {
     //    alpha[k](x) = 2 * cos(x)
     //    beta[k](x) = -1
     //    [ sin(A+B) - 2*cos(B)*sin(A) + sin(A-B) = 0, A = k*x, B = x ]
-    //    n = maxpow_
+    //    n = order
     //    a[k] = _alp[k]
     //    S = b[1] * sin(x)
     //
@@ -480,7 +495,7 @@ namespace GeographicLib {
       c0 = cos(2 * xip), ch0 = cosh(2 * etap),
       s0 = sin(2 * xip), sh0 = sinh(2 * etap);
     complex<real> a(2 * c0 * ch0, -2 * s0 * sh0); // 2 * cos(2*zeta')
-    int n = maxpow_;
+    int n = _order;
     complex<real>
       y0(n & 1 ?       _alp[n] : 0), y1, // default initializer is 0+i0
       z0(n & 1 ? 2*n * _alp[n] : 0), z1;
@@ -533,7 +548,7 @@ namespace GeographicLib {
       c0 = cos(2 * xi), ch0 = cosh(2 * eta),
       s0 = sin(2 * xi), sh0 = sinh(2 * eta);
     complex<real> a(2 * c0 * ch0, -2 * s0 * sh0); // 2 * cos(2*zeta)
-    int n = maxpow_;
+    int n = _order;
     complex<real>
       y0(n & 1 ?       -_bet[n] : 0), y1, // default initializer is 0+i0
       z0(n & 1 ? -2*n * _bet[n] : 0), z1;
@@ -591,4 +606,30 @@ namespace GeographicLib {
     k *= _k0;
   }
 
+  void TransverseMercator::ForwardBatch(size_t n, real lon0,
+                                        const real lat[], const real lon[],
+                                        real x[], real y[],
+                                        real gamma[], real k[]) const {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "TransverseMercator::ForwardBatch", n);
+    for (size_t i = 0; i < n; ++i) {
+      real gammax, kx;
+      Forward(lon0, lat[i], lon[i], x[i], y[i], gammax, kx);
+      if (gamma) gamma[i] = gammax;
+      if (k) k[i] = kx;
+    }
+  }
+
+  void TransverseMercator::ReverseBatch(size_t n, real lon0,
+                                        const real x[], const real y[],
+                                        real lat[], real lon[],
+                                        real gamma[], real k[]) const {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "TransverseMercator::ReverseBatch", n);
+    for (size_t i = 0; i < n; ++i) {
+      real gammax, kx;
+      Reverse(lon0, x[i], y[i], lat[i], lon[i], gammax, kx);
+      if (gamma) gamma[i] = gammax;
+      if (k) k[i] = kx;
+    }
+  }
+
 } // namespace GeographicLib
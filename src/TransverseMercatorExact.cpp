@@ -189,7 +189,7 @@ namespace GeographicLib {
     real
       psi = asinh(taup),
       scal = 1/hypot(real(1), taup);
-    if (zetainv0(psi, lam, u, v))
+    if (!_ztab.Guess(psi, lam, u, v) && zetainv0(psi, lam, u, v))
       return;
     real stol2 = tol2_ / Math::sq(max(psi, real(1)));
     // min iterations = 2, max iterations = 6; mean = 4.0
@@ -294,7 +294,7 @@ namespace GeographicLib {
   // Invert sigma using Newton's method
   void TransverseMercatorExact::sigmainv(real xi, real eta,
                                          real& u, real& v) const {
-    if (sigmainv0(xi, eta, u, v))
+    if (!_stab.Guess(xi, eta, u, v) && sigmainv0(xi, eta, u, v))
       return;
     // min iterations = 2, max iterations = 7; mean = 3.9
     for (int i = 0, trip = 0; i < numit_ || GEOGRAPHICLIB_PANIC; ++i) {
@@ -459,4 +459,134 @@ namespace GeographicLib {
     k *= _k0;
   }
 
+  bool TransverseMercatorExact::guesstab::Guess(real x, real y,
+                                                real& ux, real& vx) const {
+    if (nx == 0) return false;
+    real fx = (x - x0) / h, fy = (y - y0) / h;
+    // This also catches nans
+    if (!(fx >= 0 && fx <= nx && fy >= 0 && fy <= ny)) return false;
+    int ix = min(int(fx), nx - 1), iy = min(int(fy), ny - 1);
+    if (!ok[iy * nx + ix]) return false;
+    fx -= ix; fy -= iy;
+    // Weights for cubic interpolation using the nodes at -1, 0, 1, 2
+    real wx[4] = { -fx * (fx - 1) * (fx - 2) / 6,
+                   (fx + 1) * (fx - 1) * (fx - 2) / 2,
+                   -(fx + 1) * fx * (fx - 2) / 2,
+                   (fx + 1) * fx * (fx - 1) / 6 },
+      wy[4] = { -fy * (fy - 1) * (fy - 2) / 6,
+                (fy + 1) * (fy - 1) * (fy - 2) / 2,
+                -(fy + 1) * fy * (fy - 2) / 2,
+                (fy + 1) * fy * (fy - 1) / 6 };
+    ux = vx = 0;
+    for (int j = 0; j < 4; ++j) {
+      int k = (iy + j) * (nx + 3) + ix;
+      real su = 0, sv = 0;
+      for (int i = 0; i < 4; ++i) {
+        su += wx[i] * u[k + i];
+        sv += wx[i] * v[k + i];
+      }
+      ux += wy[j] * su;
+      vx += wy[j] * sv;
+    }
+    return true;
+  }
+
+  void TransverseMercatorExact::Tabulate(bool zetap, guesstab& t) const {
+    // Maximum error in a starting guess from the table
+    static const real maxerr = real(0.001);
+    int mx = t.nx + 3, my = t.ny + 3;
+    t.u.resize(mx * my); t.v.resize(mx * my);
+    // The exact inverses use the member tables which are empty at this point
+    for (int j = 0; j < my; ++j)
+      for (int i = 0; i < mx; ++i) {
+        real x = t.x0 + (i - 1) * t.h, y = t.y0 + (j - 1) * t.h;
+        if (zetap)
+          zetainv(sinh(x), y, t.u[j * mx + i], t.v[j * mx + i]);
+        else
+          sigmainv(x, y, t.u[j * mx + i], t.v[j * mx + i]);
+      }
+    // Check the interpolated values at the centers of the cells
+    t.ok.assign(t.nx * t.ny, 1);
+    vector<char> ok(t.nx * t.ny);
+    for (int j = 0; j < t.ny; ++j)
+      for (int i = 0; i < t.nx; ++i) {
+        real
+          x = t.x0 + (i + real(0.5)) * t.h,
+          y = t.y0 + (j + real(0.5)) * t.h,
+          u, v, ux, vx;
+        if (zetap)
+          zetainv(sinh(x), y, u, v);
+        else
+          sigmainv(x, y, u, v);
+        t.Guess(x, y, ux, vx);
+        ok[j * t.nx + i] = hypot(ux - u, vx - v) <= maxerr;
+      }
+    t.ok.swap(ok);
+  }
+
+  void TransverseMercatorExact::CacheArea(real south, real west,
+                                          real north, real east, real step) {
+    CacheClear();
+    if (!(-90 <= south && south <= north && north <= 90))
+      throw GeographicErr("Latitudes of the region are not in [-90d, 90d]");
+    if (!(west <= east))
+      throw GeographicErr("Longitudes of the region are out of order");
+    if (!(isfinite(step) && step > 0))
+      throw GeographicErr("Grid spacing is not positive");
+    static const real latmax = real(89.5), lonmax = 90;
+    if (!_extendp) {
+      // Fold the region using the symmetries enforced by Forward
+      real s = south, n = north;
+      south = s <= 0 && 0 <= n ? 0 : min(abs(s), abs(n));
+      north = max(abs(s), abs(n));
+      s = west; n = east;
+      west = s <= 0 && 0 <= n ? 0 : min(abs(s), abs(n));
+      east = max(abs(s), abs(n));
+    }
+    south = min(max(south, -latmax), latmax);
+    north = min(max(north, -latmax), latmax);
+    west = min(max(west, -lonmax), lonmax);
+    east = min(max(east, -lonmax), lonmax);
+    real h = step * Math::degree();
+    guesstab zt, st;
+    // The table for zetainv in terms of psi and lam
+    zt.h = h;
+    zt.x0 = asinh(Math::taupf(Math::tand(south), _e));
+    zt.y0 = west * Math::degree();
+    zt.nx = max(1, int(ceil((asinh(Math::taupf(Math::tand(north), _e))
+                             - zt.x0) / h)));
+    zt.ny = max(1, int(ceil((east * Math::degree() - zt.y0) / h)));
+    Tabulate(true, zt);
+    // The table for sigmainv in terms of xi and eta covers the image of the
+    // region.  By the maximum principle for harmonic functions, it suffices
+    // to consider the boundary of the region.
+    real
+      ximin = Math::infinity(), ximax = -ximin,
+      etamin = ximin, etamax = ximax;
+    int mx = zt.nx + 3;
+    for (int j = 1; j <= zt.ny + 1; ++j)
+      for (int i = 1; i <= zt.nx + 1; ++i) {
+        if (!(j == 1 || j == zt.ny + 1 || i == 1 || i == zt.nx + 1)) continue;
+        real u = zt.u[j * mx + i], v = zt.v[j * mx + i],
+          snu, cnu, dnu, snv, cnv, dnv, xi, eta;
+        _Eu.sncndn(u, snu, cnu, dnu);
+        _Ev.sncndn(v, snv, cnv, dnv);
+        sigma(u, snu, cnu, dnu, v, snv, cnv, dnv, xi, eta);
+        ximin = min(ximin, xi); ximax = max(ximax, xi);
+        etamin = min(etamin, eta); etamax = max(etamax, eta);
+      }
+    st.h = h;
+    st.x0 = ximin;
+    st.y0 = etamin;
+    st.nx = max(1, int(ceil((ximax - ximin) / h)));
+    st.ny = max(1, int(ceil((etamax - etamin) / h)));
+    Tabulate(false, st);
+    swap(_ztab, zt);
+    swap(_stab, st);
+  }
+
+  void TransverseMercatorExact::CacheClear() {
+    _ztab = _stab = guesstab();
+  }
+
 } // namespace GeographicLib
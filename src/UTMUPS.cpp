@@ -12,6 +12,9 @@
 #include <GeographicLib/PolarStereographic.hpp>
 #include <GeographicLib/TransverseMercator.hpp>
 #include <GeographicLib/Utility.hpp>
+#include <GeographicLib/Trace.hpp>
+#include <cstring>
+#include <vector>
 
 namespace GeographicLib {
 
@@ -62,6 +65,34 @@ namespace GeographicLib {
       return UPS;
   }
 
+  int UTMUPS::ForwardZone(real lat, real lon, int zone, bool northp,
+                          real& x, real& y, real& gamma, real& k,
+                          bool mgrslimits) {
+    bool utmp = zone != UPS;
+    if (utmp) {
+      real
+        lon0 = CentralMeridian(zone),
+        dlon = lon - lon0;
+      dlon = abs(dlon - 360 * floor((dlon + 180)/360));
+      if (!(dlon <= 60))
+        // Check isn't really necessary because CheckCoords catches this case.
+        // But this allows a more meaningful error message to be given.
+        return FAR_FROM_ZONE;
+      TransverseMercator::UTM().Forward(lon0, lat, lon, x, y, gamma, k);
+    } else {
+      if (abs(lat) < 70)
+        // Check isn't really necessary ... (see above).
+        return FAR_FROM_POLE;
+      PolarStereographic::UPS().Forward(northp, lat, lon, x, y, gamma, k);
+    }
+    int ind = (utmp ? 2 : 0) + (northp ? 1 : 0);
+    x += falseeasting_[ind];
+    y += falsenorthing_[ind];
+    if (!CheckCoords(utmp, northp, x, y, mgrslimits, false))
+      return OUT_OF_RANGE;
+    return OK;
+  }
+
   void UTMUPS::Forward(real lat, real lon,
                        int& zone, bool& northp, real& x, real& y,
                        real& gamma, real& k,
@@ -78,36 +109,25 @@ namespace GeographicLib {
       return;
     }
     real x1, y1, gamma1, k1;
-    bool utmp = zone1 != UPS;
-    if (utmp) {
-      real
-        lon0 = CentralMeridian(zone1),
-        dlon = lon - lon0;
-      dlon = abs(dlon - 360 * floor((dlon + 180)/360));
-      if (!(dlon <= 60))
-        // Check isn't really necessary because CheckCoords catches this case.
-        // But this allows a more meaningful error message to be given.
-        throw GeographicErr("Longitude " + Utility::str(lon)
-                            + "d more than 60d from center of UTM zone "
-                            + Utility::str(zone1));
-      TransverseMercator::UTM().Forward(lon0, lat, lon, x1, y1, gamma1, k1);
-    } else {
-      if (abs(lat) < 70)
-        // Check isn't really necessary ... (see above).
-        throw GeographicErr("Latitude " + Utility::str(lat)
-                            + "d more than 20d from "
-                            + (northp1 ? "N" : "S") + " pole");
-      PolarStereographic::UPS().Forward(northp1, lat, lon, x1, y1, gamma1, k1);
-    }
-    int ind = (utmp ? 2 : 0) + (northp1 ? 1 : 0);
-    x1 += falseeasting_[ind];
-    y1 += falsenorthing_[ind];
-    if (! CheckCoords(zone1 != UPS, northp1, x1, y1, mgrslimits, false) )
+    switch (ForwardZone(lat, lon, zone1, northp1, x1, y1, gamma1, k1,
+                        mgrslimits)) {
+    case FAR_FROM_ZONE:
+      throw GeographicErr("Longitude " + Utility::str(lon)
+                          + "d more than 60d from center of UTM zone "
+                          + Utility::str(zone1));
+    case FAR_FROM_POLE:
+      throw GeographicErr("Latitude " + Utility::str(lat)
+                          + "d more than 20d from "
+                          + (northp1 ? "N" : "S") + " pole");
+    case OUT_OF_RANGE:
       throw GeographicErr("Latitude " + Utility::str(lat)
                           + ", longitude " + Utility::str(lon)
                           + " out of legal range for "
-                          + (utmp ? "UTM zone " + Utility::str(zone1) :
+                          + (zone1 != UPS ? "UTM zone " + Utility::str(zone1) :
                              "UPS"));
+    default:
+      break;
+    }
     zone = zone1;
     northp = northp1;
     x = x1;
@@ -116,6 +136,33 @@ namespace GeographicLib {
     k = k1;
   }
 
+  void UTMUPS::ForwardBatch(size_t n, const real lat[], const real lon[],
+                            int zone[], bool northp[], real x[], real y[],
+                            real gamma[], real k[],
+                            int setzone, bool mgrslimits) {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "UTMUPS::ForwardBatch", n);
+    // Check setzone once; this throws if it is illegal.
+    StandardZone(0, 0, setzone);
+    for (size_t i = 0; i < n; ++i) {
+      bool northp1 = lat[i] >= 0;
+      int zone1 = abs(lat[i]) > 90 ? int(INVALID) :
+        StandardZone(lat[i], lon[i], setzone);
+      real x1, y1, gamma1, k1;
+      if (zone1 == INVALID ||
+          ForwardZone(lat[i], lon[i], zone1, northp1, x1, y1, gamma1, k1,
+                      mgrslimits) != OK) {
+        zone1 = INVALID;
+        x1 = y1 = gamma1 = k1 = Math::NaN();
+      }
+      zone[i] = zone1;
+      northp[i] = northp1;
+      x[i] = x1;
+      y[i] = y1;
+      if (gamma) gamma[i] = gamma1;
+      if (k) k[i] = k1;
+    }
+  }
+
   void UTMUPS::Reverse(int zone, bool northp, real x, real y,
                        real& lat, real& lon, real& gamma, real& k,
                        bool mgrslimits) {
@@ -139,6 +186,36 @@ namespace GeographicLib {
       PolarStereographic::UPS().Reverse(northp, x, y, lat, lon, gamma, k);
   }
 
+  void UTMUPS::ReverseBatch(size_t n, const int zone[], const bool northp[],
+                            const real x[], const real y[],
+                            real lat[], real lon[], real gamma[], real k[],
+                            bool mgrslimits) {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "UTMUPS::ReverseBatch", n);
+    for (size_t i = 0; i < n; ++i) {
+      real lat1, lon1, gamma1, k1;
+      bool utmp = zone[i] != UPS;
+      if (!(zone[i] >= MINZONE && zone[i] <= MAXZONE) ||
+          !CheckCoords(utmp, northp[i], x[i], y[i], mgrslimits, false)) {
+        lat1 = lon1 = gamma1 = k1 = Math::NaN();
+      } else {
+        int ind = (utmp ? 2 : 0) + (northp[i] ? 1 : 0);
+        real
+          x1 = x[i] - falseeasting_[ind],
+          y1 = y[i] - falsenorthing_[ind];
+        if (utmp)
+          TransverseMercator::UTM().Reverse(CentralMeridian(zone[i]),
+                                            x1, y1, lat1, lon1, gamma1, k1);
+        else
+          PolarStereographic::UPS().Reverse(northp[i], x1, y1,
+                                            lat1, lon1, gamma1, k1);
+      }
+      lat[i] = lat1;
+      lon[i] = lon1;
+      if (gamma) gamma[i] = gamma1;
+      if (k) k[i] = k1;
+    }
+  }
+
   bool UTMUPS::CheckCoords(bool utmp, bool northp, real x, real y,
                            bool mgrslimits, bool throwp) {
     // Limits are all multiples of 100km and are all closed on the both ends.
@@ -204,50 +281,177 @@ namespace GeographicLib {
     return;
   }
 
-  void UTMUPS::DecodeZone(const string& zonestr, int& zone, bool& northp)
-  {
-    unsigned zlen = unsigned(zonestr.size());
-    if (zlen == 0)
+  void UTMUPS::TransferBatch(size_t n, const int zonein[],
+                             const bool northpin[],
+                             const real xin[], const real yin[],
+                             int zoneout, bool northpout,
+                             real xout[], real yout[], int zone[]) {
+    GEOGRAPHICLIB_TRACE_SCOPE2(batch, "UTMUPS::TransferBatch", n);
+    // Check zoneout once; this throws if it is illegal.
+    StandardZone(0, 0, zoneout);
+    auto fail = [xout, yout, zone](size_t i) -> void {
+      xout[i] = yout[i] = Math::NaN(); zone[i] = INVALID;
+    };
+    // Points which change zone, with their input zones
+    vector<size_t> ind;
+    vector<int> zin;
+    for (size_t i = 0; i < n; ++i) {
+      int zone1 = zonein[i], zone2 = zoneout == MATCH ? zone1 : zoneout;
+      bool northp1 = northpin[i],
+        valid = zone1 >= MINZONE && zone1 <= MAXZONE &&
+        CheckCoords(zone1 != UPS, northp1, xin[i], yin[i], false, false);
+      // Transfer checks the coordinates for MATCH, but not otherwise
+      if (zone1 == zone2 && (valid || zoneout != MATCH)) {
+        if (zone2 == UPS && northp1 != northpout)
+          fail(i);
+        else {
+          xout[i] = xin[i];
+          yout[i] = yin[i] + (northp1 == northpout ? 0 :
+                              (northpout ? -1 : 1) * MGRS::utmNshift_);
+          zone[i] = zone2;
+        }
+      } else if (!valid)
+        fail(i);
+      else {
+        ind.push_back(i);
+        zin.push_back(zone1);
+      }
+    }
+    size_t m = ind.size();
+    if (m == 0) return;
+    // The UTM points are converted in one batch with the central meridian of
+    // each zone as the origin of longitude.  The UPS points are converted
+    // singly.
+    vector<real> x(m), y(m), lat(m), lon(m);
+    for (size_t j = 0; j < m; ++j) {
+      size_t i = ind[j];
+      int k = (zin[j] != UPS ? 2 : 0) + (northpin[i] ? 1 : 0);
+      x[j] = xin[i] - falseeasting_[k];
+      y[j] = yin[i] - falsenorthing_[k];
+    }
+    TransverseMercator::UTM().ReverseBatch(m, 0, x.data(), y.data(),
+                                           lat.data(), lon.data());
+    for (size_t j = 0; j < m; ++j)
+      if (zin[j] == UPS)
+        PolarStereographic::UPS().Reverse(northpin[ind[j]], x[j], y[j],
+                                          lat[j], lon[j]);
+    // Find the output zones and set lon relative to their central meridians
+    vector<int> zout(m);
+    for (size_t j = 0; j < m; ++j) {
+      real lon1 = zin[j] != UPS ? CentralMeridian(zin[j]) + lon[j] : lon[j];
+      int zone2 = zoneout == MATCH ? zin[j] : zoneout;
+      zout[j] = !(abs(lat[j]) <= 90) ? int(INVALID) :
+        StandardZone(lat[j], lon1, zone2);
+      if (zout[j] == INVALID || zout[j] == UPS)
+        lon[j] = lon1;
+      else if (zin[j] != UPS) {
+        // The central meridians differ by a multiple of 6 degrees, so this
+        // difference is exact.
+        int dz = 6 * (zin[j] - zout[j]);
+        if (dz >= 180) dz -= 360; else if (dz < -180) dz += 360;
+        lon[j] += dz;
+      } else
+        lon[j] = Math::AngDiff(CentralMeridian(zout[j]), lon1);
+    }
+    TransverseMercator::UTM().ForwardBatch(m, 0, lat.data(), lon.data(),
+                                           x.data(), y.data());
+    for (size_t j = 0; j < m; ++j) {
+      size_t i = ind[j];
+      int zone1 = zout[j];
+      bool northp1 = lat[j] >= 0, utmp = zone1 != UPS;
+      if (zone1 == INVALID) { fail(i); continue; }
+      if (utmp) {
+        if (!(abs(lon[j]) <= 60)) { fail(i); continue; }
+      } else {
+        if (abs(lat[j]) < 70) { fail(i); continue; }
+        PolarStereographic::UPS().Forward(northp1, lat[j], lon[j],
+                                          x[j], y[j]);
+      }
+      int k = (utmp ? 2 : 0) + (northp1 ? 1 : 0);
+      real x1 = x[j] + falseeasting_[k], y1 = y[j] + falsenorthing_[k];
+      if (!CheckCoords(utmp, northp1, x1, y1, false, false) ||
+          (!utmp && northp1 != northpout)) {
+        fail(i); continue;
+      }
+      if (northp1 != northpout)
+        y1 += (northpout ? -1 : 1) * MGRS::utmNshift_;
+      xout[i] = x1; yout[i] = y1; zone[i] = zone1;
+    }
+  }
+
+  UTMUPS::status UTMUPS::DecodeZoneChars(const char* zonestr, size_t zlen,
+                                         int& zone, bool& northp,
+                                         bool throwp) {
+    if (zlen == 0) {
+      if (!throwp) return BADSTRING;
       throw GeographicErr("Empty zone specification");
+    }
     // Longest zone spec is 32north, 42south, invalid = 7
-    if (zlen > 7)
+    if (zlen > 7) {
+      if (!throwp) return BADSTRING;
       throw GeographicErr("More than 7 characters in zone specification "
-                          + zonestr);
+                          + string(zonestr, zlen));
+    }
 
-    const char* c = zonestr.c_str();
+    // A null-terminated copy for strtol
+    char c[8];
+    copy(zonestr, zonestr + zlen, c); c[zlen] = '\0';
     char* q;
     int zone1 = strtol(c, &q, 10);
     // if (zone1 == 0) zone1 = UPS; (not necessary)
 
     if (zone1 == UPS) {
-      if (!(q == c))
+      if (!(q == c)) {
+        if (!throwp) return BADZONE;
         // Don't allow 0n as an alternative to n for UPS coordinates
-        throw GeographicErr("Illegal zone 0 in " + zonestr +
+        throw GeographicErr("Illegal zone 0 in " + string(zonestr, zlen) +
                             ", use just the hemisphere for UPS");
-    } else if (!(zone1 >= MINUTMZONE && zone1 <= MAXUTMZONE))
+      }
+    } else if (!(zone1 >= MINUTMZONE && zone1 <= MAXUTMZONE)) {
+      if (!throwp) return BADZONE;
       throw GeographicErr("Zone " + Utility::str(zone1)
                           + " not in range [1, 60]");
-    else if (!isdigit(zonestr[0]))
+    } else if (!isdigit(c[0])) {
+      if (!throwp) return BADZONE;
       throw GeographicErr("Must use unsigned number for zone "
                           + Utility::str(zone1));
-    else if (q - c > 2)
+    } else if (q - c > 2) {
+      if (!throwp) return BADZONE;
       throw GeographicErr("More than 2 digits use to specify zone "
                           + Utility::str(zone1));
+    }
 
-    string hemi(zonestr, q - c);
-    for (string::iterator p = hemi.begin(); p != hemi.end(); ++p)
-      *p = char(tolower(*p));
-    if (q == c && (hemi == "inv" || hemi == "invalid")) {
+    // Embedded nulls are retained in hemi (and so cause a mismatch below)
+    size_t hlen = zlen - (q - c);
+    char hemi[8];
+    for (size_t i = 0; i < hlen; ++i)
+      hemi[i] = char(tolower(q[i]));
+    auto match = [&hemi, hlen](const char* h) -> bool
+      { return hlen == strlen(h) && equal(h, h + hlen, hemi); };
+    if (q == c && (match("inv") || match("invalid"))) {
       zone = INVALID;
       northp = false;
-      return;
+      return OK;
+    }
+    bool northp1 = match("north") || match("n");
+    if (!(northp1 || match("south") || match("s"))) {
+      if (!throwp) return BADSTRING;
+      throw GeographicErr(string("Illegal hemisphere ") + string(hemi, hlen)
+                          + " in " + string(zonestr, zlen)
+                          + ", specify north or south");
     }
-    bool northp1 = hemi == "north" || hemi == "n";
-    if (!(northp1 || hemi == "south" || hemi == "s"))
-      throw GeographicErr(string("Illegal hemisphere ") + hemi + " in "
-                          + zonestr + ", specify north or south");
     zone = zone1;
     northp = northp1;
+    return OK;
+  }
+
+  void UTMUPS::DecodeZone(const string& zonestr, int& zone, bool& northp) {
+    DecodeZoneChars(zonestr.data(), zonestr.size(), zone, northp, true);
+  }
+
+  UTMUPS::status UTMUPS::DecodeZone(const char* zonestr, size_t len,
+                                    int& zone, bool& northp) {
+    return DecodeZoneChars(zonestr, len, zone, northp, false);
   }
 
   string UTMUPS::EncodeZone(int zone, bool northp, bool abbrev) {
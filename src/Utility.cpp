@@ -8,6 +8,12 @@
  **********************************************************************/
 
 #include <cstdlib>
+#include <cerrno>
+#include <cctype>
+#include <clocale>
+#include <cstdio>
+#include <cstring>
+#include <locale>
 #include <GeographicLib/Utility.hpp>
 
 #if defined(_MSC_VER)
@@ -38,6 +44,122 @@ namespace GeographicLib {
     return ParseLine(line, key, value, '\0');
   }
 
+  namespace {
+    typedef unsigned char uchar;
+
+    // Check that [p, e) is a plain decimal number with optional surrounding
+    // white space and return the start and end of the number.
+    bool plaindecimal(const char* p, const char* e,
+                      const char*& beg, const char*& end) {
+      while (p < e && isspace(uchar(*p))) ++p;
+      while (p < e && isspace(uchar(e[-1]))) --e;
+      beg = p;
+      if (p < e && (*p == '+' || *p == '-')) ++p;
+      int ndigits = 0;
+      for (; p < e && isdigit(uchar(*p)); ++p) ++ndigits;
+      if (p < e && *p == '.')
+        for (++p; p < e && isdigit(uchar(*p)); ++p) ++ndigits;
+      if (ndigits == 0) return false;
+      if (p < e && (*p == 'e' || *p == 'E')) {
+        ++p;
+        if (p < e && (*p == '+' || *p == '-')) ++p;
+        if (!(p < e && isdigit(uchar(*p)))) return false;
+        while (p < e && isdigit(uchar(*p))) ++p;
+      }
+      end = e;
+      if (p != e) return false;
+      // strtod and its relatives use the decimal point of the C locale.
+      const char* point = localeconv()->decimal_point;
+      return point[0] == '.' && point[1] == '\0';
+    }
+
+    // Convert the n characters at s; if terminated, the number is followed
+    // by a character which strtod won't consume (white space or a null).
+    template<typename T>
+    bool fastconv(const char* s, size_t n, bool terminated, T& x,
+                  T (*conv)(const char*, char**)) {
+      const char* beg, * end;
+      if (!plaindecimal(s, s + n, beg, end)) return false;
+      char buf[64];
+      string tmp;
+      if (!terminated) {
+        // Copy the number so that it's null-terminated
+        size_t m = size_t(end - beg);
+        if (m < sizeof(buf)) {
+          memcpy(buf, beg, m); buf[m] = '\0'; beg = buf;
+        } else {
+          tmp.assign(beg, m); beg = tmp.c_str();
+        }
+        end = beg + m;
+      }
+      char* q;
+      int olderrno = errno;
+      errno = 0;
+      T y = conv(beg, &q);
+      bool ok = errno == 0 && q == end;
+      errno = olderrno;
+      if (ok) x = y;
+      return ok;
+    }
+  }
+
+  bool Utility::fastval(const std::string& s, float& x) {
+    return fastconv<float>(s.c_str(), s.size(), true, x, strtof);
+  }
+
+  bool Utility::fastval(const std::string& s, double& x) {
+    return fastconv<double>(s.c_str(), s.size(), true, x, strtod);
+  }
+
+  bool Utility::fastval(const std::string& s, long double& x) {
+    return fastconv<long double>(s.c_str(), s.size(), true, x, strtold);
+  }
+
+  bool Utility::fastval(const char* s, size_t n, float& x) {
+    return fastconv<float>(s, n, false, x, strtof);
+  }
+
+  bool Utility::fastval(const char* s, size_t n, double& x) {
+    return fastconv<double>(s, n, false, x, strtod);
+  }
+
+  bool Utility::fastval(const char* s, size_t n, long double& x) {
+    return fastconv<long double>(s, n, false, x, strtold);
+  }
+
+  int Utility::fixedstr(char buf[], size_t n, Math::real x, int p) {
+#if GEOGRAPHICLIB_PRECISION <= 3
+    using std::isfinite;
+    // snprintf gives the same result as ostream (which is implemented in
+    // terms of it) provided that the C++ global locale is the classic one
+    // (so no digit grouping is performed) and the C locale uses ".".
+    if (p >= 0 && isfinite(x) && std::locale() == std::locale::classic()) {
+      const char* point = localeconv()->decimal_point;
+      if (point[0] == '.' && point[1] == '\0')
+#if GEOGRAPHICLIB_PRECISION == 3
+        return snprintf(buf, n, "%.*Lf", p, x);
+#else
+        return snprintf(buf, n, "%.*f", p, double(x));
+#endif
+    }
+#else
+    (void)buf; (void)n; (void)x; (void)p;
+#endif
+    return -1;
+  }
+
+  size_t Utility::str(char buf[], size_t n, Math::real x, int p) {
+    int len = fixedstr(buf, n, x, p);
+    if (len >= 0) return size_t(len);
+    string r(str(x, p));
+    if (n > 0) {
+      size_t m = min(r.size(), n - 1);
+      r.copy(buf, m);
+      buf[m] = '\0';
+    }
+    return r.size();
+  }
+
   int Utility::set_digits(int ndigits) {
 #if GEOGRAPHICLIB_PRECISION == 5
     if (ndigits <= 0) {
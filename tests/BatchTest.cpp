@@ -0,0 +1,520 @@
+/**
+ * \file BatchTest.cpp
+ * \brief Check that the batch and parallel routines match the scalar ones
+ *
+ * The batch routines for the geodesic, rhumb line, and projection classes
+ * should give results which are bitwise identical to those of the
+ * corresponding scalar routines; UTMUPS::TransferBatch should agree with
+ * UTMUPS::Transfer to roundoff.  The results of the routines which use a pool
+ * of threads (PolygonAreaBatch, ExactAccumulator, and GeodesicCluster) should
+ * not depend on the number of threads.  These properties are checked with
+ * random points (together with some NaNs).  GeodesicOriginT should agree
+ * bitwise with the scalar routines, in particular for small longitudes of the
+ * origin, which are not rounded.  The distances given by
+ * ChordMetric::Distances are checked against operator()(), both for the
+ * attached points and for a different set of points.  The program prints the
+ * number of mismatches for each routine and returns 1 if any are found.
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <string>
+#include <memory>
+#include <cmath>
+
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicExact.hpp>
+#include <GeographicLib/GeodesicOrigin.hpp>
+#include <GeographicLib/Rhumb.hpp>
+#include <GeographicLib/TransverseMercator.hpp>
+#include <GeographicLib/LambertConformalConic.hpp>
+#include <GeographicLib/AlbersEqualArea.hpp>
+#include <GeographicLib/PolarStereographic.hpp>
+#include <GeographicLib/Gnomonic.hpp>
+#include <GeographicLib/Geocentric.hpp>
+#include <GeographicLib/UTMUPS.hpp>
+#include <GeographicLib/MGRS.hpp>
+#include <GeographicLib/PolygonAreaBatch.hpp>
+#include <GeographicLib/ExactAccumulator.hpp>
+#include <GeographicLib/GeodesicCluster.hpp>
+#include <GeographicLib/ChordMetric.hpp>
+
+using namespace std;
+using namespace GeographicLib;
+
+typedef Math::real real;
+
+// Bitwise comparison (so that -0 differs from +0 and NaNs match)
+bool same(real x, real y) {
+  using std::isnan;
+  if (isnan(x) || isnan(y)) return isnan(x) && isnan(y);
+  return x == y && signbit(x) == signbit(y);
+}
+
+int report(const char* name, size_t n, int bad) {
+  cout << name << ": " << n << " points; mismatches " << bad << "\n";
+  return bad;
+}
+
+// n random numbers in [a, b] with every 97th one replaced by a NaN
+vector<real> randvals(mt19937& g, size_t n, double a, double b) {
+  uniform_real_distribution<double> dis(a, b);
+  vector<real> v(n);
+  for (size_t i = 0; i < n; ++i)
+    v[i] = i % 97 == 13 ? Math::NaN() : real(dis(g));
+  return v;
+}
+
+int checkgeodesic(mt19937& g, size_t n) {
+  const Geodesic& geod = Geodesic::WGS84();
+  const GeodesicExact& geode = GeodesicExact::WGS84();
+  const unsigned mask = Geodesic::ALL;
+  vector<real>
+    lat1 = randvals(g, n, -90, 90), lon1 = randvals(g, n, -180, 180),
+    lat2 = randvals(g, n, -90, 90), lon2 = randvals(g, n, -180, 180),
+    azi1 = randvals(g, n, -180, 180), s12 = randvals(g, n, -2e7, 2e7),
+    s(n), a1(n), a2(n), m(n), M(n), N(n), S(n), a(n);
+  int badi = 0, bade = 0, badd = 0;
+  geod.InverseBatch(n, lat1.data(), lon1.data(), lat2.data(), lon2.data(),
+                    mask, s.data(), a1.data(), a2.data(),
+                    m.data(), M.data(), N.data(), S.data(), a.data());
+  for (size_t i = 0; i < n; ++i) {
+    real s0, a10, a20, m0, M0, N0, S0,
+      A0 = geod.GenInverse(lat1[i], lon1[i], lat2[i], lon2[i], mask,
+                           s0, a10, a20, m0, M0, N0, S0);
+    if (!(same(s[i], s0) && same(a1[i], a10) && same(a2[i], a20) &&
+          same(m[i], m0) && same(M[i], M0) && same(N[i], N0) &&
+          same(S[i], S0) && same(a[i], A0)))
+      ++badi;
+  }
+  geode.InverseBatch(n, lat1.data(), lon1.data(), lat2.data(), lon2.data(),
+                     mask, s.data(), a1.data(), a2.data(),
+                     m.data(), M.data(), N.data(), S.data(), a.data(), 3);
+  for (size_t i = 0; i < n; ++i) {
+    real s0, a10, a20, m0, M0, N0, S0,
+      A0 = geode.GenInverse(lat1[i], lon1[i], lat2[i], lon2[i], mask,
+                            s0, a10, a20, m0, M0, N0, S0);
+    if (!(same(s[i], s0) && same(a1[i], a10) && same(a2[i], a20) &&
+          same(m[i], m0) && same(M[i], M0) && same(N[i], N0) &&
+          same(S[i], S0) && same(a[i], A0)))
+      ++bade;
+  }
+  geod.DirectBatch(n, lat1.data(), lon1.data(), azi1.data(), s12.data(),
+                   mask, lat2.data(), lon2.data(), a2.data(),
+                   m.data(), M.data(), N.data(), S.data(), a.data());
+  for (size_t i = 0; i < n; ++i) {
+    real lat0, lon0, a20, s0, m0, M0, N0, S0,
+      A0 = geod.GenDirect(lat1[i], lon1[i], azi1[i], false, s12[i], mask,
+                          lat0, lon0, a20, s0, m0, M0, N0, S0);
+    if (!(same(lat2[i], lat0) && same(lon2[i], lon0) && same(a2[i], a20) &&
+          same(m[i], m0) && same(M[i], M0) && same(N[i], N0) &&
+          same(S[i], S0) && same(a[i], A0)))
+      ++badd;
+  }
+  return report("Geodesic::InverseBatch", n, badi) +
+    report("GeodesicExact::InverseBatch", n, bade) +
+    report("Geodesic::DirectBatch", n, badd);
+}
+
+int checkrhumb(mt19937& g, size_t n) {
+  const Rhumb& rhumb = Rhumb::WGS84();
+  vector<real>
+    lat1 = randvals(g, n, -90, 90), lon1 = randvals(g, n, -180, 180),
+    lat2 = randvals(g, n, -90, 90), lon2 = randvals(g, n, -180, 180),
+    azi12 = randvals(g, n, -180, 180), s12 = randvals(g, n, -2e7, 2e7),
+    s(n), azi(n), S(n);
+  int badi = 0, badd = 0;
+  rhumb.InverseBatch(n, lat1.data(), lon1.data(), lat2.data(), lon2.data(),
+                     Rhumb::ALL, s.data(), azi.data(), S.data());
+  for (size_t i = 0; i < n; ++i) {
+    real s0, azi0, S0;
+    rhumb.GenInverse(lat1[i], lon1[i], lat2[i], lon2[i], Rhumb::ALL,
+                     s0, azi0, S0);
+    if (!(same(s[i], s0) && same(azi[i], azi0) && same(S[i], S0))) ++badi;
+  }
+  rhumb.DirectBatch(n, lat1.data(), lon1.data(), azi12.data(), s12.data(),
+                    Rhumb::ALL, lat2.data(), lon2.data(), S.data());
+  for (size_t i = 0; i < n; ++i) {
+    real lat0, lon0, S0;
+    rhumb.GenDirect(lat1[i], lon1[i], azi12[i], s12[i], Rhumb::ALL,
+                    lat0, lon0, S0);
+    if (!(same(lat2[i], lat0) && same(lon2[i], lon0) && same(S[i], S0)))
+      ++badd;
+  }
+  return report("Rhumb::InverseBatch", n, badi) +
+    report("Rhumb::DirectBatch", n, badd);
+}
+
+// Check ForwardBatch and ReverseBatch for a projection; fwd and rev call
+// the scalar routines and fwdb and revb call the batch routines.
+template<class F, class R, class FB, class RB>
+int checkproj(const char* name, const vector<real>& lat,
+              const vector<real>& lon, const vector<real>& x,
+              const vector<real>& y,
+              F fwd, R rev, FB fwdb, RB revb) {
+  size_t n = lat.size();
+  vector<real> u(n), v(n), gam(n), k(n);
+  int badf = 0, badr = 0;
+  fwdb(n, lat.data(), lon.data(), u.data(), v.data(), gam.data(), k.data());
+  for (size_t i = 0; i < n; ++i) {
+    real u0, v0, gam0, k0;
+    fwd(lat[i], lon[i], u0, v0, gam0, k0);
+    if (!(same(u[i], u0) && same(v[i], v0) &&
+          same(gam[i], gam0) && same(k[i], k0)))
+      ++badf;
+  }
+  revb(n, x.data(), y.data(), u.data(), v.data(), gam.data(), k.data());
+  for (size_t i = 0; i < n; ++i) {
+    real u0, v0, gam0, k0;
+    rev(x[i], y[i], u0, v0, gam0, k0);
+    if (!(same(u[i], u0) && same(v[i], v0) &&
+          same(gam[i], gam0) && same(k[i], k0)))
+      ++badr;
+  }
+  return report((string(name) + "::ForwardBatch").c_str(), n, badf) +
+    report((string(name) + "::ReverseBatch").c_str(), n, badr);
+}
+
+int checkprojections(mt19937& g, size_t n) {
+  const real lon0 = 33;
+  vector<real>
+    lat = randvals(g, n, -90, 90), lon = randvals(g, n, -180, 180),
+    x = randvals(g, n, -5e6, 5e6), y = randvals(g, n, -5e6, 5e6);
+  int bad = 0;
+  const TransverseMercator& tm = TransverseMercator::UTM();
+  bad += checkproj
+    ("TransverseMercator", lat, lon, x, y,
+     [&](real la, real lo, real& u, real& v, real& gam, real& k)
+     { tm.Forward(lon0, la, lo, u, v, gam, k); },
+     [&](real u, real v, real& la, real& lo, real& gam, real& k)
+     { tm.Reverse(lon0, u, v, la, lo, gam, k); },
+     [&](size_t m, const real la[], const real lo[], real u[], real v[],
+         real gam[], real k[])
+     { tm.ForwardBatch(m, lon0, la, lo, u, v, gam, k); },
+     [&](size_t m, const real u[], const real v[], real la[], real lo[],
+         real gam[], real k[])
+     { tm.ReverseBatch(m, lon0, u, v, la, lo, gam, k); });
+  const LambertConformalConic lcc(Constants::WGS84_a(),
+                                  Constants::WGS84_f(), 30, 60, 1);
+  bad += checkproj
+    ("LambertConformalConic", lat, lon, x, y,
+     [&](real la, real lo, real& u, real& v, real& gam, real& k)
+     { lcc.Forward(lon0, la, lo, u, v, gam, k); },
+     [&](real u, real v, real& la, real& lo, real& gam, real& k)
+     { lcc.Reverse(lon0, u, v, la, lo, gam, k); },
+     [&](size_t m, const real la[], const real lo[], real u[], real v[],
+         real gam[], real k[])
+     { lcc.ForwardBatch(m, lon0, la, lo, u, v, gam, k); },
+     [&](size_t m, const real u[], const real v[], real la[], real lo[],
+         real gam[], real k[])
+     { lcc.ReverseBatch(m, lon0, u, v, la, lo, gam, k); });
+  const AlbersEqualArea& alb = AlbersEqualArea::CylindricalEqualArea();
+  bad += checkproj
+    ("AlbersEqualArea", lat, lon, x, y,
+     [&](real la, real lo, real& u, real& v, real& gam, real& k)
+     { alb.Forward(lon0, la, lo, u, v, gam, k); },
+     [&](real u, real v, real& la, real& lo, real& gam, real& k)
+     { alb.Reverse(lon0, u, v, la, lo, gam, k); },
+     [&](size_t m, const real la[], const real lo[], real u[], real v[],
+         real gam[], real k[])
+     { alb.ForwardBatch(m, lon0, la, lo, u, v, gam, k); },
+     [&](size_t m, const real u[], const real v[], real la[], real lo[],
+         real gam[], real k[])
+     { alb.ReverseBatch(m, lon0, u, v, la, lo, gam, k); });
+  const PolarStereographic& ps = PolarStereographic::UPS();
+  bad += checkproj
+    ("PolarStereographic", lat, lon, x, y,
+     [&](real la, real lo, real& u, real& v, real& gam, real& k)
+     { ps.Forward(true, la, lo, u, v, gam, k); },
+     [&](real u, real v, real& la, real& lo, real& gam, real& k)
+     { ps.Reverse(true, u, v, la, lo, gam, k); },
+     [&](size_t m, const real la[], const real lo[], real u[], real v[],
+         real gam[], real k[])
+     { ps.ForwardBatch(m, true, la, lo, u, v, gam, k); },
+     [&](size_t m, const real u[], const real v[], real la[], real lo[],
+         real gam[], real k[])
+     { ps.ReverseBatch(m, true, u, v, la, lo, gam, k); });
+  const Gnomonic gn(Geodesic::WGS84());
+  const real lat0 = -20;
+  bad += checkproj
+    ("Gnomonic", lat, lon, x, y,
+     [&](real la, real lo, real& u, real& v, real& azi, real& rk)
+     { gn.Forward(lat0, lon0, la, lo, u, v, azi, rk); },
+     [&](real u, real v, real& la, real& lo, real& azi, real& rk)
+     { gn.Reverse(lat0, lon0, u, v, la, lo, azi, rk); },
+     [&](size_t m, const real la[], const real lo[], real u[], real v[],
+         real azi[], real rk[])
+     { gn.ForwardBatch(m, lat0, lon0, la, lo, u, v, azi, rk); },
+     [&](size_t m, const real u[], const real v[], real la[], real lo[],
+         real azi[], real rk[])
+     { gn.ReverseBatch(m, lat0, lon0, u, v, la, lo, azi, rk); });
+  // Geocentric has three coordinates, so check it separately.
+  const Geocentric& earth = Geocentric::WGS84();
+  vector<real> h(n, 1000), X(n), Y(n), Z(n), lat1(n), lon1(n), h1(n);
+  earth.ForwardBatch(n, lat.data(), lon.data(), h.data(),
+                     X.data(), Y.data(), Z.data());
+  int badf = 0, badr = 0;
+  for (size_t i = 0; i < n; ++i) {
+    real X0 = 0, Y0 = 0, Z0 = 0;
+    earth.Forward(lat[i], lon[i], h[i], X0, Y0, Z0);
+    if (!(same(X[i], X0) && same(Y[i], Y0) && same(Z[i], Z0))) ++badf;
+  }
+  earth.ReverseBatch(n, X.data(), Y.data(), Z.data(),
+                     lat1.data(), lon1.data(), h1.data());
+  for (size_t i = 0; i < n; ++i) {
+    real lat0x = 0, lon0x = 0, h0 = 0;
+    earth.Reverse(X[i], Y[i], Z[i], lat0x, lon0x, h0);
+    if (!(same(lat1[i], lat0x) && same(lon1[i], lon0x) && same(h1[i], h0)))
+      ++badr;
+  }
+  bad += report("Geocentric::ForwardBatch", n, badf) +
+    report("Geocentric::ReverseBatch", n, badr);
+  return bad;
+}
+
+int checkutmups(mt19937& g, size_t n) {
+  vector<real>
+    lat = randvals(g, n, -90, 90), lon = randvals(g, n, -180, 180),
+    x(n), y(n), gam(n), k(n), lat1(n), lon1(n), x1(n), y1(n);
+  vector<int> zone(n), zone1(n);
+  unique_ptr<bool[]> northp(new bool[n]);
+  int badf = 0, badr = 0, badt = 0, badm = 0;
+  UTMUPS::ForwardBatch(n, lat.data(), lon.data(), zone.data(), northp.get(),
+                       x.data(), y.data(), gam.data(), k.data());
+  for (size_t i = 0; i < n; ++i) {
+    int zone0; bool northp0; real x0, y0, gam0, k0;
+    try {
+      UTMUPS::Forward(lat[i], lon[i], zone0, northp0, x0, y0, gam0, k0);
+    }
+    catch (const exception&) {
+      zone0 = UTMUPS::INVALID; northp0 = false;
+      x0 = y0 = gam0 = k0 = Math::NaN();
+    }
+    if (!(zone[i] == zone0 && (zone0 == UTMUPS::INVALID ||
+                               northp[i] == northp0) &&
+          same(x[i], x0) && same(y[i], y0) &&
+          same(gam[i], gam0) && same(k[i], k0)))
+      ++badf;
+  }
+  UTMUPS::ReverseBatch(n, zone.data(), northp.get(), x.data(), y.data(),
+                       lat1.data(), lon1.data(), gam.data(), k.data());
+  for (size_t i = 0; i < n; ++i) {
+    real lat0, lon0, gam0, k0;
+    try {
+      UTMUPS::Reverse(zone[i], northp[i], x[i], y[i],
+                      lat0, lon0, gam0, k0);
+    }
+    catch (const exception&) {
+      lat0 = lon0 = gam0 = k0 = Math::NaN();
+    }
+    if (!(same(lat1[i], lat0) && same(lon1[i], lon0) &&
+          same(gam[i], gam0) && same(k[i], k0)))
+      ++badr;
+  }
+  // Transfer to zone 31 north; the batch routine uses a different path, so
+  // only agreement to 1 um is expected.
+  const int zoneout = 31; const bool northpout = true;
+  const real tol = real(1e-6);
+  UTMUPS::TransferBatch(n, zone.data(), northp.get(), x.data(), y.data(),
+                        zoneout, northpout, x1.data(), y1.data(),
+                        zone1.data());
+  for (size_t i = 0; i < n; ++i) {
+    int zone0; real x0, y0;
+    try {
+      UTMUPS::Transfer(zone[i], northp[i], x[i], y[i], zoneout, northpout,
+                       x0, y0, zone0);
+    }
+    catch (const exception&) {
+      zone0 = UTMUPS::INVALID; x0 = y0 = Math::NaN();
+    }
+    using std::isnan;
+    if (!(zone1[i] == zone0 &&
+          (isnan(x0) ? isnan(x1[i]) : abs(x1[i] - x0) <= tol) &&
+          (isnan(y0) ? isnan(y1[i]) : abs(y1[i] - y0) <= tol)))
+      ++badt;
+  }
+  const int prec = 5; const size_t stride = 16;
+  vector<char> mgrs(n * stride);
+  MGRS::ForwardBatch(n, zone.data(), northp.get(), x.data(), y.data(), prec,
+                     mgrs.data(), stride);
+  for (size_t i = 0; i < n; ++i) {
+    string mgrs0;
+    try {
+      MGRS::Forward(zone[i], northp[i], x[i], y[i], prec, mgrs0);
+    }
+    catch (const exception&) {
+      mgrs0 = "";
+    }
+    if (mgrs0 != string(mgrs.data() + i * stride)) ++badm;
+  }
+  return report("UTMUPS::ForwardBatch", n, badf) +
+    report("UTMUPS::ReverseBatch", n, badr) +
+    report("UTMUPS::TransferBatch", n, badt) +
+    report("MGRS::ForwardBatch", n, badm);
+}
+
+int checkparallel(mt19937& g, size_t n) {
+  // Random polygons with 3 to 20 vertices in 1 degree boxes
+  uniform_real_distribution<double> dis(0, 1);
+  uniform_int_distribution<int> nv(3, 20);
+  vector<size_t> off(1, 0);
+  vector<real> lat, lon;
+  unique_ptr<bool[]> hole(new bool[n]);
+  for (size_t k = 0; k < n; ++k) {
+    real lat0 = real(170 * dis(g) - 85), lon0 = real(360 * dis(g) - 180);
+    int m = nv(g);
+    for (int j = 0; j < m; ++j) {
+      lat.push_back(lat0 + real(dis(g)));
+      lon.push_back(lon0 + real(dis(g)));
+    }
+    off.push_back(lat.size());
+    hole[k] = k % 5 == 4;
+  }
+  vector<real> p(n), a(n);
+  int badp = 0, badm = 0, bada = 0, badc = 0;
+  const PolygonAreaBatch batch1(Geodesic::WGS84(), false, 1),
+    batch3(Geodesic::WGS84(), false, 3);
+  batch3.Compute(n, off.data(), lat.data(), lon.data(), false, true,
+                 p.data(), a.data());
+  PolygonArea poly(Geodesic::WGS84());
+  ExactAccumulator P, A;
+  for (size_t k = 0; k < n; ++k) {
+    poly.Clear();
+    for (size_t i = off[k]; i < off[k + 1]; ++i) poly.AddPoint(lat[i], lon[i]);
+    real p0, a0;
+    poly.Compute(false, true, p0, a0);
+    if (!(same(p[k], p0) && same(a[k], a0))) ++badp;
+    P += double(p0); A += double(hole[k] ? -abs(a0) : abs(a0));
+  }
+  real p1, a1, p3, a3;
+  batch1.ComputeMulti(n, off.data(), lat.data(), lon.data(), hole.get(),
+                      false, p1, a1);
+  batch3.ComputeMulti(n, off.data(), lat.data(), lon.data(), hole.get(),
+                      false, p3, a3);
+  if (!(same(p1, p3) && same(a1, a3) &&
+        same(p1, real(P())) && same(a1, real(A()))))
+    ++badm;
+  // Sum the perimeters and areas with 1 and 3 threads
+  vector<double> y;
+  for (size_t k = 0; k < n; ++k) {
+    y.push_back(double(p[k])); y.push_back(double(a[k]));
+  }
+  ExactAccumulator s1, s3;
+  s1.Add(y.size(), y.data(), 1);
+  s3.Add(y.size(), y.data(), 3);
+  ExactAccumulator s0;
+  for (size_t i = 0; i < y.size(); ++i) s0 += y[i];
+  if (!(s1() == s0() && s3() == s0())) ++bada;
+  // Cluster the first vertices of the polygons with 1 and 3 threads
+  const size_t kc = 8;
+  vector<real> latp(n), lonp(n);
+  for (size_t k = 0; k < n; ++k) {
+    latp[k] = lat[off[k]]; lonp[k] = lon[off[k]];
+  }
+  vector<real> latc1(latp.begin(), latp.begin() + kc),
+    lonc1(lonp.begin(), lonp.begin() + kc), latc3(latc1), lonc3(lonc1);
+  vector<int> assign1(n), assign3(n);
+  GeodesicCluster(Geodesic::WGS84(), 1).
+    KMeans(n, latp.data(), lonp.data(), kc, latc1.data(), lonc1.data(),
+           assign1.data());
+  GeodesicCluster(Geodesic::WGS84(), 3).
+    KMeans(n, latp.data(), lonp.data(), kc, latc3.data(), lonc3.data(),
+           assign3.data());
+  for (size_t j = 0; j < kc; ++j)
+    if (!(same(latc1[j], latc3[j]) && same(lonc1[j], lonc3[j]))) ++badc;
+  if (assign1 != assign3) ++badc;
+  return report("PolygonAreaBatch::Compute", n, badp) +
+    report("PolygonAreaBatch::ComputeMulti", n, badm) +
+    report("ExactAccumulator::Add", y.size(), bada) +
+    report("GeodesicCluster::KMeans", n, badc);
+}
+
+// Check GeodesicOriginT::GenInverse and InverseBatch against
+// GeodType::GenInverse with values of |lon1| < 1/16 (which Math::AngRound
+// would alter); for half the points lon2 is close to lon1.
+template<class GeodType>
+int checkorigin(const char* name, const GeodType& geod,
+                mt19937& g, size_t n) {
+  const unsigned mask = GeodType::ALL;
+  uniform_real_distribution<double> dis(0, 1);
+  vector<real>
+    lat1 = randvals(g, n, -90, 90), lon1(n),
+    lat2 = randvals(g, n, -90, 90), lon2 = randvals(g, n, -180, 180),
+    s(n), a1(n), a2(n), m(n), M(n), N(n), S(n), a(n);
+  for (size_t i = 0; i < n; ++i) {
+    lon1[i] = real((dis(g) < 0.5 ? -1 : 1) * pow(10.0, -20 + 18.8 * dis(g)));
+    if (i % 2) lon2[i] = lon1[i] + real(1e-6 * (dis(g) - 0.5));
+  }
+  int bad = 0, badb = 0;
+  for (size_t i = 0; i < n; ++i) {
+    GeodesicOriginT<GeodType> orig(geod, lat1[i], lon1[i]);
+    real s0, a10, a20, m0, M0, N0, S0, s1, a11, a21, m1, M1, N1, S1,
+      A0 = geod.GenInverse(lat1[i], lon1[i], lat2[i], lon2[i], mask,
+                           s0, a10, a20, m0, M0, N0, S0),
+      A1 = orig.GenInverse(lat2[i], lon2[i], mask,
+                           s1, a11, a21, m1, M1, N1, S1);
+    if (!(same(s1, s0) && same(a11, a10) && same(a21, a20) &&
+          same(m1, m0) && same(M1, M0) && same(N1, N0) &&
+          same(S1, S0) && same(A1, A0)))
+      ++bad;
+  }
+  GeodesicOriginT<GeodType> orig(geod, lat1[0], lon1[0]);
+  orig.InverseBatch(n, lat2.data(), lon2.data(), mask,
+                    s.data(), a1.data(), a2.data(),
+                    m.data(), M.data(), N.data(), S.data(), a.data());
+  for (size_t i = 0; i < n; ++i) {
+    real s0, a10, a20, m0, M0, N0, S0,
+      A0 = geod.GenInverse(lat1[0], lon1[0], lat2[i], lon2[i], mask,
+                           s0, a10, a20, m0, M0, N0, S0);
+    if (!(same(s[i], s0) && same(a1[i], a10) && same(a2[i], a20) &&
+          same(m[i], m0) && same(M[i], M0) && same(N[i], N0) &&
+          same(S[i], S0) && same(a[i], A0)))
+      ++badb;
+  }
+  return report((string(name) + "::GenInverse").c_str(), n, bad) +
+    report((string(name) + "::InverseBatch").c_str(), n, badb);
+}
+
+// Check ChordMetric::Distances against operator()() for the attached
+// points and for a different vector of points of the same size (for which
+// the attached copy must not be used)
+int checkchord(mt19937& g, size_t n) {
+  typedef ChordMetric::point point;
+  ChordMetric dist(Geocentric::WGS84());
+  uniform_real_distribution<double> lat(-90, 90), lon(-180, 180);
+  vector<point> pts(n), other(n);
+  for (size_t i = 0; i < n; ++i) {
+    pts[i] = dist.Point(real(lat(g)), real(lon(g)));
+    other[i] = dist.Point(real(lat(g)), real(lon(g)));
+  }
+  dist.Attach(pts);
+  point query = dist.Point(real(lat(g)), real(lon(g)));
+  vector<int> ind(n);
+  for (size_t i = 0; i < n; ++i) ind[i] = int(i);
+  vector<real> d(n);
+  int bada = 0, bado = 0;
+  dist.Distances(pts, ind.data(), int(n), query, d.data());
+  for (size_t i = 0; i < n; ++i)
+    if (!(abs(d[i] - dist(pts[i], query)) <= real(1e-6))) ++bada;
+  dist.Distances(other, ind.data(), int(n), query, d.data());
+  for (size_t i = 0; i < n; ++i)
+    if (!(abs(d[i] - dist(other[i], query)) <= real(1e-6))) ++bado;
+  return report("ChordMetric::Distances (attached)", n, bada) +
+    report("ChordMetric::Distances (not attached)", n, bado);
+}
+
+int main() {
+  mt19937 g(20260415);
+  int nbad = checkgeodesic(g, 20000) + checkrhumb(g, 20000)
+    + checkprojections(g, 20000) + checkutmups(g, 20000)
+    + checkparallel(g, 5000)
+    + checkorigin("GeodesicOrigin", Geodesic::WGS84(), g, 20000)
+    + checkorigin("GeodesicOriginExact", GeodesicExact::WGS84(), g, 5000)
+    + checkchord(g, 1000);
+  return nbad ? 1 : 0;
+}
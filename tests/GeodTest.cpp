@@ -13,6 +13,7 @@
 #include "GeographicLib/GeodesicLineExact.hpp"
 #include "GeographicLib/Constants.hpp"
 #include <GeographicLib/Utility.hpp>
+#include "GeodTestData.hpp"
 
 #include <cmath>
 #include <vector>
@@ -25,14 +26,19 @@ using namespace GeographicLib;
 
 int usage(int retval) {
   ( retval ? cerr : cout ) <<
-"GeodTest [ -a | -c | -t0 | -t1 | -t2 | -t3 | -h ]\n\
+"GeodTest [ -a [file] | -E [file] | -F | -c | -C file |\n\
+  -t0 | -t1 | -t2 | -t3 | -T0 | -T1 | -T2 | -T3 | -h ]\n\
 \n\
 Check GeographicLib::Geodesic class.\n\
--a (default) accuracy test (reads test data on standard input)\n\
--E accuracy test with GeodesicExact (reads test data on standard input)\n\
+-a (default) accuracy test (reads test data from file, if given, or\n\
+   standard input)\n\
+-E accuracy test with GeodesicExact (reads test data from file, if\n\
+   given, or standard input)\n\
 -F accuracy test with GeodesicExact (reads test data on standard input\n\
    first line gives a and f)\n\
 -c coverage test (reads test data on standard input)\n\
+-C convert the test data on standard input to the binary format and\n\
+   write it to file\n\
 -t0 time GeodecicLine with distances using synthetic data\n\
 -t1 time GeodecicLine with angles using synthetic data\n\
 -t2 time Geodecic::Direct using synthetic data\n\
@@ -42,6 +48,11 @@ Check GeographicLib::Geodesic class.\n\
 -T2 time GeodecicExact::Direct using synthetic data\n\
 -T3 time GeodecicExact::Inverse with synthetic data\n\
 \n\
+The file for -a and -E may be either the text test data or the binary\n\
+form written by -C; the binary file is memory mapped and is much faster\n\
+to read.  It stores the data as doubles; so use the text file with higher\n\
+precision versions of the library.\n\
+\n\
 -c requires an instrumented version of Geodesic.\n";
   return retval;
 }
@@ -194,9 +205,26 @@ int main(int argc, char* argv[]) {
   bool accuracytest = true;
   bool coverage = false;
   bool exact = false;
-  if (argc == 2) {
+  string file;
+  if (argc == 2 || argc == 3) {
     string arg = argv[1];
-    if (arg == "-a") {
+    if (argc == 3) {
+      file = argv[2];
+      if (!(arg == "-a" || arg == "-E" || arg == "-C"))
+        return usage(1);
+    }
+    if (arg == "-C") {
+      if (file.empty()) return usage(1);
+      try {
+        size_t n = GeodTestData::Convert(cin, file);
+        cerr << n << " records written to " << file << "\n";
+      }
+      catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+      }
+      return 0;
+    } else if (arg == "-a") {
       accuracytest = true;
       coverage = false;
       timing = false;
@@ -270,7 +298,7 @@ int main(int argc, char* argv[]) {
       exact = true;
     } else
       return usage(arg == "-h" ? 0 : 1);
-  } else if (argc > 2)
+  } else if (argc > 3)
     return usage(1);
 
   if (timing) {
@@ -447,17 +475,10 @@ int main(int argc, char* argv[]) {
     vector<Math::real> err(NUMERR, 0.0);
     vector<unsigned> errind(NUMERR);
     unsigned cnt = 0;
-    string s;
-    while (getline(cin, s)) {
-      istringstream str(s);
-      Math::real lat1l, lon1l, azi1l, lat2l, lon2l, azi2l,
-        s12l, a12l, m12l, S12l;
-      if (!(str >> lat1l >> lon1l >> azi1l
-                >> lat2l >> lon2l >> azi2l
-                >> s12l >> a12l >> m12l))
-        break;
-      if (!(str >> S12l))
-        S12l = Math::NaN();
+    auto check = [&](Math::real lat1l, Math::real lon1l, Math::real azi1l,
+                     Math::real lat2l, Math::real lon2l, Math::real azi2l,
+                     Math::real s12l, Math::real a12l, Math::real m12l,
+                     Math::real S12l) -> void {
       if (coverage) {
 #if defined(GEOD_DIAG) && GEOD_DIAG
         Math::real
@@ -487,6 +508,33 @@ int main(int argc, char* argv[]) {
         }
         ++cnt;
       }
+    };
+    if (!file.empty()) {
+      try {
+        const GeodTestData data(file);
+        for (const GeodTestData::geodesic& g : data)
+          check(g.lat1, g.lon1, g.azi1, g.lat2, g.lon2, g.azi2,
+                g.s12, g.a12, g.m12, g.S12);
+      }
+      catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+      }
+    } else {
+      string s;
+      while (getline(cin, s)) {
+        istringstream str(s);
+        Math::real lat1l, lon1l, azi1l, lat2l, lon2l, azi2l,
+          s12l, a12l, m12l, S12l;
+        if (!(str >> lat1l >> lon1l >> azi1l
+                  >> lat2l >> lon2l >> azi2l
+                  >> s12l >> a12l >> m12l))
+          break;
+        if (!(str >> S12l))
+          S12l = Math::NaN();
+        check(lat1l, lon1l, azi1l, lat2l, lon2l, azi2l,
+              s12l, a12l, m12l, S12l);
+      }
     }
     if (accuracytest) {
       Math::real mult = Math::real(Math::extra_digits() == 0 ? 1e9l :
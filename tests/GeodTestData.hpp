@@ -0,0 +1,253 @@
+/**
+ * \file GeodTestData.hpp
+ * \brief A loader for the geodesic test data
+ *
+ * GeodTest.dat (see the section "Test data for geodesics" in the
+ * documentation) is a text file of 500000 lines; parsing it takes much
+ * longer than checking the geodesics.  GeodTestData::Convert writes the data
+ * to a compact binary file and GeodTestData reads either form, memory mapping
+ * the binary file on POSIX systems so that loading the full dataset costs
+ * essentially nothing.
+ *
+ * The binary file has a 24-byte header: the 8 characters "GeodTest", the
+ * version (a 4-byte unsigned integer, 1), the byte order marker (a 4-byte
+ * unsigned integer, 0x01020304), and the number of records (an 8-byte
+ * unsigned integer).  This is followed by the records each consisting of 10
+ * doubles, lat1, lon1, azi1, lat2, lon2, azi2, s12, a12, m12, S12 (S12 is a
+ * NaN if it's missing from the text).  The numbers are in the native byte
+ * order, so the file can only be read on a machine with the same byte order
+ * as the one that wrote it.  The values are stored as doubles, so the text
+ * file should be used for testing with GEOGRAPHICLIB_PRECISION > 2.
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#if !defined(GEODTESTDATA_HPP)
+#define GEODTESTDATA_HPP 1
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <istream>
+#include <fstream>
+#include <GeographicLib/Constants.hpp>
+#include <GeographicLib/MappedInput.hpp>
+
+#if !defined(_WIN32)
+// For mmap
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+class GeodTestData {
+public:
+  /**
+   * A line of GeodTest.dat.
+   **********************************************************************/
+  struct geodesic {
+    double lat1, lon1, azi1, lat2, lon2, azi2, s12, a12, m12, S12;
+  };
+
+private:
+  struct header {
+    char magic[8];
+    std::uint32_t version, order;
+    std::uint64_t count;
+  };
+  static const std::uint32_t version_ = 1, order_ = 0x01020304u;
+  std::vector<geodesic> _buf;
+  const geodesic* _data;
+  size_t _n;
+  void* _addr;
+  size_t _size;
+  GeodTestData(const GeodTestData&) = delete;
+  GeodTestData& operator=(const GeodTestData&) = delete;
+
+  static header Header(std::uint64_t count) {
+    header h;
+    std::memcpy(h.magic, "GeodTest", 8);
+    h.version = version_; h.order = order_; h.count = count;
+    return h;
+  }
+  static bool Magic(const header& h)
+  { return std::memcmp(h.magic, "GeodTest", 8) == 0; }
+  static void Check(const header& h, size_t size) {
+    if (h.order != order_)
+      throw GeographicLib::GeographicErr
+        ("Binary test data has the wrong byte order");
+    if (h.version != version_)
+      throw GeographicLib::GeographicErr
+        ("Unknown version of binary test data");
+    if (size < sizeof(header) ||
+        (size - sizeof(header)) / sizeof(geodesic) < h.count)
+      throw GeographicLib::GeographicErr("Binary test data is truncated");
+  }
+
+  void ReadBinary(const std::string& file, size_t n) {
+#if !defined(_WIN32)
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd >= 0) {
+      struct stat st;
+      if (fstat(fd, &st) == 0 && size_t(st.st_size) >= sizeof(header)) {
+        size_t size = size_t(st.st_size);
+        void* p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (p != MAP_FAILED) {
+          ::close(fd);
+          header h;
+          std::memcpy(&h, p, sizeof(header));
+          try { Check(h, size); }
+          catch (...) { munmap(p, size); throw; }
+          _addr = p; _size = size;
+          _data = reinterpret_cast<const geodesic*>
+            (static_cast<const char*>(p) + sizeof(header));
+          _n = size_t(std::min(std::uint64_t(n), h.count));
+          madvise(p, size, MADV_SEQUENTIAL);
+          return;
+        }
+      }
+      ::close(fd);
+    }
+#endif
+    std::ifstream str(file, std::ios::binary);
+    header h;
+    if (!str.read(reinterpret_cast<char*>(&h), sizeof(header)))
+      throw GeographicLib::GeographicErr("Cannot read " + file);
+    Check(h, sizeof(header) + size_t(h.count) * sizeof(geodesic));
+    _buf.resize(size_t(std::min(std::uint64_t(n), h.count)));
+    if (!str.read(reinterpret_cast<char*>(_buf.data()),
+                  std::streamsize(_buf.size() * sizeof(geodesic))))
+      throw GeographicLib::GeographicErr("Binary test data is truncated");
+    _data = _buf.data(); _n = _buf.size();
+  }
+
+  void ReadText(std::istream& str, size_t n) {
+    std::string s;
+    geodesic g;
+    while (_buf.size() < n && std::getline(str, s) && Parse(s, g))
+      _buf.push_back(g);
+    _data = _buf.data(); _n = _buf.size();
+  }
+
+public:
+  /**
+   * Load the test data.
+   *
+   * @param[in] file the name of a binary file written by Convert or a text
+   *   file in the format of GeodTest.dat.
+   * @param[in] n the maximum number of records to read.
+   * @exception GeographicErr if the file can't be read or the binary file
+   *   is malformed.
+   *
+   * A text file is read up to the first line which can't be parsed.
+   **********************************************************************/
+  explicit GeodTestData(const std::string& file,
+                        size_t n = std::numeric_limits<size_t>::max())
+    : _data(nullptr), _n(0), _addr(nullptr), _size(0)
+  {
+    if (Binary(file))
+      ReadBinary(file, n);
+    else {
+      GeographicLib::MappedInput str(file);
+      if (!str.is_open())
+        throw GeographicLib::GeographicErr("Cannot open " + file);
+      ReadText(str, n);
+    }
+  }
+
+  /**
+   * Load the test data from a text stream in the format of GeodTest.dat.
+   **********************************************************************/
+  explicit GeodTestData(std::istream& str,
+                        size_t n = std::numeric_limits<size_t>::max())
+    : _data(nullptr), _n(0), _addr(nullptr), _size(0)
+  { ReadText(str, n); }
+
+  ~GeodTestData() {
+#if !defined(_WIN32)
+    if (_addr) munmap(_addr, _size);
+#endif
+  }
+
+  size_t size() const { return _n; }
+  const geodesic& operator[](size_t i) const { return _data[i]; }
+  const geodesic* begin() const { return _data; }
+  const geodesic* end() const { return _data + _n; }
+
+  /**
+   * @return true if the data is read directly from a memory mapping.
+   **********************************************************************/
+  bool Mapped() const { return _addr != nullptr; }
+
+  /**
+   * Parse a line of GeodTest.dat.
+   *
+   * @param[in] s the line.
+   * @param[out] g the geodesic.
+   * @return true if the first 9 fields could be read (S12 is set to a NaN
+   *   if it is missing).
+   **********************************************************************/
+  static bool Parse(const std::string& s, geodesic& g) {
+    double* v[] = {&g.lat1, &g.lon1, &g.azi1, &g.lat2, &g.lon2, &g.azi2,
+                   &g.s12, &g.a12, &g.m12, &g.S12};
+    const char* p = s.c_str();
+    for (int i = 0; i < 10; ++i) {
+      char* q;
+      *v[i] = std::strtod(p, &q);
+      if (q == p) {
+        if (i < 9) return false;
+        g.S12 = std::numeric_limits<double>::quiet_NaN();
+      }
+      p = q;
+    }
+    return true;
+  }
+
+  /**
+   * @param[in] file the name of a file.
+   * @return true if \e file starts with the header of the binary format.
+   **********************************************************************/
+  static bool Binary(const std::string& file) {
+    std::ifstream str(file, std::ios::binary);
+    header h;
+    return str.read(reinterpret_cast<char*>(&h), sizeof(header)) && Magic(h);
+  }
+
+  /**
+   * Convert test data from text to the binary format.
+   *
+   * @param[in] in the input stream in the format of GeodTest.dat.
+   * @param[in] file the name of the binary file to write.
+   * @param[in] n the maximum number of lines to convert.
+   * @exception GeographicErr if the file can't be written.
+   * @return the number of records written.
+   **********************************************************************/
+  static size_t Convert(std::istream& in, const std::string& file,
+                        size_t n = std::numeric_limits<size_t>::max()) {
+    std::ofstream out(file, std::ios::binary);
+    header h = Header(0);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(header));
+    std::string s;
+    geodesic g;
+    size_t count = 0;
+    while (count < n && std::getline(in, s) && Parse(s, g)) {
+      out.write(reinterpret_cast<const char*>(&g), sizeof(geodesic));
+      ++count;
+    }
+    h = Header(count);
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(header));
+    if (!out.flush())
+      throw GeographicLib::GeographicErr("Cannot write " + file);
+    return count;
+  }
+};
+
+#endif  // GEODTESTDATA_HPP
@@ -0,0 +1,107 @@
+/**
+ * \file GravityDisturbanceTest.cpp
+ * \brief Check that GravityModel::Disturbance agrees with GravityCircle
+ *
+ * GravityModel::Disturbance and GravityCircle::Disturbance evaluate the
+ * same disturbing potential T and gravity disturbance, so they should agree
+ * to roundoff.  These used to differ by the degree 0 term in T (0.047
+ * m^2/s^2 for this model) because GravityModel::InternalT overwrote 1/r
+ * before using it.  No gravity model is assumed to be installed; instead
+ * this writes a small synthetic model of degree and order 12 (with a mass
+ * differing from that of the reference ellipsoid) to the current directory.
+ * The program prints the maximum differences and returns 1 if these exceed
+ * 1e-6 m^2/s^2 for T or 1e-10 m/s^2 for the gravity disturbance.
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <vector>
+#include <cmath>
+
+#include <GeographicLib/GravityModel.hpp>
+#include <GeographicLib/GravityCircle.hpp>
+#include <GeographicLib/SphericalEngine.hpp>
+#include <GeographicLib/Utility.hpp>
+
+using namespace std;
+using namespace GeographicLib;
+
+typedef Math::real real;
+
+// Write the synthetic model name.egm (and name.egm.cof) to the current
+// directory
+void writemodel(const string& name) {
+  {
+    ofstream str((name + ".egm").c_str());
+    str << "EGMF-1\n"
+        << "Name " << name << "\n"
+        << "Description synthetic model for GravityDisturbanceTest\n"
+        << "ModelRadius 6378136.3\n"
+        << "ModelMass 3986004.415e8\n"
+        << "AngularVelocity 7292115e-11\n"
+        << "ReferenceRadius 6378137\n"
+        << "ReferenceMass 3986004.418e8\n"
+        << "Flattening 1/298.257223563\n"
+        << "HeightOffset -0.41\n"
+        << "Normalization Full\n"
+        << "ByteOrder Little\n"
+        << "ID SYN-TEST\n";
+  }
+  const int N = 12;
+  mt19937 r(20261015);
+  uniform_real_distribution<double> dis(-1, 1);
+  vector<double>
+    C(SphericalEngine::coeff::Csize(N, N)),
+    S(SphericalEngine::coeff::Ssize(N, N));
+  // C is ordered by m then n; skip the n = 0 and n = 1 terms
+  for (int m = 0, k = 0; m <= N; ++m)
+    for (int n = m; n <= N; ++n, ++k)
+      C[k] = n < 2 ? 0 : 1e-6 * dis(r) / (n * n);
+  for (int m = 1, k = 0; m <= N; ++m)
+    for (int n = m; n <= N; ++n, ++k)
+      S[k] = n < 2 ? 0 : 1e-6 * dis(r) / (n * n);
+  ofstream str((name + ".egm.cof").c_str(), ios::binary);
+  str.write("SYN-TEST", 8);
+  int nm[2] = {N, N}, nocorr[2] = {-1, -1};
+  Utility::writearray<int, int, false>(str, nm, 2);
+  Utility::writearray<double, double, false>(str, C);
+  Utility::writearray<double, double, false>(str, S);
+  Utility::writearray<int, int, false>(str, nocorr, 2);
+}
+
+int main() {
+  try {
+    const string name = "GravityDisturbanceTest";
+    writemodel(name);
+    GravityModel g(name, ".");
+    real errT = 0, errd = 0;
+    for (int i = -9; i <= 9; ++i) {
+      real lat = real(10 * i - 0.5);
+      for (int j = 0; j < 3; ++j) {
+        real h = real(j * 20000 - 1000);
+        GravityCircle c = g.Circle(lat, h, GravityModel::DISTURBANCE);
+        for (int k = -18; k < 18; ++k) {
+          real lon = real(10 * k + 3),
+            dx, dy, dz, cx, cy, cz,
+            T = g.Disturbance(lat, lon, h, dx, dy, dz),
+            Tc = c.Disturbance(lon, cx, cy, cz);
+          errT = max(errT, real(abs(T - Tc)));
+          errd = max(errd, real(max(abs(dx - cx),
+                                    max(abs(dy - cy), abs(dz - cz)))));
+        }
+      }
+    }
+    cout << "Disturbance differences: T " << errT
+         << ", delta " << errd << "\n";
+    return errT <= real(1e-6) && errd <= real(1e-10) ? 0 : 1;
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+}
@@ -0,0 +1,83 @@
+/**
+ * \file InverseHintTest.cpp
+ * \brief Check that InverseHint agrees with Inverse
+ *
+ * The hint passed to Geodesic::InverseHint and GeodesicExact::InverseHint
+ * only changes the starting point of Newton's method, so the distance
+ * should agree with that from Inverse to roundoff, however poor the hint.
+ * This is checked for a case where a poor hint used to drive Newton's
+ * method into a bisection which stopped before convergence, giving an error
+ * of 38 um, and for random nearly equatorial geodesics with random hints
+ * and with hints slightly off the solution.  The program prints the
+ * maximum errors and returns 1 if any exceeds 0.1 um.
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <iostream>
+#include <random>
+#include <cmath>
+
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicExact.hpp>
+
+using namespace std;
+using namespace GeographicLib;
+
+typedef Math::real real;
+
+// The error in the distance given by InverseHint with the hint (azi1,
+// azi2)
+template<class G>
+real hinterr(const G& g, real lat1, real lon1, real lat2, real lon2,
+             real azi1, real azi2) {
+  real s12, s12h;
+  g.Inverse(lat1, lon1, lat2, lon2, s12);
+  g.InverseHint(lat1, lon1, lat2, lon2, s12h, azi1, azi2);
+  return abs(s12h - s12);
+}
+
+// The maximum errors in InverseHint for random nearly equatorial geodesics
+// with random hints and with hints which are off by 1e-3 deg
+template<class G>
+void randerr(const G& g, unsigned seed, real& errr, real& erro) {
+  mt19937 r(seed);
+  uniform_real_distribution<double> dis(0, 1);
+  errr = erro = 0;
+  for (int i = 0; i < 20000; ++i) {
+    real
+      lat1 = 0,
+      lat2 = real(pow(10.0, -12 + 10 * dis(r)) * (dis(r) < 0.5 ? -1 : 1)),
+      lon1 = real(360 * dis(r) - 180),
+      lon2 = lon1 + real(179.9 * dis(r)),
+      s12, azi1, azi2;
+    g.Inverse(lat1, lon1, lat2, lon2, s12, azi1, azi2);
+    errr = max(errr, hinterr(g, lat1, lon1, lat2, lon2,
+                             real(360 * dis(r) - 180),
+                             real(360 * dis(r) - 180)));
+    erro = max(erro, hinterr(g, lat1, lon1, lat2, lon2,
+                             azi1 + real(1e-3), azi2 - real(1e-3)));
+  }
+}
+
+template<class G>
+int check(const G& g, const char* name, real tol) {
+  real
+    err = hinterr(g, 0, real(-37.590528499125952),
+                  real(1.9455549096103475e-11), real(-115.6410558597489),
+                  real(77.787), real(-100.878)),
+    errr, erro;
+  randerr(g, 1, errr, erro);
+  cout << name << "::InverseHint errors: regression " << err
+       << ", random hints " << errr << ", offset hints " << erro << "\n";
+  return err <= tol && errr <= tol && erro <= tol ? 0 : 1;
+}
+
+int main() {
+  const real tol = real(1e-7);
+  int nbad = check(Geodesic::WGS84(), "Geodesic", tol) +
+    check(GeodesicExact::WGS84(), "GeodesicExact", tol);
+  return nbad ? 1 : 0;
+}
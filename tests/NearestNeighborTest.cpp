@@ -0,0 +1,122 @@
+/**
+ * \file NearestNeighborTest.cpp
+ * \brief Check saving and restoring NearestNeighbor in the mapped format
+ *
+ * A NearestNeighbor tree for random points in the plane is written with
+ * SaveMapped() and restored with ReadMapped() and with AttachMapped().  The
+ * restored trees should give the same search results as the original and
+ * SaveMapped() should reproduce the original data.  The tree is big enough for
+ * the nodes to be transferred in several blocks.  Calling InTree() on a mapped
+ * tree sets up the data for modifying the tree; this used to make a subsequent
+ * Save() or SaveMapped() crash, so this sequence is also checked.  The program
+ * prints the number of mismatches for each check and returns 1 if any are
+ * found.
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+#include <cstring>
+
+#include <GeographicLib/NearestNeighbor.hpp>
+
+using namespace std;
+using namespace GeographicLib;
+
+typedef Math::real real;
+
+struct pos {
+  real x, y;
+  pos(real x0 = 0, real y0 = 0) : x(x0), y(y0) {}
+};
+
+class Dist {
+public:
+  real operator()(const pos& a, const pos& b) const {
+    return hypot(a.x - b.x, a.y - b.y);
+  }
+};
+
+typedef NearestNeighbor<real, pos, Dist> NN;
+
+int report(const char* name, int bad) {
+  cout << name << ": mismatches " << bad << "\n";
+  return bad;
+}
+
+// The number of queries for which t and t0 give different results
+int comparesearch(const NN& t, const NN& t0, const vector<pos>& pts,
+                  const Dist& dist, const vector<pos>& queries) {
+  int bad = 0;
+  vector<int> ind, ind0;
+  for (const pos& q : queries) {
+    real d = t.Search(pts, dist, q, ind, 5),
+      d0 = t0.Search(pts, dist, q, ind0, 5);
+    if (!(d == d0 && ind == ind0)) ++bad;
+  }
+  return bad;
+}
+
+int main() {
+  try {
+    mt19937 g(20260415);
+    uniform_real_distribution<double> dis(0, 1);
+    Dist dist;
+    vector<pos> pts(50000), queries(1000);
+    for (pos& p : pts) p = pos(real(dis(g)), real(dis(g)));
+    for (pos& p : queries) p = pos(real(dis(g)), real(dis(g)));
+    NN t(pts, dist);
+    ostringstream os;
+    t.SaveMapped(os);
+    const string data = os.str();
+
+    NN tr;
+    {
+      istringstream is(data);
+      tr.ReadMapped(is, true, 2);
+    }
+    // Copy the data into storage which is suitably aligned for the nodes
+    vector<double> buf(data.size() / sizeof(double) + 1);
+    memcpy(buf.data(), data.data(), data.size());
+    NN ta;
+    ta.AttachMapped(reinterpret_cast<const char*>(buf.data()), data.size(),
+                    true);
+
+    ostringstream osr, osa;
+    tr.SaveMapped(osr);
+    ta.SaveMapped(osa);
+
+    // Save a mapped tree after calling InTree
+    int nin = 0;
+    for (int i = 0; i < 100; ++i) nin += ta.InTree(i) ? 1 : 0;
+    ostringstream osi, ost;
+    ta.SaveMapped(osi);
+    ta.Save(ost);
+    NN tl;
+    {
+      istringstream is(ost.str());
+      tl.Load(is);
+    }
+    int nbad =
+      report("ReadMapped search", comparesearch(tr, t, pts, dist, queries)) +
+      report("AttachMapped search",
+             comparesearch(ta, t, pts, dist, queries)) +
+      report("ReadMapped then SaveMapped", osr.str() == data ? 0 : 1) +
+      report("AttachMapped then SaveMapped", osa.str() == data ? 0 : 1) +
+      report("InTree for mapped tree", 100 - nin) +
+      report("InTree then SaveMapped", osi.str() == data ? 0 : 1) +
+      report("InTree then Save", comparesearch(tl, t, pts, dist, queries));
+    return nbad ? 1 : 0;
+  }
+  catch (const exception& e) {
+    cerr << "Caught exception: " << e.what() << "\n";
+    return 1;
+  }
+}
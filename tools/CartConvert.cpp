@@ -13,9 +13,12 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
 #include <GeographicLib/Geocentric.hpp>
 #include <GeographicLib/LocalCartesian.hpp>
 #include <GeographicLib/DMS.hpp>
+#include <GeographicLib/Pipeline.hpp>
+#include <GeographicLib/MappedInput.hpp>
 #include <GeographicLib/Utility.hpp>
 
 #if defined(_MSC_VER)
@@ -26,12 +29,105 @@
 
 #include "CartConvert.usage"
 
+using namespace GeographicLib;
+typedef Math::real real;
+
+// Process binary input consisting of triplets of little-endian doubles.  The
+// input is read in large blocks which are converted with the batch routines
+// of Geocentric or LocalCartesian.  The output is the same as processing the
+// records one at a time.  Returns the exit status.
+int BinaryConvert(const Geocentric& ec, const LocalCartesian& lc,
+                  bool localcartesian, bool reverse, bool longfirst,
+                  bool binaryout, int prec,
+                  std::istream& input, std::ostream& output) {
+  const size_t chunk = 1 << 16;
+  std::vector<double> buf(3 * chunk);
+  std::vector<real> a(chunk), b(chunk), c(chunk);
+  std::vector<char> bad(chunk);
+  std::string out;
+  int retval = 0;
+  auto val = [&buf](size_t j) -> real {
+    return real(Math::bigendian ? Math::swab<double>(buf[j]) : buf[j]);
+  };
+  while (input) {
+    input.read(reinterpret_cast<char*>(buf.data()),
+               buf.size() * sizeof(double));
+    size_t nbytes = size_t(input.gcount()),
+      n = nbytes / (3 * sizeof(double));
+    // An incomplete record at the end of the input is an error
+    bool partial = nbytes % (3 * sizeof(double)) != 0;
+    if (n == 0 && !partial) break;
+    for (size_t i = 0; i < n; ++i) {
+      bad[i] = false;
+      if (reverse) {
+        a[i] = val(3 * i); b[i] = val(3 * i + 1); c[i] = val(3 * i + 2);
+      } else {
+        a[i] = val(3 * i + (longfirst ? 1 : 0));
+        b[i] = val(3 * i + (longfirst ? 0 : 1));
+        c[i] = val(3 * i + 2);
+        if (std::abs(a[i]) > 90) {
+          bad[i] = true;
+          a[i] = Math::NaN();   // So that the result is NaN
+        }
+      }
+    }
+    if (reverse) {
+      if (localcartesian)
+        lc.ReverseBatch(n, a.data(), b.data(), c.data(),
+                        a.data(), b.data(), c.data());
+      else
+        ec.ReverseBatch(n, a.data(), b.data(), c.data(),
+                        a.data(), b.data(), c.data());
+      if (longfirst) std::swap(a, b);
+    } else {
+      if (localcartesian)
+        lc.ForwardBatch(n, a.data(), b.data(), c.data(),
+                        a.data(), b.data(), c.data());
+      else
+        ec.ForwardBatch(n, a.data(), b.data(), c.data(),
+                        a.data(), b.data(), c.data());
+    }
+    if (binaryout) {
+      // Reuse buf for the output; a record of NaNs marks an error
+      for (size_t i = 0; i < n; ++i) {
+        real rec[3] = {a[i], b[i], c[i]};
+        if (bad[i]) rec[0] = rec[1] = rec[2] = Math::NaN();
+        for (int k = 0; k < 3; ++k) {
+          double v = double(rec[k]);
+          buf[3 * i + k] = Math::bigendian ? Math::swab<double>(v) : v;
+        }
+      }
+      if (partial)
+        buf[3 * n] = buf[3 * n + 1] = buf[3 * n + 2] = Math::NaN();
+      output.write(reinterpret_cast<const char*>(buf.data()),
+                   3 * (n + (partial ? 1 : 0)) * sizeof(double));
+    } else {
+      out.clear();
+      for (size_t i = 0; i < n; ++i) {
+        if (bad[i])
+          out += "ERROR: Latitude "
+            + Utility::str(val(3 * i + (longfirst ? 1 : 0)))
+            + "d not in [-90d, 90d]\n";
+        else
+          out += Utility::str(a[i], reverse ? prec + 5 : prec) + " "
+            + Utility::str(b[i], reverse ? prec + 5 : prec) + " "
+            + Utility::str(c[i], prec) + "\n";
+      }
+      if (partial) out += "ERROR: Failure reading data\n";
+      output << out;
+    }
+    for (size_t i = 0; i < n; ++i)
+      if (bad[i]) retval = 1;
+    if (partial) retval = 1;
+  }
+  return retval;
+}
+
 int main(int argc, const char* const argv[]) {
   try {
-    using namespace GeographicLib;
-    typedef Math::real real;
     Utility::set_digits();
-    bool localcartesian = false, reverse = false, longfirst = false;
+    bool localcartesian = false, reverse = false, longfirst = false,
+      binaryin = false, binaryout = false, server = false;
     real
       a = Constants::WGS84_a(),
       f = Constants::WGS84_f();
@@ -79,7 +175,13 @@ int main(int argc, const char* const argv[]) {
           std::cerr << "Precision " << argv[m] << " is not a number\n";
           return 1;
         }
-      }  else if (arg == "--input-string") {
+      } else if (arg == "--binary-input")
+        binaryin = true;
+      else if (arg == "--binary-output")
+        binaryout = true;
+      else if (arg == "--server")
+        server = true;
+      else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
       } else if (arg == "--input-file") {
@@ -110,11 +212,17 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (binaryin && !istring.empty()) {
+      std::cerr
+        << "Cannot specify --input-string and --binary-input together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
-    std::ifstream infile;
+    MappedInput infile;
     std::istringstream instring;
     if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+      infile.open(ifile,
+                  binaryin ? std::ios::in | std::ios::binary : std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -135,7 +243,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), binaryout ?
+                   std::ios::out | std::ios::binary : std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -149,56 +258,99 @@ int main(int argc, const char* const argv[]) {
     // Max precision = 10: 0.1 nm in distance, 10^-15 deg (= 0.11 nm),
     // 10^-11 sec (= 0.3 nm).
     prec = std::min(10 + Math::extra_digits(), std::max(0, prec));
+    if (binaryin && !server)
+      return BinaryConvert(ec, lc, localcartesian, reverse, longfirst,
+                           binaryout, prec, *input, *output);
+    if (!binaryin && !binaryout && !server) {
+      // Text input and output are processed in blocks by a Pipeline
+      Pipeline p;
+      if (reverse)
+        p.Add(Pipeline::ParseCartesian())
+          .Add(localcartesian ? Pipeline::FromLocal(lc) :
+               Pipeline::FromGeocentric(ec))
+          .Add(Pipeline::FormatGeodetic(prec, longfirst));
+      else
+        p.Add(Pipeline::ParseGeodetic(longfirst))
+          .Add(localcartesian ? Pipeline::ToLocal(lc) :
+               Pipeline::ToGeocentric(ec))
+          .Add(Pipeline::FormatCartesian(prec));
+      return p.Process(*input, *output, cdelim) ? 1 : 0;
+    }
     std::string s, eol, stra, strb, strc, strd;
     std::istringstream str;
     int retval = 0;
-    while (std::getline(*input, s)) {
+    // Binary records are 3 little-endian doubles
+    real rec[3];
+    while (binaryin ? input->peek() != std::char_traits<char>::eof() :
+           bool(std::getline(*input, s))) {
       try {
         eol = "\n";
-        if (!cdelim.empty()) {
-          std::string::size_type m = s.find(cdelim);
-          if (m != std::string::npos) {
-            eol = " " + s.substr(m) + "\n";
-            s = s.substr(0, m);
-          }
-        }
-        str.clear(); str.str(s);
         // initial values to suppress warnings
         real lat, lon, h, x = 0, y = 0, z = 0;
-        if (!(str >> stra >> strb >> strc))
-          throw GeographicErr("Incomplete input: " + s);
-        if (reverse) {
-          x = Utility::val<real>(stra);
-          y = Utility::val<real>(strb);
-          z = Utility::val<real>(strc);
+        if (binaryin) {
+          Utility::readarray<double, real, false>(*input, rec, 3);
+          if (reverse) {
+            x = rec[0]; y = rec[1]; z = rec[2];
+          } else {
+            lat = rec[longfirst ? 1 : 0]; lon = rec[longfirst ? 0 : 1];
+            h = rec[2];
+            if (std::abs(lat) > 90)
+              throw GeographicErr("Latitude " + Utility::str(lat)
+                                  + "d not in [-90d, 90d]");
+          }
         } else {
-          DMS::DecodeLatLon(stra, strb, lat, lon, longfirst);
-          h = Utility::val<real>(strc);
+          if (!cdelim.empty()) {
+            std::string::size_type m = s.find(cdelim);
+            if (m != std::string::npos) {
+              eol = " " + s.substr(m) + "\n";
+              s = s.substr(0, m);
+            }
+          }
+          str.clear(); str.str(s);
+          if (!(str >> stra >> strb >> strc))
+            throw GeographicErr("Incomplete input: " + s);
+          if (reverse) {
+            x = Utility::val<real>(stra);
+            y = Utility::val<real>(strb);
+            z = Utility::val<real>(strc);
+          } else {
+            DMS::DecodeLatLon(stra, strb, lat, lon, longfirst);
+            h = Utility::val<real>(strc);
+          }
+          if (str >> strd)
+            throw GeographicErr("Extraneous input: " + strd);
         }
-        if (str >> strd)
-          throw GeographicErr("Extraneous input: " + strd);
         if (reverse) {
           if (localcartesian)
             lc.Reverse(x, y, z, lat, lon, h);
           else
             ec.Reverse(x, y, z, lat, lon, h);
-          *output << Utility::str(longfirst ? lon : lat, prec + 5) << " "
-                  << Utility::str(longfirst ? lat : lon, prec + 5) << " "
-                  << Utility::str(h, prec) << eol;
+          rec[0] = longfirst ? lon : lat; rec[1] = longfirst ? lat : lon;
+          rec[2] = h;
         } else {
           if (localcartesian)
             lc.Forward(lat, lon, h, x, y, z);
           else
             ec.Forward(lat, lon, h, x, y, z);
-          *output << Utility::str(x, prec) << " "
-                  << Utility::str(y, prec) << " "
-                  << Utility::str(z, prec) << eol;
+          rec[0] = x; rec[1] = y; rec[2] = z;
         }
+        if (binaryout)
+          Utility::writearray<double, real, false>(*output, rec, 3);
+        else
+          *output << Utility::str(rec[0], reverse ? prec + 5 : prec) << " "
+                  << Utility::str(rec[1], reverse ? prec + 5 : prec) << " "
+                  << Utility::str(rec[2], prec) << eol;
       }
       catch (const std::exception& e) {
-        *output << "ERROR: " << e.what() << "\n";
+        if (binaryout) {
+          // A record of NaNs marks an error
+          rec[0] = rec[1] = rec[2] = Math::NaN();
+          Utility::writearray<double, real, false>(*output, rec, 3);
+        } else
+          *output << "ERROR: " << e.what() << "\n";
         retval = 1;
       }
+      if (server) *output << std::flush;
     }
     return retval;
   }
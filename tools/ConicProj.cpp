@@ -13,9 +13,15 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <system_error>
 #include <GeographicLib/LambertConformalConic.hpp>
 #include <GeographicLib/AlbersEqualArea.hpp>
 #include <GeographicLib/DMS.hpp>
+#include <GeographicLib/MappedInput.hpp>
+#include <GeographicLib/TextColumns.hpp>
 #include <GeographicLib/Utility.hpp>
 
 #if defined(_MSC_VER)
@@ -31,12 +37,14 @@ int main(int argc, const char* const argv[]) {
     using namespace GeographicLib;
     typedef Math::real real;
     Utility::set_digits();
-    bool lcc = false, albers = false, reverse = false, longfirst = false;
+    bool lcc = false, albers = false, reverse = false, longfirst = false,
+      binaryin = false, binaryout = false, server = false;
     real lat1 = 0, lat2 = 0, lon0 = 0, k1 = 1;
     real
       a = Constants::WGS84_a(),
       f = Constants::WGS84_f();
     int prec = 6;
+    unsigned threads = 1;
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';';
 
@@ -107,7 +115,22 @@ int main(int argc, const char* const argv[]) {
           std::cerr << "Precision " << argv[m] << " is not a number\n";
           return 1;
         }
-      } else if (arg == "--input-string") {
+      } else if (arg == "-j" || arg == "--threads") {
+        if (++m == argc) return usage(1, true);
+        try {
+          threads = Utility::val<unsigned>(std::string(argv[m]));
+        }
+        catch (const std::exception&) {
+          std::cerr << "Thread count " << argv[m] << " is not a number\n";
+          return 1;
+        }
+      } else if (arg == "--binary-input")
+        binaryin = true;
+      else if (arg == "--binary-output")
+        binaryout = true;
+      else if (arg == "--server")
+        server = true;
+      else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
       } else if (arg == "--input-file") {
@@ -138,11 +161,17 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (binaryin && !istring.empty()) {
+      std::cerr
+        << "Cannot specify --input-string and --binary-input together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
-    std::ifstream infile;
+    MappedInput infile;
     std::istringstream instring;
     if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+      infile.open(ifile,
+                  binaryin ? std::ios::in | std::ios::binary : std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -163,7 +192,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), binaryout ?
+                   std::ios::out | std::ios::binary : std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -187,54 +217,179 @@ int main(int argc, const char* const argv[]) {
     // Max precision = 10: 0.1 nm in distance, 10^-15 deg (= 0.11 nm),
     // 10^-11 sec (= 0.3 nm).
     prec = std::min(10 + Math::extra_digits(), std::max(0, prec));
-    std::string s, eol, stra, strb, strc;
-    std::istringstream str;
-    int retval = 0;
-    while (std::getline(*input, s)) {
-      try {
-        eol = "\n";
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    // In server mode each line is answered before the next one is read.
+    threads = server ? 1u : std::max(1u, threads);
+    // Read the input in batches of lines (or records); the lines of each
+    // batch are divided into chunks which are handed out to a pool of
+    // threads.  The points in a chunk are projected together with the batch
+    // routines and the output for the batch is written in input order once
+    // all its lines have been processed.  In server mode, the batch consists
+    // of a single line.
+    const size_t chunk = server ? 1 : 1024,
+      nbatch = chunk * (threads > 1 ? 8 * size_t(threads) : 1);
+    // Binary input records are 2 little-endian doubles in the order of the
+    // text input; binary output records are 4 doubles in the order of the
+    // text output.
+    const size_t nin = 2, nout = 4;
+    std::vector<std::string> lines(binaryin ? 0 : nbatch), eols(nbatch),
+      outs(nbatch), errs(nbatch);
+    std::vector<real> ins(binaryin ? nin * nbatch : 0),
+      ress(binaryout ? nout * nbatch : 0),
+      u(nbatch), v(nbatch), x(nbatch), y(nbatch), gamma(nbatch), k(nbatch);
+    std::vector<const char*> fa(nbatch), fb(nbatch), fc(nbatch);
+    std::vector<size_t> la(nbatch), lb(nbatch), lc(nbatch);
+    // Process lines (or records) [i0, i1) of the batch.  The input is decoded
+    // into the columns u and v (lat and lon, or x and y with -r), the results
+    // go into x, y, gamma, and k, and these are formatted into outs (or
+    // ress); errors are recorded in errs.  This only touches elements [i0,
+    // i1) of the batch arrays and only reads the variables it captures and
+    // so may be called by several threads at once.
+    auto solve = [&](size_t i0, size_t i1) -> void {
+      const size_t n = i1 - i0;
+      for (size_t i = i0; i < i1; ++i) {
+        errs[i].clear();
+        eols[i] = "\n";
+        if (binaryin) {
+          const real* in = &ins[nin * i];
+          u[i] = in[reverse || !longfirst ? 0 : 1];
+          v[i] = in[reverse || !longfirst ? 1 : 0];
+          if (!reverse && std::abs(u[i]) > 90)
+            errs[i] = "Latitude " + Utility::str(u[i])
+              + "d not in [-90d, 90d]";
+          continue;
+        }
+        const std::string& s = lines[i];
+        size_t len = s.size();
         if (!cdelim.empty()) {
           std::string::size_type m = s.find(cdelim);
           if (m != std::string::npos) {
-            eol = " " + s.substr(m) + "\n";
-            s = s.substr(0, m);
+            eols[i] = " " + s.substr(m) + "\n";
+            len = m;
           }
         }
-        str.clear(); str.str(s);
-        real lat, lon, x, y, gamma, k;
-        if (!(str >> stra >> strb))
-          throw GeographicErr("Incomplete input: " + s);
+        const char* f[3]; size_t l[3];
+        size_t nf = TextColumns::Split(s.data(), len, 3, f, l, false);
+        fa[i] = fb[i] = fc[i] = nullptr;
+        if (nf < 2) {
+          errs[i] = "Incomplete input: " + s.substr(0, len);
+          continue;
+        }
+        fa[i] = f[0]; la[i] = l[0];
+        fb[i] = f[1]; lb[i] = l[1];
+        if (nf > 2) { fc[i] = f[2]; lc[i] = l[2]; }
+      }
+      if (!binaryin) {
         if (reverse) {
-          x = Utility::val<real>(stra);
-          y = Utility::val<real>(strb);
+          TextColumns::DecodeNumbers(n, &fa[i0], &la[i0], &u[i0], &errs[i0]);
+          for (size_t i = i0; i < i1; ++i)
+            if (!errs[i].empty()) fb[i] = nullptr;
+          TextColumns::DecodeNumbers(n, &fb[i0], &lb[i0], &v[i0], &errs[i0]);
         } else
-          DMS::DecodeLatLon(stra, strb, lat, lon, longfirst);
-        if (str >> strc)
-          throw GeographicErr("Extraneous input: " + strc);
-        if (reverse) {
-          if (lcc)
-            lproj.Reverse(lon0, x, y, lat, lon, gamma, k);
-          else
-            aproj.Reverse(lon0, x, y, lat, lon, gamma, k);
-          *output << Utility::str(longfirst ? lon : lat, prec + 5) << " "
-                  << Utility::str(longfirst ? lat : lon, prec + 5) << " "
-                  << Utility::str(gamma, prec + 6) << " "
-                  << Utility::str(k, prec + 6) << eol;
-        } else {
-          if (lcc)
-            lproj.Forward(lon0, lat, lon, x, y, gamma, k);
-          else
-            aproj.Forward(lon0, lat, lon, x, y, gamma, k);
-          *output << Utility::str(x, prec) << " "
-                  << Utility::str(y, prec) << " "
-                  << Utility::str(gamma, prec + 6) << " "
-                  << Utility::str(k, prec + 6) << eol;
+          TextColumns::DecodeLatLon(n, &fa[i0], &la[i0], &fb[i0], &lb[i0],
+                                    longfirst, &u[i0], &v[i0], &errs[i0]);
+        for (size_t i = i0; i < i1; ++i)
+          if (fc[i] && errs[i].empty())
+            errs[i] = "Extraneous input: " + std::string(fc[i], lc[i]);
+      }
+      for (size_t i = i0; i < i1; ++i)
+        if (!errs[i].empty()) u[i] = v[i] = Math::NaN();
+      if (lcc) {
+        if (reverse)
+          lproj.ReverseBatch(n, lon0, &u[i0], &v[i0], &x[i0], &y[i0],
+                             &gamma[i0], &k[i0]);
+        else
+          lproj.ForwardBatch(n, lon0, &u[i0], &v[i0], &x[i0], &y[i0],
+                             &gamma[i0], &k[i0]);
+      } else {
+        if (reverse)
+          aproj.ReverseBatch(n, lon0, &u[i0], &v[i0], &x[i0], &y[i0],
+                             &gamma[i0], &k[i0]);
+        else
+          aproj.ForwardBatch(n, lon0, &u[i0], &v[i0], &x[i0], &y[i0],
+                             &gamma[i0], &k[i0]);
+      }
+      for (size_t i = i0; i < i1; ++i) {
+        // With -r, x and y hold lat and lon
+        real
+          r1 = reverse && longfirst ? y[i] : x[i],
+          r2 = reverse && longfirst ? x[i] : y[i];
+        int p = reverse ? prec + 5 : prec;
+        if (binaryout) {
+          real* r = &ress[nout * i];
+          if (errs[i].empty()) {
+            r[0] = r1; r[1] = r2; r[2] = gamma[i]; r[3] = k[i];
+          } else
+            // A record of NaNs marks an error
+            std::fill(r, r + nout, Math::NaN());
+        } else if (errs[i].empty())
+          outs[i] = Utility::str(r1, p) + " " + Utility::str(r2, p) + " "
+            + Utility::str(gamma[i], prec + 6) + " "
+            + Utility::str(k[i], prec + 6) + eols[i];
+        else
+          // Write error message cout so output lines match input lines
+          outs[i] = "ERROR: " + errs[i] + "\n";
+      }
+    };
+
+    std::string out;
+    int retval = 0;
+    while (*input) {
+      // An incomplete record at the end of binary input is treated as an
+      // error.
+      size_t n = 0, nbad = nbatch;
+      if (binaryin) {
+        for (; n < nbatch &&
+               input->peek() != std::char_traits<char>::eof(); ++n) {
+          try {
+            Utility::readarray<double, real, false>(*input, &ins[nin * n],
+                                                    nin);
+          }
+          catch (const std::exception&) {
+            std::fill(&ins[nin * n], &ins[nin * n] + nin, Math::NaN());
+            nbad = n++;
+            break;
+          }
         }
+      } else
+        while (n < nbatch && std::getline(*input, lines[n])) ++n;
+      if (n == 0) break;
+      std::atomic<size_t> next(0);
+      auto worker = [&]() -> void {
+        for (size_t c; (c = next++) * chunk < n;)
+          solve(c * chunk, std::min(n, (c + 1) * chunk));
+      };
+      std::vector<std::thread> pool;
+      pool.reserve(threads - 1);
+      try {
+        for (unsigned t = 1; t < threads && t * chunk < n; ++t)
+          pool.push_back(std::thread(worker));
+      }
+      catch (const std::system_error&) {
+        // Couldn't start all the threads; carry on with the ones we've got.
+      }
+      worker();
+      for (auto& th : pool) th.join();
+      if (nbad < n) {
+        errs[nbad] = "Failure reading data";
+        if (binaryout)
+          std::fill(&ress[nout * nbad], &ress[nout * nbad] + nout,
+                    Math::NaN());
+        else
+          outs[nbad] = "ERROR: " + errs[nbad] + "\n";
       }
-      catch (const std::exception& e) {
-        *output << "ERROR: " << e.what() << "\n";
-        retval = 1;
+      for (size_t i = 0; i < n; ++i)
+        if (!errs[i].empty()) retval = 1;
+      if (binaryout)
+        Utility::writearray<double, real, false>(*output, ress.data(),
+                                                 nout * n);
+      else {
+        out.clear();
+        for (size_t i = 0; i < n; ++i)
+          out += outs[i];
+        *output << out;
       }
+      if (server) *output << std::flush;
     }
     return retval;
   }
@@ -15,6 +15,7 @@
 #include <fstream>
 #include <GeographicLib/GeoCoords.hpp>
 #include <GeographicLib/DMS.hpp>
+#include <GeographicLib/MappedInput.hpp>
 #include <GeographicLib/Utility.hpp>
 #include <GeographicLib/MGRS.hpp>
 
@@ -34,7 +35,8 @@ int main(int argc, const char* const argv[]) {
     int outputmode = GEOGRAPHIC;
     int prec = 0;
     int zone = UTMUPS::MATCH;
-    bool centerp = true, longfirst = false;
+    bool centerp = true, longfirst = false, binaryin = false,
+      binaryout = false, server = false;
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';', dmssep = char(0);
     bool sethemisphere = false, northp = false, abbrev = true, latch = false;
@@ -110,6 +112,12 @@ int main(int argc, const char* const argv[]) {
         abbrev = false;
       else if (arg == "-a")
         abbrev = true;
+      else if (arg == "--binary-input")
+        binaryin = true;
+      else if (arg == "--binary-output")
+        binaryout = true;
+      else if (arg == "--server")
+        server = true;
       else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
@@ -142,11 +150,21 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (binaryin && !istring.empty()) {
+      std::cerr
+        << "Cannot specify --input-string and --binary-input together\n";
+      return 1;
+    }
+    if (binaryout && outputmode == MGRS) {
+      std::cerr << "Cannot specify -m and --binary-output together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
-    std::ifstream infile;
+    MappedInput infile;
     std::istringstream instring;
     if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+      infile.open(ifile,
+                  binaryin ? std::ios::in | std::ios::binary : std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -167,7 +185,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), binaryout ?
+                   std::ios::out | std::ios::binary : std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -179,44 +198,78 @@ int main(int argc, const char* const argv[]) {
     std::string s, eol;
     std::string os;
     int retval = 0;
+    // Binary input records are 2 little-endian doubles, latitude and
+    // longitude; binary output records are 2 doubles (geographic and
+    // convergence) or 4 doubles (zone, hemisphere, easting, northing).
+    real rec[4];
+    const int nout = outputmode == UTMUPS ? 4 : 2;
 
-    while (std::getline(*input, s)) {
+    while (binaryin ? input->peek() != std::char_traits<char>::eof() :
+           bool(std::getline(*input, s))) {
       eol = "\n";
       try {
-        if (!cdelim.empty()) {
-          std::string::size_type m = s.find(cdelim);
-          if (m != std::string::npos) {
-            eol = " " + s.substr(m) + "\n";
-            s = s.substr(0, m);
+        if (binaryin) {
+          Utility::readarray<double, real, false>(*input, rec, 2);
+          p.Reset(rec[longfirst ? 1 : 0], rec[longfirst ? 0 : 1]);
+        } else {
+          if (!cdelim.empty()) {
+            std::string::size_type m = s.find(cdelim);
+            if (m != std::string::npos) {
+              eol = " " + s.substr(m) + "\n";
+              s = s.substr(0, m);
+            }
           }
+          p.Reset(s, centerp, longfirst);
         }
-        p.Reset(s, centerp, longfirst);
         p.SetAltZone(zone);
-        switch (outputmode) {
-        case GEOGRAPHIC:
-          os = p.GeoRepresentation(prec, longfirst);
-          break;
-        case DMS:
-          os = p.DMSRepresentation(prec, longfirst, dmssep);
-          break;
-        case UTMUPS:
-          os = (sethemisphere
-                ? p.AltUTMUPSRepresentation(northp, prec, abbrev)
-                : p.AltUTMUPSRepresentation(prec, abbrev));
-          break;
-        case MGRS:
-          os = p.AltMGRSRepresentation(prec);
-          break;
-        case CONVERGENCE:
-          {
-            real
-              gamma = p.AltConvergence(),
-              k = p.AltScale();
-            int prec1 = std::max(-5, std::min(Math::extra_digits() + 8, prec));
-            os = Utility::str(gamma, prec1 + 5) + " "
-              + Utility::str(k, prec1 + 7);
+        if (binaryout) {
+          switch (outputmode) {
+          case UTMUPS:
+            {
+              bool northpa = sethemisphere ? northp : p.Northp();
+              real x, y;
+              int z;
+              UTMUPS::Transfer(p.AltZone(), p.Northp(),
+                               p.AltEasting(), p.AltNorthing(),
+                               p.AltZone(), northpa, x, y, z);
+              rec[0] = p.AltZone(); rec[1] = northpa ? 1 : 0;
+              rec[2] = x; rec[3] = y;
+            }
+            break;
+          case CONVERGENCE:
+            rec[0] = p.AltConvergence(); rec[1] = p.AltScale();
+            break;
+          default:
+            rec[0] = longfirst ? p.Longitude() : p.Latitude();
+            rec[1] = longfirst ? p.Latitude() : p.Longitude();
+          }
+        } else
+          switch (outputmode) {
+          case GEOGRAPHIC:
+            os = p.GeoRepresentation(prec, longfirst);
+            break;
+          case DMS:
+            os = p.DMSRepresentation(prec, longfirst, dmssep);
+            break;
+          case UTMUPS:
+            os = (sethemisphere
+                  ? p.AltUTMUPSRepresentation(northp, prec, abbrev)
+                  : p.AltUTMUPSRepresentation(prec, abbrev));
+            break;
+          case MGRS:
+            os = p.AltMGRSRepresentation(prec);
+            break;
+          case CONVERGENCE:
+            {
+              real
+                gamma = p.AltConvergence(),
+                k = p.AltScale();
+              int prec1 = std::max(-5, std::min(Math::extra_digits() + 8,
+                                                prec));
+              os = Utility::str(gamma, prec1 + 5) + " "
+                + Utility::str(k, prec1 + 7);
+            }
           }
-        }
         if (latch &&
             zone < UTMUPS::MINZONE && p.AltZone() >= UTMUPS::MINZONE) {
           zone = p.AltZone();
@@ -228,9 +281,15 @@ int main(int argc, const char* const argv[]) {
       catch (const std::exception& e) {
         // Write error message to cout so output lines match input lines
         os = std::string("ERROR: ") + e.what();
+        // A record of NaNs marks an error in the binary output
+        std::fill(rec, rec + nout, Math::NaN());
         retval = 1;
       }
-      *output << os << eol;
+      if (binaryout)
+        Utility::writearray<double, real, false>(*output, rec, nout);
+      else
+        *output << os << eol;
+      if (server) *output << std::flush;
     }
     return retval;
   }
@@ -13,11 +13,16 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <system_error>
 #include <GeographicLib/Geodesic.hpp>
 #include <GeographicLib/GeodesicLine.hpp>
 #include <GeographicLib/GeodesicExact.hpp>
 #include <GeographicLib/GeodesicLineExact.hpp>
 #include <GeographicLib/DMS.hpp>
+#include <GeographicLib/MappedInput.hpp>
 #include <GeographicLib/Utility.hpp>
 
 #if defined(_MSC_VER)
@@ -75,13 +80,16 @@ int main(int argc, const char* const argv[]) {
     bool inverse = false, arcmode = false,
       dms = false, full = false, exact = false, unroll = false,
       longfirst = false, azi2back = false, fraction = false,
-      arcmodeline = false;
+      arcmodeline = false, binaryin = false, binaryout = false,
+      server = false;
     real
       a = Constants::WGS84_a(),
       f = Constants::WGS84_f();
-    real lat1, lon1, azi1, lat2, lon2, azi2, s12, m12, a12, M12, M21, S12,
+    // The values given on the command line
+    real lat1 = 0, lon1 = 0, azi1 = 0, lat2 = 0, lon2 = 0, s12 = 0,
       mult = 1;
     int linecalc = NONE, prec = 3;
+    unsigned threads = 1;
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';', dmssep = char(0);
 
@@ -175,6 +183,21 @@ int main(int argc, const char* const argv[]) {
         }
       } else if (arg == "-E")
         exact = true;
+      else if (arg == "-j" || arg == "--threads") {
+        if (++m == argc) return usage(1, true);
+        try {
+          threads = Utility::val<unsigned>(std::string(argv[m]));
+        }
+        catch (const std::exception&) {
+          std::cerr << "Thread count " << argv[m] << " is not a number\n";
+          return 1;
+        }
+      } else if (arg == "--binary-input")
+        binaryin = true;
+      else if (arg == "--binary-output")
+        binaryout = true;
+      else if (arg == "--server")
+        server = true;
       else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
@@ -206,11 +229,17 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (binaryin && !istring.empty()) {
+      std::cerr
+        << "Cannot specify --input-string and --binary-input together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
-    std::ifstream infile;
+    MappedInput infile;
     std::istringstream instring;
     if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+      infile.open(ifile,
+                  binaryin ? std::ios::in | std::ios::binary : std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -231,7 +260,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), binaryout ?
+                   std::ios::out | std::ios::binary : std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -281,27 +311,74 @@ int main(int argc, const char* const argv[]) {
     // Max precision = 10: 0.1 nm in distance, 10^-15 deg (= 0.11 nm),
     // 10^-11 sec (= 0.3 nm).
     prec = std::min(10 + Math::extra_digits(), std::max(0, prec));
-    std::string s, eol, slat1, slon1, slat2, slon2, sazi1, ss12, strc;
-    std::istringstream str;
-    int retval = 0;
-    while (std::getline(*input, s)) {
+    // Binary input records are 1 (-L, -D, -I) or 4 little-endian doubles in
+    // the order of the text input; binary output records are 3 (or 12 with
+    // -f) doubles in the order of the text output.
+    const size_t nin = linecalc ? 1 : 4, nout = full ? 12 : 3;
+    // Solve the problem for one line of input s (or, if in is non-null, for
+    // the binary record in), putting the output line in out (or, if res is
+    // non-null, the binary record in res); str is scratch space.  Return true
+    // if there's an error.  This only reads the variables it captures and so
+    // may be called by several threads at once.
+    const real lat1l = lat1, lon1l = lon1, azi1l = azi1;
+    auto solve = [&](std::string s, const real* in, std::istringstream& str,
+                     std::string& out, real* res) -> bool {
+      std::string eol, slat1, slon1, slat2, slon2, sazi1, ss12, strc;
+      real lat1 = lat1l, lon1 = lon1l, azi1 = azi1l,
+        lat2 = 0, lon2, azi2, s12, m12, a12, M12, M21, S12;
+      out.clear();
       try {
         eol = "\n";
-        if (!cdelim.empty()) {
-          std::string::size_type m = s.find(cdelim);
-          if (m != std::string::npos) {
-            eol = " " + s.substr(m) + "\n";
-            s = s.substr(0, m);
+        if (in) {
+          if (linecalc)
+            s12 = in[0] * mult;
+          else {
+            lat1 = in[longfirst ? 1 : 0]; lon1 = in[longfirst ? 0 : 1];
+            if (inverse) {
+              lat2 = in[longfirst ? 3 : 2]; lon2 = in[longfirst ? 2 : 3];
+            } else {
+              azi1 = in[2]; s12 = in[3];
+            }
+            if (std::abs(lat1) > 90 || std::abs(lat2) > 90)
+              throw GeographicErr("Latitude " +
+                                  Utility::str(std::abs(lat1) > 90 ?
+                                               lat1 : lat2)
+                                  + "d not in [-90d, 90d]");
+          }
+        } else {
+          if (!cdelim.empty()) {
+            std::string::size_type m = s.find(cdelim);
+            if (m != std::string::npos) {
+              eol = " " + s.substr(m) + "\n";
+              s = s.substr(0, m);
+            }
+          }
+          str.clear(); str.str(s);
+          if (inverse) {
+            if (!(str >> slat1 >> slon1 >> slat2 >> slon2))
+              throw GeographicErr("Incomplete input: " + s);
+          } else if (linecalc) {
+            if (!(str >> ss12))
+              throw GeographicErr("Incomplete input: " + s);
+          } else {
+            if (!(str >> slat1 >> slon1 >> sazi1 >> ss12))
+              throw GeographicErr("Incomplete input: " + s);
           }
-        }
-        str.clear(); str.str(s);
-        if (inverse) {
-          if (!(str >> slat1 >> slon1 >> slat2 >> slon2))
-            throw GeographicErr("Incomplete input: " + s);
           if (str >> strc)
             throw GeographicErr("Extraneous input: " + strc);
-          DMS::DecodeLatLon(slat1, slon1, lat1, lon1, longfirst);
-          DMS::DecodeLatLon(slat2, slon2, lat2, lon2, longfirst);
+          if (inverse) {
+            DMS::DecodeLatLon(slat1, slon1, lat1, lon1, longfirst);
+            DMS::DecodeLatLon(slat2, slon2, lat2, lon2, longfirst);
+          } else if (linecalc)
+            // In fraction mode input is read as a distance
+            s12 = ReadDistance(ss12, !fraction && arcmode, fraction) * mult;
+          else {
+            DMS::DecodeLatLon(slat1, slon1, lat1, lon1, longfirst);
+            azi1 = DMS::DecodeAzimuth(sazi1);
+            s12 = ReadDistance(ss12, arcmode);
+          }
+        }
+        if (inverse) {
           a12 = exact ?
             geode.GenInverse(lat1, lon1, lat2, lon2, outmask,
                              s12, azi1, azi2, m12, M12, M21, S12) :
@@ -316,74 +393,167 @@ int main(int argc, const char* const argv[]) {
               lon1 = Math::AngNormalize(lon1);
               lon2 = Math::AngNormalize(lon2);
             }
-            *output << LatLonString(lat1, lon1, prec, dms, dmssep, longfirst)
-                    << " ";
           }
-          *output << AzimuthString(azi1, prec, dms, dmssep) << " ";
-          if (full)
-            *output << LatLonString(lat2, lon2, prec, dms, dmssep, longfirst)
-                    << " ";
-          if (azi2back)
-            azi2 += azi2 >= 0 ? -180 : 180;
-          *output << AzimuthString(azi2, prec, dms, dmssep) << " "
-                  << DistanceStrings(s12, a12, full, arcmode, prec, dms);
-          if (full)
-            *output << " " << Utility::str(m12, prec)
-                    << " " << Utility::str(M12, prec+7)
-                    << " " << Utility::str(M21, prec+7)
-                    << " " << Utility::str(S12, std::max(prec-7, 0));
-          *output << eol;
         } else {
-          if (linecalc) {
-            if (!(str >> ss12))
-              throw GeographicErr("Incomplete input: " + s);
-            if (str >> strc)
-              throw GeographicErr("Extraneous input: " + strc);
-            // In fraction mode input is read as a distance
-            s12 = ReadDistance(ss12, !fraction && arcmode, fraction) * mult;
+          if (linecalc)
             a12 = exact ?
               le.GenPosition(arcmode, s12, outmask,
                              lat2, lon2, azi2, s12, m12, M12, M21, S12) :
               ls.GenPosition(arcmode, s12, outmask,
                              lat2, lon2, azi2, s12, m12, M12, M21, S12);
-          } else {
-            if (!(str >> slat1 >> slon1 >> sazi1 >> ss12))
-              throw GeographicErr("Incomplete input: " + s);
-            if (str >> strc)
-              throw GeographicErr("Extraneous input: " + strc);
-            DMS::DecodeLatLon(slat1, slon1, lat1, lon1, longfirst);
-            azi1 = DMS::DecodeAzimuth(sazi1);
-            s12 = ReadDistance(ss12, arcmode);
+          else
             a12 = exact ?
               geode.GenDirect(lat1, lon1, azi1, arcmode, s12, outmask,
                               lat2, lon2, azi2, s12, m12, M12, M21, S12) :
               geods.GenDirect(lat1, lon1, azi1, arcmode, s12, outmask,
                               lat2, lon2, azi2, s12, m12, M12, M21, S12);
+          if (full && !unroll) lon1 = Math::AngNormalize(lon1);
+        }
+        if (azi2back)
+          azi2 += azi2 >= 0 ? -180 : 180;
+        if (res) {
+          real* r = res;
+          if (full) {
+            *r++ = longfirst ? lon1 : lat1; *r++ = longfirst ? lat1 : lon1;
+            *r++ = azi1;
+          } else if (inverse)
+            *r++ = azi1;
+          if (full || !inverse) {
+            *r++ = longfirst ? lon2 : lat2; *r++ = longfirst ? lat2 : lon2;
           }
+          *r++ = azi2;
+          if (full) {
+            *r++ = s12; *r++ = a12;
+            *r++ = m12; *r++ = M12; *r++ = M21; *r++ = S12;
+          } else if (inverse)
+            *r++ = arcmode ? a12 : s12;
+        } else if (inverse) {
+          if (full) {
+            out += LatLonString(lat1, lon1, prec, dms, dmssep, longfirst);
+            out += " ";
+          }
+          out += AzimuthString(azi1, prec, dms, dmssep);
+          out += " ";
+          if (full) {
+            out += LatLonString(lat2, lon2, prec, dms, dmssep, longfirst);
+            out += " ";
+          }
+          out += AzimuthString(azi2, prec, dms, dmssep);
+          out += " ";
+          out += DistanceStrings(s12, a12, full, arcmode, prec, dms);
           if (full)
-            *output
-              << LatLonString(lat1, unroll ? lon1 : Math::AngNormalize(lon1),
-                              prec, dms, dmssep, longfirst)
-              << " " << AzimuthString(azi1, prec, dms, dmssep) << " ";
-          if (azi2back)
-            azi2 += azi2 >= 0 ? -180 : 180;
-          *output << LatLonString(lat2, lon2, prec, dms, dmssep, longfirst)
-                  << " " << AzimuthString(azi2, prec, dms, dmssep);
+            out += " " + Utility::str(m12, prec)
+              + " " + Utility::str(M12, prec+7)
+              + " " + Utility::str(M21, prec+7)
+              + " " + Utility::str(S12, std::max(prec-7, 0));
+          out += eol;
+        } else {
+          if (full) {
+            out += LatLonString(lat1, lon1, prec, dms, dmssep, longfirst);
+            out += " " + AzimuthString(azi1, prec, dms, dmssep) + " ";
+          }
+          out += LatLonString(lat2, lon2, prec, dms, dmssep, longfirst);
+          out += " " + AzimuthString(azi2, prec, dms, dmssep);
           if (full)
-            *output << " "
-                    << DistanceStrings(s12, a12, full, arcmode, prec, dms)
-                    << " " << Utility::str(m12, prec)
-                    << " " << Utility::str(M12, prec+7)
-                    << " " << Utility::str(M21, prec+7)
-                    << " " << Utility::str(S12, std::max(prec-7, 0));
-          *output << eol;
+            out += " " + DistanceStrings(s12, a12, full, arcmode, prec, dms)
+              + " " + Utility::str(m12, prec)
+              + " " + Utility::str(M12, prec+7)
+              + " " + Utility::str(M21, prec+7)
+              + " " + Utility::str(S12, std::max(prec-7, 0));
+          out += eol;
         }
       }
       catch (const std::exception& e) {
-        // Write error message cout so output lines match input lines
-        *output << "ERROR: " << e.what() << "\n";
-        retval = 1;
+        if (res)
+          // A record of NaNs marks an error
+          std::fill(res, res + nout, Math::NaN());
+        else
+          // Write error message cout so output lines match input lines
+          out = "ERROR: " + std::string(e.what()) + "\n";
+        return true;
+      }
+      return false;
+    };
+
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    // In server mode each line is answered before the next one is read.
+    threads = server ? 1u : std::max(1u, threads);
+    // Read the input in batches of lines (or records); the lines of each
+    // batch are divided into chunks which are handed out to a pool of
+    // threads.  The output for the batch is written in input order once all
+    // its lines have been processed.  In the single-threaded case, the
+    // batch consists of a single line.
+    const size_t chunk = threads > 1 ? 1024 : 1,
+      nbatch = chunk * (threads > 1 ? 8 * size_t(threads) : 1);
+    std::vector<std::string> lines(binaryin ? 0 : nbatch), outs(nbatch);
+    std::vector<real> ins(binaryin ? nin * nbatch : 0),
+      ress(binaryout ? nout * nbatch : 0);
+    std::vector<char> errs(nbatch);
+    std::string out;
+    std::istringstream str;
+    int retval = 0;
+    while (*input) {
+      // An incomplete record at the end of binary input is treated as an
+      // error.
+      size_t n = 0, nbad = nbatch;
+      if (binaryin) {
+        for (; n < nbatch &&
+               input->peek() != std::char_traits<char>::eof(); ++n) {
+          try {
+            Utility::readarray<double, real, false>(*input, &ins[nin * n],
+                                                    nin);
+          }
+          catch (const std::exception&) {
+            std::fill(&ins[nin * n], &ins[nin * n] + nin, Math::NaN());
+            nbad = n++;
+            break;
+          }
+        }
+      } else
+        while (n < nbatch && std::getline(*input, lines[n])) ++n;
+      if (n == 0) break;
+      std::atomic<size_t> next(0);
+      auto worker = [&](std::istringstream& wstr) -> void {
+        for (size_t k; (k = next++) * chunk < n;)
+          for (size_t i = k * chunk; i < std::min(n, (k + 1) * chunk); ++i)
+            errs[i] = solve(binaryin ? std::string() : lines[i],
+                            binaryin ? &ins[nin * i] : nullptr, wstr, outs[i],
+                            binaryout ? &ress[nout * i] : nullptr);
+      };
+      std::vector<std::thread> pool;
+      pool.reserve(threads - 1);
+      try {
+        for (unsigned k = 1; k < threads && k * chunk < n; ++k)
+          pool.push_back(std::thread([&]() -> void {
+                std::istringstream wstr;
+                worker(wstr);
+              }));
+      }
+      catch (const std::system_error&) {
+        // Couldn't start all the threads; carry on with the ones we've got.
+      }
+      worker(str);
+      for (auto& th : pool) th.join();
+      if (nbad < n) {
+        errs[nbad] = true;
+        if (binaryout)
+          std::fill(&ress[nout * nbad], &ress[nout * nbad] + nout,
+                    Math::NaN());
+        else
+          outs[nbad] = "ERROR: Failure reading data\n";
+      }
+      for (size_t i = 0; i < n; ++i)
+        if (errs[i]) retval = 1;
+      if (binaryout)
+        Utility::writearray<double, real, false>(*output, ress.data(),
+                                                 nout * n);
+      else {
+        out.clear();
+        for (size_t i = 0; i < n; ++i)
+          out += outs[i];
+        *output << out;
       }
+      if (server) *output << std::flush;
     }
     return retval;
   }
@@ -13,8 +13,13 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <system_error>
 #include <GeographicLib/Geoid.hpp>
 #include <GeographicLib/DMS.hpp>
+#include <GeographicLib/MappedInput.hpp>
 #include <GeographicLib/Utility.hpp>
 #include <GeographicLib/GeoCoords.hpp>
 
@@ -38,8 +43,10 @@ int main(int argc, const char* const argv[]) {
     Geoid::convertflag heightmult = Geoid::NONE;
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';';
-    bool northp = false, longfirst = false;
+    bool northp = false, longfirst = false, binaryin = false,
+      binaryout = false, server = false, mmap = false;
     int zonenum = UTMUPS::INVALID;
+    unsigned threads = 1;
 
     for (int m = 1; m < argc; ++m) {
       std::string arg(argv[m]);
@@ -92,6 +99,23 @@ int main(int argc, const char* const argv[]) {
         cubic = false;
       else if (arg == "-v")
         verbose = true;
+      else if (arg == "--mmap")
+        mmap = true;
+      else if (arg == "-j" || arg == "--threads") {
+        if (++m == argc) return usage(1, true);
+        try {
+          threads = Utility::val<unsigned>(std::string(argv[m]));
+        }
+        catch (const std::exception&) {
+          std::cerr << "Thread count " << argv[m] << " is not a number\n";
+          return 1;
+        }
+      } else if (arg == "--binary-input")
+        binaryin = true;
+      else if (arg == "--binary-output")
+        binaryout = true;
+      else if (arg == "--server")
+        server = true;
       else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
@@ -130,11 +154,17 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (binaryin && !istring.empty()) {
+      std::cerr
+        << "Cannot specify --input-string and --binary-input together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
-    std::ifstream infile;
+    MappedInput infile;
     std::istringstream instring;
     if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+      infile.open(ifile,
+                  binaryin ? std::ios::in | std::ios::binary : std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -155,7 +185,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), binaryout ?
+                   std::ios::out | std::ios::binary : std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -163,9 +194,20 @@ int main(int argc, const char* const argv[]) {
     }
     std::ostream* output = !ofile.empty() ? &outfile : &std::cout;
 
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    // In server mode each line is answered before the next one is read.
+    threads = server ? 1u : std::max(1u, threads);
+    if ((cacheall || cachearea) && (mmap || threads > 1)) {
+      std::cerr << "Cannot specify -a or -c with --mmap or -j\n";
+      return 1;
+    }
+
     int retval = 0;
     try {
-      const Geoid g(geoid, dir, cubic);
+      // With several threads, the Geoid must be thread safe; this is
+      // automatically the case with a memory mapped data file.
+      const Geoid g(geoid, dir, cubic, threads > 1,
+                    mmap ? Geoid::MEMORYMAP : Geoid::STREAM);
       try {
         if (cacheall)
           g.CacheAll();
@@ -192,37 +234,69 @@ int main(int argc, const char* const argv[]) {
             << "\n";
       }
 
-      GeoCoords p;
-      std::string s, eol, suff;
       const char* spaces = " \t\n\v\f\r,"; // Include comma as space
-      while (std::getline(*input, s)) {
-        try {
-          eol = "\n";
+      // Binary input records are 2 little-endian doubles (3 with
+      // --msltohae or --haetomsl); binary output records are 1 double.
+      const int nrec = heightmult ? 3 : 2;
+      // Read the input in batches of lines (or records); the lines of each
+      // batch are divided into chunks which are handed out to a pool of
+      // threads.  The geoid heights for a chunk are computed together so
+      // that the fit for a cell is reused by all the points in the chunk
+      // which lie in it.  The output for the batch is written in input order
+      // once all its lines have been processed.  In the single-threaded case,
+      // the batch consists of a single line.
+      const size_t chunk = threads > 1 ? 1024 : 1,
+        nbatch = chunk * (threads > 1 ? 8 * size_t(threads) : 1);
+      std::vector<std::string> lines(binaryin ? 0 : nbatch), outs(nbatch),
+        suffs(nbatch), eols(nbatch);
+      std::vector<real> ins(binaryin ? nrec * nbatch : 0),
+        lats(nbatch), lons(nbatch), heights(nbatch), hs(nbatch);
+      std::vector<char> errs(nbatch);
+      std::string out;
+      // Decode the i'th line (or record) of the batch setting lats[i],
+      // lons[i], heights[i], suffs[i], and eols[i]; lines[i] is trimmed to
+      // the part which precedes the height.  p is workspace.  This may be
+      // called by several threads at once.
+      auto parse = [&](size_t i, GeoCoords& p) -> void {
+        std::string& eol = eols[i];
+        std::string& suff = suffs[i];
+        eol = "\n"; suff.clear();
+        real& height = heights[i];
+        height = 0;
+        if (binaryin) {
+          const real* rec = &ins[nrec * i];
+          if (heightmult) height = rec[2];
+          if (zonenum != UTMUPS::INVALID)
+            p.Reset(zonenum, northp, rec[0], rec[1]);
+          else
+            p.Reset(rec[longfirst ? 1 : 0], rec[longfirst ? 0 : 1]);
+        } else {
+          std::string& s = lines[i];
           if (!cdelim.empty()) {
             std::string::size_type m = s.find(cdelim);
             if (m != std::string::npos) {
               eol = " " + s.substr(m) + "\n";
               std::string::size_type m1 =
-                m > 0 ? s.find_last_not_of(spaces, m - 1) : std::string::npos;
+                m > 0 ? s.find_last_not_of(spaces, m - 1) :
+                std::string::npos;
               s = s.substr(0, m1 != std::string::npos ? m1 + 1 : m);
             }
           }
-          real height = 0;
           if (zonenum != UTMUPS::INVALID) {
             // Expect "easting northing" if heightmult == 0, or
             // "easting northing height" if heightmult != 0.
             std::string::size_type pa = 0, pb = 0;
             real easting = 0, northing = 0;
-            for (int i = 0; i < (heightmult ? 3 : 2); ++i) {
+            for (int j = 0; j < (heightmult ? 3 : 2); ++j) {
               if (pb == std::string::npos)
                 throw GeographicErr("Incomplete input: " + s);
-              // Start of i'th token
+              // Start of j'th token
               pa = s.find_first_not_of(spaces, pb);
               if (pa == std::string::npos)
                 throw GeographicErr("Incomplete input: " + s);
-              // End of i'th token
+              // End of j'th token
               pb = s.find_first_of(spaces, pa);
-              (i == 2 ? height : (i == 0 ? easting : northing)) =
+              (j == 2 ? height : (j == 0 ? easting : northing)) =
                 Utility::val<real>(s.substr(pa, (pb == std::string::npos ?
                                                  pb : pb - pa)));
             }
@@ -246,20 +320,97 @@ int main(int argc, const char* const argv[]) {
             }
             p.Reset(s, true, longfirst);
           }
-          if (heightmult) {
-            real h = g(p.Latitude(), p.Longitude());
-            *output << s
-                    << Utility::str(height + real(heightmult) * h, 4)
-                    << suff << eol;
-          } else {
-            real h = g(p.Latitude(), p.Longitude());
-            *output << Utility::str(h, 4) << eol;
+        }
+        lats[i] = p.Latitude(); lons[i] = p.Longitude();
+      };
+      auto error = [&](size_t i, const std::exception& e) -> void {
+        errs[i] = true;
+        // A NaN marks an error in the binary output
+        hs[i] = Math::NaN();
+        outs[i] = "ERROR: " + std::string(e.what()) + "\n";
+      };
+      while (*input) {
+        // An incomplete record at the end of binary input is treated as an
+        // error.
+        size_t n = 0, nbad = nbatch;
+        if (binaryin) {
+          for (; n < nbatch &&
+                 input->peek() != std::char_traits<char>::eof(); ++n) {
+            try {
+              Utility::readarray<double, real, false>(*input, &ins[nrec * n],
+                                                      nrec);
+            }
+            catch (const std::exception&) {
+              nbad = n++;
+              break;
+            }
           }
+        } else
+          while (n < nbatch && std::getline(*input, lines[n])) ++n;
+        if (n == 0) break;
+        std::atomic<size_t> next(0);
+        auto worker = [&]() -> void {
+          GeoCoords p;
+          for (size_t k; (k = next++) * chunk < n;) {
+            size_t i0 = k * chunk, i1 = std::min(n, (k + 1) * chunk);
+            for (size_t i = i0; i < i1; ++i) {
+              errs[i] = false;
+              try {
+                if (i == nbad)
+                  throw GeographicErr("Failure reading data");
+                parse(i, p);
+              }
+              catch (const std::exception& e) {
+                error(i, e);
+                lats[i] = lons[i] = Math::NaN();
+              }
+            }
+            try {
+              if (i1 - i0 == 1)
+                // Use the single-cell cache of g for single lines
+                hs[i0] = g(lats[i0], lons[i0]);
+              else
+                g(i1 - i0, &lats[i0], &lons[i0], &hs[i0]);
+              for (size_t i = i0; i < i1; ++i) {
+                if (errs[i]) continue;
+                real& h = hs[i];
+                if (heightmult) h = heights[i] + real(heightmult) * h;
+                if (binaryout)
+                  continue;
+                else if (heightmult && !binaryin)
+                  outs[i] = lines[i] + Utility::str(h, 4) + suffs[i] + eols[i];
+                else
+                  outs[i] = Utility::str(h, 4) + eols[i];
+              }
+            }
+            catch (const std::exception& e) {
+              for (size_t i = i0; i < i1; ++i)
+                if (!errs[i]) error(i, e);
+            }
+          }
+        };
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        try {
+          for (unsigned k = 1; k < threads && k * chunk < n; ++k)
+            pool.push_back(std::thread(worker));
         }
-        catch (const std::exception& e) {
-          *output << "ERROR: " << e.what() << "\n";
-          retval = 1;
+        catch (const std::system_error&) {
+          // Couldn't start all the threads; carry on with the ones we've got.
+        }
+        worker();
+        for (auto& th : pool) th.join();
+        for (size_t i = 0; i < n; ++i)
+          if (errs[i]) retval = 1;
+        if (binaryout)
+          Utility::writearray<double, real, false>(*output, hs.data(), n);
+        else {
+          out.clear();
+          for (size_t i = 0; i < n; ++i)
+            out += outs[i];
+          *output << out;
         }
+        if (server) *output << std::flush;
       }
     }
     catch (const std::exception& e) {
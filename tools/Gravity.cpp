@@ -13,9 +13,15 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <system_error>
 #include <GeographicLib/GravityModel.hpp>
 #include <GeographicLib/GravityCircle.hpp>
 #include <GeographicLib/DMS.hpp>
+#include <GeographicLib/MappedInput.hpp>
 #include <GeographicLib/Utility.hpp>
 
 #if defined(_MSC_VER)
@@ -31,14 +37,16 @@ int main(int argc, const char* const argv[]) {
     using namespace GeographicLib;
     typedef Math::real real;
     Utility::set_digits();
-    bool verbose = false, longfirst = false;
+    bool verbose = false, longfirst = false, binaryin = false,
+      binaryout = false, server = false;
     std::string dir;
     std::string model = GravityModel::DefaultGravityName();
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';';
-    real lat = 0, h = 0;
+    real clat = 0, ch = 0;
     bool circle = false;
     int prec = -1, Nmax = -1, Mmax = -1;
+    unsigned threads = 1;
     enum {
       GRAVITY = 0,
       DISTURBANCE = 1,
@@ -93,12 +101,12 @@ int main(int argc, const char* const argv[]) {
         try {
           using std::abs;
           DMS::flag ind;
-          lat = DMS::Decode(std::string(argv[++m]), ind);
+          clat = DMS::Decode(std::string(argv[++m]), ind);
           if (ind == DMS::LONGITUDE)
             throw GeographicErr("Bad hemisphere letter on latitude");
-          if (!(abs(lat) <= 90))
+          if (!(abs(clat) <= 90))
             throw GeographicErr("Latitude not in [-90d, 90d]");
-          h = Utility::val<real>(std::string(argv[++m]));
+          ch = Utility::val<real>(std::string(argv[++m]));
           circle = true;
         }
         catch (const std::exception& e) {
@@ -119,6 +127,21 @@ int main(int argc, const char* const argv[]) {
         }
       } else if (arg == "-v")
         verbose = true;
+      else if (arg == "-j" || arg == "--threads") {
+        if (++m == argc) return usage(1, true);
+        try {
+          threads = Utility::val<unsigned>(std::string(argv[m]));
+        }
+        catch (const std::exception&) {
+          std::cerr << "Thread count " << argv[m] << " is not a number\n";
+          return 1;
+        }
+      } else if (arg == "--binary-input")
+        binaryin = true;
+      else if (arg == "--binary-output")
+        binaryout = true;
+      else if (arg == "--server")
+        server = true;
       else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
@@ -158,11 +181,17 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (binaryin && !istring.empty()) {
+      std::cerr
+        << "Cannot specify --input-string and --binary-input together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
-    std::ifstream infile;
+    MappedInput infile;
     std::istringstream instring;
     if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+      infile.open(ifile,
+                  binaryin ? std::ios::in | std::ios::binary : std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -183,7 +212,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), binaryout ?
+                   std::ios::out | std::ios::binary : std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -191,6 +221,10 @@ int main(int argc, const char* const argv[]) {
     }
     std::ostream* output = !ofile.empty() ? &outfile : &std::cout;
 
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    // In server mode each line is answered before the next one is read.
+    threads = server ? 1u : std::max(1u, threads);
+
     switch (mode) {
     case GRAVITY:
       prec = std::min(16 + Math::extra_digits(), prec < 0 ? 5 : prec);
@@ -209,9 +243,9 @@ int main(int argc, const char* const argv[]) {
       using std::isfinite;
       const GravityModel g(model, dir, Nmax, Mmax);
       if (circle) {
-        if (!isfinite(h))
+        if (!isfinite(ch))
           throw GeographicErr("Bad height");
-        else if (mode == UNDULATION && h != 0)
+        else if (mode == UNDULATION && ch != 0)
           throw GeographicErr("Height should be zero for geoid undulations");
       }
       if (verbose) {
@@ -224,12 +258,86 @@ int main(int argc, const char* const argv[]) {
                        (mode == DISTURBANCE ? GravityModel::DISTURBANCE :
                         (mode == ANOMALY ? GravityModel::SPHERICAL_ANOMALY :
                          GravityModel::GEOID_HEIGHT))); // mode == UNDULATION
-      const GravityCircle c(circle ? g.Circle(lat, h, mask) : GravityCircle());
-      std::string s, eol, stra, strb;
-      std::istringstream str;
-      while (std::getline(*input, s)) {
+      const GravityCircle c(circle ? g.Circle(clat, ch, mask) :
+                            GravityCircle());
+      // Binary input records are 1 (-c) or 3 little-endian doubles; binary
+      // output records are 3 (1 with -H) doubles.
+      const int nin = circle ? 1 : 3, nout = mode == UNDULATION ? 1 : 3;
+      // Read the input in batches of lines (or records).  The lines of each
+      // batch are decoded and then evaluated, in both cases dividing them
+      // into chunks which are handed out to a pool of threads.  The output
+      // for the batch is written in input order.  In the single-threaded
+      // case, the batch consists of a single line.
+      const size_t chunk = threads > 1 ? 1024 : 1,
+        nbatch = chunk * (threads > 1 ? 8 * size_t(threads) : 1);
+      std::vector<std::string> lines(binaryin ? 0 : nbatch), outs(nbatch),
+        eols(nbatch);
+      std::vector<real> ins(binaryin ? nin * nbatch : 0),
+        lats(nbatch), lons(nbatch), hs(nbatch), ress(nout * nbatch);
+      std::vector<char> errs(nbatch), same(nbatch);
+      std::vector<std::istringstream> strs(threads);
+      // A point with the same lat and h as the preceding point is evaluated
+      // with a GravityCircle; each thread keeps the last circle it
+      // constructed.
+      struct circ {
+        GravityCircle c;
+        real lat, h;
+        circ() : lat(Math::NaN()), h(Math::NaN()) {}
+      };
+      std::vector<circ> circs(threads);
+      real prevlat = Math::NaN(), prevh = Math::NaN();
+      std::string out;
+      // Call f(i0, i1, k) for the chunks [i0, i1) of [0, n); k in [0,
+      // threads) identifies the thread.
+      auto run = [&](size_t n, const std::function<void(size_t, size_t,
+                                                        unsigned)>& f)
+        -> void {
+        std::atomic<size_t> next(0);
+        auto worker = [&](unsigned k) -> void {
+          for (size_t j; (j = next++) * chunk < n;)
+            f(j * chunk, std::min(n, (j + 1) * chunk), k);
+        };
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
         try {
-          eol = "\n";
+          for (unsigned k = 1; k < threads && k * chunk < n; ++k)
+            pool.push_back(std::thread(worker, k));
+        }
+        catch (const std::system_error&) {
+          // Couldn't start all the threads; carry on with the ones we've got.
+        }
+        worker(0);
+        for (auto& th : pool) th.join();
+      };
+      auto error = [&](size_t i, const std::exception& e) -> void {
+        errs[i] = true;
+        // A record of NaNs marks an error in the binary output
+        std::fill(&ress[nout * i], &ress[nout * i] + nout, Math::NaN());
+        outs[i] = "ERROR: " + std::string(e.what()) + "\n";
+      };
+      // Decode the i'th line (or record) of the batch setting lats[i],
+      // lons[i], hs[i], and eols[i]; str is workspace.
+      auto parse = [&](size_t i, std::istringstream& str) -> void {
+        std::string& eol = eols[i];
+        real &lat = lats[i], &lon = lons[i], &h = hs[i];
+        lat = lons[i] = h = Math::NaN();
+        eol = "\n";
+        if (binaryin) {
+          const real* rec = &ins[nin * i];
+          if (circle)
+            lon = rec[0];
+          else {
+            lat = rec[longfirst ? 1 : 0]; lon = rec[longfirst ? 0 : 1];
+            h = rec[2];
+            if (std::abs(lat) > 90)
+              throw GeographicErr("Latitude " + Utility::str(lat)
+                                  + "d not in [-90d, 90d]");
+            if (mode == UNDULATION && h != 0)
+              throw GeographicErr("Height must be zero for geoid heights");
+          }
+        } else {
+          std::string& s = lines[i];
+          std::string stra, strb;
           if (!cdelim.empty()) {
             std::string::size_type m = s.find(cdelim);
             if (m != std::string::npos) {
@@ -238,7 +346,6 @@ int main(int argc, const char* const argv[]) {
             }
           }
           str.clear(); str.str(s);
-          real lon;
           if (circle) {
             if (!(str >> strb))
               throw GeographicErr("Incomplete input: " + s);
@@ -254,67 +361,124 @@ int main(int argc, const char* const argv[]) {
             if (!(str >> h))    // h is optional
               str.clear();
             if (mode == UNDULATION && h != 0)
-                throw GeographicErr("Height must be zero for geoid heights");
+              throw GeographicErr("Height must be zero for geoid heights");
           }
           if (str >> stra)
             throw GeographicErr("Extra junk in input: " + s);
-          switch (mode) {
-          case GRAVITY:
-            {
-              real gx, gy, gz;
-              if (circle) {
-                c.Gravity(lon, gx, gy, gz);
-              } else {
-                g.Gravity(lat, lon, h, gx, gy, gz);
-              }
-              *output << Utility::str(gx, prec) << " "
-                      << Utility::str(gy, prec) << " "
-                      << Utility::str(gz, prec) << eol;
-            }
-            break;
-          case DISTURBANCE:
-            {
-              real deltax, deltay, deltaz;
-              if (circle) {
-                c.Disturbance(lon, deltax, deltay, deltaz);
-              } else {
-                g.Disturbance(lat, lon, h, deltax, deltay, deltaz);
-              }
-              // Convert to mGals
-              *output << Utility::str(deltax * 100000, prec) << " "
-                      << Utility::str(deltay * 100000, prec) << " "
-                      << Utility::str(deltaz * 100000, prec)
-                      << eol;
-            }
-            break;
-          case ANOMALY:
-            {
-              real Dg01, xi, eta;
-              if (circle)
-                c.SphericalAnomaly(lon, Dg01, xi, eta);
-              else
-                g.SphericalAnomaly(lat, lon, h, Dg01, xi, eta);
-              Dg01 *= 100000;   // Convert to mGals
-              xi *= 3600;       // Convert to arcsecs
-              eta *= 3600;
-              *output << Utility::str(Dg01, prec) << " "
-                      << Utility::str(xi, prec) << " "
-                      << Utility::str(eta, prec) << eol;
+        }
+      };
+      // Evaluate the i'th point of the batch using circle cc (or g if cc is
+      // null) and set ress[nout * i] and outs[i].
+      auto eval = [&](size_t i, const GravityCircle* cc) -> void {
+        real lat = lats[i], lon = lons[i], h = hs[i], *rec = &ress[nout * i];
+        switch (mode) {
+        case GRAVITY:
+          if (cc)
+            cc->Gravity(lon, rec[0], rec[1], rec[2]);
+          else
+            g.Gravity(lat, lon, h, rec[0], rec[1], rec[2]);
+          break;
+        case DISTURBANCE:
+          if (cc)
+            cc->Disturbance(lon, rec[0], rec[1], rec[2]);
+          else
+            g.Disturbance(lat, lon, h, rec[0], rec[1], rec[2]);
+          // Convert to mGals
+          for (int j = 0; j < 3; ++j) rec[j] *= 100000;
+          break;
+        case ANOMALY:
+          if (cc)
+            cc->SphericalAnomaly(lon, rec[0], rec[1], rec[2]);
+          else
+            g.SphericalAnomaly(lat, lon, h, rec[0], rec[1], rec[2]);
+          rec[0] *= 100000;   // Convert to mGals
+          rec[1] *= 3600;     // Convert to arcsecs
+          rec[2] *= 3600;
+          break;
+        case UNDULATION:
+        default:
+          rec[0] = cc ? cc->GeoidHeight(lon) : g.GeoidHeight(lat, lon);
+          break;
+        }
+        if (!binaryout) {
+          std::string& os = outs[i];
+          os = Utility::str(rec[0], prec);
+          for (int j = 1; j < nout; ++j)
+            os += " " + Utility::str(rec[j], prec);
+          os += eols[i];
+        }
+      };
+      while (*input) {
+        // An incomplete record at the end of binary input is treated as an
+        // error.
+        size_t n = 0, nbad = nbatch;
+        if (binaryin) {
+          for (; n < nbatch &&
+                 input->peek() != std::char_traits<char>::eof(); ++n) {
+            try {
+              Utility::readarray<double, real, false>(*input, &ins[nin * n],
+                                                      nin);
             }
-            break;
-          case UNDULATION:
-          default:
-            {
-              real N = circle ? c.GeoidHeight(lon) : g.GeoidHeight(lat, lon);
-              *output << Utility::str(N, prec) << eol;
+            catch (const std::exception&) {
+              nbad = n++;
+              break;
             }
-            break;
           }
+        } else
+          while (n < nbatch && std::getline(*input, lines[n])) ++n;
+        if (n == 0) break;
+        run(n, [&](size_t i0, size_t i1, unsigned k) -> void {
+            for (size_t i = i0; i < i1; ++i) {
+              errs[i] = false;
+              try {
+                if (i == nbad)
+                  throw GeographicErr("Failure reading data");
+                parse(i, strs[k]);
+              }
+              catch (const std::exception& e) {
+                error(i, e);
+              }
+            }
+          });
+        for (size_t i = 0; i < n; ++i) {
+          same[i] = !errs[i] && lats[i] == prevlat && hs[i] == prevh;
+          prevlat = errs[i] ? Math::NaN() : lats[i];
+          prevh = hs[i];
         }
-        catch (const std::exception& e) {
-          *output << "ERROR: " << e.what() << "\n";
-          retval = 1;
+        run(n, [&](size_t i0, size_t i1, unsigned k) -> void {
+            circ& wc = circs[k];
+            for (size_t i = i0; i < i1; ++i) {
+              if (errs[i]) continue;
+              try {
+                if (circle)
+                  eval(i, &c);
+                else if (same[i]) {
+                  if (!(wc.lat == lats[i] && wc.h == hs[i])) {
+                    wc.lat = wc.h = Math::NaN();
+                    wc.c = g.Circle(lats[i], hs[i], mask);
+                    wc.lat = lats[i]; wc.h = hs[i];
+                  }
+                  eval(i, &wc.c);
+                } else
+                  eval(i, nullptr);
+              }
+              catch (const std::exception& e) {
+                error(i, e);
+              }
+            }
+          });
+        for (size_t i = 0; i < n; ++i)
+          if (errs[i]) retval = 1;
+        if (binaryout)
+          Utility::writearray<double, real, false>(*output, ress.data(),
+                                                   nout * n);
+        else {
+          out.clear();
+          for (size_t i = 0; i < n; ++i)
+            out += outs[i];
+          *output << out;
         }
+        if (server) *output << std::flush;
       }
     }
     catch (const std::exception& e) {
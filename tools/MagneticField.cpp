@@ -13,9 +13,16 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <system_error>
 #include <GeographicLib/MagneticModel.hpp>
+#include <GeographicLib/MagneticSnapshot.hpp>
 #include <GeographicLib/MagneticCircle.hpp>
 #include <GeographicLib/DMS.hpp>
+#include <GeographicLib/MappedInput.hpp>
 #include <GeographicLib/Utility.hpp>
 
 #if defined(_MSC_VER)
@@ -30,15 +37,17 @@ int main(int argc, const char* const argv[]) {
     using namespace GeographicLib;
     typedef Math::real real;
     Utility::set_digits();
-    bool verbose = false, longfirst = false;
+    bool verbose = false, longfirst = false, binaryin = false,
+      binaryout = false, server = false;
     std::string dir;
     std::string model = MagneticModel::DefaultMagneticName();
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';';
-    real time = 0, lat = 0, h = 0;
+    real time = 0, clat = 0, ch = 0;
     bool timeset = false, circle = false, rate = false;
     real hguard = 500000, tguard = 50;
     int prec = 1, Nmax = -1, Mmax = -1;
+    unsigned threads = 1;
 
     for (int m = 1; m < argc; ++m) {
       std::string arg(argv[m]);
@@ -92,12 +101,12 @@ int main(int argc, const char* const argv[]) {
           using std::abs;
           time = Utility::fractionalyear<real>(std::string(argv[++m]));
           DMS::flag ind;
-          lat = DMS::Decode(std::string(argv[++m]), ind);
+          clat = DMS::Decode(std::string(argv[++m]), ind);
           if (ind == DMS::LONGITUDE)
             throw GeographicErr("Bad hemisphere letter on latitude");
-          if (!(abs(lat) <= 90))
+          if (!(abs(clat) <= 90))
             throw GeographicErr("Latitude not in [-90d, 90d]");
-          h = Utility::val<real>(std::string(argv[++m]));
+          ch = Utility::val<real>(std::string(argv[++m]));
           timeset = false;
           circle = true;
         }
@@ -141,6 +150,21 @@ int main(int argc, const char* const argv[]) {
         }
       } else if (arg == "-v")
         verbose = true;
+      else if (arg == "-j" || arg == "--threads") {
+        if (++m == argc) return usage(1, true);
+        try {
+          threads = Utility::val<unsigned>(std::string(argv[m]));
+        }
+        catch (const std::exception&) {
+          std::cerr << "Thread count " << argv[m] << " is not a number\n";
+          return 1;
+        }
+      } else if (arg == "--binary-input")
+        binaryin = true;
+      else if (arg == "--binary-output")
+        binaryout = true;
+      else if (arg == "--server")
+        server = true;
       else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
@@ -180,11 +204,17 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (binaryin && !istring.empty()) {
+      std::cerr
+        << "Cannot specify --input-string and --binary-input together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
-    std::ifstream infile;
+    MappedInput infile;
     std::istringstream instring;
     if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+      infile.open(ifile,
+                  binaryin ? std::ios::in | std::ios::binary : std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -205,7 +235,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), binaryout ?
+                   std::ios::out | std::ios::binary : std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -216,6 +247,9 @@ int main(int argc, const char* const argv[]) {
     tguard = std::max(real(0), tguard);
     hguard = std::max(real(0), hguard);
     prec = std::min(10 + Math::extra_digits(), std::max(0, prec));
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    // In server mode each line is answered before the next one is read.
+    threads = server ? 1u : std::max(1u, threads);
     int retval = 0;
     try {
       using std::isfinite;
@@ -229,10 +263,10 @@ int main(int argc, const char* const argv[]) {
                             Utility::str(m.MinTime()) + "," +
                             Utility::str(m.MaxTime()) + "]");
       if (circle
-          && (!isfinite(h) ||
-              h < m.MinHeight() - hguard ||
-              h > m.MaxHeight() + hguard))
-        throw GeographicErr("Height " + Utility::str(h/1000) +
+          && (!isfinite(ch) ||
+              ch < m.MinHeight() - hguard ||
+              ch > m.MaxHeight() + hguard))
+        throw GeographicErr("Height " + Utility::str(ch/1000) +
                             "km too far outside allowed range [" +
                             Utility::str(m.MinHeight()/1000) + "km," +
                             Utility::str(m.MaxHeight()/1000) + "km]");
@@ -252,18 +286,135 @@ int main(int argc, const char* const argv[]) {
         std::cerr << "WARNING: Time " << time
                   << " outside allowed range ["
                   << m.MinTime() << "," << m.MaxTime() << "]\n";
-      if (circle && (h < m.MinHeight() || h > m.MaxHeight()))
-        std::cerr << "WARNING: Height " << h/1000
+      if (circle && (ch < m.MinHeight() || ch > m.MaxHeight()))
+        std::cerr << "WARNING: Height " << ch/1000
                   << "km outside allowed range ["
                   << m.MinHeight()/1000 << "km,"
                   << m.MaxHeight()/1000 << "km]\n";
-      const MagneticCircle c(circle ? m.Circle(time, lat, h) :
+      const MagneticCircle c(circle ? m.Circle(time, clat, ch) :
                              MagneticCircle());
-      std::string s, eol, stra, strb;
-      std::istringstream str;
-      while (std::getline(*input, s)) {
+      // With -t, the coefficients for the time are combined once and each
+      // point needs a single spherical harmonic sum (two with -r).
+      const MagneticSnapshot snap(timeset ? m.Snapshot(time) :
+                                  MagneticSnapshot());
+      // Binary input records are [time] lat lon h (or [time] lon with -c)
+      // little-endian doubles, where time is included unless -t or -c is
+      // given; binary output records are 7 (14 with -r) doubles.
+      const bool timein = !(timeset || circle);
+      const int nin = (timein ? 1 : 0) + (circle ? 1 : 3),
+        nout = rate ? 14 : 7;
+      // Check the time and height given with each input.  The warnings are
+      // written with a single operation since several threads may be
+      // writing them.
+      auto checktime = [&](real t) -> void {
+        if (t < m.MinTime() - tguard || t > m.MaxTime() + tguard)
+          throw GeographicErr("Time " + Utility::str(t) +
+                              " too far outside allowed range [" +
+                              Utility::str(m.MinTime()) + "," +
+                              Utility::str(m.MaxTime()) +
+                              "]");
+        if (t < m.MinTime() || t > m.MaxTime()) {
+          std::ostringstream warn;
+          warn << "WARNING: Time " << t
+               << " outside allowed range ["
+               << m.MinTime() << "," << m.MaxTime() << "]\n";
+          std::cerr << warn.str();
+        }
+      };
+      auto checkheight = [&](real hh) -> void {
+        if (hh < m.MinHeight() - hguard || hh > m.MaxHeight() + hguard)
+          throw GeographicErr("Height " + Utility::str(hh/1000) +
+                              "km too far outside allowed range [" +
+                              Utility::str(m.MinHeight()/1000) + "km," +
+                              Utility::str(m.MaxHeight()/1000) + "km]");
+        if (hh < m.MinHeight() || hh > m.MaxHeight()) {
+          std::ostringstream warn;
+          warn << "WARNING: Height " << hh/1000
+               << "km outside allowed range ["
+               << m.MinHeight()/1000 << "km,"
+               << m.MaxHeight()/1000 << "km]\n";
+          std::cerr << warn.str();
+        }
+      };
+      // Read the input in batches of lines (or records).  The lines of each
+      // batch are decoded and then evaluated, in both cases dividing them
+      // into chunks which are handed out to a pool of threads.  The output
+      // for the batch is written in input order.  In the single-threaded
+      // case, the batch consists of a single line.
+      const size_t chunk = threads > 1 ? 1024 : 1,
+        nbatch = chunk * (threads > 1 ? 8 * size_t(threads) : 1);
+      std::vector<std::string> lines(binaryin ? 0 : nbatch), outs(nbatch),
+        eols(nbatch);
+      std::vector<real> ins(binaryin ? nin * nbatch : 0),
+        ts(nbatch), lats(nbatch), lons(nbatch), hs(nbatch),
+        ress(nout * nbatch);
+      std::vector<char> errs(nbatch), same(nbatch);
+      std::vector<std::istringstream> strs(threads);
+      // A point with the same time, lat, and h as the preceding point is
+      // evaluated with a MagneticCircle; each thread keeps the last circle it
+      // constructed.
+      struct circ {
+        MagneticCircle c;
+        real t, lat, h;
+        circ() : t(Math::NaN()), lat(Math::NaN()), h(Math::NaN()) {}
+      };
+      std::vector<circ> circs(threads);
+      real prevt = Math::NaN(), prevlat = Math::NaN(), prevh = Math::NaN();
+      std::string out;
+      // Call f(i0, i1, k) for the chunks [i0, i1) of [0, n); k in [0,
+      // threads) identifies the thread.
+      auto run = [&](size_t n, const std::function<void(size_t, size_t,
+                                                        unsigned)>& f)
+        -> void {
+        std::atomic<size_t> next(0);
+        auto worker = [&](unsigned k) -> void {
+          for (size_t j; (j = next++) * chunk < n;)
+            f(j * chunk, std::min(n, (j + 1) * chunk), k);
+        };
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
         try {
-          eol = "\n";
+          for (unsigned k = 1; k < threads && k * chunk < n; ++k)
+            pool.push_back(std::thread(worker, k));
+        }
+        catch (const std::system_error&) {
+          // Couldn't start all the threads; carry on with the ones we've got.
+        }
+        worker(0);
+        for (auto& th : pool) th.join();
+      };
+      auto error = [&](size_t i, const std::exception& e) -> void {
+        errs[i] = true;
+        // A record of NaNs marks an error in the binary output
+        std::fill(&ress[nout * i], &ress[nout * i] + nout, Math::NaN());
+        outs[i] = "ERROR: " + std::string(e.what()) + "\n";
+      };
+      // Decode the i'th line (or record) of the batch setting ts[i],
+      // lats[i], lons[i], hs[i], and eols[i]; str is workspace.
+      auto parse = [&](size_t i, std::istringstream& str) -> void {
+        std::string& eol = eols[i];
+        real &t = ts[i], &lat = lats[i], &lon = lons[i], &h = hs[i];
+        t = time; lat = clat; lon = Math::NaN(); h = ch;
+        eol = "\n";
+        if (binaryin) {
+          const real* r = &ins[nin * i];
+          if (timein) {
+            t = *r++;
+            checktime(t);
+          }
+          if (circle)
+            lon = *r++;
+          else {
+            lat = r[longfirst ? 1 : 0]; lon = r[longfirst ? 0 : 1];
+            if (std::abs(lat) > 90)
+              throw GeographicErr("Latitude " + Utility::str(lat)
+                                  + "d not in [-90d, 90d]");
+            h = r[2];
+            checkheight(h);
+          }
+        } else {
+          std::string& s = lines[i];
+          std::string stra, strb;
           if (!cdelim.empty()) {
             std::string::size_type n = s.find(cdelim);
             if (n != std::string::npos) {
@@ -272,22 +423,12 @@ int main(int argc, const char* const argv[]) {
             }
           }
           str.clear(); str.str(s);
-          if (!(timeset || circle)) {
+          if (timein) {
             if (!(str >> stra))
               throw GeographicErr("Incomplete input: " + s);
-            time = Utility::fractionalyear<real>(stra);
-            if (time < m.MinTime() - tguard || time > m.MaxTime() + tguard)
-              throw GeographicErr("Time " + Utility::str(time) +
-                                  " too far outside allowed range [" +
-                                  Utility::str(m.MinTime()) + "," +
-                                  Utility::str(m.MaxTime()) +
-                                  "]");
-            if (time < m.MinTime() || time > m.MaxTime())
-              std::cerr << "WARNING: Time " << time
-                        << " outside allowed range ["
-                        << m.MinTime() << "," << m.MaxTime() << "]\n";
+            t = Utility::fractionalyear<real>(stra);
+            checktime(t);
           }
-          real lon;
           if (circle) {
             if (!(str >> strb))
               throw GeographicErr("Incomplete input: " + s);
@@ -300,52 +441,129 @@ int main(int argc, const char* const argv[]) {
               throw GeographicErr("Incomplete input: " + s);
             DMS::DecodeLatLon(stra, strb, lat, lon, longfirst);
             h = 0;              // h is optional
-            if (str >> h) {
-              if (h < m.MinHeight() - hguard || h > m.MaxHeight() + hguard)
-                throw GeographicErr("Height " + Utility::str(h/1000) +
-                                    "km too far outside allowed range [" +
-                                    Utility::str(m.MinHeight()/1000) + "km," +
-                                    Utility::str(m.MaxHeight()/1000) + "km]");
-              if (h < m.MinHeight() || h > m.MaxHeight())
-                std::cerr << "WARNING: Height " << h/1000
-                          << "km outside allowed range ["
-                          << m.MinHeight()/1000 << "km,"
-                          << m.MaxHeight()/1000 << "km]\n";
-            }
+            if (str >> h)
+              checkheight(h);
             else
               str.clear();
           }
           if (str >> stra)
             throw GeographicErr("Extra junk in input: " + s);
-          real bx, by, bz, bxt, byt, bzt;
-          if (circle)
-            c(lon, bx, by, bz, bxt, byt, bzt);
-          else
-            m(time, lat, lon, h, bx, by, bz, bxt, byt, bzt);
-          real H, F, D, I, Ht, Ft, Dt, It;
-          MagneticModel::FieldComponents(bx, by, bz, bxt, byt, bzt,
-                                         H, F, D, I, Ht, Ft, Dt, It);
-
-          *output << DMS::Encode(D, prec + 1, DMS::NUMBER) << " "
-                  << DMS::Encode(I, prec + 1, DMS::NUMBER) << " "
-                  << Utility::str(H, prec) << " "
-                  << Utility::str(by, prec) << " "
-                  << Utility::str(bx, prec) << " "
-                  << Utility::str(-bz, prec) << " "
-                  << Utility::str(F, prec) << eol;
+        }
+      };
+      // Evaluate the i'th point of the batch using circle cc (or m if cc is
+      // null) and set ress[nout * i] and outs[i].
+      auto eval = [&](size_t i, const MagneticCircle* cc) -> void {
+        real bx, by, bz, bxt, byt, bzt;
+        if (cc)
+          (*cc)(lons[i], bx, by, bz, bxt, byt, bzt);
+        else if (timeset) {
           if (rate)
-            *output << DMS::Encode(Dt, prec + 1, DMS::NUMBER) << " "
-                    << DMS::Encode(It, prec + 1, DMS::NUMBER) << " "
-                    << Utility::str(Ht, prec) << " "
-                    << Utility::str(byt, prec) << " "
-                    << Utility::str(bxt, prec) << " "
-                    << Utility::str(-bzt, prec) << " "
-                    << Utility::str(Ft, prec) << eol;
+            snap(lats[i], lons[i], hs[i], bx, by, bz, bxt, byt, bzt);
+          else {
+            snap(lats[i], lons[i], hs[i], bx, by, bz);
+            bxt = byt = bzt = 0;
+          }
+        } else
+          m(ts[i], lats[i], lons[i], hs[i], bx, by, bz, bxt, byt, bzt);
+        real H, F, D, I, Ht, Ft, Dt, It;
+        MagneticModel::FieldComponents(bx, by, bz, bxt, byt, bzt,
+                                       H, F, D, I, Ht, Ft, Dt, It);
+        if (binaryout) {
+          real res[14] = { D, I, H, by, bx, -bz, F,
+                           Dt, It, Ht, byt, bxt, -bzt, Ft };
+          std::copy(res, res + nout, &ress[nout * i]);
+          return;
         }
-        catch (const std::exception& e) {
-          *output << "ERROR: " << e.what() << "\n";
-          retval = 1;
+        std::string& os = outs[i];
+        os = DMS::Encode(D, prec + 1, DMS::NUMBER) + " "
+          + DMS::Encode(I, prec + 1, DMS::NUMBER) + " "
+          + Utility::str(H, prec) + " "
+          + Utility::str(by, prec) + " "
+          + Utility::str(bx, prec) + " "
+          + Utility::str(-bz, prec) + " "
+          + Utility::str(F, prec) + eols[i];
+        if (rate)
+          os += DMS::Encode(Dt, prec + 1, DMS::NUMBER) + " "
+            + DMS::Encode(It, prec + 1, DMS::NUMBER) + " "
+            + Utility::str(Ht, prec) + " "
+            + Utility::str(byt, prec) + " "
+            + Utility::str(bxt, prec) + " "
+            + Utility::str(-bzt, prec) + " "
+            + Utility::str(Ft, prec) + eols[i];
+      };
+      while (*input) {
+        // An incomplete record at the end of binary input is treated as an
+        // error.
+        size_t n = 0, nbad = nbatch;
+        if (binaryin) {
+          for (; n < nbatch &&
+                 input->peek() != std::char_traits<char>::eof(); ++n) {
+            try {
+              Utility::readarray<double, real, false>(*input, &ins[nin * n],
+                                                      nin);
+            }
+            catch (const std::exception&) {
+              nbad = n++;
+              break;
+            }
+          }
+        } else
+          while (n < nbatch && std::getline(*input, lines[n])) ++n;
+        if (n == 0) break;
+        run(n, [&](size_t i0, size_t i1, unsigned k) -> void {
+            for (size_t i = i0; i < i1; ++i) {
+              errs[i] = false;
+              try {
+                if (i == nbad)
+                  throw GeographicErr("Failure reading data");
+                parse(i, strs[k]);
+              }
+              catch (const std::exception& e) {
+                error(i, e);
+              }
+            }
+          });
+        for (size_t i = 0; i < n; ++i) {
+          same[i] = !errs[i] &&
+            ts[i] == prevt && lats[i] == prevlat && hs[i] == prevh;
+          prevt = errs[i] ? Math::NaN() : ts[i];
+          prevlat = lats[i]; prevh = hs[i];
+        }
+        run(n, [&](size_t i0, size_t i1, unsigned k) -> void {
+            circ& wc = circs[k];
+            for (size_t i = i0; i < i1; ++i) {
+              if (errs[i]) continue;
+              try {
+                if (circle)
+                  eval(i, &c);
+                else if (same[i]) {
+                  if (!(wc.t == ts[i] && wc.lat == lats[i] &&
+                        wc.h == hs[i])) {
+                    wc.t = Math::NaN();
+                    wc.c = m.Circle(ts[i], lats[i], hs[i]);
+                    wc.t = ts[i]; wc.lat = lats[i]; wc.h = hs[i];
+                  }
+                  eval(i, &wc.c);
+                } else
+                  eval(i, nullptr);
+              }
+              catch (const std::exception& e) {
+                error(i, e);
+              }
+            }
+          });
+        for (size_t i = 0; i < n; ++i)
+          if (errs[i]) retval = 1;
+        if (binaryout)
+          Utility::writearray<double, real, false>(*output, ress.data(),
+                                                   nout * n);
+        else {
+          out.clear();
+          for (size_t i = 0; i < n; ++i)
+            out += outs[i];
+          *output << out;
         }
+        if (server) *output << std::flush;
       }
     }
     catch (const std::exception& e) {
@@ -28,11 +28,11 @@ LIBPATH = ../src
 GEOGRAPHICLIB_DATA = $(PREFIX)/share/GeographicLib
 
 CC = g++ -g
-CXXFLAGS = -g -Wall -Wextra -O3 -std=c++0x
+CXXFLAGS = -g -Wall -Wextra -O3 -std=c++0x -pthread
 
 CPPFLAGS = -I$(INCLUDEPATH) -I../man $(DEFINES)
 LDLIBS = -L$(LIBPATH) -l$(LIBSTEM)
-EXTRALIBS =
+EXTRALIBS = -pthread
 
 $(PROGRAMS): $(LIBPATH)/$(LIBRARY)
 	$(CC) $(LDFLAGS) -o $@ $@.o $(LDLIBS) $(EXTRALIBS)
@@ -54,36 +54,37 @@ Planimeter: Planimeter.o
 RhumbSolve: RhumbSolve.o
 TransverseMercatorProj: TransverseMercatorProj.o
 
-CartConvert.o: CartConvert.usage Config.h Constants.hpp DMS.hpp \
-	Geocentric.hpp LocalCartesian.hpp Math.hpp Utility.hpp
+CartConvert.o: CartConvert.usage Config.h Constants.hpp DMS.hpp Geocentric.hpp \
+	LocalCartesian.hpp MappedInput.hpp Math.hpp Pipeline.hpp Utility.hpp
 ConicProj.o: ConicProj.usage Config.h AlbersEqualArea.hpp Constants.hpp \
-	DMS.hpp LambertConformalConic.hpp Math.hpp Utility.hpp
+	DMS.hpp LambertConformalConic.hpp MappedInput.hpp Math.hpp \
+	TextColumns.hpp Utility.hpp
 GeoConvert.o: GeoConvert.usage Config.h Constants.hpp DMS.hpp GeoCoords.hpp \
-	Math.hpp UTMUPS.hpp Utility.hpp
+	MappedInput.hpp Math.hpp UTMUPS.hpp Utility.hpp
 GeodSolve.o: GeodSolve.usage Config.h Constants.hpp DMS.hpp Geodesic.hpp \
-	GeodesicExact.hpp GeodesicLine.hpp GeodesicLineExact.hpp Math.hpp \
-	Utility.hpp
+	GeodesicExact.hpp GeodesicLine.hpp GeodesicLineExact.hpp \
+	MappedInput.hpp Math.hpp Utility.hpp
 GeodesicProj.o: GeodesicProj.usage Config.h AzimuthalEquidistant.hpp \
-	CassiniSoldner.hpp Constants.hpp DMS.hpp Geodesic.hpp \
-	GeodesicLine.hpp Gnomonic.hpp Math.hpp Utility.hpp
+	CassiniSoldner.hpp Constants.hpp DMS.hpp Geodesic.hpp GeodesicLine.hpp \
+	Gnomonic.hpp MappedInput.hpp Math.hpp TextColumns.hpp Utility.hpp
 GeoidEval.o: GeoidEval.usage Config.h Constants.hpp DMS.hpp GeoCoords.hpp \
-	Geoid.hpp Math.hpp UTMUPS.hpp Utility.hpp
+	Geoid.hpp MappedInput.hpp Math.hpp UTMUPS.hpp Utility.hpp
 Gravity.o: Gravity.usage Config.h CircularEngine.hpp Constants.hpp DMS.hpp \
-	Geocentric.hpp GravityCircle.hpp GravityModel.hpp Math.hpp \
-	NormalGravity.hpp SphericalEngine.hpp SphericalHarmonic.hpp \
+	Geocentric.hpp GravityCircle.hpp GravityModel.hpp MappedInput.hpp \
+	Math.hpp NormalGravity.hpp SphericalEngine.hpp SphericalHarmonic.hpp \
 	SphericalHarmonic1.hpp Utility.hpp
-MagneticField.o: MagneticField.usage Config.h CircularEngine.hpp \
-	Constants.hpp DMS.hpp Geocentric.hpp MagneticCircle.hpp \
-	MagneticModel.hpp Math.hpp SphericalEngine.hpp SphericalHarmonic.hpp \
-	Utility.hpp
+MagneticField.o: MagneticField.usage Config.h CircularEngine.hpp Constants.hpp \
+	DMS.hpp Geocentric.hpp MagneticCircle.hpp MagneticModel.hpp \
+	MagneticSnapshot.hpp MappedInput.hpp Math.hpp SphericalEngine.hpp \
+	SphericalHarmonic.hpp Utility.hpp
 Planimeter.o: Planimeter.usage Config.h Accumulator.hpp Constants.hpp DMS.hpp \
-	Ellipsoid.hpp GeoCoords.hpp Geodesic.hpp Math.hpp PolygonArea.hpp \
-	UTMUPS.hpp Utility.hpp
+	Ellipsoid.hpp GeoCoords.hpp Geodesic.hpp MappedInput.hpp Math.hpp \
+	PolygonArea.hpp UTMUPS.hpp Utility.hpp
 RhumbSolve.o: RhumbSolve.usage Config.h Constants.hpp DMS.hpp Ellipsoid.hpp \
-	Math.hpp Utility.hpp
+	MappedInput.hpp Math.hpp Utility.hpp
 TransverseMercatorProj.o: TransverseMercatorProj.usage Config.h Constants.hpp \
-	DMS.hpp EllipticFunction.hpp Math.hpp TransverseMercator.hpp \
-	TransverseMercatorExact.hpp Utility.hpp
+	DMS.hpp EllipticFunction.hpp MappedInput.hpp Math.hpp TextColumns.hpp \
+	TransverseMercator.hpp TransverseMercatorExact.hpp Utility.hpp
 
 %: %.sh
 	sed -e "s%@GEOGRAPHICLIB_DATA@%$(GEOGRAPHICLIB_DATA)%" $< > $@
@@ -13,8 +13,11 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
 #include <GeographicLib/PolygonArea.hpp>
+#include <GeographicLib/PolygonAreaBatch.hpp>
 #include <GeographicLib/DMS.hpp>
+#include <GeographicLib/MappedInput.hpp>
 #include <GeographicLib/Utility.hpp>
 #include <GeographicLib/GeoCoords.hpp>
 #include <GeographicLib/Ellipsoid.hpp>
@@ -26,17 +29,82 @@
 
 #include "Planimeter.usage"
 
+using namespace GeographicLib;
+typedef Math::real real;
+
+// Process binary input consisting of pairs of little-endian doubles.  A pair
+// which isn't a valid position ends a polygon.  The complete polygons are
+// accumulated in batches which are handed to PolygonAreaBatchT; the results
+// are printed in input order.
+template<class GeodType>
+void BinaryPolygons(const GeodType& earth, const Ellipsoid& ellip,
+                    bool authalic, bool polyline, bool reverse, bool sign,
+                    bool longfirst, unsigned threads, int prec,
+                    std::istream& input, std::ostream& output) {
+  using std::isnan; using std::abs;
+  // Read this many vertices at a time and process the polygons when this
+  // many vertices have been accumulated.
+  const size_t chunk = 1 << 16, batch = 1 << 20;
+  const PolygonAreaBatchT<GeodType> polyb(earth, polyline, threads);
+  std::vector<double> buf(2 * chunk);
+  std::vector<size_t> offsets(1, 0);
+  std::vector<real> lat, lon, perimeter, area;
+  std::vector<unsigned> num;
+  std::string out;
+  auto flush = [&]() -> void {
+    size_t n = offsets.size() - 1;
+    if (n == 0) return;
+    perimeter.resize(n); area.resize(n); num.resize(n);
+    polyb.Compute(n, offsets.data(), lat.data(), lon.data(), reverse, sign,
+                  perimeter.data(), area.data(), num.data());
+    out.clear();
+    for (size_t i = 0; i < n; ++i) {
+      out += Utility::str(num[i]) + " " + Utility::str(perimeter[i], prec);
+      if (!polyline)
+        out += " " + Utility::str(area[i], std::max(0, prec - 5));
+      out += "\n";
+    }
+    output << out;
+    offsets.resize(1); lat.clear(); lon.clear();
+  };
+  while (input) {
+    input.read(reinterpret_cast<char*>(buf.data()),
+               buf.size() * sizeof(double));
+    size_t nbytes = size_t(input.gcount());
+    if (nbytes % (2 * sizeof(double)))
+      throw GeographicErr("Incomplete vertex at end of binary input");
+    for (size_t i = 0; i < nbytes / sizeof(double); i += 2) {
+      real
+        x = real(Math::bigendian ? Math::swab<double>(buf[i]) : buf[i]),
+        y = real(Math::bigendian ? Math::swab<double>(buf[i+1]) : buf[i+1]);
+      if (longfirst) std::swap(x, y);
+      if (isnan(y) || !(abs(x) <= 90)) {
+        // End the current polygon (if it has any vertices)
+        if (lat.size() > offsets.back()) {
+          offsets.push_back(lat.size());
+          if (lat.size() >= batch) flush();
+        }
+      } else {
+        lat.push_back(authalic ? ellip.AuthalicLatitude(x) : x);
+        lon.push_back(y);
+      }
+    }
+  }
+  if (lat.size() > offsets.back()) offsets.push_back(lat.size());
+  flush();
+}
+
 int main(int argc, const char* const argv[]) {
   try {
-    using namespace GeographicLib;
-    typedef Math::real real;
     Utility::set_digits();
     enum { GEODESIC, EXACT, AUTHALIC, RHUMB };
     real
       a = Constants::WGS84_a(),
       f = Constants::WGS84_f();
-    bool reverse = false, sign = true, polyline = false, longfirst = false;
+    bool reverse = false, sign = true, polyline = false, longfirst = false,
+      binary = false, server = false;
     int linetype = GEODESIC;
+    unsigned threads = 0;
     int prec = 6;
     std::string istring, ifile, ofile, cdelim;
     char lsep = ';';
@@ -79,6 +147,19 @@ int main(int argc, const char* const argv[]) {
         linetype = AUTHALIC;
       else if (arg == "-R")
         linetype = RHUMB;
+      else if (arg == "--binary")
+        binary = true;
+      else if (arg == "--threads") {
+        if (++m == argc) return usage(1, true);
+        try {
+          threads = Utility::val<unsigned>(std::string(argv[m]));
+        }
+        catch (const std::exception&) {
+          std::cerr << "Thread count " << argv[m] << " is not a number\n";
+          return 1;
+        }
+      } else if (arg == "--server")
+        server = true;
       else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
@@ -110,11 +191,20 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (binary && !istring.empty()) {
+      std::cerr << "Cannot specify --input-string and --binary together\n";
+      return 1;
+    }
+    if (binary && server) {
+      std::cerr << "Cannot specify --server and --binary together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
-    std::ifstream infile;
+    MappedInput infile;
     std::istringstream instring;
     if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+      infile.open(ifile,
+                  binary ? std::ios::in | std::ios::binary : std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -152,14 +242,27 @@ int main(int argc, const char* const argv[]) {
     const Geodesic geod(a, f);
     const GeodesicExact geode(a, f);
     const Rhumb rhumb(a, f);
+    // Max precision = 10: 0.1 nm in distance, 10^-15 deg (= 0.11 nm),
+    // 10^-11 sec (= 0.3 nm).
+    prec = std::min(10 + Math::extra_digits(), std::max(0, prec));
+    if (binary) {
+      if (linetype == EXACT)
+        BinaryPolygons(geode, ellip, false, polyline, reverse, sign,
+                       longfirst, threads, prec, *input, *output);
+      else if (linetype == RHUMB)
+        BinaryPolygons(rhumb, ellip, false, polyline, reverse, sign,
+                       longfirst, threads, prec, *input, *output);
+      else
+        BinaryPolygons(geod, ellip, linetype == AUTHALIC, polyline,
+                       reverse, sign, longfirst, threads, prec,
+                       *input, *output);
+      return 0;
+    }
     PolygonArea poly(geod, polyline);
     PolygonAreaExact polye(geode, polyline);
     PolygonAreaRhumb polyr(rhumb, polyline);
     GeoCoords p;
 
-    // Max precision = 10: 0.1 nm in distance, 10^-15 deg (= 0.11 nm),
-    // 10^-11 sec (= 0.3 nm).
-    prec = std::min(10 + Math::extra_digits(), std::max(0, prec));
     std::string s, eol("\n");
     real perimeter, area;
     unsigned num;
@@ -194,6 +297,7 @@ int main(int argc, const char* const argv[]) {
             *output << " " << Utility::str(area, std::max(0, prec - 5));
           }
           *output << eol;
+          if (server) *output << std::flush;
         }
         linetype == EXACT ? polye.Clear() :
           linetype == RHUMB ? polyr.Clear() : poly.Clear();
@@ -17,6 +17,7 @@
 #include <limits>
 #include <GeographicLib/Rhumb.hpp>
 #include <GeographicLib/DMS.hpp>
+#include <GeographicLib/MappedInput.hpp>
 #include <GeographicLib/Utility.hpp>
 
 #if defined(_MSC_VER)
@@ -51,7 +52,8 @@ int main(int argc, const char* const argv[]) {
   try {
     Utility::set_digits();
     bool linecalc = false, inverse = false, dms = false, exact = true,
-      longfirst = false;
+      longfirst = false, binaryin = false, binaryout = false,
+      server = false;
     real
       a = Constants::WGS84_a(),
       f = Constants::WGS84_f();
@@ -110,6 +112,12 @@ int main(int argc, const char* const argv[]) {
         }
       } else if (arg == "-s")
         exact = false;
+      else if (arg == "--binary-input")
+        binaryin = true;
+      else if (arg == "--binary-output")
+        binaryout = true;
+      else if (arg == "--server")
+        server = true;
       else if (arg == "--input-string") {
         if (++m == argc) return usage(1, true);
         istring = argv[m];
@@ -141,11 +149,17 @@ int main(int argc, const char* const argv[]) {
       std::cerr << "Cannot specify --input-string and --input-file together\n";
       return 1;
     }
+    if (binaryin && !istring.empty()) {
+      std::cerr
+        << "Cannot specify --input-string and --binary-input together\n";
+      return 1;
+    }
     if (ifile == "-") ifile.clear();
-    std::ifstream infile;
+    MappedInput infile;
     std::istringstream instring;
     if (!ifile.empty()) {
-      infile.open(ifile.c_str());
+      infile.open(ifile,
+                  binaryin ? std::ios::in | std::ios::binary : std::ios::in);
       if (!infile.is_open()) {
         std::cerr << "Cannot open " << ifile << " for reading\n";
         return 1;
@@ -166,7 +180,8 @@ int main(int argc, const char* const argv[]) {
     std::ofstream outfile;
     if (ofile == "-") ofile.clear();
     if (!ofile.empty()) {
-      outfile.open(ofile.c_str());
+      outfile.open(ofile.c_str(), binaryout ?
+                   std::ios::out | std::ios::binary : std::ios::out);
       if (!outfile.is_open()) {
         std::cerr << "Cannot open " << ofile << " for writing\n";
         return 1;
@@ -183,53 +198,95 @@ int main(int argc, const char* const argv[]) {
     std::string s, eol, slat1, slon1, slat2, slon2, sazi, ss12, strc;
     std::istringstream str;
     int retval = 0;
-    while (std::getline(*input, s)) {
+    // Binary input records are 1 (-L) or 4 little-endian doubles in the
+    // order of the text input; binary output records are 3 doubles in the
+    // order of the text output.
+    const int nin = linecalc ? 1 : 4;
+    real rec[4];
+    while (binaryin ? input->peek() != std::char_traits<char>::eof() :
+           bool(std::getline(*input, s))) {
       try {
         eol = "\n";
-        if (!cdelim.empty()) {
-          std::string::size_type m = s.find(cdelim);
-          if (m != std::string::npos) {
-            eol = " " + s.substr(m) + "\n";
-            s = s.substr(0, m);
+        if (binaryin) {
+          Utility::readarray<double, real, false>(*input, rec, nin);
+          if (linecalc)
+            s12 = rec[0];
+          else {
+            lat1 = rec[longfirst ? 1 : 0]; lon1 = rec[longfirst ? 0 : 1];
+            if (inverse) {
+              lat2 = rec[longfirst ? 3 : 2]; lon2 = rec[longfirst ? 2 : 3];
+            } else {
+              azi12 = rec[2]; s12 = rec[3];
+              lat2 = 0;
+            }
+            if (std::abs(lat1) > 90 || std::abs(lat2) > 90)
+              throw GeographicErr("Latitude " +
+                                  Utility::str(std::abs(lat1) > 90 ?
+                                               lat1 : lat2)
+                                  + "d not in [-90d, 90d]");
+          }
+        } else {
+          if (!cdelim.empty()) {
+            std::string::size_type m = s.find(cdelim);
+            if (m != std::string::npos) {
+              eol = " " + s.substr(m) + "\n";
+              s = s.substr(0, m);
+            }
+          }
+          str.clear(); str.str(s);
+          if (linecalc) {
+            if (!(str >> s12))
+              throw GeographicErr("Incomplete input: " + s);
+          } else if (inverse) {
+            if (!(str >> slat1 >> slon1 >> slat2 >> slon2))
+              throw GeographicErr("Incomplete input: " + s);
+          } else {
+            if (!(str >> slat1 >> slon1 >> sazi >> s12))
+              throw GeographicErr("Incomplete input: " + s);
           }
-        }
-        str.clear(); str.str(s);
-        if (linecalc) {
-          if (!(str >> s12))
-            throw GeographicErr("Incomplete input: " + s);
           if (str >> strc)
             throw GeographicErr("Extraneous input: " + strc);
+          if (!linecalc) {
+            DMS::DecodeLatLon(slat1, slon1, lat1, lon1, longfirst);
+            if (inverse)
+              DMS::DecodeLatLon(slat2, slon2, lat2, lon2, longfirst);
+            else
+              azi12 = DMS::DecodeAzimuth(sazi);
+          }
+        }
+        if (linecalc)
           rhl.Position(s12, lat2, lon2, S12);
-          *output << LatLonString(lat2, lon2, prec, dms, dmssep, longfirst)
-                  << " " << Utility::str(S12, std::max(prec-7, 0)) << eol;
-        } else if (inverse) {
-          if (!(str >> slat1 >> slon1 >> slat2 >> slon2))
-            throw GeographicErr("Incomplete input: " + s);
-          if (str >> strc)
-            throw GeographicErr("Extraneous input: " + strc);
-          DMS::DecodeLatLon(slat1, slon1, lat1, lon1, longfirst);
-          DMS::DecodeLatLon(slat2, slon2, lat2, lon2, longfirst);
+        else if (inverse)
           rh.Inverse(lat1, lon1, lat2, lon2, s12, azi12, S12);
+        else                    // direct
+          rh.Direct(lat1, lon1, azi12, s12, lat2, lon2, S12);
+        if (binaryout) {
+          if (inverse) {
+            rec[0] = azi12; rec[1] = s12;
+          } else {
+            rec[0] = longfirst ? lon2 : lat2; rec[1] = longfirst ? lat2 : lon2;
+          }
+          rec[2] = S12;
+          Utility::writearray<double, real, false>(*output, rec, 3);
+        } else if (inverse)
           *output << AzimuthString(azi12, prec, dms, dmssep) << " "
                   << Utility::str(s12, prec) << " "
                   << Utility::str(S12, std::max(prec-7, 0)) << eol;
-        } else {                // direct
-          if (!(str >> slat1 >> slon1 >> sazi >> s12))
-            throw GeographicErr("Incomplete input: " + s);
-          if (str >> strc)
-            throw GeographicErr("Extraneous input: " + strc);
-          DMS::DecodeLatLon(slat1, slon1, lat1, lon1, longfirst);
-          azi12 = DMS::DecodeAzimuth(sazi);
-          rh.Direct(lat1, lon1, azi12, s12, lat2, lon2, S12);
+        else
           *output << LatLonString(lat2, lon2, prec, dms, dmssep, longfirst)
                   << " " << Utility::str(S12, std::max(prec-7, 0)) << eol;
-        }
       }
       catch (const std::exception& e) {
-        // Write error message cout so output lines match input lines
-        *output << "ERROR: " << e.what() << "\n";
+        if (binaryout) {
+          // A record of NaNs marks an error
+          rec[0] = rec[1] = rec[2] = Math::NaN();
+          Utility::writearray<double, real, false>(*output, rec, 3);
+        } else
+          // Write error message cout so output lines match input lines
+          *output << "ERROR: " << e.what() << "\n";
         retval = 1;
       }
+      if (server) *output << std::flush;
     }
     return retval;
   }
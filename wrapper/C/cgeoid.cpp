@@ -1,14 +1,106 @@
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
 #include "cgeoid.h"
 #include "GeographicLib/Geoid.hpp"
 
+using GeographicLib::Geoid;
+using GeographicLib::Math;
+
+struct cgeoid {
+  std::unique_ptr<const Geoid> geoid;
+};
+
+namespace {
+
+  void seterr(char* errmsg, size_t errlen, const char* msg) {
+    if (errmsg && errlen) {
+      std::strncpy(errmsg, msg, errlen - 1);
+      errmsg[errlen - 1] = '\0';
+    }
+  }
+
+}
+
 extern "C"
 double HeightAboveEllipsoid(double lat, double lon, double h) {
   try {
     // Declare static so that g is only constructed once
-    static const GeographicLib::Geoid g("egm2008-1");
-    return h + GeographicLib::Geoid::GEOIDTOELLIPSOID * g(lat, lon);
+    static const Geoid g("egm2008-1");
+    return h + Geoid::GEOIDTOELLIPSOID * g(lat, lon);
+  }
+  catch (...) {
+    return Math::NaN();
+  }
+}
+
+extern "C"
+cgeoid* geoid_open(const char* name, const char* path, int mode,
+                   char* errmsg, size_t errlen) {
+  seterr(errmsg, errlen, "");
+  if (!name) {
+    seterr(errmsg, errlen, "No geoid name given");
+    return nullptr;
+  }
+  if (!(mode >= CGEOID_DEFAULT && mode <= CGEOID_TILED)) {
+    seterr(errmsg, errlen, "Illegal geoid mode");
+    return nullptr;
+  }
+  try {
+    std::unique_ptr<cgeoid> g(new cgeoid);
+    std::string dir(path ? path : "");
+    if (mode != CGEOID_DEFAULT)
+      g->geoid.reset(new Geoid(name, dir, true, false,
+                               Geoid::datamode(mode)));
+    else {
+      // Share the data in the page cache if the file can be mapped;
+      // otherwise read it into memory.  Both give a thread safe object.
+      try {
+        g->geoid.reset(new Geoid(name, dir, true, false, Geoid::MEMORYMAP));
+      }
+      catch (const std::exception&) {
+        g->geoid.reset(new Geoid(name, dir, true, true));
+      }
+    }
+    return g.release();
+  }
+  catch (const std::exception& e) {
+    seterr(errmsg, errlen, e.what());
+    return nullptr;
+  }
+  catch (...) {
+    seterr(errmsg, errlen, "Unknown error opening geoid");
+    return nullptr;
+  }
+}
+
+extern "C"
+void geoid_close(cgeoid* g) {
+  delete g;
+}
+
+extern "C"
+double geoid_height(const cgeoid* g, double lat, double lon) {
+  try {
+    return g ? (*g->geoid)(lat, lon) : Math::NaN();
   }
   catch (...) {
-    return GeographicLib::Math::NaN();
+    return Math::NaN();
+  }
+}
+
+extern "C"
+int geoid_heights(const cgeoid* g, size_t n,
+                  const double lat[], const double lon[], double h[]) {
+  try {
+    if (g) {
+      (*g->geoid)(n, lat, lon, h);
+      return 0;
+    }
   }
+  catch (...) {}
+  std::fill(h, h + n, Math::NaN());
+  return -1;
 }
@@ -1,9 +1,56 @@
 #if !defined(CGEOID_H)
 #define CGEOID_H 1
 
+#include <stddef.h>
+
 #if defined(__cplusplus)
-extern "C"
+extern "C" {
 #endif
+
+/* Convert a height above the geoid (egm2008-1) to a height above the
+ * ellipsoid.  Returns NaN if the geoid can't be loaded. */
 double HeightAboveEllipsoid(double lat, double lon, double h);
 
+/* How the data file is accessed by geoid_open; apart from CGEOID_DEFAULT,
+ * these match Geoid::datamode. */
+enum cgeoid_mode {
+  /* Memory map the data file if possible, otherwise read it into memory */
+  CGEOID_DEFAULT = 0,
+  CGEOID_MEMORYMAP = 1,   /* memory map the .pgm file (POSIX only) */
+  CGEOID_POSITIONAL = 2,  /* read the .pgm file with pread (POSIX only) */
+  CGEOID_PRECOMPUTED = 3, /* memory map the .cub file (POSIX only) */
+  CGEOID_TILED = 4        /* read the .gtl file with pread (POSIX only) */
+};
+
+/* An opaque handle to a geoid. */
+struct cgeoid;
+
+/* Open the geoid with the given name (e.g., "egm2008-1"); path is the
+ * directory containing the data (NULL or "" means the default directory).
+ * Returns NULL on failure; in this case, if errmsg is not NULL, the reason
+ * is copied to it (truncated to errlen characters including the
+ * terminating null).  The handle is thread safe: it may be shared by
+ * several threads which query it concurrently.  It should be opened once
+ * and closed with geoid_close when it's no longer needed. */
+struct cgeoid* geoid_open(const char* name, const char* path, int mode,
+                          char* errmsg, size_t errlen);
+
+/* Close the geoid (g may be NULL). */
+void geoid_close(struct cgeoid* g);
+
+/* Return the height of the geoid above the ellipsoid (meters) at lat, lon
+ * (degrees).  Returns NaN on error. */
+double geoid_height(const struct cgeoid* g, double lat, double lon);
+
+/* Set h[i], i = 0..n-1, to the heights of the geoid above the ellipsoid
+ * at lat[i], lon[i].  The data needed by all the points is read at once
+ * and is reused for points in the same cell.  Returns 0 on success and -1
+ * on error (in which case h is filled with NaNs). */
+int geoid_heights(const struct cgeoid* g, size_t n,
+                  const double lat[], const double lon[], double h[]);
+
+#if defined(__cplusplus)
+}
+#endif
+
 #endif  /* CGEOID_H */
@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include "cgeoid.h"
 
 #if defined(_MSC_VER)
@@ -7,7 +8,42 @@
 #endif
 
 int main() {
-  double lat, lon, h;
-  while(scanf("%lf %lf %lf", &lat, &lon, &h) == 3)
-    printf("%.3f\n", HeightAboveEllipsoid(lat, lon, h));
+  double *lat = 0, *lon = 0, *h = 0, *N = 0;
+  size_t n = 0, cap = 0, i;
+  char msg[256];
+  int ret = 0;
+  struct cgeoid* g = geoid_open("egm2008-1", 0, CGEOID_DEFAULT,
+                                msg, sizeof(msg));
+  if (!g) {
+    fprintf(stderr, "ERROR: %s\n", msg);
+    return 1;
+  }
+  /* Read all the points and then convert them with a single call */
+  for (;;) {
+    if (n == cap) {
+      cap = cap ? 2 * cap : 1024;
+      lat = realloc(lat, cap * sizeof(double));
+      lon = realloc(lon, cap * sizeof(double));
+      h = realloc(h, cap * sizeof(double));
+      if (!(lat && lon && h)) {
+        fprintf(stderr, "ERROR: out of memory\n");
+        ret = 1; goto done;
+      }
+    }
+    if (scanf("%lf %lf %lf", lat + n, lon + n, h + n) != 3) break;
+    ++n;
+  }
+  N = malloc((n ? n : 1) * sizeof(double));
+  if (!N) {
+    fprintf(stderr, "ERROR: out of memory\n");
+    ret = 1; goto done;
+  }
+  if (geoid_heights(g, n, lat, lon, N) != 0)
+    ret = 1;
+  for (i = 0; i < n; ++i)
+    printf("%.3f\n", h[i] + N[i]);
+ done:
+  free(lat); free(lon); free(h); free(N);
+  geoid_close(g);
+  return ret;
 }
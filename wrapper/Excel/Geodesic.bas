@@ -23,6 +23,26 @@ Private Declare PtrSafe Sub rinverse Lib "cgeodesic.dll" _
  ByVal lat2 As Double, ByVal lon2 As Double, _
  ByRef s12 As Double, ByRef azi12 As Double)
 
+Private Declare PtrSafe Sub gdirectarr Lib "cgeodesic.dll" _
+(ByVal n As Long, ByRef lat1 As Double, ByRef lon1 As Double, _
+ ByRef azi1 As Double, ByRef s12 As Double, _
+ ByRef lat2 As Double, ByRef lon2 As Double, ByRef azi2 As Double)
+
+Private Declare PtrSafe Sub ginversearr Lib "cgeodesic.dll" _
+(ByVal n As Long, ByRef lat1 As Double, ByRef lon1 As Double, _
+ ByRef lat2 As Double, ByRef lon2 As Double, _
+ ByRef s12 As Double, ByRef azi1 As Double, ByRef azi2 As Double)
+
+Private Declare PtrSafe Sub rdirectarr Lib "cgeodesic.dll" _
+(ByVal n As Long, ByRef lat1 As Double, ByRef lon1 As Double, _
+ ByRef azi12 As Double, ByRef s12 As Double, _
+ ByRef lat2 As Double, ByRef lon2 As Double)
+
+Private Declare PtrSafe Sub rinversearr Lib "cgeodesic.dll" _
+(ByVal n As Long, ByRef lat1 As Double, ByRef lon1 As Double, _
+ ByRef lat2 As Double, ByRef lon2 As Double, _
+ ByRef s12 As Double, ByRef azi12 As Double)
+
 '   Define the custom worksheet functions that call the DLL functions
 
 Function geodesic_direct_lat2(lat1 As Double, lon1 As Double, _
@@ -130,3 +150,158 @@ Function rhumb_inverse_azi12(lat1 As Double, lon1 As Double, _
   Call rinverse(lat1, lon1, lat2, lon2, s12, azi12)
   rhumb_inverse_azi12 = azi12
 End Function
+
+'   Helper routines for the range functions
+
+'   Return the values in a range, an array, or a single value as a
+'   zero-based vector of doubles.
+Private Function to_vector(x As Variant) As Double()
+  Dim v As Variant
+  Dim e As Variant
+  Dim r() As Double
+  Dim n As Long
+  If IsObject(x) Then v = x.Value Else v = x
+  If IsArray(v) Then
+    For Each e In v
+      n = n + 1
+    Next e
+    ReDim r(0 To n - 1)
+    n = 0
+    For Each e In v
+      r(n) = e
+      n = n + 1
+    Next e
+  Else
+    ReDim r(0 To 0)
+    r(0) = v
+  End If
+  to_vector = r
+End Function
+
+'   Expand a vector with a single element to n elements.  Return False if
+'   the vector has some other length.
+Private Function expand(r() As Double, n As Long) As Boolean
+  Dim i As Long
+  Dim v As Double
+  If UBound(r) + 1 = n Then
+    expand = True
+  ElseIf UBound(r) = 0 Then
+    v = r(0)
+    ReDim r(0 To n - 1)
+    For i = 0 To n - 1
+      r(i) = v
+    Next i
+    expand = True
+  Else
+    expand = False
+  End If
+End Function
+
+'   Convert the four inputs to vectors with a common length n.  Return
+'   False if the lengths are inconsistent.
+Private Function to_vectors(x1 As Variant, x2 As Variant, _
+                            x3 As Variant, x4 As Variant, _
+                            a1() As Double, a2() As Double, _
+                            a3() As Double, a4() As Double, _
+                            n As Long) As Boolean
+  a1 = to_vector(x1)
+  a2 = to_vector(x2)
+  a3 = to_vector(x3)
+  a4 = to_vector(x4)
+  n = UBound(a1) + 1
+  If UBound(a2) + 1 > n Then n = UBound(a2) + 1
+  If UBound(a3) + 1 > n Then n = UBound(a3) + 1
+  If UBound(a4) + 1 > n Then n = UBound(a4) + 1
+  to_vectors = expand(a1, n) And expand(a2, n) And _
+               expand(a3, n) And expand(a4, n)
+End Function
+
+'   Return an n x 2 or n x 3 array with the results as its columns.
+Private Function to_columns(n As Long, c1() As Double, c2() As Double, _
+                            Optional c3 As Variant) As Variant
+  Dim r() As Double
+  Dim i As Long
+  ReDim r(1 To n, 1 To IIf(IsMissing(c3), 2, 3))
+  For i = 1 To n
+    r(i, 1) = c1(i - 1)
+    r(i, 2) = c2(i - 1)
+    If Not IsMissing(c3) Then r(i, 3) = c3(i - 1)
+  Next i
+  to_columns = r
+End Function
+
+'   Define the range functions.  These take columns (or rows) of values
+'   (a single value is used for every row) and solve all the problems with
+'   one call to the DLL which uses all the available cores.  Enter them as
+'   array formulas in n x 3 (or n x 2) ranges; in recent versions of
+'   Excel, the results spill into the neighboring cells.
+
+Function geodesic_direct_range(lat1 As Variant, lon1 As Variant, _
+                               azi1 As Variant, s12 As Variant) As Variant
+  Attribute geodesic_direct_range.VB_Description = _
+    "Solves direct geodesic problems for lat2, lon2, azi2."
+  Dim a1() As Double, a2() As Double, a3() As Double, a4() As Double
+  Dim lat2() As Double, lon2() As Double, azi2() As Double
+  Dim n As Long
+  If Not to_vectors(lat1, lon1, azi1, s12, a1, a2, a3, a4, n) Then
+    geodesic_direct_range = CVErr(xlErrValue)
+    Exit Function
+  End If
+  ReDim lat2(0 To n - 1)
+  ReDim lon2(0 To n - 1)
+  ReDim azi2(0 To n - 1)
+  Call gdirectarr(n, a1(0), a2(0), a3(0), a4(0), lat2(0), lon2(0), azi2(0))
+  geodesic_direct_range = to_columns(n, lat2, lon2, azi2)
+End Function
+
+Function geodesic_inverse_range(lat1 As Variant, lon1 As Variant, _
+                                lat2 As Variant, lon2 As Variant) As Variant
+  Attribute geodesic_inverse_range.VB_Description = _
+    "Solves inverse geodesic problems for s12, azi1, azi2."
+  Dim a1() As Double, a2() As Double, a3() As Double, a4() As Double
+  Dim s12() As Double, azi1() As Double, azi2() As Double
+  Dim n As Long
+  If Not to_vectors(lat1, lon1, lat2, lon2, a1, a2, a3, a4, n) Then
+    geodesic_inverse_range = CVErr(xlErrValue)
+    Exit Function
+  End If
+  ReDim s12(0 To n - 1)
+  ReDim azi1(0 To n - 1)
+  ReDim azi2(0 To n - 1)
+  Call ginversearr(n, a1(0), a2(0), a3(0), a4(0), s12(0), azi1(0), azi2(0))
+  geodesic_inverse_range = to_columns(n, s12, azi1, azi2)
+End Function
+
+Function rhumb_direct_range(lat1 As Variant, lon1 As Variant, _
+                            azi12 As Variant, s12 As Variant) As Variant
+  Attribute rhumb_direct_range.VB_Description = _
+    "Solves direct rhumb problems for lat2, lon2."
+  Dim a1() As Double, a2() As Double, a3() As Double, a4() As Double
+  Dim lat2() As Double, lon2() As Double
+  Dim n As Long
+  If Not to_vectors(lat1, lon1, azi12, s12, a1, a2, a3, a4, n) Then
+    rhumb_direct_range = CVErr(xlErrValue)
+    Exit Function
+  End If
+  ReDim lat2(0 To n - 1)
+  ReDim lon2(0 To n - 1)
+  Call rdirectarr(n, a1(0), a2(0), a3(0), a4(0), lat2(0), lon2(0))
+  rhumb_direct_range = to_columns(n, lat2, lon2)
+End Function
+
+Function rhumb_inverse_range(lat1 As Variant, lon1 As Variant, _
+                             lat2 As Variant, lon2 As Variant) As Variant
+  Attribute rhumb_inverse_range.VB_Description = _
+    "Solves inverse rhumb problems for s12, azi12."
+  Dim a1() As Double, a2() As Double, a3() As Double, a4() As Double
+  Dim s12() As Double, azi12() As Double
+  Dim n As Long
+  If Not to_vectors(lat1, lon1, lat2, lon2, a1, a2, a3, a4, n) Then
+    rhumb_inverse_range = CVErr(xlErrValue)
+    Exit Function
+  End If
+  ReDim s12(0 To n - 1)
+  ReDim azi12(0 To n - 1)
+  Call rinversearr(n, a1(0), a2(0), a3(0), a4(0), s12(0), azi12(0))
+  rhumb_inverse_range = to_columns(n, s12, azi12)
+End Function
@@ -1,6 +1,37 @@
+#include <algorithm>
 #include "cgeodesic.h"
 #include "GeographicLib/Geodesic.hpp"
 #include "GeographicLib/Rhumb.hpp"
+#include "GeographicLib/Executor.hpp"
+
+namespace {
+
+  // The rows are handed out to the threads in blocks of this size.
+  const size_t block_ = 4096;
+
+  // Run f(i, k) over the blocks of [0, n) on all the cores; if an exception
+  // is thrown, fill the outputs with NaNs.
+  template<typename F>
+  void run(int n, double* out1, double* out2, double* out3, const F& f) {
+    if (n <= 0) return;
+    size_t m = size_t(n);
+    try {
+      GeographicLib::Executor::Parallel
+        ((m + block_ - 1) / block_, 0,
+         [&](size_t b) -> void {
+          size_t i = b * block_;
+          f(i, std::min(block_, m - i));
+        });
+    }
+    catch (...) {
+      double nan = GeographicLib::Math::NaN();
+      std::fill(out1, out1 + m, nan);
+      std::fill(out2, out2 + m, nan);
+      if (out3) std::fill(out3, out3 + m, nan);
+    }
+  }
+
+}
 
 extern "C" {
 
@@ -28,4 +59,50 @@ extern "C" {
                                           s12, azi12);
   }
 
+  void gdirectarr(int n, const double lat1[], const double lon1[],
+                  const double azi1[], const double s12[],
+                  double lat2[], double lon2[], double azi2[]) {
+    using GeographicLib::Geodesic;
+    run(n, lat2, lon2, azi2, [&](size_t i, size_t k) -> void {
+        Geodesic::WGS84().DirectBatch(k, lat1 + i, lon1 + i,
+                                      azi1 + i, s12 + i,
+                                      lat2 + i, lon2 + i, azi2 + i);
+      });
+  }
+
+  void ginversearr(int n, const double lat1[], const double lon1[],
+                   const double lat2[], const double lon2[],
+                   double s12[], double azi1[], double azi2[]) {
+    using GeographicLib::Geodesic;
+    run(n, s12, azi1, azi2, [&](size_t i, size_t k) -> void {
+        Geodesic::WGS84().InverseBatch(k, lat1 + i, lon1 + i,
+                                       lat2 + i, lon2 + i,
+                                       s12 + i, azi1 + i, azi2 + i);
+      });
+  }
+
+  void rdirectarr(int n, const double lat1[], const double lon1[],
+                  const double azi12[], const double s12[],
+                  double lat2[], double lon2[]) {
+    using GeographicLib::Rhumb;
+    run(n, lat2, lon2, nullptr, [&](size_t i, size_t k) -> void {
+        Rhumb::WGS84().DirectBatch
+          (k, lat1 + i, lon1 + i, azi12 + i, s12 + i,
+           Rhumb::LATITUDE | Rhumb::LONGITUDE,
+           lat2 + i, lon2 + i, nullptr);
+      });
+  }
+
+  void rinversearr(int n, const double lat1[], const double lon1[],
+                   const double lat2[], const double lon2[],
+                   double s12[], double azi12[]) {
+    using GeographicLib::Rhumb;
+    run(n, s12, azi12, nullptr, [&](size_t i, size_t k) -> void {
+        Rhumb::WGS84().InverseBatch
+          (k, lat1 + i, lon1 + i, lat2 + i, lon2 + i,
+           Rhumb::DISTANCE | Rhumb::AZIMUTH,
+           s12 + i, azi12 + i, nullptr);
+      });
+  }
+
 }
@@ -17,6 +17,24 @@ extern "C" {
   void rinverse(double lat1, double lon1, double lat2, double lon2,
                 double& s12, double& azi12);
 
+  /* The array versions solve n problems with a single call; the rows are
+   * divided into blocks which are solved on all the available cores. */
+  void gdirectarr(int n, const double lat1[], const double lon1[],
+                  const double azi1[], const double s12[],
+                  double lat2[], double lon2[], double azi2[]);
+
+  void ginversearr(int n, const double lat1[], const double lon1[],
+                   const double lat2[], const double lon2[],
+                   double s12[], double azi1[], double azi2[]);
+
+  void rdirectarr(int n, const double lat1[], const double lon1[],
+                  const double azi12[], const double s12[],
+                  double lat2[], double lon2[]);
+
+  void rinversearr(int n, const double lat1[], const double lon1[],
+                   const double lat2[], const double lon2[],
+                   double s12[], double azi12[]);
+
 #if defined(__cplusplus)
 }
 #endif
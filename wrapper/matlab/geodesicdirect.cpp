@@ -0,0 +1,150 @@
+/**
+ * \file geodesicdirect.cpp
+ * \brief Matlab mex file for the direct geodesic problem
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+// Compile in Matlab with
+// [Unix]
+// mex -I/usr/local/include -L/usr/local/lib -Wl,-rpath=/usr/local/lib
+//    -lGeographic geodesicdirect.cpp
+// [Windows]
+// mex -I../include -L../windows/Release
+//    -lGeographic geodesicdirect.cpp
+
+#include <algorithm>
+#include <GeographicLib/Geodesic.hpp>
+#include <GeographicLib/GeodesicExact.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <mex.h>
+
+using namespace std;
+using namespace GeographicLib;
+
+// The rows are handed out to the threads in blocks of this size.
+const size_t block_ = 4096;
+
+// Solve the problems for one block with the batch routines.
+void direct(const Geodesic& g, size_t n, unsigned outmask,
+            const double* lat1, const double* lon1,
+            const double* azi1, const double* s12,
+            double* lat2, double* lon2, double* azi2,
+            double* m12, double* M12, double* M21, double* S12,
+            double* a12) {
+  g.DirectBatch(n, lat1, lon1, azi1, s12, outmask,
+                lat2, lon2, azi2, m12, M12, M21, S12, a12);
+}
+
+void direct(const GeodesicExact& g, size_t n, unsigned outmask,
+            const double* lat1, const double* lon1,
+            const double* azi1, const double* s12,
+            double* lat2, double* lon2, double* azi2,
+            double* m12, double* M12, double* M21, double* S12,
+            double* a12) {
+  // This is already running in a thread; so use 1 thread here.
+  g.DirectBatch(n, lat1, lon1, azi1, s12, outmask,
+                lat2, lon2, azi2, m12, M12, M21, S12, a12, 1u);
+}
+
+template<class G> void
+compute(double a, double f, mwSize m, const double* geodesic,
+        double* latlong, double* aux) {
+  const double* lat1 = geodesic;
+  const double* lon1 = geodesic + m;
+  const double* azi1 = geodesic + 2*m;
+  const double* s12 = geodesic + 3*m;
+  double* lat2 = latlong;
+  double* lon2 = latlong + m;
+  double* azi2 = latlong + 2*m;
+  double* a12 = NULL;
+  double* m12 = NULL;
+  double* M12 = NULL;
+  double* M21 = NULL;
+  double* S12 = NULL;
+  if (aux) {
+    a12 = aux;
+    m12 = aux + m;
+    M12 = aux + 2*m;
+    M21 = aux + 3*m;
+    S12 = aux + 4*m;
+  }
+  const unsigned outmask = aux ? unsigned(G::ALL) :
+    unsigned(G::LATITUDE | G::LONGITUDE | G::AZIMUTH);
+
+  const G g(a, f);
+  // Each thread solves blocks of rows with the batch routine, writing
+  // directly into the output matrices.
+  Executor::Parallel((m + block_ - 1) / block_, 0,
+                     [&](size_t b) -> void {
+                       size_t i = b * block_, n = min(block_, size_t(m) - i);
+                       direct(g, n, outmask,
+                              lat1 + i, lon1 + i, azi1 + i, s12 + i,
+                              lat2 + i, lon2 + i, azi2 + i,
+                              aux ? m12 + i : NULL, aux ? M12 + i : NULL,
+                              aux ? M21 + i : NULL, aux ? S12 + i : NULL,
+                              aux ? a12 + i : NULL);
+                     });
+  // Rows with illegal coordinates give NaNs.
+  for (mwIndex i = 0; i < m; ++i) {
+    if (!(abs(lat1[i]) <= 90 && lon1[i] >= -540 && lon1[i] < 540 &&
+          azi1[i] >= -540 && azi1[i] < 540)) {
+      lat2[i] = lon2[i] = azi2[i] = Math::NaN<double>();
+      if (aux)
+        a12[i] = m12[i] = M12[i] = M21[i] = S12[i] = Math::NaN<double>();
+    }
+  }
+}
+
+void mexFunction( int nlhs, mxArray* plhs[],
+                  int nrhs, const mxArray* prhs[] ) {
+
+  if (nrhs < 1)
+    mexErrMsgTxt("One input argument required.");
+  else if (nrhs > 3)
+    mexErrMsgTxt("More than three input arguments specified.");
+  else if (nrhs == 2)
+    mexErrMsgTxt("Must specify flattening with the equatorial radius.");
+  else if (nlhs > 2)
+    mexErrMsgTxt("More than two output arguments specified.");
+
+  if (!( mxIsDouble(prhs[0]) && !mxIsComplex(prhs[0]) ))
+    mexErrMsgTxt("geodesic coordinates are not of type double.");
+
+  if (mxGetN(prhs[0]) != 4)
+    mexErrMsgTxt("geodesic coordinates must be M x 4 matrix.");
+
+  double a = Constants::WGS84_a<double>(), f = Constants::WGS84_f<double>();
+  if (nrhs == 3) {
+    if (!( mxIsDouble(prhs[1]) && !mxIsComplex(prhs[1]) &&
+           mxGetNumberOfElements(prhs[1]) == 1 ))
+      mexErrMsgTxt("Equatorial radius is not a real scalar.");
+    a = mxGetScalar(prhs[1]);
+    if (!( mxIsDouble(prhs[2]) && !mxIsComplex(prhs[2]) &&
+           mxGetNumberOfElements(prhs[2]) == 1 ))
+      mexErrMsgTxt("Flattening is not a real scalar.");
+    f = mxGetScalar(prhs[2]);
+  }
+
+  mwSize m = mxGetM(prhs[0]);
+
+  const double* geodesic = mxGetPr(prhs[0]);
+
+  double* latlong = mxGetPr(plhs[0] = mxCreateDoubleMatrix(m, 3, mxREAL));
+
+  double* aux =
+    nlhs == 2 ? mxGetPr(plhs[1] = mxCreateDoubleMatrix(m, 5, mxREAL)) :
+    NULL;
+
+  try {
+    if (std::abs(f) <= 0.02)
+      compute<Geodesic>(a, f, m, geodesic, latlong, aux);
+    else
+      compute<GeodesicExact>(a, f, m, geodesic, latlong, aux);
+  }
+  catch (const std::exception& e) {
+    mexErrMsgTxt(e.what());
+  }
+}
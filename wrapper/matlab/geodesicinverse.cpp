@@ -1,8 +1,8 @@
 /**
  * \file geodesicinverse.cpp
- * \brief Matlab mex file for geographic to UTM/UPS conversions
+ * \brief Matlab mex file for the inverse geodesic problem
  *
- * Copyright (c) Charles Karney (2010-2013) <charles@karney.com> and licensed
+ * Copyright (c) Charles Karney (2010-2026) <charles@karney.com> and licensed
  * under the MIT/X11 License.  For more information, see
  * https://geographiclib.sourceforge.io/
  **********************************************************************/
@@ -18,11 +18,37 @@
 #include <algorithm>
 #include <GeographicLib/Geodesic.hpp>
 #include <GeographicLib/GeodesicExact.hpp>
+#include <GeographicLib/Executor.hpp>
 #include <mex.h>
 
 using namespace std;
 using namespace GeographicLib;
 
+// The rows are handed out to the threads in blocks of this size.
+const size_t block_ = 4096;
+
+// Solve the problems for one block with the batch routines.
+void inverse(const Geodesic& g, size_t n, unsigned outmask,
+             const double* lat1, const double* lon1,
+             const double* lat2, const double* lon2,
+             double* s12, double* azi1, double* azi2,
+             double* m12, double* M12, double* M21, double* S12,
+             double* a12) {
+  g.InverseBatch(n, lat1, lon1, lat2, lon2, outmask,
+                 s12, azi1, azi2, m12, M12, M21, S12, a12);
+}
+
+void inverse(const GeodesicExact& g, size_t n, unsigned outmask,
+             const double* lat1, const double* lon1,
+             const double* lat2, const double* lon2,
+             double* s12, double* azi1, double* azi2,
+             double* m12, double* M12, double* M21, double* S12,
+             double* a12) {
+  // This is already running in a thread; so use 1 thread here.
+  g.InverseBatch(n, lat1, lon1, lat2, lon2, outmask,
+                 s12, azi1, azi2, m12, M12, M21, S12, a12, 1u);
+}
+
 template<class G> void
 compute(double a, double f, mwSize m, const double* latlong,
         double* geodesic, double* aux) {
@@ -45,18 +71,29 @@ compute(double a, double f, mwSize m, const double* latlong,
     M21 = aux + 3*m;
     S12 = aux + 4*m;
   }
+  const unsigned outmask = aux ? unsigned(G::ALL) :
+    unsigned(G::DISTANCE | G::AZIMUTH);
 
   const G g(a, f);
+  // Each thread solves blocks of rows with the batch routine, writing
+  // directly into the output matrices.
+  Executor::Parallel((m + block_ - 1) / block_, 0,
+                     [&](size_t b) -> void {
+                       size_t i = b * block_, n = min(block_, size_t(m) - i);
+                       inverse(g, n, outmask,
+                               lat1 + i, lon1 + i, lat2 + i, lon2 + i,
+                               s12 + i, azi1 + i, azi2 + i,
+                               aux ? m12 + i : NULL, aux ? M12 + i : NULL,
+                               aux ? M21 + i : NULL, aux ? S12 + i : NULL,
+                               aux ? a12 + i : NULL);
+                     });
+  // Rows with illegal coordinates give NaNs.
   for (mwIndex i = 0; i < m; ++i) {
-    if (abs(lat1[i]) <= 90 && lon1[i] >= -540 && lon1[i] < 540 &&
-        abs(lat2[i]) <= 90 && lon2[i] >= -540 && lon2[i] < 540) {
+    if (!(abs(lat1[i]) <= 90 && lon1[i] >= -540 && lon1[i] < 540 &&
+          abs(lat2[i]) <= 90 && lon2[i] >= -540 && lon2[i] < 540)) {
+      azi1[i] = azi2[i] = s12[i] = Math::NaN<double>();
       if (aux)
-        a12[i] = g.Inverse(lat1[i], lon1[i], lat2[i], lon2[i],
-                           s12[i], azi1[i], azi2[i],
-                           m12[i], M12[i], M21[i], S12[i]);
-      else
-        g.Inverse(lat1[i], lon1[i], lat2[i], lon2[i],
-                  s12[i], azi1[i], azi2[i]);
+        a12[i] = m12[i] = M12[i] = M21[i] = S12[i] = Math::NaN<double>();
     }
   }
 }
@@ -96,13 +133,10 @@ void mexFunction( int nlhs, mxArray* plhs[],
   const double* latlong = mxGetPr(prhs[0]);
 
   double* geodesic = mxGetPr(plhs[0] = mxCreateDoubleMatrix(m, 3, mxREAL));
-  std::fill(geodesic, geodesic + 3*m, Math::NaN<double>());
 
   double* aux =
     nlhs == 2 ? mxGetPr(plhs[1] = mxCreateDoubleMatrix(m, 5, mxREAL)) :
     NULL;
-  if (aux)
-    std::fill(aux, aux + 5*m, Math::NaN<double>());
 
   try {
     if (std::abs(f) <= 0.02)
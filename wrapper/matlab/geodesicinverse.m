@@ -25,6 +25,9 @@ function geodesicinverse(~, ~, ~)
 %   f = flattening (0 means a sphere)
 %   If a and f are omitted, the WGS84 values are used.
 %
+% The rows are divided into blocks which are solved on all the available
+% cores.
+%
 % A native MATLAB implementation is available as GEODDISTANCE.
 %
 % See also GEODDISTANCE.
@@ -0,0 +1,76 @@
+/**
+ * \file geoidheight.cpp
+ * \brief Matlab mex file for geoid heights
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+// Compile in Matlab with
+// [Unix]
+// mex -I/usr/local/include -L/usr/local/lib -Wl,-rpath=/usr/local/lib
+//    -lGeographic geoidheight.cpp
+// [Windows]
+// mex -I../include -L../windows/Release
+//    -lGeographic geoidheight.cpp
+
+#include <string>
+#include <GeographicLib/Geoid.hpp>
+#include <mex.h>
+
+using namespace std;
+using namespace GeographicLib;
+
+// Return the string argument i or dflt if it's absent or empty.
+string stringarg(int nrhs, const mxArray* prhs[], int i, const char* name,
+                 const string& dflt) {
+  if (nrhs <= i || mxIsEmpty(prhs[i])) return dflt;
+  if (!mxIsChar(prhs[i])) {
+    string msg = string(name) + " is not a string.";
+    mexErrMsgTxt(msg.c_str());
+  }
+  char* s = mxArrayToString(prhs[i]);
+  string val(s);
+  mxFree(s);
+  return val;
+}
+
+void mexFunction( int nlhs, mxArray* plhs[],
+                  int nrhs, const mxArray* prhs[] ) {
+
+  if (nrhs < 1)
+    mexErrMsgTxt("One input argument required.");
+  else if (nrhs > 3)
+    mexErrMsgTxt("More than three input arguments specified.");
+  else if (nlhs > 1)
+    mexErrMsgTxt("More than one output argument specified.");
+
+  if (!( mxIsDouble(prhs[0]) && !mxIsComplex(prhs[0]) ))
+    mexErrMsgTxt("latlong coordinates are not of type double.");
+
+  if (mxGetN(prhs[0]) != 2)
+    mexErrMsgTxt("latlong coordinates must be M x 2 matrix.");
+
+  string name = stringarg(nrhs, prhs, 1, "Geoid name",
+                          Geoid::DefaultGeoidName()),
+    dir = stringarg(nrhs, prhs, 2, "Geoid directory", "");
+
+  mwSize m = mxGetM(prhs[0]);
+
+  const double* latlong = mxGetPr(prhs[0]);
+  const double* lat = latlong;
+  const double* lon = latlong + m;
+
+  double* h = mxGetPr(plhs[0] = mxCreateDoubleMatrix(m, 1, mxREAL));
+
+  try {
+    const Geoid g(name, dir);
+    // The batch routine groups the points by cell and reads the data
+    // needed for many points at once.
+    g(m, lat, lon, h);
+  }
+  catch (const std::exception& e) {
+    mexErrMsgTxt(e.what());
+  }
+}
@@ -0,0 +1,26 @@
+function geoidheight(~, ~, ~)
+%geoidheight  Compute geoid heights
+%
+%   h = geoidheight(latlong)
+%   h = geoidheight(latlong, geoidname)
+%   h = geoidheight(latlong, geoidname, geoiddir)
+%
+%   latlong is an M x 2 matrix
+%       latitude = latlong(:,1) in degrees
+%       longitude = latlong(:,2) in degrees
+%
+%   h is an M x 1 matrix
+%       height of the geoid above the WGS84 ellipsoid = h in meters
+%
+%   geoidname is the name of the geoid model, e.g., 'egm2008-1'; if
+%   omitted, the default geoid (usually 'egm96-5') is used.
+%
+%   geoiddir is the directory containing the geoid data; if omitted, the
+%   default directory is used.
+%
+% The heights for all the points are computed with a single call to the
+% batch routine which reads the data needed by many points at once.
+% Illegal latitudes give NaNs.
+
+  error('Error: executing .m file instead of compiled routine');
+end
@@ -0,0 +1,100 @@
+/**
+ * \file utmupsforward.cpp
+ * \brief Matlab mex file for UTM/UPS forward conversions
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+// Compile in Matlab with
+// [Unix]
+// mex -I/usr/local/include -L/usr/local/lib -Wl,-rpath=/usr/local/lib
+//    -lGeographic utmupsforward.cpp
+// [Windows]
+// mex -I../include -L../windows/Release
+//    -lGeographic utmupsforward.cpp
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <GeographicLib/UTMUPS.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <mex.h>
+
+using namespace std;
+using namespace GeographicLib;
+
+// The rows are handed out to the threads in blocks of this size.
+const size_t block_ = 4096;
+
+void mexFunction( int nlhs, mxArray* plhs[],
+                  int nrhs, const mxArray* prhs[] ) {
+
+  if (nrhs < 1)
+    mexErrMsgTxt("One input argument required.");
+  else if (nrhs > 2)
+    mexErrMsgTxt("More than two input arguments specified.");
+  else if (nlhs > 2)
+    mexErrMsgTxt("More than two output arguments specified.");
+
+  if (!( mxIsDouble(prhs[0]) && !mxIsComplex(prhs[0]) ))
+    mexErrMsgTxt("latlong coordinates are not of type double.");
+
+  if (mxGetN(prhs[0]) != 2)
+    mexErrMsgTxt("latlong coordinates must be M x 2 matrix.");
+
+  int setzone = UTMUPS::STANDARD;
+  if (nrhs == 2) {
+    if (!( mxIsDouble(prhs[1]) && !mxIsComplex(prhs[1]) &&
+           mxGetNumberOfElements(prhs[1]) == 1 ))
+      mexErrMsgTxt("setzone is not a real scalar.");
+    setzone = int(mxGetScalar(prhs[1]));
+  }
+
+  mwSize m = mxGetM(prhs[0]);
+
+  const double* latlong = mxGetPr(prhs[0]);
+  const double* lat = latlong;
+  const double* lon = latlong + m;
+
+  double* utmups = mxGetPr(plhs[0] = mxCreateDoubleMatrix(m, 4, mxREAL));
+  double* x = utmups;
+  double* y = utmups + m;
+  double* zone = utmups + 2*m;
+  double* northp = utmups + 3*m;
+
+  double* scale =
+    nlhs == 2 ? mxGetPr(plhs[1] = mxCreateDoubleMatrix(m, 2, mxREAL)) :
+    NULL;
+  double* gamma = scale;
+  double* k = scale ? scale + m : NULL;
+
+  try {
+    // Each thread converts blocks of rows with the batch routine, writing x
+    // and y directly into the output matrix; the zones and hemispheres are
+    // converted to doubles afterwards.
+    Executor::Parallel((m + block_ - 1) / block_, 0,
+                       [&](size_t b) -> void {
+                         size_t i = b * block_, n = min(block_, size_t(m) - i);
+                         vector<int> z(n);
+                         // vector<bool> isn't an array of bool
+                         unique_ptr<bool[]> h(new bool[n]);
+                         UTMUPS::ForwardBatch(n, lat + i, lon + i,
+                                              z.data(), h.get(), x + i, y + i,
+                                              scale ? gamma + i : NULL,
+                                              scale ? k + i : NULL,
+                                              setzone);
+                         for (size_t j = 0; j < n; ++j) {
+                           // Illegal points give NaNs.
+                           bool ok = z[j] != UTMUPS::INVALID;
+                           zone[i + j] = ok ? z[j] : Math::NaN<double>();
+                           northp[i + j] = !ok ? Math::NaN<double>() :
+                             (h[j] ? 1 : 0);
+                         }
+                       });
+  }
+  catch (const std::exception& e) {
+    mexErrMsgTxt(e.what());
+  }
+}
@@ -0,0 +1,29 @@
+function utmupsforward(~, ~)
+%utmupsforward  Convert geographic coordinates to UTM/UPS
+%
+%   [utmups, scale] = utmupsforward(latlong)
+%   [utmups, scale] = utmupsforward(latlong, setzone)
+%
+%   latlong is an M x 2 matrix
+%       latitude = latlong(:,1) in degrees
+%       longitude = latlong(:,2) in degrees
+%
+%   utmups is an M x 4 matrix
+%       easting = utmups(:,1) in meters
+%       northing = utmups(:,2) in meters
+%       zone = utmups(:,3) (0 means UPS)
+%       hemisphere = utmups(:,4) (1 means north, 0 means south)
+%   scale is an M x 2 matrix
+%       meridian convergence = scale(:,1) in degrees
+%       scale = scale(:,2)
+%
+%   setzone is the zone to use (-1 = standard zone, the default, -2 =
+%   standard UTM zone, 0 = UPS, 1-60 = the UTM zone).
+%
+% The rows are divided into blocks which are converted on all the
+% available cores.  Points which can't be converted give NaNs.
+%
+% See also UTMUPSREVERSE.
+
+  error('Error: executing .m file instead of compiled routine');
+end
@@ -0,0 +1,88 @@
+/**
+ * \file utmupsreverse.cpp
+ * \brief Matlab mex file for UTM/UPS reverse conversions
+ *
+ * Copyright (c) Charles Karney (2026) <charles@karney.com> and licensed
+ * under the MIT/X11 License.  For more information, see
+ * https://geographiclib.sourceforge.io/
+ **********************************************************************/
+
+// Compile in Matlab with
+// [Unix]
+// mex -I/usr/local/include -L/usr/local/lib -Wl,-rpath=/usr/local/lib
+//    -lGeographic utmupsreverse.cpp
+// [Windows]
+// mex -I../include -L../windows/Release
+//    -lGeographic utmupsreverse.cpp
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <GeographicLib/UTMUPS.hpp>
+#include <GeographicLib/Executor.hpp>
+#include <mex.h>
+
+using namespace std;
+using namespace GeographicLib;
+
+// The rows are handed out to the threads in blocks of this size.
+const size_t block_ = 4096;
+
+void mexFunction( int nlhs, mxArray* plhs[],
+                  int nrhs, const mxArray* prhs[] ) {
+
+  if (nrhs != 1)
+    mexErrMsgTxt("One input argument required.");
+  else if (nlhs > 2)
+    mexErrMsgTxt("More than two output arguments specified.");
+
+  if (!( mxIsDouble(prhs[0]) && !mxIsComplex(prhs[0]) ))
+    mexErrMsgTxt("utmups coordinates are not of type double.");
+
+  if (mxGetN(prhs[0]) != 4)
+    mexErrMsgTxt("utmups coordinates must be M x 4 matrix.");
+
+  mwSize m = mxGetM(prhs[0]);
+
+  const double* utmups = mxGetPr(prhs[0]);
+  const double* x = utmups;
+  const double* y = utmups + m;
+  const double* zone = utmups + 2*m;
+  const double* northp = utmups + 3*m;
+
+  double* latlong = mxGetPr(plhs[0] = mxCreateDoubleMatrix(m, 2, mxREAL));
+  double* lat = latlong;
+  double* lon = latlong + m;
+
+  double* scale =
+    nlhs == 2 ? mxGetPr(plhs[1] = mxCreateDoubleMatrix(m, 2, mxREAL)) :
+    NULL;
+  double* gamma = scale;
+  double* k = scale ? scale + m : NULL;
+
+  try {
+    // Each thread converts blocks of rows with the batch routine, writing
+    // directly into the output matrices.
+    Executor::Parallel((m + block_ - 1) / block_, 0,
+                       [&](size_t b) -> void {
+                         size_t i = b * block_, n = min(block_, size_t(m) - i);
+                         vector<int> z(n);
+                         // vector<bool> isn't an array of bool
+                         unique_ptr<bool[]> h(new bool[n]);
+                         for (size_t j = 0; j < n; ++j) {
+                           // A NaN zone or hemisphere is an illegal point.
+                           bool ok = zone[i + j] == zone[i + j] &&
+                             northp[i + j] == northp[i + j];
+                           z[j] = ok ? int(zone[i + j]) : UTMUPS::INVALID;
+                           h[j] = ok && northp[i + j] != 0;
+                         }
+                         UTMUPS::ReverseBatch(n, z.data(), h.get(),
+                                              x + i, y + i, lat + i, lon + i,
+                                              scale ? gamma + i : NULL,
+                                              scale ? k + i : NULL);
+                       });
+  }
+  catch (const std::exception& e) {
+    mexErrMsgTxt(e.what());
+  }
+}
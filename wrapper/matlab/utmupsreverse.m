@@ -0,0 +1,25 @@
+function utmupsreverse(~)
+%utmupsreverse  Convert UTM/UPS coordinates to geographic
+%
+%   [latlong, scale] = utmupsreverse(utmups)
+%
+%   utmups is an M x 4 matrix
+%       easting = utmups(:,1) in meters
+%       northing = utmups(:,2) in meters
+%       zone = utmups(:,3) (0 means UPS)
+%       hemisphere = utmups(:,4) (1 means north, 0 means south)
+%
+%   latlong is an M x 2 matrix
+%       latitude = latlong(:,1) in degrees
+%       longitude = latlong(:,2) in degrees
+%   scale is an M x 2 matrix
+%       meridian convergence = scale(:,1) in degrees
+%       scale = scale(:,2)
+%
+% The rows are divided into blocks which are converted on all the
+% available cores.  Points which can't be converted give NaNs.
+%
+% See also UTMUPSFORWARD.
+
+  error('Error: executing .m file instead of compiled routine');
+end